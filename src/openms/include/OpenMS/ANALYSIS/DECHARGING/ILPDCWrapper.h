@@ -65,19 +65,19 @@ public:
     /// If the input feature map is empty, a warning is issued and -1 is returned.
     /// @return value of objective function
     /// and @p pairs will have all realized edges set to "active"
-    double compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const;
+    double compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const;
 
 private:
 
     /// slicing the problem into subproblems
-    double computeSlice_(const FeatureMap fm,
+    double computeSlice_(const FeatureMap& fm,
                          PairsType& pairs,
                          const PairsIndex margin_left,
                          const PairsIndex margin_right,
                          const Size verbose_level) const;
 
     /// slicing the problem into subproblems
-    double computeSliceOld_(const FeatureMap fm,
+    double computeSliceOld_(const FeatureMap& fm,
                             PairsType& pairs,
                             const PairsIndex margin_left,
                             const PairsIndex margin_right,
@@ -302,6 +302,9 @@ private:
     /// Extract query results from feature
     std::vector<AccurateMassSearchResult> extractQueryResults_(const Feature& feature, const Size& feature_index, const String& ion_mode_internal, Size& dummy_count) const;
 
+    /// Extract query results for all features (in parallel); the result has one entry per feature, in input order
+    std::vector<std::vector<AccurateMassSearchResult>> extractQueryResults_(const FeatureMap& fmap, const String& ion_mode_internal, Size& dummy_count) const;
+
     /// Add resulting matches to IdentificationData
     void addMatchesToID_(
       IdentificationData& id,
@@ -333,6 +336,8 @@ private:
       double mass;
       std::vector<String> massIDs;
       String formula;
+      EmpiricalFormula parsed_formula; ///< @p formula parsed once at load time (adduct compatibility, isotope patterns)
+      bool formula_parsed = false; ///< false if @p formula could not be parsed; it is then re-parsed (and reported) on use
     };
     std::vector<MappingEntry_> mass_mappings_;
 
@@ -39,6 +39,7 @@
 
 #include <cassert>
 #include <functional> // for std::hash
+#include <iosfwd>
 #include <limits>
 #include <queue>
 #include <string>
@@ -402,6 +403,21 @@ namespace OpenMS
     /// I.e. similar to while(next(state)) merge(hits_all, state.hits);
     void getAllHits(ACTrieState& state) const;
 
+    /**
+      @brief Writes the compressed trie (incl. needle indices and search limits) in binary form to @p os
+
+      The trie can be restored with load(), which is much faster than adding all needles again.
+      @throw Exception::IllegalArgument if the trie was not compressed yet (see compressTrie())
+    */
+    void store(std::ostream& os) const;
+
+    /**
+      @brief Restores a trie written by store()
+
+      @return false if @p is does not contain a valid trie (this trie is left unchanged in that case)
+    */
+    bool load(std::istream& is);
+
   private:
     /// Resume search at the last position in the query and node in the trie.
     /// If a node (or any suffices) are a hit, then @p state.hits is NOT cleared, but filled and true is returned.
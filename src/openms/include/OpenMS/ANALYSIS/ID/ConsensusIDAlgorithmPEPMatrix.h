@@ -37,6 +37,8 @@
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithmSimilarity.h>
 #include <OpenMS/ANALYSIS/SEQUENCE/NeedlemanWunsch.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -61,6 +63,15 @@ namespace OpenMS
     /// object for alignment score calculation
     NeedlemanWunsch alignment_;
 
+    /// Cache: unmodified sequence -> score of its alignment with itself (for normalization)
+    std::unordered_map<String, double> self_alignment_scores_;
+
+    /// Cache: pair of unmodified sequences -> similarity (PTMs are ignored, so this is shared between modified forms)
+    std::map<std::pair<String, String>, double> unmodified_similarities_;
+
+    /// Alignment score of @p seq with itself (cached)
+    double getSelfAlignmentScore_(const String& seq);
+
     /// Not implemented
     ConsensusIDAlgorithmPEPMatrix(const ConsensusIDAlgorithmPEPMatrix&);
 
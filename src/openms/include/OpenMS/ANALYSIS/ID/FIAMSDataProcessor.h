@@ -110,6 +110,7 @@ public:
       The bin size for summing the intensities is defined as mz / (resolution*4) 
       for all the mzs taken with the @bin_step defined in the parameters.
       Uses `SpectrumAddition::addUpSpectra` function with the sliding bin size parameter. 
+      The m/z windows are summed up in parallel.
 
       @param input  Input vector of spectra
       @return a spectrum
@@ -147,7 +148,8 @@ public:
     /**
       @brief Perform accurate mass search
 
-      Uses `AccurateMassSearchEngine`
+      Uses `AccurateMassSearchEngine`. Initialised engines (i.e. the loaded databases) are cached and shared
+      between all instances (and threads) with the same search settings.
 
       @param input  Input a feature map
       @param output  [out] mzTab file with the accurate mass search results
@@ -78,6 +78,11 @@ public:
 
     /**
       @brief Run the FIA-MS data analysis for the batch defined in the @filename_
+
+      Samples and their time points are processed as parallel tasks: while one sample is loaded,
+      the time points of already loaded samples are processed. Each sample is loaded only once.
+
+      @throws the first exception (in sample and time point order) raised by any of the tasks, after all tasks finished
     */
     void run();
 
@@ -238,8 +238,14 @@ private:
     /// Not implemented
     FalseDiscoveryRate& operator=(const FalseDiscoveryRate&);
 
+    /// score -> FDR table, sorted by score (ascending) with unique scores; see lookupFDR_()
+    using ScoreToFDRTable = std::vector<std::pair<double, double>>;
+
     /// calculates the FDR, given two vectors of scores
-    void calculateFDRs_(std::map<double, double>& score_to_fdr, std::vector<double>& target_scores, std::vector<double>& decoy_scores, bool q_value, bool higher_score_better) const;
+    void calculateFDRs_(ScoreToFDRTable& score_to_fdr, std::vector<double>& target_scores, std::vector<double>& decoy_scores, bool q_value, bool higher_score_better) const;
+
+    /// FDR of @p score in @p score_to_fdr (binary search); 0 for scores which are not contained
+    static double lookupFDR_(const ScoreToFDRTable& score_to_fdr, double score);
 
     /// Helper function for applyToObservationMatches()
     void handleObservationMatch_(
@@ -0,0 +1,135 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Index of theoretical fragment ion m/z values for candidate selection in database searches
+
+    All fragment ions of all candidate peptides are stored in one array sorted
+    by m/z, together with the peptides they belong to. Peptides are ordered by
+    their mass, so the candidates of a precursor mass window form a contiguous
+    range. A query looks up every experimental peak in the fragment array and
+    counts, for each peptide within the precursor mass window, the number of
+    theoretical fragments matched by at least one peak. Peptides sharing the
+    most fragments with the spectrum are returned and can then be scored with
+    a more expensive score.
+
+    As the cost of a query depends on the number of peaks and not on the
+    number of candidates in the precursor mass window, this allows searches
+    with wide precursor mass windows (e.g. open modification searches).
+
+    Usage: add all peptides with addPeptide(), call build() once and query
+    the index (query() is thread-safe).
+  */
+  class OPENMS_DLLAPI FragmentIndex
+  {
+public:
+    /// a peptide with the number of fragments it shares with the queried spectrum
+    struct Hit
+    {
+      Size peptide_index; ///< index of the peptide as returned by addPeptide()
+      Size shared_fragments; ///< number of matched theoretical fragments
+    };
+
+    /// adds a peptide with its (neutral) mass and theoretical fragment m/z values and returns its index
+    Size addPeptide(double mass, const std::vector<double>& fragment_mzs);
+
+    /// sorts peptides and fragments, needs to be called after all peptides were added and before querying
+    void build();
+
+    /// returns whether build() was called after the last peptide was added
+    bool isBuilt() const;
+
+    /// removes all peptides
+    void clear();
+
+    /// number of peptides
+    Size size() const;
+
+    /// number of fragments of all peptides
+    Size getNumberOfFragments() const;
+
+    /// mass of the peptide with index @p peptide_index
+    double getPeptideMass(Size peptide_index) const;
+
+    /**
+      @brief Returns the peptides sharing the most fragments with a spectrum
+
+      @param peak_mzs m/z values of the (singly charged) experimental peaks
+      @param min_mass lower bound of the precursor mass window (inclusive)
+      @param max_mass upper bound of the precursor mass window (inclusive)
+      @param fragment_tolerance fragment mass tolerance
+      @param fragment_tolerance_ppm whether @p fragment_tolerance is given in ppm (otherwise Da)
+      @param min_shared_fragments minimum number of shared fragments of a reported peptide
+      @param max_hits maximum number of reported peptides (0 = all)
+      @param hits the peptides, sorted by decreasing number of shared fragments (ties by peptide index)
+
+      @exception Exception::Precondition is thrown if the index was not built
+    */
+    void query(const std::vector<double>& peak_mzs,
+               double min_mass,
+               double max_mass,
+               double fragment_tolerance,
+               bool fragment_tolerance_ppm,
+               Size min_shared_fragments,
+               Size max_hits,
+               std::vector<Hit>& hits) const;
+
+protected:
+    /// peptide masses in order of addition
+    std::vector<double> peptide_masses_;
+
+    /// peptide masses sorted increasingly
+    std::vector<double> sorted_masses_;
+
+    /// position of each peptide in sorted_masses_
+    std::vector<UInt32> rank_by_peptide_;
+
+    /// peptide index for each position in sorted_masses_
+    std::vector<UInt32> peptide_by_rank_;
+
+    /// fragment m/z and peptide index, sorted by m/z after build()
+    std::vector<std::pair<double, UInt32> > fragments_;
+
+    bool built_ = true;
+  };
+} // namespace OpenMS
@@ -123,8 +123,10 @@ namespace OpenMS
     typedef boost::graph_traits<Graph>::vertex_descriptor vertex_t;
     typedef boost::graph_traits<Graph>::edge_descriptor edge_t;
 
-    typedef std::set<IDBoostGraph::vertex_t> ProteinNodeSet;
-    typedef std::set<IDBoostGraph::vertex_t> PeptideNodeSet;
+    /// Sets of vertices stored as sorted, duplicate-free vectors. They are filled from the (ordered)
+    /// adjacency sets of a Graph, which keeps them sorted without the per-node overhead of std::set.
+    typedef std::vector<IDBoostGraph::vertex_t> ProteinNodeSet;
+    typedef std::vector<IDBoostGraph::vertex_t> PeptideNodeSet;
 
 
     /// A boost dfs visitor that copies connected components into a vector of graphs
@@ -537,6 +539,9 @@ namespace OpenMS
     //vertex_t addVertexWithLookup_(IDPointerConst& ptr, std::unordered_map<IDPointerConst, vertex_t, boost::hash<IDPointerConst>>& vertex_map);
 
 
+    /// indices into ccs_, ordered by decreasing size (edges + vertices), ties keep their original order
+    std::vector<Size> getCCsBySizeDescending_() const;
+
     /// internal function to annotate the underlying ID structures based on the given Graph
     void annotateIndistProteins_(const Graph& fg, bool addSingletons);
     void calculateAndAnnotateIndistProteins_(const Graph& fg, bool addSingletons);
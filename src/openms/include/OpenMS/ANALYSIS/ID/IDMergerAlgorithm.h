@@ -40,6 +40,7 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/METADATA/ExperimentalDesign.h>
 
+#include <unordered_map>
 #include <unordered_set>
 
 namespace OpenMS
@@ -119,11 +120,13 @@ namespace OpenMS
 
     /// updates the references in pepIDs to the new protein ID run
     /// then moves the peptide IDs based on the
-    /// mapping in
+    /// mapping in @p runID_to_runIdx. @p originFileIdcs holds the
+    /// new origin index for every file of every old run.
+    /// Annotation runs in parallel, the order of the peptide IDs is kept.
     void updateAndMovePepIDs_(
         std::vector<PeptideIdentification>&& pepIDs,
-        const std::map<String, Size>& runID_to_runIdx,
-        const std::vector<StringList>& originFiles,
+        const std::unordered_map<String, Size>& runID_to_runIdx,
+        const std::vector<std::vector<Size>>& originFileIdcs,
         bool annotate_origin
     );
 
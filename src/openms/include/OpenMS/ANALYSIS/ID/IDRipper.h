@@ -37,6 +37,8 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
+#include <unordered_map>
+
 
 namespace OpenMS
 {
@@ -181,12 +183,10 @@ private:
 
     /// helper function, detects file origin annotation standard from collections of protein and peptide hits
     OriginAnnotationFormat detectOriginAnnotationFormat_(std::map<String, UInt> & file_origin_map, const std::vector<PeptideIdentification> & peptide_idents);
-    /// helper function, extracts all protein hits that match the protein accession
-    void getProteinHits_(std::vector<ProteinHit> & result, const std::vector<ProteinHit> & protein_hits, const std::vector<String> & protein_accessions);
+    /// helper function, appends all protein hits that match the protein accessions (looked up in @p accession_to_hits)
+    void getProteinHits_(std::vector<const ProteinHit*> & result, const std::unordered_map<String, std::vector<const ProteinHit*> > & accession_to_hits, const std::vector<String> & protein_accessions);
     /// helper function, returns the string representation of the peptide hit accession
     void getProteinAccessions_(std::vector<String> & result, const std::vector<PeptideHit> & peptide_hits);
-    /// helper function, returns the protein identification for the given peptide identification based on the same identifier
-    void getProteinIdentification_(ProteinIdentification & result, PeptideIdentification pep_ident, std::vector<ProteinIdentification> & prot_idents);
     /// helper function, register a potential output file basename to detect duplicate output basenames
     bool registerBasename_(std::map<String, std::pair<UInt, UInt> >& basename_to_numeric, const IDRipper::RipFileIdentifier& rfi);
     /// helper function, sets the value of mode to new_value and returns true if the old value was identical or unset (-1)
@@ -158,7 +158,7 @@ public:
     /**
     @brief Re-index peptide identifications honoring enzyme cutting rules, ambiguous amino acids and target/decoy hits.
     
-    Template parameter 'T' can be either TFI_File or TFI_Vector. If the data is already available, use TFI_Vector and pass the vector.
+    Template parameter 'T' can be either TFI_File, TFI_Vector or TFI_Indexed. If the data is already available, use TFI_Vector and pass the vector.
     If the data is still in a FASTA file and its not needed afterwards for additional processing, use TFI_File and pass the filename.
 
     PeptideIndexer refreshes target/decoy information and mapping of peptides to proteins.
@@ -195,6 +195,9 @@ public:
     /// Same as run() with TFI_File, but for proteins which are already in memory
     ExitCodes run(FASTAContainer<TFI_Vector>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids);
 
+    /// Same as run() with TFI_File, but for proteins from a pre-indexed binary database (see IndexedFASTAFile)
+    ExitCodes run(FASTAContainer<TFI_Indexed>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids);
+
     /// Which string is used to determine if a protein is a decoy or not
     const String& getDecoyString() const;
 
@@ -218,6 +221,7 @@ public:
     Unmatched unmatched_action_ = Unmatched::IS_ERROR;
     bool IL_equivalent_{ false };
     bool allow_nterm_protein_cleavage_{ true };
+    String trie_cache_{};
 
     Int aaa_max_{0};
     Int mm_max_{0};
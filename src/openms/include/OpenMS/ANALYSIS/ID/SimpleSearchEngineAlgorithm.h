@@ -36,14 +36,19 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 
 #include <OpenMS/CHEMISTRY/ModifiedPeptideGenerator.h>
+#include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/DATASTRUCTURES/StringView.h>
 
+#include <map>
 #include <vector>
 
 namespace OpenMS
 {
 
+class CachedPeptideDatabase;
+
 class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
   public DefaultParamHandler,
   public ProgressLogger
@@ -93,6 +98,28 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     /// @brief filter, deisotope, decharge spectra
     static void preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm);
 
+    /**
+      @brief score spectra against the candidates preselected with a fragment ion index (fragment_index:enabled)
+
+      All (modified) peptides of @p fasta_db are put into a FragmentIndex. For each precursor mass of a
+      spectrum, the candidates sharing the most fragments with it are scored with HyperScore.
+    */
+    void searchFragmentIndex_(const PeakMap& spectra,
+      const std::multimap<double, Size>& multimap_mass_2_scan_index,
+      const std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      const ProteaseDigestion& digestor,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits) const;
+
+    /// @brief score spectra against the peptides of a digested peptide database (database_cache)
+    void searchPeptideDatabase_(const PeakMap& spectra,
+      const std::multimap<double, Size>& multimap_mass_2_scan_index,
+      const CachedPeptideDatabase& peptide_db,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits) const;
+
     /// @brief filter and annotate search results
     /// most of the parameters are used to properly add meta data to the id objects
     void postProcessHits_(const PeakMap& exp, 
@@ -146,6 +173,12 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     String peptide_motif_;
 
     Size report_top_hits_;
+
+    String database_cache_;
+
+    bool fragment_index_;
+    Size fragment_index_min_shared_fragments_;
+    Size fragment_index_max_candidates_;
 };
 
 } // namespace
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FlatConsensusMap.h>
 
 namespace OpenMS
 {
@@ -86,6 +87,13 @@ public:
      * @param map ConsensusMap the map to be updated
      */
     static void setNormalizedIntensityValues(const std::vector<std::vector<double> > & feature_ints, ConsensusMap & map);
+
+protected:
+    /// extracts the intensities of the elements of @p flat for each of the @p number_of_maps maps (see extractIntensityVectors())
+    static void extractIntensityVectors_(const FlatConsensusMap & flat, const ConsensusMap::ColumnHeaders & column_headers, std::vector<std::vector<double> > & out_intensities);
+
+    /// writes the intensity values in feature_ints to the elements of @p flat (see setNormalizedIntensityValues())
+    static void setNormalizedIntensityValues_(const std::vector<std::vector<double> > & feature_ints, FlatConsensusMap & flat);
   };
 
 } // namespace OpenMS
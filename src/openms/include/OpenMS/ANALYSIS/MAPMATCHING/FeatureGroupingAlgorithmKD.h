@@ -232,10 +232,10 @@ private:
     void group_(const std::vector<MapType>& input_maps, ConsensusMap& out);
 
     /// Run the actual clustering algorithm
-    void runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out);
+    void runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out) const;
 
     /// Update maximum possible sizes of potential consensus features for indices specified in @p update_these
-    void updateClusterProxies_(std::set<ClusterProxyKD>& potential_clusters, std::vector<ClusterProxyKD>& cluster_for_idx, const std::set<Size>& update_these, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data);
+    void updateClusterProxies_(std::set<ClusterProxyKD>& potential_clusters, std::vector<ClusterProxyKD>& cluster_for_idx, const std::set<Size>& update_these, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const;
 
     /// Compute the current best cluster with center index @p i (mutates @p proxy and @p cf_indices)
     ClusterProxyKD computeBestClusterForCenter_(Size i, std::vector<Size>& cf_indices, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const;
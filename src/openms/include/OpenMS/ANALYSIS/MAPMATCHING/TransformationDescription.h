@@ -121,6 +121,14 @@ public:
     */
     double apply(double value) const;
 
+    /**
+      @brief Applies the transformation to all @p values (in place).
+
+      Equivalent to calling apply(double) for every element, but the model is
+      evaluated in parallel (the fitted models are read-only after fitting).
+    */
+    void apply(std::vector<double>& values) const;
+
     /// Gets the type of the fitted model
     const String& getModelType() const;
 
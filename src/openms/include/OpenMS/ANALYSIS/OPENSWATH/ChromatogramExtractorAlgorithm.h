@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/ISpectrumAccess.h>
 
 namespace OpenMS
@@ -108,6 +109,33 @@ public:
         double im_extraction_window,
         const String& filter);
 
+    /**
+     * @brief Extract chromatograms from spectra in structure-of-arrays layout (SoASpectrum).
+     *
+     * Same as above, but reads m/z and intensities directly from the
+     * contiguous arrays of each SoASpectrum (and ion mobility from its IM float
+     * data array, see SoASpectrum::getIMData()).
+     *
+     * @param input Input spectra (sorted by m/z)
+     * @param retention_times Retention time (in seconds) of each input spectrum
+     * @param output Output chromatograms (XICs)
+     * @param extraction_coordinates Extracts around these coordinates (sorted by m/z)
+     * @param mz_extraction_window Extracts a window of this size in m/z dimension in Th or ppm
+     * @param ppm Whether mz_extraction_window is in ppm or in Th
+     * @param im_extraction_window Full window width for IM extraction (zero or negative to disable)
+     * @param filter Which function to apply in m/z space (currently "tophat" only)
+     *
+     * @exception Exception::IllegalArgument if input sizes do not match, or IM extraction is requested for a spectrum without IM data
+    */
+    void extractChromatograms(const std::vector<SoASpectrum>& input,
+        const std::vector<double>& retention_times,
+        std::vector< OpenSwath::ChromatogramPtr >& output,
+        const std::vector<ExtractionCoordinates>& extraction_coordinates,
+        double mz_extraction_window,
+        bool ppm,
+        double im_extraction_window,
+        const String& filter);
+
     /**
      * @brief Extract the next mz value and add the integrated intensity to integrated_intensity.
      *
@@ -141,6 +169,16 @@ public:
                               const double mz_extraction_window,
                               const bool ppm);
 
+    /// Same as above, for the m/z and intensity arrays of a SoASpectrum
+    void extract_value_tophat(const SoASpectrum::MZArray::const_iterator& mz_start,
+                              SoASpectrum::MZArray::const_iterator& mz_it,
+                              const SoASpectrum::MZArray::const_iterator& mz_end,
+                              SoASpectrum::IntensityArray::const_iterator& int_it,
+                              const double mz,
+                              double& integrated_intensity,
+                              const double mz_extraction_window,
+                              const bool ppm);
+
     /**
      * @brief Extract the next m/z value and add the integrated intensity to integrated_intensity.
      *
@@ -55,10 +55,9 @@ namespace OpenMS
     (ISpectrumAccess) using the CachedmzML class which is able to read and
     write a cached mzML file.
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    Data is read from a memory mapping of the cached file which is shared
+    between all copies, thus lightClone() is cheap and concurrent read
+    access (also on the same object) is safe.
 
   */
   class OPENMS_DLLAPI SpectrumAccessOpenMSCached :
@@ -115,6 +115,17 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double /* RT */, double /* deltaRT */) const override;
 
+    /**
+      @brief Select spectra by retention time range, MS level and precursor isolation target
+
+      The selection is performed by the underlying database (see
+      MzMLSqliteHandler::getSpectraIndices) instead of reading all meta data.
+
+      @return The indices of the selected spectra (relative to the subset of this object, if any), sorted by retention time
+    */
+    std::vector<std::size_t> getSpectraByRange(double rt_min, double rt_max, int ms_level = -1,
+                                               double precursor_mz_min = 0.0, double precursor_mz_max = -1.0) const;
+
     size_t getNrSpectra() const override;
 
     OpenSwath::ChromatogramPtr getChromatogramById(int /* id */) override;
@@ -125,6 +136,9 @@ public:
 
 private:
 
+    /// Map indices of the sqMass file to indices of the subset sidx_ (drops indices not in the subset)
+    std::vector<std::size_t> mapToSubset_(const std::vector<std::size_t>& file_indices) const;
+
     /// Access to underlying sqMass file
     OpenMS::Internal::MzMLSqliteHandler handler_;
     /// Optional subset of spectral indices
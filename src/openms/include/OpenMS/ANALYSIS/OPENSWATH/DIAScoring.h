@@ -163,16 +163,16 @@ private:
 
     /// Subfunction of dia_isotope_scores
     void diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions,
-                              SpectrumPtrType spectrum,
-                              std::map<std::string, double>& intensities,
+                              const SpectrumPtrType& spectrum,
+                              const std::vector<double>& intensities,
                               double& isotope_corr,
                               double& isotope_overlap) const;
 
     /// retrieves intensities from MRMFeature
-    /// computes a vector of relative intensities for each feature (output to intensities)
+    /// computes a vector of relative intensities for each feature (output to intensities, in the order of @p transitions)
     void getFirstIsotopeRelativeIntensities_(const std::vector<TransitionType>& transitions,
                                             OpenSwath::IMRMFeature* mrmfeature,
-                                            std::map<std::string, double>& intensities //experimental intensities of transitions
+                                            std::vector<double>& intensities //experimental intensities of transitions
                                             ) const;
 
 private:
@@ -192,7 +192,7 @@ private:
       @param nr_occurrences Will contain the maximum ratio of a peaks intensity compared to the monoisotopic peak intensity how often a peak is found at lower m/z than mono_mz with an intensity higher than mono_int. Multiple charge states are tested, see class parameter dia_nr_charges_
 
     */
-    void largePeaksBeforeFirstIsotope_(SpectrumPtrType spectrum, double mono_mz, double mono_int, int& nr_occurrences, double& max_ratio) const;
+    void largePeaksBeforeFirstIsotope_(const SpectrumPtrType& spectrum, double mono_mz, double mono_int, int& nr_occurrences, double& max_ratio) const;
 
     /**
       @brief Compare an experimental isotope pattern to a theoretical one
@@ -228,7 +228,7 @@ private:
 
     /// Get the intensities of isotopes around @p precursor_mz in experimental @p spectrum
     /// and fill @p isotopes_int.
-    void getIsotopeIntysFromExpSpec_(double precursor_mz, SpectrumPtrType spectrum,
+    void getIsotopeIntysFromExpSpec_(double precursor_mz, const SpectrumPtrType& spectrum,
                                      std::vector<double>& isotopes_int,
                                      int charge_state) const;
 
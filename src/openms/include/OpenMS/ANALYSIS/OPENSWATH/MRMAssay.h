@@ -227,6 +227,22 @@ protected:
                                                       const FragmentSeqMap& ions,
                                                       const double mz_threshold);
 
+    /**
+      @brief Same as getMatchingPeptidoforms_() for ions sorted by fragment m/z
+
+      Uses binary search to find the ions within the threshold instead of
+      scanning all ions.
+
+      @param fragment_ion the queried fragment ion
+      @param sorted_ions a vector of pairs of fragment ion m/z and peptide sequences, sorted by m/z
+      @param mz_threshold the threshold within which to search for interferences
+
+      @return a vector of strings containing all peptidoforms with which fragment_ion overlaps
+    */
+    std::vector<std::string> getMatchingPeptidoformsSorted_(const double fragment_ion,
+                                                            const FragmentSeqMap& sorted_ions,
+                                                            const double mz_threshold);
+
     /**
       @brief Get swath index (precursor isolation window ordinal) for a particular precursor
 
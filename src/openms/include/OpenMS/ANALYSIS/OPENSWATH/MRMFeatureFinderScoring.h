@@ -135,6 +135,10 @@ public:
                         const PeakMap& swath_map);
 
     /** @brief Pick and score features in a single experiment from chromatograms
+     *
+     * Transition groups are picked and scored in parallel (if OpenMP is
+     * enabled). The features are added to @p output in the order of the
+     * transition groups in @p transition_group_map, as in a sequential run.
      *
      * @param input The input chromatograms
      * @param output The output features with corresponding scores
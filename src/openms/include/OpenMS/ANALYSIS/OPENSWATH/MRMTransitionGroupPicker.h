@@ -90,6 +90,23 @@ public:
     ~MRMTransitionGroupPicker() override;
     //@}
 
+    /**
+      @brief Chromatogram totals of a transition group
+
+      The XIC sums and the mutual information of the fragment traces do not
+      depend on the feature, thus pickFragmentChromatograms computes them for
+      the first feature of a transition group and reuses them for all further
+      features. Entry k holds the values of transition k and the running
+      group totals after transition k.
+    */
+    struct TransitionGroupTotals
+    {
+      std::vector<double> transition_total_xic; ///< XIC sum of transition k
+      std::vector<double> transition_total_mi; ///< mutual information of transition k
+      std::vector<double> total_xic; ///< XIC sum of the detecting transitions up to k
+      std::vector<double> total_mi; ///< total mutual information of the detecting transitions up to k
+    };
+
     /**
       @brief Pick a group of chromatograms belonging to the same peptide
 
@@ -161,6 +178,7 @@ public:
       // and terminate.
       int chr_idx, peak_idx, cnt = 0;
       std::vector<MRMFeature> features;
+      TransitionGroupTotals totals;
       while (true)
       {
         chr_idx = -1; peak_idx = -1;
@@ -181,7 +199,7 @@ public:
         }
 
         // Compute a feature from the individual chromatograms and add non-zero features
-        MRMFeature mrm_feature = createMRMFeature(transition_group, picked_chroms, smoothed_chroms, chr_idx, peak_idx);
+        MRMFeature mrm_feature = createMRMFeature(transition_group, picked_chroms, smoothed_chroms, chr_idx, peak_idx, &totals);
         double total_xic = 0;
         double intensity = mrm_feature.getIntensity();
         if (intensity > 0)
@@ -221,13 +239,20 @@ public:
 
     }
 
-    /// Create feature from a vector of chromatograms and a specified peak
+    /**
+      @brief Create feature from a vector of chromatograms and a specified peak
+
+      If @p totals is given, the chromatogram totals are taken from (or
+      stored in) it, see TransitionGroupTotals. It must only be shared
+      between features of the same transition group.
+    */
     template <typename SpectrumT, typename TransitionT>
     MRMFeature createMRMFeature(const MRMTransitionGroup<SpectrumT, TransitionT>& transition_group,
                                 std::vector<SpectrumT>& picked_chroms,
                                 const std::vector<SpectrumT>& smoothed_chroms,
                                 const int chr_idx,
-                                const int peak_idx)
+                                const int peak_idx,
+                                TransitionGroupTotals* totals = nullptr)
     {
       OPENMS_PRECONDITION(transition_group.isInternallyConsistent(), "Consistent state required")
       OPENMS_PRECONDITION(transition_group.chromatogramIdsMatch(), "Chromatogram native IDs need to match keys in transition group")
@@ -309,7 +334,7 @@ public:
                                 best_left, best_right, use_consensus_,
                                 total_intensity, total_xic, total_mi, total_peak_apices,
                                 master_peak_container, left_edges, right_edges,
-                                chr_idx, peak_idx);
+                                chr_idx, peak_idx, totals);
 
       // Also pick the precursor chromatogram(s); note total_xic is not
       // extracted here, only for fragment traces
@@ -403,7 +428,8 @@ public:
                                     const std::vector< double > & left_edges,
                                     const std::vector< double > & right_edges,
                                     const int chr_idx,
-                                    const int peak_idx)
+                                    const int peak_idx,
+                                    TransitionGroupTotals* totals = nullptr)
     {
       for (Size k = 0; k < transition_group.getTransitions().size(); k++)
       {
@@ -425,56 +451,76 @@ public:
         }
 
         const SpectrumT& chromatogram = selectChromHelper_(transition_group, transition_group.getTransitions()[k].getNativeID()); 
-        if (transition_group.getTransitions()[k].isDetectingTransition())
-        {
-          for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
-          {
-            total_xic += it->getIntensity();
-          }
-        }
 
-        // Compute total intensity on transition-level
-        double transition_total_xic = 0; 
-
-        for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
+        // The totals do not depend on the feature, thus they are computed only
+        // once per transition group if totals are given.
+        double transition_total_xic = 0;
+        double transition_total_mi = 0;
+        if (totals != nullptr && k < totals->transition_total_xic.size())
         {
-          transition_total_xic += it->getIntensity();
+          transition_total_xic = totals->transition_total_xic[k];
+          transition_total_mi = totals->transition_total_mi[k];
+          total_xic = totals->total_xic[k];
+          total_mi = totals->total_mi[k];
         }
-
-        // Compute total mutual information on transition-level.
-        double transition_total_mi = 0;
-        if (compute_total_mi_)
+        else
         {
-          std::vector<unsigned int> chrom_vect_id_ranked, chrom_vect_det_ranked;
-          std::vector<double> chrom_vect_id, chrom_vect_det;
+          if (transition_group.getTransitions()[k].isDetectingTransition())
+          {
+            for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
+            {
+              total_xic += it->getIntensity();
+            }
+          }
+
+          // Compute total intensity on transition-level
           for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
           {
-            chrom_vect_id.push_back(it->getIntensity());
+            transition_total_xic += it->getIntensity();
           }
-          unsigned int max_rank_det = OpenSwath::Scoring::computeAndAppendRank(chrom_vect_id, chrom_vect_det_ranked);
-          // compute baseline mutual information
-          int transition_total_mi_norm = 0;
-          for (Size m = 0; m < transition_group.getTransitions().size(); m++)
+
+          // Compute total mutual information on transition-level.
+          if (compute_total_mi_)
           {
-            if (transition_group.getTransitions()[m].isDetectingTransition())
+            std::vector<unsigned int> chrom_vect_id_ranked, chrom_vect_det_ranked;
+            std::vector<double> chrom_vect_id, chrom_vect_det;
+            for (typename SpectrumT::const_iterator it = chromatogram.begin(); it != chromatogram.end(); it++)
+            {
+              chrom_vect_id.push_back(it->getIntensity());
+            }
+            unsigned int max_rank_det = OpenSwath::Scoring::computeAndAppendRank(chrom_vect_id, chrom_vect_det_ranked);
+            // compute baseline mutual information
+            int transition_total_mi_norm = 0;
+            for (Size m = 0; m < transition_group.getTransitions().size(); m++)
             {
-              const SpectrumT& chromatogram_det = selectChromHelper_(transition_group, transition_group.getTransitions()[m].getNativeID());
-              chrom_vect_det.clear();
-              for (typename SpectrumT::const_iterator it = chromatogram_det.begin(); it != chromatogram_det.end(); it++)
+              if (transition_group.getTransitions()[m].isDetectingTransition())
               {
-                chrom_vect_det.push_back(it->getIntensity());
+                const SpectrumT& chromatogram_det = selectChromHelper_(transition_group, transition_group.getTransitions()[m].getNativeID());
+                chrom_vect_det.clear();
+                for (typename SpectrumT::const_iterator it = chromatogram_det.begin(); it != chromatogram_det.end(); it++)
+                {
+                  chrom_vect_det.push_back(it->getIntensity());
+                }
+                unsigned int max_rank_id = OpenSwath::Scoring::computeAndAppendRank(chrom_vect_det, chrom_vect_id_ranked);
+                transition_total_mi += OpenSwath::Scoring::rankedMutualInformation(chrom_vect_id_ranked, chrom_vect_det_ranked, max_rank_id, max_rank_det);
+                transition_total_mi_norm++;
               }
-              unsigned int max_rank_id = OpenSwath::Scoring::computeAndAppendRank(chrom_vect_det, chrom_vect_id_ranked);
-              transition_total_mi += OpenSwath::Scoring::rankedMutualInformation(chrom_vect_id_ranked, chrom_vect_det_ranked, max_rank_id, max_rank_det);
-              transition_total_mi_norm++;
+            }
+            if (transition_total_mi_norm > 0) { transition_total_mi /= transition_total_mi_norm; }
+
+            if (transition_group.getTransitions()[k].isDetectingTransition())
+            {
+              // sum up all transition-level total MI and divide by the number of detection transitions to have peak group level total MI
+              total_mi += transition_total_mi / transition_total_mi_norm;
             }
           }
-          if (transition_total_mi_norm > 0) { transition_total_mi /= transition_total_mi_norm; }
 
-          if (transition_group.getTransitions()[k].isDetectingTransition())
+          if (totals != nullptr)
           {
-            // sum up all transition-level total MI and divide by the number of detection transitions to have peak group level total MI
-            total_mi += transition_total_mi / transition_total_mi_norm;
+            totals->transition_total_xic.push_back(transition_total_xic);
+            totals->transition_total_mi.push_back(transition_total_mi);
+            totals->total_xic.push_back(total_xic);
+            totals->total_mi.push_back(total_mi);
           }
         }
 
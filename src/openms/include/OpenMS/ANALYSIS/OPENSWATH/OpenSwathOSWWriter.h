@@ -42,9 +42,12 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 
 #include <fstream>
+#include <memory>
 
 namespace OpenMS
 {
+  class SqliteConnector;
+  class WriteBehindQueue;
 
   /**
     @brief Class to write out an OpenSwath OSW SQLite output (PyProphet input).
@@ -121,6 +124,10 @@ namespace OpenMS
     bool use_ms1_traces_;
     bool sonar_;
     bool enable_uis_scoring_;
+    /// Writer thread for write-behind (null if writing synchronously)
+    std::shared_ptr<WriteBehindQueue> write_behind_;
+    /// Connection used by the writer thread (kept open between writeLines calls)
+    std::shared_ptr<SqliteConnector> write_behind_conn_;
 
   public:
 
@@ -198,6 +205,29 @@ namespace OpenMS
      */
     void writeLines(const std::vector<String>& to_osw_output);
 
+    /**
+     * @brief Enable asynchronous write-behind
+     *
+     * Statements passed to writeLines are copied and executed by a dedicated
+     * writer thread on a database connection that stays open, so callers
+     * only hold their critical section while the statements are queued. At
+     * most @p max_pending calls are kept in memory; writeLines blocks when the
+     * writer falls behind. Pass zero to write synchronously (default).
+     *
+     * Errors during writing are reported by the next call to writeLines or flush.
+     *
+     */
+    void setWriteBehind(Size max_pending);
+
+    /**
+     * @brief Wait until all queued statements are written and close the writer connection
+     *
+     * Call this before the OSW file is accessed otherwise. Does nothing when
+     * writing synchronously.
+     *
+     */
+    void flush();
+
   };
 
 }
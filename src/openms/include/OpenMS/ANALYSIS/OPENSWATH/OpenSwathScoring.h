@@ -45,9 +45,12 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathScores.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
 
+#include <OpenMS/CONCEPT/Types.h>
+
 #include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
 
 namespace OpenMS
 {
@@ -291,12 +294,52 @@ namespace OpenMS
 
   protected:
 
+    /// Peak positions of a spectrum grouped into ion mobility bins (see filterByDrift_)
+    struct IonMobilityIndex
+    {
+      boost::weak_ptr<OpenSwath::Spectrum> spectrum; ///< the indexed spectrum
+      double im_min = 0.0; ///< lower ion mobility bound of the first bin
+      double bin_width = 1.0; ///< ion mobility width of a bin
+      std::vector<UInt> bin_start; ///< offset of each bin in positions, followed by positions.size() (empty if not built yet)
+      std::vector<UInt> positions; ///< peak positions ordered by bin, in ascending m/z order within a bin
+    };
+
+    /// Ion mobility indices of the most recently filtered spectra
+    std::vector<IonMobilityIndex> im_index_cache_;
+
+    /// Cache entry that is replaced next once the cache is full
+    Size im_index_next_ = 0;
+
+    /** @brief Returns the peaks of a spectrum within an ion mobility window
+     *
+     * Equivalent to checking drift_lower < im < drift_upper for every peak, but
+     * uses an ion mobility index of the spectrum so that only the bins
+     * overlapping the window are visited. The index is built the second time
+     * a spectrum is filtered and cached for the most recently used spectra, as
+     * the same spectrum is usually filtered several times while scoring a peak
+     * group.
+     *
+     * @param[in] input The spectrum (sorted by m/z) with an ion mobility array
+     * @param drift_lower Drift time lower extraction boundary (exclusive)
+     * @param drift_upper Drift time upper extraction boundary (exclusive)
+     *
+     * @return Spectrum with the m/z, intensity and ion mobility of all peaks in the window, sorted by m/z
+    */
+    OpenSwath::SpectrumPtr filterByDrift_(const OpenSwath::SpectrumPtr& input,
+                                          const double drift_lower,
+                                          const double drift_upper);
+
     /** @brief Returns an averaged spectrum
      *
      * This function will sum up (add) the intensities of multiple spectra
      * around the given retention time and return an "averaged" spectrum which
      * may contain less noise.
      *
+     * The most recently added up spectra are cached per thread (keyed by
+     * map, closest scan, number of spectra, ion mobility window and addition
+     * method), so peak groups with their apex at the same scan share the
+     * result. The returned spectrum must therefore not be modified.
+     *
      * @param[in] swath_map The map containing the spectra
      * @param[in] RT The target retention time
      * @param[in] nr_spectra_to_add How many spectra to add up
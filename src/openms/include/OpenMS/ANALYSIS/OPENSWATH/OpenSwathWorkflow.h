@@ -120,13 +120,8 @@ protected:
     /** @brief Constructor
      *
      *  @param use_ms1_traces Whether to use MS1 data
-     *  @param threads_outer_loop How many threads should be used for the outer
-     *  loop (-1 will use all threads in the outer loop)
-     *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
-     *
+     *  @param threads_outer_loop How many SWATH windows should be processed
+     *  (and held in memory) at the same time (-1 will not limit the number of windows)
      *
      **/
     OpenSwathWorkflowBase(bool use_ms1_traces, bool use_ms1_ion_mobility, bool prm, bool pasef, int threads_outer_loop) :
@@ -287,7 +282,8 @@ protected:
      * @param irt_mzml_out Output Chromatogram mzML containing the iRT peptides (if not empty,
      *        iRT chromatograms will be stored in this file)
      * @param sonar Whether the data is SONAR data
-     * @param load_into_memory Whether to cache the current SWATH map in memory
+     * @param load_into_memory Unused: the iRT chromatograms are extracted in a
+     *        single pass over each SWATH map, which is cheaper than caching the map
      *
     */
     TransformationDescription performRTNormalization(const OpenSwath::LightTargetedExperiment & irt_transitions,
@@ -352,7 +348,6 @@ protected:
      * @param chromatograms The extracted chromatograms (output)
      * @param trafo Transformation description for RT normalization
      * @param cp Parameter set for the chromatogram extraction
-     * @param load_into_memory Whether to cache the current SWATH map in memory
      * @param sonar Whether the data is SONAR data
      *
     */
@@ -361,8 +356,7 @@ protected:
                                      std::vector< OpenMS::MSChromatogram > & chromatograms,
                                      const TransformationDescription& trafo,
                                      const ChromExtractParams & cp,
-                                     bool sonar,
-                                     bool load_into_memory);
+                                     bool sonar);
 
     /** @brief Add two chromatograms
      *
@@ -414,14 +408,13 @@ protected:
      *
      *  @param use_ms1_traces Whether to use MS1 data
      *  @param use_ms1_ion_mobility Whether to use ion mobility extraction on MS1 traces
-     *  @param threads_outer_loop How many threads should be used for the outer
-     *  loop (-1 will use all threads in the outer loop)
+     *  @param threads_outer_loop How many SWATH windows should be processed
+     *  (and held in memory) at the same time (-1 will not limit the number of windows)
      *  @param prm Whether data is acquired in targeted DIA (e.g. PRM mode) with potentially overlapping windows
      *
-     *  @note The total number of threads should be divisible by this number
-     *  (e.g. use 8 in outer loop if you have 24 threads in total and 3 will be
-     *  used for the inner loop).
-     *
+     *  @note All threads work on the batches of the windows currently being
+     *  processed, so the total number of threads does not need to be a
+     *  multiple of this number.
      *
      **/
     OpenSwathWorkflow(bool use_ms1_traces, bool use_ms1_ion_mobility, bool prm, bool pasef, int threads_outer_loop) :
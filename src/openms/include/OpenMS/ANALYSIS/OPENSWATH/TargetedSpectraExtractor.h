@@ -505,6 +505,9 @@ protected:
     /// organize into a map by combining features and subordinates with the same `identifier`
     void organizeMapWithSameIdentifier(const OpenMS::FeatureMap& fmap_input, std::map<OpenMS::String, std::vector<OpenMS::Feature>>& fmapmap) const;
 
+    /// Calls pickSpectrum() for all @p spectra (in parallel); @p picked_spectra has the same size and order as @p spectra
+    void pickSpectra_(const std::vector<MSSpectrum>& spectra, std::vector<MSSpectrum>& picked_spectra) const;
+
   private:
     /**
       @brief Combines the functionalities given by all the other methods implemented
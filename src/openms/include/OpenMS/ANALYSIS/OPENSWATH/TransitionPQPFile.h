@@ -227,6 +227,15 @@ private:
     */
     void readPQPInput_(const char* filename, std::vector<TSVTransition>& transition_list, bool legacy_traml_id = false);
 
+    /** @brief Read PQP SQLite file and pass each transition to a callback
+     *
+     * @param filename The input file
+     * @param consume Called for every transition read
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     *
+    */
+    void readPQPInput_(const char* filename, const std::function<void(TSVTransition&)>& consume, bool legacy_traml_id = false);
+
     /** @brief Write a TargetedExperiment to a file
      *
      * @param filename Name of the output file
@@ -43,6 +43,9 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 
 #include <fstream>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace OpenMS
 {
@@ -221,6 +224,25 @@ protected:
     */
     void TSVToTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp);
 
+    /// Lookup structures for the incremental conversion of TSVTransitions into a LightTargetedExperiment
+    struct LightConversionState_
+    {
+      std::unordered_set<std::string> compound_ids; ///< Compounds (transition groups) already added
+      std::unordered_set<std::string> protein_ids; ///< Proteins already added
+      std::unordered_map<std::string, std::string> label_sequence; ///< Peptide sequence of the first transition of each peptide group label
+    };
+
+    /** @brief Add a single TSVTransition to a LightTargetedExperiment
+     *
+     * The transition is appended to @p exp, together with its compound and
+     * proteins if these are new. Mixed sequences within a peptide group label
+     * are resolved on the fly (see resolveMixedSequenceGroups_()). Adding all
+     * transitions of a list in order gives the same result as
+     * TSVToTargetedExperiment_(), without keeping the list in memory.
+     *
+    */
+    void addToLightTargetedExperiment_(TSVTransition& transition, OpenSwath::LightTargetedExperiment& exp, LightConversionState_& state);
+
     /// Convert an OpenMS transition to a TSVTransition for output writing
     TransitionTSVFile::TSVTransition convertTransition_(const ReactionMonitoringTransition* it, OpenMS::TargetedExperiment& targeted_exp);
     //@}
@@ -267,6 +289,34 @@ private:
     */
     void readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, std::vector<TSVTransition>& transition_list);
 
+    /** @brief Read tab or comma separated input and pass each transition to a callback
+     *
+     * @param filename The input file
+     * @param filetype The type of file ("mrm" or "tsv")
+     * @param consume Called for every transition read (in file order)
+     *
+    */
+    void readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, const std::function<void(TSVTransition&)>& consume);
+
+    /** @brief Parse a single line of tab or comma separated input
+     *
+     * Does not modify any state of the object and can be called concurrently.
+     *
+     * @param line The input line (without line ending)
+     * @param delimiter The column delimiter
+     * @param header_dict Mapping of column names to column indices
+     * @param filetype The type of file ("mrm" or "tsv")
+     * @param line_nr Line number (used as default transition name and in error messages)
+     * @param mytransition The parsed transition
+     * @param spectrast_legacy Set to true if a legacy SpectraST retention time was encountered
+     *
+     * @return False if the transition should be skipped (unannotated SpectraST transition)
+     *
+     * @throw Exception::IllegalArgument if the line does not match the header
+    */
+    bool parseTSVLine_(const std::string& line, char delimiter, const std::map<std::string, int>& header_dict,
+                       FileTypes::Type filetype, int line_nr, TSVTransition& mytransition, bool& spectrast_legacy);
+
     /// Extract retention time from a SpectraST comment string
     void spectrastRTExtract(const String str_inp, double & value, bool & spectrast_legacy);
 
@@ -310,11 +360,11 @@ private:
                                  const OpenMS::DataValue rt_value);
 
     /// Populate a new TargetedExperiment::Peptide object from a row in the csv
-    void createPeptide_(std::vector<TSVTransition>::const_iterator tr_it,
+    void createPeptide_(const TSVTransition& tr,
                         OpenMS::TargetedExperiment::Peptide& peptide);
 
     /// Populate a new TargetedExperiment::Compound object (a metabolite) from a row in the csv
-    void createCompound_(std::vector<TSVTransition>::const_iterator tr_it,
+    void createCompound_(const TSVTransition& tr,
                          OpenMS::TargetedExperiment::Compound& compound);
 
     /// Add a modification at the specified location
@@ -36,6 +36,8 @@
 
 #include <OpenMS/DATASTRUCTURES/Matrix.h>
 
+#include <map>
+
 // forward decl
 namespace Eigen
 {
@@ -73,13 +75,21 @@ public:
                                                                   const IsobaricQuantitationMethod* quant_method);
 
 private:
+    /// map index -> "channel_id" of the column headers of a ConsensusMap
+    typedef std::map<UInt64, Int> ChannelIdMap_;
+
+    /**
+     @brief Collects the channel id of every column header, so it is not looked up per feature.
+     */
+    static ChannelIdMap_ getChannelIds_(const ConsensusMap& cm);
+
     /**
      @brief Fills the input vector for the Eigen/NNLS step given the ConsensusFeature.
      */
     static void fillInputVector_(Eigen::VectorXd& b,
                                  Matrix<double>& m_b,
                                  const ConsensusFeature& cf,
-                                 const ConsensusMap& cm);
+                                 const ChannelIdMap_& channel_ids);
 
     /**
      @brief
@@ -101,6 +111,7 @@ private:
      */
     static float updateOutpuMap_(const ConsensusMap& consensus_map_in,
                                  ConsensusMap& consensus_map_out,
+                                 const ChannelIdMap_& channel_ids_out,
                                  Size current_cf,
                                  const Matrix<double>& m_x);
   };
@@ -39,8 +39,7 @@
 #include <OpenMS/KERNEL/Feature.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/TransformationModelLowess.h>
-#include <OpenMS/DATASTRUCTURES/KDTree.h>
-#include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureNode.h>
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
 
 namespace OpenMS
 {
@@ -51,8 +50,8 @@ class OPENMS_DLLAPI KDTreeFeatureMaps : public DefaultParamHandler
 
 public:
 
-  /// 2D tree on features
-  typedef KDTree::KDTree<2,KDTreeFeatureNode> FeatureKDTree;
+  /// 2D tree on features (RT, m/z)
+  typedef StaticKDTree<2> FeatureKDTree;
 
   /// Default constructor
   KDTreeFeatureMaps() :
@@ -93,7 +92,7 @@ public:
     optimizeTree();
   }
 
-  /// Add feature
+  /// Add feature (searched linearly until the next optimizeTree())
   void addFeature(Size mt_map_index, const BaseFeature* feature);
 
   /// Return pointer to feature i
@@ -126,13 +125,20 @@ public:
   /// Clear all data
   void clear();
 
-  /// Optimize the kD tree
+  /// (Re-)build the kD tree from all features, e.g. after adding features or applying RT transformations
   void optimizeTree();
 
   /// Fill @p result with indices of all features compatible (wrt. RT, m/z, map index) to the feature with @p index
   void getNeighborhood(Size index, std::vector<Size>& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map = false, double max_pairwise_log_fc = -1.0) const;
 
-  /// Fill @p result with indices of all features within the specified boundaries
+  /**
+    @brief Batched getNeighborhood() for all features: @p result_indices[i] holds the neighbors of feature i
+
+    The neighborhoods are computed in parallel if OpenMP is enabled.
+  */
+  void getNeighborhoods(std::vector<std::vector<Size> >& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map = false, double max_pairwise_log_fc = -1.0) const;
+
+  /// Fill @p result with (ascending) indices of all features within the specified boundaries
   void queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, std::vector<Size>& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const;
 
   /// Apply RT transformations
@@ -157,6 +163,9 @@ protected:
   /// 2D tree on features from all input maps.
   FeatureKDTree kd_tree_;
 
+  /// Features added since the last optimizeTree(), not yet in kd_tree_
+  std::vector<Size> pending_;
+
 };
 }
 
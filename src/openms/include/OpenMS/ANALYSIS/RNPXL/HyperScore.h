@@ -38,6 +38,7 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 #include <vector>
 
 namespace OpenMS
@@ -84,8 +85,30 @@ struct OPENMS_DLLAPI HyperScore
                         PSMDetail& d
                        );
 
+  /** @brief compute the HyperScore of many candidates against one experimental spectrum
+   *
+   *  The experimental peaks are extracted once into contiguous arrays and each candidate is matched with
+   *  a tight loop over them. Candidates are given as fragment ion ladders (see
+   *  TheoreticalSpectrumGenerator::getFragmentIons()) with unit intensity, so no annotation strings need
+   *  to be inspected. Matching (closest experimental peak per fragment) and scores are identical to
+   *  computeWithDetail() with the corresponding annotated theoretical spectrum.
+   *
+   * @param fragment_mass_tolerance mass tolerance applied left and right of the theoretical peak position
+   * @param fragment_mass_tolerance_unit_ppm Unit of the mass tolerance is: Thomson if false, ppm if true
+   * @param exp_spectrum measured spectrum (sorted by m/z)
+   * @param theo_ions fragment ions of each candidate (sorted by m/z)
+   * @param scores HyperScore of each candidate (0 if nothing matched)
+   * @param details match details of each candidate
+   */
+  static void computeBatch(double fragment_mass_tolerance,
+                           bool fragment_mass_tolerance_unit_ppm,
+                           const PeakSpectrum& exp_spectrum,
+                           const std::vector<std::vector<TheoreticalSpectrumGenerator::FragmentIon> >& theo_ions,
+                           std::vector<double>& scores,
+                           std::vector<PSMDetail>& details);
+
   private:
-    /// helper to compute the log factorial
+    /// helper to compute the log factorial (sums precomputed logarithms)
     static double logfactorial_(const int x, int base = 2);
 };
 
@@ -38,6 +38,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
+#include <vector>
+
 namespace OpenMS
 {
 
@@ -64,6 +66,18 @@ struct OPENMS_DLLAPI MorpheusScore
                         bool fragment_mass_tolerance_unit_ppm, 
                         const PeakSpectrum& exp_spectrum, 
                         const PeakSpectrum& theo_spectrum);
+
+  /**
+   *  @brief Scores several theoretical spectra against the same experimental spectrum.
+   *
+   *  Peak positions and the total ion current of @p exp_spectrum are determined only once.
+   *  Results are identical to calling compute() for each theoretical spectrum.
+   */
+  static void computeBatch(double fragment_mass_tolerance,
+                           bool fragment_mass_tolerance_unit_ppm,
+                           const PeakSpectrum& exp_spectrum,
+                           const std::vector<const PeakSpectrum*>& theo_spectra,
+                           std::vector<Result>& results);
 };
 
 }
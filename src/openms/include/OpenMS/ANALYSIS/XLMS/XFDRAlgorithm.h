@@ -42,6 +42,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/MATH/STATISTICS/Histogram.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
 
@@ -122,7 +124,7 @@ private:
      * @brief xprophet  method for target hits counting as implemented in xProphet
      * @param cum_histograms Cumulative score distributions
      */
-    void fdr_xprophet_(std::map< String, Math::Histogram<> >& cum_histograms,
+    void fdr_xprophet_(const std::map< String, Math::Histogram<> >& cum_histograms,
                       const String& targetclass, const String& decoyclass, const String& fulldecoyclass,
                       std::vector< double >& fdr, bool mono) const;
 
@@ -175,12 +177,11 @@ private:
     Int min_score_;
     Int max_score_;
 
-    // unique top hits
-    std::vector<String> unique_ids_;
-    std::vector<double> unique_id_scores_;
+    // unique top hits: maps the candidate ID to its highest score
+    std::unordered_map<String, double> unique_id_scores_;
 
-    // maps index of peptide id all_pep_ids_ to vector of cross link class
-    std::map<String, std::vector<String>> cross_link_classes_;
+    // maps the candidate ID to vector of cross link class
+    std::unordered_map<String, std::vector<String>> cross_link_classes_;
 
     // Program arguments
     String decoy_string_;
@@ -0,0 +1,144 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
+#include <functional>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Chains processing steps on shared in-memory data, without intermediate files
+
+    Running several TOPP tools in a row writes and parses the same data once per tool. A
+    ProcessingPipeline instead passes one ProcessingPipeline::Data object through a list of steps,
+    each of which reads and replaces the members it works on (e.g. peak picking on @p experiment,
+    feature finding from @p experiment into @p features).
+
+    There are two kinds of steps:
+    - data steps (addStep()) get the whole Data object and may call any algorithm class;
+    - spectrum steps (addSpectrumStep()) transform one spectrum at a time. Consecutive spectrum steps
+      are fused into a single parallel (OpenMP) pass over the experiment, so every spectrum is
+      touched only once while it is hot in the cache. If the pipeline is run on an mzML file, the
+      leading spectrum steps are even applied while the file is being parsed (see MSDataParallelTransformingConsumer).
+
+    Each step is run in its own Profiler scope (named like the step), so a pipeline run inside a
+    TOPP tool with @p -profile reports the time and memory of every step.
+
+    @code
+    PeakPickerHiRes pp;
+    ProcessingPipeline pipeline;
+    pipeline.addSpectrumStep("pick", [&pp](MSSpectrum& s) { MSSpectrum picked; pp.pick(s, picked); s = std::move(picked); })
+            .addSpectrumStep("denoise", [](MSSpectrum& s) { ThresholdMower tm; tm.filterPeakSpectrum(s); })
+            .addStep("features", [](ProcessingPipeline::Data& d) { runFeatureFinder(d.experiment, d.features); });
+    ProcessingPipeline::Data data;
+    pipeline.run("input.mzML", data);
+    @endcode
+
+    @note Spectrum steps are called concurrently from several threads and must be thread-safe
+          (copy stateful algorithm objects inside the function). If a step throws, the exception
+          of the first failing spectrum (in order of the experiment) is rethrown after the pass.
+  */
+  class OPENMS_DLLAPI ProcessingPipeline
+  {
+  public:
+    /// The data passed from step to step
+    struct Data
+    {
+      PeakMap experiment;
+      FeatureMap features;
+      ConsensusMap consensus;
+      std::vector<ProteinIdentification> proteins;
+      std::vector<PeptideIdentification> peptides;
+    };
+
+    /// A step working on the whole data
+    typedef std::function<void (Data&)> DataStep;
+
+    /// A step transforming a single spectrum (must be thread-safe)
+    typedef std::function<void (MSSpectrum&)> SpectrumStep;
+
+    /// Appends a step working on the whole data
+    ProcessingPipeline& addStep(const String& name, DataStep step);
+
+    /// Appends a step transforming every spectrum of Data::experiment
+    ProcessingPipeline& addSpectrumStep(const String& name, SpectrumStep step);
+
+    /// Returns the number of steps
+    Size size() const;
+
+    /// Returns the names of all steps (in order)
+    std::vector<String> getStepNames() const;
+
+    /// Runs all steps in order on @p data
+    void run(Data& data) const;
+
+    /**
+      @brief Loads @p mzml_file into Data::experiment and runs all steps
+
+      Spectrum steps at the beginning of the pipeline are applied while the file is being parsed.
+
+      @exception Exception::FileNotFound and other exceptions of MzMLFile are passed on
+    */
+    void run(const String& mzml_file, Data& data) const;
+
+  protected:
+    struct Step_
+    {
+      String name;
+      DataStep data_step; ///< set for data steps
+      SpectrumStep spectrum_step; ///< set for spectrum steps
+    };
+
+    /// Runs the steps from index @p first on
+    void runFrom_(Size first, Data& data) const;
+
+    /// Index of the first data step at or after @p first (size() if there is none)
+    Size endOfSpectrumSteps_(Size first) const;
+
+    /// Applies the spectrum steps [@p first, @p last) to @p s
+    void applySpectrumSteps_(Size first, Size last, MSSpectrum& s) const;
+
+    /// Name of the fused spectrum steps [@p first, @p last), e.g. "pick+denoise"
+    String fusedName_(Size first, Size last) const;
+
+    std::vector<Step_> steps_;
+  };
+}
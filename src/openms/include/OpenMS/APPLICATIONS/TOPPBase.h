@@ -190,15 +190,23 @@ public:
     /// Destructor
     virtual ~TOPPBase();
 
-    /// Main routine of all TOPP applications
+    /**
+      @brief Main routine of all TOPP applications
+
+      Besides a regular invocation, the tool can be kept resident with '-batch <file>': every non-empty line
+      of @p file (or of stdin if @p file is '-') holds the command line arguments of one job, which are processed
+      in turn by the same tool instance. This avoids paying process start-up, library loading and database
+      initialization for every single (small) input. Lines starting with '#' are ignored; arguments containing
+      spaces must be double-quoted. All jobs are run and the exit code of the first failed job is returned.
+    */
     ExitCodes main(int argc, const char** argv);
 
     /**
       @brief Sets the maximal number of usable threads
 
-      @param num_threads The number of threads that should be usable.
+      Sets the thread budget shared by %OpenMP and the TaskPool (see TaskPool::setThreadBudget()).
 
-      @note This method only works if %OpenMS is compiled with %OpenMP support.
+      @param num_threads The number of threads that should be usable.
     */
     static void setMaxNumberOfThreads(int num_threads);
 
@@ -255,6 +263,12 @@ private:
     */
     void enableLogging_() const;
 
+    /// Parses the given command line (registration must be done already) and runs the tool (main_) once
+    ExitCodes runCommandLine_(int argc, const char** argv);
+
+    /// Runs one job per line of @p batch_file ('-' for stdin), see main()
+    ExitCodes runBatch_(const String& batch_file);
+
     /// Storage location for parameter information
     std::vector<ParameterInformation> parameters_;
 
@@ -528,6 +528,26 @@ protected:
     /// supplementing/deduction of the sequence to its ionic form.
     double getMonoWeight(Residue::ResidueType type = Residue::Full, Int charge = 0) const;
 
+    /**
+      @brief returns the mono isotopic weights of all prefixes in the given ionic form
+
+      Entry @em i is the weight of getPrefix(i + 1), i.e. <tt>getPrefix(i + 1).getMonoWeight(type, charge)</tt>,
+      but all weights are computed in a single pass over the sequence.
+
+      @throws Exception::InvalidValue if the sequence contains the unknown residue 'X' (without mass)
+    */
+    std::vector<double> getPrefixMonoWeights(Residue::ResidueType type = Residue::Full, Int charge = 0) const;
+
+    /**
+      @brief returns the mono isotopic weights of all suffixes in the given ionic form
+
+      Entry @em i is the weight of getSuffix(i + 1), i.e. <tt>getSuffix(i + 1).getMonoWeight(type, charge)</tt>,
+      but all weights are computed in a single pass over the sequence.
+
+      @throws Exception::InvalidValue if the sequence contains the unknown residue 'X' (without mass)
+    */
+    std::vector<double> getSuffixMonoWeights(Residue::ResidueType type = Residue::Full, Int charge = 0) const;
+
     /// returns mass-to-charge ratio of the peptide in the given ionic form
     /// @note will not (and cannot) control whether the required ion can exist
     /// (e.g. x/c ions for monomers) as it does not do fragmentation but rather
@@ -694,6 +714,9 @@ protected:
 
     static void parseString_(const String& peptide, AASequence& aas,
                              bool permissive = true);
+
+    /// mono isotopic weight that turns the internal residues of a sequence into the given ionic form
+    static double internalToIonMonoWeight_(Residue::ResidueType type);
   };
 
   OPENMS_DLLAPI std::ostream& operator<<(std::ostream& os, const AASequence& peptide);
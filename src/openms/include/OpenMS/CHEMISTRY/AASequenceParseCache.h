@@ -0,0 +1,120 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  /**
+    @brief Thread-safe LRU cache of parsed amino acid sequences
+
+    Identification files usually contain the same peptide many times (one
+    hit per spectrum). Parsing the string notation, especially with
+    modifications, is costly compared to copying an AASequence. This cache
+    keeps the parse results of the @p capacity most recently used strings.
+
+    Parsing happens outside of the lock, so concurrent misses for different
+    strings do not block each other. Strings that cannot be parsed are not
+    cached (the exception is passed on).
+
+    Copies of a cache start empty (with the same capacity).
+
+    @ingroup Chemistry
+  */
+  class OPENMS_DLLAPI AASequenceParseCache
+  {
+public:
+    /// Constructor (a capacity of 0 disables caching)
+    explicit AASequenceParseCache(Size capacity = 10000);
+
+    /// Copy constructor (the copy is empty)
+    AASequenceParseCache(const AASequenceParseCache& rhs);
+
+    /// Assignment operator (clears the cache and takes over the capacity)
+    AASequenceParseCache& operator=(const AASequenceParseCache& rhs);
+
+    /**
+      @brief Returns the parsed sequence of @p s (see AASequence::fromString())
+
+      @throws Exception::ParseError if an invalid string representation of an AA sequence is passed
+    */
+    AASequence fromString(const String& s, bool permissive = true);
+
+    /// Number of cached sequences
+    Size size() const;
+
+    /// Maximum number of cached sequences
+    Size getCapacity() const;
+
+    /// Number of lookups answered from the cache
+    Size getHits() const;
+
+    /// Number of lookups that had to parse
+    Size getMisses() const;
+
+    /// Removes all cached sequences and resets the statistics
+    void clear();
+
+protected:
+    /// cache key: string and parsing mode
+    typedef std::pair<String, bool> KeyType;
+
+    /// hash of KeyType
+    struct KeyHash
+    {
+      std::size_t operator()(const KeyType& key) const;
+    };
+
+    typedef std::list<std::pair<KeyType, AASequence> > ListType;
+
+    /// maximum number of entries
+    Size capacity_;
+    /// entries, most recently used first
+    ListType lru_;
+    /// lookup of entries by key
+    std::unordered_map<KeyType, ListType::iterator, KeyHash> index_;
+    /// cache hits
+    Size hits_ = 0;
+    /// cache misses
+    Size misses_ = 0;
+    /// guards all members except capacity_
+    mutable std::mutex mutex_;
+  };
+
+} // namespace OpenMS
@@ -41,6 +41,9 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+
 namespace OpenMS
 {
   class String;
@@ -85,8 +88,12 @@ namespace OpenMS
   {
 
 protected:
-	  /// Internal typedef for the used map type
-	  typedef std::map<const Element*, SignedSize> MapType_;
+    /// Number of elements stored without an additional allocation (enough for CHNOPS and a few more)
+    static constexpr Size INLINE_ELEMENTS = 8;
+
+    /// Internal typedef for the used map type: sorted flat storage, small formulae live inside the EmpiricalFormula itself
+    typedef boost::container::flat_map<const Element*, SignedSize, std::less<const Element*>,
+                                       boost::container::small_vector<std::pair<const Element*, SignedSize>, INLINE_ELEMENTS> > MapType_;
 
 public:
     /** @name Typedefs
@@ -308,11 +315,14 @@ protected:
     /// remove elements with count 0
     void removeZeroedElements_();
 
+    /// adds @p factor times the element counts of @p rhs to @p lhs (single merge pass over both sorted ranges), dropping zero counts
+    static void addScaled_(MapType_& lhs, const MapType_& rhs, SignedSize factor);
+
     MapType_ formula_;
 
     Int charge_;
 
-    Int parseFormula_(std::map<const Element*, SignedSize>& ef, const String& formula) const;
+    Int parseFormula_(MapType_& ef, const String& formula) const;
 
   };
 
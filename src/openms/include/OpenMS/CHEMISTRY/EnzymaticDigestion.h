@@ -148,6 +148,34 @@ public:
      */
     Size digestUnmodified(const StringView& sequence, std::vector<std::pair<Size,Size>>& output, Size min_length = 1, Size max_length = 0) const;
 
+    /**
+     @brief Performs the enzymatic digestion of an unmodified sequence and streams the products to a callback.
+
+     Yields the same products in the same order as the StringView output version of this function, but no output
+     container is built: @p product is called with the start position and the length of each product in @p sequence.
+
+     @param sequence Sequence to digest
+     @param product Called for each digestion product with its start position and length
+     @param min_length Minimal length of reported products
+     @param max_length Maximal length of reported products (0 = no restriction)
+     @return Number of discarded digestion products (which are not matching length restrictions)
+     */
+    Size digestUnmodified(const StringView& sequence, const std::function<void(Size, Size)>& product, Size min_length = 1, Size max_length = 0) const;
+
+    /**
+     @brief Digests many unmodified sequences in parallel (if OpenMP is enabled).
+
+     For each sequence the products are reported as pairs of start position and length (in the order of the
+     streaming version of this function). The result does not depend on the number of threads.
+
+     @param sequences Sequences to digest
+     @param output Digestion products of each sequence
+     @param min_length Minimal length of reported products
+     @param max_length Maximal length of reported products (0 = no restriction)
+     @return Number of discarded digestion products (which are not matching length restrictions)
+     */
+    Size digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size,Size>>>& output, Size min_length = 1, Size max_length = 0) const;
+
     /**
     @brief Is the peptide fragment starting at position @p pep_pos with length @p pep_length within the sequence @p protein generated by the current enzyme?
 
@@ -36,6 +36,8 @@
 
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternGenerator.h>
 
+#include <vector>
+
 namespace OpenMS
 {
 
@@ -164,6 +166,15 @@ namespace OpenMS
       **/
     IsotopeDistribution run(const EmpiricalFormula&) const override;
 
+    /**
+      * @brief Creates isotope distributions for many sum formulas (in parallel)
+      *
+      * Returns the same as run() for each formula, but converts the isotope
+      * tables of the elements only once (see IsoSpecBatchGenerator).
+      *
+      **/
+    std::vector<IsotopeDistribution> run(const std::vector<EmpiricalFormula>& formulas) const;
+
     /// Set probability stop condition (lower values generate fewer results)
     void setThreshold(double stop_condition)
     {
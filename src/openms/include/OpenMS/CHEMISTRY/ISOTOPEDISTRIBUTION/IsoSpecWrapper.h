@@ -36,6 +36,8 @@
 
 #include <vector>
 #include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Constants.h>
@@ -505,5 +507,63 @@ protected:
 
   };
 
+  /**
+    * @brief Reusable fine isotope pattern generator for many formulas
+    *
+    * IsoSpecThresholdWrapper and IsoSpecTotalProbWrapper convert the isotope
+    * table of every element into IsoSpec input again for each formula. This
+    * class converts each element once and keeps the tables for all later
+    * formulas, which pays off when computing patterns for large (e.g.
+    * metabolite) libraries. Many formulas can be evaluated in parallel
+    * (OpenMP) with run(const std::vector<EmpiricalFormula>&).
+    *
+    * Stop conditions have the same meaning as in FineIsotopePatternGenerator
+    * and results are identical to FineIsotopePatternGenerator::run(), i.e.
+    * sorted by mass.
+    *
+    * @note The element tables are taken from the Element objects on first
+    *       use; elements must not be changed in ElementDB while this object
+    *       is in use.
+    */
+  class OPENMS_DLLAPI IsoSpecBatchGenerator
+  {
+public:
+    /**
+      * @brief Constructor
+      *
+      * @param stop_condition The total probability which may remain unexplained (if use_total_prob == true) or
+      *        the intensity threshold (if use_total_prob is false)
+      * @param use_total_prob Whether to stop by covered total probability or by intensity threshold
+      * @param absolute Whether the threshold is absolute or relative to the most intense peak (ignored if use_total_prob is true)
+      **/
+    explicit IsoSpecBatchGenerator(double stop_condition = 0.01, bool use_total_prob = true, bool absolute = false);
+
+    /// Fine isotope pattern of @p formula (thread safe)
+    IsotopeDistribution run(const EmpiricalFormula& formula);
+
+    /// Fine isotope patterns of all @p formulas, computed in parallel
+    std::vector<IsotopeDistribution> run(const std::vector<EmpiricalFormula>& formulas);
+
+protected:
+    /// IsoSpec input of a single element: masses and probabilities of its isotopes with non-zero abundance
+    struct ElementTable_
+    {
+      std::vector<double> masses;
+      std::vector<double> probabilities;
+    };
+
+    /// returns the (cached) table of @p element
+    const ElementTable_& getElementTable_(const Element* element);
+
+    double stop_condition_;
+    bool use_total_prob_;
+    bool absolute_;
+
+    /// element tables converted so far
+    std::unordered_map<const Element*, ElementTable_> tables_;
+    /// guards tables_
+    std::shared_mutex mutex_;
+  };
+
 }
 
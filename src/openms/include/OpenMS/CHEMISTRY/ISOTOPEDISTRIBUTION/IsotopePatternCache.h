@@ -0,0 +1,152 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Maintainer: Chris Bielow $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Thread-safe LRU cache of coarse isotope patterns
+
+    Feature finders and accurate mass search evaluate the isotope pattern of
+    many candidates whose (estimated) sum formulae are identical: the
+    averagine estimates of CoarseIsotopePatternGenerator round atom counts,
+    so all masses within roughly one Dalton map to the same formula. This
+    cache stores the result of CoarseIsotopePatternGenerator::run() per
+    formula and generator setting (maximal isotope, mass rounding) for the
+    @p capacity most recently used keys.
+
+    Results are identical to calling CoarseIsotopePatternGenerator directly.
+    Patterns are computed outside of the lock, so concurrent misses do not
+    block each other. The batch functions compute all patterns of a vector
+    in parallel (OpenMP).
+
+    A process-wide instance is available via getInstance(). Copies of a
+    cache start empty (with the same capacity).
+
+    @ingroup Chemistry
+  */
+  class OPENMS_DLLAPI IsotopePatternCache
+  {
+public:
+    /// Constructor (a capacity of 0 disables caching)
+    explicit IsotopePatternCache(Size capacity = 10000);
+
+    /// Copy constructor (the copy is empty)
+    IsotopePatternCache(const IsotopePatternCache& rhs);
+
+    /// Assignment operator (clears the cache and takes over the capacity)
+    IsotopePatternCache& operator=(const IsotopePatternCache& rhs);
+
+    /// returns a pointer to the shared instance (thread safe)
+    static IsotopePatternCache* getInstance();
+
+    /// Isotope pattern of @p formula (see CoarseIsotopePatternGenerator::run())
+    IsotopeDistribution run(const EmpiricalFormula& formula, Size max_isotope = 0, bool round_masses = false);
+
+    /// Isotope patterns of all @p formulas, computed in parallel
+    std::vector<IsotopeDistribution> run(const std::vector<EmpiricalFormula>& formulas, Size max_isotope = 0, bool round_masses = false);
+
+    /// Averagine isotope pattern of a peptide (see CoarseIsotopePatternGenerator::estimateFromPeptideWeight())
+    IsotopeDistribution estimateFromPeptideWeight(double average_weight, Size max_isotope = 0, bool round_masses = false);
+
+    /// Averagine isotope patterns of peptides with the given @p average_weights, computed in parallel
+    std::vector<IsotopeDistribution> estimateFromPeptideWeights(const std::vector<double>& average_weights, Size max_isotope = 0, bool round_masses = false);
+
+    /// Averagine isotope pattern of RNA (see CoarseIsotopePatternGenerator::estimateFromRNAWeight())
+    IsotopeDistribution estimateFromRNAWeight(double average_weight, Size max_isotope = 0, bool round_masses = false);
+
+    /// Averagine isotope pattern of DNA (see CoarseIsotopePatternGenerator::estimateFromDNAWeight())
+    IsotopeDistribution estimateFromDNAWeight(double average_weight, Size max_isotope = 0, bool round_masses = false);
+
+    /// Number of cached patterns
+    Size size() const;
+
+    /// Maximum number of cached patterns
+    Size getCapacity() const;
+
+    /// Number of lookups answered from the cache
+    Size getHits() const;
+
+    /// Number of lookups that had to compute the pattern
+    Size getMisses() const;
+
+    /// Removes all cached patterns and resets the statistics
+    void clear();
+
+protected:
+    /// cache key: formula and generator settings
+    struct Key
+    {
+      EmpiricalFormula formula;
+      Size max_isotope;
+      bool round_masses;
+
+      bool operator==(const Key& rhs) const;
+    };
+
+    /// hash of Key
+    struct KeyHash
+    {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    typedef std::list<std::pair<Key, IsotopeDistribution> > ListType;
+
+    /// pattern of the formula estimated for @p average_weight from the given average composition
+    IsotopeDistribution estimateFromWeightAndComp_(double average_weight, double C, double H, double N, double O, double S, double P, Size max_isotope, bool round_masses);
+
+    /// maximum number of entries
+    Size capacity_;
+    /// entries, most recently used first
+    ListType lru_;
+    /// lookup of entries by key
+    std::unordered_map<Key, ListType::iterator, KeyHash> index_;
+    /// cache hits
+    Size hits_ = 0;
+    /// cache misses
+    Size misses_ = 0;
+    /// guards all members except capacity_
+    mutable std::mutex mutex_;
+  };
+
+} // namespace OpenMS
@@ -127,6 +127,24 @@ public:
       */
       decomposition_value_type getNumberOfDecompositions(value_type mass) override;
 
+      /**
+        Calls @p sink for every possible decomposition of @p mass without
+        storing them (same order as getAllDecompositions()).
+
+        The decomposer is not modified, so several threads may use the same
+        decomposer (and its extended residue table) concurrently.
+
+        @param mass Mass to be decomposed.
+        @param sink Callable taking a <tt>const decomposition_type&</tt>; the
+               decomposition is only valid during the call.
+      */
+      template <typename Sink>
+      void visitAllDecompositions(value_type mass, Sink & sink) const
+      {
+        decomposition_type decomposition(alphabet_.size());
+        visitDecompositionsRecursively_(mass, alphabet_.size() - 1, decomposition, sink);
+      }
+
 private:
 
       /**
@@ -188,15 +206,19 @@ private:
                                      witness_vector_type & _witness_vector, residues_table_type & _ertable);
 
       /**
-        Collects decompositions for @c mass by recursion.
+        Passes decompositions for @c mass to @c sink by recursion.
+
+        Each step of the recursion only sets the entries up to @p alphabetMassIndex,
+        so a single @p decomposition buffer is shared by all steps.
 
         @param mass Mass to be decomposed.
         @param alphabetMassIndex An index of the mass in alphabet that is used on this step of recursion.
         @param decomposition Decomposition which is calculated on this step of recursion.
-        @param decompositionsStore Container where decompositions are collected.
+        @param sink Callable which receives the complete decompositions.
       */
-      void collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                             decomposition_type decomposition, decompositions_type & decompositionsStore);
+      template <typename Sink>
+      void visitDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
+                                           decomposition_type & decomposition, Sink & sink) const;
     };
 
 
@@ -463,15 +485,16 @@ private:
     IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass)
     {
       decompositions_type decompositionsStore;
-      decomposition_type decomposition(alphabet_.size());
-      collectDecompositionsRecursively_(mass, alphabet_.size() - 1, decomposition, decompositionsStore);
+      auto store = [&decompositionsStore](const decomposition_type & decomposition) { decompositionsStore.push_back(decomposition); };
+      visitAllDecompositions(mass, store);
       return decompositionsStore;
     }
 
     template <typename ValueType, typename DecompositionValueType>
+    template <typename Sink>
     void IntegerMassDecomposer<ValueType, DecompositionValueType>::
-    collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                      decomposition_type decomposition, decompositions_type & decompositionsStore)
+    visitDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
+                                    decomposition_type & decomposition, Sink & sink) const
     {
       if (alphabetMassIndex == 0)
       {
@@ -479,7 +502,7 @@ private:
         if (numberOfMasses0 * alphabet_.getWeight(0) == mass)
         {
           decomposition[0] = static_cast<decomposition_value_type>(numberOfMasses0);
-          decompositionsStore.push_back(decomposition);
+          sink(static_cast<const decomposition_type &>(decomposition));
         }
         return;
       }
@@ -515,7 +538,7 @@ private:
             // the condition of the 'for' loop (m >= r) and decrementing the mass
             // in steps of the lcm ensures that m is decomposable. Therefore
             // the recursion will result in at least one witness.
-            collectDecompositionsRecursively_(m, alphabetMassIndex - 1, decomposition, decompositionsStore);
+            visitDecompositionsRecursively_(m, alphabetMassIndex - 1, decomposition, sink);
             decomposition[alphabetMassIndex] += mass_in_lcm;
             // this check is needed because mass could have unsigned type and after reduction on i*alphabetMass will be still be positive but huge
             // and that will end up in infinite loop
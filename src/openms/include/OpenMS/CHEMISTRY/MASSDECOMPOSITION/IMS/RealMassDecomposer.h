@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <utility>
 #include <map>
 #include <memory>
@@ -111,6 +112,42 @@ public:
       */
       number_of_decompositions_type getNumberOfDecompositions(double mass, double error);
 
+      /**
+        Calls @p callback for every decomposition of @p mass with an @p error
+        allowed, without collecting them in a container (same decompositions
+        and order as getDecompositions(double,double)).
+
+        The decomposer is not modified, so one decomposer can be shared by
+        several threads.
+
+        @param mass Mass to be decomposed.
+        @param error Error allowed between given and result decomposition.
+        @param callback Callable taking a <tt>const integer_decomposer_type::decomposition_type&</tt>
+      */
+      template <typename Callback>
+      void forEachDecomposition(double mass, double error, Callback && callback) const
+      {
+        // defines the range of integers to be decomposed
+        integer_value_type start_integer_mass = static_cast<integer_value_type>(
+          ceil((1 + rounding_errors_.first) * (mass - error) / precision_));
+        integer_value_type end_integer_mass = static_cast<integer_value_type>(
+          floor((1 + rounding_errors_.second) * (mass + error) / precision_));
+
+        // only decompositions whose real mass lies in [mass-error; mass+error] are passed on
+        auto filter = [&](const integer_decomposer_type::decomposition_type & decomposition)
+        {
+          if (fabs(weights_.getParentMass(decomposition) - mass) <= error)
+          {
+            callback(decomposition);
+          }
+        };
+        for (integer_value_type integer_mass = start_integer_mass;
+             integer_mass < end_integer_mass; ++integer_mass)
+        {
+          decomposer_->visitAllDecompositions(integer_mass, filter);
+        }
+      }
+
 private:
       /// Weights over which values/masses to be decomposed.
       Weights weights_;
@@ -66,6 +66,9 @@ public:
 
     /// constructor with String as parameter
     explicit MassDecomposition(const String& deco);
+
+    /// constructor from amino acids and their frequencies (entries with frequency 0 are ignored)
+    explicit MassDecomposition(const std::map<char, Size>& deco);
     //@}
 
     /**
@@ -50,6 +50,9 @@
 #pragma warning( pop )
 #endif
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace OpenMS
@@ -86,16 +89,53 @@ public:
     */
     //@{
     /// returns the possible decompositions given the weight
-    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight);
+    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight) const;
+
+    /// returns the possible decompositions given the weight, using @p tolerance instead of the "tolerance" parameter
+    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight, double tolerance) const;
+
+    /**
+      @brief returns the possible decompositions of all given weights
+
+      The weights are decomposed in parallel, sharing one precomputed
+      residue table. @p decomps[i] holds the decompositions of @p weights[i].
+    */
+    void getDecompositions(std::vector<std::vector<MassDecomposition> > & decomps, const std::vector<double> & weights) const;
+
+    /**
+      @brief calls @p callback for each possible decomposition of @p weight within @p tolerance
+
+      The decompositions are passed on as they are found, i.e. they are never
+      stored together. This function is thread safe and may be called
+      concurrently (e.g. for different weights).
+    */
+    void forEachDecomposition(double weight, double tolerance, const std::function<void(const MassDecomposition &)> & callback) const;
     //@}
 
 protected:
+    /// amino acids (including modified ones) and their masses, the decomposer is built from
+    typedef std::map<char, double> AlphabetType;
+
+    /// returns the decomposer for @p alphabet and @p precision; shared by all instances using the same parameters
+    static std::shared_ptr<const ims::RealMassDecomposer> getSharedDecomposer_(const AlphabetType & alphabet, double precision);
+
 
     void updateMembers_() override;
 
     ims::IMSAlphabet * alphabet_;
 
-    ims::RealMassDecomposer * decomposer_;
+    /// decomposer holding the (read-only) extended residue table
+    std::shared_ptr<const ims::RealMassDecomposer> decomposer_;
+
+    /// one letter code of each alphabet entry (index as in alphabet_)
+    std::vector<char> names_;
+
+    /// alphabet and precision of decomposer_ (the table is only rebuilt if these change)
+    AlphabetType current_alphabet_;
+    double current_precision_;
+
+    /// value of the "tolerance" parameter
+    double tolerance_;
 
 private:
 
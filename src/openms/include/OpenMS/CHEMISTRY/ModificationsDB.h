@@ -40,6 +40,7 @@
 
 #include <set>
 #include <memory>  // unique_ptr
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace OpenMS
@@ -71,6 +72,11 @@ namespace OpenMS
       databases. This can be done by providing a path through
       initializeModificationsDB(), however it is important that this is done
       *before* the first call to getInstance().
+
+      All queries are thread-safe. Lookups share a lock and only adding
+      modifications takes it exclusively, so parallel searches do not
+      serialize each other. Searches by mass difference use an index sorted
+      by mass instead of scanning all modifications.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -247,6 +253,18 @@ public:
     /// Stores the mappings of (unique) names to the modifications
     std::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
+    /// Monoisotopic mass difference and index (in mods_) of all modifications, sorted by mass (for delta mass searches)
+    std::vector<std::pair<double, Size> > mass_index_;
+
+    /// Guards the modifications and lookup tables (shared for lookups, exclusive for adding modifications)
+    mutable std::shared_mutex mutex_;
+
+    /// Collects the indices (in mods_, ascending) of all modifications within @p max_error of @p mass that match @p res and @p term_spec (caller needs to hold the lock)
+    void findByDiffMonoMass_(std::vector<Size>& indices, double mass, double max_error, char res, ResidueModification::TermSpecificity term_spec) const;
+
+    /// Adds the modification at @p index in mods_ to the mass index (caller needs to hold the exclusive lock)
+    void addToMassIndex_(Size index);
+
     /** @brief Helper function to check if a residue matches the origin for a modification
      *
      * Special cases are handled as follows:
@@ -82,7 +82,100 @@ namespace OpenMS
      std::vector<AASequence>& all_modified_peptides, 
      bool keep_original=true);
 
+    /**
+      @brief Lazily enumerates the variants created by applyVariableModifications()
+
+      Variants are visited in the same order as in the output of applyVariableModifications() and getIndex()
+      reports the position a variant has there. The monoisotopic weight and the placed modifications of each
+      variant are available without creating an AASequence, so candidates can be pruned by mass (see
+      setMassRange()) before getPeptide() materializes them. Only the precomputed @p var_mods lookup is
+      accessed, so (unlike AASequence::fromString()) no lock on ResidueDB is required.
+
+      @note @p var_mods and @p peptide are referenced and must outlive the enumerator.
+    */
+    class OPENMS_DLLAPI VariableModificationEnumerator
+    {
+    public:
+      /// site index of modifications placed at the N-terminus
+      static const int N_TERM_SITE = -1;
+      /// site index of modifications placed at the C-terminus
+      static const int C_TERM_SITE = -2;
+
+      /// a variable modification placed at a residue index (or N_TERM_SITE / C_TERM_SITE)
+      struct Placement
+      {
+        int site;
+        const ResidueModification* modification;
+      };
+
+      /// Enumerates the same variants as applyVariableModifications() with the given arguments
+      VariableModificationEnumerator(
+        const MapToResidueType& var_mods,
+        const AASequence& peptide,
+        Size max_variable_mods_per_peptide,
+        bool keep_unmodified = true);
+
+      /// only stop at variants with a monoisotopic weight (as reported by getMonoWeight()) in [@p min_mass, @p max_mass]
+      void setMassRange(double min_mass, double max_mass);
+
+      /// advances to the next variant (in the mass range). Returns false if all variants have been visited.
+      bool next();
+
+      /// position of the current variant in the output of applyVariableModifications()
+      Size getIndex() const;
+
+      /// monoisotopic weight of the current variant (summed up from mass differences, so it may differ from AASequence::getMonoWeight() in the last digits)
+      double getMonoWeight() const;
+
+      /// modifications placed in the current variant (empty for the unmodified peptide)
+      const std::vector<Placement>& getPlacements() const;
+
+      /// creates the current variant
+      AASequence getPeptide() const;
+
+    protected:
+      /// compatible modifications of a site and the mass differences they introduce
+      struct Site_
+      {
+        int site;
+        std::vector<const ResidueModification*> modifications;
+        std::vector<double> mass_differences;
+      };
+
+      /// advances to the next variant regardless of its mass
+      bool advance_();
+
+      /// update placements and mass after the subset of sites or the choice of modifications changed
+      void updateCurrent_();
+
+      const MapToResidueType& var_mods_;
+      const AASequence& peptide_;
+      std::vector<Site_> sites_; ///< modifiable sites in the order used by applyVariableModifications()
+      Size max_placements_;
+      bool keep_unmodified_;
+      double base_mass_;
+      double min_mass_;
+      double max_mass_;
+
+      bool started_ = false;
+      bool done_ = false;
+      Size n_placements_ = 0; ///< number of modifications placed in the current variant
+      std::vector<bool> subset_mask_; ///< which sites are modified in the current variant
+      std::vector<Size> subset_; ///< indices of modified sites
+      std::vector<Size> choice_; ///< selected modification of each modified site
+      Size count_ = 0;
+      Size index_ = 0;
+      double mass_ = 0.0;
+      std::vector<Placement> placements_;
+    };
+
   protected:
+    // Determine which modifications can be placed at which residue (or N_TERM_SITE / C_TERM_SITE) of a peptide
+    static void buildCompatibilityMap_(
+      const MapToResidueType& var_mods,
+      const AASequence& peptide,
+      std::map<int, std::vector<const ResidueModification*> >& map_compatibility);
+
     // Lookup datastructure to allow lock-free generation of modified peptides
     static MapToResidueType createResidueModificationToResidueMap_(const std::vector<const ResidueModification*>& mods);
 
@@ -111,6 +111,9 @@ namespace OpenMS
     /// Adds a charged version of an uncharged spectrum to another spectrum
     void addChargedSpectrum_(MSSpectrum& spectrum, const MSSpectrum& uncharged_spectrum, Int charge, bool add_precursor) const;
 
+    /// Reserves space for @p n_peaks additional peaks (and their meta data) in @p spectrum
+    void reservePeaks_(MSSpectrum& spectrum, Size n_peaks) const;
+
     bool add_a_ions_;
     bool add_b_ions_;
     bool add_c_ions_;
@@ -41,6 +41,7 @@
 #include <map>
 #include <set>
 #include <array>
+#include <shared_mutex>
 
 namespace OpenMS
 {
@@ -53,6 +54,10 @@ namespace OpenMS
       @brief OpenMS stores a central database of all residues in the ResidueDB.
       All (unmodified) residues are added to the database on construction.
       Modified residues get created and added if getModifiedResidue is called.
+
+      All lookups are thread-safe. Readers share a lock (std::shared_mutex) and
+      only adding a new modified residue takes it exclusively, so parallel
+      lookups do not serialize each other.
   */
   class OPENMS_DLLAPI ResidueDB
   {
@@ -177,6 +182,15 @@ protected:
 
     /// adds names of single modified residue to the index
     void addModifiedResidueNames_(const Residue*);
+
+    /// returns the residue @p res_name modified by the modification with id @p mod_id if known, nullptr otherwise (caller needs to hold the lock)
+    const Residue* findModifiedResidue_(const String& res_name, const String& mod_id) const;
+
+    /// returns the modified residue, creating it if it does not exist yet (nullptr if the residue @p res_name is unknown)
+    const Residue* getOrAddModifiedResidue_(const String& res_name, const ResidueModification* mod);
+
+    /// guards all lookup tables (shared for lookups, exclusive for adding residues)
+    mutable std::shared_mutex mutex_;
     
     std::map<String, std::map<String, const Residue*> > residue_mod_names_;
 
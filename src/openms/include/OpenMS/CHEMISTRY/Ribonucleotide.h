@@ -161,7 +161,7 @@ namespace OpenMS
     void setTermSpecificity(enum TermSpecificityNuc term_spec);
 
     /// Get sum formula after loss of the nucleobase
-    const EmpiricalFormula getBaselossFormula() const;
+    const EmpiricalFormula& getBaselossFormula() const;
 
     /// Set the sum formula after loss of the nucleobase
     void setBaselossFormula(const EmpiricalFormula& formula);
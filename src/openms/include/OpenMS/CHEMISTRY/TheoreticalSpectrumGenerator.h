@@ -34,16 +34,19 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequence.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
+#include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/METADATA/DataArrays.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace OpenMS
 {
-  class AASequence;
-
   /**
       @brief Generates theoretical spectra for peptides with various options
 
@@ -101,12 +104,121 @@ namespace OpenMS
     /// @throw Exception::InvalidParameter   If fragmentation method is anything else than 'CID', 'HCID', 'ECD' or 'ETD'.
     static MSSpectrum generateSpectrum(const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge);
 
+    /// Same peaks as generateSpectrum() above, but written into @p spec (whose peaks are cleared first, keeping the capacity).
+    /// No TheoreticalSpectrumGenerator is set up, and only the peaks of @p spec are set (no meta data or data arrays).
+    /// @throw Exception::InvalidParameter   If fragmentation method is anything else than 'CID', 'HCID', 'HCD', 'ECD' or 'ETD'.
+    static void generateSpectrum(PeakSpectrum& spec, const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge);
+
     /// overwrite
     void updateMembers_() override;
     //@}
 
+    /// a fragment ion as generated by getFragmentIons()
+    struct FragmentIon
+    {
+      double mz; ///< m/z of the monoisotopic peak
+      char ion_type; ///< 'a', 'b', 'c', 'x', 'y' or 'z'
+      Size ordinal; ///< number of residues in the fragment
+
+      bool operator<(const FragmentIon& rhs) const
+      {
+        return mz < rhs.mz;
+      }
+    };
+
+    /** @name Lightweight fragment generation
+
+      For hot loops (e.g. candidate scoring in search engines) that only need the
+      positions of the prefix and suffix ion ladders. The enabled ion types are
+      template parameters, so no parameter lookups or branches on ion types happen
+      at run time. The results are written into a caller-provided buffer, which
+      is cleared first; when the buffer is reused its capacity is kept, so no
+      memory is allocated once it has grown to the largest peptide.
+
+      The m/z values are identical to the monoisotopic single peaks of
+      getSpectrum() (without losses, isotopes, precursor or immonium ions) and
+      are returned sorted by m/z.
+     */
+    //@{
+    /// Computes the m/z of the enabled fragment ion types of @p peptide with charge @p charge
+    template <bool add_a, bool add_b, bool add_c, bool add_x, bool add_y, bool add_z>
+    static void getFragmentMZs(std::vector<double>& mzs, const AASequence& peptide, Int charge = 1, bool add_first_prefix_ion = false)
+    {
+      mzs.clear();
+      generateFragments_<add_a, add_b, add_c, add_x, add_y, add_z>(peptide, charge, add_first_prefix_ion,
+        [&mzs](double mz, char, Size) { mzs.push_back(mz); });
+      std::sort(mzs.begin(), mzs.end());
+    }
+
+    /// Same as getFragmentMZs(), also reporting the ion type and number of each fragment
+    template <bool add_a, bool add_b, bool add_c, bool add_x, bool add_y, bool add_z>
+    static void getFragmentIons(std::vector<FragmentIon>& ions, const AASequence& peptide, Int charge = 1, bool add_first_prefix_ion = false)
+    {
+      ions.clear();
+      generateFragments_<add_a, add_b, add_c, add_x, add_y, add_z>(peptide, charge, add_first_prefix_ion,
+        [&ions](double mz, char ion_type, Size ordinal) { ions.push_back(FragmentIon{mz, ion_type, ordinal}); });
+      std::sort(ions.begin(), ions.end());
+    }
+    //@}
+
     protected:
 
+    /// mass differences between internal residues and the ion types (monoisotopic)
+    struct IonOffsets_
+    {
+      double a, b, c, x, y, z;
+    };
+
+    /// returns the (precomputed) ion offsets
+    static const IonOffsets_& getIonOffsets_();
+
+    /// calls @p emit(mz, ion_type, ordinal) for each fragment, with the same masses as addPeaks_()
+    template <bool add_a, bool add_b, bool add_c, bool add_x, bool add_y, bool add_z, typename EmitFunction>
+    static void generateFragments_(const AASequence& peptide, Int charge, bool add_first_prefix_ion, EmitFunction emit)
+    {
+      if (peptide.size() < 2) return;
+
+      const IonOffsets_& offsets = getIonOffsets_();
+      const Size n = peptide.size();
+
+      if (add_a || add_b || add_c)
+      {
+        double mono_weight = Constants::PROTON_MASS_U * charge;
+        if (peptide.hasNTerminalModification())
+        {
+          mono_weight += peptide.getNTerminalModification()->getDiffMonoMass();
+        }
+        Size i = Size(!add_first_prefix_ion);
+        if (i == 1)
+        {
+          mono_weight += peptide[0].getMonoWeight(Residue::Internal);
+        }
+        for (; i < n - 1; ++i)
+        {
+          mono_weight += peptide[i].getMonoWeight(Residue::Internal);
+          if (add_a) emit((mono_weight + offsets.a) / charge, 'a', i + 1);
+          if (add_b) emit((mono_weight + offsets.b) / charge, 'b', i + 1);
+          if (add_c) emit((mono_weight + offsets.c) / charge, 'c', i + 1);
+        }
+      }
+
+      if (add_x || add_y || add_z)
+      {
+        double mono_weight = Constants::PROTON_MASS_U * charge;
+        if (peptide.hasCTerminalModification())
+        {
+          mono_weight += peptide.getCTerminalModification()->getDiffMonoMass();
+        }
+        for (Size i = n - 1; i > 0; --i)
+        {
+          mono_weight += peptide[i].getMonoWeight(Residue::Internal);
+          if (add_x) emit((mono_weight + offsets.x) / charge, 'x', n - i);
+          if (add_y) emit((mono_weight + offsets.y) / charge, 'y', n - i);
+          if (add_z) emit((mono_weight + offsets.z) / charge, 'z', n - i);
+        }
+      }
+    }
+
     /// adds peaks to a spectrum of the given ion-type, peptide, charge, and intensity, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
     virtual void addPeaks_(PeakSpectrum& spectrum, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, MSSpectrum::Chunks& chunks, const Residue::ResidueType res_type, Int charge = 1) const;
 
@@ -113,7 +113,7 @@ class OPENMS_DLLAPI ClusteringGrid
     * @param cell_index    cell index (i,j) on the grid
     * @return list of cluster indices (from the list of clusters) which are centred in this cell
     */
-    std::list<int> getClusters(const CellIndex &cell_index) const;
+    const std::list<int>& getClusters(const CellIndex &cell_index) const;
 
     /**
     * @brief returns grid cell index (i,j) for the positions (x,y)
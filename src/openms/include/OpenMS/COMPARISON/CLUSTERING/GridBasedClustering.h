@@ -246,11 +246,9 @@ public:
         new_B.insert(new_B.end(), B1.begin(), B1.end());
         new_B.insert(new_B.end(), B2.begin(), B2.end());
 
-        GridBasedCluster new_cluster(DPosition<2>(new_x, new_y), new_box, new_points, new_A, new_B);
-
-        clusters_.erase(cluster1_it);
+        // the merged cluster takes over the list entry of cluster 1
+        cluster1_it->second = GridBasedCluster(DPosition<2>(new_x, new_y), new_box, new_points, new_A, new_B);
         clusters_.erase(cluster2_it);
-        clusters_.insert(std::make_pair(cluster_index1, new_cluster));
 
         std::set<int> clusters_to_be_updated;
         clusters_to_be_updated.insert(cluster_index1);
@@ -566,8 +564,8 @@ private:
       // Will the merged cluster have the same properties A?
       if (A1 != A2) return true;
 
-      std::vector<int> B1 = c1.getPropertiesB();
-      std::vector<int> B2 = c2.getPropertiesB();
+      const std::vector<int>& B1 = c1.getPropertiesB();
+      const std::vector<int>& B2 = c2.getPropertiesB();
 
       // check if properties B of both clusters is set or not (not set := -1)
       if (std::find(B1.begin(), B1.end(), -1) != B1.end() || std::find(B2.begin(), B2.end(), -1) != B2.end())
@@ -577,12 +575,16 @@ private:
 
       // Will the merged cluster have different properties B?
       // (Hence the intersection of properties B of cluster 1 and cluster 2 should be empty.)
-      std::vector<int> B_intersection;
-      sort(B1.begin(), B1.end());
-      sort(B2.begin(), B2.end());
-      set_intersection(B1.begin(), B1.end(), B2.begin(), B2.end(), back_inserter(B_intersection));
+      // A direct search avoids copying and sorting both lists for every candidate pair.
+      for (int b : B1)
+      {
+        if (std::find(B2.begin(), B2.end(), b) != B2.end())
+        {
+          return true;
+        }
+      }
 
-      return !B_intersection.empty();
+      return false;
     }
 
     /**
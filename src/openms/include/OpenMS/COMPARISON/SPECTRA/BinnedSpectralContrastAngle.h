@@ -83,6 +83,18 @@ public:
     /// function call operator, calculates self similarity
     double operator()(const BinnedSpectrum& spec) const override;
 
+    /**
+      @brief calculates the similarity of all pairs of @p queries and @p library spectra
+
+      Each query is scattered once into a dense (per-thread) array, so every
+      library spectrum is scored by a single pass over its filled bins.
+
+      @see BinnedSpectrumCompareFunctor::computeSimilarityMatrix
+    */
+    void computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries,
+                                 const std::vector<BinnedSpectrum>& library,
+                                 Matrix<double>& similarities) const override;
+
     ///
     static BinnedSpectrumCompareFunctor* create() { return new BinnedSpectralContrastAngle(); }
 
@@ -37,6 +37,7 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
+#include <OpenMS/DATASTRUCTURES/Matrix.h>
 
 #include <cmath>
 
@@ -78,6 +79,18 @@ public:
     /// function call operator, calculates self similarity
     virtual double operator()(const BinnedSpectrum& spec) const = 0;
 
+    /**
+      @brief calculates the similarity of all pairs of @p queries and @p library spectra
+
+      @p similarities is resized to queries.size() x library.size() and entry (i, j) holds
+      the same value as operator()(queries[i], library[j]). Rows are computed in parallel.
+      The default implementation calls the pairwise operator; derived classes may provide
+      batched kernels.
+    */
+    virtual void computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries,
+                                         const std::vector<BinnedSpectrum>& library,
+                                         Matrix<double>& similarities) const;
+
     /// registers all derived products
     static void registerChildren();
 
@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Inverted file index over binned spectrum embeddings for fast candidate retrieval in spectral library search.
+
+    Every library spectrum is reduced to its @p peaks_per_entry most intense peaks. These are binned on a fixed
+    m/z grid (see BinnedSpectrum for the bin width and offset conventions) and L2-normalized, which yields a
+    short sparse embedding per entry. For each bin, the index stores the list of entries (postings) that have
+    signal in that bin, ordered by precursor m/z.
+
+    A query only touches the posting lists of its own bins and, inside each list, only the part that falls into
+    the precursor window. The approximate cosine similarity accumulated this way ranks the entries of the window;
+    the best @p k are returned and are meant to be re-scored exactly by the caller (e.g. with ZhangSimilarityScore).
+    The work per query therefore depends on the number of query bins and on the number of co-occurring library
+    entries, not on the size of the library or of the precursor window.
+
+    Entries are referenced by their position in the vector passed to build().
+
+    @ingroup SpectraComparison
+  */
+  class OPENMS_DLLAPI BinnedSpectrumIndex
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param bin_size bin width in Th
+      @param offset bin offset (see BinnedSpectrum)
+      @param bin_spread number of neighboring bins to both sides a query peak is matched against
+      @param peaks_per_entry number of most intense peaks per spectrum used for the embedding (0 = all)
+    */
+    BinnedSpectrumIndex(float bin_size = BinnedSpectrum::DEFAULT_BIN_WIDTH_HIRES,
+                        float offset = BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES,
+                        UInt bin_spread = 1,
+                        Size peaks_per_entry = 50);
+
+    /**
+      @brief Builds the index from library spectra
+
+      The precursor m/z of each entry is taken from its first precursor.
+      An existing index is replaced.
+
+      @exception Exception::MissingInformation if a spectrum has no precursor
+    */
+    void build(const std::vector<PeakSpectrum>& library);
+
+    /**
+      @brief Retrieves the most similar entries with precursor m/z in [@p precursor_mz_low, @p precursor_mz_high]
+
+      If the window holds at most @p k entries, all of them are returned. Otherwise, the @p k entries with the
+      highest approximate similarity are returned; entries that share no bin with the query are never returned.
+      Result indices refer to the vector passed to build() and are ordered by precursor m/z.
+
+      The method is const and can be called concurrently.
+    */
+    void query(const PeakSpectrum& spectrum, double precursor_mz_low, double precursor_mz_high, Size k, std::vector<Size>& candidates) const;
+
+    /// number of indexed entries
+    Size size() const;
+
+    /// number of stored postings (i.e. filled bins summed over all entries)
+    Size getNumberOfPostings() const;
+
+protected:
+    /// a single entry in a posting list
+    struct Posting
+    {
+      /// position of the entry in precursor m/z order
+      UInt rank;
+      /// normalized bin intensity
+      float weight;
+    };
+
+    /// computes the normalized (bin, weight) embedding of the top peaks of a spectrum (sorted by bin)
+    void embed_(const PeakSpectrum& spectrum, std::vector<std::pair<UInt, float> >& embedding) const;
+
+    /// bin width
+    float bin_size_;
+
+    /// bin offset
+    float offset_;
+
+    /// neighboring bins considered for query peaks
+    UInt bin_spread_;
+
+    /// number of peaks used per spectrum
+    Size peaks_per_entry_;
+
+    /// precursor m/z of entries in sorted order
+    std::vector<double> precursor_mz_;
+
+    /// entry index (as passed to build()) for each rank
+    std::vector<Size> rank_to_index_;
+
+    /// start of the posting list of each bin in postings_ (size: number of bins + 1)
+    std::vector<Size> bin_offsets_;
+
+    /// all posting lists, concatenated by bin and sorted by rank within each bin
+    std::vector<Posting> postings_;
+  };
+
+} // namespace OpenMS
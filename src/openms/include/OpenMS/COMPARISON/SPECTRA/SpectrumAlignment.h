@@ -41,6 +41,7 @@
 #include <map>
 #include <utility>
 #include <algorithm>
+#include <cstdint>
 
 #define ALIGNMENT_DEBUG
 #undef  ALIGNMENT_DEBUG
@@ -57,7 +58,6 @@ namespace OpenMS
       Peaks from s1 (usually the theoretical spectrum) are assigned to the closest peak in s2 if it lies in the tolerance window
       @note: a peak in s2 can be matched to none, one or multiple peaks in s1. Peaks in s1 may be matched to none or one peak in s2.
       @note: intensity is ignored 
-      TODO: improve time complexity, currently O(|s1|*log(|s2|))
 
       @htmlinclude OpenMS_SpectrumAlignment.parameters
 
@@ -84,120 +84,161 @@ public:
     SpectrumAlignment & operator=(const SpectrumAlignment & source);
     // @}
 
+    /**
+      @brief Reusable buffers for the banded dynamic programming alignment
+
+      Keeping one instance around (e.g. one per thread) and passing it to getSpectrumAlignment() or
+      getBandedAlignment() avoids reallocating the alignment matrix for every pair of spectra.
+      Only the band of the matrix that is actually filled is stored.
+    */
+    class Workspace
+    {
+      friend class SpectrumAlignment;
+
+      /// first column filled in each row (row i is stored at index i - 1)
+      std::vector<Size> row_begin_;
+      /// offset of each row into score_ and traceback_
+      std::vector<Size> row_offset_;
+      /// accumulated alignment cost of each filled cell
+      std::vector<double> score_;
+      /// origin of each filled cell (@see Traceback_)
+      std::vector<std::uint8_t> traceback_;
+
+      void reset_()
+      {
+        row_begin_.clear();
+        row_offset_.clear();
+        score_.clear();
+        traceback_.clear();
+      }
+
+      void beginRow_(Size first_column)
+      {
+        row_begin_.push_back(first_column);
+        row_offset_.push_back(score_.size());
+      }
+
+      /// index of cell (i, j) if it was filled
+      bool find_(Size i, Size j, Size& idx) const
+      {
+        if (i == 0 || j == 0 || i > row_begin_.size() || j < row_begin_[i - 1]) return false;
+        const Size row_end = i < row_offset_.size() ? row_offset_[i] : score_.size();
+        idx = row_offset_[i - 1] + (j - row_begin_[i - 1]);
+        return idx < row_end;
+      }
+    };
+
+    /**
+      @brief Aligns the peaks of @p s1 and @p s2 using the tolerance and method given by the parameters
+
+      @p alignment receives pairs of indices (s1, s2), sorted by both indices.
+
+      @exception Exception::IllegalArgument if a spectrum is not sorted by m/z
+    */
     template <typename SpectrumType1, typename SpectrumType2>
     void getSpectrumAlignment(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2) const
+    {
+      Workspace ws;
+      getSpectrumAlignment(alignment, s1, s2, ws);
+    }
+
+    /// as above, but reuses the buffers of @p ws for the dynamic programming matrix
+    template <typename SpectrumType1, typename SpectrumType2>
+    void getSpectrumAlignment(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2, Workspace& ws) const
     {
       if (!s1.isSorted() || !s2.isSorted())
       {
         throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Input to SpectrumAlignment is not sorted!");
       }
 
-      // clear result
-      alignment.clear();
       double tolerance = (double)param_.getValue("tolerance");
-
-      if (!param_.getValue("is_relative_tolerance").toBool() )
+      if (!param_.getValue("is_relative_tolerance").toBool())
       {
-        std::map<Size, std::map<Size, std::pair<Size, Size> > > traceback;
-        std::map<Size, std::map<Size, double> > matrix;
-
-        // init the matrix with "gap costs" tolerance
-        matrix[0][0] = 0;
-        for (Size i = 1; i <= s1.size(); ++i)
-        {
-          matrix[i][0] = i * tolerance;
-          traceback[i][0]  = std::make_pair(i - 1, 0);
-        }
-        for (Size j = 1; j <= s2.size(); ++j)
-        {
-          matrix[0][j] = j * tolerance;
-          traceback[0][j] = std::make_pair(0, j - 1);
-        }
+        getBandedAlignment(alignment, s1, s2, tolerance, ws);
+      }
+      else  // relative alignment (ppm tolerance)
+      {
+        getClosestPeakMatches(alignment, s1, s2, tolerance, true);
+      }
+    }
 
-        // fill in the matrix
-        Size left_ptr(1);
-        Size last_i(0), last_j(0);
+    /**
+      @brief Banded dynamic programming alignment with absolute tolerance (Method 1)
 
-        //Size off_band_counter(0);
-        for (Size i = 1; i <= s1.size(); ++i)
-        {
-          double pos1(s1[i - 1].getMZ());
+      The band is determined by @p tolerance (in Th), which is also the gap cost.
+      Spectra must be sorted by m/z (not checked).
+    */
+    template <typename SpectrumType1, typename SpectrumType2>
+    static void getBandedAlignment(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2, double tolerance, Workspace& ws)
+    {
+      alignment.clear();
+      ws.reset_();
 
-          for (Size j = left_ptr; j <= s2.size(); ++j)
-          {
-            bool off_band(false);
-            // find min of the three possible directions
-            double pos2(s2[j - 1].getMZ());
-            double diff_align = fabs(pos1 - pos2);
+      // cells that are not part of the band contribute the cost of gapping to them, i.e. (i + j) * tolerance
+      // (this also holds for the first row and column)
+      auto cost = [&ws, tolerance](Size i, Size j)
+      {
+        Size idx;
+        return ws.find_(i, j, idx) ? ws.score_[idx] : (i + j) * tolerance;
+      };
 
-            // running off the right border of the band?
-            if (pos2 > pos1 && diff_align > tolerance)
-            {
-              if (i < s1.size() && j < s2.size() && s1[i].getMZ() < pos2)
-              {
-                off_band = true;
-              }
-            }
+      // fill in the matrix
+      Size left_ptr(1);
+      Size last_i(0), last_j(0);
 
-            // can we tighten the left border of the band?
-            if (pos1 > pos2 && diff_align > tolerance && j > left_ptr + 1)
-            {
-              ++left_ptr;
-            }
+      for (Size i = 1; i <= s1.size(); ++i)
+      {
+        double pos1(s1[i - 1].getMZ());
+        ws.beginRow_(left_ptr);
 
-            double score_align = diff_align;
+        for (Size j = left_ptr; j <= s2.size(); ++j)
+        {
+          bool off_band(false);
+          // find min of the three possible directions
+          double pos2(s2[j - 1].getMZ());
+          double diff_align = fabs(pos1 - pos2);
 
-            if (matrix.find(i - 1) != matrix.end() && matrix[i - 1].find(j - 1) != matrix[i - 1].end())
-            {
-              score_align += matrix[i - 1][j - 1];
-            }
-            else
+          // running off the right border of the band?
+          if (pos2 > pos1 && diff_align > tolerance)
+          {
+            if (i < s1.size() && j < s2.size() && s1[i].getMZ() < pos2)
             {
-              score_align += (i - 1 + j - 1) * tolerance;
+              off_band = true;
             }
+          }
 
-            double score_up = tolerance;
-            if (matrix.find(i) != matrix.end() && matrix[i].find(j - 1) != matrix[i].end())
-            {
-              score_up += matrix[i][j - 1];
-            }
-            else
-            {
-              score_up += (i + j - 1) * tolerance;
-            }
+          // can we tighten the left border of the band?
+          if (pos1 > pos2 && diff_align > tolerance && j > left_ptr + 1)
+          {
+            ++left_ptr;
+          }
 
-            double score_left = tolerance;
-            if (matrix.find(i - 1) != matrix.end() && matrix[i - 1].find(j) != matrix[i - 1].end())
-            {
-              score_left += matrix[i - 1][j];
-            }
-            else
-            {
-              score_left += (i - 1 + j) * tolerance;
-            }
+          double score_align = diff_align + cost(i - 1, j - 1);
+          double score_up = tolerance + cost(i, j - 1);
+          double score_left = tolerance + cost(i - 1, j);
 
-    #ifdef ALIGNMENT_DEBUG
-          cerr << i << " " << j << " " << left_ptr << " " << pos1 << " " << pos2 << " " << score_align << " " << score_left << " " << score_up << endl;
-    #endif
+#ifdef ALIGNMENT_DEBUG
+          std::cerr << i << " " << j << " " << left_ptr << " " << pos1 << " " << pos2 << " " << score_align << " " << score_left << " " << score_up << std::endl;
+#endif
 
           if (score_align <= score_up && score_align <= score_left && diff_align <= tolerance)
           {
-             matrix[i][j] = score_align;
-             traceback[i][j] = std::make_pair(i - 1, j - 1);
-             last_i = i;
-             last_j = j;
+            ws.score_.push_back(score_align);
+            ws.traceback_.push_back(DIAGONAL_);
+            last_i = i;
+            last_j = j;
           }
           else
           {
             if (score_up <= score_left)
             {
-              matrix[i][j] = score_up;
-              traceback[i][j] = std::make_pair(i, j - 1);
+              ws.score_.push_back(score_up);
+              ws.traceback_.push_back(UP_);
             }
             else
             {
-              matrix[i][j] = score_left;
-              traceback[i][j] = std::make_pair(i - 1, j);
+              ws.score_.push_back(score_left);
+              ws.traceback_.push_back(LEFT_);
             }
           }
 
@@ -208,110 +249,71 @@ public:
         }
       }
 
-          //last_i = s1.size() + 1;
-          //last_j = s2.size() + 1;
-
-          //cerr << last_i << " " << last_j << endl;
-
-    #ifdef ALIGNMENT_DEBUG
-    #if 0
-          cerr << "TheMatrix: " << endl << " \t  \t";
-          for (Size j = 0; j != s2.size(); ++j)
-          {
-        cerr << s2[j].getPosition()[0] << " \t";
-          }
-          cerr << endl;
-          for (Size i = 0; i <= s1.size(); ++i)
-          {
-        if (i != 0)
-        {
-          cerr << s1[i - 1].getPosition()[0] << " \t";
-        }
-        else
-        {
-          cerr << " \t";
-        }
-        for (Size j = 0; j <= s2.size(); ++j)
-        {
-          if (matrix.has(i) && matrix[i].has(j))
-          {
-            if (traceback[i][j].first == i - 1 && traceback[i][j].second == j - 1)
-            {
-              cerr << "\\";
-            }
-            else
-            {
-              if (traceback[i][j].first == i - 1 && traceback[i][j].second == j)
-              {
-            cerr << "|";
-              }
-              else
-              {
-            cerr << "-";
-              }
-            }
-
-            cerr << matrix[i][j] << "  \t";
-          }
-          else
-          {
-            cerr << "-1  \t";
-          }
-        }
-        cerr << endl;
-          }
-    #endif
-    #endif
-
       // do traceback
       Size i = last_i;
       Size j = last_j;
 
       while (i >= 1 && j >= 1)
       {
-        if (traceback[i][j].first == i - 1 && traceback[i][j].second == j - 1)
+        Size idx;
+        if (!ws.find_(i, j, idx))
         {
-          alignment.push_back(std::make_pair(i - 1, j - 1));
+          // cells outside of the band lead back to the origin
+          if (i == 1 && j == 1)
+          {
+            alignment.emplace_back(0, 0);
+          }
+          break;
         }
-        Size new_i = traceback[i][j].first;
-        Size new_j = traceback[i][j].second;
 
-        i = new_i;
-        j = new_j;
+        switch (ws.traceback_[idx])
+        {
+          case DIAGONAL_:
+            alignment.emplace_back(i - 1, j - 1);
+            --i;
+            --j;
+            break;
+          case UP_:
+            --j;
+            break;
+          default:
+            --i;
+        }
       }
 
       std::reverse(alignment.begin(), alignment.end());
+    }
 
-      #ifdef ALIGNMENT_DEBUG
-      #if 0
-          // print alignment
-          cerr << "Alignment (size=" << alignment.size() << "): " << endl;
+    /**
+      @brief Matches every peak of @p s1 to the closest peak of @p s2 within @p tolerance (Method 2)
 
-          Size i_s1(0), i_s2(0);
-          for (vector<pair<Size, Size> >::const_reverse_iterator it = alignment.rbegin(); it != alignment.rend(); ++it, ++i_s1, ++i_s2)
-          {
-        while (i_s1 < it->first - 1)
-        {
-          cerr << i_s1 << " " << s1[i_s1].getPosition()[0] << " " << s1[i_s1].getIntensity() << endl;
-          i_s1++;
-        }
-        while (i_s2 < it->second - 1)
-        {
-          cerr << " \t " <<  i_s2 << " " << s2[i_s2].getPosition()[0] << " " << s2[i_s2].getIntensity() << endl;
-          i_s2++;
-        }
-        cerr << "(" << s1[it->first - 1].getPosition()[0] << " <-> " << s2[it->second - 1].getPosition()[0] << ") ("
-             << it->first << "|" << it->second << ") (" << s1[it->first - 1].getIntensity() << "|" << s2[it->second - 1].getIntensity() << ")" << endl;
-          }
-      #endif
-      #endif
-      }
-      else  // relative alignment (ppm tolerance)
-      {        
-        // find  closest match of s1[i] in s2 for all i
+      A peak of @p s2 can be matched to several peaks of @p s1. Both spectra are traversed once (O(|s1| + |s2|)),
+      no memory besides @p alignment is allocated. Tolerance is in ppm if @p tolerance_ppm is true, otherwise in Th.
+      Spectra must be sorted by m/z (not checked).
+    */
+    template <typename SpectrumType1, typename SpectrumType2>
+    static void getClosestPeakMatches(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2, double tolerance, bool tolerance_ppm)
+    {
+      alignment.clear();
+      if (tolerance_ppm)
+      {
         MatchedIterator<SpectrumType1, PpmTrait> it(s1, s2, tolerance);
         for (; it != it.end(); ++it) alignment.emplace_back(it.refIdx(), it.tgtIdx());
       }
+      else
+      {
+        MatchedIterator<SpectrumType1, DaTrait> it(s1, s2, tolerance);
+        for (; it != it.end(); ++it) alignment.emplace_back(it.refIdx(), it.tgtIdx());
+      }
     }
+
+protected:
+    /// origin of a cell of the alignment matrix
+    enum Traceback_ : std::uint8_t
+    {
+      DIAGONAL_, ///< from (i - 1, j - 1), i.e. peaks are aligned
+      UP_,       ///< from (i, j - 1)
+      LEFT_      ///< from (i - 1, j)
+    };
   };
 }
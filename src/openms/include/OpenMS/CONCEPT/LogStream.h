@@ -43,6 +43,7 @@
 #include <vector>
 #include <ctime>
 #include <map>
+#include <mutex>
 
 namespace OpenMS
 {
@@ -252,6 +253,45 @@ protected:
       /// Non-lock acquiring sync function called in the d'tor
       int syncLF_();
       //@}
+
+      /// Pass one complete log line (without line break) through the cache and distribute it. Requires @p sync_mutex_ to be held.
+      void processLine_(std::string line);
+
+      /// Serializes line processing of this buffer with lines forwarded by ThreadLogStreamBuf instances
+      std::mutex sync_mutex_;
+
+      friend class ThreadLogStreamBuf;
+    };
+
+    /**
+      @brief Thread-private buffer in front of a shared LogStreamBuf
+
+      Messages are formatted into a put area owned by a single thread without
+      any locking. Only when the stream is flushed (e.g. by <tt>std::endl</tt>)
+      or the put area runs full, all complete lines are handed to the shared
+      buffer in one locked call, where they pass through the regular cache and
+      are distributed to the attached streams. Text without a terminating line
+      break stays in the thread until the line is complete (or the buffer is
+      destroyed).
+
+      Used by threadLocalStream(); there should be no need to create instances directly.
+    */
+    class OPENMS_DLLAPI ThreadLogStreamBuf :
+      public LogStreamBuf
+    {
+public:
+      /// Create a buffer forwarding complete lines to @p target (not owned)
+      explicit ThreadLogStreamBuf(LogStreamBuf * target);
+
+      /// Forwards all pending text (including an unterminated last line)
+      ~ThreadLogStreamBuf() override;
+
+      /// Moves the put area into the pending text and forwards complete lines to the target buffer
+      int sync() override;
+
+protected:
+      LogStreamBuf * target_;
+      std::string pending_;
     };
 
     ///
@@ -302,10 +342,11 @@ protected:
       Which produces an error message in the log.
 
       @note The log stream macros are thread safe and can be used in a
-      multithreaded environment, the global variables are not! The macros are
-      protected by a OPENMS_THREAD_CRITICAL directive (which translates to an
-      OpenMP critical pragma), however there may be a small performance penalty
-      to this.
+      multithreaded environment, the global variables are not! Threads other
+      than the main thread write to a thread-local stream (see threadLocalStream()),
+      which hands complete lines to the global stream when flushed, so logging
+      from parallel regions does not serialize on a lock per message. End
+      messages with <tt>std::endl</tt> (or flush) to make them visible promptly.
 
     */
     class OPENMS_DLLAPI LogStream :
@@ -444,37 +485,41 @@ private:
 
     }; //LogStream
 
+    /**
+      @brief Returns the stream the calling thread should write to instead of @p global
+
+      In the thread that initialized the library this is @p global itself.
+      Any other thread (OpenMP workers, TaskPool workers, ...) gets its own
+      LogStream with a ThreadLogStreamBuf, created on first use, which forwards
+      complete lines to @p global.
+    */
+    OPENMS_DLLAPI LogStream & threadLocalStream(LogStream & global);
+
   } // namespace Logger
 
   /// Macro to be used if fatal error are reported (processing stops)
 #define OPENMS_LOG_FATAL_ERROR \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_fatal << __FILE__ << "(" << __LINE__ << "): "
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_fatal) << __FILE__ << "(" << __LINE__ << "): "
 
   /// Macro to be used if non-fatal error are reported (processing continues)
 #define OPENMS_LOG_ERROR \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_error
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_error)
 
   /// Macro if a warning, a piece of information which should be read by the user, should be logged
 #define OPENMS_LOG_WARN \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_warn
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_warn)
 
   /// Macro if a information, e.g. a status should be reported
 #define OPENMS_LOG_INFO \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_info
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_info)
 
   /// Macro for general debugging information
 #define OPENMS_LOG_DEBUG \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_debug << [](){ constexpr const char* x = (past_last_slash(__FILE__)); return x; }() << "(" << __LINE__ << "): "
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_debug) << [](){ constexpr const char* x = (past_last_slash(__FILE__)); return x; }() << "(" << __LINE__ << "): "
 
   /// Macro for general debugging information (without information on file)
 #define OPENMS_LOG_DEBUG_NOFILE \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_debug
+  OpenMS::Logger::threadLocalStream(OpenMS_Log_debug)
 
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_fatal; ///< Global static instance of a LogStream to capture messages classified as fatal errors. By default it is bound to @b cerr.
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_error; ///< Global static instance of a LogStream to capture messages classified as errors. By default it is bound to @b cerr.
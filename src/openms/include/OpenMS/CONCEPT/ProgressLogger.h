@@ -36,6 +36,9 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 
+#include <atomic>
+#include <ctime>
+
 namespace OpenMS
 {
   class String;
@@ -48,6 +51,11 @@ namespace OpenMS
     Use startProgress, setProgress and endProgress for the actual logging.
 
     @note All methods are const, so it can be used through a const reference or in const methods as well!
+
+    setProgress and nextProgress may be called concurrently from parallel loops (e.g. OpenMP)
+    without any critical section: nextProgress increments an atomic counter, and the display
+    is refreshed at most once per second by whichever thread gets there first.
+    With log type NONE, both return immediately.
   */
   class OPENMS_DLLAPI ProgressLogger
   {
@@ -115,12 +123,15 @@ public:
     /// Ends the progress display
     void endProgress() const;
 
-    /// increment progress by 1 (according to range begin-end)
+    /// increment progress by 1 (according to range begin-end); thread safe
     void nextProgress() const;
 
 protected:
+    /// Returns true for exactly one caller per second of wall time (the one that should refresh the display)
+    bool claimUpdate_() const;
+
     mutable LogType type_;
-    mutable time_t last_invoke_;
+    mutable std::atomic<time_t> last_invoke_;
     static int recursion_depth_;
 
     /// Return the name of the factory product used for this log type
@@ -39,8 +39,9 @@
 #include <OpenMS/DATASTRUCTURES/DPosition.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <boost/container/flat_map.hpp>
+
 #include <vector>
-#include <map>
 
 namespace OpenMS
 {
@@ -62,7 +63,9 @@ namespace OpenMS
   (to support encloses() at least for the new hulls, one would need to check if there exists a min&max value for each scan
    --> then the query would be valid and the inner representation can be filled. Old featureXML's are not supported in any case.)
 
-      The outer hullpoints can be queried by getHullPoints().
+      The outer hullpoints can be queried by getHullPoints(). They are computed on demand from the m/z ranges of the
+      RT scans, which are stored in a sorted flat array (adding points in ascending RT order appends to it).
+      If only the extent of a hull is needed, expandToBoundingBox() reduces it to two scans.
 
       @improvement For chromatograms we could postprocess the input and remove points in intermediate RT scans,
       which are currently reported but make the number of points rather large.
@@ -77,7 +80,8 @@ public:
     typedef PointArrayType::size_type SizeType;
     typedef PointArrayType::const_iterator PointArrayTypeConstIterator;
 
-    typedef std::map<PointType::CoordinateType, DBoundingBox<1> > HullPointType;
+    /// m/z range of each RT scan (sorted by RT)
+    typedef boost::container::flat_map<PointType::CoordinateType, DBoundingBox<1> > HullPointType;
 
     /// default constructor
     ConvexHull2D();
@@ -40,6 +40,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <string_view>
+
 class QString;
 
 namespace OpenMS
@@ -52,6 +54,7 @@ namespace OpenMS
     - To choose one of these types, just use the appropriate constructor.
     - Automatic conversion is supported and throws Exceptions in case of invalid conversions.
     - An empty object is created with the default constructor.
+    - Short strings (up to 7 characters, e.g. most flags, charges and labels) are stored inline without heap allocation.
 
     @ingroup Datastructures
   */
@@ -289,6 +292,8 @@ public:
 
       If the DataValue contains a string, a pointer to it's char* is returned.
       If the DataValue is empty, NULL is returned.
+      The pointer is only valid as long as the DataValue is neither modified nor moved
+      (short strings are stored inside the DataValue itself).
     */
     const char* toChar() const;
 
@@ -442,6 +447,9 @@ protected:
     /// Type of the currently stored unit
     UnitType unit_type_;
 
+    /// Length + 1 of a string stored inline in data_.small_str_, 0 if the string lives on the heap (or is no string)
+    unsigned char str_inline_ = 0;
+
     /// The unit of the data value (if it has one) using UO identifier, otherwise -1.
     int32_t unit_;
 
@@ -454,12 +462,19 @@ protected:
       StringList* str_list_;
       IntList* int_list_;
       DoubleList* dou_list_;
+      char small_str_[sizeof(SignedSize)]; ///< short strings (up to 7 characters) are stored without allocation
     } data_;
 
 private:
 
     /// Clears the current state of the DataValue and release every used memory.
     void clear_() noexcept;
+
+    /// Stores the string @p s of length @p length (inline if short enough). Expects a cleared state.
+    void setString_(const char* s, Size length);
+
+    /// View on the stored string (only valid for STRING_VALUE)
+    std::string_view strView_() const noexcept;
   };
 }
 
@@ -40,7 +40,9 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/DATASTRUCTURES/StringUtilsSimple.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/FORMAT/IndexedFASTAFile.h>
 
+#include <algorithm>
 #include <functional>
 #include <fstream>
 #include <unordered_map>
@@ -55,6 +57,7 @@ namespace OpenMS
 
   struct TFI_File; ///< template parameter for file-based FASTA access
   struct TFI_Vector; ///< template parameter for vector-based FASTA access
+  struct TFI_Indexed; ///< template parameter for access to a binary protein database (see IndexedFASTAFile)
 
   /**
   @brief This class allows for a chunk-wise single linear read over a (large) FASTA file, 
@@ -337,6 +340,119 @@ private:
   int cache_count_ = 0;
 };
 
+/**
+@brief
+FASTAContainer<TFI_Indexed> reads chunks from a memory-mapped binary protein database (see IndexedFASTAFile).
+
+In contrast to FASTAContainer<TFI_File>, nothing needs to be parsed and the number of entries is known
+upfront, i.e. size() is the total number of entries and readAt() is fast for any position.
+*/
+template<>
+class FASTAContainer<TFI_Indexed>
+{
+public:
+  FASTAContainer() = delete;
+
+  /// C'tor with the filename of a database written by IndexedFASTAFile::store()
+  FASTAContainer(const String& database_file)
+    : db_(database_file)
+  {
+  }
+
+  /// how many entries were read and got swapped out already
+  size_t getChunkOffset() const
+  {
+    return chunk_offset_;
+  }
+
+  /** @brief Swaps in the background cache of entries, read previously via @p cacheChunk()
+
+      @return true if cache contains data; false if empty
+      @note Should be invoked by a single thread, followed by a barrier to sync access of subsequent calls to chunkAt()
+  */
+  bool activateCache()
+  {
+    chunk_offset_ += data_fg_.size();
+    data_fg_.swap(data_bg_);
+    data_bg_.clear();
+    return !data_fg_.empty();
+  }
+
+  /** @brief Prefetch a new cache with up to @p suggested_size entries (or fewer upon reaching the end of the database)
+
+     @return true if new data is available; false if background data is empty
+  */
+  bool cacheChunk(int suggested_size)
+  {
+    data_bg_.clear();
+    const size_t end = std::min(db_.size(), next_ + (size_t)std::max(suggested_size, 0));
+    data_bg_.resize(end - next_);
+    for (size_t i = next_; i < end; ++i)
+    {
+      db_.getEntry(i, data_bg_[i - next_]);
+    }
+    next_ = end;
+    return !data_bg_.empty();
+  }
+
+  /// number of entries in active cache
+  size_t chunkSize() const
+  {
+    return data_fg_.size();
+  }
+
+  /// Retrieve a FASTA entry at cache position @p pos; requires prior call to activateCache()
+  const FASTAFile::FASTAEntry& chunkAt(size_t pos) const
+  {
+    return data_fg_[pos];
+  }
+
+  /** @brief Retrieve a FASTA entry at global position @p pos (fast, since the database is memory-mapped)
+
+    @return true if reading was successful; false otherwise
+    @throw Exception::IndexOverflow if @p pos is beyond the end of the database
+  */
+  bool readAt(FASTAFile::FASTAEntry& protein, size_t pos) const
+  {
+    db_.getEntry(pos, protein);
+    return true;
+  }
+
+  /// is the database empty?
+  bool empty() const
+  {
+    return db_.size() == 0;
+  }
+
+  /// resets reading, i.e. the next cacheChunk() starts at the first entry again
+  void reset()
+  {
+    data_fg_.clear();
+    data_bg_.clear();
+    chunk_offset_ = 0;
+    next_ = 0;
+  }
+
+  /// total number of entries in the database
+  size_t size() const
+  {
+    return db_.size();
+  }
+
+  /// the underlying database (e.g. to query decoy flags or sequences without copying)
+  const IndexedFASTAFile& getDatabase() const
+  {
+    return db_;
+  }
+
+private:
+  IndexedFASTAFile db_; ///< memory-mapped database
+  std::vector<FASTAFile::FASTAEntry> data_fg_; ///< active (foreground) data
+  std::vector<FASTAFile::FASTAEntry> data_bg_; ///< prefetched (background) data; will become the next active data
+  size_t chunk_offset_ = 0; ///< number of entries before the current chunk
+  size_t next_ = 0; ///< index of the first entry of the next chunk
+};
+
 /**
   @brief Helper class for calculations on decoy proteins
 */
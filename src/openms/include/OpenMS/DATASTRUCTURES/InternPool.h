@@ -0,0 +1,205 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  /**
+    @brief Thread-safe pool of shared, immutable values (interning)
+
+    Equal values passed to intern() share a single, reference-counted copy.
+    This saves memory for data that repeats a lot (e.g. peptide sequences or
+    protein accessions of millions of identifications) and makes equality
+    tests of handles a pointer comparison: two live handles obtained from the
+    same pool refer to equal values if and only if they point to the same object.
+
+    A value is removed from the pool once the last handle to it is gone. The
+    pool itself must outlive all of its handles; pools are therefore usually
+    created once and never destroyed.
+
+    @ingroup Datastructures
+  */
+  template <typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<T> >
+  class InternPool
+  {
+public:
+    /**
+      @brief Shared handle to an immutable, pooled value
+
+      A handle is never empty. Moving a handle copies it, so a moved-from
+      handle (and thus a moved-from owner object) still refers to a valid value.
+    */
+    class Handle
+    {
+public:
+      Handle(const Handle&) = default;
+
+      Handle(Handle&& rhs) noexcept :
+        ptr_(rhs.ptr_)
+      {
+      }
+
+      Handle& operator=(const Handle&) = default;
+
+      Handle& operator=(Handle&& rhs) noexcept
+      {
+        ptr_ = rhs.ptr_;
+        return *this;
+      }
+
+      const T& operator*() const
+      {
+        return *ptr_;
+      }
+
+      const T* operator->() const
+      {
+        return ptr_.get();
+      }
+
+      const T* get() const
+      {
+        return ptr_.get();
+      }
+
+      /// Equality of the referenced values (pointer comparison for handles of the same pool)
+      bool operator==(const Handle& rhs) const
+      {
+        return ptr_ == rhs.ptr_;
+      }
+
+      bool operator!=(const Handle& rhs) const
+      {
+        return ptr_ != rhs.ptr_;
+      }
+
+private:
+      friend class InternPool;
+
+      explicit Handle(std::shared_ptr<const T> ptr) :
+        ptr_(std::move(ptr))
+      {
+      }
+
+      std::shared_ptr<const T> ptr_;
+    };
+
+    /// Constructor
+    InternPool() :
+      default_(intern(T()))
+    {
+    }
+
+    InternPool(const InternPool&) = delete;
+    InternPool& operator=(const InternPool&) = delete;
+
+    /// Returns the handle of an equal, already pooled value or adds @p value to the pool
+    Handle intern(T value)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = entries_.find(&value);
+      if (it != entries_.end())
+      {
+        if (std::shared_ptr<const T> existing = it->second.lock())
+        {
+          return Handle(std::move(existing));
+        }
+        // last handle is gone, release_() is about to delete the value
+        entries_.erase(it);
+      }
+      const T* object = new T(std::move(value));
+      std::shared_ptr<const T> ptr(object, [this](const T* p) { release_(p); });
+      entries_.emplace(object, ptr);
+      return Handle(std::move(ptr));
+    }
+
+    /// Handle to a default constructed value (no locking)
+    const Handle& defaultValue() const
+    {
+      return default_;
+    }
+
+    /// Number of distinct values currently in the pool
+    Size size() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return entries_.size();
+    }
+
+private:
+    struct PtrHash_
+    {
+      std::size_t operator()(const T* p) const
+      {
+        return Hash()(*p);
+      }
+    };
+
+    struct PtrEqual_
+    {
+      bool operator()(const T* a, const T* b) const
+      {
+        return Equal()(*a, *b);
+      }
+    };
+
+    /// Deleter of the pooled values: removes the entry (unless it was already replaced) and frees the value
+    void release_(const T* p)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(p);
+        if (it != entries_.end() && it->first == p)
+        {
+          entries_.erase(it);
+        }
+      }
+      delete p;
+    }
+
+    /// Keys point to the pooled values themselves, which stay alive as long as their entry exists
+    std::unordered_map<const T*, std::weak_ptr<const T>, PtrHash_, PtrEqual_> entries_;
+
+    mutable std::mutex mutex_;
+
+    Handle default_;
+  };
+}
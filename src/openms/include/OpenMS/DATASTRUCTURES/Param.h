@@ -37,9 +37,12 @@
 #include <OpenMS/DATASTRUCTURES/ParamValue.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
 #include <map>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -294,6 +297,23 @@ protected:
     */
     const ParamValue& getValue(const std::string& key) const;
 
+    /**
+      @name Typed value access
+
+      Shortcuts for converting getValue(@p key) to a plain type, for use in
+      updateMembers_() and other code reading parameters repeatedly.
+      getBool() interprets the 'true'/'false' string flags (see ParamValue::toBool()).
+
+      @exception Exception::ElementNotFound is thrown if the parameter does not exists.
+      @exception Exception::ConversionError is thrown if the parameter has a different type.
+    */
+    //@{
+    double getDouble(const std::string& key) const;
+    int getInt(const std::string& key) const;
+    bool getBool(const std::string& key) const;
+    std::string getString(const std::string& key) const;
+    //@}
+
     /**
       @brief Returns the type of a parameter.
 
@@ -660,6 +680,40 @@ protected:
 
 protected:
 
+    /**
+      @brief Hashed index from fully qualified names to the entries of a Param
+
+      Built on demand once a number of lookups happened without changes to
+      the tree in between, so that alternating lookups and insertions (e.g.
+      in setDefaults()) do not rebuild it over and over. Concurrent readers
+      are safe; whoever changes the tree structure must call invalidate().
+      Copies start without an index, as the entries belong to the source.
+    */
+    class OPENMS_DLLAPI EntryIndex_
+    {
+public:
+      EntryIndex_() = default;
+      EntryIndex_(const EntryIndex_&);
+      EntryIndex_(EntryIndex_&& rhs);
+      EntryIndex_& operator=(const EntryIndex_&);
+      EntryIndex_& operator=(EntryIndex_&& rhs);
+
+      /// Returns the entry named @p key below @p root, or nullptr
+      ParamEntry* find(const std::string& key, ParamNode& root) const;
+
+      /// Drops the index after entries were added to or removed from the tree
+      void invalidate();
+
+private:
+      typedef std::unordered_map<std::string, ParamEntry*> Map;
+
+      /// Number of lookups after which the index is built
+      static const unsigned BUILD_AFTER = 8;
+
+      mutable std::shared_ptr<const Map> map_;
+      mutable std::atomic<unsigned> lookups_{0};
+    };
+
     /**
       @brief Returns a mutable reference to a parameter entry.
 
@@ -672,6 +726,9 @@ protected:
 
     /// Invisible root node that stores all the data
     mutable Param::ParamNode root_;
+
+    /// Index over the entries of @p root_
+    EntryIndex_ index_;
   };
 
   /// Output of Param to a stream.
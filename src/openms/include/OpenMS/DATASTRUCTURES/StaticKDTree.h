@@ -0,0 +1,239 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Static k-d tree for orthogonal range queries on D-dimensional points
+
+    Other than KDTree::KDTree (a node-based tree filled by single insertions),
+    the tree is built once from all points in O(n log n) and stored implicitly
+    in a single array: the median of a range (with respect to the dimension of
+    the tree level) is stored in its middle, the left and right subtrees in the
+    parts before and after. Small ranges are not split but searched linearly.
+    There are no pointers to follow and the points of a subtree are contiguous
+    in memory.
+
+    The top levels of the tree are partitioned level by level and the resulting
+    subtrees are built in parallel if OpenMP is enabled. The result does not
+    depend on the number of threads.
+
+    Points are referred to by their index in the vector passed to build().
+    Changing the points requires a new build().
+
+    @ingroup Datastructures
+  */
+  template <UInt D>
+  class StaticKDTree
+  {
+public:
+    /// Coordinates of a point
+    typedef std::array<double, D> PointType;
+    /// Closed query box (lower and upper corner)
+    typedef std::pair<PointType, PointType> RegionType;
+
+    /// Builds the tree from @p points (replacing the current content)
+    void build(const std::vector<PointType>& points)
+    {
+      nodes_.resize(points.size());
+      for (Size i = 0; i < points.size(); ++i)
+      {
+        nodes_[i].point = points[i];
+        nodes_[i].index = i;
+      }
+
+      // partition the top levels, all ranges of one level in parallel
+      std::vector<std::pair<Size, Size> > ranges(1, std::make_pair(Size(0), nodes_.size()));
+      UInt dim = 0;
+      while (ranges.size() < MAX_PARALLEL_SUBTREES && nodes_.size() / ranges.size() > LEAF_SIZE)
+      {
+        std::vector<std::pair<Size, Size> > next(2 * ranges.size());
+#pragma omp parallel for
+        for (SignedSize r = 0; r < (SignedSize)ranges.size(); ++r)
+        {
+          const Size begin = ranges[r].first, end = ranges[r].second;
+          const Size mid = partition_(begin, end, dim);
+          next[2 * r] = std::make_pair(begin, mid);
+          next[2 * r + 1] = std::make_pair(std::min(mid + 1, end), end);
+        }
+        ranges.swap(next);
+        dim = (dim + 1) % D;
+      }
+
+      // build the remaining subtrees
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize r = 0; r < (SignedSize)ranges.size(); ++r)
+      {
+        build_(ranges[r].first, ranges[r].second, dim);
+      }
+    }
+
+    /// Number of points in the tree
+    Size size() const
+    {
+      return nodes_.size();
+    }
+
+    /// Are there no points in the tree?
+    bool empty() const
+    {
+      return nodes_.empty();
+    }
+
+    /// Removes all points
+    void clear()
+    {
+      nodes_.clear();
+    }
+
+    /// Appends the indices of all points within @p region (in no particular order) to @p result
+    void queryRegion(const RegionType& region, std::vector<Size>& result) const
+    {
+      query_(0, nodes_.size(), 0, region, result);
+    }
+
+    /**
+      @brief Batched queries: fills @p results with the indices of the points within each of @p regions
+
+      The indices of each region are sorted ascending. Regions are processed in parallel if OpenMP is enabled.
+    */
+    void queryRegions(const std::vector<RegionType>& regions, std::vector<std::vector<Size> >& results) const
+    {
+      results.assign(regions.size(), std::vector<Size>());
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize r = 0; r < (SignedSize)regions.size(); ++r)
+      {
+        queryRegion(regions[r], results[r]);
+        std::sort(results[r].begin(), results[r].end());
+      }
+    }
+
+protected:
+    /// Ranges with at most this many points are searched linearly
+    static const Size LEAF_SIZE = 8;
+    /// Number of subtrees that are built in parallel
+    static const Size MAX_PARALLEL_SUBTREES = 256;
+
+    struct Node
+    {
+      PointType point;
+      Size index;
+    };
+
+    /// Moves the median (wrt. @p dim) of [@p begin, @p end) to the middle, which is returned
+    Size partition_(Size begin, Size end, UInt dim)
+    {
+      const Size mid = begin + (end - begin) / 2;
+      if (end - begin > LEAF_SIZE)
+      {
+        std::nth_element(nodes_.begin() + begin, nodes_.begin() + mid, nodes_.begin() + end,
+                         [dim](const Node& a, const Node& b) { return a.point[dim] < b.point[dim]; });
+      }
+      return mid;
+    }
+
+    void build_(Size begin, Size end, UInt dim)
+    {
+      while (end - begin > LEAF_SIZE)
+      {
+        const Size mid = partition_(begin, end, dim);
+        dim = (dim + 1) % D;
+        build_(begin, mid, dim);
+        begin = mid + 1;
+      }
+    }
+
+    bool contains_(const RegionType& region, const PointType& point) const
+    {
+      for (UInt d = 0; d < D; ++d)
+      {
+        if (point[d] < region.first[d] || point[d] > region.second[d]) return false;
+      }
+      return true;
+    }
+
+    void query_(Size begin, Size end, UInt dim, const RegionType& region, std::vector<Size>& result) const
+    {
+      while (end - begin > LEAF_SIZE)
+      {
+        // left subtree: coordinates <= median, right subtree: coordinates >= median
+        const Size mid = begin + (end - begin) / 2;
+        const PointType& median = nodes_[mid].point;
+        const UInt next_dim = (dim + 1) % D;
+        if (contains_(region, median))
+        {
+          result.push_back(nodes_[mid].index);
+        }
+        if (region.first[dim] <= median[dim])
+        {
+          if (median[dim] <= region.second[dim])
+          {
+            query_(begin, mid, next_dim, region, result);
+          }
+          else
+          {
+            end = mid; // only the left subtree remains
+            dim = next_dim;
+            continue;
+          }
+        }
+        else if (median[dim] > region.second[dim])
+        {
+          return; // cannot happen for a valid region
+        }
+        begin = mid + 1; // continue with the right subtree
+        dim = next_dim;
+      }
+      for (Size i = begin; i < end; ++i)
+      {
+        if (contains_(region, nodes_[i].point))
+        {
+          result.push_back(nodes_[i].index);
+        }
+      }
+    }
+
+    /// Points in tree order
+    std::vector<Node> nodes_;
+  };
+}
@@ -70,6 +70,11 @@ namespace OpenMS
     {
     }
 
+    /// create view on a character range (not necessarily null-terminated)
+    StringView(const char* begin, Size size) : begin_(begin), size_(size)
+    {
+    }
+
     /// less operator
     bool operator<(const StringView other) const
     {
@@ -112,6 +117,43 @@ namespace OpenMS
       return size_;
     }
 
+    /// pointer to the first character of the view (not null-terminated)
+    inline const char* data() const
+    {
+      return begin_;
+    }
+
+    /// true if the view has zero length
+    inline bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    /// create view without leading and trailing whitespace
+    StringView trim() const;
+
+    /**
+      @name Number conversion
+
+      Convert the view to a number without creating temporary strings (based on std::from_chars).
+      Leading and trailing whitespace as well as a leading '+' are allowed (same as String::toInt() etc.).
+
+      @throws Exception::ConversionError if the view is not completely explained by the number or the value is out of range
+    */
+    //@{
+    /// convert to an integer value
+    Int toInt() const;
+
+    /// convert to a 64 bit integer value
+    Int64 toInt64() const;
+
+    /// convert to a float value
+    float toFloat() const;
+
+    /// convert to a double value (also accepts 'nan' and 'inf')
+    double toDouble() const;
+    //@}
+
     /// create String object from view
     inline String getString() const
     {
@@ -120,8 +162,8 @@ namespace OpenMS
     }
 
     private:
-      const char* begin_;
-      Size size_;
+      const char* begin_ = nullptr;
+      Size size_ = 0;
   };
 	
 } // namespace OpenMS
@@ -4,6 +4,7 @@ set(directory include/OpenMS/DATASTRUCTURES)
 ### list all header files of the directory here
 set(sources_list_h
 Adduct.h
+AlignedAllocator.h
 BinaryTreeNode.h
 CalibrationData.h
 ChargePair.h
@@ -26,6 +27,7 @@ DistanceMatrix.h
 FASTAContainer.h
 FlagSet.h
 GridFeature.h
+InternPool.h
 IsotopeCluster.h
 KDTree.h
 ListUtils.h
@@ -38,6 +40,7 @@ OSWData.h
 Param.h
 ParamValue.h
 QTCluster.h
+StaticKDTree.h
 String.h
 StringUtils.h
 StringUtilsSimple.h
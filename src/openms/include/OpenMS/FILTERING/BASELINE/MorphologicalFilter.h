@@ -199,8 +199,8 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
+      // the buffer is static only to avoid reallocation (one per thread, see filterExperiment())
+      static thread_local std::vector<typename InputIterator::value_type> buffer;
       const UInt size = input_end - input_begin;
 
       //determine the struct size in data points if not already set
@@ -304,12 +304,14 @@ public:
       //make it odd (needed for the algorithm)
       if (!Math::isOdd(struct_size_in_datapoints_)) ++struct_size_in_datapoints_;
 
-      //apply the filtering and overwrite the input data
+      //apply the filtering to a contiguous copy of the intensities and overwrite the input data
+      std::vector<Peak1D::IntensityType> input(spectrum.size());
+      for (Size i = 0; i < spectrum.size(); ++i)
+      {
+        input[i] = spectrum[i].getIntensity();
+      }
       std::vector<Peak1D::IntensityType> output(spectrum.size());
-      filterRange(Internal::intensityIteratorWrapper(spectrum.begin()),
-                  Internal::intensityIteratorWrapper(spectrum.end()),
-                  output.begin()
-                  );
+      filterRange(input.begin(), input.end(), output.begin());
 
       //overwrite output with data
       for (Size i = 0; i < spectrum.size(); ++i)
@@ -323,14 +325,26 @@ public:
 
         The size of the structuring element is computed for each spectrum individually, if it is given in 'Thomson'.
         See the filtering method for MSSpectrum for details.
+
+        Spectra are filtered in parallel; each thread works on its own copy of this filter.
     */
     void filterExperiment(PeakMap & exp)
     {
       startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
+      Size progress = 0;
+#pragma omp parallel
       {
-        filter(exp[i]);
-        setProgress(i);
+        // filter() keeps the structuring element size of the current spectrum in a member
+        MorphologicalFilter thread_filter(*this);
+#pragma omp for schedule(dynamic)
+        for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+        {
+          thread_filter.filter(exp[i]);
+#pragma omp critical (MorphologicalFilter_filterExperiment)
+          {
+            setProgress(++progress);
+          }
+        }
       }
       endProgress();
     }
@@ -351,7 +365,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
+      static thread_local std::vector<ValueType> buffer;
       if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
 
       Int anchor;           // anchoring position of the current block
@@ -451,7 +465,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
+      static thread_local std::vector<ValueType> buffer;
       if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
 
       Int anchor;           // anchoring position of the current block
@@ -152,6 +152,27 @@ class OPENMS_DLLAPI Deisotoper
                                          bool use_decreasing_model = true,
                                          unsigned int start_intensity_check = 2,
                                          bool add_up_intensity = false);
+
+  /** @brief Applies deisotopeAndSingleCharge(MSSpectrum&, ...) to every spectrum in @p exp.
+
+    Spectra are processed in parallel and sorted by m/z first if necessary.
+    All other parameters have the same meaning as for the single-spectrum version.
+    If processing a spectrum throws, the first exception (in spectrum order) is rethrown.
+   */
+    static void deisotopeAndSingleCharge(PeakMap& exp,
+                                         double fragment_tolerance,
+                                         bool fragment_unit_ppm,
+                                         int min_charge = 1,
+                                         int max_charge = 3,
+                                         bool keep_only_deisotoped = false,
+                                         unsigned int min_isopeaks = 3,
+                                         unsigned int max_isopeaks = 10,
+                                         bool make_single_charged = true,
+                                         bool annotate_charge = false,
+                                         bool annotate_iso_peak_count = false,
+                                         bool use_decreasing_model = true,
+                                         unsigned int start_intensity_check = 2,
+                                         bool add_up_intensity = false);
 };
 
 }
@@ -42,6 +42,8 @@
 
 namespace OpenMS
 {
+  class SavitzkyGolayFilter;
+
   /**
     @brief Extracts chromatographic peaks from a mass trace.
 
@@ -99,6 +101,11 @@ public:
      *
      * @note Smoothed intensities are added to @p mt_vec
      *
+     * Traces are processed in parallel (longest first). The smoothing
+     * filter is set up once per window size and the smoothing buffers are
+     * reused across traces. The order of @p single_mtraces follows the
+     * order of @p mt_vec.
+     *
      * @param mt_vec Input mass traces
      * @param single_mtraces Output single mass traces (detected peaks)
      *
@@ -163,8 +170,21 @@ private:
     /// Whether to apply S/N filtering
     bool mt_snr_filtering_;
 
-    /// Main function to do the work
-    void detectElutionPeaks_(MassTrace&, std::vector<MassTrace>&);
+    /// Buffers for smoothing, reused across mass traces (one per thread)
+    struct SmoothingBuffers_
+    {
+      std::vector<double> intensities;
+      std::vector<double> smoothed;
+    };
+
+    /// Number of data points used for smoothing @p mt (expected peak width in scans)
+    Size smoothingWindow_(const MassTrace& mt) const;
+
+    /// Same as smoothData(), with a prepared @p filter and reusable @p buffers
+    void smoothData_(MassTrace& mt, const SavitzkyGolayFilter& filter, SmoothingBuffers_& buffers) const;
+
+    /// Main function to do the work (appends the detected peaks to @p single_mtraces)
+    void detectElutionPeaks_(MassTrace& mt, const SavitzkyGolayFilter& filter, SmoothingBuffers_& buffers, std::vector<MassTrace>& single_mtraces);
   };
 
 } // namespace OpenMS
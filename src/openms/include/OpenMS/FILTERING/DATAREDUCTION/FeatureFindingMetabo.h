@@ -310,6 +310,10 @@ private:
      * is assumed that candidates[0] is the monoisotopic trace.
      *
      * The resulting possible groupings are appended to output_hypotheses.
+     *
+     * Only reads members, so it can be called for many seeds in parallel
+     * (each with its own @p output_hypotheses). Expects isotope_windows_
+     * to be set up (see run()).
     */
     void findLocalFeatures_(const std::vector<const MassTrace*>& candidates, double total_intensity, std::vector<FeatureHypothesis>& output_hypotheses) const;
 
@@ -340,6 +344,9 @@ private:
 
     bool remove_single_traces_;
     std::vector<const Element*> elements_;
+
+    /// expected m/z window of each isotopic position (index 0 unused), computed once per run()
+    std::vector<Range> isotope_windows_;
   };
 
 }
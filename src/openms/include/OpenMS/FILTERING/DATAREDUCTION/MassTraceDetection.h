@@ -40,6 +40,8 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 
+#include <atomic>
+
 namespace OpenMS
 {
 
@@ -118,6 +120,37 @@ namespace OpenMS
                   std::vector<MassTrace> & found_masstraces,
                   const Size max_traces = 0);
 
+        /// Traces found in one m/z band
+        struct BandResult_
+        {
+          /// traces with the rank of their apex (in order of decreasing apex intensity)
+          std::vector<std::pair<Size, MassTrace> > traces;
+          /// peaks marked as visited by the traces
+          std::vector<Size> marked;
+          /// the search window of a trace reached below the band
+          bool crossed_low = false;
+          /// the search window of a trace reached above the band
+          bool crossed_high = false;
+        };
+
+        /**
+          @brief Extends the traces of the apices with the given ranks, using only peaks with m/z in [@p mz_low, @p mz_high)
+
+          Stops as soon as the search window of a trace crosses a band border (see BandResult_); otherwise, the
+          traces are identical to those of the serial algorithm. Called concurrently for disjoint bands.
+        */
+        void detectInBand_(const std::vector<Apex>& chrom_apices,
+                           const std::vector<Size>& apex_ranks,
+                           const PeakMap & work_exp,
+                           const std::vector<Size>& spec_offsets,
+                           const int fwhm_meta_idx,
+                           const double mz_low,
+                           const double mz_high,
+                           std::vector<char>& peak_visited,
+                           BandResult_& result,
+                           const Size max_traces,
+                           std::atomic<Size>& peaks_detected);
+
         // parameter stuff
         double mass_error_ppm_;
         double noise_threshold_int_;
@@ -131,5 +164,6 @@ namespace OpenMS
         double max_trace_length_;
 
         bool reestimate_mt_sd_;
+        Size mz_bands_;
     };
 }
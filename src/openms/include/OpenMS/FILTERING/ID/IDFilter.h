@@ -241,9 +241,9 @@ public:
 
       bool operator()(const PeptideHit& hit) const
       {
-        for (const auto& it : hit.extractProteinAccessionsSet())
+        for (const PeptideEvidence& ev : hit.getPeptideEvidences())
         {
-          if (accessions.count(it) > 0) return true;
+          if (accessions.count(ev.getProteinAccession()) > 0) return true;
         }
         return false;
       }
@@ -277,9 +277,9 @@ public:
 
       bool operator()(const PeptideHit& hit) const
       {
-        for (const auto& it : hit.extractProteinAccessionsSet())
+        for (const PeptideEvidence& ev : hit.getPeptideEvidences())
         {
-          if (accessions.count(it) > 0) return true;
+          if (accessions.count(ev.getProteinAccession()) > 0) return true;
         }
         return false;
       }
@@ -553,6 +553,24 @@ public:
         items.erase(part, items.end());
     }
 
+    /**
+       @brief Keep only hits that satisfy all of the given predicates, in a single pass over the hits of each ID
+
+       Equivalent to calling keepMatchingItems() once per predicate, but the hits are only compacted once.
+       Predicates are evaluated in the given order, i.e. cheap ones should come first.
+    */
+    template <class IDContainer, class... Predicates>
+    static void keepHitsMatchingAll(IDContainer& items, const Predicates&... preds)
+    {
+      for (auto& item : items)
+      {
+        auto& hits = item.getHits();
+        hits.erase(std::remove_if(hits.begin(), hits.end(),
+                                  [&preds...](const auto& hit) { return !(preds(hit) && ...); }),
+                   hits.end());
+      }
+    }
+
     /// Remove Hit items that satisfy a condition in one of our ID containers (e.g. vector of Peptide or ProteinIDs)
     template <class IDContainer, class Predicate>
     static void removeMatchingItemsUnroll(IDContainer& items, const Predicate& pred)
@@ -840,12 +858,13 @@ public:
     static void filterHitsByScore(std::vector<IdentificationType>& ids,
                                   double threshold_score)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+      // IDs are independent of each other
+      #pragma omp parallel for schedule(static) if (ids.size() > 10000)
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
         struct HasGoodScore<typename IdentificationType::HitType> score_filter(
-          threshold_score, id_it->isHigherScoreBetter());
-        keepMatchingItems(id_it->getHits(), score_filter);
+          threshold_score, ids[i].isHigherScoreBetter());
+        keepMatchingItems(ids[i].getHits(), score_filter);
       }
     }
 
@@ -957,12 +976,14 @@ public:
     */
     template <class IdentificationType>
     static void removeHitsMatchingProteins(std::vector<IdentificationType>& ids,
-                                           const std::set<String> accessions)
+                                           const std::set<String>& accessions)
     {
-      struct HasMatchingAccession<typename IdentificationType::HitType> acc_filter(accessions);
-      for (auto& id_it : ids)
+      const std::unordered_set<String> acc_hashed(accessions.begin(), accessions.end()); // faster lookup
+      struct HasMatchingAccessionUnordered<typename IdentificationType::HitType> acc_filter(acc_hashed);
+      #pragma omp parallel for schedule(static) if (ids.size() > 10000)
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        removeMatchingItems(id_it.getHits(), acc_filter);
+        removeMatchingItems(ids[i].getHits(), acc_filter);
       }
     }
 
@@ -977,10 +998,12 @@ public:
     static void keepHitsMatchingProteins(std::vector<IdentificationType>& ids,
                                          const std::set<String>& accessions)
     {
-      struct HasMatchingAccession<typename IdentificationType::HitType> acc_filter(accessions);
-      for (auto& id_it : ids)
+      const std::unordered_set<String> acc_hashed(accessions.begin(), accessions.end()); // faster lookup
+      struct HasMatchingAccessionUnordered<typename IdentificationType::HitType> acc_filter(acc_hashed);
+      #pragma omp parallel for schedule(static) if (ids.size() > 10000)
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        keepMatchingItems(id_it.getHits(), acc_filter);
+        keepMatchingItems(ids[i].getHits(), acc_filter);
       }
     }
 
@@ -70,6 +70,8 @@ namespace OpenMS
     @note If more than 20 percent of windows have less than <i>min_required_elements</i> of elements, a warning is issued to <i>OPENMS_LOG_WARN</i> and noise estimates in those windows are set to the constant <i>noise_for_empty_window</i>.
     @note If more than 1 percent of median estimations had to rely on the last(=rightmost) bin (which gives an unreliable result), a warning is issued to <i>OPENMS_LOG_WARN</i>.  In this case you should increase <i>max_intensity</i> (and optionally the <i>bin_count</i>). 
     @note You can disable logging this error by setting <i>write_log_messages</i> and read out the values 
+    @note Besides MSSpectrum and MSChromatogram, SoASpectrum can be used as @p Container. Its
+    contiguous intensity array lets the binning pass over all data points be vectorized.
 
 
         @htmlinclude OpenMS_SignalToNoiseEstimatorMedian.parameters
@@ -286,8 +288,19 @@ protected:
         histogram[bin] = 0;
         bin_value[bin] = (bin + 0.5) * bin_size;
       }
-      // bin in which a datapoint would fall
-      int to_bin = 0;
+      // bin in which each datapoint falls (a single pass over the intensities, so the
+      // sliding window below only needs to update the histogram)
+      std::vector<int> data_bin(c.size());
+      {
+        Size index = 0;
+        for (PeakIterator it = scan_first_; it != scan_last_; ++it, ++index)
+        {
+          data_bin[index] = std::max(std::min<int>((int)((*it).getIntensity() / bin_size), bin_count_minus_1), 0);
+        }
+      }
+      // index of the left and right window border in data_bin
+      Size index_borderleft = 0;
+      Size index_borderright = 0;
 
       // index of bin where the median is located
       int median_bin = 0;
@@ -314,21 +327,20 @@ protected:
         // erase all elements from histogram that will leave the window on the LEFT side
         while ((*window_pos_borderleft).getMZ() <  (*window_pos_center).getMZ() - window_half_size)
         {
-          to_bin = std::max(std::min<int>((int)((*window_pos_borderleft).getIntensity() / bin_size), bin_count_minus_1), 0);
-          --histogram[to_bin];
+          --histogram[data_bin[index_borderleft]];
           --elements_in_window;
           ++window_pos_borderleft;
+          ++index_borderleft;
         }
 
         // add all elements to histogram that will enter the window on the RIGHT side
         while ((window_pos_borderright != scan_last_)
               && ((*window_pos_borderright).getMZ() <= (*window_pos_center).getMZ() + window_half_size))
         {
-          //std::cerr << (*window_pos_borderright).getIntensity() << " " << bin_size << " " << bin_count_minus_1 << std::endl;
-          to_bin = std::max(std::min<int>((int)((*window_pos_borderright).getIntensity() / bin_size), bin_count_minus_1), 0);
-          ++histogram[to_bin];
+          ++histogram[data_bin[index_borderright]];
           ++elements_in_window;
           ++window_pos_borderright;
+          ++index_borderright;
         }
 
         if (elements_in_window < min_required_elements_)
@@ -0,0 +1,288 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimator.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Estimates the signal/noise (S/N) ratio of each data point in a scan by using the exact median of a sliding window
+
+    Same windowing as SignalToNoiseEstimatorMedian: for each data point, all
+    data points within +/- <i>win_len</i>/2 Thomson are collected and the
+    noise is the median of their intensities (the lower median for an even
+    number of elements). If a window holds fewer than
+    <i>min_required_elements</i> data points, the noise is set to
+    <i>noise_for_empty_window</i>.
+
+    In contrast to SignalToNoiseEstimatorMedian, no intensity histogram is
+    built, so there is no binning error and no <i>max_intensity</i> estimation
+    is required. The window is maintained in two balanced ordered multisets
+    (lower and upper half), so each data point entering or leaving the window
+    costs O(log w) and the whole scan O(n log w), where w is the number of
+    data points in a window.
+
+    @htmlinclude OpenMS_SignalToNoiseEstimatorMedianRolling.parameters
+
+    @ingroup SignalProcessing
+  */
+  template <typename Container = MSSpectrum>
+  class SignalToNoiseEstimatorMedianRolling :
+    public SignalToNoiseEstimator<Container>
+  {
+
+public:
+
+    using SignalToNoiseEstimator<Container>::stn_estimates_;
+    using SignalToNoiseEstimator<Container>::defaults_;
+    using SignalToNoiseEstimator<Container>::param_;
+
+    typedef typename SignalToNoiseEstimator<Container>::PeakIterator PeakIterator;
+    typedef typename SignalToNoiseEstimator<Container>::PeakType PeakType;
+
+    /// default constructor
+    inline SignalToNoiseEstimatorMedianRolling()
+    {
+      //set the name for DefaultParamHandler error messages
+      this->setName("SignalToNoiseEstimatorMedianRolling");
+
+      defaults_.setValue("win_len", 200.0, "window length in Thomson");
+      defaults_.setMinFloat("win_len", 1.0);
+
+      defaults_.setValue("min_required_elements", 10, "minimum number of elements required in a window (otherwise it is considered sparse)");
+      defaults_.setMinInt("min_required_elements", 1);
+
+      defaults_.setValue("noise_for_empty_window", std::pow(10.0, 20), "noise value used for sparse windows", {"advanced"});
+
+      defaults_.setValue("write_log_messages", "true", "Write out log messages in case of sparse windows");
+      defaults_.setValidStrings("write_log_messages", {"true","false"});
+
+      SignalToNoiseEstimator<Container>::defaultsToParam_();
+    }
+
+    /// Copy Constructor
+    inline SignalToNoiseEstimatorMedianRolling(const SignalToNoiseEstimatorMedianRolling & source) :
+      SignalToNoiseEstimator<Container>(source)
+    {
+      updateMembers_();
+    }
+
+    /// Assignment operator
+    inline SignalToNoiseEstimatorMedianRolling & operator=(const SignalToNoiseEstimatorMedianRolling & source)
+    {
+      if (&source == this) return *this;
+
+      SignalToNoiseEstimator<Container>::operator=(source);
+      updateMembers_();
+      return *this;
+    }
+
+    /// Destructor
+    ~SignalToNoiseEstimatorMedianRolling() override
+    {}
+
+    /// Returns how many percent of the windows were sparse
+    double getSparseWindowPercent() const
+    {
+      return sparse_window_percent_;
+    }
+
+protected:
+
+    /**
+      @brief Sliding median of the intensities in a window
+
+      @p lower_ holds the smaller half (including the median), @p upper_ the
+      larger half; their sizes differ by at most one.
+    */
+    class RollingMedian_
+    {
+    public:
+      void insert(double value)
+      {
+        if (lower_.empty() || value <= *lower_.rbegin())
+        {
+          lower_.insert(value);
+        }
+        else
+        {
+          upper_.insert(value);
+        }
+        rebalance_();
+      }
+
+      void erase(double value)
+      {
+        // all elements in upper_ are >= max(lower_), so a value <= max(lower_) is (also) found in lower_
+        if (!lower_.empty() && value <= *lower_.rbegin())
+        {
+          lower_.erase(lower_.find(value));
+        }
+        else
+        {
+          upper_.erase(upper_.find(value));
+        }
+        rebalance_();
+      }
+
+      /// lower median of all values; the window must not be empty
+      double median() const
+      {
+        return *lower_.rbegin();
+      }
+
+    private:
+      void rebalance_()
+      {
+        if (lower_.size() > upper_.size() + 1)
+        {
+          auto last = std::prev(lower_.end());
+          upper_.insert(*last);
+          lower_.erase(last);
+        }
+        else if (lower_.size() < upper_.size())
+        {
+          lower_.insert(*upper_.begin());
+          upper_.erase(upper_.begin());
+        }
+      }
+
+      std::multiset<double> lower_;
+      std::multiset<double> upper_;
+    };
+
+    /** Calculate signal-to-noise values for all data points given, by using a sliding window approach
+
+        @param c Raw data, usually an MSSpectrum
+    */
+    void computeSTN_(const Container& c) override
+    {
+      // reset counter for sparse windows
+      sparse_window_percent_ = 0;
+
+      // reset the results
+      stn_estimates_.clear();
+      stn_estimates_.resize(c.size());
+      if (c.size() == 0) return;
+
+      const double window_half_size = win_len_ / 2;
+      RollingMedian_ window;
+      int elements_in_window = 0;
+
+      PeakIterator window_pos_borderleft = c.begin();
+      PeakIterator window_pos_borderright = c.begin();
+      Size window_count = 0;
+
+      SignalToNoiseEstimator<Container>::startProgress(0, c.size(), "noise estimation of data");
+      for (PeakIterator window_pos_center = c.begin(); window_pos_center != c.end(); ++window_pos_center, ++window_count)
+      {
+        // remove all elements that leave the window on the LEFT side
+        while ((*window_pos_borderleft).getMZ() < (*window_pos_center).getMZ() - window_half_size)
+        {
+          window.erase((*window_pos_borderleft).getIntensity());
+          --elements_in_window;
+          ++window_pos_borderleft;
+        }
+
+        // add all elements that enter the window on the RIGHT side
+        while ((window_pos_borderright != c.end())
+              && ((*window_pos_borderright).getMZ() <= (*window_pos_center).getMZ() + window_half_size))
+        {
+          window.insert((*window_pos_borderright).getIntensity());
+          ++elements_in_window;
+          ++window_pos_borderright;
+        }
+
+        double noise;
+        if (elements_in_window < min_required_elements_)
+        {
+          noise = noise_for_empty_window_;
+          ++sparse_window_percent_;
+        }
+        else
+        {
+          // just avoid division by 0
+          noise = std::max(1.0, window.median());
+        }
+        stn_estimates_[window_count] = (*window_pos_center).getIntensity() / noise;
+
+        SignalToNoiseEstimator<Container>::setProgress(window_count);
+      }
+      SignalToNoiseEstimator<Container>::endProgress();
+
+      sparse_window_percent_ = sparse_window_percent_ * 100 / window_count;
+
+      // warn if percentage of sparse windows is above 20%
+      if (sparse_window_percent_ > 20 && write_log_messages_)
+      {
+        OPENMS_LOG_WARN << "WARNING in SignalToNoiseEstimatorMedianRolling: "
+                 << sparse_window_percent_
+                 << "% of all windows were sparse. You should consider increasing 'win_len' or decreasing 'min_required_elements'"
+                 << std::endl;
+      }
+    }
+
+    /// overridden function from DefaultParamHandler to keep members up to date, when a parameter is changed
+    void updateMembers_() override
+    {
+      win_len_                 = (double)param_.getValue("win_len");
+      min_required_elements_   = param_.getValue("min_required_elements");
+      noise_for_empty_window_  = (double)param_.getValue("noise_for_empty_window");
+      write_log_messages_      = (bool)param_.getValue("write_log_messages").toBool();
+      stn_estimates_.clear();
+    }
+
+    /// range of data points which belong to a window in Thomson
+    double win_len_;
+    /// minimal number of elements a window needs to cover to be used
+    int min_required_elements_;
+    /// used as noise value for windows which cover less than "min_required_elements_"
+    double noise_for_empty_window_;
+    /// whether to write out log messages in the case of sparse windows
+    bool write_log_messages_;
+    /// counter for sparse windows
+    double sparse_window_percent_;
+  };
+
+} // namespace OpenMS
+
@@ -83,15 +83,25 @@ public:
 
       Convolutes the filter and the profile data and writes the result back to the spectrum.
 
+      The filter is not modified, so the same instance can be used from several threads.
+
       @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
     */
-    void filter(MSSpectrum & spectrum);
+    void filter(MSSpectrum & spectrum) const;
 
-    void filter(MSChromatogram & chromatogram);
+    /**
+      @brief Smoothes an MSChromatogram (thread-safe, see above).
+
+      @exception Exception::IllegalArgument is thrown, if the ppm tolerance is used.
+    */
+    void filter(MSChromatogram & chromatogram) const;
 
     /**
       @brief Smoothes an MSExperiment containing profile data.
 
+      Spectra and chromatograms are filtered in parallel. If filtering fails, the error of the first failing
+      spectrum (or chromatogram) is rethrown.
+
       @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
     */
     void filterExperiment(PeakMap & map);
@@ -37,7 +37,9 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/INTERFACES/DataStructures.h>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <vector>
 
 namespace OpenMS
@@ -61,6 +63,10 @@ namespace OpenMS
 
     @note The data must be sorted according to ascending m/z!
 
+    @note If the data are equidistant (e.g. resampled spectra or regularly sampled chromatograms) and no ppm tolerance
+          is used, the Gaussian is tabulated once for the fixed data point distances and the convolution reduces to
+          plain multiply-adds; see isUniformlySpaced().
+
     @ingroup SignalProcessing
   */
 
@@ -78,7 +84,7 @@ public:
     /**
       @brief Smoothes an Spectrum containing profile data.
     */
-    bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)
+    bool filter(OpenMS::Interfaces::SpectrumPtr spectrum) const
     {
       // create new arrays for mz / intensity data and set their size
       OpenMS::Interfaces::BinaryDataArrayPtr intensity_array(new OpenMS::Interfaces::BinaryDataArray);
@@ -102,7 +108,7 @@ public:
     /**
       @brief Smoothes an Chromatogram containing profile data.
     */
-    bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)
+    bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram) const
     {
       // create new arrays for rt / intensity data and set their size
       OpenMS::Interfaces::BinaryDataArrayPtr intensity_array(new OpenMS::Interfaces::BinaryDataArray);
@@ -127,6 +133,8 @@ public:
       @brief Smoothes an two data arrays containing data.
 
       Convolutes the filter and the profile data and writes the results into the output iterators mz_out and int_out. 
+
+      The method does not modify the filter and can be called concurrently from several threads.
     */
     template <typename ConstIterT, typename IterT>
     bool filter(
@@ -134,8 +142,169 @@ public:
         ConstIterT mz_in_end,
         ConstIterT int_in_start,
         IterT mz_out,
-        IterT int_out)
+        IterT int_out) const
+    {
+      if (use_ppm_tolerance_)
+      {
+        // the kernel is recomputed for every data point; this is done on a copy, so that filter() stays const
+        GaussFilterAlgorithm ppm_algo(*this);
+        return filterPointwise_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, &ppm_algo);
+      }
+
+      // equidistant data: use a kernel tabulated for the fixed data point distances
+      double data_spacing;
+      if (isUniformlySpaced(mz_in_start, mz_in_end, data_spacing))
+      {
+        return filterUniform_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, data_spacing);
+      }
+
+      return filterPointwise_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, nullptr);
+    }
+
+    void initialize(double gaussian_width, double spacing, double ppm_tolerance, bool use_ppm_tolerance);
+
+    /**
+      @brief Checks whether the positions in [first, last) are equidistant
+
+      The data are considered uniform if every position deviates by at most 1e-6 of the average distance from the
+      regular grid through the first and last position. Needs at least three data points.
+
+      @param first Begin of the (sorted) positions
+      @param last End of the positions
+      @param data_spacing The average distance between adjacent positions (only set if true is returned)
+    */
+    template <typename ConstIterT>
+    static bool isUniformlySpaced(ConstIterT first, ConstIterT last, double& data_spacing)
     {
+      const std::ptrdiff_t n = std::distance(first, last);
+      if (n < 3) return false;
+
+      const double origin = *first;
+      const double spacing = (*(last - 1) - origin) / (n - 1);
+      if (!(spacing > 0)) return false;
+
+      const double tolerance = spacing * 1e-6;
+      std::ptrdiff_t i = 0;
+      for (ConstIterT it = first; it != last; ++it, ++i)
+      {
+        if (std::fabs(*it - (origin + i * spacing)) > tolerance) return false;
+      }
+      data_spacing = spacing;
+      return true;
+    }
+
+protected:
+
+    ///Coefficients
+    std::vector<double> coeffs_;
+    /// The standard derivation  \f$ \sigma \f$.
+    double sigma_;
+    /// The spacing of the pre-tabulated kernel coefficients
+    double spacing_;
+
+    // tolerance in ppm
+    bool use_ppm_tolerance_;
+    double ppm_tolerance_;
+
+    /// Interpolates the tabulated Gaussian at distance @p distance_in_gaussian from its center
+    double coefficientAt_(double distance_in_gaussian) const
+    {
+      const Size middle = coeffs_.size();
+      const Size left_position = std::min((Size)floor(distance_in_gaussian / spacing_), middle - 1);
+      const Size right_position = left_position + 1;
+      const double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
+      return (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
+                                       : coeffs_[left_position];
+    }
+
+    /**
+      @brief Same as filter() for equidistant data with distance @p data_spacing
+
+      The window of each data point is determined exactly as in integrate_(), but the Gaussian is evaluated only once
+      per distance (in data points) to the center. As all trapezoids have the same width, the width cancels in the
+      normalization.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterUniform_(
+        ConstIterT mz_in_start,
+        ConstIterT mz_in_end,
+        ConstIterT int_in_start,
+        IterT mz_out,
+        IterT int_out,
+        double data_spacing) const
+    {
+      const std::ptrdiff_t n = std::distance(mz_in_start, mz_in_end);
+      const double half_window = coeffs_.size() * spacing_;
+
+      // kernel value for each distance (in data points) to the center
+      std::vector<double> kernel((std::ptrdiff_t)ceil(half_window / data_spacing) + 2);
+      for (Size k = 0; k < kernel.size(); ++k)
+      {
+        kernel[k] = coefficientAt_(k * data_spacing);
+      }
+      const std::ptrdiff_t max_distance = (std::ptrdiff_t)kernel.size() - 1;
+
+      bool found_signal = false;
+      std::ptrdiff_t lo = 0; // leftmost data point of the current window
+      std::ptrdiff_t hi = 0; // rightmost data point of the current window
+      for (std::ptrdiff_t i = 0; i < n; ++i)
+      {
+        const double x = mz_in_start[i];
+        const double start_pos = std::max(x - half_window, (double)mz_in_start[0]);
+        const double end_pos = std::min(x + half_window, (double)mz_in_start[n - 1]);
+
+        // same window borders as in integrate_(): data points strictly inside (start_pos, end_pos) plus the center
+        while (lo < i && !(mz_in_start[lo] > start_pos)) ++lo;
+        hi = std::max(hi, i);
+        while (hi + 1 < n && mz_in_start[hi + 1] < end_pos) ++hi;
+        lo = std::max(lo, i - max_distance + 1);
+        hi = std::min(hi, i + max_distance - 1);
+
+        double v = 0.;
+        double norm = 0.;
+        for (std::ptrdiff_t h = i; h > lo; --h)
+        {
+          const double c_inner = kernel[i - h];
+          const double c_outer = kernel[i - h + 1];
+          norm += c_outer + c_inner;
+          v += int_in_start[h - 1] * c_outer + int_in_start[h] * c_inner;
+        }
+        for (std::ptrdiff_t h = i; h < hi; ++h)
+        {
+          const double c_inner = kernel[h - i];
+          const double c_outer = kernel[h + 1 - i];
+          norm += c_inner + c_outer;
+          v += int_in_start[h] * c_inner + int_in_start[h + 1] * c_outer;
+        }
+        const double new_int = (v > 0) ? v / norm : 0;
+
+        // store new intensity and m/z into output iterator
+        *mz_out = x;
+        *int_out = new_int;
+        ++mz_out;
+        ++int_out;
+
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
+    /**
+      @brief Convolutes every data point separately (non-uniform data)
+
+      If @p ppm_algo is given, its kernel is re-initialized for the m/z of each data point (ppm tolerance) and used
+      for the convolution, otherwise the kernel of this filter is used.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterPointwise_(
+        ConstIterT mz_in_start,
+        ConstIterT mz_in_end,
+        ConstIterT int_in_start,
+        IterT mz_out,
+        IterT int_out,
+        GaussFilterAlgorithm* ppm_algo) const
+    {
+      const GaussFilterAlgorithm& algo = (ppm_algo != nullptr) ? *ppm_algo : *this;
       bool found_signal = false;
 
       ConstIterT mz_it = mz_in_start;
@@ -143,12 +312,12 @@ public:
       for (; mz_it != mz_in_end; mz_it++, int_it++)
       {
         // if ppm tolerance is used, calculate a reasonable width value for this m/z
-        if (use_ppm_tolerance_)
+        if (ppm_algo != nullptr)
         {
-          initialize((*mz_it) * ppm_tolerance_ * 10e-6, spacing_, ppm_tolerance_, use_ppm_tolerance_ );
+          ppm_algo->initialize((*mz_it) * ppm_tolerance_ * 10e-6, spacing_, ppm_tolerance_, use_ppm_tolerance_);
         }
 
-        double new_int = integrate_(mz_it, int_it, mz_in_start, mz_in_end);
+        double new_int = algo.integrate_(mz_it, int_it, mz_in_start, mz_in_end);
         
         // store new intensity and m/z into output iterator
         *mz_out = *mz_it;
@@ -161,24 +330,9 @@ public:
       return found_signal;
     }
 
-    void initialize(double gaussian_width, double spacing, double ppm_tolerance, bool use_ppm_tolerance);
-
-protected:
-
-    ///Coefficients
-    std::vector<double> coeffs_;
-    /// The standard derivation  \f$ \sigma \f$.
-    double sigma_;
-    /// The spacing of the pre-tabulated kernel coefficients
-    double spacing_;
-
-    // tolerance in ppm
-    bool use_ppm_tolerance_;
-    double ppm_tolerance_;
-
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
-    double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
+    double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last) const
     {
       double v = 0.;
       // norm the gaussian kernel area to one
@@ -184,47 +184,79 @@ public:
 
     /**
       @brief Removed the noise from an MSSpectrum containing profile data.
+
+      The filter is not modified, so the same instance can be used from several threads.
     */
-    void filter(MSSpectrum & spectrum)
+    void filter(MSSpectrum & spectrum) const
     {
-      // copy the data AND META DATA to the output container
-      MSSpectrum output = spectrum;
-      // filter
-      filter(spectrum.begin(), spectrum.end(), output.begin());
-      // swap back
-      std::swap(spectrum, output);
+      std::vector<double> buffer;
+      filterInPlace_(spectrum, buffer);
     }
 
     /**
-      @brief Removed the noise from an MSChromatogram
+      @brief Removed the noise from an MSChromatogram (thread-safe, see above)
     */
-    void filter(MSChromatogram & chromatogram)
+    void filter(MSChromatogram & chromatogram) const
     {
-      // copy the data AND META DATA to the output container
-      MSChromatogram output = chromatogram;
-      // filter
-      filter(chromatogram.begin(), chromatogram.end(), output.begin());
-      // swap back
-      std::swap(chromatogram, output);
+      std::vector<double> buffer;
+      filterInPlace_(chromatogram, buffer);
+    }
+
+    /**
+      @brief Removes the noise from many chromatograms at once (in parallel, in place)
+
+      All chromatograms share the coefficient table of this filter. Each thread reuses a single intensity
+      buffer for all of its chromatograms, so no per-chromatogram copies are made.
+      The result is identical to calling filter() on each chromatogram.
+    */
+    void filterChromatograms(std::vector<MSChromatogram> & chromatograms) const;
+
+    /**
+      @brief Smoothes the raw intensity values @p intensities into @p smoothed (thread-safe, no allocation if @p smoothed has enough capacity)
+
+      The values are identical to those obtained by filter() on a spectrum with these intensities (i.e. they are
+      rounded to the precision of Peak1D). Data shorter than the frame length is returned unchanged.
+    */
+    void smoothIntensities(const std::vector<double> & intensities, std::vector<double> & smoothed) const
+    {
+      const Size n = intensities.size();
+      smoothed.resize(n);
+      if (frame_size_ > n)
+      {
+        for (Size p = 0; p < n; ++p)
+        {
+          smoothed[p] = Peak1D::IntensityType(intensities[p]);
+        }
+        return;
+      }
+      smooth_(intensities.data(), n, [&smoothed](Size p, double value) { smoothed[p] = Peak1D::IntensityType(value); });
     }
 
     /**
       @brief Removed the noise from an MSExperiment containing profile data.
+
+      Spectra and chromatograms are filtered in parallel, each thread reusing one intensity buffer.
     */
     void filterExperiment(PeakMap & map)
     {
       Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      const SignedSize n_spectra = (SignedSize)map.size();
+#pragma omp parallel
       {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
+        std::vector<double> buffer; // one intensity buffer per thread
+#pragma omp for schedule(dynamic)
+        for (SignedSize i = 0; i < n_spectra; ++i)
+        {
+          filterInPlace_(map[i], buffer);
+#pragma omp critical (SavitzkyGolayFilter_FilterExperiment)
+          {
+            setProgress(++progress);
+          }
+        }
       }
+      filterChromatograms(map.getChromatograms());
+      setProgress(progress + map.getChromatograms().size());
       endProgress();
     }
 
@@ -238,6 +270,77 @@ protected:
     /// The order of the smoothing polynomial.
     UInt order_;
 
+    /**
+      @brief Filters the intensities of @p container in place (positions and meta data are kept)
+
+      @p buffer receives a copy of the input intensities; it is only enlarged, so it can be reused across calls.
+      Same result as filter(first, last, d_first).
+    */
+    template <typename ContainerT>
+    void filterInPlace_(ContainerT & container, std::vector<double> & buffer) const
+    {
+      const Size n = container.size();
+      if (frame_size_ > n) { return; }
+
+      if (buffer.size() < n) buffer.resize(n);
+      for (Size p = 0; p < n; ++p)
+      {
+        buffer[p] = container[p].getIntensity();
+      }
+      smooth_(buffer.data(), n, [&container](Size p, double value) { container[p].setIntensity(value); });
+    }
+
+    /**
+      @brief Applies the filter to the raw values @p in (@p n values, at least frame length) and passes each result to @p out(index, value)
+
+      This is the kernel of filterInPlace_() and smoothIntensities(); @p in must not be modified by @p out.
+    */
+    template <typename OutputT>
+    void smooth_(const double* in, const Size n, OutputT out) const
+    {
+      const double* coeffs = coeffs_.data();
+      const Size frame = frame_size_;
+      const Size mid = frame_size_ / 2;
+
+      // transient on: the first frame data points, with the coefficient rows in reverse
+      for (Size i = 0; i <= mid; ++i)
+      {
+        const double* c = coeffs + (i + 1) * frame - 1;
+        double help = 0;
+        for (Size j = 0; j < frame; ++j)
+        {
+          help += in[j] * c[-(std::ptrdiff_t)j];
+        }
+        out(i, std::max(0.0, help));
+      }
+
+      // steady state: centered window
+      const double* c_mid = coeffs + mid * frame;
+      for (Size p = mid + 1; p < n - mid; ++p)
+      {
+        const double* x = in + p - mid;
+        double help = 0;
+        for (Size j = 0; j < frame; ++j)
+        {
+          help += x[j] * c_mid[j];
+        }
+        out(p, std::max(0.0, help));
+      }
+
+      // transient off: the last frame data points
+      const double* x_last = in + n - frame;
+      for (Size p = n - mid; p < n; ++p)
+      {
+        const double* c = coeffs + (n - 1 - p) * frame;
+        double help = 0;
+        for (Size j = 0; j < frame; ++j)
+        {
+          help += x_last[j] * c[j];
+        }
+        out(p, std::max(0.0, help));
+      }
+    }
+
     // Docu in base class
     void updateMembers_() override;
   };
@@ -90,11 +90,36 @@ public:
       int number_resampled_points = (int)(ceil((end_pos - start_pos) / spacing_ + 1));
 
       std::vector<typename SpecT::PeakType> resampled_peak_container;
-      populate_raster_(resampled_peak_container, start_pos, end_pos, number_resampled_points);
+      raster(container, resampled_peak_container);
+    }
+
+    /**
+        @brief Applies the resampling algorithm to a container, using a caller-supplied buffer.
+
+        Same as raster(SpecT&), but the resampled peaks are generated in @p
+        buffer which is then swapped with the content of @p container. After
+        the call, @p buffer holds the (former) input peaks and its capacity can
+        be reused by the next call, so resampling many containers in a loop
+        does not allocate once the buffer has grown to the required size.
+
+        @param container The container to be resampled
+        @param buffer Scratch space for the resampled peaks (content is discarded)
+    */
+    template <class SpecT>
+    void raster(SpecT& container, std::vector<typename SpecT::PeakType>& buffer)
+    {
+      //return if nothing to do
+      if (container.empty()) return;
 
-      raster(container.begin(), container.end(), resampled_peak_container.begin(), resampled_peak_container.end());
+      double end_pos = (container.end() - 1)->getMZ();
+      double start_pos = container.begin()->getMZ();
+      int number_resampled_points = (int)(ceil((end_pos - start_pos) / spacing_ + 1));
+
+      populate_raster_(buffer, start_pos, end_pos, number_resampled_points);
 
-      container.swap(resampled_peak_container);
+      raster(container.begin(), container.end(), buffer.begin(), buffer.end());
+
+      container.swap(buffer);
     }
 
     /**
@@ -125,21 +150,60 @@ public:
         return;
       }
 
-      typename SpecT::iterator first = container.begin();
-      typename SpecT::iterator last = container.end();
-
-      // get the iterators just before / after the two points start_pos / end_pos
-      while (first != container.end() && (first)->getMZ() < start_pos) {++first;}
-      while (last != first && (last - 1)->getMZ() > end_pos) {--last;}
-
       int number_resampled_points = (int)(ceil((end_pos - start_pos) / spacing_ + 1));
 
       std::vector<typename SpecT::PeakType> resampled_peak_container;
       populate_raster_(resampled_peak_container, start_pos, end_pos, number_resampled_points);
 
-      raster(first, last, resampled_peak_container.begin(), resampled_peak_container.end());
+      raster_onto_(container, resampled_peak_container, start_pos, end_pos);
+    }
 
-      container.swap(resampled_peak_container);
+    /**
+        @brief Resamples a set of containers onto one common raster in parallel.
+
+        Equivalent to calling raster_align(SpecT&, double, double) with the
+        same @p start_pos and @p end_pos on every element of @p containers,
+        but the raster is generated only once and each thread reuses its own
+        output buffer. Containers are processed in parallel (if OpenMP is
+        enabled).
+
+        @param containers The containers to be resampled (in-place)
+        @param start_pos The start position to be used for resampling
+        @param end_pos The end position to be used for resampling
+    */
+    template <typename SpecT>
+    void raster_align_all(std::vector<SpecT>& containers, double start_pos, double end_pos)
+    {
+      if (containers.empty()) return;
+
+      if (end_pos < start_pos)
+      {
+        for (SpecT& container : containers)
+        {
+          std::vector<typename SpecT::PeakType> empty;
+          container.swap(empty);
+        }
+        return;
+      }
+
+      int number_resampled_points = (int)(ceil((end_pos - start_pos) / spacing_ + 1));
+
+      // the common raster, copied into the thread-local buffers below
+      std::vector<typename SpecT::PeakType> grid;
+      populate_raster_(grid, start_pos, end_pos, number_resampled_points);
+
+#pragma omp parallel
+      {
+        std::vector<typename SpecT::PeakType> buffer;
+#pragma omp for schedule(dynamic, 16)
+        for (SignedSize i = 0; i < (SignedSize)containers.size(); ++i)
+        {
+          SpecT& container = containers[i];
+          if (container.empty()) continue;
+          buffer.assign(grid.begin(), grid.end());
+          raster_onto_(container, buffer, start_pos, end_pos);
+        }
+      }
     }
 
     /**
@@ -350,11 +414,35 @@ protected:
       ppm_ =  (bool)param_.getValue("ppm").toBool();
     }
 
-    /// Generate raster for resampled peak container
+    /**
+        @brief Resamples the part of @p container between @p start_pos and @p end_pos onto @p grid
+
+        @p grid needs to be populated (m/z set, intensities zero). It is
+        swapped with @p container afterwards, i.e. it holds the former input
+        peaks on return.
+    */
+    template <typename SpecT>
+    void raster_onto_(SpecT& container, std::vector<typename SpecT::PeakType>& grid,
+        double start_pos, double end_pos)
+    {
+      typename SpecT::iterator first = container.begin();
+      typename SpecT::iterator last = container.end();
+
+      // get the iterators just before / after the two points start_pos / end_pos
+      while (first != container.end() && (first)->getMZ() < start_pos) {++first;}
+      while (last != first && (last - 1)->getMZ() > end_pos) {--last;}
+
+      raster(first, last, grid.begin(), grid.end());
+
+      container.swap(grid);
+    }
+
+    /// Generate raster for resampled peak container (any previous content of the container is discarded)
     template <typename PeakType>
     void populate_raster_(std::vector<PeakType>& resampled_peak_container,
         double start_pos, double end_pos, int number_resampled_points)
     {
+      resampled_peak_container.clear();
       if (!ppm_)
       {
         // generate the resampled peaks at positions origin+i*spacing_
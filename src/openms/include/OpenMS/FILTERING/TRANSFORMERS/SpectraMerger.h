@@ -46,6 +46,8 @@
 #include <OpenMS/KERNEL/BaseFeature.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+
+#include <exception>
 #include <vector>
 
 namespace OpenMS
@@ -205,78 +207,50 @@ public:
       exp.sortSpectra();
     }
 
-    /// merges spectra with similar precursors (must have MS2 level)
+    /**
+      @brief merges spectra with similar precursors (must have MS2 level)
+
+      Two MS2 spectra are linked if their precursors are within
+      precursor_method:rt_tolerance and precursor_method:mz_tolerance of each
+      other; all spectra connected by such links (single linkage) are merged
+      into one block. Candidate neighbours are found by a range query in a 2D
+      tree over (RT, precursor m/z), so no pairwise distance matrix is needed.
+    */
     template <typename MapType>
     void mergeSpectraPrecursors(MapType& exp)
     {
-
       // convert spectra's precursors to clusterizable data
-      Size data_size;
-      std::vector<BinaryTreeNode> tree;
-      std::map<Size, Size> index_mapping;
-      // local scope to save memory - we do not need the clustering stuff later
+      std::vector<Size> index_mapping; // index in data ==> experiment index
+      std::vector<BaseFeature> data;
+      for (Size i = 0; i < exp.size(); ++i)
       {
-        std::vector<BaseFeature> data;
-
-        for (Size i = 0; i < exp.size(); ++i)
+        if (exp[i].getMSLevel() != 2)
         {
-          if (exp[i].getMSLevel() != 2)
-          {
-            continue;
-          }
-
-          // remember which index in distance data ==> experiment index
-          index_mapping[data.size()] = i;
-
-          // make cluster element
-          BaseFeature bf;
-          bf.setRT(exp[i].getRT());
-          const auto& pcs = exp[i].getPrecursors(); 
-          // keep the first Precursor
-          if (pcs.empty())
-          {
-            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
-          }
-          if (pcs.size() > 1)
-          {
-            OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
-          }
-          bf.setMZ(pcs[0].getMZ());
-          data.push_back(bf);
+          continue;
         }
-        data_size = data.size();
 
-        SpectraDistance_ llc;
-        llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
+        // remember which index in distance data ==> experiment index
+        index_mapping.push_back(i);
 
-        //ch.setThreshold(0.99);
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
-      }
-
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
+        // make cluster element
+        BaseFeature bf;
+        bf.setRT(exp[i].getRT());
+        const auto& pcs = exp[i].getPrecursors(); 
+        // keep the first Precursor
+        if (pcs.empty())
         {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
         }
-        if (tree[ii].distance != -1)
+        if (pcs.size() > 1)
         {
-          ++node_count;
+          OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
         }
+        bf.setMZ(pcs[0].getMZ());
+        data.push_back(bf);
       }
-      ca.cut(data_size - node_count, tree, clusters);
 
-      //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
-      //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
+      std::vector<std::vector<Size> > clusters;
+      clusterPrecursors_(data, clusters);
 
       // convert to blocks
       MergeBlocks spectra_to_merge;
@@ -289,11 +263,11 @@ public:
         }
         // init block with first cluster element
         Size cl_index0 = clusters[i_outer][0];
-        spectra_to_merge[index_mapping[cl_index0]] = std::vector<Size>();
+        std::vector<Size>& block = spectra_to_merge[index_mapping[cl_index0]];
         // add all other elements
         for (Size i_inner = 1; i_inner < clusters[i_outer].size(); ++i_inner)
         {
-          spectra_to_merge[index_mapping[cl_index0]].push_back(index_mapping[clusters[i_outer][i_inner]]);
+          block.push_back(index_mapping[clusters[i_outer][i_inner]]);
         }
       }
 
@@ -490,6 +464,14 @@ public:
 
 protected:
 
+    /**
+        @brief clusters precursors by single linkage within the precursor_method tolerances
+
+        @param data precursors (RT and m/z) of all spectra to be clustered
+        @param clusters resulting clusters (indices into @p data); each cluster is sorted and clusters are ordered by their first element
+    */
+    void clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const;
+
     /**
         @brief merges blocks of spectra of a certain level
 
@@ -523,126 +505,155 @@ protected:
 
       p.setValue("is_relative_tolerance", mz_binning_unit == "Da" ? "false" : "true");
       sas.setParameters(p);
-      std::vector<std::pair<Size, Size> > alignment;
 
       Size count_peaks_aligned(0);
       Size count_peaks_overall(0);
 
-      // each BLOCK
+      // blocks are independent of each other and are merged in parallel
+      std::vector<std::pair<Size, const std::vector<Size>*> > blocks;
+      blocks.reserve(spectra_to_merge.size());
       for (auto it = spectra_to_merge.begin(); it != spectra_to_merge.end(); ++it)
       {
         ++cluster_sizes[it->second.size() + 1]; // for stats
-
-        typename MapType::SpectrumType consensus_spec = exp[it->first];
-        consensus_spec.setMSLevel(ms_level);
-
-        //consensus_spec.unify(exp[it->first]); // append meta info
         merged_indices.insert(it->first);
+        merged_indices.insert(it->second.begin(), it->second.end());
+        blocks.emplace_back(it->first, &it->second);
+      }
 
-        //typename MapType::SpectrumType all_peaks = exp[it->first];
-        double rt_average = consensus_spec.getRT();
-        double precursor_mz_average = 0.0;
-        Size precursor_count(0);
-        if (!consensus_spec.getPrecursors().empty())
-        {
-          precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
-          ++precursor_count;
-        }
-
-        count_peaks_overall += consensus_spec.size();
+      std::vector<typename MapType::SpectrumType> consensus_spectra(blocks.size());
+      std::vector<std::exception_ptr> errors(blocks.size());
 
-        // block elements
-        for (auto sit = it->second.begin(); sit != it->second.end(); ++sit)
+      // each BLOCK
+#pragma omp parallel for schedule(dynamic) reduction(+: count_peaks_aligned, count_peaks_overall)
+      for (SignedSize block_idx = 0; block_idx < (SignedSize)blocks.size(); ++block_idx)
+      {
+        try
         {
-          consensus_spec.unify(exp[*sit]); // append meta info
-          merged_indices.insert(*sit);
-
-          rt_average += exp[*sit].getRT();
-          if (ms_level >= 2 && exp[*sit].getPrecursors().size() > 0)
+          const Size master_idx = blocks[block_idx].first;
+          const std::vector<Size>& sacrifices = *blocks[block_idx].second;
+          std::vector<std::pair<Size, Size> > alignment;
+          SpectrumAlignment::Workspace alignment_ws; // reused for all spectra of the block
+
+          typename MapType::SpectrumType& consensus_spec = consensus_spectra[block_idx];
+          consensus_spec = exp[master_idx];
+          consensus_spec.setMSLevel(ms_level);
+
+          //consensus_spec.unify(exp[it->first]); // append meta info
+
+          //typename MapType::SpectrumType all_peaks = exp[it->first];
+          double rt_average = consensus_spec.getRT();
+          double precursor_mz_average = 0.0;
+          Size precursor_count(0);
+          if (!consensus_spec.getPrecursors().empty())
           {
-            precursor_mz_average += exp[*sit].getPrecursors()[0].getMZ();
+            precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
             ++precursor_count;
           }
 
-          // merge data points
-          sas.getSpectrumAlignment(alignment, consensus_spec, exp[*sit]);
-          //std::cerr << "alignment of " << it->first << " with " << *sit << " yielded " << alignment.size() << " common peaks!\n";
-          count_peaks_aligned += alignment.size();
-          count_peaks_overall += exp[*sit].size();
-
-          Size align_index(0);
-          Size spec_b_index(0);
+          count_peaks_overall += consensus_spec.size();
 
-          // sanity check for number of peaks
-          Size spec_a = consensus_spec.size(), spec_b = exp[*sit].size(), align_size = alignment.size();
-          for (auto pit = exp[*sit].begin(); pit != exp[*sit].end(); ++pit)
+          // block elements
+          for (auto sit = sacrifices.begin(); sit != sacrifices.end(); ++sit)
           {
-            if (alignment.empty() || alignment[align_index].second != spec_b_index)
-              // ... add unaligned peak
+            consensus_spec.unify(exp[*sit]); // append meta info
+
+            rt_average += exp[*sit].getRT();
+            if (ms_level >= 2 && exp[*sit].getPrecursors().size() > 0)
             {
-              consensus_spec.push_back(*pit);
+              precursor_mz_average += exp[*sit].getPrecursors()[0].getMZ();
+              ++precursor_count;
             }
-            // or add aligned peak height to ALL corresponding existing peaks
-            else
-            {
-              Size counter(0);
-              Size copy_of_align_index(align_index);
 
-              while (!alignment.empty() && 
-                     copy_of_align_index < alignment.size() && 
-                     alignment[copy_of_align_index].second == spec_b_index)
-              {
-                ++copy_of_align_index;
-                ++counter;
-              } // Count the number of peaks in a which correspond to a single b peak.
+            // merge data points
+            sas.getSpectrumAlignment(alignment, consensus_spec, exp[*sit], alignment_ws);
+            //std::cerr << "alignment of " << it->first << " with " << *sit << " yielded " << alignment.size() << " common peaks!\n";
+            count_peaks_aligned += alignment.size();
+            count_peaks_overall += exp[*sit].size();
 
-              while (!alignment.empty() &&
-                     align_index < alignment.size() &&  
-                     alignment[align_index].second == spec_b_index)
+            Size align_index(0);
+            Size spec_b_index(0);
+
+            // sanity check for number of peaks
+            Size spec_a = consensus_spec.size(), spec_b = exp[*sit].size(), align_size = alignment.size();
+            for (auto pit = exp[*sit].begin(); pit != exp[*sit].end(); ++pit)
+            {
+              if (alignment.empty() || alignment[align_index].second != spec_b_index)
+                // ... add unaligned peak
+              {
+                consensus_spec.push_back(*pit);
+              }
+              // or add aligned peak height to ALL corresponding existing peaks
+              else
               {
-                consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
-                    (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
-                ++align_index; // this aligned peak was explained, wait for next aligned peak ...
-                if (align_index == alignment.size())
+                Size counter(0);
+                Size copy_of_align_index(align_index);
+
+                while (!alignment.empty() && 
+                       copy_of_align_index < alignment.size() && 
+                       alignment[copy_of_align_index].second == spec_b_index)
+                {
+                  ++copy_of_align_index;
+                  ++counter;
+                } // Count the number of peaks in a which correspond to a single b peak.
+
+                while (!alignment.empty() &&
+                       align_index < alignment.size() &&  
+                       alignment[align_index].second == spec_b_index)
                 {
-                  alignment.clear();  // end reached -> avoid going into this block again
+                  consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
+                      (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
+                  ++align_index; // this aligned peak was explained, wait for next aligned peak ...
+                  if (align_index == alignment.size())
+                  {
+                    alignment.clear();  // end reached -> avoid going into this block again
+                  }
                 }
+                align_size = align_size + 1 - counter; //Decrease align_size by number of
               }
-              align_size = align_size + 1 - counter; //Decrease align_size by number of
+              ++spec_b_index;
+            }
+            consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
+            if (spec_a + spec_b - align_size != consensus_spec.size())
+            {
+              OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
             }
-            ++spec_b_index;
-          }
-          consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
-          if (spec_a + spec_b - align_size != consensus_spec.size())
-          {
-            OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
           }
-        }
-        rt_average /= it->second.size() + 1;
-        consensus_spec.setRT(rt_average);
+          rt_average /= sacrifices.size() + 1;
+          consensus_spec.setRT(rt_average);
 
-        if (ms_level >= 2)
-        {
-          if (precursor_count)
+          if (ms_level >= 2)
           {
-            precursor_mz_average /= precursor_count;
+            if (precursor_count)
+            {
+              precursor_mz_average /= precursor_count;
+            }
+            auto& pcs = consensus_spec.getPrecursors();
+            //if (pcs.size()>1) OPENMS_LOG_WARN << "Removing excessive precursors - leaving only one per MS2 spectrum.\n";
+            pcs.resize(1);
+            pcs[0].setMZ(precursor_mz_average);
           }
-          auto& pcs = consensus_spec.getPrecursors();
-          //if (pcs.size()>1) OPENMS_LOG_WARN << "Removing excessive precursors - leaving only one per MS2 spectrum.\n";
-          pcs.resize(1);
-          pcs[0].setMZ(precursor_mz_average);
         }
-
-        if (consensus_spec.empty())
+        catch (...)
         {
-          continue;
+          errors[block_idx] = std::current_exception();
         }
-        else
+      }
+
+      // rethrow the first error (in block order)
+      for (const std::exception_ptr& error : errors)
+      {
+        if (error) std::rethrow_exception(error);
+      }
+
+      for (typename MapType::SpectrumType& consensus_spec : consensus_spectra)
+      {
+        if (!consensus_spec.empty())
         {
           merged_spectra.addSpectrum(std::move(consensus_spec));
         }
       }
 
+
       OPENMS_LOG_INFO << "Cluster sizes:\n";
       for (const auto& cl_size : cluster_sizes)
       {
@@ -768,8 +779,7 @@ protected:
         }
 
         // update spectrum
-        typename MapType::SpectrumType average_spec = exp[it->first];
-        average_spec.clear(false); // Precursors are part of the meta data, which are not deleted.
+        typename MapType::SpectrumType average_spec = exp[it->first].copyWithoutPeaks(); // Precursors are part of the meta data, which are kept.
         //average_spec.setMSLevel(ms_level);
 
         // refill spectrum
@@ -789,11 +799,9 @@ protected:
 
       // loop over blocks
       int n(0);
-      //typename MapType::SpectrumType empty_spec;
       for (AverageBlocks::const_iterator it = spectra_to_average_over.begin(); it != spectra_to_average_over.end(); ++it)
       {
-        exp[it->first] = exp_tmp[n];
-        //exp_tmp[n] = empty_spec;
+        exp[it->first] = std::move(exp_tmp[n]);
         ++n;
       }
     }
@@ -885,8 +893,7 @@ protected:
         }
 
         // update spectrum
-        typename MapType::SpectrumType average_spec = exp[it->first];
-        average_spec.clear(false); // Precursors are part of the meta data, which are not deleted.
+        typename MapType::SpectrumType average_spec = exp[it->first].copyWithoutPeaks(); // Precursors are part of the meta data, which are kept.
         //average_spec.setMSLevel(ms_level);
 
         // refill spectrum
@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Applies a configurable chain of fragment spectrum filters in a single pass
+
+    Search engines typically preprocess MS2 spectra by running ThresholdMower,
+    Normalizer, Deisotoper, WindowMower (jumping window), NLargest and
+    SqrtMower one after the other. Each of these filters copies and/or
+    re-sorts the spectrum. This class performs the same operations, in the
+    order given by the @p steps parameter, on one position-sorted spectrum:
+    peaks removed by a step are only marked as discarded and the spectrum is
+    compacted once at the end (or before deisotoping, which needs an actual
+    spectrum). Intensity transforms (normalization, square root) only touch
+    the peaks still alive.
+
+    Available steps and their counterparts:
+    - @em threshold: ThresholdMower (remove peaks with intensity below @p threshold:threshold)
+    - @em normalize: Normalizer (@p normalize:method "to_one" or "to_TIC")
+    - @em deisotope: Deisotoper::deisotopeAndSingleCharge with the @p deisotope: parameters
+    - @em window_mower: WindowMower in jumping window mode (@p window_mower:windowsize, @p window_mower:peakcount)
+    - @em nlargest: NLargest (@p nlargest:n)
+    - @em sqrt: SqrtMower (negative intensities are set to zero)
+
+    The resulting spectrum is sorted by position. Peaks of equal intensity
+    competing for the last slot in window_mower / nlargest are resolved in
+    favour of the lower m/z.
+
+    @htmlinclude OpenMS_SpectrumPreprocessingPipeline.parameters
+
+    @ingroup SpectraPreprocessers
+  */
+  class OPENMS_DLLAPI SpectrumPreprocessingPipeline :
+    public DefaultParamHandler
+  {
+public:
+
+    // @name Constructors, destructors and assignment operators
+    // @{
+    /// default constructor
+    SpectrumPreprocessingPipeline();
+    /// destructor
+    ~SpectrumPreprocessingPipeline() override;
+
+    /// copy constructor
+    SpectrumPreprocessingPipeline(const SpectrumPreprocessingPipeline& source);
+    /// assignment operator
+    SpectrumPreprocessingPipeline& operator=(const SpectrumPreprocessingPipeline& source);
+    // @}
+
+    /// applies all steps to @p spectrum (the result is sorted by position)
+    void filterPeakSpectrum(PeakSpectrum& spectrum) const;
+
+    /// applies all steps to every spectrum of @p exp (in parallel)
+    void filterPeakMap(PeakMap& exp) const;
+
+protected:
+
+    /// processing steps
+    enum Step_
+    {
+      THRESHOLD,
+      NORMALIZE,
+      DEISOTOPE,
+      WINDOW_MOWER,
+      NLARGEST,
+      SQRT
+    };
+
+    void updateMembers_() override;
+
+    /// keep the @p count most intense of the alive peaks in [@p first, @p last) (positions in @p alive), mark the others in @p discard
+    static void keepMostIntense_(const PeakSpectrum& spectrum, const std::vector<Size>& alive, Size first, Size last, Size count,
+                                 std::vector<Size>& order, std::vector<char>& discard);
+
+    /// removes all entries of @p alive which are marked in @p discard (order is preserved)
+    static void compact_(std::vector<Size>& alive, const std::vector<char>& discard);
+
+    std::vector<Step_> steps_;
+
+    double threshold_;
+    bool normalize_to_tic_;
+
+    double deisotope_tolerance_;
+    bool deisotope_unit_ppm_;
+    int deisotope_min_charge_;
+    int deisotope_max_charge_;
+    bool deisotope_keep_only_deisotoped_;
+    unsigned int deisotope_min_isopeaks_;
+    unsigned int deisotope_max_isopeaks_;
+    bool deisotope_make_single_charged_;
+    bool deisotope_annotate_charge_;
+
+    double window_size_;
+    Size window_peakcount_;
+
+    Size nlargest_;
+  };
+
+}
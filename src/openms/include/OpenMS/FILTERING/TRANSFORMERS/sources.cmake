@@ -22,6 +22,7 @@ ParentPeakMower.h
 PeakMarker.h
 Scaler.h
 SpectraMerger.h
+SpectrumPreprocessingPipeline.h
 SqrtMower.h
 TICFilter.h
 ThresholdMower.h
@@ -48,6 +48,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cmath>
+#include <cstring>
 #include <vector>
 
 #include <QByteArray>
@@ -149,6 +150,24 @@ public:
     */
     static void decodeSingleString(const String& in, QByteArray& base64_uncompressed, bool zlib_compression);
 
+    /**
+        @brief Decodes Base64 characters to raw bytes
+
+        Works directly on a character span (e.g. the buffer of an XML parser)
+        and does not create any intermediate strings: the characters are
+        decoded into a scratch buffer owned by the calling thread and
+        inflated from there straight into @p out. Pass the same @p out
+        repeatedly to avoid any allocations when decoding many arrays.
+
+        @param in The Base64 encoded characters
+        @param in_size The number of characters in @p in
+        @param out The decoded (and decompressed) bytes
+        @param zlib_compression Whether the data should be decompressed with zlib after decoding in Base64
+
+        @throw Exception::ConversionError if the data cannot be decompressed
+    */
+    static void decodeBytes(const char* in, Size in_size, std::vector<Byte>& out, bool zlib_compression);
+
 private:
 
     ///Internal class needed for type-punning
@@ -165,8 +184,58 @@ private:
       UInt32 i;
     };
 
-    static const char encoder_[];
-    static const char decoder_[];
+    /**
+      @brief Decodes @p in_size Base64 characters (padding already stripped) to raw bytes
+
+      Uses SIMD instructions if possible (AVX2 / SSSE3 selected at runtime on
+      x86, NEON on ARM64) and falls back to a table-driven scalar decoder.
+      Invalid characters are decoded as zero bits (as before, no validation takes place).
+
+      @param in Base64 characters
+      @param in_size Number of characters in @p in (without trailing '=')
+      @param out Output buffer which must hold at least (in_size * 3) / 4 bytes
+
+      @return The number of bytes written to @p out
+    */
+    static Size decodeRaw_(const char* in, Size in_size, Byte* out);
+
+    /**
+      @brief Encodes @p in_size raw bytes to a (padded) Base64 string
+
+      Uses SIMD instructions if possible (see decodeRaw_()).
+    */
+    static void encodeRaw_(const Byte* in, Size in_size, String& out);
+
+    /// Returns true if data encoded in @p byte_order needs to be byte-swapped on this machine
+    static bool needsSwap_(ByteOrder byte_order)
+    {
+      return (OPENMS_IS_BIG_ENDIAN && byte_order == Base64::BYTEORDER_LITTLEENDIAN) ||
+             (!OPENMS_IS_BIG_ENDIAN && byte_order == Base64::BYTEORDER_BIGENDIAN);
+    }
+
+    /// Decodes Base64 string @p in directly into the memory of @p out (resized to the number of complete elements)
+    template <typename ToType>
+    static void decodeIntoVector_(const String& in, std::vector<ToType>& out);
+
+    /// Returns the number of Base64 characters of @p in_size characters that are not padding
+    static Size stripPadding_(const char* in, Size in_size)
+    {
+      if (in_size > 0 && in[in_size - 1] == '=') --in_size;
+      if (in_size > 0 && in[in_size - 1] == '=') --in_size;
+      return in_size;
+    }
+
+    /**
+      @brief Decodes and decompresses @p in into a buffer owned by the calling thread
+
+      The buffer will be overwritten by the next call from the same thread.
+    */
+    static const std::vector<Byte>& decompressToThreadBuffer_(const String& in);
+
+    /// Interprets the bytes of @p out as integers of the same size and converts them to ToType in place
+    template <typename ToType>
+    static void convertIntegersInPlace_(std::vector<ToType>& out, bool swap);
+
     /// Decodes a Base64 string to a vector of floating point numbers
     template <typename ToType>
     static void decodeUncompressed_(const String & in, ByteOrder from_byte_order, std::vector<ToType> & out);
@@ -280,57 +349,14 @@ private:
       String(compressed).swap(compressed);
       it = reinterpret_cast<Byte *>(&compressed[0]);
       end = it + compressed_length;
-      out.resize((Size)ceil(compressed_length / 3.) * 4);     //resize output array in order to have enough space for all characters
     }
     //encode without compression
     else
     {
-      out.resize((Size)ceil(input_bytes / 3.) * 4);     //resize output array in order to have enough space for all characters
       it = reinterpret_cast<Byte *>(&in[0]);
       end = it + input_bytes;
     }
-
-    Byte * to = reinterpret_cast<Byte *>(&out[0]);
-
-
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-        to[3] = '=';
-      if (padding_count > 1)
-        to[2] = '=';
-
-      to += 4;
-      written += 4;
-    }
-
-    out.resize(written);         //no more space is needed
+    encodeRaw_(it, end - it, out);
   }
 
   template <typename ToType>
@@ -354,55 +380,47 @@ private:
 
     const Size element_size = sizeof(ToType);
 
-    String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-
-    if (base64_uncompressed.isEmpty())
+    const std::vector<Byte>& decompressed = decompressToThreadBuffer_(in);
+    if (decompressed.size() % element_size != 0)
     {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
     }
-    decompressed.resize(base64_uncompressed.size());
 
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
-
-    void* byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
-    Size buffer_size = decompressed.size();
+    // copy values
+    out.resize(decompressed.size() / element_size);
+    std::memcpy(out.data(), decompressed.data(), decompressed.size());
 
-    const ToType * float_buffer = reinterpret_cast<const ToType *>(byte_buffer);
-    if (buffer_size % element_size != 0)
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-    }
-    
-    Size float_count = buffer_size / element_size;
-    
     // change endianness if necessary
-    if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
+    if (needsSwap_(from_byte_order))
     {
       if (element_size == 4) // 32 bit
       {
-        UInt32 * p = reinterpret_cast<UInt32 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize32);
+        UInt32 * p = reinterpret_cast<UInt32 *>(out.data());
+        std::transform(p, p + out.size(), p, endianize32);
       }
       else // 64 bit
       {
-        UInt64 * p = reinterpret_cast<UInt64 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize64);
+        UInt64 * p = reinterpret_cast<UInt64 *>(out.data());
+        std::transform(p, p + out.size(), p, endianize64);
       }
     }
+  }
 
-    // copy values
-    out.assign(float_buffer, float_buffer + float_count);
+  template <typename ToType>
+  void Base64::decodeIntoVector_(const String & in, std::vector<ToType> & out)
+  {
+    // last one or two '=' are skipped if contained
+    const Size src_size = stripPadding_(in.c_str(), in.size());
+
+    // decode straight into the output memory (rounded up to whole elements,
+    // incomplete trailing elements are dropped afterwards)
+    const Size element_size = sizeof(ToType);
+    const Size max_bytes = (src_size * 3) / 4;
+    out.resize((max_bytes + element_size - 1) / element_size);
+    if (out.empty()) return;
+
+    const Size written = decodeRaw_(in.c_str(), src_size, reinterpret_cast<Byte *>(out.data()));
+    out.resize(written / element_size);
   }
 
   template <typename ToType>
@@ -421,102 +439,20 @@ private:
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, length is not a multiple of 4.");
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
-
-    const Size element_size = sizeof(ToType);
-
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
+    decodeIntoVector_(in, out);
 
     // Parse little endian data in big endian OpenMS (or other way round)
-    if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || 
-       (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
+    if (needsSwap_(from_byte_order))
     {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
-    }
-    else
-    {
-      offset = 0;
-      inc = 1;
-    }
-
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
-
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
-    {
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
-      {
-        b = 0;
-      }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
-      {
-        a = 0;
-      }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
-
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
+      if (sizeof(ToType) == 4) // 32 bit
       {
-        b = 0;
+        UInt32 * p = reinterpret_cast<UInt32 *>(out.data());
+        std::transform(p, p + out.size(), p, endianize32);
       }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
+      else // 64 bit
       {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
+        UInt64 * p = reinterpret_cast<UInt64 *>(out.data());
+        std::transform(p, p + out.size(), p, endianize64);
       }
     }
   }
@@ -575,57 +511,14 @@ private:
       String(compressed).swap(compressed);
       it = reinterpret_cast<Byte *>(&compressed[0]);
       end = it + compressed_length;
-      out.resize((Size)ceil(compressed_length / 3.) * 4);     //resize output array in order to have enough space for all characters
     }
     //encode without compression
     else
     {
-      out.resize((Size)ceil(input_bytes / 3.) * 4);     //resize output array in order to have enough space for all characters
       it = reinterpret_cast<Byte *>(&in[0]);
       end = it + input_bytes;
     }
-
-    Byte * to = reinterpret_cast<Byte *>(&out[0]);
-
-
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-        to[3] = '=';
-      if (padding_count > 1)
-        to[2] = '=';
-
-      to += 4;
-      written += 4;
-    }
-
-    out.resize(written);         //no more space is needed
+    encodeRaw_(it, end - it, out);
   }
 
   template <typename ToType>
@@ -648,109 +541,15 @@ private:
     if (in.empty())
       return;
 
-    void * byte_buffer;
-    Size buffer_size;
-    const Size element_size = sizeof(ToType);
-
-    String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
-
-    byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
-    buffer_size = decompressed.size();
-
-    //change endianness if necessary
-    if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
+    const std::vector<Byte>& decompressed = decompressToThreadBuffer_(in);
+    if (decompressed.size() % sizeof(ToType) != 0)
     {
-      if (element_size == 4)
-      {
-        const Int32 * float_buffer = reinterpret_cast<const Int32 *>(byte_buffer);
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-        Size float_count = buffer_size / element_size;
-        UInt32 * p = reinterpret_cast<UInt32 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize32);
-
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-      else
-      {
-        const Int64 * float_buffer = reinterpret_cast<const Int64 *>(byte_buffer);
-
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-
-        Size float_count = buffer_size / element_size;
-
-        UInt64 * p = reinterpret_cast<UInt64 *>(byte_buffer);
-        std::transform(p, p + float_count, p, endianize64);
-
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-    }
-    else
-    {
-      if (element_size == 4)
-      {
-        const Int * float_buffer = reinterpret_cast<const Int *>(byte_buffer);
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount while decoding?");
-
-        Size float_count = buffer_size / element_size;
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
-      else
-      {
-        const Int64 * float_buffer = reinterpret_cast<const Int64 *>(byte_buffer);
-
-        if (buffer_size % element_size != 0)
-          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount while decoding?");
-
-        Size float_count = buffer_size / element_size;
-        out.resize(float_count);
-        // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
-        for (Size i = 0; i < float_count; ++i)
-        {
-          out[i] = (ToType) * float_buffer;
-          ++float_buffer;
-        }
-      }
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
     }
 
+    out.resize(decompressed.size() / sizeof(ToType));
+    std::memcpy(out.data(), decompressed.data(), decompressed.size());
+    convertIntegersInPlace_(out, needsSwap_(from_byte_order));
   }
 
   template <typename ToType>
@@ -765,131 +564,31 @@ private:
       return;
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
-
-    const Size element_size = sizeof(ToType);
-
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
-
-    if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
-    {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
-    }
-    else
-    {
-      offset = 0;
-      inc = 1;
-    }
+    decodeIntoVector_(in, out);
 
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
+    convertIntegersInPlace_(out, needsSwap_(from_byte_order));
+  }
 
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
+  template <typename ToType>
+  void Base64::convertIntegersInPlace_(std::vector<ToType> & out, bool swap)
+  {
+    // ToType has the same size as the encoded integers
+    Byte * bytes = reinterpret_cast<Byte *>(out.data());
+    for (Size i = 0; i < out.size(); ++i, bytes += sizeof(ToType))
     {
-
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
-      {
-        b = 0;
-      }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
-      {
-        a = 0;
-      }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
+      if (sizeof(ToType) == 4)
       {
-        b = 0;
+        UInt32 tmp;
+        std::memcpy(&tmp, bytes, sizeof(tmp));
+        if (swap) tmp = endianize32(tmp);
+        out[i] = (ToType) static_cast<Int32>(tmp);
       }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
+      else
       {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
+        UInt64 tmp;
+        std::memcpy(&tmp, bytes, sizeof(tmp));
+        if (swap) tmp = endianize64(tmp);
+        out[i] = (ToType) static_cast<Int64>(tmp);
       }
     }
   }
@@ -39,12 +39,17 @@
 #include <OpenMS/FORMAT/Bzip2Ifstream.h>
 
 
+#include <memory>
+
 namespace OpenMS
 {
   class String;
+  class ReadAheadBuffer;
   /**
     * @brief Implements the BinInputStream class of the xerces-c library in order to read bzip2 compressed XML files.
     *
+    * Decompression runs ahead of the parser in a background thread (see ReadAheadBuffer).
+    *
   */
   class OPENMS_DLLAPI Bzip2InputStream :
     public xercesc::BinInputStream
@@ -97,6 +102,11 @@ public:
 private:
     ///pointer to an compression stream
     Bzip2Ifstream* bzip2_;
+    ///starts decompressing in the background
+    void startReadAhead_();
+
+    ///decompresses ahead of the parser in a background thread
+    std::unique_ptr<ReadAheadBuffer> read_ahead_;
     ///current index of the actual file
     XMLSize_t       file_current_index_;
 
@@ -111,10 +121,6 @@ private:
     return file_current_index_;
   }
 
-  inline bool Bzip2InputStream::getIsOpen() const
-  {
-    return bzip2_->isOpen();
-  }
-
+  
 } // namespace OpenMS
 
@@ -37,6 +37,15 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <fstream>
+#include <memory>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
 
 namespace OpenMS
 {
@@ -49,6 +58,12 @@ namespace OpenMS
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    The cached file is accessed through a read-only memory mapping. The
+    mapping, the index and the meta data are shared (not copied) between
+    copies of an object and reading does not modify any state, thus
+    getSpectrum() and getChromatogram() may be called concurrently from
+    multiple threads.
+
   */
   class OPENMS_DLLAPI CachedmzML
   {
@@ -80,7 +95,7 @@ public:
 
     const MSExperiment& getMetaData() const
     {
-      return meta_ms_experiment_;
+      return *meta_ms_experiment_;
     }
 
     /**
@@ -88,10 +103,11 @@ public:
 
       @p filename The data location (ends in .mzML)
       @p map has to be an MSExperiment or have the same interface.
+      @p format_version The version of the cached file format (1 or 2, version 2 is compressed)
 
       @exception Exception::UnableToCreateFile is thrown if the file could not be created
     */
-    static void store(const String& filename, const PeakMap& map);
+    static void store(const String& filename, const PeakMap& map, int format_version = 1);
 
     /**
       @brief Loads a map from a cached MzML file
@@ -108,11 +124,18 @@ protected:
 
     void load_(const String& filename);
 
-    /// Meta data
-    MSExperiment meta_ms_experiment_;
+    /**
+      @brief Returns the data at @p offset of the mapped cached file and the number of bytes until the end of the file
+
+      @throw Exception::ParseError if @p offset is outside the file
+    */
+    std::pair<const char*, Size> mappedData_(std::streampos offset) const;
 
-    /// Internal filestream 
-    std::ifstream ifs_;
+    /// Meta data (shared between copies)
+    std::shared_ptr<const MSExperiment> meta_ms_experiment_;
+
+    /// Read-only mapping of the cached file (shared between copies)
+    std::shared_ptr<const boost::interprocess::mapped_region> mapping_;
 
     /// Name of the mzML file
     String filename_;
@@ -120,9 +143,12 @@ protected:
     /// Name of the cached mzML file
     String filename_cached_;
 
-    /// Indices
-    std::vector<std::streampos> spectra_index_;
-    std::vector<std::streampos> chrom_index_;
+    /// Indices (shared between copies)
+    std::shared_ptr<const std::vector<std::streampos> > spectra_index_;
+    std::shared_ptr<const std::vector<std::streampos> > chrom_index_;
+
+    /// Version of the cached file format (see Internal::CachedMzMLHandler::FormatVersion)
+    int format_version_;
 
   };
 }
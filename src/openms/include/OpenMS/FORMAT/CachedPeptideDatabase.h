@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <memory>
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+  /**
+    @brief A digested peptide database stored on disk for reuse by subsequent searches
+
+    Contains the unique peptides of an in-silico digest of a protein
+    database, each with the masses of its modified variants (in the order in
+    which ModifiedPeptideGenerator enumerates them) and the indices of the
+    proteins it occurs in. Peptides containing X, B or Z and peptides not
+    matching the motif (if given) are excluded.
+
+    The file stores a key describing the proteins and digestion/modification
+    settings it was created from. load() only accepts files with a matching
+    key, so a cache file can be passed to every run and is regenerated
+    whenever the database or settings change.
+
+    All arrays are stored contiguously and accessed through a read-only
+    memory mapping, so loading is instantaneous and the accessors are
+    thread-safe.
+  */
+  class OPENMS_DLLAPI CachedPeptideDatabase
+  {
+public:
+    /// Digestion and modification settings
+    struct Settings
+    {
+      String enzyme = "Trypsin";
+      Size missed_cleavages = 1;
+      Size min_length = 7;
+      Size max_length = 40; ///< 0 = disabled
+      String motif; ///< regular expression peptides need to match (empty = all)
+      StringList fixed_modifications;
+      StringList variable_modifications;
+      Size max_variable_mods_per_peptide = 2;
+    };
+
+    /// Default constructor
+    CachedPeptideDatabase();
+
+    /// Destructor
+    ~CachedPeptideDatabase();
+
+    /**
+      @brief Digests @p proteins and stores the result in @p filename
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    static void store(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings);
+
+    /**
+      @brief Opens @p filename if it was created from @p proteins with @p settings
+
+      @return false if the file does not exist, is invalid or was created from different proteins or settings
+    */
+    bool load(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings);
+
+    /**
+      @brief Opens @p filename, (re-)creating it first if it cannot be loaded
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void loadOrStore(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings);
+
+    /// Number of (unique) peptides
+    Size size() const;
+
+    /// Unmodified sequence of a peptide
+    StringView getSequence(Size peptide_index) const;
+
+    /// Number of modified variants of a peptide
+    Size getNumberOfVariants(Size peptide_index) const;
+
+    /// Monoisotopic mass of a modified variant of a peptide
+    double getVariantMass(Size peptide_index, Size variant_index) const;
+
+    /// Indices of the proteins (in the database passed to store()) containing a peptide
+    std::vector<Size> getProteinReferences(Size peptide_index) const;
+
+protected:
+    /// Key identifying the proteins and settings a database was created from
+    static String getKey_(const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings);
+
+    std::shared_ptr<boost::interprocess::mapped_region> region_;
+
+    Size nr_peptides_ = 0;
+    const UInt64* peptide_offsets_ = nullptr; ///< positions in sequences_, size nr_peptides_ + 1
+    const UInt64* variant_offsets_ = nullptr; ///< positions in variant_masses_, size nr_peptides_ + 1
+    const UInt64* protein_offsets_ = nullptr; ///< positions in protein_references_, size nr_peptides_ + 1
+    const double* variant_masses_ = nullptr;
+    const UInt64* protein_references_ = nullptr;
+    const char* sequences_ = nullptr;
+  };
+} // namespace OpenMS
@@ -40,6 +40,8 @@
 
 #include <set>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -216,6 +218,17 @@ public:
     */
     static const ControlledVocabulary& getPSIMSCV();
 
+    /**
+      @brief Returns a shared CV built from the given (name, OBO file) pairs, loaded in order
+
+      OBO files are looked up via File::find(). The CV is parsed on the first request for this exact
+      list and cached for the lifetime of the process, so handlers and validators that need the same
+      vocabulary repeatedly do not re-parse it. Thread-safe.
+
+      @exception Exception::FileNotFound is thrown if one of the files cannot be found (nothing is cached in that case)
+    */
+    static const ControlledVocabulary& getCachedCV(const std::vector<std::pair<String, String>>& obo_files);
+
 protected:
     /**
         @brief checks if a name corresponds to an id
@@ -39,7 +39,9 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
 
+#include <memory>
 
 namespace OpenMS
 {
@@ -68,13 +70,15 @@ namespace OpenMS
         @param filename The output file name to which data is written
         @param clearData Whether to clear the spectral and chromatogram data
         after writing (only keep meta-data)
+        @param version The cache format version to write (version 2 is
+        compressed and carries an index in its footer)
 
         @note Clearing data from spectra and chromatograms also clears float
         and integer data arrays associated with the structure as these are
         written to disk as well.
 
       */
-      MSDataCachedConsumer(const String& filename, bool clearData=true);
+      MSDataCachedConsumer(const String& filename, bool clearData=true, FormatVersion version=FORMAT_V1);
 
       /**
         @brief Destructor
@@ -97,6 +101,17 @@ namespace OpenMS
       */
       void consumeChromatogram(ChromatogramType & c) override;
 
+      /**
+        @brief Enable asynchronous write-behind
+
+        Consumed spectra and chromatograms are copied and written by a dedicated writer thread while the
+        caller continues. At most @p max_pending items are kept in memory; consumeSpectrum() blocks when the
+        writer falls behind. Pass zero to write synchronously (default).
+
+        Errors during writing are reported by the next call to consumeSpectrum() or consumeChromatogram().
+      */
+      void setWriteBehind(Size max_pending);
+
       void setExpectedSize(Size /* expectedSpectra */, Size /* expectedChromatograms */) override {;}
 
       void setExperimentalSettings(const ExperimentalSettings& /* exp */) override {;}
@@ -106,6 +121,9 @@ namespace OpenMS
       bool clearData_;
       Size spectra_written_;
       Size chromatograms_written_;
+      FooterIndex_ footer_index_;
+      /// Writer thread for write-behind (null if writing synchronously)
+      std::unique_ptr<WriteBehindQueue> write_behind_;
 
     };
 
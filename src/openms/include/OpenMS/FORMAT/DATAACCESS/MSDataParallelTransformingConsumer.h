@@ -0,0 +1,145 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest, Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+
+#include <functional>
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Multi-threaded transforming consumer of MS data
+
+      Like MSDataTransformingConsumer, this consumer applies a user-provided
+      function to every spectrum/chromatogram, but it collects the incoming
+      data in a bounded buffer of @p batch_size items, transforms the whole
+      batch in parallel (OpenMP) and then passes the results in their original
+      order to the next consumer (e.g. an MSDataWritingConsumer). At most one
+      batch is kept in memory, so streaming (low memory) processing benefits
+      from multiple cores just like in-memory processing.
+
+      The processing functions are called concurrently from several threads
+      and must therefore be thread-safe. This holds for const algorithms such
+      as PeakPickerHiRes::pick(); stateful filters (e.g. GaussFilter,
+      SavitzkyGolayFilter, ThresholdMower) should be copied inside the lambda:
+
+      @code
+      PlainMSDataWritingConsumer writer(outfile);
+      MSDataParallelTransformingConsumer consumer(&writer);
+      consumer.setSpectraProcessingFunc([&gauss](MSSpectrum& s) { GaussFilter g(gauss); g.filter(s); });
+      MzMLFile().transform(infile, &consumer);
+      consumer.flush(); // optional, the destructor flushes as well
+      @endcode
+
+      Spectra and chromatograms are forwarded in the order they were consumed:
+      pending spectra are flushed when a chromatogram arrives, and vice versa.
+      If a processing function throws, the exception of the first failing item
+      (in consumption order) is rethrown by the call which triggered the batch.
+
+      @note The next consumer is not owned by this class and must outlive it.
+    */
+    class OPENMS_DLLAPI MSDataParallelTransformingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next Consumer which receives the transformed data (not owned, may not be null)
+        @param batch_size Number of spectra (or chromatograms) transformed together (at least 1)
+      */
+      explicit MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next, Size batch_size = 64);
+
+      /// Destructor, flushes all pending data (errors are logged)
+      ~MSDataParallelTransformingConsumer() override;
+
+      /// Forwards to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Flushes pending data and forwards the settings to the next consumer
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+      /// Queues a copy of @p s; a full batch is transformed and forwarded
+      void consumeSpectrum(SpectrumType& s) override;
+
+      /// Queues a copy of @p c; a full batch is transformed and forwarded
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Sets the (thread-safe) function to be called for every spectrum
+
+        Pass a nullptr if the spectra should be left unchanged.
+      */
+      void setSpectraProcessingFunc(std::function<void (SpectrumType&)> f_spec);
+
+      /**
+        @brief Sets the (thread-safe) function to be called for every chromatogram
+
+        Pass a nullptr if the chromatograms should be left unchanged.
+      */
+      void setChromatogramProcessingFunc(std::function<void (ChromatogramType&)> f_chrom);
+
+      /// Transforms and forwards all pending spectra and chromatograms
+      void flush();
+
+      /// Returns the batch size
+      Size getBatchSize() const;
+
+    protected:
+
+      /// Transforms the pending spectra in parallel and forwards them in order
+      void flushSpectra_();
+
+      /// Transforms the pending chromatograms in parallel and forwards them in order
+      void flushChromatograms_();
+
+      Interfaces::IMSDataConsumer* next_;
+      Size batch_size_;
+      std::function<void (SpectrumType&)> lambda_spec_;
+      std::function<void (ChromatogramType&)> lambda_chrom_;
+      std::vector<SpectrumType> pending_spectra_;
+      std::vector<ChromatogramType> pending_chromatograms_;
+    };
+
+} //end namespace OpenMS
+
@@ -38,11 +38,13 @@
 
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/HANDLERS/MzMLHandler.h>
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 
 #include <vector>
 #include <string>
 #include <fstream>
+#include <memory>
 #include <boost/shared_ptr.hpp>
 
 namespace OpenMS
@@ -159,6 +161,19 @@ namespace OpenMS
       */
       virtual void addDataProcessing(DataProcessing d);
 
+      /**
+        @brief Enable asynchronous write-behind
+
+        Consumed spectra and chromatograms are handed to a dedicated writer thread, which formats and writes them
+        while the caller continues. At most @p max_pending batches of spectra (or single chromatograms) are kept in
+        memory; consumeSpectrum() blocks when the writer falls behind. Pass zero to write synchronously (default).
+
+        Errors during writing are reported by the next call to consumeSpectrum() or consumeChromatogram().
+
+        @note Must be called before the first spectrum or chromatogram is consumed.
+      */
+      void setWriteBehind(Size max_pending);
+
       /**
         @brief Return the number of spectra written.
       */
@@ -195,6 +210,15 @@ namespace OpenMS
       */
       virtual void doCleanup_();
 
+      /// Writes all consumed spectra which have not been written yet (encoding them in parallel)
+      void writePendingSpectra_();
+
+      /// Writes all consumed chromatograms which have not been written yet (encoding them in parallel)
+      void writePendingChromatograms_();
+
+      /// Runs @p task, which writes to ofs_, directly or (with write-behind) in the writer thread
+      void write_(WriteBehindQueue::Task task);
+
     protected:
 
       /// File stream (to write mzML)
@@ -226,6 +250,14 @@ namespace OpenMS
       std::vector<std::vector< ConstDataProcessingPtr > > dps_;
       /// The dataprocessing to be added to each spectrum/chromatogram
       DataProcessingPtr additional_dataprocessing_;
+      /// Processed spectra waiting to be written (they are formatted and encoded in parallel batches)
+      std::vector<SpectrumType> pending_spectra_;
+      /// Processed chromatograms waiting to be written (same as pending_spectra_)
+      std::vector<ChromatogramType> pending_chromatograms_;
+      /// Number of spectra/chromatograms collected before a batch is written
+      Size pending_limit_;
+      /// Writer thread for write-behind (null if writing synchronously)
+      std::unique_ptr<WriteBehindQueue> write_behind_;
     };
 
     /**
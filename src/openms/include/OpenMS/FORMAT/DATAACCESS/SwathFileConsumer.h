@@ -42,6 +42,7 @@
 #include <OpenMS/FORMAT/DATAACCESS/MSDataCachedConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
 
 // Helpers
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
@@ -406,6 +407,12 @@ protected:
    * n+1 (n SWATH + 1 MS1 map) objects of MSDataCachedConsumer which can consume the
    * spectra and write them to disk immediately.
    *
+   * As soon as a map has received its expected number of spectra, its cache
+   * file is closed and its metadata is written and loaded again by a
+   * background thread while the remaining spectra are still being read.
+   * Maps that are complete early (e.g. files sorted by SWATH window) are
+   * therefore ready when reading finishes.
+   *
    */
   class OPENMS_DLLAPI CachedSwathFileConsumer :
     public FullSwathFileConsumer
@@ -471,8 +478,21 @@ protected:
       {
         addNewSwathMap_();
       }
+      if (swath_consumers_[swath_nr] == nullptr)
+      {
+        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Encountered more spectra for SWATH " + String(swath_nr) + " than the expected " + String(nr_ms2_spectra_[swath_nr]) + ".");
+      }
       swath_consumers_[swath_nr]->consumeSpectrum(s); // write data to cached file; clear data from spectrum s
       swath_maps_[swath_nr]->addSpectrum(s); // append for the metadata (actual data was deleted)
+
+      // all spectra of this window have been read
+      if (swath_nr < nr_ms2_spectra_.size() && (int)swath_maps_[swath_nr]->size() == nr_ms2_spectra_[swath_nr])
+      {
+        delete swath_consumers_[swath_nr];
+        swath_consumers_[swath_nr] = nullptr;
+        swath_maps_[swath_nr] = loadMetadataInBackground_(swath_maps_[swath_nr], cachedir_ + basename_ + "_" + String(swath_nr) +  ".mzML");
+      }
     }
 
     void addMS1Map_()
@@ -487,32 +507,69 @@ protected:
 
     void consumeMS1Spectrum_(MapType::SpectrumType& s) override
     {
+      if (ms1_complete_)
+      {
+        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Encountered more MS1 spectra than the expected " + String(nr_ms1_spectra_) + ".");
+      }
       if (ms1_consumer_ == nullptr)
       {
         addMS1Map_();
       }
       ms1_consumer_->consumeSpectrum(s);
       ms1_map_->addSpectrum(s); // append for the metadata (actual data is deleted)
+
+      // all MS1 spectra have been read
+      if ((int)ms1_map_->size() == nr_ms1_spectra_)
+      {
+        delete ms1_consumer_;
+        ms1_consumer_ = nullptr;
+        ms1_complete_ = true;
+        ms1_map_ = loadMetadataInBackground_(ms1_map_, cachedir_ + basename_ + "_ms1.mzML");
+      }
     }
 
-    void ensureMapsAreFilled_() override
+    /**
+     * @brief Writes the metadata of a map whose cache file is complete and loads it again in a background thread
+     *
+     * @param meta The metadata of the consumed spectra
+     * @param meta_file The mzML file to write the metadata to
+     *
+     * @return The map that will contain the loaded metadata (only to be accessed after metadata_loader_ is flushed)
+     */
+    boost::shared_ptr<PeakMap > loadMetadataInBackground_(boost::shared_ptr<PeakMap > meta, const String& meta_file)
     {
-      size_t swath_consumers_size = swath_consumers_.size();
-      bool have_ms1 = (ms1_consumer_ != nullptr);
+      boost::shared_ptr<PeakMap > exp(new PeakMap);
+      metadata_loader_.push([meta, meta_file, exp]()
+      {
+        // write metadata to disk and store the correct data processing tag
+        Internal::CachedMzMLHandler().writeMetadata(*meta, meta_file, true);
+        MzMLFile().load(meta_file, *exp.get());
+      });
+      return exp;
+    }
 
+    void ensureMapsAreFilled_() override
+    {
       // Properly delete the MSDataCachedConsumer -> free memory and _close_ file stream
       // The file streams to the cached data on disc can and should be closed
       // here safely. Since ensureMapsAreFilled_ is called after consuming all
       // the spectra, there will be no more spectra to append but the client
       // might already want to read after this call, so all data needs to be
       // present on disc and the file streams closed.
-      //
-      // TODO merge with destructor code into own function!
-      while (!swath_consumers_.empty())
+      // Maps that received their expected number of spectra were already
+      // closed while reading, only the remaining ones are finalized here.
+      std::vector<SignedSize> open_maps;
+      for (Size i = 0; i < swath_consumers_.size(); ++i)
       {
-        delete swath_consumers_.back();
-        swath_consumers_.pop_back();
+        if (swath_consumers_[i] != nullptr)
+        {
+          delete swath_consumers_[i];
+          swath_consumers_[i] = nullptr;
+          open_maps.push_back(i);
+        }
       }
+      bool have_ms1 = (ms1_consumer_ != nullptr);
       if (ms1_consumer_ != nullptr)
       {
         delete ms1_consumer_;
@@ -532,8 +589,9 @@ protected:
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-      for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_consumers_size); i++)
+      for (SignedSize k = 0; k < boost::numeric_cast<SignedSize>(open_maps.size()); k++)
       {
+        SignedSize i = open_maps[k];
         boost::shared_ptr<PeakMap > exp(new PeakMap);
         String meta_file = cachedir_ + basename_ + "_" + String(i) +  ".mzML";
         // write metadata to disk and store the correct data processing tag
@@ -541,6 +599,9 @@ protected:
         MzMLFile().load(meta_file, *exp.get());
         swath_maps_[i] = exp;
       }
+
+      // wait for the maps that were completed while reading
+      metadata_loader_.flush();
     }
 
     MSDataCachedConsumer* ms1_consumer_;
@@ -550,6 +611,12 @@ protected:
     String basename_;
     int nr_ms1_spectra_;
     std::vector<int> nr_ms2_spectra_;
+
+    /// Whether the MS1 map has received all expected spectra
+    bool ms1_complete_ = false;
+
+    /// Background thread writing and loading the metadata of completed maps (destroyed first)
+    WriteBehindQueue metadata_loader_;
   };
 
   /**
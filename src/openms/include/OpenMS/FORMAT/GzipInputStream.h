@@ -40,12 +40,17 @@
 #include <xercesc/util/BinInputStream.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 
+#include <memory>
+
 namespace OpenMS
 {
   class String;
+  class ReadAheadBuffer;
 
   /**
     * @brief Implements the BinInputStream class of the xerces-c library in order to read gzip compressed XML files.
+    *
+    * Decompression runs ahead of the parser in a background thread (see ReadAheadBuffer).
     * 
   */
   class OPENMS_DLLAPI GzipInputStream :
@@ -102,6 +107,11 @@ public:
 private:
     ///pointer to an compression stream
     GzipIfstream* gzip_ = nullptr;
+    ///starts decompressing in the background
+    void startReadAhead_();
+
+    ///decompresses ahead of the parser in a background thread
+    std::unique_ptr<ReadAheadBuffer> read_ahead_;
     ///current index of the actual file
     XMLSize_t file_current_index_;
   };
@@ -111,10 +121,6 @@ private:
     return file_current_index_;
   }
 
-  inline bool GzipInputStream::getIsOpen() const
-  {
-    return gzip_->isOpen();
-  }
-
+  
 } // namespace OpenMS
 
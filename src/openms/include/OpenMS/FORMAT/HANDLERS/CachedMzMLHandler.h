@@ -47,6 +47,7 @@
 #include <fstream>
 
 #define CACHED_MZML_FILE_IDENTIFIER 8094
+#define CACHED_MZML_FILE_IDENTIFIER_V2 8095
 
 namespace OpenMS
 {
@@ -62,6 +63,15 @@ namespace Internal
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    Two layouts of the binary file exist (see FormatVersion) and are
+    detected automatically on reading. Version 1 stores all data arrays as
+    uncompressed doubles and the index has to be built by scanning the whole
+    file. Version 2 stores every data array as a separately compressed chunk
+    (zlib, optionally after lossy numpress linear encoding of m/z and RT
+    arrays) and writes a footer with the offsets as well as RT, MS level and
+    precursor m/z columns of all spectra, which are read by
+    createMemdumpIndex() without touching the data.
+
   */
   class OPENMS_DLLAPI CachedMzMLHandler :
     public ProgressLogger
@@ -80,6 +90,13 @@ public:
 
     typedef std::vector<DatumSingleton> Datavector;
 
+    /// Layout versions of the binary cache file
+    enum FormatVersion
+    {
+      FORMAT_V1 = 1, ///< uncompressed doubles (readable by all versions of OpenMS)
+      FORMAT_V2 = 2  ///< compressed data arrays and a footer index with meta data columns
+    };
+
     /** @name Constructors and Destructor
     */
     //@{
@@ -121,6 +138,38 @@ public:
 
     /// Access to a constant copy of the binary chromatogram index
     const std::vector<std::streampos>& getChromatogramIndex() const;
+
+    /// Retention time of all spectra (read from the footer of format version 2 files, empty otherwise)
+    const std::vector<double>& getSpectraRTIndex() const;
+
+    /// MS level of all spectra (read from the footer of format version 2 files, empty otherwise)
+    const std::vector<int>& getSpectraMSLevelIndex() const;
+
+    /// m/z of the first precursor of all spectra, -1 if there is none (read from the footer of format version 2 files, empty otherwise)
+    const std::vector<double>& getSpectraPrecursorMZIndex() const;
+    //@}
+
+    /** @name Format of written files
+    */
+    //@{
+    /// Sets the layout used by writeMemdump (default: FORMAT_V1). When reading, the layout is taken from the file.
+    void setFormatVersion(FormatVersion version);
+
+    /// Layout used for writing, or of the file last indexed by createMemdumpIndex()
+    FormatVersion getFormatVersion() const;
+
+    /**
+      @brief Whether format version 2 may lose precision to achieve smaller files
+
+      If set, m/z and RT arrays are stored using numpress linear encoding
+      (relative error below 1e-9) and chromatogram intensities as 32 bit
+      floats. Otherwise all data is stored lossless (spectrum intensities and
+      float data arrays are 32 bit in memory already). Default: false.
+    */
+    void setLossyCompression(bool lossy);
+
+    /// Whether format version 2 may lose precision to achieve smaller files
+    bool getLossyCompression() const;
     //@}
 
     /** @name Direct access to a single Spectrum or Chromatogram
@@ -157,7 +206,8 @@ public:
 
       @throws Exception::ParseError is thrown if the spectrum cannot be read
     */
-    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(std::ifstream& ifs, int& ms_level, double& rt);
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(std::ifstream& ifs, int& ms_level, double& rt,
+                                                                       FormatVersion version = FORMAT_V1);
 
     /**
       @brief Fast access to a chromatogram
@@ -182,7 +232,37 @@ public:
 
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
-    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(std::ifstream& ifs);
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(std::ifstream& ifs, FormatVersion version = FORMAT_V1);
+
+    /**
+      @brief Fast access to a spectrum in memory (e.g. a memory-mapped cached file)
+
+      Reads the same layout as readSpectrumFast(std::ifstream&, int&, double&)
+      but does not require a file stream, thus multiple threads can read
+      concurrently from the same memory.
+
+      @param data Start of the spectrum
+      @param size Number of bytes available at @p data
+      @param ms_level Output parameter to store the MS level of the spectrum (1, 2, 3 ...)
+      @param rt Output parameter to store the retention time of the spectrum
+      @param version Layout of the file (see getFormatVersion())
+
+      @throws Exception::ParseError is thrown if the spectrum cannot be read or extends beyond @p size
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(const char* data, Size size, int& ms_level, double& rt,
+                                                                       FormatVersion version = FORMAT_V1);
+
+    /**
+      @brief Fast access to a chromatogram in memory (e.g. a memory-mapped cached file)
+
+      @param data Start of the chromatogram
+      @param size Number of bytes available at @p data
+      @param version Layout of the file (see getFormatVersion())
+
+      @throws Exception::ParseError is thrown if the chromatogram cannot be read or extends beyond @p size
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(const char* data, Size size,
+                                                                           FormatVersion version = FORMAT_V1);
     //@}
 
     /**
@@ -193,7 +273,7 @@ public:
 
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
-    static void readSpectrum(SpectrumType& spectrum, std::ifstream& ifs);
+    static void readSpectrum(SpectrumType& spectrum, std::ifstream& ifs, FormatVersion version = FORMAT_V1);
 
     /**
       @brief Read a single chromatogram directly into an OpenMS MSChromatogram (assuming file is already at the correct position)
@@ -203,7 +283,29 @@ public:
 
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
-    static void readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs);
+    static void readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs, FormatVersion version = FORMAT_V1);
+
+    /**
+      @brief Read a single spectrum from memory directly into an OpenMS MSSpectrum
+
+      @param spectrum Output spectrum
+      @param data Start of the spectrum
+      @param size Number of bytes available at @p data
+      @param version Layout of the file (see getFormatVersion())
+      @throws Exception::ParseError is thrown if the spectrum cannot be read
+    */
+    static void readSpectrum(SpectrumType& spectrum, const char* data, Size size, FormatVersion version = FORMAT_V1);
+
+    /**
+      @brief Read a single chromatogram from memory directly into an OpenMS MSChromatogram
+
+      @param chromatogram Output chromatogram
+      @param data Start of the chromatogram
+      @param size Number of bytes available at @p data
+      @param version Layout of the file (see getFormatVersion())
+      @throws Exception::ParseError is thrown if the chromatogram cannot be read
+    */
+    static void readChromatogram(ChromatogramType& chromatogram, const char* data, Size size, FormatVersion version = FORMAT_V1);
 
 protected:
 
@@ -213,13 +315,62 @@ protected:
     /// write a single chromatogram to filestream
     void writeChromatogram_(const ChromatogramType& chromatogram, std::ofstream& ofs) const;
 
-    /// helper method for fast reading of spectra and chromatograms
-    static inline void readDataFast_(std::ifstream& ifs, std::vector<OpenSwath::BinaryDataArrayPtr>& data, const Size& data_size, 
+    /// Offsets and meta data columns collected while writing format version 2
+    struct FooterIndex_
+    {
+      std::vector<UInt64> spectra_offsets;
+      std::vector<double> spectra_rt;
+      std::vector<Int32> spectra_ms_level;
+      std::vector<double> spectra_precursor_mz;
+      std::vector<UInt64> chromatogram_offsets;
+    };
+
+    /// write the file header (identifier of the current format version)
+    void writeHeader_(std::ofstream& ofs) const;
+
+    /// write a single spectrum to filestream in format version 2 and record it in @p index
+    void writeSpectrumV2_(const SpectrumType& spectrum, std::ofstream& ofs, FooterIndex_& index) const;
+
+    /// write a single chromatogram to filestream in format version 2 and record it in @p index
+    void writeChromatogramV2_(const ChromatogramType& chromatogram, std::ofstream& ofs, FooterIndex_& index) const;
+
+    /// write the footer (index for version 2, number of spectra and chromatograms for version 1)
+    void writeFooter_(std::ofstream& ofs, const FooterIndex_& index, Size nr_spectra, Size nr_chromatograms) const;
+
+    /// try to read the footer index of a format version 2 file
+    void readFooterV2_(std::ifstream& ifs, const String& filename);
+
+    /// helper method for reading one compressed data array of format version 2
+    template <typename StreamT>
+    static void readArrayV2_(StreamT& ifs, OpenSwath::BinaryDataArray& array);
+
+    /// helper method for fast reading of spectra and chromatograms (from a file stream or from memory)
+    template <typename StreamT>
+    static void readDataFast_(StreamT& ifs, std::vector<OpenSwath::BinaryDataArrayPtr>& data, const Size& data_size, 
       const Size& nr_float_arrays);
 
+    /// helper method for fast reading of spectra (from a file stream or from memory)
+    template <typename StreamT>
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast_(StreamT& ifs, int& ms_level, double& rt, FormatVersion version);
+
+    /// helper method for fast reading of chromatograms (from a file stream or from memory)
+    template <typename StreamT>
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast_(StreamT& ifs, FormatVersion version);
+
+    /// convert the data arrays read by readSpectrumFast() into @p spectrum
+    static void fillSpectrum_(const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt, SpectrumType& spectrum);
+
+    /// convert the data arrays read by readChromatogramFast() into @p chromatogram
+    static void fillChromatogram_(const std::vector<OpenSwath::BinaryDataArrayPtr>& data, ChromatogramType& chromatogram);
+
     /// Members
     std::vector<std::streampos> spectra_index_;
     std::vector<std::streampos> chrom_index_;
+    std::vector<double> spectra_rt_index_;
+    std::vector<int> spectra_ms_level_index_;
+    std::vector<double> spectra_precursor_mz_index_;
+    FormatVersion format_version_;
+    bool lossy_compression_;
 
   };
 }
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceParseCache.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>
@@ -129,6 +130,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parse results of recently seen peptide sequences (the same peptide is usually identified many times)
+    AASequenceParseCache sequence_cache_;
     /// Temporary peptide evidences
     std::vector<PeptideEvidence> peptide_evidences_;
     /// Map from protein id to accession
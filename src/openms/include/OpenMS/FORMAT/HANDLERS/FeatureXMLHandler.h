@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceParseCache.h>
 #include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
 #include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
@@ -179,6 +180,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parse results of recently seen peptide sequences (the same peptide is usually identified many times)
+    AASequenceParseCache sequence_cache_;
     /// Map from protein id to accession
     std::map<String, String> proteinid_to_accession_;
     /// Map from search identifier concatenated with protein accession to id
@@ -43,9 +43,19 @@
 #include <OpenMS/KERNEL/MSChromatogram.h>
 
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <memory>
 #include <unordered_map>
 
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
 namespace OpenMS
 {
 
@@ -70,10 +80,17 @@ namespace Internal
     extracting all the offsets of the <chromatogram> and <spectrum> tags. These
     offsets are stored as members of this class as well as the offset to the <indexList> element
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    Optionally, the file can be accessed through a read-only memory mapping
+    instead of a file stream (see setMemoryMapped()). In that case, spectra
+    and chromatograms are decoded directly from the mapped memory without
+    copying the XML and the mapping is shared between all copies of the
+    object.
+
+    @note When using a file stream (the default), this implementation is @a
+    not thread-safe since it keeps internally a single file access pointer
+    which it moves when accessing a specific data item. The caller is
+    responsible to ensure that access is performed atomically. When using a
+    memory mapping, data can be retrieved concurrently from multiple threads.
 
   */
   class OPENMS_DLLAPI IndexedMzMLHandler
@@ -94,6 +111,12 @@ namespace Internal
     bool spectra_before_chroms_;
     /// The current filestream (opened by openFile)
     std::ifstream filestream_;
+
+    /// Read-only mapping of the whole file (if memory mapped access is enabled), shared between copies
+    std::shared_ptr<const boost::interprocess::mapped_region> mapping_;
+
+    /// Whether to use memory-mapped access
+    bool memory_mapped_;
     /// Whether parsing the indexedmzML file was successful
     bool parsing_success_;
     /// Whether to skip XML checks
@@ -109,9 +132,23 @@ namespace Internal
     */
     void parseFooter_();
 
-    std::string getChromatogramById_helper_(int id);
+    /**
+      @brief Returns the raw XML of the chromatogram at position @p id
+
+      Uses the memory mapping if present (in which case the returned view
+      points into the mapping), otherwise reads from the file stream into @p
+      buffer.
+    */
+    std::string_view getChromatogramById_helper_(int id, std::string& buffer);
+
+    /// Returns the raw XML of the spectrum at position @p id, see getChromatogramById_helper_()
+    std::string_view getSpectrumById_helper_(int id, std::string& buffer);
+
+    /// Returns the bytes [@p start, @p end) of the file, see getChromatogramById_helper_()
+    std::string_view readRange_(std::streampos start, std::streampos end, std::string& buffer);
 
-    std::string getSpectrumById_helper_(int id);
+    /// Creates mapping_ for the current file
+    void mapFile_();
 
     public:
 
@@ -241,6 +278,19 @@ namespace Internal
     */
     void getMSChromatogramById(int id, OpenMS::MSChromatogram& c);
 
+    /**
+      @brief Whether to access the file through a read-only memory mapping
+
+      The mapping is created immediately if a file is open, otherwise upon
+      openFile(). The operating system is advised that access is random.
+
+      @throw Exception::FileNotReadable if the file cannot be mapped
+    */
+    void setMemoryMapped(bool memory_mapped);
+
+    /// Whether the file is accessed through a memory mapping
+    bool isMemoryMapped() const;
+
     /// Whether to skip some XML checks (removing whitespace from base64 arrays) and be fast instead
     void setSkipXMLChecks(bool skip)
     {
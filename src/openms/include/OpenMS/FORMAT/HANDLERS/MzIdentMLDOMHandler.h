@@ -118,9 +118,9 @@ protected:
       const ProgressLogger& logger_;
 
       ///Controlled vocabulary (psi-ms from OpenMS/share/OpenMS/CV/psi-ms.obo)
-      ControlledVocabulary cv_;
+      const ControlledVocabulary& cv_;
       ///Controlled vocabulary for modifications (unimod from OpenMS/share/OpenMS/CV/unimod.obo)
-      ControlledVocabulary unimod_;
+      const ControlledVocabulary& unimod_;
 
       ///Internal +w Identification Item for proteins
       std::vector<ProteinIdentification>* pro_id_;
@@ -103,9 +103,9 @@ protected:
       const ProgressLogger& logger_;
 
       ///Controlled vocabulary (psi-ms from OpenMS/share/OpenMS/CV/psi-ms.obo)
-      ControlledVocabulary cv_;
+      const ControlledVocabulary& cv_;
       ///Controlled vocabulary for modifications (unimod from OpenMS/share/OpenMS/CV/unimod.obo)
-      ControlledVocabulary unimod_;
+      const ControlledVocabulary& unimod_;
 
       //~ PeakMap* ms_exp_;
 
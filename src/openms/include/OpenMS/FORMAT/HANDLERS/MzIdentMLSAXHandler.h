@@ -0,0 +1,290 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/METADATA/CVTermList.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OpenMS
+{
+  class ControlledVocabulary;
+  class ProgressLogger;
+
+  namespace Internal
+  {
+
+    /**
+        @brief XML SAX handler for reading MzIdentMLFile into the legacy identification structures
+
+        Parses an MzIdentML file in a single streaming pass and appends the identifications to the
+        provided PeptideIdentifications and ProteinIdentifications, with the same conversion as
+        MzIdentMLDOMHandler, but without building a DOM tree of the whole file: the SequenceCollection
+        is kept in compact ID maps (peptide and DBSequence IDs mapped to indices, peptide evidences
+        grouped by peptide), and a PeptideIdentification is created as soon as its
+        SpectrumIdentificationResult has been read.
+
+        Cross-linking MS results (SpectrumIdentificationProtocol with a 'cross-linking search' parameter)
+        are not supported: parsing stops as soon as such a protocol is found (before any identification
+        was appended), see isCrossLinkingSearch().
+
+        @note Do not use this class. It is only needed in MzIdentMLFile.
+    */
+    class OPENMS_DLLAPI MzIdentMLSAXHandler :
+      public XMLHandler
+    {
+public:
+      /// Constructor for a read-only handler for internal identification structures
+      MzIdentMLSAXHandler(std::vector<ProteinIdentification>& pro_id, std::vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger);
+
+      /// Destructor
+      ~MzIdentMLSAXHandler() override;
+
+      // Docu in base class
+      void startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes) override;
+
+      // Docu in base class
+      void endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname) override;
+
+      // Docu in base class
+      void characters(const XMLCh* const chars, const XMLSize_t length) override;
+
+      /// Returns true if parsing was stopped because the file contains cross-linking MS results
+      bool isCrossLinkingSearch() const;
+
+protected:
+      /// cvParams and userParams of an element, in document order
+      struct ParamGroup
+      {
+        std::vector<CVTerm> cv_terms;
+        std::vector<std::pair<String, DataValue> > user_params;
+
+        CVTermList getCVTermList() const;
+        std::map<String, DataValue> getUserParams() const;
+        void clear();
+      };
+
+      ///Struct to hold the used analysis software for that file
+      struct AnalysisSoftware
+      {
+        String name;
+        String version;
+      };
+
+      ///Struct to hold the information from the SearchDatabase xml tag
+      struct DatabaseInput
+      {
+        String location;
+        String version;
+      };
+
+      ///Struct to hold the information from the DBSequence xml tag
+      struct DBSequence
+      {
+        String sequence;
+        String accession;
+      };
+
+      ///Struct to hold the PeptideEvidence information
+      struct PeptideEvidence
+      {
+        int start;
+        int stop;
+        char pre;
+        char post;
+        bool idec;
+        Size db_sequence; ///< index into db_sequences_
+      };
+
+      ///Struct to hold the information from the SpectrumIdentification xml tag
+      struct SpectrumIdentification
+      {
+        String spectra_data_ref;
+        String search_database_ref;
+        String spectrum_identification_protocol_ref;
+        String spectrum_identification_list_ref;
+        String activity_date;
+      };
+
+      ///Struct to hold the information from the SpectrumIdentificationProtocol xml tag
+      struct SpectrumIdentificationProtocol
+      {
+        String analysis_software_ref;
+        ProteinIdentification::SearchParameters search_parameters;
+        bool use_threshold = false;
+        double threshold = 0.0;
+      };
+
+      ///Struct to hold a Modification (of a Peptide) until the peptide sequence is complete
+      struct Modification
+      {
+        String location;
+        String mass_delta;
+        std::vector<CVTerm> cv_terms;
+      };
+
+      ///Struct to hold a SubstitutionModification (of a Peptide) until the peptide sequence is complete
+      struct Substitution
+      {
+        String location;
+        String original_residue;
+        String replacement_residue;
+      };
+
+      /// Converts a cvParam element
+      CVTerm parseCvParam_(const xercesc::Attributes& attributes) const;
+
+      /// Converts a userParam element
+      std::pair<String, DataValue> parseUserParam_(const xercesc::Attributes& attributes) const;
+
+      /// Builds the sequence of the current Peptide (from PeptideSequence, SubstitutionModification and Modification)
+      AASequence parsePeptide_() const;
+
+      /// Builds a PeptideHit from the current SpectrumIdentificationItem and adds it to the last PeptideIdentification
+      void handleSpectrumIdentificationItem_(const ParamGroup& params);
+
+      /// Creates the ProteinIdentifications for all SpectrumIdentifications (needs the protocols and inputs, which follow them in the file)
+      void createProteinIdentifications_();
+
+      /// Returns the index of the peptide with ID @p id (added if not known yet)
+      Size peptideIndex_(const String& id);
+
+      /// Returns the index of the DBSequence with ID @p id (added if not known yet)
+      Size dbSequenceIndex_(const String& id);
+
+      /// Returns the index in pro_id_ of the ProteinIdentification for SpectrumIdentificationList @p sil
+      Size proteinIdentificationIndex_(const String& sil) const;
+
+      static ProteinIdentification::SearchParameters findSearchParameters_(const ParamGroup& as_params);
+
+      /// Progress logger
+      const ProgressLogger& logger_;
+
+      ///Controlled vocabulary (psi-ms from OpenMS/share/OpenMS/CV/psi-ms.obo)
+      const ControlledVocabulary& cv_;
+
+      ///Internal +w Identification Item for proteins
+      std::vector<ProteinIdentification>* pro_id_;
+      ///Internal +w Identification Item for peptides
+      std::vector<PeptideIdentification>* pep_id_;
+
+      ///XML tag parse element
+      String tag_;
+
+      /// cvParams and userParams of the currently open elements (indexed by depth)
+      std::vector<ParamGroup> param_groups_;
+
+      /// Character data of the current Seq or PeptideSequence element
+      String characters_;
+      bool collect_characters_;
+
+      bool xl_ms_search_; ///< is true when reading a file containing Cross-Linking MS results
+      bool pro_ids_created_;
+      Size spectra_data_count_;
+      Size spectrum_identification_list_count_;
+
+      /**@name CV terms used for the conversion (looked up once per file) */
+      //@{
+      std::set<String> software_terms_;
+      std::set<String> enzyme_terms_;
+      std::set<String> threshold_terms_;
+      std::set<String> q_score_terms_;
+      std::set<String> e_score_terms_;
+      std::set<String> specific_score_terms_;
+      //@}
+
+      std::map<String, AnalysisSoftware> as_map_; ///< mapping AnalysisSoftware id -> AnalysisSoftware
+      std::map<String, String> sd_map_; ///< mapping spectradata id -> spectradata location
+      std::map<String, DatabaseInput> db_map_; ///< mapping database id -> DatabaseInput
+      std::vector<SpectrumIdentification> spectrum_identifications_; ///< in document order
+      std::map<String, SpectrumIdentificationProtocol> sp_map_; ///< mapping SpectrumIdentificationProtocol id -> SpectrumIdentificationProtocol
+      std::unordered_map<String, Size> si_pro_map_; ///< mapping SpectrumIdentificationList id -> index to ProteinIdentification in pro_id_
+      std::unordered_map<Size, std::unordered_set<String> > pro_accessions_; ///< accessions of the protein hits of ProteinIdentifications in pro_id_
+
+      std::unordered_map<String, Size> peptide_index_; ///< mapping Peptide id -> index into peptides_
+      std::vector<AASequence> peptides_;
+      std::vector<std::vector<PeptideEvidence> > peptide_evidences_; ///< PeptideEvidences of each peptide (same index as peptides_)
+      std::unordered_map<String, Size> db_sequence_index_; ///< mapping DBSequence id -> index into db_sequences_
+      std::vector<DBSequence> db_sequences_;
+
+      /**@name State of the elements currently parsed */
+      //@{
+      AnalysisSoftware current_software_;
+      String current_software_id_;
+      DatabaseInput current_database_;
+      String current_database_id_;
+      Size current_db_sequence_;
+      String current_peptide_id_;
+      String current_peptide_name_;
+      String current_peptide_sequence_;
+      std::vector<Substitution> current_substitutions_;
+      std::vector<Modification> current_modifications_;
+      SpectrumIdentification current_si_;
+      SpectrumIdentificationProtocol current_sip_;
+      String current_sip_id_;
+      std::vector<String> current_fixed_mods_;
+      std::vector<String> current_variable_mods_;
+      String current_mod_residues_;
+      String current_mod_name_;
+      bool current_mod_fixed_;
+      CVTermList current_specificity_rules_;
+      String current_enzyme_name_;
+      double current_fragment_tolerance_;
+      double current_precursor_tolerance_;
+      CVTermList current_threshold_;
+      String current_sil_;
+      String current_sii_peptide_ref_;
+      double current_sii_calculated_mz_;
+      double current_sii_experimental_mz_;
+      int current_sii_charge_;
+      int current_sii_rank_;
+      bool current_sii_pass_;
+      //@}
+
+private:
+      MzIdentMLSAXHandler();
+      MzIdentMLSAXHandler(const MzIdentMLSAXHandler& rhs);
+      MzIdentMLSAXHandler& operator=(const MzIdentMLSAXHandler& rhs);
+    };
+  } // namespace Internal
+} // namespace OpenMS
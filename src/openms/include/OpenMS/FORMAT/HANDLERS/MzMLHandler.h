@@ -49,6 +49,8 @@
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 #include <OpenMS/FORMAT/VALIDATORS/SemanticValidator.h>
 
+#include <deque>
+#include <future>
 #include <map>
 
 
@@ -221,6 +223,11 @@ protected:
 
           Will populate all spectra on the current work stack with data (using
           multiple threads if available) and append them to the result.
+
+          If pipelined decoding is enabled (see PeakFileOptions::setPipelinedDecoding),
+          the work stack is handed to a background thread instead and only
+          spectra of previously submitted stacks whose decoding has finished
+          are appended (in order).
       */
       void populateSpectraWithData_();
 
@@ -229,6 +236,8 @@ protected:
 
           Will populate all chromatograms on the current work stack with data (using
           multiple threads if available) and append them to the result.
+
+          See populateSpectraWithData_() for pipelined decoding.
       */
       void populateChromatogramsWithData_();
 
@@ -311,19 +320,47 @@ protected:
                         const Internal::MzMLValidator& validator);
 
 
-      /// Write out a single spectrum
+      /**
+        @brief Write out a single spectrum
+
+        If @p record_offset is false, the offset for the index is not recorded (the caller is responsible for it,
+        e.g. when formatting spectra concurrently into separate buffers). Apart from this, the function does not
+        modify the handler and can be called concurrently.
+      */
       void writeSpectrum_(std::ostream& os,
                           const SpectrumType& spec,
                           Size spec_idx,
                           const Internal::MzMLValidator& validator,
                           bool renew_native_ids,
-                          std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+                          std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                          bool record_offset = true);
 
-      /// Write out a single chromatogram
+      /// Write out a single chromatogram (see writeSpectrum_() for @p record_offset)
       void writeChromatogram_(std::ostream& os,
                               const ChromatogramType& chromatogram,
                               Size chrom_idx,
-                              const Internal::MzMLValidator& validator);
+                              const Internal::MzMLValidator& validator,
+                              bool record_offset = true);
+
+      /**
+        @brief Write out spectra in parallel (in order) and record their offsets for the index
+
+        @p first_idx is the index of the first spectrum in the spectrum list.
+      */
+      void writeSpectraParallel_(std::ostream& os,
+                                 const std::vector<const SpectrumType*>& spectra,
+                                 Size first_idx,
+                                 const Internal::MzMLValidator& validator,
+                                 bool renew_native_ids,
+                                 std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                                 const std::function<void(Size)>& progress);
+
+      /// Write out chromatograms in parallel (in order) and record their offsets for the index
+      void writeChromatogramsParallel_(std::ostream& os,
+                                       const std::vector<const ChromatogramType*>& chromatograms,
+                                       Size first_idx,
+                                       const Internal::MzMLValidator& validator,
+                                       const std::function<void(Size)>& progress);
 
       template <typename ContainerT>
       void writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type);
@@ -482,6 +519,61 @@ protected:
       /// Vector of chromatogram data stored for later parallel processing
       std::vector<ChromatogramData> chromatogram_data_;
 
+      /// A work stack which is decoded by a TaskPool worker (pipelined decoding)
+      template <typename DataType>
+      struct PendingData
+      {
+        std::vector<DataType> data;
+        std::future<void> decoded;
+
+        /// waits for the decoding task, which works on @p data (TaskPool futures do not block on destruction)
+        ~PendingData()
+        {
+          if (decoded.valid()) decoded.wait();
+        }
+      };
+
+      /// Decodes the binary data of all spectra in @p spectrum_data (using multiple threads if @p parallel is true)
+      void decodeSpectra_(std::vector<SpectrumData>& spectrum_data, bool parallel);
+
+      /// Decodes the binary data of all chromatograms in @p chromatogram_data (using multiple threads if @p parallel is true)
+      void decodeChromatograms_(std::vector<ChromatogramData>& chromatogram_data, bool parallel);
+
+      /// Appends decoded spectra to the experiment / consumer
+      void appendSpectra_(std::vector<SpectrumData>& spectrum_data);
+
+      /// Appends decoded chromatograms to the experiment / consumer
+      void appendChromatograms_(std::vector<ChromatogramData>& chromatogram_data);
+
+      /// Returns an empty BinaryData object, reusing the buffers of a recycled one if available
+      BinaryData nextBinaryData_();
+
+      /// Clears @p data and hands its buffers over to binary_data_pool_ (empties @p data)
+      void recycleBinaryData_(std::vector<BinaryData>& data);
+
+      /**
+          @brief Pool of BinaryData objects whose buffers are reused while loading
+
+          Once a spectrum (or chromatogram) has been decoded, the buffers of its
+          binary data arrays (base64 text, decoded values) are recycled for the
+          arrays of the following spectra. After the first data pool has been
+          decoded, loading thus allocates (almost) no scratch memory anymore,
+          which reduces heap fragmentation for large files.
+      */
+      std::vector<BinaryData> binary_data_pool_;
+
+      /**
+          @brief Appends pending spectra which have been decoded in the background
+
+          Appends (in order) all leading work stacks whose decoding has
+          finished and waits for further ones until at most @p max_pending
+          stacks are left. Errors from the background threads are re-thrown.
+      */
+      void appendPendingSpectra_(Size max_pending);
+
+      /// Appends pending chromatograms which have been decoded in the background (see appendPendingSpectra_())
+      void appendPendingChromatograms_(Size max_pending);
+
       //@}
       
       /**@name temporary data structures to hold written data
@@ -512,6 +604,16 @@ protected:
       const ControlledVocabulary& cv_;
       CVMappings mapping_;
 
+      /**@name work stacks which are decoded in the background (pipelined decoding)
+
+        @note Declared last, so they are destroyed (i.e. running decoding
+        threads are waited for) before any state those threads access.
+      */
+      //@{
+      std::deque<PendingData<SpectrumData> > pending_spectra_;
+      std::deque<PendingData<ChromatogramData> > pending_chromatograms_;
+      //@}
+
     };
 
     //--------------------------------------------------------------------------------
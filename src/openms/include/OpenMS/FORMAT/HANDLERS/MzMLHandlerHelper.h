@@ -122,6 +122,24 @@ namespace OpenMS
         BinaryData& operator=(BinaryData&&) & = default;       // Move assignment operator
         ~BinaryData() = default;                               // Destructor
 
+        /// Resets all members to their defaults, but keeps the allocated buffers (for reuse with the next array)
+        void clear()
+        {
+          precision = PRE_NONE;
+          data_type = DT_NONE;
+          np_compression = MSNumpressCoder::NumpressCompression();
+          compression = false;
+          unit_multiplier = 1.0;
+          base64.clear();
+          size = 0;
+          floats_32.clear();
+          floats_64.clear();
+          ints_32.clear();
+          ints_64.clear();
+          decoded_char.clear();
+          meta = MetaInfoDescription();
+        }
+
       };
 
       /**
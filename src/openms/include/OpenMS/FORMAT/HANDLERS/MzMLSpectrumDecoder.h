@@ -43,6 +43,7 @@
 #include <OpenMS/METADATA/MetaInfoDescription.h>
 
 #include <string>
+#include <string_view>
 #include <xercesc/dom/DOMNode.hpp>
 
 #include <OpenMS/FORMAT/HANDLERS/MzMLHandlerHelper.h>
@@ -111,13 +112,13 @@ namespace OpenMS
       vector with all binary data found in the string in the binaryDataArray
       tags.
 
-      @param in Input string containing the raw XML
+      @param in Input string containing the raw XML (not copied, may point into a memory-mapped file)
       @param data Binary data extracted from the string
 
       @pre in must have <spectrum> or <chromatogram> as root element.
 
     */
-    std::string domParseString_(const std::string& in, std::vector<BinaryData>& data);
+    std::string domParseString_(std::string_view in, std::vector<BinaryData>& data);
 
   public:
 
@@ -138,7 +139,7 @@ namespace OpenMS
       @pre in must have <spectrum> as root element.
 
     */
-    void domParseSpectrum(const std::string& in, OpenMS::Interfaces::SpectrumPtr & sptr);
+    void domParseSpectrum(std::string_view in, OpenMS::Interfaces::SpectrumPtr & sptr);
 
     /**
       @brief Extract data from a string which contains a full mzML spectrum.
@@ -153,7 +154,7 @@ namespace OpenMS
       @pre in must have <spectrum> as root element.
 
     */
-    void domParseSpectrum(const std::string& in, MSSpectrum& s);
+    void domParseSpectrum(std::string_view in, MSSpectrum& s);
 
     /**
       @brief Extract data from a string which contains a full mzML chromatogram.
@@ -168,7 +169,7 @@ namespace OpenMS
 
       @pre in must have <chromatogram> as root element.
     */
-    void domParseChromatogram(const std::string& in, MSChromatogram& c);
+    void domParseChromatogram(std::string_view in, MSChromatogram& c);
 
     /**
       @brief Extract data from a string which contains a full mzML chromatogram.
@@ -183,7 +184,7 @@ namespace OpenMS
 
       @pre in must have <chromatogram> as root element.
     */
-    void domParseChromatogram(const std::string& in, OpenMS::Interfaces::ChromatogramPtr & cptr);
+    void domParseChromatogram(std::string_view in, OpenMS::Interfaces::ChromatogramPtr & cptr);
 
     /// Whether to skip some XML checks (e.g. removing whitespace inside base64 arrays) and be fast instead
     void setSkipXMLChecks(bool only);
@@ -46,6 +46,7 @@ struct sqlite3_stmt;
 namespace OpenMS
 {
   class ProgressLogger;
+  class SqliteConnector;
 
   namespace Internal
   {
@@ -58,9 +59,11 @@ namespace OpenMS
         @note Due to the performance characteristics of the underlying SQLite
         database, it is highly recommended to read and write data
         (spectra/chromatograms) in batch. This is supported in this class and
-        essential for reasonable performance. The current class does support
-        batching SQL statements which can be controlled using setConfig and it
-        is recommended to set the batch size to at least 500.
+        essential for reasonable performance. All rows of a single write call
+        are inserted in one transaction using prepared statements, while the
+        binary data is encoded in batches by worker threads (the batch size
+        can be controlled using setConfig and it is recommended to set it to at
+        least 500). See also setWriteTuning.
         The underlying SQLite database only stores the most essential
         parameters of a MS experiment, to store the complete meta-data, a
         zipped representation of the mzML data structure can be written
@@ -145,7 +148,7 @@ public:
           @param write_full_meta Whether to write a complete mzML meta data structure into the RUN_EXTRA field (allows complete recovery of the input file)
           @param use_lossy_compression Whether to use lossy compression (ms numpress)
           @param linear_abs_mass_acc Accepted loss in mass accuracy (absolute m/z, in Th)
-          @param sql_batch_size Batch size of SQL insert statements
+          @param sql_batch_size Number of binary data arrays encoded per batch (encoding of the next batch overlaps with writing the current one)
       */
       void setConfig(bool write_full_meta, bool use_lossy_compression, double linear_abs_mass_acc, int sql_batch_size = 500) 
       {
@@ -155,6 +158,24 @@ public:
         sql_batch_size_ = sql_batch_size; 
       }
 
+      /**
+          @brief Set SQLite tuning options for writing
+
+          All data of a single writeSpectra() / writeChromatograms() call is
+          written in one transaction using prepared statements, while the
+          binary data is encoded in parallel ahead of the database writer.
+
+          @param use_wal Whether to use write-ahead logging while writing (the file is switched back to a rollback journal afterwards, so readers need no write access)
+          @param page_size Page size of newly created files in bytes (a power of two between 512 and 65536, zero keeps the SQLite default)
+          @param cache_size_kb Size of the SQLite page cache while writing in KiB (zero keeps the SQLite default)
+      */
+      void setWriteTuning(bool use_wal, int page_size = 0, int cache_size_kb = 0)
+      {
+        use_wal_ = use_wal;
+        page_size_ = page_size;
+        cache_size_kb_ = cache_size_kb;
+      }
+
       /**
           @brief Get spectral indices around a specific retention time
 
@@ -165,6 +186,23 @@ public:
       */
       std::vector<size_t> getSpectraIndicesbyRT(double RT, double deltaRT, const std::vector<int> & indices) const;
 
+      /**
+          @brief Get spectral indices by retention time range, MS level and precursor isolation target
+
+          The selection is performed by the database using the indices on
+          retention time, MS level and isolation target (created for new files
+          in createTables), so only the matching rows are read.
+
+          @param rt_min Lower bound of the retention time range (the range is ignored if rt_min > rt_max)
+          @param rt_max Upper bound of the retention time range
+          @param ms_level Only select spectra of this MS level (ignored if zero or negative)
+          @param precursor_mz_min Lower bound of the precursor isolation target (the range is ignored if precursor_mz_min > precursor_mz_max, otherwise only spectra with a precursor are selected)
+          @param precursor_mz_max Upper bound of the precursor isolation target
+          @return The indices of the selected spectra, sorted by retention time
+      */
+      std::vector<int> getSpectraIndices(double rt_min, double rt_max, int ms_level = -1,
+                                         double precursor_mz_min = 0.0, double precursor_mz_max = -1.0) const;
+
 protected:
 
       void populateChromatogramsWithData_(sqlite3 *db, std::vector<MSChromatogram>& chromatograms) const;
@@ -235,6 +273,12 @@ public:
 protected:
 
       void createIndices_();
+
+      /// apply the write tuning options to @p conn and start a transaction
+      void beginBulkWrite_(SqliteConnector& conn) const;
+
+      /// commit the transaction started by beginBulkWrite_
+      void endBulkWrite_(SqliteConnector& conn) const;
       //@}
 
       String filename_;
@@ -255,6 +299,9 @@ protected:
       double linear_abs_mass_acc_; 
       double write_full_meta_; 
       int sql_batch_size_; 
+      bool use_wal_;
+      int page_size_;
+      int cache_size_kb_;
     };
 
 
@@ -87,7 +87,7 @@ protected:
       const ProgressLogger & logger_;
 
       /// Controlled vocabulary (hopefully the psi-pi from OpenMS/share/OpenMS/CV/psi-pi.obo)
-      ControlledVocabulary cv_;
+      const ControlledVocabulary& cv_;
 
       String tag_;
 
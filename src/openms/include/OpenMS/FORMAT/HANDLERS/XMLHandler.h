@@ -45,6 +45,7 @@
 #include <xercesc/sax2/DefaultHandler.hpp>
 #include <xercesc/sax2/Attributes.hpp>
 
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <memory>
@@ -460,6 +461,24 @@ protected:
 
       //@}
 
+      /**
+        @brief Writes @p count independent elements to @p os in their original order, formatting them in parallel
+
+        @p write_element(out, i) must write element @p i to @p out and must be safe to call concurrently.
+        Elements are formatted block-wise into per-thread buffers (using the precision, flags and locale
+        of @p os), which are then appended to @p os in order. After each block, @p progress is called with
+        the number of elements written so far (from the calling thread).
+        Exceptions thrown by @p write_element are rethrown after the current block.
+
+        If @p element_offsets is given, it receives the position (os.tellp()) at which each element starts.
+        @p elements_per_thread bounds the number of formatted elements held in memory per thread.
+      */
+      static void writeElementsParallel_(std::ostream & os, Size count,
+                                         const std::function<void(std::ostream &, Size)> & write_element,
+                                         const std::function<void(Size)> & progress,
+                                         std::vector<Int64> * element_offsets = nullptr,
+                                         Size elements_per_thread = 256);
+
       ///@name controlled vocabulary handling methods
       //@{
 
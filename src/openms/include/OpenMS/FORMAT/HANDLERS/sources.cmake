@@ -12,6 +12,7 @@ MascotXMLHandler.h
 MzDataHandler.h
 MzIdentMLDOMHandler.h
 MzIdentMLHandler.h
+MzIdentMLSAXHandler.h
 MzMLHandler.h
 MzMLHandlerHelper.h
 MzMLSpectrumDecoder.h
@@ -34,11 +34,13 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceParseCache.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
 
 #include <vector>
 
@@ -100,6 +102,21 @@ public:
     */
     void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, String& document_id);
 
+    /**
+        @brief Streams the identifications of an idXML file to @p consumer
+
+        Hands out each ProteinIdentification and PeptideIdentification as soon as it was parsed,
+        instead of collecting all of them. Memory usage is therefore bounded by the size of a single
+        identification, which allows to process very large files (e.g. for filtering or export).
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, String& document_id);
+
+    /// Same as above, ignoring the document identifier
+    void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer);
+
     /**
         @brief Stores the data in an idXML file
 
@@ -124,6 +141,12 @@ protected:
     void addProteinGroups_(MetaInfoInterface& meta, const std::vector<ProteinIdentification::ProteinGroup>& groups,
                            const String& group_name, const std::unordered_map<std::string, UInt>& accession_to_id, XMLHandler::ActionMode mode);
 
+    /// Append a completed protein identification to prot_ids_ (or hand it to consumer_ when streaming)
+    void addProteinIdentification_(ProteinIdentification&& prot_id);
+
+    /// reset the temporary members used while loading
+    void resetMembers_();
+
     /// Read and store ProteinGroup data
     void getProteinGroups_(std::vector<ProteinIdentification::ProteinGroup>& groups, const String& group_name);
 
@@ -174,6 +197,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parse results of recently seen peptide sequences (the same peptide is usually identified many times)
+    AASequenceParseCache sequence_cache_;
     /// Temporary analysis result instance
     PeptideHit::PepXMLAnalysisResult current_analysis_result_;
     /// Temporary peptide evidences
@@ -184,6 +209,10 @@ protected:
     String* document_id_;
     /// true if a prot id is contained in the current run
     bool prot_id_in_run_;
+    /// Consumer which receives identifications while streaming (see transform()); nullptr otherwise
+    Interfaces::IIdentificationConsumer* consumer_;
+    /// Identifiers of the runs handed out so far while streaming (needed to link the peptide identifications)
+    std::vector<ProteinIdentification> streamed_prot_ids_;
     //@}
   };
 
@@ -0,0 +1,140 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace boost
+{
+  namespace interprocess
+  {
+    class mapped_region;
+  }
+}
+
+namespace OpenMS
+{
+  /**
+    @brief Binary, pre-indexed protein database which is memory-mapped for reading
+
+    Converting a FASTA file into this format once avoids re-parsing the text for every search.
+    The file contains the number of entries, offset tables for identifiers, descriptions and
+    sequences, a decoy flag per entry and the concatenated strings:
+
+    @code
+    UInt64 magic, UInt32 version, UInt32 reserved, UInt64 entry count (n), UInt64 string data size
+    UInt64 identifier offsets[n + 1], description offsets[n + 1], sequence offsets[n + 1]
+    UInt8 decoy flags[n] (padded to a multiple of 8 bytes)
+    char string data[]
+    @endcode
+
+    All numbers are stored in native byte order. After load(), entries can be accessed in random
+    order and concurrently without copying (see getSequence()); copies of an object share the mapping.
+    Use FASTAContainer<TFI_Indexed> to feed the database to algorithms which consume a FASTAContainer.
+  */
+  class OPENMS_DLLAPI IndexedFASTAFile
+  {
+  public:
+    /// Default constructor (no database loaded)
+    IndexedFASTAFile();
+
+    /// Constructor which loads the database @p filename (see load())
+    explicit IndexedFASTAFile(const String& filename);
+
+    /// Destructor
+    ~IndexedFASTAFile();
+
+    /**
+      @brief Writes @p entries as binary database to @p filename
+
+      An entry is flagged as decoy if its identifier starts (if @p decoy_is_prefix) or ends with @p decoy_string.
+      If @p decoy_string is empty, no entry is flagged.
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    static void store(const String& filename, const std::vector<FASTAFile::FASTAEntry>& entries,
+                      const String& decoy_string = "", bool decoy_is_prefix = true);
+
+    /**
+      @brief Memory-maps the database @p filename and validates its layout
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::FileNotReadable is thrown if the file cannot be mapped
+      @exception Exception::ParseError is thrown if the file is not a valid database
+    */
+    void load(const String& filename);
+
+    /// is a database loaded?
+    bool isOpen() const;
+
+    /// number of entries (0 if no database is loaded)
+    Size size() const;
+
+    /// identifier of entry @p index (view into the mapped file; valid while the mapping is alive)
+    std::string_view getIdentifier(Size index) const;
+
+    /// description of entry @p index (view into the mapped file; valid while the mapping is alive)
+    std::string_view getDescription(Size index) const;
+
+    /// sequence of entry @p index (view into the mapped file; valid while the mapping is alive)
+    std::string_view getSequence(Size index) const;
+
+    /// was entry @p index flagged as decoy when the database was written?
+    bool isDecoy(Size index) const;
+
+    /**
+      @brief Copies entry @p index into @p entry
+
+      @exception Exception::IndexOverflow is thrown if @p index is not smaller than size()
+    */
+    void getEntry(Size index, FASTAFile::FASTAEntry& entry) const;
+
+  private:
+    /// view of the string with index @p index in the offset table @p offsets
+    std::string_view view_(const UInt64* offsets, Size index) const;
+
+    std::shared_ptr<const boost::interprocess::mapped_region> mapping_; ///< read-only mapping of the database file
+    Size size_ = 0; ///< number of entries
+    const UInt64* id_offsets_ = nullptr; ///< size_ + 1 offsets of identifiers into data_
+    const UInt64* description_offsets_ = nullptr; ///< size_ + 1 offsets of descriptions into data_
+    const UInt64* sequence_offsets_ = nullptr; ///< size_ + 1 offsets of sequences into data_
+    const unsigned char* decoy_ = nullptr; ///< size_ decoy flags
+    const char* data_ = nullptr; ///< concatenated strings
+  };
+
+} // namespace OpenMS
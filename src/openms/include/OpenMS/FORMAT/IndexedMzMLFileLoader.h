@@ -82,6 +82,28 @@ namespace OpenMS
     */
     bool load(const String& filename, OnDiscPeakMap& exp);
 
+    /**
+      @brief Load a file completely into memory, decoding the data in parallel
+
+      Reads the meta data (without any binary data) and the index of the
+      file, then splits the indexed spectra and chromatograms into contiguous
+      blocks, one per thread. Each thread reads its block (a contiguous byte
+      range of the file) through its own file handle and decodes the data
+      arrays independently of all other threads.
+
+      The RT range, MS level, fill data and sorting options are honored. If
+      m/z or intensity ranges are set, the file is loaded sequentially
+      through MzMLFile instead.
+
+      @param filename Filename determines where the file is located
+      @param exp Object which will contain the data after the call
+
+      @return Indicates whether parsing was successful (if it is false, the file most likely was not an mzML or not indexed).
+
+      @exception Exception::ParseError is thrown if the data of a spectrum or chromatogram cannot be decoded
+    */
+    bool load(const String& filename, PeakMap& exp);
+
     /**
       @brief Store a file from an on-disc data-structure
 
@@ -38,6 +38,8 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <functional>
+#include <iosfwd>
 #include <vector>
 
 namespace OpenMS
@@ -84,6 +86,18 @@ public:
     */
     void load(const String & filename, std::vector<PeptideIdentification> & ids, PeakMap & exp);
 
+    /**
+        @brief Loads a MSPFile file and passes each library spectrum to a callback instead of storing it.
+
+        Entries are parsed in parallel in chunks, @p consume is called in file order with the peptide
+        identification of the entry and its spectrum (same content as the output of load()).
+
+        @throw FileNotFound is thrown if the file could not be found
+        @throw ParseError is thrown if the given file could not be parsed
+        @throw ElementNotFound is thrown if a annotated modification cannot be found in ModificationsDB (PSI-MOD definitions)
+    */
+    void load(const String & filename, const std::function<void(PeptideIdentification&, PeakSpectrum&)>& consume);
+
     /**
         @brief Stores a map in a MSPFile file.
 
@@ -95,6 +109,12 @@ protected:
 
     /// reads the header information and stores it as metainfo in the spectrum
     void parseHeader_(const String & header, PeakSpectrum & spec);
+
+    /// splits the file into chunks of entries, parses them in parallel and passes the results (in file order) to @p consume_chunk
+    void readChunks_(const String & filename, const std::function<void(std::vector<PeptideIdentification>&, std::vector<PeakSpectrum>&, const std::vector<Size>&)>& consume_chunk);
+
+    /// parses all entries of @p is (starting at @p line_number and @p spectrum_number); @p spectrum_to_id holds the index of the identification for each spectrum
+    void parseEntries_(std::istream & is, Size line_number, Size spectrum_number, std::vector<PeptideIdentification> & ids, std::vector<PeakSpectrum> & spectra, std::vector<Size> & spectrum_to_id);
   };
 
 } // namespace OpenMS
@@ -104,6 +104,20 @@ namespace OpenMS
         std::vector<BaseFeature> features;                                        //<s Features of ConsensusMap
       };
 
+      /*
+        *  @brief: Experimental design information of one map (column) of the ConsensusMap.
+        *  Resolved once per map on first use instead of once per feature handle and peptide hit.
+        */
+      struct MapDesignInfo_
+      {
+        bool resolved = false;
+        String run_string;                //< MSstats run
+        String fraction_string;           //< empty if the experiment is not fractionated
+        String condition;
+        String bioreplicate;
+        String filename;                  //< basename of the spectra file
+      };
+
       /*
         *  @brief: Aggregates information from ConsensusFeature and ConsensusMap,
         *  such as filenames, intensities, retention times, labels and features.
@@ -37,12 +37,16 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/METADATA/SpectrumSettings.h>
 #include <OpenMS/SYSTEM/File.h>
 
-#include <vector>
+#include <exception>
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -92,35 +96,21 @@ public:
     template <typename MapType>
     void load(const String& filename, MapType& exp)
     {
-      if (!File::exists(filename))
-      {
-        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
-      }
-
       exp.reset();
+      readSpectra_<typename MapType::SpectrumType>(filename, [&exp](typename MapType::SpectrumType& spectrum) { exp.addSpectrum(std::move(spectrum)); });
+    }
 
-      std::ifstream is(filename.c_str());
-      // get size of file
-      is.seekg(0, std::ios::end);
-      startProgress(0, is.tellg(), "loading MGF");
-      is.seekg(0, std::ios::beg);
-
-      UInt spectrum_number(0);
-      Size line_number(0); // carry line number for error messages within getNextSpectrum()
+    /**
+      @brief Transforms a Mascot Generic File while loading using the supplied consumer
 
-      typename MapType::SpectrumType spectrum;
-      spectrum.setMSLevel(2);
-      spectrum.getPrecursors().resize(1);
-      spectrum.setType(SpectrumSettings::SpectrumType::CENTROID); // MGF is always centroided, by definition
-      while (getNextSpectrum_(is, spectrum, line_number, spectrum_number))
-      {
-        exp.addSpectrum(spectrum);
-        setProgress(is.tellg());
-        ++spectrum_number;
-      } // next spectrum
+      Spectra are parsed in parallel (in chunks) and passed to the consumer in file order, without keeping the whole file in memory.
 
-      endProgress();
-    }
+      @param filename file name which the spectra should be read from
+      @param consumer consumer which receives the spectra
+      @param skip_full_count skip counting the spectra before reading (consumer->setExpectedSize() is then called with zero)
+      @throw FileNotFound is thrown if the given file could not be found
+    */
+    void transform(const String& filename, Interfaces::IMSDataConsumer* consumer, bool skip_full_count = false);
 
     /**
       @brief enclosing Strings of the peak list body for HTTP submission
@@ -155,9 +145,127 @@ protected:
     /// writes the MSExperiment
     void writeMSExperiment_(std::ostream& os, const String& filename, const PeakMap& experiment);
 
+    /**
+      @brief reads all spectra of a MGF file and passes them to @p consume (in file order)
+
+      The file is read sequentially and split into 'BEGIN IONS' ... 'END IONS' blocks, which are parsed in parallel
+      in batches. Every spectrum is parsed independently, i.e. values which are missing in a block (e.g. RTINSECONDS)
+      are not taken over from the previous spectrum. Blocks without peaks are skipped.
+    */
+    template <typename SpectrumType, typename Consumer>
+    void readSpectra_(const String& filename, Consumer&& consume)
+    {
+      if (!File::exists(filename))
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+
+      std::ifstream is(filename.c_str());
+      // get size of file
+      is.seekg(0, std::ios::end);
+      startProgress(0, is.tellg(), "loading MGF");
+      is.seekg(0, std::ios::beg);
+
+      SpectrumType empty_spectrum;
+      empty_spectrum.setMSLevel(2);
+      empty_spectrum.getPrecursors().resize(1);
+      empty_spectrum.setType(SpectrumSettings::SpectrumType::CENTROID); // MGF is always centroided, by definition
+
+      const Size batch_size = 4096; // spectra parsed concurrently
+      std::vector<std::string> blocks;
+      std::vector<Size> block_lines; // line number before the 'BEGIN IONS' line of each block
+      std::vector<SpectrumType> spectra;
+      std::string block;
+      String line;
+      Size line_number(0);
+      Size block_line(0);
+      bool in_block(false), block_has_peaks(false);
+      Size spectrum_number(0);
+      bool more(true);
+      while (more)
+      {
+        blocks.clear();
+        block_lines.clear();
+        while (blocks.size() < batch_size)
+        {
+          more = static_cast<bool>(getline(is, line, '\n'));
+          if (!more)
+          {
+            if (in_block && block_has_peaks)
+            { // incomplete block: the parser reports the missing 'END IONS'
+              blocks.push_back(std::move(block));
+              block_lines.push_back(block_line);
+            }
+            break;
+          }
+          ++line_number;
+          String trimmed(line);
+          trimmed.trim(); // remove whitespaces, line-endings etc
+          if (!in_block)
+          {
+            if (trimmed == "BEGIN IONS")
+            {
+              in_block = true;
+              block_has_peaks = false;
+              block_line = line_number - 1;
+              block.assign(line).push_back('\n');
+            }
+            continue;
+          }
+          block.append(line).push_back('\n');
+          if (trimmed == "END IONS")
+          {
+            if (block_has_peaks)
+            {
+              blocks.push_back(std::move(block));
+              block_lines.push_back(block_line);
+            }
+            block.clear();
+            in_block = false;
+          }
+          else if (!trimmed.empty() && isdigit(trimmed[0]))
+          {
+            block_has_peaks = true;
+          }
+        }
+
+        const SignedSize n = static_cast<SignedSize>(blocks.size());
+        spectra.assign(blocks.size(), empty_spectrum);
+        std::vector<std::exception_ptr> errors(blocks.size());
+#pragma omp parallel for schedule(dynamic, 16)
+        for (SignedSize i = 0; i < n; ++i)
+        {
+          try
+          {
+            std::istringstream block_is(blocks[i]);
+            Size block_line_number = block_lines[i];
+            getNextSpectrum_(block_is, spectra[i], block_line_number, spectrum_number + i);
+          }
+          catch (...)
+          {
+            errors[i] = std::current_exception();
+          }
+        }
+        // report the first error in file order, as the sequential reader did
+        for (const std::exception_ptr& error : errors)
+        {
+          if (error) std::rethrow_exception(error);
+        }
+
+        for (SpectrumType& spectrum : spectra)
+        {
+          consume(spectrum);
+        }
+        spectrum_number += blocks.size();
+        if (more) setProgress(is.tellg());
+      }
+
+      endProgress();
+    }
+
     /// reads a spectrum block, the section between 'BEGIN IONS' and 'END IONS' of a MGF file
     template <typename SpectrumType>
-    bool getNextSpectrum_(std::ifstream& is, SpectrumType& spectrum, Size& line_number, const Size& spectrum_number)
+    bool getNextSpectrum_(std::istream& is, SpectrumType& spectrum, Size& line_number, const Size& spectrum_number)
     {
       spectrum.resize(0);
       spectrum.setNativeID(String("index=") + (spectrum_number));
@@ -188,7 +296,6 @@ protected:
 
             if (isdigit(line[0])) // actual data .. this comes first, since its the most common case
             {
-              std::vector<String> split;
               do
               {
                 if (line.empty())
@@ -196,14 +303,28 @@ protected:
                   continue;
                 }
 
-                line.simplify(); // merge double spaces (explicitly allowed by MGF), to prevent empty split() chunks and subsequent parse error
-                line.substitute('\t', ' '); // also accept Tab (strictly, only space(s) are allowed)
-                if (line.split(' ', split, false))
+                // split into the first two columns without creating temporary strings;
+                // multiple spaces (explicitly allowed by MGF) and tabs (strictly, only space(s) are allowed) are accepted as separator
+                StringView columns[2];
+                Size n_columns = 0;
+                const char* c = line.c_str();
+                const char* const line_end = c + line.size();
+                while (c != line_end && n_columns < 2)
+                {
+                  while (c != line_end && isspace(static_cast<unsigned char>(*c))) ++c;
+                  const char* column_start = c;
+                  while (c != line_end && !isspace(static_cast<unsigned char>(*c))) ++c;
+                  if (c != column_start)
+                  {
+                    columns[n_columns++] = StringView(column_start, c - column_start);
+                  }
+                }
+                if (n_columns == 2)
                 {
                   try
                   {
-                    p.setPosition(split[0].toDouble());
-                    p.setIntensity(split[1].toDouble());
+                    p.setPosition(columns[0].toDouble());
+                    p.setIntensity(columns[1].toDouble());
                   }
                   catch (Exception::ConversionError& /*e*/)
                   {
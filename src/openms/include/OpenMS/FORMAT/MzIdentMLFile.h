@@ -77,6 +77,9 @@ public:
     /**
         @brief Loads the identifications from a MzIdentML file.
 
+        The file is read in a single streaming (SAX) pass. Only files with cross-linking MS results are
+        read into a DOM tree, as their conversion is not supported by the streaming parser.
+
         @exception Exception::FileNotFound is thrown if the file could not be opened
         @exception Exception::ParseError is thrown if an error occurs during parsing
     */
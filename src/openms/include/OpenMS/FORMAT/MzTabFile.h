@@ -40,7 +40,9 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 
+#include <ostream>
 #include <vector>
 
 namespace OpenMS
@@ -157,12 +159,71 @@ namespace OpenMS
     /// Generate an mzTab section comprising multiple rows of the same type and perform sanity check
     template <typename SectionRow> void generateMzTabSection_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, StringList& output, size_t n_header_columns) const
     {
-      output.reserve(output.size() + rows.size() + 1);
-      for (const auto& row : rows)
+      const Size offset = output.size();
+      output.resize(offset + rows.size());
+      std::vector<size_t> n_section_columns(rows.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)rows.size(); ++i)
       {
-        size_t n_section_columns = 0;
-        output.push_back(generateMzTabSectionRow_(row, optional_columns, meta, n_section_columns));
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns. Please report this bug to the OpenMS developers.");
+        output[offset + i] = generateMzTabSectionRow_(rows[i], optional_columns, meta, n_section_columns[i]);
+      }
+      for (size_t n : n_section_columns)
+      {
+        if (n_header_columns != n)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns. Please report this bug to the OpenMS developers.");
+      }
+    }
+
+    /**
+      @brief Stream an mzTab section to @p os without materializing all of its rows
+
+      Rows are pulled from @p next_row (e.g. MzTab::IDMzTabStream::nextPSMRow) in batches.
+      Each batch is formatted in parallel into reused buffers and written in input order.
+      @p write_header is called with the first row, writes the section header and returns its number of columns.
+
+      @throw Exception::Postcondition if a row and the header differ in their number of columns
+    */
+    template <typename SectionRow, typename NextRow, typename WriteHeader>
+    void writeMzTabSectionStreamed_(std::ostream& os, NextRow&& next_row, WriteHeader&& write_header, const std::vector<String>& optional_columns, const MzTabMetaData& meta, const String& section_name) const
+    {
+      const Size batch_size = 1024;
+      std::vector<SectionRow> rows(batch_size);
+      std::vector<String> lines(batch_size);
+      std::vector<size_t> n_section_columns(batch_size);
+      size_t n_header_columns = 0;
+      bool first = true;
+      while (true)
+      {
+        Size n_rows = 0;
+        while (n_rows < batch_size && next_row(rows[n_rows])) { ++n_rows; }
+        if (n_rows == 0) break;
+
+        if (first)
+        {
+          n_header_columns = write_header(rows[0]);
+          first = false;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)n_rows; ++i)
+        {
+          n_section_columns[i] = 0;
+          lines[i] = generateMzTabSectionRow_(rows[i], optional_columns, meta, n_section_columns[i]);
+        }
+
+        for (Size i = 0; i < n_rows; ++i)
+        {
+          if (n_header_columns != n_section_columns[i])
+          {
+            OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns[i] << std::endl;
+            throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, section_name + " header and content differs in columns. Please report this bug to the OpenMS developers.");
+          }
+          os << lines[i] << "\n";
+        }
+        if (n_rows < batch_size) break;
       }
     }
 
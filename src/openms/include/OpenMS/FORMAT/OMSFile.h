@@ -44,10 +44,31 @@ namespace OpenMS
       @brief This class supports reading and writing of OMS files.
 
       OMS files are SQLite databases consisting of several tables.
+
+      Identification data can be loaded selectively (see LoadSelection), so that tools that e.g. only need the scores of observation matches do not have to read the whole database.
   */
   class OPENMS_DLLAPI OMSFile: public ProgressLogger
   {
   public:
+    /**
+      @brief Selection of identification data to load from an OMS file
+
+      Score types, input files, processing steps and their search parameters and adducts are always loaded, since they are small and referenced by everything else.
+
+      Paging (@p offset, @p limit) is applied to observation matches and parent sequences independently, in database order.
+      Only those observations and identified molecules that are referenced by the selected observation matches are loaded.
+      Parent group sets are only loaded if all parent sequences are, and parent matches pointing to parent sequences that were not loaded are skipped.
+    */
+    struct LoadSelection
+    {
+      bool observation_matches = true; ///< Load observation matches incl. their scores (and the observations/identified molecules they refer to)?
+      bool parent_sequences = true; ///< Load parent sequences (and parent group sets)?
+      bool meta_info = true; ///< Load meta values of all loaded elements?
+      bool peak_annotations = true; ///< Load peak annotations of observation matches?
+      Size offset = 0; ///< Number of observation matches/parent sequences to skip
+      Size limit = 0; ///< Maximum number of observation matches/parent sequences to load (0: no limit)
+    };
+
     /// Constructor (with option to set log type)
     explicit OMSFile(LogType log_type = LogType::NONE):
       log_type_(log_type)
@@ -76,6 +97,16 @@ namespace OpenMS
      */
     void load(const String& filename, IdentificationData& id_data);
 
+    /** @brief Read parts of an OMS file into an IdentificationData object
+     *
+     * Use this to load e.g. only observation matches with their scores, or only parent sequences, and to page through large files.
+     *
+     * @param filename The input file
+     * @param id_data The IdentificationData object
+     * @param selection Which parts of the data to load
+     */
+    void load(const String& filename, IdentificationData& id_data, const LoadSelection& selection);
+
     /** @brief Read in a OMS file and construct a feature map
      *
      * @param filename The input file
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FORMAT/OMSFile.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/METADATA/ID/IdentificationData.h>
 
@@ -77,6 +78,9 @@ namespace OpenMS
       /// Load data from database and populate an IdentificationData object
       void load(IdentificationData& id_data);
 
+      /// Load selected parts of the data from database and populate an IdentificationData object
+      void load(IdentificationData& id_data, const OMSFile::LoadSelection& selection);
+
       /// Load data from database and populate a FeatureMap object
       void load(FeatureMap& features);
 
@@ -141,11 +145,19 @@ namespace OpenMS
         QSqlQuery& query, IdentificationData::ObservationMatch& match,
         Key parent_id);
 
+      /// SQL clause for paging (empty if all rows are selected)
+      QString pagingClause_() const;
+
       // store name, not database connection itself (see https://stackoverflow.com/a/55200682):
       QString db_name_;
 
       int version_number_; ///< schema version number
 
+      OMSFile::LoadSelection selection_; ///< what to load
+
+      /// SQL query selecting the observation matches to load (empty if all of them are loaded)
+      QString match_subset_;
+
       // mappings between database keys and loaded data:
       std::unordered_map<Key, IdentificationData::ScoreTypeRef> score_type_refs_;
       std::unordered_map<Key, IdentificationData::InputFileRef> input_file_refs_;
@@ -38,8 +38,11 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/METADATA/ID/IdentificationData.h>
 
+#include <QtCore/QVariant>
 #include <QtSql/QSqlQuery>
 
+#include <exception>
+
 class QSqlError;
 
 namespace OpenMS
@@ -158,9 +161,62 @@ namespace OpenMS
 
       void createTableAppliedProcessingStep_(const String& parent_table);
 
-      void storeAppliedProcessingStep_(
+      /// Append the table rows (5 columns each) for an applied processing step to @p values
+      static void appendAppliedProcessingStep_(
         const IdentificationData::AppliedProcessingStep& step, Size step_order,
-        const String& parent_table, Key parent_id);
+        Key parent_id, std::vector<QVariant>& values);
+
+      /*!
+        @brief Insert rows into a table using multi-row INSERT statements
+
+        @param table Name of the table
+        @param n_columns Number of columns of the table
+        @param values Values of all rows (row-major, @p n_columns per row)
+
+        @throw Exception::FailedAPICall Data cannot be inserted
+      */
+      void insertRows_(const String& table, Size n_columns,
+                       const std::vector<QVariant>& values);
+
+      /*!
+        @brief Convert the elements of a container to table rows in parallel
+
+        @p fill_row is called for every element with a pointer to the @p n_columns values of its row.
+        It must be safe to call concurrently for different elements.
+
+        @return Values of all rows (row-major), suitable for insertRows_()
+      */
+      template <class Container, class RowFunction>
+      static std::vector<QVariant> serializeRows_(const Container& container,
+                                                  Size n_columns,
+                                                  const RowFunction& fill_row)
+      {
+        // ID containers are not random-access, so collect pointers first:
+        std::vector<const typename Container::value_type*> elements;
+        elements.reserve(container.size());
+        for (const auto& element : container) elements.push_back(&element);
+        std::vector<QVariant> values(elements.size() * n_columns);
+        std::exception_ptr error; // exceptions must not escape the parallel region
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1024)
+#endif
+        for (SignedSize i = 0; i < SignedSize(elements.size()); ++i)
+        {
+          try
+          {
+            fill_row(*elements[i], &values[i * n_columns]);
+          }
+          catch (...)
+          {
+#ifdef _OPENMP
+#pragma omp critical (OMSFileStore_serializeRows)
+#endif
+            if (!error) error = std::current_exception();
+          }
+        }
+        if (error) std::rethrow_exception(error);
+        return values;
+      }
 
       void createTableIdentifiedMolecule_();
 
@@ -196,25 +252,22 @@ namespace OpenMS
         const ScoredProcessingResultContainer& container,
         const String& parent_table)
       {
-        bool table_created = false;
+        std::vector<QVariant> values;
         for (const auto& element : container)
         {
-          if (!element.steps_and_scores.empty())
+          Size counter = 0;
+          for (const IdentificationData::AppliedProcessingStep& step :
+                 element.steps_and_scores)
           {
-            if (!table_created)
-            {
-              createTableAppliedProcessingStep_(parent_table);
-              table_created = true;
-            }
-            Size counter = 0;
-            for (const IdentificationData::AppliedProcessingStep& step :
-                   element.steps_and_scores)
-            {
-              storeAppliedProcessingStep_(step, ++counter, parent_table,
-                                          Key(&element));
-            }
+            appendAppliedProcessingStep_(step, ++counter, Key(&element),
+                                         values);
           }
         }
+        if (!values.empty())
+        {
+          createTableAppliedProcessingStep_(parent_table);
+          insertRows_(parent_table + "_AppliedProcessingStep", 5, values);
+        }
         storeMetaInfos_(container, parent_table);
       }
 
@@ -63,6 +63,16 @@ public:
     ///returns whether or not to load subordinates
     bool getLoadSubordinates() const;
 
+    ///@name store options
+    ///sets whether or not to write convex hulls when storing
+    void setStoreConvexHull(bool convex);
+    ///returns whether or not to write convex hulls when storing
+    bool getStoreConvexHull() const;
+    ///sets whether or not to write subordinate features when storing
+    void setStoreSubordinates(bool sub);
+    ///returns whether or not to write subordinate features when storing
+    bool getStoreSubordinates() const;
+
     ///@name metadata option
     ///sets whether or not to load only meta data
     void setMetadataOnly(bool only);
@@ -102,6 +112,8 @@ public:
 private:
     bool loadConvexhull_;
     bool loadSubordinates_;
+    bool storeConvexhull_;
+    bool storeSubordinates_;
     bool metadata_only_;
     bool has_rt_range_;
     bool has_mz_range_;
@@ -221,6 +221,22 @@ public:
     Size getMaxDataPoolSize() const;
     /// Set maximal size of the data pool
     void setMaxDataPoolSize(Size size);
+
+    /**
+        @brief [mzML only!] Whether to decode the data pool in background threads while parsing continues
+
+        By default, parsing of the XML stops whenever the data pool is full
+        and resumes once all of its binary data has been decoded (in
+        parallel). When pipelined decoding is enabled, full data pools are
+        handed over to the worker threads of the TaskPool (i.e. within the
+        thread budget of the process) and the XML parser immediately
+        continues with the next pool, keeping all cores busy. Spectra and
+        chromatograms are still passed to the consumer (or experiment) in
+        file order and from the parsing thread.
+    */
+    bool getPipelinedDecoding() const;
+    /// Set whether to decode the data pool in background threads (see getPipelinedDecoding())
+    void setPipelinedDecoding(bool pipelined);
     //@}
 
     /// [mzML only!] Whether to use the "selected ion m/z" value as the precursor m/z value (alternative: use the "isolation window target m/z" value)
@@ -257,6 +273,7 @@ private:
     MSNumpressCoder::NumpressConfig np_config_int_;
     MSNumpressCoder::NumpressConfig np_config_fda_;
     Size maximal_data_pool_size_;
+    bool pipelined_decoding_;
     bool precursor_mz_selected_ion_;
   };
 
@@ -35,8 +35,9 @@
 #pragma once
 
 #include <OpenMS/METADATA/PeptideIdentification.h>
-#include <OpenMS/FORMAT/TextFile.h>
 
+#include <iosfwd>
+#include <set>
 #include <vector>
 
 namespace OpenMS
@@ -45,6 +46,9 @@ namespace OpenMS
   /**
      @brief Class for storing Percolator tab-delimited input files.
 
+     The rows are generated in parallel for blocks of PeptideIdentifications and
+     written to the file block by block (in input order), so the complete file
+     content is never held in memory.
   */
   class OPENMS_DLLAPI PercolatorInfile
   {
@@ -62,13 +66,26 @@ namespace OpenMS
     protected:
 
       //id <tab> label <tab> scannr <tab> calcmass <tab> expmass <tab> feature1 <tab> ... <tab> featureN <tab> peptide <tab> proteinId1 <tab> .. <tab> proteinIdM
-      static TextFile preparePin_(
+      static void writePin_(
+        std::ostream& os,
         const std::vector<PeptideIdentification>& peptide_ids, 
         const StringList& feature_set, 
         const std::string& enz, 
         int min_charge, 
         int max_charge);
 
+      /// Appends the rows for the hits of @p pep_id to @p rows. Returns the number of hits skipped because of missing features (whose names are added to @p missing_meta_values).
+      static Size getPinRows_(
+        const PeptideIdentification& pep_id,
+        const String& scan_identifier,
+        Int scan_number,
+        const StringList& feature_set, 
+        const std::string& enz, 
+        int min_charge, 
+        int max_charge,
+        std::vector<String>& rows,
+        std::set<String>& missing_meta_values);
+
 
       static Int getScanNumber_(const String& scan_identifier);
 
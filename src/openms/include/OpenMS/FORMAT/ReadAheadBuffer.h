@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Reads ahead from a (decompressing) input in a background thread
+
+    Wraps a read function which fills a buffer and returns the number of
+    bytes read (zero at the end of the input, short reads are allowed). A
+    worker thread fills chunks of data
+    ahead of the consumer, so decompression overlaps with parsing of the
+    already decompressed data.
+
+    Exceptions thrown by the read function are passed on to the consumer by
+    the next call to read() after all data read before the error was consumed.
+
+    @note The read function is only called from the worker thread. The
+    underlying stream must not be accessed by anyone else while this object
+    exists.
+  */
+  class OPENMS_DLLAPI ReadAheadBuffer
+  {
+public:
+    /// Function filling a buffer of given size, returns the number of bytes written (zero only at the end of the input)
+    typedef std::function<size_t(char*, size_t)> ReadFunction;
+
+    /**
+      @brief Starts reading ahead from @p read_function
+
+      @param read_function The source of the data
+      @param chunk_size Number of bytes requested from @p read_function at once
+      @param max_chunks_ahead Maximal number of chunks buffered ahead of the consumer
+    */
+    explicit ReadAheadBuffer(ReadFunction read_function, size_t chunk_size = 1 << 20, size_t max_chunks_ahead = 2);
+
+    /// Stops the worker thread (waits for the current chunk to finish)
+    ~ReadAheadBuffer();
+
+    ReadAheadBuffer(const ReadAheadBuffer&) = delete;
+    ReadAheadBuffer& operator=(const ReadAheadBuffer&) = delete;
+
+    /**
+      @brief Reads up to @p n bytes into @p s
+
+      Blocks until data is available.
+
+      @return The number of bytes read. If it is less than @p n, the end of the input was reached.
+
+      @exception Any exception thrown by the read function
+    */
+    size_t read(char* s, size_t n);
+
+    /// Returns true if all data has been consumed
+    bool streamEnd() const;
+
+protected:
+    /// worker thread: fill chunks until the input ends or stop_ is set
+    void run_();
+
+    /// takes the next filled chunk, returns false at the end of the input
+    bool nextChunk_();
+
+    ReadFunction read_function_;
+    size_t chunk_size_;
+    size_t max_chunks_ahead_;
+
+    /// chunk currently consumed and position within
+    std::vector<char> current_;
+    size_t current_pos_ = 0;
+    bool at_end_ = false;
+
+    /// shared between consumer and worker (protected by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::vector<char> > filled_;
+    std::vector<std::vector<char> > free_;
+    bool done_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    std::thread worker_;
+  };
+
+} // namespace OpenMS
@@ -67,6 +67,10 @@ public:
       bool write_full_meta{true}; ///< write full meta data
       bool use_lossy_numpress{false}; ///< use lossy numpress compression
       double linear_fp_mass_acc{-1}; ///< desired mass accuracy for numpress linear encoding (-1 no effect, use 0.0001 for 0.2 ppm accuracy @ 500 m/z)
+      int sql_batch_size{500}; ///< number of binary data arrays encoded per batch while writing (encoding of the next batch overlaps with writing)
+      bool use_wal{false}; ///< use write-ahead logging while writing (the file is switched back to a rollback journal afterwards)
+      int page_size{0}; ///< SQLite page size of new files in bytes (0 keeps the SQLite default)
+      int cache_size_kb{0}; ///< SQLite page cache size while writing in KiB (0 keeps the SQLite default)
     };
 
     typedef MSExperiment MapType;
@@ -95,6 +99,16 @@ public:
     */
     void store(const String& filename, MapType& map) const;
 
+    /**
+     @brief Load only the spectra within a retention time range (and optionally of a given MS level and precursor isolation target range)
+
+     The selection is performed by the database (see
+     Internal::MzMLSqliteHandler::getSpectraIndices), so only the data of the
+     selected spectra is read from disk. Parameters are as there.
+    */
+    void loadSpectra(const String& filename, std::vector<MSSpectrum>& spectra, double rt_min, double rt_max,
+                     int ms_level = -1, double precursor_mz_min = 0.0, double precursor_mz_max = -1.0) const;
+
     void transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, bool skip_full_count = false, bool skip_first_pass = false) const;
 
     void setConfig(const SqMassConfig& config) 
@@ -79,26 +79,16 @@ namespace OpenMS
       static const char quote_ = '"';
 
       /*
-        *  @brief: Struct to aggregate intermediate information from ConsensusFeature and ConsensusMap,
-        *  such as filenames, intensities, retention times, labels and features (for further processing)
+        *  @brief: Experimental design information of one map (column) of the ConsensusMap.
+        *  Resolved once per map on first use instead of once per feature handle and peptide hit.
         */
-      struct AggregatedConsensusInfo
+      struct MapDesignInfo_
       {
-        std::vector< std::vector< String > > consensus_feature_filenames;           //< Filenames of ConsensusFeature
-        std::vector< std::vector< Intensity > > consensus_feature_intensities;       //< Intensities of ConsensusFeature
-        std::vector< std::vector< Coordinate > > consensus_feature_retention_times; //< Retention times of ConsensusFeature
-        std::vector< std::vector< unsigned > > consensus_feature_labels;          //< Labels of ConsensusFeature
-        std::vector<BaseFeature> features;                                        //<s Features of ConsensusMap
+        bool resolved = false;
+        String run_string;  //< Triqler run
+        String condition;
       };
 
-      /*
-        *  @brief: Aggregates information from ConsensusFeature and ConsensusMap,
-        *  such as filenames, intensities, retention times, labels and features.
-        *  Stores them in AggregatedConsensusInfo for later processing
-        */
-      TriqlerFile::AggregatedConsensusInfo aggregateInfo_(const ConsensusMap& consensus_map,
-                                                          const std::vector<String>& spectra_paths);
-
       /*
         *  @brief: Internal function to check if condition exists in Experimental Design
         */
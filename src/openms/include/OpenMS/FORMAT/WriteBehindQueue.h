@@ -0,0 +1,113 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace OpenMS
+{
+  /**
+    @brief Runs write tasks in submission order in a background thread
+
+    Used for write-behind output: the producer hands over tasks (e.g.
+    formatting and writing a spectrum, owning a copy of the data) and
+    continues with its computation while a dedicated writer thread executes
+    them. At most @p max_pending tasks are queued; push() blocks when the queue
+    is full, so memory stays bounded if the writer cannot keep up.
+
+    If a task throws, the exception is rethrown by the next call to push() or
+    flush(), and all tasks queued after the failing one are discarded.
+
+    @note All access to the written resource (e.g. the output stream) must go
+    through the queue while it exists.
+  */
+  class OPENMS_DLLAPI WriteBehindQueue
+  {
+public:
+    typedef std::function<void()> Task;
+
+    /// Starts the writer thread
+    explicit WriteBehindQueue(size_t max_pending = 16);
+
+    /// Runs all pending tasks and stops the writer thread (exceptions are discarded, call flush() to receive them)
+    ~WriteBehindQueue();
+
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+
+    /**
+      @brief Queues @p task for execution in the writer thread
+
+      Blocks while the queue is full.
+
+      @exception Any exception thrown by a previously queued task
+    */
+    void push(Task task);
+
+    /**
+      @brief Waits until all queued tasks have been executed
+
+      @exception Any exception thrown by a queued task
+    */
+    void flush();
+
+protected:
+    /// writer thread: execute tasks until stop_ is set and the queue is empty
+    void run_();
+
+    /// rethrows (and resets) error_, requires the lock
+    void rethrowError_();
+
+    size_t max_pending_;
+
+    /// shared between producer and writer (protected by mutex_)
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Task> tasks_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    std::thread worker_;
+  };
+
+} // namespace OpenMS
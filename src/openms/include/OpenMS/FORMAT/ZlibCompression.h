@@ -75,6 +75,20 @@ public:
     */
     static void compressString(const QByteArray& raw_data, QByteArray& compressed_data);
 
+    /**
+      * @brief Compresses data using zlib directly into a byte buffer
+      *
+      * Counterpart of uncompressData(), no length header is prepended. The
+      * capacity of @p compressed_data is reused.
+      *
+      * @param raw_data Data to be compressed
+      * @param nr_bytes Number of bytes in @p raw_data
+      * @param compressed_data Compressed result data (resized to the number of compressed bytes)
+      *
+      * @throw Exception::ConversionError if the data cannot be compressed
+    */
+    static void compressData(const void* raw_data, size_t nr_bytes, std::vector<Byte>& compressed_data);
+
     /**
       * @brief Uncompresses data using Qt (wrapper around Qt function)
       *
@@ -94,6 +108,22 @@ public:
     */
     static void uncompressString(const QByteArray& compressed_data, QByteArray& raw_data);
 
+    /**
+      * @brief Uncompresses data using zlib directly into a byte buffer
+      *
+      * Other than the Qt based functions, this inflates the data without
+      * prepending a length header or copying the input. The capacity of @p
+      * raw_data is reused, which makes it suitable as a scratch buffer when
+      * decompressing many arrays in a row.
+      *
+      * @param compressed_data Compressed data
+      * @param nr_bytes Number of bytes in compressed data
+      * @param raw_data Uncompressed result data (resized to the number of uncompressed bytes)
+      *
+      * @throw Exception::ConversionError if the data cannot be decompressed
+    */
+    static void uncompressData(const void* compressed_data, size_t nr_bytes, std::vector<Byte>& raw_data);
+
   };
 
 } // namespace OpenMS
@@ -23,6 +23,7 @@ Base64.h
 Bzip2Ifstream.h
 Bzip2InputStream.h
 CachedMzML.h
+CachedPeptideDatabase.h
 ChromeleonFile.h
 CompressedInputSource.h
 CVMappingFile.h
@@ -34,6 +35,7 @@ DTAFile.h
 EDTAFile.h
 ExperimentalDesignFile.h
 FASTAFile.h
+IndexedFASTAFile.h
 FeatureXMLFile.h
 FileHandler.h
 GNPSMetaValueFile.h
@@ -88,6 +90,7 @@ PercolatorInfile.h
 PercolatorOutfile.h
 ProtXMLFile.h
 QcMLFile.h
+ReadAheadBuffer.h
 SequestInfile.h
 SequestOutfile.h
 SpecArrayFile.h
@@ -100,6 +103,7 @@ ToolDescriptionFile.h
 TransformationXMLFile.h
 TriqlerFile.h
 UnimodXMLFile.h
+WriteBehindQueue.h
 XMLFile.h
 XTandemInfile.h
 XTandemXMLFile.h
@@ -0,0 +1,78 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+namespace OpenMS
+{
+  class ProteinIdentification;
+  class PeptideIdentification;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of protein and peptide identifications
+
+      Counterpart of IMSDataConsumer for identification data: a reader (e.g.
+      IdXMLFile::transform()) hands out identifications one at a time as they
+      are parsed, so that large result files can be processed without holding
+      all PeptideIdentification objects in memory.
+
+      Each ProteinIdentification (i.e. identification run) is consumed before
+      the PeptideIdentification objects which refer to it.
+    */
+    class OPENMS_DLLAPI IIdentificationConsumer
+    {
+    public:
+      virtual ~IIdentificationConsumer() {}
+
+      /**
+        @brief Consume a protein identification (run)
+
+        The object may be modified or moved from by the implementation.
+      */
+      virtual void consumeProteinIdentification(ProteinIdentification& protein_id) = 0;
+
+      /**
+        @brief Consume a peptide identification
+
+        The object may be modified or moved from by the implementation.
+      */
+      virtual void consumePeptideIdentification(PeptideIdentification& peptide_id) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
@@ -5,6 +5,7 @@ set(directory include/OpenMS/INTERFACES)
 set(sources_list_h
 DataStructures.h
 ISpectrumAccess.h
+IIdentificationConsumer.h
 IMSDataConsumer.h
 )
 
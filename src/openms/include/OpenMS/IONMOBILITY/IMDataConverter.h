@@ -80,6 +80,8 @@ namespace OpenMS
         @param number_of_bins In how many bins should the ion mobility frame be sliced? Default(-1) assigns all peaks with identical ion-mobility values to a separate spectrum.
         @return IM frame split into multiple bins (= 1 spectrum per bin)
 
+        @note For large (TIMS) data, consider IMFrameMap, which gives access to the individual mobility scans without creating a spectrum for each.
+
         @throws Exception::MissingInformation if @p im_frame does not have IM data in floatDataArrays
       */
       static MSExperiment splitByIonMobility(MSSpectrum im_frame, UInt number_of_bins = -1);
@@ -0,0 +1,152 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/IONMOBILITY/IMTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/METADATA/DataArrays.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class MSExperiment;
+
+  /**
+    @brief Compact storage of (TimsTOF) ion mobility frames
+
+    IMDataConverter::splitByIonMobility() creates one MSSpectrum per ion mobility value, i.e. for TIMS data
+    tens of millions of tiny spectra, each with its own copy of the frame's meta data.
+    This container instead stores the peaks of all frames in two concatenated buffers (m/z and intensity),
+    sorted by ion mobility within each frame, plus offset arrays which delimit the frames and their mobility
+    scans (= all peaks of a frame with identical ion mobility value).
+
+    Single mobility scans are accessed via getScan(), which returns a non-owning view into the peak buffers.
+    If a real MSSpectrum is required, use toSpectrum() (equivalent to the output of IMDataConverter::splitByIonMobility())
+    or toFrameSpectrum() (the concatenated frame, sorted by ion mobility).
+
+    Only m/z, intensity and ion mobility of the peaks are stored; other data arrays of the frames are dropped.
+    The meta data of a frame (RT, MS level, precursors, ...) is stored once per frame.
+  */
+  class OPENMS_DLLAPI IMFrameMap
+  {
+  public:
+    /**
+      @brief Non-owning view on the peaks of a single mobility scan of a frame
+
+      The view is invalidated when frames are added to (or cleared from) the IMFrameMap it was obtained from.
+    */
+    struct OPENMS_DLLAPI MobilityScanView
+    {
+      /// m/z values of the peaks
+      const double* mz = nullptr;
+      /// intensities of the peaks
+      const float* intensity = nullptr;
+      /// number of peaks
+      Size size = 0;
+      /// ion mobility value (of all peaks) of this scan
+      double drift_time = IMTypes::DRIFTTIME_NOT_SET;
+    };
+
+    /// Default constructor
+    IMFrameMap() = default;
+
+    /**
+      @brief Stores all ion mobility frames (i.e. spectra with an IM float data array) of @p exp
+
+      Spectra without IM float data array are ignored. The experimental settings of @p exp are not stored.
+    */
+    explicit IMFrameMap(const MSExperiment& exp);
+
+    /**
+      @brief Append the ion mobility frame @p im_frame
+
+      @throws Exception::MissingInformation if a non-empty @p im_frame does not have IM data in floatDataArrays
+    */
+    void addFrame(const MSSpectrum& im_frame);
+
+    /// Number of frames
+    Size size() const;
+
+    /// Are there no frames?
+    bool empty() const;
+
+    /// Removes all frames
+    void clear();
+
+    /// Total number of peaks in all frames
+    Size getNrOfPeaks() const;
+
+    /// Total number of mobility scans in all frames
+    Size getNrOfScans() const;
+
+    /// Number of mobility scans of frame @p frame_index
+    Size getNrOfScans(Size frame_index) const;
+
+    /// Meta data (RT, MS level, ...) of frame @p frame_index, without peaks and data arrays
+    const MSSpectrum& getFrameMetaData(Size frame_index) const;
+
+    /// Unit of the ion mobility values of frame @p frame_index
+    DriftTimeUnit getDriftTimeUnit(Size frame_index) const;
+
+    /// View on the mobility scan @p scan_index of frame @p frame_index (scans are sorted by ascending ion mobility)
+    MobilityScanView getScan(Size frame_index, Size scan_index) const;
+
+    /// Creates an MSSpectrum of the mobility scan @p scan_index of frame @p frame_index (meta data of the frame, drift time and unit of the scan)
+    MSSpectrum toSpectrum(Size frame_index, Size scan_index) const;
+
+    /// Creates the concatenated frame @p frame_index with IM float data array (peaks sorted by ion mobility)
+    MSSpectrum toFrameSpectrum(Size frame_index) const;
+
+  protected:
+    /// meta data of each frame (without peaks)
+    std::vector<MSSpectrum> frame_meta_;
+    /// IM float data array of each frame (name and meta data only, without values)
+    std::vector<DataArrays::FloatDataArray> frame_im_arrays_;
+    /// unit of the ion mobility values of each frame
+    std::vector<DriftTimeUnit> frame_im_units_;
+    /// scans of frame i are [frame_scan_offsets_[i], frame_scan_offsets_[i + 1])
+    std::vector<Size> frame_scan_offsets_{0};
+    /// ion mobility value of each scan
+    std::vector<double> scan_drift_times_;
+    /// peaks of scan i are [scan_peak_offsets_[i], scan_peak_offsets_[i + 1])
+    std::vector<Size> scan_peak_offsets_{0};
+    /// concatenated m/z values of all peaks
+    std::vector<double> mz_;
+    /// concatenated intensities of all peaks
+    std::vector<float> intensity_;
+  };
+
+} //end namespace OpenMS
@@ -0,0 +1,155 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/PeakIndex.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class MSExperiment;
+  class MSChromatogram;
+
+  /**
+    @brief Precomputed 2D index of the peaks of an MSExperiment for fast RT/m/z area queries
+
+    MSExperiment::areaBegin() and the AreaIterator visit every peak of an
+    area. Repeated queries (zooming in a viewer, extracting many ion
+    chromatograms) on the same data are answered faster by this index, which
+    stores for all spectra of one MS level (sorted by RT):
+
+    - the m/z values of all peaks in one contiguous array, together with
+      the first m/z of each block of @ref BLOCK_SIZE peaks, so that m/z
+      positions are found by a two-level binary search,
+    - a prefix sum of the intensities, so that the summed intensity of an
+      m/z window of a spectrum is computed in constant time (independent
+      of the number of peaks in the window),
+    - the maximum intensity of each block (tile summary), so that only the
+      partial blocks at the window borders need to be scanned for maxima.
+
+    Thus, countPeaks(), sumIntensity() and extractXIC() need
+    O(S * log P) time and maxIntensity() O(S * (log P + W / BLOCK_SIZE + BLOCK_SIZE)),
+    with S the number of spectra in the RT range, P the number of peaks per
+    spectrum and W the number of peaks in the m/z window.
+
+    The index stores copies of m/z values and intensities (about 20 bytes per
+    peak) and does not observe the experiment: rebuild it after modifying the
+    experiment.
+    Peaks of each spectrum must be sorted by m/z.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI AreaIndex
+  {
+public:
+    /// Number of peaks summarized in one block
+    static constexpr Size BLOCK_SIZE = 32;
+
+    /// Default constructor (empty index)
+    AreaIndex() = default;
+
+    /**
+      @brief Builds the index for all spectra of MS level @p ms_level of @p exp
+
+      @exception Exception::IllegalArgument if a spectrum is not sorted by m/z
+    */
+    explicit AreaIndex(const MSExperiment& exp, UInt ms_level = 1);
+
+    /// @copydoc AreaIndex(const MSExperiment&, UInt)
+    void build(const MSExperiment& exp, UInt ms_level = 1);
+
+    /// Number of indexed spectra
+    Size size() const;
+
+    /// Returns if no spectrum is indexed
+    bool empty() const;
+
+    /// Number of peaks in the area
+    Size countPeaks(double min_rt, double max_rt, double min_mz, double max_mz) const;
+
+    /// Summed intensity of all peaks in the area
+    double sumIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const;
+
+    /// Maximum intensity of a peak in the area (0 if there is none)
+    double maxIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const;
+
+    /**
+      @brief Extracts the ion chromatogram of the m/z window for the RT range
+
+      @p xic receives one point (RT, summed intensity) per indexed spectrum in
+      [@p min_rt, @p max_rt], including spectra without peaks in the window
+      (intensity 0). Previous peaks of @p xic are removed.
+    */
+    void extractXIC(double min_rt, double max_rt, double min_mz, double max_mz, MSChromatogram& xic) const;
+
+    /// Appends the indices (spectrum index in the experiment, peak index in the spectrum) of all peaks in the area to @p result
+    void getPeaks(double min_rt, double max_rt, double min_mz, double max_mz, std::vector<PeakIndex>& result) const;
+
+private:
+    /// Range [first, last) of indexed spectra with RT in [min_rt, max_rt]
+    std::pair<Size, Size> rtRange_(double min_rt, double max_rt) const;
+
+    /// Range [first, last) of positions in the flat arrays of spectrum @p s with m/z in [min_mz, max_mz]
+    std::pair<Size, Size> mzRange_(Size s, double min_mz, double max_mz) const;
+
+    /// Retention times of the indexed spectra (sorted)
+    std::vector<double> rt_;
+
+    /// Index of the indexed spectra in the experiment
+    std::vector<Size> spectrum_index_;
+
+    /// Offset of the first peak of each indexed spectrum in the flat arrays (plus one past-the-end entry)
+    std::vector<Size> peak_offset_;
+
+    /// Offset of the first block of each indexed spectrum (plus one past-the-end entry)
+    std::vector<Size> block_offset_;
+
+    /// m/z values of all peaks
+    std::vector<double> mz_;
+
+    /// Intensities of all peaks
+    std::vector<float> intensity_;
+
+    /// Intensity prefix sums per spectrum (P + 1 entries for spectrum s, starting at peak_offset_[s] + s)
+    std::vector<double> intensity_sum_;
+
+    /// First m/z of each block
+    std::vector<double> block_mz_;
+
+    /// Maximum intensity of each block
+    std::vector<float> block_max_;
+  };
+}
@@ -160,8 +160,7 @@ public:
             for (Size peak_idx = 0; peak_idx < it->size(); peak_idx++)
             {
               // copy spectrum and delete all data, but keep metadata, then add single peak
-              SpectrumType dummy = *it;
-              dummy.clear(false);
+              SpectrumType dummy = it->copyWithoutPeaks();
               dummy.push_back((*it)[peak_idx]);
               chroms[it->getPrecursors().begin()->getMZ()][(*it)[peak_idx].getMZ()].push_back(dummy);
             }
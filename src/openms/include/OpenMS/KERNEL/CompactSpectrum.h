@@ -0,0 +1,144 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/Peak1D.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class MSSpectrum;
+
+  /**
+    @brief Memory compact, read-only peak storage of a spectrum with single precision m/z values
+
+    MSSpectrum stores each peak as Peak1D, i.e. a double m/z and a float
+    intensity (16 bytes per peak including padding). Data of low resolution
+    instruments (e.g. ion traps) does not need double precision. This
+    container stores the m/z of each peak as a float offset relative to a
+    per-spectrum base m/z (the smallest m/z) and the intensity as float, i.e.
+    8 bytes per peak. The relative encoding keeps the absolute error small:
+    it is at most half a float ULP of the m/z span of the spectrum (about
+    3e-5 Th for a span of 500 Th, 6e-5 Th for 1000 Th).
+
+    Use it for spectra that are kept in memory for read-only access (e.g.
+    spectral libraries or caches). getMaxMZError() reports the largest error
+    introduced by the encoding, and exportTo() restores an MSSpectrum.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI CompactSpectrum
+  {
+public:
+    /// Default constructor (no peaks)
+    CompactSpectrum() = default;
+
+    /// Encodes the peaks of @p spectrum (meta data and data arrays are not stored)
+    explicit CompactSpectrum(const MSSpectrum& spectrum);
+
+    /// Equality operator
+    bool operator==(const CompactSpectrum& rhs) const;
+
+    /// Inequality operator
+    bool operator!=(const CompactSpectrum& rhs) const;
+
+    /// Replaces the content by the encoded peaks of @p spectrum
+    void assign(const MSSpectrum& spectrum);
+
+    /// Replaces the peaks of @p spectrum by the decoded peaks (meta data is kept, data arrays are removed)
+    void exportTo(MSSpectrum& spectrum) const;
+
+    /// Number of peaks
+    Size size() const
+    {
+      return intensity_.size();
+    }
+
+    /// Returns if there are no peaks
+    bool empty() const
+    {
+      return intensity_.empty();
+    }
+
+    /// Removes all peaks
+    void clear();
+
+    /// Decoded m/z of peak @p i
+    double getMZ(Size i) const
+    {
+      return base_mz_ + mz_offset_[i];
+    }
+
+    /// Intensity of peak @p i
+    float getIntensity(Size i) const
+    {
+      return intensity_[i];
+    }
+
+    /// Decoded peak @p i
+    Peak1D operator[](Size i) const
+    {
+      return Peak1D(getMZ(i), getIntensity(i));
+    }
+
+    /// m/z all offsets refer to
+    double getBaseMZ() const
+    {
+      return base_mz_;
+    }
+
+    /// Largest absolute m/z error (in Th) introduced when encoding the current peaks
+    double getMaxMZError() const
+    {
+      return max_mz_error_;
+    }
+
+    /// Memory used by the peak data (in bytes)
+    Size getMemoryUsage() const;
+
+protected:
+    /// Base m/z of the spectrum (smallest m/z)
+    double base_mz_ = 0.0;
+
+    /// Largest encoding error of the current peaks
+    double max_mz_error_ = 0.0;
+
+    /// m/z offsets to base_mz_
+    std::vector<float> mz_offset_;
+
+    /// Intensities
+    std::vector<float> intensity_;
+  };
+}
@@ -0,0 +1,194 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/FeatureHandle.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ConsensusMap;
+
+  /**
+    @brief Flat (column-wise) copy of the feature handles of a ConsensusMap
+
+    Each ConsensusFeature stores its sub-features in a std::set<FeatureHandle>,
+    i.e. one tree node per handle. Algorithms that only need the map index,
+    position and intensity of all handles (normalization, export) spend most of
+    their time chasing pointers on large cohort studies. This class stores the
+    handles of all consensus features in contiguous arrays (compressed sparse
+    row layout): the handles of consensus feature @em i are the elements
+    <tt>[elementsBegin(i), elementsEnd(i))</tt>, in the order of the handle set.
+
+    The layout is a snapshot: changes to the ConsensusMap are not reflected.
+    Modified intensities can be written back with applyIntensities(), as long
+    as the features of the map were not added, removed or reordered.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI FlatConsensusMap
+  {
+public:
+    /// Default constructor (no features)
+    FlatConsensusMap() = default;
+
+    /// Copies the feature handles of @p map
+    explicit FlatConsensusMap(const ConsensusMap& map);
+
+    /// Replaces the content by the feature handles of @p map
+    void assign(const ConsensusMap& map);
+
+    /**
+      @brief Writes the (modified) intensities back to the feature handles of @p map
+
+      @exception Exception::IllegalArgument is thrown if @p map has a different number of consensus features or handles
+    */
+    void applyIntensities(ConsensusMap& map) const;
+
+    /// Number of consensus features
+    Size size() const
+    {
+      return offsets_.size() - 1;
+    }
+
+    /// Returns if there are no consensus features
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    /// Total number of feature handles
+    Size numberOfElements() const
+    {
+      return map_index_.size();
+    }
+
+    /// Index of the first element of consensus feature @p feature
+    Size elementsBegin(Size feature) const
+    {
+      return offsets_[feature];
+    }
+
+    /// Index after the last element of consensus feature @p feature
+    Size elementsEnd(Size feature) const
+    {
+      return offsets_[feature + 1];
+    }
+
+    /// Map index of element @p element
+    UInt64 getMapIndex(Size element) const
+    {
+      return map_index_[element];
+    }
+
+    /// Unique id of the feature referenced by element @p element
+    UInt64 getUniqueId(Size element) const
+    {
+      return unique_id_[element];
+    }
+
+    /// Intensity of element @p element
+    FeatureHandle::IntensityType getIntensity(Size element) const
+    {
+      return intensity_[element];
+    }
+
+    /// Sets the intensity of element @p element (see applyIntensities())
+    void setIntensity(Size element, FeatureHandle::IntensityType intensity)
+    {
+      intensity_[element] = intensity;
+    }
+
+    /// RT of element @p element
+    FeatureHandle::CoordinateType getRT(Size element) const
+    {
+      return rt_[element];
+    }
+
+    /// m/z of element @p element
+    FeatureHandle::CoordinateType getMZ(Size element) const
+    {
+      return mz_[element];
+    }
+
+    /// Map indices of all elements
+    const std::vector<UInt64>& getMapIndices() const
+    {
+      return map_index_;
+    }
+
+    /// Intensities of all elements
+    const std::vector<FeatureHandle::IntensityType>& getIntensities() const
+    {
+      return intensity_;
+    }
+
+    /// Mutable intensities of all elements (see applyIntensities())
+    std::vector<FeatureHandle::IntensityType>& getIntensities()
+    {
+      return intensity_;
+    }
+
+    /// Retention times of all elements
+    const std::vector<FeatureHandle::CoordinateType>& getRTs() const
+    {
+      return rt_;
+    }
+
+    /// m/z values of all elements
+    const std::vector<FeatureHandle::CoordinateType>& getMZs() const
+    {
+      return mz_;
+    }
+
+    /// Removes all features
+    void clear();
+
+protected:
+    /// Start of the elements of each consensus feature (size() + 1 entries)
+    std::vector<Size> offsets_ = std::vector<Size>(1, 0);
+    /// Map index of each element
+    std::vector<UInt64> map_index_;
+    /// Unique id of the referenced feature of each element
+    std::vector<UInt64> unique_id_;
+    /// Intensity of each element
+    std::vector<FeatureHandle::IntensityType> intensity_;
+    /// RT of each element
+    std::vector<FeatureHandle::CoordinateType> rt_;
+    /// m/z of each element
+    std::vector<FeatureHandle::CoordinateType> mz_;
+  };
+
+} // namespace OpenMS
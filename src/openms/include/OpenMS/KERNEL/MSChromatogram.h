@@ -159,11 +159,24 @@ public:
     void updateRanges() override
     {
       clearRanges();
+      if (ContainerType::empty())
+      {
+        return;
+      }
+      // reduce into local variables instead of extending the member ranges for each peak
+      double min_rt = std::numeric_limits<double>::max(), max_rt = std::numeric_limits<double>::lowest();
+      double min_int = std::numeric_limits<double>::max(), max_int = std::numeric_limits<double>::lowest();
       for (const auto& peak : (ContainerType&) *this)
       {
-        extendRT(peak.getRT());
-        extendIntensity(peak.getIntensity());
+        min_rt = std::min(min_rt, double(peak.getRT()));
+        max_rt = std::max(max_rt, double(peak.getRT()));
+        min_int = std::min(min_int, double(peak.getIntensity()));
+        max_int = std::max(max_int, double(peak.getIntensity()));
       }
+      extendRT(min_rt);
+      extendRT(max_rt);
+      extendIntensity(min_int);
+      extendIntensity(max_int);
     }
 
     ///@name Accessors for meta information
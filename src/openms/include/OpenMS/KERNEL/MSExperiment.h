@@ -329,7 +329,7 @@ public:
 
     ///@name Iterating ranges and areas
     //@{
-    /// Returns an area iterator for @p area
+    /// Returns an area iterator for @p area (for repeated queries on unchanged data, see AreaIndex)
     AreaIterator areaBegin(CoordinateType min_rt, CoordinateType max_rt, CoordinateType min_mz, CoordinateType max_mz);
 
     /// Returns an invalid area iterator marking the end of an area
@@ -377,6 +377,24 @@ public:
       }
     }
 
+    /**
+      @brief Extracts ion chromatograms for many targets in a single sweep over the spectra
+
+      For each target (m/z range, RT range) of @p ranges, the result contains
+      (at the same position) a chromatogram with one point per spectrum of MS
+      level @p ms_level within the RT range. The intensity of a point is the
+      summed intensity of the peaks in the m/z range (0 if there are none). The
+      product m/z of the chromatogram is set to the center of the m/z range.
+
+      Other than calling areaBeginConst() for every target, the spectra are
+      visited once, each taking care of all targets overlapping its RT. Targets
+      do not need to be sorted. Spectra are processed in parallel if OpenMP is
+      enabled.
+
+      @note Make sure the spectra are sorted with respect to retention time and m/z! Otherwise the result is undefined.
+    */
+    std::vector<MSChromatogram> extractXICs(const std::vector<std::pair<RangeMZ, RangeRT> >& ranges, UInt ms_level = 1) const;
+
 
     /**
       @brief Fast search for spectrum range begin
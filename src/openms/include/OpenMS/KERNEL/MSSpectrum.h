@@ -570,6 +570,15 @@ public:
     */
     void clear(bool clear_meta_data);
 
+    /**
+      @brief Returns a copy of the spectrum without peaks and data arrays
+
+      Same result as copying the spectrum and calling clear(false), but the
+      peaks and data arrays are never copied. Use this to create a spectrum
+      that is filled with new peaks but keeps the meta data of this one.
+    */
+    MSSpectrum copyWithoutPeaks() const;
+
     /*
       @brief Select a (subset of) spectrum and its data_arrays, only retaining the indices given in @p indices
 
@@ -54,14 +54,20 @@ namespace OpenMS
 
     @ingroup Kernel
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. Please provide a separate copy to each thread, e.g. 
+    @note By default, this implementation is @a not thread-safe since it
+    keeps internally a single file access pointer which it moves when
+    accessing a specific data item. Please provide a separate copy to each
+    thread, e.g. 
 
     @code
     #pragma omp parallel for firstprivate(ondisc_map) 
     @endcode
 
+    Alternatively, use setMemoryMapped() to read the file through a shared
+    read-only memory mapping. Then getSpectrum(), getSpectrumById(),
+    getChromatogram() and getChromatogramById() may be called concurrently
+    from multiple threads on the same object.
+
   */
   class OPENMS_DLLAPI OnDiscMSExperiment
   {
@@ -236,6 +242,17 @@ public:
     /// sets whether to skip some XML checks and be fast instead
     void setSkipXMLChecks(bool skip);
 
+    /**
+      @brief Sets whether to access the file through a read-only memory mapping
+
+      Spectra and chromatograms are then decoded directly from the mapped
+      file (no stream seeks, no copies of the XML) and concurrent read access
+      is safe. May be called before or after openFile().
+
+      @throw Exception::FileNotReadable if the file cannot be mapped
+    */
+    void setMemoryMapped(bool memory_mapped);
+
 private:
 
     /// Private Assignment operator -> we cannot copy file streams in IndexedMzMLHandler
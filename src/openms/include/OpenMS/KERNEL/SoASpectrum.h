@@ -0,0 +1,309 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/AlignedAllocator.h>
+#include <OpenMS/KERNEL/Peak1D.h>
+#include <OpenMS/METADATA/DataArrays.h>
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  class MSSpectrum;
+  enum class DriftTimeUnit;
+
+  /**
+    @brief Peak data of a spectrum stored as structure of arrays (SoA)
+
+    In contrast to MSSpectrum, which stores a contiguous array of Peak1D
+    (m/z and intensity interleaved), this container keeps all m/z values and
+    all intensities in two separate, cache line aligned arrays. Loops that
+    touch only one of the two dimensions (e.g. noise estimation on intensities
+    or a binary search on m/z) read only the memory they need and can be
+    vectorized by the compiler. Use getMZArray() and getIntensityArray() for
+    such loops.
+
+    For code written against MSSpectrum, element access and iteration return
+    lightweight proxies (ConstPeakRef, PeakRef) with the Peak1D accessors, so
+    templated algorithms (e.g. SignalToNoiseEstimatorMedian) can be used with
+    either container.
+
+    Only peak data and float data arrays (e.g. ion mobility) are stored. Use
+    assign() and exportTo() to convert from and to MSSpectrum, which keeps
+    the remaining spectrum meta data.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI SoASpectrum
+  {
+public:
+    ///@name Type definitions
+    //@{
+    /// Peak type (of the AoS representation)
+    typedef Peak1D PeakType;
+    /// Coordinate (m/z) type
+    typedef PeakType::CoordinateType CoordinateType;
+    /// Intensity type
+    typedef PeakType::IntensityType IntensityType;
+    /// Aligned array of m/z values
+    typedef std::vector<CoordinateType, AlignedAllocator<CoordinateType> > MZArray;
+    /// Aligned array of intensities
+    typedef std::vector<IntensityType, AlignedAllocator<IntensityType> > IntensityArray;
+    /// Float data array vector type
+    typedef DataArrays::FloatDataArray FloatDataArray;
+    typedef std::vector<FloatDataArray> FloatDataArrays;
+    //@}
+
+    /// Read-only view of a single peak
+    class ConstPeakRef
+    {
+public:
+      typedef SoASpectrum::CoordinateType CoordinateType;
+      typedef SoASpectrum::IntensityType IntensityType;
+
+      ConstPeakRef(const SoASpectrum& spectrum, Size index) :
+        spectrum_(&spectrum),
+        index_(index)
+      {
+      }
+
+      CoordinateType getMZ() const { return spectrum_->mz_[index_]; }
+      CoordinateType getPos() const { return spectrum_->mz_[index_]; }
+      IntensityType getIntensity() const { return spectrum_->intensity_[index_]; }
+
+      /// Copy of the peak
+      operator PeakType() const { return PeakType(getMZ(), getIntensity()); }
+
+protected:
+      const SoASpectrum* spectrum_;
+      Size index_;
+    };
+
+    /// Mutable view of a single peak
+    class PeakRef
+    {
+public:
+      typedef SoASpectrum::CoordinateType CoordinateType;
+      typedef SoASpectrum::IntensityType IntensityType;
+
+      PeakRef(SoASpectrum& spectrum, Size index) :
+        spectrum_(&spectrum),
+        index_(index)
+      {
+      }
+
+      /// Assigns m/z and intensity of @p peak
+      PeakRef& operator=(const PeakType& peak)
+      {
+        setMZ(peak.getMZ());
+        setIntensity(peak.getIntensity());
+        return *this;
+      }
+
+      CoordinateType getMZ() const { return spectrum_->mz_[index_]; }
+      CoordinateType getPos() const { return spectrum_->mz_[index_]; }
+      IntensityType getIntensity() const { return spectrum_->intensity_[index_]; }
+      void setMZ(CoordinateType mz) { spectrum_->mz_[index_] = mz; }
+      void setPos(CoordinateType mz) { spectrum_->mz_[index_] = mz; }
+      void setIntensity(IntensityType intensity) { spectrum_->intensity_[index_] = intensity; }
+
+      /// Copy of the peak
+      operator PeakType() const { return PeakType(getMZ(), getIntensity()); }
+
+      operator ConstPeakRef() const { return ConstPeakRef(*spectrum_, index_); }
+
+protected:
+      SoASpectrum* spectrum_;
+      Size index_;
+    };
+
+    /**
+      @brief Random access iterator over the peaks (read-only)
+
+      Dereferencing yields a ConstPeakRef; the value_type is PeakType.
+    */
+    class ConstIterator
+    {
+public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef PeakType value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef ConstPeakRef reference;
+
+      /// Proxy for operator->
+      struct pointer
+      {
+        ConstPeakRef ref;
+        const ConstPeakRef* operator->() const { return &ref; }
+      };
+
+      ConstIterator() = default;
+
+      ConstIterator(const SoASpectrum* spectrum, Size index) :
+        spectrum_(spectrum),
+        index_(index)
+      {
+      }
+
+      reference operator*() const { return ConstPeakRef(*spectrum_, index_); }
+      pointer operator->() const { return pointer{ConstPeakRef(*spectrum_, index_)}; }
+      reference operator[](difference_type n) const { return ConstPeakRef(*spectrum_, index_ + n); }
+
+      /// Index of the peak the iterator points to
+      Size getIndex() const { return index_; }
+
+      ConstIterator& operator++() { ++index_; return *this; }
+      ConstIterator& operator--() { --index_; return *this; }
+      ConstIterator operator++(int) { ConstIterator tmp(*this); ++index_; return tmp; }
+      ConstIterator operator--(int) { ConstIterator tmp(*this); --index_; return tmp; }
+      ConstIterator& operator+=(difference_type n) { index_ += n; return *this; }
+      ConstIterator& operator-=(difference_type n) { index_ -= n; return *this; }
+      ConstIterator operator+(difference_type n) const { return ConstIterator(spectrum_, index_ + n); }
+      ConstIterator operator-(difference_type n) const { return ConstIterator(spectrum_, index_ - n); }
+      friend ConstIterator operator+(difference_type n, const ConstIterator& it) { return it + n; }
+      difference_type operator-(const ConstIterator& rhs) const { return difference_type(index_) - difference_type(rhs.index_); }
+
+      bool operator==(const ConstIterator& rhs) const { return index_ == rhs.index_; }
+      bool operator!=(const ConstIterator& rhs) const { return index_ != rhs.index_; }
+      bool operator<(const ConstIterator& rhs) const { return index_ < rhs.index_; }
+      bool operator>(const ConstIterator& rhs) const { return index_ > rhs.index_; }
+      bool operator<=(const ConstIterator& rhs) const { return index_ <= rhs.index_; }
+      bool operator>=(const ConstIterator& rhs) const { return index_ >= rhs.index_; }
+
+protected:
+      const SoASpectrum* spectrum_ = nullptr;
+      Size index_ = 0;
+    };
+
+    typedef ConstIterator const_iterator;
+
+    /// Default constructor
+    SoASpectrum() = default;
+
+    /// Conversion from MSSpectrum (copies peaks and float data arrays)
+    explicit SoASpectrum(const MSSpectrum& spectrum);
+
+    /// Copy constructor
+    SoASpectrum(const SoASpectrum&) = default;
+
+    /// Move constructor
+    SoASpectrum(SoASpectrum&&) = default;
+
+    /// Assignment operator
+    SoASpectrum& operator=(const SoASpectrum&) = default;
+
+    /// Move assignment operator
+    SoASpectrum& operator=(SoASpectrum&&) = default;
+
+    /// Equality operator (peaks and float data arrays)
+    bool operator==(const SoASpectrum& rhs) const;
+
+    /// Equality operator
+    bool operator!=(const SoASpectrum& rhs) const;
+
+    ///@name Conversion
+    //@{
+    /// Replaces peaks and float data arrays by those of @p spectrum
+    void assign(const MSSpectrum& spectrum);
+
+    /// Replaces peaks and float data arrays of @p spectrum by those of this container (other meta data of @p spectrum is kept)
+    void exportTo(MSSpectrum& spectrum) const;
+    //@}
+
+    ///@name Peak access
+    //@{
+    Size size() const { return mz_.size(); }
+    bool empty() const { return mz_.empty(); }
+    void reserve(Size n) { mz_.reserve(n); intensity_.reserve(n); }
+    void resize(Size n) { mz_.resize(n); intensity_.resize(n); }
+
+    /// Removes all peaks and float data arrays
+    void clear();
+
+    void push_back(const PeakType& peak) { push_back(peak.getMZ(), peak.getIntensity()); }
+    void push_back(CoordinateType mz, IntensityType intensity) { mz_.push_back(mz); intensity_.push_back(intensity); }
+
+    ConstPeakRef operator[](Size index) const { return ConstPeakRef(*this, index); }
+    PeakRef operator[](Size index) { return PeakRef(*this, index); }
+
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, mz_.size()); }
+
+    /// m/z values of all peaks
+    const MZArray& getMZArray() const { return mz_; }
+    /// m/z values of all peaks (resizing requires resizing the intensity array as well)
+    MZArray& getMZArray() { return mz_; }
+
+    /// intensities of all peaks
+    const IntensityArray& getIntensityArray() const { return intensity_; }
+    /// intensities of all peaks (resizing requires resizing the m/z array as well)
+    IntensityArray& getIntensityArray() { return intensity_; }
+    //@}
+
+    ///@name Float data arrays
+    //@{
+    const FloatDataArrays& getFloatDataArrays() const { return float_data_arrays_; }
+    FloatDataArrays& getFloatDataArrays() { return float_data_arrays_; }
+    void setFloatDataArrays(const FloatDataArrays& fda) { float_data_arrays_ = fda; }
+
+    /// Do we have an ion mobility float data array (see MSSpectrum::containsIMData())?
+    bool containsIMData() const;
+
+    /**
+      @brief Index and unit of the ion mobility float data array
+
+      @exception Exception::MissingInformation if there is no ion mobility array
+    */
+    std::pair<Size, DriftTimeUnit> getIMData() const;
+    //@}
+
+    ///@name Sorting
+    //@{
+    /// Checks whether the peaks are sorted by ascending m/z
+    bool isSorted() const;
+
+    /// Sorts the peaks (and all float data arrays of the same length) by ascending m/z
+    void sortByPosition();
+    //@}
+
+protected:
+    MZArray mz_;
+    IntensityArray intensity_;
+    FloatDataArrays float_data_arrays_;
+  };
+
+} // namespace OpenMS
@@ -3,10 +3,12 @@ set(directory include/OpenMS/KERNEL)
 
 ### list all header files of the directory here
 set(sources_list_h
+AreaIndex.h
 AreaIterator.h
 BaseFeature.h
 ChromatogramPeak.h
 ChromatogramTools.h
+CompactSpectrum.h
 ConsensusFeature.h
 ConversionHelper.h
 ConsensusMap.h
@@ -14,6 +16,7 @@ ConversionHelper.h
 DPeak.h
 Feature.h
 FeatureHandle.h
+FlatConsensusMap.h
 FeatureMap.h
 MassTrace.h
 MRMFeature.h
@@ -28,6 +31,7 @@ PeakIndex.h
 RangeManager.h
 RangeUtils.h
 RichPeak2D.h
+SoASpectrum.h
 StandardTypes.h
 StandardDeclarations.h
 SpectrumHelper.h
@@ -43,6 +43,8 @@
 #include <OpenMS/MATH/MISC/RANSACModelLinear.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
+#include <algorithm>
+#include <exception>
 #include <limits>       // std::numeric_limits
 #include <vector>       // std::vector
 #include <sstream>      // stringstream
@@ -170,80 +172,148 @@ public:
                                         String("RANSAC: Number of total data points (") + String(pairs.size()) + ") must be larger than number of initial points (n=" + String(n) + ").");
         }
 
-        TModelType model;
-
-        std::vector< std::pair<double, double> > alsoinliers, betterdata, bestdata;
-        std::vector<std::pair<double, double> > pairs_shuffled = pairs;  // mutable data. will be shuffled in every iteration
-        double besterror = std::numeric_limits<double>::max();
-        typename TModelType::ModelParameters coeff;
-    #ifdef DEBUG_RANSAC
-        std::pair<double, double > bestcoeff;
-        double betterrsq = 0;
-        double bestrsq = 0;
-    #endif
-
-        for (size_t ransac_int=0; ransac_int<k; ransac_int++)
+        // The samples ('maybeinliers') of all iterations are drawn from the seeded RNG up front (only n random numbers
+        // per iteration), the hypotheses are then evaluated in parallel. The best hypothesis is selected with a total
+        // order (see better()) and iterations are processed in blocks to allow stopping early, so the result only
+        // depends on the seed and not on the number of threads.
+        const size_t N = pairs.size();
+        const size_t block_size = 64;
+        Hypothesis_ best;
+        std::vector<size_t> perm(N);
+        for (size_t i = 0; i < N; ++i) perm[i] = i;
+
+        for (size_t block_begin = 0; block_begin < k; block_begin += block_size)
         {
           // check if the model already includes all points
-          if (bestdata.size() == pairs.size()) break;
-
-          // use portable RNG in test mode
-          shuffler_.portable_random_shuffle(pairs_shuffled.begin(), pairs_shuffled.end());
+          if (best.data.size() == N) break;
 
-          // test 'maybeinliers'
-          try
-          { // fitting might throw UnableToFit if points are 'unfortunate'
-            coeff = model.rm_fit(pairs_shuffled.begin(), pairs_shuffled.begin()+n);
-          }
-          catch (...)
+          const size_t block_end = std::min(k, block_begin + block_size);
+          std::vector<size_t> samples;
+          samples.reserve((block_end - block_begin) * n);
+          for (size_t ransac_int = block_begin; ransac_int < block_end; ++ransac_int)
           {
-            continue;
+            // partial Fisher-Yates shuffle: the first n entries are a random sample
+            for (size_t j = 0; j < n; ++j)
+            {
+              boost::uniform_int<size_t> dist(j, N - 1);
+              std::swap(perm[j], perm[dist(shuffler_.rng_)]);
+            }
+            samples.insert(samples.end(), perm.begin(), perm.begin() + n);
           }
-          // apply model to remaining data; pick inliers
-          alsoinliers = model.rm_inliers(pairs_shuffled.begin()+n, pairs_shuffled.end(), coeff, t);
-          // ... and add data
-          if (alsoinliers.size() > d 
-              || alsoinliers.size() >= (pairs_shuffled.size()-n)) // maximum number of inliers we can possibly have (i.e. remaining data)
-          {
-            betterdata.clear();
-            std::copy( pairs_shuffled.begin(), pairs_shuffled.begin()+n, back_inserter(betterdata) );
-            betterdata.insert( betterdata.end(), alsoinliers.begin(), alsoinliers.end() );
-            typename TModelType::ModelParameters bettercoeff = model.rm_fit(betterdata.begin(), betterdata.end());
-            double bettererror = model.rm_rss(betterdata.begin(), betterdata.end(), bettercoeff);
-    #ifdef DEBUG_RANSAC
-            betterrsq = model.rm_rsq(betterdata);
-    #endif
 
-            // If the current model explains more points, we assume its better (these points pass the error threshold 't', so they should be ok);
-            // If the number of points is equal, we trust rss.
-            // E.g. imagine gaining a zillion more points (which pass the threshold!) -- then rss will automatically be worse, no matter how good
-            //      these points fit, since its a simple absolute SUM() of residual error over all points.
-            if (betterdata.size() > bestdata.size() || (betterdata.size() == bestdata.size() && (bettererror < besterror)))
+          std::vector<std::exception_ptr> errors(block_end - block_begin);
+#pragma omp parallel
+          {
+            TModelType model;
+            Hypothesis_ thread_best;
+            std::vector<std::pair<double, double> > maybeinliers(n), rest;
+            rest.reserve(N - n);
+            std::vector<char> in_sample(N, false);
+
+#pragma omp for schedule(dynamic)
+            for (SignedSize b = 0; b < SignedSize(block_end - block_begin); ++b)
             {
-              besterror = bettererror;
-              bestdata = betterdata;
-    #ifdef DEBUG_RANSAC
-              bestcoeff = bettercoeff;
-              bestrsq = betterrsq;
-              std::cout << "RANSAC " << ransac_int << ": Points: " << betterdata.size() << " RSQ: " << bestrsq << " Error: " << besterror << " c0: " << bestcoeff.first << " c1: " << bestcoeff.second << std::endl;
-    #endif
+              const size_t* sample = &samples[b * n];
+              for (size_t j = 0; j < n; ++j)
+              {
+                maybeinliers[j] = pairs[sample[j]];
+                in_sample[sample[j]] = true;
+              }
+              rest.clear();
+              for (size_t i = 0; i < N; ++i)
+              {
+                if (!in_sample[i]) rest.push_back(pairs[i]);
+              }
+              for (size_t j = 0; j < n; ++j)
+              {
+                in_sample[sample[j]] = false;
+              }
+
+              // test 'maybeinliers'
+              typename TModelType::ModelParameters coeff;
+              try
+              { // fitting might throw UnableToFit if points are 'unfortunate'
+                coeff = model.rm_fit(maybeinliers.begin(), maybeinliers.end());
+              }
+              catch (...)
+              {
+                continue;
+              }
+              // apply model to remaining data; pick inliers
+              std::vector<std::pair<double, double> > alsoinliers = model.rm_inliers(rest.begin(), rest.end(), coeff, t);
+              // ... and add data
+              if (alsoinliers.size() > d
+                  || alsoinliers.size() >= (N - n)) // maximum number of inliers we can possibly have (i.e. remaining data)
+              {
+                Hypothesis_ hypothesis;
+                hypothesis.iteration = block_begin + b;
+                hypothesis.data = maybeinliers;
+                hypothesis.data.insert(hypothesis.data.end(), alsoinliers.begin(), alsoinliers.end());
+                try
+                {
+                  typename TModelType::ModelParameters bettercoeff = model.rm_fit(hypothesis.data.begin(), hypothesis.data.end());
+                  hypothesis.error = model.rm_rss(hypothesis.data.begin(), hypothesis.data.end(), bettercoeff);
+                }
+                catch (...)
+                {
+                  errors[b] = std::current_exception();
+                  continue;
+                }
+                if (hypothesis.isBetterThan(thread_best, N))
+                {
+                  thread_best = std::move(hypothesis);
+                }
+              }
+            }
+#pragma omp critical (RANSAC_best)
+            {
+              if (thread_best.isBetterThan(best, N))
+              {
+                best = std::move(thread_best);
+              }
             }
           }
+          for (const std::exception_ptr& e : errors)
+          {
+            if (e) std::rethrow_exception(e);
+          }
         }
-
     #ifdef DEBUG_RANSAC
         std::cout << "=======STARTPOINTS=======" << std::endl;
-        for (std::vector<std::pair<double, double> >::iterator it = bestdata.begin(); it != bestdata.end(); ++it)
+        for (std::vector<std::pair<double, double> >::const_iterator it = best.data.begin(); it != best.data.end(); ++it)
         {
           std::cout << it->first << "\t" << it->second << std::endl;
         }
         std::cout << "=======ENDPOINTS=======" << std::endl;
     #endif
 
-        return(bestdata);
+        return best.data;
       } // ransac()
 
     private:
+      /// result of one RANSAC iteration
+      struct Hypothesis_
+      {
+        std::vector<std::pair<double, double> > data; ///< sample and its inliers
+        double error = std::numeric_limits<double>::max(); ///< RSS of the model fitted to 'data'
+        size_t iteration = std::numeric_limits<size_t>::max();
+
+        /**
+          @brief Total order on hypotheses (independent of evaluation order)
+
+          A model which explains more data points is better; if the number of points is equal, we trust the RSS.
+          E.g. imagine gaining a zillion more points (which pass the threshold!) -- then RSS will automatically be worse, no matter how good
+          these points fit, since its a simple absolute SUM() of residual error over all points.
+          Among models explaining all @p n_points, the earliest iteration wins (the search stops there).
+        */
+        bool isBetterThan(const Hypothesis_& other, size_t n_points) const
+        {
+          if (data.size() != other.data.size()) return data.size() > other.data.size();
+          if (data.size() != n_points && error != other.error) return error < other.error;
+          return iteration < other.iteration;
+        }
+      };
+
       Math::RandomShuffler shuffler_{};
     }; // class
   
@@ -290,21 +290,41 @@ public:
         return bin_index;
       }
 
+      /**
+        @brief Adds the cumulative counts of the values in [@p begin, @p end) to @p histogram
+
+        The result is the same as calling incUntil() (if @p complement is true) or incFrom() (otherwise) for every value,
+        but the values are only binned once and accumulated in a single pass over the bins.
+
+        @exception Exception::OutOfRange is thrown if a value is out of valid range
+      */
       template< typename DataIterator >
       static void getCumulativeHistogram(DataIterator begin, DataIterator end,
                                          bool complement,
                                          bool inclusive,
                                          Histogram< ValueType, BinSizeType > & histogram)
       {
+        std::vector<ValueType> counts(histogram.bins_.size(), 0);
         for (DataIterator it = begin; it != end; ++it)
         {
-          if (complement)
+          counts[histogram.valueToBin(*it)] += 1;
+        }
+
+        ValueType running(0); // number of values in the bins already passed
+        if (complement)
+        {
+          for (Size i = counts.size(); i > 0; --i)
           {
-            histogram.incUntil(*it, inclusive);
+            histogram.bins_[i - 1] += running + (inclusive ? counts[i - 1] : ValueType(0));
+            running += counts[i - 1];
           }
-          else
+        }
+        else
+        {
+          for (Size i = 0; i < counts.size(); ++i)
           {
-            histogram.incFrom(*it, inclusive);
+            histogram.bins_[i] += running + (inclusive ? counts[i] : ValueType(0));
+            running += counts[i];
           }
         }
       }
@@ -41,6 +41,7 @@
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
 
 #include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 
 namespace OpenMS
 {
@@ -63,6 +64,9 @@ namespace OpenMS
       member. MetaInfoInterface implements a full interface to a MetaInfo
       member and is more memory efficient if no meta info gets added.
 
+      Values are kept in a flat array sorted by index. Up to four values are
+      stored inline, i.e. without an allocation beyond the MetaInfo itself.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfo
@@ -126,7 +130,12 @@ public:
     void clear();
 
 private:
-    using MapType = boost::container::flat_map<UInt, DataValue>;
+    /// Number of meta values stored without an additional allocation (most objects carry only a few)
+    static constexpr Size INLINE_VALUES = 4;
+
+    /// Sorted (by registry index) flat storage; the first INLINE_VALUES entries live inside the MetaInfo itself
+    using MapType = boost::container::flat_map<UInt, DataValue, std::less<UInt>,
+                                               boost::container::small_vector<std::pair<UInt, DataValue>, INLINE_VALUES> >;
 
     /// Static MetaInfoRegistry
     static MetaInfoRegistry registry_;
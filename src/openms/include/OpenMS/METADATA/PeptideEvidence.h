@@ -36,6 +36,7 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/InternPool.h>
 
 namespace OpenMS
 {
@@ -45,6 +46,9 @@ namespace OpenMS
 
   A peptide evidence object describes a single peptide to protein match.
 
+  Protein accessions are interned: all evidences referring to the same
+  protein share one copy of its accession.
+
   @ingroup Metadata
 */
   class OPENMS_DLLAPI PeptideEvidence
@@ -124,7 +128,7 @@ public:
     char getAAAfter() const;
 
 protected:
-    String accession_;
+    InternPool<String>::Handle accession_; ///< interned protein accession
 
     Int start_;
 
@@ -39,6 +39,7 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/InternPool.h>
 #include <OpenMS/METADATA/MetaInfoInterface.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
 #include <OpenMS/METADATA/PeptideEvidence.h>
@@ -171,6 +172,12 @@ public:
     };
     //@}
 
+    /// Hash of a (modified) sequence, consistent with AASequence::operator==
+    struct OPENMS_DLLAPI SequenceHash
+    {
+      std::size_t operator()(const AASequence& seq) const;
+    };
+
     /// Analysis Result (containing search engine / prophet results)
     class OPENMS_DLLAPI PepXMLAnalysisResult
     {
@@ -287,7 +294,8 @@ public:
     std::set<String> extractProteinAccessionsSet() const;
 
 protected:
-    AASequence sequence_;
+    /// the (interned) peptide sequence; hits with equal sequences share one AASequence
+    InternPool<AASequence, SequenceHash>::Handle sequence_;
 
     /// the score of the peptide hit
     double score_;
@@ -43,6 +43,7 @@
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/DATASTRUCTURES/InternPool.h>
 #include <OpenMS/METADATA/MetaInfoInterface.h>
 
 namespace OpenMS
@@ -53,6 +54,9 @@ namespace OpenMS
     It contains the fields score, score_type, rank, accession,
     sequence and coverage.
 
+    Accessions are interned, i.e. protein hits of the same protein (e.g. in
+    several runs) share one copy of the accession.
+
     @ingroup Metadata
   */
   class OPENMS_DLLAPI ProteinHit :
@@ -208,7 +212,7 @@ public:
 protected:
     double score_;       ///< the score of the protein hit
     UInt rank_;          ///< the position(rank) where the hit appeared in the hit list
-    String accession_;   ///< the protein identifier
+    InternPool<String>::Handle accession_; ///< the protein identifier (interned)
     String sequence_;    ///< the amino acid sequence of the protein hit
     double coverage_;    ///< coverage of the protein based upon the matched peptide sequences
     std::set<std::pair<Size, ResidueModification> > modifications_; ///< modified positions in a protein
@@ -39,6 +39,8 @@
 
 #include <boost/regex.hpp>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -107,6 +109,8 @@ namespace OpenMS
       ids_.clear();
       scans_.clear();
       n_spectra_ = spectra.size();
+      ids_.reserve(n_spectra_);
+      scans_.reserve(n_spectra_);
       setScanRegExp_(scan_regexp);
       for (Size i = 0; i < n_spectra_; ++i)
       {
@@ -238,8 +242,8 @@ namespace OpenMS
     std::vector<String> regexp_name_list_; ///< Named groups in vector format
 
     std::map<double, Size> rts_; ///< Mapping: RT -> spectrum index
-    std::map<String, Size> ids_; ///< Mapping: native ID -> spectrum index
-    std::map<Size, Size> scans_; ///< Mapping: scan number -> spectrum index
+    std::unordered_map<String, Size> ids_; ///< Mapping: native ID -> spectrum index
+    std::unordered_map<Size, Size> scans_; ///< Mapping: scan number -> spectrum index
 
     /**
        @brief Add a look-up entry for a spectrum
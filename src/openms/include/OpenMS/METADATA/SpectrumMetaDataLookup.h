@@ -218,6 +218,8 @@ namespace OpenMS
       // we do not call "SpectrumLookup::readSpectra" here:
       n_spectra_ = spectra.size();
       metadata_.reserve(n_spectra_);
+      ids_.reserve(n_spectra_);
+      scans_.reserve(n_spectra_);
       setScanRegExp_(scan_regexp);
       // mapping: MS level -> RT of previous spectrum of that level
       std::map<Size, double> precursor_rts;
@@ -38,7 +38,7 @@
 #include <OpenMS/DATASTRUCTURES/FlagSet.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
-#include <map>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -115,7 +115,7 @@ namespace OpenMS
       Size size() const;
 
     private:
-      std::map<String, UInt64> nativeid_to_index_; //< nativeID to index
+      std::unordered_map<String, UInt64> nativeid_to_index_; //< nativeID to index
     };
 
     using Status = FlagSet<Requires>;
@@ -41,6 +41,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <boost/random/mersenne_twister.hpp>
+#include <boost/random/seed_seq.hpp>
 
 #include <OpenMS/CHEMISTRY/AASequence.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
@@ -139,6 +140,19 @@ public:
         technical_rng_.seed(seed);
       }
 
+      /**
+        @brief Create an independent RNG for item @p index of a parallel loop
+
+        @p base_seed should be drawn once (e.g. from getTechnicalRng()) before the loop.
+        Each item then receives the same random numbers no matter which thread processes
+        it, so results are reproducible independent of the number of threads.
+      */
+      static boost::random::mt19937_64 createItemRng(UInt64 base_seed, UInt64 index)
+      {
+        boost::random::seed_seq seq{UInt32(base_seed), UInt32(base_seed >> 32), UInt32(index), UInt32(index >> 32)};
+        return boost::random::mt19937_64(seq);
+      }
+
       /// Initialize the RNGs
       void initialize(bool biological_random, bool technical_random)
       {
@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <map>
+
+namespace OpenMS
+{
+  /**
+      @brief Hierarchical wall/CPU time and memory profile of named processing stages.
+
+      Code annotates stages with a Profiler::Scope (or the OPENMS_PROFILE_SCOPE macro).
+      Scopes nest, so the recorded stages form a tree, e.g.
+
+      @code
+      {
+        OPENMS_PROFILE_SCOPE("load");
+        MzMLFile().load(in, exp);
+        Profiler::addCounter("spectra", exp.size());
+      }
+      {
+        OPENMS_PROFILE_SCOPE("pick");
+        pp.pickExperiment(exp, out);
+      }
+      @endcode
+
+      For each stage, the number of calls, wall time and CPU time (StopWatch), the change in
+      memory consumption and the process' peak memory consumption at the end of the stage
+      (SysInfo, in KB) are accumulated, together with any user defined counters.
+      Repeated scopes with the same name under the same parent are merged into one node.
+      Opening and closing a stage queries the memory consumption of the process, so stages should
+      be coarse (e.g. "load", "pick", "store"), not per spectrum or feature.
+
+      Profiling is disabled by default and then costs only a check of a global flag per scope.
+      TOPP tools enable it with the @p -profile option (see TOPPBase), which stores the profile as JSON.
+
+      @note Only the thread which enabled the profiler records stages outside of OpenMP parallel regions.
+            Scopes inside parallel regions (or in other threads) are ignored; their time is accounted to the
+            enclosing scope.
+
+      @ingroup System
+  */
+  class OPENMS_DLLAPI Profiler
+  {
+public:
+    /// Records the enclosing block as a (child) stage of the currently open stage while in scope
+    class OPENMS_DLLAPI Scope
+    {
+public:
+      /// Opens the stage @p name (no-op if profiling is disabled)
+      explicit Scope(const String& name);
+      /// Closes the stage
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+private:
+      /// recording session this scope was opened in (0 if it does not record)
+      Size session_;
+    };
+
+    /// Enables/disables recording. Enabling clears previously recorded data.
+    static void setEnabled(bool enabled);
+
+    /// Is recording enabled?
+    static bool isEnabled();
+
+    /// Adds @p value to the counter @p name of the currently open stage (no-op if profiling is disabled or no stage is open)
+    static void addCounter(const String& name, Int64 value);
+
+    /// Discards all recorded data
+    static void clear();
+
+    /**
+      @brief The recorded stages as JSON
+
+      Each stage is an object with the members "name", "calls", "wall_time_s", "cpu_time_s",
+      "memory_delta_kb", "peak_memory_kb", "counters" (object) and "children" (array of stages).
+      Returns an array of the top-level stages.
+    */
+    static String toJSON();
+
+    /**
+      @brief Stores the recorded stages in @p filename
+
+      The file contains a JSON object with the members @p info (e.g. tool name and version, if not empty)
+      and "stages" (see toJSON()).
+
+      @exception Exception::UnableToCreateFile if the file cannot be written
+    */
+    static void storeJSON(const String& filename, const std::map<String, String>& info = std::map<String, String>());
+
+private:
+    Profiler() = delete;
+  };
+
+} // namespace OpenMS
+
+#define OPENMS_PROFILE_CONCAT_IMPL_(a, b) a##b
+#define OPENMS_PROFILE_CONCAT_(a, b) OPENMS_PROFILE_CONCAT_IMPL_(a, b)
+
+/// Records the rest of the enclosing block as the profiling stage @p name (see OpenMS::Profiler)
+#define OPENMS_PROFILE_SCOPE(name) \
+  const OpenMS::Profiler::Scope OPENMS_PROFILE_CONCAT_(openms_profile_scope_, __LINE__)(name)
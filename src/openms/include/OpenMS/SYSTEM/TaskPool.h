@@ -0,0 +1,179 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Work-stealing pool of worker threads for task parallelism outside of OpenMP
+
+    OpenMS uses OpenMP for data parallel loops. Code which runs independent tasks
+    concurrently instead (e.g. decoding data in the background while parsing) should
+    submit them to the global pool (getInstance()) rather than starting own threads
+    via std::async or std::thread, so that the total number of busy threads stays
+    within the thread budget of the process (see setThreadBudget()).
+
+    Each worker owns a task queue; submitted tasks are distributed round-robin and
+    idle workers steal from the queues of busy ones.
+
+    Oversubscription is avoided by:
+      - a pool of <tt>budget - 1</tt> workers: the submitting thread usually keeps working
+        (with a budget of 1 there are no workers and submit() runs tasks synchronously)
+      - running tasks submitted from inside a task synchronously in the worker (no nested
+        parallelism in the pool, which also prevents deadlocks when a task waits for a sub-task)
+      - limiting OpenMP in the workers to one thread, i.e. OpenMP loops called from a task run sequentially
+
+    @code
+    std::future<double> f = TaskPool::getInstance().submit([&]() { return compute(data); });
+    // ... do other work ...
+    double result = f.get(); // rethrows exceptions of the task
+    @endcode
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI TaskPool
+  {
+public:
+    /// Creates a pool with @p num_workers worker threads (0: run all tasks synchronously in submit())
+    explicit TaskPool(Size num_workers);
+
+    /// Runs all queued tasks and joins the workers
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+      @brief The process wide pool
+
+      Created on first use with <tt>getThreadBudget() - 1</tt> workers.
+    */
+    static TaskPool& getInstance();
+
+    /**
+      @brief Sets the number of threads the process may keep busy (e.g. from the -threads option of TOPP tools)
+
+      Sets the number of OpenMP threads to @p num_threads, disables nested OpenMP
+      parallelism and resizes the global pool to <tt>num_threads - 1</tt> workers.
+      Must not be called while tasks are submitted to the global pool.
+    */
+    static void setThreadBudget(Size num_threads);
+
+    /// The thread budget (default: the number of OpenMP threads, or the number of cores if OpenMP is disabled)
+    static Size getThreadBudget();
+
+    /// Number of worker threads
+    Size getNumberOfWorkers() const;
+
+    /**
+      @brief Runs @p function (callable without arguments) in a worker thread
+
+      The task is run synchronously (before submit() returns) if the pool has no
+      workers or if submit() is called from a worker thread of this pool.
+
+      @return A future for the result of @p function, which also rethrows its exceptions
+    */
+    template <typename Function>
+    std::future<std::invoke_result_t<Function>> submit(Function function)
+    {
+      typedef std::invoke_result_t<Function> Result;
+      // std::function requires copyable callables, but packaged_task is move-only
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+      std::future<Result> result = task->get_future();
+      if (queues_.empty() || isWorkerThread_())
+      {
+        (*task)();
+      }
+      else
+      {
+        enqueue_([task]() { (*task)(); });
+      }
+      return result;
+    }
+
+protected:
+    typedef std::function<void()> Task;
+
+    /// task queue of a worker
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    /// is the calling thread a worker of this pool?
+    bool isWorkerThread_() const;
+
+    /// puts @p task into the queue of the next worker (round-robin) and wakes up a worker
+    void enqueue_(Task task);
+
+    /// takes a task from the queue of worker @p index, or steals one from another worker
+    bool popTask_(Size index, Task& task);
+
+    /// worker thread: run tasks until stop_ is set and no task is pending
+    void run_(Size index);
+
+    /// starts @p num_workers workers
+    void start_(Size num_workers);
+
+    /// runs all pending tasks and joins the workers
+    void stop_();
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<Size> next_queue_{0};
+
+    /// wake-up of idle workers (pending_ and stopping_ are protected by wake_mutex_)
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    Size pending_ = 0;
+    bool stopping_ = false;
+  };
+
+} // namespace OpenMS
@@ -25,10 +25,12 @@ File.h
 FileWatcher.h
 JavaInfo.h
 NetworkGetRequest.h
+Profiler.h
 PythonInfo.h
 RWrapper.h
 StopWatch.h
 SysInfo.h
+TaskPool.h
 UpdateCheck.h
 )
 
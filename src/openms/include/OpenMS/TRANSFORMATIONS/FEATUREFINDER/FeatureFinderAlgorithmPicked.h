@@ -125,6 +125,7 @@ protected:
     double min_rt_span_; ///< Minimum RT range that has to be left after the fit
     double max_rt_span_; ///< Maximum RT range the model is allowed to span
     double max_feature_intersection_; ///< Maximum allowed feature intersection (if larger, that one of the feature is removed)
+    bool bounding_box_hulls_; ///< Report only the bounding boxes of the mass trace hulls
     String reported_mz_; ///< The mass type that is reported for features. 'maximum' returns the m/z value of the highest mass trace. 'average' returns the intensity-weighted average m/z value of all contained peaks. 'monoisotopic' returns the monoisotopic m/z value derived from the fitted isotope model.
     //@}
 
@@ -263,6 +263,10 @@ protected:
   /// @param clear_IDs set to false to keep IDs in internal charge maps (only needed for debugging purposes)
   void createAssayLibrary_(const PeptideMap::iterator& begin, const PeptideMap::iterator& end, PeptideRefRTMap& ref_rt_map, bool clear_IDs = true);
 
+  /// extracts chromatograms for the assays in @p library and detects/scores features in them (one batch)
+  /// only reads shared state, so that several batches can be processed in parallel
+  void extractAndScoreBatch_(const TargetedExperiment& library, OpenSwath::SpectrumAccessPtr ms_data, FeatureMap& features) const;
+
   /// CAUTION: This method stores a pointer to the given @p peptide reference in internals
   /// Make sure it stays valid until destruction of the class.
   /// @todo find better solution
@@ -568,10 +568,12 @@ protected:
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
     UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
 
+    // every position of the transform is computed independently
+#pragma omp parallel for schedule(static)
     for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
     {
+      double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
       value = 0; T_boundary_left = 0; T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
       old = 0; old_pos = (my_local_pos - from_max_to_left_ - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left_ - 1].getMZ() : c_ref[0].getMZ() - min_spacing_;
       my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
@@ -611,10 +613,12 @@ protected:
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
     UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, c_diff, current, my_local_MZ, my_local_lambda, origin, c_mz;
 
+    // every position of the transform is computed independently
+#pragma omp parallel for schedule(static)
     for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
     {
+      double value, T_boundary_left, T_boundary_right, c_diff, current, my_local_MZ, my_local_lambda, origin, c_mz;
       value = 0; T_boundary_left = 0; T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
 
 
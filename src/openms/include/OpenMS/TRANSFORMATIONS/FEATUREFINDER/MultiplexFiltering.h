@@ -41,6 +41,7 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexIsotopicPeakPattern.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteredPeak.h>
+#include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteredMSExperiment.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
 #include <vector>
@@ -83,9 +84,10 @@ public:
      * which blacklisted peaks are removed is called 'white'. White spectra
      * contain fewer peaks than their corresponding primary spectra. Consequently,
      * their indices are shifted. The type maps a peak index in a 'white'
-     * spectrum back to its original spectrum.
+     * spectrum back to its original spectrum. Since the white indices are
+     * contiguous, a plain vector per spectrum serves as lookup table.
      */
-    typedef std::vector<std::map<int, int> > White2Original;
+    typedef std::vector<std::vector<int> > White2Original;
 
     /**
      * @brief constructor
@@ -174,6 +176,20 @@ protected:
      * @param pattern_idx    index of the pattern in @em patterns_
      */
     void blacklistPeak_(const MultiplexFilteredPeak& peak, unsigned pattern_idx);
+
+    /**
+     * @brief add the peaks which passed all filters to the result and blacklist them
+     * 
+     * The spectra of the white experiment are filtered in parallel, each collecting
+     * its candidate peaks separately. The candidates are then merged in spectrum order.
+     * Peaks which an earlier candidate of the same pattern has blacklisted in the
+     * meantime (i.e. claimed as one of its satellites) are skipped.
+     * 
+     * @param peaks_per_spectrum    candidate peaks for each spectrum of the white experiment
+     * @param pattern_idx    index of the pattern in @em patterns_
+     * @param result    filter result for this pattern
+     */
+    void addFilteredPeaks_(const std::vector<std::vector<MultiplexFilteredPeak> >& peaks_per_spectrum, unsigned pattern_idx, MultiplexFilteredMSExperiment& result);
     
     /**
      * @brief check if the satellite peaks conform with the averagine model
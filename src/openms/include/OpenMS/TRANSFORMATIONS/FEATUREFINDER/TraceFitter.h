@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderAlgorithmPickedHelperStructs.h>
+#include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/KERNEL/Peak1D.h>
 
@@ -170,13 +171,65 @@ protected:
      */
     virtual String getGnuplotFormula(const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace, const char function_name, const double baseline, const double rt_shift) = 0;
 
+    /**
+     * @brief Fits the model of @p prototype to many sets of mass traces in parallel
+     *
+     * Every thread works on its own copy of @p prototype, which reuses its data arrays for all of its fits.
+     * After fitting @p traces[i], @p callback(i, fitter, success) is called with the fitted model; @p success is
+     * false if the fit failed (Exception::UnableToFit). The callback is called concurrently for different i,
+     * and the fitted model is only valid during the call.
+     */
+    template <typename FitterType, typename CallbackType>
+    static void fitBatch(const FitterType& prototype, std::vector<FeatureFinderAlgorithmPickedHelperStructs::MassTraces>& traces, CallbackType callback)
+    {
+#pragma omp parallel
+      {
+        FitterType fitter(prototype);
+#pragma omp for schedule(dynamic)
+        for (SignedSize i = 0; i < (SignedSize)traces.size(); ++i)
+        {
+          bool success = true;
+          try
+          {
+            fitter.fit(traces[i]);
+          }
+          catch (Exception::UnableToFit&)
+          {
+            success = false;
+          }
+          callback(Size(i), static_cast<const FitterType&>(fitter), success);
+        }
+      }
+    }
+
 protected:
     struct ModelData
     {
       FeatureFinderAlgorithmPickedHelperStructs::MassTraces* traces_ptr;
       bool weighted;
+
+      /// @name Data points of all traces in contiguous arrays (see setUpModelData_())
+      //@{
+      double baseline = 0.0;
+      std::vector<double> rt;
+      std::vector<double> intensity;
+      /// theoretical intensity of the trace of the data point
+      std::vector<double> theoretical_int;
+      /// weight of the residual of the data point (1 if not weighted)
+      std::vector<double> weight;
+      //@}
     };
 
+    /**
+     * Fills model_data_ with the data points of @p traces.
+     *
+     * The arrays are reused across fits, so fitting many features with one fitter does not allocate for them.
+     */
+    void setUpModelData_(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces);
+
+    /// Data of the current fit, passed to the functors (see setUpModelData_())
+    ModelData model_data_{};
+
     void updateMembers_() override;
 
     /**
@@ -150,11 +150,15 @@ public:
           processed_input[k] = getInterpolatedValue_(x, it_help);
         }
         
+        // the resampled data are equidistant, so the wavelet values for each distance to
+        // the center are the same for every position and only need to be looked up once
+        const std::vector<double> kernel = tabulateKernel_(spacing);
+
         // TODO avoid to compute the cwt for the zeros in signal
         for (Int i = 0; i < n; ++i)
         {
           signal_[i].setMZ(origin + i * spacing);
-          signal_[i].setIntensity((Peak1D::IntensityType)integrate_(processed_input, spacing, i));
+          signal_[i].setIntensity((Peak1D::IntensityType)integrate_(processed_input, kernel, spacing, i));
         }
 
         begin_right_padding_ = n;
@@ -198,26 +202,19 @@ protected:
       std::cout << "integrate from middle to start_pos " << help->getMZ() << " until " << start_pos << std::endl;
 #endif
 
+      // the wavelet value of the center (distance 0); in each step, the outer point of the
+      // previous trapezoid becomes the inner one, so its wavelet value is carried over
+      double wavelet_right = wavelet_[0];
+
       //integrate from middle to start_pos
       while ((help != first) && ((help - 1)->getMZ() > start_pos))
       {
-        // search for the corresponding data point of help in the wavelet (take the left most adjacent point)
-        double distance = fabs(x->getMZ() - help->getMZ());
-        Size index_w_r = (Size) Math::round(distance / spacing_);
-        if (index_w_r >= wavelet_.size())
-        {
-          index_w_r = wavelet_.size() - 1;
-        }
-        double wavelet_right =  wavelet_[index_w_r];
-
 #ifdef DEBUG_PEAK_PICKING
-        std::cout << "distance x help " << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_r * spacing_ << std::endl;
         std::cout << "wavelet_right "  <<  wavelet_right << std::endl;
 #endif
 
         // search for the corresponding datapoint for (help-1) in the wavelet (take the left most adjacent point)
-        distance = fabs(x->getMZ() - (help - 1)->getMZ());
+        double distance = fabs(x->getMZ() - (help - 1)->getMZ());
         Size index_w_l = (Size) Math::round(distance / spacing_);
         if (index_w_l >= wavelet_.size())
         {
@@ -237,6 +234,7 @@ protected:
 #endif
 
         v += fabs((help - 1)->getMZ() - help->getMZ()) / 2. * ((help - 1)->getIntensity() * wavelet_left + help->getIntensity() * wavelet_right);
+        wavelet_right = wavelet_left;
         --help;
       }
 
@@ -246,25 +244,15 @@ protected:
 #ifdef DEBUG_PEAK_PICKING
       std::cout << "integrate from middle to endpos " << (help)->getMZ() << " until " << end_pos << std::endl;
 #endif
+      double wavelet_left = wavelet_[0];
       while ((help != (last - 1)) && ((help + 1)->getMZ() < end_pos))
       {
-        // search for the corresponding datapoint for help in the wavelet (take the left most adjacent point)
-        double distance = fabs(x->getMZ() - help->getMZ());
-        Size index_w_l = (Size) Math::round(distance / spacing_);
-        if (index_w_l >= wavelet_.size())
-        {
-          index_w_l = wavelet_.size() - 1;
-        }
-        double wavelet_left =  wavelet_[index_w_l];
-
 #ifdef DEBUG_PEAK_PICKING
-        std::cout << " help " << (help)->getMZ() << " distance x, help" << distance << std::endl;
-        std::cout << "distance in wavelet_ " << index_w_l * spacing_ << std::endl;
         std::cout << "wavelet_ at left " <<   wavelet_left << std::endl;
 #endif
 
         // search for the corresponding datapoint for (help+1) in the wavelet (take the left most adjacent point)
-        distance = fabs(x->getMZ() - (help + 1)->getMZ());
+        double distance = fabs(x->getMZ() - (help + 1)->getMZ());
         Size index_w_r = (Size) Math::round(distance / spacing_);
         if (index_w_r >= wavelet_.size())
         {
@@ -279,6 +267,7 @@ protected:
 #endif
 
         v += fabs(help->getMZ() - (help + 1)->getMZ()) / 2. * (help->getIntensity() * wavelet_left + (help + 1)->getIntensity() * wavelet_right);
+        wavelet_left = wavelet_right;
         ++help;
       }
 
@@ -289,8 +278,15 @@ protected:
       return v / sqrt(scale_);
     }
 
-    /// Computes the convolution of the wavelet and the profile data at position x with resolution > 1
-    double integrate_(const std::vector<double> & processed_input, double spacing_data, int index);
+    /**
+      @brief Computes the convolution of the wavelet and the (equidistant) profile data at position @p index with resolution > 1
+
+      @p kernel holds the wavelet value for each distance (in data points) to @p index, see tabulateKernel_().
+    */
+    double integrate_(const std::vector<double> & processed_input, const std::vector<double> & kernel, double spacing_data, int index) const;
+
+    /// Tabulates the wavelet for equidistant data with spacing @p spacing_data (one value per data point distance to the center)
+    std::vector<double> tabulateKernel_(double spacing_data) const;
 
     /// Computes the Marr wavelet at position x
     inline double marr_(const double x) const
@@ -46,6 +46,7 @@ namespace OpenMS
 {
   class MSChromatogram;
   class OnDiscMSExperiment;
+  class SoASpectrum;
 
   /**
     @brief This class implements a fast peak-picking algorithm best suited for
@@ -137,6 +138,24 @@ public:
      */
     void pick(const MSChromatogram& input, MSChromatogram& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = false) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a single spectrum in
+      structure-of-arrays layout (SoASpectrum). The resulting picked peaks
+      (and FWHM / ion mobility float data arrays, if applicable) replace the
+      content of the output spectrum.
+
+      Yields the same peaks as the MSSpectrum overload.
+
+      @param input  input spectrum in profile mode
+      @param output  output spectrum with picked peaks
+      @param boundaries  boundaries of the picked peaks
+      @param check_spacings  check spacing constraints?
+     */
+    void pick(const SoASpectrum& input, SoASpectrum& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = true) const;
+
+    /// Applies the peak-picking algorithm to a single spectrum in structure-of-arrays layout (SoASpectrum)
+    void pick(const SoASpectrum& input, SoASpectrum& output) const;
+
     /**
       @brief Applies the peak-picking algorithm to a map (MSExperiment). This
       method picks peaks for each scan in the map consecutively. The resulting
@@ -158,6 +177,10 @@ public:
       @param boundaries_spec  boundaries of the picked peaks in spectra
       @param boundaries_chrom  boundaries of the picked peaks in chromatograms
       @param check_spectrum_type  if set, checks spectrum type and throws an exception if a centroided spectrum is passed 
+
+      Spectra and chromatograms are picked in parallel (if OpenMP is enabled).
+      Output order and boundaries are identical to a sequential run; if a spectrum
+      fails, the exception of the first failing spectrum is rethrown.
      */
     void pickExperiment(const PeakMap& input,
                         PeakMap& output,
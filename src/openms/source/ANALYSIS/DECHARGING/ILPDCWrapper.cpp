@@ -55,7 +55,7 @@ namespace OpenMS
   {
   }
 
-  double ILPDCWrapper::compute(const FeatureMap fm, PairsType& pairs, Size verbose_level) const
+  double ILPDCWrapper::compute(const FeatureMap& fm, PairsType& pairs, Size verbose_level) const
   {
     if (fm.empty())
     {
@@ -199,12 +199,13 @@ namespace OpenMS
     // split problem into slices and have each one solved by the ILPS
     double score = 0;
 // OMP currently causes spurious segfaults in Release mode; OMP fix applied, however: disable if problem persists
+// (the GLPK backend of LPWrapper is not guaranteed to be thread-safe, so slices are solved one after another)
 //#ifdef _OPENMP
 //#pragma omp parallel for schedule(dynamic, 1), reduction(+: score)
 //#endif
     for (SignedSize i = 0; i < static_cast<SignedSize>(bins.size()); ++i)
     {
-      score = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+      score += computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
     }
     time1.stop();
     OPENMS_LOG_INFO << " Branch and cut took " << time1.getClockTime() << " seconds, "
@@ -219,7 +220,7 @@ namespace OpenMS
     f_set[rota_l].insert(v);
   }
 
-  double ILPDCWrapper::computeSlice_(const FeatureMap fm,
+  double ILPDCWrapper::computeSlice_(const FeatureMap& fm,
                                      PairsType& pairs,
                                      const PairsIndex margin_left,
                                      const PairsIndex margin_right,
@@ -320,7 +321,7 @@ namespace OpenMS
 
   // old version, slower, as ILP has different layout (i.e, the same as described in paper)
 
-  double ILPDCWrapper::computeSliceOld_(const FeatureMap fm,
+  double ILPDCWrapper::computeSliceOld_(const FeatureMap& fm,
                                         PairsType& pairs,
                                         const PairsIndex margin_left,
                                         const PairsIndex margin_right,
@@ -137,15 +137,14 @@ namespace OpenMS
       }
     }
 
-    decomp_param.setValue("tolerance", (double)param_.getValue("precursor_mass_tolerance"));
-    decomp_algo.setParameters(decomp_param);
     // now the upper part with different tolerance
+    double precursor_mass_tolerance((double)param_.getValue("precursor_mass_tolerance"));
     for (std::map<double, IonScore>::iterator it = ion_scores.begin(); it != ion_scores.end(); ++it)
     {
       if (it->first < precursor_weight && precursor_weight - it->first < max_decomp_weight)
       {
         vector<MassDecomposition> decomps;
-        decomp_algo.getDecompositions(decomps, precursor_weight - it->first);
+        decomp_algo.getDecompositions(decomps, precursor_weight - it->first, precursor_mass_tolerance);
 #ifdef ION_SCORING_DEBUG
         cerr << "Decomps: " << it->first << " " << precursor_weight - it->first << " " << decomps.size() << " " << it->second.score << endl;
 #endif
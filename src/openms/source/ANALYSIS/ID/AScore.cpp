@@ -504,6 +504,9 @@ namespace OpenMS
     TheoreticalSpectrumGenerator spectrum_generator;
     
     th_spectra.resize(permutations.size());
+    // all permutations phosphorylate the same few positions: resolve each modified residue once
+    // instead of looking it up by name (a locked ResidueDB query) for every permutation
+    vector<const Residue*> phospho_residues(seq_without_phospho.size(), nullptr);
     for (Size i = 0; i < permutations.size(); ++i)
     {
       AASequence seq(seq_without_phospho);
@@ -513,7 +516,15 @@ namespace OpenMS
       {
         if (as == permutations[i][permu])
         {
-          seq.setModification(as, "Phospho");
+          if (phospho_residues[as] == nullptr)
+          {
+            seq.setModification(as, "Phospho");
+            phospho_residues[as] = &seq[as];
+          }
+          else
+          {
+            seq.setModification(as, phospho_residues[as]);
+          }
           ++permu;
         }
         
@@ -35,7 +35,7 @@
 #include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 #include <OpenMS/CHEMISTRY/AdductInfo.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
-#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternCache.h>
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/FORMAT/TextFile.h>
@@ -45,6 +45,7 @@
 #include <OpenMS/METADATA/ID/IdentificationDataConverter.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
 #include <numeric>
 
 namespace OpenMS
@@ -433,7 +434,8 @@ namespace OpenMS
       for (Size i = hit_idx.first; i < hit_idx.second; ++i)
       {
         // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        const MappingEntry_& entry = mass_mappings_[i];
+        if (!(entry.formula_parsed ? it->isCompatible(entry.parsed_formula) : it->isCompatible(EmpiricalFormula(entry.formula))))
         {
           // only written if TOPP tool has --debug
           OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
@@ -663,9 +665,10 @@ namespace OpenMS
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
+    QueryResultsTable all_query_results = extractQueryResults_(fmap, ion_mode_internal, dummy_count);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results = extractQueryResults_(fmap[i], i, ion_mode_internal, dummy_count);
+      const std::vector<AccurateMassSearchResult>& query_results = all_query_results[i];
       if (query_results.empty())
       {
         continue;
@@ -728,9 +731,10 @@ namespace OpenMS
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
+    QueryResultsTable all_query_results = extractQueryResults_(fmap, ion_mode_internal, dummy_count);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results = extractQueryResults_(fmap[i], i, ion_mode_internal, dummy_count);
+      const std::vector<AccurateMassSearchResult>& query_results = all_query_results[i];
       if (query_results.empty())
       {
         continue;
@@ -906,13 +910,28 @@ namespace OpenMS
     }
 
     // map for storing overall results
-    QueryResultsTable overall_results;
+    // queries are independent: run them in parallel, annotate serially in input order
+    QueryResultsTable overall_results(cmap.size());
+    std::vector<std::exception_ptr> errors(cmap.size());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)cmap.size(); ++i)
+    {
+      try
+      {
+        queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, overall_results[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const std::exception_ptr& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
     for (Size i = 0; i < cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      annotate_(overall_results[i], cmap[i]);
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
@@ -1366,9 +1385,17 @@ namespace OpenMS
           else if (word_count == 1)
           {
             entry.formula = *istr_it;
+            try
+            {
+              entry.parsed_formula = EmpiricalFormula(entry.formula);
+              entry.formula_parsed = true;
+            }
+            catch (Exception::BaseException&)
+            { // keep going; the formula is only needed (and the error raised) if the entry is ever hit
+            }
             if (entry.mass == 0)
             { // recompute mass from formula
-              entry.mass = EmpiricalFormula(entry.formula).getMonoWeight();
+              entry.mass = entry.formula_parsed ? entry.parsed_formula.getMonoWeight() : EmpiricalFormula(entry.formula).getMonoWeight();
               //std::cerr << "mass of " << entry.formula << " is " << entry.mass << "\n";
             }
           }
@@ -1520,7 +1547,7 @@ namespace OpenMS
     Size common_size = std::min(num_traces, MAX_THEORET_ISOS);
 
     // compute theoretical isotope distribution
-    IsotopeDistribution iso_dist(form.getIsotopeDistribution(CoarseIsotopePatternGenerator((UInt)common_size)));
+    IsotopeDistribution iso_dist(IsotopePatternCache::getInstance()->run(form, common_size));
     std::vector<double> theoretical_iso_dist;
     std::transform(
       iso_dist.begin(),
@@ -1541,6 +1568,32 @@ namespace OpenMS
     return computeCosineSim_(theoretical_iso_dist, observed_iso_dist);
   }
 
+  AccurateMassSearchEngine::QueryResultsTable AccurateMassSearchEngine::extractQueryResults_(const FeatureMap& fmap, const String& ion_mode_internal, Size& dummy_count) const
+  {
+    // queries are independent: run them in parallel into per-feature slots
+    QueryResultsTable results(fmap.size());
+    std::vector<Size> dummies(fmap.size(), 0);
+    std::vector<std::exception_ptr> errors(fmap.size());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
+    {
+      try
+      {
+        results[i] = extractQueryResults_(fmap[i], i, ion_mode_internal, dummies[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const std::exception_ptr& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
+    dummy_count += std::accumulate(dummies.begin(), dummies.end(), Size(0));
+    return results;
+  }
+
   std::vector<AccurateMassSearchResult> AccurateMassSearchEngine::extractQueryResults_(const Feature& feature, const Size& feature_index, const String& ion_mode_internal, Size& dummy_count) const
   {
     std::vector<AccurateMassSearchResult> query_results;
@@ -1568,8 +1621,11 @@ namespace OpenMS
         // it is impossible to decide here which one is best
         for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
         {
-          String emp_formula(query_results[hit_idx].getFormulaString());
-          double iso_sim(computeIsotopePatternSimilarity_(feature, EmpiricalFormula(emp_formula)));
+          // the DB entry already holds the parsed formula; isotope patterns are cached by IsotopePatternCache
+          const MappingEntry_& entry = mass_mappings_[query_results[hit_idx].getMatchingIndex()];
+          double iso_sim(entry.formula_parsed ?
+                         computeIsotopePatternSimilarity_(feature, entry.parsed_formula) :
+                         computeIsotopePatternSimilarity_(feature, EmpiricalFormula(query_results[hit_idx].getFormulaString())));
           query_results[hit_idx].setIsotopesSimScore(iso_sim);
         }
       }
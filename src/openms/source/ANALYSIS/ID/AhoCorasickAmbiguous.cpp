@@ -37,7 +37,11 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <queue>
 
 namespace OpenMS
@@ -189,6 +193,128 @@ namespace OpenMS
     umap_index2children_naive_.clear(); // not needed anymore
   }
 
+  namespace
+  {
+    const char TRIE_MAGIC[8] = {'O', 'M', 'S', 'A', 'C', 'T', 'R', 'I'};
+    const uint32_t TRIE_FORMAT_VERSION = 1;
+    const uint32_t TRIE_BYTE_ORDER_MARK = 0x01020304;
+
+    template<typename T>
+    void writeValue(std::ostream& os, const T value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::istream& is, T& value)
+    {
+      return bool(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+  }
+
+  void ACTrie::store(std::ostream& os) const
+  {
+    if (!umap_index2children_naive_.empty())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The trie must be compressed before it can be stored. Call compressTrie() first.");
+    }
+
+    os.write(TRIE_MAGIC, sizeof(TRIE_MAGIC));
+    writeValue(os, TRIE_BYTE_ORDER_MARK);
+    writeValue(os, TRIE_FORMAT_VERSION);
+    writeValue(os, needle_count_);
+    writeValue(os, max_aaa_);
+    writeValue(os, max_mm_);
+
+    // nodes (field by field, to be independent of padding)
+    writeValue(os, uint64_t(trie_.size()));
+    for (const ACNode& node : trie_)
+    {
+      writeValue(os, node.suffix());
+      writeValue(os, node.first_child());
+      writeValue(os, node.edge());
+      writeValue(os, node.nr_children);
+      writeValue(os, uint8_t(node.depth_and_hits.has_hit));
+      writeValue(os, uint8_t(node.depth_and_hits.depth));
+    }
+
+    // needles ending in each node (sorted by node, so the output is reproducible)
+    std::vector<Index::T> nodes;
+    nodes.reserve(umap_index2needles_.size());
+    for (const auto& entry : umap_index2needles_) { nodes.push_back(entry.first()); }
+    std::sort(nodes.begin(), nodes.end());
+    writeValue(os, uint64_t(nodes.size()));
+    for (const Index::T node : nodes)
+    {
+      const std::vector<uint32_t>& needles = umap_index2needles_.at(node);
+      writeValue(os, node);
+      writeValue(os, uint64_t(needles.size()));
+      os.write(reinterpret_cast<const char*>(needles.data()), needles.size() * sizeof(uint32_t));
+    }
+  }
+
+  bool ACTrie::load(std::istream& is)
+  {
+    static_assert(sizeof(AA) == 1, "AA must be a single byte");
+
+    char magic[sizeof(TRIE_MAGIC)];
+    uint32_t bom(0), version(0), needle_count(0), max_aaa(0), max_mm(0);
+    if (!is.read(magic, sizeof(magic)) || memcmp(magic, TRIE_MAGIC, sizeof(TRIE_MAGIC)) != 0
+      || !readValue(is, bom) || bom != TRIE_BYTE_ORDER_MARK
+      || !readValue(is, version) || version != TRIE_FORMAT_VERSION
+      || !readValue(is, needle_count) || !readValue(is, max_aaa) || !readValue(is, max_mm))
+    {
+      return false;
+    }
+
+    uint64_t node_count(0);
+    if (!readValue(is, node_count) || node_count == 0) { return false; }
+    std::vector<ACNode> trie;
+    trie.reserve(std::min(node_count, uint64_t(1) << 20)); // do not trust the header blindly
+    for (uint64_t i = 0; i < node_count; ++i)
+    {
+      Index::T suffix, first_child;
+      uint8_t edge, nr_children, has_hit, depth;
+      if (!readValue(is, suffix) || !readValue(is, first_child) || !readValue(is, edge)
+        || !readValue(is, nr_children) || !readValue(is, has_hit) || !readValue(is, depth))
+      {
+        return false;
+      }
+      if (suffix >= node_count) { return false; } // corrupt
+      ACNode node;
+      node.suffix = suffix;
+      node.first_child = first_child;
+      memcpy(&node.edge, &edge, sizeof(edge)); // AA has no public C'tor from its internal representation
+      node.nr_children = nr_children;
+      node.depth_and_hits.has_hit = has_hit;
+      node.depth_and_hits.depth = depth;
+      trie.push_back(node);
+    }
+
+    uint64_t entry_count(0);
+    if (!readValue(is, entry_count)) { return false; }
+    decltype(umap_index2needles_) index2needles;
+    if (entry_count > node_count) { return false; }
+    index2needles.reserve(entry_count);
+    for (uint64_t i = 0; i < entry_count; ++i)
+    {
+      Index::T node;
+      uint64_t size;
+      if (!readValue(is, node) || !readValue(is, size) || node >= node_count || size > needle_count) { return false; }
+      std::vector<uint32_t> needles(size);
+      if (!is.read(reinterpret_cast<char*>(needles.data()), size * sizeof(uint32_t))) { return false; }
+      index2needles[node] = std::move(needles);
+    }
+
+    trie_ = std::move(trie);
+    umap_index2needles_ = std::move(index2needles);
+    umap_index2children_naive_.clear();
+    needle_count_ = needle_count;
+    max_aaa_ = max_aaa;
+    max_mm_ = max_mm;
+    return true;
+  }
+
   size_t ACTrie::getNeedleCount() const
   {
     return needle_count_;
@@ -72,6 +72,17 @@ namespace OpenMS
     }
     // new parameters may affect the similarity calculation, so clear cache:
     similarities_.clear();
+    self_alignment_scores_.clear();
+    unmodified_similarities_.clear();
+  }
+
+  double ConsensusIDAlgorithmPEPMatrix::getSelfAlignmentScore_(const String& seq)
+  {
+    auto pos = self_alignment_scores_.find(seq);
+    if (pos != self_alignment_scores_.end()) return pos->second;
+    const double score = alignment_.align(seq, seq);
+    self_alignment_scores_.emplace(seq, score);
+    return score;
   }
 
   double ConsensusIDAlgorithmPEPMatrix::getSimilarity_(AASequence seq1,
@@ -82,6 +93,10 @@ namespace OpenMS
     String unmod_seq2 = seq2.toUnmodifiedString();
     if (unmod_seq1 == unmod_seq2) return 1.0;
 
+    // the same pairs come up for every hit of every ID run, so cache the results:
+    auto pos = unmodified_similarities_.find(make_pair(unmod_seq1, unmod_seq2));
+    if (pos != unmodified_similarities_.end()) return pos->second;
+
     double score_sim = alignment_.align(unmod_seq1, unmod_seq2);
 
     if (score_sim < 0)
@@ -90,10 +105,11 @@ namespace OpenMS
     }
     else
     {
-      double score_self1 = alignment_.align(unmod_seq1, unmod_seq1);
-      double score_self2 = alignment_.align(unmod_seq2, unmod_seq2);
+      double score_self1 = getSelfAlignmentScore_(unmod_seq1);
+      double score_self2 = getSelfAlignmentScore_(unmod_seq2);
       score_sim /= min(score_self1, score_self2); // normalize
     }
+    unmodified_similarities_[make_pair(std::move(unmod_seq1), std::move(unmod_seq2))] = score_sim;
     return score_sim;
   }
 
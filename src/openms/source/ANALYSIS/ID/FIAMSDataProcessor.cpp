@@ -37,9 +37,56 @@
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedianRapid.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
+#include <exception>
+#include <map>
+#include <memory>
 
 namespace OpenMS {
 
+  namespace
+  {
+    /**
+      @brief Returns an initialised AccurateMassSearchEngine for @p ams_param
+
+      Loading the databases is expensive, so engines are cached (for the lifetime of the process) and shared by all
+      FIAMSDataProcessor instances and threads with identical search settings. AccurateMassSearchEngine::run() is const.
+    */
+    std::shared_ptr<const AccurateMassSearchEngine> getAccurateMassSearchEngine(const Param& ams_param)
+    {
+      static std::map<String, std::shared_ptr<const AccurateMassSearchEngine>> cache;
+
+      String key;
+      for (const char* name : {"ionization_mode", "mass_error_value", "db:mapping", "db:struct", "positive_adducts", "negative_adducts", "keep_unidentified_masses"})
+      {
+        key += String(name) + "=" + String(ams_param.getValue(name).toString()) + "\n";
+      }
+
+      std::shared_ptr<const AccurateMassSearchEngine> ams;
+      std::exception_ptr error;
+#pragma omp critical (FIAMSDataProcessor_ams_cache)
+      {
+        try
+        {
+          auto& cached = cache[key];
+          if (!cached)
+          {
+            auto engine = std::make_shared<AccurateMassSearchEngine>();
+            engine->setParameters(ams_param);
+            engine->init();
+            cached = std::move(engine);
+          }
+          ams = cached;
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+      return ams;
+    }
+  }
+
   FIAMSDataProcessor::FIAMSDataProcessor() :
       DefaultParamHandler("FIAMSDataProcessor"),
       mzs_(),
@@ -113,15 +160,31 @@ namespace OpenMS {
     const std::vector<MSSpectrum> & input
     ) {
       MSSpectrum output;
-      for (Size i = 0; i < mzs_.size() - 1; i++) {
-          OpenMS::MSSpectrum full_spectrum = OpenMS::SpectrumAddition::addUpSpectra(
-              input, bin_sizes_[i], false
-          );
-          for (auto it = full_spectrum.begin(); it != full_spectrum.end(); ++it) {
-              if (it->getMZ() > mzs_[i+1]) break;
-              if (it->getMZ() >= mzs_[i]) output.push_back(*it);
+      if (mzs_.size() < 2) return output;
+
+      // each m/z window is summed up with its own bin size, independently of the others
+      std::vector<std::vector<Peak1D>> window_peaks(mzs_.size() - 1);
+      std::vector<std::exception_ptr> errors(window_peaks.size());
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)window_peaks.size(); i++) {
+          try {
+              OpenMS::MSSpectrum full_spectrum = OpenMS::SpectrumAddition::addUpSpectra(
+                  input, bin_sizes_[i], false
+              );
+              for (auto it = full_spectrum.begin(); it != full_spectrum.end(); ++it) {
+                  if (it->getMZ() > mzs_[i+1]) break;
+                  if (it->getMZ() >= mzs_[i]) window_peaks[i].push_back(*it);
+              }
+          } catch (...) {
+              errors[i] = std::current_exception();
           }
       }
+      for (const auto& e : errors) {
+          if (e) std::rethrow_exception(e);
+      }
+      for (const auto& peaks : window_peaks) {
+          output.insert(output.end(), peaks.begin(), peaks.end());
+      }
       output.sortByPosition();
       return output;
   }
@@ -162,11 +225,8 @@ namespace OpenMS {
     ams_param.setValue("negative_adducts", param_.getValue("negative_adducts"));
     ams_param.setValue("keep_unidentified_masses", "false"); // only report IDs
 
-    AccurateMassSearchEngine ams;
-    ams.setParameters(ams_param);
-    ams.init();
-
-    ams.run(input, output);
+    // the databases are loaded only once per search settings
+    getAccurateMassSearchEngine(ams_param)->run(input, output);
   }
 
   MSSpectrum FIAMSDataProcessor::trackNoise(const MSSpectrum& input)
@@ -37,6 +37,9 @@
 #include <OpenMS/ANALYSIS/ID/FIAMSDataProcessor.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <exception>
+#include <memory>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -73,14 +76,14 @@ namespace OpenMS {
   }
 
   void FIAMSScheduler::run() {
-    #pragma omp parallel for
-    for (int i = 0; i < (int)samples_.size(); ++i) {
-      MSExperiment exp;
-      MzMLFile mzml;
-      mzml.load(base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML", exp);
+    // prepare the jobs of all samples up front (parameters, time points)
+    std::vector<String> input_files(samples_.size());
+    std::vector<Param> params(samples_.size());
+    std::vector<std::vector<String>> times(samples_.size());
+    for (Size i = 0; i < samples_.size(); ++i) {
+      input_files[i] = base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML";
 
-      FIAMSDataProcessor fia_processor;
-      Param p;
+      Param& p = params[i];
       p.setValue("filename", samples_[i].at("filename"));
       p.setValue("dir_output", base_dir_ + samples_[i].at("dir_output"));
       p.setValue("resolution", std::stof(samples_[i].at("resolution")));
@@ -89,16 +92,57 @@ namespace OpenMS {
       p.setValue("db:struct", std::vector<std::string>{base_dir_ + samples_[i].at("db_struct")});
       p.setValue("positive_adducts", base_dir_ + samples_[i].at("positive_adducts"));
       p.setValue("negative_adducts", base_dir_ + samples_[i].at("negative_adducts"));
-      fia_processor.setParameters(p);
 
       String time = samples_[i].at("time");
-      std::vector<String> times;
-      time.split(";", times);
-      for (Size j = 0; j < times.size(); ++j) {
-        OPENMS_LOG_INFO << "Started " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
-        MzTab mztab_output;
-        fia_processor.run(exp, std::stof(times[j]), mztab_output, load_cached_);
-        OPENMS_LOG_INFO << "Finished " << samples_[i].at("filename") << " for " << times[j] << " seconds" << std::endl;
+      time.split(";", times[i]);
+    }
+
+    // Pipeline: one task per sample loads its mzML file and then spawns one task per time point
+    // (merging, picking, accurate mass search), so that loading and processing of different samples
+    // and time points overlap. The mass search databases are shared (see FIAMSDataProcessor).
+    // errors[i][0]: loading of sample i, errors[i][j + 1]: time point j of sample i
+    std::vector<std::vector<std::exception_ptr>> errors(samples_.size());
+    for (Size i = 0; i < samples_.size(); ++i) {
+      errors[i].resize(times[i].size() + 1);
+    }
+    #pragma omp parallel
+    #pragma omp single
+    for (Size i = 0; i < samples_.size(); ++i) {
+      #pragma omp task firstprivate(i) shared(input_files, params, times, errors)
+      {
+        std::shared_ptr<const MSExperiment> exp;
+        try {
+          auto loaded = std::make_shared<MSExperiment>();
+          MzMLFile mzml;
+          mzml.load(input_files[i], *loaded);
+          exp = std::move(loaded);
+        } catch (...) {
+          errors[i][0] = std::current_exception();
+        }
+
+        for (Size j = 0; exp && j < times[i].size(); ++j) {
+          #pragma omp task firstprivate(i, j, exp) shared(params, times, errors)
+          {
+            try {
+              const String& filename = samples_[i].at("filename");
+              FIAMSDataProcessor fia_processor;
+              fia_processor.setParameters(params[i]);
+              OPENMS_LOG_INFO << "Started " << filename << " for " << times[i][j] << " seconds" << std::endl;
+              MzTab mztab_output;
+              fia_processor.run(*exp, std::stof(times[i][j]), mztab_output, load_cached_);
+              OPENMS_LOG_INFO << "Finished " << filename << " for " << times[i][j] << " seconds" << std::endl;
+            } catch (...) {
+              errors[i][j + 1] = std::current_exception();
+            }
+          }
+        }
+      }
+    }
+    // (implicit barrier: all tasks are finished here)
+
+    for (const auto& sample_errors : errors) {
+      for (const auto& e : sample_errors) {
+        if (e) std::rethrow_exception(e);
       }
     }
   }
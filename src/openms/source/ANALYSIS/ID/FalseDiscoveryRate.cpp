@@ -176,7 +176,7 @@ namespace OpenMS
             }
 
             String target_decoy(it->getHits()[i].getMetaValue("target_decoy"));
-            const String peptide_sequence = it->getHits()[i].getSequence().toUnmodifiedString();
+            const String peptide_sequence = annotate_peptide_fdr ? it->getHits()[i].getSequence().toUnmodifiedString() : String();
             const double score = it->getHits()[i].getScore();
 
             if (target_decoy == "target" || target_decoy == "target+decoy")
@@ -316,7 +316,7 @@ namespace OpenMS
         }
 
         // calculate fdr for the forward scores
-        map<double, double> score_to_fdr;
+        ScoreToFDRTable score_to_fdr;
         calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
         // calculate peptide FDR
@@ -331,16 +331,16 @@ namespace OpenMS
           {
             target_peptide_scores.push_back(ps.second);
           }      
-          map<double, double> score_to_peptide_fdr;
+          ScoreToFDRTable score_to_peptide_fdr;
           calculateFDRs_(score_to_peptide_fdr, target_peptide_scores, decoy_peptide_scores, q_value, higher_score_better);
           // overwrite best peptide score with peptide q-value
           for (auto& ps : peptide_to_best_decoy_score)
           {
-            ps.second = score_to_peptide_fdr[ps.second];
+            ps.second = lookupFDR_(score_to_peptide_fdr, ps.second);
           }
           for (auto& ps : peptide_to_best_target_score)
           {
-            ps.second = score_to_peptide_fdr[ps.second];
+            ps.second = lookupFDR_(score_to_peptide_fdr, ps.second);
           }
         }
 
@@ -395,7 +395,7 @@ namespace OpenMS
               }              
             }
             hit.setMetaValue(score_type, pit->getScore());
-            hit.setScore(score_to_fdr[pit->getScore()]);
+            hit.setScore(lookupFDR_(score_to_fdr, pit->getScore()));
             hits.push_back(hit);
           }
           it->getHits().swap(hits);
@@ -459,7 +459,7 @@ namespace OpenMS
     bool higher_score_better = fwd_ids.begin()->isHigherScoreBetter();
     bool add_decoy_peptides = param_.getValue("add_decoy_peptides").toBool();
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRTable score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -480,10 +480,10 @@ namespace OpenMS
       for (vector<PeptideHit>::iterator pit = hits.begin(); pit != hits.end(); ++pit)
       {
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
-        cerr << pit->getScore() << " " << score_to_fdr[pit->getScore()] << endl;
+        cerr << pit->getScore() << " " << lookupFDR_(score_to_fdr, pit->getScore()) << endl;
 #endif
         pit->setMetaValue(score_type, pit->getScore());
-        pit->setScore(score_to_fdr[pit->getScore()]);
+        pit->setScore(lookupFDR_(score_to_fdr, pit->getScore()));
       }
       it->setHits(hits);
     }
@@ -507,10 +507,10 @@ namespace OpenMS
         for (vector<PeptideHit>::iterator pit = hits.begin(); pit != hits.end(); ++pit)
         {
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
-          cerr << pit->getScore() << " " << score_to_fdr[pit->getScore()] << endl;
+          cerr << pit->getScore() << " " << lookupFDR_(score_to_fdr, pit->getScore()) << endl;
 #endif
           pit->setMetaValue(score_type, pit->getScore());
-          pit->setScore(score_to_fdr[pit->getScore()]);
+          pit->setScore(lookupFDR_(score_to_fdr, pit->getScore()));
         }
         it->setHits(hits);
       }
@@ -560,7 +560,7 @@ namespace OpenMS
 
 
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRTable score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -584,7 +584,7 @@ namespace OpenMS
         if (add_decoy_proteins || hit.getMetaValue("target_decoy") != "decoy")
         {
           hit.setMetaValue(score_type, hit.getScore());
-          hit.setScore(score_to_fdr[hit.getScore()]);
+          hit.setScore(lookupFDR_(score_to_fdr, hit.getScore()));
           new_hits.push_back(std::move(hit));
         }
       }
@@ -618,7 +618,7 @@ namespace OpenMS
     bool q_value = !param_.getValue("no_qvalues").toBool();
     bool higher_score_better = fwd_ids.begin()->isHigherScoreBetter();
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRTable score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -638,7 +638,7 @@ namespace OpenMS
       for (vector<ProteinHit>::iterator pit = hits.begin(); pit != hits.end(); ++pit)
       {
         pit->setMetaValue(score_type, pit->getScore());
-        pit->setScore(score_to_fdr[pit->getScore()]);
+        pit->setScore(lookupFDR_(score_to_fdr, pit->getScore()));
       }
       it->setHits(hits);
     }
@@ -673,7 +673,7 @@ namespace OpenMS
       }
     }
 
-    map<double, double> score_to_fdr;
+    ScoreToFDRTable score_to_fdr;
     bool higher_better = score_ref->higher_better;
     bool use_qvalue = !param_.getValue("no_qvalues").toBool();
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, use_qvalue,
@@ -702,7 +702,7 @@ namespace OpenMS
       }
       auto pos = match_to_score.find(it);
       if (pos == match_to_score.end()) continue;
-      double fdr = score_to_fdr.at(pos->second);
+      double fdr = lookupFDR_(score_to_fdr, pos->second);
       id_data.addScore(it, fdr_ref, fdr);
     }
     return fdr_ref;
@@ -756,31 +756,27 @@ namespace OpenMS
   }
 
 
-  void FalseDiscoveryRate::calculateFDRs_(map<double, double>& score_to_fdr, vector<double>& target_scores, vector<double>& decoy_scores, bool q_value, bool higher_score_better) const
+  void FalseDiscoveryRate::calculateFDRs_(ScoreToFDRTable& score_to_fdr, vector<double>& target_scores, vector<double>& decoy_scores, bool q_value, bool higher_score_better) const
   {
     Size number_of_target_scores = target_scores.size();
-    // sort the scores
-    if (higher_score_better && !q_value)
+    // sort the scores (targets and decoys independently of each other)
+    const bool targets_ascending = (q_value == higher_score_better);
+    const bool decoys_ascending = !higher_score_better;
+    auto sortScores = [](vector<double>& scores, const bool ascending)
     {
-      sort(target_scores.rbegin(), target_scores.rend());
-      sort(decoy_scores.rbegin(), decoy_scores.rend());
-    }
-    else if (!higher_score_better && !q_value)
-    {
-      sort(target_scores.begin(), target_scores.end());
-      sort(decoy_scores.begin(), decoy_scores.end());
-    }
-    else if (higher_score_better)
-    {
-      sort(target_scores.begin(), target_scores.end());
-      sort(decoy_scores.rbegin(), decoy_scores.rend());
-    }
-    else
+      if (ascending) sort(scores.begin(), scores.end());
+      else sort(scores.rbegin(), scores.rend());
+    };
+    #pragma omp parallel sections if (number_of_target_scores + decoy_scores.size() > 100000)
     {
-      sort(target_scores.rbegin(), target_scores.rend());
-      sort(decoy_scores.begin(), decoy_scores.end());
+      #pragma omp section
+      sortScores(target_scores, targets_ascending);
+      #pragma omp section
+      sortScores(decoy_scores, decoys_ascending);
     }
 
+    // FDR of each (sorted) target score; for equal scores, the last one counts
+    vector<double> target_fdrs(number_of_target_scores);
     Size j = 0;
 
     if (q_value)
@@ -836,7 +832,7 @@ namespace OpenMS
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
         cerr << fdr << endl;
 #endif
-        score_to_fdr[target_scores[i]] = fdr;
+        target_fdrs[i] = fdr;
 
       }
     }
@@ -861,22 +857,59 @@ namespace OpenMS
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
         cerr << fdr << endl;
 #endif
-        score_to_fdr[target_scores[i]] = fdr;
+        target_fdrs[i] = fdr;
       }
     }
 
+    // unique target scores (in sort order) and their FDRs
+    vector<double> unique_scores;
+    vector<double> unique_fdrs;
+    vector<Size> unique_index(number_of_target_scores); // target index -> index into unique_*
+    for (Size i = 0; i != number_of_target_scores; ++i)
+    {
+      if (unique_scores.empty() || unique_scores.back() != target_scores[i])
+      {
+        unique_scores.push_back(target_scores[i]);
+        unique_fdrs.push_back(target_fdrs[i]);
+      }
+      else
+      {
+        unique_fdrs.back() = target_fdrs[i];
+      }
+      unique_index[i] = unique_scores.size() - 1;
+    }
+    auto target_order = [targets_ascending](const double a, const double b) { return targets_ascending ? a < b : a > b; };
+    // a decoy with the same score as a target overwrites the target's FDR, others are collected separately
+    vector<pair<double, double>> decoy_fdrs;
+    auto assign = [&](const double ds, const double fdr)
+    {
+      auto it = lower_bound(unique_scores.begin(), unique_scores.end(), ds, target_order);
+      if (it != unique_scores.end() && *it == ds)
+      {
+        unique_fdrs[it - unique_scores.begin()] = fdr;
+      }
+      else if (!decoy_fdrs.empty() && decoy_fdrs.back().first == ds)
+      {
+        decoy_fdrs.back().second = fdr;
+      }
+      else
+      {
+        decoy_fdrs.emplace_back(ds, fdr);
+      }
+    };
+
     // assign q-value of decoy_score to closest target_score
     for (Size i = 0; i != decoy_scores.size(); ++i)
     {
       const double& ds = decoy_scores[i];
 
       // advance target index until score is better than decoy score
+      // (binary search: if the first target does not qualify, none does; otherwise the qualifying targets form a prefix)
+      auto not_better = [ds, higher_score_better](const double ts) { return (ts <= ds && higher_score_better) || (ts >= ds && !higher_score_better); };
       size_t k{0};
-      while (k != target_scores.size() &&
-             ((target_scores[k] <= ds && higher_score_better) ||
-              (target_scores[k] >= ds && !higher_score_better)))
+      if (!target_scores.empty() && not_better(target_scores[0]))
       {
-        ++k;
+        k = partition_point(target_scores.begin(), target_scores.end(), not_better) - target_scores.begin();
       }
 
       // corner cases
@@ -884,27 +917,47 @@ namespace OpenMS
       {
         if (!target_scores.empty())
         {
-          score_to_fdr[ds] = score_to_fdr[target_scores[0]];
+          assign(ds, unique_fdrs[unique_index[0]]);
           continue;
         }
         else
         {
-          score_to_fdr[ds] = 1.0;
+          assign(ds, 1.0);
           continue;
         }
       }
 
-      if (k == target_scores.size()) { score_to_fdr[ds] = score_to_fdr[target_scores.back()]; continue; }
+      if (k == target_scores.size()) { assign(ds, unique_fdrs[unique_index.back()]); continue; }
 
       if (fabs(target_scores[k] - ds) < fabs(target_scores[k - 1] - ds))
       {
-        score_to_fdr[ds] = score_to_fdr[target_scores[k]];
+        assign(ds, unique_fdrs[unique_index[k]]);
       }
       else
       {
-        score_to_fdr[ds] = score_to_fdr[target_scores[k - 1]];
+        assign(ds, unique_fdrs[unique_index[k - 1]]);
       }
     }
+
+    // combine into a table sorted by score
+    score_to_fdr.clear();
+    score_to_fdr.reserve(unique_scores.size() + decoy_fdrs.size());
+    for (Size i = 0; i != unique_scores.size(); ++i)
+    {
+      score_to_fdr.emplace_back(unique_scores[i], unique_fdrs[i]);
+    }
+    score_to_fdr.insert(score_to_fdr.end(), decoy_fdrs.begin(), decoy_fdrs.end());
+    sort(score_to_fdr.begin(), score_to_fdr.end(), [](const pair<double, double>& a, const pair<double, double>& b) { return a.first < b.first; });
+  }
+
+  double FalseDiscoveryRate::lookupFDR_(const ScoreToFDRTable& score_to_fdr, double score)
+  {
+    auto it = lower_bound(score_to_fdr.begin(), score_to_fdr.end(), score, [](const pair<double, double>& entry, const double s) { return entry.first < s; });
+    if (it == score_to_fdr.end() || it->first != score)
+    {
+      return 0.0;
+    }
+    return it->second;
   }
 
   //TODO does not support "by run" and/or "by charge"
@@ -0,0 +1,176 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace OpenMS
+{
+  Size FragmentIndex::addPeptide(double mass, const vector<double>& fragment_mzs)
+  {
+    const Size peptide_index = peptide_masses_.size();
+    peptide_masses_.push_back(mass);
+    for (double mz : fragment_mzs)
+    {
+      fragments_.emplace_back(mz, (UInt32)peptide_index);
+    }
+    built_ = false;
+    return peptide_index;
+  }
+
+  void FragmentIndex::build()
+  {
+    // order peptides by mass (ties by index) so mass windows map to rank ranges
+    peptide_by_rank_.resize(peptide_masses_.size());
+    iota(peptide_by_rank_.begin(), peptide_by_rank_.end(), 0);
+    sort(peptide_by_rank_.begin(), peptide_by_rank_.end(), [this](UInt32 a, UInt32 b)
+    {
+      if (peptide_masses_[a] != peptide_masses_[b]) return peptide_masses_[a] < peptide_masses_[b];
+      return a < b;
+    });
+    rank_by_peptide_.resize(peptide_masses_.size());
+    sorted_masses_.resize(peptide_masses_.size());
+    for (Size rank = 0; rank != peptide_by_rank_.size(); ++rank)
+    {
+      rank_by_peptide_[peptide_by_rank_[rank]] = (UInt32)rank;
+      sorted_masses_[rank] = peptide_masses_[peptide_by_rank_[rank]];
+    }
+
+    sort(fragments_.begin(), fragments_.end());
+    built_ = true;
+  }
+
+  bool FragmentIndex::isBuilt() const
+  {
+    return built_;
+  }
+
+  void FragmentIndex::clear()
+  {
+    peptide_masses_.clear();
+    sorted_masses_.clear();
+    rank_by_peptide_.clear();
+    peptide_by_rank_.clear();
+    fragments_.clear();
+    built_ = true;
+  }
+
+  Size FragmentIndex::size() const
+  {
+    return peptide_masses_.size();
+  }
+
+  Size FragmentIndex::getNumberOfFragments() const
+  {
+    return fragments_.size();
+  }
+
+  double FragmentIndex::getPeptideMass(Size peptide_index) const
+  {
+    return peptide_masses_.at(peptide_index);
+  }
+
+  void FragmentIndex::query(const vector<double>& peak_mzs,
+                            double min_mass,
+                            double max_mass,
+                            double fragment_tolerance,
+                            bool fragment_tolerance_ppm,
+                            Size min_shared_fragments,
+                            Size max_hits,
+                            vector<Hit>& hits) const
+  {
+    hits.clear();
+    if (!built_)
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FragmentIndex::build() needs to be called before querying.");
+    }
+
+    // candidates of the precursor mass window
+    const UInt32 rank_begin = (UInt32)(lower_bound(sorted_masses_.begin(), sorted_masses_.end(), min_mass) - sorted_masses_.begin());
+    const UInt32 rank_end = (UInt32)(upper_bound(sorted_masses_.begin(), sorted_masses_.end(), max_mass) - sorted_masses_.begin());
+    if (rank_begin >= rank_end) return;
+
+    // collect matched fragments as (rank of peptide, position in fragment array)
+    vector<pair<UInt32, Size> > matches;
+    for (double mz : peak_mzs)
+    {
+      const double tolerance = fragment_tolerance_ppm ? mz * fragment_tolerance * 1e-6 : fragment_tolerance;
+      auto it = lower_bound(fragments_.begin(), fragments_.end(), mz - tolerance,
+        [](const pair<double, UInt32>& f, double value) { return f.first < value; });
+      for (; it != fragments_.end() && it->first <= mz + tolerance; ++it)
+      {
+        const UInt32 rank = rank_by_peptide_[it->second];
+        if (rank >= rank_begin && rank < rank_end)
+        {
+          matches.emplace_back(rank, it - fragments_.begin());
+        }
+      }
+    }
+
+    // count each theoretical fragment once, even if it is matched by several peaks
+    sort(matches.begin(), matches.end());
+    matches.erase(unique(matches.begin(), matches.end()), matches.end());
+    for (Size i = 0; i < matches.size(); )
+    {
+      Size j = i + 1;
+      while (j < matches.size() && matches[j].first == matches[i].first) ++j;
+      if (j - i >= min_shared_fragments)
+      {
+        hits.push_back(Hit{peptide_by_rank_[matches[i].first], j - i});
+      }
+      i = j;
+    }
+
+    auto better = [](const Hit& a, const Hit& b)
+    {
+      if (a.shared_fragments != b.shared_fragments) return a.shared_fragments > b.shared_fragments;
+      return a.peptide_index < b.peptide_index;
+    };
+    if (max_hits != 0 && hits.size() > max_hits)
+    {
+      partial_sort(hits.begin(), hits.begin() + max_hits, hits.end(), better);
+      hits.resize(max_hits);
+    }
+    else
+    {
+      sort(hits.begin(), hits.end(), better);
+    }
+  }
+} // namespace OpenMS
@@ -46,6 +46,7 @@
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <numeric>
 #include <ostream>
 #ifdef _OPENMP
 #include <omp.h>
@@ -62,11 +63,11 @@ using Internal::IDBoostGraph;
 namespace OpenMS
 {
 
-  /// Hasher for sets of uints using boost::hash_range
+  /// Hasher for (sorted) sets of uints using boost::hash_range
   struct MyUIntSetHasher
   {
   public:
-    size_t operator()(const set<IDBoostGraph::vertex_t>& s) const
+    size_t operator()(const vector<IDBoostGraph::vertex_t>& s) const
         {
           return boost::hash_range(s.begin(), s.end());
         }
@@ -611,6 +612,20 @@ namespace OpenMS
   }*/
 
 
+  std::vector<Size> IDBoostGraph::getCCsBySizeDescending_() const
+  {
+    std::vector<Size> order(ccs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    // inference cost grows with the number of edges (factors) and vertices (variables)
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b)
+    {
+      const Graph& ga = ccs_[a];
+      const Graph& gb = ccs_[b];
+      return boost::num_edges(ga) + boost::num_vertices(ga) > boost::num_edges(gb) + boost::num_vertices(gb);
+    });
+    return order;
+  }
+
   /// Do sth on ccs
   void IDBoostGraph::applyFunctorOnCCs(const std::function<unsigned long(Graph&, unsigned int)>& functor)
   {
@@ -619,9 +634,15 @@ namespace OpenMS
     }
 
     // Use dynamic schedule because big CCs take much longer!
-    #pragma omp parallel for schedule(dynamic) default(none) shared(functor)
-    for (int i = 0; i < static_cast<int>(ccs_.size()); i += 1)
+    // Hand out the biggest CCs first so that a large component picked up late does not
+    // leave all other threads idle at the end (longest-processing-time-first).
+    // The functor still receives the original CC index and only touches its own CC.
+    const std::vector<Size> order = getCCsBySizeDescending_();
+    #pragma omp parallel for schedule(dynamic, 1) default(none) shared(functor, order)
+    for (int j = 0; j < static_cast<int>(order.size()); j += 1)
     {
+      const int i = static_cast<int>(order[j]);
+
       #ifdef INFERENCE_BENCH
       StopWatch sw;
       sw.start();
@@ -833,19 +854,21 @@ namespace OpenMS
         {
           if (fg[*adjIt].which() >= 3) //if there are only two types (pep,prot) this check for pep is actually unnecessary
           {
-            childPeps.insert(*adjIt);
+            childPeps.push_back(*adjIt);
           }
         }
 
         auto clusterIt = indistProteins.emplace(childPeps, ProteinNodeSet({*ui}));
         if (!clusterIt.second) //no insertion -> append
         {
-          (clusterIt.first)->second.insert(*ui);
+          (clusterIt.first)->second.push_back(*ui);
         }
       }
     }
 
     // add the protein groups to the underlying ProteinGroup data structure only
+    // collect them locally first so that threads synchronize once per CC instead of once per group
+    vector<ProteinIdentification::ProteinGroup> groups;
     for (auto const &pepsToGrps : indistProteins)
     {
       if (pepsToGrps.second.size() <= 1 && !addSingletons)
@@ -873,11 +896,16 @@ namespace OpenMS
         }
       }
 
-      // TODO you could allocate as many groups as proteins in the beginning
-      //  then you do not need a critical section. Resize afterwards.
-      //  Or make a local vector of Groups and merge in a single threaded section
+      groups.push_back(std::move(pg));
+    }
+
+    if (!groups.empty())
+    {
       #pragma omp critical (ProteinGroups)
-      {protIDs_.getIndistinguishableProteins().push_back(pg);}
+      {
+        auto& indist = protIDs_.getIndistinguishableProteins();
+        indist.insert(indist.end(), std::make_move_iterator(groups.begin()), std::make_move_iterator(groups.end()));
+      }
     }
   }
 
@@ -1243,14 +1271,14 @@ namespace OpenMS
             {
               if (curr_cc[*adjIt].which() >= 3) //if there are only two types (pep,prot) this check for pep is actually unnecessary
               {
-                childPeps.insert(*adjIt);
+                childPeps.push_back(*adjIt);
               }
             }
 
             auto clusterIt = indistProteins.emplace(childPeps, ProteinNodeSet({*ui}));
             if (!clusterIt.second) //no insertion -> append
             {
-              (clusterIt.first)->second.insert(*ui);
+              (clusterIt.first)->second.push_back(*ui);
             }
           }
         }
@@ -1301,14 +1329,14 @@ namespace OpenMS
             {
               if (curr_cc[*adjIt].which() <= 1) // Either protein or protein group
               {
-                parents.insert(*adjIt);
+                parents.push_back(*adjIt);
               }
             }
 
             auto clusterIt = pepClusters.emplace(parents, PeptideNodeSet({*ui}));
             if (!clusterIt.second) //no insertion -> append
             {
-              (clusterIt.first)->second.insert(*ui);
+              (clusterIt.first)->second.push_back(*ui);
             }
           }
         }
@@ -1397,14 +1425,14 @@ namespace OpenMS
             {
               if (curr_cc[*adjIt].which() >= 3) //if there are only two types (pep,prot) this check for pep is actually unnecessary
               {
-                childPeps.insert(*adjIt);
+                childPeps.push_back(*adjIt);
               }
             }
 
             auto clusterIt = indistProteins.emplace(childPeps, ProteinNodeSet({*ui}));
             if (!clusterIt.second) //no insertion -> append
             {
-              (clusterIt.first)->second.insert(*ui);
+              (clusterIt.first)->second.push_back(*ui);
             }
           }
         }
@@ -1462,14 +1490,14 @@ namespace OpenMS
             {
               if (curr_cc[*adjIt].which() <= 1) // Either protein or protein group
               {
-                parents.insert(*adjIt);
+                parents.push_back(*adjIt);
               }
             }
 
             auto clusterIt = pepClusters.emplace(parents, PeptideNodeSet({*ui}));
             if (!clusterIt.second) //no insertion -> append
             {
-              (clusterIt.first)->second.insert(*ui);
+              (clusterIt.first)->second.push_back(*ui);
             }
           }
         }
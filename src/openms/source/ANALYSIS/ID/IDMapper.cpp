@@ -36,6 +36,7 @@
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/METADATA/SpectrumLookup.h>
 
+#include <unordered_map>
 #include <unordered_set>
 
 
@@ -249,18 +250,76 @@ namespace OpenMS
     annotate(map, peptide_ids, protein_ids, clear_ids, map_ms1);
   }
 
-  bool isMatchByNativeID(const PeptideIdentification& id, ConsensusFeature& cf)
+  namespace
   {
-    // check if the native id of an identifying spectrum is annotated            
-    String ref_mv;
-    if (cf.metaValueExists("id_scan_id")) // identifying MS2 spectrum in MS3 TMT
+    /// RT index over consensus features: finds all features which may be within an RT tolerance of a given RT
+    class ConsensusRTIndex
     {
-      ref_mv = "id_scan_id";
-    }
-    else if (cf.metaValueExists("scan_id")) // identifying MS2 spectrum in standard TMT
+    public:
+      ConsensusRTIndex(const ConsensusMap& map, const bool measure_from_subelements, const double rt_tolerance) :
+        // small slack guards against rounding; candidates are checked exactly afterwards
+        tolerance_(rt_tolerance + 1e-6)
+      {
+        entries_.reserve(map.size());
+        for (Size i = 0; i < map.size(); ++i)
+        {
+          Entry e{map[i].getRT(), map[i].getRT(), i};
+          if (measure_from_subelements)
+          {
+            if (map[i].getFeatures().empty()) continue; // can never match
+            e.min_rt = std::numeric_limits<double>::max();
+            e.max_rt = -std::numeric_limits<double>::max();
+            for (const FeatureHandle& h : map[i].getFeatures())
+            {
+              e.min_rt = std::min(e.min_rt, h.getRT());
+              e.max_rt = std::max(e.max_rt, h.getRT());
+            }
+          }
+          max_width_ = std::max(max_width_, e.max_rt - e.min_rt);
+          entries_.push_back(e);
+        }
+        std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.min_rt < b.min_rt; });
+      }
+
+      /// indices of all candidate features for @p rt (sorted ascending)
+      void getCandidates(const double rt, std::vector<Size>& candidates) const
+      {
+        candidates.clear();
+        const double rt_low = rt - tolerance_;
+        const double rt_high = rt + tolerance_;
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), rt_low - max_width_, [](const Entry& e, const double v) { return e.min_rt < v; });
+        for (; it != entries_.end() && it->min_rt <= rt_high; ++it)
+        {
+          if (it->max_rt >= rt_low) candidates.push_back(it->index);
+        }
+        std::sort(candidates.begin(), candidates.end());
+      }
+
+    private:
+      struct Entry
+      {
+        double min_rt;
+        double max_rt;
+        Size index;
+      };
+      std::vector<Entry> entries_; ///< sorted by min_rt
+      double max_width_{0}; ///< largest RT extent of a feature
+      double tolerance_;
+    };
+
+    /// name of the meta value used for matching @p cf by native ID (empty if none)
+    String getNativeIDMetaValueName(const ConsensusFeature& cf)
     {
-      ref_mv = "scan_id";
+      if (cf.metaValueExists("id_scan_id")) return "id_scan_id"; // identifying MS2 spectrum in MS3 TMT
+      if (cf.metaValueExists("scan_id")) return "scan_id"; // identifying MS2 spectrum in standard TMT
+      return "";
     }
+  }
+
+  bool isMatchByNativeID(const PeptideIdentification& id, ConsensusFeature& cf)
+  {
+    // check if the native id of an identifying spectrum is annotated            
+    const String ref_mv = getNativeIDMetaValueName(cf);
 
     // return if no meta info to match ids between spectra and consensus features?
     if (ref_mv.empty() || !id.metaValueExists("spectrum_reference")) return false;
@@ -292,106 +351,141 @@ namespace OpenMS
     // consensusMap -> {peptide_index}
     vector<set<size_t>> mapping(map.size());
 
-    DoubleList mz_values;
-    double rt_pep;
-    IntList charges;
-
     // for statistics
     Size id_matches_none(0), id_matches_single(0), id_matches_multiple(0);
 
-    // iterate over the peptide IDs
-    for (Size i = 0; i < ids.size(); ++i)
+    // only features close in RT (or sharing the native ID, see isMatchByNativeID()) can match
+    const ConsensusRTIndex rt_index(map, measure_from_subelements, rt_tolerance_);
+    std::unordered_map<String, std::vector<Size>> native_id_to_features;
+    if (!measure_from_subelements)
     {
-      if (ids[i].getHits().empty()) continue;
-
-      getIDDetails_(ids[i], rt_pep, mz_values, charges);
+      for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+      {
+        const String ref_mv = getNativeIDMetaValueName(map[cm_index]);
+        if (!ref_mv.empty()) native_id_to_features[map[cm_index].getMetaValue(ref_mv).toString()].push_back(cm_index);
+      }
+    }
 
-      bool id_mapped(false);
+    // find matches of all peptide IDs (in parallel): ID index -> {(feature index, map index of matching handle)}
+    vector<vector<pair<Size, Size>>> id_to_features(ids.size());
+    #pragma omp parallel
+    {
+      DoubleList mz_values;
+      double rt_pep;
+      IntList charges;
+      vector<Size> candidates;
 
-      // iterate over the features
-      for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+      #pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        // if set to TRUE, we leave the i_mz-loop as we added the whole ID with all hits
-        bool was_added = false; // was current pep-m/z matched?!
+        if (ids[i].getHits().empty()) continue;
 
-        // iterate over m/z values of pepIds
-        for (Size i_mz = 0; i_mz < mz_values.size(); ++i_mz)
-        {
-          double mz_pep = mz_values[i_mz];
+        getIDDetails_(ids[i], rt_pep, mz_values, charges);
 
-          // charge states to use for checking:
-          IntList current_charges;
-          if (!ignore_charge_)
+        rt_index.getCandidates(rt_pep, candidates);
+        if (!native_id_to_features.empty() && ids[i].metaValueExists("spectrum_reference"))
+        {
+          auto native_it = native_id_to_features.find(ids[i].getMetaValue("spectrum_reference").toString());
+          if (native_it != native_id_to_features.end())
           {
-            // if "mz_ref." is "precursor", we have only one m/z value to check,
-            // but still one charge state per peptide hit that could match:
-            if (mz_values.size() == 1)
-            {
-              current_charges = charges;
-            }
-            else
-            {
-              current_charges.push_back(charges[i_mz]);
-            }
-            current_charges.push_back(0); // "not specified" always matches
+            candidates.insert(candidates.end(), native_it->second.begin(), native_it->second.end());
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
           }
+        }
 
-          //check if we compare distance from centroid or subelements
-          if (!measure_from_subelements)
+        // iterate over the candidate features
+        for (const Size cm_index : candidates)
+        {
+          // iterate over m/z values of pepIds
+          for (Size i_mz = 0; i_mz < mz_values.size(); ++i_mz)
           {
-            if (isMatchByNativeID(ids[i], map[cm_index]) || // can we match by native ids? if not, match by rt/mz
-               (isMatch_(rt_pep - map[cm_index].getRT(), mz_pep, map[cm_index].getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, map[cm_index].getCharge()))))
+            double mz_pep = mz_values[i_mz];
+
+            // charge states to use for checking:
+            IntList current_charges;
+            if (!ignore_charge_)
             {
-              id_mapped = true;
-              was_added = true;
-              map[cm_index].getPeptideIdentifications().push_back(ids[i]);
-              ++assigned_ids[i];
+              // if "mz_ref." is "precursor", we have only one m/z value to check,
+              // but still one charge state per peptide hit that could match:
+              if (mz_values.size() == 1)
+              {
+                current_charges = charges;
+              }
+              else
+              {
+                current_charges.push_back(charges[i_mz]);
+              }
+              current_charges.push_back(0); // "not specified" always matches
             }
-          }
-          else
-          {
-            for (ConsensusFeature::HandleSetType::const_iterator it_handle = map[cm_index].getFeatures().begin();
-                 it_handle != map[cm_index].getFeatures().end();
-                 ++it_handle)
+
+            bool was_added = false; // was current pep-m/z matched?!
+            //check if we compare distance from centroid or subelements
+            if (!measure_from_subelements)
             {
-              if (isMatch_(rt_pep - it_handle->getRT(), mz_pep, it_handle->getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, it_handle->getCharge())))
+              if (isMatchByNativeID(ids[i], map[cm_index]) || // can we match by native ids? if not, match by rt/mz
+                 (isMatch_(rt_pep - map[cm_index].getRT(), mz_pep, map[cm_index].getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, map[cm_index].getCharge()))))
               {
-                id_mapped = true;
+                id_to_features[i].emplace_back(cm_index, 0);
                 was_added = true;
-                if (mapping[cm_index].count(i) == 0)
+              }
+            }
+            else
+            {
+              for (const FeatureHandle& handle : map[cm_index].getFeatures())
+              {
+                if (isMatch_(rt_pep - handle.getRT(), mz_pep, handle.getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, handle.getCharge())))
                 {
-                  // Store the map index of the peptide feature in the id the feature was mapped to.
-                  PeptideIdentification id_pep = ids[i];
-                  if (annotate_ids_with_subelements)
-                  {
-                    id_pep.setMetaValue("map_index", it_handle->getMapIndex());
-                  }
-
-                  map[cm_index].getPeptideIdentifications().push_back(id_pep);
-                  ++assigned_ids[i];
-                  mapping[cm_index].insert(i);
+                  id_to_features[i].emplace_back(cm_index, handle.getMapIndex());
+                  was_added = true;
+                  break; // we added this peptide already.. no need to check other handles
                 }
-                break; // we added this peptide already.. no need to check other handles
               }
             }
-            // continue to here
-          }
-
-          if (was_added) break;
 
-        } // m/z values to check
-
-        // break to here
+            // we added the whole ID with all hits
+            if (was_added) break;
+          } // m/z values to check
+        } // features
+      } // Identifications
+    }
 
-      } // features
+    // annotate (serially, in the order of the IDs)
+    for (Size i = 0; i < ids.size(); ++i)
+    {
+      if (ids[i].getHits().empty()) continue;
 
       // the id has not been mapped to any consensus feature
-      if (!id_mapped)
+      if (id_to_features[i].empty())
       {
         map.getUnassignedPeptideIdentifications().push_back(ids[i]);
         ++id_matches_none;
+        continue;
       }
-    } // Identifications
+
+      for (const auto& match : id_to_features[i])
+      {
+        const Size cm_index = match.first;
+        if (!measure_from_subelements)
+        {
+          map[cm_index].getPeptideIdentifications().push_back(ids[i]);
+          ++assigned_ids[i];
+        }
+        else if (mapping[cm_index].count(i) == 0)
+        {
+          // Store the map index of the peptide feature in the id the feature was mapped to.
+          PeptideIdentification id_pep = ids[i];
+          if (annotate_ids_with_subelements)
+          {
+            id_pep.setMetaValue("map_index", match.second);
+          }
+
+          map[cm_index].getPeptideIdentifications().push_back(id_pep);
+          ++assigned_ids[i];
+          mapping[cm_index].insert(i);
+        }
+      }
+    }
 
     for (std::map<Size, Size>::const_iterator it = assigned_ids.begin(); it != assigned_ids.end(); ++it)
     {
@@ -445,6 +539,7 @@ namespace OpenMS
     Size spectrum_matches_none(0), spectrum_matches_single(0), spectrum_matches_multiple(0);
 
     // are there any mapped but unidentified precursors?
+    vector<Size> candidates;
     for (Size ui = 0; ui != unidentified.size(); ++ui)
     {
       Size spectrum_index = unidentified[ui];
@@ -471,8 +566,9 @@ namespace OpenMS
         }
         precursor_empty_id.setIdentifier(empty_protein_id.getIdentifier());
 
-        // iterate over the consensus features
-        for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+        // iterate over the candidate consensus features
+        rt_index.getCandidates(rt_value, candidates);
+        for (const Size cm_index : candidates)
         {
           // charge states to use for checking:
           IntList current_charges;
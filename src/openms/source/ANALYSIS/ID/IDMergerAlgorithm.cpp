@@ -35,7 +35,9 @@
 #include <OpenMS/ANALYSIS/ID/IDMergerAlgorithm.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <unordered_map>
+#include <algorithm>
 #include <array>
+#include <exception>
 
 using namespace std;
 namespace OpenMS
@@ -97,28 +99,10 @@ namespace OpenMS
       const std::vector<PeptideIdentification>& peps
   )
   {
-    //copy
-    std::vector<ProteinIdentification> pr = prots;
-    std::vector<PeptideIdentification> pep = peps;
     if (prots.empty() || peps.empty()) return; //error?
 
-    //TODO instead of only checking consistency, merge if possible (especially for SILAC mods)
-    if (!filled_)
-    {
-      if (prots.size() > 1)
-      {
-        //Without any exp. design we assume label-free for checking mods
-        checkOldRunConsistency_(prots, "label-free");
-      }
-      copySearchParams_(prots[0], prot_result_);
-      filled_ = true;
-    }
-    else
-    {
-      //Without any exp. design we assume label-free for checking mods
-      checkOldRunConsistency_(prots, this->prot_result_, "label-free");
-    }
-    movePepIDsAndRefProteinsToResultFaster_(std::move(pep), std::move(pr));
+    // copy once, then proceed as for rvalues
+    insertRuns(std::vector<ProteinIdentification>(prots), std::vector<PeptideIdentification>(peps));
   }
 
   void IDMergerAlgorithm::returnResultsAndClear(
@@ -144,6 +128,7 @@ namespace OpenMS
     //reset internals
     file_origin_to_idx_.clear();
 
+    prots.getHits().reserve(prots.getHits().size() + collected_protein_hits_.size());
     for (auto& p : collected_protein_hits_)
       prots.getHits().push_back(std::move(const_cast<ProteinHit&>(p)));
     // above invalidates set but we clear right after
@@ -181,71 +166,96 @@ namespace OpenMS
 
   void IDMergerAlgorithm::updateAndMovePepIDs_(
       vector<PeptideIdentification>&& pepIDs,
-      const map<String, Size>& runID_to_runIdx,
-      const vector<StringList>& originFiles,
+      const unordered_map<String, Size>& runID_to_runIdx,
+      const vector<vector<Size>>& originFileIdcs,
       bool annotate_origin)
   {
     //TODO if we allow run IDs, we should do a remove_if,
     // then use the iterator to update and move
     // the IDs, then erase them so we don't encounter them in
     // subsequent calls of this function
-    for (auto &pid : pepIDs)
-    {
-      const String &runID = pid.getIdentifier();
 
-      const auto& runIdxIt = runID_to_runIdx.find(runID);
+    // resolve meta value index once; the registry lookup by name is a critical section
+    const UInt merge_index_idx = MetaInfoInterface::metaRegistry().registerName("id_merge_index");
+    const String& new_identifier = prot_result_.getIdentifier();
 
-      if (runIdxIt == runID_to_runIdx.end())
+    // annotate in parallel, move afterwards in input order
+    vector<char> keep(pepIDs.size(), 0);
+    vector<std::exception_ptr> errors(pepIDs.size());
+#pragma omp parallel for schedule(dynamic, 1000)
+    for (SignedSize i = 0; i < (SignedSize)pepIDs.size(); ++i)
+    {
+      try
       {
-        //This is an easy way to just merge peptides from a certain run
-        continue;
-        /*
-        throw Exception::MissingInformation(
-            __FILE__,
-            __LINE__,
-            OPENMS_PRETTY_FUNCTION,
-            "Old IdentificationRun not found for PeptideIdentification "
-            "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ").");
-        */
-      }
+        PeptideIdentification& pid = pepIDs[i];
+        const auto runIdxIt = runID_to_runIdx.find(pid.getIdentifier());
 
-      bool annotated = pid.metaValueExists("id_merge_index");
-      if (annotate_origin || annotated)
-      {
-        Size oldFileIdx(0);
-        const StringList& origins = originFiles[runIdxIt->second];
-        if (annotated)
+        if (runIdxIt == runID_to_runIdx.end())
         {
-          oldFileIdx = pid.getMetaValue("id_merge_index");
-        }
-        else if (origins.size() > 1)
-        {
-          // If there is more than one possible file it might be from
-          // and it is not annotated -> fail
+          //This is an easy way to just merge peptides from a certain run
+          continue;
+          /*
           throw Exception::MissingInformation(
               __FILE__,
               __LINE__,
               OPENMS_PRETTY_FUNCTION,
-              "Trying to annotate new id_merge_index for PeptideIdentification "
-              "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
-              "no old id_merge_index present");
+              "Old IdentificationRun not found for PeptideIdentification "
+              "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ").");
+          */
         }
 
-        if (oldFileIdx >= origins.size())
+        bool annotated = pid.metaValueExists(merge_index_idx);
+        if (annotate_origin || annotated)
         {
-          throw Exception::MissingInformation(
-              __FILE__,
-              __LINE__,
-              OPENMS_PRETTY_FUNCTION,
-              "Trying to annotate new id_merge_index for PeptideIdentification "
-              "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
-              " the index exceeds the number of files in the run.");
+          Size oldFileIdx(0);
+          const vector<Size>& origins = originFileIdcs[runIdxIt->second];
+          if (annotated)
+          {
+            oldFileIdx = pid.getMetaValue(merge_index_idx);
+          }
+          else if (origins.size() > 1)
+          {
+            // If there is more than one possible file it might be from
+            // and it is not annotated -> fail
+            throw Exception::MissingInformation(
+                __FILE__,
+                __LINE__,
+                OPENMS_PRETTY_FUNCTION,
+                "Trying to annotate new id_merge_index for PeptideIdentification "
+                "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
+                "no old id_merge_index present");
+          }
+
+          if (oldFileIdx >= origins.size())
+          {
+            throw Exception::MissingInformation(
+                __FILE__,
+                __LINE__,
+                OPENMS_PRETTY_FUNCTION,
+                "Trying to annotate new id_merge_index for PeptideIdentification "
+                "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
+                " the index exceeds the number of files in the run.");
+          }
+          pid.setMetaValue(merge_index_idx, origins[oldFileIdx]);
         }
-        pid.setMetaValue("id_merge_index", file_origin_to_idx_[origins[oldFileIdx]]);
+        pid.setIdentifier(new_identifier);
+        keep[i] = 1;
       }
-      pid.setIdentifier(prot_result_.getIdentifier());
-      //move peptides into right vector
-      pep_result_.emplace_back(std::move(pid));
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const auto& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
+
+    //move peptides into right vector
+    pep_result_.reserve(pep_result_.size() + std::count(keep.begin(), keep.end(), 1));
+    for (Size i = 0; i < pepIDs.size(); ++i)
+    {
+      if (keep[i]) pep_result_.emplace_back(std::move(pepIDs[i]));
     }
   }
 
@@ -258,7 +268,9 @@ namespace OpenMS
   )
   {
     bool annotate_origin(param_.getValue("annotate_origin").toBool());
-    vector<StringList> originFiles{};
+    // per run: the new (merged) origin index of each of its files
+    vector<vector<Size>> originFileIdcs{};
+    originFileIdcs.reserve(old_protRuns.size());
     //TODO here check run ID if we allow this option
     for (const auto& protRun : old_protRuns)
     {
@@ -275,22 +287,25 @@ namespace OpenMS
       }
       //TODO this will make multiple runs from the same file appear multiple times.
       // should be ok but check all possibilities at some point
-      originFiles.push_back(toFill);
+      vector<Size> idcs;
+      idcs.reserve(toFill.size());
       for (String& f : toFill)
       {
-        file_origin_to_idx_.emplace(std::move(f), file_origin_to_idx_.size());
+        Size new_idx = file_origin_to_idx_.size();
+        idcs.push_back(file_origin_to_idx_.emplace(std::move(f), new_idx).first->second);
       }
-      toFill.clear();
+      originFileIdcs.push_back(std::move(idcs));
     }
 
-    std::map<String, Size> runIDToRunIdx;
+    unordered_map<String, Size> runIDToRunIdx;
+    runIDToRunIdx.reserve(old_protRuns.size());
     for (Size oldProtRunIdx = 0; oldProtRunIdx < old_protRuns.size(); ++oldProtRunIdx)
     {
       ProteinIdentification &protIDRun = old_protRuns[oldProtRunIdx];
       runIDToRunIdx[protIDRun.getIdentifier()] = oldProtRunIdx;
     }
 
-    updateAndMovePepIDs_(std::move(pepIDs), runIDToRunIdx, originFiles, annotate_origin);
+    updateAndMovePepIDs_(std::move(pepIDs), runIDToRunIdx, originFileIdcs, annotate_origin);
     insertProteinIDs_(std::move(old_protRuns));
     pepIDs.clear();
     old_protRuns.clear();
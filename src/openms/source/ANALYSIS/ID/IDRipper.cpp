@@ -36,7 +36,11 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <QDir>
+#include <algorithm>
 #include <array>
+#include <exception>
+#include <optional>
+#include <unordered_map>
 
 using std::vector;
 using std::string;
@@ -195,22 +199,66 @@ namespace OpenMS
     // Build identifier index
     const IdentificationRuns id_runs = IdentificationRuns(proteins);
 
-    // Collect all protein hits
-    vector<ProteinHit> all_protein_hits;
+    // resolve meta value index once; the registry lookup by name is a critical section
+    const UInt origin_meta_idx = MetaInfoInterface::metaRegistry().registerName(names_of_OriginAnnotationFormat[origin_annotation_fmt]);
+
+    // Per run a copy without protein hits (used as template for the output files) and
+    // an index of all protein hits by accession (in order of the runs, as before)
+    vector<ProteinIdentification> prot_templates;
+    prot_templates.reserve(proteins.size());
+    std::unordered_map<String, vector<const ProteinHit*> > accession_to_hits;
     for (ProteinIdentification& prot : proteins)
     {
       // remove protein identification file origin
-      prot.removeMetaValue(names_of_OriginAnnotationFormat[origin_annotation_fmt]);
-      vector<ProteinHit>& protein_hits  = prot.getHits();
-      all_protein_hits.insert(all_protein_hits.end(), protein_hits.begin(), protein_hits.end());
+      prot.removeMetaValue(origin_meta_idx);
+      vector<ProteinHit> hits;
+      hits.swap(prot.getHits());
+      prot_templates.push_back(prot);
+      hits.swap(prot.getHits());
+      for (const ProteinHit& hit : prot.getHits())
+      {
+        accession_to_hits[hit.getAccession()].push_back(&hit);
+      }
+    }
+
+    // Determine output file and referenced protein hits of all peptide identifications in parallel ...
+    vector<std::optional<RipFileIdentifier> > rfis(peptides.size());
+    vector<vector<const ProteinHit*> > pep_protein_hits(peptides.size());
+    vector<std::exception_ptr> errors(peptides.size());
+#pragma omp parallel for schedule(dynamic, 1000)
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
+    {
+      try
+      {
+        PeptideIdentification& pep = peptides[i];
+
+        // Build the output file identifier
+        rfis[i].emplace(id_runs, pep, file_origin_map, origin_annotation_fmt, split_ident_runs);
+
+        // remove file origin annotation
+        pep.removeMetaValue(origin_meta_idx);
+
+        // collect all protein hits that are associated with the peptide hits
+        const vector<PeptideHit>& peptide_hits = pep.getHits();
+        if (!peptide_hits.empty())
+        {
+          vector<String> protein_accessions;
+          getProteinAccessions_(protein_accessions, peptide_hits);
+          getProteinHits_(pep_protein_hits[i], accession_to_hits, protein_accessions);
+        }
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
     }
 
+    // ... and assemble the files in input order
     map<String, pair<UInt, UInt> > basename_to_numeric;
-    //store protein and peptides identifications for each file origin
-    for (PeptideIdentification& pep : peptides)
+    for (Size i = 0; i < peptides.size(); ++i)
     {
-      // Build the output file identifier
-      const IDRipper::RipFileIdentifier rfi(id_runs, pep, file_origin_map, origin_annotation_fmt, split_ident_runs);
+      if (errors[i]) std::rethrow_exception(errors[i]);
+      const RipFileIdentifier& rfi = *rfis[i];
 
       // If we are inferring the output file names from the spectra_data or
       // file_origin, make sure they are unique
@@ -219,73 +267,39 @@ namespace OpenMS
           throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
           "Autodetected output file names are not unique. Use -numeric_filenames.");
       }
-      
-      // remove file origin annotation
-      pep.removeMetaValue(names_of_OriginAnnotationFormat[origin_annotation_fmt]);
 
-      // try to get peptide hits for peptide identification
-      const vector<PeptideHit>& peptide_hits = pep.getHits();
-      if (peptide_hits.empty())
+      const PeptideIdentification& pep = peptides[i];
+      if (pep.getHits().empty())
       {
         continue;
       }
-      // collect all protein accessions that are stored in the peptide hits
-      vector<String> protein_accessions;
-      getProteinAccessions_(protein_accessions, peptide_hits);
-
-      // returns all protein hits that are associated with the given peptide hits
-      vector<ProteinHit> protein2accessions;
-      getProteinHits_(protein2accessions, all_protein_hits, protein_accessions);
-
-      // search for the protein identification of the peptide identification
-      ProteinIdentification prot_ident;
-      getProteinIdentification_(prot_ident, pep, proteins);
-      // TODO catch case that ProteinIdentification prot_ident is not found in the for-loop
 
+      // create new entry for file_origin if it does not exist yet
       RipFileMap::iterator it = ripped.find(rfi);
-      // If file_origin already exists
-      if (it != ripped.end())
+      if (it == ripped.end())
       {
-        vector<ProteinIdentification>& prot_tmp = it->second.prot_idents;
-        bool flag = true;
+        it = ripped.emplace(rfi, RipFileContent({}, {})).first;
+      }
 
-        for (vector<ProteinIdentification>::iterator it2 = prot_tmp.begin(); it2 != prot_tmp.end(); ++it2)
-        {
-          // ProteinIdentification is already there, just add protein hits
-          if (prot_ident.getIdentifier().compare(it2->getIdentifier()) == 0)
-          {
-            for (const ProteinHit& prot : protein2accessions)
-            {
-              it2->insertHit(prot);
-            }
-            flag = false;
-            break;
-          }
-        }
-        // if it was not found
-        if (flag)
-        {
-          prot_ident.setHits(protein2accessions);
-          prot_tmp.push_back(prot_ident);
-        }
-        vector<PeptideIdentification>& pep_tmp = it->second.pep_idents;
-        pep_tmp.push_back(pep);
+      // search for the protein identification of the peptide identification, add it if not there yet
+      vector<ProteinIdentification>& prot_tmp = it->second.prot_idents;
+      const String& identifier = pep.getIdentifier();
+      auto prot_it = std::find_if(prot_tmp.begin(), prot_tmp.end(),
+        [&identifier](const ProteinIdentification& prot) { return prot.getIdentifier() == identifier; });
+      if (prot_it == prot_tmp.end())
+      {
+        prot_tmp.push_back(prot_templates[id_runs.index_map.at(identifier)]);
+        prot_it = prot_tmp.end() - 1;
       }
-      else // otherwise create new entry for file_origin
+      // only use the protein hits that are needed for the peptide identification
+      for (const ProteinHit* prot : pep_protein_hits[i])
       {
-        // create protein identification, TODO parameters
-        vector<ProteinIdentification> protein_idents;
-        // only use the protein hits that are needed for the peptide identification
-        prot_ident.setHits(protein2accessions);
-        protein_idents.push_back(prot_ident);
-
-        //create new peptide identification
-        vector<PeptideIdentification> peptide_idents;
-        peptide_idents.push_back(pep);
-
-        //create and insert new map entry
-        ripped.insert(make_pair(rfi, RipFileContent(protein_idents, peptide_idents)));
+        prot_it->insertHit(*prot);
       }
+      pep_protein_hits[i].clear();
+      pep_protein_hits[i].shrink_to_fit();
+
+      it->second.pep_idents.push_back(pep);
     }
     // Reduce the spectra data string list if that's what we ripped by
     if (origin_annotation_fmt == MAP_INDEX || origin_annotation_fmt == ID_MERGE_INDEX)
@@ -321,10 +335,12 @@ namespace OpenMS
 
       rfis.clear();
       rfcs.clear();
+      rfis.reserve(rfm.size());
+      rfcs.reserve(rfm.size());
       for (RipFileMap::iterator it = rfm.begin(); it != rfm.end(); ++it)
       {
           rfis.push_back(it->first);
-          rfcs.push_back(it->second);
+          rfcs.push_back(std::move(it->second));
       }
   }
 
@@ -390,16 +406,14 @@ IDRipper::OriginAnnotationFormat IDRipper::detectOriginAnnotationFormat_(map<Str
     }
   }
 
-  void IDRipper::getProteinHits_(vector<ProteinHit>& result, const vector<ProteinHit>& protein_hits, const vector<String>& protein_accessions)
+  void IDRipper::getProteinHits_(vector<const ProteinHit*>& result, const std::unordered_map<String, vector<const ProteinHit*> >& accession_to_hits, const vector<String>& protein_accessions)
   {
-    for (const String& it : protein_accessions)
+    for (const String& acc : protein_accessions)
     {
-      for (const ProteinHit& prot : protein_hits)
+      auto it = accession_to_hits.find(acc);
+      if (it != accession_to_hits.end())
       {
-        if (prot.getAccession().compare(it) == 0)
-        {
-          result.push_back(prot);
-        }
+        result.insert(result.end(), it->second.begin(), it->second.end());
       }
     }
   }
@@ -413,18 +427,4 @@ IDRipper::OriginAnnotationFormat IDRipper::detectOriginAnnotationFormat_(map<Str
     }
   }
 
-  void IDRipper::getProteinIdentification_(ProteinIdentification& result, PeptideIdentification pep_ident, std::vector<ProteinIdentification>& prot_idents)
-  {
-    const String& identifier = pep_ident.getIdentifier();
-
-    for (ProteinIdentification& prot: prot_idents)
-    {
-      if (identifier.compare(prot.getIdentifier()) == 0)
-      {
-        result = prot;
-        break;
-      }
-    }
-  }
-
 } // namespace OpenMS
@@ -35,6 +35,7 @@
 #include <OpenMS/ANALYSIS/ID/MetaboliteSpectralMatching.h>
 
 
+#include <exception>
 #include <numeric>
 #include <boost/math/special_functions/factorials.hpp>
 
@@ -362,10 +363,12 @@ namespace OpenMS
 
     // for every DB (theoretical) peak in the valid m/z range, find the closest
     // matching experimental (observed) peak within the allowed tolerance;
-    // in principle, multiple DB peaks can match to the same exp. peak:
-    map<Size, vector<MSSpectrum::ConstIterator>> peak_matches;
-    for (auto db_it = db_spectrum.MZBegin(mz_lower_bound);
-         db_it != db_spectrum.MZEnd(mz_upper_bound); ++db_it)
+    // in principle, multiple DB peaks can match to the same exp. peak.
+    // Matches are kept as a flat list of (exp. peak index, DB peak), grouped by exp. peak below;
+    // this is called for every library candidate, so avoid a node-based container here.
+    vector<pair<Size, MSSpectrum::ConstIterator>> peak_matches;
+    const auto db_end = db_spectrum.MZEnd(mz_upper_bound);
+    for (auto db_it = db_spectrum.MZBegin(mz_lower_bound); db_it != db_end; ++db_it)
     {
       double db_mz = db_it->getMZ();
 
@@ -375,18 +378,28 @@ namespace OpenMS
       }
 
       Int index = exp_spectrum.findNearest(db_mz, mz_offset);
-      if (index >= 0) peak_matches[index].push_back(db_it);
+      if (index >= 0) peak_matches.emplace_back(index, db_it);
+    }
+    // the nearest exp. peak moves along with the DB m/z, so this is usually already sorted
+    if (!is_sorted(peak_matches.begin(), peak_matches.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; }))
+    {
+      stable_sort(peak_matches.begin(), peak_matches.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
     }
 
     double dot_product = 0.0;
-    for (const auto& match : peak_matches)
+    Size matched_ions_count = 0; // count obs. peaks only once
+    for (auto match_it = peak_matches.begin(); match_it != peak_matches.end(); )
     {
+      const Size exp_index = match_it->first;
       double db_intensity = 0.0;
-      for (const auto& db_it : match.second)
+      for (; match_it != peak_matches.end() && match_it->first == exp_index; ++match_it)
       {
-        db_intensity = max(db_intensity, double(db_it->getIntensity()));
+        db_intensity = max(db_intensity, double(match_it->second->getIntensity()));
       }
-      dot_product += db_intensity * exp_spectrum[match.first].getIntensity();
+      dot_product += db_intensity * exp_spectrum[exp_index].getIntensity();
+      ++matched_ions_count;
     }
 
     // return annotations for matching peaks?
@@ -394,25 +407,21 @@ namespace OpenMS
         !db_spectrum.getStringDataArrays().empty() &&
         !db_spectrum.getIntegerDataArrays().empty())
     {
+      // potentially add several annotations for the same peak if there are
+      // multiple matches for that peak:
       for (const auto& match : peak_matches)
       {
         const auto& exp_peak = exp_spectrum[match.first];
-        // potentially add several annotations for the same peak if there are
-        // multiple matches for that peak:
-        for (const auto& db_it : match.second)
-        {
-          PeptideHit::PeakAnnotation ann;
-          Size index = db_it - db_spectrum.begin();
-          ann.annotation = db_spectrum.getStringDataArrays()[0].at(index);
-          ann.charge = db_spectrum.getIntegerDataArrays()[0].at(index);
-          ann.mz = exp_peak.getMZ();
-          ann.intensity = exp_peak.getIntensity();
-          annotations->push_back(ann);
-        }
+        PeptideHit::PeakAnnotation ann;
+        Size index = match.second - db_spectrum.begin();
+        ann.annotation = db_spectrum.getStringDataArrays()[0].at(index);
+        ann.charge = db_spectrum.getIntegerDataArrays()[0].at(index);
+        ann.mz = exp_peak.getMZ();
+        ann.intensity = exp_peak.getIntensity();
+        annotations->push_back(ann);
       }
     }
 
-    Size matched_ions_count = peak_matches.size(); // count obs. peaks only once
     double matched_ions_term = 0.0;
 
     // return score 0 if too few matched ions
@@ -472,114 +481,134 @@ namespace OpenMS
     bool fragment_error_unit_ppm(true);
     if (mz_error_unit_ == "Da") { fragment_error_unit_ppm = false; }
 
-    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+    // query spectra are independent: match them in parallel and collect the results in input order
+    const bool positive_mode(ion_mode_ == "positive");
+    const bool negative_mode(ion_mode_ == "negative");
+    vector<vector<SpectralMatch>> results_per_spectrum(msexp.size());
+    vector<exception_ptr> errors(msexp.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize spec_idx = 0; spec_idx < (SignedSize)msexp.size(); ++spec_idx)
     {
-      // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
-
-      // iterate over all precursor masses
-      for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
+      vector<SpectralMatch>& spectrum_results = results_per_spectrum[spec_idx];
+      try
       {
-        // get precursor m/z
-        double precursor_mz(msexp[spec_idx].getPrecursors()[prec_idx].getMZ());
-
-        // cout << "precursor no. " << prec_idx << ": mz " << precursor_mz << " ";
-
-        double prec_mz_lowerbound, prec_mz_upperbound;
+        // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
 
-        if (!fragment_error_unit_ppm) // Da
+        // iterate over all precursor masses
+        for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
         {
-          prec_mz_lowerbound = precursor_mz - precursor_mz_error_;
-          prec_mz_upperbound = precursor_mz + precursor_mz_error_;
-        }
-        else // ppm
-        {
-          double ppm_offset(precursor_mz * 1e-6 * precursor_mz_error_);
-          prec_mz_lowerbound = precursor_mz - ppm_offset;
-          prec_mz_upperbound = precursor_mz + ppm_offset;
-        }
+          // get precursor m/z
+          double precursor_mz(msexp[spec_idx].getPrecursors()[prec_idx].getMZ());
 
-        // cout << "lower mz: " << prec_mz_lowerbound << " ";
-        // cout << "upper mz: " << prec_mz_upperbound << endl;
+          // cout << "precursor no. " << prec_idx << ": mz " << precursor_mz << " ";
 
-        vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
-        vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
+          double prec_mz_lowerbound, prec_mz_upperbound;
 
-        Size start_idx(lower_it - mz_keys.begin());
-        Size end_idx(upper_it - mz_keys.begin());
+          if (!fragment_error_unit_ppm) // Da
+          {
+            prec_mz_lowerbound = precursor_mz - precursor_mz_error_;
+            prec_mz_upperbound = precursor_mz + precursor_mz_error_;
+          }
+          else // ppm
+          {
+            double ppm_offset(precursor_mz * 1e-6 * precursor_mz_error_);
+            prec_mz_lowerbound = precursor_mz - ppm_offset;
+            prec_mz_upperbound = precursor_mz + ppm_offset;
+          }
 
-        //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
+          // cout << "lower mz: " << prec_mz_lowerbound << " ";
+          // cout << "upper mz: " << prec_mz_upperbound << endl;
 
-        vector<SpectralMatch> partial_results;
+          vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
+          vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
 
-        for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
-        {
-          // do spectral matching
-          // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
+          Size start_idx(lower_it - mz_keys.begin());
+          Size end_idx(upper_it - mz_keys.begin());
 
-          // check for charge state of precursor ions: do they match?
-          if ( (ion_mode_ == "positive" && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (ion_mode_ == "negative" && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
-          {
-            continue;
-          }
+          //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
 
-          double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], spec_db[search_idx], 0.0));
+          vector<SpectralMatch> partial_results;
 
-          // cout << " scored with " << hyperScore << endl;
-          if (hyperscore > 0)
+          for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
           {
-            // cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
-
-            // score result temporarily
-            SpectralMatch tmp_match;
-            tmp_match.setObservedPrecursorMass(precursor_mz);
-            tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
-            double obs_rt = floor(msexp[spec_idx].getRT() * 10)/10.0;
-            tmp_match.setObservedPrecursorRT(obs_rt);
-            tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
-            tmp_match.setMatchingScore(hyperscore);
-            tmp_match.setObservedSpectrumIndex(spec_idx);
-            tmp_match.setMatchingSpectrumIndex(search_idx);
-
-            tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
-            tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
-            tmp_match.setSumFormula(spec_db[search_idx].getMetaValue("Sum_Formula"));
-            tmp_match.setCommonName(spec_db[search_idx].getMetaValue("Metabolite_Name"));
-            tmp_match.setInchiString(spec_db[search_idx].getMetaValue("Inchi_String"));
-            tmp_match.setSMILESString(spec_db[search_idx].getMetaValue("SMILES_String"));
-            tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue("Precursor_Ion"));
-
-            partial_results.push_back(tmp_match);
+            // do spectral matching
+            // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
+
+            // check for charge state of precursor ions: do they match?
+            if ( (positive_mode && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (negative_mode && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
+            {
+              continue;
+            }
+
+            double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], spec_db[search_idx], 0.0));
+
+            // cout << " scored with " << hyperScore << endl;
+            if (hyperscore > 0)
+            {
+              // cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
+
+              // score result temporarily
+              SpectralMatch tmp_match;
+              tmp_match.setObservedPrecursorMass(precursor_mz);
+              tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
+              double obs_rt = floor(msexp[spec_idx].getRT() * 10)/10.0;
+              tmp_match.setObservedPrecursorRT(obs_rt);
+              tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
+              tmp_match.setMatchingScore(hyperscore);
+              tmp_match.setObservedSpectrumIndex(spec_idx);
+              tmp_match.setMatchingSpectrumIndex(search_idx);
+
+              tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
+              tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
+              tmp_match.setSumFormula(spec_db[search_idx].getMetaValue("Sum_Formula"));
+              tmp_match.setCommonName(spec_db[search_idx].getMetaValue("Metabolite_Name"));
+              tmp_match.setInchiString(spec_db[search_idx].getMetaValue("Inchi_String"));
+              tmp_match.setSMILESString(spec_db[search_idx].getMetaValue("SMILES_String"));
+              tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue("Precursor_Ion"));
+
+              partial_results.push_back(tmp_match);
+            }
           }
-        }
 
-        // sort results by decreasing store
-        sort(partial_results.begin(), partial_results.end(), SpectralMatchScoreGreater);
+          // sort results by decreasing store
+          sort(partial_results.begin(), partial_results.end(), SpectralMatchScoreGreater);
 
-        // report mode: top3 or best?
-        if (report_mode_ == "top3")
-        {
-          Size num_results(partial_results.size());
+          // report mode: top3 or best?
+          if (report_mode_ == "top3")
+          {
+            Size num_results(partial_results.size());
 
-          Size last_result_idx = (num_results >= 3) ? 3 : num_results;
+            Size last_result_idx = (num_results >= 3) ? 3 : num_results;
 
-          for (Size result_idx = 0; result_idx < last_result_idx; ++result_idx)
-          {
-            // cout << "score: " << partial_results[result_idx].getMatchingScore() << " " << partial_results[result_idx].getMatchingSpectrumIndex() << endl;
-            matching_results.push_back(partial_results[result_idx]);
+            for (Size result_idx = 0; result_idx < last_result_idx; ++result_idx)
+            {
+              // cout << "score: " << partial_results[result_idx].getMatchingScore() << " " << partial_results[result_idx].getMatchingSpectrumIndex() << endl;
+              spectrum_results.push_back(partial_results[result_idx]);
+            }
           }
-        }
 
-        if (report_mode_ == "best")
-        {
-          if (!partial_results.empty())
+          if (report_mode_ == "best")
           {
-            matching_results.push_back(partial_results[0]);
+            if (!partial_results.empty())
+            {
+              spectrum_results.push_back(partial_results[0]);
+            }
           }
-        }
 
-      } // end precursor loop
+        } // end precursor loop
+      }
+      catch (...)
+      {
+        errors[spec_idx] = current_exception();
+      }
     } // end spectra loop
 
+    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+    {
+      if (errors[spec_idx]) rethrow_exception(errors[spec_idx]);
+      matching_results.insert(matching_results.end(), results_per_spectrum[spec_idx].begin(), results_per_spectrum[spec_idx].end());
+    }
+
     // write final results to MzTab
     exportMzTab_(matching_results, mztab_out);
   }
@@ -38,10 +38,13 @@
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
 #include <OpenMS/CONCEPT/EnumHelpers.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 
+#include <algorithm>
 #include <atomic>
+#include <fstream>
 #include <map>
 #include <array>
 
@@ -165,6 +168,65 @@ using namespace std;
   };
 
 
+  // internal k-mer prefilter (not exported): skips proteins which cannot contain any peptide
+  // Only exact (i.e. without false negatives) if matching without mismatches; ambiguous AAs are handled conservatively.
+  struct KmerPrefilter
+  {
+    static constexpr Size K = 5;
+
+    /// encode an AA as 0..25; ambiguous AAs (B, J, Z, X) and other characters cannot be encoded (-1)
+    static int encode(const char c)
+    {
+      if (c < 'A' || c > 'Z' || c == 'B' || c == 'J' || c == 'Z' || c == 'X') return -1;
+      return c - 'A';
+    }
+
+    /// add the first K AAs of a needle; disables the filter if that is not possible
+    void addNeedle(const String& needle)
+    {
+      if (!enabled) return;
+      Size code(0);
+      if (needle.size() < K)
+      {
+        enabled = false;
+        return;
+      }
+      for (Size i = 0; i < K; ++i)
+      {
+        const int c = encode(needle[i]);
+        if (c < 0)
+        {
+          enabled = false;
+          return;
+        }
+        code = code * 26 + c;
+      }
+      if (prefixes.empty()) prefixes.resize(26 * 26 * 26 * 26 * 26);
+      prefixes[code] = true;
+    }
+
+    /// false only if none of the needles can start anywhere in @p prot
+    bool mayContainPeptide(const String& prot) const
+    {
+      if (!enabled || prefixes.empty()) return true;
+      Size code(0), valid(0);
+      const Size mod = 26 * 26 * 26 * 26; // 26^(K-1)
+      for (const char aa : prot)
+      {
+        const int c = encode(aa);
+        if (c < 0) return true; // an ambiguous AA may match anything
+        code = (code % mod) * 26 + c;
+        if (++valid >= K && prefixes[code]) return true;
+      }
+      return false;
+    }
+
+    bool enabled{true};
+    std::vector<bool> prefixes;
+  };
+
+  const char TRIE_CACHE_MAGIC[8] = {'O', 'M', 'S', 'P', 'I', 'T', 'R', 'I'};
+
   // free function (not exported) used to add hits
   void search(ACTrie& trie, ACTrieState& state, const String& prot, const String& full_prot, size_t prot_offset, Hit::T idx_prot, 
               FoundProteinFunctor& func_threads, const bool allow_nterm_protein_cleavage)
@@ -249,6 +311,8 @@ using namespace std;
     defaults_.setValue("allow_nterm_protein_cleavage", "true", "Allow the protein N-terminus amino acid to clip.");
     defaults_.setValidStrings("allow_nterm_protein_cleavage", { "true", "false" });
 
+    defaults_.setValue("trie_cache", "", "Binary file to store the compressed peptide trie in (or load it from, if it was built from the same peptides before). Saves the time for building the trie when the same identifications are mapped to several databases. Empty: no caching.", {"advanced"});
+
     defaultsToParam_();
   }
 
@@ -271,6 +335,7 @@ using namespace std;
     aaa_max_ = static_cast<Int>(param_.getValue("aaa_max"));
     mm_max_ = static_cast<Int>(param_.getValue("mismatches_max"));
     allow_nterm_protein_cleavage_ = param_.getValue("allow_nterm_protein_cleavage").toBool();
+    trie_cache_ = param_.getValue("trie_cache").toString();
   }
 
 PeptideIndexing::ExitCodes PeptideIndexing::run(std::vector<FASTAFile::FASTAEntry>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids)
@@ -289,6 +354,11 @@ PeptideIndexing::ExitCodes PeptideIndexing::run(FASTAContainer<TFI_Vector>& prot
   return run_<TFI_Vector>(proteins, prot_ids, pep_ids);
 }
 
+PeptideIndexing::ExitCodes PeptideIndexing::run(FASTAContainer<TFI_Indexed>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids)
+{
+  return run_<TFI_Indexed>(proteins, prot_ids, pep_ids);
+}
+
 const String& PeptideIndexing::getDecoyString() const
 {
   return decoy_string_;
@@ -431,39 +501,108 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
     */
     ACTrie ac_trie(aaa_max_, mm_max_);
     SysInfo::MemUsage mu;
-    OPENMS_LOG_INFO << "Building trie ...";
     StopWatch s;
     s.start();
+    //
+    // Warning:
+    // do not skip over peptides here, since the results are iterated in the same way
+    //
+    auto needle_of = [this](const PeptideHit& hit)
+    {
+      String seq = hit.getSequence().toUnmodifiedString().remove('*'); // make a copy, i.e. do NOT change the peptide sequence!
+      if (IL_equivalent_)                                              // convert L to I;
+      {
+        seq.substitute('L', 'I');
+      }
+      return seq;
+    };
     bool peptide_has_X {false}; // if any peptide contains an 'X', we switch off protein-X splitting (see below)
+    KmerPrefilter prefilter;
+    prefilter.enabled = (mm_max_ == 0);
+    // FNV-1a hash over all needles (identifies a cached trie)
+    UInt64 needle_hash = 14695981039346656037ULL;
+    Size needle_count(0);
     for (const auto& pep : pep_ids)
     {
       for (const auto& hit : pep.getHits())
       {
-        //
-        // Warning:
-        // do not skip over peptides here, since the results are iterated in the same way
-        //
-        String seq = hit.getSequence().toUnmodifiedString().remove('*'); // make a copy, i.e. do NOT change the peptide sequence!
-        if (IL_equivalent_)                                              // convert L to I;
+        const String seq = needle_of(hit);
+        peptide_has_X |= seq.has('X');
+        prefilter.addNeedle(seq);
+        for (const char c : seq)
         {
-          seq.substitute('L', 'I');
+          needle_hash ^= (unsigned char)c;
+          needle_hash *= 1099511628211ULL;
         }
-        peptide_has_X |= seq.has('X');
-        ac_trie.addNeedle(seq);
+        needle_hash ^= 0xFF; // separator
+        needle_hash *= 1099511628211ULL;
+        ++needle_count;
       }
     }
-    s.stop();
-    OPENMS_LOG_INFO << " done (" << int(s.getClockTime()) << "s)" << std::endl;
-    if (ac_trie.getNeedleCount() == 0)
-    { // Aho-Corasick will crash if given empty needles as input
-      OPENMS_LOG_WARN << "Warning: Peptide identifications have no hits inside! Output will be empty as well." << std::endl;
-      return PEPTIDE_IDS_EMPTY;
+    if (peptide_has_X) prefilter.enabled = false;
+    const String cache_key = "needles=" + String(needle_count) + ":" + String(needle_hash) + ";IL_equivalent=" + String(IL_equivalent_);
+
+    bool trie_loaded(false);
+    if (!trie_cache_.empty() && File::exists(trie_cache_))
+    {
+      std::ifstream is(trie_cache_.c_str(), std::ios::binary);
+      char magic[sizeof(TRIE_CACHE_MAGIC)];
+      UInt64 key_size(0);
+      if (is.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), TRIE_CACHE_MAGIC)
+        && is.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)) && key_size == cache_key.size())
+      {
+        std::string key(key_size, '\0');
+        trie_loaded = is.read(&key[0], key_size) && key == cache_key && ac_trie.load(is);
+      }
+      if (trie_loaded)
+      { // limits are not part of the key; use the current ones
+        ac_trie.setMaxAAACount(aaa_max_);
+        ac_trie.setMaxMMCount(mm_max_);
+        OPENMS_LOG_INFO << "Loaded trie from cache file '" << trie_cache_ << "'." << std::endl;
+      }
+      else
+      {
+        OPENMS_LOG_INFO << "Trie cache file '" << trie_cache_ << "' does not match the input peptides. Rebuilding it." << std::endl;
+      }
+    }
+
+    if (!trie_loaded)
+    {
+      OPENMS_LOG_INFO << "Building trie ...";
+      for (const auto& pep : pep_ids)
+      {
+        for (const auto& hit : pep.getHits())
+        {
+          ac_trie.addNeedle(needle_of(hit));
+        }
+      }
+      s.stop();
+      OPENMS_LOG_INFO << " done (" << int(s.getClockTime()) << "s)" << std::endl;
+      if (ac_trie.getNeedleCount() == 0)
+      { // Aho-Corasick will crash if given empty needles as input
+        OPENMS_LOG_WARN << "Warning: Peptide identifications have no hits inside! Output will be empty as well." << std::endl;
+        return PEPTIDE_IDS_EMPTY;
+      }
+      s.start();
+      OPENMS_LOG_INFO << "Compressing trie to BFS format ..." << std::endl;
+      ac_trie.compressTrie();
+      s.stop();
+      OPENMS_LOG_INFO << " done (" << int(s.getClockTime()) << "s)" << std::endl;
+
+      if (!trie_cache_.empty())
+      {
+        std::ofstream os(trie_cache_.c_str(), std::ios::binary);
+        const UInt64 key_size = cache_key.size();
+        os.write(TRIE_CACHE_MAGIC, sizeof(TRIE_CACHE_MAGIC));
+        os.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+        os.write(cache_key.c_str(), key_size);
+        ac_trie.store(os);
+        if (!os)
+        {
+          OPENMS_LOG_WARN << "Warning: Could not write trie cache file '" << trie_cache_ << "'." << std::endl;
+        }
+      }
     }
-    s.start();
-    OPENMS_LOG_INFO << "Compressing trie to BFS format ..." << std::endl;
-    ac_trie.compressTrie();
-    s.stop();
-    OPENMS_LOG_INFO << " done (" << int(s.getClockTime()) << "s)" << std::endl;
     s.reset();
     OPENMS_LOG_INFO << "Mapping " << ac_trie.getNeedleCount() << " peptides to " << (proteins.size() == PROTEIN_CACHE_SIZE ? "? (unknown number of)" : String(proteins.size())) << " proteins."
                     << std::endl;
@@ -477,6 +616,7 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
     this->startProgress(0, proteins.size() == PROTEIN_CACHE_SIZE ? std::numeric_limits<SignedSize>::max() : proteins.size(), "Aho-Corasick");
     std::atomic<int> progress_prots(0);
     
+    // hits are collected in thread-local buffers (no locking while searching) and merged once at the end
     #pragma omp parallel
     {
       FoundProteinFunctor func_threads(enzyme, xtandem_fix_parameters);
@@ -544,6 +684,9 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
             }
           }
 
+          // no peptide can start anywhere in this protein?
+          if (!prefilter.mayContainPeptide(prot)) continue;
+
           const Hit::T prot_idx = Hit::T(i + proteins.getChunkOffset());
           
           // grab #hits before searching protein; we know its a hit if this number changes
@@ -581,21 +724,22 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
             acc_to_prot_thread[protein_accessions[prot_idx]] = prot_idx;
           }
         } // end parallel FOR
-
-        // join results
-        #pragma omp critical(PeptideIndexer_joinAC)
-        {
-          s.start();
-          // hits
-          func.merge(func_threads);
-          // sort hits by peptide index
-          std::sort(func.pep_to_prot.begin(), func.pep_to_prot.end());
-          // accession -> index
-          acc_to_prot.insert(acc_to_prot_thread.begin(), acc_to_prot_thread.end());
-          acc_to_prot_thread.clear();
-          s.stop();
-        } // OMP end critical
       } // end readChunk
+
+      // sort thread-local hits by peptide index (in parallel), then join them
+      std::sort(func_threads.pep_to_prot.begin(), func_threads.pep_to_prot.end());
+      #pragma omp critical(PeptideIndexer_joinAC)
+      {
+        s.start();
+        const Size old_size = func.pep_to_prot.size();
+        // hits
+        func.merge(func_threads);
+        // both ranges are sorted; the result does not depend on the order in which threads arrive
+        std::inplace_merge(func.pep_to_prot.begin(), func.pep_to_prot.begin() + old_size, func.pep_to_prot.end());
+        // accession -> index
+        acc_to_prot.insert(acc_to_prot_thread.begin(), acc_to_prot_thread.end());
+        s.stop();
+      } // OMP end critical
     } // OMP end parallel
     this->endProgress();
     std::cout << "Merge took: " << s.toString() << "\n";
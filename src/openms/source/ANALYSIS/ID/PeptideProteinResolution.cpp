@@ -329,13 +329,13 @@ namespace OpenMS
       const vector<PeptideHit>& hits = pep_it->getHits();
       if (!hits.empty())
       {
-        PeptideHit best_hit = hits[0];
-        const vector<PeptideEvidence> pepev = best_hit.getPeptideEvidences();
+        const PeptideHit& best_hit = hits[0];
+        const vector<PeptideEvidence>& pepev = best_hit.getPeptideEvidences();
 
         for (vector<PeptideEvidence>::const_iterator pepev_it = pepev.begin();
              pepev_it != pepev.end(); ++pepev_it)
         {
-          String acc = pepev_it->getProteinAccession();
+          const String& acc = pepev_it->getProteinAccession();
           auto found = prot_acc_to_indist_prot_grp_.find(acc);
           if (found == prot_acc_to_indist_prot_grp_.end())
           {
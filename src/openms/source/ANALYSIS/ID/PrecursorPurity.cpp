@@ -36,12 +36,41 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Same result as MSSpectrum::findNearest(mz, tolerance), on a plain m/z-sorted peak vector
+    Int findNearestPeak(const std::vector<Peak1D>& peaks, double mz, double tolerance)
+    {
+      if (peaks.empty())
+      {
+        return -1;
+      }
+      auto it = std::lower_bound(peaks.begin(), peaks.end(), mz, Peak1D::MZLess());
+      if (it == peaks.end())
+      {
+        --it;
+      }
+      else if (it != peaks.begin() && !(std::fabs(it->getMZ() - mz) < std::fabs((it - 1)->getMZ() - mz)))
+      { // the peak before is at least as close
+        --it;
+      }
+      const double found_mz = it->getMZ();
+      if (found_mz >= mz - tolerance && found_mz <= mz + tolerance)
+      {
+        return static_cast<Int>(it - peaks.begin());
+      }
+      return -1;
+    }
+  }
 
   PrecursorPurity::PurityScores PrecursorPurity::computePrecursorPurity(const PeakSpectrum& ms1, const Precursor& pre, const double precursor_mass_tolerance, const bool precursor_mass_tolerance_unit_ppm)
   {
@@ -56,12 +85,8 @@ namespace OpenMS
     auto lower_it = ms1.MZBegin(lower);
     auto upper_it = ms1.MZEnd(upper);
 
-    PeakSpectrum isolated_window;
-    while (lower_it != upper_it)
-    {
-      isolated_window.push_back(*lower_it);
-      lower_it++;
-    }
+    // plain peak copy of the window (no spectrum meta data); matched isotope peaks are removed from it below
+    std::vector<Peak1D> isolated_window(lower_it, upper_it);
 
     // total intensity in isolation window
     double total_intensity(0);
@@ -98,7 +123,7 @@ namespace OpenMS
       {
         break;
       }
-      int next_iso_index = isolated_window.findNearest(next_peak, precursor_tolerance_abs);
+      int next_iso_index = findNearestPeak(isolated_window, next_peak, precursor_tolerance_abs);
       if (next_iso_index != -1)
       {
         target_intensity += isolated_window[next_iso_index].getIntensity();
@@ -145,6 +170,8 @@ namespace OpenMS
     std::map<String, PrecursorPurity::PurityScores> purityscores;
     std::pair<std::map<String, PrecursorPurity::PurityScores>::iterator, bool> insert_return_value;
     int spectra_size = static_cast<int>(spectra.size());
+    // parent MS1 spectrum of every MS2 spectrum, looked up once during validation
+    std::vector<PeakMap::ConstIterator> parent_spectra(spectra.size(), spectra.end());
 
     if (spectra[0].getMSLevel() != 1)
     {
@@ -162,6 +189,7 @@ namespace OpenMS
           OPENMS_LOG_WARN << "Warning: Input data not suitable for Precursor Purity computation. An MS2 spectrum without parent spectrum detected. Precursor Purity info will not be calculated!\n";
           return std::map<String, PrecursorPurity::PurityScores>();
         }
+        parent_spectra[i] = parent_spectrum_it;
         if (spectra[i].getNativeID().empty())
         {
           OPENMS_LOG_WARN << "Warning: Input data not suitable for Precursor Purity computation. Spectrum without an ID. Precursor Purity info will not be calculated!\n";
@@ -178,21 +206,24 @@ namespace OpenMS
       }
     }
 
+    std::vector<PrecursorPurity::PurityScores> scores(spectra.size());
 #pragma omp parallel for schedule(guided)
     for (int i = 0; i < spectra_size; ++i)
     {
       if (spectra[i].getMSLevel() == 2)
       {
-        auto parent_spectrum_it = spectra.getPrecursorSpectrum(spectra.begin()+i);
-        PrecursorPurity::PurityScores score = PrecursorPurity::computePrecursorPurity((*parent_spectrum_it), spectra[i].getPrecursors()[0], precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
-
-#pragma omp critical (purityscores_access)
-        {
-          // replace the initialized values
-          purityscores[spectra[i].getNativeID()] = score;
-        }
+        scores[i] = PrecursorPurity::computePrecursorPurity((*parent_spectra[i]), spectra[i].getPrecursors()[0], precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
       } // end of MS2 spectrum
     } // end of parallelized spectra loop
+
+    // replace the initialized values
+    for (int i = 0; i < spectra_size; ++i)
+    {
+      if (spectra[i].getMSLevel() == 2)
+      {
+        purityscores[spectra[i].getNativeID()] = scores[i];
+      }
+    }
     return purityscores;
   } // end of function def
 
@@ -34,6 +34,7 @@
 
 #include <OpenMS/ANALYSIS/ID/SimpleSearchEngineAlgorithm.h>
 
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
 #include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
 #include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
 #include <OpenMS/CHEMISTRY/DecoyGenerator.h>
@@ -46,12 +47,9 @@
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/DATASTRUCTURES/Param.h>
 #include <OpenMS/DATASTRUCTURES/StringView.h>
-#include <OpenMS/FILTERING/DATAREDUCTION/Deisotoper.h>
 #include <OpenMS/FILTERING/ID/IDFilter.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/ThresholdMower.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/SpectrumPreprocessingPipeline.h>
+#include <OpenMS/FORMAT/CachedPeptideDatabase.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -141,11 +139,20 @@ namespace OpenMS
     defaults_.setValue("peptide:max_size", 40, "Maximum size a peptide must have after digestion to be considered in the search (0 = disabled).");
     defaults_.setValue("peptide:missed_cleavages", 1, "Number of missed cleavages.");
     defaults_.setValue("peptide:motif", "", "If set, only peptides that contain this motif (provided as RegEx) will be considered.");
+    defaults_.setValue("peptide:database_cache", "", "Optional file storing the digested peptide database. It is created if it does not exist or stems from a different database or digestion/modification settings, and reused otherwise.");
     defaults_.setSectionDescription("peptide", "Peptide Options");
 
     defaults_.setValue("report:top_hits", 1, "Maximum number of top scoring hits per spectrum that are reported.");
     defaults_.setSectionDescription("report", "Reporting Options");
 
+    defaults_.setValue("fragment_index:enabled", "false", "Preselect the candidates of each spectrum with a fragment ion index before scoring. Recommended for wide precursor mass windows (e.g. open modification searches with a precursor mass tolerance of several hundred Da).");
+    defaults_.setValidStrings("fragment_index:enabled", {"true","false"} );
+    defaults_.setValue("fragment_index:min_shared_fragments", 3, "Minimum number of fragments a candidate needs to share with a spectrum to be scored.");
+    defaults_.setMinInt("fragment_index:min_shared_fragments", 1);
+    defaults_.setValue("fragment_index:max_candidates", 50, "Maximum number of candidates (with the most shared fragments) scored per spectrum and precursor mass (0 = all).");
+    defaults_.setMinInt("fragment_index:max_candidates", 0);
+    defaults_.setSectionDescription("fragment_index", "Fragment Ion Index Options");
+
     defaultsToParam_();
   }
 
@@ -187,58 +194,43 @@ namespace OpenMS
     peptide_max_size_ = param_.getValue("peptide:max_size");
     peptide_missed_cleavages_ = param_.getValue("peptide:missed_cleavages");
     peptide_motif_ = param_.getValue("peptide:motif").toString();
+    database_cache_ = param_.getValue("peptide:database_cache").toString();
 
     report_top_hits_ = param_.getValue("report:top_hits");
 
     decoys_ = param_.getValue("decoys") == "true";
     annotate_psm_ = ListUtils::toStringList<std::string>(param_.getValue("annotate:PSM"));
+
+    fragment_index_ = param_.getValue("fragment_index:enabled") == "true";
+    fragment_index_min_shared_fragments_ = (Int)param_.getValue("fragment_index:min_shared_fragments");
+    fragment_index_max_candidates_ = (Int)param_.getValue("fragment_index:max_candidates");
   }
 
   // static
   void SimpleSearchEngineAlgorithm::preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm)
   {
-    // filter MS2 map
-    // remove 0 intensities
-    ThresholdMower threshold_mower_filter;
-    threshold_mower_filter.filterPeakMap(exp);
-
-    Normalizer normalizer;
-    normalizer.filterPeakMap(exp);
+    // filter MS2 map: remove low intensities, normalize, deisotope and remove noise in one pass per spectrum
+    SpectrumPreprocessingPipeline pipeline;
+    Param pipeline_param = pipeline.getParameters();
+    pipeline_param.setValue("steps", std::vector<std::string>{"threshold", "normalize", "deisotope", "window_mower", "nlargest"});
+    pipeline_param.setValue("deisotope:fragment_tolerance", fragment_mass_tolerance);
+    pipeline_param.setValue("deisotope:fragment_unit", fragment_mass_tolerance_unit_ppm ? "ppm" : "Da");
+    pipeline_param.setValue("deisotope:min_charge", 1);
+    pipeline_param.setValue("deisotope:max_charge", 3);
+    pipeline_param.setValue("deisotope:keep_only_deisotoped", "false");
+    pipeline_param.setValue("deisotope:min_isopeaks", 3);
+    pipeline_param.setValue("deisotope:max_isopeaks", 10);
+    pipeline_param.setValue("deisotope:make_single_charged", "true"); // convert fragment m/z to mono-charge
+    pipeline_param.setValue("window_mower:windowsize", 100.0);
+    pipeline_param.setValue("window_mower:peakcount", 20);
+    pipeline_param.setValue("nlargest:n", 400);
+    pipeline.setParameters(pipeline_param);
 
     // sort by rt
     exp.sortSpectra(false);
 
-    // filter settings
-    WindowMower window_mower_filter;
-    Param filter_param = window_mower_filter.getParameters();
-    filter_param.setValue("windowsize", 100.0, "The size of the sliding window along the m/z axis.");
-    filter_param.setValue("peakcount", 20, "The number of peaks that should be kept.");
-    filter_param.setValue("movetype", "jump", "Whether sliding window (one peak steps) or jumping window (window size steps) should be used.");
-    window_mower_filter.setParameters(filter_param);
-
-    NLargest nlargest_filter = NLargest(400);
-
-#pragma omp parallel for default(none) shared(exp, fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, window_mower_filter, nlargest_filter)
-    for (SignedSize exp_index = 0; exp_index < (SignedSize)exp.size(); ++exp_index)
-    {
-      // sort by mz
-      exp[exp_index].sortByPosition();
-
-      // deisotope
-      Deisotoper::deisotopeAndSingleCharge(exp[exp_index], 
-        fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm, 
-        1, 3,   // min / max charge 
-        false,  // keep only deisotoped
-        3, 10,  // min / max isopeaks 
-        true);  // convert fragment m/z to mono-charge
-
-      // remove noise
-      window_mower_filter.filterPeakSpectrum(exp[exp_index]);
-      nlargest_filter.filterPeakSpectrum(exp[exp_index]);
-
-      // sort (nlargest changes order)
-      exp[exp_index].sortByPosition();
-    }
+    // spectra are sorted by m/z afterwards
+    pipeline.filterPeakMap(exp);
   }
 
 void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp, 
@@ -418,6 +410,370 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     protein_ids[0].setSearchParameters(std::move(search_parameters));
   }
 
+  void SimpleSearchEngineAlgorithm::searchFragmentIndex_(const PeakMap& spectra,
+    const multimap<double, Size>& multimap_mass_2_scan_index,
+    const vector<FASTAFile::FASTAEntry>& fasta_db,
+    const ProteaseDigestion& digestor,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    vector<vector<AnnotatedHit_> >& annotated_hits) const
+  {
+    boost::regex peptide_motif_regex(peptide_motif_);
+
+    bool precursor_mass_tolerance_unit_ppm = (precursor_mass_tolerance_unit_ == "ppm");
+    bool fragment_mass_tolerance_unit_ppm = (fragment_mass_tolerance_unit_ == "ppm");
+
+    // digest all proteins
+    startProgress(0, fasta_db.size(), "Digesting proteins...");
+    vector<vector<StringView> > digests(fasta_db.size());
+    Size count_proteins(0);
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
+    {
+      #pragma omp atomic
+      ++count_proteins;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_proteins);
+      }
+
+      digestor.digestUnmodified(fasta_db[fasta_index].sequence, digests[fasta_index], peptide_min_size_, peptide_max_size_);
+    }
+    endProgress();
+
+    // keep the first occurrence of each peptide (in database order, so the index is independent of the number of threads)
+    set<StringView> processed_peptides;
+    vector<StringView> peptides;
+    for (auto& digest : digests)
+    {
+      for (const auto& c : digest)
+      {
+        const String current_peptide = c.getString();
+        if (current_peptide.find_first_of("XBZ") != std::string::npos)
+        {
+          continue;
+        }
+
+        // if a peptide motif is provided skip all peptides without match
+        if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex))
+        {
+          continue;
+        }
+
+        if (processed_peptides.insert(c).second)
+        {
+          peptides.push_back(c);
+        }
+      }
+      vector<StringView>().swap(digest);
+    }
+
+    // generate all modified variants and their fragments
+    startProgress(0, peptides.size(), "Building fragment ion index...");
+    vector<vector<AASequence> > modified_peptides(peptides.size());
+    vector<vector<vector<double> > > fragment_mzs(peptides.size());
+    Size count_peptides(0);
+#pragma omp parallel for schedule(dynamic, 1000)
+    for (SignedSize peptide_index = 0; peptide_index < (SignedSize)peptides.size(); ++peptide_index)
+    {
+      #pragma omp atomic
+      ++count_peptides;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_peptides);
+      }
+
+      // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
+      #pragma omp critical (residuedb_access)
+      {
+        AASequence aas = AASequence::fromString(peptides[peptide_index].getString());
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, modified_peptides[peptide_index]);
+      }
+
+      for (const AASequence& candidate : modified_peptides[peptide_index])
+      {
+        // b and y ions with charge 1 (the same positions as in the theoretical spectra used for scoring)
+        vector<double> mzs;
+        TheoreticalSpectrumGenerator::getFragmentMZs<false, true, false, false, true, false>(mzs, candidate, 1, true);
+        fragment_mzs[peptide_index].push_back(std::move(mzs));
+      }
+    }
+
+    // candidate (index in the fragment index) to peptide and modified variant
+    FragmentIndex fragment_index;
+    vector<pair<Size, SignedSize> > candidates;
+    for (Size peptide_index = 0; peptide_index != peptides.size(); ++peptide_index)
+    {
+      for (Size mod_pep_idx = 0; mod_pep_idx != modified_peptides[peptide_index].size(); ++mod_pep_idx)
+      {
+        fragment_index.addPeptide(modified_peptides[peptide_index][mod_pep_idx].getMonoWeight(), fragment_mzs[peptide_index][mod_pep_idx]);
+        candidates.emplace_back(peptide_index, (SignedSize)mod_pep_idx);
+      }
+      vector<vector<double> >().swap(fragment_mzs[peptide_index]);
+    }
+    fragment_index.build();
+    endProgress();
+
+    OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
+    OPENMS_LOG_INFO << "Peptides: " << peptides.size() << endl;
+    OPENMS_LOG_INFO << "Indexed candidates: " << fragment_index.size() << endl;
+    OPENMS_LOG_INFO << "Indexed fragments: " << fragment_index.getNumberOfFragments() << endl;
+
+    // precursor masses (optionally corrected for misassignment) of each spectrum
+    vector<vector<double> > scan_precursor_masses(spectra.size());
+    for (const auto& m : multimap_mass_2_scan_index)
+    {
+      scan_precursor_masses[m.second].push_back(m.first);
+    }
+
+    startProgress(0, spectra.size(), "Scoring peptide models against spectra...");
+    Size count_spectra(0);
+#pragma omp parallel for schedule(dynamic, 10)
+    for (SignedSize scan_index = 0; scan_index < (SignedSize)spectra.size(); ++scan_index)
+    {
+      #pragma omp atomic
+      ++count_spectra;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_spectra);
+      }
+
+      if (scan_precursor_masses[scan_index].empty()) { continue; }
+
+      const PeakSpectrum& exp_spectrum = spectra[scan_index];
+      vector<double> peak_mzs;
+      peak_mzs.reserve(exp_spectrum.size());
+      for (const auto& p : exp_spectrum) { peak_mzs.push_back(p.getMZ()); }
+
+      // collect the best candidates of all precursor masses (the same as the mass window of the regular search)
+      vector<Size> candidate_indices;
+      vector<FragmentIndex::Hit> hits;
+      for (double precursor_mass : scan_precursor_masses[scan_index])
+      {
+        double min_mass, max_mass;
+        if (precursor_mass_tolerance_unit_ppm) // ppm
+        {
+          min_mass = precursor_mass / (1.0 + precursor_mass_tolerance_ * 1e-6);
+          max_mass = precursor_mass / (1.0 - precursor_mass_tolerance_ * 1e-6);
+        }
+        else // Dalton
+        {
+          min_mass = precursor_mass - precursor_mass_tolerance_;
+          max_mass = precursor_mass + precursor_mass_tolerance_;
+        }
+        fragment_index.query(peak_mzs, min_mass, max_mass, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm,
+          fragment_index_min_shared_fragments_, fragment_index_max_candidates_, hits);
+        for (const auto& h : hits) { candidate_indices.push_back(h.peptide_index); }
+      }
+      std::sort(candidate_indices.begin(), candidate_indices.end());
+      candidate_indices.erase(std::unique(candidate_indices.begin(), candidate_indices.end()), candidate_indices.end());
+
+      // b and y ions with charge 1 of all candidates, scored in one batch against the spectrum
+      vector<vector<TheoreticalSpectrumGenerator::FragmentIon> > candidate_ions(candidate_indices.size());
+      for (Size i = 0; i != candidate_indices.size(); ++i)
+      {
+        const Size candidate_index = candidate_indices[i];
+        const AASequence& candidate = modified_peptides[candidates[candidate_index].first][candidates[candidate_index].second];
+        TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(candidate_ions[i], candidate, 1, true);
+      }
+      vector<double> scores;
+      vector<HyperScore::PSMDetail> details;
+      HyperScore::computeBatch(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, candidate_ions, scores, details);
+
+      // each spectrum is processed by one thread only, so no locking is required
+      vector<AnnotatedHit_>& scan_hits = annotated_hits[scan_index];
+      for (Size i = 0; i != candidate_indices.size(); ++i)
+      {
+        const double score = scores[i];
+        if (score == 0)
+        {
+          continue; // no hit?
+        }
+
+        const Size candidate_index = candidate_indices[i];
+        const StringView& c = peptides[candidates[candidate_index].first];
+        const HyperScore::PSMDetail& detail = details[i];
+
+        // add peptide hit
+        AnnotatedHit_ ah;
+        ah.sequence = c;
+        ah.peptide_mod_index = candidates[candidate_index].second;
+        ah.score = score;
+        ah.prefix_fraction = (double)detail.matched_b_ions/(double)c.size();
+        ah.suffix_fraction = (double)detail.matched_y_ions/(double)c.size();
+        ah.mean_error = detail.mean_error;
+        scan_hits.push_back(ah);
+
+        // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
+        if (scan_hits.size() >= 2 * report_top_hits_)
+        {
+          std::partial_sort(scan_hits.begin(), scan_hits.begin() + report_top_hits_, scan_hits.end(), AnnotatedHit_::hasBetterScore);
+          scan_hits.resize(report_top_hits_);
+        }
+      }
+    }
+    endProgress();
+  }
+
+  void SimpleSearchEngineAlgorithm::searchPeptideDatabase_(const PeakMap& spectra,
+    const multimap<double, Size>& multimap_mass_2_scan_index,
+    const CachedPeptideDatabase& peptide_db,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    vector<vector<AnnotatedHit_> >& annotated_hits) const
+  {
+    bool precursor_mass_tolerance_unit_ppm = (precursor_mass_tolerance_unit_ == "ppm");
+    bool fragment_mass_tolerance_unit_ppm = (fragment_mass_tolerance_unit_ == "ppm");
+
+    // create spectrum generator
+    TheoreticalSpectrumGenerator spectrum_generator;
+    Param param(spectrum_generator.getParameters());
+    param.setValue("add_first_prefix_ion", "true");
+    param.setValue("add_metainfo", "true");
+    spectrum_generator.setParameters(param);
+
+#ifdef _OPENMP
+    // we want to do locking at the spectrum level so we get good parallelization
+    vector<omp_lock_t> annotated_hits_lock(annotated_hits.size());
+    for (size_t i = 0; i != annotated_hits_lock.size(); i++)
+    {
+      omp_init_lock(&(annotated_hits_lock[i]));
+    }
+#endif
+
+    // returns the MS2 precursors that match to a peptide mass
+    auto matching_precursors = [&](double current_peptide_mass)
+    {
+      if (precursor_mass_tolerance_unit_ppm) // ppm
+      {
+        return make_pair(multimap_mass_2_scan_index.lower_bound(current_peptide_mass - current_peptide_mass * precursor_mass_tolerance_ * 1e-6),
+                         multimap_mass_2_scan_index.upper_bound(current_peptide_mass + current_peptide_mass * precursor_mass_tolerance_ * 1e-6));
+      }
+      // Dalton
+      return make_pair(multimap_mass_2_scan_index.lower_bound(current_peptide_mass - precursor_mass_tolerance_),
+                       multimap_mass_2_scan_index.upper_bound(current_peptide_mass + precursor_mass_tolerance_));
+    };
+
+    startProgress(0, peptide_db.size(), "Scoring peptide models against spectra...");
+    Size count_peptides(0), count_scored_peptides(0);
+
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize peptide_index = 0; peptide_index < (SignedSize)peptide_db.size(); ++peptide_index)
+    {
+      #pragma omp atomic
+      ++count_peptides;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_peptides);
+      }
+
+      // the stored masses allow skipping peptides without matching precursor before creating the modified sequences
+      bool has_matching_precursor = false;
+      for (Size mod_pep_idx = 0; mod_pep_idx != peptide_db.getNumberOfVariants(peptide_index); ++mod_pep_idx)
+      {
+        auto range = matching_precursors(peptide_db.getVariantMass(peptide_index, mod_pep_idx));
+        if (range.first != range.second)
+        {
+          has_matching_precursor = true;
+          break;
+        }
+      }
+      if (!has_matching_precursor) { continue; }
+
+      #pragma omp atomic
+      ++count_scored_peptides;
+
+      const StringView c = peptide_db.getSequence(peptide_index);
+      vector<AASequence> all_modified_peptides;
+
+      // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
+      #pragma omp critical (residuedb_access)
+      {
+        AASequence aas = AASequence::fromString(c.getString());
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+      }
+
+      for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
+      {
+        const AASequence& candidate = all_modified_peptides[mod_pep_idx];
+
+        // determine MS2 precursors that match to the current peptide mass
+        auto range = matching_precursors(peptide_db.getVariantMass(peptide_index, mod_pep_idx));
+
+        // no matching precursor in data
+        if (range.first == range.second)
+        {
+          continue;
+        }
+
+        // create theoretical spectrum
+        PeakSpectrum theo_spectrum;
+
+        // add peaks for b and y ions with charge 1
+        spectrum_generator.getSpectrum(theo_spectrum, candidate, 1, 1);
+
+        // sort by mz
+        theo_spectrum.sortByPosition();
+
+        for (auto low_it = range.first; low_it != range.second; ++low_it)
+        {
+          const Size& scan_index = low_it->second;
+          const PeakSpectrum& exp_spectrum = spectra[scan_index];
+          HyperScore::PSMDetail detail;
+          const double& score = HyperScore::computeWithDetail(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_spectrum, detail);
+
+          if (score == 0)
+          {
+            continue; // no hit?
+          }
+          // add peptide hit
+          AnnotatedHit_ ah;
+          ah.sequence = c;
+          ah.peptide_mod_index = mod_pep_idx;
+          ah.score = score;
+          ah.prefix_fraction = (double)detail.matched_b_ions/(double)c.size();
+          ah.suffix_fraction = (double)detail.matched_y_ions/(double)c.size();
+          ah.mean_error = detail.mean_error;
+
+#ifdef _OPENMP
+          omp_set_lock(&(annotated_hits_lock[scan_index]));
+          {
+#endif
+            annotated_hits[scan_index].push_back(ah);
+
+            // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
+            if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+            {
+              std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
+              annotated_hits[scan_index].resize(report_top_hits_);
+            }
+#ifdef _OPENMP
+          }
+          omp_unset_lock(&(annotated_hits_lock[scan_index]));
+#endif
+        }
+      }
+    }
+    endProgress();
+
+#ifdef _OPENMP
+    // free locks
+    for (size_t i = 0; i != annotated_hits_lock.size(); i++)
+    {
+      omp_destroy_lock(&(annotated_hits_lock[i]));
+    }
+#endif
+
+    OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
+    OPENMS_LOG_INFO << "Peptides with matching precursors: " << count_scored_peptides << endl;
+  }
+
   SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::search(const String& in_mzML, const String& in_db, vector<ProteinIdentification>& protein_ids, vector<PeptideIdentification>& peptide_ids) const
   {
     boost::regex peptide_motif_regex(peptide_motif_);
@@ -526,153 +882,193 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
       endProgress();
       digestor.setMissedCleavages(peptide_missed_cleavages_);
     }
-    startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
-
-    // lookup for processed peptides. must be defined outside of omp section and synchronized
-    set<StringView> processed_petides;
 
-    Size count_proteins(0), count_peptides(0);
+    // must outlive the annotated hits, which refer to its sequences
+    CachedPeptideDatabase peptide_db;
 
-#pragma omp parallel for schedule(static) default(none) shared(annotated_hits, spectrum_generator, multimap_mass_2_scan_index, fixed_modifications, variable_modifications, fasta_db, digestor, processed_petides, count_proteins, count_peptides, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm, peptide_motif_regex, spectra, annotated_hits_lock)
-      for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
-      {
-
-      #pragma omp atomic
-      ++count_proteins;
+    if (fragment_index_)
+    {
+      searchFragmentIndex_(spectra, multimap_mass_2_scan_index, fasta_db, digestor, fixed_modifications, variable_modifications, annotated_hits);
+    }
+    else if (!database_cache_.empty())
+    {
+      CachedPeptideDatabase::Settings settings;
+      settings.enzyme = enzyme_;
+      settings.missed_cleavages = peptide_missed_cleavages_;
+      settings.min_length = peptide_min_size_;
+      settings.max_length = peptide_max_size_;
+      settings.motif = peptide_motif_;
+      settings.fixed_modifications = modifications_fixed_;
+      settings.variable_modifications = modifications_variable_;
+      settings.max_variable_mods_per_peptide = modifications_max_variable_mods_per_peptide_;
+
+      startProgress(0, 1, "Loading digested peptide database...");
+      peptide_db.loadOrStore(database_cache_, fasta_db, settings);
+      endProgress();
 
-      IF_MASTERTHREAD
-      {
-        setProgress(count_proteins);
-      }
+      searchPeptideDatabase_(spectra, multimap_mass_2_scan_index, peptide_db, fixed_modifications, variable_modifications, annotated_hits);
+    }
+    else
+    {
+      startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
 
-      vector<StringView> current_digest;
-      digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
+      // lookup for processed peptides. must be defined outside of omp section and synchronized
+      set<StringView> processed_petides;
 
-      for (auto const & c : current_digest)
-      { 
-        const String current_peptide = c.getString();
-        if (current_peptide.find_first_of("XBZ") != std::string::npos)
-        {
-          continue;
-        }
+      Size count_proteins(0), count_peptides(0);
 
-        // if a peptide motif is provided skip all peptides without match
-        if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex))
-        {
-          continue;
-        }          
-      
-        bool already_processed = false;
-        #pragma omp critical (processed_peptides_access)
+#pragma omp parallel for schedule(static) default(none) shared(annotated_hits, spectrum_generator, multimap_mass_2_scan_index, fixed_modifications, variable_modifications, fasta_db, digestor, processed_petides, count_proteins, count_peptides, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm, peptide_motif_regex, spectra, annotated_hits_lock)
+        for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
         {
-          // peptide (and all modified variants) already processed so skip it
-          if (processed_petides.find(c) != processed_petides.end())
-          {
-            already_processed = true;
-          }
-          else
-          {
-            processed_petides.insert(c);
-          }
-        }
-
-        // skip peptides that have already been processed
-        if (already_processed) { continue; }
 
         #pragma omp atomic
-        ++count_peptides;
+        ++count_proteins;
 
-        vector<AASequence> all_modified_peptides;
-
-        // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
-        #pragma omp critical (residuedb_access)
+        IF_MASTERTHREAD
         {
-          AASequence aas = AASequence::fromString(current_peptide);
-          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
-          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+          setProgress(count_proteins);
         }
 
-        for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
-        {
-          const AASequence& candidate = all_modified_peptides[mod_pep_idx];
-          double current_peptide_mass = candidate.getMonoWeight();
-
-          // determine MS2 precursors that match to the current peptide mass
-          multimap<double, Size>::const_iterator low_it;
-          multimap<double, Size>::const_iterator up_it;
+        vector<StringView> current_digest;
+        digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
 
-          if (precursor_mass_tolerance_unit_ppm) // ppm
+        for (auto const & c : current_digest)
+        { 
+          const String current_peptide = c.getString();
+          if (current_peptide.find_first_of("XBZ") != std::string::npos)
           {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-          }
-          else // Dalton
-          {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - precursor_mass_tolerance_);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + precursor_mass_tolerance_);
+            continue;
           }
 
-          // no matching precursor in data
-          if (low_it == up_it)
-          { 
+          // if a peptide motif is provided skip all peptides without match
+          if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex))
+          {
             continue;
+          }          
+      
+          bool already_processed = false;
+          #pragma omp critical (processed_peptides_access)
+          {
+            // peptide (and all modified variants) already processed so skip it
+            if (processed_petides.find(c) != processed_petides.end())
+            {
+              already_processed = true;
+            }
+            else
+            {
+              processed_petides.insert(c);
+            }
           }
 
-          // create theoretical spectrum
-          PeakSpectrum theo_spectrum;
+          // skip peptides that have already been processed
+          if (already_processed) { continue; }
 
-          // add peaks for b and y ions with charge 1
-          spectrum_generator.getSpectrum(theo_spectrum, candidate, 1, 1);
+          #pragma omp atomic
+          ++count_peptides;
 
-          // sort by mz
-          theo_spectrum.sortByPosition();
+          AASequence aas;
+
+          // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
+          #pragma omp critical (residuedb_access)
+          {
+            aas = AASequence::fromString(current_peptide);
+            ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+          }
 
-          for (; low_it != up_it; ++low_it)
+          // enumerate modified variants lazily and only create those with a matching precursor
+          ModifiedPeptideGenerator::VariableModificationEnumerator variants(variable_modifications, aas, modifications_max_variable_mods_per_peptide_);
+          while (variants.next())
           {
-            const Size& scan_index = low_it->second;
-            const PeakSpectrum& exp_spectrum = spectra[scan_index];
-            // const int& charge = exp_spectrum.getPrecursors()[0].getCharge();
-            HyperScore::PSMDetail detail;
-            const double& score = HyperScore::computeWithDetail(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_spectrum, detail);
+            // quick check on the summed up mass (with some slack for rounding) before the variant is created
+            const double approximate_mass = variants.getMonoWeight();
+            const double approximate_tolerance = (precursor_mass_tolerance_unit_ppm ? approximate_mass * precursor_mass_tolerance_ * 1e-6 : precursor_mass_tolerance_) + 1e-6;
+            auto approximate_it = multimap_mass_2_scan_index.lower_bound(approximate_mass - approximate_tolerance);
+            if (approximate_it == multimap_mass_2_scan_index.end() || approximate_it->first > approximate_mass + approximate_tolerance)
+            {
+              continue;
+            }
+
+            const SignedSize mod_pep_idx = (SignedSize)variants.getIndex();
+            const AASequence candidate = variants.getPeptide();
+            double current_peptide_mass = candidate.getMonoWeight();
 
-            if (score == 0)
+            // determine MS2 precursors that match to the current peptide mass
+            multimap<double, Size>::const_iterator low_it;
+            multimap<double, Size>::const_iterator up_it;
+
+            if (precursor_mass_tolerance_unit_ppm) // ppm
+            {
+              low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
+              up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
+            }
+            else // Dalton
+            {
+              low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - precursor_mass_tolerance_);
+              up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + precursor_mass_tolerance_);
+            }
+
+            // no matching precursor in data
+            if (low_it == up_it)
             { 
-              continue; // no hit?
+              continue;
             }
-            // add peptide hit
-            AnnotatedHit_ ah;
-            ah.sequence = c;
-            ah.peptide_mod_index = mod_pep_idx;
-            ah.score = score;
-            ah.prefix_fraction = (double)detail.matched_b_ions/(double)c.size();
-            ah.suffix_fraction = (double)detail.matched_y_ions/(double)c.size();
-            ah.mean_error = detail.mean_error;            
 
-#ifdef _OPENMP
-            omp_set_lock(&(annotated_hits_lock[scan_index]));
+            // create theoretical spectrum
+            PeakSpectrum theo_spectrum;
+
+            // add peaks for b and y ions with charge 1
+            spectrum_generator.getSpectrum(theo_spectrum, candidate, 1, 1);
+
+            // sort by mz
+            theo_spectrum.sortByPosition();
+
+            for (; low_it != up_it; ++low_it)
             {
-#endif
-              annotated_hits[scan_index].push_back(ah);
+              const Size& scan_index = low_it->second;
+              const PeakSpectrum& exp_spectrum = spectra[scan_index];
+              // const int& charge = exp_spectrum.getPrecursors()[0].getCharge();
+              HyperScore::PSMDetail detail;
+              const double& score = HyperScore::computeWithDetail(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_spectrum, detail);
+
+              if (score == 0)
+              { 
+                continue; // no hit?
+              }
+              // add peptide hit
+              AnnotatedHit_ ah;
+              ah.sequence = c;
+              ah.peptide_mod_index = mod_pep_idx;
+              ah.score = score;
+              ah.prefix_fraction = (double)detail.matched_b_ions/(double)c.size();
+              ah.suffix_fraction = (double)detail.matched_y_ions/(double)c.size();
+              ah.mean_error = detail.mean_error;            
 
-              // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
-              if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+#ifdef _OPENMP
+              omp_set_lock(&(annotated_hits_lock[scan_index]));
               {
-                std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
-                annotated_hits[scan_index].resize(report_top_hits_); 
-              }
+#endif
+                annotated_hits[scan_index].push_back(ah);
+
+                // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
+                if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+                {
+                  std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
+                  annotated_hits[scan_index].resize(report_top_hits_); 
+                }
 #ifdef _OPENMP
-            }
-            omp_unset_lock(&(annotated_hits_lock[scan_index]));
+              }
+              omp_unset_lock(&(annotated_hits_lock[scan_index]));
 #endif
+            }
           }
         }
       }
-    }
-    endProgress();
+      endProgress();
 
-    OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
-    OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
-    OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
+      OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
+      OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
+      OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
+    }
 
     startProgress(0, 1, "Post-processing PSMs...");
     SimpleSearchEngineAlgorithm::postProcessHits_(spectra, 
@@ -496,8 +496,7 @@ namespace OpenMS
     }
  
     // extract accession by name
-    ControlledVocabulary cv;
-    cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({{"MS", "/CV/psi-ms.obo"}});
     auto lambda = [&ainfo, &cv] (const String& child)
     {
       const ControlledVocabulary::CVTerm& c = cv.getTerm(child);
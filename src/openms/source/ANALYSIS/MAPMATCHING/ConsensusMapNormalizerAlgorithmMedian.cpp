@@ -36,6 +36,7 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/KERNEL/FlatConsensusMap.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
@@ -86,20 +87,21 @@ namespace OpenMS
     }
 
     // fill feature_int with intensities
+    FlatConsensusMap flat(map);
     Size pass_counter = 0;
-    ConsensusMap::ConstIterator cf_it;
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    // without filters every feature passes (avoids compiling the regexps for each feature)
+    const bool use_filters = !(acc_filter.empty() && desc_filter.empty());
+    for (Size i = 0; i < flat.size(); ++i)
     {
-      if (!passesFilters_(cf_it, map, acc_filter, desc_filter))
+      if (use_filters && !passesFilters_(map.begin() + i, map, acc_filter, desc_filter))
       {
         continue;
       }
       ++pass_counter;
 
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
+      for (Size e = flat.elementsBegin(i); e < flat.elementsEnd(i); ++e)
       {
-        feature_int[f_it->getMapIndex()].push_back(f_it->getIntensity());
+        feature_int[flat.getMapIndex(e)].push_back(flat.getIntensity(e));
       }
     }
 
@@ -126,11 +128,22 @@ namespace OpenMS
     }
     else
     {
-      //compute medians
-      for (UInt j = 0; j < number_of_maps; j++)
+      //compute medians (same values as Math::median, but with partial sorting; maps in parallel)
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize j = 0; j < SignedSize(number_of_maps); j++)
       {
         vector<double>& ints_j = feature_int[j];
-        medians[j] = Math::median(ints_j.begin(), ints_j.end());
+        const Size size = ints_j.size();
+        vector<double>::iterator mid = ints_j.begin() + size / 2;
+        std::nth_element(ints_j.begin(), mid, ints_j.end());
+        if (size % 2 == 0) // even size => average two middle values
+        {
+          medians[j] = (*std::max_element(ints_j.begin(), mid) + *mid) / 2.0;
+        }
+        else
+        {
+          medians[j] = *mid;
+        }
       }
     }
 
@@ -144,7 +157,6 @@ namespace OpenMS
       OPENMS_LOG_WARN << endl << "WARNING: normalization using median shifting is not recommended for regular log-normal MS data. Use this only if you know exactly what you're doing!" << endl << endl;
     }
 
-    ConsensusMap::Iterator cf_it;
     ProgressLogger progresslogger;
     progresslogger.setLogType(ProgressLogger::CMD);
     progresslogger.startProgress(0, map.size(), "normalizing maps");
@@ -152,35 +164,37 @@ namespace OpenMS
     vector<double> medians;
     Size index_of_largest_map = computeMedians(map, medians, acc_filter, desc_filter);
 
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    // shift to median of map with largest median in order to avoid negative intensities
+    double max_median(numeric_limits<double>::min());
+    Size max_median_index(0);
+    for (Size i = 0; i < medians.size(); ++i)
     {
-      progresslogger.setProgress(cf_it - map.begin());
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
+      if (medians[i] > max_median)
       {
-        Size map_index = f_it->getMapIndex();
+        max_median = medians[i];
+        max_median_index = i;
+      }
+    }
+
+    FlatConsensusMap flat(map);
+    for (Size i = 0; i < flat.size(); ++i)
+    {
+      progresslogger.setProgress(i);
+      for (Size e = flat.elementsBegin(i); e < flat.elementsEnd(i); ++e)
+      {
+        Size map_index = flat.getMapIndex(e);
         if (method == NM_SCALE)
         {
           // scale to median of map with largest number of features
-          f_it->asMutable().setIntensity(f_it->getIntensity() * medians[index_of_largest_map] / medians[map_index]);
+          flat.setIntensity(e, flat.getIntensity(e) * medians[index_of_largest_map] / medians[map_index]);
         }
         else // method == NM_SHIFT
         {
-          // shift to median of map with largest median in order to avoid negative intensities
-          double max_median(numeric_limits<double>::min());
-          Size max_median_index(0);
-          for (Size i = 0; i < medians.size(); ++i)
-          {
-            if (medians[i] > max_median)
-            {
-              max_median = medians[i];
-              max_median_index = i;
-            }
-          }
-          f_it->asMutable().setIntensity(f_it->getIntensity() + medians[max_median_index] - medians[map_index]);
+          flat.setIntensity(e, flat.getIntensity(e) + medians[max_median_index] - medians[map_index]);
         }
       }
     }
+    flat.applyIntensities(map);
     progresslogger.endProgress();
   }
 
@@ -51,9 +51,10 @@ namespace OpenMS
 
   void ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(ConsensusMap& map)
   {
-    //extract feature intensities
+    //extract feature intensities (from a flat copy of the handles, which is much faster to traverse than the handle sets)
+    FlatConsensusMap flat(map);
     vector<vector<double> > feature_ints;
-    extractIntensityVectors(map, feature_ints);
+    extractIntensityVectors_(flat, map.getColumnHeaders(), feature_ints);
     Size number_of_maps = feature_ints.size();
 
     //determine largest number of features in any map
@@ -66,66 +67,60 @@ namespace OpenMS
       }
     }
 
+    // Sort each map's intensities once. The (value, index) pairs give both the sorted
+    // intensity distribution and the rank of each feature, which is needed to write the
+    // normalized values back without changing the order in feature_ints[i].
+    // Maps are independent, so this (and the resampling) is done in parallel.
+    vector<vector<std::pair<double, UInt> > > sort_pairs(number_of_maps);
     //resample n data points from each sorted intensity distribution (from the different maps), n = maximum number of features in any map
-    vector<vector<double> > resampled_sorted_data;
-    for (Size i = 0; i < number_of_maps; ++i)
+    vector<vector<double> > resampled_sorted_data(number_of_maps);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < SignedSize(number_of_maps); ++i)
     {
-      vector<double> sorted = feature_ints[i];
-      std::sort(sorted.begin(), sorted.end());
-      vector<double> resampled(largest_number_of_features);
-      resample(sorted, resampled, static_cast<UInt>(largest_number_of_features));
-      resampled_sorted_data.push_back(resampled);
+      sort_pairs[i].reserve(feature_ints[i].size());
+      for (Size j = 0; j < feature_ints[i].size(); ++j)
+      {
+        sort_pairs[i].push_back(std::make_pair(feature_ints[i][j], j));
+      }
+      std::sort(sort_pairs[i].begin(), sort_pairs[i].end());
+
+      vector<double> sorted;
+      sorted.reserve(sort_pairs[i].size());
+      for (const auto& sp : sort_pairs[i])
+      {
+        sorted.push_back(sp.first);
+      }
+      resample(sorted, resampled_sorted_data[i], static_cast<UInt>(largest_number_of_features));
     }
 
     //compute reference distribution from all resampled distributions
+    //(summed over the maps in order for each point, so the points can be computed in parallel)
     vector<double> reference_distribution(largest_number_of_features);
-    for (Size i = 0; i < number_of_maps; ++i)
+#pragma omp parallel for schedule(static)
+    for (SignedSize j = 0; j < SignedSize(largest_number_of_features); ++j)
     {
-      for (Size j = 0; j < largest_number_of_features; ++j)
+      for (Size i = 0; i < number_of_maps; ++i)
       {
         reference_distribution[j] += (resampled_sorted_data[i][j] / (double)number_of_maps);
       }
     }
 
     //for each map: resample from the reference distribution down to the respective original size again
-    vector<vector<double> > normalized_sorted_ints(number_of_maps);
-    for (Size i = 0; i < number_of_maps; ++i)
+    //and set the intensities of feature_ints to the normalized intensities (in the order of their ranks)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < SignedSize(number_of_maps); ++i)
     {
-      vector<double> ints;
-      resample(reference_distribution, ints, static_cast<UInt>(feature_ints[i].size()));
-      normalized_sorted_ints[i] = ints;
-    }
-
-    //set the intensities of feature_ints to the normalized intensities
-    for (Size i = 0; i < number_of_maps; ++i)
-    {
-      // We do not want to change the order in feature_ints[i] but normalized_sorted_ints
-      // comes sorted, so we transfer the values in feature_ints[i] into pairs that store
-      // the value and the index in feature_ints[i]. Then we sort the vector of pair and as
-      // a result store the indexes of feature_ints[i] in a sorted order in sort_indices.
-      std::vector<std::pair<double, UInt> > sort_pairs;
-      sort_pairs.reserve(feature_ints[i].size());
-      for (Size j = 0; j < feature_ints[i].size(); ++j)
-      {
-        sort_pairs.push_back(std::make_pair(feature_ints[i][j], j));
-      }
-      std::sort(sort_pairs.begin(), sort_pairs.end());
-      vector<Size> sort_indices;
-      sort_indices.reserve(sort_pairs.size());
-      for (Size j = 0; j < sort_pairs.size(); ++j)
-      {
-        sort_indices.push_back(sort_pairs.at(j).second);
-      }
-      Size k = 0;
-      for (Size j = 0; j < sort_indices.size(); ++j)
+      vector<double> normalized_sorted_ints;
+      resample(reference_distribution, normalized_sorted_ints, static_cast<UInt>(feature_ints[i].size()));
+      for (Size k = 0; k < sort_pairs[i].size(); ++k)
       {
-        Size idx = sort_indices[j];
-        feature_ints[i][idx] = normalized_sorted_ints[i][k++];
+        feature_ints[i][sort_pairs[i][k].second] = normalized_sorted_ints[k];
       }
     }
 
     //write new feature intensities to the consensus map
-    setNormalizedIntensityValues(feature_ints, map);
+    setNormalizedIntensityValues_(feature_ints, flat);
+    flat.applyIntensities(map);
   }
 
   void ConsensusMapNormalizerAlgorithmQuantile::resample(const vector<double>& data_in, vector<double>& data_out, UInt n_resampling_points)
@@ -160,45 +155,49 @@ namespace OpenMS
   }
 
   void ConsensusMapNormalizerAlgorithmQuantile::extractIntensityVectors(const ConsensusMap& map, vector<vector<double> >& out_intensities)
+  {
+    extractIntensityVectors_(FlatConsensusMap(map), map.getColumnHeaders(), out_intensities);
+  }
+
+  void ConsensusMapNormalizerAlgorithmQuantile::setNormalizedIntensityValues(const vector<vector<double> >& feature_ints, ConsensusMap& map)
+  {
+    FlatConsensusMap flat(map);
+    setNormalizedIntensityValues_(feature_ints, flat);
+    flat.applyIntensities(map);
+  }
+
+  void ConsensusMapNormalizerAlgorithmQuantile::extractIntensityVectors_(const FlatConsensusMap& flat, const ConsensusMap::ColumnHeaders& column_headers, vector<vector<double> >& out_intensities)
   {
     //reserve space for out_intensities (unequal vector lengths, 0-features omitted)
-    Size number_of_maps = map.getColumnHeaders().size();
+    Size number_of_maps = column_headers.size();
     out_intensities.clear();
     out_intensities.resize(number_of_maps);
     for (UInt i = 0; i < number_of_maps; i++)
     {
-      ConsensusMap::ColumnHeaders::const_iterator it = map.getColumnHeaders().find(i);
-      if (it == map.getColumnHeaders().end()) throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String(i));
+      ConsensusMap::ColumnHeaders::const_iterator it = column_headers.find(i);
+      if (it == column_headers.end()) throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String(i));
       out_intensities[i].reserve(it->second.size);
     }
     //fill out_intensities
-    ConsensusMap::ConstIterator cf_it;
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    const vector<UInt64>& map_indices = flat.getMapIndices();
+    const vector<FeatureHandle::IntensityType>& intensities = flat.getIntensities();
+    for (Size e = 0; e < map_indices.size(); ++e)
     {
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
-      {
-        out_intensities[f_it->getMapIndex()].push_back(f_it->getIntensity());
-      }
+      out_intensities[map_indices[e]].push_back(intensities[e]);
     }
   }
 
-  void ConsensusMapNormalizerAlgorithmQuantile::setNormalizedIntensityValues(const vector<vector<double> >& feature_ints, ConsensusMap& map)
+  void ConsensusMapNormalizerAlgorithmQuantile::setNormalizedIntensityValues_(const vector<vector<double> >& feature_ints, FlatConsensusMap& flat)
   {
-    //assumes the input map and feature_ints are in the same order as in the beginning,
+    //assumes the elements of flat and feature_ints are in the same order as in the beginning,
     //although feature_ints has normalized values now (but the same ranks as before)
-    Size number_of_maps = map.getColumnHeaders().size();
-    ConsensusMap::ConstIterator cf_it;
-    vector<Size> progress_indices(number_of_maps);
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    const vector<UInt64>& map_indices = flat.getMapIndices();
+    vector<FeatureHandle::IntensityType>& intensities = flat.getIntensities();
+    vector<Size> progress_indices(feature_ints.size());
+    for (Size e = 0; e < map_indices.size(); ++e)
     {
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
-      {
-        Size map_idx = f_it->getMapIndex();
-        double intensity = feature_ints[map_idx][progress_indices[map_idx]++];
-        f_it->asMutable().setIntensity(intensity);
-      }
+      Size map_idx = map_indices[e];
+      intensities[e] = feature_ints[map_idx][progress_indices[map_idx]++];
     }
   }
 
@@ -41,6 +41,9 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <exception>
 
 using namespace std;
 
@@ -116,6 +119,8 @@ namespace OpenMS
   void FeatureGroupingAlgorithmKD::group_(const vector<MapType>& input_maps,
                                           ConsensusMap& out)
   {
+    OPENMS_PROFILE_SCOPE("FeatureGroupingAlgorithmKD::group");
+
     // set parameters
     String mz_unit(param_.getValue("mz_unit").toString());
     mz_ppm_ = mz_unit == "ppm";
@@ -194,6 +199,7 @@ namespace OpenMS
     bool align = param_.getValue("warp:enabled").toString() == "true";
     if (align)
     {
+      OPENMS_PROFILE_SCOPE("RT alignment");
       Size progress = 0;
       startProgress(0, partition_boundaries.size(), "computing RT transformations");
       for (size_t j = 0; j < partition_boundaries.size()-1; j++)
@@ -239,46 +245,75 @@ namespace OpenMS
     }
 
     // ------------ run alignment + feature linking on individual partitions ------------
-    Size progress = 0;
+    // No cluster can reach across partition boundaries, so the partitions are
+    // linked in parallel. The consensus features of each partition are
+    // collected separately and appended in partition order afterwards, which
+    // gives the same result as linking the partitions one after another.
     startProgress(0, partition_boundaries.size(), "linking features");
-    for (size_t j = 0; j < partition_boundaries.size()-1; j++)
+    const SignedSize n_partitions = partition_boundaries.size() - 1;
+    vector<ConsensusMap> partition_results(n_partitions);
+    vector<std::exception_ptr> errors(n_partitions);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize j = 0; j < n_partitions; j++)
     {
-      double partition_start = partition_boundaries[j];
-      double partition_end = partition_boundaries[j+1];
-
-      std::vector<MapType> tmp_input_maps(input_maps.size());
-      for (size_t k = 0; k < input_maps.size(); k++)
+      try
       {
-        // iterate over all features in the current input map and append
-        // matching features (within the current partition) to the temporary
-        // map
-        for (size_t m = 0; m < input_maps[k].size(); m++)
+        double partition_start = partition_boundaries[j];
+        double partition_end = partition_boundaries[j+1];
+
+        std::vector<MapType> tmp_input_maps(input_maps.size());
+        for (size_t k = 0; k < input_maps.size(); k++)
         {
-          if (input_maps[k][m].getMZ() >= partition_start &&
-              input_maps[k][m].getMZ() < partition_end)
+          // iterate over all features in the current input map and append
+          // matching features (within the current partition) to the temporary
+          // map
+          for (size_t m = 0; m < input_maps[k].size(); m++)
           {
-            tmp_input_maps[k].push_back(input_maps[k][m]);
+            if (input_maps[k][m].getMZ() >= partition_start &&
+                input_maps[k][m].getMZ() < partition_end)
+            {
+              tmp_input_maps[k].push_back(input_maps[k][m]);
+            }
           }
+          tmp_input_maps[k].updateRanges();
         }
-        tmp_input_maps[k].updateRanges();
-      }
 
-      // set up kd-tree
-      KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
+        // set up kd-tree
+        KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
+
+        // alignment
+        if (align)
+        {
+          aligner.transform(kd_data);
+        }
 
-      // alignment
-      if (align)
+        // link features
+        runClustering_(kd_data, partition_results[j]);
+      }
+      catch (...)
       {
-        aligner.transform(kd_data);
+        errors[j] = std::current_exception();
       }
-
-      // link features
-      runClustering_(kd_data, out);
-      setProgress(progress++);
+      nextProgress();
     }
     endProgress();
+
+    for (SignedSize j = 0; j < n_partitions; j++)
+    {
+      if (errors[j])
+      {
+        std::rethrow_exception(errors[j]);
+      }
+      for (ConsensusFeature& cf : partition_results[j])
+      {
+        out.push_back(std::move(cf));
+      }
+      partition_results[j].clear(true);
+    }
     
     postprocess_(input_maps, out);
+    Profiler::addCounter("partitions", n_partitions);
+    Profiler::addCounter("consensus_features", out.size());
   }
 
   void FeatureGroupingAlgorithmKD::group(const std::vector<FeatureMap>& maps,
@@ -293,7 +328,7 @@ namespace OpenMS
     group_(maps, out);
   }
 
-  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out)
+  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out) const
   {
     Size n = kd_data.size();
 
@@ -354,14 +389,23 @@ namespace OpenMS
                                                          vector<ClusterProxyKD>& cluster_for_idx,
                                                          const set<Size>& update_these,
                                                          const vector<Int>& assigned,
-                                                         const KDTreeFeatureMaps& kd_data)
+                                                         const KDTreeFeatureMaps& kd_data) const
   {
-    for (set<Size>::const_iterator it = update_these.begin(); it != update_these.end(); ++it)
+    // compute the new proxies in parallel (each only depends on the neighborhood and the assigned flags)
+    vector<Size> indices(update_these.begin(), update_these.end());
+    vector<ClusterProxyKD> new_proxies(indices.size());
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize k = 0; k < (SignedSize)indices.size(); ++k)
     {
-      Size i = *it;
-      const ClusterProxyKD& old_proxy = cluster_for_idx[i];
       vector<Size> unused;
-      ClusterProxyKD new_proxy = computeBestClusterForCenter_(i, unused, assigned, kd_data);
+      new_proxies[k] = computeBestClusterForCenter_(indices[k], unused, assigned, kd_data);
+    }
+
+    for (Size k = 0; k < indices.size(); ++k)
+    {
+      Size i = indices[k];
+      const ClusterProxyKD& old_proxy = cluster_for_idx[i];
+      const ClusterProxyKD& new_proxy = new_proxies[k];
 
       // only need to update if size and/or average distance have changed
       if (new_proxy != old_proxy)
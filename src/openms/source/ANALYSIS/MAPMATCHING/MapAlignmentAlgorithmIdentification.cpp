@@ -230,6 +230,7 @@ namespace OpenMS
     // compute RT medians:
     OPENMS_LOG_DEBUG << "Computing RT medians..." << endl;
     vector<SeqToValue> medians_per_run(size);
+#pragma omp parallel for schedule(dynamic, 1)
     for (Int i = 0; i < size; ++i)
     {
       computeMedians_(rt_data[i], medians_per_run[i], sorted);
@@ -316,6 +317,37 @@ namespace OpenMS
 
     // generate RT transformations:
     OPENMS_LOG_DEBUG << "Generating RT transformations..." << endl;
+
+    // to be useful for the alignment, a peptide sequence has to occur in the
+    // current run ("medians_per_run[i]"), but also in the reference
+    // ("reference_"); both are sorted by sequence, so they can be joined
+    // linearly (and each run independently):
+    vector<TransformationDescription::DataPoints> data_per_run(size);
+    vector<Size> outliers_per_run(size, 0);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (Int i = 0; i < size; ++i)
+    {
+      TransformationDescription::DataPoints& data = data_per_run[i];
+      SeqToValue::const_iterator pos = reference_.begin();
+      for (SeqToValue::const_iterator med_it = medians_per_run[i].begin();
+           med_it != medians_per_run[i].end(); ++med_it)
+      {
+        while ((pos != reference_.end()) && (pos->first < med_it->first)) ++pos;
+        if (pos == reference_.end()) break;
+        if (pos->first == med_it->first)
+        {
+          if (abs(med_it->second - pos->second) <= max_rt_shift)
+          { // found, and satisfies "max_rt_shift" condition!
+            data.emplace_back(med_it->second, pos->second, pos->first);
+          }
+          else
+          {
+            outliers_per_run[i]++;
+          }
+        }
+      }
+    }
+
     OPENMS_LOG_INFO << "\nAlignment based on:" << endl; // diagnostic output
     Size offset = 0; // offset in case of internal reference
     for (Int i = 0; i < size + 1; ++i)
@@ -333,29 +365,8 @@ namespace OpenMS
       }
       if (i >= size) break;
 
-      // to be useful for the alignment, a peptide sequence has to occur in the
-      // current run ("medians_per_run[i]"), but also in at least one other run
-      // ("medians_overall"):
-      TransformationDescription::DataPoints data;
-      Size n_outliers = 0;
-      for (SeqToValue::iterator med_it = medians_per_run[i].begin();
-           med_it != medians_per_run[i].end(); ++med_it)
-      {
-        SeqToValue::const_iterator pos = reference_.find(med_it->first);
-        if (pos != reference_.end())
-        {
-          if (abs(med_it->second - pos->second) <= max_rt_shift)
-          { // found, and satisfies "max_rt_shift" condition!
-            TransformationDescription::DataPoint point(med_it->second,
-                                                       pos->second, pos->first);
-            data.push_back(point);
-          }
-          else
-          {
-            n_outliers++;
-          }
-        }
-      }
+      const TransformationDescription::DataPoints& data = data_per_run[i];
+      const Size n_outliers = outliers_per_run[i];
       transforms.push_back(TransformationDescription(data));
       OPENMS_LOG_INFO << "- " << data.size() << " data points for sample "
                << i + offset + 1;
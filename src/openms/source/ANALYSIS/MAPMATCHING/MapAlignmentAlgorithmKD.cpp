@@ -144,6 +144,10 @@ Size MapAlignmentAlgorithmKD::computeCCs_(const KDTreeFeatureMaps& kd_data, vect
   //set up data structures
   queue<Size> bfs_queue;
   vector<Int> bfs_visited(num_nodes, false);
+
+  // all edges are needed (each node is visited once): batched neighborhood queries
+  vector<vector<Size> > compatible_features;
+  kd_data.getNeighborhoods(compatible_features, rt_tol_secs_, mz_tol_, mz_ppm_, false, max_pairwise_log_fc_);
   Size search_pos = 0;
   Size cc_index = 0;
 
@@ -170,13 +174,8 @@ Size MapAlignmentAlgorithmKD::computeCCs_(const KDTreeFeatureMaps& kd_data, vect
       bfs_queue.pop();
       result[i] = cc_index;
 
-      vector<Size> compatible_features;
-      kd_data.getNeighborhood(i, compatible_features, rt_tol_secs_, mz_tol_, mz_ppm_, false, max_pairwise_log_fc_);
-      for (vector<Size>::const_iterator it = compatible_features.begin();
-           it != compatible_features.end();
-           ++it)
+      for (Size j : compatible_features[i])
       {
-        Size j = *it;
         if (!bfs_visited[j])
         {
           bfs_queue.push(j);
@@ -48,6 +48,8 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <include/OpenMS/APPLICATIONS/MapAlignerBase.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -82,7 +84,47 @@ namespace OpenMS
   class MapAlignmentAlgorithmTreeGuided::PeptideIdentificationsPearsonDistance_
   {
   public:
-    float operator()(SeqAndRTList& map_first, SeqAndRTList& map_second) const
+    /// Peptide sequences (as indices in lexicographical order) with their median RT, sorted by sequence
+    typedef vector<pair<Size, double>> SeqAndMedianList;
+
+    /**
+      @brief Converts the RT lists of all maps to sorted lists of per-sequence median RTs
+
+      Sequences are replaced by their rank among all sequences, so that intersections
+      are computed with integer comparisons and medians are computed only once per map
+      (instead of once per pair of maps). The order of the entries is the same as in
+      @p maps_seq_and_rt, so the distances are unaffected.
+    */
+    static vector<SeqAndMedianList> precompute(const vector<SeqAndRTList>& maps_seq_and_rt)
+    {
+      map<String, Size> sequence_ranks;
+      for (const auto& seq_and_rt : maps_seq_and_rt)
+      {
+        for (const auto& entry : seq_and_rt)
+        {
+          sequence_ranks.emplace(entry.first, 0);
+        }
+      }
+      Size rank = 0;
+      for (auto& entry : sequence_ranks)
+      {
+        entry.second = rank++;
+      }
+
+      vector<SeqAndMedianList> result(maps_seq_and_rt.size());
+      for (Size i = 0; i < maps_seq_and_rt.size(); ++i)
+      {
+        result[i].reserve(maps_seq_and_rt[i].size());
+        for (const auto& entry : maps_seq_and_rt[i])
+        {
+          result[i].emplace_back(sequence_ranks[entry.first],
+                                 Math::median(entry.second.begin(), entry.second.end(), true));
+        }
+      }
+      return result;
+    }
+
+    float operator()(const SeqAndMedianList& map_first, const SeqAndMedianList& map_second) const
     {
       // if both input maps have no peptide identifications with hits (sequence) they are not similar
       if (map_first.size()+map_second.size() == 0)
@@ -109,10 +151,8 @@ namespace OpenMS
         }
         else
         {
-          double med1 = Math::median(pep1_it->second.begin(), pep1_it->second.end(), true);
-          intercept_rts1.push_back(med1);
-          double med2 = Math::median(pep2_it->second.begin(), pep2_it->second.end(), true);
-          intercept_rts2.push_back(med2);
+          intercept_rts1.push_back(pep1_it->second);
+          intercept_rts2.push_back(pep2_it->second);
           ++pep1_it;
           ++pep2_it;
         }
@@ -171,10 +211,25 @@ namespace OpenMS
     extractSeqAndRt_(feature_maps, maps_seq_and_rt, maps_ranges);
     PeptideIdentificationsPearsonDistance_ pep_dist;
     AverageLinkage al;
-    DistanceMatrix<float> dist_matrix; // will be filled
     ClusterHierarchical ch;
 
-    ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, dist_matrix);
+    // compute the distance matrix in parallel, then cluster it with the linkage
+    // functor (this is what ClusterHierarchical::cluster does, serially)
+    const vector<PeptideIdentificationsPearsonDistance_::SeqAndMedianList> maps_seq_and_median =
+      PeptideIdentificationsPearsonDistance_::precompute(maps_seq_and_rt);
+    const SignedSize n_maps = SignedSize(maps_seq_and_median.size());
+    DistanceMatrix<float> dist_matrix(n_maps, 1);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < n_maps; ++i)
+    {
+      for (SignedSize j = 0; j < i; ++j)
+      {
+        // distance value is 1-similarity value, since similarity is in range of [0,1]
+        dist_matrix.setValueQuick(i, j, 1 - pep_dist(maps_seq_and_median[i], maps_seq_and_median[j]));
+      }
+    }
+
+    al(dist_matrix, tree, ch.getThreshold());
   }
 
   // Align feature maps tree guided using align() of MapAlignmentAlgorithmIdentification and use TreeNode with larger 10/90 percentile range as reference.
@@ -185,8 +240,6 @@ namespace OpenMS
                                                             std::vector<Size>& trafo_order)
   {
     Size last_trafo = 0;  // to get final transformation order from map_sets
-    vector<TransformationDescription> transformations_align;  // temporary for aligner output
-    vector<FeatureMap> to_align;
 
     // helper to memorize rt transformation order
     vector<vector<Size>> map_sets(feature_maps_transformed.size());
@@ -195,9 +248,6 @@ namespace OpenMS
       map_sets[i].push_back(i);
     }
 
-    Size ref;
-    Size to_transform;
-
     // check RT ranges of IDs
     for (size_t i = 0; i < maps_ranges.size(); ++i)
     {
@@ -206,64 +256,104 @@ namespace OpenMS
       if (maps_ranges[i].empty()) throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FeatureMap originating from '" + ListUtils::concatenate(p, "', '") + "' contains no Peptide Identifications. Cannot align!");
     }
 
-    for (const auto& node : tree)
+    // Each node only reads and writes the maps of its two children, so nodes of
+    // sibling subtrees are independent. Group the nodes into waves: a node is
+    // placed in the wave after the last one that modified one of its maps.
+    // Nodes of one wave are aligned concurrently.
+    vector<Size> map_wave(feature_maps_transformed.size(), 0);
+    vector<vector<Size>> waves;
+    for (Size k = 0; k < tree.size(); ++k)
     {
-      // ----------------
-      // prepare alignment
-      // ----------------
-      //  determine the map with larger RT range for 10/90 percentile (->reference)
-      double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
-      double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
-
-      if (left_range > right_range)
-      {
-        ref = node.left_child;
-        to_transform = node.right_child;
-      }
-      else
-      {
-        ref = node.right_child;
-        to_transform = node.left_child;
-      }
-
-      vector<double> tmp;
-      std::merge(maps_ranges[node.right_child].begin(), maps_ranges[node.right_child].end(), maps_ranges[node.left_child].begin(), maps_ranges[node.left_child].end(), std::back_inserter(tmp));
-
-      to_align.push_back(feature_maps_transformed[to_transform]);
-      to_align.push_back(feature_maps_transformed[ref]);
-
-      // ----------------
-      // perform alignment
-      // ----------------
-      align_algorithm_.align(to_align, transformations_align, 1);
-
-      // transform retention times of non-identity for next iteration
-      transformations_align[0].fitModel(model_type_, model_param_);
-      MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
-              transformations_align[0], true);
+      Size wave = max(map_wave[tree[k].left_child], map_wave[tree[k].right_child]);
+      map_wave[tree[k].left_child] = map_wave[tree[k].right_child] = wave + 1;
+      if (waves.size() <= wave) waves.resize(wave + 1);
+      waves[wave].push_back(k);
+    }
 
-      // combine aligned maps, store at smaller index, because tree always calls smaller number
-      // clear feature map at larger index to save memory
-      feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
-      feature_maps_transformed[ref].updateRanges();
-      if (ref < to_transform)
+    vector<Size> refs(tree.size()), to_transforms(tree.size());
+    const Param align_param = align_algorithm_.getParameters();
+    for (const vector<Size>& wave : waves)
+    {
+      vector<std::exception_ptr> errors(wave.size());
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize w = 0; w < SignedSize(wave.size()); ++w)
       {
-        feature_maps_transformed[to_transform].clear(true);
-        last_trafo = ref;
+        try
+        {
+          const BinaryTreeNode& node = tree[wave[w]];
+          Size& ref = refs[wave[w]];
+          Size& to_transform = to_transforms[wave[w]];
+
+          // ----------------
+          // prepare alignment
+          // ----------------
+          //  determine the map with larger RT range for 10/90 percentile (->reference)
+          double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
+          double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
+
+          if (left_range > right_range)
+          {
+            ref = node.left_child;
+            to_transform = node.right_child;
+          }
+          else
+          {
+            ref = node.right_child;
+            to_transform = node.left_child;
+          }
+
+          vector<FeatureMap> to_align;
+          to_align.push_back(feature_maps_transformed[to_transform]);
+          to_align.push_back(feature_maps_transformed[ref]);
+
+          // ----------------
+          // perform alignment
+          // ----------------
+          // (the aligner keeps state during align(), so each node uses its own instance)
+          MapAlignmentAlgorithmIdentification align_algorithm;
+          align_algorithm.setParameters(align_param);
+          vector<TransformationDescription> transformations_align;  // temporary for aligner output
+          align_algorithm.align(to_align, transformations_align, 1);
+
+          // transform retention times of non-identity for next iteration
+          transformations_align[0].fitModel(model_type_, model_param_);
+          MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
+                  transformations_align[0], true);
+
+          // combine aligned maps, store at smaller index, because tree always calls smaller number
+          // clear feature map at larger index to save memory
+          feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
+          feature_maps_transformed[ref].updateRanges();
+          if (ref < to_transform)
+          {
+            feature_maps_transformed[to_transform].clear(true);
+          }
+          else
+          {
+            feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
+            feature_maps_transformed[ref].clear(true);
+          }
+        }
+        catch (...)
+        {
+          errors[w] = std::current_exception();
+        }
       }
-      else
+      for (const auto& error : errors)
       {
-        feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
-        feature_maps_transformed[ref].clear(true);
-        last_trafo = to_transform;
+        if (error) std::rethrow_exception(error);
       }
+    }
+
+    for (Size k = 0; k < tree.size(); ++k)
+    {
+      const Size ref = refs[k];
+      const Size to_transform = to_transforms[k];
+      last_trafo = min(ref, to_transform);
 
       // update order of alignment for both aligned maps
       map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
       map_sets[to_transform] = map_sets[ref];
-
-      transformations_align.clear();
-      to_align.clear();
     }
     // copy last transformed FeatureMap for reference return
     map_transformed = feature_maps_transformed[last_trafo];
@@ -60,16 +60,18 @@ namespace OpenMS
     msexp.clearRanges();
 
     // Transform spectra
-    for (PeakMap::iterator mse_iter = msexp.begin();
-         mse_iter != msexp.end(); ++mse_iter)
+#pragma omp parallel for schedule(static)
+    for (SignedSize i = 0; i < (SignedSize)msexp.size(); ++i)
     {
-      double rt = mse_iter->getRT();
-      if (store_original_rt) storeOriginalRT_(*mse_iter, rt);
-      mse_iter->setRT(trafo.apply(rt));
+      MSSpectrum& spectrum = msexp[i];
+      double rt = spectrum.getRT();
+      if (store_original_rt) storeOriginalRT_(spectrum, rt);
+      spectrum.setRT(trafo.apply(rt));
     }
 
     // Also transform chromatograms
-    for (Size i = 0; i < msexp.getNrChromatograms(); ++i)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)msexp.getNrChromatograms(); ++i)
     {
       MSChromatogram& chromatogram = msexp.getChromatogram(i);
       vector<double> original_rts;
@@ -94,10 +96,11 @@ namespace OpenMS
     FeatureMap& fmap, const TransformationDescription& trafo,
     bool store_original_rt)
   {
-    for (vector<Feature>::iterator fmit = fmap.begin(); fmit != fmap.end();
-         ++fmit)
+    // features (incl. their hulls, subordinates and IDs) are independent
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
     {
-      applyToFeature_(*fmit, trafo, store_original_rt);
+      applyToFeature_(fmap[i], trafo, store_original_rt);
     }
 
     // adapt RT values of unassigned peptides:
@@ -163,9 +166,11 @@ namespace OpenMS
     ConsensusMap& cmap, const TransformationDescription& trafo,
     bool store_original_rt)
   {
-    for (ConsensusMap::Iterator cmit = cmap.begin(); cmit != cmap.end(); ++cmit)
+    // consensus features (incl. their handles and IDs) are independent
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)cmap.size(); ++i)
     {
-      applyToConsensusFeature_(*cmit, trafo, store_original_rt);
+      applyToConsensusFeature_(cmap[i], trafo, store_original_rt);
     }
 
     // adapt RT values of unassigned peptides:
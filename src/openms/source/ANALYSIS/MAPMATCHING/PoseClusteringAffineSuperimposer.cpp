@@ -39,6 +39,9 @@
 
 #include <boost/math/special_functions/fpclassify.hpp> // isnan
 
+#include <algorithm>
+#include <functional>
+
 // #define Debug_PoseClusteringAffineSuperimposer
 
 namespace OpenMS
@@ -177,135 +180,195 @@ namespace OpenMS
       dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
     }
 
-    // first point in model map (i)
-    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size - 1; ++i)
+    typedef Math::LinearInterpolation<double, double> HashTable;
+
+    // hashes all quadruplets with first model point i in [i_begin, i_end) into the given tables
+    auto hashRange = [&](Size i_begin, Size i_end, HashTable& hash_scaling_1, HashTable& hash_scaling_2, HashTable& hash_rt_low, HashTable& hash_rt_high)
     {
-      // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
-      while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-        ++i_low;
-      while (i_high < model_map_size && model_map[i_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-        ++i_high;
-      // stop if there are too many features are in our window
-      double i_winlength_factor = 1. / (i_high - i_low);
-      i_winlength_factor -= winlength_factor_baseline;
-      if (i_winlength_factor <= 0)
-        continue;
-
-      // Adjust window around k in scene map (get all features in a m/z range of item i in the scene map)
-      while (k_low < scene_map_size && scene_map[k_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-        ++k_low;
-      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-        ++k_high;
-
-      // Iterate through all matching features in the scene map that are
-      // within the m/z distance of item i from the model map.
-      // first point in scene map (k)
-      for (Size k = k_low; k < k_high; ++k)
+      // first point in model map (i)
+      for (Size i = i_begin, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < i_end; ++i)
       {
+        // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
+        while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+          ++i_low;
+        while (i_high < model_map_size && model_map[i_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+          ++i_high;
         // stop if there are too many features are in our window
-        double k_winlength_factor = 1. / (k_high - k_low);
-        k_winlength_factor -= winlength_factor_baseline;
-        if (k_winlength_factor <= 0)
+        double i_winlength_factor = 1. / (i_high - i_low);
+        i_winlength_factor -= winlength_factor_baseline;
+        if (i_winlength_factor <= 0)
           continue;
 
-        // compute similarity of intensities i k by taking the ratio of the two intensities
-        double similarity_ik;
-        {
-          const double int_i = model_map[i].getIntensity();
-          const double int_k = scene_map[k].getIntensity() * total_intensity_ratio;
-          similarity_ik = (int_i < int_k) ? int_i / int_k : int_k / int_i;
-          // weight is inverse proportional to number of elements with similar mz
-          similarity_ik *= i_winlength_factor;
-          similarity_ik *= k_winlength_factor;
-        }
+        // Adjust window around k in scene map (get all features in a m/z range of item i in the scene map)
+        while (k_low < scene_map_size && scene_map[k_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+          ++k_low;
+        while (k_high < scene_map_size && scene_map[k_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+          ++k_high;
 
-        // second point in model map (j)
-        for (Size j = i + 1, j_low = i_low, j_high = i_low, l_low = k_low, l_high = k_high; j < model_map_size; ++j)
+        // Iterate through all matching features in the scene map that are
+        // within the m/z distance of item i from the model map.
+        // first point in scene map (k)
+        for (Size k = k_low; k < k_high; ++k)
         {
-          // diff in model map -> skip features that are too far away in RT
-          double diff_model = model_map[j].getRT() - model_map[i].getRT();
-          if (fabs(diff_model) < rt_pair_min_distance)
+          // stop if there are too many features are in our window
+          double k_winlength_factor = 1. / (k_high - k_low);
+          k_winlength_factor -= winlength_factor_baseline;
+          if (k_winlength_factor <= 0)
             continue;
 
-          // Adjust window around j in model map
-          while (j_low < model_map_size && model_map[j_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-            ++j_low;
-          while (j_high < model_map_size && model_map[j_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-            ++j_high;
-          double j_winlength_factor = 1. / (j_high - j_low);
-          j_winlength_factor -= winlength_factor_baseline;
-          if (j_winlength_factor <= 0)
-            continue;
-
-          // Adjust window around l in scene map
-          while (l_low < scene_map_size && scene_map[l_low].getMZ() < model_map[j].getMZ() - mz_pair_max_distance)
-            ++l_low;
-          while (l_high < scene_map_size && scene_map[l_high].getMZ() <= model_map[j].getMZ() + mz_pair_max_distance)
-            ++l_high;
+          // compute similarity of intensities i k by taking the ratio of the two intensities
+          double similarity_ik;
+          {
+            const double int_i = model_map[i].getIntensity();
+            const double int_k = scene_map[k].getIntensity() * total_intensity_ratio;
+            similarity_ik = (int_i < int_k) ? int_i / int_k : int_k / int_i;
+            // weight is inverse proportional to number of elements with similar mz
+            similarity_ik *= i_winlength_factor;
+            similarity_ik *= k_winlength_factor;
+          }
 
-          // second point in scene map (l)
-          for (Size l = l_low; l < l_high; ++l)
+          // second point in model map (j)
+          for (Size j = i + 1, j_low = i_low, j_high = i_low, l_low = k_low, l_high = k_high; j < model_map_size; ++j)
           {
-            double l_winlength_factor = 1. / (l_high - l_low);
-            l_winlength_factor -= winlength_factor_baseline;
-            if (l_winlength_factor <= 0)
+            // diff in model map -> skip features that are too far away in RT
+            double diff_model = model_map[j].getRT() - model_map[i].getRT();
+            if (fabs(diff_model) < rt_pair_min_distance)
               continue;
 
-            // diff in scene map -> skip features that are too far away in RT
-            double diff_scene = scene_map[l].getRT() - scene_map[k].getRT();
-
-            // avoid cross mappings (i,j) -> (k,l) (e.g. i_rt < j_rt and k_rt > l_rt)
-            // and point pairs with equal retention times (e.g. i_rt == j_rt)
-            if (fabs(diff_scene) < rt_pair_min_distance || ((diff_model > 0) != (diff_scene > 0)))
+            // Adjust window around j in model map
+            while (j_low < model_map_size && model_map[j_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+              ++j_low;
+            while (j_high < model_map_size && model_map[j_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+              ++j_high;
+            double j_winlength_factor = 1. / (j_high - j_low);
+            j_winlength_factor -= winlength_factor_baseline;
+            if (j_winlength_factor <= 0)
               continue;
 
-            // compute the transformation (i,j) -> (k,l)
-            double scaling = diff_model / diff_scene;
-            double shift = model_map[i].getRT() - scene_map[k].getRT() * scaling;
+            // Adjust window around l in scene map
+            while (l_low < scene_map_size && scene_map[l_low].getMZ() < model_map[j].getMZ() - mz_pair_max_distance)
+              ++l_low;
+            while (l_high < scene_map_size && scene_map[l_high].getMZ() <= model_map[j].getMZ() + mz_pair_max_distance)
+              ++l_high;
 
-            // compute similarity of intensities i k j l
-            double similarity_ik_jl;
+            // second point in scene map (l)
+            for (Size l = l_low; l < l_high; ++l)
             {
-              // compute similarity of intensities j l
-              const double int_j = model_map[j].getIntensity();
-              const double int_l = scene_map[l].getIntensity() * total_intensity_ratio;
-              double similarity_jl = (int_j < int_l) ? int_j / int_l : int_l / int_j;
-              // weight is inverse proportional to number of elements with similar mz
-              similarity_jl *= j_winlength_factor;
-              similarity_jl *= l_winlength_factor;
-              similarity_ik_jl = similarity_ik * similarity_jl;
-            }
-
-            // hash the images of scaling, rt_low and rt_high into their respective hash tables
-            // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
-            //   -> in round 2, discard values outside of scale_low_1 and
-            //   scale_high_1 (estimated before in scalingEstimate)
-            if (hashing_round == 1)
-            {
-              // hashing round 1 (estimate the scaling only)
-              scaling_hash_1.addValue(log(scaling), similarity_ik_jl);
-            }
-            else if (scaling >= scale_low_1 && scaling <= scale_high_1)
-            {
-              // hashing round 2 (estimate scaling and shift)
-              scaling_hash_2.addValue(log(scaling), similarity_ik_jl);
+              double l_winlength_factor = 1. / (l_high - l_low);
+              l_winlength_factor -= winlength_factor_baseline;
+              if (l_winlength_factor <= 0)
+                continue;
+
+              // diff in scene map -> skip features that are too far away in RT
+              double diff_scene = scene_map[l].getRT() - scene_map[k].getRT();
 
-              const double rt_low_image = shift + rt_low * scaling;
-              rt_low_hash_.addValue(rt_low_image, similarity_ik_jl);
-              const double rt_high_image = shift + rt_high * scaling;
-              rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
+              // avoid cross mappings (i,j) -> (k,l) (e.g. i_rt < j_rt and k_rt > l_rt)
+              // and point pairs with equal retention times (e.g. i_rt == j_rt)
+              if (fabs(diff_scene) < rt_pair_min_distance || ((diff_model > 0) != (diff_scene > 0)))
+                continue;
 
-              if (do_dump_pairs)
+              // compute the transformation (i,j) -> (k,l)
+              double scaling = diff_model / diff_scene;
+              double shift = model_map[i].getRT() - scene_map[k].getRT() * scaling;
+
+              // compute similarity of intensities i k j l
+              double similarity_ik_jl;
+              {
+                // compute similarity of intensities j l
+                const double int_j = model_map[j].getIntensity();
+                const double int_l = scene_map[l].getIntensity() * total_intensity_ratio;
+                double similarity_jl = (int_j < int_l) ? int_j / int_l : int_l / int_j;
+                // weight is inverse proportional to number of elements with similar mz
+                similarity_jl *= j_winlength_factor;
+                similarity_jl *= l_winlength_factor;
+                similarity_ik_jl = similarity_ik * similarity_jl;
+              }
+
+              // hash the images of scaling, rt_low and rt_high into their respective hash tables
+              // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
+              //   -> in round 2, discard values outside of scale_low_1 and
+              //   scale_high_1 (estimated before in scalingEstimate)
+              if (hashing_round == 1)
+              {
+                // hashing round 1 (estimate the scaling only)
+                hash_scaling_1.addValue(log(scaling), similarity_ik_jl);
+              }
+              else if (scaling >= scale_low_1 && scaling <= scale_high_1)
               {
-                dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
-                                << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
-                                << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
+                // hashing round 2 (estimate scaling and shift)
+                hash_scaling_2.addValue(log(scaling), similarity_ik_jl);
+
+                const double rt_low_image = shift + rt_low * scaling;
+                hash_rt_low.addValue(rt_low_image, similarity_ik_jl);
+                const double rt_high_image = shift + rt_high * scaling;
+                hash_rt_high.addValue(rt_high_image, similarity_ik_jl);
+
+                if (do_dump_pairs)
+                {
+                  dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
+                                  << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
+                                  << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
+                }
               }
-            }
-          }   // l
-        }   // j
-      }   // k
-    }   // i
+            }   // l
+          }   // j
+        }   // k
+      }   // i
+    };
+
+    if (model_map_size < 2)
+    {
+      return;
+    }
+
+    // The outer loop is split into a fixed number of blocks that are hashed in parallel, each into its own
+    // copy of the (fixed-size) hash tables. The copies are added up in block order, so the result does not
+    // depend on the number of threads. Pair dumps are written serially (in the original order).
+    const Size n_blocks = do_dump_pairs ? 1 : std::min(Size(32), model_map_size - 1);
+    if (n_blocks == 1)
+    {
+      hashRange(0, model_map_size - 1, scaling_hash_1, scaling_hash_2, rt_low_hash_, rt_high_hash_);
+      return;
+    }
+
+    auto emptyCopy = [](const HashTable& hash)
+    {
+      HashTable copy(hash);
+      std::fill(copy.getData().begin(), copy.getData().end(), 0.0);
+      return copy;
+    };
+    std::vector<HashTable> block_scaling_1(n_blocks, emptyCopy(scaling_hash_1));
+    std::vector<HashTable> block_scaling_2(n_blocks, emptyCopy(scaling_hash_2));
+    std::vector<HashTable> block_rt_low(n_blocks, emptyCopy(rt_low_hash_));
+    std::vector<HashTable> block_rt_high(n_blocks, emptyCopy(rt_high_hash_));
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize block = 0; block < SignedSize(n_blocks); ++block)
+    {
+      // the inner loops get shorter with increasing i, dynamic scheduling balances the blocks
+      Size n = model_map_size - 1;
+      Size i_begin = n * block / n_blocks;
+      Size i_end = n * (block + 1) / n_blocks;
+      hashRange(i_begin, i_end, block_scaling_1[block], block_scaling_2[block], block_rt_low[block], block_rt_high[block]);
+    }
+
+    auto addTo = [](HashTable& hash, const std::vector<HashTable>& blocks)
+    {
+      for (const HashTable& block : blocks)
+      {
+        std::transform(hash.getData().begin(), hash.getData().end(), block.getData().begin(), hash.getData().begin(), std::plus<double>());
+      }
+    };
+    if (hashing_round == 1)
+    {
+      addTo(scaling_hash_1, block_scaling_1);
+    }
+    else
+    {
+      addTo(scaling_hash_2, block_scaling_2);
+      addTo(rt_low_hash_, block_rt_low);
+      addTo(rt_high_hash_, block_rt_high);
+    }
   }
 
   /**
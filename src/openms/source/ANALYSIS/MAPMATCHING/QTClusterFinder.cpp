@@ -518,7 +518,13 @@ namespace OpenMS
     Size id = cluster.getId();
     for (const auto& element : cluster.getElements())
     {
-      element_mapping[element.feature].erase(id);
+      // look up instead of operator[]: entries of already used features have
+      // been dropped and must not be re-created as empty sets
+      ElementMapping::iterator pos = element_mapping.find(element.feature);
+      if (pos != element_mapping.end())
+      {
+        pos->second.erase(id);
+      }
     }
   }
 
@@ -669,6 +675,10 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
           element_mapping[feat_clusterids.first].insert(id);
         }
       }
+
+      // the feature is now used and will never be part of a cluster again,
+      // so its cluster ids can be released to keep the mapping small
+      element_mapping.erase(curr_feature);
     }
   }
 
@@ -122,20 +122,47 @@ namespace OpenMS
     // TODO: iterate over SENSIBLE RT (and m/z) window -- sort the maps beforehand
     //       to save a lot of processing time...
     //       Once done, remove the warning in the description of the 'use_identifications' parameter
-    for (UInt fi0 = 0; fi0 < input_maps[0].size(); ++fi0)
+    //
+    // The (expensive) distances are computed in parallel for a block of rows
+    // of the distance matrix. The nearest neighbor updates below depend on the
+    // order in which the pairs are visited, so they are applied serially in
+    // the original row-major order to keep the result independent of the
+    // number of threads.
+    const Size size0 = input_maps[0].size(), size1 = input_maps[1].size();
+    const Size block_rows = (size1 == 0) ? size0 : max(Size(1), Size(1 << 20) / size1);
+    vector<pair<bool, double> > block_distances;
+    vector<char> block_compatible;
+    for (Size block_start = 0; block_start < size0; block_start += block_rows)
     {
-      const ConsensusFeature& feat0 = input_maps[0][fi0];
+      const Size block_end = min(size0, block_start + block_rows);
+      const SignedSize block_size = SignedSize((block_end - block_start) * size1);
+      block_distances.resize(block_size);
+      block_compatible.assign(block_size, 1);
 
-      for (UInt fi1 = 0; fi1 < input_maps[1].size(); ++fi1)
+#pragma omp parallel for schedule(static)
+      for (SignedSize k = 0; k < block_size; ++k)
       {
-        const ConsensusFeature& feat1 = input_maps[1][fi1];
+        const ConsensusFeature& feat0 = input_maps[0][block_start + k / size1];
+        const ConsensusFeature& feat1 = input_maps[1][k % size1];
 
         if (use_IDs_ && !compatibleIDs_(feat0, feat1)) // check peptide IDs
+        {
+          block_compatible[k] = 0; // mismatch
+          continue;
+        }
+        block_distances[k] = feature_distance(feat0, feat1);
+      }
+
+      for (Size k = 0; k < Size(block_size); ++k)
+      {
+        if (!block_compatible[k])
         {
           continue; // mismatch
         }
+        const UInt fi0 = UInt(block_start + k / size1);
+        const UInt fi1 = UInt(k % size1);
 
-        pair<bool, double> result = feature_distance(feat0, feat1);
+        const pair<bool, double>& result = block_distances[k];
         double distance = result.second;
         // we only care if distance constraints are satisfied for "best
         // matches", not for second-best; this means that second-best distances
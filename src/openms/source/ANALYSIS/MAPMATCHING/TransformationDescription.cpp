@@ -134,6 +134,15 @@ namespace OpenMS
     return model_->evaluate(value);
   }
 
+  void TransformationDescription::apply(std::vector<double>& values) const
+  {
+#pragma omp parallel for schedule(static)
+    for (SignedSize i = 0; i < (SignedSize)values.size(); ++i)
+    {
+      values[i] = model_->evaluate(values[i]);
+    }
+  }
+
   const String& TransformationDescription::getModelType() const
   {
     return model_type_;
@@ -37,113 +37,369 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
+
+#include <algorithm>
 #include <iostream>
 
 namespace OpenMS
 {
 
-  void ChromatogramExtractorAlgorithm::extract_value_tophat(
-      const std::vector<double>::const_iterator& mz_start,
-            std::vector<double>::const_iterator& mz_it,
-      const std::vector<double>::const_iterator& mz_end,
-            std::vector<double>::const_iterator& int_it,
-      const double mz,
-      double& integrated_intensity,
-      const double mz_extraction_window,
-      const bool ppm)
+  namespace
   {
-    integrated_intensity = 0;
-    if (mz_start == mz_end)
+    // implementation of extract_value_tophat for any pair of m/z and intensity arrays
+    template <typename MzIterator, typename IntIterator>
+    void extractTophat_(
+        const MzIterator& mz_start,
+              MzIterator& mz_it,
+        const MzIterator& mz_end,
+              IntIterator& int_it,
+        const double mz,
+        double& integrated_intensity,
+        const double mz_extraction_window,
+        const bool ppm)
     {
-      return;
-    }
+      integrated_intensity = 0;
+      if (mz_start == mz_end)
+      {
+        return;
+      }
 
-    // calculate extraction window
-    double left, right;
-    if (ppm)
-    {
-      left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
-      right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
-    }
-    else
-    {
-      left  = mz - mz_extraction_window / 2.0;
-      right = mz + mz_extraction_window / 2.0;
-    }
+      // calculate extraction window
+      double left, right;
+      if (ppm)
+      {
+        left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left  = mz - mz_extraction_window / 2.0;
+        right = mz + mz_extraction_window / 2.0;
+      }
 
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator int_walker;
+      MzIterator mz_walker;
+      IntIterator int_walker;
 
-    // advance the mz / int iterator until we hit the m/z value of the next transition
-    while (mz_it != mz_end && (*mz_it) < mz)
-    {
-      mz_it++;
-      int_it++;
-    }
+      // advance the mz / int iterator until we hit the m/z value of the next transition
+      while (mz_it != mz_end && (*mz_it) < mz)
+      {
+        mz_it++;
+        int_it++;
+      }
 
-    // walk right and left and add to our intensity
-    mz_walker  = mz_it;
-    int_walker = int_it;
+      // walk right and left and add to our intensity
+      mz_walker  = mz_it;
+      int_walker = int_it;
 
-    // if we moved past the end of the spectrum, we need to try the last peak
-    // of the spectrum (it could still be within the window)
-    if (mz_it == mz_end)
-    {
-      --mz_walker;
-      --int_walker;
-    }
+      // if we moved past the end of the spectrum, we need to try the last peak
+      // of the spectrum (it could still be within the window)
+      if (mz_it == mz_end)
+      {
+        --mz_walker;
+        --int_walker;
+      }
 
-    // add the current peak if it is between right and left
-    if ((*mz_walker) > left && (*mz_walker) < right)
-    {
-      integrated_intensity += (*int_walker);
-    }
+      // add the current peak if it is between right and left
+      if ((*mz_walker) > left && (*mz_walker) < right)
+      {
+        integrated_intensity += (*int_walker);
+      }
 
-    // (i) Walk to the left one step and then keep walking left until we go
-    // outside the window. Note for the first step to the left we have to
-    // check for the walker becoming equal to the first data point.
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    if (mz_it != mz_start)
-    {
-      --mz_walker;
-      --int_walker;
-
-      // Special case: target m/z is larger than first data point but the first
-      // data point is inside the window.
-      // Then, mz_it is the second data point, mz_walker now points to the very
-      // first data point. If mz_it was the first data point, we already added
-      // it above. We still need to add this point if it is inside the window
-      // (while loop below will not catch it)
-      if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right)
+      // (i) Walk to the left one step and then keep walking left until we go
+      // outside the window. Note for the first step to the left we have to
+      // check for the walker becoming equal to the first data point.
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      if (mz_it != mz_start)
+      {
+        --mz_walker;
+        --int_walker;
+
+        // Special case: target m/z is larger than first data point but the first
+        // data point is inside the window.
+        // Then, mz_it is the second data point, mz_walker now points to the very
+        // first data point. If mz_it was the first data point, we already added
+        // it above. We still need to add this point if it is inside the window
+        // (while loop below will not catch it)
+        if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right)
+        {
+          integrated_intensity += (*int_walker);
+        }
+      }
+      while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
       {
         integrated_intensity += (*int_walker);
+        --mz_walker;
+        --int_walker;
+      }
+
+      // (ii) Walk to the right one step and then keep walking right until we are
+      // outside the window
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      if (mz_it != mz_end)
+      {
+        ++mz_walker;
+        ++int_walker;
+      }
+      while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        integrated_intensity += (*int_walker);
+        ++mz_walker;
+        ++int_walker;
       }
     }
-    while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+
+    // implementation of extract_value_tophat (with ion mobility) for any m/z, intensity and ion mobility arrays
+    template <typename MzIterator, typename IntIterator, typename ImIterator>
+    void extractTophat_(
+        const MzIterator& mz_start,
+              MzIterator& mz_it,
+        const MzIterator& mz_end,
+              IntIterator& int_it,
+              ImIterator& im_it,
+        const double mz,
+        const double im,
+        double& integrated_intensity,
+        const double mz_extraction_window,
+        const double im_extraction_window,
+        const bool ppm)
     {
-      integrated_intensity += (*int_walker);
-      --mz_walker;
-      --int_walker;
+      // Note that we have a 3D spectrum with m/z, intensity and ion mobility.
+      // The spectrum is sorted by m/z but we expect to have ion mobility
+      // information for each m/z point as well. Right now we simply filter by
+      // ion mobility and skip data that does not fall within the ion mobility
+      // window.
+
+      integrated_intensity = 0;
+      if (mz_start == mz_end)
+      {
+        return;
+      }
+
+      // calculate extraction window
+      double left, right;
+      if (ppm)
+      {
+        left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left  = mz - mz_extraction_window / 2.0;
+        right = mz + mz_extraction_window / 2.0;
+      }
+      double left_im  = im - im_extraction_window / 2.0;
+      double right_im = im + im_extraction_window / 2.0;
+
+      MzIterator mz_walker;
+      ImIterator im_walker;
+      IntIterator int_walker;
+
+      // advance the mz / int iterator until we hit the m/z value of the next transition
+      while (mz_it != mz_end && (*mz_it) < mz)
+      {
+        mz_it++;
+        im_it++;
+        int_it++;
+      }
+
+      // walk right and left and add to our intensity
+      mz_walker  = mz_it;
+      im_walker  = im_it;
+      int_walker = int_it;
+
+      // if we moved past the end of the spectrum, we need to try the last peak
+      // of the spectrum (it could still be within the window)
+      if (mz_it == mz_end)
+      {
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+      }
+
+      // add the current peak if it is between right and left
+      if ((*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
+      {
+        integrated_intensity += (*int_walker);
+      }
+
+      // (i) Walk to the left one step and then keep walking left until we go
+      // outside the window. Note for the first step to the left we have to
+      // check for the walker becoming equal to the first data point.
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      im_walker = im_it;
+      if (mz_it != mz_start)
+      {
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+
+        // Special case: target m/z is larger than first data point but the first
+        // data point is inside the window.
+        // Then, mz_it is the second data point, mz_walker now points to the very
+        // first data point. If mz_it was the first data point, we already added
+        // it above. We still need to add this point if it is inside the window
+        // (while loop below will not catch it)
+        if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
+        {
+          integrated_intensity += (*int_walker);
+        }
+      }
+      while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+      }
+
+      // (ii) Walk to the right one step and then keep walking right until we are
+      // outside the window
+      mz_walker  = mz_it;
+      im_walker  = im_it;
+      int_walker = int_it;
+      if (mz_it != mz_end)
+      {
+        ++im_walker;
+        ++mz_walker;
+        ++int_walker;
+      }
+      while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
+        ++mz_walker;
+        ++im_walker;
+        ++int_walker;
+      }
     }
 
-    // (ii) Walk to the right one step and then keep walking right until we are
-    // outside the window
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    if (mz_it != mz_end)
+    // number of extraction coordinates that are processed together by one thread
+    const Size coordinate_block_size = 4096;
+
+    // extracts the coordinates [first, last) from a single spectrum (m/z sorted, filter is tophat) and appends the results to output
+    template <typename MzIterator, typename IntIterator, typename ImIterator>
+    void extractCoordinateBlock_(const MzIterator& mz_start,
+                                 MzIterator mz_it,
+                                 const MzIterator& mz_end,
+                                 IntIterator int_it,
+                                 ImIterator im_it,
+                                 bool has_im,
+                                 double current_rt,
+                                 const std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& extraction_coordinates,
+                                 Size first,
+                                 Size last,
+                                 std::vector< OpenSwath::ChromatogramPtr >& output,
+                                 double mz_extraction_window,
+                                 bool ppm,
+                                 double im_extraction_window)
     {
-      ++mz_walker;
-      ++int_walker;
+      // go through all transitions / chromatograms which are sorted by
+      // ProductMZ. We can use this to step through the spectrum and at the
+      // same time step through the transitions. We increase the peak counter
+      // until we hit the next transition and then extract the signal.
+      for (Size k = first; k < last; ++k)
+      {
+        double integrated_intensity = 0;
+        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
+             (current_rt < extraction_coordinates[k].rt_start ||
+              current_rt > extraction_coordinates[k].rt_end) )
+        {
+          continue;
+        }
+
+        const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0 && has_im);
+        if (!use_im)
+        {
+          extractTophat_(mz_start, mz_it, mz_end, int_it,
+                         extraction_coordinates[k].mz, integrated_intensity, mz_extraction_window, ppm);
+        }
+        else
+        {
+          if (extraction_coordinates[k].ion_mobility < 0)
+          {
+            std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
+          }
+          extractTophat_(mz_start, mz_it, mz_end, int_it, im_it,
+                         extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
+                         integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
+        }
+
+        output[k]->getTimeArray()->data.push_back(current_rt);
+        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+      }
     }
-    while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+
+    // extracts all coordinates from a single spectrum (m/z sorted, filter is tophat) and appends the results to output
+    template <typename MzIterator, typename IntIterator, typename ImIterator>
+    void extractSpectrum_(const MzIterator& mz_start,
+                          const MzIterator& mz_end,
+                          IntIterator int_it,
+                          ImIterator im_it,
+                          bool has_im,
+                          double current_rt,
+                          const std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& extraction_coordinates,
+                          std::vector< OpenSwath::ChromatogramPtr >& output,
+                          double mz_extraction_window,
+                          bool ppm,
+                          double im_extraction_window)
     {
-      integrated_intensity += (*int_walker);
-      ++mz_walker;
-      ++int_walker;
+      const Size n_coordinates = extraction_coordinates.size();
+      // The ion mobility iterator only moves along with coordinates that use ion mobility, so its position
+      // cannot be derived from the m/z position. Such data is therefore processed in a single sweep.
+      if (has_im || n_coordinates <= coordinate_block_size)
+      {
+        extractCoordinateBlock_(mz_start, mz_start, mz_end, int_it, im_it, has_im, current_rt, extraction_coordinates,
+                                0, n_coordinates, output, mz_extraction_window, ppm, im_extraction_window);
+        return;
+      }
+
+      // Large libraries: process blocks of coordinates in parallel. Every block starts its sweep at the first
+      // peak not below the m/z of its first coordinate, which is exactly where the sweep over all preceding
+      // coordinates would have arrived (see extractTophat_). Each coordinate writes only to its own chromatogram.
+      const SignedSize n_blocks = (n_coordinates + coordinate_block_size - 1) / coordinate_block_size;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize block = 0; block < n_blocks; ++block)
+      {
+        Size first = block * coordinate_block_size;
+        Size last = std::min(first + coordinate_block_size, n_coordinates);
+        MzIterator mz_it = std::lower_bound(mz_start, mz_end, extraction_coordinates[first].mz);
+        IntIterator block_int_it = int_it;
+        std::advance(block_int_it, std::distance(mz_start, mz_it));
+        extractCoordinateBlock_(mz_start, mz_it, mz_end, block_int_it, im_it, has_im, current_rt, extraction_coordinates,
+                                first, last, output, mz_extraction_window, ppm, im_extraction_window);
+      }
     }
   }
 
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const std::vector<double>::const_iterator& mz_start,
+            std::vector<double>::const_iterator& mz_it,
+      const std::vector<double>::const_iterator& mz_end,
+            std::vector<double>::const_iterator& int_it,
+      const double mz,
+      double& integrated_intensity,
+      const double mz_extraction_window,
+      const bool ppm)
+  {
+    extractTophat_(mz_start, mz_it, mz_end, int_it, mz, integrated_intensity, mz_extraction_window, ppm);
+  }
+
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const SoASpectrum::MZArray::const_iterator& mz_start,
+            SoASpectrum::MZArray::const_iterator& mz_it,
+      const SoASpectrum::MZArray::const_iterator& mz_end,
+            SoASpectrum::IntensityArray::const_iterator& int_it,
+      const double mz,
+      double& integrated_intensity,
+      const double mz_extraction_window,
+      const bool ppm)
+  {
+    extractTophat_(mz_start, mz_it, mz_end, int_it, mz, integrated_intensity, mz_extraction_window, ppm);
+  }
+
   void ChromatogramExtractorAlgorithm::extract_value_tophat(
       const std::vector<double>::const_iterator& mz_start,
             std::vector<double>::const_iterator& mz_it,
@@ -157,114 +413,7 @@ namespace OpenMS
       const double im_extraction_window,
       const bool ppm)
   {
-    // Note that we have a 3D spectrum with m/z, intensity and ion mobility.
-    // The spectrum is sorted by m/z but we expect to have ion mobility
-    // information for each m/z point as well. Right now we simply filter by
-    // ion mobility and skip data that does not fall within the ion mobility
-    // window.
-
-    integrated_intensity = 0;
-    if (mz_start == mz_end)
-    {
-      return;
-    }
-
-    // calculate extraction window
-    double left, right;
-    if (ppm)
-    {
-      left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
-      right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
-    }
-    else
-    {
-      left  = mz - mz_extraction_window / 2.0;
-      right = mz + mz_extraction_window / 2.0;
-    }
-    double left_im  = im - im_extraction_window / 2.0;
-    double right_im = im + im_extraction_window / 2.0;
-
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator im_walker;
-    std::vector<double>::const_iterator int_walker;
-
-    // advance the mz / int iterator until we hit the m/z value of the next transition
-    while (mz_it != mz_end && (*mz_it) < mz)
-    {
-      mz_it++;
-      im_it++;
-      int_it++;
-    }
-
-    // walk right and left and add to our intensity
-    mz_walker  = mz_it;
-    im_walker  = im_it;
-    int_walker = int_it;
-
-    // if we moved past the end of the spectrum, we need to try the last peak
-    // of the spectrum (it could still be within the window)
-    if (mz_it == mz_end)
-    {
-      --mz_walker;
-      --im_walker;
-      --int_walker;
-    }
-
-    // add the current peak if it is between right and left
-    if ((*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
-    {
-      integrated_intensity += (*int_walker);
-    }
-
-    // (i) Walk to the left one step and then keep walking left until we go
-    // outside the window. Note for the first step to the left we have to
-    // check for the walker becoming equal to the first data point.
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    im_walker = im_it;
-    if (mz_it != mz_start)
-    {
-      --mz_walker;
-      --im_walker;
-      --int_walker;
-
-      // Special case: target m/z is larger than first data point but the first
-      // data point is inside the window.
-      // Then, mz_it is the second data point, mz_walker now points to the very
-      // first data point. If mz_it was the first data point, we already added
-      // it above. We still need to add this point if it is inside the window
-      // (while loop below will not catch it)
-      if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
-      {
-        integrated_intensity += (*int_walker);
-      }
-    }
-    while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
-    {
-      if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
-      --mz_walker;
-      --im_walker;
-      --int_walker;
-    }
-
-    // (ii) Walk to the right one step and then keep walking right until we are
-    // outside the window
-    mz_walker  = mz_it;
-    im_walker  = im_it;
-    int_walker = int_it;
-    if (mz_it != mz_end)
-    {
-      ++im_walker;
-      ++mz_walker;
-      ++int_walker;
-    }
-    while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
-    {
-      if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
-      ++mz_walker;
-      ++im_walker;
-      ++int_walker;
-    }
+    extractTophat_(mz_start, mz_it, mz_end, int_it, im_it, mz, im, integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
   }
 
   void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr input,
@@ -287,7 +436,10 @@ namespace OpenMS
         "Output and extraction coordinates need to have the same size: "+ String(output.size()) + " != " + String(extraction_coordinates.size()) );
     }
 
-    int used_filter = getFilterNr_(filter);
+    if (getFilterNr_(filter) == 2)
+    {
+      throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    }
     // assert that they are sorted!
     if (std::adjacent_find(extraction_coordinates.begin(), extraction_coordinates.end(),
           ExtractionCoordinates::SortExtractionCoordinatesReverseByMZ) != extraction_coordinates.end())
@@ -307,13 +459,9 @@ namespace OpenMS
 
       OpenSwath::BinaryDataArrayPtr mz_arr = sptr->getMZArray();
       OpenSwath::BinaryDataArrayPtr int_arr = sptr->getIntensityArray();
-      std::vector<double>::const_iterator mz_start = mz_arr->data.begin();
-      std::vector<double>::const_iterator mz_end = mz_arr->data.end();
-      std::vector<double>::const_iterator mz_it = mz_arr->data.begin();
-      std::vector<double>::const_iterator int_it = int_arr->data.begin();
       std::vector<double>::const_iterator im_it;
 
-      if (sptr->getMZArray()->data.empty())
+      if (mz_arr->data.empty())
       {
         continue;
       }
@@ -334,45 +482,73 @@ namespace OpenMS
         }
       }
 
-      // go through all transitions / chromatograms which are sorted by
-      // ProductMZ. We can use this to step through the spectrum and at the
-      // same time step through the transitions. We increase the peak counter
-      // until we hit the next transition and then extract the signal.
-      for (Size k = 0; k < extraction_coordinates.size(); ++k)
+      extractSpectrum_(mz_arr->data.cbegin(), mz_arr->data.cend(), int_arr->data.cbegin(), im_it, has_im, s_meta.RT,
+                       extraction_coordinates, output, mz_extraction_window, ppm, im_extraction_window);
+    }
+    endProgress();
+  }
+
+  void ChromatogramExtractorAlgorithm::extractChromatograms(const std::vector<SoASpectrum>& input,
+      const std::vector<double>& retention_times,
+      std::vector< OpenSwath::ChromatogramPtr >& output,
+      const std::vector<ExtractionCoordinates>& extraction_coordinates,
+      double mz_extraction_window,
+      bool ppm,
+      double im_extraction_window,
+      const String& filter)
+  {
+    if (input.size() != retention_times.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Spectra and retention times need to have the same size: "+ String(input.size()) + " != " + String(retention_times.size()) );
+    }
+    if (input.empty())
+    {
+      return;
+    }
+
+    if (output.size() != extraction_coordinates.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Output and extraction coordinates need to have the same size: "+ String(output.size()) + " != " + String(extraction_coordinates.size()) );
+    }
+
+    if (getFilterNr_(filter) == 2)
+    {
+      throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    }
+    if (std::adjacent_find(extraction_coordinates.begin(), extraction_coordinates.end(),
+          ExtractionCoordinates::SortExtractionCoordinatesReverseByMZ) != extraction_coordinates.end())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Input to extractChromatogram needs to be sorted by m/z");
+    }
+
+    startProgress(0, input.size(), "Extracting chromatograms");
+    for (Size scan_idx = 0; scan_idx < input.size(); ++scan_idx)
+    {
+      setProgress(scan_idx);
+
+      const SoASpectrum& spectrum = input[scan_idx];
+      if (spectrum.empty())
       {
-        double integrated_intensity = 0;
-        double current_rt = s_meta.RT;
-        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
-             (current_rt < extraction_coordinates[k].rt_start ||
-              current_rt > extraction_coordinates[k].rt_end) )
-        {
-          continue;
-        }
+        continue;
+      }
 
-        const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0 && has_im);
-        if (!use_im && used_filter == 1)
-        {
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it,
-                               extraction_coordinates[k].mz, integrated_intensity, mz_extraction_window, ppm);
-        }
-        else if (use_im && used_filter == 1)
-        {
-          if (extraction_coordinates[k].ion_mobility < 0)
-          {
-            std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
-          }
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
-                               extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
-                               integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
-        }
-        else if (used_filter == 2)
+      bool has_im = (im_extraction_window > 0.0);
+      std::vector<float>::const_iterator im_it;
+      if (has_im)
+      {
+        if (!spectrum.containsIMData())
         {
-          throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Requested ion mobility extraction but no ion mobility array found.");
         }
-
-        output[k]->getTimeArray()->data.push_back(current_rt);
-        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+        im_it = spectrum.getFloatDataArrays()[spectrum.getIMData().first].cbegin();
       }
+
+      extractSpectrum_(spectrum.getMZArray().cbegin(), spectrum.getMZArray().cend(), spectrum.getIntensityArray().cbegin(), im_it,
+                       has_im, retention_times[scan_idx], extraction_coordinates, output, mz_extraction_window, ppm, im_extraction_window);
     }
     endProgress();
   }
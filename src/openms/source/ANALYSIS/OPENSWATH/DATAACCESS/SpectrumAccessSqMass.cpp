@@ -35,6 +35,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessSqMass.h>
 
 #include <algorithm>    // std::lower_bound, std::upper_bound, std::sort
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -193,24 +194,43 @@ namespace OpenMS
     {
       OPENMS_PRECONDITION(deltaRT >= 0, "Delta RT needs to be a positive number");
       std::vector<std::size_t> res = handler_.getSpectraIndicesbyRT(RT, deltaRT, sidx_);
+      return mapToSubset_(res);
+    }
 
+    std::vector<std::size_t> SpectrumAccessSqMass::getSpectraByRange(double rt_min, double rt_max, int ms_level,
+                                                                     double precursor_mz_min, double precursor_mz_max) const
+    {
+      std::vector<int> res = handler_.getSpectraIndices(rt_min, rt_max, ms_level, precursor_mz_min, precursor_mz_max);
+      return mapToSubset_(std::vector<std::size_t>(res.begin(), res.end()));
+    }
+
+    std::vector<std::size_t> SpectrumAccessSqMass::mapToSubset_(const std::vector<std::size_t>& file_indices) const
+    {
       if (sidx_.empty())
       {
-        return res;
+        return file_indices;
       }
-      else
+
+      // we need to map the resulting indices back to the external indices
+      std::unordered_multimap<std::size_t, std::size_t> positions;
+      positions.reserve(sidx_.size());
+      for (Size s_it = 0; s_it < sidx_.size(); s_it++)
+      {
+        positions.emplace(sidx_[s_it], s_it);
+      }
+      std::vector<std::size_t> res_mapped;
+      for (Size k = 0; k < file_indices.size(); k++)
       {
-        // we need to map the resulting indices back to the external indices
-        std::vector<std::size_t> res_mapped;
-        for (Size k = 0; k < res.size(); k++)
+        auto range = positions.equal_range(file_indices[k]);
+        std::vector<std::size_t> matches;
+        for (auto it = range.first; it != range.second; ++it)
         {
-          for (Size s_it = 0; s_it < sidx_.size(); s_it++)
-          {
-            if (res[k] == (size_t)sidx_[s_it]) {res_mapped.push_back(s_it);}
-          }
+          matches.push_back(it->second);
         }
-        return res_mapped;
+        std::sort(matches.begin(), matches.end());
+        res_mapped.insert(res_mapped.end(), matches.begin(), matches.end());
       }
+      return res_mapped;
     }
 
     size_t SpectrumAccessSqMass::getNrSpectra() const
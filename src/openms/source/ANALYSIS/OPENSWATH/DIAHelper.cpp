@@ -64,7 +64,7 @@ namespace OpenMS::DIAHelpers
       }
     }
 
-    void integrateWindows(const OpenSwath::SpectrumPtr spectrum,
+    void integrateWindows(const OpenSwath::SpectrumPtr& spectrum,
                           const std::vector<double> & windowsCenter,
                           double width,
                           std::vector<double> & integratedWindowsIntensity,
@@ -91,7 +91,7 @@ namespace OpenMS::DIAHelpers
       }
     }
 
-    void integrateDriftSpectrum(OpenSwath::SpectrumPtr spectrum, 
+    void integrateDriftSpectrum(const OpenSwath::SpectrumPtr& spectrum, 
                                               double mz_start,
                                               double mz_end,
                                               double & im,
@@ -146,7 +146,7 @@ namespace OpenMS::DIAHelpers
 
     }
 
-    bool integrateWindow(const OpenSwath::SpectrumPtr spectrum,
+    bool integrateWindow(const OpenSwath::SpectrumPtr& spectrum,
                          double mz_start,
                          double mz_end,
                          double & mz,
@@ -51,14 +51,108 @@
 #include <numeric>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
 
 #include <boost/bind.hpp>
+#include <boost/functional/hash.hpp>
 #include <cmath> // for isnan
 
 const double C13C12_MASSDIFF_U = 1.0033548;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Buffers and caches reused between the scoring calls of one thread
+
+      The same transitions and peptides are scored for every peak group of a
+      transition group, thus the theoretical isotope patterns and b/y series
+      are computed once and looked up afterwards.
+    */
+    struct DIAScoringWorkspace
+    {
+      /// maximal number of cached averagine patterns before the cache is cleared
+      static const Size max_cached_patterns = 65536;
+
+      /// normalized averagine isotope intensities by (weight, number of isotopes)
+      std::unordered_map<std::pair<double, int>, std::vector<double>, boost::hash<std::pair<double, int> > > averagine_patterns;
+
+      /// experimental isotope intensities
+      std::vector<double> isotopes_int;
+
+      /// relative intensities of the transitions of a feature
+      std::vector<double> rel_intensities;
+
+      /// b/y series of the most recently scored peptide
+      AASequence by_sequence;
+      int by_charge = 0;
+      const TheoreticalSpectrumGenerator* by_generator = nullptr;
+      std::vector<double> bseries;
+      std::vector<double> yseries;
+    };
+
+    DIAScoringWorkspace& scoringWorkspace_()
+    {
+      thread_local DIAScoringWorkspace workspace;
+      return workspace;
+    }
+
+    /// intensities of @p isotope_dist scaled to a maximum of 1
+    void normalizedIsotopeIntensities_(const IsotopeDistribution& isotope_dist, std::vector<double>& intensities)
+    {
+      intensities.clear();
+      for (IsotopeDistribution::ConstIterator it = isotope_dist.begin(); it != isotope_dist.end(); ++it)
+      {
+        intensities.push_back(it->getIntensity());
+      }
+      double max = 0.0;
+      for (Size i = 0; i < intensities.size(); ++i)
+      {
+        if (intensities[i] > max)
+        {
+          max = intensities[i];
+        }
+      }
+      if (max == 0.) max = 1.;
+      for (Size i = 0; i < intensities.size(); ++i)
+      {
+        intensities[i] /= max;
+      }
+    }
+
+    /// normalized averagine isotope intensities for @p weight (computed once per thread)
+    const std::vector<double>& averagineIsotopeIntensities_(double weight, int nr_isotopes)
+    {
+      DIAScoringWorkspace& workspace = scoringWorkspace_();
+      const std::pair<double, int> key(weight, nr_isotopes);
+      auto it = workspace.averagine_patterns.find(key);
+      if (it != workspace.averagine_patterns.end())
+      {
+        return it->second;
+      }
+      if (workspace.averagine_patterns.size() >= DIAScoringWorkspace::max_cached_patterns)
+      {
+        workspace.averagine_patterns.clear();
+      }
+      CoarseIsotopePatternGenerator solver(nr_isotopes + 1);
+      std::vector<double>& intensities = workspace.averagine_patterns[key];
+      normalizedIsotopeIntensities_(solver.estimateFromPeptideWeight(weight), intensities);
+      return intensities;
+    }
+
+    /// Pearson correlation of experimental and theoretical isotope intensities (0 if undefined)
+    double correlateIsotopePattern_(const std::vector<double>& isotopes_int, const std::vector<double>& theoretical)
+    {
+      OPENMS_POSTCONDITION(isotopes_int.size() == theoretical.size(), "Vectors for pearson correlation do not have the same size.");
+      double int_score = OpenSwath::cor_pearson(isotopes_int.begin(), isotopes_int.end(), theoretical.begin());
+      if (std::isnan(int_score))
+      {
+        int_score = 0;
+      }
+      return int_score;
+    }
+  }
 
   DIAScoring::DIAScoring() :
     DefaultParamHandler("DIAScoring")
@@ -129,8 +223,8 @@ namespace OpenMS
   {
     isotope_corr = 0;
     isotope_overlap = 0;
-    // first compute a map of relative intensities from the feature, then compute the score
-    std::map<std::string, double> intensities;
+    // first compute the relative intensities from the feature, then compute the score
+    std::vector<double>& intensities = scoringWorkspace_().rel_intensities;
     getFirstIsotopeRelativeIntensities_(transitions, mrmfeature, intensities);
     diaIsotopeScoresSub_(transitions, spectrum, intensities, isotope_corr, isotope_overlap);
   }
@@ -208,7 +302,8 @@ namespace OpenMS
     // although precursor_mz can be received from the empirical formula (if non-empty), the actual precursor could be
     // slightly different. And also for compounds, usually the neutral sum_formula without adducts is given.
     // Therefore calculate the isotopes based on the formula but place them at precursor_mz
-    std::vector<double> isotopes_int;
+    std::vector<double>& isotopes_int = scoringWorkspace_().isotopes_int;
+    isotopes_int.clear();
     getIsotopeIntysFromExpSpec_(precursor_mz, spectrum, isotopes_int, sum_formula.getCharge());
 
     double max_ratio = 0;
@@ -221,7 +316,7 @@ namespace OpenMS
     isotope_overlap = max_ratio;
   }
 
-  void DIAScoring::getIsotopeIntysFromExpSpec_(double precursor_mz, SpectrumPtrType spectrum,
+  void DIAScoring::getIsotopeIntysFromExpSpec_(double precursor_mz, const SpectrumPtrType& spectrum,
                             std::vector<double>& isotopes_int,
                             int charge_state) const
   {
@@ -241,17 +336,18 @@ namespace OpenMS
                                                     double& isotope_corr, double& isotope_overlap,
                                                     int charge_state) const
   {
-    std::vector<double> exp_isotopes_int;
+    std::vector<double>& exp_isotopes_int = scoringWorkspace_().isotopes_int;
+    exp_isotopes_int.clear();
     getIsotopeIntysFromExpSpec_(precursor_mz, spectrum, exp_isotopes_int, charge_state);
-    CoarseIsotopePatternGenerator solver(dia_nr_isotopes_ + 1);
+
     // NOTE: this is a rough estimate of the neutral mz value since we would not know the charge carrier for negative ions
-    IsotopeDistribution isotope_dist = solver.estimateFromPeptideWeight(std::fabs(precursor_mz * charge_state));
+    const std::vector<double>& theoretical = averagineIsotopeIntensities_(std::fabs(precursor_mz * charge_state), (int)dia_nr_isotopes_);
 
     double max_ratio;
     int nr_occurrences;
     // calculate the scores:
     // isotope correlation (forward) and the isotope overlap (backward) scores
-    isotope_corr = scoreIsotopePattern_(exp_isotopes_int, isotope_dist);
+    isotope_corr = correlateIsotopePattern_(exp_isotopes_int, theoretical);
     largePeaksBeforeFirstIsotope_(spectrum, precursor_mz, exp_isotopes_int[0], nr_occurrences, max_ratio);
     isotope_overlap = max_ratio;
   }
@@ -265,8 +361,19 @@ namespace OpenMS
     OPENMS_PRECONDITION(charge > 0, "Charge is a positive integer"); // for peptides, charge should be positive
 
     double mz, intensity, left, right;
-    std::vector<double> yseries, bseries;
-    OpenMS::DIAHelpers::getBYSeries(sequence, bseries, yseries, generator, charge);
+    // the b/y series only depend on the peptide, which is the same for all peak groups of a transition group
+    DIAScoringWorkspace& workspace = scoringWorkspace_();
+    if (workspace.by_generator != generator || workspace.by_charge != charge || !(workspace.by_sequence == sequence))
+    {
+      workspace.bseries.clear();
+      workspace.yseries.clear();
+      OpenMS::DIAHelpers::getBYSeries(sequence, workspace.bseries, workspace.yseries, generator, charge);
+      workspace.by_sequence = sequence;
+      workspace.by_charge = charge;
+      workspace.by_generator = generator;
+    }
+    const std::vector<double>& bseries = workspace.bseries;
+    const std::vector<double>& yseries = workspace.yseries;
     for (const auto& b_ion_mz : bseries)
     {
       left = b_ion_mz;
@@ -308,29 +415,28 @@ namespace OpenMS
   /// computes a vector of relative intensities for each feature (output to intensities)
   void DIAScoring::getFirstIsotopeRelativeIntensities_(
     const std::vector<TransitionType>& transitions,
-    OpenSwath::IMRMFeature* mrmfeature, std::map<std::string, double>& intensities) const
+    OpenSwath::IMRMFeature* mrmfeature, std::vector<double>& intensities) const
   {
+    intensities.clear();
     for (Size k = 0; k < transitions.size(); k++)
     {
-      std::string native_id = transitions[k].getNativeID();
-      double rel_intensity = mrmfeature->getFeature(native_id)->getIntensity() / mrmfeature->getIntensity();
-      intensities.insert(std::pair<std::string, double>(native_id, rel_intensity));
+      double rel_intensity = mrmfeature->getFeature(transitions[k].getNativeID())->getIntensity() / mrmfeature->getIntensity();
+      intensities.push_back(rel_intensity);
     }
   }
 
-  void DIAScoring::diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions, SpectrumPtrType spectrum,
-                                        std::map<std::string, double>& intensities, //relative intensities
+  void DIAScoring::diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions, const SpectrumPtrType& spectrum,
+                                        const std::vector<double>& intensities, //relative intensities
                                         double& isotope_corr,
                                         double& isotope_overlap) const
   {
-    std::vector<double> isotopes_int;
+    std::vector<double>& isotopes_int = scoringWorkspace_().isotopes_int;
     double max_ratio;
     int nr_occurences;
     for (Size k = 0; k < transitions.size(); k++)
     {
       isotopes_int.clear();
-      const String native_id = transitions[k].getNativeID();
-      double rel_intensity = intensities[native_id];
+      double rel_intensity = intensities[k];
 
       // If no charge is given, we assume it to be 1
       int putative_fragment_charge = 1;
@@ -360,7 +466,7 @@ namespace OpenMS
     }
   }
 
-  void DIAScoring::largePeaksBeforeFirstIsotope_(SpectrumPtrType spectrum, double mono_mz, double mono_int, int& nr_occurences, double& max_ratio) const
+  void DIAScoring::largePeaksBeforeFirstIsotope_(const SpectrumPtrType& spectrum, double mono_mz, double mono_int, int& nr_occurences, double& max_ratio) const
   {
     double mz, intensity;
     nr_occurences = 0;
@@ -415,14 +521,11 @@ namespace OpenMS
   {
     OPENMS_PRECONDITION(putative_fragment_charge != 0, "Charge needs to be set to != 0"); // charge can be positive and negative
 
-    IsotopeDistribution isotope_dist;
-
     // create the theoretical distribution from the peptide weight
-    CoarseIsotopePatternGenerator solver(dia_nr_isotopes_ + 1);
     // NOTE: this is a rough estimate of the neutral mz value since we would not know the charge carrier for negative ions
-    isotope_dist = solver.estimateFromPeptideWeight(std::fabs(product_mz * putative_fragment_charge));
+    const std::vector<double>& theoretical = averagineIsotopeIntensities_(std::fabs(product_mz * putative_fragment_charge), (int)dia_nr_isotopes_);
 
-    return scoreIsotopePattern_(isotopes_int, isotope_dist);
+    return correlateIsotopePattern_(isotopes_int, theoretical);
   } //end of dia_isotope_corr_sub
 
   double DIAScoring::scoreIsotopePattern_(const std::vector<double>& isotopes_int,
@@ -435,41 +538,9 @@ namespace OpenMS
   double DIAScoring::scoreIsotopePattern_(const std::vector<double>& isotopes_int,
                                           const IsotopeDistribution& isotope_dist) const
   {
-    typedef OpenMS::FeatureFinderAlgorithmPickedHelperStructs::TheoreticalIsotopePattern TheoreticalIsotopePattern;
-
-    TheoreticalIsotopePattern isotopes;
-
-    for (IsotopeDistribution::ConstIterator it = isotope_dist.begin(); it != isotope_dist.end(); ++it)
-    {
-      isotopes.intensity.push_back(it->getIntensity());
-    }
-    isotopes.optional_begin = 0;
-    isotopes.optional_end = dia_nr_isotopes_;
-
-    // scale the distribution to a maximum of 1
-    double max = 0.0;
-    for (Size i = 0; i < isotopes.intensity.size(); ++i)
-    {
-      if (isotopes.intensity[i] > max)
-      {
-        max = isotopes.intensity[i];
-      }
-    }
-    isotopes.max = max;
-    if (max == 0.) max = 1.;
-    for (Size i = 0; i < isotopes.intensity.size(); ++i)
-    {
-      isotopes.intensity[i] /= max;
-    }
-    isotopes.trimmed_left = 0;
-
-    // score the pattern against a theoretical one
-    OPENMS_POSTCONDITION(isotopes_int.size() == isotopes.intensity.size(), "Vectors for pearson correlation do not have the same size.");
-    double int_score = OpenSwath::cor_pearson(isotopes_int.begin(), isotopes_int.end(), isotopes.intensity.begin());
-    if (std::isnan(int_score))
-    {
-      int_score = 0;
-    }
-    return int_score;
+    // score the pattern against a theoretical one scaled to a maximum of 1
+    std::vector<double> theoretical;
+    normalizedIsotopeIntensities_(isotope_dist, theoretical);
+    return correlateIsotopePattern_(isotopes_int, theoretical);
   } //end of dia_isotope_corr_sub
 }
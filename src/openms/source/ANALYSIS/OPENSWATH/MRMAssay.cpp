@@ -37,6 +37,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <boost/lexical_cast.hpp>
+#include <exception>
 #include <regex>
 #include <unordered_set>
 #include <map>
@@ -73,6 +74,27 @@ namespace OpenMS
     return isoforms;
   }
 
+  std::vector<std::string> MRMAssay::getMatchingPeptidoformsSorted_(const double fragment_ion,
+                                                                    const FragmentSeqMap& sorted_ions,
+                                                                    const double mz_threshold)
+  {
+    std::vector<std::string> isoforms;
+
+    // the ions matching the upper condition form a suffix, the ones matching
+    // the lower condition a prefix of the sorted ions
+    auto it = std::partition_point(sorted_ions.begin(), sorted_ions.end(),
+      [&](const std::pair<double, std::string>& ion) { return !(ion.first + mz_threshold >= fragment_ion); });
+    for (; it != sorted_ions.end() && it->first - mz_threshold <= fragment_ion; ++it)
+    {
+      isoforms.push_back(it->second);
+    }
+
+    std::sort(isoforms.begin(), isoforms.end());
+    isoforms.erase(std::unique(isoforms.begin(), isoforms.end()), isoforms.end());
+
+    return isoforms;
+  }
+
   int MRMAssay::getSwath_(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     int swath = -1;
@@ -422,6 +444,15 @@ namespace OpenMS
       }
     }
     endProgress();
+
+    // sort the ions of each window by m/z for getMatchingPeptidoformsSorted_()
+    for (auto& swath_it : TargetIonMap)
+    {
+      for (auto& seq_it : swath_it.second)
+      {
+        std::sort(seq_it.second.begin(), seq_it.second.end());
+      }
+    }
   }
 
   void MRMAssay::generateDecoySequences_(const SequenceMapT& TargetSequenceMap,
@@ -566,6 +597,15 @@ namespace OpenMS
       }
     }
     endProgress();
+
+    // sort the ions of each window by m/z for getMatchingPeptidoformsSorted_()
+    for (auto& swath_it : DecoyIonMap)
+    {
+      for (auto& seq_it : swath_it.second)
+      {
+        std::sort(seq_it.second.begin(), seq_it.second.end());
+      }
+    }
   }
 
  void MRMAssay::generateTargetAssays_(const OpenMS::TargetedExperiment& exp,
@@ -576,69 +616,111 @@ namespace OpenMS
                                       const PeptideMapT& TargetPeptideMap,
                                       const IonMapT & TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 3: Generate target identification transitions
-    Size progress = 0;
     startProgress(0, TargetPeptideMap.size(), "Generation of target identification transitions");
 
-    // Iterate over all target peptides
-    int transition_index = 0;
-    for (const auto& pep_it : TargetPeptideMap)
-    { 
-      setProgress(progress++);
+    // Peptides are processed in parallel; the transitions of each peptide are
+    // numbered locally and renamed with their global index when merged in
+    // peptide order, so the output does not depend on the number of threads.
+    std::vector<PeptideMapT::const_iterator> peptide_its;
+    std::vector<const TargetedExperiment::Peptide*> target_peptides; // reference lookups are not thread-safe
+    peptide_its.reserve(TargetPeptideMap.size());
+    target_peptides.reserve(TargetPeptideMap.size());
+    for (auto pep_it = TargetPeptideMap.begin(); pep_it != TargetPeptideMap.end(); ++pep_it)
+    {
+      peptide_its.push_back(pep_it);
+      target_peptides.push_back(&exp.getPeptideByRef(pep_it->first));
+    }
+    std::vector<TransitionVectorType> peptide_transitions(peptide_its.size());
+    std::vector<std::vector<std::pair<int, String> > > peptide_names(peptide_its.size()); // local index and remainder of the identifier
+    std::vector<int> peptide_nr_indices(peptide_its.size(), 0);
+    std::vector<std::exception_ptr> errors(peptide_its.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 50)
+#endif
+    for (SignedSize k = 0; k < (SignedSize)peptide_its.size(); ++k)
+    {
+      try
+      {
+        const auto& pep_it = *peptide_its[k];
+        MRMIonSeries mrmis;
 
-      TargetedExperiment::Peptide peptide = exp.getPeptideByRef(pep_it.first);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
+        const TargetedExperiment::Peptide& peptide = *target_peptides[k];
+        int precursor_charge = 1;
+        if (peptide.hasCharge()) 
+        {
+          precursor_charge = peptide.getChargeState();
+        }
+        AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+        int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMZ(precursor_charge));
+        const FragmentSeqMap& target_ions = TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString());
+
+        // Sort all transitions and make them unique
+        auto transition_vector = pep_it.second;
+        std::sort(transition_vector.begin(), transition_vector.end());
+        auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+
+        // Iterate over all transitions
+        for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
+        { 
+          // Compute the set of peptidoforms mapping to this transition
+          vector<string> isoforms = getMatchingPeptidoformsSorted_(tr_it->second, target_ions, mz_threshold);
+
+          // Check that transition maps to at least one peptidoform
+          if (!isoforms.empty())
+          {
+            ReactionMonitoringTransition trn;
+            trn.setDetectingTransition(false);
+            trn.setMetaValue("insilico_transition", "true");
+            trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMZ(precursor_charge), round_decPow));
+            trn.setProductMZ(tr_it->second);
+            trn.setPeptideRef(peptide.id);
+            mrmis.annotateTransitionCV(trn, tr_it->first);
+            trn.setIdentifyingTransition(true);
+            trn.setQuantifyingTransition(false);
+
+            // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
+            peptide_names[k].emplace_back(peptide_nr_indices[k], "_" + String("UIS") +  \
+              "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
+              String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" + 
+              String(peptide.getRetentionTime()) + "_" + tr_it->first);
+            trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
+
+            // Append transition
+            peptide_transitions[k].push_back(std::move(trn));
+          }
+          peptide_nr_indices[k]++;
+        }
+      }
+      catch (...)
       {
-        precursor_charge = peptide.getChargeState();
+        errors[k] = std::current_exception();
       }
-      AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMZ(precursor_charge));
-
-      // Sort all transitions and make them unique
-      auto transition_vector = pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+      nextProgress();
+    }
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
 
-      // Iterate over all transitions
-      for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
-      { 
-        // Compute the set of peptidoforms mapping to this transition
-        vector<string> isoforms = getMatchingPeptidoforms_(
-            tr_it->second, TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString()), mz_threshold);
+    int transition_index = 0;
+    for (Size k = 0; k < peptide_its.size(); ++k)
+    {
+      for (Size i = 0; i < peptide_transitions[k].size(); ++i)
+      {
+        ReactionMonitoringTransition& trn = peptide_transitions[k][i];
+        String identifier = String(transition_index + peptide_names[k][i].first) + peptide_names[k][i].second;
+        trn.setName(identifier); 
+        trn.setNativeID(identifier);
 
-        // Check that transition maps to at least one peptidoform
-        if (!isoforms.empty())
-        {
-          ReactionMonitoringTransition trn;
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(peptide_sequence.getMZ(precursor_charge), round_decPow));
-          trn.setProductMZ(tr_it->second);
-          trn.setPeptideRef(peptide.id);
-          mrmis.annotateTransitionCV(trn, tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UIS") +  \
-            "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
-            String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" + 
-            String(peptide.getRetentionTime()) + "_" + tr_it->first; 
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
-
-          OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
+        OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
 
-          // Append transition
-          transitions.push_back(trn);
-        }
-        transition_index++;
+        // Append transition
+        transitions.push_back(std::move(trn));
       }
-      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptide.id << std::endl;
+      transition_index += peptide_nr_indices[k];
+      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptide_its[k]->first << std::endl;
     }
     endProgress();
   }
@@ -653,83 +735,130 @@ namespace OpenMS
                                      const IonMapT& DecoyIonMap,
                                      const IonMapT& TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 4: Generate decoy identification transitions
-    Size progress = 0;
     startProgress(0, DecoyPeptideMap.size(), "Generation of decoy identification transitions");
 
-    // Iterate over all decoy peptides
-    int transition_index = 0;
-    for (const auto & decoy_pep_it : DecoyPeptideMap)
+    // Peptides are processed in parallel as in generateTargetAssays_(); the
+    // peptide lookups are resolved beforehand since they are not thread-safe.
+    std::vector<PeptideMapT::const_iterator> peptide_its;
+    std::vector<const TargetedExperiment::Peptide*> target_peptides, decoy_peptides;
+    peptide_its.reserve(DecoyPeptideMap.size());
+    target_peptides.reserve(DecoyPeptideMap.size());
+    decoy_peptides.reserve(DecoyPeptideMap.size());
+    for (auto decoy_pep_it = DecoyPeptideMap.begin(); decoy_pep_it != DecoyPeptideMap.end(); ++decoy_pep_it)
     {
-      setProgress(progress++);
-      TargetedExperiment::Peptide target_peptide = exp.getPeptideByRef(decoy_pep_it.first);
-      int precursor_charge = 1;
-      if (target_peptide.hasCharge()) 
+      peptide_its.push_back(decoy_pep_it);
+      target_peptides.push_back(&exp.getPeptideByRef(decoy_pep_it->first));
+      decoy_peptides.push_back(&TargetDecoyMap[decoy_pep_it->first]);
+    }
+    std::vector<TransitionVectorType> peptide_transitions(peptide_its.size());
+    std::vector<std::vector<std::pair<int, String> > > peptide_names(peptide_its.size()); // local index and remainder of the identifier
+    std::vector<int> peptide_nr_indices(peptide_its.size(), 0);
+    std::vector<std::exception_ptr> errors(peptide_its.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 50)
+#endif
+    for (SignedSize k = 0; k < (SignedSize)peptide_its.size(); ++k)
+    {
+      try
       {
-        precursor_charge = target_peptide.getChargeState();
-      }
-      AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMZ(precursor_charge));
+        const auto& decoy_pep_it = *peptide_its[k];
+        MRMIonSeries mrmis;
 
-      TargetedExperiment::Peptide decoy_peptide = TargetDecoyMap[decoy_pep_it.first];
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+        const TargetedExperiment::Peptide& target_peptide = *target_peptides[k];
+        int precursor_charge = 1;
+        if (target_peptide.hasCharge()) 
+        {
+          precursor_charge = target_peptide.getChargeState();
+        }
+        AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+        int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMZ(precursor_charge));
 
-      // Sort all transitions and make them unique
-      auto transition_vector = decoy_pep_it.second;
-      std::sort(transition_vector.begin(), transition_vector.end());
-      auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
+        const TargetedExperiment::Peptide& decoy_peptide = *decoy_peptides[k];
+        OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
 
-      // Iterate over all transitions
-      for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
-      {
-        // Check mapping of transitions to other peptidoforms
-        vector<string> decoy_isoforms = getMatchingPeptidoforms_(
-            decoy_tr_it->second, DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString()), mz_threshold);
+        const FragmentSeqMap& decoy_ions = DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString());
+        const FragmentSeqMap* target_ions = nullptr; // only looked up when needed
+
+        // Sort all transitions and make them unique
+        auto transition_vector = decoy_pep_it.second;
+        std::sort(transition_vector.begin(), transition_vector.end());
+        auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
-        // Check that transition maps to at least one peptidoform
-        if (!decoy_isoforms.empty())
+        // Iterate over all transitions
+        for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
         {
-          ReactionMonitoringTransition trn;
-          trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-          trn.setDetectingTransition(false);
-          trn.setMetaValue("insilico_transition", "true");
-          trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMZ(precursor_charge), round_decPow));
-          trn.setProductMZ(decoy_tr_it->second);
-          trn.setPeptideRef(decoy_peptide.id);
-          mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
-          trn.setIdentifyingTransition(true);
-          trn.setQuantifyingTransition(false);
-
-          // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UISDECOY") +
-                "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
-                String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
-                String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first;
-          trn.setName(identifier); 
-          trn.setNativeID(identifier);
-          trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
-
-          OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
-
-          // Check if decoy transition is overlapping with target transition
-          vector<string> target_isoforms_overlap = getMatchingPeptidoforms_(
-              decoy_tr_it->second, TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString()), mz_threshold);
-
-          if (!target_isoforms_overlap.empty())
-          {
-            OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << trn.getNativeID() << std::endl;
-            continue;
-          }
-          else
+          // Check mapping of transitions to other peptidoforms
+          vector<string> decoy_isoforms = getMatchingPeptidoformsSorted_(decoy_tr_it->second, decoy_ions, mz_threshold);
+
+          // Check that transition maps to at least one peptidoform
+          if (!decoy_isoforms.empty())
           {
+            // Check if decoy transition is overlapping with target transition
+            if (target_ions == nullptr)
+            {
+              target_ions = &TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString());
+            }
+            vector<string> target_isoforms_overlap = getMatchingPeptidoformsSorted_(decoy_tr_it->second, *target_ions, mz_threshold);
+
+            if (!target_isoforms_overlap.empty())
+            {
+              OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << decoy_tr_it->first << " of " << decoy_peptide.id << std::endl;
+              continue;
+            }
+
+            ReactionMonitoringTransition trn;
+            trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+            trn.setDetectingTransition(false);
+            trn.setMetaValue("insilico_transition", "true");
+            trn.setPrecursorMZ(Math::roundDecimal(target_peptide_sequence.getMZ(precursor_charge), round_decPow));
+            trn.setProductMZ(decoy_tr_it->second);
+            trn.setPeptideRef(decoy_peptide.id);
+            mrmis.annotateTransitionCV(trn, decoy_tr_it->first);
+            trn.setIdentifyingTransition(true);
+            trn.setQuantifyingTransition(false);
+
+            // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
+            peptide_names[k].emplace_back(peptide_nr_indices[k], "_" + String("UISDECOY") +
+                  "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
+                  String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
+                  String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first);
+            trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
+
             // Append transition
-            transitions.push_back(trn);
+            peptide_transitions[k].push_back(std::move(trn));
           }
+          peptide_nr_indices[k]++;
         }
-        transition_index++;
       }
+      catch (...)
+      {
+        errors[k] = std::current_exception();
+      }
+      nextProgress();
+    }
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
+
+    int transition_index = 0;
+    for (Size k = 0; k < peptide_its.size(); ++k)
+    {
+      for (Size i = 0; i < peptide_transitions[k].size(); ++i)
+      {
+        ReactionMonitoringTransition& trn = peptide_transitions[k][i];
+        String identifier = String(transition_index + peptide_names[k][i].first) + peptide_names[k][i].second;
+        trn.setName(identifier); 
+        trn.setNativeID(identifier);
+
+        OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
+
+        // Append transition
+        transitions.push_back(std::move(trn));
+      }
+      transition_index += peptide_nr_indices[k];
     }
     endProgress();
   }
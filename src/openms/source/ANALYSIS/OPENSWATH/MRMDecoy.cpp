@@ -45,6 +45,7 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <boost/unordered_map.hpp>
+#include <exception>
 #include <unordered_set>
 
 namespace OpenMS
@@ -406,7 +407,6 @@ namespace OpenMS
                                 const std::vector<String>& fragment_types, const std::vector<size_t>& fragment_charges,
                                 const bool enable_specific_losses, const bool enable_unspecific_losses, const int round_decPow) const
   {
-    MRMIonSeries mrmis;
     MRMDecoy::PeptideVectorType peptides, decoy_peptides;
     MRMDecoy::ProteinVectorType proteins, decoy_proteins;
     MRMDecoy::TransitionVectorType decoy_transitions;
@@ -454,59 +454,92 @@ namespace OpenMS
 
     std::unordered_set<String> exclusion_peptides;
     // Go through all peptides and apply the decoy method to the sequence
-    // (pseudo-reverse, reverse or shuffle). Then set the peptides and proteins of the decoy
-    // experiment.
-    Size progress = 0;
+    // (pseudo-reverse, reverse or shuffle). The decoy sequences are computed
+    // in parallel, the checks against the targets and previously generated
+    // decoys are done afterwards in the original order so that the result
+    // does not depend on the number of threads.
+    std::vector<OpenMS::TargetedExperiment::Peptide> decoy_candidates(selection_list.size());
+    std::vector<char> has_cn_terminal_mods(selection_list.size(), false);
+    std::vector<std::exception_ptr> errors(selection_list.size());
     startProgress(0, selection_list.size(), "Generating decoy peptides");
-    for (const auto& pep_idx : selection_list)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)selection_list.size(); ++i)
     {
-      setProgress(++progress);
-
-      OpenMS::TargetedExperiment::Peptide peptide = exp.getPeptides()[pep_idx];
+      try
+      {
+        OpenMS::TargetedExperiment::Peptide peptide = exp.getPeptides()[selection_list[i]];
 
-      peptide.id = decoy_tag + peptide.id;
+        peptide.id = decoy_tag + peptide.id;
 
-      if (!peptide.getPeptideGroupLabel().empty())
-      {
-        peptide.setPeptideGroupLabel(decoy_tag + peptide.getPeptideGroupLabel());
-      }
+        if (!peptide.getPeptideGroupLabel().empty())
+        {
+          peptide.setPeptideGroupLabel(decoy_tag + peptide.getPeptideGroupLabel());
+        }
 
-      if (method == "pseudo-reverse")
-      {
-        // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
-        if (MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
+        if (method == "pseudo-reverse")
         {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
+          // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
+          if (MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
+          {
+            has_cn_terminal_mods[i] = true;
+          }
+          else
+          {
+            peptide = MRMDecoy::pseudoreversePeptide_(peptide);
+            if (do_switchKR) { switchKR(peptide); }
+          }
         }
-        else
+        else if (method == "reverse")
         {
-          peptide = MRMDecoy::pseudoreversePeptide_(peptide);
-          if (do_switchKR) { switchKR(peptide); }
+          // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
+          if (MRMDecoy::hasCNterminalMods_(peptide, false))
+          {
+            has_cn_terminal_mods[i] = true;
+          }
+          else
+          {
+            peptide = MRMDecoy::reversePeptide_(peptide);
+          }
         }
-      }
-      else if (method == "reverse")
-      {
-        // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
-        if (MRMDecoy::hasCNterminalMods_(peptide, false))
+        else if (method == "shuffle")
         {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
+          peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, -1, max_attempts);
+          if (do_switchKR && MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
+          {
+            has_cn_terminal_mods[i] = true;
+          }
+          else if (do_switchKR) { switchKR(peptide); }
         }
-        else
+
+        for (Size prot_idx = 0; prot_idx < peptide.protein_refs.size(); ++prot_idx)
         {
-          peptide = MRMDecoy::reversePeptide_(peptide);
+          peptide.protein_refs[prot_idx] = decoy_tag + peptide.protein_refs[prot_idx];
         }
+
+        decoy_candidates[i] = std::move(peptide);
       }
-      else if (method == "shuffle")
+      catch (...)
       {
-        peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, -1, max_attempts);
-        if (do_switchKR && MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
-        {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
-        }
-        else if (do_switchKR) { switchKR(peptide); }
+        errors[i] = std::current_exception();
+      }
+      nextProgress();
+    }
+    endProgress();
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
+
+    peptides.reserve(decoy_candidates.size());
+    for (Size i = 0; i < decoy_candidates.size(); ++i)
+    {
+      OpenMS::TargetedExperiment::Peptide& peptide = decoy_candidates[i];
+      if (has_cn_terminal_mods[i])
+      {
+        OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
+        exclusion_peptides.insert(peptide.id);
       }
 
       // Check that the decoy sequence does not happen to be a target sequence AND is not already present
@@ -522,14 +555,8 @@ namespace OpenMS
         allPeptideSequences[MRMDecoy::getModifiedPeptideSequence_(peptide)] = peptide.id;
       }
 
-      for (Size prot_idx = 0; prot_idx < peptide.protein_refs.size(); ++prot_idx)
-      {
-        peptide.protein_refs[prot_idx] = decoy_tag + peptide.protein_refs[prot_idx];
-      }
-
-      peptides.push_back(peptide);
+      peptides.push_back(std::move(peptide));
     }
-    endProgress();
     dec.setPeptides(peptides); // temporary set peptides, overwrite later again!
 
     // hash of the peptide reference containing all transitions
@@ -539,82 +566,123 @@ namespace OpenMS
       peptide_trans_map[exp.getTransitions()[i].getPeptideRef()].push_back(&exp.getTransitions()[i]);
     }
 
-    progress = 0;
-    startProgress(0, peptide_trans_map.size(), "Generating decoy transitions");
-    for (MRMDecoy::PeptideTransitionMapType::iterator pep_it = peptide_trans_map.begin();
-         pep_it != peptide_trans_map.end(); ++pep_it)
+    // Resolve target and decoy peptides up front: the reference lookups of
+    // TargetedExperiment build their index lazily and are not thread-safe.
+    struct DecoyTransitionTask
     {
-      setProgress(++progress);
-
-      String peptide_ref = pep_it->first;
-      String decoy_peptide_ref = decoy_tag + pep_it->first; // see above, the decoy peptide id is computed deterministically from the target id
+      const TargetedExperiment::Peptide* target_peptide;
+      const TargetedExperiment::Peptide* decoy_peptide;
+      const std::vector<const ReactionMonitoringTransition*>* transitions;
+    };
+    std::vector<DecoyTransitionTask> tasks;
+    tasks.reserve(peptide_trans_map.size());
+    for (const auto& pep_it : peptide_trans_map)
+    {
+      String decoy_peptide_ref = decoy_tag + pep_it.first; // see above, the decoy peptide id is computed deterministically from the target id
       if (!dec.hasPeptide(decoy_peptide_ref)) { continue; }
-      const TargetedExperiment::Peptide target_peptide = exp.getPeptideByRef(peptide_ref);
-
-      const TargetedExperiment::Peptide decoy_peptide = dec.getPeptideByRef(decoy_peptide_ref);
-      OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
-
-      int decoy_charge = 1;
-      int target_charge = 1;
-      if (decoy_peptide.hasCharge()) { decoy_charge = decoy_peptide.getChargeState(); }
-      if (target_peptide.hasCharge()) { target_charge = target_peptide.getChargeState(); }
-
-      MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
-                                                                   fragment_types, fragment_charges, enable_specific_losses,
-                                                                   enable_unspecific_losses, round_decPow);
-      MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
-                                                                    fragment_types, fragment_charges, enable_specific_losses,
-                                                                    enable_unspecific_losses, round_decPow);
-
-      // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
-      double decoy_precursor_mz = decoy_peptide_sequence.getMZ(decoy_charge);
-      decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+      tasks.push_back({&exp.getPeptideByRef(pep_it.first), &dec.getPeptideByRef(decoy_peptide_ref), &pep_it.second});
+    }
 
-      for (Size i = 0; i < pep_it->second.size(); i++)
+    // Annotate the decoy transitions of each peptide in parallel; results
+    // are collected per peptide and merged in map order afterwards.
+    std::vector<TransitionVectorType> task_transitions(tasks.size());
+    std::vector<std::vector<String> > task_exclusions(tasks.size());
+    errors.assign(tasks.size(), std::exception_ptr());
+    startProgress(0, tasks.size(), "Generating decoy transitions");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize task_idx = 0; task_idx < (SignedSize)tasks.size(); ++task_idx)
+    {
+      try
       {
-        const ReactionMonitoringTransition tr = *(pep_it->second[i]);
-
-        if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+        MRMIonSeries mrmis;
+        const TargetedExperiment::Peptide& target_peptide = *tasks[task_idx].target_peptide;
+        const TargetedExperiment::Peptide& decoy_peptide = *tasks[task_idx].decoy_peptide;
+        OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+        OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+
+        int decoy_charge = 1;
+        int target_charge = 1;
+        if (decoy_peptide.hasCharge()) { decoy_charge = decoy_peptide.getChargeState(); }
+        if (target_peptide.hasCharge()) { target_charge = target_peptide.getChargeState(); }
+
+        MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
+                                                                     fragment_types, fragment_charges, enable_specific_losses,
+                                                                     enable_unspecific_losses, round_decPow);
+        MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
+                                                                      fragment_types, fragment_charges, enable_specific_losses,
+                                                                      enable_unspecific_losses, round_decPow);
+
+        // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
+        double decoy_precursor_mz = decoy_peptide_sequence.getMZ(decoy_charge);
+        decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+
+        for (const ReactionMonitoringTransition* tr_ptr : *tasks[task_idx].transitions)
         {
-          continue;
-        }
+          const ReactionMonitoringTransition& tr = *tr_ptr;
 
-        ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
+          if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+          {
+            continue;
+          }
 
-        decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
-        decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-        decoy_tr.setPrecursorMZ(decoy_precursor_mz);
+          ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
 
-        // determine the current annotation for the target ion and then select
-        // the appropriate decoy ion for this target transition
-        std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
-        std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
+          decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
+          decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+          decoy_tr.setPrecursorMZ(decoy_precursor_mz);
 
-        if (method == "shift")
-        {
-          decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
-        }
-        else
-        {
-          decoy_tr.setProductMZ(decoyion.second);
-        }
-        decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
+          // determine the current annotation for the target ion and then select
+          // the appropriate decoy ion for this target transition
+          std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
+          std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
 
-        if (decoyion.second > 0)
-        {
-          decoy_transitions.push_back(decoy_tr);
-        }
-        else
-        {
-          // transition could not be annotated, remove whole peptide
-          exclusion_peptides.insert(decoy_tr.getPeptideRef());
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << decoy_tr.getPeptideRef() << " due to missing annotation" << std::endl;
-        }
-      } // end loop over transitions
+          if (method == "shift")
+          {
+            decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
+          }
+          else
+          {
+            decoy_tr.setProductMZ(decoyion.second);
+          }
+          decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
 
+          if (decoyion.second > 0)
+          {
+            task_transitions[task_idx].push_back(std::move(decoy_tr));
+          }
+          else
+          {
+            // transition could not be annotated, remove whole peptide
+            task_exclusions[task_idx].push_back(decoy_tr.getPeptideRef());
+          }
+        } // end loop over transitions
+      }
+      catch (...)
+      {
+        errors[task_idx] = std::current_exception();
+      }
+      nextProgress();
     } // end loop over peptides
     endProgress();
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
+
+    for (Size task_idx = 0; task_idx < tasks.size(); ++task_idx)
+    {
+      for (auto& decoy_tr : task_transitions[task_idx])
+      {
+        decoy_transitions.push_back(std::move(decoy_tr));
+      }
+      for (const auto& peptide_ref : task_exclusions[task_idx])
+      {
+        exclusion_peptides.insert(peptide_ref);
+        OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide_ref << " due to missing annotation" << std::endl;
+      }
+    }
 
     decoy_transitions.erase(std::remove_if(
                             decoy_transitions.begin(), decoy_transitions.end(),
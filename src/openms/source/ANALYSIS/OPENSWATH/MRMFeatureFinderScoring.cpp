@@ -52,6 +52,8 @@
 #include <boost/make_shared.hpp>
 #include <boost/foreach.hpp>
 
+#include <exception>
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -237,29 +239,68 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
-    Size progress = 0;
+    // Transition groups are picked and scored independently (in parallel).
+    // Features and errors are collected per group and merged afterwards in
+    // the order of the map, so the result is identical to a sequential run.
+    std::vector<MRMTransitionGroupType*> transition_groups;
+    transition_groups.reserve(transition_group_map.size());
+    for (auto& trgroup : transition_group_map)
+    {
+      transition_groups.push_back(&trgroup.second);
+    }
+    std::vector<FeatureMap> group_features(transition_groups.size());
+    std::vector<std::exception_ptr> errors(transition_groups.size());
+
     startProgress(0, transition_group_map.size(), "picking peaks");
-    for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
+#pragma omp parallel
     {
+      // the picker keeps state while picking and is used by one thread only
+      MRMTransitionGroupPicker trgroup_picker;
+      trgroup_picker.setParameters(trgroup_picker_param);
 
-      setProgress(++progress);
-      MRMTransitionGroupType& transition_group = trgroup_it->second;
-      if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)transition_groups.size(); ++i)
       {
-        continue;
+        MRMTransitionGroupType& transition_group = *transition_groups[i];
+        if (!transition_group.getChromatograms().empty() && !transition_group.getTransitions().empty())
+        {
+          try
+          {
+            trgroup_picker.pickTransitionGroup(transition_group);
+            scorePeakgroups(transition_group, trafo, swath_maps, group_features[i]);
+          }
+          catch (...)
+          {
+            errors[i] = std::current_exception();
+          }
+        }
+        nextProgress();
+      }
+    }
+
+    // report the first error in map order, as the sequential loop did
+    for (const std::exception_ptr& error : errors)
+    {
+      if (error)
+      {
+        endProgress();
+        std::rethrow_exception(error);
       }
+    }
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+    for (FeatureMap& features : group_features)
+    {
+      for (Feature& feature : features)
+      {
+        output.push_back(std::move(feature));
+      }
     }
     endProgress();
 
@@ -547,13 +588,6 @@ namespace OpenMS
     newtr.invert();
     expected_rt = newtr.apply(expected_rt);
 
-    OpenSwathScoring scorer;
-    scorer.initialize(rt_normalization_factor_, add_up_spectra_,
-                      spacing_for_spectra_resampling_,
-                      im_extra_drift_,
-                      su_,
-                      spectrum_addition_method_);
-
     ProteaseDigestion pd;
     pd.setEnzyme("Trypsin");
 
@@ -570,6 +604,14 @@ namespace OpenMS
       OpenSwath::IMRMFeature* imrmfeature;
       imrmfeature = new MRMFeatureOpenMS(mrmfeature);
 
+      // the scorer caches ion mobility indices of spectra and must not be shared between threads
+      OpenSwathScoring scorer;
+      scorer.initialize(rt_normalization_factor_, add_up_spectra_,
+                        spacing_for_spectra_resampling_,
+                        im_extra_drift_,
+                        su_,
+                        spectrum_addition_method_);
+
       OPENMS_LOG_DEBUG << "Scoring feature " << (mrmfeature) << " == " << mrmfeature.getMetaValue("PeptideRef") <<
         " [ expected RT " << PeptideRefMap_.at(mrmfeature.getMetaValue("PeptideRef"))->rt << " / " << expected_rt << " ]" <<
         " with " << transition_group_detection.size()  << " transitions and " << 
@@ -498,55 +498,47 @@ namespace OpenMS
           continue;
         }
 
-        for (Size i = 1; i < sequence.size(); ++i)
+        if (sequence.size() < 2)
         {
-          double pos = 0;
-          AASequence ion;
+          continue;
+        }
 
-          if (*ft_it == "a")
-          {
-            ion = sequence.getPrefix(i);
-            pos = ion.getMZ(charge, Residue::AIon);
-          }
-          else if (*ft_it == "b")
-          {
-            ion = sequence.getPrefix(i);
-            pos = ion.getMZ(charge, Residue::BIon);
-          }
-          else if (*ft_it == "c")
-          {
-            ion = sequence.getPrefix(i);
-            pos = ion.getMZ(charge, Residue::CIon);
-          }
-          else if (*ft_it == "x")
-          {
-            ion = sequence.getSuffix(i);
-            pos = ion.getMZ(charge, Residue::XIon);
-          }
-          else if (*ft_it == "y")
-          {
-            ion = sequence.getSuffix(i);
-            pos = ion.getMZ(charge, Residue::YIon);
-          }
-          else if (*ft_it == "z")
-          {
-            ion = sequence.getSuffix(i);
-            pos = ion.getMZ(charge, Residue::ZIon);
-          }
-          else
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                *ft_it + " ion series for peptide sequence \"" + sequence.toString() +
-                "\" with precursor charge +" + String(precursor_charge) + " could not be generated.");
-          }
-          
+        bool prefix = true;
+        Residue::ResidueType type;
+        if (*ft_it == "a") { type = Residue::AIon; }
+        else if (*ft_it == "b") { type = Residue::BIon; }
+        else if (*ft_it == "c") { type = Residue::CIon; }
+        else if (*ft_it == "x") { type = Residue::XIon; prefix = false; }
+        else if (*ft_it == "y") { type = Residue::YIon; prefix = false; }
+        else if (*ft_it == "z") { type = Residue::ZIon; prefix = false; }
+        else
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              *ft_it + " ion series for peptide sequence \"" + sequence.toString() +
+              "\" with precursor charge +" + String(precursor_charge) + " could not be generated.");
+        }
+        if (charge == 0)
+        {
+          throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Can't calculate mass-to-charge ratio for charge=0.", sequence.toString());
+        }
+
+        // all fragment masses of this series in one pass instead of one getPrefix()/getSuffix() copy per ion
+        const std::vector<double> weights = prefix ?
+          sequence.getPrefix(sequence.size() - 1).getPrefixMonoWeights(type, charge) :
+          sequence.getSuffix(sequence.size() - 1).getSuffixMonoWeights(type, charge);
+
+        for (Size i = 1; i < sequence.size(); ++i)
+        {
+          const double pos = weights[i - 1] / charge;
           ionseries[*ft_it + String(i) + "^" + String(charge)] = Math::roundDecimal(pos, round_decPow);
 
-          for (Size j = 0; j < ion.size(); ++j)
+          // residues of the current fragment within the full sequence
+          const Size first = prefix ? 0 : sequence.size() - i;
+          for (Size j = first; j < first + i; ++j)
           {
-            if (ion[j].hasNeutralLoss())
+            if (sequence[j].hasNeutralLoss())
             {
-              for (const auto& lit : ion[j].getLossFormulas())
+              for (const auto& lit : sequence[j].getLossFormulas())
               {
                 if (enable_specific_losses && 
                     lit != H2O &&
@@ -97,19 +97,36 @@ namespace OpenMS
     // the data points with one removed pair. The combination resulting in
     // highest rsq is considered corresponding to the outlier candidate. The
     // corresponding iterator position is then returned.
-    std::vector<double> x_tmp, y_tmp, rsq_tmp;
-
-    for (Size i = 0; i < x.size(); i++)
+    //
+    // Instead of fitting n regressions, the rsq (squared Pearson correlation,
+    // as in LinearRegression) without point i is computed from the centered
+    // sums of all points in O(1) each: removing point i reduces each sum of
+    // (co)variances by n / (n - 1) * dx_i * dy_i.
+    const Size n = x.size();
+    double mean_x = 0, mean_y = 0;
+    for (Size i = 0; i < n; i++)
     {
-      x_tmp = x;
-      y_tmp = y;
-      x_tmp.erase(x_tmp.begin() + i);
-      y_tmp.erase(y_tmp.begin() + i);
-
-      Math::LinearRegression lin_reg;
-      lin_reg.computeRegression(0.95, x_tmp.begin(), x_tmp.end(), y_tmp.begin());
+      mean_x += x[i];
+      mean_y += y[i];
+    }
+    mean_x /= n;
+    mean_y /= n;
+    double sxx = 0, syy = 0, sxy = 0;
+    for (Size i = 0; i < n; i++)
+    {
+      const double dx = x[i] - mean_x, dy = y[i] - mean_y;
+      sxx += dx * dx;
+      syy += dy * dy;
+      sxy += dx * dy;
+    }
 
-      rsq_tmp.push_back(lin_reg.getRSquared());
+    std::vector<double> rsq_tmp(n);
+    const double f = double(n) / (n - 1);
+    for (Size i = 0; i < n; i++)
+    {
+      const double dx = x[i] - mean_x, dy = y[i] - mean_y;
+      const double cov_xy = sxy - f * dx * dy;
+      rsq_tmp[i] = (cov_xy * cov_xy) / ((sxx - f * dx * dx) * (syy - f * dy * dy));
     }
     return max_element(rsq_tmp.begin(), rsq_tmp.end()) - rsq_tmp.begin();
   }
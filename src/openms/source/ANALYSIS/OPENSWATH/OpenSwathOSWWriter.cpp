@@ -35,6 +35,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 
 #include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
 
 #include <sqlite3.h>
 
@@ -479,6 +480,26 @@ namespace OpenMS
 
   void OpenSwathOSWWriter::writeLines(const std::vector<String>& to_osw_output)
   {
+    if (write_behind_)
+    {
+      if (!write_behind_conn_)
+      {
+        write_behind_conn_ = std::make_shared<SqliteConnector>(output_filename_);
+      }
+      auto conn = write_behind_conn_;
+      auto lines = std::make_shared<std::vector<String>>(to_osw_output);
+      write_behind_->push([conn, lines]()
+      {
+        conn->executeStatement("BEGIN TRANSACTION");
+        for (const auto& line : *lines)
+        {
+          conn->executeStatement(line);
+        }
+        conn->executeStatement("END TRANSACTION");
+      });
+      return;
+    }
+
     SqliteConnector conn(output_filename_);
     conn.executeStatement("BEGIN TRANSACTION");
     for (Size i = 0; i < to_osw_output.size(); i++)
@@ -487,5 +508,19 @@ namespace OpenMS
     }
     conn.executeStatement("END TRANSACTION");
   }
-}
 
+  void OpenSwathOSWWriter::setWriteBehind(Size max_pending)
+  {
+    flush();
+    write_behind_.reset(max_pending > 0 ? new WriteBehindQueue(max_pending) : nullptr);
+  }
+
+  void OpenSwathOSWWriter::flush()
+  {
+    if (write_behind_)
+    {
+      write_behind_->flush();
+    }
+    write_behind_conn_.reset();
+  }
+}
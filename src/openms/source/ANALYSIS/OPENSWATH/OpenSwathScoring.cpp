@@ -49,6 +49,11 @@
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
 namespace OpenMS
 {
 
@@ -559,46 +564,188 @@ namespace OpenMS
     }
   }
 
-  OpenSwath::SpectrumPtr filterByDrift(const OpenSwath::SpectrumPtr input, const double drift_lower, const double drift_upper)
+  namespace
+  {
+    // number of spectra for which an ion mobility index is kept
+    const Size im_index_cache_size = 16;
+    // average number of peaks per ion mobility bin
+    const Size im_index_bin_size = 256;
+
+    // number of summed spectra kept per thread
+    const Size added_spectrum_cache_size = 16;
+
+    // a summed spectrum and everything it was computed from
+    struct AddedSpectrumEntry
+    {
+      boost::weak_ptr<OpenSwath::ISpectrumAccess> map;
+      const OpenSwath::ISpectrumAccess* map_ptr;
+      int closest_idx;
+      int nr_spectra_to_add;
+      double drift_lower;
+      double drift_upper;
+      std::string addition_method;
+      double spacing;
+      OpenSwath::SpectrumPtr spectrum;
+      Size last_used;
+    };
+
+    // Least recently used cache of summed spectra. Peak groups of different
+    // peptides in the same SWATH window often have their apex at the same
+    // scan and would otherwise add up the same spectra again. The cache is
+    // kept per thread so scoring threads do not need to synchronize.
+    struct AddedSpectrumCache
+    {
+      std::vector<AddedSpectrumEntry> entries;
+      Size clock = 0;
+    };
+
+    AddedSpectrumCache& addedSpectrumCache_()
+    {
+      thread_local AddedSpectrumCache cache;
+      return cache;
+    }
+
+    // bin of an ion mobility value, monotonic in im (NaN goes to the first bin)
+    Size imBin_(double im, double im_min, double bin_width, Size n_bins)
+    {
+      double bin = std::floor((im - im_min) / bin_width);
+      if (!(bin >= 0.0)) return 0;
+      if (bin >= (double)n_bins) return n_bins - 1;
+      return (Size)bin;
+    }
+  }
+
+  OpenSwath::SpectrumPtr OpenSwathScoring::filterByDrift_(const OpenSwath::SpectrumPtr& input, const double drift_lower, const double drift_upper)
   {
     OPENMS_PRECONDITION(drift_upper > 0, "Cannot filter by drift time if upper value is less or equal to zero");
-    //OPENMS_PRECONDITION(input->getDriftTimeArray() != nullptr, "Cannot filter by drift time if no drift time is available.");
 
     if (input->getDriftTimeArray() == nullptr)
     {
       std::cerr << "Warning: Cannot filter by drift time if no drift time is available.\n";
       return input;
     }
-      
-    OpenSwath::SpectrumPtr output(new OpenSwath::Spectrum);
 
-    OpenSwath::BinaryDataArrayPtr mz_arr = input->getMZArray();
-    OpenSwath::BinaryDataArrayPtr int_arr = input->getIntensityArray();
     OpenSwath::BinaryDataArrayPtr im_arr = input->getDriftTimeArray();
+    const std::vector<double>& mz = input->getMZArray()->data;
+    const std::vector<double>& intensity = input->getIntensityArray()->data;
+    const std::vector<double>& im = im_arr->data;
+
+    IonMobilityIndex* index = nullptr;
+    for (auto& entry : im_index_cache_)
+    {
+      if (entry.spectrum.lock() == input)
+      {
+        index = &entry;
+        break;
+      }
+    }
+
+    std::vector<UInt> selected;
+    if (index == nullptr)
+    {
+      // first request for this spectrum: remember it and scan all peaks
+      if (im_index_cache_.size() < im_index_cache_size)
+      {
+        im_index_cache_.emplace_back();
+        index = &im_index_cache_.back();
+      }
+      else
+      {
+        index = &im_index_cache_[im_index_next_];
+        im_index_next_ = (im_index_next_ + 1) % im_index_cache_size;
+      }
+      index->spectrum = input;
+      index->bin_start.clear();
+      index->positions.clear();
+
+      for (Size i = 0; i < im.size(); ++i)
+      {
+        if (im[i] > drift_lower && im[i] < drift_upper)
+        {
+          selected.push_back((UInt)i);
+        }
+      }
+    }
+    else
+    {
+      if (index->bin_start.empty())
+      {
+        // counting sort of the peak positions into equally wide ion mobility bins
+        const Size n = im.size();
+        const Size n_bins = std::max(Size(1), n / im_index_bin_size);
+        double im_min = std::numeric_limits<double>::max();
+        double im_max = -std::numeric_limits<double>::max();
+        for (double v : im)
+        {
+          im_min = std::min(im_min, v);
+          im_max = std::max(im_max, v);
+        }
+        index->im_min = (im_min <= im_max) ? im_min : 0.0;
+        index->bin_width = (im_min < im_max) ? (im_max - im_min) / n_bins : 1.0;
+
+        std::vector<UInt> bins(n);
+        index->bin_start.assign(n_bins + 1, 0);
+        for (Size i = 0; i < n; ++i)
+        {
+          bins[i] = (UInt)imBin_(im[i], index->im_min, index->bin_width, n_bins);
+          ++index->bin_start[bins[i] + 1];
+        }
+        std::partial_sum(index->bin_start.begin(), index->bin_start.end(), index->bin_start.begin());
+        std::vector<UInt> next(index->bin_start.begin(), index->bin_start.end() - 1);
+        index->positions.resize(n);
+        for (Size i = 0; i < n; ++i)
+        {
+          index->positions[next[bins[i]]++] = (UInt)i;
+        }
+      }
 
-    std::vector<double>::const_iterator mz_it = mz_arr->data.begin();
-    std::vector<double>::const_iterator int_it = int_arr->data.begin();
-    std::vector<double>::const_iterator im_it = im_arr->data.begin();
-    std::vector<double>::const_iterator mz_end = mz_arr->data.end();
+      // All peaks inside the window lie in the bins between those of the window
+      // boundaries. Each bin contributes a run of positions in m/z order.
+      const Size n_bins = index->bin_start.size() - 1;
+      const Size first_bin = imBin_(drift_lower, index->im_min, index->bin_width, n_bins);
+      const Size last_bin = imBin_(drift_upper, index->im_min, index->bin_width, n_bins);
+      std::vector<Size> run_start;
+      for (Size bin = first_bin; bin <= last_bin; ++bin)
+      {
+        run_start.push_back(selected.size());
+        for (UInt k = index->bin_start[bin]; k < index->bin_start[bin + 1]; ++k)
+        {
+          const UInt pos = index->positions[k];
+          if (im[pos] > drift_lower && im[pos] < drift_upper)
+          {
+            selected.push_back(pos);
+          }
+        }
+      }
+      run_start.push_back(selected.size());
+
+      // merge the runs pairwise to restore the m/z order
+      const Size n_runs = run_start.size() - 1;
+      for (Size width = 1; width < n_runs; width *= 2)
+      {
+        for (Size r = 0; r + width < n_runs; r += 2 * width)
+        {
+          std::inplace_merge(selected.begin() + run_start[r],
+                             selected.begin() + run_start[r + width],
+                             selected.begin() + run_start[std::min(r + 2 * width, n_runs)]);
+        }
+      }
+    }
 
+    OpenSwath::SpectrumPtr output(new OpenSwath::Spectrum);
     OpenSwath::BinaryDataArrayPtr mz_arr_out(new OpenSwath::BinaryDataArray);
     OpenSwath::BinaryDataArrayPtr intens_arr_out(new OpenSwath::BinaryDataArray);
     OpenSwath::BinaryDataArrayPtr im_arr_out(new OpenSwath::BinaryDataArray);
     im_arr_out->description = im_arr->description;
 
-    size_t n = mz_arr->data.size();
-    im_arr_out->data.reserve(n);
-    while (mz_it != mz_end)
+    mz_arr_out->data.reserve(selected.size());
+    intens_arr_out->data.reserve(selected.size());
+    im_arr_out->data.reserve(selected.size());
+    for (UInt pos : selected)
     {
-      if (*im_it > drift_lower && *im_it < drift_upper)
-      {
-        mz_arr_out->data.push_back( *mz_it );
-        intens_arr_out->data.push_back( *int_it );
-        im_arr_out->data.push_back( *im_it );
-      }
-      ++mz_it;
-      ++int_it;
-      ++im_it;
+      mz_arr_out->data.push_back(mz[pos]);
+      intens_arr_out->data.push_back(intensity[pos]);
+      im_arr_out->data.push_back(im[pos]);
     }
     output->setMZArray(mz_arr_out);
     output->setIntensityArray(intens_arr_out);
@@ -632,11 +779,25 @@ namespace OpenMS
       added_spec = swath_map->getSpectrumById(closest_idx);
       if (drift_upper > 0) 
       {
-        added_spec = filterByDrift(added_spec, drift_lower, drift_upper);
+        added_spec = filterByDrift_(added_spec, drift_lower, drift_upper);
       }
     }
     else
     {
+      AddedSpectrumCache& cache = addedSpectrumCache_();
+      ++cache.clock;
+      for (AddedSpectrumEntry& entry : cache.entries)
+      {
+        if (entry.map_ptr == swath_map.get() && !entry.map.expired() &&
+            entry.closest_idx == closest_idx && entry.nr_spectra_to_add == nr_spectra_to_add &&
+            entry.drift_lower == drift_lower && entry.drift_upper == drift_upper &&
+            entry.addition_method == spectra_addition_method_ && entry.spacing == spacing_for_spectra_resampling_)
+        {
+          entry.last_used = cache.clock;
+          return entry.spectrum;
+        }
+      }
+
       std::vector<OpenSwath::SpectrumPtr> all_spectra;
       // always add the spectrum 0, then add those right and left
       all_spectra.push_back(swath_map->getSpectrumById(closest_idx));
@@ -655,7 +816,7 @@ namespace OpenMS
       // Filter all spectra by drift time before further processing
       if (drift_upper > 0) 
       {
-        for (auto& s: all_spectra) s = filterByDrift(s, drift_lower, drift_upper);
+        for (auto& s: all_spectra) s = filterByDrift_(s, drift_lower, drift_upper);
       }
 
       // add up all spectra
@@ -690,6 +851,37 @@ namespace OpenMS
       {
         added_spec = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
       }
+
+      // replace the least recently used entry (entries of deleted maps first)
+      AddedSpectrumEntry* slot = nullptr;
+      if (cache.entries.size() < added_spectrum_cache_size)
+      {
+        cache.entries.emplace_back();
+        slot = &cache.entries.back();
+      }
+      else
+      {
+        slot = &cache.entries[0];
+        for (AddedSpectrumEntry& entry : cache.entries)
+        {
+          if (entry.map.expired())
+          {
+            slot = &entry;
+            break;
+          }
+          if (entry.last_used < slot->last_used) slot = &entry;
+        }
+      }
+      slot->map = swath_map;
+      slot->map_ptr = swath_map.get();
+      slot->closest_idx = closest_idx;
+      slot->nr_spectra_to_add = nr_spectra_to_add;
+      slot->drift_lower = drift_lower;
+      slot->drift_upper = drift_upper;
+      slot->addition_method = spectra_addition_method_;
+      slot->spacing = spacing_for_spectra_resampling_;
+      slot->spectrum = added_spec;
+      slot->last_used = cache.clock;
     }
 
     OPENMS_POSTCONDITION( std::adjacent_find(added_spec->getMZArray()->data.begin(),
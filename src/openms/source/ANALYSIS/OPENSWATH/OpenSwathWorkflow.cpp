@@ -73,12 +73,12 @@ namespace OpenMS
     const String& irt_mzml_out,
     Size debug_level,
     bool sonar,
-    bool load_into_memory)
+    bool /* load_into_memory */)
   {
     OPENMS_LOG_DEBUG << "performRTNormalization method starting" << std::endl;
     std::vector< OpenMS::MSChromatogram > irt_chromatograms;
     TransformationDescription trafo; // dummy
-    this->simpleExtractChromatograms_(swath_maps, irt_transitions, irt_chromatograms, trafo, cp_irt, sonar, load_into_memory);
+    this->simpleExtractChromatograms_(swath_maps, irt_transitions, irt_chromatograms, trafo, cp_irt, sonar);
 
     // debug output of the iRT chromatograms
     if (irt_mzml_out.empty() && debug_level > 1)
@@ -309,8 +309,7 @@ namespace OpenMS
     std::vector< OpenMS::MSChromatogram > & chromatograms,
     const TransformationDescription& trafo,
     const ChromExtractParams & cp,
-    bool sonar,
-    bool load_into_memory)
+    bool sonar)
   {
     TransformationDescription trafo_inverse = trafo;
     trafo_inverse.invert();
@@ -335,12 +334,9 @@ namespace OpenMS
           std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
           ChromatogramExtractor extractor;
 
+          // The extraction reads every spectrum of the map exactly once, so
+          // loading the map into memory first would only add a second pass.
           OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[map_idx].sptr;
-          if (load_into_memory)
-          {
-            // This creates an InMemory object that keeps all data in memory
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
-          }
 
           prepareExtractionCoordinates_(tmp_out, coordinates, transition_exp_used, trafo_inverse, cp);
           extractor.extractChromatograms(current_swath_map, tmp_out, coordinates, cp.mz_extraction_window,
@@ -367,7 +363,7 @@ namespace OpenMS
               if (tic > 0.0)
               {
                 // add the chromatogram to the output
-                chromatograms.push_back(tmp_chromatograms[chrom_idx]);
+                chromatograms.push_back(std::move(tmp_chromatograms[chrom_idx]));
               }
               else
               {
@@ -411,9 +407,9 @@ namespace OpenMS
         {
           addChromatograms(chrom_acc, chromatograms[ it->second[i] ] );
         }
-        chromatograms_new.push_back(chrom_acc);
+        chromatograms_new.push_back(std::move(chrom_acc));
       }
-      chromatograms = chromatograms_new; // switch
+      chromatograms.swap(chromatograms_new);
 
       OPENMS_LOG_DEBUG << " got a total of " << chromatograms.size() << " chromatograms after SONAR addition " << std::endl;
     }
@@ -464,7 +460,6 @@ namespace OpenMS
     trafo_inverse.invert();
 
     std::cout << "Will analyze " << transition_exp.transitions.size() << " transitions in total." << std::endl;
-    int progress = 0;
     this->startProgress(0, swath_maps.size(), "Extracting and scoring transitions");
 
     // (i) Obtain precursor chromatograms (MS1) if precursor extraction is enabled
@@ -585,139 +580,162 @@ namespace OpenMS
     else {
     };
 
-    // (iv) Perform extraction and scoring of fragment ion chromatograms (MS2)
-    // We set dynamic scheduling such that the maps are worked on in the order
-    // in which they were given to the program / acquired. This gives much
-    // better load balancing than static allocation.
+    // (iv) Select the transitions to be extracted from each window
+    std::vector< OpenSwath::LightTargetedExperiment > window_transitions(swath_maps.size());
 #ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-    int total_nr_threads = omp_get_max_threads(); // store total number of threads we are allowed to use
-    if (threads_outer_loop_ > -1)
-    {
-      std::cout << "Setting up nested loop with " << std::min(threads_outer_loop_, omp_get_max_threads()) << " threads out of "<< omp_get_max_threads() << std::endl;
-      omp_set_nested(1);
-      omp_set_dynamic(0);
-      omp_set_num_threads(std::min(threads_outer_loop_, omp_get_max_threads()) ); // use at most threads_outer_loop_ threads here
-    }
-    else
-    {
-      std::cout << "Use non-nested loop with " << total_nr_threads << " threads." << std::endl;
-    }
-#endif
 #pragma omp parallel for schedule(dynamic,1)
 #endif
     for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
     {
-      if (!swath_maps[i].ms1) // skip MS1
-      {
+      if (swath_maps[i].ms1) continue; // skip MS1
 
-        // Step 1: select which transitions to extract (proceed in batches)
-        OpenSwath::LightTargetedExperiment transition_exp_used_all;
-        if (!(prm_ || pasef_))
-        {
-          // Step 1.1: select transitions matching the window
-          OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
-              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
-        }
-        else
+      OpenSwath::LightTargetedExperiment& transition_exp_used_all = window_transitions[i];
+      if (!(prm_ || pasef_))
+      {
+        // select transitions matching the window
+        OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
+            cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+      }
+      else
+      {
+        // select transitions based on matching PRM/PASEF window (best window)
+        std::set<std::string> matching_compounds;
+        for (Size k = 0; k < tr_win_map.size(); k++)
         {
-          // Step 1.2: select transitions based on matching PRM/PASEF window (best window)
-          std::set<std::string> matching_compounds;
-          for (Size k = 0; k < tr_win_map.size(); k++)
+          if (tr_win_map[k] == i)
           {
-            if (tr_win_map[k] == i)
-            {
-               const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
-               transition_exp_used_all.transitions.push_back(tr);
-               matching_compounds.insert(tr.getPeptideRef());
-               OPENMS_LOG_DEBUG << "Adding Precursor with m/z " << tr.getPrecursorMZ() << " and IM of " << tr.getPrecursorIM() <<  " to swath with mz upper of " << swath_maps[i].upper << " im lower of " << swath_maps[i].imLower << " and im upper of " << swath_maps[i].imUpper << std::endl;
-            }
+             const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
+             transition_exp_used_all.transitions.push_back(tr);
+             matching_compounds.insert(tr.getPeptideRef());
+             OPENMS_LOG_DEBUG << "Adding Precursor with m/z " << tr.getPrecursorMZ() << " and IM of " << tr.getPrecursorIM() <<  " to swath with mz upper of " << swath_maps[i].upper << " im lower of " << swath_maps[i].imLower << " and im upper of " << swath_maps[i].imUpper << std::endl;
           }
+        }
 
-          std::set<std::string> matching_proteins;
-          for (Size i = 0; i < transition_exp.compounds.size(); i++)
-          {
-            if (matching_compounds.find(transition_exp.compounds[i].id) != matching_compounds.end())
-            {
-              transition_exp_used_all.compounds.push_back( transition_exp.compounds[i] );
-              for (Size j = 0; j < transition_exp.compounds[i].protein_refs.size(); j++)
-              {
-                matching_proteins.insert(transition_exp.compounds[i].protein_refs[j]);
-              }
-            }
-          }
-          for (Size i = 0; i < transition_exp.proteins.size(); i++)
+        std::set<std::string> matching_proteins;
+        for (Size c = 0; c < transition_exp.compounds.size(); c++)
+        {
+          if (matching_compounds.find(transition_exp.compounds[c].id) != matching_compounds.end())
           {
-            if (matching_proteins.find(transition_exp.proteins[i].id) != matching_proteins.end())
+            transition_exp_used_all.compounds.push_back( transition_exp.compounds[c] );
+            for (Size j = 0; j < transition_exp.compounds[c].protein_refs.size(); j++)
             {
-              transition_exp_used_all.proteins.push_back( transition_exp.proteins[i] );
+              matching_proteins.insert(transition_exp.compounds[c].protein_refs[j]);
             }
           }
         }
-
-        if (!transition_exp_used_all.getTransitions().empty()) // skip if no transitions found
+        for (Size p = 0; p < transition_exp.proteins.size(); p++)
         {
-
-          OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
-          if (load_into_memory)
+          if (matching_proteins.find(transition_exp.proteins[p].id) != matching_proteins.end())
           {
-            // This creates an InMemory object that keeps all data in memory
-            current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
+            transition_exp_used_all.proteins.push_back( transition_exp.proteins[p] );
           }
+        }
+      }
+    }
 
-          int batch_size;
-          if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
-          {
-            batch_size = transition_exp_used_all.getCompounds().size();
-          }
-          else
-          {
-            batch_size = batchSize;
-          }
+    // Start the windows with the most work (transitions times spectra) first,
+    // so that the small windows fill up the gaps at the end of the run.
+    std::vector<SignedSize> window_order(swath_maps.size());
+    std::vector<double> window_cost(swath_maps.size(), 0.0);
+    for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
+    {
+      window_order[i] = i;
+      if (!swath_maps[i].ms1)
+      {
+        window_cost[i] = (double)window_transitions[i].getTransitions().size() * swath_maps[i].sptr->getNrSpectra();
+      }
+    }
+    std::stable_sort(window_order.begin(), window_order.end(),
+        [&window_cost](SignedSize a, SignedSize b) { return window_cost[a] > window_cost[b]; });
+
+    // (v) Perform extraction and scoring of fragment ion chromatograms (MS2)
+    // Each window is split into batches of compounds and every batch is an
+    // OpenMP task. Idle threads pick up pending batches of any window that has
+    // been started, so threads do not run idle while a few large windows are
+    // still being processed. At most threads_outer_loop_ windows (if set) are
+    // worked on (and held in memory) at the same time.
+    int windows_open = 0;
+    const int max_windows_open = (threads_outer_loop_ > 0) ? threads_outer_loop_ : std::numeric_limits<int>::max();
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    for (SignedSize i : window_order)
+    {
+      if (swath_maps[i].ms1 || window_transitions[i].getTransitions().empty()) // skip MS1 and windows without transitions
+      {
+        this->nextProgress();
+        continue;
+      }
 
-          SignedSize nr_batches = (transition_exp_used_all.getCompounds().size() / batch_size);
+      // wait (and help with pending batches) until another window may be opened
+      while (true)
+      {
+        int current_open;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+        current_open = windows_open;
+        if (current_open < max_windows_open) break;
+#ifdef _OPENMP
+#pragma omp taskyield
+#endif
+      }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++windows_open;
 
 #ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-          // If we have a multiple of threads_outer_loop_ here, then use nested
-          // parallelization here. E.g. if we use 8 threads for the outer loop,
-          // but we have a total of 24 cores available, each of the 8 threads
-          // will then create a team of 3 threads to work on the batches
-          // individually.
-          //
-          // We should avoid oversubscribing the CPUs, therefore we use integer division.
-          // -- see https://docs.oracle.com/cd/E19059-01/stud.10/819-0501/2_nested.html
-          int outer_thread_nr = omp_get_thread_num();
-          omp_set_num_threads(std::max(1, total_nr_threads / threads_outer_loop_) );
-#pragma omp parallel for schedule(dynamic, 1)
+#pragma omp task firstprivate(i)
 #endif
+      {
+        OpenSwath::SpectrumAccessPtr current_swath_map = swath_maps[i].sptr;
+        if (load_into_memory)
+        {
+          // This creates an InMemory object that keeps all data in memory
+          current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
+        }
+
+        int batch_size;
+        if (batchSize <= 0 || batchSize >= (int)window_transitions[i].getCompounds().size())
+        {
+          batch_size = window_transitions[i].getCompounds().size();
+        }
+        else
+        {
+          batch_size = batchSize;
+        }
+
+        SignedSize nr_batches = (window_transitions[i].getCompounds().size() / batch_size);
+
+        for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
+        {
+#ifdef _OPENMP
+#pragma omp task firstprivate(pep_idx) shared(current_swath_map)
 #endif
-          for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
           {
-            OpenSwath::SpectrumAccessPtr current_swath_map_inner = current_swath_map;
+            const OpenSwath::LightTargetedExperiment& transition_exp_used_all = window_transitions[i];
 
-#ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
             // To ensure multi-threading safe access to the individual spectra, we
-            // need to use a light clone of the spectrum access (if multiple threads
-            // share a single filestream and call seek on it, chaos will ensue).
-            if (total_nr_threads / threads_outer_loop_ > 1)
+            // need to use a light clone of the spectrum access when batches of the
+            // same window may run concurrently (if multiple threads share a single
+            // filestream and call seek on it, chaos will ensue).
+            OpenSwath::SpectrumAccessPtr current_swath_map_inner = current_swath_map;
+            if (nr_batches > 0)
             {
               current_swath_map_inner = current_swath_map->lightClone();
             }
-#endif
+
+#ifdef _OPENMP
 #pragma omp critical (osw_write_stdout)
 #endif
             {
               std::cout << "Thread " <<
 #ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-              outer_thread_nr << "_" << omp_get_thread_num() << " " <<
-#else
-              omp_get_thread_num() << "_0 " <<
-#endif
+              omp_get_thread_num() << " " <<
 #else
-              "0" <<
+              "0 " <<
 #endif
               "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
               << transition_exp_used_all.getTransitions().size() <<  " transitions "
@@ -764,29 +782,27 @@ namespace OpenMS
             // Step 4: write all chromatograms and features out into an output object / file
             // (this needs to be done in a critical section since we only have one
             // output file and one output map).
-            #pragma omp critical (osw_write_out)
+#ifdef _OPENMP
+#pragma omp critical (osw_write_out)
+#endif
             {
               writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), featureFile, out_featureFile, store_features, chromConsumer);
             }
           }
-
-        } // continue 2 (no continue due to OpenMP)
-      } // continue 1 (no continue due to OpenMP)
-
-      #pragma omp critical (progress)
-      this->setProgress(++progress);
-
-    }
-    this->endProgress();
-
+        }
+        // the batches refer to the data of this window, wait for them before releasing it
 #ifdef _OPENMP
-#ifdef MT_ENABLE_NESTED_OPENMP
-    if (threads_outer_loop_ > -1)
-    {
-      omp_set_num_threads(total_nr_threads); // set number of available threads back to initial value
-    }
+#pragma omp taskwait
 #endif
+
+        this->nextProgress();
+#ifdef _OPENMP
+#pragma omp atomic
 #endif
+        --windows_open;
+      }
+    }
+    this->endProgress();
   }
 
   void OpenSwathWorkflow::writeOutFeaturesAndChroms_(
@@ -1171,7 +1187,6 @@ namespace OpenMS
       computeSonarWindows_(swath_maps, sonar_winsize, sonar_start, sonar_end, sonar_total_win);
 
       std::cout << "Will analyze " << transition_exp.transitions.size() << " transitions in total." << std::endl;
-      int progress = 0;
       this->startProgress(0, sonar_total_win, "Extracting and scoring transitions");
 
       ///////////////////////////////////////////////////////////////////////////
@@ -1218,6 +1233,17 @@ namespace OpenMS
             }
           }
 
+          int batch_size;
+          if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
+          {
+            batch_size = transition_exp_used_all.getCompounds().size();
+          }
+          else
+          {
+            batch_size = batchSize;
+          }
+          const size_t nr_batches = (transition_exp_used_all.getCompounds().size() + batch_size - 1) / batch_size;
+
           //////////////////////////////////
           // Threadsafe loading of identified maps
           //////////////////////////////////
@@ -1230,8 +1256,10 @@ namespace OpenMS
               // Loading the maps is not threadsafe if they overlap (e.g.
               // multiple threads could access the same maps) which often
               // happens in SONAR. Thus we either create a threadsafe light
-              // clone or load them into memory if requested.
-              if (load_into_memory)
+              // clone or load them into memory if requested. With a single
+              // batch every map is read exactly once, so a copy in memory
+              // would only add a second pass over the data.
+              if (load_into_memory && nr_batches > 1)
               {
                 used_maps[i].sptr = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*used_maps[i].sptr) );
               }
@@ -1242,16 +1270,6 @@ namespace OpenMS
             }
           }
 
-          int batch_size;
-          if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
-          {
-            batch_size = transition_exp_used_all.getCompounds().size();
-          }
-          else
-          {
-            batch_size = batchSize;
-          }
-
 #ifdef _OPENMP
 #pragma omp critical (osw_write_stdout)
 #endif
@@ -1299,10 +1317,7 @@ namespace OpenMS
             }
           }
         }
-#ifdef _OPENMP
-#pragma omp critical (progress)
-#endif
-        this->setProgress(++progress);
+        this->nextProgress();
       }
       this->endProgress();
     }
@@ -1365,22 +1380,36 @@ namespace OpenMS
       typedef std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinatesList;
 
       ChromatogramExtractor extractor;
+      std::vector<size_t> coordinate_indices;
       // Iterate over all SONAR maps we currently have and extract chromatograms from them
       for (size_t map_idx = 0; map_idx < used_maps.size(); map_idx++)
       {
         chromatogramList tmp_chromatogram_list;
         coordinatesList coordinates_used;
 
+        // remember which coordinates fall into the current map
+        coordinate_indices.clear();
         for (size_t c_idx = 0; c_idx < coordinates.size(); c_idx++)
         {
           if (coordinates[c_idx].mz_precursor > used_maps[map_idx].lower &&
               coordinates[c_idx].mz_precursor < used_maps[map_idx].upper)
           {
-            coordinates_used.push_back( coordinates[c_idx] );
-            OpenSwath::ChromatogramPtr s(new OpenSwath::Chromatogram);
-            tmp_chromatogram_list.push_back(s);
+            coordinate_indices.push_back(c_idx);
           }
         }
+        if (coordinate_indices.empty())
+        {
+          continue; // nothing to extract from this map
+        }
+
+        coordinates_used.reserve(coordinate_indices.size());
+        tmp_chromatogram_list.reserve(coordinate_indices.size());
+        for (size_t c_idx : coordinate_indices)
+        {
+          coordinates_used.push_back( coordinates[c_idx] );
+          OpenSwath::ChromatogramPtr s(new OpenSwath::Chromatogram);
+          tmp_chromatogram_list.push_back(s);
+        }
 
 #ifdef OPENSWATH_WORKFLOW_DEBUG
         std::cout << " in used maps, extract " << coordinates_used.size()
@@ -1394,21 +1423,11 @@ namespace OpenMS
         // In order to reach maximal sensitivity and identify peaks in
         // the data, we will aggregate the data by adding all
         // chromatograms from different SONAR scans up
-        size_t chrom_idx = 0;
-        for (size_t c_idx = 0; c_idx < coordinates.size(); c_idx++)
+        for (size_t chrom_idx = 0; chrom_idx < coordinate_indices.size(); chrom_idx++)
         {
-          if (coordinates[c_idx].mz_precursor > used_maps[map_idx].lower &&
-              coordinates[c_idx].mz_precursor < used_maps[map_idx].upper)
-          {
-
-            OpenSwath::ChromatogramPtr s = tmp_chromatogram_list[chrom_idx];
-            OpenSwath::ChromatogramPtr base_chrom = chrom_list[c_idx];
-
-            /// add the new chromatogram to the one that we already have (the base chromatogram)
-            chrom_list[c_idx] = addChromatograms(chrom_list[c_idx], tmp_chromatogram_list[chrom_idx]);
-
-            chrom_idx++;
-          }
+          const size_t c_idx = coordinate_indices[chrom_idx];
+          /// add the new chromatogram to the one that we already have (the base chromatogram)
+          chrom_list[c_idx] = addChromatograms(chrom_list[c_idx], tmp_chromatogram_list[chrom_idx]);
         }
       }
 
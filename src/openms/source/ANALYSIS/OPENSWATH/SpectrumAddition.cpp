@@ -197,21 +197,13 @@ namespace OpenMS
       ++it;
     }
 
-    // resample all spectra and add to master spectrum
+    // resample all spectra and add to master spectrum (raster() adds to the
+    // intensities already present, so no intermediate spectrum is needed)
     LinearResamplerAlign lresampler;
-    MSSpectrum master_spectrum = resampled_peak_container;
+    MSSpectrum& master_spectrum = resampled_peak_container;
     for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
     {
-      MSSpectrum input_spectrum;
-      MSSpectrum output_spectrum = resampled_peak_container;
-
-      lresampler.raster(all_spectra[curr_sp].begin(), all_spectra[curr_sp].end(), output_spectrum.begin(), output_spectrum.end());
-
-      // add to master spectrum
-      for (Size i = 0; i < output_spectrum.size(); ++i)
-      {
-        master_spectrum[i].setIntensity(master_spectrum[i].getIntensity() + output_spectrum[i].getIntensity());
-      }
+      lresampler.raster(all_spectra[curr_sp].begin(), all_spectra[curr_sp].end(), master_spectrum.begin(), master_spectrum.end());
     }
 
     if (!filter_zeros)
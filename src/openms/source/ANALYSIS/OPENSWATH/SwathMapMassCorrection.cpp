@@ -42,6 +42,7 @@
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumHelpers.h> // integrateWindow
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAHelper.h>
 
+#include <exception>
 #include <fstream>
 
 #define SWATHMAPMASSCORRECTION_DEBUG
@@ -370,62 +371,122 @@ namespace OpenMS
       pep_im_map[cmp.id] = cmp.drift_time;
     }
 
-    for (auto & trgroup_it : transition_group_map)
+    // Collect the calibration data points of each transition group in
+    // parallel and merge them afterwards in map order, so that the regression
+    // input (and thus the result) does not depend on the number of threads.
+    struct MZDataPoint
     {
-      // we need at least one feature to find the best one
-      auto transition_group = trgroup_it.second;
-
-      const auto& tr = transition_group->getTransitions()[0];
-      auto pepref = tr.getPeptideRef();
-      double drift_target = pep_im_map[pepref];
-
-      if (transition_group->getFeatures().empty()) continue;
+      double mz;
+      double theo_mz;
+      double intensity;
+    };
+    struct GroupResult
+    {
+      double drift_target = 0.0;
+      double bestRT = -1;
+      std::vector<MZDataPoint> points;
+    };
 
-      // Find the feature with the highest score
-      double bestRT;
-      findBestFeature(*transition_group, bestRT);
-      // Get the corresponding SWATH map(s), for SONAR there will be more than one map
-      std::vector<OpenSwath::SwathMap> used_maps = findSwathMaps(*transition_group, swath_maps);
+    std::vector<const OpenMS::MRMFeatureFinderScoring::MRMTransitionGroupType*> transition_groups;
+    transition_groups.reserve(transition_group_map.size());
+    for (const auto& trgroup_it : transition_group_map)
+    {
+      transition_groups.push_back(trgroup_it.second);
+    }
+    std::vector<GroupResult> group_results(transition_groups.size());
+    std::vector<std::exception_ptr> errors(transition_groups.size());
 
-      if (used_maps.empty())
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // spectrum access is not thread-safe, every thread reads through its own light clones
+      std::vector<OpenSwath::SwathMap> thread_maps = swath_maps;
+      for (auto& m : thread_maps)
       {
-        continue;
+        if (m.sptr) m.sptr = m.sptr->lightClone();
       }
 
-      // Get the spectrum for this RT and extract raw data points for all the
-      // calibrating transitions (fragment m/z values) from the spectrum
-      OpenSwath::SpectrumPtr sp = OpenSwathScoring().fetchSpectrumSwath(used_maps, bestRT, 1, 0, 0);
-      for (const auto& tr : transition_group->getTransitions())
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (SignedSize k = 0; k < (SignedSize)transition_groups.size(); ++k)
       {
-        double mz, intensity, left(tr.product_mz), right(tr.product_mz);
-        bool centroided = false;
+        try
+        {
+          const auto transition_group = transition_groups[k];
+          GroupResult& result = group_results[k];
 
-        // integrate spectrum at the position of the theoretical mass
-        DIAHelpers::adjustExtractionWindow(right, left, mz_extr_window, ppm);
-        DIAHelpers::integrateWindow(sp, left, right, mz, intensity, centroided);
+          const auto& tr = transition_group->getTransitions()[0];
+          auto pepref = tr.getPeptideRef();
+          auto pep_im_it = pep_im_map.find(pepref);
+          result.drift_target = pep_im_it != pep_im_map.end() ? pep_im_it->second : 0.0;
 
-        // skip empty windows
-        if (mz == -1)
+          // we need at least one feature to find the best one
+          if (transition_group->getFeatures().empty()) continue;
+
+          // Find the feature with the highest score
+          findBestFeature(*transition_group, result.bestRT);
+          // Get the corresponding SWATH map(s), for SONAR there will be more than one map
+          std::vector<OpenSwath::SwathMap> used_maps = findSwathMaps(*transition_group, thread_maps);
+
+          if (used_maps.empty())
+          {
+            continue;
+          }
+
+          // Get the spectrum for this RT and extract raw data points for all the
+          // calibrating transitions (fragment m/z values) from the spectrum
+          OpenSwath::SpectrumPtr sp = OpenSwathScoring().fetchSpectrumSwath(used_maps, result.bestRT, 1, 0, 0);
+          for (const auto& tr : transition_group->getTransitions())
+          {
+            double mz, intensity, left(tr.product_mz), right(tr.product_mz);
+            bool centroided = false;
+
+            // integrate spectrum at the position of the theoretical mass
+            DIAHelpers::adjustExtractionWindow(right, left, mz_extr_window, ppm);
+            DIAHelpers::integrateWindow(sp, left, right, mz, intensity, centroided);
+
+            // skip empty windows
+            if (mz == -1)
+            {
+              continue;
+            }
+            result.points.push_back({mz, tr.product_mz, intensity});
+          }
+        }
+        catch (...)
         {
-          continue;
+          errors[k] = std::current_exception();
         }
+      }
+    }
 
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
+
+    for (const auto& result : group_results)
+    {
+      for (const auto& p : result.points)
+      {
         // store result masses
-        data_all.push_back(std::make_pair(mz, tr.product_mz));
+        data_all.push_back(std::make_pair(p.mz, p.theo_mz));
         // regression weight is the log2 intensity
-        weights.push_back( log(intensity) / log(2.0) );
-        exp_mz.push_back( mz );
+        weights.push_back( log(p.intensity) / log(2.0) );
+        exp_mz.push_back( p.mz );
         // y = target = theoretical
-        theo_mz.push_back( tr.product_mz );
-        double diff_ppm = (mz - tr.product_mz) * 1000000 / mz;
+        theo_mz.push_back( p.theo_mz );
+        double diff_ppm = (p.mz - p.theo_mz) * 1000000 / p.mz;
         // y = target = delta-ppm
         delta_ppm.push_back(diff_ppm);
 
         if (!debug_mz_file_.empty())
         {
-          os << mz << "\t" << tr.product_mz << "\t" << drift_target << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << bestRT << std::endl;
+          os << p.mz << "\t" << p.theo_mz << "\t" << result.drift_target << "\t" << diff_ppm << "\t" << log(p.intensity) / log(2.0) << "\t" << result.bestRT << std::endl;
         }
-        OPENMS_LOG_DEBUG << mz << "\t" << tr.product_mz << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << bestRT << std::endl;
+        OPENMS_LOG_DEBUG << p.mz << "\t" << p.theo_mz << "\t" << diff_ppm << "\t" << log(p.intensity) / log(2.0) << "\t" << result.bestRT << std::endl;
       }
     }
 
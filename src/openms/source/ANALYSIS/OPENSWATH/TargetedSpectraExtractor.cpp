@@ -48,6 +48,10 @@
 #include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
 namespace OpenMS
 {
   TargetedSpectraExtractor::TargetedSpectraExtractor() :
@@ -206,16 +210,61 @@ namespace OpenMS
       std::vector<MSSpectrum>& annotated_spectra) const
   {
     annotated_spectra.clear();
-    for (const auto& spectrum : spectra)
+
+    // annotated features (subordinates, if present) in feature map order, indexed by RT
+    std::vector<const Feature*> targets;
+    for (const auto& feature : ms1_features)
+    {
+      if (!feature.getSubordinates().empty())
+      {
+        // iterate through the subordinate level
+        for (const auto& subordinate : feature.getSubordinates())
+        {
+          targets.push_back(&subordinate);
+        }
+      }
+      else
+      {
+        targets.push_back(&feature);
+      }
+    }
+    // check for null annotations resulting from unnanotated features
+    targets.erase(std::remove_if(targets.begin(), targets.end(),
+      [](const Feature* f) { return f->getMetaValue("PeptideRef") == "null" || std::isnan(f->getRT()); }), targets.end());
+    std::vector<Size> targets_by_rt(targets.size());
+    std::iota(targets_by_rt.begin(), targets_by_rt.end(), 0);
+    std::stable_sort(targets_by_rt.begin(), targets_by_rt.end(),
+      [&targets](Size a, Size b) { return targets[a]->getRT() < targets[b]->getRT(); });
+
+    // find the features within the RT window of each MS2 spectrum (in parallel)
+    std::vector<std::vector<Size>> spectrum_targets(spectra.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+    {
+      if (spectra[i].getMSLevel() == 1)
+      {
+        continue; // we want to annotate MS2 spectra only
+      }
+      const double rt_left_lim = spectra[i].getRT() - rt_window_ / 2.0;
+      const double rt_right_lim = spectra[i].getRT() + rt_window_ / 2.0;
+      auto it = std::lower_bound(targets_by_rt.cbegin(), targets_by_rt.cend(), rt_left_lim,
+        [&targets](Size t, double rt) { return targets[t]->getRT() < rt; });
+      for (; it != targets_by_rt.cend() && targets[*it]->getRT() <= rt_right_lim; ++it)
+      {
+        spectrum_targets[i].push_back(*it);
+      }
+      std::sort(spectrum_targets[i].begin(), spectrum_targets[i].end()); // feature map order
+    }
+
+    for (Size i = 0; i < spectra.size(); ++i)
     {
+      const MSSpectrum& spectrum = spectra[i];
       if (spectrum.getMSLevel() == 1)
       {
         continue; // we want to annotate MS2 spectra only
       }
 
       const double spectrum_rt = spectrum.getRT();
-      const double rt_left_lim = spectrum_rt - rt_window_ / 2.0;
-      const double rt_right_lim = spectrum_rt + rt_window_ / 2.0;
       const std::vector<Precursor>& precursors = spectrum.getPrecursors();
       if (precursors.empty())
       {
@@ -223,56 +272,25 @@ namespace OpenMS
       }
       const double spectrum_mz = precursors.empty() ? 0.0 : precursors.front().getMZ();
 
-      auto construct_feature = [rt_left_lim,
-                                rt_right_lim,
-                                spectrum_rt,
-                                spectrum_mz,
-                                &ms2_features,
-                                &annotated_spectra,
-                                &spectrum]
-                                (const OpenMS::Feature& feature) 
+      for (Size t : spectrum_targets[i])
       {
+        const Feature& feature = *targets[t];
         const auto& peptide_ref_s = feature.getMetaValue("PeptideRef");
         const auto& native_id_s = feature.getMetaValue("native_id");
 
-        // check for null annotations resulting from unnanotated features
-        if (peptide_ref_s != "null")
-        {
-          const double target_mz = feature.getMZ();
-          const double target_rt = feature.getRT();
-          if (target_rt >= rt_left_lim && target_rt <= rt_right_lim)
-          {
-            OPENMS_LOG_DEBUG << "annotateSpectra(): " << peptide_ref_s << "]";
-            OPENMS_LOG_DEBUG << " (target_rt: " << target_rt << ") (target_mz: " << target_mz << ")" << std::endl;
-            MSSpectrum annotated_spectrum = spectrum;
-            annotated_spectrum.setName(peptide_ref_s);
-            annotated_spectra.push_back(std::move(annotated_spectrum));
-            // fill the ms2 features map
-            Feature ms2_feature;
-            ms2_feature.setRT(spectrum_rt);
-            ms2_feature.setMZ(spectrum_mz);
-            ms2_feature.setIntensity(feature.getIntensity());
-            ms2_feature.setMetaValue("native_id", native_id_s);
-            ms2_feature.setMetaValue("PeptideRef", peptide_ref_s);
-            ms2_features.push_back(std::move(ms2_feature));
-          }
-        }
-      };
-
-      for (const auto& feature : ms1_features)
-      {
-        if (!feature.getSubordinates().empty())
-        {
-          // iterate through the subordinate level
-          for (const auto& subordinate : feature.getSubordinates())
-          {
-            construct_feature(subordinate);
-          }
-        }
-        else
-        {
-          construct_feature(feature);
-        }
+        OPENMS_LOG_DEBUG << "annotateSpectra(): " << peptide_ref_s << "]";
+        OPENMS_LOG_DEBUG << " (target_rt: " << feature.getRT() << ") (target_mz: " << feature.getMZ() << ")" << std::endl;
+        MSSpectrum annotated_spectrum = spectrum;
+        annotated_spectrum.setName(peptide_ref_s);
+        annotated_spectra.push_back(std::move(annotated_spectrum));
+        // fill the ms2 features map
+        Feature ms2_feature;
+        ms2_feature.setRT(spectrum_rt);
+        ms2_feature.setMZ(spectrum_mz);
+        ms2_feature.setIntensity(feature.getIntensity());
+        ms2_feature.setMetaValue("native_id", native_id_s);
+        ms2_feature.setMetaValue("PeptideRef", peptide_ref_s);
+        ms2_features.push_back(std::move(ms2_feature));
       }
     }
   }
@@ -372,51 +390,86 @@ namespace OpenMS
     annotated_spectra.clear();
     features.clear(true);
     const std::vector<ReactionMonitoringTransition>& transitions = targeted_exp.getTransitions();
+    const double mz_tolerance = mz_unit_is_Da_ ? mz_tolerance_ : mz_tolerance_ / 1e6;
+
+    // resolve the target RT of each transition once and index the transitions by RT
+    struct Target
+    {
+      double rt;
+      double mz;
+      Size transition_idx;
+    };
+    std::vector<Target> targets;
+    targets.reserve(transitions.size());
+    for (Size j = 0; j < transitions.size(); ++j)
+    {
+      const TargetedExperimentHelper::Peptide& peptide = targeted_exp.getPeptideByRef(transitions[j].getPeptideRef());
+      double target_rt = peptide.getRetentionTime();
+      if (peptide.getRetentionTimeUnit() == TargetedExperimentHelper::RetentionTime::RTUnit::MINUTE)
+      {
+        target_rt *= 60.0;
+      }
+      if (!std::isnan(target_rt))
+      {
+        targets.push_back({target_rt, transitions[j].getPrecursorMZ(), j});
+      }
+    }
+    std::sort(targets.begin(), targets.end(), [](const Target& a, const Target& b) { return a.rt < b.rt; });
+
+    // find the matching transitions of each spectrum (in parallel)
+    std::vector<std::vector<Size>> spectrum_transitions(spectra.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+    {
+      const MSSpectrum& spectrum = spectra[i];
+      const double rt_left_lim = spectrum.getRT() - rt_window_ / 2.0;
+      const double rt_right_lim = spectrum.getRT() + rt_window_ / 2.0;
+      const std::vector<Precursor>& precursors = spectrum.getPrecursors();
+      const double spectrum_mz = precursors.empty() ? 0.0 : precursors.front().getMZ();
+
+      // When spectrum_mz is 0, the mz check on transitions is inhibited
+      const double mz_left_lim = spectrum_mz ? spectrum_mz - mz_tolerance : std::numeric_limits<double>::min();
+      const double mz_right_lim = spectrum_mz ? spectrum_mz + mz_tolerance : std::numeric_limits<double>::max();
+
+      auto it = std::lower_bound(targets.cbegin(), targets.cend(), rt_left_lim,
+        [](const Target& t, double rt) { return t.rt < rt; });
+      for (; it != targets.cend() && it->rt <= rt_right_lim; ++it)
+      {
+        if (it->mz >= mz_left_lim && it->mz <= mz_right_lim)
+        {
+          spectrum_transitions[i].push_back(it->transition_idx);
+        }
+      }
+      std::sort(spectrum_transitions[i].begin(), spectrum_transitions[i].end()); // transition order
+    }
+
     for (Size i = 0; i < spectra.size(); ++i)
     {
       const MSSpectrum& spectrum = spectra[i];
       const double spectrum_rt = spectrum.getRT();
-      const double rt_left_lim = spectrum_rt - rt_window_ / 2.0;
-      const double rt_right_lim = spectrum_rt + rt_window_ / 2.0;
       const std::vector<Precursor>& precursors = spectrum.getPrecursors();
       if (precursors.empty())
       {
         OPENMS_LOG_WARN << "annotateSpectra(): No precursor MZ found. Setting spectrum_mz to 0." << std::endl;
       }
       const double spectrum_mz = precursors.empty() ? 0.0 : precursors.front().getMZ();
-      const double mz_tolerance = mz_unit_is_Da_ ? mz_tolerance_ : mz_tolerance_ / 1e6;
-
-      // When spectrum_mz is 0, the mz check on transitions is inhibited
-      const double mz_left_lim = spectrum_mz ? spectrum_mz - mz_tolerance : std::numeric_limits<double>::min();
-      const double mz_right_lim = spectrum_mz ? spectrum_mz + mz_tolerance : std::numeric_limits<double>::max();
 
       OPENMS_LOG_DEBUG << "annotateSpectra(): [" << i << "] (RT: " << spectrum_rt << ") (MZ: " << spectrum_mz << ")" << std::endl;
 
-      for (Size j = 0; j < transitions.size(); ++j)
+      for (Size j : spectrum_transitions[i])
       {
-        const TargetedExperimentHelper::Peptide& peptide = targeted_exp.getPeptideByRef(transitions[j].getPeptideRef());
-        double target_rt = peptide.getRetentionTime();
-        if (peptide.getRetentionTimeUnit() == TargetedExperimentHelper::RetentionTime::RTUnit::MINUTE)
-        {
-          target_rt *= 60.0;
-        }
-        const double target_mz = transitions[j].getPrecursorMZ();
-        if (target_rt >= rt_left_lim && target_rt <= rt_right_lim &&
-            target_mz >= mz_left_lim && target_mz <= mz_right_lim)
+        OPENMS_LOG_DEBUG << "annotateSpectra(): [" << j << "][" << transitions[j].getPeptideRef() << "]";
+        OPENMS_LOG_DEBUG << " (target_mz: " << transitions[j].getPrecursorMZ() << ")" << std::endl << std::endl;
+        MSSpectrum annotated_spectrum = spectrum;
+        annotated_spectrum.setName(transitions[j].getPeptideRef());
+        annotated_spectra.push_back(std::move(annotated_spectrum));
+        if (compute_features)
         {
-          OPENMS_LOG_DEBUG << "annotateSpectra(): [" << j << "][" << transitions[j].getPeptideRef() << "]";
-          OPENMS_LOG_DEBUG << " (target_rt: " << target_rt << ") (target_mz: " << target_mz << ")" << std::endl << std::endl;
-          MSSpectrum annotated_spectrum = spectrum;
-          annotated_spectrum.setName(transitions[j].getPeptideRef());
-          annotated_spectra.push_back(annotated_spectrum);
-          if (compute_features)
-          {
-            Feature feature;
-            feature.setRT(spectrum_rt);
-            feature.setMZ(spectrum_mz);
-            feature.setMetaValue("transition_name", transitions[j].getPeptideRef());
-            features.push_back(feature);
-          }
+          Feature feature;
+          feature.setRT(spectrum_rt);
+          feature.setMZ(spectrum_mz);
+          feature.setMetaValue("transition_name", transitions[j].getPeptideRef());
+          features.push_back(std::move(feature));
         }
       }
     }
@@ -474,35 +527,55 @@ namespace OpenMS
     pp.setParameters(pepi_param);
     pp.pick(smoothed_spectrum, picked_spectrum);
 
-    std::vector<Int> peaks_pos_to_erase;
+    std::vector<Size> peaks_pos_to_keep;
     const double fwhm_threshold = mz_unit_is_Da_ ? fwhm_threshold_ : fwhm_threshold_ / 1e6;
-    for (Int i = picked_spectrum.size() - 1; i >= 0; --i)
+    for (Size i = 0; i < picked_spectrum.size(); ++i)
     {
-      if (picked_spectrum[i].getIntensity() < peak_height_min_ ||
-          picked_spectrum[i].getIntensity() > peak_height_max_ ||
-          picked_spectrum.getFloatDataArrays()[0][i] < fwhm_threshold)
+      if (!(picked_spectrum[i].getIntensity() < peak_height_min_ ||
+            picked_spectrum[i].getIntensity() > peak_height_max_ ||
+            picked_spectrum.getFloatDataArrays()[0][i] < fwhm_threshold))
       {
-        peaks_pos_to_erase.push_back(i);
+        peaks_pos_to_keep.push_back(i);
       }
     }
 
-    if (peaks_pos_to_erase.size() != picked_spectrum.size()) // if not all peaks are to be removed
+    if (!peaks_pos_to_keep.empty()) // if not all peaks are to be removed
     {
-      for (Int i : peaks_pos_to_erase) // then keep only the valid peaks (and fwhm)
-      {
-        picked_spectrum.erase(picked_spectrum.begin() + i);
-        picked_spectrum.getFloatDataArrays()[0].erase(picked_spectrum.getFloatDataArrays()[0].begin() + i);
-      }
+      picked_spectrum.select(peaks_pos_to_keep); // then keep only the valid peaks (and fwhm)
     }
     else // otherwise output an empty picked_spectrum
     {
       picked_spectrum.clear(true);
     }
 
+#pragma omp critical (LOG_DEBUG_access)
     OPENMS_LOG_DEBUG << "pickSpectrum(): " << spectrum.getName() << " (input size: " <<
       spectrum.size() << ") (picked: " << picked_spectrum.size() << ")\n" << std::endl;
   }
 
+  void TargetedSpectraExtractor::pickSpectra_(const std::vector<MSSpectrum>& spectra, std::vector<MSSpectrum>& picked_spectra) const
+  {
+    picked_spectra.clear();
+    picked_spectra.resize(spectra.size());
+    std::vector<std::exception_ptr> errors(spectra.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+    {
+      try
+      {
+        pickSpectrum(spectra[i], picked_spectra[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const auto& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
+  }
+
   void TargetedSpectraExtractor::scoreSpectra(
     const std::vector<MSSpectrum>& annotated_spectra,
     const std::vector<MSSpectrum>& picked_spectra,
@@ -517,70 +590,83 @@ namespace OpenMS
     {
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
-    for (Size i = 0; i < annotated_spectra.size(); ++i)
+    std::vector<std::exception_ptr> errors(annotated_spectra.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)annotated_spectra.size(); ++i)
     {
-      double total_tic { 0 };
-      for (Size j = 0; j < annotated_spectra[i].size(); ++j)
+      try
       {
-        total_tic += annotated_spectra[i][j].getIntensity();
-      }
+        double total_tic { 0 };
+        for (Size j = 0; j < annotated_spectra[i].size(); ++j)
+        {
+          total_tic += annotated_spectra[i][j].getIntensity();
+        }
 
-      double avgFWHM { 0 };
-      if (!picked_spectra[i].getFloatDataArrays().empty())
-      {
-        for (Size j = 0; j < picked_spectra[i].getFloatDataArrays()[0].size(); ++j)
+        double avgFWHM { 0 };
+        if (!picked_spectra[i].getFloatDataArrays().empty())
+        {
+          for (Size j = 0; j < picked_spectra[i].getFloatDataArrays()[0].size(); ++j)
+          {
+            avgFWHM += picked_spectra[i].getFloatDataArrays()[0][j];
+          }
+          avgFWHM /= picked_spectra[i].getFloatDataArrays()[0].size();
+        }
+        SignalToNoiseEstimatorMedian<MSSpectrum> sne;
+        Param p;
+        p.setValue("win_len", 40.0);
+        p.setValue("noise_for_empty_window", 2.0);
+        p.setValue("min_required_elements", 10);
+        sne.setParameters(p);
+        sne.init(annotated_spectra[i]);
+        double avgSNR { 0 };
+        for (Size j = 0; j < annotated_spectra[i].size(); ++j)
         {
-          avgFWHM += picked_spectra[i].getFloatDataArrays()[0][j];
+          avgSNR += sne.getSignalToNoise(j);
         }
-        avgFWHM /= picked_spectra[i].getFloatDataArrays()[0].size();
-      }
-      SignalToNoiseEstimatorMedian<MSSpectrum> sne;
-      Param p;
-      p.setValue("win_len", 40.0);
-      p.setValue("noise_for_empty_window", 2.0);
-      p.setValue("min_required_elements", 10);
-      sne.setParameters(p);
-      sne.init(annotated_spectra[i]);
-      double avgSNR { 0 };
-      for (Size j = 0; j < annotated_spectra[i].size(); ++j)
-      {
-        avgSNR += sne.getSignalToNoise(j);
-      }
-      avgSNR /= annotated_spectra[i].size();
-
-      const double log10_total_tic = log10(total_tic);
-      const double inverse_avgFWHM = 1.0 / avgFWHM;
-      const double score = log10_total_tic * tic_weight_ + inverse_avgFWHM * fwhm_weight_ + avgSNR * snr_weight_;
-
-      scored_spectra[i] = annotated_spectra[i];
-      scored_spectra[i].getFloatDataArrays().resize(5);
-      scored_spectra[i].getFloatDataArrays()[1].setName("score");
-      scored_spectra[i].getFloatDataArrays()[1].push_back(score);
-      scored_spectra[i].getFloatDataArrays()[2].setName("log10_total_tic");
-      scored_spectra[i].getFloatDataArrays()[2].push_back(log10_total_tic);
-      scored_spectra[i].getFloatDataArrays()[3].setName("inverse_avgFWHM");
-      scored_spectra[i].getFloatDataArrays()[3].push_back(inverse_avgFWHM);
-      scored_spectra[i].getFloatDataArrays()[4].setName("avgSNR");
-      scored_spectra[i].getFloatDataArrays()[4].push_back(avgSNR);
-
-      if (compute_features)
-      {
-        // The intensity of a feature is (proportional to) its total ion count
-        // http://www.openms.de/documentation/classOpenMS_1_1Feature.html
-        features[i].setIntensity(score);
-        features[i].setMetaValue("log10_total_tic", log10_total_tic);
-        features[i].setMetaValue("inverse_avgFWHM", inverse_avgFWHM);
-        features[i].setMetaValue("avgFWHM", avgFWHM);
-        features[i].setMetaValue("avgSNR", avgSNR);
-        std::vector<Feature> subordinates(picked_spectra[i].size());
-        for (Size j = 0; j < picked_spectra[i].size(); ++j)
+        avgSNR /= annotated_spectra[i].size();
+
+        const double log10_total_tic = log10(total_tic);
+        const double inverse_avgFWHM = 1.0 / avgFWHM;
+        const double score = log10_total_tic * tic_weight_ + inverse_avgFWHM * fwhm_weight_ + avgSNR * snr_weight_;
+
+        scored_spectra[i] = annotated_spectra[i];
+        scored_spectra[i].getFloatDataArrays().resize(5);
+        scored_spectra[i].getFloatDataArrays()[1].setName("score");
+        scored_spectra[i].getFloatDataArrays()[1].push_back(score);
+        scored_spectra[i].getFloatDataArrays()[2].setName("log10_total_tic");
+        scored_spectra[i].getFloatDataArrays()[2].push_back(log10_total_tic);
+        scored_spectra[i].getFloatDataArrays()[3].setName("inverse_avgFWHM");
+        scored_spectra[i].getFloatDataArrays()[3].push_back(inverse_avgFWHM);
+        scored_spectra[i].getFloatDataArrays()[4].setName("avgSNR");
+        scored_spectra[i].getFloatDataArrays()[4].push_back(avgSNR);
+
+        if (compute_features)
         {
-          subordinates[j].setMZ(picked_spectra[i][j].getMZ());
-          subordinates[j].setIntensity(picked_spectra[i][j].getIntensity());
-          subordinates[j].setMetaValue("FWHM", picked_spectra[i].getFloatDataArrays()[0][j]);
+          // The intensity of a feature is (proportional to) its total ion count
+          // http://www.openms.de/documentation/classOpenMS_1_1Feature.html
+          features[i].setIntensity(score);
+          features[i].setMetaValue("log10_total_tic", log10_total_tic);
+          features[i].setMetaValue("inverse_avgFWHM", inverse_avgFWHM);
+          features[i].setMetaValue("avgFWHM", avgFWHM);
+          features[i].setMetaValue("avgSNR", avgSNR);
+          std::vector<Feature> subordinates(picked_spectra[i].size());
+          for (Size j = 0; j < picked_spectra[i].size(); ++j)
+          {
+            subordinates[j].setMZ(picked_spectra[i][j].getMZ());
+            subordinates[j].setIntensity(picked_spectra[i][j].getIntensity());
+            subordinates[j].setMetaValue("FWHM", picked_spectra[i].getFloatDataArrays()[0][j]);
+          }
+          features[i].setSubordinates(subordinates);
         }
-        features[i].setSubordinates(subordinates);
       }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const auto& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
     }
   }
 
@@ -666,22 +752,28 @@ namespace OpenMS
     annotateSpectra(spectra, targeted_exp, annotated, features, compute_features);
 
     // pick peaks from annotate spectra
-    std::vector<MSSpectrum> picked(annotated.size());
-    for (Size i = 0; i < annotated.size(); ++i)
-    {
-      pickSpectrum(annotated[i], picked[i]);
-    }
+    std::vector<MSSpectrum> picked;
+    pickSpectra_(annotated, picked);
 
     // remove empty picked<> spectra, and accordingly update annotated<> and features
-    for (Int i = annotated.size() - 1; i >= 0; --i)
+    Size n_kept { 0 };
+    for (Size i = 0; i < annotated.size(); ++i)
     {
       if (picked[i].empty())
       {
-        annotated.erase(annotated.begin() + i);
-        picked.erase(picked.begin() + i);
-        if (compute_features) features.erase(features.begin() + i);
+        continue;
+      }
+      if (i != n_kept)
+      {
+        annotated[n_kept] = std::move(annotated[i]);
+        picked[n_kept] = std::move(picked[i]);
+        if (compute_features) features[n_kept] = std::move(features[i]);
       }
+      ++n_kept;
     }
+    annotated.resize(n_kept);
+    picked.resize(n_kept);
+    if (compute_features) features.resize(n_kept);
 
     // score spectra
     std::vector<MSSpectrum> scored;
@@ -736,11 +828,8 @@ namespace OpenMS
     annotateSpectra(experiment.getSpectra(), ms1_features, ms2_features, annotated_spectra);
 
     // pickSpectra
-    std::vector<MSSpectrum> picked_spectra(annotated_spectra.size());
-    for (Size i = 0; i < annotated_spectra.size(); ++i)
-    {
-      pickSpectrum(annotated_spectra[i], picked_spectra[i]);
-    }
+    std::vector<MSSpectrum> picked_spectra;
+    pickSpectra_(annotated_spectra, picked_spectra);
 
     // score and select
     std::vector<OpenMS::MSSpectrum> scored_spectra;
@@ -764,17 +853,18 @@ namespace OpenMS
 
     cmp.generateScores(input_spectrum, scores, min_match_score_);
 
-    // Sort the vector of scores
-    std::sort(scores.begin(), scores.end(),
+    // Set the number of best matches to return
+    const Size n = std::min(top_matches_to_report_, scores.size());
+
+    // Sort the best n scores
+    std::partial_sort(scores.begin(), scores.begin() + n, scores.end(),
       [](const std::pair<Size,double>& a, const std::pair<Size,double>& b)
       {
         return a.second > b.second;
       });
 
-    // Set the number of best matches to return
-    const Size n = std::min(top_matches_to_report_, scores.size());
-
     // Construct a vector of n `Match`es
+    matches.reserve(n);
     for (Size i = 0; i < n; ++i)
     {
       const Size spec_idx { scores[i].first };
@@ -794,20 +884,47 @@ namespace OpenMS
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
 
-    std::vector<Size> no_matches_idx; // to keep track of those features without a match
-    const Size tmp = top_matches_to_report_;
-    top_matches_to_report_ = 1;
+    // score all spectra against the library in parallel, keeping only the best hit
+    // (instead of copying it from the library into a `Match`)
+    const Size no_match = std::numeric_limits<Size>::max();
+    std::vector<std::pair<Size, double>> best_matches(spectra.size(), {no_match, 0.0});
+    std::vector<std::exception_ptr> errors(spectra.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+    {
+      try
+      {
+        std::vector<std::pair<Size,double>> scores;
+        cmp.generateScores(spectra[i], scores, min_match_score_);
+        if (!scores.empty())
+        {
+          best_matches[i] = *std::max_element(scores.begin(), scores.end(),
+            [](const std::pair<Size,double>& a, const std::pair<Size,double>& b)
+            {
+              return a.second < b.second;
+            });
+        }
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+    for (const auto& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
 
+    std::vector<Size> no_matches_idx; // to keep track of those features without a match
     for (Size i = 0; i < spectra.size(); ++i)
     {
-      std::vector<Match> matches;
-      matchSpectrum(spectra[i], cmp, matches);
-      if (!matches.empty())
+      if (best_matches[i].first != no_match)
       {
-        features[i].setMetaValue("spectral_library_name", matches[0].spectrum.getName());
-        features[i].setMetaValue("spectral_library_score", matches[0].score);
-        const String& comments = matches[0].spectrum.metaValueExists("Comments") ?
-          matches[0].spectrum.getMetaValue("Comments") : "";
+        const MSSpectrum& match = cmp.getLibrary()[best_matches[i].first];
+        features[i].setMetaValue("spectral_library_name", match.getName());
+        features[i].setMetaValue("spectral_library_score", best_matches[i].second);
+        const String& comments = match.metaValueExists("Comments") ?
+          match.getMetaValue("Comments") : "";
         features[i].setMetaValue("spectral_library_comments", comments);
       }
       else
@@ -819,8 +936,6 @@ namespace OpenMS
       }
     }
 
-    top_matches_to_report_ = tmp;
-
     if (!no_matches_idx.empty())
     {
       String warn_msg = "No match was found for " + std::to_string(no_matches_idx.size()) + " `Feature`s. Indices: ";
@@ -840,20 +955,12 @@ namespace OpenMS
   {
     features.clear(true);
 
-    std::vector<MSSpectrum> picked(spectra.size());
-    for (Size i = 0; i < spectra.size(); ++i)
-    {
-      pickSpectrum(spectra[i], picked[i]);
-    }
+    std::vector<MSSpectrum> picked;
+    pickSpectra_(spectra, picked);
 
     // remove empty picked<> spectra
-    for (Int i = spectra.size() - 1; i >= 0; --i)
-    {
-      if (picked[i].empty())
-      {
-        picked.erase(picked.begin() + i);
-      }
-    }
+    picked.erase(std::remove_if(picked.begin(), picked.end(),
+      [](const MSSpectrum& s) { return s.empty(); }), picked.end());
 
     for (const MSSpectrum& spectrum : picked)
     {
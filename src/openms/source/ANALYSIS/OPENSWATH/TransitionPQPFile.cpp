@@ -59,6 +59,11 @@ namespace OpenMS
   }
 
   void TransitionPQPFile::readPQPInput_(const char* filename, std::vector<TSVTransition>& transition_list, bool legacy_traml_id)
+  {
+    readPQPInput_(filename, [&transition_list](TSVTransition& tr) { transition_list.push_back(std::move(tr)); }, legacy_traml_id);
+  }
+
+  void TransitionPQPFile::readPQPInput_(const char* filename, const std::function<void(TSVTransition&)>& consume, bool legacy_traml_id)
   {
     sqlite3 *db;
     sqlite3_stmt * cntstmt;
@@ -252,7 +257,7 @@ namespace OpenMS
 
       if (mytransition.GeneName == "NA") mytransition.GeneName = "";
 
-      transition_list.push_back(mytransition);
+      consume(mytransition);
       sqlite3_step( stmt );
     }
     endProgress();
@@ -716,9 +721,11 @@ namespace OpenMS
                                                          OpenSwath::LightTargetedExperiment& targeted_exp,
                                                          bool legacy_traml_id)
   {
-    std::vector<TSVTransition> transition_list;
-    readPQPInput_(filename, transition_list, legacy_traml_id);
-    TSVToTargetedExperiment_(transition_list, targeted_exp);
+    // convert transitions as they are read, without an intermediate list
+    LightConversionState_ state;
+    readPQPInput_(filename,
+                  [&](TSVTransition& tr) { addToLightTargetedExperiment_(tr, targeted_exp, state); },
+                  legacy_traml_id);
   }
 
 }
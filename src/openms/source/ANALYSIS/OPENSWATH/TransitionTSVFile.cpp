@@ -38,8 +38,11 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
 #include <OpenMS/FORMAT/TextFile.h>
 
+#include <exception>
+
 namespace OpenMS
 {
 
@@ -67,9 +70,9 @@ namespace OpenMS
                         const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find( header_name );
-    if (tmp != header_dict.end() && !String(tmp_line[ tmp->second ]).empty())
+    if (tmp != header_dict.end() && !tmp_line[ tmp->second ].empty())
     {
-      value = String(tmp_line[ tmp->second ]).toInt();
+      value = StringView(tmp_line[ tmp->second ]).toInt();
       return true;
     }
     return false;
@@ -81,9 +84,9 @@ namespace OpenMS
                         const std::map<std::string, int>& header_dict)
   {
     auto tmp = header_dict.find(header_name);
-    if (tmp != header_dict.end() && !String(tmp_line[ tmp->second ]).empty())
+    if (tmp != header_dict.end() && !tmp_line[ tmp->second ].empty())
     {
-      value = String(tmp_line[ tmp->second ]).toDouble();
+      value = StringView(tmp_line[ tmp->second ]).toDouble();
       return true;
     }
     return false;
@@ -216,13 +219,16 @@ namespace OpenMS
   }
 
   void TransitionTSVFile::readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, std::vector<TSVTransition>& transition_list)
+  {
+    readUnstructuredTSVInput_(filename, filetype, [&transition_list](TSVTransition& tr) { transition_list.push_back(std::move(tr)); });
+  }
+
+  void TransitionTSVFile::readUnstructuredTSVInput_(const char* filename, FileTypes::Type filetype, const std::function<void(TSVTransition&)>& consume)
   {
     std::ifstream data(filename);
     std::string   line;
-    std::string   tmp;
 
     // read header
-    std::vector<std::string>   tmp_line;
     std::map<std::string, int> header_dict;
     char delimiter = ',';
 
@@ -254,241 +260,303 @@ namespace OpenMS
 
     bool spectrast_legacy = false; // we will check below if SpectraST was run in legacy (<5.0) mode or if the RT normalization was forgotten.
     int cnt = 0;
-    while (TextFile::getLine(data, line)) // make sure line endings are handled correctly
-    {
-      line.push_back(delimiter); // avoid losing last column if it is empty
-      std::stringstream lineStream(line);
 
-      while (std::getline(lineStream, tmp, delimiter)) // default getline is fine here, we only want to split the line
+    // Lines are read sequentially in batches, parsed in parallel (parsing dominates the runtime for
+    // large libraries) and then handed to the consumer in file order.
+    const Size batch_size = 8192;
+    std::vector<std::string> lines;
+    std::vector<TSVTransition> transitions;
+    std::vector<char> keep;
+    lines.reserve(batch_size);
+    bool more = true;
+    while (more)
+    {
+      lines.clear();
+      while (lines.size() < batch_size && (more = static_cast<bool>(TextFile::getLine(data, line)))) // make sure line endings are handled correctly
+      {
+        lines.push_back(std::move(line));
+      }
+      if (lines.empty())
       {
-        tmp_line.push_back(tmp);
+        break;
       }
-      cnt++;
 
-#ifdef TRANSITIONTSVREADER_TESTING
-      for (Size i = 0; i < tmp_line.size(); i++)
+      const SignedSize n = static_cast<SignedSize>(lines.size());
+      transitions.assign(lines.size(), TSVTransition());
+      keep.assign(lines.size(), 0);
+      std::vector<std::exception_ptr> errors(lines.size());
+      bool batch_legacy = false;
+
+#pragma omp parallel for schedule(dynamic, 64) reduction(||: batch_legacy)
+      for (SignedSize i = 0; i < n; ++i)
       {
-        std::cout << "line " << i << " " << tmp_line[i] << std::endl;
+        try
+        {
+          bool legacy = false;
+          keep[i] = parseTSVLine_(lines[i], delimiter, header_dict, filetype, cnt + static_cast<int>(i) + 1, transitions[i], legacy);
+          batch_legacy = batch_legacy || legacy;
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
       }
 
-      for (const auto& iter : header_dict)
+      // report the first error in file order, as the sequential reader did
+      for (const std::exception_ptr& error : errors)
       {
-        std::cout << "header " << iter.first << " " << iter.second << std::endl;
+        if (error) std::rethrow_exception(error);
       }
-#endif
+      spectrast_legacy = spectrast_legacy || batch_legacy;
+      cnt += static_cast<int>(n);
 
-      if (tmp_line.size() != header_dict.size())
+      for (Size i = 0; i < transitions.size(); ++i)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Error reading the file on line " + String(cnt) + ": length of the header and length of the line" +
-                                         " do not match: " + String(tmp_line.size()) + " != " + String(header_dict.size()));
+        if (keep[i])
+        {
+          consume(transitions[i]);
+        }
       }
+    }
 
-      TSVTransition mytransition;
-      bool skip_transition = false; // skip unannotated transitions in SpectraST MRM files
+    if (spectrast_legacy && retentionTimeInterpretation_ == "iRT")
+    {
+      std::cout << "Warning: SpectraST was not run in RT normalization mode but the converted list was interpreted to have iRT units. Check whether you need to adapt the parameter -algorithm:retentionTimeInterpretation. You can ignore this warning if you used a legacy SpectraST 4.0 file." << std::endl;
 
-      //// Required columns (they are guaranteed to be present, see getTSVHeader_)
-      // PrecursorMz
-      mytransition.precursor = String(tmp_line[header_dict["PrecursorMz"]]).toDouble();
+    }
+  }
 
-      // ProductMz
-      if (!extractName<double>(mytransition.product, "ProductMz", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.product, "FragmentMz", tmp_line, header_dict)) // Spectronaut
+  bool TransitionTSVFile::parseTSVLine_(const std::string& line, char delimiter, const std::map<std::string, int>& header_dict,
+                                        FileTypes::Type filetype, int line_nr, TSVTransition& mytransition, bool& spectrast_legacy)
+  {
+    // split the line; a trailing empty column is kept (same as appending the delimiter and splitting)
+    std::vector<std::string> tmp_line;
+    tmp_line.reserve(header_dict.size());
+    std::string::size_type start = 0;
+    while (true)
+    {
+      std::string::size_type end = line.find(delimiter, start);
+      if (end == std::string::npos)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Expected a header named ProductMz or FragmentMz but found none");
+        tmp_line.emplace_back(line, start);
+        break;
       }
+      tmp_line.emplace_back(line, start, end - start);
+      start = end + 1;
+    }
+
+#ifdef TRANSITIONTSVREADER_TESTING
+    for (Size i = 0; i < tmp_line.size(); i++)
+    {
+      std::cout << "line " << i << " " << tmp_line[i] << std::endl;
+    }
 
-      // LibraryIntensity
-      if (!extractName<double>(mytransition.library_intensity, "LibraryIntensity", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.library_intensity, "RelativeIntensity", tmp_line, header_dict) && // Spectronaut
-          !extractName<double>(mytransition.library_intensity, "RelativeFragmentIntensity", tmp_line, header_dict)) // Spectronaut
+    for (const auto& iter : header_dict)
+    {
+      std::cout << "header " << iter.first << " " << iter.second << std::endl;
+    }
+#endif
+
+    if (tmp_line.size() != header_dict.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Error reading the file on line " + String(line_nr) + ": length of the header and length of the line" +
+                                       " do not match: " + String(tmp_line.size()) + " != " + String(header_dict.size()));
+    }
+
+    bool skip_transition = false; // skip unannotated transitions in SpectraST MRM files
+
+
+    //// Required columns (they are guaranteed to be present, see getTSVHeader_)
+    // PrecursorMz
+    mytransition.precursor = StringView(tmp_line[header_dict.at("PrecursorMz")]).toDouble();
+
+    // ProductMz
+    if (!extractName<double>(mytransition.product, "ProductMz", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.product, "FragmentMz", tmp_line, header_dict)) // Spectronaut
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Expected a header named ProductMz or FragmentMz but found none");
+    }
+
+    // LibraryIntensity
+    if (!extractName<double>(mytransition.library_intensity, "LibraryIntensity", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.library_intensity, "RelativeIntensity", tmp_line, header_dict) && // Spectronaut
+        !extractName<double>(mytransition.library_intensity, "RelativeFragmentIntensity", tmp_line, header_dict)) // Spectronaut
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                       "Expected a header named LibraryIntensity or RelativeFragmentIntensity but found none");
+    }
+
+    //// Additional columns for both proteomics and metabolomics
+    // NormalizedRetentionTime
+    if (!extractName<double>(mytransition.rt_calibrated, "RetentionTimeCalculatorScore", tmp_line, header_dict) && // Skyline
+        !extractName<double>(mytransition.rt_calibrated, "iRT", tmp_line, header_dict) && // Spectronaut
+        !extractName<double>(mytransition.rt_calibrated, "NormalizedRetentionTime", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.rt_calibrated, "RetentionTime", tmp_line, header_dict) &&
+        !extractName<double>(mytransition.rt_calibrated, "Tr_recalibrated", tmp_line, header_dict))
+    {
+      if (header_dict.find("SpectraSTRetentionTime") != header_dict.end())
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                         "Expected a header named LibraryIntensity or RelativeFragmentIntensity but found none");
+        spectrastRTExtract(tmp_line[header_dict.at("SpectraSTRetentionTime")], mytransition.rt_calibrated, spectrast_legacy);
       }
-
-      //// Additional columns for both proteomics and metabolomics
-      // NormalizedRetentionTime
-      if (!extractName<double>(mytransition.rt_calibrated, "RetentionTimeCalculatorScore", tmp_line, header_dict) && // Skyline
-          !extractName<double>(mytransition.rt_calibrated, "iRT", tmp_line, header_dict) && // Spectronaut
-          !extractName<double>(mytransition.rt_calibrated, "NormalizedRetentionTime", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.rt_calibrated, "RetentionTime", tmp_line, header_dict) &&
-          !extractName<double>(mytransition.rt_calibrated, "Tr_recalibrated", tmp_line, header_dict))
+      else
       {
-        if (header_dict.find("SpectraSTRetentionTime") != header_dict.end())
-        {
-          spectrastRTExtract(tmp_line[header_dict["SpectraSTRetentionTime"]], mytransition.rt_calibrated, spectrast_legacy);
-        }
-        else
-        {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-                                           "Expected a header named RetentionTime, NormalizedRetentionTime, iRT, RetentionTimeCalculatorScore, Tr_recalibrated or SpectraSTRetentionTime but found none");
-        }
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                         "Expected a header named RetentionTime, NormalizedRetentionTime, iRT, RetentionTimeCalculatorScore, Tr_recalibrated or SpectraSTRetentionTime but found none");
       }
+    }
 
-      // PrecursorCharge
-      void(!extractName(mytransition.precursor_charge, "PrecursorCharge", tmp_line, header_dict) &&
-      !extractName(mytransition.precursor_charge, "Charge", tmp_line, header_dict)); // charge is assumed to be the charge of the precursor
+    // PrecursorCharge
+    void(!extractName(mytransition.precursor_charge, "PrecursorCharge", tmp_line, header_dict) &&
+    !extractName(mytransition.precursor_charge, "Charge", tmp_line, header_dict)); // charge is assumed to be the charge of the precursor
 
-      void(!extractName(mytransition.fragment_type, "FragmentType", tmp_line, header_dict) &&
-      !extractName(mytransition.fragment_type, "FragmentIonType", tmp_line, header_dict)); // Skyline
+    void(!extractName(mytransition.fragment_type, "FragmentType", tmp_line, header_dict) &&
+    !extractName(mytransition.fragment_type, "FragmentIonType", tmp_line, header_dict)); // Skyline
 
-      void(!extractName(mytransition.fragment_charge, "FragmentCharge", tmp_line, header_dict) &&
-      !extractName(mytransition.fragment_charge, "ProductCharge", tmp_line, header_dict));
+    void(!extractName(mytransition.fragment_charge, "FragmentCharge", tmp_line, header_dict) &&
+    !extractName(mytransition.fragment_charge, "ProductCharge", tmp_line, header_dict));
 
-      void(!extractName<int>(mytransition.fragment_nr, "FragmentSeriesNumber", tmp_line, header_dict) &&
-      !extractName<int>(mytransition.fragment_nr, "FragmentNumber", tmp_line, header_dict) &&
-      !extractName<int>(mytransition.fragment_nr, "FragmentIonOrdinal", tmp_line, header_dict));
+    void(!extractName<int>(mytransition.fragment_nr, "FragmentSeriesNumber", tmp_line, header_dict) &&
+    !extractName<int>(mytransition.fragment_nr, "FragmentNumber", tmp_line, header_dict) &&
+    !extractName<int>(mytransition.fragment_nr, "FragmentIonOrdinal", tmp_line, header_dict));
 
-      void(extractName<double>(mytransition.drift_time, "PrecursorIonMobility", tmp_line, header_dict));
-      void(extractName<double>(mytransition.fragment_mzdelta, "FragmentMzDelta", tmp_line, header_dict));
-      void(extractName<int>(mytransition.fragment_modification, "FragmentModification", tmp_line, header_dict));
+    void(extractName<double>(mytransition.drift_time, "PrecursorIonMobility", tmp_line, header_dict));
+    void(extractName<double>(mytransition.fragment_mzdelta, "FragmentMzDelta", tmp_line, header_dict));
+    void(extractName<int>(mytransition.fragment_modification, "FragmentModification", tmp_line, header_dict));
 
-      //// Proteomics
-      extractName(mytransition.GeneName, "GeneName", tmp_line, header_dict);
+    //// Proteomics
+    extractName(mytransition.GeneName, "GeneName", tmp_line, header_dict);
 
-      String proteins;
-      void(!extractName(proteins, "ProteinName", tmp_line, header_dict) &&
-      !extractName(proteins, "ProteinId", tmp_line, header_dict)); // Spectronaut
-      if (proteins != "NA" && !proteins.empty())
-      {
-        proteins.split(';', mytransition.ProteinName);
-      }
+    String proteins;
+    void(!extractName(proteins, "ProteinName", tmp_line, header_dict) &&
+    !extractName(proteins, "ProteinId", tmp_line, header_dict)); // Spectronaut
+    if (proteins != "NA" && !proteins.empty())
+    {
+      proteins.split(';', mytransition.ProteinName);
+    }
 
-      void(extractName(mytransition.peptide_group_label, "PeptideGroupLabel", tmp_line, header_dict));
+    void(extractName(mytransition.peptide_group_label, "PeptideGroupLabel", tmp_line, header_dict));
 
-      void(extractName(mytransition.label_type, "LabelType", tmp_line, header_dict));
+    void(extractName(mytransition.label_type, "LabelType", tmp_line, header_dict));
 
-      void(!extractName(mytransition.PeptideSequence, "PeptideSequence", tmp_line, header_dict) &&
-      !extractName(mytransition.PeptideSequence, "Sequence", tmp_line, header_dict) && // Skyline
-      !extractName(mytransition.PeptideSequence, "StrippedSequence", tmp_line, header_dict)); // Spectronaut
+    void(!extractName(mytransition.PeptideSequence, "PeptideSequence", tmp_line, header_dict) &&
+    !extractName(mytransition.PeptideSequence, "Sequence", tmp_line, header_dict) && // Skyline
+    !extractName(mytransition.PeptideSequence, "StrippedSequence", tmp_line, header_dict)); // Spectronaut
 
-      void(!extractName(mytransition.FullPeptideName, "FullUniModPeptideName", tmp_line, header_dict) &&
-      !extractName(mytransition.FullPeptideName, "FullPeptideName", tmp_line, header_dict) &&
-      !extractName(mytransition.FullPeptideName, "ModifiedSequence", tmp_line, header_dict) && // Spectronaut
-      !extractName(mytransition.FullPeptideName, "ModifiedPeptideSequence", tmp_line, header_dict));
+    void(!extractName(mytransition.FullPeptideName, "FullUniModPeptideName", tmp_line, header_dict) &&
+    !extractName(mytransition.FullPeptideName, "FullPeptideName", tmp_line, header_dict) &&
+    !extractName(mytransition.FullPeptideName, "ModifiedSequence", tmp_line, header_dict) && // Spectronaut
+    !extractName(mytransition.FullPeptideName, "ModifiedPeptideSequence", tmp_line, header_dict));
 
-      //// IPF
-      String peptidoforms;
-      void(!extractName<bool>(mytransition.detecting_transition, "detecting_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.detecting_transition, "DetectingTransition", tmp_line, header_dict));
+    //// IPF
+    String peptidoforms;
+    void(!extractName<bool>(mytransition.detecting_transition, "detecting_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.detecting_transition, "DetectingTransition", tmp_line, header_dict));
 
-      void(!extractName<bool>(mytransition.identifying_transition, "identifying_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.identifying_transition, "IdentifyingTransition", tmp_line, header_dict));
+    void(!extractName<bool>(mytransition.identifying_transition, "identifying_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.identifying_transition, "IdentifyingTransition", tmp_line, header_dict));
 
-      void(!extractName<bool>(mytransition.quantifying_transition, "quantifying_transition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.quantifying_transition, "QuantifyingTransition", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.quantifying_transition, "Quantitative", tmp_line, header_dict)); // Skyline
+    void(!extractName<bool>(mytransition.quantifying_transition, "quantifying_transition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.quantifying_transition, "QuantifyingTransition", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.quantifying_transition, "Quantitative", tmp_line, header_dict)); // Skyline
 
-      void(extractName(peptidoforms, "Peptidoforms", tmp_line, header_dict));
-      peptidoforms.split('|', mytransition.peptidoforms);
+    void(extractName(peptidoforms, "Peptidoforms", tmp_line, header_dict));
+    peptidoforms.split('|', mytransition.peptidoforms);
 
-      //// Targeted Metabolomics
-      void(extractName(mytransition.CompoundName, "CompoundName", tmp_line, header_dict));
-      void(extractName(mytransition.SumFormula, "SumFormula", tmp_line, header_dict));
-      void(extractName(mytransition.SMILES, "SMILES", tmp_line, header_dict));
-      void(extractName(mytransition.Adducts, "Adducts", tmp_line, header_dict));
+    //// Targeted Metabolomics
+    void(extractName(mytransition.CompoundName, "CompoundName", tmp_line, header_dict));
+    void(extractName(mytransition.SumFormula, "SumFormula", tmp_line, header_dict));
+    void(extractName(mytransition.SMILES, "SMILES", tmp_line, header_dict));
+    void(extractName(mytransition.Adducts, "Adducts", tmp_line, header_dict));
 
-      //// Meta
-      void(extractName(mytransition.Annotation, "Annotation", tmp_line, header_dict));
-      
-      // UniprotId
-      String uniprot_ids;
-      void(!extractName(uniprot_ids, "UniprotId", tmp_line, header_dict) &&
-      !extractName(uniprot_ids, "UniprotID", tmp_line, header_dict));
-      if (uniprot_ids != "NA" && !uniprot_ids.empty())
-      {
-        uniprot_ids.split(';', mytransition.uniprot_id);
-      }
+    //// Meta
+    void(extractName(mytransition.Annotation, "Annotation", tmp_line, header_dict));
+    
+    // UniprotId
+    String uniprot_ids;
+    void(!extractName(uniprot_ids, "UniprotId", tmp_line, header_dict) &&
+    !extractName(uniprot_ids, "UniprotID", tmp_line, header_dict));
+    if (uniprot_ids != "NA" && !uniprot_ids.empty())
+    {
+      uniprot_ids.split(';', mytransition.uniprot_id);
+    }
 
-      void(!extractName<double>(mytransition.CE, "CE", tmp_line, header_dict) &&
-      !extractName<double>(mytransition.CE, "CollisionEnergy", tmp_line, header_dict));
+    void(!extractName<double>(mytransition.CE, "CE", tmp_line, header_dict) &&
+    !extractName<double>(mytransition.CE, "CollisionEnergy", tmp_line, header_dict));
 
-      // Decoy
-      void(!extractName<bool>(mytransition.decoy, "decoy", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.decoy, "Decoy", tmp_line, header_dict) &&
-      !extractName<bool>(mytransition.decoy, "IsDecoy", tmp_line, header_dict));
+    // Decoy
+    void(!extractName<bool>(mytransition.decoy, "decoy", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.decoy, "Decoy", tmp_line, header_dict) &&
+    !extractName<bool>(mytransition.decoy, "IsDecoy", tmp_line, header_dict));
 
-      if (header_dict.find("SpectraSTAnnotation") != header_dict.end())
-      {
-        skip_transition = spectrastAnnotationExtract(tmp_line[header_dict["SpectraSTAnnotation"]], mytransition);
-      }
+    if (header_dict.find("SpectraSTAnnotation") != header_dict.end())
+    {
+      skip_transition = spectrastAnnotationExtract(tmp_line[header_dict.at("SpectraSTAnnotation")], mytransition);
+    }
 
-      //// Generate Group IDs
-      // SpectraST
-      if (filetype == FileTypes::MRM)
-      {
-        std::vector<String> substrings;
-        String(tmp_line[header_dict["SpectraSTFullPeptideName"]]).split("/", substrings);
-        AASequence peptide = AASequence::fromString(substrings[0]);
+    //// Generate Group IDs
+    // SpectraST
+    if (filetype == FileTypes::MRM)
+    {
+      std::vector<String> substrings;
+      String(tmp_line[header_dict.at("SpectraSTFullPeptideName")]).split("/", substrings);
+      AASequence peptide = AASequence::fromString(substrings[0]);
 
-        mytransition.FullPeptideName = peptide.toString();
-        mytransition.PeptideSequence = peptide.toUnmodifiedString();
-        mytransition.precursor_charge = substrings[1];
+      mytransition.FullPeptideName = peptide.toString();
+      mytransition.PeptideSequence = peptide.toUnmodifiedString();
+      mytransition.precursor_charge = substrings[1];
 
-        mytransition.transition_name = String(cnt);
+      mytransition.transition_name = String(line_nr);
 
-        mytransition.group_id = mytransition.FullPeptideName + String("_") + String(mytransition.precursor_charge);
-      }
-      // Generate transition_group_id and transition_name if not defined
-      else
+      mytransition.group_id = mytransition.FullPeptideName + String("_") + String(mytransition.precursor_charge);
+    }
+    // Generate transition_group_id and transition_name if not defined
+    else
+    {
+      // Use TransitionId if available, else generate from attributes
+      if (!extractName(mytransition.transition_name, "transition_name", tmp_line, header_dict) &&
+          !extractName(mytransition.transition_name, "TransitionName", tmp_line, header_dict) &&
+          !extractName(mytransition.transition_name, "TransitionId", tmp_line, header_dict))
       {
-        // Use TransitionId if available, else generate from attributes
-        if (!extractName(mytransition.transition_name, "transition_name", tmp_line, header_dict) &&
-            !extractName(mytransition.transition_name, "TransitionName", tmp_line, header_dict) &&
-            !extractName(mytransition.transition_name, "TransitionId", tmp_line, header_dict))
-        {
-          mytransition.transition_name = String(cnt);
-        }
-
-        // Use TransitionGroupId if available, else generate from attributes
-        if (!extractName(mytransition.group_id, "transition_group_id", tmp_line, header_dict) &&
-            !extractName(mytransition.group_id, "TransitionGroupId", tmp_line, header_dict) &&
-            !extractName(mytransition.group_id, "TransitionGroupName", tmp_line, header_dict))
-        {
-          mytransition.group_id = AASequence::fromString(mytransition.FullPeptideName).toString() + String("_") + String(mytransition.precursor_charge);
-        }
+        mytransition.transition_name = String(line_nr);
       }
 
-      cleanupTransitions_(mytransition);
-
-      if (!skip_transition)
+      // Use TransitionGroupId if available, else generate from attributes
+      if (!extractName(mytransition.group_id, "transition_group_id", tmp_line, header_dict) &&
+          !extractName(mytransition.group_id, "TransitionGroupId", tmp_line, header_dict) &&
+          !extractName(mytransition.group_id, "TransitionGroupName", tmp_line, header_dict))
       {
-        transition_list.push_back(mytransition);
+        mytransition.group_id = AASequence::fromString(mytransition.FullPeptideName).toString() + String("_") + String(mytransition.precursor_charge);
       }
+    }
+
+    cleanupTransitions_(mytransition);
 
 #ifdef TRANSITIONTSVREADER_TESTING
-      std::cout << mytransition.precursor << std::endl;
-      std::cout << mytransition.product << std::endl;
-      std::cout << mytransition.rt_calibrated << std::endl;
-      std::cout << mytransition.transition_name << std::endl;
-      std::cout << mytransition.CE << std::endl;
-      std::cout << mytransition.library_intensity << std::endl;
-      std::cout << mytransition.group_id << std::endl;
-      std::cout << mytransition.decoy << std::endl;
-      std::cout << mytransition.PeptideSequence << std::endl;
-      std::cout << mytransition.ProteinName << std::endl;
-      std::cout << mytransition.Annotation << std::endl;
-      std::cout << mytransition.FullPeptideName << std::endl;
-      std::cout << mytransition.precursor_charge << std::endl;
-      std::cout << mytransition.peptide_group_label << std::endl;
-      std::cout << mytransition.fragment_charge << std::endl;
-      std::cout << mytransition.fragment_nr << std::endl;
-      std::cout << mytransition.fragment_mzdelta << std::endl;
-      std::cout << mytransition.fragment_modification << std::endl;
-      std::cout << mytransition.fragment_type << std::endl;
-      std::cout << mytransition.uniprot_id << std::endl;
+    std::cout << mytransition.precursor << std::endl;
+    std::cout << mytransition.product << std::endl;
+    std::cout << mytransition.rt_calibrated << std::endl;
+    std::cout << mytransition.transition_name << std::endl;
+    std::cout << mytransition.CE << std::endl;
+    std::cout << mytransition.library_intensity << std::endl;
+    std::cout << mytransition.group_id << std::endl;
+    std::cout << mytransition.decoy << std::endl;
+    std::cout << mytransition.PeptideSequence << std::endl;
+    std::cout << mytransition.ProteinName << std::endl;
+    std::cout << mytransition.Annotation << std::endl;
+    std::cout << mytransition.FullPeptideName << std::endl;
+    std::cout << mytransition.precursor_charge << std::endl;
+    std::cout << mytransition.peptide_group_label << std::endl;
+    std::cout << mytransition.fragment_charge << std::endl;
+    std::cout << mytransition.fragment_nr << std::endl;
+    std::cout << mytransition.fragment_mzdelta << std::endl;
+    std::cout << mytransition.fragment_modification << std::endl;
+    std::cout << mytransition.fragment_type << std::endl;
+    std::cout << mytransition.uniprot_id << std::endl;
 #endif
 
-      tmp_line.clear();
-    }
-
-    if (spectrast_legacy && retentionTimeInterpretation_ == "iRT")
-    {
-      std::cout << "Warning: SpectraST was not run in RT normalization mode but the converted list was interpreted to have iRT units. Check whether you need to adapt the parameter -algorithm:retentionTimeInterpretation. You can ignore this warning if you used a legacy SpectraST 4.0 file." << std::endl;
-
-    }
+    return !skip_transition;
   }
 
   void TransitionTSVFile::spectrastRTExtract(const String str_inp, double & value, bool & spectrast_legacy)
@@ -630,14 +698,14 @@ namespace OpenMS
         if (tr_it->isPeptide())
         {
           OpenMS::TargetedExperiment::Peptide peptide;
-          createPeptide_(tr_it, peptide);
+          createPeptide_(*tr_it, peptide);
           peptides.push_back(peptide);
           peptide_map[peptide.id] = 0;
         }
         else
         {
           OpenMS::TargetedExperiment::Compound compound;
-          createCompound_(tr_it, compound);
+          createCompound_(*tr_it, compound);
           compounds.push_back(compound);
           compound_map[compound.id] = 0;
         }
@@ -674,73 +742,101 @@ namespace OpenMS
 
   void TransitionTSVFile::TSVToTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp)
   {
-    std::map<String, int> compound_map;
-    std::map<String, int> protein_map;
-
-    resolveMixedSequenceGroups_(transition_list);
+    LightConversionState_ state;
+    exp.transitions.reserve(exp.transitions.size() + transition_list.size());
 
     Size progress = 0;
     startProgress(0, transition_list.size(), "conversion to internal data representation");
-    for (auto tr_it = transition_list.cbegin(); tr_it != transition_list.cend(); ++tr_it)
-    {
-      OpenSwath::LightTransition transition;
-      transition.transition_name  = tr_it->transition_name;
-      transition.peptide_ref  = tr_it->group_id;
-      transition.library_intensity  = tr_it->library_intensity;
-      transition.precursor_mz  = tr_it->precursor;
-      transition.product_mz  = tr_it->product;
-      transition.precursor_im = tr_it->drift_time;
-      transition.fragment_charge = 0; // use zero for charge that is not set
-      if (!tr_it->fragment_charge.empty() && tr_it->fragment_charge != "NA")
-      {
-        transition.fragment_charge = tr_it->fragment_charge.toInt();
-      }
-
-      transition.decoy = tr_it->decoy;
-      transition.detecting_transition = tr_it->detecting_transition;
-      transition.identifying_transition = tr_it->identifying_transition;
-      transition.quantifying_transition = tr_it->quantifying_transition;
+    for (auto& tr : transition_list)
+    {
+      addToLightTargetedExperiment_(tr, exp, state);
+      setProgress(progress++);
+    }
+    endProgress();
 
-      exp.transitions.push_back(transition);
+    OPENMS_POSTCONDITION(exp.transitions.size() == transition_list.size(), "Input and output list need to have equal size.")
+  }
 
-      // check whether we need a new compound
-      if (compound_map.find(tr_it->group_id) == compound_map.end())
+  void TransitionTSVFile::addToLightTargetedExperiment_(TSVTransition& tr, OpenSwath::LightTargetedExperiment& exp, LightConversionState_& state)
+  {
+    // same check as in resolveMixedSequenceGroups_, but against the first transition seen so far
+    if (!tr.peptide_group_label.empty())
+    {
+      auto label_it = state.label_sequence.emplace(tr.peptide_group_label, tr.PeptideSequence).first;
+      const std::string& curr_sequence = label_it->second;
+      if (!curr_sequence.empty() && tr.PeptideSequence != curr_sequence)
       {
-        OpenSwath::LightCompound compound;
-        if (tr_it->isPeptide())
+        if (override_group_label_check_)
         {
-          OpenMS::TargetedExperiment::Peptide tramlpeptide;
-          createPeptide_(tr_it, tramlpeptide);
-          OpenSwathDataAccessHelper::convertTargetedCompound(tramlpeptide, compound);
+          // We wont fix it but give out a warning
+          OPENMS_LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << label_it->first <<
+            ". Since 'override_group_label_check' is on, nothing will be changed." << std::endl;
         }
         else
         {
-          OpenMS::TargetedExperiment::Compound tramlcompound;
-          createCompound_(tr_it, tramlcompound);
-          OpenSwathDataAccessHelper::convertTargetedCompound(tramlcompound, compound);
+          // Lets fix it and inform the user
+          OPENMS_LOG_WARN << "Warning: Found multiple peptide sequences for peptide label group " << label_it->first <<
+            ". This is most likely an error and to fix this, a new peptide label group will be inferred - " <<
+            "to override this decision, please use the override_group_label_check parameter." << std::endl;
+          tr.peptide_group_label = tr.group_id;
         }
-        exp.compounds.push_back(compound);
-        compound_map[compound.id] = 0;
       }
+    }
 
-      // check whether we need new proteins
-      for (Size i = 0; i < tr_it->ProteinName.size(); ++i)
+    OpenSwath::LightTransition transition;
+    transition.transition_name  = tr.transition_name;
+    transition.peptide_ref  = tr.group_id;
+    transition.library_intensity  = tr.library_intensity;
+    transition.precursor_mz  = tr.precursor;
+    transition.product_mz  = tr.product;
+    transition.precursor_im = tr.drift_time;
+    transition.fragment_charge = 0; // use zero for charge that is not set
+    if (!tr.fragment_charge.empty() && tr.fragment_charge != "NA")
+    {
+      transition.fragment_charge = tr.fragment_charge.toInt();
+    }
+
+    transition.decoy = tr.decoy;
+    transition.detecting_transition = tr.detecting_transition;
+    transition.identifying_transition = tr.identifying_transition;
+    transition.quantifying_transition = tr.quantifying_transition;
+
+    exp.transitions.push_back(std::move(transition));
+
+    // check whether we need a new compound
+    if (state.compound_ids.find(tr.group_id) == state.compound_ids.end())
+    {
+      OpenSwath::LightCompound compound;
+      if (tr.isPeptide())
       {
-        if (tr_it->isPeptide() && protein_map.find(tr_it->ProteinName[i]) == protein_map.end())
+        OpenMS::TargetedExperiment::Peptide tramlpeptide;
+        createPeptide_(tr, tramlpeptide);
+        OpenSwathDataAccessHelper::convertTargetedCompound(tramlpeptide, compound);
+      }
+      else
+      {
+        OpenMS::TargetedExperiment::Compound tramlcompound;
+        createCompound_(tr, tramlcompound);
+        OpenSwathDataAccessHelper::convertTargetedCompound(tramlcompound, compound);
+      }
+      state.compound_ids.insert(compound.id);
+      exp.compounds.push_back(std::move(compound));
+    }
+
+    // check whether we need new proteins
+    if (tr.isPeptide())
+    {
+      for (const String& protein_name : tr.ProteinName)
+      {
+        if (state.protein_ids.insert(protein_name).second)
         {
           OpenSwath::LightProtein protein;
-          protein.id = tr_it->ProteinName[i];
+          protein.id = protein_name;
           protein.sequence = "";
-          exp.proteins.push_back(protein);
-          protein_map[tr_it->ProteinName[i]] = 0;
+          exp.proteins.push_back(std::move(protein));
         }
       }
-
-      setProgress(progress++);
     }
-    endProgress();
-
-    OPENMS_POSTCONDITION(exp.transitions.size() == transition_list.size(), "Input and output list need to have equal size.")
   }
 
   void TransitionTSVFile::resolveMixedSequenceGroups_(std::vector<TransitionTSVFile::TSVTransition>& transition_list) const
@@ -1026,7 +1122,7 @@ namespace OpenMS
     retention_times.push_back(retention_time);
   }
 
-  void TransitionTSVFile::createPeptide_(std::vector<TSVTransition>::const_iterator tr_it, OpenMS::TargetedExperiment::Peptide& peptide)
+  void TransitionTSVFile::createPeptide_(const TSVTransition& tr, OpenMS::TargetedExperiment::Peptide& peptide)
   {
     // the following attributes will be stored as meta values (userParam):
     //  - full_peptide_name (full unimod peptide name)
@@ -1038,41 +1134,41 @@ namespace OpenMS
     // - id
     // - sequence
 
-    peptide.id = tr_it->group_id;
-    peptide.sequence = tr_it->PeptideSequence;
+    peptide.id = tr.group_id;
+    peptide.sequence = tr.PeptideSequence;
 
     // per peptide user params
-    peptide.setMetaValue("full_peptide_name", tr_it->FullPeptideName);
-    if (!tr_it->label_type.empty())
+    peptide.setMetaValue("full_peptide_name", tr.FullPeptideName);
+    if (!tr.label_type.empty())
     {
-      peptide.setMetaValue("LabelType", tr_it->label_type);
+      peptide.setMetaValue("LabelType", tr.label_type);
     }
-    if (!tr_it->GeneName.empty())
+    if (!tr.GeneName.empty())
     {
-      peptide.setMetaValue("GeneName", tr_it->GeneName);
+      peptide.setMetaValue("GeneName", tr.GeneName);
     }
-    if (!tr_it->SumFormula.empty())
+    if (!tr.SumFormula.empty())
     {
-      peptide.setMetaValue("SumFormula", tr_it->SumFormula);
+      peptide.setMetaValue("SumFormula", tr.SumFormula);
     }
 
     // per peptide CV terms
-    peptide.setPeptideGroupLabel(tr_it->peptide_group_label);
-    if (!tr_it->precursor_charge.empty() && tr_it->precursor_charge != "NA")
+    peptide.setPeptideGroupLabel(tr.peptide_group_label);
+    if (!tr.precursor_charge.empty() && tr.precursor_charge != "NA")
     {
-      peptide.setChargeState(tr_it->precursor_charge.toInt());
+      peptide.setChargeState(tr.precursor_charge.toInt());
     }
 
     // add retention time for the peptide
     std::vector<TargetedExperiment::RetentionTime> retention_times;
-    OpenMS::DataValue rt_value(tr_it->rt_calibrated);
+    OpenMS::DataValue rt_value(tr.rt_calibrated);
     interpretRetentionTime_(retention_times, rt_value);
     peptide.rts = retention_times;
 
     // add ion mobility drift time
-    if (tr_it->drift_time >= 0.0)
+    if (tr.drift_time >= 0.0)
     {
-      peptide.setDriftTime(tr_it->drift_time);
+      peptide.setDriftTime(tr.drift_time);
     }
 
     // Try to parse full UniMod string including modifications. If the string
@@ -1082,8 +1178,8 @@ namespace OpenMS
     // fall back to the "naked" sequence by default.
     std::vector<TargetedExperiment::Peptide::Modification> mods;
     AASequence aa_sequence;
-    String sequence = tr_it->FullPeptideName;
-    if (sequence.empty()) sequence = tr_it->PeptideSequence;
+    String sequence = tr.FullPeptideName;
+    if (sequence.empty()) sequence = tr.PeptideSequence;
     try
     {
       aa_sequence = AASequence::fromString(sequence);
@@ -1092,19 +1188,19 @@ namespace OpenMS
       if (force_invalid_mods_)
       {
         // fallback: parse the "naked" peptide sequence which should always work
-        OPENMS_LOG_DEBUG << "Invalid sequence when parsing '" << tr_it->FullPeptideName << "'" << std::endl;
-        aa_sequence = AASequence::fromString(tr_it->PeptideSequence);
+        OPENMS_LOG_DEBUG << "Invalid sequence when parsing '" << tr.FullPeptideName << "'" << std::endl;
+        aa_sequence = AASequence::fromString(tr.PeptideSequence);
       }
       else
       {
-        OPENMS_LOG_DEBUG << "Invalid sequence when parsing '" << tr_it->FullPeptideName << "'" << std::endl;
+        OPENMS_LOG_DEBUG << "Invalid sequence when parsing '" << tr.FullPeptideName << "'" << std::endl;
         std::cerr << "Error while reading file (use 'force_invalid_mods' parameter to override): " << e.what() << std::endl;
         throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "Invalid input, cannot parse: " + tr_it->FullPeptideName);
+            "Invalid input, cannot parse: " + tr.FullPeptideName);
       }
     }
 
-    peptide.protein_refs = tr_it->ProteinName;
+    peptide.protein_refs = tr.ProteinName;
 
     // check if the naked peptide sequence is equal to the unmodified AASequence
     if (peptide.sequence != aa_sequence.toUnmodifiedString())
@@ -1152,7 +1248,7 @@ namespace OpenMS
                           + aa_sequence.toUnmodifiedString() + " != " + peptide.sequence).c_str())
   }
 
-  void TransitionTSVFile::createCompound_(std::vector<TSVTransition>::const_iterator tr_it, OpenMS::TargetedExperiment::Compound& compound)
+  void TransitionTSVFile::createCompound_(const TSVTransition& tr, OpenMS::TargetedExperiment::Compound& compound)
   {
     // the following attributes will be stored as meta values (userParam):
     //  - CompoundName (name of the compound)
@@ -1165,33 +1261,33 @@ namespace OpenMS
     // - SMILES
     // - id
 
-    compound.id = tr_it->group_id;
+    compound.id = tr.group_id;
 
-    compound.molecular_formula = tr_it->SumFormula;
-    compound.smiles_string = tr_it->SMILES;
-    compound.setMetaValue("CompoundName", tr_it->CompoundName);
-    if (!tr_it->Adducts.empty()) compound.setMetaValue("Adducts", tr_it->Adducts);
+    compound.molecular_formula = tr.SumFormula;
+    compound.smiles_string = tr.SMILES;
+    compound.setMetaValue("CompoundName", tr.CompoundName);
+    if (!tr.Adducts.empty()) compound.setMetaValue("Adducts", tr.Adducts);
 
     // does this apply to compounds as well?
-    if (!tr_it->label_type.empty())
+    if (!tr.label_type.empty())
     {
-      compound.setMetaValue("LabelType", tr_it->label_type);
+      compound.setMetaValue("LabelType", tr.label_type);
     }
 
     // add ion mobility drift time
-    if (tr_it->drift_time >= 0.0)
+    if (tr.drift_time >= 0.0)
     {
-      compound.setDriftTime(tr_it->drift_time);
+      compound.setDriftTime(tr.drift_time);
     }
 
-    if (!tr_it->precursor_charge.empty() && tr_it->precursor_charge != "NA")
+    if (!tr.precursor_charge.empty() && tr.precursor_charge != "NA")
     {
-      compound.setChargeState(tr_it->precursor_charge.toInt());
+      compound.setChargeState(tr.precursor_charge.toInt());
     }
 
     // add retention time for the compound
     std::vector<TargetedExperiment::RetentionTime> retention_times;
-    OpenMS::DataValue rt_value(tr_it->rt_calibrated);
+    OpenMS::DataValue rt_value(tr.rt_calibrated);
     interpretRetentionTime_(retention_times, rt_value);
     compound.rts = retention_times;
   }
@@ -1499,9 +1595,10 @@ namespace OpenMS
 
   void TransitionTSVFile::convertTSVToTargetedExperiment(const char* filename, FileTypes::Type filetype, OpenSwath::LightTargetedExperiment& targeted_exp)
   {
-    std::vector<TSVTransition> transition_list;
-    readUnstructuredTSVInput_(filename, filetype, transition_list);
-    TSVToTargetedExperiment_(transition_list, targeted_exp);
+    // convert transitions as they are read, without an intermediate list
+    LightConversionState_ state;
+    readUnstructuredTSVInput_(filename, filetype,
+                              [&](TSVTransition& tr) { addToLightTargetedExperiment_(tr, targeted_exp, state); });
   }
 
   void TransitionTSVFile::validateTargetedExperiment(const OpenMS::TargetedExperiment& targeted_exp)
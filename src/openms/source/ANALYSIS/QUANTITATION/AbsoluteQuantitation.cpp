@@ -66,6 +66,7 @@
 #include <numeric>
 #include <boost/math/special_functions/erf.hpp>
 #include <algorithm>
+#include <exception>
 
 namespace OpenMS
 {
@@ -224,30 +225,31 @@ namespace OpenMS
     // reset biases
     biases.clear();
 
+    // set up the (inverted) calibration once for all points (as done by applyCalibration for a single point)
+    TransformationModel::DataPoints no_data;
+    TransformationDescription calibration(no_data);
+    calibration.fitModel(transformation_model, transformation_model_params);
+    calibration.invert();
+
     // extract out the calibration points
     std::vector<double> concentration_ratios, feature_amounts_ratios;
     TransformationModel::DataPoints data;
     TransformationModel::DataPoint point;
     for (size_t i = 0; i < component_concentrations.size(); ++i)
     {
+      // extract out the feature amount ratios
+      double feature_amount_ratio = calculateRatio(component_concentrations[i].feature,
+        component_concentrations[i].IS_feature,
+        feature_name);
+      feature_amounts_ratios.push_back(feature_amount_ratio);
 
       // calculate the actual and calculated concentration ratios
-      double calculated_concentration_ratio = applyCalibration(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name,
-        transformation_model,
-        transformation_model_params);
+      double calculated_concentration_ratio = std::max(calibration.apply(feature_amount_ratio), 0.0);
 
       double actual_concentration_ratio = component_concentrations[i].actual_concentration/
         component_concentrations[i].IS_actual_concentration / component_concentrations[i].dilution_factor;
       concentration_ratios.push_back(component_concentrations[i].actual_concentration);
 
-      // extract out the feature amount ratios
-      double feature_amount_ratio = calculateRatio(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name);
-      feature_amounts_ratios.push_back(feature_amount_ratio);
-
       // calculate the bias
       double bias = calculateBias(actual_concentration_ratio, calculated_concentration_ratio);
       biases.push_back(bias);
@@ -622,16 +624,42 @@ namespace OpenMS
     std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>> & components_concentrations)
   {
     std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>>& cc = components_concentrations;
+    if (!quant_methods_.empty() && optimization_method_ != "iterative")
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
+    }
+
+    // collect the components with standards; each calibration curve is optimized
+    // independently of the others, so the components are processed in parallel
+    std::vector<std::pair<AbsoluteQuantitationMethod*, std::vector<AbsoluteQuantitationStandards::featureConcentration>*>> components;
     for (std::pair<const String, AbsoluteQuantitationMethod>& quant_method : quant_methods_)
     {
       const String& component_name = quant_method.first;
-      AbsoluteQuantitationMethod& component_aqm = quant_method.second;
-      if (cc.count(component_name) && optimization_method_ == "iterative")
+      auto cc_it = cc.find(component_name);
+      if (cc_it != cc.end())
       {
+        components.emplace_back(&quant_method.second, &cc_it->second);
+      }
+      else
+      {
+        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << component_name << ".";
+      }
+    }
+
+    std::vector<std::exception_ptr> errors(components.size());
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < SignedSize(components.size()); ++i)
+    {
+      try
+      {
+        AbsoluteQuantitationMethod& component_aqm = *components[i].first;
+        std::vector<AbsoluteQuantitationStandards::featureConcentration>& component_concentrations = *components[i].second;
+
         // optimize the calibration curve for the component
         Param optimized_params;
         bool optimal_calibration_found = optimizeCalibrationCurveIterative(
-          cc[component_name],
+          component_concentrations,
           component_aqm.getFeatureName(),
           component_aqm.getTransformationModel(),
           component_aqm.getTransformationModelParams(),
@@ -639,7 +667,7 @@ namespace OpenMS
 
         // order component concentrations and update the lloq and uloq
         std::vector<AbsoluteQuantitationStandards::featureConcentration>::const_iterator it;
-        it = std::min_element(cc[component_name].begin(), cc[component_name].end(), [](
+        it = std::min_element(component_concentrations.begin(), component_concentrations.end(), [](
             const AbsoluteQuantitationStandards::featureConcentration& lhs,
             const AbsoluteQuantitationStandards::featureConcentration& rhs
           )
@@ -648,7 +676,7 @@ namespace OpenMS
           }
         );
         component_aqm.setLLOQ(it->actual_concentration);
-        it = std::max_element(cc[component_name].begin(), cc[component_name].end(), [](
+        it = std::max_element(component_concentrations.begin(), component_concentrations.end(), [](
             const AbsoluteQuantitationStandards::featureConcentration& lhs,
             const AbsoluteQuantitationStandards::featureConcentration& rhs
           )
@@ -664,7 +692,7 @@ namespace OpenMS
           std::vector<double> biases;
           double correlation_coefficient = 0.0;
           calculateBiasAndR(
-            cc[component_name],
+            component_concentrations,
             component_aqm.getFeatureName(),
             component_aqm.getTransformationModel(),
             optimized_params,
@@ -674,7 +702,7 @@ namespace OpenMS
           // record the updated information
           component_aqm.setCorrelationCoefficient(correlation_coefficient);
           component_aqm.setTransformationModelParams(optimized_params);
-          component_aqm.setNPoints(cc[component_name].size());
+          component_aqm.setNPoints(component_concentrations.size());
         }
         else 
         {
@@ -684,16 +712,15 @@ namespace OpenMS
           component_aqm.setULOQ(0.0);
         }
       }
-      else if (optimization_method_ != "iterative")
-      {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
-      }
-      else
+      catch (...)
       {
-        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << component_name << ".";
+        errors[i] = std::current_exception();
       }
     }
+    for (const auto& error : errors)
+    {
+      if (error) std::rethrow_exception(error);
+    }
   }
 
   void AbsoluteQuantitation::optimizeSingleCalibrationCurve(
@@ -43,6 +43,9 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
+#include <cmath>
+#include <limits>
+
 // #define ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 // #undef ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 
@@ -527,8 +530,14 @@ namespace OpenMS
 
     Size number_of_channels = quant_method_->getNumberOfChannels();
 
-    PeakMap::ConstIterator it_last_MS2 = ms_exp_data.end(); // remember last MS2 spec, to get precursor in MS1 (also if quant is in MS3)
-    bool ms3 = false;
+    // Pass 1 (serial): select the quantifiable scans and remember the MS1 scans around each of them,
+    // since this depends on walking the experiment in order.
+    struct QuantScan_
+    {
+      PeakMap::ConstIterator scan;
+      PuritySate_ state;
+    };
+    std::vector<QuantScan_> quant_scans;
     for (PeakMap::ConstIterator it = ms_exp_data.begin(); it != ms_exp_data.end(); ++it)
     {
       // remember the last MS1 spectra as we assume it to be the precursor spectrum
@@ -536,8 +545,6 @@ namespace OpenMS
       {
         // remember potential precursor and continue
         pState.precursorScan = it;
-        // reset last MS2 -- we expect to see a new one soon and the old one should not be used for the following MS3 (if any)
-        it_last_MS2 = ms_exp_data.end();
         continue;
       }
 
@@ -558,12 +565,87 @@ namespace OpenMS
         OPENMS_LOG_DEBUG << "Skip spectrum " << it->getNativeID() << ": Precursor doesn't fulfill all constraints." << std::endl;
         continue;
       }
+      quant_scans.push_back(QuantScan_{it, pState});
+    }
+
+    // Pass 2 (parallel): precursor purity and reporter ion search are independent per scan.
+    // Per channel we keep the intensity and the m/z delta of the closest signal (NaN if none).
+    const Size n_scans = quant_scans.size();
+    std::vector<double> purities(n_scans, -1.0);
+    std::vector<double> channel_intensities(n_scans * number_of_channels, 0.0);
+    std::vector<double> channel_deltas(n_scans * number_of_channels, std::numeric_limits<double>::quiet_NaN());
+    std::vector<char> channel_not_unique(n_scans * number_of_channels, 0);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)n_scans; ++scan_idx)
+    {
+      const QuantScan_& qs = quant_scans[scan_idx];
+      const PeakMap::ConstIterator it = qs.scan;
 
       // check precursor purity if we have a valid precursor ..
-      double precursor_purity = -1.0;
-      if (pState.precursorScan != ms_exp_data.end())
+      if (qs.state.precursorScan != ms_exp_data.end())
+      {
+        purities[scan_idx] = computePrecursorPurity_(it, qs.state);
+        // scans below the purity threshold are dropped during merging
+        if (purities[scan_idx] < min_precursor_purity_) continue;
+      }
+
+      Size channel_idx = scan_idx * number_of_channels;
+      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
+            cl_it != quant_method_->getChannelInformation().end();
+            ++cl_it, ++channel_idx)
+      {
+        // as every evaluation requires time, we cache the MZEnd iterator
+        const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
+
+        // search for the non-zero signal closest to theoretical position
+        // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
+        int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
+        PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
+        for (PeakMap::SpectrumType::ConstIterator mz_it = it->MZBegin(cl_it->center - qc_dist_mz);
+              mz_it != mz_end;
+              ++mz_it)
+        {
+          if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
+          double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
+          if (dist_mz < reporter_mass_shift_) ++peak_count;
+          if (idx_nearest == mz_end // first peak
+              || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
+          {
+            idx_nearest = mz_it;
+          }
+        }
+        double intensity = 0;
+        if (idx_nearest != mz_end)
+        {
+          double mz_delta = cl_it->center - idx_nearest->getMZ();
+          channel_deltas[channel_idx] = mz_delta;
+          channel_not_unique[channel_idx] = (peak_count > 1);
+          // pass user threshold
+          if (std::fabs(mz_delta) < reporter_mass_shift_)
+          {
+            intensity = idx_nearest->getIntensity();
+          }
+        }
+
+        // discard contribution of this channel as it is below the required intensity threshold
+        if (intensity < min_reporter_intensity_)
+        {
+          intensity = 0;
+        }
+        channel_intensities[channel_idx] = intensity;
+      } // ! channel_iterator
+    }
+
+    // Pass 3 (serial): assemble the features in scan order
+    PeakMap::ConstIterator it_last_MS2 = ms_exp_data.end(); // remember last MS2 spec, to get precursor in MS1 (also if quant is in MS3)
+    bool ms3 = false;
+    for (Size scan_idx = 0; scan_idx < n_scans; ++scan_idx)
+    {
+      const PeakMap::ConstIterator it = quant_scans[scan_idx].scan;
+      const double precursor_purity = purities[scan_idx];
+
+      if (quant_scans[scan_idx].state.precursorScan != ms_exp_data.end())
       {
-        precursor_purity = computePrecursorPurity_(it, pState);
         // check if purity is high enough
         if (precursor_purity < min_precursor_purity_)
         {
@@ -610,52 +692,20 @@ namespace OpenMS
       UInt64 map_index = 0;
       Peak2D::IntensityType overall_intensity = 0;
 
+      Size channel_idx = scan_idx * number_of_channels;
       for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
             cl_it != quant_method_->getChannelInformation().end();
-            ++cl_it)
+            ++cl_it, ++channel_idx)
       {
         // set mz-position of channel
         channel_value.setMZ(cl_it->center);
-        // reset intensity
-        channel_value.setIntensity(0);
+        channel_value.setIntensity(channel_intensities[channel_idx]);
 
-        // as every evaluation requires time, we cache the MZEnd iterator
-        const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
-
-        // search for the non-zero signal closest to theoretical position
-        // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
-        int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
-        PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
-        for (PeakMap::SpectrumType::ConstIterator mz_it = it->MZBegin(cl_it->center - qc_dist_mz);
-              mz_it != mz_end;
-              ++mz_it)
+        if (!std::isnan(channel_deltas[channel_idx]))
         {
-          if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
-          double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
-          if (dist_mz < reporter_mass_shift_) ++peak_count;
-          if (idx_nearest == mz_end // first peak
-              || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
-          {
-            idx_nearest = mz_it;
-          }
-        }
-        if (idx_nearest != mz_end)
-        {
-          double mz_delta = cl_it->center - idx_nearest->getMZ();
           // stats: we don't care what shift the user specified
-          channel_mz_delta[cl_it->name].mz_deltas.push_back(mz_delta);
-          if (peak_count > 1) ++channel_mz_delta[cl_it->name].signal_not_unique;
-          // pass user threshold
-          if (std::fabs(mz_delta) < reporter_mass_shift_)
-          {
-            channel_value.setIntensity(idx_nearest->getIntensity());
-          }
-        }
-
-        // discard contribution of this channel as it is below the required intensity threshold
-        if (channel_value.getIntensity() < min_reporter_intensity_)
-        {
-          channel_value.setIntensity(0);
+          channel_mz_delta[cl_it->name].mz_deltas.push_back(channel_deltas[channel_idx]);
+          if (channel_not_unique[channel_idx]) ++channel_mz_delta[cl_it->name].signal_not_unique;
         }
 
         overall_intensity += channel_value.getIntensity();
@@ -698,7 +748,7 @@ namespace OpenMS
 
       // the tandem-scan in the order they appear in the experiment
       ++element_index;
-    } // ! Experiment iterator
+    } // ! quantified scans
 
     // print stats about m/z calibration / presence of signal
     OPENMS_LOG_INFO << "Calibration stats: Median distance of observed reporter ions m/z to expected position (up to " << qc_dist_mz << " Th):\n";
@@ -91,6 +91,9 @@ namespace OpenMS
     Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
     Matrix<double> m_x(quant_method->getNumberOfChannels(), 1);
 
+    const ChannelIdMap_ channel_ids_in = getChannelIds_(consensus_map_in);
+    const ChannelIdMap_ channel_ids_out = getChannelIds_(consensus_map_out);
+
     // correct all consensus elements
     for (ConsensusMap::size_type i = 0; i < consensus_map_out.size(); ++i)
     {
@@ -101,7 +104,7 @@ namespace OpenMS
       consensus_map_out[i].clear();
 
       // fill b vector
-      fillInputVector_(b, m_b, consensus_map_in[i], consensus_map_in);
+      fillInputVector_(b, m_b, consensus_map_in[i], channel_ids_in);
 
       //solve
       Eigen::MatrixXd e_mx = ludecomp.solve(b);
@@ -112,7 +115,7 @@ namespace OpenMS
       solveNNLS_(correction_matrix, m_b, m_x);
 
       // update the output consensus map with the corrected intensities
-      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x);
+      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, channel_ids_out, i, m_x);
 
       // check consistency
       computeStats_(m_x, e_mx, cf_intensity, quant_method, stats);    
@@ -121,16 +124,30 @@ namespace OpenMS
     return stats;
   }
 
+  IsobaricIsotopeCorrector::ChannelIdMap_
+  IsobaricIsotopeCorrector::getChannelIds_(const ConsensusMap& cm)
+  {
+    ChannelIdMap_ channel_ids;
+    for (const auto& header : cm.getColumnHeaders())
+    {
+      if (header.second.metaValueExists("channel_id"))
+      {
+        channel_ids[header.first] = Int(header.second.getMetaValue("channel_id"));
+      }
+    }
+    return channel_ids;
+  }
+
   void
   IsobaricIsotopeCorrector::fillInputVector_(Eigen::VectorXd& b,
-                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ConsensusMap& cm)
+                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ChannelIdMap_& channel_ids)
   {
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = cf.getFeatures().begin();
          it_elements != cf.getFeatures().end();
          ++it_elements)
     {
       //find channel_id of current element
-      Int index = Int(cm.getColumnHeaders().find(it_elements->getMapIndex())->second.getMetaValue("channel_id"));
+      Int index = channel_ids.at(it_elements->getMapIndex());
 #ifdef ISOBARIC_QUANT_DEBUG
       std::cout << "  map_index " << it_elements->getMapIndex() << "-> id " << index << " with intensity " << it_elements->getIntensity() << "\n" << std::endl;
 #endif
@@ -194,7 +211,7 @@ namespace OpenMS
   float
   IsobaricIsotopeCorrector::updateOutpuMap_(
     const ConsensusMap& consensus_map_in, ConsensusMap& consensus_map_out,
-    ConsensusMap::size_type current_cf, const Matrix<double>& m_x)
+    const ChannelIdMap_& channel_ids_out, ConsensusMap::size_type current_cf, const Matrix<double>& m_x)
   {
     float cf_intensity(0);
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = consensus_map_in[current_cf].begin();
@@ -203,7 +220,7 @@ namespace OpenMS
     {
       FeatureHandle handle = *it_elements;
       //find channel_id of current element
-      Int index = Int(consensus_map_out.getColumnHeaders()[it_elements->getMapIndex()].getMetaValue("channel_id"));
+      Int index = channel_ids_out.at(it_elements->getMapIndex());
       handle.setIntensity(float(m_x(index, 0)));
 
       consensus_map_out[current_cf].insert(handle);
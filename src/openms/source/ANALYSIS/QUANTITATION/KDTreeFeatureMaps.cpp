@@ -35,6 +35,8 @@
 #include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureMaps.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -45,9 +47,7 @@ void KDTreeFeatureMaps::addFeature(Size mt_map_index, const BaseFeature* feature
   map_index_.push_back(mt_map_index);
   features_.push_back(feature);
   rt_.push_back(feature->getRT());
-
-  KDTreeFeatureNode mt_node(this, size() - 1);
-  kd_tree_.insert(mt_node);
+  pending_.push_back(size() - 1);
 }
 
 const BaseFeature* KDTreeFeatureMaps::feature(Size i) const
@@ -87,7 +87,7 @@ Size KDTreeFeatureMaps::size() const
 
 Size KDTreeFeatureMaps::treeSize() const
 {
-  return kd_tree_.size();
+  return kd_tree_.size() + pending_.size();
 }
 
 Size KDTreeFeatureMaps::numMaps() const
@@ -99,12 +99,20 @@ void KDTreeFeatureMaps::clear()
 {
   features_.clear();
   map_index_.clear();
+  rt_.clear();
   kd_tree_.clear();
+  pending_.clear();
 }
 
 void KDTreeFeatureMaps::optimizeTree()
 {
-  kd_tree_.optimize();
+  vector<FeatureKDTree::PointType> points(size());
+  for (Size i = 0; i < size(); ++i)
+  {
+    points[i] = {rt_[i], mz(i)};
+  }
+  kd_tree_.build(points);
+  pending_.clear();
 }
 
 void KDTreeFeatureMaps::getNeighborhood(Size index, vector<Size>& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map, double max_pairwise_log_fc) const
@@ -141,24 +149,39 @@ void KDTreeFeatureMaps::getNeighborhood(Size index, vector<Size>& result_indices
   }
 }
 
+void KDTreeFeatureMaps::getNeighborhoods(vector<vector<Size> >& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map, double max_pairwise_log_fc) const
+{
+  result_indices.assign(size(), vector<Size>());
+#pragma omp parallel for schedule(dynamic, 64)
+  for (SignedSize i = 0; i < (SignedSize)size(); ++i)
+  {
+    getNeighborhood(i, result_indices[i], rt_tol, mz_tol, mz_ppm, include_features_from_same_map, max_pairwise_log_fc);
+  }
+}
+
 void KDTreeFeatureMaps::queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, vector<Size>& result_indices, Size ignored_map_index) const
 {
   // set up tolerance window as region for the 2D tree
-  FeatureKDTree::_Region_ region;
-  region._M_low_bounds[0] = rt_low;
-  region._M_high_bounds[0] = rt_high;
-  region._M_low_bounds[1] = mz_low;
-  region._M_high_bounds[1] = mz_high;
+  FeatureKDTree::RegionType region;
+  region.first = {rt_low, mz_low};
+  region.second = {rt_high, mz_high};
 
-  // range-query tolerance window
-  vector<KDTreeFeatureNode> tmp_result;
-  kd_tree_.find_within_range(region, back_insert_iterator<vector<KDTreeFeatureNode> >(tmp_result));
+  // range-query tolerance window, plus features not yet in the tree
+  vector<Size> tmp_result;
+  kd_tree_.queryRegion(region, tmp_result);
+  for (Size i : pending_)
+  {
+    if (rt_[i] >= rt_low && rt_[i] <= rt_high && mz(i) >= mz_low && mz(i) <= mz_high)
+    {
+      tmp_result.push_back(i);
+    }
+  }
+  sort(tmp_result.begin(), tmp_result.end());
 
   // add indices to result
   result_indices.clear();
-  for (vector<KDTreeFeatureNode>::const_iterator it = tmp_result.begin(); it != tmp_result.end(); ++it)
+  for (Size found_index : tmp_result)
   {
-    Size found_index = it->getIndex();
     if (ignored_map_index == numeric_limits<Size>::max() || map_index_[found_index] != ignored_map_index)
     {
       result_indices.push_back(found_index);
@@ -247,10 +247,21 @@ namespace OpenMS
     }
 
     //////////////////////////////////////////////////////
-    // second, perform the actual peptide quantification:
+    // second, perform the actual peptide quantification
+    // (peptides are independent, so they are processed in parallel):
+    const bool best_charge_and_fraction = (param_.getValue("best_charge_and_fraction") == "true");
+    vector<PeptideQuant::value_type*> pep_quant_entries;
+    pep_quant_entries.reserve(pep_quant_.size());
     for (auto & pep_q : pep_quant_)
     {
-      if (param_.getValue("best_charge_and_fraction") == "true")
+      pep_quant_entries.push_back(&pep_q);
+    }
+    Size quant_peptides = 0;
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: quant_peptides)
+    for (SignedSize i = 0; i < SignedSize(pep_quant_entries.size()); ++i)
+    {
+      auto & pep_q = *pep_quant_entries[i];
+      if (best_charge_and_fraction)
       { // quantify according to the best charge state only:
 
         // determine which fraction and charge state yields the maximum number of abundances 
@@ -300,8 +311,9 @@ namespace OpenMS
       }
 
       // count quantified peptide
-      if (!pep_q.second.total_abundances.empty()) { stats_.quant_peptides++; }
+      if (!pep_q.second.total_abundances.empty()) { quant_peptides++; }
     }
+    stats_.quant_peptides += quant_peptides;
 
     //////////////////////////////////////////////////////
     // normalize (optional):
@@ -489,8 +501,18 @@ namespace OpenMS
       aggregate = "sum";
     }
 
+    // proteins (groups) are independent, so they are quantified in parallel:
+    vector<ProteinQuant::value_type*> prot_quant_entries;
+    prot_quant_entries.reserve(prot_quant_.size());
     for (auto& prot_q : prot_quant_)
     {
+      prot_quant_entries.push_back(&prot_q);
+    }
+    Size too_few_peptides = 0, quant_proteins = 0;
+#pragma omp parallel for schedule(dynamic, 10) reduction(+: too_few_peptides, quant_proteins)
+    for (SignedSize i = 0; i < SignedSize(prot_quant_entries.size()); ++i)
+    {
+      auto& prot_q = *prot_quant_entries[i];
       const ProteinData& pd = prot_q.second;
 
       // calculate PSM counts based on all (!) peptides of a protein (group)
@@ -510,7 +532,7 @@ namespace OpenMS
       // select which peptides of the current protein (group) are quantified
       if ((top_n > 0) && (prot_q.second.abundances.size() < top_n))
       { // not enough proteotypic peptides? skip protein (except if user chose to include the nevertheless)
-        stats_.too_few_peptides++;
+        too_few_peptides++;
         if (!include_all)
         {
           continue;
@@ -565,8 +587,8 @@ namespace OpenMS
         // if we have more than "top", reduce to the top ones
         if ((top_n > 0) && (ab.second.size() > top_n))
         {
-          // sort descending:
-          sort(ab.second.begin(), ab.second.end(), greater<double>());
+          // sort the best N descending:
+          partial_sort(ab.second.begin(), ab.second.begin() + top_n, ab.second.end(), greater<double>());
           ab.second.resize(top_n); // remove all but best N values
         }
 
@@ -601,13 +623,15 @@ namespace OpenMS
       // update statistics:
       if (prot_q.second.total_abundances.empty())
       {
-        stats_.too_few_peptides++;
+        too_few_peptides++;
       }
       else
       {
-        stats_.quant_proteins++;
+        quant_proteins++;
       }
     }
+    stats_.too_few_peptides += too_few_peptides;
+    stats_.quant_proteins += quant_proteins;
     if (method == "iBAQ")
     {
       EnzymaticDigestion digest{};
@@ -37,19 +37,38 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/DATASTRUCTURES/MatchedIterator.h>
 #include <OpenMS/DATASTRUCTURES/StringUtils.h>
+#include <OpenMS/MATH/MISC/MathFunctions.h>
 
+#include <cmath>
+#include <limits>
 
 using std::vector;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// natural logarithms of small integers (ion counts rarely exceed a few hundred)
+    struct LogTable
+    {
+      static constexpr int size = 1024;
+      double values[size];
+
+      LogTable()
+      {
+        for (int i = 0; i < size; ++i) { values[i] = i > 0 ? log(i) : 0.0; }
+      }
+    };
+  }
+
   inline double HyperScore::logfactorial_(const int x, int base)
   {
+    static const LogTable logs;
     double z(0);
     base = std::max(base, 2);
     for (int i = base; i <= x; ++i)
     {
-      z += log(i);
+      z += i < LogTable::size ? logs.values[i] : log(i);
     }
     return z;
   }
@@ -209,5 +228,84 @@ namespace OpenMS
     return hyperScore;
   }
 
-}
+  void HyperScore::computeBatch(double fragment_mass_tolerance,
+    bool fragment_mass_tolerance_unit_ppm,
+    const PeakSpectrum& exp_spectrum,
+    const std::vector<std::vector<TheoreticalSpectrumGenerator::FragmentIon> >& theo_ions,
+    std::vector<double>& scores,
+    std::vector<PSMDetail>& details)
+  {
+    scores.assign(theo_ions.size(), 0.0);
+    details.assign(theo_ions.size(), PSMDetail());
+    if (exp_spectrum.empty()) { return; }
 
+    // contiguous copies of the experimental peaks, shared by all candidates
+    const Size n_exp = exp_spectrum.size();
+    vector<double> exp_mz(n_exp), exp_int(n_exp);
+    for (Size e = 0; e != n_exp; ++e)
+    {
+      exp_mz[e] = exp_spectrum[e].getMZ();
+      exp_int[e] = exp_spectrum[e].getIntensity();
+    }
+
+    // same (single precision) tolerance handling as MatchedIterator
+    const float tolerance = fragment_mass_tolerance;
+
+    for (Size c = 0; c != theo_ions.size(); ++c)
+    {
+      const auto& ions = theo_ions[c];
+      if (ions.empty()) { continue; }
+
+      int y_ion_count = 0;
+      int b_ion_count = 0;
+      double dot_product = 0.0;
+      double abs_error = 0.0;
+
+      // for each fragment, find the closest experimental peak (as MatchedIterator does)
+      Size e = 0;
+      for (const auto& ion : ions)
+      {
+        const double theo_mz = ion.mz;
+        const double max_dist = fragment_mass_tolerance_unit_ppm ? Math::ppmToMass(tolerance, (float)theo_mz) : tolerance;
+        float diff = std::numeric_limits<float>::max();
+        do
+        {
+          const float d = fabs(theo_mz - exp_mz[e]);
+          if (diff > d) // getting better
+          {
+            diff = d;
+          }
+          else // getting worse (overshot)
+          {
+            --e;
+            break;
+          }
+          ++e;
+        } while (e != n_exp);
+        if (e == n_exp) { --e; }
+
+        if (diff <= max_dist)
+        {
+          abs_error += fragment_mass_tolerance_unit_ppm ? Math::getPPMAbs(theo_mz, exp_mz[e]) : std::fabs(theo_mz - exp_mz[e]);
+          dot_product += exp_int[e]; // unit intensity of the theoretical peak
+          if (ion.ion_type == 'y')
+          {
+            ++y_ion_count;
+          }
+          else if (ion.ion_type == 'b')
+          {
+            ++b_ion_count;
+          }
+        }
+      }
+
+      const int i_min = std::min(y_ion_count, b_ion_count);
+      const int i_max = std::max(y_ion_count, b_ion_count);
+      scores[c] = log1p(dot_product) + 2*logfactorial_(i_min) + logfactorial_(i_max, i_min + 1);
+      details[c].matched_b_ions = b_ion_count;
+      details[c].matched_y_ions = y_ion_count;
+      details[c].mean_error = (b_ion_count + y_ion_count) > 0 ? abs_error / (double)(b_ion_count + y_ion_count) : 0.0;
+    }
+  }
+
+}
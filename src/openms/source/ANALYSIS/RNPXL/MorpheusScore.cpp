@@ -116,5 +116,90 @@ namespace OpenMS
     psm.err = matches > 0 ? sum_error / static_cast<double>(matches) : 1e10;
     return psm;
   }
-}
 
+  void MorpheusScore::computeBatch(double fragment_mass_tolerance,
+                                   bool fragment_mass_tolerance_unit_ppm,
+                                   const PeakSpectrum& exp_spectrum,
+                                   const std::vector<const PeakSpectrum*>& theo_spectra,
+                                   std::vector<Result>& results)
+  {
+    results.assign(theo_spectra.size(), MorpheusScore::Result());
+
+    const Size n_e(exp_spectrum.size());
+    if (n_e == 0) { return; }
+
+    // experimental peaks and TIC are shared by all theoretical spectra
+    // (compute() also sums up every experimental intensity exactly once and in order)
+    std::vector<double> exp_mzs(n_e), exp_intensities(n_e);
+    double total_intensity(0);
+    for (Size e = 0; e != n_e; ++e)
+    {
+      exp_mzs[e] = exp_spectrum[e].getMZ();
+      exp_intensities[e] = exp_spectrum[e].getIntensity();
+      total_intensity += exp_intensities[e];
+    }
+
+    for (Size i = 0; i != theo_spectra.size(); ++i)
+    {
+      const PeakSpectrum& theo_spectrum = *theo_spectra[i];
+      const Size n_t(theo_spectrum.size());
+      if (n_t == 0) { continue; }
+
+      // count matching peaks and make sure that every theoretical peak is matched at most once
+      Size t(0), e(0), matches(0);
+      while (t < n_t && e < n_e)
+      {
+        const double theo_mz = theo_spectrum[t].getMZ();
+        const double d = exp_mzs[e] - theo_mz;
+        const double max_dist_dalton = fragment_mass_tolerance_unit_ppm ? theo_mz * fragment_mass_tolerance * 1e-6 : fragment_mass_tolerance;
+        if (fabs(d) <= max_dist_dalton)
+        {
+          ++matches;
+          ++t;
+        }
+        else if (d < 0)
+        {
+          ++e;
+        }
+        else if (d > 0)
+        {
+          ++t;
+        }
+      }
+
+      // sum up the intensity of every matched experimental peak once
+      t = 0;
+      e = 0;
+      double match_intensity(0.0);
+      double sum_error(0.0);
+      while (t < n_t && e < n_e)
+      {
+        const double theo_mz = theo_spectrum[t].getMZ();
+        const double d = exp_mzs[e] - theo_mz;
+        const double max_dist_dalton = fragment_mass_tolerance_unit_ppm ? theo_mz * fragment_mass_tolerance * 1e-6 : fragment_mass_tolerance;
+        if (fabs(d) <= max_dist_dalton)
+        {
+          match_intensity += exp_intensities[e];
+          sum_error += fabs(d);
+          ++e;
+        }
+        else if (d < 0)
+        {
+          ++e;
+        }
+        else if (d > 0)
+        {
+          ++t;
+        }
+      }
+
+      MorpheusScore::Result& psm = results[i];
+      psm.score = static_cast<double>(matches) + match_intensity / total_intensity;
+      psm.n_peaks = n_t;
+      psm.matches = matches;
+      psm.MIC = match_intensity;
+      psm.TIC = total_intensity;
+      psm.err = matches > 0 ? sum_error / static_cast<double>(matches) : 1e10;
+    }
+  }
+}
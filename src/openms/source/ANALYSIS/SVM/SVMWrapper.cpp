@@ -528,11 +528,12 @@ namespace OpenMS
           problem = computeKernelMatrix(problem, training_set_);
         }
       }
-      results.reserve(problem->l);
+      // svm_predict() only reads the model, so samples can be scored concurrently
+      results.resize(problem->l);
+#pragma omp parallel for schedule(dynamic, 64)
       for (Int i = 0; i < problem->l; i++)
       {
-        double label = svm_predict(model_, problem->x[i]);
-        results.push_back(label);
+        results[i] = svm_predict(model_, problem->x[i]);
       }
 
       if (kernel_type_ == OLIGO)
@@ -563,10 +564,11 @@ namespace OpenMS
       else if (model_ != nullptr)
       {
         struct svm_problem* prediction_problem = computeKernelMatrix(problem, training_data_);
-        for (Size i = 0; i < problem.sequences.size(); i++)
+        results.resize(problem.sequences.size());
+#pragma omp parallel for schedule(dynamic, 64)
+        for (SignedSize i = 0; i < (SignedSize)problem.sequences.size(); i++)
         {
-          double label = svm_predict(model_, prediction_problem->x[i]);
-          results.push_back(label);
+          results[i] = svm_predict(model_, prediction_problem->x[i]);
         }
 
         LibSVMEncoder::destroyProblem(prediction_problem);
@@ -1295,10 +1297,11 @@ namespace OpenMS
 
     if (model_ != nullptr)
     {
-      for (Size i = 0; i < vectors.size(); i++)
+      results.resize(vectors.size());
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize i = 0; i < (SignedSize)vectors.size(); i++)
       {
-        double label = svm_predict(model_, vectors[i]);
-        results.push_back(label);
+        results[i] = svm_predict(model_, vectors[i]);
       }
     }
   }
@@ -1339,17 +1342,19 @@ namespace OpenMS
           problem = computeKernelMatrix(problem, training_set_);
         }
       }
+      prediction_labels.resize(problem->l);
+      probabilities.resize(problem->l);
+#pragma omp parallel for schedule(dynamic, 64) firstprivate(temp_prob_estimates)
       for (int i = 0; i < problem->l; ++i)
       {
-        double temp_label = svm_predict_probability(model_, problem->x[i], &(temp_prob_estimates[0]));
-        prediction_labels.push_back(temp_label);
+        prediction_labels[i] = svm_predict_probability(model_, problem->x[i], &(temp_prob_estimates[0]));
         if (labels[0] >= 0)
         {
-          probabilities.push_back(temp_prob_estimates[0]);
+          probabilities[i] = temp_prob_estimates[0];
         }
         else
         {
-          probabilities.push_back(1 - temp_prob_estimates[0]);
+          probabilities[i] = 1 - temp_prob_estimates[0];
         }
       }
       if (kernel_type_ == OLIGO)
@@ -1587,7 +1592,6 @@ namespace OpenMS
 
   svm_problem* SVMWrapper::computeKernelMatrix(svm_problem* problem1, svm_problem* problem2)
   {
-    double temp = 0;
     svm_problem* kernel_matrix;
 
     if (problem1 == nullptr || problem2 == nullptr)
@@ -1611,11 +1615,14 @@ namespace OpenMS
 
     if (problem1 == problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+      // every (i, j) pair of the upper triangle is written exactly once (mirrored into (j, i)),
+      // so rows can be distributed over threads; dynamic scheduling balances the triangle
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
-        for (Size j = i; j < number_of_sequences; j++)
+        for (Size j = (Size)i; j < number_of_sequences; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
+          const double temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
           kernel_matrix->x[i][j + 1].index = (Int)j + 1;
           kernel_matrix->x[i][j + 1].value = temp;
           kernel_matrix->x[j][i + 1].index = (Int)i + 1;
@@ -1625,11 +1632,12 @@ namespace OpenMS
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = 0; j < (Size) problem2->l; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
+          const double temp = SVMWrapper::kernelOligo(problem1->x[i], problem2->x[j], gauss_table_);
 
           kernel_matrix->x[i][j + 1].index = (Int)j + 1;
           kernel_matrix->x[i][j + 1].value = temp;
@@ -1653,7 +1661,6 @@ namespace OpenMS
       return nullptr;
     }
 
-    double temp = 0;
     svm_problem* kernel_matrix;
 
     Size number_of_sequences = problem1.labels.size();
@@ -1673,11 +1680,14 @@ namespace OpenMS
 
     if (&problem1 == &problem2)
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+      // every (i, j) pair of the upper triangle is written exactly once (mirrored into (j, i)),
+      // so rows can be distributed over threads; dynamic scheduling balances the triangle
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
-        for (Size j = i; j < number_of_sequences; j++)
+        for (Size j = (Size)i; j < number_of_sequences; j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+          const double temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
           kernel_matrix->x[i][j + 1].index = int(j) + 1;
           kernel_matrix->x[i][j + 1].value = temp;
           kernel_matrix->x[j][i + 1].index = int(i) + 1;
@@ -1687,11 +1697,12 @@ namespace OpenMS
     }
     else
     {
-      for (Size i = 0; i < number_of_sequences; i++)
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)number_of_sequences; i++)
       {
         for (Size j = 0; j < problem2.labels.size(); j++)
         {
-          temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
+          const double temp = SVMWrapper::kernelOligo(problem1.sequences[i], problem2.sequences[j], gauss_table_);
 
           kernel_matrix->x[i][j + 1].index = int(j) + 1;
           kernel_matrix->x[i][j + 1].value = temp;
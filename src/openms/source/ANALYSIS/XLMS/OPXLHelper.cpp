@@ -53,6 +53,41 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Calls @p fill(i, out) for all i in [begin, end) in parallel and appends everything written to @p out to @p result, in the order of i.
+
+      Every thread fills its own buffer (no lock per candidate). With a static schedule the threads
+      process consecutive blocks in thread order, so concatenating the buffers reproduces the serial order.
+    */
+    template <typename FillFunction>
+    Size appendInOrder(int begin, int end, const FillFunction& fill, vector<OPXLDataStructs::XLPrecursor>& result)
+    {
+      if (begin >= end) return 0;
+#ifdef _OPENMP
+      vector<vector<OPXLDataStructs::XLPrecursor>> buffers(omp_get_max_threads());
+#else
+      vector<vector<OPXLDataStructs::XLPrecursor>> buffers(1);
+#endif
+#pragma omp parallel for schedule(static)
+      for (int i = begin; i < end; ++i)
+      {
+#ifdef _OPENMP
+        fill(i, buffers[omp_get_thread_num()]);
+#else
+        fill(i, buffers[0]);
+#endif
+      }
+      Size added = 0;
+      for (vector<OPXLDataStructs::XLPrecursor>& buffer : buffers)
+      {
+        added += buffer.size();
+        result.insert(result.end(), make_move_iterator(buffer.begin()), make_move_iterator(buffer.end()));
+      }
+      return added;
+    }
+  }
   vector<OPXLDataStructs::XLPrecursor> OPXLHelper::enumerateCrossLinksAndMasses(const vector<OPXLDataStructs::AASeqWithMass>& peptides, double cross_link_mass, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const vector< double >& spectrum_precursors, vector< int >& precursor_correction_positions, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm)
   {
     // initialize empty vector for the results
@@ -77,6 +112,18 @@ namespace OpenMS
 
     vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_alpha = peptides.cbegin();
 
+    // residues the two ends of the linker can attach to (only single residues are relevant for loop-links)
+    vector<bool> is_residue1(256, false);
+    vector<bool> is_residue2(256, false);
+    for (const String& res : cross_link_residue1)
+    {
+      if (res.size() == 1) is_residue1[static_cast<unsigned char>(res[0])] = true;
+    }
+    for (const String& res : cross_link_residue2)
+    {
+      if (res.size() == 1) is_residue2[static_cast<unsigned char>(res[0])] = true;
+    }
+
     for (Size pm = 0; pm < spectrum_precursors.size(); ++pm)
     {
       double precursor_mass = spectrum_precursors[pm];
@@ -102,52 +149,35 @@ namespace OpenMS
       int first_index = first_loop - peptides.cbegin();
       int last_index = last_loop - peptides.cbegin();
 
-#pragma omp parallel for
-      for (int p1 = first_index; p1 < last_index; ++p1)
+      Size added = appendInOrder(first_index, last_index, [&](int p1, vector<OPXLDataStructs::XLPrecursor>& out)
       {
         const String& seq_first = peptides[p1].unmodified_seq;
         // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
         bool first_res = false; // is there a residue the first side of the linker can attach to?
         bool second_res = false; // is there a residue the second side of the linker can attach to?
-        for (Size k = 0; k < seq_first.size()-1; ++k)
+        for (Size k = 0; k + 1 < seq_first.size(); ++k)
         {
-         for (Size i = 0; i < cross_link_residue1.size(); ++i)
-         {
-           if (cross_link_residue1[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue1[i])
-           {
-             first_res = true;
-           }
-         }
-         for (Size i = 0; i < cross_link_residue2.size(); ++i)
-         {
-           if (cross_link_residue2[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue2[i])
-           {
-             second_res = true;
-           }
-         }
+          first_res = first_res || is_residue1[static_cast<unsigned char>(seq_first[k])];
+          second_res = second_res || is_residue2[static_cast<unsigned char>(seq_first[k])];
         }
 
         // If both sides of a cross-linker can link to this peptide, generate the loop-link
         if (first_res && second_res)
         {
-         // Monoisotopic weight of the peptide + cross-linker
-         double cross_linked_peptide_mass = peptides[p1].peptide_mass + cross_link_mass;
-
-         // also only one peptide
-         OPXLDataStructs::XLPrecursor precursor;
-         precursor.precursor_mass = cross_linked_peptide_mass;
-         precursor.alpha_index = p1;
-         precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
-         precursor.alpha_seq = seq_first;
-         precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          // Monoisotopic weight of the peptide + cross-linker
+          double cross_linked_peptide_mass = peptides[p1].peptide_mass + cross_link_mass;
+
+          // also only one peptide
+          OPXLDataStructs::XLPrecursor precursor;
+          precursor.precursor_mass = cross_linked_peptide_mass;
+          precursor.alpha_index = p1;
+          precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
+          precursor.alpha_seq = seq_first;
+          precursor.beta_seq = "";
+          out.push_back(precursor);
         }
-      } // end of parallel loop over loop-link candidates
+      }, mass_to_candidates); // end of parallel loop over loop-link candidates
+      precursor_correction_positions.insert(precursor_correction_positions.end(), added, pm);
 
       // ################################ Enumerate Mono-Links #################
       for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
@@ -165,8 +195,7 @@ namespace OpenMS
         first_index = first_mono - peptides.cbegin();
         last_index = last_mono - peptides.cbegin();
 
-#pragma omp parallel for
-        for (int p1 = first_index; p1 < last_index; ++p1)
+        added = appendInOrder(first_index, last_index, [&](int p1, vector<OPXLDataStructs::XLPrecursor>& out)
         {
           // Monoisotopic weight of the peptide + cross-linker
           double cross_linked_peptide_mass = peptides[p1].peptide_mass + mono_link_mass;
@@ -178,13 +207,9 @@ namespace OpenMS
           precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
           precursor.alpha_seq = peptides[p1].unmodified_seq;
           precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
-        } // end of loop over candidates for a specific mono-link mass
+          out.push_back(precursor);
+        }, mass_to_candidates); // end of loop over candidates for a specific mono-link mass
+        precursor_correction_positions.insert(precursor_correction_positions.end(), added, pm);
       } // end of loop over mono-link masses
 
       // ################################ Enumerate Cross-Links #################
@@ -195,8 +220,7 @@ namespace OpenMS
       last_alpha = upper_bound(last_alpha, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
       int last_alpha_index = last_alpha - peptides.cbegin();
 
-#pragma omp parallel for
-      for (int p1 = 0; p1 < last_alpha_index; ++p1)
+      added = appendInOrder(0, last_alpha_index, [&](int p1, vector<OPXLDataStructs::XLPrecursor>& out)
       {
         // Constrain search for beta
         double min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
@@ -204,12 +228,7 @@ namespace OpenMS
 
         // the last_alpha upper bound is also a conservative upper bound here
         vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_beta = lower_bound(peptides.cbegin()+p1, last_alpha, min_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_beta = upper_bound(peptides.cbegin()+p1, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-
-        if (first_beta == last_beta)
-        {
-          continue;
-        }
+        vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_beta = upper_bound(first_beta, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
 
         Size first_beta_index = first_beta - peptides.begin();
         Size last_beta_index = last_beta - peptides.begin();
@@ -226,14 +245,10 @@ namespace OpenMS
           precursor.beta_index = p2;
           precursor.alpha_seq = peptides[p1].unmodified_seq;
           precursor.beta_seq = peptides[p2].unmodified_seq;
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          out.push_back(precursor);
         } // end of loop over betas
-      } // end of parallel loop over alphas
+      }, mass_to_candidates); // end of parallel loop over alphas
+      precursor_correction_positions.insert(precursor_correction_positions.end(), added, pm);
     } // end of loop over precursor masses
     return mass_to_candidates;
   }
@@ -152,15 +152,11 @@ using namespace OpenMS;
         // check for the unique ID criterion
         if (arg_uniquex_)
         {
-          auto uid_it = std::find(this->unique_ids_.begin(), this->unique_ids_.end(), id);
-          if (uid_it != this->unique_ids_.end())
+          auto uid_it = this->unique_id_scores_.find(id);
+          if (uid_it != this->unique_id_scores_.end() && uid_it->second != ph.getScore())
           {
-            int index = std::distance(this->unique_ids_.begin(), uid_it);
-            if (this->unique_id_scores_[index] != ph.getScore())
-            {
-              // this is not the highest scoring ID for this candidate
-              continue;
-            }
+            // this is not the highest scoring ID for this candidate
+            continue;
           }
         }
         num_flagged++;
@@ -185,14 +181,20 @@ using namespace OpenMS;
 
     // Generate Histograms of the scores for each class
     // Use cumulative histograms to count the number of scores above consecutive thresholds
+    // The classes are independent, so their histograms are filled in parallel
     std::map< String, Math::Histogram<> >  cum_histograms;
+    std::vector< std::pair<const std::vector<double>*, Math::Histogram<>*> > class_histograms;
     for (const auto &class_scores: scores)
     {
-      std::vector< double > current_scores = class_scores.second;
-
-      Math::Histogram<> histogram(this->min_score_, this->max_score_, arg_binsize_);
-      Math::Histogram<>::getCumulativeHistogram(current_scores.begin(), current_scores.end(), true, true, histogram);
-      cum_histograms[class_scores.first] = histogram;
+      Math::Histogram<>& histogram = cum_histograms[class_scores.first];
+      histogram.reset(this->min_score_, this->max_score_, arg_binsize_);
+      class_histograms.emplace_back(&class_scores.second, &histogram);
+    }
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)class_histograms.size(); ++i)
+    {
+      const std::vector< double >& current_scores = *class_histograms[i].first;
+      Math::Histogram<>::getCumulativeHistogram(current_scores.begin(), current_scores.end(), true, true, *class_histograms[i].second);
     }
 
     std::cout << "Calculating Score Distributions..." << std::endl;
@@ -472,25 +474,30 @@ using namespace OpenMS;
     }
   }
 
-  void XFDRAlgorithm::fdr_xprophet_(std::map< String, Math::Histogram<> > & cum_histograms,
+  void XFDRAlgorithm::fdr_xprophet_(const std::map< String, Math::Histogram<> > & cum_histograms,
                     const String  & targetclass, const String & decoyclass, const String & fulldecoyclass,
                     std::vector< double > & fdr, bool mono) const
   {
-    // Determine whether targetclass, decoyclass, and fulldecoyclass are present in the histogram map
-    bool targetclass_present = cum_histograms.find(targetclass) != cum_histograms.end();
-    bool decoyclass_present = cum_histograms.find(decoyclass) != cum_histograms.end();
-    bool fulldecoyclass_present = cum_histograms.find(fulldecoyclass) != cum_histograms.end();
+    // Look up the histograms of targetclass, decoyclass, and fulldecoyclass once (nullptr if not present)
+    auto findHistogram = [&cum_histograms](const String& cls) -> const Math::Histogram<>*
+    {
+      auto it = cum_histograms.find(cls);
+      return it != cum_histograms.end() ? &it->second : nullptr;
+    };
+    const Math::Histogram<>* target_histogram = findHistogram(targetclass);
+    const Math::Histogram<>* decoy_histogram = findHistogram(decoyclass);
+    const Math::Histogram<>* fulldecoy_histogram = findHistogram(fulldecoyclass);
 
     for (double current_score = this->min_score_ +  (arg_binsize_/2);
         current_score <= this->max_score_ - (arg_binsize_/2);
         current_score += arg_binsize_)
     {
-      double estimated_n_decoys = decoyclass_present ? cum_histograms[decoyclass].binValue(current_score) : 0;
+      double estimated_n_decoys = decoy_histogram ? decoy_histogram->binValue(current_score) : 0;
       if ( ! mono)
       {
-        estimated_n_decoys -= 2 * ( fulldecoyclass_present ? cum_histograms[fulldecoyclass].binValue(current_score) : 0);
+        estimated_n_decoys -= 2 * ( fulldecoy_histogram ? fulldecoy_histogram->binValue(current_score) : 0);
       }
-      double n_targets = targetclass_present ? cum_histograms[targetclass].binValue(current_score) : 0;
+      double n_targets = target_histogram ? target_histogram->binValue(current_score) : 0;
       fdr.push_back(n_targets > 0 ? estimated_n_decoys / (n_targets) : 0);
     }
   }
@@ -498,19 +505,15 @@ using namespace OpenMS;
   void XFDRAlgorithm::calc_qfdr_(const std::vector< double > &fdr, std::vector< double > &qfdr)
   {
     qfdr.resize(fdr.size());
-    for (Int i = fdr.size() - 1; i >= 0; --i)
+    // the qFDR is the smallest FDR up to (and including) the current position, i.e. a running minimum
+    double smallest_fdr = std::numeric_limits<double>::max();
+    for (Size i = 0; i < fdr.size(); ++i)
     {
-      double current_fdr = fdr[i];
-      double smallest_fdr = current_fdr;
-      for (Int j = i; j >= 0; j--)
+      if (fdr[i] < smallest_fdr)
       {
-        double fdr_to_check = fdr[j];
-        if (fdr_to_check < smallest_fdr)
-        {
-          smallest_fdr = fdr_to_check;
-        }
+        smallest_fdr = fdr[i];
       }
-      qfdr[i] = smallest_fdr < current_fdr ? smallest_fdr : current_fdr;
+      qfdr[i] = smallest_fdr;
     }
   }
 
@@ -521,20 +524,11 @@ using namespace OpenMS;
       for (PeptideHit& ph : pep_id.getHits())
       {
         String id = ph.getMetaValue("OpenPepXL:id");
-        auto uid_it = std::find(this->unique_ids_.begin(), this->unique_ids_.end(), id);
+        auto uid_it = this->unique_id_scores_.emplace(id, ph.getScore());
         // if an ID for this candidate already exists, check if the new score is higher than the last
-        if (uid_it != this->unique_ids_.end())
-        {
-          int index = std::distance(this->unique_ids_.begin(), uid_it);
-          if (this->unique_id_scores_[index] < ph.getScore())
-          {
-            this->unique_id_scores_[index] = ph.getScore();
-          }
-        }
-        else
+        if (!uid_it.second && uid_it.first->second < ph.getScore())
         {
-          this->unique_ids_.push_back(id);
-          this->unique_id_scores_.push_back(ph.getScore());
+          uid_it.first->second = ph.getScore();
         }
       }
     }
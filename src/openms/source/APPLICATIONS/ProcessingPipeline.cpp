@@ -0,0 +1,213 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/APPLICATIONS/ProcessingPipeline.h>
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <exception>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// moves the consumed data into an experiment (avoids the copy of MSDataStoringConsumer::getData())
+    class MovingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+    public:
+      explicit MovingConsumer(PeakMap& exp) :
+        exp_(exp)
+      {
+      }
+
+      void setExperimentalSettings(const ExperimentalSettings& settings) override
+      {
+        static_cast<ExperimentalSettings&>(exp_) = settings;
+      }
+
+      void setExpectedSize(Size s_size, Size c_size) override
+      {
+        exp_.reserveSpaceSpectra(s_size);
+        exp_.reserveSpaceChromatograms(c_size);
+      }
+
+      void consumeSpectrum(SpectrumType& s) override
+      {
+        exp_.addSpectrum(std::move(s));
+      }
+
+      void consumeChromatogram(ChromatogramType& c) override
+      {
+        exp_.addChromatogram(std::move(c));
+      }
+
+    private:
+      PeakMap& exp_;
+    };
+  }
+
+  ProcessingPipeline& ProcessingPipeline::addStep(const String& name, DataStep step)
+  {
+    steps_.push_back({name, std::move(step), nullptr});
+    return *this;
+  }
+
+  ProcessingPipeline& ProcessingPipeline::addSpectrumStep(const String& name, SpectrumStep step)
+  {
+    steps_.push_back({name, nullptr, std::move(step)});
+    return *this;
+  }
+
+  Size ProcessingPipeline::size() const
+  {
+    return steps_.size();
+  }
+
+  std::vector<String> ProcessingPipeline::getStepNames() const
+  {
+    std::vector<String> names;
+    for (const Step_& step : steps_)
+    {
+      names.push_back(step.name);
+    }
+    return names;
+  }
+
+  void ProcessingPipeline::run(Data& data) const
+  {
+    runFrom_(0, data);
+  }
+
+  void ProcessingPipeline::run(const String& mzml_file, Data& data) const
+  {
+    Size last = endOfSpectrumSteps_(0);
+    data.experiment.clear(true);
+    {
+      Profiler::Scope scope(last == 0 ? String("load") : String("load+") + fusedName_(0, last));
+      MovingConsumer store(data.experiment);
+      if (last == 0)
+      {
+        MzMLFile().transform(mzml_file, &store);
+      }
+      else
+      {
+        MSDataParallelTransformingConsumer transformer(&store);
+        transformer.setSpectraProcessingFunc([this, last](MSSpectrum& s) { applySpectrumSteps_(0, last, s); });
+        MzMLFile().transform(mzml_file, &transformer);
+        transformer.flush();
+      }
+      data.experiment.updateRanges();
+    }
+    runFrom_(last, data);
+  }
+
+  void ProcessingPipeline::runFrom_(Size first, Data& data) const
+  {
+    Size i = first;
+    while (i < steps_.size())
+    {
+      if (steps_[i].data_step)
+      {
+        Profiler::Scope scope(steps_[i].name);
+        steps_[i].data_step(data);
+        ++i;
+        continue;
+      }
+
+      // fuse consecutive spectrum steps into one pass
+      Size last = endOfSpectrumSteps_(i);
+      {
+        Profiler::Scope scope(fusedName_(i, last));
+        PeakMap& exp = data.experiment;
+        std::vector<std::exception_ptr> errors(exp.size());
+#pragma omp parallel for schedule(dynamic)
+        for (SignedSize k = 0; k < (SignedSize)exp.size(); ++k)
+        {
+          try
+          {
+            applySpectrumSteps_(i, last, exp[k]);
+          }
+          catch (...)
+          {
+            errors[k] = std::current_exception();
+          }
+        }
+        for (const std::exception_ptr& e : errors)
+        {
+          if (e)
+          {
+            std::rethrow_exception(e);
+          }
+        }
+        exp.updateRanges();
+      }
+      i = last;
+    }
+  }
+
+  Size ProcessingPipeline::endOfSpectrumSteps_(Size first) const
+  {
+    Size last = first;
+    while (last < steps_.size() && steps_[last].spectrum_step)
+    {
+      ++last;
+    }
+    return last;
+  }
+
+  void ProcessingPipeline::applySpectrumSteps_(Size first, Size last, MSSpectrum& s) const
+  {
+    for (Size i = first; i < last; ++i)
+    {
+      steps_[i].spectrum_step(s);
+    }
+  }
+
+  String ProcessingPipeline::fusedName_(Size first, Size last) const
+  {
+    String name;
+    for (Size i = first; i < last; ++i)
+    {
+      if (i != first)
+      {
+        name += "+";
+      }
+      name += steps_[i].name;
+    }
+    return name;
+  }
+}
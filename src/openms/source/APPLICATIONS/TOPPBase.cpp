@@ -60,8 +60,10 @@
 
 #include <OpenMS/SYSTEM/ExternalProcess.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
+#include <OpenMS/SYSTEM/TaskPool.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
 
 #include <QDir>
@@ -69,13 +71,9 @@
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include <algorithm>
 #include <iostream>
 
-// OpenMP support
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 #ifdef OPENMS_WINDOWSPLATFORM
 #undef min
 #undef max
@@ -96,16 +94,9 @@ namespace OpenMS
       "Nat Meth. 2016; 13, 9: 741-748",
       "10.1038/nmeth.3959" };
 
-  void TOPPBase::setMaxNumberOfThreads(int
-#ifdef _OPENMP
-                                       num_threads // to avoid the unused warning we enable this
-                                                   // argument only if openmp is available
-#endif
-                                       )
+  void TOPPBase::setMaxNumberOfThreads(int num_threads)
   {
-#ifdef _OPENMP
-    omp_set_num_threads(num_threads);
-#endif
+    TaskPool::setThreadBudget(std::max(1, num_threads));
   }
 
   String TOPPBase::getToolPrefix() const
@@ -199,12 +190,27 @@ namespace OpenMS
     registerIntOption_("threads", "<n>", 1, "Sets the number of threads allowed to be used by the TOPP tool", false);
     registerStringOption_("write_ini", "<file>", "", "Writes the default configuration file", false);
     registerStringOption_("write_ctd", "<out_dir>", "", "Writes the common tool description file(s) (Toolname(s).ctd) to <out_dir>", false, true);
+    registerStringOption_("profile", "<file>", "", "Writes a JSON profile (wall/CPU time and memory of each processing stage) to <file>", false, true);
+    registerStringOption_("batch", "<file>", "", "Keeps the tool resident and runs one job per line of <file> ('-' reads from stdin). Each line holds the command line arguments of one job.", false, true);
     registerFlag_("no_progress", "Disables progress logging to command line", true);
     registerFlag_("force", "Overrides tool-specific checks", true);
     registerFlag_("test", "Enables the test mode (needed for internal use only)", true);
     registerFlag_("-help", "Shows options");
     registerFlag_("-helphelp", "Shows all options (including advanced)", false);
 
+    return runCommandLine_(argc, argv);
+  }
+
+  TOPPBase::ExitCodes TOPPBase::runCommandLine_(int argc, const char** argv)
+  {
+    // reset state left over from a previous job (see runBatch_())
+    param_inifile_.clear();
+    param_instance_.clear();
+    param_common_tool_.clear();
+    param_common_.clear();
+    test_mode_ = false;
+    log_type_ = ProgressLogger::NONE;
+
     // parse command line parameters:
     try
     {
@@ -279,6 +285,17 @@ namespace OpenMS
       return ILLEGAL_PARAMETERS;
     }
 
+    // '-batch' given: all further arguments come from the batch file
+    if (param_cmdline_.exists("batch"))
+    {
+      if (argc != 3)
+      {
+        writeLog_("Error: '-batch' cannot be combined with other options; give them per job in the batch file. Aborting!");
+        return ILLEGAL_PARAMETERS;
+      }
+      return runBatch_(param_cmdline_.getValue("batch").toString());
+    }
+
     ExitCodes result;
     try
     {
@@ -416,8 +433,11 @@ namespace OpenMS
       char* disable_usage = getenv("OPENMS_DISABLE_UPDATE_CHECK");
 
       // only perform check if variable is not set or explicitly enabled by setting it to "OFF"
-      if (!test_mode_ && (disable_usage == nullptr || strcmp(disable_usage, "OFF") == 0))
+      // (and only once per process, i.e. for the first job in batch mode)
+      static bool update_checked = false;
+      if (!update_checked && !test_mode_ && (disable_usage == nullptr || strcmp(disable_usage, "OFF") == 0))
       {
+        update_checked = true;
         UpdateCheck::run(tool_name_, version_, debug_level_);
       }
   #endif
@@ -445,10 +465,30 @@ namespace OpenMS
       //----------------------------------------------------------
       //main
       //----------------------------------------------------------
+      // -profile (not stored in INI files, like -write_ini)
+      String profile_file;
+      if (param_cmdline_.exists("profile"))
+      {
+        profile_file = param_cmdline_.getValue("profile").toString();
+        outputFileWritable_(profile_file, "profile");
+        Profiler::setEnabled(true);
+      }
+
       StopWatch sw;
       sw.start();
-      result = main_(argc, argv);
+      {
+        Profiler::Scope profile_scope(tool_name_);
+        result = main_(argc, argv);
+      }
       sw.stop();
+      if (!profile_file.empty())
+      {
+        Profiler::storeJSON(profile_file, {{"tool", tool_name_},
+                                           {"version", version_},
+                                           {"threads", String(getParamAsInt_("threads", 1))},
+                                           {"exit_code", String(int(result))}});
+        Profiler::setEnabled(false);
+      }
       // useful for benchmarking and for execution on clusters with schedulers
       String mem_usage;
       {
@@ -532,6 +572,82 @@ namespace OpenMS
     return result;
   }
 
+  TOPPBase::ExitCodes TOPPBase::runBatch_(const String& batch_file)
+  {
+    ifstream file_in;
+    if (batch_file != "-")
+    {
+      file_in.open(batch_file.c_str());
+      if (!file_in)
+      {
+        writeLog_("Error: File not found (" + batch_file + ")");
+        return INPUT_FILE_NOT_FOUND;
+      }
+    }
+    istream& in = (batch_file == "-") ? cin : file_in;
+
+    ExitCodes result = EXECUTION_OK;
+    Size job = 0;
+    string line;
+    while (getline(in, line))
+    {
+      String job_line(line);
+      job_line.trim();
+      if (job_line.empty() || job_line.hasPrefix("#"))
+      {
+        continue;
+      }
+      ++job;
+
+      // tokenize like a shell would (double quotes group arguments containing spaces)
+      StringList args(1, tool_name_);
+      ExitCodes job_result = EXECUTION_OK;
+      try
+      {
+        vector<String> tokens;
+        job_line.split_quoted(" ", tokens);
+        for (String& token : tokens)
+        {
+          if (token.empty())
+          {
+            continue;
+          }
+          if (token.hasPrefix("\""))
+          {
+            token.unquote();
+          }
+          if (token == "-batch")
+          {
+            throw InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "'-batch' is not allowed within a batch file");
+          }
+          args.push_back(token);
+        }
+      }
+      catch (BaseException& e)
+      {
+        writeLog_("Error: Invalid batch job " + String(job) + " (" + e.what() + ")");
+        job_result = ILLEGAL_PARAMETERS;
+      }
+
+      if (job_result == EXECUTION_OK)
+      {
+        vector<const char*> job_argv;
+        for (const String& arg : args)
+        {
+          job_argv.push_back(arg.c_str());
+        }
+        job_result = runCommandLine_(int(job_argv.size()), job_argv.data());
+      }
+      OPENMS_LOG_INFO << tool_name_ << ": batch job " << job << " finished with exit code " << int(job_result) << "." << std::endl;
+
+      if (result == EXECUTION_OK)
+      {
+        result = job_result;
+      }
+    }
+    return result;
+  }
+
   void TOPPBase::printUsage_()
   {
     // show advanced options?
@@ -1986,7 +2102,7 @@ namespace OpenMS
     //parameters
     for (vector<ParameterInformation>::const_iterator it = parameters_.begin(); it != parameters_.end(); ++it)
     {
-      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_ctd") // do not store those params in ini file
+      if (it->name == "ini" || it->name == "-help" || it->name == "-helphelp" || it->name == "instance" || it->name == "write_ini" || it->name == "write_ctd" || it->name == "profile") // do not store those params in ini file
       {
         continue;
       }
@@ -558,53 +558,7 @@ namespace OpenMS
       }
 
       // add the missing formula part
-      switch (type)
-      {
-        case Residue::Full:
-        {
-          return mono_weight + Residue::getInternalToFull().getMonoWeight();
-        }
-        case Residue::Internal:
-        {
-          return mono_weight;
-        }
-        case Residue::NTerminal:
-        {
-          return mono_weight + Residue::getInternalToNTerm().getMonoWeight();
-        }
-        case Residue::CTerminal:
-        {
-          return mono_weight + Residue::getInternalToCTerm().getMonoWeight();
-        }
-        case Residue::AIon:
-        {
-          return mono_weight + Residue::getInternalToAIon().getMonoWeight();
-        }
-        case Residue::BIon:
-        {
-          return mono_weight + Residue::getInternalToBIon().getMonoWeight();
-        }
-        case Residue::CIon:
-        {
-          return mono_weight + Residue::getInternalToCIon().getMonoWeight();
-        }
-        case Residue::XIon:
-        {
-          return mono_weight + Residue::getInternalToXIon().getMonoWeight();
-        }
-        case Residue::YIon:
-        {
-          return mono_weight + Residue::getInternalToYIon().getMonoWeight();
-        }
-        case Residue::ZIon:
-        {
-          return mono_weight + Residue::getInternalToZIon().getMonoWeight();
-        }
-        default:
-          OPENMS_LOG_ERROR << "AASequence::getMonoWeight: unknown ResidueType" << std::endl;
-      }
-
-      return mono_weight;
+      return mono_weight + internalToIonMonoWeight_(type);
     }
     else
     {
@@ -616,6 +570,94 @@ namespace OpenMS
 
 
 
+  double AASequence::internalToIonMonoWeight_(Residue::ResidueType type)
+  {
+    switch (type)
+    {
+      case Residue::Full: return Residue::getInternalToFull().getMonoWeight();
+      case Residue::Internal: return 0.0;
+      case Residue::NTerminal: return Residue::getInternalToNTerm().getMonoWeight();
+      case Residue::CTerminal: return Residue::getInternalToCTerm().getMonoWeight();
+      case Residue::AIon: return Residue::getInternalToAIon().getMonoWeight();
+      case Residue::BIon: return Residue::getInternalToBIon().getMonoWeight();
+      case Residue::CIon: return Residue::getInternalToCIon().getMonoWeight();
+      case Residue::XIon: return Residue::getInternalToXIon().getMonoWeight();
+      case Residue::YIon: return Residue::getInternalToYIon().getMonoWeight();
+      case Residue::ZIon: return Residue::getInternalToZIon().getMonoWeight();
+      default:
+        OPENMS_LOG_ERROR << "AASequence::getMonoWeight: unknown ResidueType" << std::endl;
+    }
+    return 0.0;
+  }
+
+  std::vector<double> AASequence::getPrefixMonoWeights(Residue::ResidueType type, Int charge) const
+  {
+    std::vector<double> weights;
+    weights.reserve(peptide_.size());
+    double mono_weight(Constants::PROTON_MASS_U * charge);
+    if (n_term_mod_ != nullptr &&
+        (type == Residue::Full || type == Residue::AIon ||
+         type == Residue::BIon || type == Residue::CIon ||
+         type == Residue::NTerminal))
+    {
+      mono_weight += n_term_mod_->getDiffMonoMass();
+    }
+    const double ion_weight = internalToIonMonoWeight_(type);
+    static auto const rx = ResidueDB::getInstance()->getResidue("X");
+    for (auto const& e : peptide_)
+    {
+      if (e == rx)
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot get weight of sequence with unknown AA 'X' with unknown mass.", toString());
+      }
+      mono_weight += e->getMonoWeight(Residue::Internal);
+      weights.push_back(mono_weight + ion_weight);
+    }
+    // only the complete sequence carries the C-terminal modification
+    if (c_term_mod_ != nullptr && !weights.empty() &&
+        (type == Residue::Full || type == Residue::XIon ||
+         type == Residue::YIon || type == Residue::ZIon ||
+         type == Residue::CTerminal))
+    {
+      weights.back() += c_term_mod_->getDiffMonoMass();
+    }
+    return weights;
+  }
+
+  std::vector<double> AASequence::getSuffixMonoWeights(Residue::ResidueType type, Int charge) const
+  {
+    std::vector<double> weights;
+    weights.reserve(peptide_.size());
+    double mono_weight(Constants::PROTON_MASS_U * charge);
+    if (c_term_mod_ != nullptr &&
+        (type == Residue::Full || type == Residue::XIon ||
+         type == Residue::YIon || type == Residue::ZIon ||
+         type == Residue::CTerminal))
+    {
+      mono_weight += c_term_mod_->getDiffMonoMass();
+    }
+    const double ion_weight = internalToIonMonoWeight_(type);
+    static auto const rx = ResidueDB::getInstance()->getResidue("X");
+    for (auto it = peptide_.rbegin(); it != peptide_.rend(); ++it)
+    {
+      if (*it == rx)
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Cannot get weight of sequence with unknown AA 'X' with unknown mass.", toString());
+      }
+      mono_weight += (*it)->getMonoWeight(Residue::Internal);
+      weights.push_back(mono_weight + ion_weight);
+    }
+    // only the complete sequence carries the N-terminal modification
+    if (n_term_mod_ != nullptr && !weights.empty() &&
+        (type == Residue::Full || type == Residue::AIon ||
+         type == Residue::BIon || type == Residue::CIon ||
+         type == Residue::NTerminal))
+    {
+      weights.back() += n_term_mod_->getDiffMonoMass();
+    }
+    return weights;
+  }
+
 /*void AASequence::getNeutralLosses(Map<const EmpiricalFormula, UInt) const
   {
       // the following losses are from the Zhang paper (AC, 76, 14, 2004)
@@ -1319,6 +1361,31 @@ namespace OpenMS
     // function for unmodified sequences (3x speedup).
     aas.peptide_.clear();
 
+    static ResidueDB* rdb = ResidueDB::getInstance();
+
+    // fast path for the most common case, unmodified one letter codes only:
+    // no copy of the string, no trimming and no handling of modifications
+    if (!pep.empty())
+    {
+      aas.peptide_.reserve(pep.size());
+      bool unmodified = true;
+      for (const char c : pep)
+      {
+        const Residue* r = rdb->getResidue(c);
+        if (r == nullptr)
+        {
+          unmodified = false;
+          break;
+        }
+        aas.peptide_.push_back(r);
+      }
+      if (unmodified)
+      {
+        return;
+      }
+      aas.peptide_.clear();
+    }
+
     String peptide(pep);
     peptide.trim();
     aas.peptide_.reserve(peptide.size());
@@ -1345,8 +1412,6 @@ namespace OpenMS
     // track if last char denoted a terminus
     bool dot_terminal(false), dot_notation(false);
 
-    static ResidueDB* rdb = ResidueDB::getInstance();
-
     for (String::ConstIterator str_it = peptide.begin();
          str_it != peptide.end(); ++str_it)
     {
@@ -0,0 +1,131 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/AASequenceParseCache.h>
+
+namespace OpenMS
+{
+  AASequenceParseCache::AASequenceParseCache(Size capacity) :
+    capacity_(capacity)
+  {
+  }
+
+  AASequenceParseCache::AASequenceParseCache(const AASequenceParseCache& rhs) :
+    capacity_(rhs.capacity_)
+  {
+  }
+
+  AASequenceParseCache& AASequenceParseCache::operator=(const AASequenceParseCache& rhs)
+  {
+    if (&rhs != this)
+    {
+      clear();
+      capacity_ = rhs.capacity_;
+    }
+    return *this;
+  }
+
+  std::size_t AASequenceParseCache::KeyHash::operator()(const KeyType& key) const
+  {
+    return std::hash<String>()(key.first) ^ std::size_t(key.second);
+  }
+
+  AASequence AASequenceParseCache::fromString(const String& s, bool permissive)
+  {
+    if (capacity_ == 0)
+    {
+      return AASequence::fromString(s, permissive);
+    }
+
+    KeyType key(s, permissive);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key);
+      if (it != index_.end())
+      {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second); // mark as most recently used
+        return it->second->second;
+      }
+      ++misses_;
+    }
+
+    AASequence seq = AASequence::fromString(s, permissive); // may throw, nothing is cached then
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index_.find(key) == index_.end()) // another thread may have parsed the same string meanwhile
+    {
+      lru_.emplace_front(key, seq);
+      index_.emplace(std::move(key), lru_.begin());
+      if (lru_.size() > capacity_)
+      {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+      }
+    }
+    return seq;
+  }
+
+  Size AASequenceParseCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+  }
+
+  Size AASequenceParseCache::getCapacity() const
+  {
+    return capacity_;
+  }
+
+  Size AASequenceParseCache::getHits() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  Size AASequenceParseCache::getMisses() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+  void AASequenceParseCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+  }
+
+} // namespace OpenMS
@@ -248,7 +248,7 @@ namespace OpenMS
   EmpiricalFormula EmpiricalFormula::operator*(const SignedSize& times) const
   {
     EmpiricalFormula ef(*this);
-    for (const auto& it : formula_) ef.formula_[it.first] *= times;
+    for (auto& it : ef.formula_) it.second *= times;
     ef.charge_ *= times;
     ef.removeZeroedElements_();
     return ef;
@@ -256,84 +256,63 @@ namespace OpenMS
 
   EmpiricalFormula EmpiricalFormula::operator+(const EmpiricalFormula& formula) const
   {
-    EmpiricalFormula ef;
-    ef.formula_ = formula.formula_;
-    for (const auto& it : formula_)
-    {
-      auto ef_it  = ef.formula_.find(it.first);
-      if (ef_it != ef.formula_.end())
-      {
-        ef_it->second += it.second;
-      }
-      else
-      {
-        ef.formula_.insert(it);
-      }
-    }
+    EmpiricalFormula ef(*this);
+    addScaled_(ef.formula_, formula.formula_, 1);
     ef.charge_ = charge_ + formula.charge_;
-    ef.removeZeroedElements_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator+=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
-    {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
-      {
-        f_it->second += it.second;
-      }
-      else
-      {
-        formula_.insert(it);
-      }
-    }
+    addScaled_(formula_, formula.formula_, 1);
     charge_ += formula.charge_;
-    removeZeroedElements_();
     return *this;
   }
 
   EmpiricalFormula EmpiricalFormula::operator-(const EmpiricalFormula& formula) const
   {
     EmpiricalFormula ef(*this);
-    for (const auto& it : formula.formula_)
-    {
-      const Element* e = it.first;
-      SignedSize num = it.second;
-      auto ef_it  = ef.formula_.find(e);
-      if (ef_it != ef.formula_.end())
-      {
-        ef_it->second -= num;
-      }
-      else
-      {
-        ef.formula_[e] = -num;
-      }
-    }
-
+    addScaled_(ef.formula_, formula.formula_, -1);
     ef.charge_ = charge_ - formula.charge_;
-    ef.removeZeroedElements_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator-=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
+    addScaled_(formula_, formula.formula_, -1);
+    charge_ -= formula.charge_;
+    return *this;
+  }
+
+  void EmpiricalFormula::addScaled_(MapType_& lhs, const MapType_& rhs, SignedSize factor)
+  {
+    // merge both sorted ranges into a new sequence; formulae up to INLINE_ELEMENTS elements never allocate
+    MapType_::sequence_type merged;
+    merged.reserve(lhs.size() + rhs.size());
+    const std::less<const Element*> less;
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    while (l != lhs.end() || r != rhs.end())
     {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
+      if (r == rhs.end() || (l != lhs.end() && less(l->first, r->first)))
       {
-        f_it->second -= it.second;
+        if (l->second != 0) merged.push_back(*l);
+        ++l;
+      }
+      else if (l == lhs.end() || less(r->first, l->first))
+      {
+        if (r->second != 0) merged.emplace_back(r->first, r->second * factor);
+        ++r;
       }
       else
       {
-        formula_[it.first] = -it.second;
+        const SignedSize num = l->second + r->second * factor;
+        if (num != 0) merged.emplace_back(l->first, num);
+        ++l;
+        ++r;
       }
     }
-    charge_ -= formula.charge_;
-    removeZeroedElements_();
-    return *this;
+    lhs.adopt_sequence(boost::container::ordered_unique_range, std::move(merged));
   }
 
   bool EmpiricalFormula::isCharged() const
@@ -416,7 +395,7 @@ namespace OpenMS
     return os;
   }
 
-  Int EmpiricalFormula::parseFormula_(std::map<const Element*, SignedSize>& ef, const String& input_formula) const
+  Int EmpiricalFormula::parseFormula_(MapType_& ef, const String& input_formula) const
   {
     Int charge{0};
     String formula(input_formula);
@@ -609,7 +588,7 @@ namespace OpenMS
     {
       if (it->second == 0)
       {
-        ef.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = ef.erase(it);
       }
       else
       {
@@ -627,7 +606,7 @@ namespace OpenMS
     {
       if (it->second == 0)
       {
-        formula_.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = formula_.erase(it);
       }
       else
       {
@@ -452,4 +452,89 @@ namespace OpenMS
     return digestAfterTokenize_(fragment_positions, sequence, output, min_length, max_length);
   }
 
+  Size EnzymaticDigestion::digestUnmodified(const StringView& sequence, const std::function<void(Size, Size)>& product, Size min_length, Size max_length) const
+  {
+    // disable max length filter by setting to maximum length
+    if (max_length == 0 || max_length > sequence.size())
+    {
+      max_length = sequence.size();
+    }
+
+    // Unspecific cleavage:
+    // For unspecific cleavage every site is a cutting position.
+    // All substrings of length min_size..max_size are generated.
+    if (enzyme_->getName() == UnspecificCleavage)
+    {
+      for (Size i = 0; i + min_length <= sequence.size(); ++i)
+      {
+        const Size right = std::min(i + max_length, sequence.size());
+        for (Size j = i + min_length; j <= right; ++j)
+        {
+          product(i, j - i);
+        }
+      }
+      return 0;
+    }
+
+    // naive cleavage sites
+    const std::vector<int> fragment_positions = tokenize_(sequence.getString());
+    const Size count = fragment_positions.size();
+    Size wrong_size(0);
+
+    auto report = [&](Size start, Size length)
+    {
+      if (length >= min_length && length <= max_length)
+      {
+        product(start, length);
+      }
+      else ++wrong_size;
+    };
+
+    // no cleavage sites? return full string
+    if (count == 0)
+    {
+      if (sequence.size() >= min_length && sequence.size() <= max_length)
+      {
+        product(0, sequence.size());
+      }
+      return wrong_size;
+    }
+
+    for (Size i = 1; i != count; ++i)
+    {
+      report(fragment_positions[i - 1], fragment_positions[i] - fragment_positions[i - 1]);
+    }
+
+    // add last cleavage product (need to add because end is not a cleavage site)
+    report(fragment_positions[count - 1], sequence.size() - fragment_positions[count - 1]);
+
+    // generate fragments with missed cleavages
+    for (Size i = 1; ((i <= missed_cleavages_) && (i < count)); ++i)
+    {
+      for (Size j = 1; j < count - i; ++j)
+      {
+        report(fragment_positions[j - 1], fragment_positions[j + i] - fragment_positions[j - 1]);
+      }
+
+      // add last cleavage product (need to add because end is not a cleavage site)
+      report(fragment_positions[count - i - 1], sequence.size() - fragment_positions[count - i - 1]);
+    }
+    return wrong_size;
+  }
+
+  Size EnzymaticDigestion::digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size,Size>>>& output, Size min_length, Size max_length) const
+  {
+    output.clear();
+    output.resize(sequences.size());
+    Size wrong_size(0);
+
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: wrong_size)
+    for (SignedSize i = 0; i < (SignedSize)sequences.size(); ++i)
+    {
+      std::vector<std::pair<Size,Size>>& products = output[i];
+      wrong_size += digestUnmodified(sequences[i], [&products](Size start, Size length) { products.emplace_back(start, length); }, min_length, max_length);
+    }
+    return wrong_size;
+  }
+
 } //namespace
@@ -57,5 +57,10 @@ namespace OpenMS
     }
   }
 
+  std::vector<IsotopeDistribution> FineIsotopePatternGenerator::run(const std::vector<EmpiricalFormula>& formulas) const
+  {
+    return IsoSpecBatchGenerator(stop_condition_, use_total_prob_, absolute_).run(formulas);
+  }
+
 }
 
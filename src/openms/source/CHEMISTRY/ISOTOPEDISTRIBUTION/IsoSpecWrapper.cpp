@@ -40,6 +40,7 @@
 #include <OpenMS/CHEMISTRY/Element.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -133,6 +134,88 @@ namespace OpenMS
     return _OMS_IsoFromParameters(isotopeNumbers, atomCounts, isotopeMasses, isotopeProbabilities);
   }
 
+  /// Collect all configurations of a threshold generator
+  IsotopeDistribution _OMS_runThresholdGenerator(IsoThresholdGenerator& ITG)
+  {
+    std::vector<Peak1D> distribution;
+    distribution.reserve(ITG.count_confs());
+
+    ITG.reset();
+
+    while (ITG.advanceToNextConfiguration())
+        distribution.emplace_back(Peak1D(ITG.mass(), ITG.prob()));
+
+    IsotopeDistribution ID;
+
+    ID.set(std::move(distribution));
+
+    return ID;
+  }
+
+  /// Collect configurations of a layered generator until @p target_prob is covered
+  IsotopeDistribution _OMS_runLayeredGenerator(IsoLayeredGenerator& ILG, double target_prob, bool do_p_trim)
+  {
+    std::vector<Peak1D> distribution;
+    // There is no sensible way to precalculate the number of configurations 
+    // in IsoLayeredGenerator
+
+    double acc_prob = 0.0;
+
+    while (acc_prob < target_prob && ILG.advanceToNextConfiguration())
+    {
+        double p = ILG.prob();
+        acc_prob += p;
+        distribution.emplace_back(Peak1D(ILG.mass(), p));
+    }
+
+    if (do_p_trim)
+    {
+        // the p_trim: extract the rest of the last layer, and perform quickselect
+
+        while (ILG.advanceToNextConfigurationWithinLayer())
+            distribution.emplace_back(Peak1D(ILG.mass(), ILG.prob()));
+
+        size_t start = 0;
+        size_t end = distribution.size();
+        double sum_to_start = 0.0;
+
+        while (start < end)
+        {
+            // Partition part
+            size_t pivot = start + (end-start)/2; // middle
+            double pprob = distribution[pivot].getIntensity();
+            std::swap(distribution[pivot], distribution[end-1]);
+
+            double new_csum = sum_to_start;
+
+            size_t loweridx = start;
+            for (size_t ii = start; ii < end-1; ii++)
+                if (distribution[ii].getIntensity() > pprob)
+                {
+                    std::swap(distribution[ii], distribution[loweridx]);
+                    new_csum += distribution[loweridx].getIntensity();
+                    loweridx++;
+                }
+
+            std::swap(distribution[end-1], distribution[loweridx]);
+
+            // Selection part
+            if (new_csum < target_prob)
+            {
+                start = loweridx + 1;
+                sum_to_start = new_csum + distribution[loweridx].getIntensity();
+            }
+            else
+                end = loweridx;
+        }
+        distribution.resize(end);
+    }
+
+    IsotopeDistribution ID;
+    ID.set(std::move(distribution));
+    return ID;
+  }
+
   IsoSpecThresholdGeneratorWrapper::IsoSpecThresholdGeneratorWrapper(const std::vector<int>& isotopeNr,
                     const std::vector<int>& atomCounts,
                     const std::vector<std::vector<double> >& isotopeMasses,
@@ -229,19 +312,7 @@ namespace OpenMS
 
   IsotopeDistribution IsoSpecThresholdWrapper::run()
   {
-    std::vector<Peak1D> distribution;
-    distribution.reserve(ITG->count_confs());
-
-    ITG->reset();
-
-    while (ITG->advanceToNextConfiguration())
-        distribution.emplace_back(Peak1D(ITG->mass(), ITG->prob()));
-
-    IsotopeDistribution ID;
-
-    ID.set(std::move(distribution));
-
-    return ID;
+    return _OMS_runThresholdGenerator(*ITG);
   }
 
   IsoSpecThresholdWrapper::~IsoSpecThresholdWrapper() = default;
@@ -277,64 +348,74 @@ namespace OpenMS
 
   IsotopeDistribution IsoSpecTotalProbWrapper::run()
   {
-    std::vector<Peak1D> distribution;
-    // There is no sensible way to precalculate the number of configurations 
-    // in IsoLayeredGenerator
+    return _OMS_runLayeredGenerator(*ILG, target_prob, do_p_trim);
+  }
 
-    double acc_prob = 0.0;
+//  --------------------------------------------------------------------------------
 
-    while (acc_prob < target_prob && ILG->advanceToNextConfiguration())
+  IsoSpecBatchGenerator::IsoSpecBatchGenerator(double stop_condition, bool use_total_prob, bool absolute) :
+    stop_condition_(stop_condition),
+    use_total_prob_(use_total_prob),
+    absolute_(absolute)
+  {
+  }
+
+  const IsoSpecBatchGenerator::ElementTable_& IsoSpecBatchGenerator::getElementTable_(const Element* element)
+  {
     {
-        double p = ILG->prob();
-        acc_prob += p;
-        distribution.emplace_back(Peak1D(ILG->mass(), p));
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto it = tables_.find(element);
+      if (it != tables_.end()) return it->second; // references into the map stay valid on insertion
     }
-
-    if (do_p_trim)
+    ElementTable_ table;
+    for (const auto& iso : element->getIsotopeDistribution())
     {
-        // the p_trim: extract the rest of the last layer, and perform quickselect
-
-        while (ILG->advanceToNextConfigurationWithinLayer())
-            distribution.emplace_back(Peak1D(ILG->mass(), ILG->prob()));
-
-        size_t start = 0;
-        size_t end = distribution.size();
-        double sum_to_start = 0.0;
-
-        while (start < end)
-        {
-            // Partition part
-            size_t pivot = start + (end-start)/2; // middle
-            double pprob = distribution[pivot].getIntensity();
-            std::swap(distribution[pivot], distribution[end-1]);
-
-            double new_csum = sum_to_start;
-
-            size_t loweridx = start;
-            for (size_t ii = start; ii < end-1; ii++)
-                if (distribution[ii].getIntensity() > pprob)
-                {
-                    std::swap(distribution[ii], distribution[loweridx]);
-                    new_csum += distribution[loweridx].getIntensity();
-                    loweridx++;
-                }
+      if (iso.getIntensity() <= 0.0) continue; // Note: there will be a segfault if one of the intensities is zero!
+      table.masses.push_back(iso.getMZ());
+      table.probabilities.push_back(iso.getIntensity());
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return tables_.emplace(element, std::move(table)).first->second; // keeps an entry added by another thread meanwhile
+  }
 
-            std::swap(distribution[end-1], distribution[loweridx]);
+  IsotopeDistribution IsoSpecBatchGenerator::run(const EmpiricalFormula& formula)
+  {
+    std::vector<int> isotope_numbers, atom_counts;
+    std::vector<const double*> masses, probabilities;
+    for (const auto& elem : formula)
+    {
+      const ElementTable_& table = getElementTable_(elem.first);
+      atom_counts.push_back(elem.second);
+      isotope_numbers.push_back(table.masses.size());
+      masses.push_back(table.masses.data());
+      probabilities.push_back(table.probabilities.data());
+    }
 
-            // Selection part
-            if (new_csum < target_prob)
-            {
-                start = loweridx + 1;
-                sum_to_start = new_csum + distribution[loweridx].getIntensity();
-            }
-            else
-                end = loweridx;
-        }
-        distribution.resize(end);
+    // IsoSpec copies the tables
+    Iso iso(isotope_numbers.size(), isotope_numbers.data(), atom_counts.data(), masses.data(), probabilities.data());
+    IsotopeDistribution result;
+    if (use_total_prob_)
+    {
+      IsoLayeredGenerator ILG(std::move(iso), 1024, 1024, true, 1.0 - stop_condition_);
+      result = _OMS_runLayeredGenerator(ILG, 1.0 - stop_condition_, true);
+    }
+    else
+    {
+      IsoThresholdGenerator ITG(std::move(iso), stop_condition_, absolute_);
+      result = _OMS_runThresholdGenerator(ITG);
     }
+    result.sortByMass();
+    return result;
+  }
 
-    IsotopeDistribution ID;
-    ID.set(std::move(distribution));
-    return ID;
-}
+  std::vector<IsotopeDistribution> IsoSpecBatchGenerator::run(const std::vector<EmpiricalFormula>& formulas)
+  {
+    std::vector<IsotopeDistribution> result(formulas.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)formulas.size(); ++i)
+    {
+      result[i] = run(formulas[i]);
+    }
+    return result;
+  }
 }  // namespace OpenMS
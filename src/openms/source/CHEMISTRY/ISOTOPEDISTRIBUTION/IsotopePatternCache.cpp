@@ -0,0 +1,200 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Maintainer: Chris Bielow $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternCache.h>
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+
+#include <boost/functional/hash.hpp>
+
+namespace OpenMS
+{
+  IsotopePatternCache::IsotopePatternCache(Size capacity) :
+    capacity_(capacity)
+  {
+  }
+
+  IsotopePatternCache::IsotopePatternCache(const IsotopePatternCache& rhs) :
+    capacity_(rhs.capacity_)
+  {
+  }
+
+  IsotopePatternCache& IsotopePatternCache::operator=(const IsotopePatternCache& rhs)
+  {
+    if (&rhs != this)
+    {
+      clear();
+      capacity_ = rhs.capacity_;
+    }
+    return *this;
+  }
+
+  IsotopePatternCache* IsotopePatternCache::getInstance()
+  {
+    static IsotopePatternCache* cache_ = new IsotopePatternCache;
+    return cache_;
+  }
+
+  bool IsotopePatternCache::Key::operator==(const Key& rhs) const
+  {
+    return max_isotope == rhs.max_isotope && round_masses == rhs.round_masses && formula == rhs.formula;
+  }
+
+  std::size_t IsotopePatternCache::KeyHash::operator()(const Key& key) const
+  {
+    std::size_t seed = key.max_isotope;
+    boost::hash_combine(seed, key.round_masses);
+    boost::hash_combine(seed, key.formula.getCharge());
+    for (const auto& element : key.formula)
+    {
+      boost::hash_combine(seed, element.first);
+      boost::hash_combine(seed, element.second);
+    }
+    return seed;
+  }
+
+  IsotopeDistribution IsotopePatternCache::run(const EmpiricalFormula& formula, Size max_isotope, bool round_masses)
+  {
+    if (capacity_ == 0)
+    {
+      return CoarseIsotopePatternGenerator(max_isotope, round_masses).run(formula);
+    }
+
+    Key key{formula, max_isotope, round_masses};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key);
+      if (it != index_.end())
+      {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second); // mark as most recently used
+        return it->second->second;
+      }
+      ++misses_;
+    }
+
+    IsotopeDistribution dist = CoarseIsotopePatternGenerator(max_isotope, round_masses).run(formula);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index_.find(key) == index_.end()) // another thread may have computed the same pattern meanwhile
+    {
+      lru_.emplace_front(key, dist);
+      index_.emplace(std::move(key), lru_.begin());
+      if (lru_.size() > capacity_)
+      {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+      }
+    }
+    return dist;
+  }
+
+  std::vector<IsotopeDistribution> IsotopePatternCache::run(const std::vector<EmpiricalFormula>& formulas, Size max_isotope, bool round_masses)
+  {
+    std::vector<IsotopeDistribution> result(formulas.size());
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize i = 0; i < (SignedSize)formulas.size(); ++i)
+    {
+      result[i] = run(formulas[i], max_isotope, round_masses);
+    }
+    return result;
+  }
+
+  IsotopeDistribution IsotopePatternCache::estimateFromWeightAndComp_(double average_weight, double C, double H, double N, double O, double S, double P, Size max_isotope, bool round_masses)
+  {
+    EmpiricalFormula ef;
+    ef.estimateFromWeightAndComp(average_weight, C, H, N, O, S, P);
+    return run(ef, max_isotope, round_masses);
+  }
+
+  IsotopeDistribution IsotopePatternCache::estimateFromPeptideWeight(double average_weight, Size max_isotope, bool round_masses)
+  {
+    // same averagine composition as CoarseIsotopePatternGenerator::estimateFromPeptideWeight
+    return estimateFromWeightAndComp_(average_weight, 4.9384, 7.7583, 1.3577, 1.4773, 0.0417, 0, max_isotope, round_masses);
+  }
+
+  std::vector<IsotopeDistribution> IsotopePatternCache::estimateFromPeptideWeights(const std::vector<double>& average_weights, Size max_isotope, bool round_masses)
+  {
+    std::vector<IsotopeDistribution> result(average_weights.size());
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize i = 0; i < (SignedSize)average_weights.size(); ++i)
+    {
+      result[i] = estimateFromPeptideWeight(average_weights[i], max_isotope, round_masses);
+    }
+    return result;
+  }
+
+  IsotopeDistribution IsotopePatternCache::estimateFromRNAWeight(double average_weight, Size max_isotope, bool round_masses)
+  {
+    return estimateFromWeightAndComp_(average_weight, 9.75, 12.25, 3.75, 7, 0, 1, max_isotope, round_masses);
+  }
+
+  IsotopeDistribution IsotopePatternCache::estimateFromDNAWeight(double average_weight, Size max_isotope, bool round_masses)
+  {
+    return estimateFromWeightAndComp_(average_weight, 9.75, 12.25, 3.75, 6, 0, 1, max_isotope, round_masses);
+  }
+
+  Size IsotopePatternCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+  }
+
+  Size IsotopePatternCache::getCapacity() const
+  {
+    return capacity_;
+  }
+
+  Size IsotopePatternCache::getHits() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+  Size IsotopePatternCache::getMisses() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+  }
+
+  void IsotopePatternCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    hits_ = 0;
+    misses_ = 0;
+  }
+
+} // namespace OpenMS
@@ -8,6 +8,7 @@ set(sources_list
   FineIsotopePatternGenerator.cpp
   IsotopeDistribution.cpp
   IsoSpecWrapper.cpp
+  IsotopePatternCache.cpp
   IsotopePatternGenerator.cpp
 )
 
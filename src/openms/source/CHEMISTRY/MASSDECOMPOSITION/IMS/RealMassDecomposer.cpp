@@ -51,38 +51,11 @@ namespace OpenMS::ims
 
   RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error)
   {
-    // defines the range of integers to be decomposed
-    integer_value_type start_integer_mass = static_cast<integer_value_type>(
-      ceil((1 + rounding_errors_.first) * (mass - error) / precision_));
-    integer_value_type end_integer_mass = static_cast<integer_value_type>(
-      floor((1 + rounding_errors_.second) * (mass + error) / precision_));
-
     decompositions_type all_decompositions_from_range;
-
-    // loops and finds decompositions for every integer mass,
-    // then checks if real mass of decomposition lays in the allowed
-    // error interval [mass-error; mass+error]
-    for (integer_value_type integer_mass = start_integer_mass;
-         integer_mass < end_integer_mass; ++integer_mass)
+    forEachDecomposition(mass, error, [&all_decompositions_from_range](const integer_decomposer_type::decomposition_type & decomposition)
     {
-      decompositions_type decompositions =
-        decomposer_->getAllDecompositions(integer_mass);
-      for (decompositions_type::iterator pos = decompositions.begin();
-           pos != decompositions.end(); )
-      {
-        double parent_mass = weights_.getParentMass(*pos);
-        if (fabs(parent_mass - mass) > error)
-        {
-          pos = decompositions.erase(pos);
-        }
-        else
-        {
-          ++pos;
-        }
-      }
-      all_decompositions_from_range.insert(all_decompositions_from_range.end(),
-                                           decompositions.begin(), decompositions.end());
-    }
+      all_decompositions_from_range.push_back(decomposition);
+    });
     return all_decompositions_from_range;
   }
 
@@ -84,6 +84,20 @@ namespace OpenMS
     }
   }
 
+  MassDecomposition::MassDecomposition(const std::map<char, Size>& deco) :
+    number_of_max_aa_(0)
+  {
+    for (const auto& aa : deco)
+    {
+      if (aa.second == 0)
+      {
+        continue;
+      }
+      number_of_max_aa_ = std::max(number_of_max_aa_, aa.second);
+      decomp_.insert(decomp_.end(), aa);
+    }
+  }
+
   MassDecomposition::MassDecomposition(const MassDecomposition& rhs) :
     decomp_(rhs.decomp_),
     number_of_max_aa_(rhs.number_of_max_aa_)
@@ -40,6 +40,7 @@
 
 #include <iostream>
 #include <map>
+#include <mutex>
 using namespace std;
 
 namespace OpenMS
@@ -47,7 +48,8 @@ namespace OpenMS
   MassDecompositionAlgorithm::MassDecompositionAlgorithm() :
     DefaultParamHandler("MassDecompositionAlgorithm"),
     alphabet_(nullptr),
-    decomposer_(nullptr)
+    current_precision_(0.0),
+    tolerance_(0.0)
   {
     defaults_.setValue("decomp_weights_precision", 0.01, "precision used to calculate the decompositions, this only affects cache usage!", {"advanced"});
     defaults_.setValue("tolerance", 0.3, "tolerance which is allowed for the decompositions");
@@ -72,36 +74,80 @@ namespace OpenMS
   MassDecompositionAlgorithm::~MassDecompositionAlgorithm()
   {
     delete alphabet_;
-    delete decomposer_;
   }
 
-  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass)
+  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass) const
   {
-    double tolerance((double) param_.getValue("tolerance"));
-    ims::RealMassDecomposer::decompositions_type decompositions = decomposer_->getDecompositions(mass, tolerance);
+    getDecompositions(decomps, mass, tolerance_);
+  }
+
+  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass, double tolerance) const
+  {
+    forEachDecomposition(mass, tolerance, [&decomps](const MassDecomposition & decomp) { decomps.push_back(decomp); });
+  }
+
+  void MassDecompositionAlgorithm::getDecompositions(vector<vector<MassDecomposition> > & decomps, const vector<double> & weights) const
+  {
+    decomps.resize(weights.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)weights.size(); ++i)
+    {
+      decomps[i].clear();
+      getDecompositions(decomps[i], weights[i], tolerance_);
+    }
+  }
 
-    for (ims::RealMassDecomposer::decompositions_type::const_iterator pos = decompositions.begin(); pos != decompositions.end(); ++pos)
+  void MassDecompositionAlgorithm::forEachDecomposition(double mass, double tolerance, const std::function<void(const MassDecomposition &)> & callback) const
+  {
+    std::map<char, Size> composition;
+    decomposer_->forEachDecomposition(mass, tolerance, [&](const ims::RealMassDecomposer::integer_decomposer_type::decomposition_type & decomposition)
     {
-      String d;
-      for (ims::IMSAlphabet::size_type i = 0; i < alphabet_->size(); ++i)
+      composition.clear();
+      for (Size i = 0; i < names_.size(); ++i)
       {
-        if ((*pos)[i] > 0)
+        if (decomposition[i] > 0)
         {
-          d += alphabet_->getName(i) + String((*pos)[i]) + " ";
+          composition[names_[i]] = decomposition[i];
         }
       }
-      d.trim();
-      MassDecomposition decomp(d);
-      decomps.push_back(decomp);
+      callback(MassDecomposition(composition));
+    });
+  }
+
+  std::shared_ptr<const ims::RealMassDecomposer> MassDecompositionAlgorithm::getSharedDecomposer_(const AlphabetType & alphabet, double precision)
+  {
+    // building the extended residue table is expensive, e.g. CompNovo creates a new algorithm object per spectrum
+    static std::mutex mutex;
+    static std::map<std::pair<AlphabetType, double>, std::shared_ptr<const ims::RealMassDecomposer> > decomposers;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_pair(alphabet, precision);
+    auto it = decomposers.find(key);
+    if (it != decomposers.end())
+    {
+      return it->second;
     }
 
-    return;
+    ims::IMSAlphabet ims_alphabet;
+    for (const auto& aa : alphabet)
+    {
+      ims_alphabet.push_back(String(aa.first), aa.second);
+    }
+
+    // initializes weights
+    ims::Weights weights(ims_alphabet.getMasses(), precision);
+
+    // optimize alphabet by dividing by gcd
+    weights.divideByGCD();
+
+    // decomposes real values
+    auto decomposer = std::make_shared<const ims::RealMassDecomposer>(weights);
+    decomposers.emplace(std::move(key), decomposer);
+    return decomposer;
   }
 
   void MassDecompositionAlgorithm::updateMembers_()
   {
-    // todo add accessor to tolerance, it is called very often in CID mode
-
     std::map<char, double> aa_to_weight;
 
     set<const Residue *> residues = ResidueDB::getInstance()->getResidues(String(param_.getValue("residue_set").toString()));
@@ -185,30 +231,29 @@ namespace OpenMS
       }
     }
 
-    if (alphabet_ != nullptr)
-    {
-      delete alphabet_;
-    }
-    if (decomposer_ != nullptr)
+    tolerance_ = (double) param_.getValue("tolerance");
+
+    // the residue table only depends on the alphabet and the precision (changing e.g. the tolerance is cheap)
+    double precision((double) param_.getValue("decomp_weights_precision"));
+    if (decomposer_ != nullptr && aa_to_weight == current_alphabet_ && precision == current_precision_)
     {
-      delete decomposer_;
+      return;
     }
 
+    delete alphabet_;
+
     // init mass decomposer
     alphabet_ = new ims::IMSAlphabet();
+    names_.clear();
     for (std::map<char, double>::const_iterator it = aa_to_weight.begin(); it != aa_to_weight.end(); ++it)
     {
       alphabet_->push_back(String(it->first), it->second);
+      names_.push_back(it->first);
     }
 
-    // initializes weights
-    ims::Weights weights(alphabet_->getMasses(), (double) param_.getValue("decomp_weights_precision"));
-
-    // optimize alphabet by dividing by gcd
-    weights.divideByGCD();
-
-    // decomposes real values
-    decomposer_ = new ims::RealMassDecomposer(weights);
+    decomposer_ = getSharedDecomposer_(aa_to_weight, precision);
+    current_alphabet_ = aa_to_weight;
+    current_precision_ = precision;
 
     return;
   }
@@ -42,7 +42,9 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
 #include <fstream>
 
 using namespace std;
@@ -132,8 +134,8 @@ namespace OpenMS
   Size ModificationsDB::getNumberOfModifications() const
   {
     Size s;
-    #pragma omp critical (OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = mods_.size();
     }
     return s;
@@ -153,8 +155,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -198,8 +200,8 @@ namespace OpenMS
 
     String mod_name = mod_in.getFullId();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
 
@@ -242,8 +244,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -312,8 +314,8 @@ namespace OpenMS
   bool ModificationsDB::has(const String & modification) const
   {
     bool has_mod;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       has_mod = (modification_names_.find(modification) != modification_names_.end());
     }
     return has_mod;
@@ -327,8 +329,8 @@ namespace OpenMS
     }
 
     bool one_mod(true);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       if (modification_names_.find(mod_name)->second.size() > 1)
       {
         one_mod = false;
@@ -340,8 +342,8 @@ namespace OpenMS
     }
 
     Size index(numeric_limits<Size>::max());
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       const ResidueModification* mod = *(modification_names_.find(mod_name)->second.begin());
       for (Size i = 0; i != mods_.size(); ++i)
       {
@@ -360,99 +362,100 @@ namespace OpenMS
     return index;
   }
 
-  void ModificationsDB::searchModificationsByDiffMonoMass(vector<String>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
+  void ModificationsDB::findByDiffMonoMass_(vector<Size>& indices, double mass, double max_error, char res, ResidueModification::TermSpecificity term_spec) const
   {
-    mods.clear();
-    char res = '?'; // empty
-    if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
+    indices.clear();
+    // find the mass window in the sorted index; widen it to all entries that pass the exact test below (rounding)
+    auto begin = lower_bound(mass_index_.begin(), mass_index_.end(), make_pair(mass - max_error, Size(0)));
+    while (begin != mass_index_.begin() && fabs(prev(begin)->first - mass) <= max_error)
     {
-      for (auto const & m : mods_)
+      --begin;
+    }
+    for (auto it = begin; it != mass_index_.end() && (it->first <= mass + max_error || fabs(it->first - mass) <= max_error); ++it)
+    {
+      const ResidueModification* m = mods_[it->second];
+      if ((fabs(it->first - mass) <= max_error) &&
+          residuesMatch_(res, m) &&
+          ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
+           (term_spec == m->getTermSpecificity())))
       {
-        if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          mods.push_back(m->getFullId());
-        }
+        indices.push_back(it->second);
       }
     }
+    // report in the order of the database
+    sort(indices.begin(), indices.end());
   }
 
-  void ModificationsDB::searchModificationsByDiffMonoMass(vector<const ResidueModification*>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
+  void ModificationsDB::addToMassIndex_(Size index)
+  {
+    const pair<double, Size> entry(mods_[index]->getDiffMonoMass(), index);
+    mass_index_.insert(upper_bound(mass_index_.begin(), mass_index_.end(), entry), entry);
+  }
+
+  void ModificationsDB::searchModificationsByDiffMonoMass(vector<String>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
   {
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
-      for (auto const & m : mods_)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      vector<Size> indices;
+      findByDiffMonoMass_(indices, mass, max_error, res, term_spec);
+      for (Size i : indices)
       {
-        if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          mods.push_back(m);
-        }
+        mods.push_back(mods_[i]->getFullId());
       }
     }
   }
 
-  void ModificationsDB::searchModificationsByDiffMonoMassSorted(vector<String>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
+  void ModificationsDB::searchModificationsByDiffMonoMass(vector<const ResidueModification*>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
   {
     mods.clear();
-    std::map<std::pair<double,Size>, const String&> diff_idx2mods;
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    double diff = 0;
-    Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
-      for (auto const & m : mods_)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      vector<Size> indices;
+      findByDiffMonoMass_(indices, mass, max_error, res, term_spec);
+      for (Size i : indices)
       {
-        diff = fabs(m->getDiffMonoMass() - mass);
-        if ((diff <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          diff_idx2mods.emplace(make_pair(diff, cnt++), m->getFullId());
-        }
+        mods.push_back(mods_[i]);
       }
     }
-    for (const auto& foo_mod : diff_idx2mods)
+  }
+
+  void ModificationsDB::searchModificationsByDiffMonoMassSorted(vector<String>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
+  {
+    vector<const ResidueModification*> sorted_mods;
+    searchModificationsByDiffMonoMassSorted(sorted_mods, mass, max_error, residue, term_spec);
+    mods.clear();
+    for (const ResidueModification* m : sorted_mods)
     {
-      mods.push_back(foo_mod.second);
+      mods.push_back(m->getFullId());
     }
   }
 
   void ModificationsDB::searchModificationsByDiffMonoMassSorted(vector<const ResidueModification*>& mods, double mass, double max_error, const String& residue, ResidueModification::TermSpecificity term_spec)
   {
     mods.clear();
-    std::map<std::pair<double,Size>, const ResidueModification*> diff_idx2mods;
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    double diff = 0;
-    Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
-      for (auto const & m : mods_)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      vector<Size> indices;
+      findByDiffMonoMass_(indices, mass, max_error, res, term_spec);
+      // sort by mass error, equal errors in the order of the database
+      vector<pair<double, Size> > diff_idx;
+      diff_idx.reserve(indices.size());
+      for (Size i : indices)
       {
-        diff = fabs(m->getDiffMonoMass() - mass);
-        if ((diff <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          diff_idx2mods.emplace(make_pair(diff, cnt++), m);
-        }
+        diff_idx.emplace_back(fabs(mods_[i]->getDiffMonoMass() - mass), i);
+      }
+      sort(diff_idx.begin(), diff_idx.end());
+      for (const auto& d : diff_idx)
+      {
+        mods.push_back(mods_[d.second]);
       }
-    }
-    for (const auto& foo_mod : diff_idx2mods)
-    {
-      mods.push_back(foo_mod.second);
     }
   }
 
@@ -466,21 +469,20 @@ namespace OpenMS
     {
       res = residue[0];
     }
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
-      for (auto const & m : mods_)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      vector<Size> indices;
+      findByDiffMonoMass_(indices, mass, max_error, res, term_spec);
+      for (Size i : indices)
       {
         // using less instead of less-or-equal will pick the first matching
         // modification of equally heavy modifications (in our case this is the
         // first matching UniMod entry)
-        double mass_error = fabs(m->getDiffMonoMass() - mass);
-        if ((mass_error < min_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
+        double mass_error = fabs(mods_[i]->getDiffMonoMass() - mass);
+        if (mass_error < min_error)
         {
           min_error = mass_error;
-          mod = m;
+          mod = mods_[i];
         }
       }
     }
@@ -497,8 +499,8 @@ namespace OpenMS
       // create full ID based on other information:
       m->setFullId();
 
-      #pragma omp critical(OpenMS_ModificationsDB)
       {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         // e.g. Oxidation (M)
         modification_names_[m->getFullId()].insert(m);
         // e.g. Oxidation
@@ -508,6 +510,7 @@ namespace OpenMS
         // e.g. UniMod:312
         modification_names_[m->getUniModAccession()].insert(m);
         mods_.push_back(m);
+        addToMassIndex_(mods_.size() - 1);
       }
     }
   }
@@ -515,13 +518,13 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addModification(std::unique_ptr<ResidueModification> new_mod)
   {
     const ResidueModification* ret;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       auto it = modification_names_.find(new_mod->getFullId());
       if (it != modification_names_.end())
       {
         OPENMS_LOG_WARN << "Modification already exists in ModificationsDB. Skipping." << new_mod->getFullId() << endl;
-        ret = *(it->second.begin()); // returning from omp critical is not allowed
+        ret = *(it->second.begin()); // single exit point
       }
       else
       {
@@ -530,6 +533,7 @@ namespace OpenMS
         modification_names_[new_mod->getFullName()].insert(new_mod.get());
         modification_names_[new_mod->getUniModAccession()].insert(new_mod.get());
         mods_.push_back(new_mod.get());
+        addToMassIndex_(mods_.size() - 1);
         new_mod.release(); // do not delete the object;
         ret = mods_.back();
       }
@@ -540,13 +544,13 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addModification(const ResidueModification& new_mod)
   {
     const ResidueModification* ret = new ResidueModification(new_mod);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       auto it = modification_names_.find(new_mod.getFullId());
       if (it != modification_names_.end())
       {
         OPENMS_LOG_WARN << "Modification already exists in ModificationsDB. Skipping." << new_mod.getFullId() << endl;
-        ret = *(it->second.begin()); // returning from omp critical is not allowed
+        ret = *(it->second.begin()); // single exit point
       }
       else
       {
@@ -555,6 +559,7 @@ namespace OpenMS
         modification_names_[ret->getFullName()].insert(ret);
         modification_names_[ret->getUniModAccession()].insert(ret);
         mods_.push_back(const_cast<ResidueModification*>(ret));
+        addToMassIndex_(mods_.size() - 1);
         ret = mods_.back();
       }
     }
@@ -564,13 +569,14 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addNewModification_(const ResidueModification& new_mod)
   {
     const ResidueModification* ret = new ResidueModification(new_mod);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       modification_names_[ret->getFullId()].insert(ret);
       modification_names_[ret->getId()].insert(ret);
       modification_names_[ret->getFullName()].insert(ret);
       modification_names_[ret->getUniModAccession()].insert(ret);
       mods_.push_back(const_cast<ResidueModification*>(ret));
+      addToMassIndex_(mods_.size() - 1);
       ret = mods_.back();
     }
     return ret;
@@ -831,8 +837,8 @@ namespace OpenMS
     }
 
     // now use the term and all synonyms to build the database
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       for (multimap<String, ResidueModification>::const_iterator it = all_mods.begin(); it != all_mods.end(); ++it)
       {
         // check whether a unimod definition already exists, then simply add synonyms to it
@@ -855,6 +861,7 @@ namespace OpenMS
              (it->second.getDiffMonoMass() != 0)))
           {
             mods_.push_back(new ResidueModification(it->second));
+            addToMassIndex_(mods_.size() - 1);
 
             set<String> synonyms = it->second.getSynonyms();
             synonyms.insert(it->first);
@@ -882,8 +889,8 @@ namespace OpenMS
   {
     modifications.clear();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if (m->getUniModRecordId() > 0)
@@ -35,6 +35,10 @@
 #include <OpenMS/CHEMISTRY/ModifiedPeptideGenerator.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
+
+#include <algorithm>
+#include <limits>
+
 using std::vector;
 using std::map;
 
@@ -174,9 +178,6 @@ namespace OpenMS
       return;
     }
 
-    const int N_TERM_MODIFICATION_INDEX = -1; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
-    const int C_TERM_MODIFICATION_INDEX = -2; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
-
     //keep a list of all possible modifications of this peptide
     vector<AASequence> modified_peptides;
 
@@ -189,6 +190,77 @@ namespace OpenMS
     // iterate over each residue and build compatibility mapping describing
     // which amino acid (peptide index) is compatible with which modification
     map<int, vector<const ResidueModification*> > map_compatibility;
+    buildCompatibilityMap_(var_mods, peptide, map_compatibility);
+
+    // Check if no compatible site that can be modified by variable
+    // modification. If so just return peptides without variable modifications.
+    const Size compatible_mod_sites = map_compatibility.size();
+    if (compatible_mod_sites == 0)
+    {
+      if (keep_unmodified)
+      {
+        all_modified_peptides.push_back(peptide);
+      }
+      return;
+    }
+
+    // generate powerset of max_variable_mods_per_peptide sized subset of all compatible modification sites
+    Size max_placements = std::min(max_variable_mods_per_peptide, compatible_mod_sites);
+    for (Size n_var_mods = 1; n_var_mods <= max_placements; ++n_var_mods)
+    {
+      // enumerate all modified peptides with n_var_mods variable modified residues
+      Size zeros = std::max((Size)0, compatible_mod_sites - n_var_mods);
+      vector<bool> subset_mask;
+
+      for (Size i = 0; i != compatible_mod_sites; ++i)
+      {
+        // create mask 000011 to select last (e.g. n_var_mods = 2) two compatible sites as subset from the set of all compatible sites
+        if (i < zeros)
+        {
+          subset_mask.push_back(false);
+        }
+        else
+        {
+          subset_mask.push_back(true);
+        }
+      }
+
+      // generate all subsets of compatible sites {000011, ... , 101000, 110000} with current number of allowed variable modifications per peptide
+      do
+      {
+        // create subset indices e.g.{4,12} from subset mask e.g. 1010000 corresponding to the positions in the peptide sequence
+        vector<int> subset_indices;
+        map<int, vector<const ResidueModification*> >::const_iterator mit = map_compatibility.begin();
+        for (Size i = 0; i != compatible_mod_sites; ++i, ++mit)
+        {
+          if (subset_mask[i])
+          {
+            subset_indices.push_back(mit->first);
+          }
+        }
+
+        // now enumerate all modifications
+        recurseAndGenerateVariableModifiedPeptides_(subset_indices, map_compatibility, var_mods, 0, peptide, modified_peptides);
+      } while (next_permutation(subset_mask.begin(), subset_mask.end()));
+    }
+    // add modified version of the current peptide to the list of all peptides
+    
+    all_modified_peptides.insert(
+      all_modified_peptides.end(), 
+      make_move_iterator(modified_peptides.begin()), 
+      make_move_iterator(modified_peptides.end())); 
+      
+  }
+
+
+  // static
+  void ModifiedPeptideGenerator::buildCompatibilityMap_(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    map<int, vector<const ResidueModification*> >& map_compatibility)
+  {
+    const int N_TERM_MODIFICATION_INDEX = -1; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
+    const int C_TERM_MODIFICATION_INDEX = -2; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
 
     // set terminal modifications for modifications without amino acid preference
     for (auto const& mr : var_mods.val)
@@ -250,68 +322,8 @@ namespace OpenMS
         }
       }
     }
-
-    // Check if no compatible site that can be modified by variable
-    // modification. If so just return peptides without variable modifications.
-    const Size compatible_mod_sites = map_compatibility.size();
-    if (compatible_mod_sites == 0)
-    {
-      if (keep_unmodified)
-      {
-        all_modified_peptides.push_back(peptide);
-      }
-      return;
-    }
-
-    // generate powerset of max_variable_mods_per_peptide sized subset of all compatible modification sites
-    Size max_placements = std::min(max_variable_mods_per_peptide, compatible_mod_sites);
-    for (Size n_var_mods = 1; n_var_mods <= max_placements; ++n_var_mods)
-    {
-      // enumerate all modified peptides with n_var_mods variable modified residues
-      Size zeros = std::max((Size)0, compatible_mod_sites - n_var_mods);
-      vector<bool> subset_mask;
-
-      for (Size i = 0; i != compatible_mod_sites; ++i)
-      {
-        // create mask 000011 to select last (e.g. n_var_mods = 2) two compatible sites as subset from the set of all compatible sites
-        if (i < zeros)
-        {
-          subset_mask.push_back(false);
-        }
-        else
-        {
-          subset_mask.push_back(true);
-        }
-      }
-
-      // generate all subsets of compatible sites {000011, ... , 101000, 110000} with current number of allowed variable modifications per peptide
-      do
-      {
-        // create subset indices e.g.{4,12} from subset mask e.g. 1010000 corresponding to the positions in the peptide sequence
-        vector<int> subset_indices;
-        map<int, vector<const ResidueModification*> >::const_iterator mit = map_compatibility.begin();
-        for (Size i = 0; i != compatible_mod_sites; ++i, ++mit)
-        {
-          if (subset_mask[i])
-          {
-            subset_indices.push_back(mit->first);
-          }
-        }
-
-        // now enumerate all modifications
-        recurseAndGenerateVariableModifiedPeptides_(subset_indices, map_compatibility, var_mods, 0, peptide, modified_peptides);
-      } while (next_permutation(subset_mask.begin(), subset_mask.end()));
-    }
-    // add modified version of the current peptide to the list of all peptides
-    
-    all_modified_peptides.insert(
-      all_modified_peptides.end(), 
-      make_move_iterator(modified_peptides.begin()), 
-      make_move_iterator(modified_peptides.end())); 
-      
   }
 
-
   // static
   void ModifiedPeptideGenerator::recurseAndGenerateVariableModifiedPeptides_(
     const vector<int>& subset_indices, 
@@ -421,5 +433,191 @@ namespace OpenMS
       }
     }
   }
-}
 
+  ModifiedPeptideGenerator::VariableModificationEnumerator::VariableModificationEnumerator(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    Size max_variable_mods_per_peptide,
+    bool keep_unmodified) :
+    var_mods_(var_mods),
+    peptide_(peptide),
+    max_placements_(0),
+    keep_unmodified_(keep_unmodified),
+    base_mass_(peptide.getMonoWeight()),
+    min_mass_(-std::numeric_limits<double>::max()),
+    max_mass_(std::numeric_limits<double>::max())
+  {
+    if (var_mods.val.empty() || max_variable_mods_per_peptide == 0) { return; }
+
+    if (max_variable_mods_per_peptide == 1)
+    {
+      // mirror applyAtMostOneVariableModification_: residues are visited from the C-terminus (i.e. from the last site)
+      // and modifications compatible with the residue (incl. terminal ones) are placed on the residue itself
+      for (Size residue_index = 0; residue_index != peptide.size(); ++residue_index)
+      {
+        const Residue& residue = peptide[residue_index];
+        if (residue.isModified()) { continue; }
+
+        Site_ site;
+        site.site = static_cast<int>(residue_index);
+        for (auto const& mr : var_mods.val)
+        {
+          const ResidueModification* v = mr.first;
+          if (residue.getOneLetterCode()[0] != v->getOrigin()) { continue; }
+
+          const ResidueModification::TermSpecificity& term_spec = v->getTermSpecificity();
+          if (term_spec == ResidueModification::ANYWHERE
+            || (term_spec == ResidueModification::C_TERM && residue_index == (peptide.size() - 1))
+            || (term_spec == ResidueModification::N_TERM && residue_index == 0))
+          {
+            site.modifications.push_back(v);
+            site.mass_differences.push_back(mr.second->getMonoWeight(Residue::Internal) - residue.getMonoWeight(Residue::Internal));
+          }
+        }
+        if (!site.modifications.empty()) { sites_.push_back(std::move(site)); }
+      }
+    }
+    else
+    {
+      map<int, vector<const ResidueModification*> > map_compatibility;
+      buildCompatibilityMap_(var_mods, peptide, map_compatibility);
+      for (auto const& mc : map_compatibility)
+      {
+        Site_ site;
+        site.site = mc.first;
+        site.modifications = mc.second;
+        for (const ResidueModification* m : mc.second)
+        {
+          if (mc.first == N_TERM_SITE || mc.first == C_TERM_SITE)
+          {
+            site.mass_differences.push_back(m->getDiffMonoMass());
+          }
+          else
+          {
+            site.mass_differences.push_back(var_mods.val.at(m)->getMonoWeight(Residue::Internal) - peptide[mc.first].getMonoWeight(Residue::Internal));
+          }
+        }
+        sites_.push_back(std::move(site));
+      }
+    }
+    max_placements_ = std::min(max_variable_mods_per_peptide, sites_.size());
+  }
+
+  void ModifiedPeptideGenerator::VariableModificationEnumerator::setMassRange(double min_mass, double max_mass)
+  {
+    min_mass_ = min_mass;
+    max_mass_ = max_mass;
+  }
+
+  bool ModifiedPeptideGenerator::VariableModificationEnumerator::next()
+  {
+    while (advance_())
+    {
+      if (mass_ >= min_mass_ && mass_ <= max_mass_) { return true; }
+    }
+    return false;
+  }
+
+  bool ModifiedPeptideGenerator::VariableModificationEnumerator::advance_()
+  {
+    if (done_) { return false; }
+
+    if (!started_)
+    {
+      started_ = true;
+      if (keep_unmodified_)
+      {
+        placements_.clear();
+        mass_ = base_mass_;
+        index_ = count_++;
+        return true;
+      }
+    }
+    else if (n_placements_ > 0)
+    {
+      // next combination of modifications on the current sites (the last site changes fastest)
+      for (Size d = n_placements_; d > 0; --d)
+      {
+        if (++choice_[d - 1] < sites_[subset_[d - 1]].modifications.size())
+        {
+          updateCurrent_();
+          index_ = count_++;
+          return true;
+        }
+        choice_[d - 1] = 0;
+      }
+    }
+
+    // next subset of sites: {000011, ... , 110000} (as in applyVariableModifications) followed by subsets with more sites
+    if (n_placements_ == 0 || !std::next_permutation(subset_mask_.begin(), subset_mask_.end()))
+    {
+      ++n_placements_;
+      if (n_placements_ > max_placements_)
+      {
+        done_ = true;
+        return false;
+      }
+      subset_mask_.assign(sites_.size(), false);
+      std::fill(subset_mask_.end() - n_placements_, subset_mask_.end(), true);
+    }
+
+    subset_.clear();
+    for (Size i = 0; i != subset_mask_.size(); ++i)
+    {
+      if (subset_mask_[i]) { subset_.push_back(i); }
+    }
+    choice_.assign(n_placements_, 0);
+    updateCurrent_();
+    index_ = count_++;
+    return true;
+  }
+
+  void ModifiedPeptideGenerator::VariableModificationEnumerator::updateCurrent_()
+  {
+    placements_.resize(n_placements_);
+    mass_ = base_mass_;
+    for (Size d = 0; d != n_placements_; ++d)
+    {
+      const Site_& site = sites_[subset_[d]];
+      placements_[d].site = site.site;
+      placements_[d].modification = site.modifications[choice_[d]];
+      mass_ += site.mass_differences[choice_[d]];
+    }
+  }
+
+  Size ModifiedPeptideGenerator::VariableModificationEnumerator::getIndex() const
+  {
+    return index_;
+  }
+
+  double ModifiedPeptideGenerator::VariableModificationEnumerator::getMonoWeight() const
+  {
+    return mass_;
+  }
+
+  const vector<ModifiedPeptideGenerator::VariableModificationEnumerator::Placement>& ModifiedPeptideGenerator::VariableModificationEnumerator::getPlacements() const
+  {
+    return placements_;
+  }
+
+  AASequence ModifiedPeptideGenerator::VariableModificationEnumerator::getPeptide() const
+  {
+    AASequence peptide = peptide_;
+    for (const Placement& p : placements_)
+    {
+      if (p.site == C_TERM_SITE)
+      {
+        peptide.setCTerminalModification(p.modification);
+      }
+      else if (p.site == N_TERM_SITE)
+      {
+        peptide.setNTerminalModification(p.modification);
+      }
+      else
+      {
+        peptide.setModification(p.site, var_mods_.val.at(p.modification)); // set modified Residue
+      }
+    }
+    return peptide;
+  }
+}
@@ -237,6 +237,17 @@ namespace OpenMS
 
     vector<double> fragments_left, fragments_right;
     Size start = add_first_prefix_ion_ ? 0 : 1;
+
+    // reserve space for all fragment peaks up front (ambiguous a-B ions may add a few more):
+    Size n_ion_types = Size(add_a_ions_) + Size(add_b_ions_) + Size(add_c_ions_) +
+      Size(add_d_ions_) + Size(add_aB_ions_) + Size(add_w_ions_) +
+      Size(add_x_ions_) + Size(add_y_ions_) + Size(add_z_ions_);
+    Size n_peaks = n_ion_types * (oligo.size() - 1) + Size(add_precursor_peaks_);
+    spectrum.reserve(n_peaks);
+    if (add_metainfo_)
+    {
+      spectrum.getStringDataArrays()[0].reserve(n_peaks);
+    }
     if ((add_a_ions_ || add_b_ions_ || add_c_ions_ || add_d_ions_ ||
          add_aB_ions_) && (oligo.size() > start + 1))
     {
@@ -367,6 +378,19 @@ namespace OpenMS
   }
 
 
+  void NucleicAcidSpectrumGenerator::reservePeaks_(MSSpectrum& spectrum, Size n_peaks) const
+  {
+    spectrum.reserve(spectrum.size() + n_peaks);
+    if (add_metainfo_)
+    {
+      auto& ions = spectrum.getStringDataArrays()[0];
+      ions.reserve(ions.size() + n_peaks);
+      auto& charges = spectrum.getIntegerDataArrays()[0];
+      charges.reserve(charges.size() + n_peaks);
+    }
+  }
+
+
   void NucleicAcidSpectrumGenerator::getSpectrum(MSSpectrum& spectrum, const NASequence& oligo, Int min_charge, Int max_charge) const
   {
     Int sign = 1;
@@ -401,6 +425,10 @@ namespace OpenMS
 
     MSSpectrum uncharged_spectrum = getUnchargedSpectrum_(oligo);
 
+    if ((UInt)abs(min_charge) <= (UInt)abs(max_charge))
+    {
+      reservePeaks_(spectrum, uncharged_spectrum.size() * ((UInt)abs(max_charge) - (UInt)abs(min_charge) + 1));
+    }
     for (UInt z = (UInt)abs(min_charge); z <= (UInt)abs(max_charge) && z < (UInt)oligo.size(); ++z)
     {
       bool add_precursor =
@@ -452,6 +480,8 @@ namespace OpenMS
       while (charge_it != charges.rend())
       {
         MSSpectrum& spectrum = spectra[*charge_it];
+        // space for the charge states added below and the final precursor peak:
+        reservePeaks_(spectrum, uncharged_spectrum.size() * (charge - *charge_it + 1) + 1);
         for (; charge >= *charge_it; --charge)
         {
           addChargedSpectrum_(spectrum, uncharged_spectrum, charge,
@@ -491,6 +521,8 @@ namespace OpenMS
       while (charge_it != charges.end())
       {
         MSSpectrum& spectrum = spectra[*charge_it];
+        // space for the charge states added below and the final precursor peak:
+        reservePeaks_(spectrum, uncharged_spectrum.size() * (*charge_it - charge + 1) + 1);
         for (; charge <= *charge_it; ++charge)
         {
           addChargedSpectrum_(spectrum, uncharged_spectrum, charge,
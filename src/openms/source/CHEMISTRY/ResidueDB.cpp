@@ -40,6 +40,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
@@ -71,8 +72,8 @@ namespace OpenMS
     }
 
     const Residue* r{};
-    #pragma omp critical (ResidueDB)
-    {   
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       auto it = residue_names_.find(name);
       if (it != residue_names_.end()) 
       { 
@@ -96,8 +97,8 @@ namespace OpenMS
   Size ResidueDB::getNumberOfResidues() const
   {
     Size s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = const_residues_.size();
     } 
     return s;
@@ -106,8 +107,8 @@ namespace OpenMS
   Size ResidueDB::getNumberOfModifiedResidues() const
   {
     Size s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = const_modified_residues_.size();
     } 
     return s;
@@ -116,8 +117,8 @@ namespace OpenMS
   const set<const Residue*> ResidueDB::getResidues(const String& residue_set) const
   {
     set<const Residue*> s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       auto it = residues_by_set_.find(residue_set);
       if (it != residues_by_set_.end())
       {
@@ -155,8 +156,8 @@ namespace OpenMS
   bool ResidueDB::hasResidue(const String& res_name) const
   {
     bool found = false;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       found = residue_names_.find(res_name) != residue_names_.end();
     }  
     return found;
@@ -165,8 +166,8 @@ namespace OpenMS
   bool ResidueDB::hasResidue(const Residue* residue) const
   {
     bool found = false;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       found = (const_residues_.find(residue) != const_residues_.end() ||
           const_modified_residues_.find(residue) != const_modified_residues_.end());
     } 
@@ -300,8 +301,8 @@ namespace OpenMS
   const set<String> ResidueDB::getResidueSets() const
   {
     set<String> rs;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       rs = residue_sets_; 
     }
     return rs;
@@ -383,77 +384,29 @@ namespace OpenMS
   const Residue* ResidueDB::getModifiedResidue(const Residue* residue, const String& modification)
   {
     OPENMS_PRECONDITION(!modification.empty(), "Modification cannot be empty")
-    // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res{};
-    bool residue_found(true), mod_found(true);
-    #pragma omp critical (ResidueDB)
+    if (!hasResidue(res_name))
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknown, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
-      {
-        if (residue_names_.find(res_name) == residue_names_.end())
-        {
-          residue_found = false;
-        }
-      }
-
-      if (residue_found)
-      {
-        const ResidueModification* mod{};
-        try
-        {
-          // terminal modifications don't apply to residues (side chain), so only consider internal ones
-          static const ModificationsDB* mdb = ModificationsDB::getInstance();
-          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
-        }
-        catch (...)
-        {
-          mod_found = false;
-        }
-
-        // check if modification in ResidueDB
-        if (mod_found)
-        {
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = const_cast<Residue*>(inner->second);
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_.at(res_name));
-            res->setModification(mod);
-            addResidue_(res);            
-          }
-        }
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
     }
 
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
-    if (!residue_found)
+    const ResidueModification* mod{};
+    try
     {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+      // terminal modifications don't apply to residues (side chain), so only consider internal ones
+      static const ModificationsDB* mdb = ModificationsDB::getInstance();
+      mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
     }
-    else if (!mod_found)
+    catch (...)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: ", modification);
     }
-    
+
+    const Residue* res = getOrAddModifiedResidue_(res_name, mod);
+    if (res == nullptr)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+    }
     return res;
   }
 
@@ -462,62 +415,64 @@ namespace OpenMS
     OPENMS_PRECONDITION(mod != nullptr, "Mod cannot be nullptr")
     OPENMS_PRECONDITION(mod->getTermSpecificity() == ResidueModification::ANYWHERE, "Mod's term specificity needs to be ANYWHERE to attach it to Residues");
     OPENMS_PRECONDITION(mod->getOrigin() == residue->getOneLetterCode()[0], "Mod's AA origin needs to match residues one-letter-code");
-    // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res{};
-    bool residue_found(true);
-    #pragma omp critical (ResidueDB)
+    const Residue* res = getOrAddModifiedResidue_(res_name, mod);
+    if (res == nullptr)
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknown, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+    }
+    return res;
+  }
+
+  const Residue* ResidueDB::findModifiedResidue_(const String& res_name, const String& mod_id) const
+  {
+    // Perform a single lookup of the residue name in our database, we assume
+    // that if it is present in residue_mod_names_ then we have seen it
+    // before and can directly grab it.
+    const auto& rm_entry = residue_mod_names_.find(res_name);
+    if (rm_entry != residue_mod_names_.end())
+    {
+      const auto& inner = rm_entry->second.find(mod_id);
+      if (inner != rm_entry->second.end())
       {
-        if (residue_names_.find(res_name) == residue_names_.end())
-        {
-          residue_found = false;
-        }
+        return inner->second;
       }
+    }
+    return nullptr;
+  }
 
-      if (residue_found)
+  const Residue* ResidueDB::getOrAddModifiedResidue_(const String& res_name, const ResidueModification* mod)
+  {
+    const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
+    {
+      // fast path: modified residues are created once and looked up very often (e.g. by AASequence::fromString)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      const Residue* res = findModifiedResidue_(res_name, id);
+      if (res != nullptr)
       {
-
-        // check if modification in ResidueDB
-        if (mod != nullptr)
-        {
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = const_cast<Residue*>(inner->second);
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_.at(res_name));
-            res->setModification(mod);
-            addResidue_(res);            
-          }
-        }
+        return res;
       }
     }
 
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
-    if (!residue_found)
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // another thread might have created it in the meantime
+    const Residue* found = findModifiedResidue_(res_name, id);
+    if (found != nullptr)
     {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+      return found;
     }
-    
+    // If the residue is not present in residue_mod_names_ we may have it as
+    // unmodified residue in residue_names_ but need to create a new entry as
+    // modified residue. If the residue itself is unknown, the caller will throw.
+    const auto& r_entry = residue_names_.find(res_name);
+    if (r_entry == residue_names_.end())
+    {
+      return nullptr;
+    }
+    // create and register this modified residue
+    Residue* res = new Residue(*r_entry->second);
+    res->setModification(mod);
+    addResidue_(res);
     return res;
   }
 }
@@ -179,7 +179,7 @@ namespace OpenMS
     term_spec_ = term_spec;
   }
 
-  const EmpiricalFormula Ribonucleotide::getBaselossFormula() const
+  const EmpiricalFormula& Ribonucleotide::getBaselossFormula() const
   {
     return baseloss_formula_;
   }
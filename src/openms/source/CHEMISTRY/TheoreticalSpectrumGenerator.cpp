@@ -260,6 +260,18 @@ namespace OpenMS
     spectrum.getPrecursors().push_back(prec);
   }
 
+  const TheoreticalSpectrumGenerator::IonOffsets_& TheoreticalSpectrumGenerator::getIonOffsets_()
+  {
+    static const IonOffsets_ offsets{
+      Residue::getInternalToAIon().getMonoWeight(),
+      Residue::getInternalToBIon().getMonoWeight(),
+      Residue::getInternalToCIon().getMonoWeight(),
+      Residue::getInternalToXIon().getMonoWeight(),
+      Residue::getInternalToYIon().getMonoWeight(),
+      Residue::getInternalToZIon().getMonoWeight()};
+    return offsets;
+  }
+
   MSSpectrum TheoreticalSpectrumGenerator::generateSpectrum(const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge)
   {
     if (precursor_charge == 0)
@@ -302,6 +314,37 @@ namespace OpenMS
     return theo_spectrum;
   }
 
+  void TheoreticalSpectrumGenerator::generateSpectrum(PeakSpectrum& spec, const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge)
+  {
+    bool by_ions = (fm == Precursor::ActivationMethod::CID || fm == Precursor::ActivationMethod::HCID || fm == Precursor::ActivationMethod::HCD);
+    if (!by_ions && fm != Precursor::ActivationMethod::ECD && fm != Precursor::ActivationMethod::ETD)
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Fragmentation method is not supported.");
+    }
+    if (precursor_charge == 0)
+    {
+      OPENMS_LOG_WARN << "Precursor charge can't be 0. Using 2 instead." << endl;
+      precursor_charge = 2;
+    }
+
+    // the default settings of generateSpectrum(): only the ion ladders, all with intensity 1
+    spec.clear(false);
+    auto emit = [&spec](double mz, char, Size) { spec.emplace_back(mz, 1.0); };
+    const Int max_charge = precursor_charge <= 2 ? 1 : 2;
+    for (Int z = 1; z <= max_charge; ++z)
+    {
+      if (by_ions)
+      {
+        generateFragments_<false, true, false, false, true, false>(seq, z, false, emit);
+      }
+      else
+      {
+        generateFragments_<false, false, true, false, false, true>(seq, z, false, emit);
+      }
+    }
+    spec.sortByPosition();
+  }
+
 
   void TheoreticalSpectrumGenerator::addAbundantImmoniumIons_(PeakSpectrum& spectrum, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges) const
   {
@@ -89,4 +89,52 @@ namespace OpenMS
     return static_cast<double>(s.nonZeros()) / denominator;
   }
 
+  void BinnedSharedPeakCount::computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries,
+                                                      const std::vector<BinnedSpectrum>& library,
+                                                      Matrix<double>& similarities) const
+  {
+    similarities.resize(queries.size(), library.size());
+    if (queries.empty() || library.empty()) return;
+
+    // size of the dense array: all query bins need to fit
+    Size max_index(0);
+    for (const BinnedSpectrum& q : queries)
+    {
+      const BinnedSpectrum::SparseVectorType& bins = *q.getBins();
+      if (bins.nonZeros() > 0) max_index = std::max(max_index, (Size)bins.innerIndexPtr()[bins.nonZeros() - 1]);
+    }
+
+#pragma omp parallel
+    {
+      // marks the filled bins of the current query
+      std::vector<char> filled(max_index + 1, 0);
+
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)queries.size(); ++i)
+      {
+        const BinnedSpectrum::SparseVectorType& q = *queries[i].getBins();
+        const int* q_idx = q.innerIndexPtr();
+        const Size q_nnz = q.nonZeros();
+        for (Size k = 0; k < q_nnz; ++k) filled[q_idx[k]] = 1;
+
+        for (Size j = 0; j < library.size(); ++j)
+        {
+          OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(queries[i], library[j]), "Binned spectra have different bin size or spread");
+          const BinnedSpectrum::SparseVectorType& l = *library[j].getBins();
+          const int* l_idx = l.innerIndexPtr();
+          const Size l_nnz = l.nonZeros();
+          Size shared(0);
+          for (Size k = 0; k < l_nnz && (Size)l_idx[k] <= max_index; ++k)
+          {
+            shared += filled[l_idx[k]];
+          }
+          similarities(i, j) = static_cast<double>(shared) / max(q_nnz, l_nnz);
+        }
+
+        // reset for the next query
+        for (Size k = 0; k < q_nnz; ++k) filled[q_idx[k]] = 0;
+      }
+    }
+  }
+
 }
@@ -87,5 +87,62 @@ namespace OpenMS
 
     return score;
   }
+
+  void BinnedSpectralContrastAngle::computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries,
+                                                            const std::vector<BinnedSpectrum>& library,
+                                                            Matrix<double>& similarities) const
+  {
+    similarities.resize(queries.size(), library.size());
+    if (queries.empty() || library.empty()) return;
+
+    // squared norms are needed for every pair: compute them once
+    std::vector<double> library_norms(library.size());
+    for (Size j = 0; j < library.size(); ++j)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(queries[0], library[j]), "Binned spectra have different bin size or spread");
+      library_norms[j] = library[j].getBins()->dot(*library[j].getBins());
+    }
+
+    // size of the dense array: all query bins need to fit
+    Size max_index(0);
+    for (const BinnedSpectrum& q : queries)
+    {
+      const BinnedSpectrum::SparseVectorType& bins = *q.getBins();
+      if (bins.nonZeros() > 0) max_index = std::max(max_index, (Size)bins.innerIndexPtr()[bins.nonZeros() - 1]);
+    }
+
+#pragma omp parallel
+    {
+      std::vector<float> dense(max_index + 1, 0.0f);
+
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)queries.size(); ++i)
+      {
+        const BinnedSpectrum::SparseVectorType& q = *queries[i].getBins();
+        const int* q_idx = q.innerIndexPtr();
+        const float* q_val = q.valuePtr();
+        const Size q_nnz = q.nonZeros();
+        for (Size k = 0; k < q_nnz; ++k) dense[q_idx[k]] = q_val[k];
+        const double query_norm = q.dot(q);
+
+        for (Size j = 0; j < library.size(); ++j)
+        {
+          const BinnedSpectrum::SparseVectorType& l = *library[j].getBins();
+          const int* l_idx = l.innerIndexPtr();
+          const float* l_val = l.valuePtr();
+          const Size l_nnz = l.nonZeros();
+          double numerator(0);
+          for (Size k = 0; k < l_nnz && (Size)l_idx[k] <= max_index; ++k)
+          {
+            numerator += dense[l_idx[k]] * l_val[k];
+          }
+          similarities(i, j) = numerator / sqrt(query_norm * library_norms[j]);
+        }
+
+        // reset the dense array for the next query
+        for (Size k = 0; k < q_nnz; ++k) dense[q_idx[k]] = 0.0f;
+      }
+    }
+  }
 }
 
@@ -67,6 +67,22 @@ namespace OpenMS
     return *this;
   }
 
+  void BinnedSpectrumCompareFunctor::computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries,
+                                                             const std::vector<BinnedSpectrum>& library,
+                                                             Matrix<double>& similarities) const
+  {
+    similarities.resize(queries.size(), library.size());
+
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)queries.size(); ++i)
+    {
+      for (Size j = 0; j < library.size(); ++j)
+      {
+        similarities(i, j) = operator()(queries[i], library[j]);
+      }
+    }
+  }
+
   void BinnedSpectrumCompareFunctor::registerChildren()
   {
     Factory<BinnedSpectrumCompareFunctor>::registerProduct(BinnedSharedPeakCount::getProductName(), &BinnedSharedPeakCount::create);
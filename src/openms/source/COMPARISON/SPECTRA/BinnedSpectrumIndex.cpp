@@ -0,0 +1,235 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  BinnedSpectrumIndex::BinnedSpectrumIndex(float bin_size, float offset, UInt bin_spread, Size peaks_per_entry) :
+    bin_size_(bin_size),
+    offset_(offset),
+    bin_spread_(bin_spread),
+    peaks_per_entry_(peaks_per_entry)
+  {
+    if (bin_size_ <= 0)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bin size must be positive.", String(bin_size_));
+    }
+  }
+
+  void BinnedSpectrumIndex::embed_(const PeakSpectrum& spectrum, vector<pair<UInt, float> >& embedding) const
+  {
+    embedding.clear();
+
+    vector<pair<float, double> > peaks; // (intensity, m/z)
+    peaks.reserve(spectrum.size());
+    for (const Peak1D& p : spectrum)
+    {
+      if (p.getIntensity() > 0 && p.getMZ() > 0) { peaks.emplace_back(p.getIntensity(), p.getMZ()); }
+    }
+
+    // keep the most intense peaks (ties resolved towards lower m/z)
+    if (peaks_per_entry_ > 0 && peaks.size() > peaks_per_entry_)
+    {
+      nth_element(peaks.begin(), peaks.begin() + peaks_per_entry_, peaks.end(),
+        [](const pair<float, double>& a, const pair<float, double>& b)
+        {
+          return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+      peaks.resize(peaks_per_entry_);
+    }
+
+    embedding.reserve(peaks.size());
+    for (const auto& p : peaks)
+    {
+      embedding.emplace_back(static_cast<UInt>(p.second / bin_size_ + offset_), p.first);
+    }
+    sort(embedding.begin(), embedding.end());
+
+    // sum up peaks that fall into the same bin
+    Size n = 0;
+    for (Size i = 0; i < embedding.size(); ++i)
+    {
+      if (n > 0 && embedding[n - 1].first == embedding[i].first)
+      {
+        embedding[n - 1].second += embedding[i].second;
+      }
+      else
+      {
+        embedding[n++] = embedding[i];
+      }
+    }
+    embedding.resize(n);
+
+    double norm = 0;
+    for (const auto& e : embedding) { norm += static_cast<double>(e.second) * e.second; }
+    if (norm > 0)
+    {
+      const float inv_norm = static_cast<float>(1.0 / sqrt(norm));
+      for (auto& e : embedding) { e.second *= inv_norm; }
+    }
+  }
+
+  void BinnedSpectrumIndex::build(const vector<PeakSpectrum>& library)
+  {
+    const Size n = library.size();
+    precursor_mz_.resize(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      if (library[i].getPrecursors().empty())
+      {
+        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Library spectrum " + String(i) + " has no precursor.");
+      }
+      precursor_mz_[i] = library[i].getPrecursors()[0].getMZ();
+    }
+
+    // order entries by precursor m/z (stable, so equal precursors keep their input order)
+    rank_to_index_.resize(n);
+    iota(rank_to_index_.begin(), rank_to_index_.end(), 0);
+    stable_sort(rank_to_index_.begin(), rank_to_index_.end(),
+      [this](Size a, Size b) { return precursor_mz_[a] < precursor_mz_[b]; });
+    vector<double> sorted_mz(n);
+    for (Size r = 0; r < n; ++r) { sorted_mz[r] = precursor_mz_[rank_to_index_[r]]; }
+    precursor_mz_.swap(sorted_mz);
+
+    // embed all entries
+    vector<vector<pair<UInt, float> > > embeddings(n);
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize r = 0; r < (SignedSize)n; ++r)
+    {
+      embed_(library[rank_to_index_[r]], embeddings[r]);
+    }
+
+    // counting sort of all (bin, rank) pairs into the posting lists
+    Size n_bins = 0;
+    for (const auto& emb : embeddings)
+    {
+      if (!emb.empty()) { n_bins = max(n_bins, static_cast<Size>(emb.back().first) + 1); }
+    }
+    bin_offsets_.assign(n_bins + 1, 0);
+    for (const auto& emb : embeddings)
+    {
+      for (const auto& e : emb) { ++bin_offsets_[e.first + 1]; }
+    }
+    partial_sum(bin_offsets_.begin(), bin_offsets_.end(), bin_offsets_.begin());
+
+    postings_.resize(bin_offsets_.back());
+    vector<Size> fill(bin_offsets_.begin(), bin_offsets_.end() - 1);
+    for (Size r = 0; r < n; ++r)
+    {
+      for (const auto& e : embeddings[r])
+      {
+        postings_[fill[e.first]++] = Posting{static_cast<UInt>(r), e.second};
+      }
+      vector<pair<UInt, float> >().swap(embeddings[r]);
+    }
+  }
+
+  void BinnedSpectrumIndex::query(const PeakSpectrum& spectrum, double precursor_mz_low, double precursor_mz_high, Size k, vector<Size>& candidates) const
+  {
+    candidates.clear();
+    const Size lo = lower_bound(precursor_mz_.begin(), precursor_mz_.end(), precursor_mz_low) - precursor_mz_.begin();
+    const Size hi = upper_bound(precursor_mz_.begin(), precursor_mz_.end(), precursor_mz_high) - precursor_mz_.begin();
+    if (lo >= hi) { return; }
+
+    // small window: nothing to prune
+    if (hi - lo <= k)
+    {
+      candidates.assign(rank_to_index_.begin() + lo, rank_to_index_.begin() + hi);
+      return;
+    }
+
+    vector<pair<UInt, float> > embedding;
+    embed_(spectrum, embedding);
+
+    // accumulate approximate cosine similarity over the posting lists restricted to the window
+    vector<float> scores(hi - lo, 0.0f);
+    vector<UInt> touched;
+    const Size n_bins = bin_offsets_.size() - 1;
+    for (const auto& e : embedding)
+    {
+      const Size first_bin = e.first > bin_spread_ ? e.first - bin_spread_ : 0;
+      const Size last_bin = min(static_cast<Size>(e.first) + bin_spread_ + 1, n_bins);
+      for (Size b = first_bin; b < last_bin; ++b)
+      {
+        auto it = lower_bound(postings_.begin() + bin_offsets_[b], postings_.begin() + bin_offsets_[b + 1], lo,
+          [](const Posting& p, Size rank) { return p.rank < rank; });
+        const auto end = postings_.begin() + bin_offsets_[b + 1];
+        for (; it != end && it->rank < hi; ++it)
+        {
+          float& score = scores[it->rank - lo];
+          if (score == 0.0f) { touched.push_back(it->rank); }
+          score += e.second * it->weight;
+        }
+      }
+    }
+
+    // select the best k entries (ties resolved towards lower precursor m/z)
+    if (touched.size() > k)
+    {
+      nth_element(touched.begin(), touched.begin() + k, touched.end(),
+        [&scores, lo](UInt a, UInt b)
+        {
+          const float sa = scores[a - lo], sb = scores[b - lo];
+          return sa > sb || (sa == sb && a < b);
+        });
+      touched.resize(k);
+    }
+    sort(touched.begin(), touched.end());
+
+    candidates.reserve(touched.size());
+    for (UInt r : touched) { candidates.push_back(rank_to_index_[r]); }
+  }
+
+  Size BinnedSpectrumIndex::size() const
+  {
+    return rank_to_index_.size();
+  }
+
+  Size BinnedSpectrumIndex::getNumberOfPostings() const
+  {
+    return postings_.size();
+  }
+
+} // namespace OpenMS
@@ -84,14 +84,22 @@ namespace OpenMS
 
     OPENMS_PRECONDITION(!(use_linear_factor && use_gaussian_factor), "SpectrumAlignmentScore, use either 'use_linear_factor' or 'use_gaussian_factor")
 
-    SpectrumAlignment aligner;
-    Param p;
-    p.setValue("tolerance", tolerance);
-    p.setValue("is_relative_tolerance", param_.getValue("is_relative_tolerance"));
-    aligner.setParameters(p);
+    if (!s1.isSorted() || !s2.isSorted())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Input to SpectrumAlignment is not sorted!");
+    }
 
+    // same alignment as SpectrumAlignment with our tolerance settings, without setting up a parameter handler per call
     vector<pair<Size, Size>> alignment;
-    aligner.getSpectrumAlignment(alignment, s1, s2);
+    if (is_relative_tolerance)
+    {
+      SpectrumAlignment::getClosestPeakMatches(alignment, s1, s2, tolerance, true);
+    }
+    else
+    {
+      SpectrumAlignment::Workspace ws;
+      SpectrumAlignment::getBandedAlignment(alignment, s1, s2, tolerance, ws);
+    }
 
     double score(0), sum(0);
     
@@ -51,6 +51,8 @@
 
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <thread>
 
 #define BUFFER_LENGTH 32768
 
@@ -285,24 +287,7 @@ namespace OpenMS
               std::swap(outstring, incomplete_line_); // init outstring, while resetting incomplete_line_
               outstring += &(buf[0]);
 
-              // avoid adding empty lines to the cache
-              if (outstring.empty())
-              {
-                distribute_(outstring);
-              }
-                // check if we have already seen this log message
-              else if (!isInCache_(outstring))
-              {
-                // add line to the log cache
-                std::string extra_message = addToCache_(outstring);
-
-                // send outline (and extra_message) to attached streams
-                if (!extra_message.empty())
-                {
-                  distribute_(extra_message);
-                }
-                distribute_(outstring);
-              }
+              processLine_(std::move(outstring));
 
               // update the line pointers (increment both)
               line_start = ++line_end;
@@ -315,13 +300,80 @@ namespace OpenMS
       return 0;
     }
 
+    void LogStreamBuf::processLine_(std::string line)
+    {
+      // avoid adding empty lines to the cache
+      if (line.empty())
+      {
+        distribute_(line);
+      }
+        // check if we have already seen this log message
+      else if (!isInCache_(line))
+      {
+        // add line to the log cache
+        std::string extra_message = addToCache_(line);
+
+        // send outline (and extra_message) to attached streams
+        if (!extra_message.empty())
+        {
+          distribute_(extra_message);
+        }
+        distribute_(line);
+      }
+    }
+
     int LogStreamBuf::sync()
     {
-      int ret = 0;
+      std::lock_guard<std::mutex> lock(sync_mutex_);
+      return syncLF_();
+    }
 
-        ret = syncLF_();
-      
-      return ret;
+    ThreadLogStreamBuf::ThreadLogStreamBuf(LogStreamBuf * target) :
+      LogStreamBuf(target->level_),
+      target_(target),
+      pending_()
+    {
+    }
+
+    ThreadLogStreamBuf::~ThreadLogStreamBuf()
+    {
+      sync();
+      if (!pending_.empty())
+      {
+        // terminate the last line, so it is not lost
+        pending_ += '\n';
+        sync();
+      }
+    }
+
+    int ThreadLogStreamBuf::sync()
+    {
+      // collect the put area without any locking
+      pending_.append(pbase(), pptr());
+      pbump((int) (pbase() - pptr()));
+
+      const std::string::size_type last_lf = pending_.rfind('\n');
+      if (last_lf == std::string::npos)
+      {
+        return 0;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(target_->sync_mutex_);
+        // like LogStreamBuf::syncLF_, do not prepare output nobody will see
+        if (!target_->stream_list_.empty())
+        {
+          std::string::size_type line_start = 0;
+          while (line_start <= last_lf)
+          {
+            const std::string::size_type line_end = pending_.find('\n', line_start);
+            target_->processLine_(pending_.substr(line_start, line_end - line_start));
+            line_start = line_end + 1;
+          }
+        }
+      }
+      pending_.erase(0, last_lf + 1);
+      return 0;
     }
 
     string LogStreamBuf::expandPrefix_
@@ -561,7 +613,33 @@ namespace OpenMS
   // global StreamHandler
   OPENMS_DLLAPI StreamHandler STREAM_HANDLER;
 
+  namespace Logger
+  {
+    namespace
+    {
+      // the thread initializing the library writes to the global streams directly; must be defined before them
+      const std::thread::id log_owner_thread = std::this_thread::get_id();
+    }
+
+    LogStream & threadLocalStream(LogStream & global)
+    {
+      if (std::this_thread::get_id() == log_owner_thread)
+      {
+        return global;
+      }
+      // one stream per global stream and thread; destroyed (and flushed) when the thread exits
+      thread_local std::map<LogStream *, std::unique_ptr<LogStream> > thread_streams;
+      std::unique_ptr<LogStream> & stream = thread_streams[&global];
+      if (stream == nullptr)
+      {
+        stream.reset(new LogStream(new ThreadLogStreamBuf(global.rdbuf()), true));
+      }
+      return *stream;
+    }
+  }
+
   // global default logstream
+
   OPENMS_DLLAPI Logger::LogStream OpenMS_Log_fatal(new Logger::LogStreamBuf("FATAL_ERROR"), true, &cerr);
   OPENMS_DLLAPI Logger::LogStream OpenMS_Log_error(new Logger::LogStreamBuf("ERROR"), true, &cerr);
   OPENMS_DLLAPI Logger::LogStream OpenMS_Log_warn(new Logger::LogStreamBuf("WARNING"), true, &cout);
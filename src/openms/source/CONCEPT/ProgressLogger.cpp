@@ -101,9 +101,7 @@ public:
     }
     SignedSize nextProgress() const override
     {
-      #pragma omp atomic
-      ++current_;
-      return current_;
+      return ++current_;
     }
 
     void endProgress(const int current_recursion_depth) const override
@@ -120,7 +118,7 @@ private:
     mutable StopWatch stop_watch_;
     mutable SignedSize begin_;
     mutable SignedSize end_;
-    mutable SignedSize current_;
+    mutable std::atomic<SignedSize> current_;
   };
 
   class NoProgressLoggerImpl :
@@ -197,14 +195,14 @@ public:
 
   ProgressLogger::ProgressLogger() :
     type_(NONE),
-    last_invoke_()
+    last_invoke_(0)
   {
     current_logger_ = Factory<ProgressLogger::ProgressLoggerImpl>::create(logTypeToFactoryName_(type_));
   }
 
   ProgressLogger::ProgressLogger(const ProgressLogger& other) :
     type_(other.type_),
-    last_invoke_(other.last_invoke_)
+    last_invoke_(other.last_invoke_.load())
   {
     // recreate our logger
     current_logger_ = Factory<ProgressLogger::ProgressLoggerImpl>::create(logTypeToFactoryName_(type_));
@@ -217,7 +215,7 @@ public:
       return *this;
     }
 
-    this->last_invoke_ = other.last_invoke_;
+    this->last_invoke_ = other.last_invoke_.load();
     this->type_ = other.type_;
 
     // we clean our old logger
@@ -256,27 +254,38 @@ public:
     ++recursion_depth_;
   }
 
+  bool ProgressLogger::claimUpdate_() const
+  {
+    // update only if at least 1 second has passed; if several threads
+    // notice that at the same time, only the one swapping in 'now' renders
+    const time_t now = time(nullptr);
+    time_t last = last_invoke_.load(std::memory_order_relaxed);
+    return last != now && last_invoke_.compare_exchange_strong(last, now, std::memory_order_relaxed);
+  }
+
   void ProgressLogger::setProgress(SignedSize value) const
   {
-    // update only if at least 1 second has passed
-    if (last_invoke_ == time(nullptr))
+    if (type_ == NONE)
     {
       return;
     }
-    last_invoke_ = time(nullptr);
-    current_logger_->setProgress(value, recursion_depth_);
+    if (claimUpdate_())
+    {
+      current_logger_->setProgress(value, recursion_depth_);
+    }
   }
+
   void ProgressLogger::nextProgress() const
   {
-    auto p = current_logger_->nextProgress();
-    // update only if at least 1 second has passed
-    if (last_invoke_ == time(nullptr))
+    if (type_ == NONE)
     {
       return;
     }
-
-    last_invoke_ = time(nullptr);
-    current_logger_->setProgress(p, recursion_depth_);
+    const SignedSize p = current_logger_->nextProgress();
+    if (claimUpdate_())
+    {
+      current_logger_->setProgress(p, recursion_depth_);
+    }
   }
 
   void ProgressLogger::endProgress() const
@@ -188,17 +188,25 @@ namespace OpenMS
   {
     outer_points_.clear();
 
-    if (map_points_.find(point[0]) != map_points_.end())
+    // points are usually added in ascending RT order: a new last scan is appended without a search
+    if (!map_points_.empty() && map_points_.rbegin()->first < point[0])
     {
-      if (map_points_.at(point[0]).encloses(point[1]))
+      map_points_.emplace_hint(map_points_.end(), point[0], DBoundingBox<1>(point[1], point[1]));
+      return true;
+    }
+
+    HullPointType::iterator it = map_points_.lower_bound(point[0]);
+    if (it != map_points_.end() && it->first == point[0])
+    {
+      if (it->second.encloses(point[1]))
       {
         return false;
       }
-      map_points_[point[0]].enlarge(point[1]);
+      it->second.enlarge(point[1]);
     }
     else
     {
-      map_points_[point[0]] = DBoundingBox<1>(point[1], point[1]);
+      map_points_.emplace_hint(it, point[0], DBoundingBox<1>(point[1], point[1]));
     }
 
     return true;
@@ -206,6 +214,10 @@ namespace OpenMS
 
   void ConvexHull2D::addPoints(const PointArrayType& points)
   {
+    if (map_points_.empty())
+    {
+      map_points_.reserve(points.size());
+    }
     for (PointArrayTypeConstIterator it = points.begin(); it != points.end(); ++it)
     {
       addPoint(*it);
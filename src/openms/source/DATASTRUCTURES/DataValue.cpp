@@ -39,6 +39,7 @@
 
 #include <QtCore/QString>
 
+#include <cstring>
 #include <sstream>
 
 using namespace std;
@@ -144,25 +145,26 @@ namespace OpenMS
   DataValue::DataValue(const char* p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p, strlen(p));
   }
 
   DataValue::DataValue(const string& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p.data(), p.size());
   }
 
   DataValue::DataValue(const QString& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    const String s(p);
+    setString_(s.data(), s.size());
   }
 
   DataValue::DataValue(const String& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p.data(), p.size());
   }
 
   DataValue::DataValue(const StringList& p) :
@@ -201,7 +203,7 @@ namespace OpenMS
     break;
     case ParamValue::STRING_VALUE:
         value_type_ = STRING_VALUE;
-        data_.str_ = new String(p.toChar());
+        setString_(p.toChar(), strlen(p.toChar()));
     break;
     case ParamValue::INT_LIST:
         value_type_ = INT_LIST;
@@ -224,10 +226,11 @@ namespace OpenMS
   DataValue::DataValue(const DataValue& p) :
     value_type_(p.value_type_),
     unit_type_(p.unit_type_),
+    str_inline_(p.str_inline_),
     unit_(p.unit_),
     data_(p.data_)
   {
-    if (value_type_ == STRING_VALUE)
+    if (value_type_ == STRING_VALUE && !str_inline_)
     {
       data_.str_ = new String(*(p.data_.str_));
     }
@@ -248,6 +251,7 @@ namespace OpenMS
   DataValue::DataValue(DataValue&& rhs) noexcept :
     value_type_(std::move(rhs.value_type_)),
     unit_type_(std::move(rhs.unit_type_)),
+    str_inline_(rhs.str_inline_),
     unit_(std::move(rhs.unit_)),
     data_(std::move(rhs.data_))
   {
@@ -255,6 +259,7 @@ namespace OpenMS
     // NOTE: value_type_ == EMPTY_VALUE implies data_ is empty and can be reset
     rhs.value_type_ = EMPTY_VALUE;
     rhs.unit_type_ = OTHER;
+    rhs.str_inline_ = 0;
     rhs.unit_ = -1;
   }
 
@@ -264,7 +269,7 @@ namespace OpenMS
     {
       delete(data_.str_list_);
     }
-    else if (value_type_ == STRING_VALUE)
+    else if (value_type_ == STRING_VALUE && !str_inline_)
     {
       delete(data_.str_);
     }
@@ -279,9 +284,34 @@ namespace OpenMS
 
     value_type_ = EMPTY_VALUE;
     unit_type_ = OTHER;
+    str_inline_ = 0;
     unit_ = -1;
   }
 
+  void DataValue::setString_(const char* s, Size length)
+  {
+    if (length < sizeof(data_.small_str_))
+    {
+      memcpy(data_.small_str_, s, length);
+      data_.small_str_[length] = '\0';
+      str_inline_ = static_cast<unsigned char>(length + 1);
+    }
+    else
+    {
+      data_.str_ = new String(s, length);
+      str_inline_ = 0;
+    }
+  }
+
+  std::string_view DataValue::strView_() const noexcept
+  {
+    if (str_inline_)
+    {
+      return std::string_view(data_.small_str_, str_inline_ - 1);
+    }
+    return std::string_view(*data_.str_);
+  }
+
   //--------------------------------------------------------------------
   //                    copy and move assignment operators
   //--------------------------------------------------------------------
@@ -301,7 +331,7 @@ namespace OpenMS
     {
       data_.str_list_ = new StringList(*(p.data_.str_list_));
     }
-    else if (p.value_type_ == STRING_VALUE)
+    else if (p.value_type_ == STRING_VALUE && !p.str_inline_)
     {
       data_.str_ = new String(*(p.data_.str_));
     }
@@ -321,6 +351,7 @@ namespace OpenMS
     // copy type
     value_type_ = p.value_type_;
     unit_type_ = p.unit_type_;
+    str_inline_ = p.str_inline_;
     unit_ = p.unit_;
 
     return *this;
@@ -342,11 +373,13 @@ namespace OpenMS
     data_ = rhs.data_;
     value_type_ = rhs.value_type_;
     unit_type_ = rhs.unit_type_;
+    str_inline_ = rhs.str_inline_;
     unit_ = rhs.unit_;
 
     // clean up rhs 
     rhs.value_type_ = EMPTY_VALUE;
     rhs.unit_type_ = OTHER;
+    rhs.str_inline_ = 0;
     rhs.unit_ = -1;
 
     return *this;
@@ -359,7 +392,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const char* arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    setString_(arg, strlen(arg));
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -367,7 +400,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const std::string& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    setString_(arg.data(), arg.size());
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -375,7 +408,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const String& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    setString_(arg.data(), arg.size());
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -383,7 +416,8 @@ namespace OpenMS
   DataValue& DataValue::operator=(const QString& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    const String s(arg);
+    setString_(s.data(), s.size());
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -678,7 +712,7 @@ namespace OpenMS
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
         "Could not convert non-string DataValue of type '" + NamesOfDataType[value_type_] + "' and value '" + this->toString(true) + "' to string");
     }
-    return *(data_.str_);
+    return std::string(strView_());
   }
 
   DataValue::operator StringList() const
@@ -702,7 +736,7 @@ namespace OpenMS
     switch (value_type_)
     {
     case DataValue::STRING_VALUE: 
-      return const_cast<const char*>(data_.str_->c_str());
+      return str_inline_ ? data_.small_str_ : data_.str_->c_str();
 
     case DataValue::EMPTY_VALUE: 
       return nullptr;
@@ -752,7 +786,7 @@ namespace OpenMS
       case DataValue::EMPTY_VALUE: 
         break;
       case DataValue::STRING_VALUE: 
-        return *(data_.str_);
+        return String(strView_());
       case DataValue::STRING_LIST: ss << *(data_.str_list_); 
         break;
       case DataValue::INT_LIST: ss << *(data_.int_list_); 
@@ -792,14 +826,14 @@ namespace OpenMS
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
         "Could not convert non-string DataValue of type '" + NamesOfDataType[value_type_] + "' and value '" + this->toString(true) + "' to bool");
     }
-    else if (*(data_.str_) != "true" &&  *(data_.str_) != "false")
+    else if (strView_() != "true" && strView_() != "false")
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
         String("Could not convert non-string DataValue of type '") + NamesOfDataType[value_type_] + 
-        "' and value '" + *(data_.str_) + "' to bool. Valid stings are 'true' and 'false'.");
+        "' and value '" + toString() + "' to bool. Valid stings are 'true' and 'false'.");
     }
 
-    return *(data_.str_) == "true";
+    return strView_() == "true";
   }
 
   // ----------------- Comparator ----------------------
@@ -812,7 +846,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return b.value_type_ == DataValue::EMPTY_VALUE;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) == *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.strView_() == b.strView_();
 
       case DataValue::STRING_LIST: return *(a.data_.str_list_) == *(b.data_.str_list_);
 
@@ -838,7 +872,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) < *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.strView_() < b.strView_();
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() < b.data_.str_list_->size();
 
@@ -864,7 +898,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) > *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.strView_() > b.strView_();
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() > b.data_.str_list_->size();
 
@@ -895,7 +929,7 @@ namespace OpenMS
   {
     switch (p.value_type_)
     {
-    case DataValue::STRING_VALUE: os << *(p.data_.str_); break;
+    case DataValue::STRING_VALUE: os << p.strView_(); break;
 
     case DataValue::STRING_LIST: os << *(p.data_.str_list_); break;
 
@@ -181,6 +181,25 @@ namespace OpenMS
     Int max_pq = q_max_; //maximal number of positive adduct-charges for a compomer
     //Int max_nq = q_max_; //maximal number of negative adduct-charges for a compomer
 
+    // Adding an adduct never lowers the positive or negative charge count of a compomer and, as long as all
+    // adduct probabilities are <= 1, never raises its log probability. Compomers violating one of these limits
+    // can therefore not become valid by combining them further and are not enumerated at all.
+    // (The net charge limit is not monotonic and is only checked after enumeration.)
+    bool prune_by_log_p = true;
+    for (AdductsType::const_iterator it = adduct_charged.begin(); it != adduct_charged.end(); ++it)
+    {
+      if (it->getLogProb() > 0)
+      {
+        prune_by_log_p = false;
+      }
+    }
+    auto extensible = [&](const Compomer& cmp)
+    {
+      return (!prune_by_log_p || cmp.getLogP() >= thresh_p_)
+             && cmp.getNegativeCharges() <= q_max_
+             && cmp.getPositiveCharges() <= q_max_;
+    };
+
     for (AdductsType::const_iterator it = adduct_charged.begin(); it != adduct_charged.end(); ++it)
     {
       std::vector<Adduct> new_adducts;
@@ -210,11 +229,17 @@ namespace OpenMS
         {
           Compomer cmpl(explanations_[ci]);
           cmpl.add(*new_it, Compomer::LEFT);
-          explanations_.push_back(cmpl);
+          if (extensible(cmpl))
+          {
+            explanations_.push_back(cmpl);
+          }
 
           Compomer cmpr(explanations_[ci]);
           cmpr.add(*new_it, Compomer::RIGHT);
-          explanations_.push_back(cmpr);
+          if (extensible(cmpr))
+          {
+            explanations_.push_back(cmpr);
+          }
         }
       }
       // finally add new compomers to the list itself
@@ -222,11 +247,17 @@ namespace OpenMS
       {
         Compomer cmpl;
         cmpl.add(*new_it, Compomer::LEFT);
-        explanations_.push_back(cmpl);
+        if (extensible(cmpl))
+        {
+          explanations_.push_back(cmpl);
+        }
 
         Compomer cmpr;
         cmpr.add(*new_it, Compomer::RIGHT);
-        explanations_.push_back(cmpr);
+        if (extensible(cmpr))
+        {
+          explanations_.push_back(cmpr);
+        }
       }
 
       OPENMS_LOG_DEBUG << "valid explanations: " << explanations_.size() << " after " << it->getFormula() << std::endl;
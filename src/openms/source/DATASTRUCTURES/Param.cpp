@@ -314,19 +314,32 @@ namespace OpenMS
 
   Param::ParamEntry* Param::ParamNode::findEntryRecursive(const std::string& local_name)
   {
-    ParamNode* parent = findParentOf(local_name);
-    if (parent == nullptr)
+    // walk down the sections of the key in place (same result as findParentOf() + findEntry(), without copying substrings)
+    ParamNode* node = this;
+    size_t start = 0;
+    size_t pos;
+    while ((pos = local_name.find(':', start)) != std::string::npos)
     {
-      return nullptr;
+      const size_t length = pos - start;
+      NodeIterator it = std::find_if(node->nodes.begin(), node->nodes.end(),
+        [&](const ParamNode& n) { return n.name.size() == length && local_name.compare(start, length, n.name) == 0; });
+      if (it == node->nodes.end())
+      {
+        return nullptr;
+      }
+      node = &(*it);
+      start = pos + 1;
     }
 
-    EntryIterator it = parent->findEntry(suffix(local_name));
-    if (it == parent->entries.end())
+    const size_t length = local_name.size() - start;
+    for (ParamEntry& entry : node->entries)
     {
-      return nullptr;
+      if (entry.name.size() == length && local_name.compare(start, length, entry.name) == 0)
+      {
+        return &entry;
+      }
     }
-
-    return &(*it);
+    return nullptr;
   }
 
   void Param::ParamNode::insert(const ParamNode& node, const std::string& prefix)
@@ -449,6 +462,73 @@ namespace OpenMS
     return key;
   }
 
+  //********************************* Param::EntryIndex_ **************************************
+
+  Param::EntryIndex_::EntryIndex_(const EntryIndex_&)
+  {
+  }
+
+  Param::EntryIndex_::EntryIndex_(EntryIndex_&& rhs)
+  {
+    // the entries now belong to another Param
+    rhs.invalidate();
+  }
+
+  Param::EntryIndex_& Param::EntryIndex_::operator=(const EntryIndex_&)
+  {
+    invalidate();
+    return *this;
+  }
+
+  Param::EntryIndex_& Param::EntryIndex_::operator=(EntryIndex_&& rhs)
+  {
+    invalidate();
+    rhs.invalidate();
+    return *this;
+  }
+
+  Param::ParamEntry* Param::EntryIndex_::find(const std::string& key, ParamNode& root) const
+  {
+    std::shared_ptr<const Map> map = std::atomic_load(&map_);
+    if (map == nullptr)
+    {
+      if (++lookups_ < BUILD_AFTER)
+      {
+        return root.findEntryRecursive(key);
+      }
+
+      // collect all entries with their full names (first one wins, like the tree walk)
+      std::shared_ptr<Map> new_map = std::make_shared<Map>();
+      std::vector<std::pair<ParamNode*, std::string> > stack(1, std::make_pair(&root, std::string()));
+      while (!stack.empty())
+      {
+        ParamNode* node = stack.back().first;
+        const std::string prefix = std::move(stack.back().second);
+        stack.pop_back();
+        for (ParamEntry& entry : node->entries)
+        {
+          new_map->emplace(prefix + entry.name, &entry);
+        }
+        for (ParamNode::NodeIterator it = node->nodes.end(); it != node->nodes.begin(); )
+        {
+          --it;
+          stack.emplace_back(&(*it), prefix + it->name + ':');
+        }
+      }
+      map = new_map;
+      std::atomic_store(&map_, map);
+    }
+
+    Map::const_iterator it = map->find(key);
+    return it == map->end() ? nullptr : it->second;
+  }
+
+  void Param::EntryIndex_::invalidate()
+  {
+    std::atomic_store(&map_, std::shared_ptr<const Map>());
+    lookups_ = 0;
+  }
+
   //********************************* Param **************************************
 
   Param::Param() :
@@ -475,6 +555,7 @@ namespace OpenMS
   void Param::setValue(const std::string& key, const ParamValue& value, const std::string& description, const std::vector<std::string>& tags)
   {
     root_.insert(ParamEntry("", value, description, tags), key);
+    index_.invalidate();
   }
 
   void Param::setValidStrings(const std::string& key, const std::vector<std::string>& strings)
@@ -552,6 +633,26 @@ namespace OpenMS
     return getEntry_(key).value;
   }
 
+  double Param::getDouble(const std::string& key) const
+  {
+    return getEntry_(key).value;
+  }
+
+  int Param::getInt(const std::string& key) const
+  {
+    return getEntry_(key).value;
+  }
+
+  bool Param::getBool(const std::string& key) const
+  {
+    return getEntry_(key).value.toBool();
+  }
+
+  std::string Param::getString(const std::string& key) const
+  {
+    return getEntry_(key).value;
+  }
+
   const std::string& Param::getSectionDescription(const std::string& key) const
   {
     //This variable is used instead of String::EMPTY as the method is used in
@@ -579,10 +680,12 @@ namespace OpenMS
     for (Param::ParamNode::NodeIterator it = param.root_.nodes.begin(); it != param.root_.nodes.end(); ++it)
     {
       root_.insert(*it, prefix);
+      index_.invalidate();
     }
     for (Param::ParamNode::EntryIterator it = param.root_.entries.begin(); it != param.root_.entries.end(); ++it)
     {
       root_.insert(*it, prefix);
+      index_.invalidate();
     }
   }
 
@@ -606,6 +709,7 @@ namespace OpenMS
           std::cerr << "Setting " << prefix2 + it.getName() << " to " << it->value << std::endl;
         std::string name = prefix2 + it.getName();
         root_.insert(ParamEntry("", it->value, it->description), name);
+        index_.invalidate();
         //copy tags
         for (std::set<std::string>::const_iterator tag_it = it->tags.begin(); tag_it != it->tags.end(); ++tag_it)
         {
@@ -671,6 +775,7 @@ namespace OpenMS
         {
           std::string name = it->name;
           node_parent->nodes.erase(it); // will automatically delete subnodes
+          index_.invalidate();
           if (node_parent->nodes.empty()  && node_parent->entries.empty())
           {
             // delete last section name (could be partial)
@@ -689,6 +794,7 @@ namespace OpenMS
         if (it != node->entries.end())
         {
           node->entries.erase(it); // delete entry
+          index_.invalidate();
           if (node->nodes.empty()  && node->entries.empty())
           {
             // delete if section is now empty
@@ -711,6 +817,7 @@ namespace OpenMS
         {
           std::string name = it->name;
           node->nodes.erase(it); // will automatically delete subnodes
+          index_.invalidate();
           if (node->nodes.empty()  && node->entries.empty())
           {
             // delete last section name (could be partial)
@@ -731,6 +838,7 @@ namespace OpenMS
           if (it->name.compare(0, suffix.length(), suffix) == 0)
           {
             it = node->nodes.erase(it);
+            index_.invalidate();
           }
           else if (it != node->nodes.end())
           {
@@ -742,6 +850,7 @@ namespace OpenMS
           if (it->name.compare(0, suffix.size(), suffix) == 0)
           {
             it = node->entries.erase(it);
+            index_.invalidate();
           }
           else if (it != node->entries.end())
           {
@@ -893,11 +1002,13 @@ namespace OpenMS
       if (arg_is_option && arg1_is_option)
       {
         root_.insert(ParamEntry(arg, std::string(), ""), prefix2);
+        index_.invalidate();
       }
       //option with argument
       else if (arg_is_option && !arg1_is_option)
       {
         root_.insert(ParamEntry(arg, arg1, ""), prefix2);
+        index_.invalidate();
         ++i;
       }
       //just text arguments (not preceded by an option)
@@ -911,6 +1022,7 @@ namespace OpenMS
           sl.push_back(arg);
           // create "misc"-Node:
           root_.insert(ParamEntry("misc", sl, ""), prefix2);
+          index_.invalidate();
         }
         else
         {
@@ -961,6 +1073,7 @@ namespace OpenMS
         if (arg1_is_option)
         {
           root_.insert(ParamEntry("", std::vector<std::string>(), ""), options_with_multiple_argument.find(arg)->second);
+          index_.invalidate();
         }
         //next argument is not an option
         else
@@ -978,6 +1091,7 @@ namespace OpenMS
           }
 
           root_.insert(ParamEntry("", sl, ""), options_with_multiple_argument.find(arg)->second);
+          index_.invalidate();
           i = j - 1;
         }
       }
@@ -985,6 +1099,7 @@ namespace OpenMS
       else if (options_without_argument.find(arg) != options_without_argument.end())
       {
         root_.insert(ParamEntry("", "true", ""), options_without_argument.find(arg)->second);
+        index_.invalidate();
       }
       //with one argument
       else if (options_with_one_argument.find(arg) != options_with_one_argument.end())
@@ -993,6 +1108,7 @@ namespace OpenMS
         if (!arg1_is_option)
         {
           root_.insert(ParamEntry("", arg1, ""), options_with_one_argument.find(arg)->second);
+          index_.invalidate();
           ++i;
         }
         //next argument is an option
@@ -1000,6 +1116,7 @@ namespace OpenMS
         {
 
           root_.insert(ParamEntry("", std::string(), ""), options_with_one_argument.find(arg)->second);
+          index_.invalidate();
         }
       }
       //unknown option
@@ -1011,6 +1128,7 @@ namespace OpenMS
           std::vector<std::string> sl;
           sl.push_back(arg);
           root_.insert(ParamEntry("", sl, ""), unknown);
+          index_.invalidate();
         }
         else
         {
@@ -1029,6 +1147,7 @@ namespace OpenMS
           sl.push_back(arg);
           // create "misc"-Node:
           root_.insert(ParamEntry("", sl, ""), misc);
+          index_.invalidate();
         }
         else
         {
@@ -1072,6 +1191,7 @@ namespace OpenMS
   void Param::clear()
   {
     root_ = ParamNode("ROOT", "");
+    index_.invalidate();
   }
 
   void Param::checkDefaults(const std::string& name, const Param& defaults, const std::string& prefix) const
@@ -1310,6 +1430,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
               prefix = it.getName().substr(0, 1 + it.getName().find_last_of(':'));
             }
             this->root_.insert(local_entry, prefix); //->setValue(it.getName(), local_entry.value, local_entry.description, local_entry.tags);
+            index_.invalidate();
           }
           else if (verbose)
           {
@@ -1402,6 +1523,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
         Param::ParamEntry entry = *it;
         OPENMS_LOG_DEBUG << "[Param::merge] merging " << it.getName() << std::endl;
         this->root_.insert(entry, prefix);
+        index_.invalidate();
       }
 
       //copy section descriptions
@@ -1454,6 +1576,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
   void Param::addSection(const std::string& key, const std::string& description)
   {
     root_.insert(ParamNode("",description),key);
+    index_.invalidate();
   }
 
   Param::ParamIterator Param::begin() const
@@ -1669,7 +1792,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   bool Param::exists(const std::string& key) const
   {
-    return root_.findEntryRecursive(key);
+    return index_.find(key, root_) != nullptr;
   }
 
   bool Param::hasSection(const std::string &key) const
@@ -1687,7 +1810,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   Param::ParamEntry& Param::getEntry_(const std::string& key) const
   {
-    ParamEntry* entry = root_.findEntryRecursive(key);
+    ParamEntry* entry = index_.find(key, root_);
     if (entry == nullptr)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
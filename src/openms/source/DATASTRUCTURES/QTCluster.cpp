@@ -518,7 +518,9 @@ namespace OpenMS
 
     finalized_ = true;
 
-    data_->tmp_neighbors_.clear();
+    // release the storage of all collected neighbors (not only the entries),
+    // only the best neighbor per map is needed from now on
+    NeighborMapMulti().swap(data_->tmp_neighbors_);
   }
 
   void QTCluster::initializeCluster()
@@ -34,6 +34,116 @@
 
 #include <OpenMS/DATASTRUCTURES/StringView.h>
 
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+#if !defined(__cpp_lib_to_chars)
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
+#endif
+
 namespace OpenMS
 {
+  namespace
+  {
+    inline bool isSpace_(char c)
+    {
+      return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    inline void throwConversionError_(const StringView sv, const char* type_name)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + sv.getString() + "' to " + type_name + " value");
+    }
+
+    template <typename T>
+    T fromChars_(const StringView input, const char* type_name)
+    {
+      const StringView sv = input.trim();
+      const char* first = sv.data();
+      const char* last = first + sv.size();
+      // std::from_chars does not accept a leading '+' (but boost::spirit and strtod do)
+      if (first != last && *first == '+')
+      {
+        ++first;
+        if (first != last && (*first == '+' || *first == '-'))
+        {
+          throwConversionError_(input, type_name);
+        }
+      }
+
+      T value{};
+      const std::from_chars_result res = std::from_chars(first, last, value);
+      if (res.ec == std::errc::invalid_argument)
+      {
+        throwConversionError_(input, type_name);
+      }
+      if (res.ec == std::errc::result_out_of_range)
+      {
+        if constexpr (std::is_floating_point<T>::value)
+        { // underflow is not an error (flush to zero, like boost::spirit), only overflow is
+          const double d = std::strtod(String(first, last).c_str(), nullptr);
+          if (std::fabs(d) <= std::numeric_limits<T>::max() && res.ptr == last)
+          {
+            return static_cast<T>(d);
+          }
+        }
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Value of string '") + input.getString() + "' is out of range for " + type_name + " value");
+      }
+      // was the string parsed completely? If not, we have a problem because a previous split might have used the wrong split char
+      if (res.ptr != last)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Prefix of string '") + input.getString() + "' successfully converted to " + type_name + " value. Additional characters found at position " + (int)(res.ptr - input.data() + 1));
+      }
+      return value;
+    }
+  }
+
+  StringView StringView::trim() const
+  {
+    Size start = 0;
+    Size end = size_;
+    while (start < end && isSpace_(begin_[start])) ++start;
+    while (end > start && isSpace_(begin_[end - 1])) --end;
+    return StringView(begin_ + start, end - start);
+  }
+
+  Int StringView::toInt() const
+  {
+    return fromChars_<Int>(*this, "an integer");
+  }
+
+  Int64 StringView::toInt64() const
+  {
+    return fromChars_<Int64>(*this, "an integer");
+  }
+
+// floating point std::from_chars is not available in all standard libraries yet
+#if defined(__cpp_lib_to_chars)
+  float StringView::toFloat() const
+  {
+    return fromChars_<float>(*this, "a float");
+  }
+
+  double StringView::toDouble() const
+  {
+    return fromChars_<double>(*this, "a double");
+  }
+#else
+  float StringView::toFloat() const
+  {
+    return StringUtils::toFloat(getString());
+  }
+
+  double StringView::toDouble() const
+  {
+    return StringUtils::toDouble(getString());
+  }
+#endif
+
 }
@@ -45,6 +45,7 @@
 #include <QtCore/QStringList>
 
 #include <cstdio>
+#include <exception>
 
 namespace OpenMS
 {
@@ -94,9 +95,11 @@ namespace OpenMS
 
   void InternalCalibration::applyTransformation(PeakMap& exp, const IntList& target_mslvl, const MZTrafoModel& trafo)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
+    // spectra are independent
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
     {
-      applyTransformation(*it, target_mslvl, trafo);
+      applyTransformation(exp[i], target_mslvl, trafo);
     }
   }
 
@@ -113,28 +116,42 @@ namespace OpenMS
     //
     // find lock masses in data and build calibrant table
     //
-    std::map<Size, Size> stats_cal_per_spectrum;
-    typedef PeakMap::ConstIterator ExpCIt;
-    for (ExpCIt it = exp.begin(); it != exp.end(); ++it)
+    // spectra are searched in parallel; the results are merged in spectrum order afterwards
+    struct LockMassPoint
+    {
+      double rt, mz_obs, intensity, mz_ref, weight;
+      int group;
+    };
+    struct SpectrumResult
+    {
+      std::vector<LockMassPoint> found, failed;
+      String messages;
+    };
+    std::vector<SpectrumResult> results(exp.size());
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
     {
+      const MSSpectrum& spec = exp[i];
+      SpectrumResult& result = results[i];
       // empty spectrum
-      if (it->empty()) {
-        ++stats_cal_per_spectrum[0];
+      if (spec.empty())
+      {
         continue;
       }
 
-      Size cnt_cd = cal_data_.size();
       // iterate over calibrants
       for (std::vector<InternalCalibration::LockMass>::const_iterator itl = ref_masses.begin(); itl != ref_masses.end(); ++itl)
       {
         // calibrant meant for this MS level?
-        if (it->getMSLevel() != itl->ms_level) continue;
+        if (spec.getMSLevel() != itl->ms_level) continue;
 
-        Size s = it->findNearest(itl->mz);
-        const double mz_obs = (*it)[s].getMZ();
+        const int group = std::distance(ref_masses.begin(), itl);
+        Size s = spec.findNearest(itl->mz);
+        const double mz_obs = spec[s].getMZ();
         if (Math::getPPMAbs(mz_obs, itl->mz) > tol_ppm)
         {
-          failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 0.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+          result.failed.push_back({spec.getRT(), itl->mz, 0.0, itl->mz, 0.0, group});
         }
         else
         {
@@ -142,14 +159,14 @@ namespace OpenMS
           {
             // check if its the monoisotopic .. discard otherwise
             const double mz_iso_left = mz_obs - (Constants::C13C12_MASSDIFF_U / itl->charge);
-            Size s_left = it->findNearest(mz_iso_left);
-            if (Math::getPPMAbs(mz_iso_left, (*it)[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
+            Size s_left = spec.findNearest(mz_iso_left);
+            if (Math::getPPMAbs(mz_iso_left, spec[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
             { // peak nearby lock mass was not the monoisotopic
               if (verbose)
               {
-                OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " is NOT monoisotopic. Skipping it!\n";
+                result.messages += "peak at [RT, m/z] " + String(spec.getRT()) + ", " + String(spec[s].getMZ()) + " is NOT monoisotopic. Skipping it!\n";
               }
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 1.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              result.failed.push_back({spec.getRT(), itl->mz, 1.0, itl->mz, 0.0, group});
               continue;
             }
           }
@@ -157,22 +174,37 @@ namespace OpenMS
           {
             // require it to have a +1 isotope?!
             const double mz_iso_right = mz_obs + Constants::C13C12_MASSDIFF_U / itl->charge;
-            Size s_right = it->findNearest(mz_iso_right);
-            if (!(Math::getPPMAbs(mz_iso_right, (*it)[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
+            Size s_right = spec.findNearest(mz_iso_right);
+            if (!(Math::getPPMAbs(mz_iso_right, spec[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
             { // peak has no +1iso.. weird
               if (verbose)
               {
-                OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " has no +1 isotope (ppm to closest: " << Math::getPPM(mz_iso_right, (*it)[s_right].getMZ()) << ")... Skipping it!\n";
+                result.messages += "peak at [RT, m/z] " + String(spec.getRT()) + ", " + String(spec[s].getMZ()) + " has no +1 isotope (ppm to closest: " + String(Math::getPPM(mz_iso_right, spec[s_right].getMZ())) + ")... Skipping it!\n";
               }
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 2.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              result.failed.push_back({spec.getRT(), itl->mz, 2.0, itl->mz, 0.0, group});
               continue;
             }
           }
-          cal_data_.insertCalibrationPoint(it->getRT(), mz_obs, (*it)[s].getIntensity(), itl->mz, std::log((*it)[s].getIntensity()), std::distance(ref_masses.begin(), itl));
+          result.found.push_back({spec.getRT(), mz_obs, spec[s].getIntensity(), itl->mz, std::log(spec[s].getIntensity()), group});
         }
       }
-      // how many locks found in this spectrum?!
-      ++stats_cal_per_spectrum[cal_data_.size()-cnt_cd];
+    }
+
+    std::map<Size, Size> stats_cal_per_spectrum;
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      const SpectrumResult& result = results[i];
+      OPENMS_LOG_INFO << result.messages;
+      for (const LockMassPoint& p : result.failed)
+      {
+        failed_lock_masses.insertCalibrationPoint(p.rt, p.mz_obs, p.intensity, p.mz_ref, p.weight, p.group);
+      }
+      for (const LockMassPoint& p : result.found)
+      {
+        cal_data_.insertCalibrationPoint(p.rt, p.mz_obs, p.intensity, p.mz_ref, p.weight, p.group);
+      }
+      // how many locks found in this spectrum?! (empty spectra count as 0)
+      ++stats_cal_per_spectrum[result.found.size()];
     }
 
     OPENMS_LOG_INFO << "Lock masses found across viable spectra:\n";
@@ -341,35 +373,53 @@ namespace OpenMS
     }
     else
     { // one model per spectrum (not all might be needed, if certain MS levels are excluded from calibration)
-      tms.reserve(exp.size());
-      // go through spectra and calibrate
-      Size i(0), i_mslvl(0);
-      for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it, ++i)
+      // spectra which need a model
+      std::vector<Size> model_spectra;
+      for (Size i = 0; i < exp.size(); ++i)
       {
-        setProgress(i);
-
         // skip this MS level?
-        if (!(ListUtils::contains(target_mslvl, it->getMSLevel()) ||     // scan m/z needs correction
-              ListUtils::contains(target_mslvl, it->getMSLevel() - 1)))  // precursor m/z needs correction
+        if (ListUtils::contains(target_mslvl, exp[i].getMSLevel()) ||     // scan m/z needs correction
+            ListUtils::contains(target_mslvl, exp[i].getMSLevel() - 1))   // precursor m/z needs correction
         {
-          continue;
+          model_spectra.push_back(i);
         }
+      }
 
-        //
-        // build model
-        //
-        tms.emplace_back();
-        tms.back().train(cal_data_, model_type, use_RANSAC, it->getRT() - rt_chunk, it->getRT() + rt_chunk);
-        if (!MZTrafoModel::isValidModel(tms.back())) // model not trained or coefficients are too extreme
+      //
+      // build models (each on its own RT window) and calibrate, spectra in parallel
+      //
+      tms.resize(model_spectra.size());
+      std::vector<std::exception_ptr> errors(model_spectra.size());
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize k = 0; k < (SignedSize)model_spectra.size(); ++k)
+      {
+        try
         {
-          invalid_models[i_mslvl] = i;
+          MSSpectrum& spec = exp[model_spectra[k]];
+          tms[k].train(cal_data_, model_type, use_RANSAC, spec.getRT() - rt_chunk, spec.getRT() + rt_chunk);
+          if (MZTrafoModel::isValidModel(tms[k]))
+          {
+            applyTransformation(spec, target_mslvl, tms[k]);
+          }
         }
-        else
+        catch (...)
         {
-          applyTransformation(*it, target_mslvl, tms.back());
+          errors[k] = std::current_exception();
         }
-        ++i_mslvl;
-      } // MSExp::iter
+        nextProgress();
+      }
+      for (const std::exception_ptr& e : errors)
+      {
+        if (e) std::rethrow_exception(e);
+      }
+
+      for (Size k = 0; k < tms.size(); ++k)
+      {
+        if (!MZTrafoModel::isValidModel(tms[k])) // model not trained or coefficients are too extreme
+        {
+          invalid_models[k] = model_spectra[k];
+        }
+      }
 
       //////////////////////////////////////////////////////////////////////////
       // CHECK Models -- use neighbors if needed
@@ -385,9 +435,11 @@ namespace OpenMS
           << "Using the closest successful model on these." << std::endl;
 
         std::vector<MZTrafoModel> tms_new = tms; // will contain corrected models (this wastes a bit of memory)
-        for (std::map<Size, Size>::const_iterator it = invalid_models.begin(); it != invalid_models.end(); ++it)
+        const std::vector<std::pair<Size, Size> > invalid(invalid_models.begin(), invalid_models.end());
+#pragma omp parallel for schedule(dynamic)
+        for (SignedSize k = 0; k < (SignedSize)invalid.size(); ++k)
         {
-          Size p = it->first;
+          Size p = invalid[k].first;
           // find model closest valid model to p'th model
           std::vector<MZTrafoModel>::iterator it_center_r = tms.begin() + p; // points to 'p'
           std::vector<MZTrafoModel>::iterator it_right = std::find_if(it_center_r, tms.end(), MZTrafoModel::isValidModel);
@@ -411,7 +463,7 @@ namespace OpenMS
           {
             model_index = p + dist_right;
           }
-          applyTransformation(exp[it->second], target_mslvl, tms[model_index]);
+          applyTransformation(exp[invalid[k].second], target_mslvl, tms[model_index]);
           tms_new[p].setCoefficients(tms[model_index]); // overwrite invalid model
         }
         tms_new.swap(tms);
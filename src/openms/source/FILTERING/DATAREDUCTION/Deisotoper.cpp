@@ -39,12 +39,46 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
 #include <OpenMS/FILTERING/TRANSFORMERS/ThresholdMower.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 
+#include <exception>
+
 namespace OpenMS
 {
 
+namespace
+{
+  /**
+    @brief Same result as MSSpectrum::findNearest(mz, tolerance) on the m/z values in @p mzs, but
+    searches forward from @p lower_bound (which is updated to the first index with m/z >= @p mz).
+
+    Successive queries with increasing @p mz thus cost amortized O(1) instead of a binary search each.
+  */
+  int findNearestForward_(const std::vector<double>& mzs, double mz, double tolerance, Size& lower_bound)
+  {
+    while (lower_bound < mzs.size() && mzs[lower_bound] < mz) ++lower_bound;
+
+    Size nearest;
+    if (lower_bound == 0)
+    {
+      nearest = 0;
+    }
+    else if (lower_bound == mzs.size())
+    {
+      nearest = mzs.size() - 1;
+    }
+    else
+    {
+      // the peak before or the current peak are closest (ties go to the left one)
+      nearest = std::fabs(mzs[lower_bound] - mz) < std::fabs(mzs[lower_bound - 1] - mz) ? lower_bound : lower_bound - 1;
+    }
+    const double found_mz = mzs[nearest];
+    return (found_mz >= mz - tolerance && found_mz <= mz + tolerance) ? static_cast<int>(nearest) : -1;
+  }
+}
+
 // static
 void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
   double fragment_tolerance,
@@ -404,6 +438,24 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
 
   std::vector<size_t> extensions;
 
+  // m/z values in contiguous memory for the isotope searches
+  std::vector<double> mzs(old_spectrum.size());
+  for (Size i = 0; i != old_spectrum.size(); ++i)
+  {
+    mzs[i] = old_spectrum[i].getMZ();
+  }
+
+  // m/z offsets of the isotopic peaks for each charge (index: q - min_charge, i)
+  std::vector<std::vector<double> > iso_offsets;
+  for (int q = min_charge; q <= max_charge; ++q)
+  {
+    iso_offsets.emplace_back(max_isopeaks, 0.0);
+    for (unsigned int i = 1; i < max_isopeaks; ++i)
+    {
+      iso_offsets.back()[i] = static_cast<double>(i) * Constants::C13C12_MASSDIFF_U / static_cast<double>(q);
+    }
+  }
+
   bool has_precursor_data(false);
   double precursor_mass(0);
   if (old_spectrum.getPrecursors().size() == 1)
@@ -421,6 +473,13 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
       mono_iso_peak_intensity[current_peak] = old_spectrum[current_peak].getIntensity();
     }
 
+    // only process peaks which have no assigned feature number
+    if (features[current_peak] != -1)
+    {
+      continue;
+    }
+    const double tolerance_dalton = fragment_unit_ppm ? Math::ppmToMass(fragment_tolerance, current_mz) : fragment_tolerance;
+
     for (int q = max_charge; q >= min_charge; --q) // important: test charge hypothesis from high to low
     {
       // try to extend isotopes from mono-isotopic peak
@@ -430,7 +489,6 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
       if (features[current_peak] == -1) // only process peaks which have no assigned feature number
       {
         bool has_min_isopeaks = true;
-        const double tolerance_dalton = fragment_unit_ppm ? Math::ppmToMass(fragment_tolerance, current_mz) : fragment_tolerance;
 
         // do not bother testing charges q (and masses m) with: m/q > precursor_mass/q (or m > precursor_mass)
         if (has_precursor_data)
@@ -444,10 +502,13 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
 
         extensions.clear();
         extensions.push_back(current_peak);
+        // for positive charges, isotopic peaks are to the right: search forward from the current peak
+        const std::vector<double>& offsets = iso_offsets[q - min_charge];
+        Size lower_bound = current_peak;
         for (unsigned int i = 1; i < max_isopeaks; ++i)
         {
-          const double expected_mz = current_mz + static_cast<double>(i) * Constants::C13C12_MASSDIFF_U / static_cast<double>(q);
-          const int p = old_spectrum.findNearest(expected_mz, tolerance_dalton);
+          const double expected_mz = current_mz + offsets[i];
+          const int p = q > 0 ? findNearestForward_(mzs, expected_mz, tolerance_dalton, lower_bound) : old_spectrum.findNearest(expected_mz, tolerance_dalton);
           if (p == -1) // test for missing peak
           {
             has_min_isopeaks = (i >= min_isopeaks);
@@ -537,4 +598,51 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
   spec.sortByPosition();
   return;
 }
+
+// static
+void Deisotoper::deisotopeAndSingleCharge(PeakMap& exp,
+                      double fragment_tolerance,
+                      bool fragment_unit_ppm,
+                      int min_charge,
+                      int max_charge,
+                      bool keep_only_deisotoped,
+                      unsigned int min_isopeaks,
+                      unsigned int max_isopeaks,
+                      bool make_single_charged,
+                      bool annotate_charge,
+                      bool annotate_iso_peak_count,
+                      bool use_decreasing_model,
+                      unsigned int start_intensity_check,
+                      bool add_up_intensity)
+{
+  std::vector<std::exception_ptr> errors(exp.size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+  {
+    try
+    {
+      MSSpectrum& spec = exp[i];
+      if (!spec.isSorted())
+      {
+        spec.sortByPosition();
+      }
+      deisotopeAndSingleCharge(spec, fragment_tolerance, fragment_unit_ppm,
+        min_charge, max_charge, keep_only_deisotoped,
+        min_isopeaks, max_isopeaks, make_single_charged,
+        annotate_charge, annotate_iso_peak_count,
+        use_decreasing_model, start_intensity_check, add_up_intensity);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  }
+
+  // rethrow the first error (in spectrum order)
+  for (const std::exception_ptr& error : errors)
+  {
+    if (error) std::rethrow_exception(error);
+  }
+}
 } // namespace
@@ -40,6 +40,10 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -48,6 +52,20 @@
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Savitzky-Golay filter (2nd order) as used for smoothing mass traces with window size @p win_size
+    SavitzkyGolayFilter createSmoothingFilter(int win_size)
+    {
+      SavitzkyGolayFilter sg;
+      Param param;
+      param.setValue("polynomial_order", 2);
+      param.setValue("frame_length", std::max(3, win_size)); // frame length must be at least polynomial_order+1, otherwise SG will fail
+      sg.setParameters(param);
+      return sg;
+    }
+  }
+
   ElutionPeakDetection::ElutionPeakDetection() :
     DefaultParamHandler("ElutionPeakDetection"), ProgressLogger()
   {
@@ -77,7 +95,7 @@ namespace OpenMS
   {
     // compute RMSE
     double squared_sum(0.0);
-    std::vector<double> smooth_ints(tr.getSmoothedIntensities());
+    const std::vector<double>& smooth_ints = tr.getSmoothedIntensities();
 
     for (Size i = 0; i < smooth_ints.size(); ++i)
     {
@@ -130,7 +148,7 @@ namespace OpenMS
   void ElutionPeakDetection::findLocalExtrema(const MassTrace& tr, const Size& num_neighboring_peaks,
                                               std::vector<Size>& chrom_maxes, std::vector<Size>& chrom_mins) const
   {
-    std::vector<double> smoothed_ints_vec(tr.getSmoothedIntensities());
+    const std::vector<double>& smoothed_ints_vec = tr.getSmoothedIntensities();
 
     Size mt_length(smoothed_ints_vec.size());
 
@@ -328,7 +346,8 @@ namespace OpenMS
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
-    detectElutionPeaks_(mt, single_mtraces);
+    SmoothingBuffers_ buffers;
+    detectElutionPeaks_(mt, createSmoothingFilter(static_cast<Int>(smoothingWindow_(mt))), buffers, single_mtraces);
     return;
   }
 
@@ -338,21 +357,61 @@ namespace OpenMS
     single_mtraces.clear();
 
     this->startProgress(0, mt_vec.size(), "elution peak detection");
+
+    // set up the smoothing filter once per window size (the coefficients are computed by an SVD)
+    std::vector<Size> win_sizes(mt_vec.size());
+    std::map<Size, SavitzkyGolayFilter> filters;
+    for (Size i = 0; i < mt_vec.size(); ++i)
+    {
+      win_sizes[i] = smoothingWindow_(mt_vec[i]);
+      if (filters.find(win_sizes[i]) == filters.end())
+      {
+        filters.emplace(win_sizes[i], createSmoothingFilter(static_cast<Int>(win_sizes[i])));
+      }
+    }
+
+    // process long traces first, so that no thread is left with a long trace at the end
+    std::vector<Size> order(mt_vec.size());
+    for (Size i = 0; i < order.size(); ++i)
+    {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&mt_vec](Size a, Size b) { return mt_vec[a].getSize() > mt_vec[b].getSize(); });
+
+    // peaks of each input trace, concatenated in input order below
+    std::vector<std::vector<MassTrace> > peaks_per_trace(mt_vec.size());
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-    for (SignedSize i = 0; i < (SignedSize) mt_vec.size(); ++i)
     {
-      IF_MASTERTHREAD this->setProgress(progress);
+      SmoothingBuffers_ buffers; // one set of buffers per thread
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (SignedSize k = 0; k < (SignedSize) order.size(); ++k)
+      {
+        IF_MASTERTHREAD this->setProgress(progress);
 
 #ifdef _OPENMP
 #pragma omp atomic
 #endif
-      ++progress;
+        ++progress;
 
-      // push_back to 'single_mtraces' is protected, so threading is ok
-      detectElutionPeaks_(mt_vec[i], single_mtraces);
+        const Size i = order[k];
+        detectElutionPeaks_(mt_vec[i], filters.at(win_sizes[i]), buffers, peaks_per_trace[i]);
+      }
+    }
+
+    Size total(0);
+    for (const std::vector<MassTrace>& peaks : peaks_per_trace)
+    {
+      total += peaks.size();
+    }
+    single_mtraces.reserve(total);
+    for (std::vector<MassTrace>& peaks : peaks_per_trace)
+    {
+      std::move(peaks.begin(), peaks.end(), std::back_inserter(single_mtraces));
     }
 
     this->endProgress();
@@ -392,18 +451,23 @@ namespace OpenMS
     return;
   }
 
-  void ElutionPeakDetection::detectElutionPeaks_(MassTrace& mt, std::vector<MassTrace>& single_mtraces)
+  Size ElutionPeakDetection::smoothingWindow_(const MassTrace& mt) const
+  {
+    double scan_time(mt.getAverageMS1CycleTime());
+    return std::ceil(chrom_fwhm_ / scan_time);
+  }
+
+  void ElutionPeakDetection::detectElutionPeaks_(MassTrace& mt, const SavitzkyGolayFilter& filter, SmoothingBuffers_& buffers, std::vector<MassTrace>& single_mtraces)
   {
 
     // *********************************************************************
     // Step 1: Smooth data
     // *********************************************************************
 
-    double scan_time(mt.getAverageMS1CycleTime());
-    Size win_size = std::ceil(chrom_fwhm_ / scan_time);
+    Size win_size = smoothingWindow_(mt);
 
     // add smoothed data (original data is still accessible)
-    smoothData(mt, static_cast<Int>(win_size));
+    smoothData_(mt, filter, buffers);
 
 #ifdef DEBUG_EPD
     Size i = 0;
@@ -471,12 +535,7 @@ namespace OpenMS
           mt.estimateFWHM(true);
         }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-        {
-          single_mtraces.push_back(mt);
-        }
+        single_mtraces.push_back(mt);
 
       }
     }
@@ -498,15 +557,12 @@ namespace OpenMS
         // *********************************************************************
         // Step 3.1: Create new mass trace (sub-trace between cp_it and split point)
         // *********************************************************************
-        std::vector<PeakType> tmp_mt;
-        std::vector<double> smoothed_tmp;
-        while (last_idx <= mins[min_idx])
-        {
-          tmp_mt.push_back(*cp_it);
-          smoothed_tmp.push_back(mt.getSmoothedIntensities()[last_idx]);
-          ++cp_it;
-          ++last_idx;
-        }
+        const Size first_idx(last_idx);
+        std::vector<PeakType> tmp_mt(cp_it, cp_it + (mins[min_idx] + 1 - first_idx));
+        std::vector<double> smoothed_tmp(mt.getSmoothedIntensities().begin() + first_idx,
+                                         mt.getSmoothedIntensities().begin() + mins[min_idx] + 1);
+        cp_it += tmp_mt.size();
+        last_idx = mins[min_idx] + 1;
 
         // Create new mass trace, copy smoothed intensities
         MassTrace new_mt(tmp_mt);
@@ -552,12 +608,7 @@ namespace OpenMS
             new_mt.estimateFWHM(true);
           }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-          {
-            single_mtraces.push_back(new_mt);
-          }
+          single_mtraces.push_back(std::move(new_mt));
         }
       }
 
@@ -570,26 +621,8 @@ namespace OpenMS
     // alternative smoothing using SavitzkyGolay
     // looking at the unit test, this method gives better fits than lowess smoothing
     // reference paper uses lowess smoothing
-
-    MSSpectrum spectrum;
-    for (Size i = 0; i != mt.getSize(); ++i)
-    {
-      spectrum.push_back(Peak1D(mt[i].getRT(), mt[i].getIntensity()));
-    }
-
-    SavitzkyGolayFilter sg;
-    Param param;
-    param.setValue("polynomial_order", 2);
-    param.setValue("frame_length", std::max(3, win_size)); // frame length must be at least polynomial_order+1, otherwise SG will fail
-    sg.setParameters(param);
-    sg.filter(spectrum);
-    MSSpectrum::iterator iter = spectrum.begin();
-    std::vector<double> smoothed_intensities;
-    for (; iter != spectrum.end(); ++iter)
-    {
-      smoothed_intensities.push_back(iter->getIntensity());
-    }
-    mt.setSmoothedIntensities(smoothed_intensities);
+    SmoothingBuffers_ buffers;
+    smoothData_(mt, createSmoothingFilter(win_size), buffers);
     //alternative end
 
     // std::cout << "win_size elution: " << scan_time << " " << win_size << std::endl;
@@ -618,6 +651,17 @@ namespace OpenMS
     //  mt.setSmoothedIntensities(smoothed_data);
   }
 
+  void ElutionPeakDetection::smoothData_(MassTrace& mt, const SavitzkyGolayFilter& filter, SmoothingBuffers_& buffers) const
+  {
+    buffers.intensities.resize(mt.getSize());
+    for (Size i = 0; i != mt.getSize(); ++i)
+    {
+      buffers.intensities[i] = mt[i].getIntensity();
+    }
+    filter.smoothIntensities(buffers.intensities, buffers.smoothed);
+    mt.setSmoothedIntensities(buffers.smoothed);
+  }
+
   void ElutionPeakDetection::updateMembers_()
   {
     chrom_fwhm_ = (double)param_.getValue("chrom_fwhm");
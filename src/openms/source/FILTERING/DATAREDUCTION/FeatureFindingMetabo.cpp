@@ -41,6 +41,7 @@
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
 #include <fstream>
 
 #include <boost/dynamic_bitset.hpp>
@@ -756,14 +757,10 @@ namespace OpenMS
     FeatureHypothesis tmp_hypo;
     tmp_hypo.addMassTrace(*candidates[0]);
     tmp_hypo.setScore((candidates[0]->getIntensity(use_smoothed_intensities_)) / total_intensity);
+    output_hypotheses.push_back(tmp_hypo);
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-    {
-      // pushing back to shared vector needs to be synchronized
-      output_hypotheses.push_back(tmp_hypo);
-    }
+    // the RT score of a candidate does not depend on charge and isotopic position, compute it only once
+    std::vector<double> rt_scores(candidates.size(), -1.0);
 
     for (Size charge = charge_lower_bound_; charge <= charge_upper_bound_; ++charge)
     {
@@ -779,8 +776,8 @@ namespace OpenMS
       Size iso_pos_max(static_cast<Size>(std::floor(charge * local_mz_range_)));
       for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
       {
-        //estimate expected m/z window for iso_pos
-        Range isotope_window = getTheoreticIsotopicMassWindow_(elements_, iso_pos);
+        // expected m/z window for iso_pos (precomputed in run())
+        const Range& isotope_window = isotope_windows_[iso_pos];
         // Find mass trace that best agrees with current hypothesis of charge
         // and isotopic position
         double best_so_far(0.0);
@@ -797,7 +794,11 @@ namespace OpenMS
 #endif
 
           // Score current mass trace candidates against hypothesis
-          double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx]));
+          if (rt_scores[mt_idx] < 0.0)
+          {
+            rt_scores[mt_idx] = scoreRT_(*candidates[0], *candidates[mt_idx]);
+          }
+          double rt_score(rt_scores[mt_idx]);
           double mz_score(scoreMZ_(*candidates[0], *candidates[mt_idx], iso_pos, charge, isotope_window));
 
           // disable intensity scoring for now...
@@ -840,13 +841,7 @@ namespace OpenMS
           fh_tmp.setCharge(charge);
           last_iso_idx = best_idx;
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-          {
-            // pushing back to shared vector needs to be synchronized
-            output_hypotheses.push_back(fh_tmp);
-          }
+          output_hypotheses.push_back(fh_tmp);
         }
         else
         {
@@ -904,49 +899,105 @@ namespace OpenMS
       total_intensity += input_mtraces[i].getIntensity(use_smoothed_intensities_);
     }
 
+    // expected m/z windows of all isotopic positions that are scored (the same for all seeds)
+    isotope_windows_.assign(1, Range());
+    const Size iso_pos_max(static_cast<Size>(std::floor(charge_upper_bound_ * local_mz_range_)));
+    for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
+    {
+      isotope_windows_.push_back(getTheoreticIsotopicMassWindow_(elements_, iso_pos));
+    }
+
+    // RT grid over the mass traces: bins of width local_rt_range, each holding its trace indices in m/z order.
+    // All traces within local_rt_range of a seed are in the bin of the seed or its two neighbors.
+    double min_rt(input_mtraces[0].getCentroidRT()), max_rt(min_rt);
+    for (const MassTrace& mt : input_mtraces)
+    {
+      min_rt = std::min(min_rt, mt.getCentroidRT());
+      max_rt = std::max(max_rt, mt.getCentroidRT());
+    }
+    const bool use_rt_bins(local_rt_range_ > 0.0 && (max_rt - min_rt) / local_rt_range_ < double(input_mtraces.size()));
+    auto rtBin = [&](double rt) -> Size { return use_rt_bins ? static_cast<Size>((rt - min_rt) / local_rt_range_) : 0; };
+    std::vector<std::vector<Size> > rt_bins(rtBin(max_rt) + 1);
+    for (Size i = 0; i < input_mtraces.size(); ++i)
+    {
+      rt_bins[rtBin(input_mtraces[i].getCentroidRT())].push_back(i);
+    }
+
     // *********************************************************** //
     // Step 2 Iterate through all mass traces to find likely matches 
     // and generate isotopic / charge hypotheses
     // *********************************************************** //
 
-    std::vector<FeatureHypothesis> feat_hypos;
+    // hypotheses of each seed, concatenated in seed order below (independent of the number of threads)
+    std::vector<std::vector<FeatureHypothesis> > seed_hypos(input_mtraces.size());
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-    for (SignedSize i = 0; i < (SignedSize)input_mtraces.size(); ++i)
     {
-      IF_MASTERTHREAD this->setProgress(progress);
+      std::vector<Size> local_idx;
+      std::vector<const MassTrace*> local_traces;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)input_mtraces.size(); ++i)
+      {
+        IF_MASTERTHREAD this->setProgress(progress);
 #ifdef _OPENMP
 #pragma omp atomic
 #endif
-      ++progress;
+        ++progress;
 
-      std::vector<const MassTrace*> local_traces;
-      double ref_trace_mz(input_mtraces[i].getCentroidMZ());
-      double ref_trace_rt(input_mtraces[i].getCentroidRT());
-
-      local_traces.push_back(&input_mtraces[i]);
+        double ref_trace_mz(input_mtraces[i].getCentroidMZ());
+        double ref_trace_rt(input_mtraces[i].getCentroidRT());
 
-      for (Size ext_idx = i + 1; ext_idx < input_mtraces.size(); ++ext_idx)
-      {
-        // traces are sorted by m/z, so we can break when we leave the allowed window
-        double diff_mz = std::fabs(input_mtraces[ext_idx].getCentroidMZ() - ref_trace_mz);
-        if (diff_mz > local_mz_range_)
+        local_idx.clear();
+        const Size bin(rtBin(ref_trace_rt));
+        for (Size b = (bin > 0 ? bin - 1 : 0); b <= std::min(bin + 1, rt_bins.size() - 1); ++b)
         {
-          break;
+          const std::vector<Size>& bin_idx = rt_bins[b];
+          for (auto it = std::upper_bound(bin_idx.begin(), bin_idx.end(), Size(i)); it != bin_idx.end(); ++it)
+          {
+            // traces are sorted by m/z, so we can break when we leave the allowed window
+            double diff_mz = std::fabs(input_mtraces[*it].getCentroidMZ() - ref_trace_mz);
+            if (diff_mz > local_mz_range_)
+            {
+              break;
+            }
+            double diff_rt = std::fabs(input_mtraces[*it].getCentroidRT() - ref_trace_rt);
+            if (diff_rt <= local_rt_range_)
+            {
+              local_idx.push_back(*it);
+            }
+          }
         }
-        double diff_rt = std::fabs(input_mtraces[ext_idx].getCentroidRT() - ref_trace_rt);
-        if (diff_rt <= local_rt_range_)
+        // candidates in m/z order, as if all traces had been scanned
+        std::sort(local_idx.begin(), local_idx.end());
+
+        local_traces.clear();
+        local_traces.push_back(&input_mtraces[i]);
+        for (Size idx : local_idx)
         {
-          // std::cout << " accepted!" << std::endl;
-          local_traces.push_back(&input_mtraces[ext_idx]);
+          local_traces.push_back(&input_mtraces[idx]);
         }
+        findLocalFeatures_(local_traces, total_intensity, seed_hypos[i]);
       }
-      findLocalFeatures_(local_traces, total_intensity, feat_hypos);
     }
     this->endProgress();
 
+    std::vector<FeatureHypothesis> feat_hypos;
+    Size hypo_count(0);
+    for (const std::vector<FeatureHypothesis>& hypos : seed_hypos)
+    {
+      hypo_count += hypos.size();
+    }
+    feat_hypos.reserve(hypo_count);
+    for (std::vector<FeatureHypothesis>& hypos : seed_hypos)
+    {
+      feat_hypos.insert(feat_hypos.end(), hypos.begin(), hypos.end());
+      std::vector<FeatureHypothesis>().swap(hypos);
+    }
+
     // sort feature candidates by their score
     std::sort(feat_hypos.begin(), feat_hypos.end(), CmpHypothesesByScore());
 
@@ -36,7 +36,15 @@
 
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
-#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <map>
+#include <set>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
@@ -61,6 +69,8 @@ namespace OpenMS
       defaults_.setValue("min_sample_rate", 0.5, "Minimum fraction of scans along the mass trace that must contain a peak.", {"advanced"});
       defaults_.setValue("min_trace_length", 5.0, "Minimum expected length of a mass trace (in seconds).", {"advanced"});
       defaults_.setValue("max_trace_length", -1.0, "Maximum expected length of a mass trace (in seconds). Set to a negative value to disable maximal length check during mass trace detection.", {"advanced"});
+      defaults_.setValue("mz_bands", 0, "Number of m/z bands that are processed in parallel (1: serial processing, 0: choose automatically based on the number of threads and apices). The result does not depend on this setting.", {"advanced"});
+      defaults_.setMinInt("mz_bands", 0);
 
       defaultsToParam_();
 
@@ -267,6 +277,58 @@ namespace OpenMS
       return;
     } // end of MassTraceDetection::run
 
+    namespace
+    {
+      /// Same as MSSpectrum::findNearest(), restricted to the peaks [begin, end) (must not be empty)
+      Size findNearestInRange(const MSSpectrum& spec, Size begin, Size end, double mz)
+      {
+        const auto first = spec.begin() + begin;
+        const auto last = spec.begin() + end;
+        const auto it = std::lower_bound(first, last, mz, [](const Peak1D& p, double value) { return p.getMZ() < value; });
+        if (it == first) return begin;
+        if (it == last) return end - 1;
+        const auto it2 = it - 1;
+        if (std::fabs(it->getMZ() - mz) < std::fabs(it2->getMZ() - mz))
+        {
+          return Size(it - spec.begin());
+        }
+        return Size(it2 - spec.begin());
+      }
+
+      /**
+        @brief Chooses up to @p n_bands - 1 m/z values that split the apices into bands of similar size
+
+        Each cut is placed in the middle of the widest gap between neighboring apex m/z values around the
+        ideal (equal count) position, so that only few traces get close to a band border.
+      */
+      std::vector<double> chooseBandCuts(std::vector<double> apex_mz, Size n_bands)
+      {
+        std::vector<double> cuts;
+        if (n_bands < 2 || apex_mz.size() < 2 * n_bands) return cuts;
+
+        std::sort(apex_mz.begin(), apex_mz.end());
+        const Size n = apex_mz.size();
+        const Size half_window = n / (4 * n_bands);
+        for (Size k = 1; k < n_bands; ++k)
+        {
+          const Size center = k * n / n_bands;
+          const Size from = center > half_window ? center - half_window : 0;
+          const Size to = std::min(center + half_window + 1, n - 1);
+          Size best = from;
+          for (Size i = from; i < to; ++i)
+          {
+            if (apex_mz[i + 1] - apex_mz[i] > apex_mz[best + 1] - apex_mz[best]) best = i;
+          }
+          const double cut = 0.5 * (apex_mz[best] + apex_mz[best + 1]);
+          if (apex_mz[best + 1] > apex_mz[best] && (cuts.empty() || cut > cuts.back()))
+          {
+            cuts.push_back(cut);
+          }
+        }
+        return cuts;
+      }
+    }
+
     void MassTraceDetection::run_(const std::vector<Apex>& chrom_apices,
                                   const Size total_peak_count,
                                   const PeakMap& work_exp,
@@ -274,8 +336,8 @@ namespace OpenMS
                                   std::vector<MassTrace>& found_masstraces,
                                   const Size max_traces)
     {
-      boost::dynamic_bitset<> peak_visited(total_peak_count);
-      Size trace_number(1);
+      // one byte per peak (instead of a bitset), so that threads working on different m/z bands never share a word
+      std::vector<char> peak_visited(total_peak_count, 0);
 
       // check presence of FWHM meta data
       int fwhm_meta_idx(-1);
@@ -299,14 +361,164 @@ namespace OpenMS
                                       String("FWHM meta arrays are expected to be missing or present for all MS spectra [") + fwhm_meta_count + "/" + work_exp.size() + "].");
       }
 
+      // *********************************************************************
+      // Split the m/z axis into bands which are processed independently (in parallel). A band only uses its own
+      // peaks. As long as no trace of a band looks beyond the band borders, its traces are exactly those of the
+      // serial algorithm. Otherwise, the band is merged with its neighbor and processed again.
+      // *********************************************************************
+      Size n_bands = mz_bands_;
+      if (n_bands == 0)
+      {
+#ifdef _OPENMP
+        n_bands = std::min<Size>(4 * omp_get_max_threads(), chrom_apices.size() / 1000);
+#else
+        n_bands = 1;
+#endif
+      }
+      std::vector<double> apex_mz;
+      if (n_bands > 1)
+      {
+        apex_mz.reserve(chrom_apices.size());
+        for (const Apex& a : chrom_apices) { apex_mz.push_back(work_exp[a.scan_idx][a.peak_idx].getMZ()); }
+      }
+      std::vector<double> cuts = chooseBandCuts(apex_mz, n_bands);
 
       this->startProgress(0, total_peak_count, "mass trace detection");
-      Size peaks_detected(0);
+      std::atomic<Size> peaks_detected(0);
 
-      for (auto m_it = chrom_apices.crbegin(); m_it != chrom_apices.crend(); ++m_it)
+      const double inf = std::numeric_limits<double>::infinity();
+      std::map<std::pair<double, double>, BandResult_> done; // successfully processed bands
+      while (true)
       {
-        Size apex_scan_idx(m_it->scan_idx);
-        Size apex_peak_idx(m_it->peak_idx);
+        // bands of the current cut points that still need to be processed
+        std::vector<std::pair<double, double> > pending;
+        for (Size b = 0; b <= cuts.size(); ++b)
+        {
+          std::pair<double, double> band(b == 0 ? -inf : cuts[b - 1], b == cuts.size() ? inf : cuts[b]);
+          if (done.find(band) == done.end()) { pending.push_back(band); }
+        }
+        if (pending.empty()) { break; }
+
+        // apex ranks (position in order of decreasing intensity) per pending band
+        std::vector<std::vector<Size> > band_ranks(pending.size());
+        for (Size rank = 0; rank < chrom_apices.size(); ++rank)
+        {
+          const Apex& a = chrom_apices[chrom_apices.size() - 1 - rank];
+          const double mz = work_exp[a.scan_idx][a.peak_idx].getMZ();
+          const auto it = std::upper_bound(pending.begin(), pending.end(), mz,
+            [](double value, const std::pair<double, double>& band) { return value < band.second; });
+          if (it != pending.end() && mz >= it->first) { band_ranks[it - pending.begin()].push_back(rank); }
+        }
+
+        std::vector<BandResult_> results(pending.size());
+        std::vector<std::exception_ptr> errors(pending.size());
+#pragma omp parallel for schedule(dynamic)
+        for (SignedSize b = 0; b < (SignedSize)pending.size(); ++b)
+        {
+          try
+          {
+            detectInBand_(chrom_apices, band_ranks[b], work_exp, spec_offsets, fwhm_meta_idx,
+                          pending[b].first, pending[b].second, peak_visited, results[b], max_traces, peaks_detected);
+          }
+          catch (...)
+          {
+            errors[b] = std::current_exception();
+          }
+        }
+        for (const std::exception_ptr& error : errors)
+        {
+          if (error) { std::rethrow_exception(error); }
+        }
+
+        // remove the cuts that were crossed, keep the results of all other bands
+        std::set<double> crossed;
+        for (Size b = 0; b < pending.size(); ++b)
+        {
+          if (results[b].crossed_low) { crossed.insert(pending[b].first); }
+          if (results[b].crossed_high) { crossed.insert(pending[b].second); }
+          if (!results[b].crossed_low && !results[b].crossed_high) { done[pending[b]] = std::move(results[b]); }
+          else
+          {
+            for (Size idx : results[b].marked) { peak_visited[idx] = 0; }
+          }
+        }
+        if (crossed.empty()) { continue; }
+
+        std::vector<double> remaining_cuts;
+        for (double c : cuts)
+        {
+          if (crossed.count(c) == 0) { remaining_cuts.push_back(c); }
+        }
+        cuts.swap(remaining_cuts);
+
+        // discard bands that border a removed cut, they are processed again as part of a merged band
+        for (auto it = done.begin(); it != done.end();)
+        {
+          if (crossed.count(it->first.first) > 0 || crossed.count(it->first.second) > 0)
+          {
+            for (Size idx : it->second.marked) { peak_visited[idx] = 0; }
+            it = done.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+      }
+
+      // merge the traces of all bands in order of decreasing apex intensity (i.e. in the order of the serial algorithm)
+      std::vector<std::pair<Size, MassTrace> > traces;
+      for (auto& band : done)
+      {
+        for (auto& t : band.second.traces) { traces.push_back(std::move(t)); }
+      }
+      std::sort(traces.begin(), traces.end(),
+        [](const std::pair<Size, MassTrace>& a, const std::pair<Size, MassTrace>& b) { return a.first < b.first; });
+      if (max_traces > 0 && traces.size() > max_traces)
+      {
+        traces.resize(max_traces);
+      }
+
+      found_masstraces.reserve(found_masstraces.size() + traces.size());
+      Size trace_number(1);
+      for (auto& t : traces)
+      {
+        t.second.setLabel("T" + String(trace_number));
+        ++trace_number;
+        found_masstraces.push_back(std::move(t.second));
+      }
+
+      this->endProgress();
+    }
+
+    void MassTraceDetection::detectInBand_(const std::vector<Apex>& chrom_apices,
+                                           const std::vector<Size>& apex_ranks,
+                                           const PeakMap& work_exp,
+                                           const std::vector<Size>& spec_offsets,
+                                           const int fwhm_meta_idx,
+                                           const double mz_low,
+                                           const double mz_high,
+                                           std::vector<char>& peak_visited,
+                                           BandResult_& result,
+                                           const Size max_traces,
+                                           std::atomic<Size>& peaks_detected)
+    {
+      // the peaks of each spectrum in [mz_low, mz_high)
+      const bool bounded_low = mz_low > -std::numeric_limits<double>::infinity();
+      const bool bounded_high = mz_high < std::numeric_limits<double>::infinity();
+      std::vector<Size> band_begin(work_exp.size()), band_end(work_exp.size());
+      for (Size i = 0; i < work_exp.size(); ++i)
+      {
+        const MSSpectrum& s = work_exp[i];
+        band_begin[i] = bounded_low ? s.MZBegin(mz_low) - s.begin() : 0;
+        band_end[i] = bounded_high ? s.MZBegin(mz_high) - s.begin() : s.size();
+      }
+
+      for (Size rank : apex_ranks)
+      {
+        const Apex& apex = chrom_apices[chrom_apices.size() - 1 - rank];
+        Size apex_scan_idx(apex.scan_idx);
+        Size apex_peak_idx(apex.peak_idx);
 
         if (peak_visited[spec_offsets[apex_scan_idx] + apex_peak_idx])
         {
@@ -357,6 +569,31 @@ namespace OpenMS
         double ftl_sd((centroid_mz / 1e6) * mass_error_ppm_);
         double intensity_so_far(apex_peak.getIntensity());
 
+        // Looks for the next peak of the trace in spectrum @p scan_idx. Returns the peak index, or -1 if no
+        // matching peak was found. Flags the band if the search window reaches beyond the band borders.
+        auto findNextPeak = [&](Size scan_idx) -> SignedSize
+        {
+          double right_bound = centroid_mz + 3 * ftl_sd;
+          double left_bound = centroid_mz - 3 * ftl_sd;
+          if (bounded_low && left_bound < mz_low) { result.crossed_low = true; }
+          if (bounded_high && right_bound >= mz_high) { result.crossed_high = true; }
+          if (result.crossed_low || result.crossed_high) { return -1; }
+
+          // all peaks outside of the band lie outside of the search window
+          if (band_begin[scan_idx] == band_end[scan_idx]) { return -1; }
+
+          const MSSpectrum& spec = work_exp[scan_idx];
+          Size peak_idx = findNearestInRange(spec, band_begin[scan_idx], band_end[scan_idx], centroid_mz);
+          double peak_mz = spec[peak_idx].getMZ();
+          if ((peak_mz <= right_bound) &&
+              (peak_mz >= left_bound) &&
+              !peak_visited[spec_offsets[scan_idx] + peak_idx])
+          {
+            return peak_idx;
+          }
+          return -1;
+        };
+
         while (((trace_down_idx > 0) && toggle_down) ||
                ((trace_up_idx < work_exp.size() - 1) && toggle_up)
                 )
@@ -369,18 +606,14 @@ namespace OpenMS
             const MSSpectrum& spec_trace_down = work_exp[trace_down_idx - 1];
             if (!spec_trace_down.empty())
             {
-              Size next_down_peak_idx = spec_trace_down.findNearest(centroid_mz);
-              double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
-              double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
-
-              double right_bound = centroid_mz + 3 * ftl_sd;
-              double left_bound = centroid_mz - 3 * ftl_sd;
+              SignedSize next_down_peak_idx = findNextPeak(trace_down_idx - 1);
+              if (result.crossed_low || result.crossed_high) { return; }
 
-              if ((next_down_peak_mz <= right_bound) &&
-                  (next_down_peak_mz >= left_bound) &&
-                  !peak_visited[spec_offsets[trace_down_idx - 1] + next_down_peak_idx]
-                      )
+              if (next_down_peak_idx != -1)
               {
+                double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
+                double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
+
                 Peak2D next_peak;
                 next_peak.setRT(spec_trace_down.getRT());
                 next_peak.setMZ(next_down_peak_mz);
@@ -447,17 +680,14 @@ namespace OpenMS
             const MSSpectrum& spec_trace_up = work_exp[trace_up_idx + 1];
             if (!spec_trace_up.empty())
             {
-              Size next_up_peak_idx = spec_trace_up.findNearest(centroid_mz);
-              double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
-              double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
-
-              double right_bound = centroid_mz + 3 * ftl_sd;
-              double left_bound = centroid_mz - 3 * ftl_sd;
+              SignedSize next_up_peak_idx = findNextPeak(trace_up_idx + 1);
+              if (result.crossed_low || result.crossed_high) { return; }
 
-              if ((next_up_peak_mz <= right_bound) &&
-                  (next_up_peak_mz >= left_bound) &&
-                  !peak_visited[spec_offsets[trace_up_idx + 1] + next_up_peak_idx])
+              if (next_up_peak_idx != -1)
               {
+                double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
+                double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
+
                 Peak2D next_peak;
                 next_peak.setRT(spec_trace_up.getRT());
                 next_peak.setMZ(next_up_peak_mz);
@@ -531,12 +761,12 @@ namespace OpenMS
         bool max_trace_criteria = (max_trace_length_ < 0.0 || rt_range < max_trace_length_);
         if (rt_range >= min_trace_length_ && max_trace_criteria && mt_quality >= min_sample_rate_)
         {
-          // std::cout << "T" << trace_number << "\t" << mt_quality << std::endl;
-
           // mark all peaks as visited
           for (Size i = 0; i < gathered_idx.size(); ++i)
           {
-            peak_visited[spec_offsets[gathered_idx[i].first] +  gathered_idx[i].second] = true;
+            const Size idx = spec_offsets[gathered_idx[i].first] + gathered_idx[i].second;
+            peak_visited[idx] = true;
+            result.marked.push_back(idx);
           }
 
           // create new MassTrace object and store collected peaks from list current_trace
@@ -550,24 +780,19 @@ namespace OpenMS
           new_trace.setQuantMethod(quant_method_);
           //new_trace.setCentroidSD(ftl_sd);
           new_trace.updateWeightedMZsd();
-          new_trace.setLabel("T" + String(trace_number));
-          ++trace_number;
 
-          found_masstraces.push_back(new_trace);
+          this->setProgress(peaks_detected += new_trace.getSize());
 
-          peaks_detected += new_trace.getSize();
-          this->setProgress(peaks_detected);
+          result.traces.emplace_back(rank, std::move(new_trace));
 
           // check if we already reached the (optional) maximum number of traces
-          if (max_traces > 0 && found_masstraces.size() == max_traces)
+          // (no other band can contribute to the first max_traces traces of this band)
+          if (max_traces > 0 && result.traces.size() == max_traces)
           {
             break;
           }
         }
       }
-
-      this->endProgress();
-
     }
 
     void MassTraceDetection::updateMembers_()
@@ -583,6 +808,7 @@ namespace OpenMS
       min_trace_length_ = (double)param_.getValue("min_trace_length");
       max_trace_length_ = (double)param_.getValue("max_trace_length");
       reestimate_mt_sd_ = param_.getValue("reestimate_mt_sd").toBool();
+      mz_bands_ = (Size)param_.getValue("mz_bands");
     }
 
 }
@@ -38,6 +38,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <cmath>
+#include <exception>
 
 namespace OpenMS
 {
@@ -68,7 +69,7 @@ namespace OpenMS
     write_log_messages_ = param_.getValue("write_log_messages").toBool();
   }
 
-  void GaussFilter::filter(MSSpectrum & spectrum)
+  void GaussFilter::filter(MSSpectrum & spectrum) const
   {
     // make sure the right data type is set
     spectrum.setType(SpectrumSettings::PROFILE);
@@ -115,7 +116,7 @@ namespace OpenMS
     }
   }
 
-  void GaussFilter::filter(MSChromatogram & chromatogram)
+  void GaussFilter::filter(MSChromatogram & chromatogram) const
   {
     if (param_.getValue("use_ppm_tolerance").toBool())
     {
@@ -168,20 +169,48 @@ namespace OpenMS
 
   void GaussFilter::filterExperiment(PeakMap & map)
   {
-    Size progress = 0;
     startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-    for (Size i = 0; i < map.size(); ++i)
+
+    const SignedSize n_spectra = (SignedSize)map.size();
+    std::vector<std::exception_ptr> errors(map.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < n_spectra; ++i)
     {
-      filter(map[i]);
-      setProgress(++progress);
+      try
+      {
+        filter(map[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+      nextProgress();
     }
 
-    for (Size i = 0; i < map.getChromatograms().size(); ++i)
+    std::vector<MSChromatogram>& chromatograms = map.getChromatograms();
+    const SignedSize n_chromatograms = (SignedSize)chromatograms.size();
+    std::vector<std::exception_ptr> chrom_errors(chromatograms.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < n_chromatograms; ++i)
     {
-      filter(map.getChromatogram(i));
-      setProgress(++progress);
+      try
+      {
+        filter(chromatograms[i]);
+      }
+      catch (...)
+      {
+        chrom_errors[i] = std::current_exception();
+      }
+      nextProgress();
     }
     endProgress();
+
+    // report the first error in input order, as the sequential loop did
+    errors.insert(errors.end(), chrom_errors.begin(), chrom_errors.end());
+    for (const std::exception_ptr& error : errors)
+    {
+      if (error) { std::rethrow_exception(error); }
+    }
   }
 
 }
@@ -55,6 +55,19 @@ namespace OpenMS
   {
   }
 
+  void SavitzkyGolayFilter::filterChromatograms(std::vector<MSChromatogram> & chromatograms) const
+  {
+#pragma omp parallel
+    {
+      std::vector<double> buffer; // one intensity buffer per thread
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)chromatograms.size(); ++i)
+      {
+        filterInPlace_(chromatograms[i], buffer);
+      }
+    }
+  }
+
   void SavitzkyGolayFilter::updateMembers_()
   {
     frame_size_ = (UInt)param_.getValue("frame_length");
@@ -35,6 +35,11 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 
+#include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureMaps.h>
+
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 namespace OpenMS
 {
@@ -112,4 +117,78 @@ namespace OpenMS
     return *this;
   }
 
+  void SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const
+  {
+    clusters.clear();
+    if (data.empty()) return;
+
+    SpectraDistance_ llc;
+    llc.setParameters(param_.copy("precursor_method:", true));
+    double rt_tol = param_.getValue("precursor_method:rt_tolerance");
+    double mz_tol = param_.getValue("precursor_method:mz_tolerance");
+
+    // 2D tree on (RT, precursor m/z) for range queries
+    KDTreeFeatureMaps kd_data;
+    for (const BaseFeature& bf : data)
+    {
+      kd_data.addFeature(0, &bf);
+    }
+    kd_data.optimizeTree();
+
+    // union-find over all pairs which are linked (single linkage)
+    std::vector<Size> parent(data.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]]; // path halving
+        i = parent[i];
+      }
+      return i;
+    };
+
+    // linked partners of each precursor, from batched (parallel) range queries
+    std::vector<std::vector<Size> > neighbors;
+    kd_data.getNeighborhoods(neighbors, rt_tol, mz_tol, false, true);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)data.size(); ++i)
+    {
+      std::vector<Size>& linked = neighbors[i];
+      linked.erase(std::remove_if(linked.begin(), linked.end(), [&](Size j)
+        {
+          // each pair once; same criterion as hierarchical clustering: distance (1 - similarity) below 1.0
+          return j <= (Size)i || !(float(1 - llc(data[i], data[j])) < 1);
+        }), linked.end());
+    }
+
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      for (Size j : neighbors[i])
+      {
+        Size root_i = find_root(i);
+        Size root_j = find_root(j);
+        if (root_i != root_j)
+        {
+          // the smaller index becomes the root (i.e. cluster representative)
+          parent[std::max(root_i, root_j)] = std::min(root_i, root_j);
+        }
+      }
+    }
+
+    // collect clusters: elements sorted ascending, clusters sorted by first element
+    std::vector<Size> cluster_of(data.size());
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      Size root = find_root(i);
+      if (root == i)
+      {
+        cluster_of[i] = clusters.size();
+        clusters.emplace_back();
+      }
+      // roots are always the smallest index of their cluster, i.e. already seen
+      clusters[cluster_of[root]].push_back(i);
+    }
+  }
+
 }
@@ -0,0 +1,281 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/FILTERING/TRANSFORMERS/SpectrumPreprocessingPipeline.h>
+
+#include <OpenMS/FILTERING/DATAREDUCTION/Deisotoper.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+namespace OpenMS
+{
+  SpectrumPreprocessingPipeline::SpectrumPreprocessingPipeline() :
+    DefaultParamHandler("SpectrumPreprocessingPipeline")
+  {
+    defaults_.setValue("steps", std::vector<std::string>{"threshold", "normalize", "deisotope", "window_mower", "nlargest"}, "Filters to apply, in this order.");
+    defaults_.setValidStrings("steps", {"threshold","normalize","deisotope","window_mower","nlargest","sqrt"});
+
+    defaults_.setValue("threshold:threshold", 0.05, "Intensity threshold, peaks below this threshold are discarded");
+
+    defaults_.setValue("normalize:method", "to_one", "Normalize via dividing by TIC ('to_TIC') per spectrum or normalize to max. intensity of one ('to_one') per spectrum.");
+    defaults_.setValidStrings("normalize:method", {"to_one","to_TIC"});
+
+    defaults_.setValue("deisotope:fragment_tolerance", 10.0, "The tolerance used to match isotopic peaks.");
+    defaults_.setMinFloat("deisotope:fragment_tolerance", 0.0);
+    defaults_.setValue("deisotope:fragment_unit", "ppm", "Unit of the fragment tolerance.");
+    defaults_.setValidStrings("deisotope:fragment_unit", {"ppm","Da"});
+    defaults_.setValue("deisotope:min_charge", 1, "The minimum charge considered.");
+    defaults_.setMinInt("deisotope:min_charge", 1);
+    defaults_.setValue("deisotope:max_charge", 3, "The maximum charge considered.");
+    defaults_.setMinInt("deisotope:max_charge", 1);
+    defaults_.setValue("deisotope:keep_only_deisotoped", "false", "Only monoisotopic peaks of fragments with isotopic pattern are retained.");
+    defaults_.setValidStrings("deisotope:keep_only_deisotoped", {"true","false"});
+    defaults_.setValue("deisotope:min_isopeaks", 3, "The minimum number of isotopic peaks required for an isotopic cluster.");
+    defaults_.setMinInt("deisotope:min_isopeaks", 2);
+    defaults_.setValue("deisotope:max_isopeaks", 10, "The maximum number of isotopic peaks considered for an isotopic cluster.");
+    defaults_.setMinInt("deisotope:max_isopeaks", 2);
+    defaults_.setValue("deisotope:make_single_charged", "true", "Convert deisotoped monoisotopic peaks to single charge.");
+    defaults_.setValidStrings("deisotope:make_single_charged", {"true","false"});
+    defaults_.setValue("deisotope:annotate_charge", "false", "Annotate the charge of the peaks in the IntegerDataArray 'charge'.");
+    defaults_.setValidStrings("deisotope:annotate_charge", {"true","false"});
+
+    defaults_.setValue("window_mower:windowsize", 100.0, "The size of the jumping window along the m/z axis.");
+    defaults_.setMinFloat("window_mower:windowsize", 0.0);
+    defaults_.setValue("window_mower:peakcount", 20, "The number of peaks that should be kept per window.");
+    defaults_.setMinInt("window_mower:peakcount", 0);
+
+    defaults_.setValue("nlargest:n", 400, "The number of peaks to keep.");
+    defaults_.setMinInt("nlargest:n", 0);
+
+    defaultsToParam_();
+  }
+
+  SpectrumPreprocessingPipeline::~SpectrumPreprocessingPipeline()
+  {
+  }
+
+  SpectrumPreprocessingPipeline::SpectrumPreprocessingPipeline(const SpectrumPreprocessingPipeline& source) :
+    DefaultParamHandler(source)
+  {
+    updateMembers_();
+  }
+
+  SpectrumPreprocessingPipeline& SpectrumPreprocessingPipeline::operator=(const SpectrumPreprocessingPipeline& source)
+  {
+    if (this != &source)
+    {
+      DefaultParamHandler::operator=(source);
+      updateMembers_();
+    }
+    return *this;
+  }
+
+  void SpectrumPreprocessingPipeline::updateMembers_()
+  {
+    steps_.clear();
+    for (const String& step : ListUtils::toStringList<std::string>(param_.getValue("steps")))
+    {
+      if (step == "threshold") steps_.push_back(THRESHOLD);
+      else if (step == "normalize") steps_.push_back(NORMALIZE);
+      else if (step == "deisotope") steps_.push_back(DEISOTOPE);
+      else if (step == "window_mower") steps_.push_back(WINDOW_MOWER);
+      else if (step == "nlargest") steps_.push_back(NLARGEST);
+      else if (step == "sqrt") steps_.push_back(SQRT);
+      else
+      {
+        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown preprocessing step '" + step + "'.");
+      }
+    }
+
+    threshold_ = param_.getValue("threshold:threshold");
+    normalize_to_tic_ = param_.getValue("normalize:method") == "to_TIC";
+
+    deisotope_tolerance_ = param_.getValue("deisotope:fragment_tolerance");
+    deisotope_unit_ppm_ = param_.getValue("deisotope:fragment_unit") == "ppm";
+    deisotope_min_charge_ = param_.getValue("deisotope:min_charge");
+    deisotope_max_charge_ = param_.getValue("deisotope:max_charge");
+    deisotope_keep_only_deisotoped_ = param_.getValue("deisotope:keep_only_deisotoped").toBool();
+    deisotope_min_isopeaks_ = (unsigned int)(int)param_.getValue("deisotope:min_isopeaks");
+    deisotope_max_isopeaks_ = (unsigned int)(int)param_.getValue("deisotope:max_isopeaks");
+    deisotope_make_single_charged_ = param_.getValue("deisotope:make_single_charged").toBool();
+    deisotope_annotate_charge_ = param_.getValue("deisotope:annotate_charge").toBool();
+
+    window_size_ = param_.getValue("window_mower:windowsize");
+    window_peakcount_ = (Size)(int)param_.getValue("window_mower:peakcount");
+
+    nlargest_ = (Size)(int)param_.getValue("nlargest:n");
+  }
+
+  void SpectrumPreprocessingPipeline::keepMostIntense_(const PeakSpectrum& spectrum, const std::vector<Size>& alive, Size first, Size last, Size count,
+                                                       std::vector<Size>& order, std::vector<char>& discard)
+  {
+    if (last - first <= count) return;
+
+    order.assign(alive.begin() + first, alive.begin() + last);
+    // most intense first, ties resolved by position (i.e. lower m/z first)
+    std::nth_element(order.begin(), order.begin() + count, order.end(),
+      [&spectrum](Size a, Size b)
+      {
+        const float ia = spectrum[a].getIntensity();
+        const float ib = spectrum[b].getIntensity();
+        return ia > ib || (ia == ib && a < b);
+      });
+    for (auto it = order.begin() + count; it != order.end(); ++it)
+    {
+      discard[*it] = 1;
+    }
+  }
+
+  void SpectrumPreprocessingPipeline::compact_(std::vector<Size>& alive, const std::vector<char>& discard)
+  {
+    alive.erase(std::remove_if(alive.begin(), alive.end(), [&discard](Size i) { return discard[i] != 0; }), alive.end());
+  }
+
+  void SpectrumPreprocessingPipeline::filterPeakSpectrum(PeakSpectrum& spectrum) const
+  {
+    if (!spectrum.isSorted())
+    {
+      spectrum.sortByPosition();
+    }
+
+    // indices of the peaks which are still part of the spectrum (in m/z order)
+    std::vector<Size> alive(spectrum.size());
+    std::iota(alive.begin(), alive.end(), 0);
+    std::vector<char> discard(spectrum.size(), 0);
+    std::vector<Size> order;
+
+    for (Step_ step : steps_)
+    {
+      if (alive.empty()) break;
+
+      switch (step)
+      {
+      case THRESHOLD:
+        for (Size i : alive)
+        {
+          if (!(spectrum[i].getIntensity() >= threshold_)) discard[i] = 1;
+        }
+        compact_(alive, discard);
+        break;
+
+      case NORMALIZE:
+      {
+        double divisor(0);
+        if (normalize_to_tic_)
+        {
+          for (Size i : alive) divisor += spectrum[i].getIntensity();
+        }
+        else
+        {
+          divisor = spectrum[alive[0]].getIntensity();
+          for (Size i : alive) divisor = std::max(divisor, (double)spectrum[i].getIntensity());
+        }
+        for (Size i : alive) spectrum[i].setIntensity(spectrum[i].getIntensity() / divisor);
+        break;
+      }
+
+      case DEISOTOPE:
+        // Deisotoper works on the spectrum itself: apply pending removals first
+        if (alive.size() != spectrum.size())
+        {
+          spectrum.select(alive);
+        }
+        Deisotoper::deisotopeAndSingleCharge(spectrum,
+          deisotope_tolerance_, deisotope_unit_ppm_,
+          deisotope_min_charge_, deisotope_max_charge_,
+          deisotope_keep_only_deisotoped_,
+          deisotope_min_isopeaks_, deisotope_max_isopeaks_,
+          deisotope_make_single_charged_,
+          deisotope_annotate_charge_);
+        alive.resize(spectrum.size());
+        std::iota(alive.begin(), alive.end(), 0);
+        discard.assign(spectrum.size(), 0);
+        break;
+
+      case WINDOW_MOWER:
+      {
+        // jumping windows: a new window starts at the first peak outside the current one
+        Size window_first = 0;
+        double window_start = spectrum[alive[0]].getMZ();
+        for (Size k = 0; k != alive.size(); ++k)
+        {
+          if (spectrum[alive[k]].getMZ() - window_start < window_size_) continue;
+          keepMostIntense_(spectrum, alive, window_first, k, window_peakcount_, order, discard);
+          window_first = k;
+          window_start = spectrum[alive[k]].getMZ();
+        }
+        // the last window might be much smaller than windowsize: adapt the number of peaks kept (as WindowMower does)
+        double last_window_size = spectrum[alive.back()].getMZ() - window_start;
+        Size last_window_peakcount = static_cast<Size>(std::round(last_window_size / window_size_ * window_peakcount_));
+        keepMostIntense_(spectrum, alive, window_first, alive.size(), last_window_peakcount, order, discard);
+        compact_(alive, discard);
+        break;
+      }
+
+      case NLARGEST:
+        keepMostIntense_(spectrum, alive, 0, alive.size(), nlargest_, order, discard);
+        compact_(alive, discard);
+        break;
+
+      case SQRT:
+        for (Size i : alive)
+        {
+          spectrum[i].setIntensity(std::sqrt(std::max(spectrum[i].getIntensity(), 0.0f)));
+        }
+        break;
+      }
+    }
+
+    if (alive.size() != spectrum.size())
+    {
+      spectrum.select(alive);
+    }
+  }
+
+  void SpectrumPreprocessingPipeline::filterPeakMap(PeakMap& exp) const
+  {
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+    {
+      filterPeakSpectrum(exp[i]);
+    }
+  }
+
+}
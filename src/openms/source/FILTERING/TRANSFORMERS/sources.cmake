@@ -22,6 +22,7 @@ PeakMarker.cpp
 #~ PreprocessingFunctor.cpp
 Scaler.cpp
 SpectraMerger.cpp
+SpectrumPreprocessingPipeline.cpp
 SqrtMower.cpp
 TICFilter.cpp
 ThresholdMower.cpp
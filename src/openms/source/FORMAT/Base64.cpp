@@ -34,8 +34,19 @@
 
 #include <OpenMS/FORMAT/Base64.h>
 
-#include <QtCore/QList>
-#include <QtCore/QString>
+#include <OpenMS/FORMAT/ZlibCompression.h>
+
+#include <array>
+
+// SIMD kernels: on x86 with GCC/Clang the best instruction set is selected at
+// runtime (no special compiler flags needed), on ARM64 NEON is always present
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define OPENMS_BASE64_X86_DISPATCH
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define OPENMS_BASE64_NEON
+#include <arm_neon.h>
+#endif
 
 using namespace std;
 
@@ -82,47 +93,348 @@ namespace OpenMS
      /   = 47       ->       63
 
 
-  this can be done by first subtracting 43 from each value
-  and then looking up a value in a table as found in the code,
-  e.g. lookup[char - 43] - 62
+  For scalar decoding we use a direct mapping of all 256 possible
+  characters to their target (invalid characters are mapped to 0). The SIMD
+  decoders translate 16 or more characters at once using range comparisons
+  and fall back to the scalar decoder for blocks containing invalid
+  characters, so all code paths produce identical results.
 
-  The following string can be produced by this Python snippet:
+  */
 
-offset = 62
-s = ""
-s += chr(62 + offset)
-s += '$' * 3
-s += "".join([ chr(52 + i + offset) for i in range(10) ])
-s += '$' * 7
-s += "".join([ chr(i + offset) for i in range(26) ])
-s += '$' * 6
-s += "".join([ chr(26 + i + offset) for i in range(26) ])
-print s
+  namespace
+  {
+    using DecodeFunction = Size (*)(const Byte* in, Size in_size, Byte* out);
+    using EncodeFunction = Size (*)(const Byte* in, Size in_size, Byte* out);
 
-"|$$$rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\]^_`abcdefghijklmnopq"
+    constexpr char encoder[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-  however, this is basically just convenience to produce printable characters.
-  We could also go for a direct mapping:
+    constexpr std::array<Byte, 256> decode_table = []
+    {
+      std::array<Byte, 256> table{};
+      for (Byte i = 0; i < 64; ++i)
+      {
+        table[(Byte)encoder[i]] = i;
+      }
+      return table;
+    }();
 
-s = '$' * 42
-s += hex(62)
-s += '$' * 3
-s += "".join([ hex(52 + i) for i in range(10) ])
-s += '$' * 7
-s += "".join([ hex(i) for i in range(26) ])
-s += '$' * 6
-s += "".join([ hex(26 + i) for i in range(26) ])
-print s
+    Size decodeScalar(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      for (; i + 4 <= in_size; i += 4)
+      {
+        const UInt32 int_24bit = (UInt32(decode_table[in[i]]) << 18) | (UInt32(decode_table[in[i + 1]]) << 12) |
+                                 (UInt32(decode_table[in[i + 2]]) << 6) | UInt32(decode_table[in[i + 3]]);
+        *to++ = Byte(int_24bit >> 16);
+        *to++ = Byte(int_24bit >> 8);
+        *to++ = Byte(int_24bit);
+      }
+      // remaining 2 or 3 characters encode 1 or 2 bytes (a single character encodes nothing)
+      const Size rest = in_size - i;
+      if (rest >= 2)
+      {
+        UInt32 int_24bit = (UInt32(decode_table[in[i]]) << 18) | (UInt32(decode_table[in[i + 1]]) << 12);
+        if (rest == 3)
+        {
+          int_24bit |= UInt32(decode_table[in[i + 2]]) << 6;
+        }
+        *to++ = Byte(int_24bit >> 16);
+        if (rest == 3)
+        {
+          *to++ = Byte(int_24bit >> 8);
+        }
+      }
+      return to - out;
+    }
 
-"$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$0x3e$$$0x340x350x360x370x380x390x3a0x3b0x3c0x3d$$$$$$$0x00x10x20x30x40x50x60x70x80x90xa0xb0xc0xd0xe0xf0x100x110x120x130x140x150x160x170x180x19$$$$$$0x1a0x1b0x1c0x1d0x1e0x1f0x200x210x220x230x240x250x260x270x280x290x2a0x2b0x2c0x2d0x2e0x2f0x300x310x320x33"
+    Size encodeScalar(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      for (; i + 3 <= in_size; i += 3)
+      {
+        const UInt32 int_24bit = (UInt32(in[i]) << 16) | (UInt32(in[i + 1]) << 8) | UInt32(in[i + 2]);
+        *to++ = encoder[(int_24bit >> 18) & 0x3F];
+        *to++ = encoder[(int_24bit >> 12) & 0x3F];
+        *to++ = encoder[(int_24bit >> 6) & 0x3F];
+        *to++ = encoder[int_24bit & 0x3F];
+      }
+      // fixup for padding
+      const Size rest = in_size - i;
+      if (rest > 0)
+      {
+        UInt32 int_24bit = UInt32(in[i]) << 16;
+        if (rest == 2)
+        {
+          int_24bit |= UInt32(in[i + 1]) << 8;
+        }
+        *to++ = encoder[(int_24bit >> 18) & 0x3F];
+        *to++ = encoder[(int_24bit >> 12) & 0x3F];
+        *to++ = rest == 2 ? encoder[(int_24bit >> 6) & 0x3F] : '=';
+        *to++ = '=';
+      }
+      return to - out;
+    }
 
-  which would allow lookup[char] without any adding or subtraction step (but
-  needs a 42 byte extra memory in the local cache).
+#ifdef OPENMS_BASE64_X86_DISPATCH
+    /// Translates 16 Base64 characters to their 6 bit values, returns false if invalid characters are present
+    __attribute__((target("ssse3")))
+    inline bool translateSSSE3(const __m128i input, __m128i& values)
+    {
+      // all valid characters are below 128, i.e. positive as signed bytes
+      const __m128i range_AZ = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), input));
+      const __m128i range_az = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), input));
+      const __m128i range_09 = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), input));
+      const __m128i char_plus = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+      const __m128i char_slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+
+      const __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(range_AZ, range_az), _mm_or_si128(range_09, char_plus)), char_slash);
+      if (_mm_movemask_epi8(valid) != 0xFFFF)
+      {
+        return false;
+      }
 
-  */
+      __m128i shift = _mm_and_si128(range_AZ, _mm_set1_epi8(-'A'));
+      shift = _mm_or_si128(shift, _mm_and_si128(range_az, _mm_set1_epi8(26 - 'a')));
+      shift = _mm_or_si128(shift, _mm_and_si128(range_09, _mm_set1_epi8(52 - '0')));
+      shift = _mm_or_si128(shift, _mm_and_si128(char_plus, _mm_set1_epi8(62 - '+')));
+      shift = _mm_or_si128(shift, _mm_and_si128(char_slash, _mm_set1_epi8(63 - '/')));
+      values = _mm_add_epi8(input, shift);
+      return true;
+    }
+
+    /// Packs 16 6-bit values (four per 32 bit word) into 12 bytes at the front of the register
+    __attribute__((target("ssse3")))
+    inline __m128i packSSSE3(const __m128i values)
+    {
+      // [00aaaaaa 00bbbbbb 00cccccc 00dddddd] -> [0000aaaa aabbbbbb 0000cccc ccdddddd]
+      const __m128i merged_ab_cd = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+      // -> 24 bit integer per 32 bit word (little endian)
+      const __m128i merged = _mm_madd_epi16(merged_ab_cd, _mm_set1_epi32(0x00011000));
+      // reorder the three bytes of each word to big endian and move them to the front
+      return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    __attribute__((target("ssse3")))
+    Size decodeSSSE3(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      // each block writes 16 bytes (12 valid): make sure we never write beyond the output
+      for (; i + 24 <= in_size; i += 16)
+      {
+        __m128i values;
+        if (!translateSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), values))
+        {
+          break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to), packSSSE3(values));
+        to += 12;
+      }
+      return (to - out) + decodeScalar(in + i, in_size - i, to);
+    }
+
+    __attribute__((target("avx2")))
+    Size decodeAVX2(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      // each block writes 32 bytes (24 valid): make sure we never write beyond the output
+      for (; i + 48 <= in_size; i += 32)
+      {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i range_AZ = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), input));
+        const __m256i range_az = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), input));
+        const __m256i range_09 = _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), input));
+        const __m256i char_plus = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('+'));
+        const __m256i char_slash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8('/'));
+
+        const __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(range_AZ, range_az), _mm256_or_si256(range_09, char_plus)), char_slash);
+        if (_mm256_movemask_epi8(valid) != -1)
+        {
+          break;
+        }
+
+        __m256i shift = _mm256_and_si256(range_AZ, _mm256_set1_epi8(-'A'));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(range_az, _mm256_set1_epi8(26 - 'a')));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(range_09, _mm256_set1_epi8(52 - '0')));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(char_plus, _mm256_set1_epi8(62 - '+')));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(char_slash, _mm256_set1_epi8(63 - '/')));
+        const __m256i values = _mm256_add_epi8(input, shift);
+
+        // same packing as in packSSSE3, per 128 bit lane
+        const __m256i merged_ab_cd = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i merged = _mm256_madd_epi16(merged_ab_cd, _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                                            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        // move the 12 valid bytes of the upper lane next to the ones of the lower lane
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(to), _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+        to += 24;
+      }
+      return (to - out) + decodeSSSE3(in + i, in_size - i, to);
+    }
+
+    __attribute__((target("ssse3")))
+    Size encodeSSSE3(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      // each block reads 16 bytes (12 used) and writes 16 characters
+      for (; i + 16 <= in_size; i += 12)
+      {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // distribute 3 input bytes into each 32 bit word: [b1 b0 b2 b1]
+        input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        // extract the four 6 bit values of each word into separate bytes
+        const __m128i t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // map 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12 and look up the offset to the character
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+        const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        const __m128i result = _mm_add_epi8(_mm_shuffle_epi8(shift_lut, reduced), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to), result);
+        to += 16;
+      }
+      return (to - out) + encodeScalar(in + i, in_size - i, to);
+    }
+
+    DecodeFunction selectDecoder()
+    {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) return &decodeAVX2;
+      if (__builtin_cpu_supports("ssse3")) return &decodeSSSE3;
+      return &decodeScalar;
+    }
+
+    EncodeFunction selectEncoder()
+    {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("ssse3")) return &encodeSSSE3;
+      return &encodeScalar;
+    }
+#elif defined(OPENMS_BASE64_NEON)
+    /// Translates 16 Base64 characters to their 6 bit values, invalid characters are flagged in @p invalid
+    inline uint8x16_t translateNEON(const uint8x16_t input, uint8x16_t& invalid)
+    {
+      const uint8x16_t range_AZ = vandq_u8(vcgeq_u8(input, vdupq_n_u8('A')), vcleq_u8(input, vdupq_n_u8('Z')));
+      const uint8x16_t range_az = vandq_u8(vcgeq_u8(input, vdupq_n_u8('a')), vcleq_u8(input, vdupq_n_u8('z')));
+      const uint8x16_t range_09 = vandq_u8(vcgeq_u8(input, vdupq_n_u8('0')), vcleq_u8(input, vdupq_n_u8('9')));
+      const uint8x16_t char_plus = vceqq_u8(input, vdupq_n_u8('+'));
+      const uint8x16_t char_slash = vceqq_u8(input, vdupq_n_u8('/'));
+
+      const uint8x16_t valid = vorrq_u8(vorrq_u8(vorrq_u8(range_AZ, range_az), vorrq_u8(range_09, char_plus)), char_slash);
+      invalid = vorrq_u8(invalid, vmvnq_u8(valid));
+
+      uint8x16_t shift = vandq_u8(range_AZ, vdupq_n_u8(Byte(-'A')));
+      shift = vorrq_u8(shift, vandq_u8(range_az, vdupq_n_u8(Byte(26 - 'a'))));
+      shift = vorrq_u8(shift, vandq_u8(range_09, vdupq_n_u8(Byte(52 - '0'))));
+      shift = vorrq_u8(shift, vandq_u8(char_plus, vdupq_n_u8(Byte(62 - '+'))));
+      shift = vorrq_u8(shift, vandq_u8(char_slash, vdupq_n_u8(Byte(63 - '/'))));
+      return vaddq_u8(input, shift);
+    }
 
-  const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  const char Base64::decoder_[] = "|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+    Size decodeNEON(const Byte* in, Size in_size, Byte* out)
+    {
+      Byte* to = out;
+      Size i = 0;
+      for (; i + 64 <= in_size; i += 64)
+      {
+        // de-interleave: val[k] holds character k of 16 consecutive quadruplets
+        const uint8x16x4_t input = vld4q_u8(in + i);
+        uint8x16_t invalid = vdupq_n_u8(0);
+        const uint8x16_t a = translateNEON(input.val[0], invalid);
+        const uint8x16_t b = translateNEON(input.val[1], invalid);
+        const uint8x16_t c = translateNEON(input.val[2], invalid);
+        const uint8x16_t d = translateNEON(input.val[3], invalid);
+        if (vmaxvq_u8(invalid) != 0)
+        {
+          break;
+        }
+        uint8x16x3_t result;
+        result.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        result.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        result.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(to, result);
+        to += 48;
+      }
+      return (to - out) + decodeScalar(in + i, in_size - i, to);
+    }
+
+    DecodeFunction selectDecoder()
+    {
+      return &decodeNEON;
+    }
+
+    EncodeFunction selectEncoder()
+    {
+      return &encodeScalar;
+    }
+#else
+    DecodeFunction selectDecoder()
+    {
+      return &decodeScalar;
+    }
+
+    EncodeFunction selectEncoder()
+    {
+      return &encodeScalar;
+    }
+#endif
+  } // anonymous namespace
+
+  Size Base64::decodeRaw_(const char* in, Size in_size, Byte* out)
+  {
+    static const DecodeFunction decode = selectDecoder();
+    return decode(reinterpret_cast<const Byte*>(in), in_size, out);
+  }
+
+  void Base64::decodeBytes(const char* in, Size in_size, std::vector<Byte>& out, bool zlib_compression)
+  {
+    out.clear();
+    // The length of a base64 string is a always a multiple of 4 (always 3
+    // bytes are encoded as 4 characters)
+    if (in_size < 4)
+    {
+      return;
+    }
+    const Size src_size = stripPadding_(in, in_size);
+    if (!zlib_compression)
+    {
+      out.resize((src_size * 3) / 4);
+      out.resize(decodeRaw_(in, src_size, out.data()));
+      return;
+    }
+    thread_local std::vector<Byte> compressed;
+    compressed.resize((src_size * 3) / 4);
+    compressed.resize(decodeRaw_(in, src_size, compressed.data()));
+    ZlibCompression::uncompressData(compressed.data(), compressed.size(), out);
+  }
+
+  const std::vector<Byte>& Base64::decompressToThreadBuffer_(const String& in)
+  {
+    thread_local std::vector<Byte> decompressed;
+    decodeBytes(in.c_str(), in.size(), decompressed, true);
+    return decompressed;
+  }
+
+  void Base64::encodeRaw_(const Byte* in, Size in_size, String& out)
+  {
+    static const EncodeFunction encode = selectEncoder();
+    out.resize((in_size + 2) / 3 * 4);
+    if (out.empty())
+    {
+      return;
+    }
+    out.resize(encode(in, in_size, reinterpret_cast<Byte*>(&out[0])));
+  }
 
   void Base64::encodeStrings(const std::vector<String>& in, String& out, bool zlib_compression, bool append_null_byte)
   {
@@ -173,58 +485,13 @@ print s
 
       it = reinterpret_cast<Byte*>(&compressed[0]);
       end = it + compressed_length;
-      // TODO check integer overflow
-      out.resize((Size)ceil(compressed_length / 3.) * 4); //resize output array in order to have enough space for all characters
     }
     else
     {
-      // TODO check integer overflow
-      out.resize((Size)ceil(str.size() / 3.) * 4); //resize output array in order to have enough space for all characters
       it = reinterpret_cast<Byte*>(&str[0]);
       end = it + str.size();
     }
-    Byte* to = reinterpret_cast<Byte*>(&out[0]);
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-      {
-        to[3] = '=';
-      }
-      if (padding_count > 1)
-      {
-        to[2] = '=';
-      }
-      to += 4;
-      written += 4;
-    }
-
-    out.resize(written); //no more space is needed
+    encodeRaw_(it, end - it, out);
   }
 
   void Base64::decodeStrings(const String& in, std::vector<String>& out, bool zlib_compression)
@@ -238,15 +505,20 @@ print s
       return;
     }
 
-    QByteArray base64_uncompressed;
-    decodeSingleString(in, base64_uncompressed, zlib_compression);
-    QList<QByteArray> null_strings = base64_uncompressed.split('\0');
-    for (QList<QByteArray>::iterator it = null_strings.begin(); it < null_strings.end(); ++it)
+    thread_local std::vector<Byte> base64_uncompressed;
+    decodeBytes(in.c_str(), in.size(), base64_uncompressed, zlib_compression);
+
+    // split at null bytes, skipping empty strings
+    const char* start = reinterpret_cast<const char*>(base64_uncompressed.data());
+    const char* end = start + base64_uncompressed.size();
+    while (start < end)
     {
-      if (!it->isEmpty())
+      const char* null_byte = std::find(start, end, '\0');
+      if (null_byte != start)
       {
-        out.push_back(QString(*it).toStdString());
+        out.push_back(String(std::string(start, null_byte)));
       }
+      start = null_byte + 1;
     }
   }
 
@@ -34,6 +34,7 @@
 
 
 #include <OpenMS/FORMAT/Bzip2InputStream.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 using namespace xercesc;
@@ -43,11 +44,13 @@ namespace OpenMS
   Bzip2InputStream::Bzip2InputStream(const String & file_name) :
     bzip2_(new Bzip2Ifstream(file_name.c_str())), file_current_index_(0)
   {
+    startReadAhead_();
   }
 
   Bzip2InputStream::Bzip2InputStream(const char * file_name) :
     bzip2_(new Bzip2Ifstream(file_name)), file_current_index_(0)
   {
+    startReadAhead_();
   }
 
 /*	Bzip2InputStream::Bzip2InputStream()
@@ -58,19 +61,34 @@ namespace OpenMS
 
   Bzip2InputStream::~Bzip2InputStream()
   {
+    read_ahead_.reset(); // stop reading before closing the file
     delete bzip2_;
   }
 
+  void Bzip2InputStream::startReadAhead_()
+  {
+    Bzip2Ifstream* stream = bzip2_;
+    read_ahead_.reset(new ReadAheadBuffer([stream](char* s, size_t n) -> size_t
+    {
+      return stream->streamEnd() ? 0 : stream->read(s, n);
+    }));
+  }
+
+  bool Bzip2InputStream::getIsOpen() const
+  {
+    return !read_ahead_->streamEnd();
+  }
+
   XMLSize_t Bzip2InputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
   {
     //  Figure out whether we can really read.
-    if (bzip2_->streamEnd())
+    if (read_ahead_->streamEnd())
     {
       return 0;
     }
 
     unsigned char * fill_it = static_cast<unsigned char *>(to_fill);
-    XMLSize_t actual_read = (XMLSize_t) bzip2_->read((char *)fill_it, static_cast<size_t>(max_to_read));
+    XMLSize_t actual_read = (XMLSize_t) read_ahead_->read((char *)fill_it, static_cast<size_t>(max_to_read));
     file_current_index_ += actual_read;
     return actual_read;
   }
@@ -44,30 +44,40 @@
 
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 namespace OpenMS
 {
 
-  CachedmzML::CachedmzML()
+  CachedmzML::CachedmzML() :
+    meta_ms_experiment_(new MSExperiment),
+    spectra_index_(new std::vector<std::streampos>),
+    chrom_index_(new std::vector<std::streampos>),
+    format_version_(Internal::CachedMzMLHandler::FORMAT_V1)
   {
   }
 
-  CachedmzML::CachedmzML(const String& filename)
+  CachedmzML::CachedmzML(const String& filename) :
+    CachedmzML()
   {
     load_(filename);
   }
 
   CachedmzML::~CachedmzML()
   {
-    ifs_.close();
   }
 
   CachedmzML::CachedmzML(const CachedmzML & rhs) :
     meta_ms_experiment_(rhs.meta_ms_experiment_),
-    ifs_(rhs.filename_cached_.c_str(), std::ios::binary),
+    mapping_(rhs.mapping_),
     filename_(rhs.filename_),
+    filename_cached_(rhs.filename_cached_),
     spectra_index_(rhs.spectra_index_),
-    chrom_index_(rhs.chrom_index_)
+    chrom_index_(rhs.chrom_index_),
+    format_version_(rhs.format_version_)
   {
+    // the shared data is read-only, no need to copy anything
   }
 
   void CachedmzML::load_(const String& filename)
@@ -78,30 +88,50 @@ namespace OpenMS
     // Create the index from the given file
     Internal::CachedMzMLHandler cache;
     cache.createMemdumpIndex(filename_cached_);
-    spectra_index_ = cache.getSpectraIndex();
-    chrom_index_ = cache.getChromatogramIndex();;
+    spectra_index_ = std::make_shared<const std::vector<std::streampos> >(cache.getSpectraIndex());
+    chrom_index_ = std::make_shared<const std::vector<std::streampos> >(cache.getChromatogramIndex());
+    format_version_ = cache.getFormatVersion();
 
-    // open the filestream
-    ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    // map the cached file
+    try
+    {
+      boost::interprocess::file_mapping file(filename_cached_.c_str(), boost::interprocess::read_only);
+      auto region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+      region->advise(boost::interprocess::mapped_region::advice_random);
+      mapping_ = region;
+    }
+    catch (boost::interprocess::interprocess_exception&)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_cached_);
+    }
 
     // load the meta data from disk
-    MzMLFile().load(filename, meta_ms_experiment_);
+    auto meta = std::make_shared<MSExperiment>();
+    MzMLFile().load(filename, *meta);
+    meta_ms_experiment_ = meta;
   }
 
-  MSSpectrum CachedmzML::getSpectrum(Size id)
+  std::pair<const char*, Size> CachedmzML::mappedData_(std::streampos offset) const
   {
-    OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
-
-    if ( !ifs_.seekg(spectra_index_[id]) )
+    const Size region_size = mapping_ ? mapping_->get_size() : 0;
+    if (offset < 0 || Size(std::streamoff(offset)) >= region_size)
     {
-      std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
-      std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
+      std::cerr << "Error while reading from cached file - invalid position " << offset << "." << std::endl;
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Error while changing position of input stream pointer.", filename_cached_);
+        "Error while accessing the mapped cached file.", filename_cached_);
     }
+    const Size start = Size(std::streamoff(offset));
+    return std::make_pair(static_cast<const char*>(mapping_->get_address()) + start, region_size - start);
+  }
 
-    MSSpectrum s = meta_ms_experiment_.getSpectrum(id);
-    Internal::CachedMzMLHandler::readSpectrum(s, ifs_);
+  MSSpectrum CachedmzML::getSpectrum(Size id)
+  {
+    OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
+
+    const auto data = mappedData_((*spectra_index_)[id]);
+    MSSpectrum s = (*meta_ms_experiment_)[id];
+    Internal::CachedMzMLHandler::readSpectrum(s, data.first, data.second,
+      Internal::CachedMzMLHandler::FormatVersion(format_version_));
     return s;
   }
 
@@ -109,32 +139,29 @@ namespace OpenMS
   {
     OPENMS_PRECONDITION(id < getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
-    if ( !ifs_.seekg(chrom_index_[id]) )
-    {
-      std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
-      std::cerr << "Maybe an invalid position was supplied to seekg, this can happen for example when reading large files (>2GB) on 32bit systems." << std::endl;
-      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Error while changing position of input stream pointer.", filename_cached_);
-    }
-
-    MSChromatogram c = meta_ms_experiment_.getChromatogram(id);
-    Internal::CachedMzMLHandler::readChromatogram(c, ifs_);
+    const auto data = mappedData_((*chrom_index_)[id]);
+    MSChromatogram c = meta_ms_experiment_->getChromatograms()[id];
+    Internal::CachedMzMLHandler::readChromatogram(c, data.first, data.second,
+      Internal::CachedMzMLHandler::FormatVersion(format_version_));
     return c;
   }
 
   size_t CachedmzML::getNrSpectra() const
   {
-    return meta_ms_experiment_.size();
+    return meta_ms_experiment_->size();
   }
 
   size_t CachedmzML::getNrChromatograms() const
   {
-    return meta_ms_experiment_.getChromatograms().size();
+    return meta_ms_experiment_->getChromatograms().size();
   }
 
-  void CachedmzML::store(const String& filename, const PeakMap& map)
+  void CachedmzML::store(const String& filename, const PeakMap& map, int format_version)
   {
-    Internal::CachedMzMLHandler().writeMemdump(map, filename + ".cached");
+    Internal::CachedMzMLHandler cache;
+    cache.setFormatVersion(format_version == Internal::CachedMzMLHandler::FORMAT_V2 ?
+      Internal::CachedMzMLHandler::FORMAT_V2 : Internal::CachedMzMLHandler::FORMAT_V1);
+    cache.writeMemdump(map, filename + ".cached");
     Internal::CachedMzMLHandler().writeMetadata_x(map, filename, true);
   }
 
@@ -0,0 +1,314 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/CachedPeptideDatabase.h>
+
+#include <OpenMS/CHEMISTRY/ModifiedPeptideGenerator.h>
+#include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/regex.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    const char MAGIC[8] = {'O', 'M', 'S', 'P', 'E', 'P', 'D', 'B'};
+    const UInt64 FORMAT_VERSION = 1;
+    const UInt64 BYTE_ORDER_MARK = 0x0102030405060708ULL;
+
+    /// number of bytes needed to pad @p size to a multiple of 8
+    Size padding(Size size)
+    {
+      return (8 - size % 8) % 8;
+    }
+  }
+
+  CachedPeptideDatabase::CachedPeptideDatabase() = default;
+
+  CachedPeptideDatabase::~CachedPeptideDatabase() = default;
+
+  String CachedPeptideDatabase::getKey_(const vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings)
+  {
+    // FNV-1a hash over identifiers and sequences (in order, as protein references are indices)
+    UInt64 hash = 14695981039346656037ULL;
+    auto add = [&hash](const String& s)
+    {
+      for (const char c : s)
+      {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+      }
+      hash ^= 0xFF; // separator
+      hash *= 1099511628211ULL;
+    };
+    for (const auto& p : proteins)
+    {
+      add(p.identifier);
+      add(p.sequence);
+    }
+
+    return "proteins=" + String(proteins.size()) + ":" + String(hash) +
+      ";enzyme=" + settings.enzyme +
+      ";missed_cleavages=" + String(settings.missed_cleavages) +
+      ";length=" + String(settings.min_length) + "-" + String(settings.max_length) +
+      ";motif=" + settings.motif +
+      ";fixed=" + ListUtils::concatenate(settings.fixed_modifications, ",") +
+      ";variable=" + ListUtils::concatenate(settings.variable_modifications, ",") +
+      ";max_variable_mods=" + String(settings.max_variable_mods_per_peptide);
+  }
+
+  void CachedPeptideDatabase::store(const String& filename, const vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings)
+  {
+    ProteaseDigestion digestor;
+    digestor.setEnzyme(settings.enzyme);
+    digestor.setMissedCleavages(settings.missed_cleavages);
+    boost::regex motif_regex(settings.motif);
+
+    // unique peptides in order of first occurrence, with the proteins they occur in
+    map<StringView, Size> peptide_index;
+    vector<StringView> peptides;
+    vector<vector<UInt64> > protein_references;
+    vector<StringView> digest;
+    for (Size protein_index = 0; protein_index != proteins.size(); ++protein_index)
+    {
+      digest.clear();
+      digestor.digestUnmodified(proteins[protein_index].sequence, digest, settings.min_length, settings.max_length);
+      for (const auto& c : digest)
+      {
+        auto it = peptide_index.find(c);
+        if (it == peptide_index.end())
+        {
+          const String peptide = c.getString();
+          if (peptide.find_first_of("XBZ") != std::string::npos) continue;
+          if (!settings.motif.empty() && !boost::regex_match(peptide, motif_regex)) continue;
+          it = peptide_index.emplace(c, peptides.size()).first;
+          peptides.push_back(c);
+          protein_references.emplace_back();
+        }
+        vector<UInt64>& refs = protein_references[it->second];
+        if (refs.empty() || refs.back() != protein_index) refs.push_back(protein_index);
+      }
+    }
+
+    // masses of all modified variants
+    const auto fixed_modifications = ModifiedPeptideGenerator::getModifications(settings.fixed_modifications);
+    const auto variable_modifications = ModifiedPeptideGenerator::getModifications(settings.variable_modifications);
+    vector<vector<double> > variant_masses(peptides.size());
+#pragma omp parallel for schedule(dynamic, 1000)
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
+    {
+      vector<AASequence> all_modified_peptides;
+
+      // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
+      #pragma omp critical (residuedb_access)
+      {
+        AASequence aas = AASequence::fromString(peptides[i].getString());
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, settings.max_variable_mods_per_peptide, all_modified_peptides);
+      }
+      for (const AASequence& candidate : all_modified_peptides)
+      {
+        variant_masses[i].push_back(candidate.getMonoWeight());
+      }
+    }
+
+    // offsets into the concatenated arrays
+    vector<UInt64> peptide_offsets(1, 0), variant_offsets(1, 0), protein_offsets(1, 0);
+    for (Size i = 0; i != peptides.size(); ++i)
+    {
+      peptide_offsets.push_back(peptide_offsets.back() + peptides[i].size());
+      variant_offsets.push_back(variant_offsets.back() + variant_masses[i].size());
+      protein_offsets.push_back(protein_offsets.back() + protein_references[i].size());
+    }
+
+    ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    auto write_uint = [&ofs](UInt64 value) { ofs.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    // header
+    const String key = getKey_(proteins, settings);
+    ofs.write(MAGIC, sizeof(MAGIC));
+    write_uint(BYTE_ORDER_MARK);
+    write_uint(FORMAT_VERSION);
+    write_uint(key.size());
+    ofs.write(key.c_str(), key.size());
+    ofs.write(zeros, padding(key.size()));
+    write_uint(peptides.size());
+    write_uint(variant_offsets.back());
+    write_uint(protein_offsets.back());
+    write_uint(peptide_offsets.back());
+
+    // arrays (all 8 byte aligned)
+    ofs.write(reinterpret_cast<const char*>(peptide_offsets.data()), peptide_offsets.size() * sizeof(UInt64));
+    ofs.write(reinterpret_cast<const char*>(variant_offsets.data()), variant_offsets.size() * sizeof(UInt64));
+    ofs.write(reinterpret_cast<const char*>(protein_offsets.data()), protein_offsets.size() * sizeof(UInt64));
+    for (const auto& masses : variant_masses)
+    {
+      ofs.write(reinterpret_cast<const char*>(masses.data()), masses.size() * sizeof(double));
+    }
+    for (const auto& refs : protein_references)
+    {
+      ofs.write(reinterpret_cast<const char*>(refs.data()), refs.size() * sizeof(UInt64));
+    }
+    for (const auto& p : peptides)
+    {
+      ofs.write(p.data(), p.size());
+    }
+
+    ofs.close();
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error writing peptide database.");
+    }
+  }
+
+  bool CachedPeptideDatabase::load(const String& filename, const vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings)
+  {
+    region_.reset();
+    nr_peptides_ = 0;
+    if (!File::exists(filename) || File::empty(filename)) return false;
+
+    std::shared_ptr<boost::interprocess::mapped_region> region;
+    try
+    {
+      boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+      region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception&)
+    {
+      return false;
+    }
+
+    const char* data = static_cast<const char*>(region->get_address());
+    const Size file_size = region->get_size();
+    Size pos = 0;
+    // returns nullptr if the file is too short
+    auto take = [&](Size bytes) -> const char*
+    {
+      if (file_size - pos < bytes) return nullptr;
+      const char* p = data + pos;
+      pos += bytes;
+      return p;
+    };
+    auto take_uint = [&](UInt64& value) -> bool
+    {
+      const char* p = take(sizeof(UInt64));
+      if (p == nullptr) return false;
+      memcpy(&value, p, sizeof(UInt64));
+      return true;
+    };
+
+    const char* magic = take(sizeof(MAGIC));
+    UInt64 byte_order_mark, version, key_size;
+    if (magic == nullptr || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !take_uint(byte_order_mark) || byte_order_mark != BYTE_ORDER_MARK ||
+        !take_uint(version) || version != FORMAT_VERSION ||
+        !take_uint(key_size))
+    {
+      return false;
+    }
+    const char* key = take(key_size);
+    if (key == nullptr || String(key, key_size) != getKey_(proteins, settings) || take(padding(key_size)) == nullptr)
+    {
+      return false;
+    }
+
+    UInt64 nr_peptides, nr_variants, nr_protein_references, sequence_size;
+    if (!take_uint(nr_peptides) || !take_uint(nr_variants) || !take_uint(nr_protein_references) || !take_uint(sequence_size) ||
+        file_size - pos != (3 * (nr_peptides + 1) + nr_variants + nr_protein_references) * 8 + sequence_size)
+    {
+      return false;
+    }
+    peptide_offsets_ = reinterpret_cast<const UInt64*>(take((nr_peptides + 1) * sizeof(UInt64)));
+    variant_offsets_ = reinterpret_cast<const UInt64*>(take((nr_peptides + 1) * sizeof(UInt64)));
+    protein_offsets_ = reinterpret_cast<const UInt64*>(take((nr_peptides + 1) * sizeof(UInt64)));
+    variant_masses_ = reinterpret_cast<const double*>(take(nr_variants * sizeof(double)));
+    protein_references_ = reinterpret_cast<const UInt64*>(take(nr_protein_references * sizeof(UInt64)));
+    sequences_ = take(sequence_size);
+
+    region_ = region;
+    nr_peptides_ = nr_peptides;
+    return true;
+  }
+
+  void CachedPeptideDatabase::loadOrStore(const String& filename, const vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings)
+  {
+    if (load(filename, proteins, settings)) return;
+
+    store(filename, proteins, settings);
+    if (!load(filename, proteins, settings))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Peptide database could not be read back.");
+    }
+  }
+
+  Size CachedPeptideDatabase::size() const
+  {
+    return nr_peptides_;
+  }
+
+  StringView CachedPeptideDatabase::getSequence(Size peptide_index) const
+  {
+    return StringView(sequences_ + peptide_offsets_[peptide_index], peptide_offsets_[peptide_index + 1] - peptide_offsets_[peptide_index]);
+  }
+
+  Size CachedPeptideDatabase::getNumberOfVariants(Size peptide_index) const
+  {
+    return variant_offsets_[peptide_index + 1] - variant_offsets_[peptide_index];
+  }
+
+  double CachedPeptideDatabase::getVariantMass(Size peptide_index, Size variant_index) const
+  {
+    return variant_masses_[variant_offsets_[peptide_index] + variant_index];
+  }
+
+  vector<Size> CachedPeptideDatabase::getProteinReferences(Size peptide_index) const
+  {
+    return vector<Size>(protein_references_ + protein_offsets_[peptide_index], protein_references_ + protein_offsets_[peptide_index + 1]);
+  }
+} // namespace OpenMS
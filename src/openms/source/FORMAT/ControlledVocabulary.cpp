@@ -41,6 +41,8 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 
@@ -606,6 +608,26 @@ namespace OpenMS
     return cv;
   }
 
+  const ControlledVocabulary& ControlledVocabulary::getCachedCV(const std::vector<std::pair<String, String>>& obo_files)
+  {
+    // entries are never removed, so references handed out stay valid
+    static std::map<std::vector<std::pair<String, String>>, std::unique_ptr<ControlledVocabulary>> cache;
+    static std::mutex cache_mutex;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::unique_ptr<ControlledVocabulary>& entry = cache[obo_files];
+    if (!entry)
+    {
+      std::unique_ptr<ControlledVocabulary> cv(new ControlledVocabulary());
+      for (const auto& f : obo_files)
+      {
+        cv->loadFromOBO(f.first, File::find(f.second));
+      }
+      entry = std::move(cv);
+    }
+    return *entry;
+  }
+
   bool ControlledVocabulary::checkName_(const String& id, const String& name, bool ignore_case) const
   {
     if (!exists(id))
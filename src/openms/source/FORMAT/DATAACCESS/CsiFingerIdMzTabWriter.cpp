@@ -41,6 +41,8 @@
 #include <OpenMS/SYSTEM/File.h>
 #include <boost/regex.hpp>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -52,166 +54,198 @@ void CsiFingerIdMzTabWriter::read(const std::vector<String>& sirius_output_paths
 
   CsiFingerIdMzTabWriter::CsiAdapterRun csi_result;
 
-  for (const auto& it : sirius_output_paths)
+  // the result directories are independent: parse them in parallel and collect the identifications in input order
+  std::vector<CsiFingerIdMzTabWriter::CsiAdapterIdentification> identifications(sirius_output_paths.size());
+  std::vector<char> has_identification(sirius_output_paths.size(), 0);
+  std::vector<std::exception_ptr> errors(sirius_output_paths.size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (SignedSize path_index = 0; path_index < (SignedSize)sirius_output_paths.size(); ++path_index)
   {
-    // extract mz, rt of the precursor and the nativeID of the corresponding MS2 spectra in the spectrum.ms file
-    SiriusMzTabWriter::SiriusSpectrumMSInfo info = SiriusMzTabWriter::extractSpectrumMSInfo(it);
+    try
+    {
+      const String& it = sirius_output_paths[path_index];
 
-    const std::string pathtocsicsv = it + "/structure_candidates.tsv";
+      // extract mz, rt of the precursor and the nativeID of the corresponding MS2 spectra in the spectrum.ms file
+      SiriusMzTabWriter::SiriusSpectrumMSInfo info = SiriusMzTabWriter::extractSpectrumMSInfo(it);
 
-    ifstream file(pathtocsicsv);
+      const std::string pathtocsicsv = it + "/structure_candidates.tsv";
 
-    if (file) 
-    {
-      CsvFile compounds(pathtocsicsv, '\t');
-      const UInt rowcount = compounds.rowCount();
+      ifstream file(pathtocsicsv);
 
-      if (rowcount > 1)
+      if (file) 
       {
-        // correction if the rowcount is smaller than the number of hits used as parameter
-        // rowcount-1 because the csv header will be skipped in the loop later on.
-        int header = 1;
-        const UInt top_n_hits_cor = (top_n_hits >= rowcount) ? rowcount-header : top_n_hits;
+        CsvFile compounds(pathtocsicsv, '\t');
+        const UInt rowcount = compounds.rowCount();
 
-        // fill identification structure containing all candidate hits for a single spectrum
-        CsiFingerIdMzTabWriter::CsiAdapterIdentification csi_id{};
+        if (rowcount > 1)
+        {
+          // correction if the rowcount is smaller than the number of hits used as parameter
+          // rowcount-1 because the csv header will be skipped in the loop later on.
+          int header = 1;
+          const UInt top_n_hits_cor = (top_n_hits >= rowcount) ? rowcount-header : top_n_hits;
+
+          // fill identification structure containing all candidate hits for a single spectrum
+          CsiFingerIdMzTabWriter::CsiAdapterIdentification csi_id{};
 
-        // extract scan_index from path
-        OpenMS::String str = File::path(pathtocsicsv);
-        int scan_index = SiriusMzTabWriter::extractScanIndex(str);
+          // extract scan_index from path
+          OpenMS::String str = File::path(pathtocsicsv);
+          int scan_index = SiriusMzTabWriter::extractScanIndex(str);
     
-        // extract scan_number from string
-        int scan_number = SiriusMzTabWriter::extractScanNumber(str);
+          // extract scan_number from string
+          int scan_number = SiriusMzTabWriter::extractScanNumber(str);
 
-        // extract feature_id from string
-        String feature_id = SiriusMzTabWriter::extractFeatureId(str);
+          // extract feature_id from string
+          String feature_id = SiriusMzTabWriter::extractFeatureId(str);
 
-        // extract column name and index from header
-        std::map< std::string, Size > columnname_to_columnindex = SiriusMzTabWriter::extract_columnname_to_columnindex(compounds);
+          // extract column name and index from header
+          std::map< std::string, Size > columnname_to_columnindex = SiriusMzTabWriter::extract_columnname_to_columnindex(compounds);
 
-        // j = 1 because of .csv file format (header)
-        for (Size j = 1; j <= top_n_hits_cor; ++j)
-        {
-          StringList sl;
-          compounds.getRow(j, sl);
-          CsiFingerIdMzTabWriter::CsiAdapterHit csi_hit;
-          csi_hit.inchikey2D = sl[columnname_to_columnindex.at("InChIkey2D")];
-          csi_hit.inchi = sl[columnname_to_columnindex.at("InChI")];
-          csi_hit.molecular_formula = sl[columnname_to_columnindex.at("molecularFormula")];
-          csi_hit.rank = sl[columnname_to_columnindex.at("rank")].toInt();
-          csi_hit.formula_rank = sl[columnname_to_columnindex.at("formulaRank")].toInt();
-          csi_hit.adduct = sl[columnname_to_columnindex.at("adduct")];
-          csi_hit.score = sl[columnname_to_columnindex.at("CSI:FingerIDScore")].toDouble();
-          csi_hit.name = sl[columnname_to_columnindex.at("name")];
-          csi_hit.smiles = sl[columnname_to_columnindex.at("smiles")];
-          csi_hit.xlogp = sl[columnname_to_columnindex.at("xlogp")];
-          csi_hit.dbflags = sl[columnname_to_columnindex.at("dbflags")];
-          sl[columnname_to_columnindex.at("pubchemids")].split(';', csi_hit.pubchemids);
-          sl[columnname_to_columnindex.at("links")].split(';', csi_hit.links);
-
-          csi_id.hits.push_back(csi_hit);
+          // j = 1 because of .csv file format (header)
+          for (Size j = 1; j <= top_n_hits_cor; ++j)
+          {
+            StringList sl;
+            compounds.getRow(j, sl);
+            CsiFingerIdMzTabWriter::CsiAdapterHit csi_hit;
+            csi_hit.inchikey2D = sl[columnname_to_columnindex.at("InChIkey2D")];
+            csi_hit.inchi = sl[columnname_to_columnindex.at("InChI")];
+            csi_hit.molecular_formula = sl[columnname_to_columnindex.at("molecularFormula")];
+            csi_hit.rank = sl[columnname_to_columnindex.at("rank")].toInt();
+            csi_hit.formula_rank = sl[columnname_to_columnindex.at("formulaRank")].toInt();
+            csi_hit.adduct = sl[columnname_to_columnindex.at("adduct")];
+            csi_hit.score = sl[columnname_to_columnindex.at("CSI:FingerIDScore")].toDouble();
+            csi_hit.name = sl[columnname_to_columnindex.at("name")];
+            csi_hit.smiles = sl[columnname_to_columnindex.at("smiles")];
+            csi_hit.xlogp = sl[columnname_to_columnindex.at("xlogp")];
+            csi_hit.dbflags = sl[columnname_to_columnindex.at("dbflags")];
+            sl[columnname_to_columnindex.at("pubchemids")].split(';', csi_hit.pubchemids);
+            sl[columnname_to_columnindex.at("links")].split(';', csi_hit.links);
+
+            csi_id.hits.push_back(csi_hit);
+          }
+
+          csi_id.mz = info.ext_mz;
+          csi_id.rt = info.ext_rt;
+          csi_id.native_ids = info.ext_n_id;
+          csi_id.scan_index = scan_index;
+          csi_id.scan_number = scan_number;
+          csi_id.feature_id = feature_id;
+          identifications[path_index] = std::move(csi_id);
+          has_identification[path_index] = 1;
         }
+      }
+      file.close();
+    }
+    catch (...)
+    {
+      errors[path_index] = std::current_exception();
+    }
+  }
+
+  for (Size path_index = 0; path_index < sirius_output_paths.size(); ++path_index)
+  {
+    if (errors[path_index])
+    {
+      std::rethrow_exception(errors[path_index]);
+    }
+    if (has_identification[path_index])
+    {
+      csi_result.identifications.push_back(std::move(identifications[path_index]));
+    }
+  }
 
-        csi_id.mz = info.ext_mz;
-        csi_id.rt = info.ext_rt;
-        csi_id.native_ids = info.ext_n_id;
-        csi_id.scan_index = scan_index;
-        csi_id.scan_number = scan_number;
-        csi_id.feature_id = feature_id;
-        csi_result.identifications.push_back(csi_id);
-
-        // write metadata to mzTab file
-        MzTabFile mztab_out;
-        MzTabMetaData md;
-        MzTabMSRunMetaData md_run;
-        md_run.location = MzTabString(original_input_mzml);
-        md.ms_run[1] = md_run;
-        md.description = MzTabString("CSI:FingerID-" + SiriusVersion::CURRENT_VERSION);
-
-        //needed for header generation (score)
-        std::map<Size, MzTabParameter> smallmolecule_search_engine_score;
-        smallmolecule_search_engine_score[1].setName("CSI:FingerIDScore");
-        md.smallmolecule_search_engine_score = smallmolecule_search_engine_score;
-        result.setMetaData(md);
-
-        // write results to mzTab file
-        MzTabSmallMoleculeSectionRows smsd;
-        for (Size i = 0; i < csi_result.identifications.size(); ++i)
+  // meta data and rows only depend on the complete list of identifications, so they are assembled once
+  if (!csi_result.identifications.empty())
+  {
+    // write metadata to mzTab file
+    MzTabFile mztab_out;
+    MzTabMetaData md;
+    MzTabMSRunMetaData md_run;
+    md_run.location = MzTabString(original_input_mzml);
+    md.ms_run[1] = md_run;
+    md.description = MzTabString("CSI:FingerID-" + SiriusVersion::CURRENT_VERSION);
+
+    //needed for header generation (score)
+    std::map<Size, MzTabParameter> smallmolecule_search_engine_score;
+    smallmolecule_search_engine_score[1].setName("CSI:FingerIDScore");
+    md.smallmolecule_search_engine_score = smallmolecule_search_engine_score;
+    result.setMetaData(md);
+
+    // write results to mzTab file
+    MzTabSmallMoleculeSectionRows smsd;
+    for (Size i = 0; i < csi_result.identifications.size(); ++i)
+    {
+      const CsiFingerIdMzTabWriter::CsiAdapterIdentification &id = csi_result.identifications[i];
+      for (Size j = 0; j < id.hits.size(); ++j)
+      {
+        const CsiFingerIdMzTabWriter::CsiAdapterHit &hit = id.hits[j];
+        MzTabSmallMoleculeSectionRow smsr;
+
+        map <Size, MzTabDouble> engine_score;
+        engine_score[1] = MzTabDouble(hit.score);
+        smsr.best_search_engine_score = engine_score;
+
+        smsr.chemical_formula = MzTabString(hit.molecular_formula);
+        smsr.description = MzTabString(hit.name);
+        std::vector <MzTabString> pubchemids;
+        for (Size k = 0; k < hit.pubchemids.size(); ++k)
         {
-          const CsiFingerIdMzTabWriter::CsiAdapterIdentification &id = csi_result.identifications[i];
-          for (Size j = 0; j < id.hits.size(); ++j)
-          {
-            const CsiFingerIdMzTabWriter::CsiAdapterHit &hit = id.hits[j];
-            MzTabSmallMoleculeSectionRow smsr;
-
-            map <Size, MzTabDouble> engine_score;
-            engine_score[1] = MzTabDouble(hit.score);
-            smsr.best_search_engine_score = engine_score;
-
-            smsr.chemical_formula = MzTabString(hit.molecular_formula);
-            smsr.description = MzTabString(hit.name);
-            std::vector <MzTabString> pubchemids;
-            for (Size k = 0; k < hit.pubchemids.size(); ++k)
-            {
-              pubchemids.emplace_back(MzTabString(hit.pubchemids[k]));
-            }  
-            smsr.identifier.set(pubchemids);
-            smsr.inchi_key = MzTabString(hit.inchikey2D);
-            smsr.smiles = MzTabString(hit.smiles);
-            std::vector < MzTabString > links;
-            MzTabStringList m_links;
-            m_links.setSeparator('|');
-            for (Size k = 0; k < hit.links.size(); ++k)
-            {
-              links.emplace_back(MzTabString(hit.links[k]));
-            }
-            m_links.set(links);
-
-            smsr.exp_mass_to_charge = MzTabDouble(id.mz);
-
-            vector<MzTabDouble> v_rt;
-            MzTabDoubleList rt_list;
-            v_rt.emplace_back(id.rt);
-            rt_list.set(v_rt);
-            smsr.retention_time = rt_list;
-            
-            MzTabOptionalColumnEntry rank = make_pair("opt_global_rank", MzTabString(hit.rank));
-            MzTabOptionalColumnEntry formula_rank = make_pair("opt_global_formulaRank", MzTabString(hit.formula_rank));
-            MzTabOptionalColumnEntry compoundId = make_pair("opt_global_compoundId", MzTabString(id.scan_index));
-            MzTabOptionalColumnEntry compoundScanNumber = make_pair("opt_global_compoundScanNumber", MzTabString(id.scan_number));
-            MzTabOptionalColumnEntry featureId = make_pair("opt_global_featureId", MzTabString(id.feature_id));
-            MzTabOptionalColumnEntry adduct = make_pair("opt_global_adduct", MzTabString(hit.adduct));
-            MzTabOptionalColumnEntry xlogp = make_pair("opt_global_rank", MzTabString(hit.xlogp));
-            MzTabOptionalColumnEntry dblinks = make_pair("opt_global_dblinks", MzTabString(m_links.toCellString()));
-            MzTabOptionalColumnEntry dbflags = make_pair("opt_global_dbflags", MzTabString(hit.dbflags));
-
-            vector<MzTabString> m_native_ids;
-            MzTabStringList ml_native_ids;
-            ml_native_ids.setSeparator('|');
-            for (auto& element : id.native_ids)
-            {
-              m_native_ids.emplace_back(MzTabString(element));
-            }
-            ml_native_ids.set(m_native_ids);
-
-            MzTabOptionalColumnEntry native_ids = make_pair("opt_global_native_id", MzTabString(ml_native_ids.toCellString()));
-
-            smsr.opt_.push_back(rank);
-            smsr.opt_.push_back(compoundId);
-            smsr.opt_.push_back(compoundScanNumber);
-            smsr.opt_.push_back(featureId);
-            smsr.opt_.push_back(native_ids);
-            smsr.opt_.push_back(adduct);
-            smsr.opt_.push_back(xlogp);
-            smsr.opt_.push_back(dblinks);
-            smsr.opt_.push_back(dbflags);
-            smsd.push_back(smsr);
-          } 
+          pubchemids.emplace_back(MzTabString(hit.pubchemids[k]));
+        }  
+        smsr.identifier.set(pubchemids);
+        smsr.inchi_key = MzTabString(hit.inchikey2D);
+        smsr.smiles = MzTabString(hit.smiles);
+        std::vector < MzTabString > links;
+        MzTabStringList m_links;
+        m_links.setSeparator('|');
+        for (Size k = 0; k < hit.links.size(); ++k)
+        {
+          links.emplace_back(MzTabString(hit.links[k]));
         }
-        result.setSmallMoleculeSectionRows(smsd);
-      }
+        m_links.set(links);
+
+        smsr.exp_mass_to_charge = MzTabDouble(id.mz);
+
+        vector<MzTabDouble> v_rt;
+        MzTabDoubleList rt_list;
+        v_rt.emplace_back(id.rt);
+        rt_list.set(v_rt);
+        smsr.retention_time = rt_list;
+        
+        MzTabOptionalColumnEntry rank = make_pair("opt_global_rank", MzTabString(hit.rank));
+        MzTabOptionalColumnEntry formula_rank = make_pair("opt_global_formulaRank", MzTabString(hit.formula_rank));
+        MzTabOptionalColumnEntry compoundId = make_pair("opt_global_compoundId", MzTabString(id.scan_index));
+        MzTabOptionalColumnEntry compoundScanNumber = make_pair("opt_global_compoundScanNumber", MzTabString(id.scan_number));
+        MzTabOptionalColumnEntry featureId = make_pair("opt_global_featureId", MzTabString(id.feature_id));
+        MzTabOptionalColumnEntry adduct = make_pair("opt_global_adduct", MzTabString(hit.adduct));
+        MzTabOptionalColumnEntry xlogp = make_pair("opt_global_rank", MzTabString(hit.xlogp));
+        MzTabOptionalColumnEntry dblinks = make_pair("opt_global_dblinks", MzTabString(m_links.toCellString()));
+        MzTabOptionalColumnEntry dbflags = make_pair("opt_global_dbflags", MzTabString(hit.dbflags));
+
+        vector<MzTabString> m_native_ids;
+        MzTabStringList ml_native_ids;
+        ml_native_ids.setSeparator('|');
+        for (auto& element : id.native_ids)
+        {
+          m_native_ids.emplace_back(MzTabString(element));
+        }
+        ml_native_ids.set(m_native_ids);
+
+        MzTabOptionalColumnEntry native_ids = make_pair("opt_global_native_id", MzTabString(ml_native_ids.toCellString()));
+
+        smsr.opt_.push_back(rank);
+        smsr.opt_.push_back(compoundId);
+        smsr.opt_.push_back(compoundScanNumber);
+        smsr.opt_.push_back(featureId);
+        smsr.opt_.push_back(native_ids);
+        smsr.opt_.push_back(adduct);
+        smsr.opt_.push_back(xlogp);
+        smsr.opt_.push_back(dblinks);
+        smsr.opt_.push_back(dbflags);
+        smsd.push_back(smsr);
+      } 
     }
-    file.close();
+    result.setSmallMoleculeSectionRows(smsd);
   }
 }
 
@@ -34,6 +34,7 @@
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataCachedConsumer.h>
 
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
@@ -41,21 +42,34 @@
 
 namespace OpenMS
 {
-  MSDataCachedConsumer::MSDataCachedConsumer(const String& filename, bool clearData) :
+  MSDataCachedConsumer::MSDataCachedConsumer(const String& filename, bool clearData, FormatVersion version) :
     ofs_(filename.c_str(), std::ios::binary),
     clearData_(clearData),
     spectra_written_(0),
     chromatograms_written_(0)
   {
-    int file_identifier = CACHED_MZML_FILE_IDENTIFIER;
-    ofs_.write((char*)&file_identifier, sizeof(file_identifier));
+    setFormatVersion(version);
+    writeHeader_(ofs_);
   }
 
   MSDataCachedConsumer::~MSDataCachedConsumer()
   {
-    // Write size of file (to the end of the file)
-    ofs_.write((char*)&spectra_written_, sizeof(spectra_written_));
-    ofs_.write((char*)&chromatograms_written_, sizeof(chromatograms_written_));
+    // write everything that is still pending (errors can only be reported here)
+    if (write_behind_)
+    {
+      try
+      {
+        write_behind_->flush();
+      }
+      catch (std::exception& e)
+      {
+        OPENMS_LOG_ERROR << "Error while writing cached mzML data: " << e.what() << std::endl;
+      }
+      write_behind_.reset();
+    }
+
+    // Write size of file (and for version 2 the index) to the end of the file
+    writeFooter_(ofs_, footer_index_, spectra_written_, chromatograms_written_);
 
     // Close file stream: close() _should_ call flush() but it might not in
     // all cases. To be sure call flush() first.
@@ -63,6 +77,15 @@ namespace OpenMS
     ofs_.close();
   }
 
+  void MSDataCachedConsumer::setWriteBehind(Size max_pending)
+  {
+    if (write_behind_)
+    {
+      write_behind_->flush();
+    }
+    write_behind_.reset(max_pending > 0 ? new WriteBehindQueue(max_pending) : nullptr);
+  }
+
   void MSDataCachedConsumer::consumeSpectrum(SpectrumType & s)
   {
     if (chromatograms_written_ > 0)
@@ -70,7 +93,29 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Cannot write spectra after writing chromatograms.");
     }
-    writeSpectrum_(s, ofs_);
+    if (write_behind_)
+    {
+      auto spec = std::make_shared<SpectrumType>(s);
+      write_behind_->push([this, spec]()
+      {
+        if (getFormatVersion() == FORMAT_V2)
+        {
+          writeSpectrumV2_(*spec, ofs_, footer_index_);
+        }
+        else
+        {
+          writeSpectrum_(*spec, ofs_);
+        }
+      });
+    }
+    else if (getFormatVersion() == FORMAT_V2)
+    {
+      writeSpectrumV2_(s, ofs_, footer_index_);
+    }
+    else
+    {
+      writeSpectrum_(s, ofs_);
+    }
     spectra_written_++;
 
     // Clear all spectral data including all float/int data arrays (but not string arrays)
@@ -87,7 +132,29 @@ namespace OpenMS
 
   void MSDataCachedConsumer::consumeChromatogram(ChromatogramType & c)
   {
-    writeChromatogram_(c, ofs_);
+    if (write_behind_)
+    {
+      auto chrom = std::make_shared<ChromatogramType>(c);
+      write_behind_->push([this, chrom]()
+      {
+        if (getFormatVersion() == FORMAT_V2)
+        {
+          writeChromatogramV2_(*chrom, ofs_, footer_index_);
+        }
+        else
+        {
+          writeChromatogram_(*chrom, ofs_);
+        }
+      });
+    }
+    else if (getFormatVersion() == FORMAT_V2)
+    {
+      writeChromatogramV2_(c, ofs_, footer_index_);
+    }
+    else
+    {
+      writeChromatogram_(c, ofs_);
+    }
     chromatograms_written_++;
 
     // Clear all chromatogram data including all float/int data arrays (but not string arrays)
@@ -0,0 +1,186 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest, Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#include <exception>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// applies @p f to all items in parallel, then rethrows the first error (in order)
+    template <typename T>
+    void transformBatch_(std::vector<T>& items, const std::function<void (T&)>& f)
+    {
+      if (!f || items.empty()) return;
+
+      const SignedSize n = static_cast<SignedSize>(items.size());
+      std::vector<std::exception_ptr> errors(items.size());
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < n; ++i)
+      {
+        try
+        {
+          f(items[i]);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      }
+
+      for (const std::exception_ptr& error : errors)
+      {
+        if (error)
+        {
+          items.clear();
+          std::rethrow_exception(error);
+        }
+      }
+    }
+  }
+
+  MSDataParallelTransformingConsumer::MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next, Size batch_size) :
+    next_(next),
+    batch_size_(batch_size),
+    lambda_spec_(nullptr),
+    lambda_chrom_(nullptr)
+  {
+    if (next_ == nullptr)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "A consumer to forward the data to is required.");
+    }
+    if (batch_size_ == 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Batch size must be at least 1.");
+    }
+    pending_spectra_.reserve(batch_size_);
+  }
+
+  MSDataParallelTransformingConsumer::~MSDataParallelTransformingConsumer()
+  {
+    // called from the destructor, so errors can only be reported
+    try
+    {
+      flush();
+    }
+    catch (std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "Error while processing MS data: " << e.what() << std::endl;
+    }
+  }
+
+  void MSDataParallelTransformingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    next_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataParallelTransformingConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    flush();
+    next_->setExperimentalSettings(exp);
+  }
+
+  void MSDataParallelTransformingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    flushChromatograms_();
+    pending_spectra_.push_back(s);
+    if (pending_spectra_.size() >= batch_size_)
+    {
+      flushSpectra_();
+    }
+  }
+
+  void MSDataParallelTransformingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    flushSpectra_();
+    pending_chromatograms_.push_back(c);
+    if (pending_chromatograms_.size() >= batch_size_)
+    {
+      flushChromatograms_();
+    }
+  }
+
+  void MSDataParallelTransformingConsumer::setSpectraProcessingFunc(std::function<void (SpectrumType&)> f_spec)
+  {
+    flushSpectra_(); // pending spectra are processed with the previous function
+    lambda_spec_ = std::move(f_spec);
+  }
+
+  void MSDataParallelTransformingConsumer::setChromatogramProcessingFunc(std::function<void (ChromatogramType&)> f_chrom)
+  {
+    flushChromatograms_();
+    lambda_chrom_ = std::move(f_chrom);
+  }
+
+  void MSDataParallelTransformingConsumer::flush()
+  {
+    // at most one of the two buffers is non-empty
+    flushSpectra_();
+    flushChromatograms_();
+  }
+
+  Size MSDataParallelTransformingConsumer::getBatchSize() const
+  {
+    return batch_size_;
+  }
+
+  void MSDataParallelTransformingConsumer::flushSpectra_()
+  {
+    if (pending_spectra_.empty()) return;
+
+    transformBatch_(pending_spectra_, lambda_spec_);
+    for (SpectrumType& s : pending_spectra_)
+    {
+      next_->consumeSpectrum(s);
+    }
+    pending_spectra_.clear();
+  }
+
+  void MSDataParallelTransformingConsumer::flushChromatograms_()
+  {
+    if (pending_chromatograms_.empty()) return;
+
+    transformBatch_(pending_chromatograms_, lambda_chrom_);
+    for (ChromatogramType& c : pending_chromatograms_)
+    {
+      next_->consumeChromatogram(c);
+    }
+    pending_chromatograms_.clear();
+  }
+} // namespace OpenMS
@@ -34,6 +34,11 @@
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/FORMAT/VALIDATORS/MzMLValidator.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
@@ -47,9 +52,13 @@ namespace OpenMS
     chromatograms_written_(0),
     spectra_expected_(0),
     chromatograms_expected_(0),
-    add_dataprocessing_(false)
+    add_dataprocessing_(false),
+    pending_limit_(8)
   {
     validator_ = new Internal::MzMLValidator(this->mapping_, this->cv_);
+#ifdef _OPENMP
+    pending_limit_ = 8 * (Size)omp_get_max_threads();
+#endif
 
     // open file in binary mode to avoid any line ending conversions
     ofs_.open(filename.c_str(), std::ios::out | std::ios::binary);
@@ -95,27 +104,77 @@ namespace OpenMS
       // This is the first data to be written -> start writing the header
       // We also need to modify the map and add this dummy spectrum in
       // order to write the header correctly
-      MapType dummy;
-      dummy = settings_;
-      dummy.addSpectrum(scpy);
+      auto dummy = std::make_shared<MapType>();
+      *dummy = settings_;
+      dummy->addSpectrum(scpy);
 
       //--------------------------------------------------------------------
       //header
       //--------------------------------------------------------------------
-      Internal::MzMLHandler::writeHeader_(ofs_, dummy, dps_, *validator_);
+      write_([this, dummy]() { Internal::MzMLHandler::writeHeader_(ofs_, *dummy, dps_, *validator_); });
       started_writing_ = true;
     }
     if (!writing_spectra_)
     {
       // This is the first spectrum, thus write the spectrumList header
-      ofs_ << "\t\t<spectrumList count=\"" << spectra_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
+      const Size expected = spectra_expected_;
+      write_([this, expected]() { ofs_ << "\t\t<spectrumList count=\"" << expected << "\" defaultDataProcessingRef=\"dp_sp_0\">\n"; });
       writing_spectra_ = true;
     }
-    bool renew_native_ids = false;
-    // TODO writeSpectrum assumes that dps_ has at least one value -> assert
-    // this here ...
-    Internal::MzMLHandler::writeSpectrum_(ofs_, scpy,
-            spectra_written_++, *validator_, renew_native_ids, dps_);
+    pending_spectra_.push_back(std::move(scpy));
+    ++spectra_written_;
+    if (pending_spectra_.size() >= pending_limit_)
+    {
+      writePendingSpectra_();
+    }
+  }
+
+  void MSDataWritingConsumer::writePendingSpectra_()
+  {
+    if (pending_spectra_.empty())
+    {
+      return;
+    }
+    auto batch = std::make_shared<std::vector<SpectrumType> >();
+    batch->swap(pending_spectra_);
+    const Size first_idx = spectra_written_ - batch->size();
+    write_([this, batch, first_idx]()
+    {
+      std::vector<const SpectrumType*> spectra;
+      spectra.reserve(batch->size());
+      for (const SpectrumType& spec : *batch)
+      {
+        spectra.push_back(&spec);
+      }
+      bool renew_native_ids = false;
+      // TODO writeSpectrum assumes that dps_ has at least one value -> assert
+      // this here ...
+      Internal::MzMLHandler::writeSpectraParallel_(ofs_, spectra, first_idx,
+              *validator_, renew_native_ids, dps_, [](Size) {});
+    });
+    pending_spectra_.reserve(pending_limit_);
+  }
+
+  void MSDataWritingConsumer::write_(WriteBehindQueue::Task task)
+  {
+    if (write_behind_)
+    {
+      write_behind_->push(std::move(task));
+    }
+    else
+    {
+      task();
+    }
+  }
+
+  void MSDataWritingConsumer::setWriteBehind(Size max_pending)
+  {
+    if (started_writing_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Write-behind must be configured before writing starts.");
+    }
+    write_behind_.reset(max_pending > 0 ? new WriteBehindQueue(max_pending) : nullptr);
   }
 
    void MSDataWritingConsumer::consumeChromatogram(ChromatogramType & c)
@@ -123,7 +182,8 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
-      ofs_ << "\t\t</spectrumList>\n";
+      writePendingSpectra_();
+      write_([this]() { ofs_ << "\t\t</spectrumList>\n"; });
       writing_spectra_ = false;
     }
 
@@ -141,23 +201,50 @@ namespace OpenMS
       // this is the first data to be written -> start writing the header
       // We also need to modify the map and add this dummy chromatogram in
       // order to write the header correctly
-      MapType dummy;
-      dummy = settings_;
-      dummy.addChromatogram(ccpy);
+      auto dummy = std::make_shared<MapType>();
+      *dummy = settings_;
+      dummy->addChromatogram(ccpy);
 
       //--------------------------------------------------------------------
       //header (fill also dps_ variable)
       //--------------------------------------------------------------------
-      Internal::MzMLHandler::writeHeader_(ofs_, dummy, dps_, *validator_);
+      write_([this, dummy]() { Internal::MzMLHandler::writeHeader_(ofs_, *dummy, dps_, *validator_); });
       started_writing_ = true;
     }
     if (!writing_chromatograms_)
     {
-      ofs_ << "\t\t<chromatogramList count=\"" << chromatograms_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
+      const Size expected = chromatograms_expected_;
+      write_([this, expected]() { ofs_ << "\t\t<chromatogramList count=\"" << expected << "\" defaultDataProcessingRef=\"dp_sp_0\">\n"; });
       writing_chromatograms_ = true;
     }
-    Internal::MzMLHandler::writeChromatogram_(ofs_, ccpy,
-            chromatograms_written_++, *validator_);
+    pending_chromatograms_.push_back(std::move(ccpy));
+    ++chromatograms_written_;
+    if (pending_chromatograms_.size() >= pending_limit_)
+    {
+      writePendingChromatograms_();
+    }
+  }
+
+  void MSDataWritingConsumer::writePendingChromatograms_()
+  {
+    if (pending_chromatograms_.empty())
+    {
+      return;
+    }
+    auto batch = std::make_shared<std::vector<ChromatogramType> >();
+    batch->swap(pending_chromatograms_);
+    const Size first_idx = chromatograms_written_ - batch->size();
+    write_([this, batch, first_idx]()
+    {
+      std::vector<const ChromatogramType*> chromatograms;
+      chromatograms.reserve(batch->size());
+      for (const ChromatogramType& chrom : *batch)
+      {
+        chromatograms.push_back(&chrom);
+      }
+      Internal::MzMLHandler::writeChromatogramsParallel_(ofs_, chromatograms, first_idx, *validator_, [](Size) {});
+    });
+    pending_chromatograms_.reserve(pending_limit_);
   }
 
    void MSDataWritingConsumer::addDataProcessing(DataProcessing d)
@@ -175,6 +262,28 @@ namespace OpenMS
     //--------------------------------------------------------------------------------------------
     //cleanup
     //--------------------------------------------------------------------------------------------
+    // write everything that is still pending (this is called from the destructor, so errors can only be reported)
+    try
+    {
+      if (writing_spectra_)
+      {
+        writePendingSpectra_();
+      }
+      else if (writing_chromatograms_)
+      {
+        writePendingChromatograms_();
+      }
+      if (write_behind_)
+      {
+        write_behind_->flush();
+      }
+    }
+    catch (std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "Error while writing mzML data: " << e.what() << std::endl;
+    }
+    write_behind_.reset();
+
     // make sure to close an open List tag
     if (writing_spectra_)
     {
@@ -40,6 +40,8 @@
 #include <OpenMS/SYSTEM/File.h>
 #include <boost/regex.hpp>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -130,158 +132,190 @@ void SiriusMzTabWriter::read(const std::vector<String>& sirius_output_paths,
 {
   SiriusMzTabWriter::SiriusAdapterRun sirius_result;
 
-  for (const auto& it : sirius_output_paths)
+  // the result directories are independent: parse them in parallel and collect the identifications in input order
+  std::vector<SiriusMzTabWriter::SiriusAdapterIdentification> identifications(sirius_output_paths.size());
+  std::vector<char> has_identification(sirius_output_paths.size(), 0);
+  std::vector<std::exception_ptr> errors(sirius_output_paths.size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (SignedSize path_index = 0; path_index < (SignedSize)sirius_output_paths.size(); ++path_index)
   {
-    SiriusSpectrumMSInfo info = SiriusMzTabWriter::extractSpectrumMSInfo(it);
+    try
+    {
+      const String& it = sirius_output_paths[path_index];
 
-    // extract data from formula_candidates.csv
-    const std::string pathtosiriuscsv = it + "/formula_candidates.tsv";
+      SiriusSpectrumMSInfo info = SiriusMzTabWriter::extractSpectrumMSInfo(it);
 
-    ifstream file(pathtosiriuscsv);
-    if (file) 
-    {
-      CsvFile compounds(pathtosiriuscsv, '\t');
-      const UInt rowcount = compounds.rowCount();
+      // extract data from formula_candidates.csv
+      const std::string pathtosiriuscsv = it + "/formula_candidates.tsv";
 
-      if (rowcount > 1)
+      ifstream file(pathtosiriuscsv);
+      if (file) 
       {
-        // correction if the rowcount is smaller than the number of hits used as parameter
-        // rowcount-1 because the csv header will be skipped in the loop later on.
-        int header = 1;
-        const UInt top_n_hits_cor = (top_n_hits >= rowcount) ? rowcount-header : top_n_hits;
-        
-        // fill identification structure containing all candidate hits for a single spectrum
-        SiriusMzTabWriter::SiriusAdapterIdentification sirius_id;
+        CsvFile compounds(pathtosiriuscsv, '\t');
+        const UInt rowcount = compounds.rowCount();
 
-        // extract scan_number from path
-        OpenMS::String str = File::path(pathtosiriuscsv);
-        int scan_index = SiriusMzTabWriter::extractScanIndex(str);
+        if (rowcount > 1)
+        {
+          // correction if the rowcount is smaller than the number of hits used as parameter
+          // rowcount-1 because the csv header will be skipped in the loop later on.
+          int header = 1;
+          const UInt top_n_hits_cor = (top_n_hits >= rowcount) ? rowcount-header : top_n_hits;
+        
+          // fill identification structure containing all candidate hits for a single spectrum
+          SiriusMzTabWriter::SiriusAdapterIdentification sirius_id;
 
-        // extract scan_number from string
-        int scan_number = SiriusMzTabWriter::extractScanNumber(str);
+          // extract scan_number from path
+          OpenMS::String str = File::path(pathtosiriuscsv);
+          int scan_index = SiriusMzTabWriter::extractScanIndex(str);
 
-        // extract feature_id from string
-        String feature_id = SiriusMzTabWriter::extractFeatureId(str);
+          // extract scan_number from string
+          int scan_number = SiriusMzTabWriter::extractScanNumber(str);
 
-        std::map< std::string, Size > columnname_to_columnindex = SiriusMzTabWriter::extract_columnname_to_columnindex(compounds);
+          // extract feature_id from string
+          String feature_id = SiriusMzTabWriter::extractFeatureId(str);
 
-        // formula	adduct	precursorFormula	rank	rankingScore	IsotopeScore	TreeScore	siriusScore	explainedPeaks	explainedIntensity
-        // j = 1 because of .csv file format (header)
-        for (Size j = 1; j <= top_n_hits_cor; ++j)
-        {
-          StringList sl;
-          compounds.getRow(j, sl);
-          SiriusMzTabWriter::SiriusAdapterHit sirius_hit;
-
-          // maybe should check columnname instead?
-          // rank	molecularFormula	adduct	precursorFormula	rankingScore	TreeIsotope_Score	Tree_Score	Isotope_Score	explainedPeaks	explainedIntensity
-          // parse single candidate hit
-          sirius_hit.formula = sl[columnname_to_columnindex.at("molecularFormula")];
-          sirius_hit.adduct = sl[columnname_to_columnindex.at("adduct")];
-          sirius_hit.precursor_formula = sl[columnname_to_columnindex.at("precursorFormula")];
-          sirius_hit.rank = sl[columnname_to_columnindex.at("rank")].toInt();
-          sirius_hit.iso_score = sl[columnname_to_columnindex.at("IsotopeScore")].toDouble();
-          sirius_hit.tree_score = sl[columnname_to_columnindex.at("TreeScore")].toDouble();
-          sirius_hit.sirius_score = sl[columnname_to_columnindex.at("SiriusScore")].toDouble();
-          sirius_hit.explainedpeaks = sl[columnname_to_columnindex.at("numExplainedPeaks")].toInt();
-          sirius_hit.explainedintensity = sl[columnname_to_columnindex.at("explainedIntensity")].toDouble();
-          sirius_hit.median_mass_error_fragment_peaks_ppm = sl[columnname_to_columnindex.at("medianMassErrorFragmentPeaks(ppm)")].toDouble();
-          sirius_hit.median_absolute_mass_error_fragment_peaks_ppm = sl[columnname_to_columnindex.at("medianAbsoluteMassErrorFragmentPeaks(ppm)")].toDouble();
-          sirius_hit.mass_error_precursor_ppm = sl[columnname_to_columnindex.at("massErrorPrecursor(ppm)")].toDouble();
-
-          sirius_id.hits.push_back(sirius_hit);
-        }
+          std::map< std::string, Size > columnname_to_columnindex = SiriusMzTabWriter::extract_columnname_to_columnindex(compounds);
 
-        sirius_id.mz = info.ext_mz;
-        sirius_id.rt = info.ext_rt;
-        sirius_id.native_ids = info.ext_n_id;
-        sirius_id.scan_index = scan_index;
-        sirius_id.scan_number = scan_number;
-        sirius_id.feature_id = feature_id;
-        sirius_result.identifications.push_back(sirius_id);
-
-        // write metadata to mzTab file
-        MzTabMetaData md;
-        MzTabMSRunMetaData md_run;
-        md_run.location = MzTabString(original_input_mzml);
-        md.ms_run[1] = md_run;
-        md.description = MzTabString("Sirius-" + SiriusVersion::CURRENT_VERSION);
-
-        //needed for header generation (score)
-        std::map<Size, MzTabParameter> smallmolecule_search_engine_score;
-        smallmolecule_search_engine_score[1].setName("SiriusScore");
-        smallmolecule_search_engine_score[2].setName("TreeScore");
-        smallmolecule_search_engine_score[3].setName("IsotopeScore");
-        md.smallmolecule_search_engine_score = smallmolecule_search_engine_score;
-        result.setMetaData(md);
-
-        // write results to mzTab file
-        MzTabSmallMoleculeSectionRows smsd;
-        for (Size i = 0; i < sirius_result.identifications.size(); ++i)
-        {
-          const SiriusMzTabWriter::SiriusAdapterIdentification &id = sirius_result.identifications[i];
-          for (Size j = 0; j < id.hits.size(); ++j)
+          // formula	adduct	precursorFormula	rank	rankingScore	IsotopeScore	TreeScore	siriusScore	explainedPeaks	explainedIntensity
+          // j = 1 because of .csv file format (header)
+          for (Size j = 1; j <= top_n_hits_cor; ++j)
           {
-            const SiriusMzTabWriter::SiriusAdapterHit &hit = id.hits[j];
-            MzTabSmallMoleculeSectionRow smsr;
-
-            map<Size, MzTabDouble> engine_score;
-            engine_score[1] = MzTabDouble(hit.sirius_score);
-            engine_score[2] = MzTabDouble(hit.tree_score);
-            engine_score[3] = MzTabDouble(hit.iso_score);
-            smsr.best_search_engine_score = engine_score;
-
-            smsr.chemical_formula = MzTabString(hit.formula);
-            smsr.exp_mass_to_charge = MzTabDouble(id.mz);
-           
-            vector<MzTabDouble> v_rt;
-            MzTabDoubleList rt_list;
-            v_rt.emplace_back(id.rt); 
-            rt_list.set(v_rt);
-            smsr.retention_time = rt_list;
-            
-            MzTabOptionalColumnEntry adduct = make_pair("opt_global_adduct", MzTabString(hit.adduct));
-            MzTabOptionalColumnEntry precursor_formula = make_pair("opt_gobal_precursorFormula", MzTabString(hit.precursor_formula));
-            MzTabOptionalColumnEntry rank = make_pair("opt_global_rank", MzTabString(hit.rank));
-            MzTabOptionalColumnEntry explainedPeaks = make_pair("opt_global_explainedPeaks", MzTabString(hit.explainedpeaks));
-            MzTabOptionalColumnEntry explainedIntensity = make_pair("opt_global_explainedIntensity", MzTabString(hit.explainedintensity));
-            MzTabOptionalColumnEntry median_mass_error_fragment_peaks = make_pair("opt_global_median_mass_error_fragment_peaks_ppm", MzTabString(hit.median_mass_error_fragment_peaks_ppm));
-            MzTabOptionalColumnEntry median_absolute_mass_error_fragment_peaks = make_pair("opt_global_median_absolute_mass_error_fragment_peaks_ppm", MzTabString(hit.median_absolute_mass_error_fragment_peaks_ppm));
-            MzTabOptionalColumnEntry mass_error_precursor = make_pair("opt_global_mass_error_precursor_ppm", MzTabString(hit.mass_error_precursor_ppm));
-            MzTabOptionalColumnEntry compoundId = make_pair("opt_global_compoundId", MzTabString(id.scan_index));
-            MzTabOptionalColumnEntry compoundScanNumber = make_pair("opt_global_compoundScanNumber", MzTabString(id.scan_number));
-            MzTabOptionalColumnEntry featureId = make_pair("opt_global_featureId", MzTabString(id.feature_id));
-
-            vector<MzTabString> m_native_ids;
-            MzTabStringList ml_native_ids;
-            ml_native_ids.setSeparator('|');
-            for (auto& element : id.native_ids)
-            {
-              m_native_ids.emplace_back(MzTabString(element));
-            }
-            ml_native_ids.set(m_native_ids);
-
-            MzTabOptionalColumnEntry native_ids = make_pair("opt_global_native_id", MzTabString(ml_native_ids.toCellString()));
-
-            smsr.opt_.push_back(adduct);
-            smsr.opt_.push_back(precursor_formula);
-            smsr.opt_.push_back(rank);
-            smsr.opt_.push_back(explainedPeaks);
-            smsr.opt_.push_back(explainedIntensity);
-            smsr.opt_.push_back(median_mass_error_fragment_peaks);
-            smsr.opt_.push_back(median_absolute_mass_error_fragment_peaks);
-            smsr.opt_.push_back(mass_error_precursor);
-            smsr.opt_.push_back(compoundId);
-            smsr.opt_.push_back(compoundScanNumber);
-            smsr.opt_.push_back(featureId);
-            smsr.opt_.push_back(native_ids);
-            smsd.push_back(smsr);
+            StringList sl;
+            compounds.getRow(j, sl);
+            SiriusMzTabWriter::SiriusAdapterHit sirius_hit;
+
+            // maybe should check columnname instead?
+            // rank	molecularFormula	adduct	precursorFormula	rankingScore	TreeIsotope_Score	Tree_Score	Isotope_Score	explainedPeaks	explainedIntensity
+            // parse single candidate hit
+            sirius_hit.formula = sl[columnname_to_columnindex.at("molecularFormula")];
+            sirius_hit.adduct = sl[columnname_to_columnindex.at("adduct")];
+            sirius_hit.precursor_formula = sl[columnname_to_columnindex.at("precursorFormula")];
+            sirius_hit.rank = sl[columnname_to_columnindex.at("rank")].toInt();
+            sirius_hit.iso_score = sl[columnname_to_columnindex.at("IsotopeScore")].toDouble();
+            sirius_hit.tree_score = sl[columnname_to_columnindex.at("TreeScore")].toDouble();
+            sirius_hit.sirius_score = sl[columnname_to_columnindex.at("SiriusScore")].toDouble();
+            sirius_hit.explainedpeaks = sl[columnname_to_columnindex.at("numExplainedPeaks")].toInt();
+            sirius_hit.explainedintensity = sl[columnname_to_columnindex.at("explainedIntensity")].toDouble();
+            sirius_hit.median_mass_error_fragment_peaks_ppm = sl[columnname_to_columnindex.at("medianMassErrorFragmentPeaks(ppm)")].toDouble();
+            sirius_hit.median_absolute_mass_error_fragment_peaks_ppm = sl[columnname_to_columnindex.at("medianAbsoluteMassErrorFragmentPeaks(ppm)")].toDouble();
+            sirius_hit.mass_error_precursor_ppm = sl[columnname_to_columnindex.at("massErrorPrecursor(ppm)")].toDouble();
+
+            sirius_id.hits.push_back(sirius_hit);
           }
-        }  
-        result.setSmallMoleculeSectionRows(smsd);
+
+          sirius_id.mz = info.ext_mz;
+          sirius_id.rt = info.ext_rt;
+          sirius_id.native_ids = info.ext_n_id;
+          sirius_id.scan_index = scan_index;
+          sirius_id.scan_number = scan_number;
+          sirius_id.feature_id = feature_id;
+          identifications[path_index] = std::move(sirius_id);
+          has_identification[path_index] = 1;
+        }
       }
       file.close();
     }
+    catch (...)
+    {
+      errors[path_index] = std::current_exception();
+    }
+  }
+
+  for (Size path_index = 0; path_index < sirius_output_paths.size(); ++path_index)
+  {
+    if (errors[path_index])
+    {
+      std::rethrow_exception(errors[path_index]);
+    }
+    if (has_identification[path_index])
+    {
+      sirius_result.identifications.push_back(std::move(identifications[path_index]));
+    }
+  }
+
+  // meta data and rows only depend on the complete list of identifications, so they are assembled once
+  if (!sirius_result.identifications.empty())
+  {
+    // write metadata to mzTab file
+    MzTabMetaData md;
+    MzTabMSRunMetaData md_run;
+    md_run.location = MzTabString(original_input_mzml);
+    md.ms_run[1] = md_run;
+    md.description = MzTabString("Sirius-" + SiriusVersion::CURRENT_VERSION);
+
+    //needed for header generation (score)
+    std::map<Size, MzTabParameter> smallmolecule_search_engine_score;
+    smallmolecule_search_engine_score[1].setName("SiriusScore");
+    smallmolecule_search_engine_score[2].setName("TreeScore");
+    smallmolecule_search_engine_score[3].setName("IsotopeScore");
+    md.smallmolecule_search_engine_score = smallmolecule_search_engine_score;
+    result.setMetaData(md);
+
+    // write results to mzTab file
+    MzTabSmallMoleculeSectionRows smsd;
+    for (Size i = 0; i < sirius_result.identifications.size(); ++i)
+    {
+      const SiriusMzTabWriter::SiriusAdapterIdentification &id = sirius_result.identifications[i];
+      for (Size j = 0; j < id.hits.size(); ++j)
+      {
+        const SiriusMzTabWriter::SiriusAdapterHit &hit = id.hits[j];
+        MzTabSmallMoleculeSectionRow smsr;
+
+        map<Size, MzTabDouble> engine_score;
+        engine_score[1] = MzTabDouble(hit.sirius_score);
+        engine_score[2] = MzTabDouble(hit.tree_score);
+        engine_score[3] = MzTabDouble(hit.iso_score);
+        smsr.best_search_engine_score = engine_score;
+
+        smsr.chemical_formula = MzTabString(hit.formula);
+        smsr.exp_mass_to_charge = MzTabDouble(id.mz);
+       
+        vector<MzTabDouble> v_rt;
+        MzTabDoubleList rt_list;
+        v_rt.emplace_back(id.rt); 
+        rt_list.set(v_rt);
+        smsr.retention_time = rt_list;
+        
+        MzTabOptionalColumnEntry adduct = make_pair("opt_global_adduct", MzTabString(hit.adduct));
+        MzTabOptionalColumnEntry precursor_formula = make_pair("opt_gobal_precursorFormula", MzTabString(hit.precursor_formula));
+        MzTabOptionalColumnEntry rank = make_pair("opt_global_rank", MzTabString(hit.rank));
+        MzTabOptionalColumnEntry explainedPeaks = make_pair("opt_global_explainedPeaks", MzTabString(hit.explainedpeaks));
+        MzTabOptionalColumnEntry explainedIntensity = make_pair("opt_global_explainedIntensity", MzTabString(hit.explainedintensity));
+        MzTabOptionalColumnEntry median_mass_error_fragment_peaks = make_pair("opt_global_median_mass_error_fragment_peaks_ppm", MzTabString(hit.median_mass_error_fragment_peaks_ppm));
+        MzTabOptionalColumnEntry median_absolute_mass_error_fragment_peaks = make_pair("opt_global_median_absolute_mass_error_fragment_peaks_ppm", MzTabString(hit.median_absolute_mass_error_fragment_peaks_ppm));
+        MzTabOptionalColumnEntry mass_error_precursor = make_pair("opt_global_mass_error_precursor_ppm", MzTabString(hit.mass_error_precursor_ppm));
+        MzTabOptionalColumnEntry compoundId = make_pair("opt_global_compoundId", MzTabString(id.scan_index));
+        MzTabOptionalColumnEntry compoundScanNumber = make_pair("opt_global_compoundScanNumber", MzTabString(id.scan_number));
+        MzTabOptionalColumnEntry featureId = make_pair("opt_global_featureId", MzTabString(id.feature_id));
+
+        vector<MzTabString> m_native_ids;
+        MzTabStringList ml_native_ids;
+        ml_native_ids.setSeparator('|');
+        for (auto& element : id.native_ids)
+        {
+          m_native_ids.emplace_back(MzTabString(element));
+        }
+        ml_native_ids.set(m_native_ids);
+
+        MzTabOptionalColumnEntry native_ids = make_pair("opt_global_native_id", MzTabString(ml_native_ids.toCellString()));
+
+        smsr.opt_.push_back(adduct);
+        smsr.opt_.push_back(precursor_formula);
+        smsr.opt_.push_back(rank);
+        smsr.opt_.push_back(explainedPeaks);
+        smsr.opt_.push_back(explainedIntensity);
+        smsr.opt_.push_back(median_mass_error_fragment_peaks);
+        smsr.opt_.push_back(median_absolute_mass_error_fragment_peaks);
+        smsr.opt_.push_back(mass_error_precursor);
+        smsr.opt_.push_back(compoundId);
+        smsr.opt_.push_back(compoundScanNumber);
+        smsr.opt_.push_back(featureId);
+        smsr.opt_.push_back(native_ids);
+        smsd.push_back(smsr);
+      }
+    }  
+    result.setSmallMoleculeSectionRows(smsd);
   }
 } // namespace OpenMS
 
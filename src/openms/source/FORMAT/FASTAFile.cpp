@@ -40,11 +40,126 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
   using namespace std;
 
+  namespace
+  {
+    /// append [begin, end) to @p out, leaving out all characters for which @p skip returns true
+    template <typename SkipPredicate>
+    void appendFiltered(String& out, const char* begin, const char* end, SkipPredicate skip)
+    {
+      const char* run = begin;
+      for (const char* p = begin; p != end; ++p)
+      {
+        if (skip(*p))
+        {
+          out.append(run, p);
+          run = p + 1;
+        }
+      }
+      out.append(run, end);
+    }
+
+    /// does the line which ends with the newline at @p newline start with '>' (i.e. is it a header line)?
+    bool isHeaderLine(const char* begin, const char* newline)
+    {
+      const char* p = newline;
+      while (p != begin && *(p - 1) != '\n')
+      {
+        --p;
+      }
+      return p != newline && *p == '>';
+    }
+
+    /**
+      @brief Parses all FASTA entries in [pos, end) using the same rules as FASTAFile::readEntry_()
+
+      @p end must be the end of the file or the start of a header line which would also end the
+      previous entry when reading linearly (see FASTAFile::load()).
+
+      @return false if a record could not be parsed; @p entries then contains all entries before it
+    */
+    bool parseEntries(const char* pos, const char* end, std::vector<FASTAFile::FASTAEntry>& entries)
+    {
+      while (pos != end)
+      {
+        if (*pos != '>')
+        {
+          return false;
+        }
+        ++pos;
+        FASTAFile::FASTAEntry entry;
+
+        // identifier: up to the first blank after a non-empty ID, or the end of the line
+        bool description_exists = true;
+        while (true)
+        {
+          if (pos == end)
+          {
+            return false;
+          }
+          const char c = *pos++;
+          if (c == ' ' || c == '\t')
+          {
+            if (!entry.identifier.empty()) break;
+          }
+          else if (c == '\n')
+          {
+            description_exists = false;
+            break;
+          }
+          else if (c != '\r')
+          {
+            entry.identifier += c;
+          }
+        }
+        if (entry.identifier.empty())
+        {
+          return false;
+        }
+
+        if (description_exists)
+        {
+          const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+          if (eol == nullptr)
+          {
+            return false;
+          }
+          appendFiltered(entry.description, pos, eol, [](char c) { return c == '\r' || c == '\t'; });
+          pos = eol + 1;
+        }
+
+        // sequence: the line after the header always belongs to it (as in readEntry_()), then up to the next header line
+        bool first_line = true;
+        while (pos != end && (first_line || *pos != '>'))
+        {
+          const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+          const char* line_end = (eol == nullptr) ? end : eol;
+          appendFiltered(entry.sequence, pos, line_end, [](char c) { return c == '\r' || c == ' ' || c == '\t'; });
+          pos = (eol == nullptr) ? end : eol + 1;
+          first_line = false;
+        }
+        if (entry.sequence.empty())
+        {
+          return false;
+        }
+        entries.push_back(std::move(entry));
+      }
+      return true;
+    }
+  }
+
   bool FASTAFile::readEntry_(std::string& id, std::string& description, std::string& seq)
   {
     std::streambuf* sb = infile_.rdbuf();
@@ -230,12 +345,108 @@ namespace OpenMS
   {
     startProgress(0, 1, "Loading FASTA file");
     data.clear();
-    FASTAEntry p;
-    FASTAFile f;
-    f.readStart(filename);
-    while (f.readNext(p))
+
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    if (!File::readable(filename))
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    boost::interprocess::mapped_region region;
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::ifstream probe(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (probe.tellg() > 0) // an empty file cannot be mapped
+    {
+      try
+      {
+        boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region(file, boost::interprocess::read_only).swap(region);
+        region.advise(boost::interprocess::mapped_region::advice_sequential);
+      }
+      catch (boost::interprocess::interprocess_exception&)
+      {
+        throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      begin = static_cast<const char*>(region.get_address());
+      end = begin + region.get_size();
+    }
+
+    // skip the header of PEFF files (http://www.psidev.info/peff); like readStart(), a header without
+    // trailing newline leaves the stream at EOF, i.e. an empty (but valid) database
+    while (begin != end && *begin == '#')
+    {
+      const char* eol = static_cast<const char*>(memchr(begin, '\n', end - begin));
+      if (eol == nullptr)
+      {
+        endProgress();
+        return;
+      }
+      begin = eol + 1;
+    }
+
+    // split the file into chunks which start at a header line; to be consistent with readEntry_(),
+    // never split right after another header line (the line following a header always belongs to its sequence)
+    const Size min_chunk_bytes = 1 << 22;
+    Size threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    const Size bytes = end - begin;
+    const Size n_chunks = std::min(bytes / min_chunk_bytes + 1, 4 * threads);
+    std::vector<const char*> bounds(1, begin);
+    for (Size i = 1; i < n_chunks; ++i)
+    {
+      const char* pos = std::max(begin + bytes * i / n_chunks, bounds.back());
+      while (pos != end)
+      {
+        const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+        if (eol == nullptr)
+        {
+          pos = end;
+          break;
+        }
+        pos = eol + 1;
+        if (pos != end && *pos == '>' && !isHeaderLine(begin, eol))
+        {
+          break;
+        }
+      }
+      if (pos == end) break;
+      if (pos != bounds.back()) bounds.push_back(pos);
+    }
+    bounds.push_back(end);
+
+    const Size n_ranges = bounds.size() - 1;
+    std::vector<std::vector<FASTAEntry>> chunks(n_ranges);
+    std::vector<char> success(n_ranges, 1);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)n_ranges; ++i)
+    {
+      success[i] = parseEntries(bounds[i], bounds[i + 1], chunks[i]);
+    }
+
+    Size total = 0;
+    for (Size i = 0; i < n_ranges; ++i)
+    {
+      total += chunks[i].size();
+      if (!success[i] || total == 0) // an empty file cannot be parsed by readNext() either
+      {
+        String msg = (total == 0) ? String("The first entry could not be read!")
+                                  : "Only " + String(total) + " proteins could be read. Parsing next record failed.";
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "",
+                                    "Error while parsing FASTA file! " + msg + " Please check the file!");
+      }
+    }
+
+    data.reserve(total);
+    for (auto& chunk : chunks)
     {
-      data.push_back(std::move(p));
+      std::move(chunk.begin(), chunk.end(), std::back_inserter(data));
+      std::vector<FASTAEntry>().swap(chunk);
     }
     endProgress();
   }
@@ -62,6 +62,8 @@
 #include <QFile>
 #include <QCryptographicHash>
 
+#include <sstream>
+
 using namespace std;
 
 namespace OpenMS
@@ -257,12 +259,28 @@ namespace OpenMS
     //else {} // TODO: ZIP
     else // uncompressed
     {
-      //load first 5 lines
-      TextFile file(filename, true, 5);
-      TextFile::ConstIterator file_it = file.begin();
+      // load first 5 lines, but only from a bounded prefix of the file: a single line can span
+      // the whole file (e.g. XML without line breaks), which would otherwise be read completely
+      const Size max_prefix = 16 * 1024;
+      ifstream is(filename.c_str(), ios_base::in | ios_base::binary);
+      if (!is)
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      std::string prefix(max_prefix, '\0');
+      is.read(&prefix[0], max_prefix);
+      prefix.resize(is.gcount());
+
+      // split into lines like TextFile does (handles \n, \r\n and \r)
+      istringstream prefix_stream(prefix);
+      String line;
+      while (complete_file.size() < 5 && TextFile::getLine(prefix_stream, line))
+      {
+        complete_file.push_back(line.trim());
+      }
 
       // file could be empty
-      if (file_it == file.end())
+      if (complete_file.empty())
       {
         two_five = " ";
         all_simple = " ";
@@ -272,17 +290,11 @@ namespace OpenMS
       {
         // concat elements 2 to 5
         two_five = "";
-        ++file_it;
-        for (int i = 1; i < 5; ++i)
+        for (Size i = 1; i < 5; ++i)
         {
-          if (file_it != file.end())
-          {
-            two_five += *file_it;
-            ++file_it;
-          }
-          else
+          if (i < complete_file.size())
           {
-            two_five += "";
+            two_five += complete_file[i];
           }
           two_five += " ";
         }
@@ -290,11 +302,9 @@ namespace OpenMS
         // remove trailing space
         two_five = two_five.chop(1);
         two_five.substitute('\t', ' ');
-        all_simple = *(file.begin()) + ' ' + two_five;
-        first_line = *(file.begin());
+        all_simple = complete_file[0] + ' ' + two_five;
+        first_line = complete_file[0];
       }
-
-      complete_file.insert(complete_file.end(), file.begin(), file.end());
     }
     //std::cerr << "\n Line1:\n" << first_line << "\nLine2-5:\n" << two_five << "\nall:\n" << all_simple << "\n\n";
 
@@ -44,6 +44,7 @@
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -239,11 +240,11 @@ namespace OpenMS
     vector<pair<int,int>>& pepts
   )
   {
+    const vector<PeptideIdentification>& feature_pepts = feature.getPeptideIdentifications();
     for (pair<int,double>& element_pair : sorted_element_maps)
     {
       int element_map = element_pair.first;
-      vector<PeptideIdentification> feature_pepts = feature.getPeptideIdentifications();
-      for (PeptideIdentification& pept_id : feature_pepts)
+      for (const PeptideIdentification& pept_id : feature_pepts)
       {
         if (pept_id.metaValueExists("spectrum_index") && pept_id.metaValueExists("map_index")
             && (int)pept_id.getMetaValue("map_index") == element_map)
@@ -291,109 +292,138 @@ namespace OpenMS
     //-------------------------------------------------------------
     startProgress(0, consensus_map.size(), "parsing features and ms2 identifications...");
 
-    for (Size cons_i = 0; cons_i < consensus_map.size(); ++cons_i)
+    // Features are processed in blocks: the spectra of a block are read from the (not thread-safe) on-disc
+    // experiments serially, binning, cosine similarity and merging run in parallel per feature and the
+    // blocks are written in feature order. The block size bounds the number of spectra held in memory.
+    const Size block_size = 1000;
+    for (Size block_begin = 0; block_begin < consensus_map.size(); block_begin += block_size)
     {
-      setProgress(cons_i);
+      const Size block_end = std::min(block_begin + block_size, consensus_map.size());
+      const Size n_block = block_end - block_begin;
 
-      const ConsensusFeature& feature = consensus_map[cons_i];
+      vector<int> charges(n_block);
+      vector<vector<pair<int, int>>> block_pepts(n_block);
+      vector<vector<MSSpectrum>> block_spectra(n_block); // first spectrum is the most intense one
+      vector<vector<Peak1D>> block_peaks(n_block);
 
-      // determine feature's charge as maximum feature handle charge
-      int charge = feature.getCharge();
-      for (auto& fh : feature)
-      { 
-        if (fh.getCharge() > charge)
+      for (Size k = 0; k < n_block; ++k)
+      {
+        const Size cons_i = block_begin + k;
+        setProgress(cons_i);
+
+        const ConsensusFeature& feature = consensus_map[cons_i];
+
+        // determine feature's charge as maximum feature handle charge
+        int charge = feature.getCharge();
+        for (auto& fh : feature)
         {
-          charge = fh.getCharge();
+          if (fh.getCharge() > charge)
+          {
+            charge = fh.getCharge();
+          }
         }
-      }
+        charges[k] = charge;
 
-      // compute most intense peptide identifications (based on precursor intensity)
-      vector<pair<int,double>> element_maps;
-      sortElementMapsByIntensity_(feature, element_maps);
-      vector<pair<int, int>> pepts;
-      getElementPeptideIdentificationsByElementIntensity_(feature, element_maps, pepts);
+        // compute most intense peptide identifications (based on precursor intensity)
+        vector<pair<int,double>> element_maps;
+        sortElementMapsByIntensity_(feature, element_maps);
+        vector<pair<int, int>>& pepts = block_pepts[k];
+        getElementPeptideIdentificationsByElementIntensity_(feature, element_maps, pepts);
 
-      // discard poorer precursor spectra for 'merged_spectra' and 'full_spectra' output
-      if (pept_cutoff != -1 && pepts.size() > (unsigned long) pept_cutoff)
-      {
-        pepts.erase(pepts.begin()+pept_cutoff, pepts.end());
-      }
+        // discard poorer precursor spectra for 'merged_spectra' and 'full_spectra' output
+        if (pept_cutoff != -1 && pepts.size() > (unsigned long) pept_cutoff)
+        {
+          pepts.erase(pepts.begin()+pept_cutoff, pepts.end());
+        }
 
-      // validate all peptide annotation maps have been loaded
-      for (const auto& pep : pepts)
-      {
-        int map_index = pep.first;
+        // validate all peptide annotation maps have been loaded
+        for (const auto& pep : pepts)
+        {
+          int map_index = pep.first;
+
+          // open on-disc experiments
+          if (map_index2file_index.find(map_index) == map_index2file_index.end())
+          {
+            specs_list[num_msmaps_cached].openFile(mzml_file_paths[map_index], false); // open on-disc experiment and load meta-data
+            map_index2file_index[map_index] = num_msmaps_cached;
+            ++num_msmaps_cached;
+          }
+        }
 
-        // open on-disc experiments
-        if (map_index2file_index.find(map_index) == map_index2file_index.end())
+        // identify most intense spectrum (and for merging, all spectra of the retained annotations)
+        const Size n_spectra = (output_type == "merged_spectra") ? pepts.size() : 1;
+        block_spectra[k].reserve(n_spectra);
+        for (Size p = 0; p < n_spectra; ++p)
         {
-          specs_list[num_msmaps_cached].openFile(mzml_file_paths[map_index], false); // open on-disc experiment and load meta-data
-          map_index2file_index[map_index] = num_msmaps_cached;
-          ++num_msmaps_cached;
+          block_spectra[k].push_back(specs_list[map_index2file_index[pepts[p].first]][pepts[p].second]);
         }
       }
 
-      // identify most intense spectrum
-      const int best_mapi = pepts[0].first;
-      const int best_speci = pepts[0].second;
-      auto best_spec = specs_list[map_index2file_index[best_mapi]][best_speci];
-
-      // write block output header
-      writeMSMSBlockHeader_(
-        output_file,
-        output_type,
-        (cons_i + 1),
-        feature.getUniqueId(),
-        charge,
-        feature.getMZ(),
-        best_speci,
-        best_spec.getRT()
-      );
-
-      // store outputted spectra in MSExperiment
-      MSExperiment exp;
-
-      // add most intense spectrum to MSExperiment
-      exp.addSpectrum(best_spec);
-
-      if (output_type == "merged_spectra")
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize k = 0; k < (SignedSize)n_block; ++k)
       {
-        // merge spectra that meet cosine similarity threshold to most intense spectrum
-        BinnedSpectrum binned_highest_int(best_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
+        const vector<MSSpectrum>& spectra = block_spectra[k];
+        const MSSpectrum& best_spec = spectra[0];
 
-        // Retain peptide annotations that do not meet user-specified cosine similarity threshold
-        for (pair<int,int> &pept : pepts)
-        {
-          int map_index = pept.first;
-          int spec_index = pept.second;
-          auto test_spec = specs_list[map_index2file_index[map_index]][spec_index];
+        // store outputted spectra in MSExperiment
+        MSExperiment exp;
 
-          BinnedSpectrum binned_spectrum(test_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
+        // add most intense spectrum to MSExperiment
+        exp.addSpectrum(best_spec);
 
+        if (output_type == "merged_spectra")
+        {
+          // merge spectra that meet cosine similarity threshold to most intense spectrum
+          BinnedSpectrum binned_highest_int(best_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
           BinnedSpectralContrastAngle bsca;
-          double cos_sim = bsca(binned_highest_int, binned_spectrum);
 
-          if (cos_sim >= cos_sim_threshold)
+          // Retain peptide annotations that do not meet user-specified cosine similarity threshold
+          for (Size p = 0; p < spectra.size(); ++p)
           {
-            exp.addSpectrum(test_spec);
+            // the first annotation is the most intense spectrum itself, its binning can be reused
+            double cos_sim = (p == 0) ? bsca(binned_highest_int, binned_highest_int)
+                                      : bsca(binned_highest_int, BinnedSpectrum(spectra[p], bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES));
+
+            if (cos_sim >= cos_sim_threshold)
+            {
+              exp.addSpectrum(spectra[p]);
+            }
           }
         }
+
+        // store outputted peaks in vector<Peak1D>
+        flattenAndBinSpectra_(
+          exp,
+          bin_width,
+          block_peaks[k]
+        );
       }
 
-      // store outputted peaks in vector<Peak1D>
-      vector<Peak1D> peaks;
-      flattenAndBinSpectra_(
-        exp,
-        bin_width,
-        peaks
-      );
-
-      // write peaks to output block
-      writeMSMSBlock_(
-        output_file,
-        peaks
-      );
+      for (Size k = 0; k < n_block; ++k)
+      {
+        const Size cons_i = block_begin + k;
+        const ConsensusFeature& feature = consensus_map[cons_i];
+
+        // write block output header
+        writeMSMSBlockHeader_(
+          output_file,
+          output_type,
+          (cons_i + 1),
+          feature.getUniqueId(),
+          charges[k],
+          feature.getMZ(),
+          block_pepts[k][0].second,
+          block_spectra[k][0].getRT()
+        );
+
+        // write peaks to output block
+        writeMSMSBlock_(
+          output_file,
+          block_peaks[k]
+        );
+      }
     }
+    endProgress();
 
     output_file.close();
   }
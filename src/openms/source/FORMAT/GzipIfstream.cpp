@@ -96,6 +96,8 @@ namespace OpenMS
     }
     else
     {
+      // larger internal buffer than the zlib default (8 KB) for fewer, larger file reads
+      gzbuffer(gzfile_, 1 << 17);
       stream_at_end_ = false;
       /*		crc  = crc32(0L, Z_NULL, 0);
               FILE* file =  fopen(filename,"rb");
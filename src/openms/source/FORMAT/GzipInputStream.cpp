@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/GzipInputStream.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
 
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/FORMAT/GzipIfstream.h>
@@ -44,28 +45,45 @@ namespace OpenMS
   GzipInputStream::GzipInputStream(const String & file_name) :
     gzip_(new GzipIfstream(file_name.c_str())), file_current_index_(0)
   {
+    startReadAhead_();
   }
 
   GzipInputStream::GzipInputStream(const char * file_name) :
     gzip_(new GzipIfstream(file_name)), file_current_index_(0)
   {
+    startReadAhead_();
   }
 
   GzipInputStream::~GzipInputStream()
   {
+    read_ahead_.reset(); // stop reading before closing the file
     delete gzip_;
   }
 
+  void GzipInputStream::startReadAhead_()
+  {
+    GzipIfstream* stream = gzip_;
+    read_ahead_.reset(new ReadAheadBuffer([stream](char* s, size_t n) -> size_t
+    {
+      return stream->streamEnd() ? 0 : stream->read(s, n);
+    }));
+  }
+
+  bool GzipInputStream::getIsOpen() const
+  {
+    return !read_ahead_->streamEnd();
+  }
+
   XMLSize_t GzipInputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
   {
     // Figure out whether we can really read.
-    if (gzip_->streamEnd())
+    if (read_ahead_->streamEnd())
     {
       return 0;
     }
 
     unsigned char * fill_it = static_cast<unsigned char *>(to_fill);
-    XMLSize_t actual_read = (XMLSize_t) gzip_->read((char *)fill_it, static_cast<size_t>(max_to_read));
+    XMLSize_t actual_read = (XMLSize_t) read_ahead_->read((char *)fill_it, static_cast<size_t>(max_to_read));
     file_current_index_ += actual_read;
     return actual_read;
   }
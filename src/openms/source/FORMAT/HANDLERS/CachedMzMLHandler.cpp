@@ -36,10 +36,137 @@
 
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/ZlibCompression.h>
+#include <OpenMS/MATH/MISC/MSNumpress.h>
+
+#include <cstring>
 
 namespace OpenMS::Internal
 {
-  CachedMzMLHandler::CachedMzMLHandler()
+  namespace
+  {
+    /**
+      @brief Minimal input stream over a memory region
+
+      Provides the subset of the std::ifstream interface used by the cached
+      readers (read and relative seek). Unlike the file stream, any attempt to
+      read beyond the end of the region is an error.
+    */
+    class MemoryCursor
+    {
+    public:
+      MemoryCursor(const char* data, Size size) :
+        pos_(data),
+        end_(data + size)
+      {}
+
+      MemoryCursor& read(char* out, std::streamsize n)
+      {
+        check_(n);
+        std::memcpy(out, pos_, n);
+        pos_ += n;
+        return *this;
+      }
+
+      MemoryCursor& seekg(std::streamoff off, std::ios_base::seekdir /* always relative to the current position */)
+      {
+        check_(off);
+        pos_ += off;
+        return *this;
+      }
+
+    private:
+      void check_(std::streamoff n) const
+      {
+        if (n < 0 || n > end_ - pos_)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Read beyond the end of the cached data, something is wrong here. Aborting.", "memory");
+        }
+      }
+
+      const char* pos_;
+      const char* end_;
+    };
+
+    /// Encoding of a single data array in format version 2 (before compression)
+    enum ArrayEncodingV2 : Byte
+    {
+      ENC_DOUBLE = 0,
+      ENC_FLOAT = 1,
+      ENC_NUMPRESS_LINEAR = 2
+    };
+
+    /// Compression of a single data array in format version 2
+    enum ArrayCompressionV2 : Byte
+    {
+      COMPRESSION_NONE = 0,
+      COMPRESSION_ZLIB = 1
+    };
+
+    /// Encodes and compresses @p values and writes them (including @p name) as one array of format version 2
+    void writeArrayV2(std::ofstream& ofs, const std::string& name, const std::vector<double>& values, Byte encoding)
+    {
+      std::vector<Byte> encoded;
+      if (encoding == ENC_NUMPRESS_LINEAR)
+      {
+        if (values.size() < 3)
+        {
+          encoding = ENC_DOUBLE; // nothing to gain
+        }
+        else
+        {
+          try
+          {
+            double fixed_point = ms::numpress::MSNumpress::optimalLinearFixedPoint(values.data(), values.size());
+            encoded.resize(8 + values.size() * 5);
+            encoded.resize(ms::numpress::MSNumpress::encodeLinear(values.data(), values.size(), encoded.data(), fixed_point));
+          }
+          catch (const char*)
+          {
+            encoding = ENC_DOUBLE; // data cannot be encoded safely
+          }
+        }
+      }
+      if (encoding == ENC_FLOAT)
+      {
+        std::vector<float> tmp(values.begin(), values.end());
+        encoded.resize(tmp.size() * sizeof(float));
+        if (!tmp.empty()) memcpy(encoded.data(), tmp.data(), encoded.size());
+      }
+      else if (encoding == ENC_DOUBLE)
+      {
+        encoded.resize(values.size() * sizeof(double));
+        if (!values.empty()) memcpy(encoded.data(), values.data(), encoded.size());
+      }
+
+      Byte compression = COMPRESSION_NONE;
+      std::vector<Byte> compressed;
+      if (!encoded.empty())
+      {
+        ZlibCompression::compressData(encoded.data(), encoded.size(), compressed);
+        compression = COMPRESSION_ZLIB;
+      }
+
+      Size len_name = name.size();
+      Size nr_values = values.size();
+      Size nr_bytes = compressed.size();
+      ofs.write((char*)&len_name, sizeof(len_name));
+      ofs.write(name.data(), len_name);
+      ofs.write((char*)&nr_values, sizeof(nr_values));
+      ofs.write((char*)&encoding, sizeof(encoding));
+      ofs.write((char*)&compression, sizeof(compression));
+      ofs.write((char*)&nr_bytes, sizeof(nr_bytes));
+      if (nr_bytes > 0) ofs.write((char*)compressed.data(), nr_bytes);
+    }
+
+    /// Size of the trailer of format version 2: footer offset, number of spectra, number of chromatograms, identifier
+    constexpr Size trailer_size_v2 = 3 * sizeof(UInt64) + sizeof(Int32);
+  }
+
+  CachedMzMLHandler::CachedMzMLHandler() :
+    format_version_(FORMAT_V1),
+    lossy_compression_(false)
   {
   }
 
@@ -55,6 +182,11 @@ namespace OpenMS::Internal
     }
     spectra_index_ = rhs.spectra_index_;
     chrom_index_ = rhs.chrom_index_;
+    spectra_rt_index_ = rhs.spectra_rt_index_;
+    spectra_ms_level_index_ = rhs.spectra_ms_level_index_;
+    spectra_precursor_mz_index_ = rhs.spectra_precursor_mz_index_;
+    format_version_ = rhs.format_version_;
+    lossy_compression_ = rhs.lossy_compression_;
 
     return *this;
   }
@@ -62,30 +194,121 @@ namespace OpenMS::Internal
   void CachedMzMLHandler::writeMemdump(const MapType& exp, const String& out) const
   {
     std::ofstream ofs(out.c_str(), std::ios::binary);
-    Size exp_size = exp.size();
-    Size chrom_size = exp.getChromatograms().size();
-    int file_identifier = CACHED_MZML_FILE_IDENTIFIER;
-    ofs.write((char*)&file_identifier, sizeof(file_identifier));
+    writeHeader_(ofs);
 
+    FooterIndex_ index;
     startProgress(0, exp.size() + exp.getChromatograms().size(), "storing binary data");
     for (Size i = 0; i < exp.size(); i++)
     {
       setProgress(i);
-      writeSpectrum_(exp[i], ofs);
+      if (format_version_ == FORMAT_V2)
+      {
+        writeSpectrumV2_(exp[i], ofs, index);
+      }
+      else
+      {
+        writeSpectrum_(exp[i], ofs);
+      }
     }
 
     for (Size i = 0; i < exp.getChromatograms().size(); i++)
     {
       setProgress(i);
-      writeChromatogram_(exp.getChromatograms()[i], ofs);
+      if (format_version_ == FORMAT_V2)
+      {
+        writeChromatogramV2_(exp.getChromatograms()[i], ofs, index);
+      }
+      else
+      {
+        writeChromatogram_(exp.getChromatograms()[i], ofs);
+      }
     }
 
-    ofs.write((char*)&exp_size, sizeof(exp_size));
-    ofs.write((char*)&chrom_size, sizeof(chrom_size));
+    writeFooter_(ofs, index, exp.size(), exp.getChromatograms().size());
     ofs.close();
     endProgress();
   }
 
+  void CachedMzMLHandler::writeHeader_(std::ofstream& ofs) const
+  {
+    int file_identifier = (format_version_ == FORMAT_V2) ? CACHED_MZML_FILE_IDENTIFIER_V2 : CACHED_MZML_FILE_IDENTIFIER;
+    ofs.write((char*)&file_identifier, sizeof(file_identifier));
+  }
+
+  void CachedMzMLHandler::writeFooter_(std::ofstream& ofs, const FooterIndex_& index, Size nr_spectra, Size nr_chromatograms) const
+  {
+    if (format_version_ != FORMAT_V2)
+    {
+      ofs.write((char*)&nr_spectra, sizeof(nr_spectra));
+      ofs.write((char*)&nr_chromatograms, sizeof(nr_chromatograms));
+      return;
+    }
+
+    OPENMS_PRECONDITION(index.spectra_offsets.size() == nr_spectra, "Index needs to contain all spectra")
+    OPENMS_PRECONDITION(index.chromatogram_offsets.size() == nr_chromatograms, "Index needs to contain all chromatograms")
+
+    // columnar index: all offsets, then all RTs etc. (each column is read in one go)
+    UInt64 footer_offset = ofs.tellp();
+    ofs.write((char*)index.spectra_offsets.data(), index.spectra_offsets.size() * sizeof(UInt64));
+    ofs.write((char*)index.spectra_rt.data(), index.spectra_rt.size() * sizeof(double));
+    ofs.write((char*)index.spectra_ms_level.data(), index.spectra_ms_level.size() * sizeof(Int32));
+    ofs.write((char*)index.spectra_precursor_mz.data(), index.spectra_precursor_mz.size() * sizeof(double));
+    ofs.write((char*)index.chromatogram_offsets.data(), index.chromatogram_offsets.size() * sizeof(UInt64));
+
+    UInt64 n_spectra = index.spectra_offsets.size();
+    UInt64 n_chromatograms = index.chromatogram_offsets.size();
+    Int32 file_identifier = CACHED_MZML_FILE_IDENTIFIER_V2;
+    ofs.write((char*)&footer_offset, sizeof(footer_offset));
+    ofs.write((char*)&n_spectra, sizeof(n_spectra));
+    ofs.write((char*)&n_chromatograms, sizeof(n_chromatograms));
+    ofs.write((char*)&file_identifier, sizeof(file_identifier));
+  }
+
+  void CachedMzMLHandler::readFooterV2_(std::ifstream& ifs, const String& filename)
+  {
+    ifs.seekg(0, ifs.end);
+    const UInt64 file_size = ifs.tellg();
+    if (file_size < sizeof(Int32) + trailer_size_v2)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "File is too small to contain a cached mzML index. Aborting!", filename);
+    }
+
+    UInt64 footer_offset, n_spectra, n_chromatograms;
+    Int32 file_identifier;
+    ifs.seekg(file_size - trailer_size_v2, ifs.beg);
+    ifs.read((char*)&footer_offset, sizeof(footer_offset));
+    ifs.read((char*)&n_spectra, sizeof(n_spectra));
+    ifs.read((char*)&n_chromatograms, sizeof(n_chromatograms));
+    ifs.read((char*)&file_identifier, sizeof(file_identifier));
+
+    // the columns need to fill the space between footer offset and trailer exactly
+    const UInt64 column_bytes = n_spectra * (sizeof(UInt64) + sizeof(double) + sizeof(Int32) + sizeof(double)) + n_chromatograms * sizeof(UInt64);
+    if (!ifs || file_identifier != CACHED_MZML_FILE_IDENTIFIER_V2 ||
+        footer_offset > file_size - trailer_size_v2 || column_bytes != file_size - trailer_size_v2 - footer_offset)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Invalid index in cached mzML file (file truncated?). Aborting!", filename);
+    }
+
+    std::vector<UInt64> spectra_offsets(n_spectra), chromatogram_offsets(n_chromatograms);
+    spectra_rt_index_.resize(n_spectra);
+    spectra_ms_level_index_.resize(n_spectra);
+    spectra_precursor_mz_index_.resize(n_spectra);
+    std::vector<Int32> ms_levels(n_spectra);
+
+    ifs.seekg(footer_offset, ifs.beg);
+    ifs.read((char*)spectra_offsets.data(), n_spectra * sizeof(UInt64));
+    ifs.read((char*)spectra_rt_index_.data(), n_spectra * sizeof(double));
+    ifs.read((char*)ms_levels.data(), n_spectra * sizeof(Int32));
+    ifs.read((char*)spectra_precursor_mz_index_.data(), n_spectra * sizeof(double));
+    ifs.read((char*)chromatogram_offsets.data(), n_chromatograms * sizeof(UInt64));
+
+    spectra_index_.assign(spectra_offsets.begin(), spectra_offsets.end());
+    chrom_index_.assign(chromatogram_offsets.begin(), chromatogram_offsets.end());
+    spectra_ms_level_index_.assign(ms_levels.begin(), ms_levels.end());
+  }
+
   void CachedMzMLHandler::readMemdump(MapType& exp_reading, String filename) const
   {
     std::ifstream ifs(filename.c_str(), std::ios::binary);
@@ -99,6 +322,35 @@ namespace OpenMS::Internal
 
     int file_identifier;
     ifs.read((char*)&file_identifier, sizeof(file_identifier));
+    if (file_identifier == CACHED_MZML_FILE_IDENTIFIER_V2)
+    {
+      CachedMzMLHandler index;
+      index.setLogType(getLogType());
+      index.createMemdumpIndex(filename);
+
+      exp_reading.reserve(index.getSpectraIndex().size());
+      startProgress(0, index.getSpectraIndex().size() + index.getChromatogramIndex().size(), "reading binary data");
+      for (Size i = 0; i < index.getSpectraIndex().size(); i++)
+      {
+        setProgress(i);
+        SpectrumType spectrum;
+        ifs.seekg(index.getSpectraIndex()[i]);
+        readSpectrum(spectrum, ifs, FORMAT_V2);
+        exp_reading.addSpectrum(std::move(spectrum));
+      }
+      std::vector<ChromatogramType> chromatograms;
+      for (Size i = 0; i < index.getChromatogramIndex().size(); i++)
+      {
+        setProgress(i);
+        ChromatogramType chromatogram;
+        ifs.seekg(index.getChromatogramIndex()[i]);
+        readChromatogram(chromatogram, ifs, FORMAT_V2);
+        chromatograms.push_back(std::move(chromatogram));
+      }
+      exp_reading.setChromatograms(std::move(chromatograms));
+      endProgress();
+      return;
+    }
     if (file_identifier != CACHED_MZML_FILE_IDENTIFIER)
     {
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
@@ -145,6 +397,41 @@ namespace OpenMS::Internal
     return chrom_index_;
   }
 
+  const std::vector<double>& CachedMzMLHandler::getSpectraRTIndex() const
+  {
+    return spectra_rt_index_;
+  }
+
+  const std::vector<int>& CachedMzMLHandler::getSpectraMSLevelIndex() const
+  {
+    return spectra_ms_level_index_;
+  }
+
+  const std::vector<double>& CachedMzMLHandler::getSpectraPrecursorMZIndex() const
+  {
+    return spectra_precursor_mz_index_;
+  }
+
+  void CachedMzMLHandler::setFormatVersion(FormatVersion version)
+  {
+    format_version_ = version;
+  }
+
+  CachedMzMLHandler::FormatVersion CachedMzMLHandler::getFormatVersion() const
+  {
+    return format_version_;
+  }
+
+  void CachedMzMLHandler::setLossyCompression(bool lossy)
+  {
+    lossy_compression_ = lossy;
+  }
+
+  bool CachedMzMLHandler::getLossyCompression() const
+  {
+    return lossy_compression_;
+  }
+
   void CachedMzMLHandler::createMemdumpIndex(String filename)
   {
     std::ifstream ifs(filename.c_str(), std::ios::binary);
@@ -163,12 +450,24 @@ namespace OpenMS::Internal
     int extra_offset = sizeof(DoubleType) + sizeof(IntType);
     int chrom_offset = 0;
 
+    spectra_rt_index_.clear();
+    spectra_ms_level_index_.clear();
+    spectra_precursor_mz_index_.clear();
+
     ifs.read((char*)&file_identifier, sizeof(file_identifier));
+    if (file_identifier == CACHED_MZML_FILE_IDENTIFIER_V2)
+    {
+      // version 2 has an index in the footer, no need to scan the file
+      format_version_ = FORMAT_V2;
+      readFooterV2_(ifs, filename);
+      return;
+    }
     if (file_identifier != CACHED_MZML_FILE_IDENTIFIER)
     {
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
           "File might not be a cached mzML file (wrong file magic number). Aborting!", filename);
     }
+    format_version_ = FORMAT_V1;
 
     // For spectra and chromatograms go through file, read the size of the
     // spectrum/chromatogram and record the starting index of the element, then
@@ -312,12 +611,126 @@ namespace OpenMS::Internal
     MzMLFile().store(out_meta, out_exp);
   }
 
-  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast(std::ifstream& ifs, int& ms_level, double& rt)
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast(std::ifstream& ifs, int& ms_level, double& rt, FormatVersion version)
+  {
+    return readSpectrumFast_(ifs, ms_level, rt, version);
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast(const char* data, Size size, int& ms_level, double& rt, FormatVersion version)
+  {
+    MemoryCursor cursor(data, size);
+    return readSpectrumFast_(cursor, ms_level, rt, version);
+  }
+
+  template <typename StreamT>
+  void CachedMzMLHandler::readArrayV2_(StreamT& ifs, OpenSwath::BinaryDataArray& array)
+  {
+    // scratch buffers, reused for all arrays read by this thread
+    thread_local std::vector<Byte> compressed;
+    thread_local std::vector<Byte> raw;
+
+    Size len_name = 0, nr_values = 0, nr_bytes = 0;
+    Byte encoding = ENC_DOUBLE, compression = COMPRESSION_NONE;
+    ifs.read((char*)&len_name, sizeof(len_name));
+    if (len_name > 1024)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "Read an invalid data array name, something is wrong here. Aborting.", "filestream");
+    }
+    std::string name(len_name, '\0');
+    if (len_name > 0) ifs.read(&name[0], len_name);
+    ifs.read((char*)&nr_values, sizeof(nr_values));
+    ifs.read((char*)&encoding, sizeof(encoding));
+    ifs.read((char*)&compression, sizeof(compression));
+    ifs.read((char*)&nr_bytes, sizeof(nr_bytes));
+
+    compressed.resize(nr_bytes);
+    if (nr_bytes > 0) ifs.read((char*)compressed.data(), nr_bytes);
+    const std::vector<Byte>* encoded = &compressed;
+    if (compression == COMPRESSION_ZLIB)
+    {
+      ZlibCompression::uncompressData(compressed.data(), compressed.size(), raw);
+      encoded = &raw;
+    }
+    else if (compression != COMPRESSION_NONE)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "Unknown compression of data array, something is wrong here. Aborting.", String(int(compression)));
+    }
+
+    array.description = name;
+    array.data.resize(nr_values);
+    bool valid = false;
+    switch (encoding)
+    {
+      case ENC_DOUBLE:
+        valid = (encoded->size() == nr_values * sizeof(double));
+        if (valid && nr_values > 0) memcpy(array.data.data(), encoded->data(), encoded->size());
+        break;
+
+      case ENC_FLOAT:
+        valid = (encoded->size() == nr_values * sizeof(float));
+        if (valid)
+        {
+          const float* values = reinterpret_cast<const float*>(encoded->data());
+          std::copy(values, values + nr_values, array.data.begin());
+        }
+        break;
+
+      case ENC_NUMPRESS_LINEAR:
+        try
+        {
+          // numpress may decode up to two values per byte
+          array.data.resize(std::max(nr_values, encoded->size() * 2));
+          valid = (ms::numpress::MSNumpress::decodeLinear(encoded->data(), encoded->size(), array.data.data()) == nr_values);
+          array.data.resize(nr_values);
+        }
+        catch (const char*)
+        {
+          valid = false;
+        }
+        break;
+    }
+    if (!valid)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "Could not decode data array, something is wrong here. Aborting.", "filestream");
+    }
+  }
+
+  template <typename StreamT>
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast_(StreamT& ifs, int& ms_level, double& rt, FormatVersion version)
   {
     std::vector<OpenSwath::BinaryDataArrayPtr> data;
     data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
     data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
 
+    if (version == FORMAT_V2)
+    {
+      Size spec_size = 0;
+      Size nr_float_arrays = 0;
+      Int32 level = 0;
+      ifs.read((char*) &spec_size, sizeof(spec_size));
+      ifs.read((char*) &nr_float_arrays, sizeof(nr_float_arrays));
+      ifs.read((char*) &level, sizeof(level));
+      ifs.read((char*) &rt, sizeof(rt));
+      ms_level = level;
+
+      readArrayV2_(ifs, *data[0]);
+      readArrayV2_(ifs, *data[1]);
+      if (data[0]->data.size() != spec_size || data[1]->data.size() != spec_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+          "Read an invalid spectrum length, something is wrong here. Aborting.", "filestream");
+      }
+      for (Size k = 0; k < nr_float_arrays; k++)
+      {
+        data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+        readArrayV2_(ifs, *data.back());
+      }
+      return data;
+    }
+
     Size spec_size = -1;
     Size nr_float_arrays = -1;
     ifs.read((char*) &spec_size, sizeof(spec_size));
@@ -335,7 +748,8 @@ namespace OpenMS::Internal
     return data;
   }
 
-  void CachedMzMLHandler::readDataFast_(std::ifstream& ifs,
+  template <typename StreamT>
+  void CachedMzMLHandler::readDataFast_(StreamT& ifs,
                                         std::vector<OpenSwath::BinaryDataArrayPtr>& data,
                                         const Size& data_size,
                                         const Size& nr_float_arrays)
@@ -366,7 +780,7 @@ namespace OpenMS::Internal
       // our buffer (and is user-generated input data)
       if (len_name > 1023)
       {
-        ifs.seekg(len_name * sizeof(char), ifs.cur);
+        ifs.seekg(len_name * sizeof(char), std::ios_base::cur);
       }
       else
       {
@@ -381,12 +795,46 @@ namespace OpenMS::Internal
     return;
   }
 
-  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(std::ifstream& ifs)
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(std::ifstream& ifs, FormatVersion version)
+  {
+    return readChromatogramFast_(ifs, version);
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(const char* data, Size size, FormatVersion version)
+  {
+    MemoryCursor cursor(data, size);
+    return readChromatogramFast_(cursor, version);
+  }
+
+  template <typename StreamT>
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast_(StreamT& ifs, FormatVersion version)
   {
     std::vector<OpenSwath::BinaryDataArrayPtr> data;
     data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
     data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
 
+    if (version == FORMAT_V2)
+    {
+      Size chrom_size = 0;
+      Size nr_float_arrays = 0;
+      ifs.read((char*) &chrom_size, sizeof(chrom_size));
+      ifs.read((char*) &nr_float_arrays, sizeof(nr_float_arrays));
+
+      readArrayV2_(ifs, *data[0]);
+      readArrayV2_(ifs, *data[1]);
+      if (data[0]->data.size() != chrom_size || data[1]->data.size() != chrom_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+          "Read an invalid chromatogram length, something is wrong here. Aborting.", "filestream");
+      }
+      for (Size k = 0; k < nr_float_arrays; k++)
+      {
+        data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+        readArrayV2_(ifs, *data.back());
+      }
+      return data;
+    }
+
     Size chrom_size = -1;
     Size nr_float_arrays = -1;
     ifs.read((char*) &chrom_size, sizeof(chrom_size));
@@ -402,11 +850,36 @@ namespace OpenMS::Internal
     return data;
   }
 
-  void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, std::ifstream& ifs)
+  void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, std::ifstream& ifs, FormatVersion version)
+  {
+    int ms_level;
+    double rt;
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(ifs, ms_level, rt, version);
+    fillSpectrum_(data, ms_level, rt, spectrum);
+  }
+
+  void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, const char* data, Size size, FormatVersion version)
   {
     int ms_level;
     double rt;
-    std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(ifs, ms_level, rt);
+    std::vector<OpenSwath::BinaryDataArrayPtr> arrays = readSpectrumFast(data, size, ms_level, rt, version);
+    fillSpectrum_(arrays, ms_level, rt, spectrum);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs, FormatVersion version)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs, version);
+    fillChromatogram_(data, chromatogram);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, const char* data, Size size, FormatVersion version)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> arrays = readChromatogramFast(data, size, version);
+    fillChromatogram_(arrays, chromatogram);
+  }
+
+  void CachedMzMLHandler::fillSpectrum_(const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt, SpectrumType& spectrum)
+  {
     spectrum.reserve(data[0]->data.size());
     spectrum.setMSLevel(ms_level);
     spectrum.setRT(rt);
@@ -428,9 +901,8 @@ namespace OpenMS::Internal
     }
   }
 
-  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs)
+  void CachedMzMLHandler::fillChromatogram_(const std::vector<OpenSwath::BinaryDataArrayPtr>& data, ChromatogramType& chromatogram)
   {
-    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs);
     chromatogram.reserve(data[0]->data.size());
 
     for (Size j = 0; j < data[0]->data.size(); j++)
@@ -446,13 +918,84 @@ namespace OpenMS::Internal
     {
       MSChromatogram::FloatDataArray fda;
       fda.reserve(data[j]->data.size());
-      for (const auto& k : fda) fda.push_back(k);
+      for (const auto& k : data[j]->data) fda.push_back(k);
       fda.setName(data[j]->description);
       fdas.push_back(fda);
     }
     chromatogram.setFloatDataArrays(fdas);
   }
 
+  void CachedMzMLHandler::writeSpectrumV2_(const SpectrumType& spectrum, std::ofstream& ofs, FooterIndex_& index) const
+  {
+    index.spectra_offsets.push_back(ofs.tellp());
+    index.spectra_rt.push_back(spectrum.getRT());
+    index.spectra_ms_level.push_back(spectrum.getMSLevel());
+    index.spectra_precursor_mz.push_back(spectrum.getPrecursors().empty() ? -1.0 : spectrum.getPrecursors()[0].getMZ());
+
+    Size exp_size = spectrum.size();
+    ofs.write((char*)&exp_size, sizeof(exp_size));
+    Size arr_s = spectrum.getFloatDataArrays().size() + spectrum.getIntegerDataArrays().size();
+    ofs.write((char*)&arr_s, sizeof(arr_s));
+    Int32 int_field_ = spectrum.getMSLevel();
+    ofs.write((char*)&int_field_, sizeof(int_field_));
+    DoubleType dbl_field_ = spectrum.getRT();
+    ofs.write((char*)&dbl_field_, sizeof(dbl_field_));
+
+    Datavector mz_data;
+    Datavector int_data;
+    mz_data.reserve(spectrum.size());
+    int_data.reserve(spectrum.size());
+    for (Size j = 0; j < spectrum.size(); j++)
+    {
+      mz_data.push_back(spectrum[j].getMZ());
+      int_data.push_back(static_cast<double>(spectrum[j].getIntensity()));
+    }
+    writeArrayV2(ofs, "", mz_data, lossy_compression_ ? ENC_NUMPRESS_LINEAR : ENC_DOUBLE);
+    // intensities are single precision in memory, float is lossless
+    writeArrayV2(ofs, "", int_data, ENC_FLOAT);
+
+    // float data arrays are single precision in memory, float is lossless
+    for (const auto& fda : spectrum.getFloatDataArrays())
+    {
+      writeArrayV2(ofs, fda.getName(), Datavector(fda.begin(), fda.end()), ENC_FLOAT);
+    }
+    for (const auto& ida : spectrum.getIntegerDataArrays())
+    {
+      writeArrayV2(ofs, ida.getName(), Datavector(ida.begin(), ida.end()), ENC_DOUBLE);
+    }
+  }
+
+  void CachedMzMLHandler::writeChromatogramV2_(const ChromatogramType& chromatogram, std::ofstream& ofs, FooterIndex_& index) const
+  {
+    index.chromatogram_offsets.push_back(ofs.tellp());
+
+    Size exp_size = chromatogram.size();
+    ofs.write((char*)&exp_size, sizeof(exp_size));
+    Size arr_s = chromatogram.getFloatDataArrays().size() + chromatogram.getIntegerDataArrays().size();
+    ofs.write((char*)&arr_s, sizeof(arr_s));
+
+    Datavector rt_data;
+    Datavector int_data;
+    rt_data.reserve(chromatogram.size());
+    int_data.reserve(chromatogram.size());
+    for (Size j = 0; j < chromatogram.size(); j++)
+    {
+      rt_data.push_back(chromatogram[j].getRT());
+      int_data.push_back(chromatogram[j].getIntensity());
+    }
+    writeArrayV2(ofs, "", rt_data, lossy_compression_ ? ENC_NUMPRESS_LINEAR : ENC_DOUBLE);
+    writeArrayV2(ofs, "", int_data, lossy_compression_ ? ENC_FLOAT : ENC_DOUBLE);
+
+    for (const auto& fda : chromatogram.getFloatDataArrays())
+    {
+      writeArrayV2(ofs, fda.getName(), Datavector(fda.begin(), fda.end()), ENC_FLOAT);
+    }
+    for (const auto& ida : chromatogram.getIntegerDataArrays())
+    {
+      writeArrayV2(ofs, ida.getName(), Datavector(ida.begin(), ida.end()), ENC_DOUBLE);
+    }
+  }
+
   void CachedMzMLHandler::writeSpectrum_(const SpectrumType& spectrum, std::ofstream& ofs) const
   {
     Size exp_size = spectrum.size();
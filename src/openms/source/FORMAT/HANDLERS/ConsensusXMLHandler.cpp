@@ -507,7 +507,7 @@ namespace OpenMS::Internal
       peptide_evidences_ = vector<PeptideEvidence>();
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -801,25 +801,26 @@ namespace OpenMS::Internal
 
     // write all consensus elements
     os << "\t<consensusElementList>\n";
-    for (Size i = 0; i < consensus_map.size(); ++i)
+    // consensus elements are independent of each other, so they can be formatted in parallel
+    const UInt progress_offset = progress_;
+    writeElementsParallel_(os, consensus_map.size(), [&](std::ostream& out, Size i)
     {
-      setProgress(++progress_);
       // write a consensusElement
       const ConsensusFeature& elem = consensus_map[i];
-      os << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
+      out << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
       if (elem.getCharge() != 0)
       {
-        os << " charge=\"" << elem.getCharge() << "\"";
+        out << " charge=\"" << elem.getCharge() << "\"";
       }
-      os << ">\n";
+      out << ">\n";
       // write centroid
-      os << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
+      out << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
         elem.getIntensity()) << "\"/>\n";
       // write groupedElementList
-      os << "\t\t\t<groupedElementList>\n";
+      out << "\t\t\t<groupedElementList>\n";
       for (ConsensusFeature::HandleSetType::const_iterator it = elem.begin(); it != elem.end(); ++it)
       {
-        os << "\t\t\t\t<element"
+        out << "\t\t\t\t<element"
               " map=\"" << it->getMapIndex() << "\""
                                                 " id=\"" << it->getUniqueId() << "\""
                                                                                  " rt=\"" << precisionWrapper(it->getRT()) << "\""
@@ -827,21 +828,22 @@ namespace OpenMS::Internal
                                                                                                                                                                            " it=\"" << precisionWrapper(it->getIntensity()) << "\"";
         if (it->getCharge() != 0)
         {
-          os << " charge=\"" << it->getCharge() << "\"";
+          out << " charge=\"" << it->getCharge() << "\"";
         }
-        os << "/>\n";
+        out << "/>\n";
       }
-      os << "\t\t\t</groupedElementList>\n";
+      out << "\t\t\t</groupedElementList>\n";
 
       // write PeptideIdentification
       for (UInt j = 0; j < elem.getPeptideIdentifications().size(); ++j)
       {
-        writePeptideIdentification_(file_, os, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
+        writePeptideIdentification_(file_, out, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
       }
 
-      writeUserParam_("UserParam", os, elem, 3);
-      os << "\t\t</consensusElement>\n";
-    }
+      writeUserParam_("UserParam", out, elem, 3);
+      out << "\t\t</consensusElement>\n";
+    },
+    [&](Size written) { progress_ = progress_offset + (UInt)written; setProgress(progress_); });
     os << "\t</consensusElementList>\n";
 
     os << "</consensusXML>\n";
@@ -857,14 +859,17 @@ namespace OpenMS::Internal
   {
     String indent = String(indentation_level, '\t');
 
-    if (identifier_id_.find(id.getIdentifier()) == identifier_id_.end())
+    // only const access to the lookup tables (consensus elements are written in parallel)
+    const auto run_id = identifier_id_.find(id.getIdentifier());
+    if (run_id == identifier_id_.end())
     {
+#pragma omp critical (ConsensusXMLHandler_warning)
       warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + id.getIdentifier()
               + "' while writing '" + filename + "'!");
       return;
     }
     os << indent << "<" << tag_name << " ";
-    os << "identification_run_ref=\"" << identifier_id_[id.getIdentifier()] << "\" ";
+    os << "identification_run_ref=\"" << run_id->second << "\" ";
     os << "score_type=\"" << writeXMLEscape(id.getScoreType()) << "\" ";
     os << "higher_score_better=\"" << (id.isHigherScoreBetter() ? "true" : "false") << "\" ";
     os << "significance_threshold=\"" << id.getSignificanceThreshold() << "\" ";
@@ -894,7 +899,7 @@ namespace OpenMS::Internal
       os << " sequence=\"" << writeXMLEscape(id.getHits()[j].getSequence().toString()) << "\"";
       os << " charge=\"" << id.getHits()[j].getCharge() << "\"";
 
-      vector<PeptideEvidence> pes = id.getHits()[j].getPeptideEvidences();
+      const vector<PeptideEvidence>& pes = id.getHits()[j].getPeptideEvidences();
 
       IdXMLFile::createFlankingAAXMLString_(pes, os);
       IdXMLFile::createPositionXMLString_(pes, os);
@@ -911,8 +916,9 @@ namespace OpenMS::Internal
         // empty accessions are not written out (legacy code)
         if (!protein_accession.empty())
         {
+          const auto acc_id = accession_to_id_.find(id.getIdentifier() + "_" + protein_accession);
           accs += "PH_";
-          accs += String(accession_to_id_[id.getIdentifier() + "_" + protein_accession]);
+          accs += String(acc_id == accession_to_id_.end() ? UInt(0) : acc_id->second);
         }
       }
 
@@ -234,12 +234,10 @@ namespace OpenMS::Internal
     // write features with their corresponding attributes
     os << "\t<featureList count=\"" << feature_map.size() << "\">\n";
     startProgress(0, feature_map.size(), "Storing featureXML file");
-    for (Size s = 0; s < feature_map.size(); s++)
-    {
-      writeFeature_(file_, os, feature_map[s], "f_", feature_map[s].getUniqueId(), 0);
-      setProgress(s);
-      // writeFeature_(file_, os, feature_map[s], "f_", s, 0);
-    }
+    // features are independent of each other, so they can be formatted in parallel
+    writeElementsParallel_(os, feature_map.size(),
+      [&](std::ostream& out, Size s) { writeFeature_(file_, out, feature_map[s], "f_", feature_map[s].getUniqueId(), 0); },
+      [&](Size written) { setProgress(written); });
     endProgress();
 
     os << "\t</featureList>\n";
@@ -623,7 +621,7 @@ namespace OpenMS::Internal
 
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -924,9 +922,9 @@ namespace OpenMS::Internal
     os << indent << "\t\t\t<charge>" << feat.getCharge() << "</charge>\n";
 
     // write convex hull
-    vector<ConvexHull2D> hulls = feat.getConvexHulls();
+    const vector<ConvexHull2D>& hulls = feat.getConvexHulls();
 
-    Size hulls_count = hulls.size();
+    Size hulls_count = options_.getStoreConvexHull() ? hulls.size() : 0;
 
     for (Size i = 0; i < hulls_count; i++)
     {
@@ -952,7 +950,7 @@ namespace OpenMS::Internal
       os << indent << "\t\t\t</convexhull>\n";
     }
 
-    if (!feat.getSubordinates().empty())
+    if (!feat.getSubordinates().empty() && options_.getStoreSubordinates())
     {
       os << indent << "\t\t\t<subordinate>\n";
       for (size_t i = 0; i < feat.getSubordinates().size(); ++i)
@@ -980,13 +978,16 @@ namespace OpenMS::Internal
   {
     String indent = String(indentation_level, '\t');
 
-    if (identifier_id_.find(id.getIdentifier()) == identifier_id_.end())
+    // only const access to the lookup tables (features are written in parallel)
+    const auto run_id = identifier_id_.find(id.getIdentifier());
+    if (run_id == identifier_id_.end())
     {
+#pragma omp critical (FeatureXMLHandler_warning)
       warning(STORE, String("Omitting peptide identification because of missing ProteinIdentification with identifier '") + id.getIdentifier() + "' while writing '" + filename + "'!");
       return;
     }
     os << indent << "<" << tag_name << " ";
-    os << "identification_run_ref=\"" << identifier_id_[id.getIdentifier()] << "\" ";
+    os << "identification_run_ref=\"" << run_id->second << "\" ";
     os << "score_type=\"" << writeXMLEscape(id.getScoreType()) << "\" ";
     os << "higher_score_better=\"" << (id.isHigherScoreBetter() ? "true" : "false") << "\" ";
     os << "significance_threshold=\"" << id.getSignificanceThreshold() << "\" ";
@@ -1034,8 +1035,9 @@ namespace OpenMS::Internal
         // empty accessions are not written out (legacy code)
         if (!protein_accession.empty())
         {
+          const auto acc_id = accession_to_id_.find(id.getIdentifier() + "_" + protein_accession);
           accs += "PH_";
-          accs += String(accession_to_id_[id.getIdentifier() + "_" + protein_accession]);
+          accs += String(acc_id == accession_to_id_.end() ? Size(0) : acc_id->second);
         }
       }
 
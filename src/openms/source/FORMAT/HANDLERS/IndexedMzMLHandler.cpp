@@ -37,6 +37,9 @@
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
 #include <OpenMS/FORMAT/HANDLERS/MzMLSpectrumDecoder.h>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 
 // #define DEBUG_READER
 
@@ -88,6 +91,7 @@ namespace OpenMS::Internal
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler(const String& filename) :
+    memory_mapped_(false),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {
@@ -95,6 +99,7 @@ namespace OpenMS::Internal
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler() :
+    memory_mapped_(false),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {}
@@ -102,15 +107,23 @@ namespace OpenMS::Internal
   IndexedMzMLHandler::IndexedMzMLHandler(const IndexedMzMLHandler& source) :
     filename_(source.filename_),
     spectra_offsets_(source.spectra_offsets_),
+    spectra_native_ids_(source.spectra_native_ids_),
     chromatograms_offsets_(source.chromatograms_offsets_),
+    chromatograms_native_ids_(source.chromatograms_native_ids_),
     index_offset_(source.index_offset_),
     spectra_before_chroms_(source.spectra_before_chroms_),
-    // do not copy the filestream itself but open a new filestream using the same file
-    // this is critical for parallel access to the same file!
-    filestream_(source.filename_.c_str()),
+    // the read-only mapping can be shared safely
+    mapping_(source.mapping_),
+    memory_mapped_(source.memory_mapped_),
     parsing_success_(source.parsing_success_),
     skip_xml_checks_(source.skip_xml_checks_)
   {
+    // do not copy the filestream itself but open a new filestream using the same file
+    // this is critical for parallel access to the same file!
+    if (!mapping_)
+    {
+      filestream_.open(filename_.c_str());
+    }
   }
 
   IndexedMzMLHandler::~IndexedMzMLHandler()
@@ -126,6 +139,10 @@ namespace OpenMS::Internal
     filename_ = filename;
     filestream_.open(filename);
     parseFooter_();
+    if (memory_mapped_)
+    {
+      mapFile_();
+    }
   }
 
   bool IndexedMzMLHandler::getParsingSuccess() const
@@ -143,7 +160,7 @@ namespace OpenMS::Internal
     return chromatograms_offsets_.size();
   }
 
-  std::string IndexedMzMLHandler::getChromatogramById_helper_(int id)
+  std::string_view IndexedMzMLHandler::getChromatogramById_helper_(int id, std::string& buffer)
   {
     int chromToGet = id;
 
@@ -187,23 +204,10 @@ namespace OpenMS::Internal
       endidx = chromatograms_offsets_[chromToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
-
-#ifdef DEBUG_READER
-    // print the full text we just read
-    std::cout << text << std::endl;
-#endif
-
-    return text;
+    return readRange_(startidx, endidx, buffer);
   }
 
-  std::string IndexedMzMLHandler::getSpectrumById_helper_(int id)
+  std::string_view IndexedMzMLHandler::getSpectrumById_helper_(int id, std::string& buffer)
   {
     int spectrumToGet = id;
 
@@ -247,26 +251,82 @@ namespace OpenMS::Internal
       endidx = spectra_offsets_[spectrumToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    return readRange_(startidx, endidx, buffer);
+  }
+
+  std::string_view IndexedMzMLHandler::readRange_(std::streampos start, std::streampos end, std::string& buffer)
+  {
+    if (mapping_)
+    {
+      // zero-copy: decode directly from the mapped file
+      const Size region_size = mapping_->get_size();
+      if (start < 0 || end < start || Size(end) > region_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Offset outside of the mapped file", filename_);
+      }
+      return std::string_view(static_cast<const char*>(mapping_->get_address()) + std::streamoff(start), Size(end - start));
+    }
+
+    std::streampos readl = end - start;
+    buffer.resize(readl);
+    filestream_.seekg(start, filestream_.beg);
+    filestream_.read(&buffer[0], readl);
+    // the file may be shorter than the offsets claim (do not decode garbage)
+    buffer.resize(filestream_.gcount());
 
 #ifdef DEBUG_READER
     // print the full text we just read
-    std::cout << text << std::endl;
+    std::cout << buffer << std::endl;
 #endif
 
-    return text;
+    return buffer;
+  }
+
+  void IndexedMzMLHandler::mapFile_()
+  {
+    mapping_.reset();
+    if (filename_.empty() || !parsing_success_)
+    {
+      return;
+    }
+    try
+    {
+      boost::interprocess::file_mapping file(filename_.c_str(), boost::interprocess::read_only);
+      auto region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+      // spectra are usually accessed in random order (the mapping stays valid after the file_mapping is closed)
+      region->advise(boost::interprocess::mapped_region::advice_random);
+      mapping_ = region;
+    }
+    catch (boost::interprocess::interprocess_exception&)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+  }
+
+  void IndexedMzMLHandler::setMemoryMapped(bool memory_mapped)
+  {
+    memory_mapped_ = memory_mapped;
+    if (memory_mapped_)
+    {
+      mapFile_();
+    }
+    else
+    {
+      mapping_.reset();
+    }
+  }
+
+  bool IndexedMzMLHandler::isMemoryMapped() const
+  {
+    return mapping_ != nullptr;
   }
 
   OpenMS::Interfaces::SpectrumPtr IndexedMzMLHandler::getSpectrumById(int id)
   {
     OpenMS::Interfaces::SpectrumPtr sptr(new OpenMS::Interfaces::Spectrum);
-    std::string text = IndexedMzMLHandler::getSpectrumById_helper_(id);
+    std::string buffer;
+    std::string_view text = IndexedMzMLHandler::getSpectrumById_helper_(id, buffer);
     MzMLSpectrumDecoder(skip_xml_checks_).domParseSpectrum(text, sptr);
     return sptr;
   }
@@ -290,14 +350,16 @@ namespace OpenMS::Internal
 
   void IndexedMzMLHandler::getMSSpectrumById(int id, MSSpectrum& s)
   {
-    std::string text = IndexedMzMLHandler::getSpectrumById_helper_(id);
+    std::string buffer;
+    std::string_view text = IndexedMzMLHandler::getSpectrumById_helper_(id, buffer);
     MzMLSpectrumDecoder(skip_xml_checks_).domParseSpectrum(text, s);
   }
 
   OpenMS::Interfaces::ChromatogramPtr IndexedMzMLHandler::getChromatogramById(int id)
   {
     OpenMS::Interfaces::ChromatogramPtr cptr(new OpenMS::Interfaces::Chromatogram);
-    std::string text = IndexedMzMLHandler::getChromatogramById_helper_(id);
+    std::string buffer;
+    std::string_view text = IndexedMzMLHandler::getChromatogramById_helper_(id, buffer);
     MzMLSpectrumDecoder(skip_xml_checks_).domParseChromatogram(text, cptr);
     return cptr;
   }
@@ -322,7 +384,8 @@ namespace OpenMS::Internal
 
   void IndexedMzMLHandler::getMSChromatogramById(int id, MSChromatogram& c)
   {
-    std::string text = IndexedMzMLHandler::getChromatogramById_helper_(id);
+    std::string buffer;
+    std::string_view text = IndexedMzMLHandler::getChromatogramById_helper_(id, buffer);
     MzMLSpectrumDecoder(skip_xml_checks_).domParseChromatogram(text, c);
   }
 
@@ -58,6 +58,8 @@ namespace OpenMS::Internal
     //TODO general id openms struct for overall parameter for one id run
     MzIdentMLDOMHandler::MzIdentMLDOMHandler(const vector<ProteinIdentification>& pro_id, const vector<PeptideIdentification>& pep_id, const String& version, const ProgressLogger& logger) :
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"UNIMOD", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       pro_id_(nullptr),
       pep_id_(nullptr),
@@ -66,9 +68,6 @@ namespace OpenMS::Internal
       schema_version_(version),
       mzid_parser_()
     {
-      unimod_.loadFromOBO("UNIMOD", File::find("/CV/unimod.obo"));
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-
       try
       {
         XMLPlatformUtils::Initialize(); // Initialize Xerces infrastructure
@@ -91,6 +90,8 @@ namespace OpenMS::Internal
 
     MzIdentMLDOMHandler::MzIdentMLDOMHandler(vector<ProteinIdentification>& pro_id, vector<PeptideIdentification>& pep_id, const String& version, const ProgressLogger& logger) :
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"UNIMOD", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       pro_id_(&pro_id),
       pep_id_(&pep_id),
@@ -100,9 +101,6 @@ namespace OpenMS::Internal
       mzid_parser_(),
       xl_ms_search_(false)
     {
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      unimod_.loadFromOBO("UNIMOD", File::find("/CV/unimod.obo"));
-
       try
       {
         XMLPlatformUtils::Initialize(); // Initialize Xerces infrastructure
@@ -55,49 +55,49 @@ namespace OpenMS::Internal
     MzIdentMLHandler::MzIdentMLHandler(const Identification& id, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       id_(nullptr),
       cid_(&id)
     {
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      unimod_.loadFromOBO("PSI-MS", File::find("/CV/unimod.obo"));
     }
 
     MzIdentMLHandler::MzIdentMLHandler(Identification& id, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       id_(&id),
       cid_(nullptr)
     {
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      unimod_.loadFromOBO("PSI-MS", File::find("/CV/unimod.obo"));
     }
 
     MzIdentMLHandler::MzIdentMLHandler(const std::vector<ProteinIdentification>& pro_id, const std::vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       pro_id_(nullptr),
       pep_id_(nullptr),
       cpro_id_(&pro_id),
       cpep_id_(&pep_id)
     {
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      unimod_.loadFromOBO("PSI-MS", File::find("/CV/unimod.obo"));
     }
 
     MzIdentMLHandler::MzIdentMLHandler(std::vector<ProteinIdentification>& pro_id, std::vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+      unimod_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/unimod.obo"}})),
       //~ ms_exp_(0),
       pro_id_(&pro_id),
       pep_id_(&pep_id),
       cpro_id_(nullptr),
       cpep_id_(nullptr)
     {
-      cv_.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      unimod_.loadFromOBO("PSI-MS", File::find("/CV/unimod.obo"));
     }
 
     //~ TODO create MzIdentML instances from MSExperiment which contains much of the information yet needed
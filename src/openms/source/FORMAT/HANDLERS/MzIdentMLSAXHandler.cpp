@@ -0,0 +1,1235 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLSAXHandler.h>
+
+#include <OpenMS/CHEMISTRY/ModificationsDB.h>
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/CHEMISTRY/ResidueModification.h>
+#include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/UniqueIdGenerator.h>
+#include <OpenMS/FORMAT/ControlledVocabulary.h>
+
+using namespace std;
+
+namespace OpenMS::Internal
+{
+
+  CVTermList MzIdentMLSAXHandler::ParamGroup::getCVTermList() const
+  {
+    CVTermList cvs;
+    for (const CVTerm& cv : cv_terms)
+    {
+      cvs.addCVTerm(cv);
+    }
+    return cvs;
+  }
+
+  map<String, DataValue> MzIdentMLSAXHandler::ParamGroup::getUserParams() const
+  {
+    // (like in the DOM handler, the first userParam of a name wins)
+    return map<String, DataValue>(user_params.begin(), user_params.end());
+  }
+
+  void MzIdentMLSAXHandler::ParamGroup::clear()
+  {
+    cv_terms.clear();
+    user_params.clear();
+  }
+
+  MzIdentMLSAXHandler::MzIdentMLSAXHandler(vector<ProteinIdentification>& pro_id, vector<PeptideIdentification>& pep_id, const String& filename, const String& version, const ProgressLogger& logger) :
+    XMLHandler(filename, version),
+    logger_(logger),
+    cv_(ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}})),
+    pro_id_(&pro_id),
+    pep_id_(&pep_id),
+    collect_characters_(false),
+    xl_ms_search_(false),
+    pro_ids_created_(false),
+    spectra_data_count_(0),
+    spectrum_identification_list_count_(0),
+    current_db_sequence_(0),
+    current_mod_fixed_(false),
+    current_fragment_tolerance_(0),
+    current_precursor_tolerance_(0),
+    current_sii_calculated_mz_(0),
+    current_sii_experimental_mz_(0),
+    current_sii_charge_(0),
+    current_sii_rank_(0),
+    current_sii_pass_(false)
+  {
+    cv_.getAllChildTerms(software_terms_, "MS:1000531"); // software
+    cv_.getAllChildTerms(enzyme_terms_, "MS:1001045"); // cleavage agent name
+    cv_.getAllChildTerms(threshold_terms_, "MS:1002482"); // statistical threshold
+    cv_.getAllChildTerms(q_score_terms_, "MS:1002354"); // q-value for peptides
+    set<String> e_score_tmp;
+    cv_.getAllChildTerms(e_score_terms_, "MS:1001872");
+    cv_.getAllChildTerms(e_score_tmp, "MS:1002353");
+    e_score_terms_.insert(e_score_tmp.begin(), e_score_tmp.end()); // E-value for peptides
+    cv_.getAllChildTerms(specific_score_terms_, "MS:1001143"); // search engine specific score for PSMs
+  }
+
+  MzIdentMLSAXHandler::~MzIdentMLSAXHandler()
+  {
+  }
+
+  bool MzIdentMLSAXHandler::isCrossLinkingSearch() const
+  {
+    return xl_ms_search_;
+  }
+
+  void MzIdentMLSAXHandler::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
+  {
+    tag_ = sm_.convert(qname);
+    open_tags_.push_back(tag_);
+    if (param_groups_.size() < open_tags_.size())
+    {
+      param_groups_.resize(open_tags_.size());
+    }
+    param_groups_[open_tags_.size() - 1].clear();
+
+    String parent_tag;
+    if (open_tags_.size() > 1)
+    {
+      parent_tag = *(open_tags_.end() - 2);
+    }
+
+    if (tag_ == "cvParam")
+    {
+      if (open_tags_.size() < 2) return;
+      param_groups_[open_tags_.size() - 2].cv_terms.push_back(parseCvParam_(attributes));
+      if (parent_tag == "AdditionalSearchParams" && param_groups_[open_tags_.size() - 2].cv_terms.back().getAccession() == "MS:1002494") // cross-linking search
+      {
+        // the XL-MS specific conversion is only implemented in MzIdentMLDOMHandler
+        xl_ms_search_ = true;
+        throw EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+      }
+      return;
+    }
+    if (tag_ == "userParam")
+    {
+      if (open_tags_.size() < 2) return;
+      param_groups_[open_tags_.size() - 2].user_params.push_back(parseUserParam_(attributes));
+      return;
+    }
+
+    // 0. AnalysisSoftwareList
+    if (tag_ == "AnalysisSoftware")
+    {
+      current_software_ = AnalysisSoftware();
+      current_software_id_.clear();
+      optionalAttributeAsString_(current_software_id_, attributes, CONST_XMLCH("id"));
+      optionalAttributeAsString_(current_software_.version, attributes, CONST_XMLCH("version"));
+      return;
+    }
+
+    // 1. SequenceCollection: DBSequence, Peptide, PeptideEvidence
+    if (tag_ == "DBSequence")
+    {
+      String id;
+      optionalAttributeAsString_(id, attributes, CONST_XMLCH("id"));
+      current_db_sequence_ = dbSequenceIndex_(id);
+      DBSequence& db = db_sequences_[current_db_sequence_];
+      db = DBSequence();
+      optionalAttributeAsString_(db.accession, attributes, CONST_XMLCH("accession"));
+      return;
+    }
+    if (tag_ == "Seq" || tag_ == "PeptideSequence")
+    {
+      characters_.clear();
+      collect_characters_ = true;
+      return;
+    }
+    if (tag_ == "Peptide")
+    {
+      current_peptide_id_.clear();
+      current_peptide_name_.clear();
+      optionalAttributeAsString_(current_peptide_id_, attributes, CONST_XMLCH("id"));
+      optionalAttributeAsString_(current_peptide_name_, attributes, CONST_XMLCH("name"));
+      current_peptide_sequence_.clear();
+      current_substitutions_.clear();
+      current_modifications_.clear();
+      return;
+    }
+    if (tag_ == "SubstitutionModification")
+    {
+      Substitution sub;
+      optionalAttributeAsString_(sub.location, attributes, CONST_XMLCH("location"));
+      optionalAttributeAsString_(sub.original_residue, attributes, CONST_XMLCH("originalResidue"));
+      optionalAttributeAsString_(sub.replacement_residue, attributes, CONST_XMLCH("replacementResidue"));
+      current_substitutions_.push_back(sub);
+      return;
+    }
+    if (tag_ == "Modification" && parent_tag == "Peptide")
+    {
+      Modification mod;
+      optionalAttributeAsString_(mod.location, attributes, CONST_XMLCH("location"));
+      optionalAttributeAsString_(mod.mass_delta, attributes, CONST_XMLCH("monoisotopicMassDelta"));
+      current_modifications_.push_back(mod);
+      return;
+    }
+    if (tag_ == "PeptideEvidence")
+    {
+      // <PeptideEvidence peptide_ref="peptide_1_1" id="PE_1_1_HSP70_ECHGR_0" start="161" end="172" pre="K" post="I" isDecoy="false" dBSequence_ref="DBSeq_HSP70_ECHGR"/>
+      String peptide_ref, db_sequence_ref;
+      optionalAttributeAsString_(peptide_ref, attributes, CONST_XMLCH("peptide_ref"));
+      optionalAttributeAsString_(db_sequence_ref, attributes, CONST_XMLCH("dBSequence_ref"));
+      //rest is optional !!
+      PeptideEvidence pev = {-1, -1, '-', '-', false, dbSequenceIndex_(db_sequence_ref)};
+      String value;
+      try
+      {
+        optionalAttributeAsString_(value, attributes, CONST_XMLCH("start"));
+        pev.start = value.toInt();
+        value.clear();
+        optionalAttributeAsString_(value, attributes, CONST_XMLCH("end"));
+        pev.stop = value.toInt();
+      }
+      catch (...)
+      {
+        OPENMS_LOG_WARN << "'PeptideEvidence' without reference to the position in the originating sequence found." << endl;
+      }
+      if (optionalAttributeAsString_(value, attributes, CONST_XMLCH("pre")))
+      {
+        pev.pre = value[0];
+      }
+      if (optionalAttributeAsString_(value, attributes, CONST_XMLCH("post")))
+      {
+        pev.post = value[0];
+      }
+      value.clear();
+      optionalAttributeAsString_(value, attributes, CONST_XMLCH("isDecoy"));
+      pev.idec = value.hasPrefix('t') || value.hasPrefix('1');
+      peptide_evidences_[peptideIndex_(peptide_ref)].push_back(pev);
+      return;
+    }
+
+    // 2. AnalysisCollection: SpectrumIdentification
+    if (tag_ == "SpectrumIdentification")
+    {
+      current_si_ = SpectrumIdentification();
+      optionalAttributeAsString_(current_si_.spectrum_identification_protocol_ref, attributes, CONST_XMLCH("spectrumIdentificationProtocol_ref"));
+      optionalAttributeAsString_(current_si_.spectrum_identification_list_ref, attributes, CONST_XMLCH("spectrumIdentificationList_ref"));
+      optionalAttributeAsString_(current_si_.activity_date, attributes, CONST_XMLCH("activityDate"));
+      return;
+    }
+    if (tag_ == "InputSpectra" && parent_tag == "SpectrumIdentification")
+    {
+      optionalAttributeAsString_(current_si_.spectra_data_ref, attributes, CONST_XMLCH("spectraData_ref"));
+      return;
+    }
+    if (tag_ == "SearchDatabaseRef" && parent_tag == "SpectrumIdentification")
+    {
+      optionalAttributeAsString_(current_si_.search_database_ref, attributes, CONST_XMLCH("searchDatabase_ref"));
+      return;
+    }
+
+    // 3. AnalysisProtocolCollection: SpectrumIdentificationProtocol
+    if (tag_ == "SpectrumIdentificationProtocol")
+    {
+      current_sip_ = SpectrumIdentificationProtocol();
+      current_sip_id_.clear();
+      optionalAttributeAsString_(current_sip_id_, attributes, CONST_XMLCH("id"));
+      optionalAttributeAsString_(current_sip_.analysis_software_ref, attributes, CONST_XMLCH("analysisSoftware_ref"));
+      current_fragment_tolerance_ = 0;
+      current_precursor_tolerance_ = 0;
+      current_threshold_ = CVTermList();
+      return;
+    }
+    if (tag_ == "ModificationParams")
+    {
+      current_fixed_mods_.clear();
+      current_variable_mods_.clear();
+      return;
+    }
+    if (tag_ == "SearchModification")
+    {
+      current_mod_residues_.clear();
+      current_mod_name_.clear();
+      current_specificity_rules_ = CVTermList();
+      optionalAttributeAsString_(current_mod_residues_, attributes, CONST_XMLCH("residues"));
+      String fixed;
+      optionalAttributeAsString_(fixed, attributes, CONST_XMLCH("fixedMod"));
+      fixed.trim();
+      current_mod_fixed_ = (fixed == "true" || fixed == "1");
+      return;
+    }
+    if (tag_ == "Enzyme")
+    {
+      int missed_cleavages = -1;
+      String value;
+      optionalAttributeAsString_(value, attributes, CONST_XMLCH("missedCleavages"));
+      try
+      {
+        missed_cleavages = value.toInt();
+      }
+      catch (exception& e)
+      {
+        OPENMS_LOG_WARN << "Search engine enzyme settings for 'missedCleavages' unreadable: " << e.what() << value << endl;
+      }
+      if (missed_cleavages < 0)
+      {
+        OPENMS_LOG_WARN << "missedCleavages has a negative value. Assuming unlimited and setting it to 1000." << endl;
+        missed_cleavages = 1000;
+      }
+      current_sip_.search_parameters.missed_cleavages = missed_cleavages;
+      current_enzyme_name_ = "UNKNOWN";
+      return;
+    }
+
+    // 4. DataCollection: Inputs
+    if (tag_ == "SpectraData")
+    {
+      String id, location;
+      optionalAttributeAsString_(id, attributes, CONST_XMLCH("id"));
+      optionalAttributeAsString_(location, attributes, CONST_XMLCH("location"));
+      sd_map_.insert(make_pair(id, location));
+      ++spectra_data_count_;
+      return;
+    }
+    if (tag_ == "SearchDatabase")
+    {
+      String id;
+      DatabaseInput db;
+      optionalAttributeAsString_(id, attributes, CONST_XMLCH("id"));
+      optionalAttributeAsString_(db.location, attributes, CONST_XMLCH("location"));
+      optionalAttributeAsString_(db.version, attributes, CONST_XMLCH("version"));
+      db_map_.insert(make_pair(id, db));
+      return;
+    }
+
+    // 5. DataCollection: AnalysisData - the identifications
+    if (tag_ == "SpectrumIdentificationList")
+    {
+      if (!pro_ids_created_)
+      {
+        createProteinIdentifications_();
+      }
+      current_sil_.clear();
+      optionalAttributeAsString_(current_sil_, attributes, CONST_XMLCH("id"));
+      ++spectrum_identification_list_count_;
+      return;
+    }
+    if (tag_ == "SpectrumIdentificationResult")
+    {
+      String spectrum_id;
+      optionalAttributeAsString_(spectrum_id, attributes, CONST_XMLCH("spectrumID"));
+      pep_id_->push_back(PeptideIdentification());
+      pep_id_->back().setHigherScoreBetter(false); //either a q-value or an e-value, only if neither available there will be another
+      pep_id_->back().setMetaValue("spectrum_reference", spectrum_id);
+      return;
+    }
+    if (tag_ == "SpectrumIdentificationItem")
+    {
+      current_sii_peptide_ref_.clear();
+      optionalAttributeAsString_(current_sii_peptide_ref_, attributes, CONST_XMLCH("peptide_ref"));
+      current_sii_calculated_mz_ = 0;
+      optionalAttributeAsDouble_(current_sii_calculated_mz_, attributes, CONST_XMLCH("calculatedMassToCharge"));
+      current_sii_experimental_mz_ = 0;
+      optionalAttributeAsDouble_(current_sii_experimental_mz_, attributes, CONST_XMLCH("experimentalMassToCharge"));
+      String value;
+      current_sii_charge_ = 0;
+      if (optionalAttributeAsString_(value, attributes, CONST_XMLCH("chargeState")))
+      {
+        try
+        {
+          current_sii_charge_ = value.toInt();
+        }
+        catch (...)
+        {
+          OPENMS_LOG_WARN << "Found unreadable 'chargeState'." << endl;
+        }
+      }
+      current_sii_rank_ = 0;
+      value.clear();
+      optionalAttributeAsString_(value, attributes, CONST_XMLCH("rank"));
+      try
+      {
+        current_sii_rank_ = value.toInt();
+      }
+      catch (...)
+      {
+        OPENMS_LOG_WARN << "Found unreadable PSM rank." << endl;
+      }
+      value.clear();
+      optionalAttributeAsString_(value, attributes, CONST_XMLCH("passThreshold"));
+      value.trim();
+      current_sii_pass_ = (value == "true" || value == "1");
+      return;
+    }
+    if (tag_ == "ProteinDetectionHypothesis")
+    {
+      String db_sequence_ref;
+      optionalAttributeAsString_(db_sequence_ref, attributes, CONST_XMLCH("dBSequence_ref"));
+      if (pro_id_->empty()) return;
+
+      ProteinIdentification& protein_identification = pro_id_->back();
+      protein_identification.insertHit(ProteinHit());
+      unordered_map<String, Size>::const_iterator db_it = db_sequence_index_.find(db_sequence_ref);
+      if (db_it != db_sequence_index_.end())
+      {
+        protein_identification.getHits().back().setSequence(db_sequences_[db_it->second].sequence);
+        protein_identification.getHits().back().setAccession(db_sequences_[db_it->second].accession);
+      }
+      return;
+    }
+  }
+
+  void MzIdentMLSAXHandler::characters(const XMLCh* const chars, const XMLSize_t length)
+  {
+    if (collect_characters_)
+    {
+      sm_.appendASCII(chars, length, characters_);
+    }
+  }
+
+  void MzIdentMLSAXHandler::endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname)
+  {
+    tag_ = sm_.convert(qname);
+    const ParamGroup& params = param_groups_[open_tags_.size() - 1];
+    String parent_tag;
+    if (open_tags_.size() > 1)
+    {
+      parent_tag = *(open_tags_.end() - 2);
+    }
+
+    if (tag_ == "cvParam" || tag_ == "userParam")
+    {
+      // nothing to do
+    }
+    // 0. AnalysisSoftwareList
+    else if (tag_ == "SoftwareName") //must have exactly one SoftwareName
+    {
+      String swname;
+      if (!params.cv_terms.empty())
+      {
+        CVTermList cvs = params.getCVTermList();
+        for (map<String, vector<CVTerm> >::const_iterator it = cvs.getCVTerms().begin(); it != cvs.getCVTerms().end(); ++it)
+        {
+          if (software_terms_.find(it->first) != software_terms_.end())
+          {
+            swname = it->second.front().getName();
+            break;
+          }
+        }
+      }
+      else if (!params.user_params.empty())
+      {
+        map<String, DataValue> ups = params.getUserParams();
+        for (map<String, DataValue>::const_iterator up = ups.begin(); up != ups.end(); ++up)
+        {
+          if (up->first.hasSubstring("name"))
+          {
+            swname = up->second.toString();
+            break;
+          }
+          else
+          {
+            swname = up->first;
+          }
+        }
+      }
+      current_software_.name = swname;
+    }
+    else if (tag_ == "AnalysisSoftware")
+    {
+      if (!current_software_.name.empty() && !current_software_.version.empty())
+      {
+        as_map_.insert(make_pair(current_software_id_, current_software_));
+      }
+      else
+      {
+        OPENMS_LOG_ERROR << "No name/version found for 'AnalysisSoftware':" << current_software_id_ << "." << endl;
+      }
+    }
+    // 1. SequenceCollection
+    else if (tag_ == "Seq")
+    {
+      collect_characters_ = false;
+      if (parent_tag == "DBSequence")
+      {
+        db_sequences_[current_db_sequence_].sequence = characters_;
+      }
+    }
+    else if (tag_ == "DBSequence")
+    {
+      // (DBSequences without accession are not referenceable)
+      if (db_sequences_[current_db_sequence_].accession.empty())
+      {
+        db_sequences_[current_db_sequence_] = DBSequence();
+      }
+    }
+    else if (tag_ == "PeptideSequence")
+    {
+      collect_characters_ = false;
+      current_peptide_sequence_ = characters_;
+    }
+    else if (tag_ == "Modification" && parent_tag == "Peptide")
+    {
+      current_modifications_.back().cv_terms = params.cv_terms;
+    }
+    else if (tag_ == "Peptide")
+    {
+      AASequence aas;
+      try
+      {
+        try
+        {
+          aas = parsePeptide_();
+        }
+        catch (Exception::MissingInformation&)
+        {
+          // We found an unknown modification, we could try to rescue this
+          // situation. The "name" attribute, if present, may be parsable:
+          //   The potentially ambiguous common identifier, such as a
+          //   human-readable name for the instance.
+          if (!current_peptide_name_.empty()) aas = AASequence::fromString(current_peptide_name_);
+        }
+      }
+      catch (...)
+      {
+        OPENMS_LOG_ERROR << "No amino acid sequence readable from 'Peptide'" << endl;
+      }
+      peptides_[peptideIndex_(current_peptide_id_)] = aas;
+    }
+    // 2. AnalysisCollection
+    else if (tag_ == "SpectrumIdentification")
+    {
+      spectrum_identifications_.push_back(current_si_);
+    }
+    // 3. AnalysisProtocolCollection
+    else if (tag_ == "AdditionalSearchParams" && parent_tag == "SpectrumIdentificationProtocol")
+    {
+      current_sip_.search_parameters = findSearchParameters_(params);
+    }
+    else if (tag_ == "SpecificityRules")
+    {
+      current_specificity_rules_.consumeCVTerms(params.getCVTermList().getCVTerms());
+    }
+    else if (tag_ == "SearchModification")
+    {
+      for (const CVTerm& cv : params.cv_terms)
+      {
+        current_mod_name_ = cv.getName();
+        if (current_mod_name_ == "unknown modification")
+        {
+          // e.g. <cvParam cvRef="MS" accession="MS:1001460" name="unknown modification" value="N-Glycan"/>
+          current_mod_name_ = cv.getValue().toString();
+        }
+      }
+      if (!current_mod_name_.empty())
+      {
+        String mod;
+        String r = (current_mod_residues_ != ".") ? current_mod_residues_ : "";
+
+        if (!current_specificity_rules_.empty())
+        {
+          for (map<String, vector<CVTerm> >::const_iterator spci = current_specificity_rules_.getCVTerms().begin(); spci != current_specificity_rules_.getCVTerms().end(); ++spci)
+          {
+            if (spci->second.front().getAccession() == "MS:1001189")  // nterm
+            {
+              mod = ModificationsDB::getInstance()->getModification(current_mod_name_, r, ResidueModification::N_TERM)->getFullId();
+            }
+            else if (spci->second.front().getAccession() == "MS:1001190")  // cterm
+            {
+              mod = ModificationsDB::getInstance()->getModification(current_mod_name_, r, ResidueModification::C_TERM)->getFullId();
+            }
+            else if (spci->second.front().getAccession() == "MS:1002057")  // protein nterm
+            {
+              mod = ModificationsDB::getInstance()->getModification(current_mod_name_, r, ResidueModification::PROTEIN_N_TERM)->getFullId();
+            }
+            else if (spci->second.front().getAccession() == "MS:1002058")  // protein cterm
+            {
+              mod = ModificationsDB::getInstance()->getModification(current_mod_name_, r, ResidueModification::PROTEIN_C_TERM)->getFullId();
+            }
+          }
+        }
+        else  // anywhere
+        {
+          mod = ModificationsDB::getInstance()->getModification(current_mod_name_, r)->getFullId();
+        }
+
+        if (current_mod_fixed_)
+        {
+          current_fixed_mods_.push_back(mod);
+        }
+        else
+        {
+          current_variable_mods_.push_back(mod);
+        }
+      }
+    }
+    else if (tag_ == "ModificationParams")
+    {
+      current_sip_.search_parameters.fixed_modifications = current_fixed_mods_;
+      current_sip_.search_parameters.variable_modifications = current_variable_mods_;
+    }
+    else if (tag_ == "EnzymeName")
+    {
+      CVTermList cvs = params.getCVTermList();
+      for (map<String, vector<CVTerm> >::const_iterator it = cvs.getCVTerms().begin(); it != cvs.getCVTerms().end(); ++it)
+      {
+        if (enzyme_terms_.find(it->first) != enzyme_terms_.end())
+        {
+          current_enzyme_name_ = it->second.front().getName();
+        }
+        else
+        {
+          OPENMS_LOG_WARN << "Additional parameters for enzyme settings not readable." << endl;
+        }
+      }
+    }
+    else if (tag_ == "Enzyme")
+    {
+      if (ProteaseDB::getInstance()->hasEnzyme(current_enzyme_name_))
+      {
+        current_sip_.search_parameters.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(current_enzyme_name_));
+      }
+    }
+    else if (tag_ == "FragmentTolerance" || tag_ == "ParentTolerance")
+    {
+      const bool fragment = (tag_ == "FragmentTolerance");
+      double& tolerance = fragment ? current_fragment_tolerance_ : current_precursor_tolerance_;
+      ProteinIdentification::SearchParameters& sp = current_sip_.search_parameters;
+      CVTermList cvs = params.getCVTermList();
+      //+- take the numerically greater
+      for (map<String, vector<CVTerm> >::const_iterator it = cvs.getCVTerms().begin(); it != cvs.getCVTerms().end(); ++it)
+      {
+        tolerance = max(tolerance, it->second.front().getValue().toString().toDouble());
+        bool ppm = (it->second.front().getUnit().name == "parts per million");
+        if (fragment)
+        {
+          sp.fragment_mass_tolerance = tolerance;
+          if (ppm) sp.fragment_mass_tolerance_ppm = true;
+        }
+        else
+        {
+          sp.precursor_mass_tolerance = tolerance;
+          if (ppm) sp.precursor_mass_tolerance_ppm = true;
+        }
+      }
+    }
+    else if (tag_ == "Threshold" && parent_tag == "SpectrumIdentificationProtocol")
+    {
+      current_threshold_ = params.getCVTermList();
+    }
+    else if (tag_ == "SpectrumIdentificationProtocol")
+    {
+      for (map<String, vector<CVTerm> >::const_iterator thit = current_threshold_.getCVTerms().begin(); thit != current_threshold_.getCVTerms().end(); ++thit)
+      {
+        if (threshold_terms_.find(thit->first) != threshold_terms_.end())
+        {
+          if (thit->first != "MS:1001494") // no threshold
+          {
+            current_sip_.threshold = thit->second.front().getValue().toString().toDouble();
+            current_sip_.use_threshold = true;
+          }
+          break;
+        }
+      }
+      sp_map_.insert(make_pair(current_sip_id_, current_sip_));
+    }
+    // 5. AnalysisData
+    else if (tag_ == "SpectrumIdentificationItem")
+    {
+      handleSpectrumIdentificationItem_(params);
+    }
+    else if (tag_ == "SpectrumIdentificationResult")
+    {
+      PeptideIdentification& pep = pep_id_->back();
+      pep.setIdentifier(pro_id_->at(proteinIdentificationIndex_(current_sil_)).getIdentifier());
+      pep.sortByRank();
+
+      //adopt cv s
+      CVTermList cvs = params.getCVTermList();
+      for (map<String, vector<CVTerm> >::const_iterator cvit = cvs.getCVTerms().begin(); cvit != cvs.getCVTerms().end(); ++cvit)
+      {
+        // check for retention time or scan time entry (see MzIdentMLDOMHandler)
+        if (cvit->first == "MS:1000894" || cvit->first == "MS:1000016")
+        {
+          double rt = cvit->second.front().getValue().toString().toDouble();
+          if (cvit->second.front().getUnit().accession == "UO:0000031")  // minutes
+          {
+            rt *= 60.0;
+          }
+          pep.setRT(rt);
+        }
+        else
+        {
+          pep.setMetaValue(cvit->first, cvit->second.front().getValue());
+        }
+      }
+      //adopt up s
+      map<String, DataValue> ups = params.getUserParams();
+      for (map<String, DataValue>::const_iterator upit = ups.begin(); upit != ups.end(); ++upit)
+      {
+        pep.setMetaValue(upit->first, upit->second);
+      }
+      if (pep.getRT() != pep.getRT())
+      {
+        OPENMS_LOG_WARN << "No retention time found for 'SpectrumIdentificationResult'" << endl;
+      }
+    }
+    else if (tag_ == "MzIdentML")
+    {
+      if (spectra_data_count_ == 0)
+      {
+        fatalError(LOAD, "No SpectraData nodes");
+      }
+      if (spectrum_identifications_.empty())
+      {
+        fatalError(LOAD, "No SpectrumIdentification nodes");
+      }
+      if (sp_map_.empty())
+      {
+        fatalError(LOAD, "No SpectrumIdentificationProtocol nodes");
+      }
+      if (spectrum_identification_list_count_ == 0)
+      {
+        fatalError(LOAD, "No SpectrumIdentificationList nodes");
+      }
+      for (ProteinIdentification& pro : *pro_id_)
+      {
+        pro.sort();
+      }
+    }
+
+    open_tags_.pop_back();
+  }
+
+  CVTerm MzIdentMLSAXHandler::parseCvParam_(const xercesc::Attributes& attributes) const
+  {
+    //      <cvParam accession="MS:1001469" name="taxonomy: scientific name" cvRef="PSI-MS"  value="Drosophila melanogaster"/>
+    String accession, name, cv_ref, value, unit_acc, unit_name, unit_cv_ref;
+    optionalAttributeAsString_(accession, attributes, CONST_XMLCH("accession"));
+    optionalAttributeAsString_(name, attributes, CONST_XMLCH("name"));
+    optionalAttributeAsString_(cv_ref, attributes, CONST_XMLCH("cvRef"));
+    optionalAttributeAsString_(value, attributes, CONST_XMLCH("value"));
+    optionalAttributeAsString_(unit_acc, attributes, CONST_XMLCH("unitAccession"));
+    optionalAttributeAsString_(unit_name, attributes, CONST_XMLCH("unitName"));
+    optionalAttributeAsString_(unit_cv_ref, attributes, CONST_XMLCH("unitCvRef"));
+
+    CVTerm::Unit u;
+    if (!unit_acc.empty() && !unit_name.empty())
+    {
+      u = CVTerm::Unit(unit_acc, unit_name, unit_cv_ref);
+      if (unit_cv_ref.empty())
+      {
+        OPENMS_LOG_WARN << "This mzid file uses a cv term with units, but without "
+                        << "unit cv reference (required)! Please notify the mzid "
+                        << "producer of this file. \"" << name << "\" will be read as \""
+                        << unit_name << "\" but further actions on this unit may fail."
+                        << endl;
+      }
+    }
+    return CVTerm(accession, name, cv_ref, value, u);
+  }
+
+  pair<String, DataValue> MzIdentMLSAXHandler::parseUserParam_(const xercesc::Attributes& attributes) const
+  {
+    //      <userParam name="Mascot User Comment" value="Example Mascot MS-MS search for PSI mzIdentML"/>
+    String name, value, unit_acc, type;
+    optionalAttributeAsString_(name, attributes, CONST_XMLCH("name"));
+    optionalAttributeAsString_(value, attributes, CONST_XMLCH("value"));
+    optionalAttributeAsString_(unit_acc, attributes, CONST_XMLCH("unitAccession"));
+    optionalAttributeAsString_(type, attributes, CONST_XMLCH("type"));
+
+    DataValue dv;
+    if (type == "xsd:float" || type == "xsd:double")
+    {
+      try
+      {
+        dv = value.toDouble();
+      }
+      catch (...)
+      {
+        OPENMS_LOG_ERROR << "Found float parameter not convertible to float type." << endl;
+      }
+    }
+    else if (type == "xsd:int" || type == "xsd:unsignedInt")
+    {
+      try
+      {
+        dv = value.toInt();
+      }
+      catch (...)
+      {
+        OPENMS_LOG_ERROR << "Found integer parameter not convertible to integer type." << endl;
+      }
+    }
+    else
+    {
+      dv = value;
+    }
+
+    // Add unit *after* creating the term
+    if (!unit_acc.empty())
+    {
+      if (unit_acc.hasPrefix("UO:"))
+      {
+        dv.setUnit(unit_acc.suffix(unit_acc.size() - 3).toInt());
+        dv.setUnitType(DataValue::UnitType::UNIT_ONTOLOGY);
+      }
+      else if (unit_acc.hasPrefix("MS:"))
+      {
+        dv.setUnit(unit_acc.suffix(unit_acc.size() - 3).toInt());
+        dv.setUnitType(DataValue::UnitType::MS_ONTOLOGY);
+      }
+      else
+      {
+        OPENMS_LOG_WARN << String("Unhandled unit '") + unit_acc + "' in tag '" + name + "'." << endl;
+      }
+    }
+    return make_pair(name, dv);
+  }
+
+  AASequence MzIdentMLSAXHandler::parsePeptide_() const
+  {
+    String as = current_peptide_sequence_;
+    //1. Substitutions
+    for (const Substitution& sub : current_substitutions_)
+    {
+      char original_residue = sub.original_residue[0];
+      char replacement_residue = sub.replacement_residue[0];
+      if (!sub.location.empty())
+      {
+        as[sub.location.toInt() - 1] = replacement_residue;
+      }
+      else if (as.hasSubstring(original_residue)) //no location - every occurrence will be replaced
+      {
+        as.substitute(original_residue, replacement_residue);
+      }
+      else
+      {
+        throw std::runtime_error("ERROR : Non Text Node");
+      }
+    }
+
+    //2. Modifications
+    as.trim();
+    AASequence aas = AASequence::fromString(as);
+    ModificationsDB* mod_db = ModificationsDB::getInstance();
+    for (const Modification& modification : current_modifications_)
+    {
+      SignedSize index = -2;
+      try
+      {
+        index = static_cast<SignedSize>(modification.location.toInt());
+      }
+      catch (...)
+      {
+        OPENMS_LOG_WARN << "Found unreadable modification location." << endl;
+      }
+
+      for (const CVTerm& cv : modification.cv_terms)
+      {
+        if (cv.getAccession() == "MS:1001460") // unknown modification
+        {
+          const String cvvalue = cv.getValue();
+          if (cv.hasValue() && mod_db->has(cvvalue) && !cvvalue.empty())
+          {
+            // Case 1: unknown (to e.g., third-party tool) modification known to OpenMS (see value)
+            //  <Modification location="0" monoisotopicMassDelta="17.031558">
+            //  <cvParam cvRef="PSI-MS" accession="MS:1001460" name="unknown modification" value="Methyl:2H(2)13C"/>
+            if (index == 0)
+            {
+              aas.setNTerminalModification(cvvalue);
+            }
+            else if (index == (int)aas.size() + 1)
+            {
+              aas.setCTerminalModification(cvvalue);
+            }
+            else if (index > 0 && index <= (int)aas.size())
+            {
+              aas.setModification(index - 1, cvvalue);
+            }
+            continue;
+          }
+          else
+          {
+            // Case 2: unknown modification (needs to be added to ModificationsDB)
+            double mass_delta = 0;
+            const String& mod = modification.mass_delta;
+            try
+            {
+              mass_delta = static_cast<double>(mod.toDouble());
+            }
+            catch (...)
+            {
+              OPENMS_LOG_WARN << "Found unreadable modification location." << endl;
+              throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown modification");
+            }
+
+            // compare with String::ConstIterator AASequence::parseModSquareBrackets_
+            if (index == 0)
+            {
+              // n-terminal
+              String residue_name = ".[+" + mod + "]";
+              String residue_id = ".n[" + mod + "]";
+              if (!mod_db->has(residue_id))
+              {
+                unique_ptr<ResidueModification> new_mod(new ResidueModification);
+                new_mod->setFullId(residue_id); // setting FullId but not Id makes it a user-defined mod
+                new_mod->setFullName(residue_name); // display name
+                new_mod->setDiffMonoMass(mass_delta);
+                new_mod->setMonoMass(mass_delta + Residue::getInternalToNTerm().getMonoWeight());
+                new_mod->setTermSpecificity(ResidueModification::N_TERM);
+                mod_db->addModification(std::move(new_mod));
+              }
+              aas.setNTerminalModification(residue_id);
+              continue;
+            }
+            else if (index == (int)aas.size() + 1)
+            {
+              // c-terminal
+              String residue_name = ".[" + mod + "]";
+              String residue_id = ".c[" + mod + "]";
+              if (!mod_db->has(residue_name))
+              {
+                unique_ptr<ResidueModification> new_mod(new ResidueModification);
+                new_mod->setFullId(residue_id); // setting FullId but not Id makes it a user-defined mod
+                new_mod->setFullName(residue_name); // display name
+                new_mod->setDiffMonoMass(mass_delta);
+                new_mod->setMonoMass(mass_delta + Residue::getInternalToCTerm().getMonoWeight());
+                new_mod->setTermSpecificity(ResidueModification::C_TERM);
+                mod_db->addModification(std::move(new_mod));
+              }
+              aas.setCTerminalModification(residue_id);
+              continue;
+            }
+            else if (index > 0 && index <= (int)aas.size())
+            {
+              // internal modification
+              const Residue& residue = aas[index - 1];
+              String residue_name = residue.getOneLetterCode() + "[" + mod + "]"; // e.g. N[12345.6]
+              String modification_name = "[" + mod + "]";
+              if (!mod_db->has(residue_name))
+              {
+                unique_ptr<ResidueModification> new_mod(new ResidueModification);
+                new_mod->setFullId(residue_name); // setting FullId but not Id makes it a user-defined mod
+                new_mod->setFullName(modification_name); // display name
+                // We will set origin to make sure the same modification will be used for the same AA
+                new_mod->setOrigin(residue.getOneLetterCode()[0]);
+                new_mod->setMonoMass(mass_delta + residue.getMonoWeight());
+                new_mod->setAverageMass(mass_delta + residue.getAverageWeight());
+                new_mod->setDiffMonoMass(mass_delta);
+                mod_db->addModification(std::move(new_mod));
+              }
+              const ResidueModification* res_mod = mod_db->getModification(mod_db->findModificationIndex(residue_name));
+              aas.setModification(index - 1, res_mod->getFullId());
+              continue;
+            }
+          }
+        }
+        if (cv.getCVIdentifierRef() != "UNIMOD")
+        {
+          // e.g.  <cvParam accession="MS:1001524" name="fragment neutral loss" cvRef="PSI-MS" value="0" unitAccession="UO:0000221" unitName="dalton" unitCvRef="UO"/>
+          continue;
+        }
+
+        if (index == 0)
+        {
+          if (cv.getName() == "unknown modification")
+          {
+            aas.setNTerminalModification(cv.getValue());
+          }
+          else
+          {
+            aas.setNTerminalModification(cv.getName());
+          }
+        }
+        else if (index == static_cast<SignedSize>(aas.size() + 1))
+        {
+          aas.setCTerminalModification(cv.getName());
+        }
+        else
+        {
+          try
+          {
+            aas.setModification(index - 1, cv.getName());
+          }
+          catch (Exception::BaseException& e)
+          {
+            OPENMS_LOG_WARN << e.getName() << ": " << e.what() << " Sequence: " << aas.toUnmodifiedString() << ", residue " << aas.getResidue(index - 1).getName() << "@" << String(index) << "\n";
+          }
+        }
+      }
+    }
+    return aas;
+  }
+
+  void MzIdentMLSAXHandler::handleSpectrumIdentificationItem_(const ParamGroup& params)
+  {
+    PeptideIdentification& spectrum_identification = pep_id_->back();
+    CVTermList cvs = params.getCVTermList();
+
+    double score = 0;
+    bool scoretype = false;
+    for (map<String, vector<CVTerm> >::const_iterator scoreit = cvs.getCVTerms().begin(); scoreit != cvs.getCVTerms().end(); ++scoreit)
+    {
+      if (q_score_terms_.find(scoreit->first) != q_score_terms_.end() || scoreit->first == "MS:1002354")
+      {
+        if (scoreit->first != "MS:1002055") // do not use peptide-level q-values for now
+        {
+          score = scoreit->second.front().getValue().toString().toDouble();
+          spectrum_identification.setHigherScoreBetter(false);
+          spectrum_identification.setScoreType("q-value"); //higherIsBetter = false
+          scoretype = true;
+          break;
+        }
+      }
+      else if (specific_score_terms_.find(scoreit->first) != specific_score_terms_.end())
+      {
+        score = scoreit->second.front().getValue().toString().toDouble();
+        spectrum_identification.setHigherScoreBetter(ControlledVocabulary::CVTerm::isHigherBetterScore(cv_.getTerm(scoreit->first)));
+        spectrum_identification.setScoreType(scoreit->second.front().getName());
+        scoretype = true;
+        break;
+      }
+      else if (e_score_terms_.find(scoreit->first) != e_score_terms_.end())
+      {
+        score = scoreit->second.front().getValue().toString().toDouble();
+        spectrum_identification.setHigherScoreBetter(false);
+        spectrum_identification.setScoreType("E-value"); //higherIsBetter = false
+        scoretype = true;
+        break;
+      }
+      else if (scoreit->first == "MS:1001143")
+      {
+        spectrum_identification.setScoreType("PSM-level search engine specific statistic");
+        // TODO this is just an assumption for unknown scores
+        spectrum_identification.setHigherScoreBetter(true);
+        scoretype = true;
+      }
+    }
+    if (!scoretype) // (no q/E/raw score: no hit will be read, as in MzIdentMLDOMHandler)
+    {
+      return;
+    }
+
+    //build the PeptideHit from a SpectrumIdentificationItem
+    const Size peptide = peptideIndex_(current_sii_peptide_ref_);
+    PeptideHit hit(score, current_sii_rank_, current_sii_charge_, peptides_[peptide]);
+    for (map<String, vector<CVTerm> >::const_iterator cvit = cvs.getCVTerms().begin(); cvit != cvs.getCVTerms().end(); ++cvit)
+    {
+      for (const CVTerm& cv : cvit->second)
+      {
+        if (cvit->first == "MS:1002540")
+        {
+          hit.setMetaValue(cvit->first, cv.getValue().toString());
+        }
+        else if (cvit->first == "MS:1001143") // this is the CV term "PSM-level search engine specific statistic" and it doesn't have a value
+        {
+          continue;
+        }
+        else
+        {
+          hit.setMetaValue(cvit->first, cv.getValue().toString().toDouble());
+        }
+      }
+    }
+    map<String, DataValue> ups = params.getUserParams();
+    for (map<String, DataValue>::const_iterator up = ups.begin(); up != ups.end(); ++up)
+    {
+      hit.setMetaValue(up->first, up->second);
+    }
+    hit.setMetaValue("calcMZ", current_sii_calculated_mz_);
+    spectrum_identification.setMZ(current_sii_experimental_mz_);
+    hit.setMetaValue("pass_threshold", current_sii_pass_);
+
+    //connect the PeptideHit with PeptideEvidences (for AABefore/After) and subsequently with DBSequence (for ProteinAccession)
+    const Size pro_index = proteinIdentificationIndex_(current_sil_);
+    ProteinIdentification& protein_identification = pro_id_->at(pro_index);
+    pair<unordered_map<Size, unordered_set<String> >::iterator, bool> accessions = pro_accessions_.emplace(pro_index, unordered_set<String>());
+    if (accessions.second)
+    {
+      for (const ProteinHit& protein_hit : protein_identification.getHits())
+      {
+        accessions.first->second.insert(protein_hit.getAccession());
+      }
+    }
+    for (const PeptideEvidence& pv : peptide_evidences_[peptide])
+    {
+      OpenMS::PeptideEvidence pev;
+      if (pv.pre != '-') pev.setAABefore(pv.pre);
+      if (pv.post != '-') pev.setAAAfter(pv.post);
+
+      if (pv.start != OpenMS::PeptideEvidence::UNKNOWN_POSITION && pv.stop != OpenMS::PeptideEvidence::UNKNOWN_POSITION)
+      {
+        hit.setMetaValue("start", pv.start);
+        hit.setMetaValue("end", pv.stop);
+        pev.setStart(pv.start);
+        pev.setEnd(pv.stop);
+      }
+
+      const String own_target_decoy = pv.idec ? "decoy" : "target";
+      if (hit.metaValueExists(Constants::UserParam::TARGET_DECOY) && hit.getMetaValue(Constants::UserParam::TARGET_DECOY).toString() != own_target_decoy)
+      {
+        hit.setMetaValue(Constants::UserParam::TARGET_DECOY, "target+decoy");
+      }
+      else
+      {
+        hit.setMetaValue(Constants::UserParam::TARGET_DECOY, own_target_decoy);
+      }
+
+      const DBSequence& db = db_sequences_[pv.db_sequence];
+      pev.setProteinAccession(db.accession);
+      if (accessions.first->second.insert(db.accession).second)
+      {
+        protein_identification.insertHit(ProteinHit());
+        protein_identification.getHits().back().setSequence(db.sequence);
+        protein_identification.getHits().back().setAccession(db.accession);
+        protein_identification.getHits().back().setMetaValue("isDecoy", pv.idec ? "true" : "false");
+      }
+      hit.addPeptideEvidence(pev);
+    }
+    spectrum_identification.insertHit(hit);
+  }
+
+  void MzIdentMLSAXHandler::createProteinIdentifications_()
+  {
+    pro_ids_created_ = true;
+    for (const SpectrumIdentification& si : spectrum_identifications_)
+    {
+      pro_id_->push_back(ProteinIdentification());
+      ProteinIdentification& pro = pro_id_->back();
+
+      ProteinIdentification::SearchParameters sp;
+      map<String, SpectrumIdentificationProtocol>::const_iterator sip = sp_map_.find(si.spectrum_identification_protocol_ref);
+      if (sip != sp_map_.end())
+      {
+        const AnalysisSoftware& software = as_map_[sip->second.analysis_software_ref];
+        pro.setSearchEngine(software.name);
+        pro.setSearchEngineVersion(software.version);
+        sp = sip->second.search_parameters;
+        if (sip->second.use_threshold)
+        {
+          pro.setSignificanceThreshold(sip->second.threshold);
+        }
+      }
+      const DatabaseInput& db = db_map_[si.search_database_ref];
+      sp.db = db.location;
+      sp.db_version = db.version;
+      pro.setSearchParameters(sp);
+
+      // internally we store a list of files so convert the mzIdentML file String to a StringList
+      StringList spectra_data_list;
+      spectra_data_list.push_back(sd_map_[si.spectra_data_ref]);
+      pro.setMetaValue("spectra_data", spectra_data_list);
+      if (!si.activity_date.empty())
+      {
+        pro.setDateTime(DateTime::fromString(si.activity_date));
+      }
+      else
+      {
+        pro.setDateTime(DateTime::now());
+      }
+      pro.setIdentifier(UniqueIdGenerator::getUniqueId());
+      si_pro_map_.emplace(si.spectrum_identification_list_ref, pro_id_->size() - 1);
+    }
+  }
+
+  Size MzIdentMLSAXHandler::peptideIndex_(const String& id)
+  {
+    pair<unordered_map<String, Size>::iterator, bool> it = peptide_index_.emplace(id, peptides_.size());
+    if (it.second)
+    {
+      peptides_.emplace_back();
+      peptide_evidences_.emplace_back();
+    }
+    return it.first->second;
+  }
+
+  Size MzIdentMLSAXHandler::dbSequenceIndex_(const String& id)
+  {
+    pair<unordered_map<String, Size>::iterator, bool> it = db_sequence_index_.emplace(id, db_sequences_.size());
+    if (it.second)
+    {
+      db_sequences_.emplace_back();
+    }
+    return it.first->second;
+  }
+
+  Size MzIdentMLSAXHandler::proteinIdentificationIndex_(const String& sil) const
+  {
+    unordered_map<String, Size>::const_iterator it = si_pro_map_.find(sil);
+    return it != si_pro_map_.end() ? it->second : 0;
+  }
+
+  ProteinIdentification::SearchParameters MzIdentMLSAXHandler::findSearchParameters_(const ParamGroup& as_params)
+  {
+    ProteinIdentification::SearchParameters sp;
+    for (const CVTerm& cv : as_params.cv_terms)
+    {
+      sp.setMetaValue(cv.getAccession(), cv.getValue());
+    }
+    int min_charge = 0;
+    int max_charge = 0;
+    map<String, DataValue> ups = as_params.getUserParams();
+    for (map<String, DataValue>::const_iterator upit = ups.begin(); upit != ups.end(); ++upit)
+    {
+      if (upit->first == "taxonomy")
+      {
+        sp.taxonomy = upit->second.toString();
+      }
+      else if (upit->first == "charges")
+      {
+        sp.charges = upit->second.toString();
+      }
+      else if (upit->first == "MinCharge")
+      {
+        min_charge = upit->second.toString().toInt();
+      }
+      else if (upit->first == "MaxCharge")
+      {
+        max_charge = upit->second.toString().toInt();
+      }
+      else if (upit->first == "NumTolerableTermini")
+      {
+        sp.enzyme_term_specificity = static_cast<EnzymaticDigestion::Specificity>(upit->second.toString().toInt());
+      }
+      else
+      {
+        sp.setMetaValue(upit->first, upit->second);
+      }
+    }
+    if (min_charge != 0 || max_charge != 0) // this means "MinCharge" and "MaxCharge" get preference over "charges"
+    {
+      sp.charges = String(min_charge) + "-" + String(max_charge);
+    }
+    return sp;
+  }
+
+} // namespace OpenMS::Internal
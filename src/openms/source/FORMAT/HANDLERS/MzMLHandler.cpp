@@ -43,9 +43,16 @@
 #include <OpenMS/FORMAT/VALIDATORS/MzMLValidator.h>
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/TaskPool.h>
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS::Internal
 {
 
@@ -82,6 +89,9 @@ namespace OpenMS::Internal
     /// Destructor
     MzMLHandler::~MzMLHandler()
     {
+      // wait for decoding tasks still working on the handler (e.g. after a parse error)
+      pending_spectra_.clear();
+      pending_chromatograms_.clear();
     }
     /// Set the peak file options
     void MzMLHandler::setOptions(const PeakFileOptions& opt)
@@ -133,145 +143,258 @@ namespace OpenMS::Internal
       consumer_ = consumer;
     }
 
+    namespace
+    {
+      /// Number of work stacks which may be decoded concurrently in pipelined mode
+      Size maxPendingStacks()
+      {
+        return TaskPool::getThreadBudget();
+      }
+    }
+
     void MzMLHandler::populateSpectraWithData_()
     {
+      if (options_.getPipelinedDecoding())
+      {
+        if (!spectrum_data_.empty())
+        {
+          // hand the current stack to the task pool and continue parsing
+          pending_spectra_.emplace_back();
+          std::vector<SpectrumData>* stack = &pending_spectra_.back().data;
+          stack->swap(spectrum_data_);
+          spectrum_data_.reserve(options_.getMaxDataPoolSize());
+          pending_spectra_.back().decoded = TaskPool::getInstance().submit([this, stack]() { decodeSpectra_(*stack, false); });
+        }
+        appendPendingSpectra_(maxPendingStacks());
+        return;
+      }
+
+      decodeSpectra_(spectrum_data_, true);
+      appendSpectra_(spectrum_data_);
+
+      // Delete batch
+      spectrum_data_.clear();
+    }
+
+    void MzMLHandler::populateChromatogramsWithData_()
+    {
+      if (options_.getPipelinedDecoding())
+      {
+        if (!chromatogram_data_.empty())
+        {
+          // hand the current stack to the task pool and continue parsing
+          pending_chromatograms_.emplace_back();
+          std::vector<ChromatogramData>* stack = &pending_chromatograms_.back().data;
+          stack->swap(chromatogram_data_);
+          chromatogram_data_.reserve(options_.getMaxDataPoolSize());
+          pending_chromatograms_.back().decoded = TaskPool::getInstance().submit([this, stack]() { decodeChromatograms_(*stack, false); });
+        }
+        appendPendingChromatograms_(maxPendingStacks());
+        return;
+      }
+
+      decodeChromatograms_(chromatogram_data_, true);
+      appendChromatograms_(chromatogram_data_);
+
+      // Delete batch
+      chromatogram_data_.clear();
+    }
 
+    void MzMLHandler::appendPendingSpectra_(Size max_pending)
+    {
+      // deque elements are not moved by push_back/pop_front, i.e. the stacks stay valid for the threads working on them
+      while (!pending_spectra_.empty() &&
+             (pending_spectra_.size() > max_pending ||
+              pending_spectra_.front().decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+      {
+        pending_spectra_.front().decoded.get(); // re-throws errors from decoding
+        appendSpectra_(pending_spectra_.front().data);
+        pending_spectra_.pop_front();
+      }
+    }
+
+    void MzMLHandler::appendPendingChromatograms_(Size max_pending)
+    {
+      while (!pending_chromatograms_.empty() &&
+             (pending_chromatograms_.size() > max_pending ||
+              pending_chromatograms_.front().decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+      {
+        pending_chromatograms_.front().decoded.get(); // re-throws errors from decoding
+        appendChromatograms_(pending_chromatograms_.front().data);
+        pending_chromatograms_.pop_front();
+      }
+    }
+
+    void MzMLHandler::decodeSpectra_(std::vector<SpectrumData>& spectrum_data, bool parallel)
+    {
       // Whether spectrum should be populated with data
-      if (options_.getFillData())
+      if (!options_.getFillData())
       {
-        size_t errCount = 0;
-        String error_message;
+        return;
+      }
+
+      size_t errCount = 0;
+      String error_message;
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for if (parallel)
 #endif
-        for (SignedSize i = 0; i < (SignedSize)spectrum_data_.size(); i++)
+      for (SignedSize i = 0; i < (SignedSize)spectrum_data.size(); i++)
+      {
+        // parallel exception catching and re-throwing business
+        if (!errCount) // no need to parse further if already an error was encountered
         {
-          // parallel exception catching and re-throwing business
-          if (!errCount) // no need to parse further if already an error was encountered
+          try
           {
-            try
+            populateSpectraWithData_(spectrum_data[i].data,
+                                     spectrum_data[i].default_array_length,
+                                     options_,
+                                     spectrum_data[i].spectrum);
+            if (options_.getSortSpectraByMZ() && !spectrum_data[i].spectrum.isSorted())
             {
-              populateSpectraWithData_(spectrum_data_[i].data,
-                                       spectrum_data_[i].default_array_length,
-                                       options_,
-                                       spectrum_data_[i].spectrum);
-              if (options_.getSortSpectraByMZ() && !spectrum_data_[i].spectrum.isSorted())
-              {
-                spectrum_data_[i].spectrum.sortByPosition();
-              }
+              spectrum_data[i].spectrum.sortByPosition();
             }
+          }
 
-            catch (OpenMS::Exception::BaseException& e)
-            {
+          catch (OpenMS::Exception::BaseException& e)
+          {
 #pragma omp critical(MZMLErrorHandling)
-              {
-                ++errCount;
-                error_message = e.what();
-              }
-            }
-            catch (...)
             {
-#pragma omp atomic
               ++errCount;
+              error_message = e.what();
             }
           }
+          catch (...)
+          {
+#pragma omp atomic
+            ++errCount;
+          }
         }
-        if (errCount != 0)
-        {
-          std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
-          std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
-          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
-        }
       }
+      if (errCount != 0)
+      {
+        std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
+        std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+      }
+#ifndef _OPENMP
+      (void)parallel;
+#endif
+    }
 
+    void MzMLHandler::appendSpectra_(std::vector<SpectrumData>& spectrum_data)
+    {
       // Append all spectra to experiment / consumer
-      for (Size i = 0; i < spectrum_data_.size(); i++)
+      for (Size i = 0; i < spectrum_data.size(); i++)
       {
         if (consumer_ != nullptr)
         {
-          consumer_->consumeSpectrum(spectrum_data_[i].spectrum);
+          consumer_->consumeSpectrum(spectrum_data[i].spectrum);
           if (options_.getAlwaysAppendData())
           {
-            exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
+            exp_->addSpectrum(std::move(spectrum_data[i].spectrum));
           }
         }
         else
         {
-          exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
+          exp_->addSpectrum(std::move(spectrum_data[i].spectrum));
         }
+        recycleBinaryData_(spectrum_data[i].data);
       }
-
-      // Delete batch
-      spectrum_data_.clear();
     }
 
-    void MzMLHandler::populateChromatogramsWithData_()
+    void MzMLHandler::decodeChromatograms_(std::vector<ChromatogramData>& chromatogram_data, bool parallel)
     {
       // Whether chromatogram should be populated with data
-      if (options_.getFillData())
+      if (!options_.getFillData())
       {
-        size_t errCount = 0;
-        String error_message;
+        return;
+      }
+
+      size_t errCount = 0;
+      String error_message;
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for if (parallel)
 #endif
-        for (SignedSize i = 0; i < (SignedSize)chromatogram_data_.size(); i++)
+      for (SignedSize i = 0; i < (SignedSize)chromatogram_data.size(); i++)
+      {
+        // parallel exception catching and re-throwing business
+        try
         {
-          // parallel exception catching and re-throwing business
-          try
+          populateChromatogramsWithData_(chromatogram_data[i].data,
+                                         chromatogram_data[i].default_array_length,
+                                         options_,
+                                         chromatogram_data[i].chromatogram);
+          if (options_.getSortChromatogramsByRT() && !chromatogram_data[i].chromatogram.isSorted())
           {
-            populateChromatogramsWithData_(chromatogram_data_[i].data,
-                                           chromatogram_data_[i].default_array_length,
-                                           options_,
-                                           chromatogram_data_[i].chromatogram);
-            if (options_.getSortChromatogramsByRT() && !chromatogram_data_[i].chromatogram.isSorted())
-            {
-              chromatogram_data_[i].chromatogram.sortByPosition();
-            }
+            chromatogram_data[i].chromatogram.sortByPosition();
           }
-          catch (OpenMS::Exception::BaseException& e)
-          {
+        }
+        catch (OpenMS::Exception::BaseException& e)
+        {
 #pragma omp critical
-            {
-              ++errCount;
-              error_message = e.what();
-            }
-          }
-          catch (...)
           {
-#pragma omp atomic
             ++errCount;
+            error_message = e.what();
           }
         }
-        if (errCount != 0)
+        catch (...)
         {
-          // throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data.");
-          std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
-          std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
-          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+#pragma omp atomic
+          ++errCount;
         }
-
       }
+      if (errCount != 0)
+      {
+        // throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data.");
+        std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
+        std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+      }
+#ifndef _OPENMP
+      (void)parallel;
+#endif
+    }
 
+    void MzMLHandler::appendChromatograms_(std::vector<ChromatogramData>& chromatogram_data)
+    {
       // Append all chromatograms to experiment / consumer
-      for (Size i = 0; i < chromatogram_data_.size(); i++)
+      for (Size i = 0; i < chromatogram_data.size(); i++)
       {
         if (consumer_ != nullptr)
         {
-          consumer_->consumeChromatogram(chromatogram_data_[i].chromatogram);
+          consumer_->consumeChromatogram(chromatogram_data[i].chromatogram);
           if (options_.getAlwaysAppendData())
           {
-            exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+            exp_->addChromatogram(std::move(chromatogram_data[i].chromatogram));
           }
         }
         else
         {
-          exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+          exp_->addChromatogram(std::move(chromatogram_data[i].chromatogram));
         }
+        recycleBinaryData_(chromatogram_data[i].data);
       }
+    }
 
-      // Delete batch
-      chromatogram_data_.clear();
+    MzMLHandler::BinaryData MzMLHandler::nextBinaryData_()
+    {
+      if (binary_data_pool_.empty())
+      {
+        return BinaryData();
+      }
+      BinaryData data = std::move(binary_data_pool_.back());
+      binary_data_pool_.pop_back();
+      return data;
+    }
+
+    void MzMLHandler::recycleBinaryData_(std::vector<BinaryData>& data)
+    {
+      for (BinaryData& d : data)
+      {
+        d.clear();
+        binary_data_pool_.push_back(std::move(d));
+      }
+      data.clear();
     }
 
     void MzMLHandler::addSpectrumMetaData_(const std::vector<MzMLHandlerHelper::BinaryData>& input_data,
@@ -865,7 +988,7 @@ namespace OpenMS::Internal
       }
       else if (tag == "binaryDataArray" /* && in_spectrum_list_*/)
       {
-        bin_data_.push_back(BinaryData());
+        bin_data_.push_back(nextBinaryData_());
         bin_data_.back().np_compression = MSNumpressCoder::NONE; // ensure that numpress compression is initially set to none ...
         bin_data_.back().compression = false; // ensure that zlib compression is initially set to none ...
 
@@ -1281,7 +1404,7 @@ namespace OpenMS::Internal
 
         rt_set_ = false;
         logger_.nextProgress();
-        bin_data_.clear();
+        recycleBinaryData_(bin_data_); // skipped or without data
         default_array_length_ = 0;
       }
       else if (equal_(qname, s_chromatogram))
@@ -1318,7 +1441,7 @@ namespace OpenMS::Internal
         }
 
         logger_.nextProgress();
-        bin_data_.clear();
+        recycleBinaryData_(bin_data_); // skipped or without data
         default_array_length_ = 0;
       }
       else if (equal_(qname, s_spectrum_list))
@@ -1355,9 +1478,11 @@ namespace OpenMS::Internal
         instruments_.clear();
         processing_.clear();
 
-        // Flush the remaining data
+        // Flush the remaining data (and wait for data still decoded in the background)
         populateSpectraWithData_();
         populateChromatogramsWithData_();
+        appendPendingSpectra_(0);
+        appendPendingChromatograms_(0);
       }
     }
 
@@ -4095,14 +4220,17 @@ namespace OpenMS::Internal
           warning(STORE, String("Invalid native IDs detected. Using spectrum identifier nativeID format (spectrum=xsd:nonNegativeInteger) for all spectra."));
         }
 
-        // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        // write actual data (the binary encoding of the spectra is done in parallel)
+        std::vector<const SpectrumType*> spectra;
+        spectra.reserve(exp.size());
+        for (const SpectrumType& spec : exp)
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
-          ++stored_spectra;
+          spectra.push_back(&spec);
         }
+        writeSpectraParallel_(os, spectra, 0, validator, renew_native_ids, dps,
+                              [&](Size written) { logger_.setProgress(progress + written); });
+        progress += exp.size();
+        stored_spectra += exp.size();
         os << "\t\t</spectrumList>\n";
       }
 
@@ -4116,13 +4244,16 @@ namespace OpenMS::Internal
         // meta information needs to be stored here but the actual data is
         // stored somewhere else).
         os << "\t\t<chromatogramList count=\"" << exp.getChromatograms().size() << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
-        for (Size c_idx = 0; c_idx != exp.getChromatograms().size(); ++c_idx)
+        std::vector<const ChromatogramType*> chromatograms;
+        chromatograms.reserve(exp.getChromatograms().size());
+        for (const ChromatogramType& chromatogram : exp.getChromatograms())
         {
-          logger_.setProgress(progress++);
-          const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
-          writeChromatogram_(os, chromatogram, c_idx, validator);
-          ++stored_chromatograms;
+          chromatograms.push_back(&chromatogram);
         }
+        writeChromatogramsParallel_(os, chromatograms, 0, validator,
+                                    [&](Size written) { logger_.setProgress(progress + written); });
+        progress += exp.getChromatograms().size();
+        stored_chromatograms += exp.getChromatograms().size();
         os << "\t\t</chromatogramList>" << "\n";
       }
 
@@ -5077,7 +5208,8 @@ namespace OpenMS::Internal
                                      Size s,
                                      const Internal::MzMLValidator& validator,
                                      bool renew_native_ids,
-                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                                     bool record_offset)
     {
       //native id
       String native_id = spec.getNativeID();
@@ -5086,8 +5218,11 @@ namespace OpenMS::Internal
         native_id = String("spectrum=") + s;
       }
 
-      Int64 offset = os.tellp();
-      spectra_offsets_.push_back(make_pair(native_id, offset + 3));
+      if (record_offset)
+      {
+        Int64 offset = os.tellp();
+        spectra_offsets_.push_back(make_pair(native_id, offset + 3));
+      }
 
       // IMPORTANT make sure the offset (above) corresponds to the start of the <spectrum tag
       os << "\t\t\t<spectrum id=\"" << writeXMLEscape(native_id) << "\" index=\"" << s << "\" defaultArrayLength=\"" << spec.size() << "\"";
@@ -5661,13 +5796,54 @@ namespace OpenMS::Internal
                                                              bool is32bit,
                                                              String array_type);
 
+    void MzMLHandler::writeSpectraParallel_(std::ostream& os,
+                                            const std::vector<const SpectrumType*>& spectra,
+                                            Size first_idx,
+                                            const Internal::MzMLValidator& validator,
+                                            bool renew_native_ids,
+                                            std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                                            const std::function<void(Size)>& progress)
+    {
+      std::vector<Int64> offsets;
+      // spectra can be large once encoded, keep only a few per thread in memory
+      writeElementsParallel_(os, spectra.size(),
+        [&](std::ostream& out, Size i) { writeSpectrum_(out, *spectra[i], first_idx + i, validator, renew_native_ids, dps, false); },
+        progress, &offsets, 8);
+      for (Size i = 0; i < spectra.size(); ++i)
+      {
+        const String native_id = renew_native_ids ? String("spectrum=") + (first_idx + i) : spectra[i]->getNativeID();
+        // IMPORTANT the offset has to point to the start of the <spectrum tag (after the indentation)
+        spectra_offsets_.push_back(make_pair(native_id, offsets[i] + 3));
+      }
+    }
+
+    void MzMLHandler::writeChromatogramsParallel_(std::ostream& os,
+                                                  const std::vector<const ChromatogramType*>& chromatograms,
+                                                  Size first_idx,
+                                                  const Internal::MzMLValidator& validator,
+                                                  const std::function<void(Size)>& progress)
+    {
+      std::vector<Int64> offsets;
+      writeElementsParallel_(os, chromatograms.size(),
+        [&](std::ostream& out, Size i) { writeChromatogram_(out, *chromatograms[i], first_idx + i, validator, false); },
+        progress, &offsets, 8);
+      for (Size i = 0; i < chromatograms.size(); ++i)
+      {
+        chromatograms_offsets_.emplace_back(chromatograms[i]->getNativeID(), offsets[i] + 3);
+      }
+    }
+
     void MzMLHandler::writeChromatogram_(std::ostream& os,
                                          const ChromatogramType& chromatogram,
                                          Size c,
-                                         const Internal::MzMLValidator& validator)
+                                         const Internal::MzMLValidator& validator,
+                                         bool record_offset)
     {
-      Int64 offset = os.tellp();
-      chromatograms_offsets_.emplace_back(chromatogram.getNativeID(), offset + 3);
+      if (record_offset)
+      {
+        Int64 offset = os.tellp();
+        chromatograms_offsets_.emplace_back(chromatogram.getNativeID(), offset + 3);
+      }
 
       // TODO native id with chromatogram=?? prefix?
       // IMPORTANT make sure the offset (above) corresponds to the start of the <chromatogram tag
@@ -546,7 +546,7 @@ namespace OpenMS
     }
   }
 
-  std::string MzMLSpectrumDecoder::domParseString_(const std::string& in, std::vector<BinaryData>& data)
+  std::string MzMLSpectrumDecoder::domParseString_(std::string_view in, std::vector<BinaryData>& data)
   {
     // PRECONDITON is below (since we first need to do XML parsing before validating)
     // initializer list of XMLCh (= usually some type that fits utf16) from ASCII chars
@@ -557,7 +557,7 @@ namespace OpenMS
     //-------------------------------------------------------------
     // Create parser from input string using MemBufInputSource
     //-------------------------------------------------------------
-    xercesc::MemBufInputSource myxml_buf(reinterpret_cast<const unsigned char*>(in.c_str()), in.length(), "myxml (in memory)");
+    xercesc::MemBufInputSource myxml_buf(reinterpret_cast<const unsigned char*>(in.data()), in.length(), "myxml (in memory)");
     xercesc::XercesDOMParser* parser = new xercesc::XercesDOMParser();
     parser->setDoNamespaces(false);
     parser->setDoSchema(false);
@@ -576,7 +576,7 @@ namespace OpenMS
     if (!elementRoot)
     {
       delete parser;
-      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, in, "No root element");
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, std::string(in), "No root element");
     }
 
     OPENMS_PRECONDITION(xercesc::XMLString::equals(elementRoot->getTagName(), CONST_XMLCH("spectrum")) || xercesc::XMLString::equals(elementRoot->getTagName(), CONST_XMLCH("chromatogram")),
@@ -589,7 +589,7 @@ namespace OpenMS
     {
       delete parser;
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          in, "Root element does not contain defaultArrayLength XML tag.");
+          std::string(in), "Root element does not contain defaultArrayLength XML tag.");
     }
     int default_array_length = xercesc::XMLString::parseInt(elementRoot->getAttribute(default_array_length_tag));
     OpenMS::Internal::StringManager sm;
@@ -616,14 +616,14 @@ namespace OpenMS
     return id;
   }
 
-  void MzMLSpectrumDecoder::domParseSpectrum(const std::string& in, OpenMS::Interfaces::SpectrumPtr& sptr)
+  void MzMLSpectrumDecoder::domParseSpectrum(std::string_view in, OpenMS::Interfaces::SpectrumPtr& sptr)
   {
     std::vector<BinaryData> data;
     domParseString_(in, data);
     sptr = decodeBinaryDataSpectrum_(data);
   }
 
-  void MzMLSpectrumDecoder::domParseSpectrum(const std::string& in, MSSpectrum& s)
+  void MzMLSpectrumDecoder::domParseSpectrum(std::string_view in, MSSpectrum& s)
   {
     std::vector<BinaryData> data;
     std::string id = domParseString_(in, data);
@@ -631,7 +631,7 @@ namespace OpenMS
     s.setNativeID(id);
   }
 
-  void MzMLSpectrumDecoder::domParseChromatogram(const std::string& in, MSChromatogram& c)
+  void MzMLSpectrumDecoder::domParseChromatogram(std::string_view in, MSChromatogram& c)
   {
     std::vector<BinaryData> data;
     std::string id = domParseString_(in, data);
@@ -639,7 +639,7 @@ namespace OpenMS
     c.setNativeID(id);
   }
 
-  void MzMLSpectrumDecoder::domParseChromatogram(const std::string& in, OpenMS::Interfaces::ChromatogramPtr& sptr)
+  void MzMLSpectrumDecoder::domParseChromatogram(std::string_view in, OpenMS::Interfaces::ChromatogramPtr& sptr)
   {
     std::vector<BinaryData> data;
     domParseString_(in, data);
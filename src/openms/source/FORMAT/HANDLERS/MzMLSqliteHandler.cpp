@@ -35,11 +35,13 @@
 #include <OpenMS/FORMAT/HANDLERS/MzMLSqliteHandler.h>
 
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/RAIICleanup.h>
 #include <OpenMS/FORMAT/Base64.h>
 #include <OpenMS/FORMAT/MSNumpressCoder.h>
 #include <OpenMS/FORMAT/MzMLFile.h> // for writing to stringstream
 #include <OpenMS/FORMAT/SqliteConnector.h>
 #include <OpenMS/FORMAT/ZlibCompression.h>
+#include <OpenMS/SYSTEM/TaskPool.h>
 
 #include <QtCore/QFileInfo>
 
@@ -53,12 +55,145 @@
 #endif
 
 #include <cmath>
+#include <future>
 
 namespace OpenMS::Internal
 {
 
     namespace Sql = Internal::SqliteHelper;
 
+    namespace
+    {
+      /**
+        @brief A prepared statement which is executed repeatedly with different bound values
+
+        Preparing the statement once and re-using it for every row avoids
+        parsing SQL for each insert and removes the need to escape values.
+      */
+      class PreparedInsert
+      {
+      public:
+        PreparedInsert(sqlite3* db, const String& statement) :
+          db_(db)
+        {
+          SqliteConnector::prepareStatement(db_, &stmt_, statement);
+        }
+
+        ~PreparedInsert()
+        {
+          sqlite3_finalize(stmt_);
+        }
+
+        PreparedInsert(const PreparedInsert&) = delete;
+        PreparedInsert& operator=(const PreparedInsert&) = delete;
+
+        void bindInt(int pos, Int64 value)
+        {
+          check_(sqlite3_bind_int64(stmt_, pos, value));
+        }
+
+        void bindDouble(int pos, double value)
+        {
+          check_(sqlite3_bind_double(stmt_, pos, value));
+        }
+
+        /// binds text, @p value needs to stay valid until execute() is called
+        void bindText(int pos, const String& value)
+        {
+          check_(sqlite3_bind_text(stmt_, pos, value.c_str(), (int)value.size(), SQLITE_STATIC));
+        }
+
+        /// binds a blob, @p value needs to stay valid until execute() is called
+        void bindBlob(int pos, const String& value)
+        {
+          check_(sqlite3_bind_blob(stmt_, pos, value.c_str(), (int)value.size(), SQLITE_STATIC));
+        }
+
+        void bindNull(int pos)
+        {
+          check_(sqlite3_bind_null(stmt_, pos));
+        }
+
+        /// inserts a single row and resets the statement for the next row
+        void execute()
+        {
+          int rc = sqlite3_step(stmt_);
+          sqlite3_reset(stmt_);
+          sqlite3_clear_bindings(stmt_);
+          if (rc != SQLITE_DONE)
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sqlite3_errmsg(db_));
+          }
+        }
+
+      private:
+        void check_(int rc)
+        {
+          if (rc != SQLITE_OK)
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sqlite3_errmsg(db_));
+          }
+        }
+
+        sqlite3* db_;
+        sqlite3_stmt* stmt_ = nullptr;
+      };
+
+      /// Encoded (binary) data of a single spectrum or chromatogram
+      struct EncodedArrays
+      {
+        String first; ///< m/z or retention time
+        String second; ///< intensity
+      };
+
+      /**
+        @brief Encodes and inserts @p n items in chunks of @p chunk_size
+
+        The items of one chunk are encoded in parallel by @p encode (called as
+        encode(begin, end, buffer)) while the previous chunk is inserted into
+        the database in a TaskPool worker by @p insert (called as
+        insert(begin, end, buffer)). Only a single thread accesses the database
+        at any time and at most two chunks are held in memory.
+      */
+      template <typename EncodeFunc, typename InsertFunc>
+      void encodeAndInsert(Size n, Size chunk_size, EncodeFunc encode, InsertFunc insert)
+      {
+        std::vector<EncodedArrays> buffers[2];
+        std::future<void> writer;
+        // the writer uses the buffers, wait for it before they are destroyed (also if encoding throws)
+        RAIICleanup wait_for_writer([&writer]() { if (writer.valid()) writer.wait(); });
+        Size chunk = 0;
+        for (Size begin = 0; begin < n; begin += chunk_size, ++chunk)
+        {
+          const Size end = std::min(n, begin + chunk_size);
+          // the writer for this buffer has finished before the previous chunk started
+          std::vector<EncodedArrays>& buffer = buffers[chunk % 2];
+          buffer.resize(end - begin);
+          encode(begin, end, buffer);
+
+          if (writer.valid()) writer.get();
+          writer = TaskPool::getInstance().submit([&insert, begin, end, &buffer]() { insert(begin, end, buffer); });
+        }
+        if (writer.valid()) writer.get();
+      }
+
+      /// Encodes @p data_to_encode with zlib (and numpress if @p npconfig is given) into @p result
+      void encodeArray(std::vector<double>& data_to_encode, const MSNumpressCoder::NumpressConfig* npconfig, String& result)
+      {
+        if (npconfig != nullptr)
+        {
+          String uncompressed_str;
+          MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, *npconfig);
+          OpenMS::ZlibCompression::compressString(uncompressed_str, result);
+        }
+        else
+        {
+          std::string str_data = std::string((const char*) (data_to_encode.data()), data_to_encode.size() * sizeof(double));
+          OpenMS::ZlibCompression::compressString(str_data, result);
+        }
+      }
+    }
+
     /*
      * @brief Helper function to concatenate integers with ","
      *
@@ -257,7 +392,11 @@ namespace OpenMS::Internal
       run_id_(Internal::SqliteHelper::clearSignBit(run_id)),
       use_lossy_compression_(true),
       linear_abs_mass_acc_(0.0001), // set the desired mass accuracy = 1ppm at 100 m/z
-      write_full_meta_(true)
+      write_full_meta_(true),
+      sql_batch_size_(500),
+      use_wal_(false),
+      page_size_(0),
+      cache_size_kb_(0)
     {
     }
 
@@ -479,6 +618,56 @@ namespace OpenMS::Internal
       return result;
     }
 
+    std::vector<int> MzMLSqliteHandler::getSpectraIndices(double rt_min, double rt_max, int ms_level,
+                                                          double precursor_mz_min, double precursor_mz_max) const
+    {
+      SqliteConnector conn(filename_);
+
+      // the selection is done by the database using the indices on
+      // SPECTRUM(MSLEVEL, RETENTION_TIME) and PRECURSOR(ISOLATION_TARGET)
+      const bool select_rt = rt_min <= rt_max;
+      const bool select_ms_level = ms_level > 0;
+      const bool select_precursor = precursor_mz_min <= precursor_mz_max;
+
+      String select_sql = "SELECT SPECTRUM.ID FROM SPECTRUM ";
+      if (select_precursor)
+      {
+        select_sql += "INNER JOIN PRECURSOR ON PRECURSOR.SPECTRUM_ID = SPECTRUM.ID ";
+      }
+      select_sql += "WHERE 1 ";
+      if (select_rt) select_sql += "AND SPECTRUM.RETENTION_TIME BETWEEN ?1 AND ?2 ";
+      if (select_ms_level) select_sql += "AND SPECTRUM.MSLEVEL = ?3 ";
+      if (select_precursor) select_sql += "AND PRECURSOR.ISOLATION_TARGET BETWEEN ?4 AND ?5 ";
+      select_sql += "ORDER BY SPECTRUM.RETENTION_TIME, SPECTRUM.ID;";
+
+      sqlite3_stmt* stmt;
+      conn.prepareStatement(&stmt, select_sql);
+      if (select_rt)
+      {
+        sqlite3_bind_double(stmt, 1, rt_min);
+        sqlite3_bind_double(stmt, 2, rt_max);
+      }
+      if (select_ms_level)
+      {
+        sqlite3_bind_int(stmt, 3, ms_level);
+      }
+      if (select_precursor)
+      {
+        sqlite3_bind_double(stmt, 4, precursor_mz_min);
+        sqlite3_bind_double(stmt, 5, precursor_mz_max);
+      }
+
+      std::vector<int> result;
+      Sql::SqlState state = Sql::SqlState::SQL_ROW;
+      while ((state = Sql::nextRow(stmt, state)) == Sql::SqlState::SQL_ROW)
+      {
+        result.push_back(Sql::extractInt(stmt, 0));
+      }
+      sqlite3_finalize(stmt);
+
+      return result;
+    }
+
     Size MzMLSqliteHandler::getNrChromatograms() const
     {
       SqliteConnector conn(filename_);
@@ -854,9 +1043,7 @@ namespace OpenMS::Internal
         static_cast<ExperimentalSettings &>(meta) = exp;
         for (Size k = 0; k < exp.getNrSpectra(); k++)
         {
-          MSSpectrum s = exp.getSpectra()[k];
-          s.clear(false);
-          meta.addSpectrum(s);
+          meta.addSpectrum(exp.getSpectra()[k].copyWithoutPeaks());
         }
         for (Size k = 0; k < exp.getNrChromatograms(); k++)
         {
@@ -888,6 +1075,12 @@ namespace OpenMS::Internal
 
       SqliteConnector conn(filename_);
 
+      // the page size can only be changed before the first table is created
+      if (page_size_ > 0)
+      {
+        conn.executeStatement(String("PRAGMA page_size = ") + page_size_ + ";");
+      }
+
       // Create SQL structure
       char const *create_sql =
 
@@ -973,23 +1166,49 @@ namespace OpenMS::Internal
 
         "CREATE INDEX spec_rt_idx ON SPECTRUM(RETENTION_TIME);" \
         "CREATE INDEX spec_mslevel_idx ON SPECTRUM(MSLEVEL);" \
+        "CREATE INDEX spec_mslevel_rt_idx ON SPECTRUM(MSLEVEL, RETENTION_TIME);" \
         "CREATE INDEX spec_run_idx ON SPECTRUM(RUN_ID);" \
 
         "CREATE INDEX run_extra_idx ON RUN_EXTRA(RUN_ID);" \
 
         "CREATE INDEX chrom_run_idx ON CHROMATOGRAM(RUN_ID);" \
 
-        "CREATE INDEX product_chr_idx ON DATA(CHROMATOGRAM_ID);" \
-        "CREATE INDEX product_sp_idx ON DATA(SPECTRUM_ID);" \
+        "CREATE INDEX product_chr_idx ON PRODUCT(CHROMATOGRAM_ID);" \
+        "CREATE INDEX product_sp_idx ON PRODUCT(SPECTRUM_ID);" \
 
-        "CREATE INDEX precursor_chr_idx ON DATA(CHROMATOGRAM_ID);" \
-        "CREATE INDEX precursor_sp_idx ON DATA(SPECTRUM_ID);";
+        "CREATE INDEX precursor_chr_idx ON PRECURSOR(CHROMATOGRAM_ID);" \
+        "CREATE INDEX precursor_sp_idx ON PRECURSOR(SPECTRUM_ID);" \
+        "CREATE INDEX precursor_target_idx ON PRECURSOR(ISOLATION_TARGET, SPECTRUM_ID);";
 
       // Execute SQL statement
       SqliteConnector conn(filename_);
       conn.executeStatement(create_sql);
     }
 
+    void MzMLSqliteHandler::beginBulkWrite_(SqliteConnector& conn) const
+    {
+      if (cache_size_kb_ > 0)
+      {
+        conn.executeStatement(String("PRAGMA cache_size = -") + cache_size_kb_ + ";");
+      }
+      if (use_wal_)
+      {
+        conn.executeStatement("PRAGMA journal_mode = WAL;");
+        conn.executeStatement("PRAGMA synchronous = NORMAL;");
+      }
+      conn.executeStatement("BEGIN TRANSACTION");
+    }
+
+    void MzMLSqliteHandler::endBulkWrite_(SqliteConnector& conn) const
+    {
+      conn.executeStatement("END TRANSACTION");
+      if (use_wal_)
+      {
+        // checkpoint and return to a self-contained file (readers may not have write access)
+        conn.executeStatement("PRAGMA journal_mode = DELETE;");
+      }
+    }
+
     void MzMLSqliteHandler::writeSpectra(const std::vector<MSSpectrum>& spectra)
     {
       // prevent writing of empty data which would throw an SQL exception
@@ -999,15 +1218,6 @@ namespace OpenMS::Internal
       }
       SqliteConnector conn(filename_);
 
-      // prepare streams and set required precision (default is 6 digits)
-      std::stringstream insert_spectra_sql;
-      std::stringstream insert_precursor_sql;
-      std::stringstream insert_product_sql;
-
-      insert_spectra_sql.precision(11);
-      insert_precursor_sql.precision(11);
-      insert_product_sql.precision(11);
-
       // Encoding options
       MSNumpressCoder::NumpressConfig npconfig_mz;
       npconfig_mz.estimate_fixed_point = true; // critical
@@ -1019,206 +1229,133 @@ namespace OpenMS::Internal
       npconfig_int.numpressErrorTolerance = -1.0; // skip check, faster
       npconfig_int.setCompression("slof");
 
-      String prepare_statement = "INSERT INTO DATA (SPECTRUM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES ";
-      std::vector<String> data;
-      int sql_it = 1;
+      beginBulkWrite_(conn);
+
+      // one prepared statement per table, re-used for all rows
+      PreparedInsert insert_spectrum(conn.getDB(), "INSERT INTO SPECTRUM (ID, RUN_ID, NATIVE_ID, MSLEVEL, RETENTION_TIME, SCAN_POLARITY) VALUES (?1, ?2, ?3, ?4, ?5, ?6);");
+      PreparedInsert insert_precursor(conn.getDB(), "INSERT INTO PRECURSOR (SPECTRUM_ID, CHARGE, ISOLATION_TARGET, "
+        "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, ACTIVATION_METHOD, PEPTIDE_SEQUENCE) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9);");
+      PreparedInsert insert_product(conn.getDB(), "INSERT INTO PRODUCT (SPECTRUM_ID, CHARGE, ISOLATION_TARGET, "
+        "ISOLATION_LOWER, ISOLATION_UPPER) VALUES (?1, ?2, ?3, ?4, ?5);");
+      PreparedInsert insert_data(conn.getDB(), "INSERT INTO DATA (SPECTRUM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES (?1, ?2, ?3, ?4);");
 
-      std::vector<String> encoded_strings_mz(spectra.size());
-      std::vector<String> encoded_strings_int(spectra.size());
+      //  data_type is one of 0 = mz, 1 = int, 2 = rt
+      //  compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+      const int compression_mz = use_lossy_compression_ ? 5 : 1;
+      const int compression_int = use_lossy_compression_ ? 6 : 1;
+      const Int first_id = spec_id_;
+
+      // encode mz data (zlib or np-linear + zlib) and intensity data (zlib or np-slof + zlib)
+      auto encode = [&](Size begin, Size end, std::vector<EncodedArrays>& encoded)
+      {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-      for (SignedSize k = 0; k < (SignedSize)spectra.size(); k++)
-      {
-        const MSSpectrum& spec = spectra[k];
-
-        // encode mz data (zlib or np-linear + zlib)
+        for (SignedSize k = (SignedSize)begin; k < (SignedSize)end; k++)
         {
-          std::vector<double> data_to_encode;
-          data_to_encode.resize(spec.size());
+          const MSSpectrum& spec = spectra[k];
+          std::vector<double> data_to_encode(spec.size());
           for (Size p = 0; p < spec.size(); ++p)
           {
             data_to_encode[p] = spec[p].getMZ();
           }
+          encodeArray(data_to_encode, use_lossy_compression_ ? &npconfig_mz : nullptr, encoded[k - begin].first);
 
-          String uncompressed_str;
-          String encoded_string;
-          if (use_lossy_compression_)
-          {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_mz);
-            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_mz[k] = encoded_string;
-          }
-          else
-          {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_mz[k] = encoded_string;
-          }
-        }
-
-        // encode intensity data (zlib or np-slof + zlib)
-        {
-          std::vector<double> data_to_encode;
-          data_to_encode.resize(spec.size());
           for (Size p = 0; p < spec.size(); ++p)
           {
             data_to_encode[p] = spec[p].getIntensity();
           }
-
-          String uncompressed_str;
-          String encoded_string;
-          if (use_lossy_compression_)
-          {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_int);
-            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_int[k] = encoded_string;
-          }
-          else
-          {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_int[k] = encoded_string;
-          }
+          encodeArray(data_to_encode, use_lossy_compression_ ? &npconfig_int : nullptr, encoded[k - begin].second);
         }
-      }
+      };
 
-      int nr_precursors = 0;
-      int nr_products = 0;
-      for (Size k = 0; k < spectra.size(); k++)
+      auto insert = [&](Size begin, Size end, const std::vector<EncodedArrays>& encoded)
       {
-        const MSSpectrum& spec = spectra[k];
-        int polarity = (spec.getInstrumentSettings().getPolarity() == IonSource::POSITIVE); // 1 = positive
-        insert_spectra_sql << "INSERT INTO SPECTRUM(ID, RUN_ID, NATIVE_ID, MSLEVEL, RETENTION_TIME, SCAN_POLARITY) VALUES (" <<
-          spec_id_ << "," <<
-          run_id_ << ",'" <<
-          spec.getNativeID() << "'," <<
-          spec.getMSLevel() << "," <<
-          spec.getRT() << "," <<
-          polarity << "); ";
-
-        if (!spec.getPrecursors().empty())
+        for (Size k = begin; k < end; k++)
         {
-          if (spec.getPrecursors().size() > 1)
-          {
-            std::cout << "WARNING cannot store more than first precursor" << std::endl;
-          }
-          if (spec.getPrecursors()[0].getActivationMethods().size() > 1)
+          const MSSpectrum& spec = spectra[k];
+          const Int64 id = first_id + (Int64)k;
+          int polarity = (spec.getInstrumentSettings().getPolarity() == IonSource::POSITIVE); // 1 = positive
+          insert_spectrum.bindInt(1, id);
+          insert_spectrum.bindInt(2, (Int64)run_id_);
+          insert_spectrum.bindText(3, spec.getNativeID());
+          insert_spectrum.bindInt(4, spec.getMSLevel());
+          insert_spectrum.bindDouble(5, spec.getRT());
+          insert_spectrum.bindInt(6, polarity);
+          insert_spectrum.execute();
+
+          if (!spec.getPrecursors().empty())
           {
-            std::cout << "WARNING cannot store more than one activation method" << std::endl;
+            if (spec.getPrecursors().size() > 1)
+            {
+              std::cout << "WARNING cannot store more than first precursor" << std::endl;
+            }
+            if (spec.getPrecursors()[0].getActivationMethods().size() > 1)
+            {
+              std::cout << "WARNING cannot store more than one activation method" << std::endl;
+            }
+
+            const OpenMS::Precursor& prec = spec.getPrecursors()[0];
+            // see src/openms/include/OpenMS/METADATA/Precursor.h for activation modes
+            int activation_method = -1;
+            if (!prec.getActivationMethods().empty() )
+            {
+              activation_method = *prec.getActivationMethods().begin();
+            }
+            insert_precursor.bindInt(1, id);
+            insert_precursor.bindInt(2, prec.getCharge());
+            insert_precursor.bindDouble(3, prec.getMZ());
+            insert_precursor.bindDouble(4, prec.getIsolationWindowLowerOffset());
+            insert_precursor.bindDouble(5, prec.getIsolationWindowUpperOffset());
+            insert_precursor.bindDouble(6, prec.getDriftTime());
+            insert_precursor.bindDouble(7, prec.getActivationEnergy());
+            insert_precursor.bindInt(8, activation_method);
+            String pepseq;
+            if (prec.metaValueExists("peptide_sequence"))
+            {
+              pepseq = prec.getMetaValue("peptide_sequence");
+              insert_precursor.bindText(9, pepseq);
+            }
+            else
+            {
+              insert_precursor.bindNull(9);
+            }
+            insert_precursor.execute();
           }
 
-          OpenMS::Precursor prec = spec.getPrecursors()[0];
-          // see src/openms/include/OpenMS/METADATA/Precursor.h for activation modes
-          int activation_method = -1;
-          if (!prec.getActivationMethods().empty() )
-          {
-            activation_method = *prec.getActivationMethods().begin();
-          }
-          String pepseq;
-          if (prec.metaValueExists("peptide_sequence"))
-          {
-            pepseq = prec.getMetaValue("peptide_sequence");
-            insert_precursor_sql << "INSERT INTO PRECURSOR (SPECTRUM_ID, CHARGE, ISOLATION_TARGET, " <<
-                "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, " <<
-                "ACTIVATION_METHOD, PEPTIDE_SEQUENCE) VALUES (" << 
-              spec_id_ << "," << prec.getCharge() << "," << prec.getMZ() <<
-              "," << prec.getIsolationWindowLowerOffset() << "," << prec.getIsolationWindowUpperOffset() <<
-              "," << prec.getDriftTime() << 
-              "," << prec.getActivationEnergy() << 
-              "," << activation_method << ",'" << pepseq << "'" << "); ";
-          }
-          else
+          if (!spec.getProducts().empty())
           {
-            insert_precursor_sql << "INSERT INTO PRECURSOR (SPECTRUM_ID, CHARGE, ISOLATION_TARGET, " << 
-              "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, ACTIVATION_METHOD) VALUES (" <<
-              spec_id_ << "," << prec.getCharge() << "," << prec.getMZ() << 
-              "," << prec.getIsolationWindowLowerOffset() << "," << prec.getIsolationWindowUpperOffset() << 
-              "," << prec.getDriftTime() <<
-              "," << prec.getActivationEnergy() <<
-              "," << activation_method << "); ";
+            if (spec.getProducts().size() > 1)
+            {
+              std::cout << "WARNING cannot store more than first product" << std::endl;
+            }
+            const OpenMS::Product& prod = spec.getProducts()[0];
+            insert_product.bindInt(1, id);
+            insert_product.bindInt(2, 0);
+            insert_product.bindDouble(3, prod.getMZ());
+            insert_product.bindDouble(4, prod.getIsolationWindowLowerOffset());
+            insert_product.bindDouble(5, prod.getIsolationWindowUpperOffset());
+            insert_product.execute();
           }
-          nr_precursors++;
-        }
 
-        if (!spec.getProducts().empty())
-        {
-          if (spec.getProducts().size() > 1)
-          {
-            std::cout << "WARNING cannot store more than first product" << std::endl;
-          }
-          OpenMS::Product prod = spec.getProducts()[0];
-          insert_product_sql << "INSERT INTO PRODUCT (SPECTRUM_ID, CHARGE, ISOLATION_TARGET, " << 
-            "ISOLATION_LOWER, ISOLATION_UPPER) VALUES (" << 
-            spec_id_ << "," << 0 << "," << prod.getMZ() << 
-            "," << prod.getIsolationWindowLowerOffset() << "," << prod.getIsolationWindowUpperOffset() << "); ";
-          nr_products++;
+          insert_data.bindInt(1, id);
+          insert_data.bindInt(2, 0);
+          insert_data.bindInt(3, compression_mz);
+          insert_data.bindBlob(4, encoded[k - begin].first);
+          insert_data.execute();
+
+          insert_data.bindInt(1, id);
+          insert_data.bindInt(2, 1);
+          insert_data.bindInt(3, compression_int);
+          insert_data.bindBlob(4, encoded[k - begin].second);
+          insert_data.execute();
         }
+      };
 
-        //  data_type is one of 0 = mz, 1 = int, 2 = rt
-        //  compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+      encodeAndInsert(spectra.size(), std::max(1, sql_batch_size_ / 2), encode, insert);
+      spec_id_ += (Int)spectra.size();
 
-        // encode mz data (zlib or np-linear + zlib)
-        {
-          data.push_back(encoded_strings_mz[k]);
-          if (use_lossy_compression_)
-          {
-            prepare_statement += String("(") + spec_id_ + ", 0, 5, ?" + sql_it++ + " ),";
-          }
-          else
-          {
-            prepare_statement += String("(") + spec_id_ + ", 0, 1, ?" + sql_it++ + " ),";
-          }
-        }
-
-        // encode intensity data (zlib or np-slof + zlib)
-        {
-          data.push_back(encoded_strings_int[k]);
-          if (use_lossy_compression_)
-          {
-            prepare_statement += String("(") + spec_id_ + ", 1, 6, ?" + sql_it++ + " ),";
-          }
-          else
-          {
-            prepare_statement += String("(") + spec_id_ + ", 1, 1, ?" + sql_it++ + " ),";
-          }
-        }
-        spec_id_++;
-
-        if (sql_it > sql_batch_size_) // flush as sqlite can only handle so many bind_blob statements
-        {
-          // prevent writing of empty data which would throw an SQL exception
-          if (!data.empty())
-          {
-            prepare_statement.resize( prepare_statement.size() -1 ); // remove last ","
-            conn.executeBindStatement(prepare_statement, data);
-          }
-
-          data.clear();
-          prepare_statement = "INSERT INTO DATA (SPECTRUM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES ";
-          sql_it = 1;
-        }
-
-      }
-
-      // prevent writing of empty data which would throw an SQL exception
-      if (!data.empty())
-      {
-        prepare_statement.resize( prepare_statement.size() -1 );
-        conn.executeBindStatement(prepare_statement, data);
-      }
-
-      conn.executeStatement("BEGIN TRANSACTION");
-      conn.executeStatement(insert_spectra_sql.str());
-      if (nr_precursors > 0)
-      {
-        conn.executeStatement(insert_precursor_sql.str());
-      }
-      if (nr_products > 0)
-      {
-        conn.executeStatement(insert_product_sql.str());
-      }
-      conn.executeStatement("END TRANSACTION");
+      endBulkWrite_(conn);
     }
 
     void MzMLSqliteHandler::writeChromatograms(const std::vector<MSChromatogram >& chroms)
@@ -1230,15 +1367,6 @@ namespace OpenMS::Internal
       }
       SqliteConnector conn(filename_);
 
-      // prepare streams and set required precision (default is 6 digits)
-      std::stringstream insert_chrom_sql;
-      std::stringstream insert_precursor_sql;
-      std::stringstream insert_product_sql;
-
-      insert_chrom_sql.precision(11);
-      insert_precursor_sql.precision(11);
-      insert_product_sql.precision(11);
-
       // Encoding options
       MSNumpressCoder::NumpressConfig npconfig_mz;
       npconfig_mz.estimate_fixed_point = true; // critical
@@ -1250,170 +1378,110 @@ namespace OpenMS::Internal
       npconfig_int.numpressErrorTolerance = -1.0; // skip check, faster
       npconfig_int.setCompression("slof");
 
-      String prepare_statement = "INSERT INTO DATA (CHROMATOGRAM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES ";
-      int sql_it = 1;
+      beginBulkWrite_(conn);
+
+      // one prepared statement per table, re-used for all rows
+      PreparedInsert insert_chrom(conn.getDB(), "INSERT INTO CHROMATOGRAM (ID, RUN_ID, NATIVE_ID) VALUES (?1, ?2, ?3);");
+      PreparedInsert insert_precursor(conn.getDB(), "INSERT INTO PRECURSOR (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, "
+        "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, ACTIVATION_METHOD, PEPTIDE_SEQUENCE) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9);");
+      PreparedInsert insert_product(conn.getDB(), "INSERT INTO PRODUCT (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, "
+        "ISOLATION_LOWER, ISOLATION_UPPER) VALUES (?1, ?2, ?3, ?4, ?5);");
+      PreparedInsert insert_data(conn.getDB(), "INSERT INTO DATA (CHROMATOGRAM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES (?1, ?2, ?3, ?4);");
 
-      // Perform encoding in parallel
-      std::vector<String> encoded_strings_rt(chroms.size());
-      std::vector<String> encoded_strings_int(chroms.size());
+      //  data_type is one of 0 = mz, 1 = int, 2 = rt
+      //  compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+      const int compression_rt = use_lossy_compression_ ? 5 : 1;
+      const int compression_int = use_lossy_compression_ ? 6 : 1;
+      const Int first_id = chrom_id_;
+
+      // encode retention time data (zlib or np-linear + zlib) and intensity data (zlib or np-slof + zlib)
+      auto encode = [&](Size begin, Size end, std::vector<EncodedArrays>& encoded)
+      {
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-      for (SignedSize k = 0; k < (SignedSize)chroms.size(); k++)
-      {
-        const MSChromatogram& chrom = chroms[k];
-        // encode retention time data (zlib or np-linear + zlib)
+        for (SignedSize k = (SignedSize)begin; k < (SignedSize)end; k++)
         {
-          std::vector<double> data_to_encode;
-          data_to_encode.resize(chrom.size());
+          const MSChromatogram& chrom = chroms[k];
+          std::vector<double> data_to_encode(chrom.size());
           for (Size p = 0; p < chrom.size(); ++p)
           {
             data_to_encode[p] = chrom[p].getRT();
           }
+          encodeArray(data_to_encode, use_lossy_compression_ ? &npconfig_mz : nullptr, encoded[k - begin].first);
 
-          String uncompressed_str;
-          String encoded_string;
-          if (use_lossy_compression_)
-          {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_mz);
-            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_rt[k] = encoded_string;
-          }
-          else
-          {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_rt[k] = encoded_string;
-          }
-        }
-
-        // encode intensity data (zlib or np-slof + zlib)
-        {
-          std::vector<double> data_to_encode;
-          data_to_encode.resize(chrom.size());
           for (Size p = 0; p < chrom.size(); ++p)
           {
             data_to_encode[p] = chrom[p].getIntensity();
           }
-
-          String uncompressed_str;
-          String encoded_string;
-          if (use_lossy_compression_)
-          {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_int);
-            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_int[k] = encoded_string;
-          }
-          else
-          {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_int[k] = encoded_string;
-          }
+          encodeArray(data_to_encode, use_lossy_compression_ ? &npconfig_int : nullptr, encoded[k - begin].second);
         }
-      }
+      };
 
-      std::vector<String> data;
-      for (Size k = 0; k < chroms.size(); k++)
+      auto insert = [&](Size begin, Size end, const std::vector<EncodedArrays>& encoded)
       {
-        const MSChromatogram& chrom = chroms[k];
-        insert_chrom_sql << "INSERT INTO CHROMATOGRAM (ID, RUN_ID, NATIVE_ID) VALUES (" << chrom_id_ << "," << run_id_ << ",'" << chrom.getNativeID() << "'); ";
-
-        OpenMS::Precursor prec = chrom.getPrecursor();
-        // see src/openms/include/OpenMS/METADATA/Precursor.h for activation modes
-        int activation_method = -1;
-        if (!prec.getActivationMethods().empty() )
-        {
-          activation_method = *prec.getActivationMethods().begin();
-        }
-        String pepseq;
-        if (prec.metaValueExists("peptide_sequence"))
-        {
-          pepseq = prec.getMetaValue("peptide_sequence");
-          insert_precursor_sql << "INSERT INTO PRECURSOR (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, " <<
-            "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, " << 
-            "ACTIVATION_METHOD, PEPTIDE_SEQUENCE) VALUES (" << 
-            chrom_id_ << "," << prec.getCharge() << "," << prec.getMZ() << 
-            "," << prec.getIsolationWindowLowerOffset() << "," << prec.getIsolationWindowUpperOffset() <<
-            "," << prec.getDriftTime() << 
-            "," << prec.getActivationEnergy() << 
-            "," << activation_method << ",'" << pepseq << "'" << "); ";
-        }
-        else
-        {
-          insert_precursor_sql << "INSERT INTO PRECURSOR (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, " << 
-            "ISOLATION_LOWER, ISOLATION_UPPER, DRIFT_TIME, ACTIVATION_ENERGY, ACTIVATION_METHOD) VALUES (" << 
-            chrom_id_ << "," << prec.getCharge() << "," << prec.getMZ() << 
-            "," << prec.getIsolationWindowLowerOffset() << "," << prec.getIsolationWindowUpperOffset() <<
-            "," << prec.getDriftTime() << 
-            "," << prec.getActivationEnergy() << 
-            "," << activation_method << "); ";
-        }
-
-        OpenMS::Product prod = chrom.getProduct();
-        insert_product_sql << "INSERT INTO PRODUCT (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, " << 
-          "ISOLATION_LOWER, ISOLATION_UPPER) VALUES (" << 
-          chrom_id_ << "," << 0 << "," << prod.getMZ() << 
-          "," << prod.getIsolationWindowLowerOffset() << "," << prod.getIsolationWindowUpperOffset() << "); ";
-
-        //  data_type is one of 0 = mz, 1 = int, 2 = rt
-        //  compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
-
-        // encode retention time data (zlib or np-linear + zlib)
+        for (Size k = begin; k < end; k++)
         {
-          data.push_back(encoded_strings_rt[k]);
-          if (use_lossy_compression_)
-          {
-            prepare_statement += String("(") + chrom_id_ + ", 2, 5, ?" + sql_it++ + " ),";
-          }
-          else
+          const MSChromatogram& chrom = chroms[k];
+          const Int64 id = first_id + (Int64)k;
+          insert_chrom.bindInt(1, id);
+          insert_chrom.bindInt(2, (Int64)run_id_);
+          insert_chrom.bindText(3, chrom.getNativeID());
+          insert_chrom.execute();
+
+          const OpenMS::Precursor& prec = chrom.getPrecursor();
+          // see src/openms/include/OpenMS/METADATA/Precursor.h for activation modes
+          int activation_method = -1;
+          if (!prec.getActivationMethods().empty() )
           {
-            prepare_statement += String("(") + chrom_id_ + ", 2, 1, ?" + sql_it++ + " ),";
+            activation_method = *prec.getActivationMethods().begin();
           }
-        }
-
-        // encode intensity data (zlib or np-slof + zlib)
-        {
-          data.push_back(encoded_strings_int[k]);
-          if (use_lossy_compression_)
+          insert_precursor.bindInt(1, id);
+          insert_precursor.bindInt(2, prec.getCharge());
+          insert_precursor.bindDouble(3, prec.getMZ());
+          insert_precursor.bindDouble(4, prec.getIsolationWindowLowerOffset());
+          insert_precursor.bindDouble(5, prec.getIsolationWindowUpperOffset());
+          insert_precursor.bindDouble(6, prec.getDriftTime());
+          insert_precursor.bindDouble(7, prec.getActivationEnergy());
+          insert_precursor.bindInt(8, activation_method);
+          String pepseq;
+          if (prec.metaValueExists("peptide_sequence"))
           {
-            prepare_statement += String("(") + chrom_id_ + ", 1, 6, ?" + sql_it++ + " ),";
+            pepseq = prec.getMetaValue("peptide_sequence");
+            insert_precursor.bindText(9, pepseq);
           }
           else
           {
-            prepare_statement += String("(") + chrom_id_ + ", 1, 1, ?" + sql_it++ + " ),";
+            insert_precursor.bindNull(9);
           }
+          insert_precursor.execute();
+
+          const OpenMS::Product& prod = chrom.getProduct();
+          insert_product.bindInt(1, id);
+          insert_product.bindInt(2, 0);
+          insert_product.bindDouble(3, prod.getMZ());
+          insert_product.bindDouble(4, prod.getIsolationWindowLowerOffset());
+          insert_product.bindDouble(5, prod.getIsolationWindowUpperOffset());
+          insert_product.execute();
+
+          insert_data.bindInt(1, id);
+          insert_data.bindInt(2, 2);
+          insert_data.bindInt(3, compression_rt);
+          insert_data.bindBlob(4, encoded[k - begin].first);
+          insert_data.execute();
+
+          insert_data.bindInt(1, id);
+          insert_data.bindInt(2, 1);
+          insert_data.bindInt(3, compression_int);
+          insert_data.bindBlob(4, encoded[k - begin].second);
+          insert_data.execute();
         }
-        chrom_id_++;
+      };
 
-        if (sql_it > sql_batch_size_) // flush as sqlite can only handle so many bind_blob statements
-        {
-          // prevent writing of empty data which would throw an SQL exception
-          if (!data.empty())
-          {
-            prepare_statement.resize( prepare_statement.size() -1 ); // remove last ","
-            conn.executeBindStatement(prepare_statement, data);
-          }
-
-          data.clear();
-          prepare_statement = "INSERT INTO DATA (CHROMATOGRAM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES ";
-          sql_it = 1;
-        }
-
-      }
+      encodeAndInsert(chroms.size(), std::max(1, sql_batch_size_ / 2), encode, insert);
+      chrom_id_ += (Int)chroms.size();
 
-      // prevent writing of empty data which would throw an SQL exception
-      if (!data.empty())
-      {
-        prepare_statement.resize(prepare_statement.size() -1); // remove last ","
-        conn.executeBindStatement(prepare_statement, data);
-      }
-
-      conn.executeStatement("BEGIN TRANSACTION");
-      conn.executeStatement(insert_chrom_sql.str());
-      conn.executeStatement(insert_precursor_sql.str());
-      conn.executeStatement(insert_product_sql.str());
-      conn.executeStatement("END TRANSACTION");
+      endBulkWrite_(conn);
     }
 
 } // namespace OpenMS  // namespace Internal
@@ -49,19 +49,19 @@ namespace OpenMS::Internal
     MzQuantMLHandler::MzQuantMLHandler(const MSQuantifications& msq, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"MS", "/CV/psi-ms.obo"}})), //TODO unimod -> then automatise CVList writing
       msq_(nullptr),
       cmsq_(&msq)
     {
-      cv_.loadFromOBO("MS", File::find("/CV/psi-ms.obo")); //TODO unimod -> then automatise CVList writing
     }
 
     MzQuantMLHandler::MzQuantMLHandler(MSQuantifications& msq, /* FeatureMap& feature_map, */ const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"MS", "/CV/psi-ms.obo"}})),
       msq_(&msq),
       cmsq_(nullptr)
     {
-      cv_.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
     }
 
     MzQuantMLHandler::~MzQuantMLHandler()
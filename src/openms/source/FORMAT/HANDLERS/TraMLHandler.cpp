@@ -48,19 +48,19 @@ namespace OpenMS::Internal
     TraMLHandler::TraMLHandler(const TargetedExperiment& exp, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PI", "/CV/psi-ms.obo"}})),
       exp_(nullptr),
       cexp_(&exp)
     {
-      cv_.loadFromOBO("PI", File::find("/CV/psi-ms.obo"));
     }
 
     TraMLHandler::TraMLHandler(TargetedExperiment& exp, const String& filename, const String& version, const ProgressLogger& logger) :
       XMLHandler(filename, version),
       logger_(logger),
+      cv_(ControlledVocabulary::getCachedCV({{"PI", "/CV/psi-ms.obo"}})),
       exp_(&exp),
       cexp_(nullptr)
     {
-      cv_.loadFromOBO("PI", File::find("/CV/psi-ms.obo"));
     }
 
     TraMLHandler::~TraMLHandler()
@@ -40,7 +40,13 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
 #include <algorithm>
+#include <exception>
 #include <set>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 using namespace xercesc;
@@ -151,26 +157,29 @@ namespace OpenMS::Internal
 
     void XMLHandler::warning(ActionMode mode, const String & msg, UInt line, UInt column) const
     {
-      if (mode == LOAD)
-      {
-        error_message_ =  String("While loading '") + file_ + "': " + msg;
-      }
-      else if (mode == STORE)
+      // may be called from concurrently formatted elements (see writeElementsParallel_)
+#pragma omp critical (XMLHandler_warning)
       {
-        error_message_ =  String("While storing '") + file_ + "': " + msg;
-      }
-      if (line != 0 || column != 0)
-      {
-        error_message_ += String("( in line ") + line + " column " + column + ")";
-      }
+        if (mode == LOAD)
+        {
+          error_message_ =  String("While loading '") + file_ + "': " + msg;
+        }
+        else if (mode == STORE)
+        {
+          error_message_ =  String("While storing '") + file_ + "': " + msg;
+        }
+        if (line != 0 || column != 0)
+        {
+          error_message_ += String("( in line ") + line + " column " + column + ")";
+        }
 
-// warn only in Debug mode but suppress warnings in release mode (more happy users)
+        // warn only in Debug mode but suppress warnings in release mode (more happy users)
 #ifdef OPENMS_ASSERTIONS
-      OPENMS_LOG_WARN << error_message_ << std::endl;
+        OPENMS_LOG_WARN << error_message_ << std::endl;
 #else
-      OPENMS_LOG_DEBUG << error_message_ << std::endl;
+        OPENMS_LOG_DEBUG << error_message_ << std::endl;
 #endif
-
+      }
     }
 
     void XMLHandler::characters(const XMLCh * const /*chars*/, const XMLSize_t /*length*/)
@@ -237,6 +246,99 @@ namespace OpenMS::Internal
       }
     }
 
+    void XMLHandler::writeElementsParallel_(std::ostream& os, Size count,
+                                            const std::function<void(std::ostream&, Size)>& write_element,
+                                            const std::function<void(Size)>& progress,
+                                            std::vector<Int64>* element_offsets,
+                                            Size elements_per_thread)
+    {
+      int threads = 1;
+#ifdef _OPENMP
+      threads = omp_get_max_threads();
+#endif
+      // enough elements per thread to amortize the thread synchronization, few enough to keep the buffers small
+      const Size block_size = std::max(elements_per_thread, Size(1)) * (Size)threads;
+      // start of each element within its thread buffer
+      std::vector<Int64> buffer_offsets(element_offsets ? std::min(block_size, count) : 0);
+      if (element_offsets)
+      {
+        element_offsets->resize(count);
+      }
+
+      std::vector<std::ostringstream> buffers(threads);
+      for (std::ostringstream& buffer : buffers)
+      {
+        buffer.precision(os.precision());
+        buffer.flags(os.flags());
+        buffer.imbue(os.getloc());
+      }
+
+      std::exception_ptr error;
+      for (Size block_start = 0; block_start < count; block_start += block_size)
+      {
+        const Size block_end = std::min(count, block_start + block_size);
+        for (std::ostringstream& buffer : buffers)
+        {
+          buffer.str(std::string());
+          buffer.clear();
+        }
+        // range of elements formatted by each thread (threads which are not started have an empty range)
+        std::vector<std::pair<Size, Size> > slices(threads, std::make_pair(block_end, block_end));
+
+#pragma omp parallel num_threads(threads)
+        {
+          int thread = 0;
+          int n_threads = 1;
+#ifdef _OPENMP
+          thread = omp_get_thread_num();
+          n_threads = omp_get_num_threads();
+#endif
+          // each thread formats a contiguous slice, so concatenating the buffers preserves the order
+          const Size slice = (block_end - block_start + n_threads - 1) / n_threads;
+          const Size begin = std::min(block_end, block_start + thread * slice);
+          const Size end = std::min(block_end, begin + slice);
+          slices[thread] = std::make_pair(begin, end);
+          try
+          {
+            for (Size i = begin; i < end; ++i)
+            {
+              if (element_offsets)
+              {
+                buffer_offsets[i - block_start] = buffers[thread].tellp();
+              }
+              write_element(buffers[thread], i);
+            }
+          }
+          catch (...)
+          {
+#pragma omp critical (XMLHandler_writeElementsParallel)
+            {
+              if (!error) error = std::current_exception();
+            }
+          }
+        }
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+
+        for (Size t = 0; t < buffers.size(); ++t)
+        {
+          const std::string& text = buffers[t].str();
+          if (element_offsets)
+          {
+            const Int64 base = os.tellp();
+            for (Size i = slices[t].first; i < slices[t].second; ++i)
+            {
+              (*element_offsets)[i] = base + buffer_offsets[i - block_start];
+            }
+          }
+          os.write(text.data(), text.size());
+        }
+        progress(block_end);
+      }
+    }
+
     void XMLHandler::writeUserParam_(const String& tag_name, std::ostream& os, const MetaInfoInterface& meta, UInt indent) const
     {
       std::vector<String> keys;
@@ -14,6 +14,7 @@ set(sources_list
   MzDataHandler.cpp
   MzIdentMLHandler.cpp
   MzIdentMLDOMHandler.cpp
+  MzIdentMLSAXHandler.cpp
   MzQuantMLHandler.cpp
   MzMLHandler.cpp
   MzMLHandlerHelper.cpp
@@ -56,7 +56,8 @@ namespace OpenMS
     XMLFile("/SCHEMAS/IdXML_1_5.xsd", "1.5"),
     last_meta_(nullptr),
     document_id_(),
-    prot_id_in_run_(false)
+    prot_id_in_run_(false),
+    consumer_(nullptr)
   {
   }
 
@@ -82,7 +83,48 @@ namespace OpenMS
 
     parse_(filename, this);
 
-    //reset members
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::transform(const String& filename, Interfaces::IIdentificationConsumer* consumer)
+  {
+    String document_id;
+    transform(filename, consumer, document_id);
+  }
+
+  void IdXMLFile::transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, String& document_id)
+  {
+    startProgress(0, 0, "Streaming idXML");
+    file_ = filename;
+
+    // protein identifications only keep their identifier here; peptide identifications are not collected at all
+    streamed_prot_ids_.clear();
+    prot_ids_ = &streamed_prot_ids_;
+    pep_ids_ = nullptr;
+    document_id_ = &document_id;
+    consumer_ = consumer;
+
+    try
+    {
+      parse_(filename, this);
+    }
+    catch (...)
+    {
+      consumer_ = nullptr;
+      resetMembers_();
+      throw;
+    }
+
+    consumer_ = nullptr;
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::resetMembers_()
+  {
     prot_ids_ = nullptr;
     pep_ids_ = nullptr;
     last_meta_ = nullptr;
@@ -94,8 +136,22 @@ namespace OpenMS
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
     proteinid_to_accession_.clear();
+    streamed_prot_ids_.clear();
+    sequence_cache_.clear();
+  }
 
-    endProgress();
+  void IdXMLFile::addProteinIdentification_(ProteinIdentification&& prot_id)
+  {
+    if (consumer_ == nullptr)
+    {
+      prot_ids_->push_back(std::move(prot_id));
+      return;
+    }
+    // streaming: keep only the identifier (the consumer may move from the object)
+    ProteinIdentification run;
+    run.setIdentifier(prot_id.getIdentifier());
+    prot_ids_->push_back(std::move(run));
+    consumer_->consumeProteinIdentification(prot_id);
   }
 
   void IdXMLFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id)
@@ -445,18 +501,7 @@ namespace OpenMS
 
     endProgress();
 
-    //reset members
-    prot_ids_ = nullptr;
-    pep_ids_ = nullptr;
-    last_meta_ = nullptr;
-    parameters_.clear();
-    param_ = ProteinIdentification::SearchParameters();
-    id_ = "";
-    prot_id_ = ProteinIdentification();
-    pep_id_ = PeptideIdentification();
-    prot_hit_ = ProteinHit();
-    pep_hit_ = PeptideHit();
-    proteinid_to_accession_.clear();
+    resetMembers_();
   }
 
   void IdXMLFile::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
@@ -616,7 +661,7 @@ namespace OpenMS
       // check whether a prot id has been given, add "empty" one to list else
       if (!prot_id_in_run_)
       {
-        prot_ids_->push_back(prot_id_);
+        addProteinIdentification_(ProteinIdentification(prot_id_));
         prot_id_in_run_ = true; // set to true, cause we have created one; will be reset for next run
       }
 
@@ -666,7 +711,7 @@ namespace OpenMS
 
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -890,7 +935,7 @@ namespace OpenMS
       getProteinGroups_(prot_id_.getIndistinguishableProteins(),
                         "indistinguishable_proteins");
 
-      prot_ids_->push_back(prot_id_);
+      addProteinIdentification_(std::move(prot_id_));
       prot_id_ = ProteinIdentification();
       last_meta_  = nullptr;
       prot_id_in_run_ = true;
@@ -900,7 +945,7 @@ namespace OpenMS
       if (prot_ids_->empty())
       {
         // add empty <ProteinIdentification> if there was none so far (that's where the IdentificationRun parameters are stored)
-        prot_ids_->emplace_back(std::move(prot_id_));
+        addProteinIdentification_(std::move(prot_id_));
       }
       prot_id_ = ProteinIdentification();
       last_meta_ = nullptr;
@@ -914,7 +959,14 @@ namespace OpenMS
     //PEPTIDES
     else if (tag == "PeptideIdentification")
     {
-      pep_ids_->emplace_back(std::move(pep_id_));
+      if (consumer_ != nullptr)
+      {
+        consumer_->consumePeptideIdentification(pep_id_);
+      }
+      else
+      {
+        pep_ids_->emplace_back(std::move(pep_id_));
+      }
       pep_id_ = PeptideIdentification();
       last_meta_ = nullptr;
     }
@@ -0,0 +1,259 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+#include <OpenMS/FORMAT/IndexedFASTAFile.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+
+namespace OpenMS
+{
+  namespace
+  {
+    const UInt64 MAGIC_NUMBER = 0x3142444641534D4FULL; // "OMSAFDB1" in little endian
+    const UInt32 FORMAT_VERSION = 1;
+
+    struct Header
+    {
+      UInt64 magic;
+      UInt32 version;
+      UInt32 reserved;
+      UInt64 entry_count;
+      UInt64 data_size;
+    };
+
+    /// size of the decoy flag block (including padding to 8 bytes)
+    UInt64 decoyBlockSize(UInt64 n)
+    {
+      return (n + 7) / 8 * 8;
+    }
+
+    bool isDecoyEntry(const String& identifier, const String& decoy_string, bool decoy_is_prefix)
+    {
+      if (decoy_string.empty()) return false;
+      return decoy_is_prefix ? identifier.hasPrefix(decoy_string) : identifier.hasSuffix(decoy_string);
+    }
+
+    /// are the @p n + 1 offsets ascending and within [first, last]?
+    bool validOffsets(const UInt64* offsets, UInt64 n, UInt64 first, UInt64 last)
+    {
+      if (offsets[0] != first || offsets[n] != last) return false;
+      for (UInt64 i = 0; i < n; ++i)
+      {
+        if (offsets[i] > offsets[i + 1]) return false;
+      }
+      return true;
+    }
+  }
+
+  IndexedFASTAFile::IndexedFASTAFile() = default;
+
+  IndexedFASTAFile::IndexedFASTAFile(const String& filename)
+  {
+    load(filename);
+  }
+
+  IndexedFASTAFile::~IndexedFASTAFile() = default;
+
+  void IndexedFASTAFile::store(const String& filename, const std::vector<FASTAFile::FASTAEntry>& entries,
+                               const String& decoy_string, bool decoy_is_prefix)
+  {
+    const UInt64 n = entries.size();
+    std::vector<UInt64> id_offsets, description_offsets, sequence_offsets;
+    id_offsets.reserve(n + 1);
+    description_offsets.reserve(n + 1);
+    sequence_offsets.reserve(n + 1);
+    std::vector<unsigned char> decoy(decoyBlockSize(n), 0);
+
+    UInt64 offset = 0;
+    for (UInt64 i = 0; i < n; ++i)
+    {
+      id_offsets.push_back(offset);
+      offset += entries[i].identifier.size();
+      decoy[i] = isDecoyEntry(entries[i].identifier, decoy_string, decoy_is_prefix);
+    }
+    id_offsets.push_back(offset);
+    for (const auto& e : entries)
+    {
+      description_offsets.push_back(offset);
+      offset += e.description.size();
+    }
+    description_offsets.push_back(offset);
+    for (const auto& e : entries)
+    {
+      sequence_offsets.push_back(offset);
+      offset += e.sequence.size();
+    }
+    sequence_offsets.push_back(offset);
+
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    Header header{MAGIC_NUMBER, FORMAT_VERSION, 0, n, offset};
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(id_offsets.data()), id_offsets.size() * sizeof(UInt64));
+    ofs.write(reinterpret_cast<const char*>(description_offsets.data()), description_offsets.size() * sizeof(UInt64));
+    ofs.write(reinterpret_cast<const char*>(sequence_offsets.data()), sequence_offsets.size() * sizeof(UInt64));
+    ofs.write(reinterpret_cast<const char*>(decoy.data()), decoy.size());
+    for (const auto& e : entries) ofs.write(e.identifier.data(), e.identifier.size());
+    for (const auto& e : entries) ofs.write(e.description.data(), e.description.size());
+    for (const auto& e : entries) ofs.write(e.sequence.data(), e.sequence.size());
+    ofs.close();
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Could not write the database (disk full?)");
+    }
+  }
+
+  void IndexedFASTAFile::load(const String& filename)
+  {
+    mapping_.reset();
+    size_ = 0;
+    id_offsets_ = description_offsets_ = sequence_offsets_ = nullptr;
+    decoy_ = nullptr;
+    data_ = nullptr;
+
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    std::shared_ptr<boost::interprocess::mapped_region> region;
+    try
+    {
+      boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+      region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception&)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const char* begin = static_cast<const char*>(region->get_address());
+    const UInt64 file_size = region->get_size();
+    Header header;
+    if (file_size < sizeof(Header))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "File too small for a protein database");
+    }
+    std::memcpy(&header, begin, sizeof(Header));
+    if (header.magic != MAGIC_NUMBER || header.version != FORMAT_VERSION)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a protein database of version " + String(FORMAT_VERSION));
+    }
+    const UInt64 n = header.entry_count;
+    // guard against overflow in the size computation below
+    if (n > file_size / (3 * sizeof(UInt64)) || header.data_size > file_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Corrupt header of protein database");
+    }
+    const UInt64 table_bytes = 3 * (n + 1) * sizeof(UInt64);
+    if (sizeof(Header) + table_bytes + decoyBlockSize(n) + header.data_size != file_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Protein database is truncated or corrupt");
+    }
+
+    const UInt64* tables = reinterpret_cast<const UInt64*>(begin + sizeof(Header));
+    const UInt64* id_offsets = tables;
+    const UInt64* description_offsets = tables + (n + 1);
+    const UInt64* sequence_offsets = tables + 2 * (n + 1);
+    if (!validOffsets(id_offsets, n, 0, id_offsets[n])
+        || !validOffsets(description_offsets, n, id_offsets[n], description_offsets[n])
+        || !validOffsets(sequence_offsets, n, description_offsets[n], header.data_size))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Invalid offset table in protein database");
+    }
+
+    mapping_ = region;
+    size_ = n;
+    id_offsets_ = id_offsets;
+    description_offsets_ = description_offsets;
+    sequence_offsets_ = sequence_offsets;
+    decoy_ = reinterpret_cast<const unsigned char*>(begin + sizeof(Header) + table_bytes);
+    data_ = begin + sizeof(Header) + table_bytes + decoyBlockSize(n);
+  }
+
+  bool IndexedFASTAFile::isOpen() const
+  {
+    return mapping_ != nullptr;
+  }
+
+  Size IndexedFASTAFile::size() const
+  {
+    return size_;
+  }
+
+  std::string_view IndexedFASTAFile::view_(const UInt64* offsets, Size index) const
+  {
+    return std::string_view(data_ + offsets[index], offsets[index + 1] - offsets[index]);
+  }
+
+  std::string_view IndexedFASTAFile::getIdentifier(Size index) const
+  {
+    return view_(id_offsets_, index);
+  }
+
+  std::string_view IndexedFASTAFile::getDescription(Size index) const
+  {
+    return view_(description_offsets_, index);
+  }
+
+  std::string_view IndexedFASTAFile::getSequence(Size index) const
+  {
+    return view_(sequence_offsets_, index);
+  }
+
+  bool IndexedFASTAFile::isDecoy(Size index) const
+  {
+    return decoy_[index] != 0;
+  }
+
+  void IndexedFASTAFile::getEntry(Size index, FASTAFile::FASTAEntry& entry) const
+  {
+    if (index >= size_)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, size_);
+    }
+    std::string_view id = getIdentifier(index), desc = getDescription(index), seq = getSequence(index);
+    entry.identifier.assign(id.data(), id.size());
+    entry.description.assign(desc.data(), desc.size());
+    entry.sequence.assign(seq.data(), seq.size());
+  }
+
+} // namespace OpenMS
@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+#include <OpenMS/FORMAT/HANDLERS/IndexedMzMLHandler.h>
 
 namespace OpenMS
 {
@@ -69,6 +70,109 @@ namespace OpenMS
     return exp.openFile(filename);
   }
 
+  namespace
+  {
+    /**
+      @brief Fill the meta data containers @p items with the binary data from @p index
+
+      Each thread works on a contiguous block of @p items through its own copy
+      of @p index (and thus its own file handle). If @p items does not
+      correspond to the full index (e.g. due to RT or MS level filtering), the
+      native id is used to find the data of each item.
+    */
+    template <typename ContainerT, typename ReadByIdF, typename ReadByNativeIdF>
+    void fillDataParallel(const Internal::IndexedMzMLHandler& index, Size index_size, ContainerT& items,
+                          bool sort, const String& filename, ReadByIdF read_by_id, ReadByNativeIdF read_by_native_id)
+    {
+      const bool positional = (items.size() == index_size);
+      Size err_count = 0;
+      String error_message;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        // the copy opens its own file stream, see IndexedMzMLHandler copy constructor
+        Internal::IndexedMzMLHandler thread_index(index);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)items.size(); ++i)
+        {
+          if (err_count) continue; // no need to decode further if already an error was encountered
+          try
+          {
+            if (positional)
+            {
+              read_by_id(thread_index, int(i), items[i]);
+            }
+            else
+            {
+              read_by_native_id(thread_index, items[i].getNativeID(), items[i]);
+            }
+            if (sort && !items[i].isSorted())
+            {
+              items[i].sortByPosition();
+            }
+          }
+          catch (Exception::BaseException& e)
+          {
+#ifdef _OPENMP
+#pragma omp critical (IndexedMzMLFileLoader_load)
+#endif
+            {
+              ++err_count;
+              error_message = e.what();
+            }
+          }
+        }
+      }
+      if (err_count != 0)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error during parsing of binary data: '" + error_message + "'");
+      }
+    }
+  }
+
+  bool IndexedMzMLFileLoader::load(const String& filename, PeakMap& exp)
+  {
+    if (options_.hasMZRange() || options_.hasIntensityRange())
+    {
+      // data filtering is only implemented in the sequential parser
+      MzMLFile f;
+      f.setOptions(options_);
+      f.load(filename, exp);
+      return Internal::IndexedMzMLHandler(filename).getParsingSuccess();
+    }
+
+    Internal::IndexedMzMLHandler index(filename);
+    if (!index.getParsingSuccess())
+    {
+      return false;
+    }
+    index.setSkipXMLChecks(options_.getSkipXMLChecks());
+
+    // meta data only (a fast pass which does not decode any binary data)
+    MzMLFile f;
+    PeakFileOptions meta_options(options_);
+    meta_options.setFillData(false);
+    f.setOptions(meta_options);
+    f.load(filename, exp);
+
+    if (!options_.getFillData())
+    {
+      return true;
+    }
+
+    fillDataParallel(index, index.getNrSpectra(), exp.getSpectra(), options_.getSortSpectraByMZ(), filename,
+      [](Internal::IndexedMzMLHandler& h, int id, MSSpectrum& s) { h.getMSSpectrumById(id, s); },
+      [](Internal::IndexedMzMLHandler& h, const String& id, MSSpectrum& s) { h.getMSSpectrumByNativeId(id, s); });
+
+    fillDataParallel(index, index.getNrChromatograms(), exp.getChromatograms(), options_.getSortChromatogramsByRT(), filename,
+      [](Internal::IndexedMzMLHandler& h, int id, MSChromatogram& c) { h.getMSChromatogramById(id, c); },
+      [](Internal::IndexedMzMLHandler& h, const String& id, MSChromatogram& c) { h.getMSChromatogramByNativeId(id, c); });
+    return true;
+  }
+
   void IndexedMzMLFileLoader::store(const String& filename, OnDiscPeakMap& exp)
   {
     // Create a writing data consumer which consumes the experiment (writes it to disk)
@@ -73,18 +73,12 @@ namespace OpenMS
   void MSNumpressCoder::decodeNP(const String & in, std::vector<double> & out,
       bool zlib_compression, const NumpressConfig & config)
   {
-    QByteArray base64_uncompressed;
-    Base64::decodeSingleString(in, base64_uncompressed, zlib_compression);
-
-    // Create a temporary string (*not* null-terminated) to hold the data
-    std::string tmpstring(base64_uncompressed.constData(), base64_uncompressed.size());
-    decodeNPRaw(tmpstring, out, config);
-
-    // NOTE: it is possible (and likely faster) to call directly the const
-    // unsigned char * function but this would make it necessary to deal with
-    // reinterpret_cast ugliness here ... 
-    //
-    // decodeNP_internal_(reinterpret_cast<const unsigned char*>(base64_uncompressed.constData()), base64_uncompressed.size(), out, config);
+    // Decode (and inflate) into a buffer that is reused across calls of the
+    // same thread and hand the raw bytes directly to the numpress decoder,
+    // no intermediate strings are created
+    thread_local std::vector<Byte> base64_uncompressed;
+    Base64::decodeBytes(in.c_str(), in.size(), base64_uncompressed, zlib_compression);
+    decodeNPInternal_(base64_uncompressed.data(), base64_uncompressed.size(), out, config);
   }
 
   void MSNumpressCoder::encodeNPRaw(const std::vector<double>& in, String& result, const NumpressConfig & config)
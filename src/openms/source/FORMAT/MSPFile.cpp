@@ -35,10 +35,13 @@
 #include <OpenMS/FORMAT/MSPFile.h>
 
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
 #include <fstream>
+#include <sstream>
 #include <regex>
 #include <map>
 
@@ -76,6 +79,38 @@ namespace OpenMS
   MSPFile::~MSPFile() = default;
 
   void MSPFile::load(const String & filename, vector<PeptideIdentification> & ids, PeakMap & exp)
+  {
+    exp.reset();
+
+    //set DocumentIdentifier
+    exp.setLoadedFileType(filename);
+    exp.setLoadedFilePath(filename);
+
+    readChunks_(filename, [&ids, &exp](vector<PeptideIdentification>& chunk_ids, vector<PeakSpectrum>& chunk_spectra, const vector<Size>& /* spectrum_to_id */)
+    {
+      ids.insert(ids.end(), std::make_move_iterator(chunk_ids.begin()), std::make_move_iterator(chunk_ids.end()));
+      for (PeakSpectrum& spec : chunk_spectra)
+      {
+        exp.addSpectrum(std::move(spec));
+      }
+    });
+  }
+
+  void MSPFile::load(const String & filename, const std::function<void(PeptideIdentification&, PeakSpectrum&)>& consume)
+  {
+    readChunks_(filename, [&consume](vector<PeptideIdentification>& chunk_ids, vector<PeakSpectrum>& chunk_spectra, const vector<Size>& spectrum_to_id)
+    {
+      for (Size i = 0; i < chunk_spectra.size(); ++i)
+      {
+        if (spectrum_to_id[i] < chunk_ids.size())
+        {
+          consume(chunk_ids[spectrum_to_id[i]], chunk_spectra[i]);
+        }
+      }
+    });
+  }
+
+  void MSPFile::readChunks_(const String & filename, const std::function<void(vector<PeptideIdentification>&, vector<PeakSpectrum>&, const vector<Size>&)>& consume_chunk)
   {
     if (!File::exists(filename))
     {
@@ -86,6 +121,89 @@ namespace OpenMS
       throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
     }
 
+    ifstream is(filename.c_str());
+
+    // Entries (starting with "Name:") are collected sequentially into chunks, which are parsed in parallel.
+    // For each chunk, the line number and spectrum number of its first line are recorded, so that native IDs
+    // and error messages are the same as for sequential parsing.
+    const Size entries_per_chunk = 256;
+    const Size chunks_per_batch = 64;
+    struct Chunk
+    {
+      std::string text;
+      Size line_number = 0; // line number before the first line of the chunk
+      Size spectrum_number = 0; // spectrum number of the first spectrum in the chunk
+      Size n_entries = 0;
+      vector<PeptideIdentification> ids;
+      vector<PeakSpectrum> spectra;
+      vector<Size> spectrum_to_id;
+    };
+
+    String line;
+    Size line_number = 0;
+    Size spectrum_number = 0;
+    vector<Chunk> chunks;
+    Chunk current;
+    bool more = true;
+    while (more)
+    {
+      chunks.clear();
+      while (chunks.size() < chunks_per_batch)
+      {
+        more = static_cast<bool>(getline(is, line));
+        if (!more)
+        {
+          if (!current.text.empty())
+          {
+            chunks.push_back(std::move(current));
+          }
+          break;
+        }
+        if (line.hasPrefix("Name:") && ++current.n_entries > entries_per_chunk)
+        {
+          chunks.push_back(std::move(current));
+          current = Chunk();
+          current.line_number = line_number;
+          current.spectrum_number = spectrum_number;
+          current.n_entries = 1;
+        }
+        ++line_number;
+        if (line.hasPrefix("Num peaks:") || line.hasPrefix("NumPeaks:"))
+        {
+          ++spectrum_number;
+        }
+        current.text.append(line).push_back('\n');
+      }
+
+      const SignedSize n = static_cast<SignedSize>(chunks.size());
+      vector<std::exception_ptr> errors(chunks.size());
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize i = 0; i < n; ++i)
+      {
+        try
+        {
+          std::istringstream chunk_is(chunks[i].text);
+          parseEntries_(chunk_is, chunks[i].line_number, chunks[i].spectrum_number, chunks[i].ids, chunks[i].spectra, chunks[i].spectrum_to_id);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      }
+      // report the first error in file order, as the sequential reader did
+      for (const std::exception_ptr& error : errors)
+      {
+        if (error) std::rethrow_exception(error);
+      }
+      for (Chunk& chunk : chunks)
+      {
+        consume_chunk(chunk.ids, chunk.spectra, chunk.spectrum_to_id);
+      }
+    }
+  }
+
+  void MSPFile::parseEntries_(std::istream & is, Size line_number, Size spectrum_number, vector<PeptideIdentification> & ids, vector<PeakSpectrum> & spectra, vector<Size> & spectrum_to_id)
+  {
     // groups everything inside the shortest pair of parentheses
     const std::regex rex(R"(\((.*?)\))");
     // matches 2+ whitespaces or tabs or returns "   ", "\t", "\r"
@@ -93,15 +211,6 @@ namespace OpenMS
     // TODO choose a format during construction of the class. If we actually knew how to call and define them.
     const std::regex ws_rex(R"(\s{2,}|\t|\r)");
 
-    exp.reset();
-
-    //set DocumentIdentifier
-    exp.setLoadedFileType(filename);
-    exp.setLoadedFilePath(filename);
-
-    String line;
-    ifstream is(filename.c_str());
-
     std::map<String, String> modname_to_unimod;
     modname_to_unimod["Pyro-glu"] = "Gln->pyro-Glu";
     modname_to_unimod["CAM"] = "Carbamidomethyl";
@@ -114,12 +223,9 @@ namespace OpenMS
     std::string instrument((std::string)param_.getValue("instrument"));
     bool inst_type_correct(true);
     [[maybe_unused]] bool spectrast_format(false); // TODO: implement usage
-    Size spectrum_number = 0;
 
     PeakSpectrum spec;
-
-    // line number counter
-    Size line_number = 0;
+    String line;
 
     while (getline(is, line))
     {
@@ -290,7 +396,7 @@ namespace OpenMS
                                           line, R"(not <mz><tab/spaces><intensity><tab/spaces>"<annotation>"<tab/spaces>"<comment>" in line )" + String(line_number));
             }
             Peak1D peak;
-            float mz = String(iter->str()).toFloat();
+            float mz = StringView(line.data() + (iter->first - line.begin()), iter->length()).toFloat();
             peak.setMZ(mz);
             ++iter;
             if (iter == end)
@@ -298,7 +404,7 @@ namespace OpenMS
               throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
                                           line, R"(not <mz><tab/spaces><intensity><tab/spaces>"<annotation>"<tab/spaces>"<comment>" in line )" + String(line_number));
             }
-            float ity = String(iter->str()).toFloat();
+            float ity = StringView(line.data() + (iter->first - line.begin()), iter->length()).toFloat();
             peak.setIntensity(ity);
             ++iter;
             if (parse_peakinfo && iter != end)
@@ -339,7 +445,8 @@ namespace OpenMS
           }
           hitToAnnotate.setPeakAnnotations(annots);
           spec.setNativeID(String("index=") + spectrum_number);
-          exp.addSpectrum(spec);
+          spectrum_to_id.push_back(ids.size() - 1);
+          spectra.push_back(spec);
           // clear spectrum
           spec.clear(true);
         }
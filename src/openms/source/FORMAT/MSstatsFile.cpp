@@ -34,8 +34,10 @@
 
 #include <OpenMS/FORMAT/MSstatsFile.h>
 
+#include <OpenMS/KERNEL/FlatConsensusMap.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <map>
 #include <tuple>
 
 using namespace std;
@@ -85,35 +87,52 @@ MSstatsFile::AggregatedConsensusInfo MSstatsFile::aggregateInfo_(const Consensus
   MSstatsFile::AggregatedConsensusInfo aggregatedInfo; //results
   const auto &column_headers = consensus_map.getColumnHeaders(); // needed for label_id
 
-  for (const ConsensusFeature &consensus_feature : consensus_map)
+  // label of each map: resolved once instead of a lookup per feature handle
+  std::map<UInt64, unsigned> map_labels;
+  for (const auto& column : column_headers)
   {
+    // Get the label_id from the file description MetaValue
+    if (column.second.metaValueExists("channel_id"))
+    {
+      map_labels[column.first] = Int(column.second.getMetaValue("channel_id"));
+    }
+    else
+    {
+      // label id 1 is used in case the experimental design specifies a LFQ experiment
+      //TODO Not really, according to the if-case it only cares about the metavalue.
+      // which could be missing due to other reasons
+      map_labels[column.first] = 1u;
+    }
+  }
+
+  const FlatConsensusMap flat(consensus_map);
+  aggregatedInfo.consensus_feature_labels.reserve(flat.size());
+  aggregatedInfo.consensus_feature_filenames.reserve(flat.size());
+  aggregatedInfo.consensus_feature_intensities.reserve(flat.size());
+  aggregatedInfo.consensus_feature_retention_times.reserve(flat.size());
+  aggregatedInfo.features.reserve(flat.size());
+  for (Size i = 0; i < flat.size(); ++i)
+  {
+    const ConsensusFeature& consensus_feature = consensus_map[i];
+    const Size n = flat.elementsEnd(i) - flat.elementsBegin(i);
 
     vector<String> filenames;
     vector<MSstatsFile::Intensity> intensities;
     vector<MSstatsFile::Coordinate> retention_times;
     vector<unsigned> cf_labels;
+    filenames.reserve(n);
+    intensities.reserve(n);
+    retention_times.reserve(n);
+    cf_labels.reserve(n);
 
     // Store the file names and the run intensities of this feature
-    const ConsensusFeature::HandleSetType& fs(consensus_feature.getFeatures());
-    for (const auto& feat : fs)
+    for (Size e = flat.elementsBegin(i); e < flat.elementsEnd(i); ++e)
     {
-      filenames.push_back(spectra_paths[feat.getMapIndex()]);
-      intensities.push_back(feat.getIntensity());
-      retention_times.push_back(feat.getRT());
-
-      // Get the label_id from the file description MetaValue
-      auto &column = column_headers.at(feat.getMapIndex());
-      if (column.metaValueExists("channel_id"))
-      {
-        cf_labels.push_back(Int(column.getMetaValue("channel_id")));
-      }
-      else
-      {
-        // label id 1 is used in case the experimental design specifies a LFQ experiment
-        //TODO Not really, according to the if-case it only cares about the metavalue.
-        // which could be missing due to other reasons
-        cf_labels.push_back(1u);
-      }
+      const UInt64 map_index = flat.getMapIndex(e);
+      filenames.push_back(spectra_paths[map_index]);
+      intensities.push_back(flat.getIntensity(e));
+      retention_times.push_back(flat.getRT(e));
+      cf_labels.push_back(map_labels.at(map_index));
     }
     aggregatedInfo.consensus_feature_labels.push_back(cf_labels);
     aggregatedInfo.consensus_feature_filenames.push_back(filenames);
@@ -303,8 +322,36 @@ void MSstatsFile::storeLFQ(const String& filename,
     throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The filenames (extension ignored) in the consensusXML file are not the same as in the experimental design");
   }
 
-  // Extract information from the consensus features.
-  MSstatsFile::AggregatedConsensusInfo aggregatedInfo = MSstatsFile::aggregateInfo_(consensus_map, spectra_paths);
+  // The design lookups of a map are the same for all its feature handles, so they are resolved once per map
+  // while walking the consensus map (instead of copying all features and handles into intermediate vectors first).
+  const ConsensusMap::ColumnHeaders& column_headers = consensus_map.getColumnHeaders();
+  std::vector<MapDesignInfo_> map_design_info(spectra_paths.size());
+  auto resolveMapDesignInfo = [&](UInt64 map_index) -> const MapDesignInfo_&
+  {
+    MapDesignInfo_& info = map_design_info.at(map_index);
+    if (!info.resolved)
+    {
+      // label id 1 is used in case the experimental design specifies a LFQ experiment
+      const ConsensusMap::ColumnHeader& column = column_headers.at(map_index);
+      const unsigned label = column.metaValueExists("channel_id") ? unsigned(Int(column.getMetaValue("channel_id"))) : 1u;
+
+      info.filename = spectra_paths[map_index];
+      const pair< String, unsigned> tpl1 = make_pair(info.filename, label);
+      const unsigned sample = path_label_to_sample[tpl1];
+      const unsigned fraction = path_label_to_fraction[tpl1];
+
+      // Resolve run
+      const pair< String, unsigned> tpl2 = make_pair(info.filename, fraction);
+      const unsigned run = run_map[tpl2];  // MSstats run according to the file table
+      info.run_string = String(run);
+      info.fraction_string = has_fraction ? String(fraction) : "";
+      info.condition = sampleSection.getFactorValue(sample, condition);
+      info.bioreplicate = sampleSection.getFactorValue(sample, bioreplicate);
+      msstats_run_to_openms_fractiongroup[run] = path_label_to_fractiongroup[tpl1];
+      info.resolved = true;
+    }
+    return info;
+  };
 
   // The output file of the MSstats converter
   TextFile csv_out;
@@ -365,11 +412,9 @@ void MSstatsFile::storeLFQ(const String& filename,
   // - We also need to map to the intensities, such that we combine intensities over multiple retention times.
   map< String, map< MSstatsLine_, set< tuple<Intensity, Coordinate, String> > > > peptideseq_to_prefix_to_intensities;
 
-  for (Size i = 0; i < aggregatedInfo.features.size(); ++i)
+  for (const ConsensusFeature& consensus_feature : consensus_map)
   {
-    const BaseFeature &base_feature = aggregatedInfo.features[i];
-
-    for (const PeptideIdentification &pep_id : base_feature.getPeptideIdentifications())
+    for (const PeptideIdentification &pep_id : consensus_feature.getPeptideIdentifications())
     {
       for (const PeptideHit & pep_hit : pep_id.getHits())
       {
@@ -414,23 +459,11 @@ void MSstatsFile::storeLFQ(const String& filename,
           accession = na_string_; //shouldn't really matter since we skip unquantifiable peptides
         }
         // Write new line for each run
-        for (Size j = 0; j < aggregatedInfo.consensus_feature_filenames[i].size(); j++)
+        for (const FeatureHandle& feature_handle : consensus_feature.getFeatures())
         {
-          const String &current_filename = aggregatedInfo.consensus_feature_filenames[i][j];
-          const Intensity intensity(aggregatedInfo.consensus_feature_intensities[i][j]);
-          const Coordinate retention_time(aggregatedInfo.consensus_feature_retention_times[i][j]);
-          const unsigned label(aggregatedInfo.consensus_feature_labels[i][j]);
-
-          const pair< String, unsigned> tpl1 = make_pair(current_filename, label);
-          const unsigned sample = path_label_to_sample[tpl1];
-          const unsigned fraction = path_label_to_fraction[tpl1];
-
-          const pair< String, unsigned> tpl2 = make_pair(current_filename, fraction);
-
-          // Resolve run
-          const unsigned run = run_map[tpl2];  // MSstats run according to the file table
-          const unsigned openms_fractiongroup = path_label_to_fractiongroup[tpl1];
-          msstats_run_to_openms_fractiongroup[run] = openms_fractiongroup;
+          const MapDesignInfo_& info = resolveMapDesignInfo(feature_handle.getMapIndex());
+          const Intensity intensity(feature_handle.getIntensity());
+          const Coordinate retention_time(feature_handle.getRT());
 
           // Assemble MSstats line
           //TODO since a lot of cols are constant in DDA LFQ, we could reduce the prefix and add the constant
@@ -443,12 +476,12 @@ void MSstatsFile::storeLFQ(const String& filename,
                   fragment_ion,
                   frag_charge,
                   isotope_label_type,
-                  sampleSection.getFactorValue(sample, condition),
-                  sampleSection.getFactorValue(sample, bioreplicate),
-                  String(run),
-                  (has_fraction ? String(fraction) : "")
+                  info.condition,
+                  info.bioreplicate,
+                  info.run_string,
+                  info.fraction_string
           );
-          tuple<Intensity, Coordinate, String> intensity_retention_time = make_tuple(intensity, retention_time, current_filename);
+          tuple<Intensity, Coordinate, String> intensity_retention_time = make_tuple(intensity, retention_time, info.filename);
           peptideseq_to_prefix_to_intensities[sequence][prefix].insert(intensity_retention_time);
         }
       }
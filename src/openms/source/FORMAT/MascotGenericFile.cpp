@@ -432,6 +432,29 @@ namespace OpenMS
     }
   }
 
+  void MascotGenericFile::transform(const String& filename, Interfaces::IMSDataConsumer* consumer, bool skip_full_count)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    Size scount = 0;
+    if (!skip_full_count)
+    {
+      std::ifstream is(filename.c_str());
+      String line;
+      while (getline(is, line, '\n'))
+      {
+        if (line.trim() == "BEGIN IONS") ++scount;
+      }
+    }
+    consumer->setExpectedSize(scount, 0);
+    consumer->setExperimentalSettings(ExperimentalSettings());
+
+    readSpectra_<MSSpectrum>(filename, [consumer](MSSpectrum& spectrum) { consumer->consumeSpectrum(spectrum); });
+  }
+
   std::pair<String, String> MascotGenericFile::getHTTPPeakListEnclosure(const String& filename) const
   {
     std::pair<String, String> r;
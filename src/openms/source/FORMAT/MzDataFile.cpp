@@ -72,8 +72,7 @@ namespace OpenMS
     CVMappingFile().load(File::find("/MAPPING/mzdata-mapping.xml"), mapping);
 
     //load cvs
-    ControlledVocabulary cv;
-    cv.loadFromOBO("PSI", File::find("/CV/psi-mzdata.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({{"PSI", "/CV/psi-mzdata.obo"}});
 
     //validate
     Internal::MzDataValidator v(mapping, cv);
@@ -38,6 +38,7 @@
 #include <OpenMS/FORMAT/CVMappingFile.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLHandler.h>
 #include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLSAXHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
@@ -55,8 +56,18 @@ namespace OpenMS
 
   void MzIdentMLFile::load(const String& filename, std::vector<ProteinIdentification>& poid, std::vector<PeptideIdentification>& peid)
   {
-    Internal::MzIdentMLDOMHandler handler(poid, peid, schema_version_, *this);
-    handler.readMzIdentMLFile(filename);
+    const Size pro_size = poid.size();
+    const Size pep_size = peid.size();
+    Internal::MzIdentMLSAXHandler handler(poid, peid, filename, schema_version_, *this);
+    parse_(filename, &handler);
+    if (handler.isCrossLinkingSearch())
+    {
+      // XL-MS results are only supported by the DOM handler (nothing was appended yet, but be safe)
+      poid.erase(poid.begin() + pro_size, poid.end());
+      peid.erase(peid.begin() + pep_size, peid.end());
+      Internal::MzIdentMLDOMHandler dom_handler(poid, peid, schema_version_, *this);
+      dom_handler.readMzIdentMLFile(filename);
+    }
   }
 
   void MzIdentMLFile::store(const String& filename, const Identification& id) const
@@ -42,6 +42,7 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <sstream>
 
@@ -159,6 +160,7 @@ namespace OpenMS
 
   void MzMLFile::load(const String& filename, PeakMap& map)
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::load");
     map.reset();
 
     //set DocumentIdentifier
@@ -168,10 +170,15 @@ namespace OpenMS
     Internal::MzMLHandler handler(map, filename, getVersion(), *this);
     handler.setOptions(options_);
     safeParse_(filename, &handler);
+    Profiler::addCounter("spectra", map.size());
+    Profiler::addCounter("chromatograms", map.getNrChromatograms());
   }
 
   void MzMLFile::store(const String& filename, const PeakMap& map) const
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::store");
+    Profiler::addCounter("spectra", map.size());
+    Profiler::addCounter("chromatograms", map.getNrChromatograms());
     Internal::MzMLHandler handler(map, filename, getVersion(), *this);
     handler.setOptions(options_);
     save_(filename, &handler);
@@ -75,9 +75,9 @@ namespace OpenMS
     using json = nlohmann::ordered_json;
     json quality_metrics = {};
 
-    ControlledVocabulary cv;
-    cv.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-    cv.loadFromOBO("QC", File::find("/CV/qc-cv.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({
+      {"PSI-MS", "/CV/psi-ms.obo"},
+      {"QC", "/CV/qc-cv.obo"}});
 
     QCBase::Status status;
     if (!input_file.empty())
@@ -2949,27 +2949,23 @@ namespace OpenMS
    
     Size n_best_search_engine_score = meta_data.protein_search_engine_score.size();
 
-    {
-      MzTabProteinSectionRow row;
-      bool first = true;
-      size_t n_header_columns = 0;
-      while (s.nextPRTRow(row))
-      {
-        if (first)
-        { // add header
-          tab_file << "\n" << generateMzTabProteinHeader_(
-            row,
-            n_best_search_engine_score,
-            s.getProteinOptionalColumnNames(),
-            meta_data,
-            n_header_columns) + "\n";
-          first = false;
-        }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
-      }
-    }
+    writeMzTabSectionStreamed_<MzTabProteinSectionRow>(
+      tab_file,
+      [&s](MzTabProteinSectionRow& row) { return s.nextPRTRow(row); },
+      [&](const MzTabProteinSectionRow& row)
+      { // add header
+        size_t n_header_columns = 0;
+        tab_file << "\n" << generateMzTabProteinHeader_(
+          row,
+          n_best_search_engine_score,
+          s.getProteinOptionalColumnNames(),
+          meta_data,
+          n_header_columns) + "\n";
+        return n_header_columns;
+      },
+      s.getProteinOptionalColumnNames(),
+      meta_data,
+      "Protein");
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
 
@@ -2978,22 +2974,18 @@ namespace OpenMS
       OPENMS_LOG_WARN << "No search engine scores given. Please check your input data." << endl;
     }
 
-    {
-      MzTabPSMSectionRow row;
-      bool first = true;
-      size_t n_header_columns = 0;
-      while (s.nextPSMRow(row))
-      {
-        if (first)
-        { // add header
-          tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
-          first = false;
-        }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
-      }
-    }
+    writeMzTabSectionStreamed_<MzTabPSMSectionRow>(
+      tab_file,
+      [&s](MzTabPSMSectionRow& row) { return s.nextPSMRow(row); },
+      [&](const MzTabPSMSectionRow&)
+      { // add header
+        size_t n_header_columns = 0;
+        tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
+        return n_header_columns;
+      },
+      s.getPSMOptionalColumnNames(),
+      meta_data,
+      "PSM");
 
     tab_file.close();
     
@@ -3041,58 +3033,46 @@ namespace OpenMS
     Size n_best_search_engine_score = meta_data.protein_search_engine_score.size();
     // TODO: we currently only store one search engine score per PSM so we need to limit the number to the main score
     n_best_search_engine_score = std::min(n_best_search_engine_score, Size(1));
-    {
-      MzTabProteinSectionRow row;
-      bool first = true;
-      size_t n_header_columns = 0;
-      while (s.nextPRTRow(row))
-      {
-        if (first)
-        { // add header
-          tab_file << "\n" << generateMzTabProteinHeader_(
-            row,
-            n_best_search_engine_score,
-            s.getProteinOptionalColumnNames(),
-            meta_data, 
-            n_header_columns) + "\n";
-          first = false;
-        }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
-      }
-    }
+    writeMzTabSectionStreamed_<MzTabProteinSectionRow>(
+      tab_file,
+      [&s](MzTabProteinSectionRow& row) { return s.nextPRTRow(row); },
+      [&](const MzTabProteinSectionRow& row)
+      { // add header
+        size_t n_header_columns = 0;
+        tab_file << "\n" << generateMzTabProteinHeader_(
+          row,
+          n_best_search_engine_score,
+          s.getProteinOptionalColumnNames(),
+          meta_data,
+          n_header_columns) + "\n";
+        return n_header_columns;
+      },
+      s.getProteinOptionalColumnNames(),
+      meta_data,
+      "Protein");
 
     Size assays(0);
     Size study_variables(0);
-    {
-      MzTabPeptideSectionRow row;
-      bool first = true;
-      size_t n_header_columns = 0;
-      while (s.nextPEPRow(row))
-      {
-        if (first)
-        {
-          assays = row.peptide_abundance_assay.size();
-          study_variables = row.peptide_abundance_study_variable.size();
-          Size n_search_engine_score = row.search_engine_score_ms_run.size(); // scores to runs          
-          Size search_ms_runs = n_search_engine_score != 0 ? row.search_engine_score_ms_run.at(1).size() : 0; // take number of searched MS runs from first score. TODO: handle this more generic
-          OPENMS_LOG_DEBUG << "Exporting assays: " << assays << endl;
-          OPENMS_LOG_DEBUG << "Exporting study variables: " << study_variables << endl;
-          OPENMS_LOG_DEBUG << "Exporting search engines scores: " << n_search_engine_score << endl;
-          Size n_best_search_engine_score = row.best_search_engine_score.size();
-          tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns) + "\n";
-          first = false;
-        }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPeptideOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)
-        {
-          OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns << endl;
-          throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peptide header and content differs in columns. Please report this bug to the OpenMS developers.");
-        }
-      }
-    } 
+    writeMzTabSectionStreamed_<MzTabPeptideSectionRow>(
+      tab_file,
+      [&s](MzTabPeptideSectionRow& row) { return s.nextPEPRow(row); },
+      [&](const MzTabPeptideSectionRow& row)
+      { // add header
+        assays = row.peptide_abundance_assay.size();
+        study_variables = row.peptide_abundance_study_variable.size();
+        Size n_search_engine_score = row.search_engine_score_ms_run.size(); // scores to runs
+        Size search_ms_runs = n_search_engine_score != 0 ? row.search_engine_score_ms_run.at(1).size() : 0; // take number of searched MS runs from first score. TODO: handle this more generic
+        OPENMS_LOG_DEBUG << "Exporting assays: " << assays << endl;
+        OPENMS_LOG_DEBUG << "Exporting study variables: " << study_variables << endl;
+        OPENMS_LOG_DEBUG << "Exporting search engines scores: " << n_search_engine_score << endl;
+        Size n_best_search_engine_score = row.best_search_engine_score.size();
+        size_t n_header_columns = 0;
+        tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns) + "\n";
+        return n_header_columns;
+      },
+      s.getPeptideOptionalColumnNames(),
+      meta_data,
+      "Peptide");
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
 
@@ -3101,25 +3081,20 @@ namespace OpenMS
       OPENMS_LOG_WARN << "No search engine scores given. Please check your input data." << endl;
     }
 
-    {
-      MzTabPSMSectionRow row;
-      bool first = true;
-
-      // TODO: we currently only store one search engine score per PSM so we need to limit the number to the main score      
-      n_search_engine_scores = 1;
-      size_t n_header_columns = 0;
-      while (s.nextPSMRow(row))
-      {
-        if (first)
-        { // add header
-          tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
-          first = false;
-        }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
-      }
-    }
+    // TODO: we currently only store one search engine score per PSM so we need to limit the number to the main score
+    n_search_engine_scores = 1;
+    writeMzTabSectionStreamed_<MzTabPSMSectionRow>(
+      tab_file,
+      [&s](MzTabPSMSectionRow& row) { return s.nextPSMRow(row); },
+      [&](const MzTabPSMSectionRow&)
+      { // add header
+        size_t n_header_columns = 0;
+        tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
+        return n_header_columns;
+      },
+      s.getPSMOptionalColumnNames(),
+      meta_data,
+      "PSM");
 
     tab_file.close();
   }
@@ -202,9 +202,8 @@ namespace OpenMS
     // meta_software.setting[0] (not mandatory)
 
     MzTabSoftwareMetaData meta_software;
-    ControlledVocabulary cv;
+    const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({{"PSI-MS", "/CV/psi-ms.obo"}});
     MzTabString reliability = MzTabString("2"); // initialize at 2 (should be valid for all tools - putatively annotated compound)
-    cv.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
     for (const auto& software : id_data.getProcessingSoftwares())
     {
       if (software.metaValueExists("reliability"))
@@ -60,6 +60,12 @@ namespace OpenMS
     helper.load(id_data);
   }
 
+  void OMSFile::load(const String& filename, IdentificationData& id_data, const LoadSelection& selection)
+  {
+    OpenMS::Internal::OMSFileLoad helper(filename, log_type_);
+    helper.load(id_data, selection);
+  }
+
   void OMSFile::load(const String& filename, FeatureMap& features)
   {
     OpenMS::Internal::OMSFileLoad helper(filename, log_type_);
@@ -239,6 +239,7 @@ namespace OpenMS::Internal
   bool OMSFileLoad::prepareQueryMetaInfo_(QSqlQuery& query,
                                           const String& parent_table)
   {
+    if (!selection_.meta_info) return false;
     String table_name = parent_table + "_MetaInfo";
     if (!tableExists_(db_name_, table_name)) return false;
 
@@ -454,7 +455,12 @@ namespace OpenMS::Internal
     QSqlDatabase db = QSqlDatabase::database(db_name_);
     QSqlQuery query(db);
     query.setForwardOnly(true);
-    if (!query.exec("SELECT * FROM ID_Observation"))
+    QString sql_select = "SELECT * FROM ID_Observation";
+    if (!match_subset_.isEmpty())
+    {
+      sql_select += " WHERE id IN (SELECT observation_id FROM (" + match_subset_ + "))";
+    }
+    if (!query.exec(sql_select))
     {
       raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
                     "error reading from database");
@@ -487,7 +493,7 @@ namespace OpenMS::Internal
     QSqlDatabase db = QSqlDatabase::database(db_name_);
     QSqlQuery query(db);
     query.setForwardOnly(true);
-    if (!query.exec("SELECT * FROM ID_ParentSequence"))
+    if (!query.exec("SELECT * FROM ID_ParentSequence ORDER BY id" + pagingClause_()))
     {
       raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
                     "error reading from database");
@@ -625,6 +631,10 @@ namespace OpenMS::Internal
     QString sql_select =
       "SELECT * FROM ID_IdentifiedMolecule JOIN ID_IdentifiedCompound " \
       "ON ID_IdentifiedMolecule.id = ID_IdentifiedCompound.molecule_id";
+    if (!match_subset_.isEmpty())
+    {
+      sql_select += " WHERE ID_IdentifiedMolecule.id IN (SELECT identified_molecule_id FROM (" + match_subset_ + "))";
+    }
     if (!query.exec(sql_select))
     {
       raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
@@ -672,8 +682,9 @@ namespace OpenMS::Internal
     }
     while (query.next())
     {
-      ID::ParentSequenceRef ref =
-        parent_refs_[query.value("parent_id").toLongLong()];
+      auto pos = parent_refs_.find(query.value("parent_id").toLongLong());
+      if (pos == parent_refs_.end()) continue; // parent sequence not loaded
+      ID::ParentSequenceRef ref = pos->second;
       ID::ParentMatch match;
       QVariant start_pos = query.value("start_pos");
       QVariant end_pos = query.value("end_pos");
@@ -693,8 +704,13 @@ namespace OpenMS::Internal
     QSqlDatabase db = QSqlDatabase::database(db_name_);
     QSqlQuery query(db);
     query.setForwardOnly(true);
-    query.prepare("SELECT * FROM ID_IdentifiedMolecule "          \
-                  "WHERE molecule_type_id = :molecule_type_id");
+    QString sql_select = "SELECT * FROM ID_IdentifiedMolecule "  \
+      "WHERE molecule_type_id = :molecule_type_id";
+    if (!match_subset_.isEmpty())
+    {
+      sql_select += " AND id IN (SELECT identified_molecule_id FROM (" + match_subset_ + "))";
+    }
+    query.prepare(sql_select);
     // @TODO: can we combine handling of meta info and applied processing steps?
     QSqlQuery subquery_info(db);
     bool have_meta_info = prepareQueryMetaInfo_(subquery_info,
@@ -704,8 +720,8 @@ namespace OpenMS::Internal
       prepareQueryAppliedProcessingStep_(subquery_step,
                                          "ID_IdentifiedMolecule");
     QSqlQuery subquery_parent(db);
-    bool have_parent_matches = tableExists_(db_name_,
-                                            "ID_ParentMatch");
+    bool have_parent_matches = selection_.parent_sequences &&
+      tableExists_(db_name_, "ID_ParentMatch");
     if (have_parent_matches)
     {
       subquery_parent.setForwardOnly(true);
@@ -831,7 +847,7 @@ namespace OpenMS::Internal
     QSqlDatabase db = QSqlDatabase::database(db_name_);
     QSqlQuery query(db);
     query.setForwardOnly(true);
-    if (!query.exec("SELECT * FROM ID_ObservationMatch"))
+    if (!query.exec(match_subset_.isEmpty() ? QString("SELECT * FROM ID_ObservationMatch") : match_subset_))
     {
       raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
                     "error reading from database");
@@ -845,7 +861,7 @@ namespace OpenMS::Internal
       prepareQueryAppliedProcessingStep_(subquery_step,
                                          "ID_ObservationMatch");
     QSqlQuery subquery_ann(db);
-    bool have_peak_annotations =
+    bool have_peak_annotations = selection_.peak_annotations &&
       tableExists_(db_name_, "ID_ObservationMatch_PeakAnnotation");
     if (have_peak_annotations)
     {
@@ -886,8 +902,35 @@ namespace OpenMS::Internal
   }
 
 
+  QString OMSFileLoad::pagingClause_() const
+  {
+    if ((selection_.limit == 0) && (selection_.offset == 0)) return "";
+    // in SQLite, a negative limit means "no limit":
+    qint64 limit = (selection_.limit == 0) ? -1 : qint64(selection_.limit);
+    return " LIMIT " + QString::number(limit) + " OFFSET " +
+      QString::number(qint64(selection_.offset));
+  }
+
+
   void OMSFileLoad::load(IdentificationData& id_data)
   {
+    load(id_data, OMSFile::LoadSelection());
+  }
+
+
+  void OMSFileLoad::load(IdentificationData& id_data,
+                         const OMSFile::LoadSelection& selection)
+  {
+    selection_ = selection;
+    bool paged = (selection_.limit > 0) || (selection_.offset > 0);
+    // restrict dependent tables to what the selected matches refer to:
+    match_subset_.clear();
+    if (selection_.observation_matches && paged)
+    {
+      match_subset_ = "SELECT * FROM ID_ObservationMatch ORDER BY id" +
+        pagingClause_();
+    }
+
     startProgress(0, 12, "Reading identification data from file");
     loadInputFiles_(id_data);
     nextProgress();
@@ -899,19 +942,20 @@ namespace OpenMS::Internal
     nextProgress();
     loadProcessingSteps_(id_data);
     nextProgress();
-    loadObservations_(id_data);
+    if (selection_.observation_matches) loadObservations_(id_data);
     nextProgress();
-    loadParentSequences_(id_data);
+    if (selection_.parent_sequences) loadParentSequences_(id_data);
     nextProgress();
-    loadParentGroupSets_(id_data);
+    // groups may refer to any parent sequence, so they require all of them:
+    if (selection_.parent_sequences && !paged) loadParentGroupSets_(id_data);
     nextProgress();
-    loadIdentifiedCompounds_(id_data);
+    if (selection_.observation_matches) loadIdentifiedCompounds_(id_data);
     nextProgress();
-    loadIdentifiedSequences_(id_data);
+    if (selection_.observation_matches) loadIdentifiedSequences_(id_data);
     nextProgress();
     loadAdducts_(id_data);
     nextProgress();
-    loadObservationMatches_(id_data);
+    if (selection_.observation_matches) loadObservationMatches_(id_data);
     endProgress();
     // @TODO: load input match groups
   }
@@ -373,49 +373,68 @@ namespace OpenMS::Internal
     // @TODO: add constraint that "processing_step_id" and "score_type_id" can't both be NULL
     // @TODO: add constraint that "processing_step_order" must match "..._id"?
     // @TODO: normalize table? (splitting into multiple tables is awkward here)
-    // prepare query for inserting data:
-    QSqlQuery query(QSqlDatabase::database(db_name_));
-    query.prepare("INSERT INTO " + table.toQString() + " VALUES ("  \
-                  ":parent_id, "                                    \
-                  ":processing_step_id, "                           \
-                  ":processing_step_order, "                        \
-                  ":score_type_id, "                                \
-                  ":score)");
-    prepared_queries_[table] = query;
+    // data is inserted in bulk via "insertRows_"
   }
 
 
-  void OMSFileStore::storeAppliedProcessingStep_(
-    const ID::AppliedProcessingStep& step, Size step_order,
-    const String& parent_table, Key parent_id)
+  void OMSFileStore::appendAppliedProcessingStep_(
+    const ID::AppliedProcessingStep& step, Size step_order, Key parent_id,
+    vector<QVariant>& values)
   {
-    // this assumes the "..._AppliedProcessingStep" table exists already!
-    QSqlQuery& query = prepared_queries_[parent_table + "_AppliedProcessingStep"];
-    query.bindValue(":parent_id", parent_id);
-    query.bindValue(":processing_step_order", int(step_order));
+    // columns: parent_id, processing_step_id, processing_step_order, score_type_id, score
+    QVariant step_id = QVariant(QVariant::Int); // use NULL for missing processing step reference
     if (step.processing_step_opt)
     {
-      query.bindValue(":processing_step_id",
-                      Key(&(**step.processing_step_opt)));
+      step_id = Key(&(**step.processing_step_opt));
       if (step.scores.empty()) // insert processing step information only
       {
-        query.bindValue(":score_type_id", QVariant(QVariant::Int)); // NULL
-        query.bindValue(":score", QVariant(QVariant::Double)); // NULL
-        if (!query.exec())
-        {
-          raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                        "error inserting data");
-        }
+        values.insert(values.end(), {parent_id, step_id, int(step_order),
+                                     QVariant(QVariant::Int), // NULL
+                                     QVariant(QVariant::Double)}); // NULL
       }
     }
-    else // use NULL for missing processing step reference
+    for (const auto& score_pair : step.scores)
     {
-      query.bindValue(":processing_step_id", QVariant(QVariant::Int));
+      values.insert(values.end(), {parent_id, step_id, int(step_order),
+                                   Key(&(*score_pair.first)),
+                                   score_pair.second});
     }
-    for (const auto& score_pair : step.scores)
+  }
+
+
+  void OMSFileStore::insertRows_(const String& table, Size n_columns,
+                                 const vector<QVariant>& values)
+  {
+    if (values.empty()) return;
+    // SQLite limits the number of parameters per statement (999 in older versions):
+    const Size max_rows = max(Size(1), min(Size(500), 999 / n_columns));
+    const Size n_rows = values.size() / n_columns;
+
+    QString row = "(?";
+    for (Size i = 1; i < n_columns; ++i) row += ", ?";
+    row += ")";
+
+    QSqlQuery query(QSqlDatabase::database(db_name_));
+    Size prepared_rows = 0;
+    for (Size first_row = 0; first_row < n_rows; first_row += max_rows)
     {
-      query.bindValue(":score_type_id", Key(&(*score_pair.first)));
-      query.bindValue(":score", score_pair.second);
+      Size batch_rows = min(max_rows, n_rows - first_row);
+      if (batch_rows != prepared_rows) // full batches share one statement
+      {
+        QString sql_insert = "INSERT INTO " + table.toQString() + " VALUES " + row;
+        for (Size i = 1; i < batch_rows; ++i) sql_insert += ", " + row;
+        if (!query.prepare(sql_insert))
+        {
+          raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
+                        "error preparing query");
+        }
+        prepared_rows = batch_rows;
+      }
+      const Size offset = first_row * n_columns;
+      for (Size i = 0; i < batch_rows * n_columns; ++i)
+      {
+        query.bindValue(int(i), values[offset + i]);
+      }
       if (!query.exec())
       {
         raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
@@ -739,41 +758,18 @@ namespace OpenMS::Internal
                  "UNIQUE (data_id, input_file_id), "                    \
                  "FOREIGN KEY (input_file_id) REFERENCES ID_InputFile (id)");
 
-    QSqlQuery query(QSqlDatabase::database(db_name_));
-    query.prepare("INSERT INTO ID_Observation VALUES (" \
-                  ":id, "                             \
-                  ":data_id, "                        \
-                  ":input_file_id, "                  \
-                  ":rt, "                             \
-                  ":mz)");
-    for (const ID::Observation& obs : id_data.getObservations())
-    {
-      query.bindValue(":id", Key(&obs)); // use address as primary key
-      query.bindValue(":data_id", obs.data_id.toQString());
-      query.bindValue(":input_file_id", Key(&(*obs.input_file)));
-
-      if (obs.rt == obs.rt)
-      {
-        query.bindValue(":rt", obs.rt);
-      }
-      else // NaN
-      {
-        query.bindValue(":rt", QVariant(QVariant::Double)); // NULL
-      }
-      if (obs.mz == obs.mz)
-      {
-        query.bindValue(":mz", obs.mz);
-      }
-      else // NaN
-      {
-        query.bindValue(":mz", QVariant(QVariant::Double)); // NULL
-      }
-      if (!query.exec())
+    vector<QVariant> values = serializeRows_(
+      id_data.getObservations(), 5,
+      [](const ID::Observation& obs, QVariant* row)
       {
-        raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                      "error inserting data");
-      }
-    }
+        row[0] = Key(&obs); // use address as primary key
+        row[1] = obs.data_id.toQString();
+        row[2] = Key(&(*obs.input_file));
+        // use NULL for NaN:
+        row[3] = (obs.rt == obs.rt) ? QVariant(obs.rt) : QVariant(QVariant::Double);
+        row[4] = (obs.mz == obs.mz) ? QVariant(obs.mz) : QVariant(QVariant::Double);
+      });
+    insertRows_("ID_Observation", 5, values);
     storeMetaInfos_(id_data.getObservations(), "ID_Observation");
   }
 
@@ -795,30 +791,19 @@ namespace OpenMS::Internal
       "is_decoy NUMERIC NOT NULL CHECK (is_decoy in (0, 1)) DEFAULT 0, " \
       "FOREIGN KEY (molecule_type_id) REFERENCES ID_MoleculeType (id)");
 
-    QSqlQuery query(QSqlDatabase::database(db_name_));
-    query.prepare("INSERT INTO ID_ParentSequence VALUES ("  \
-                  ":id, "                                   \
-                  ":accession, "                            \
-                  ":molecule_type_id, "                     \
-                  ":sequence, "                             \
-                  ":description, "                          \
-                  ":coverage, "                             \
-                  ":is_decoy)");
-    for (const ID::ParentSequence& parent : id_data.getParentSequences())
-    {
-      query.bindValue(":id", Key(&parent)); // use address as primary key
-      query.bindValue(":accession", parent.accession.toQString());
-      query.bindValue(":molecule_type_id", int(parent.molecule_type) + 1);
-      query.bindValue(":sequence", parent.sequence.toQString());
-      query.bindValue(":description", parent.description.toQString());
-      query.bindValue(":coverage", parent.coverage);
-      query.bindValue(":is_decoy", int(parent.is_decoy));
-      if (!query.exec())
+    vector<QVariant> values = serializeRows_(
+      id_data.getParentSequences(), 7,
+      [](const ID::ParentSequence& parent, QVariant* row)
       {
-        raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                      "error inserting data");
-      }
-    }
+        row[0] = Key(&parent); // use address as primary key
+        row[1] = parent.accession.toQString();
+        row[2] = int(parent.molecule_type) + 1;
+        row[3] = parent.sequence.toQString();
+        row[4] = parent.description.toQString();
+        row[5] = parent.coverage;
+        row[6] = int(parent.is_decoy);
+      });
+    insertRows_("ID_ParentSequence", 7, values);
     storeScoredProcessingResults_(id_data.getParentSequences(), "ID_ParentSequence");
   }
 
@@ -1014,41 +999,38 @@ namespace OpenMS::Internal
     {
       createTableIdentifiedMolecule_();
     }
-    QSqlQuery& query = prepared_queries_["ID_IdentifiedMolecule"];
-
-    bool any_parent_matches = false;
     // store peptides:
-    query.bindValue(":molecule_type_id", int(ID::MoleculeType::PROTEIN) + 1);
-    for (const ID::IdentifiedPeptide& peptide : id_data.getIdentifiedPeptides())
-    {
-      if (!peptide.parent_matches.empty()) any_parent_matches = true;
-      query.bindValue(":id", Key(&peptide)); // use address as primary key
-      query.bindValue(":identifier", peptide.sequence.toString().toQString());
-      if (!query.exec())
+    vector<QVariant> values = serializeRows_(
+      id_data.getIdentifiedPeptides(), 3,
+      [](const ID::IdentifiedPeptide& peptide, QVariant* row)
       {
-        raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                      "error inserting data");
-      }
-    }
+        row[0] = Key(&peptide); // use address as primary key
+        row[1] = int(ID::MoleculeType::PROTEIN) + 1;
+        row[2] = peptide.sequence.toString().toQString();
+      });
+    insertRows_("ID_IdentifiedMolecule", 3, values);
     storeScoredProcessingResults_(id_data.getIdentifiedPeptides(),
                                   "ID_IdentifiedMolecule");
     // store RNA oligos:
-    query.bindValue(":molecule_type_id", int(ID::MoleculeType::RNA) + 1);
-    for (const ID::IdentifiedOligo& oligo : id_data.getIdentifiedOligos())
-    {
-      if (!oligo.parent_matches.empty()) any_parent_matches = true;
-      query.bindValue(":id", Key(&oligo)); // use address as primary key
-      query.bindValue(":identifier",
-                      QString::fromStdString(oligo.sequence.toString()));
-      if (!query.exec())
+    values = serializeRows_(
+      id_data.getIdentifiedOligos(), 3,
+      [](const ID::IdentifiedOligo& oligo, QVariant* row)
       {
-        raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                      "error inserting data");
-      }
-    }
+        row[0] = Key(&oligo); // use address as primary key
+        row[1] = int(ID::MoleculeType::RNA) + 1;
+        row[2] = QString::fromStdString(oligo.sequence.toString());
+      });
+    insertRows_("ID_IdentifiedMolecule", 3, values);
     storeScoredProcessingResults_(id_data.getIdentifiedOligos(),
                                   "ID_IdentifiedMolecule");
 
+    bool any_parent_matches =
+      any_of(id_data.getIdentifiedPeptides().begin(),
+             id_data.getIdentifiedPeptides().end(),
+             [](const ID::IdentifiedPeptide& peptide) { return !peptide.parent_matches.empty(); }) ||
+      any_of(id_data.getIdentifiedOligos().begin(),
+             id_data.getIdentifiedOligos().end(),
+             [](const ID::IdentifiedOligo& oligo) { return !oligo.parent_matches.empty(); });
     if (any_parent_matches)
     {
       createTableParentMatches_();
@@ -1205,39 +1187,27 @@ namespace OpenMS::Internal
     }
     createTable_("ID_ObservationMatch", table_def);
 
-    QSqlQuery query(QSqlDatabase::database(db_name_));
-    query.prepare("INSERT INTO ID_ObservationMatch VALUES ("    \
-                  ":id, "                                       \
-                  ":identified_molecule_id, "                   \
-                  ":observation_id, "                           \
-                  ":adduct_id, "                                \
-                  ":charge)");
-    bool any_peak_annotations = false;
-    for (const ID::ObservationMatch& match : id_data.getObservationMatches())
-    {
-      if (!match.peak_annotations.empty()) any_peak_annotations = true;
-      query.bindValue(":id", Key(&match)); // use address as primary key
-      query.bindValue(":identified_molecule_id", getAddress_(match.identified_molecule_var));
-      query.bindValue(":observation_id", Key(&(*match.observation_ref)));
-      if (match.adduct_opt)
+    vector<QVariant> values = serializeRows_(
+      id_data.getObservationMatches(), 5,
+      [this](const ID::ObservationMatch& match, QVariant* row)
       {
-        query.bindValue(":adduct_id", Key(&(**match.adduct_opt)));
-      }
-      else // bind NULL value
-      {
-        query.bindValue(":adduct_id", QVariant(QVariant::Int));
-      }
-      query.bindValue(":charge", match.charge);
-      if (!query.exec())
-      {
-        raiseDBError_(query.lastError(), __LINE__, OPENMS_PRETTY_FUNCTION,
-                      "error inserting data");
-      }
-    }
+        row[0] = Key(&match); // use address as primary key
+        row[1] = getAddress_(match.identified_molecule_var);
+        row[2] = Key(&(*match.observation_ref));
+        // use NULL for missing adduct:
+        row[3] = match.adduct_opt ? QVariant(Key(&(**match.adduct_opt))) : QVariant(QVariant::Int);
+        row[4] = match.charge;
+      });
+    insertRows_("ID_ObservationMatch", 5, values);
+    bool any_peak_annotations =
+      any_of(id_data.getObservationMatches().begin(),
+             id_data.getObservationMatches().end(),
+             [](const ID::ObservationMatch& match) { return !match.peak_annotations.empty(); });
     storeScoredProcessingResults_(id_data.getObservationMatches(), "ID_ObservationMatch");
 
     if (any_peak_annotations)
     {
+      QSqlQuery query(QSqlDatabase::database(db_name_));
       createTable_(
         "ID_ObservationMatch_PeakAnnotation",
         "parent_id INTEGER NOT NULL, "                                  \
@@ -1287,9 +1257,9 @@ namespace OpenMS::Internal
           }
         }
       }
+      // create index on parent_id column after all data has been inserted:
+      query.exec("CREATE INDEX PeakAnnotation_parent_id ON ID_ObservationMatch_PeakAnnotation (parent_id)");
     }
-    // create index on parent_id column
-    query.exec("CREATE INDEX PeakAnnotation_parent_id ON ID_ObservationMatch_PeakAnnotation (parent_id)");
   }
 
 
@@ -41,6 +41,8 @@ namespace OpenMS
   FeatureFileOptions::FeatureFileOptions() :
     loadConvexhull_(true),
     loadSubordinates_(true),
+    storeConvexhull_(true),
+    storeSubordinates_(true),
     metadata_only_(false),
     has_rt_range_(false),
     has_mz_range_(false),
@@ -73,6 +75,26 @@ namespace OpenMS
     return loadSubordinates_;
   }
 
+  void FeatureFileOptions::setStoreConvexHull(bool convex)
+  {
+    storeConvexhull_ = convex;
+  }
+
+  bool FeatureFileOptions::getStoreConvexHull() const
+  {
+    return storeConvexhull_;
+  }
+
+  void FeatureFileOptions::setStoreSubordinates(bool sub)
+  {
+    storeSubordinates_ = sub;
+  }
+
+  bool FeatureFileOptions::getStoreSubordinates() const
+  {
+    return storeSubordinates_;
+  }
+
   void FeatureFileOptions::setMetadataOnly(bool only)
   {
     metadata_only_ = only;
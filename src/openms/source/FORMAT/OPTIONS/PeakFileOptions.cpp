@@ -63,6 +63,7 @@ namespace OpenMS
     np_config_int_(),
     np_config_fda_(),
     maximal_data_pool_size_(100),
+    pipelined_decoding_(false),
     precursor_mz_selected_ion_(true)
   {
   }
@@ -92,6 +93,7 @@ namespace OpenMS
     np_config_int_(options.np_config_int_),
     np_config_fda_(options.np_config_fda_),
     maximal_data_pool_size_(options.maximal_data_pool_size_),
+    pipelined_decoding_(options.pipelined_decoding_),
     precursor_mz_selected_ion_(options.precursor_mz_selected_ion_)
   {
   }
@@ -352,6 +354,16 @@ namespace OpenMS
     maximal_data_pool_size_ = size;
   }
 
+  bool PeakFileOptions::getPipelinedDecoding() const
+  {
+    return pipelined_decoding_;
+  }
+
+  void PeakFileOptions::setPipelinedDecoding(bool pipelined)
+  {
+    pipelined_decoding_ = pipelined;
+  }
+
   bool PeakFileOptions::getPrecursorMZSelectedIon() const
   {
     return precursor_mz_selected_ion_;
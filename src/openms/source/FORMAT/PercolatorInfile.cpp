@@ -36,8 +36,13 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/METADATA/SpectrumLookup.h>
 
+#include <algorithm>
+#include <exception>
+#include <fstream>
+
 namespace OpenMS
 {
   using namespace std;
@@ -49,8 +54,13 @@ namespace OpenMS
     int min_charge, 
     int max_charge)
   {
-    TextFile txt = preparePin_(peptide_ids, feature_set, enz, min_charge, max_charge);
-    txt.store(pin_file);
+    // stream not opened in binary mode, thus "\n" will be evaluated platform dependent (as in TextFile::store)
+    ofstream os(pin_file.c_str(), ofstream::out);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pin_file);
+    }
+    writePin_(os, peptide_ids, feature_set, enz, min_charge, max_charge);
   }
 
   // uses spectrum_reference, if empty uses spectrum_id, if also empty fall back to using index
@@ -77,19 +87,19 @@ namespace OpenMS
   }
 
 
-  TextFile PercolatorInfile::preparePin_(
+  void PercolatorInfile::writePin_(
+    std::ostream& os,
     const vector<PeptideIdentification>& peptide_ids, 
     const StringList& feature_set, 
     const std::string& enz, 
     int min_charge, 
     int max_charge)
   {
-    TextFile txt;  
-    txt.addLine(ListUtils::concatenate(feature_set, '\t'));
+    os << ListUtils::concatenate(feature_set, '\t') << "\n";
     if (peptide_ids.empty()) 
     {
       OPENMS_LOG_WARN << "No identifications provided. Creating empty percolator input." << endl;
-      return txt;
+      return;
     }
 
     // extract native id (usually in spectrum_reference)
@@ -102,164 +112,209 @@ namespace OpenMS
     size_t missing_meta_value_count{};
     set<String> missing_meta_values;
 
-    size_t index = 0;
-    for (const PeptideIdentification& pep_id : peptide_ids)
+    // rows are generated in parallel, one block at a time, and written in input order
+    const Size block_size = 10000;
+    vector<vector<String>> rows;
+    vector<set<String>> missing;
+    vector<Size> missing_count;
+    vector<exception_ptr> errors;
+    for (Size block_start = 0; block_start < peptide_ids.size(); block_start += block_size)
     {
-      index++;
-      String scan_identifier = getScanIdentifier(pep_id, index);
-      Int scan_number = SpectrumLookup::extractScanNumber(scan_identifier, scan_regex, true);
-      
-      double exp_mass = pep_id.getMZ();
-      double retention_time = pep_id.getRT();
-      for (const PeptideHit& psm : pep_id.getHits())
+      const Size n = std::min(block_size, peptide_ids.size() - block_start);
+      rows.assign(n, vector<String>());
+      missing.assign(n, set<String>());
+      missing_count.assign(n, 0);
+      errors.assign(n, nullptr);
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize i = 0; i < (SignedSize)n; ++i)
       {
-        if (psm.getPeptideEvidences().empty())
+        try
         {
-          OPENMS_LOG_WARN << "PSM (PeptideHit) without protein reference found. "
-                  << "This may indicate incomplete mapping during PeptideIndexing (e.g., wrong enzyme settings)." 
-                  << "Will skip this PSM." << endl;
-          continue;
+          const PeptideIdentification& pep_id = peptide_ids[block_start + i];
+          const size_t index = block_start + i + 1;
+          String scan_identifier = getScanIdentifier(pep_id, index);
+          Int scan_number = SpectrumLookup::extractScanNumber(scan_identifier, scan_regex, true);
+          missing_count[i] = getPinRows_(pep_id, scan_identifier, scan_number, feature_set, enz, min_charge, max_charge, rows[i], missing[i]);
         }
-        PeptideHit hit(psm); // make a copy of the hit to store temporary features
-        hit.setMetaValue("SpecId", scan_identifier);
-        hit.setMetaValue("ScanNr", scan_number);
-        
-        if (!hit.metaValueExists("target_decoy") 
-          || hit.getMetaValue("target_decoy").toString().empty()) 
+        catch (...)
         {
-          continue;
+          errors[i] = current_exception();
         }
-        
-        int label = 1;
-        if (hit.getMetaValue("target_decoy") == "decoy")
+      }
+      for (Size i = 0; i < n; ++i)
+      {
+        if (errors[i]) rethrow_exception(errors[i]);
+        for (const String& row : rows[i])
         {
-          label = -1;
+          os << row << "\n";
         }
-        hit.setMetaValue("Label", label);
-        
-        int charge = hit.getCharge();
-        String unmodified_sequence = hit.getSequence().toUnmodifiedString();
+        missing_meta_value_count += missing_count[i];
+        missing_meta_values.insert(missing[i].begin(), missing[i].end());
+      }
+    }
+
+    // print warnings
+    if (missing_meta_value_count != 0)
+    {
+      OPENMS_LOG_WARN << "There were peptide hits with missing features/meta values. Skipped peptide hits: " << missing_meta_value_count << endl;
+      OPENMS_LOG_WARN << "Names of missing meta values: " << endl;
+      for (const auto& f : missing_meta_values)
+      {
+        OPENMS_LOG_WARN << f << endl;
+      }
+    }
+  }
+
+  Size PercolatorInfile::getPinRows_(
+    const PeptideIdentification& pep_id,
+    const String& scan_identifier,
+    Int scan_number,
+    const StringList& feature_set, 
+    const std::string& enz, 
+    int min_charge, 
+    int max_charge,
+    vector<String>& rows,
+    set<String>& missing_meta_values)
+  {
+    Size missing_meta_value_count = 0;
+    double exp_mass = pep_id.getMZ();
+    double retention_time = pep_id.getRT();
+    for (const PeptideHit& psm : pep_id.getHits())
+    {
+      if (psm.getPeptideEvidences().empty())
+      {
+        OPENMS_LOG_WARN << "PSM (PeptideHit) without protein reference found. "
+                << "This may indicate incomplete mapping during PeptideIndexing (e.g., wrong enzyme settings)." 
+                << "Will skip this PSM." << endl;
+        continue;
+      }
+      PeptideHit hit(psm); // make a copy of the hit to store temporary features
+      hit.setMetaValue("SpecId", scan_identifier);
+      hit.setMetaValue("ScanNr", scan_number);
       
-        double calc_mass; 
-        if (!hit.metaValueExists("CalcMass"))
-        {
-          calc_mass = hit.getSequence().getMZ(charge);
-          hit.setMetaValue("CalcMass", calc_mass); // Percolator calls is CalcMass instead of m/z
-        }
-        else
-        {
-          calc_mass = hit.getMetaValue("CalcMass");
-        }
+      if (!hit.metaValueExists("target_decoy") 
+        || hit.getMetaValue("target_decoy").toString().empty()) 
+      {
+        continue;
+      }
+      
+      int label = 1;
+      if (hit.getMetaValue("target_decoy") == "decoy")
+      {
+        label = -1;
+      }
+      hit.setMetaValue("Label", label);
+      
+      int charge = hit.getCharge();
+      String unmodified_sequence = hit.getSequence().toUnmodifiedString();
+    
+      double calc_mass; 
+      if (!hit.metaValueExists("CalcMass"))
+      {
+        calc_mass = hit.getSequence().getMZ(charge);
+        hit.setMetaValue("CalcMass", calc_mass); // Percolator calls is CalcMass instead of m/z
+      }
+      else
+      {
+        calc_mass = hit.getMetaValue("CalcMass");
+      }
 
-        if (hit.metaValueExists("IsotopeError"))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
-        {
-          float isoErr = hit.getMetaValue("IsotopeError").toString().toFloat();
-          exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
-        }
-        else if (hit.metaValueExists(Constants::UserParam::ISOTOPE_ERROR)) // OpenMS user param name for isotope error
-        {
-          float isoErr = hit.getMetaValue(Constants::UserParam::ISOTOPE_ERROR).toString().toFloat();
-          exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
-        }
-                
-        hit.setMetaValue("ExpMass", exp_mass);
+      if (hit.metaValueExists("IsotopeError"))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
+      {
+        float isoErr = hit.getMetaValue("IsotopeError").toString().toFloat();
+        exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
+      }
+      else if (hit.metaValueExists(Constants::UserParam::ISOTOPE_ERROR)) // OpenMS user param name for isotope error
+      {
+        float isoErr = hit.getMetaValue(Constants::UserParam::ISOTOPE_ERROR).toString().toFloat();
+        exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
+      }
+              
+      hit.setMetaValue("ExpMass", exp_mass);
 
-        // needed in case "description of correct" option is used
-        double delta_mass = exp_mass - calc_mass;
-        hit.setMetaValue("deltamass", delta_mass);
-        hit.setMetaValue("retentiontime", retention_time);
+      // needed in case "description of correct" option is used
+      double delta_mass = exp_mass - calc_mass;
+      hit.setMetaValue("deltamass", delta_mass);
+      hit.setMetaValue("retentiontime", retention_time);
 
-        hit.setMetaValue("mass", exp_mass);
-        
-        double score = hit.getScore();
-        // TODO better to use log scores for E-value based scores
-        hit.setMetaValue("score", score);
-        
-        int peptide_length = unmodified_sequence.size();
-        hit.setMetaValue("peplen", peptide_length);
-        
-        for (int i = min_charge; i <= max_charge; ++i)
-        {
-          hit.setMetaValue("charge" + String(i), charge == i);
-        }
+      hit.setMetaValue("mass", exp_mass);
+      
+      double score = hit.getScore();
+      // TODO better to use log scores for E-value based scores
+      hit.setMetaValue("score", score);
+      
+      int peptide_length = unmodified_sequence.size();
+      hit.setMetaValue("peplen", peptide_length);
+      
+      for (int i = min_charge; i <= max_charge; ++i)
+      {
+        hit.setMetaValue("charge" + String(i), charge == i);
+      }
 
-        // just first peptide evidence
-        char aa_before = hit.getPeptideEvidences().front().getAABefore();
-        char aa_after = hit.getPeptideEvidences().front().getAAAfter();
+      // just first peptide evidence
+      char aa_before = hit.getPeptideEvidences().front().getAABefore();
+      char aa_after = hit.getPeptideEvidences().front().getAAAfter();
 
-        bool enzN = isEnz_(aa_before, unmodified_sequence.prefix(1)[0], enz);
-        hit.setMetaValue("enzN", enzN);
-        bool enzC = isEnz_(unmodified_sequence.suffix(1)[0], aa_after, enz);
-        hit.setMetaValue("enzC", enzC);
-        int enzInt = countEnzymatic_(unmodified_sequence, enz);
-        hit.setMetaValue("enzInt", enzInt);
+      bool enzN = isEnz_(aa_before, unmodified_sequence.prefix(1)[0], enz);
+      hit.setMetaValue("enzN", enzN);
+      bool enzC = isEnz_(unmodified_sequence.suffix(1)[0], aa_after, enz);
+      hit.setMetaValue("enzC", enzC);
+      int enzInt = countEnzymatic_(unmodified_sequence, enz);
+      hit.setMetaValue("enzInt", enzInt);
 
-        hit.setMetaValue("dm", delta_mass);
-        
-        double abs_delta_mass = abs(delta_mass);
-        hit.setMetaValue("absdm", abs_delta_mass);
-        
-        //peptide
-        String sequence = "";
+      hit.setMetaValue("dm", delta_mass);
+      
+      double abs_delta_mass = abs(delta_mass);
+      hit.setMetaValue("absdm", abs_delta_mass);
+      
+      //peptide
+      String sequence = "";
 
-        aa_before = aa_before == '[' ? '-' : aa_before;
-        aa_after = aa_after == ']' ? '-' : aa_after;
+      aa_before = aa_before == '[' ? '-' : aa_before;
+      aa_after = aa_after == ']' ? '-' : aa_after;
 
-        sequence += aa_before;
-        sequence += "."; 
-        // Percolator uses square brackets to indicate PTMs
-        sequence += hit.getSequence().toBracketString(false, true);
-        sequence += "."; 
-        sequence += aa_after;
-        
-        hit.setMetaValue("Peptide", sequence);
-        
-        //proteinId1
-        StringList proteins;
-        for (const PeptideEvidence& pep : hit.getPeptideEvidences())
-        {
-          proteins.push_back(pep.getProteinAccession());
-        }
-        hit.setMetaValue("Proteins", ListUtils::concatenate(proteins, '\t'));
-        
-        StringList feats;
-        for (const String& feat : feature_set)
+      sequence += aa_before;
+      sequence += "."; 
+      // Percolator uses square brackets to indicate PTMs
+      sequence += hit.getSequence().toBracketString(false, true);
+      sequence += "."; 
+      sequence += aa_after;
+      
+      hit.setMetaValue("Peptide", sequence);
+      
+      //proteinId1
+      StringList proteins;
+      for (const PeptideEvidence& pep : hit.getPeptideEvidences())
+      {
+        proteins.push_back(pep.getProteinAccession());
+      }
+      hit.setMetaValue("Proteins", ListUtils::concatenate(proteins, '\t'));
+      
+      StringList feats;
+      for (const String& feat : feature_set)
+      {
+      // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
+        if (hit.metaValueExists(feat))
         {
-        // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
-          if (hit.metaValueExists(feat))
-          {
-            feats.push_back(hit.getMetaValue(feat).toString());
-          }
-        }
-        // here: feats (metavalues in peptide hits) and feature_set are equal if they have same size (if no metavalue is missing)
-
-        if (feats.size() == feature_set.size())
-        { // only if all feats were present add
-          txt.addLine(ListUtils::concatenate(feats, '\t'));
-        }        
-        else
-        { // at least one feature is missing in the current peptide hit
-          missing_meta_value_count++;        
-          for (const auto& f : feature_set)
-          {
-            if (std::find(feats.begin(), feats.end(), f) == feats.end()) missing_meta_values.insert(f);
-          }
+          feats.push_back(hit.getMetaValue(feat).toString());
         }
       }
-    }
+      // here: feats (metavalues in peptide hits) and feature_set are equal if they have same size (if no metavalue is missing)
 
-    // print warnings
-    if (missing_meta_value_count != 0)
-    {
-      OPENMS_LOG_WARN << "There were peptide hits with missing features/meta values. Skipped peptide hits: " << missing_meta_value_count << endl;
-      OPENMS_LOG_WARN << "Names of missing meta values: " << endl;
-      for (const auto& f : missing_meta_values)
-      {
-        OPENMS_LOG_WARN << f << endl;
+      if (feats.size() == feature_set.size())
+      { // only if all feats were present add
+        rows.push_back(ListUtils::concatenate(feats, '\t'));
+      }        
+      else
+      { // at least one feature is missing in the current peptide hit
+        ++missing_meta_value_count;
+        for (const auto& f : feature_set)
+        {
+          if (std::find(feats.begin(), feats.end(), f) == feats.end()) missing_meta_values.insert(f);
+        }
       }
     }
-
-    return txt;
+    return missing_meta_value_count;
   }
 
 
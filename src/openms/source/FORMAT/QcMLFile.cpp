@@ -1093,10 +1093,10 @@ namespace OpenMS
                                const MSExperiment& exp)
   {
       // fetch vocabularies
-      ControlledVocabulary cv;
-      cv.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
-      cv.loadFromOBO("QC", File::find("/CV/qc-cv.obo"));
-      cv.loadFromOBO("QC", File::find("/CV/qc-cv-legacy.obo"));
+      const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({
+        {"PSI-MS", "/CV/psi-ms.obo"},
+        {"QC", "/CV/qc-cv.obo"},
+        {"QC", "/CV/qc-cv-legacy.obo"}});
       //-------------------------------------------------------------
       // MS acquisition
       //------------------------------------------------------------
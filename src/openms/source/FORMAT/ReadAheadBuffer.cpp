@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpenMS
+{
+  ReadAheadBuffer::ReadAheadBuffer(ReadFunction read_function, size_t chunk_size, size_t max_chunks_ahead) :
+    read_function_(std::move(read_function)),
+    chunk_size_(std::max<size_t>(chunk_size, 1)),
+    max_chunks_ahead_(std::max<size_t>(max_chunks_ahead, 1))
+  {
+    worker_ = std::thread(&ReadAheadBuffer::run_, this);
+  }
+
+  ReadAheadBuffer::~ReadAheadBuffer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    if (worker_.joinable())
+    {
+      worker_.join();
+    }
+  }
+
+  void ReadAheadBuffer::run_()
+  {
+    while (true)
+    {
+      std::vector<char> chunk;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return stop_ || filled_.size() < max_chunks_ahead_; });
+        if (stop_)
+        {
+          return;
+        }
+        if (!free_.empty())
+        {
+          chunk.swap(free_.back());
+          free_.pop_back();
+        }
+      }
+
+      // decompress without holding the lock
+      chunk.resize(chunk_size_);
+      size_t n = 0;
+      std::exception_ptr error;
+      try
+      {
+        n = read_function_(chunk.data(), chunk.size());
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+      chunk.resize(n);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (n > 0)
+        {
+          filled_.push_back(std::move(chunk));
+        }
+        if (error || n == 0)
+        {
+          error_ = error;
+          done_ = true;
+        }
+      }
+      cond_.notify_all();
+      if (error || n == 0)
+      {
+        return;
+      }
+    }
+  }
+
+  bool ReadAheadBuffer::nextChunk_()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return done_ || !filled_.empty(); });
+    if (filled_.empty())
+    {
+      if (error_)
+      {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+      }
+      return false;
+    }
+    // hand the consumed chunk back to the worker for re-use
+    free_.push_back(std::move(current_));
+    current_.swap(filled_.front());
+    filled_.pop_front();
+    current_pos_ = 0;
+    lock.unlock();
+    cond_.notify_all();
+    return true;
+  }
+
+  size_t ReadAheadBuffer::read(char* s, size_t n)
+  {
+    size_t copied = 0;
+    while (copied < n && !at_end_)
+    {
+      if (current_pos_ == current_.size() && !nextChunk_())
+      {
+        at_end_ = true;
+        break;
+      }
+      size_t count = std::min(n - copied, current_.size() - current_pos_);
+      memcpy(s + copied, current_.data() + current_pos_, count);
+      current_pos_ += count;
+      copied += count;
+    }
+    return copied;
+  }
+
+  bool ReadAheadBuffer::streamEnd() const
+  {
+    if (at_end_)
+    {
+      return true;
+    }
+    if (current_pos_ < current_.size())
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_ && filled_.empty() && !error_;
+  }
+
+} // namespace OpenMS
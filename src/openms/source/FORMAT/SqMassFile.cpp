@@ -50,10 +50,25 @@ namespace OpenMS
     sql_mass.readExperiment(map);
   }
 
+  void SqMassFile::loadSpectra(const String& filename, std::vector<MSSpectrum>& spectra, double rt_min, double rt_max,
+                               int ms_level, double precursor_mz_min, double precursor_mz_max) const
+  {
+    OpenMS::Internal::MzMLSqliteHandler sql_mass(filename, 0);
+    sql_mass.setConfig(config_.write_full_meta, config_.use_lossy_numpress, config_.linear_fp_mass_acc);
+    std::vector<int> indices = sql_mass.getSpectraIndices(rt_min, rt_max, ms_level, precursor_mz_min, precursor_mz_max);
+    spectra.clear();
+    if (indices.empty())
+    {
+      return;
+    }
+    sql_mass.readSpectra(spectra, indices, false);
+  }
+
   void SqMassFile::store(const String& filename, MapType& map) const
   {
     OpenMS::Internal::MzMLSqliteHandler sql_mass(filename, map.getSqlRunID());
-    sql_mass.setConfig(config_.write_full_meta, config_.use_lossy_numpress, config_.linear_fp_mass_acc);
+    sql_mass.setConfig(config_.write_full_meta, config_.use_lossy_numpress, config_.linear_fp_mass_acc, config_.sql_batch_size);
+    sql_mass.setWriteTuning(config_.use_wal, config_.page_size, config_.cache_size_kb);
     sql_mass.createTables();
     sql_mass.writeExperiment(map);
   }
@@ -71,9 +71,9 @@ namespace OpenMS
     CVMappingFile().load(File::find("/MAPPING/TraML-mapping.xml"), mapping);
 
     //load cvs
-    ControlledVocabulary cv;
-    cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
-    cv.loadFromOBO("UO", File::find("/CV/unit.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getCachedCV({
+      {"MS", "/CV/psi-ms.obo"},
+      {"UO", "/CV/unit.obo"}});
 
     //validate
     Internal::TraMLValidator v(mapping, cv);
@@ -55,54 +55,6 @@ void TriqlerFile::checkConditionLFQ_(const ExperimentalDesign::SampleSection& sa
   }
 }
 
-//TODO why do we need this method and store everything three times??? (Once in the CMap, once in the feature
-// of aggregatedConsensusInfo, and once in the other fields of aggregatedConsensusInfo)
-// Cant we just get this stuff on the fly?
-// We go through the features anyway again.
-TriqlerFile::AggregatedConsensusInfo TriqlerFile::aggregateInfo_(const ConsensusMap& consensus_map,
-                                                                                 const std::vector<String>& spectra_paths)
-{
-  TriqlerFile::AggregatedConsensusInfo aggregatedInfo; //results
-  const auto &column_headers = consensus_map.getColumnHeaders(); // needed for label_id
-
-  for (const ConsensusFeature &consensus_feature : consensus_map)
-  {
-    vector<String> filenames;
-    vector<TriqlerFile::Intensity> intensities;
-    vector<TriqlerFile::Coordinate> retention_times;
-    vector<unsigned> cf_labels;
-
-    // Store the file names and the run intensities of this feature
-    const ConsensusFeature::HandleSetType& fs(consensus_feature.getFeatures());
-    for (const auto& feat : fs)
-    {
-      filenames.push_back(spectra_paths[feat.getMapIndex()]);
-      intensities.push_back(feat.getIntensity());
-      retention_times.push_back(feat.getRT());
-
-      // Get the label_id from the file description MetaValue
-      auto &column = column_headers.at(feat.getMapIndex());
-      if (column.metaValueExists("channel_id"))
-      {
-        cf_labels.push_back(Int(column.getMetaValue("channel_id")));
-      }
-      else
-      {
-        // label id 1 is used in case the experimental design specifies a LFQ experiment
-        //TODO Not really, according to the if-case it only cares about the metavalue.
-        // which could be missing due to other reasons
-        cf_labels.push_back(1u);
-      }
-    }
-    aggregatedInfo.consensus_feature_labels.push_back(cf_labels);
-    aggregatedInfo.consensus_feature_filenames.push_back(filenames);
-    aggregatedInfo.consensus_feature_intensities.push_back(intensities);
-    aggregatedInfo.consensus_feature_retention_times.push_back(retention_times);
-    aggregatedInfo.features.push_back(consensus_feature);
-  }
-  return aggregatedInfo;
-}
-
 //@todo LineType should be a template only for the line, not for the whole
 // mapping structure. More exact type matching/info then.
 void TriqlerFile::constructFile_(TextFile& csv_out,
@@ -190,8 +142,34 @@ void TriqlerFile::storeLFQ(const String& filename,
     throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The filenames (extension ignored) in the consensusXML file are not the same as in the experimental design");
   }
 
-  // Extract information from the consensus features.
-  TriqlerFile::AggregatedConsensusInfo aggregatedInfo = TriqlerFile::aggregateInfo_(consensus_map, spectra_paths);
+  // The design lookups of a map are the same for all its feature handles, so they are resolved once per map
+  // while walking the consensus map (instead of copying all features and handles into intermediate vectors first).
+  const ConsensusMap::ColumnHeaders& column_headers = consensus_map.getColumnHeaders();
+  std::vector<MapDesignInfo_> map_design_info(spectra_paths.size());
+  auto resolveMapDesignInfo = [&](UInt64 map_index) -> const MapDesignInfo_&
+  {
+    MapDesignInfo_& info = map_design_info.at(map_index);
+    if (!info.resolved)
+    {
+      // label id 1 is used in case the experimental design specifies a LFQ experiment
+      const ConsensusMap::ColumnHeader& column = column_headers.at(map_index);
+      const unsigned label = column.metaValueExists("channel_id") ? unsigned(Int(column.getMetaValue("channel_id"))) : 1u;
+
+      const String& current_filename = spectra_paths[map_index];
+      const pair< String, unsigned> tpl1 = make_pair(current_filename, label);
+      const unsigned sample = path_label_to_sample[tpl1];
+      const unsigned fraction = path_label_to_fraction[tpl1];
+
+      // Resolve run
+      const pair< String, unsigned> tpl2 = make_pair(current_filename, fraction);
+      const unsigned run = run_map[tpl2];  // Triqler run according to the file table
+      info.run_string = String(run);
+      info.condition = sampleSection.getFactorValue(sample, condition);
+      Triqler_run_to_openms_fractiongroup[run] = path_label_to_fractiongroup[tpl1];
+      info.resolved = true;
+    }
+    return info;
+  };
 
   // The output file of the Triqler converter
   TextFile csv_out;
@@ -237,11 +215,9 @@ void TriqlerFile::storeLFQ(const String& filename,
   // Stores all the lines that will be present in the final Triqler output
   MapSequenceToLines_ peptideseq_to_line;
   IDScoreSwitcherAlgorithm scores;
-  for (Size i = 0; i < aggregatedInfo.features.size(); ++i)
+  for (const ConsensusFeature& consensus_feature : consensus_map)
   {
-    const BaseFeature &base_feature = aggregatedInfo.features[i];
-
-    for (const PeptideIdentification &pep_id : base_feature.getPeptideIdentifications())
+    for (const PeptideIdentification &pep_id : consensus_feature.getPeptideIdentifications())
     {
       if (!scores.isScoreType(pep_id.getScoreType(), IDScoreSwitcherAlgorithm::ScoreType::PEP))
       {
@@ -281,31 +257,21 @@ void TriqlerFile::storeLFQ(const String& filename,
           accession = na_string_; // shouldn't really matter since we skip unquantifiable peptides
         }
         // Write new line for each run
-        for (Size j = 0; j < aggregatedInfo.consensus_feature_filenames[i].size(); j++)
+        const String precursor_charge_string(precursor_charge);
+        const String search_score_string(1. - search_score);
+        std::set<TriqlerLine_>& lines = peptideseq_to_line[sequence];
+        for (const FeatureHandle& feature_handle : consensus_feature.getFeatures())
         {
-          const String &current_filename = aggregatedInfo.consensus_feature_filenames[i][j];
-          const Intensity intensity(aggregatedInfo.consensus_feature_intensities[i][j]);
-          // const Coordinate retention_time(aggregatedInfo.consensus_feature_retention_times[i][j]);
-          const unsigned label(aggregatedInfo.consensus_feature_labels[i][j]);
-
-          const pair< String, unsigned> tpl1 = make_pair(current_filename, label);
-          const unsigned sample = path_label_to_sample[tpl1];
-          const unsigned fraction = path_label_to_fraction[tpl1];
-
-          const pair< String, unsigned> tpl2 = make_pair(current_filename, fraction);
-
-          // Resolve run
-          const unsigned run = run_map[tpl2];  // Triqler run according to the file table
-          const unsigned openms_fractiongroup = path_label_to_fractiongroup[tpl1];
-          Triqler_run_to_openms_fractiongroup[run] = openms_fractiongroup;
-
-          // Store Triqler line          
-          peptideseq_to_line[sequence].insert(TriqlerLine_(
-                  String(run),
-                  sampleSection.getFactorValue(sample, condition),
-                  String(precursor_charge),
-                  String(1. - search_score),
-                  String(intensity), 
+          const MapDesignInfo_& info = resolveMapDesignInfo(feature_handle.getMapIndex());
+          const Intensity intensity(feature_handle.getIntensity());
+
+          // Store Triqler line
+          lines.insert(TriqlerLine_(
+                  info.run_string,
+                  info.condition,
+                  precursor_charge_string,
+                  search_score_string,
+                  String(intensity),
                   sequence,
                   accession));
         }
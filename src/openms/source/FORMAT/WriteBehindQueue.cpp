@@ -0,0 +1,130 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  WriteBehindQueue::WriteBehindQueue(size_t max_pending) :
+    max_pending_(std::max<size_t>(max_pending, 1))
+  {
+    worker_ = std::thread(&WriteBehindQueue::run_, this);
+  }
+
+  WriteBehindQueue::~WriteBehindQueue()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    if (worker_.joinable())
+    {
+      worker_.join();
+    }
+  }
+
+  void WriteBehindQueue::run_()
+  {
+    while (true)
+    {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty())
+        {
+          return; // stop_ is set and everything was written
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        busy_ = true;
+      }
+      cond_.notify_all(); // space in the queue
+
+      // write without holding the lock
+      std::exception_ptr error;
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_ = false;
+        if (error)
+        {
+          error_ = error;
+          tasks_.clear(); // the output is incomplete anyway
+        }
+      }
+      cond_.notify_all();
+    }
+  }
+
+  void WriteBehindQueue::rethrowError_()
+  {
+    if (error_)
+    {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  void WriteBehindQueue::push(Task task)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] { return error_ || tasks_.size() < max_pending_; });
+      rethrowError_();
+      tasks_.push_back(std::move(task));
+    }
+    cond_.notify_all();
+  }
+
+  void WriteBehindQueue::flush()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+    rethrowError_();
+  }
+
+} // namespace OpenMS
@@ -36,6 +36,9 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 
 namespace OpenMS
@@ -72,6 +75,35 @@ namespace OpenMS
     compressed.resize(compressed_length);
   }
 
+  void ZlibCompression::compressData(const void* raw_data, size_t nr_bytes, std::vector<Byte>& compressed_data)
+  {
+    unsigned long sourceLen = (unsigned long)nr_bytes;
+    unsigned long compressed_length = sourceLen + (sourceLen >> 12) + (sourceLen >> 14) + 11; // taken from zlib's compress.c, as we cannot use compressBound*
+
+    int zlib_error;
+    do
+    {
+      compressed_data.resize(compressed_length);
+      zlib_error = compress(reinterpret_cast<Bytef*>(compressed_data.data()), &compressed_length,
+                            reinterpret_cast<const Bytef*>(raw_data), sourceLen);
+
+      switch (zlib_error)
+      {
+      case Z_MEM_ERROR:
+        throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, compressed_length);
+
+      case Z_BUF_ERROR:
+        compressed_length *= 2;
+      }
+    } while (zlib_error == Z_BUF_ERROR);
+
+    if (zlib_error != Z_OK)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Compression error?");
+    }
+    compressed_data.resize(compressed_length);
+  }
+
   void ZlibCompression::compressString(const QByteArray& raw_data, QByteArray& compressed_data)
   {
     compressed_data = qCompress(raw_data);
@@ -81,14 +113,51 @@ namespace OpenMS
   void ZlibCompression::uncompressString(const void * tt, size_t blob_bytes, std::string& uncompressed)
   {
     // take a leap of faith and assume the input is valid
-    QByteArray compressed_data = QByteArray::fromRawData((const char*)tt, blob_bytes);
-    QByteArray raw_data;
-
-    ZlibCompression::uncompressString(compressed_data, raw_data);
+    std::vector<Byte> raw_data;
+    ZlibCompression::uncompressData(tt, blob_bytes, raw_data);
 
     // Note that we may have zero bytes in the string, so we cannot use QString
-    uncompressed.clear();
-    uncompressed = std::string(raw_data.data(), raw_data.size());
+    uncompressed.assign(reinterpret_cast<const char*>(raw_data.data()), raw_data.size());
+  }
+
+  void ZlibCompression::uncompressData(const void* compressed_data, size_t nr_bytes, std::vector<Byte>& raw_data)
+  {
+    z_stream zs;
+    zs.zalloc = Z_NULL;
+    zs.zfree = Z_NULL;
+    zs.opaque = Z_NULL;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(compressed_data));
+    zs.avail_in = (uInt)nr_bytes;
+    if (inflateInit(&zs) != Z_OK)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+    }
+
+    // MS data usually compresses by a factor of 2-4, start with a generous guess
+    // (but never shrink the buffer we got handed, its capacity is reused anyway)
+    size_t written = 0;
+    raw_data.resize(std::max(raw_data.capacity(), std::max(nr_bytes * 4, size_t(1024))));
+    int zlib_error;
+    do
+    {
+      if (written == raw_data.size())
+      {
+        raw_data.resize(raw_data.size() * 2);
+      }
+      zs.next_out = reinterpret_cast<Bytef*>(raw_data.data() + written);
+      zs.avail_out = (uInt)std::min(raw_data.size() - written, size_t(std::numeric_limits<uInt>::max()));
+      const uInt avail_before = zs.avail_out;
+      zlib_error = inflate(&zs, Z_NO_FLUSH);
+      written += avail_before - zs.avail_out;
+    } while (zlib_error == Z_OK);
+    inflateEnd(&zs);
+
+    if (zlib_error != Z_STREAM_END || written == 0)
+    {
+      raw_data.clear();
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+    }
+    raw_data.resize(written);
   }
 
   void ZlibCompression::uncompressString(const QByteArray& compressed_data, QByteArray& raw_data)
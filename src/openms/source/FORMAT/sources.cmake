@@ -9,6 +9,7 @@ Base64.cpp
 Bzip2Ifstream.cpp
 Bzip2InputStream.cpp
 CachedMzML.cpp
+CachedPeptideDatabase.cpp
 ChromeleonFile.cpp
 CompressedInputSource.cpp
 CVMappingFile.cpp
@@ -20,6 +21,7 @@ DTAFile.cpp
 EDTAFile.cpp
 ExperimentalDesignFile.cpp
 FASTAFile.cpp
+IndexedFASTAFile.cpp
 FeatureXMLFile.cpp
 FileHandler.cpp
 FileTypes.cpp
@@ -77,6 +79,7 @@ PercolatorInfile.cpp
 PercolatorOutfile.cpp
 ProtXMLFile.cpp
 QcMLFile.cpp
+ReadAheadBuffer.cpp
 SequestInfile.cpp
 SequestOutfile.cpp
 SpecArrayFile.cpp
@@ -90,6 +93,7 @@ TraMLFile.cpp
 TransformationXMLFile.cpp
 TriqlerFile.cpp
 UnimodXMLFile.cpp
+WriteBehindQueue.cpp
 XMassFile.cpp
 XMLFile.cpp
 XQuestResultXMLFile.cpp
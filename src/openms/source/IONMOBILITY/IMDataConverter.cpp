@@ -68,11 +68,19 @@ namespace OpenMS
       counter++;
     }
 
+    // count spectra per CV to allocate the PeakMaps only once
+    std::vector<Size> spectra_per_cv(CVs.size(), 0);
+    for (const MSSpectrum& it : exp)
+    {
+      ++spectra_per_cv[cv2index[it.getDriftTime()]];
+    }
+
     // make as many PeakMaps as there are different CVs and fill their Meta Data
     split_peakmap.resize(CVs.size());
-    for (auto& spec : split_peakmap)
+    for (size_t i = 0; i < split_peakmap.size(); ++i)
     {
-      spec.getExperimentalSettings() = exp.getExperimentalSettings();
+      split_peakmap[i].getExperimentalSettings() = exp.getExperimentalSettings();
+      split_peakmap[i].reserveSpaceSpectra(spectra_per_cv[i]);
     }
 
     // fill up the PeakMaps by moving spectra from the input PeakMap
@@ -228,8 +236,7 @@ namespace OpenMS
     if (stack.empty()) return;
 
     // copy meta data without the raw data and without the IM array
-    MSSpectrum new_spec = *stack[0];
-    new_spec.clear(false);
+    MSSpectrum new_spec = stack[0]->copyWithoutPeaks();
 
     // create new FDA
     OpenMS::DataArrays::FloatDataArray& fda = new_spec.getFloatDataArrays().emplace_back();
@@ -0,0 +1,217 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/IONMOBILITY/IMFrameMap.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace OpenMS
+{
+  IMFrameMap::IMFrameMap(const MSExperiment& exp)
+  {
+    Size nr_frames(0), nr_peaks(0);
+    for (const auto& spec : exp)
+    {
+      if (spec.containsIMData())
+      {
+        ++nr_frames;
+        nr_peaks += spec.size();
+      }
+    }
+    frame_meta_.reserve(nr_frames);
+    frame_im_arrays_.reserve(nr_frames);
+    frame_im_units_.reserve(nr_frames);
+    frame_scan_offsets_.reserve(nr_frames + 1);
+    mz_.reserve(nr_peaks);
+    intensity_.reserve(nr_peaks);
+
+    for (const auto& spec : exp)
+    {
+      if (spec.containsIMData())
+      {
+        addFrame(spec);
+      }
+    }
+  }
+
+  void IMFrameMap::addFrame(const MSSpectrum& im_frame)
+  {
+    if (im_frame.empty())
+    { // nothing to split (we do not even check for IM data, for robustness)
+      frame_meta_.push_back(im_frame.copyWithoutPeaks());
+      frame_im_arrays_.emplace_back();
+      frame_im_units_.push_back(DriftTimeUnit::NONE);
+      frame_scan_offsets_.push_back(scan_drift_times_.size());
+      return;
+    }
+    // can throw if IM float data array is missing
+    const auto [im_data_index, im_unit] = im_frame.getIMData();
+    const auto& im_data = im_frame.getFloatDataArrays()[im_data_index];
+
+    // peak order by ascending IM (stable, i.e. as IMDataConverter::splitByIonMobility())
+    std::vector<Size> order(im_frame.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(im_data.begin(), im_data.end()))
+    {
+      std::stable_sort(order.begin(), order.end(), [&im_data](const Size i1, const Size i2) {
+        return im_data[i1] < im_data[i2];
+      });
+    }
+
+    frame_meta_.push_back(im_frame.copyWithoutPeaks());
+    DataArrays::FloatDataArray im_array_meta;
+    im_array_meta.MetaInfoDescription::operator=(im_data);
+    frame_im_arrays_.push_back(std::move(im_array_meta));
+    frame_im_units_.push_back(im_unit);
+
+    mz_.reserve(mz_.size() + order.size());
+    intensity_.reserve(intensity_.size() + order.size());
+    using IMV_t = MSSpectrum::FloatDataArray::value_type;
+    IMV_t im_last = std::numeric_limits<IMV_t>::max();
+    for (Size i : order)
+    {
+      const IMV_t im = im_data[i];
+      if (im != im_last)
+      { // new scan
+        im_last = im;
+        scan_drift_times_.push_back(im);
+        scan_peak_offsets_.push_back(mz_.size()); // empty scan, extended below
+      }
+      mz_.push_back(im_frame[i].getMZ());
+      intensity_.push_back(im_frame[i].getIntensity());
+      ++scan_peak_offsets_.back(); // end of current scan
+    }
+    frame_scan_offsets_.push_back(scan_drift_times_.size());
+  }
+
+  Size IMFrameMap::size() const
+  {
+    return frame_meta_.size();
+  }
+
+  bool IMFrameMap::empty() const
+  {
+    return frame_meta_.empty();
+  }
+
+  void IMFrameMap::clear()
+  {
+    *this = IMFrameMap();
+  }
+
+  Size IMFrameMap::getNrOfPeaks() const
+  {
+    return mz_.size();
+  }
+
+  Size IMFrameMap::getNrOfScans() const
+  {
+    return scan_drift_times_.size();
+  }
+
+  Size IMFrameMap::getNrOfScans(Size frame_index) const
+  {
+    return frame_scan_offsets_.at(frame_index + 1) - frame_scan_offsets_[frame_index];
+  }
+
+  const MSSpectrum& IMFrameMap::getFrameMetaData(Size frame_index) const
+  {
+    return frame_meta_.at(frame_index);
+  }
+
+  DriftTimeUnit IMFrameMap::getDriftTimeUnit(Size frame_index) const
+  {
+    return frame_im_units_.at(frame_index);
+  }
+
+  IMFrameMap::MobilityScanView IMFrameMap::getScan(Size frame_index, Size scan_index) const
+  {
+    if (scan_index >= getNrOfScans(frame_index))
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, scan_index, getNrOfScans(frame_index));
+    }
+    const Size scan = frame_scan_offsets_[frame_index] + scan_index;
+    const Size begin = scan_peak_offsets_[scan];
+    MobilityScanView view;
+    view.mz = mz_.data() + begin;
+    view.intensity = intensity_.data() + begin;
+    view.size = scan_peak_offsets_[scan + 1] - begin;
+    view.drift_time = scan_drift_times_[scan];
+    return view;
+  }
+
+  MSSpectrum IMFrameMap::toSpectrum(Size frame_index, Size scan_index) const
+  {
+    const MobilityScanView view = getScan(frame_index, scan_index);
+    MSSpectrum spec = frame_meta_[frame_index].copyWithoutPeaks();
+    spec.setDriftTime(view.drift_time);
+    spec.setDriftTimeUnit(frame_im_units_[frame_index]);
+    spec.reserve(view.size);
+    for (Size i = 0; i < view.size; ++i)
+    {
+      spec.emplace_back(view.mz[i], view.intensity[i]);
+    }
+    return spec;
+  }
+
+  MSSpectrum IMFrameMap::toFrameSpectrum(Size frame_index) const
+  {
+    MSSpectrum spec = getFrameMetaData(frame_index).copyWithoutPeaks();
+    const Size first_scan = frame_scan_offsets_[frame_index];
+    const Size last_scan = frame_scan_offsets_[frame_index + 1];
+    if (first_scan == last_scan)
+    {
+      return spec;
+    }
+    const Size begin = scan_peak_offsets_[first_scan];
+    const Size end = scan_peak_offsets_[last_scan];
+    spec.reserve(end - begin);
+    for (Size i = begin; i < end; ++i)
+    {
+      spec.emplace_back(mz_[i], intensity_[i]);
+    }
+    auto& fda = spec.getFloatDataArrays().emplace_back(frame_im_arrays_[frame_index]);
+    fda.reserve(end - begin);
+    for (Size scan = first_scan; scan < last_scan; ++scan)
+    {
+      fda.insert(fda.end(), scan_peak_offsets_[scan + 1] - scan_peak_offsets_[scan], scan_drift_times_[scan]);
+    }
+    return spec;
+  }
+
+} //end namespace OpenMS
@@ -5,6 +5,7 @@ set(directory source/IONMOBILITY)
 set(sources_list
 IMTypes.cpp
 IMDataConverter.cpp
+IMFrameMap.cpp
 FAIMSHelper.cpp
 )
 
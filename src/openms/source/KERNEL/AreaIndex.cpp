@@ -0,0 +1,238 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/AreaIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  AreaIndex::AreaIndex(const MSExperiment& exp, UInt ms_level)
+  {
+    build(exp, ms_level);
+  }
+
+  void AreaIndex::build(const MSExperiment& exp, UInt ms_level)
+  {
+    *this = AreaIndex();
+
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      if (exp[i].getMSLevel() == ms_level)
+      {
+        spectrum_index_.push_back(i);
+      }
+    }
+    // index in RT order, even if the experiment is not sorted
+    std::stable_sort(spectrum_index_.begin(), spectrum_index_.end(),
+      [&exp](Size a, Size b) { return exp[a].getRT() < exp[b].getRT(); });
+
+    Size n_peaks(0), n_blocks(0);
+    for (Size i : spectrum_index_)
+    {
+      n_peaks += exp[i].size();
+      n_blocks += (exp[i].size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    }
+    rt_.reserve(spectrum_index_.size());
+    peak_offset_.reserve(spectrum_index_.size() + 1);
+    block_offset_.reserve(spectrum_index_.size() + 1);
+    mz_.reserve(n_peaks);
+    intensity_.reserve(n_peaks);
+    intensity_sum_.reserve(n_peaks + spectrum_index_.size());
+    block_mz_.reserve(n_blocks);
+    block_max_.reserve(n_blocks);
+
+    for (Size i : spectrum_index_)
+    {
+      const MSSpectrum& spec = exp[i];
+      if (!spec.isSorted())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Spectrum " + String(i) + " is not sorted by m/z. Sort the experiment before building an AreaIndex.");
+      }
+      rt_.push_back(spec.getRT());
+      peak_offset_.push_back(mz_.size());
+      block_offset_.push_back(block_mz_.size());
+
+      double sum(0);
+      intensity_sum_.push_back(sum);
+      for (Size p = 0; p < spec.size(); ++p)
+      {
+        const float intensity = spec[p].getIntensity();
+        if (p % BLOCK_SIZE == 0)
+        {
+          block_mz_.push_back(spec[p].getMZ());
+          block_max_.push_back(intensity);
+        }
+        else
+        {
+          block_max_.back() = std::max(block_max_.back(), intensity);
+        }
+        mz_.push_back(spec[p].getMZ());
+        intensity_.push_back(intensity);
+        sum += intensity;
+        intensity_sum_.push_back(sum);
+      }
+    }
+    peak_offset_.push_back(mz_.size());
+    block_offset_.push_back(block_mz_.size());
+  }
+
+  Size AreaIndex::size() const
+  {
+    return rt_.size();
+  }
+
+  bool AreaIndex::empty() const
+  {
+    return rt_.empty();
+  }
+
+  std::pair<Size, Size> AreaIndex::rtRange_(double min_rt, double max_rt) const
+  {
+    Size first = std::lower_bound(rt_.begin(), rt_.end(), min_rt) - rt_.begin();
+    Size last = std::upper_bound(rt_.begin() + first, rt_.end(), max_rt) - rt_.begin();
+    return {first, std::max(first, last)};
+  }
+
+  std::pair<Size, Size> AreaIndex::mzRange_(Size s, double min_mz, double max_mz) const
+  {
+    const Size peak_begin = peak_offset_[s], peak_end = peak_offset_[s + 1];
+    const auto block_begin = block_mz_.begin() + block_offset_[s];
+    const auto block_end = block_mz_.begin() + block_offset_[s + 1];
+
+    // first block whose first m/z is not smaller (resp. larger) than the bound; the position
+    // sought is then either in the preceding block or at the start of that block
+    auto findInBlocks = [&](auto block, auto peak_search) -> Size
+    {
+      Size b = block - block_begin;
+      if (b == 0)
+      {
+        return peak_begin;
+      }
+      const Size first = peak_begin + (b - 1) * BLOCK_SIZE;
+      const Size last = std::min(first + BLOCK_SIZE, peak_end);
+      return peak_search(mz_.begin() + first, mz_.begin() + last) - mz_.begin();
+    };
+
+    const Size lo = findInBlocks(std::lower_bound(block_begin, block_end, min_mz),
+      [min_mz](auto first, auto last) { return std::lower_bound(first, last, min_mz); });
+    const Size hi = findInBlocks(std::upper_bound(block_begin, block_end, max_mz),
+      [max_mz](auto first, auto last) { return std::upper_bound(first, last, max_mz); });
+    return {lo, std::max(lo, hi)};
+  }
+
+  Size AreaIndex::countPeaks(double min_rt, double max_rt, double min_mz, double max_mz) const
+  {
+    Size count(0);
+    const auto rt_range = rtRange_(min_rt, max_rt);
+    for (Size s = rt_range.first; s < rt_range.second; ++s)
+    {
+      const auto mz_range = mzRange_(s, min_mz, max_mz);
+      count += mz_range.second - mz_range.first;
+    }
+    return count;
+  }
+
+  double AreaIndex::sumIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const
+  {
+    double sum(0);
+    const auto rt_range = rtRange_(min_rt, max_rt);
+    for (Size s = rt_range.first; s < rt_range.second; ++s)
+    {
+      const auto mz_range = mzRange_(s, min_mz, max_mz);
+      sum += intensity_sum_[mz_range.second + s] - intensity_sum_[mz_range.first + s];
+    }
+    return sum;
+  }
+
+  double AreaIndex::maxIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const
+  {
+    float max_int(0);
+    const auto rt_range = rtRange_(min_rt, max_rt);
+    for (Size s = rt_range.first; s < rt_range.second; ++s)
+    {
+      auto [lo, hi] = mzRange_(s, min_mz, max_mz);
+      // scan up to the first block boundary, use block maxima for complete blocks, scan the rest
+      const Size peak_begin = peak_offset_[s];
+      Size full_begin = peak_begin + ((lo - peak_begin + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE;
+      Size full_end = peak_begin + ((hi - peak_begin) / BLOCK_SIZE) * BLOCK_SIZE;
+      if (full_begin >= full_end)
+      {
+        full_begin = full_end = hi;
+      }
+      for (Size p = lo; p < full_begin; ++p)
+      {
+        max_int = std::max(max_int, intensity_[p]);
+      }
+      for (Size b = (full_begin - peak_begin) / BLOCK_SIZE; b < (full_end - peak_begin) / BLOCK_SIZE; ++b)
+      {
+        max_int = std::max(max_int, block_max_[block_offset_[s] + b]);
+      }
+      for (Size p = full_end; p < hi; ++p)
+      {
+        max_int = std::max(max_int, intensity_[p]);
+      }
+    }
+    return max_int;
+  }
+
+  void AreaIndex::extractXIC(double min_rt, double max_rt, double min_mz, double max_mz, MSChromatogram& xic) const
+  {
+    xic.clear(false);
+    const auto rt_range = rtRange_(min_rt, max_rt);
+    xic.reserve(rt_range.second - rt_range.first);
+    for (Size s = rt_range.first; s < rt_range.second; ++s)
+    {
+      const auto mz_range = mzRange_(s, min_mz, max_mz);
+      xic.push_back(ChromatogramPeak(rt_[s], intensity_sum_[mz_range.second + s] - intensity_sum_[mz_range.first + s]));
+    }
+  }
+
+  void AreaIndex::getPeaks(double min_rt, double max_rt, double min_mz, double max_mz, std::vector<PeakIndex>& result) const
+  {
+    const auto rt_range = rtRange_(min_rt, max_rt);
+    for (Size s = rt_range.first; s < rt_range.second; ++s)
+    {
+      const auto mz_range = mzRange_(s, min_mz, max_mz);
+      for (Size p = mz_range.first; p < mz_range.second; ++p)
+      {
+        result.emplace_back(spectrum_index_[s], p - peak_offset_[s]);
+      }
+    }
+  }
+}
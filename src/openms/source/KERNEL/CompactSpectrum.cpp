@@ -0,0 +1,106 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/CompactSpectrum.h>
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace OpenMS
+{
+  CompactSpectrum::CompactSpectrum(const MSSpectrum& spectrum)
+  {
+    assign(spectrum);
+  }
+
+  bool CompactSpectrum::operator==(const CompactSpectrum& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return base_mz_ == rhs.base_mz_ &&
+           mz_offset_ == rhs.mz_offset_ &&
+           intensity_ == rhs.intensity_;
+#pragma clang diagnostic pop
+  }
+
+  bool CompactSpectrum::operator!=(const CompactSpectrum& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void CompactSpectrum::assign(const MSSpectrum& spectrum)
+  {
+    clear();
+    if (spectrum.empty())
+    {
+      return;
+    }
+    // the smallest m/z as base keeps all offsets positive and small
+    base_mz_ = std::min_element(spectrum.begin(), spectrum.end(), Peak1D::MZLess())->getMZ();
+
+    mz_offset_.reserve(spectrum.size());
+    intensity_.reserve(spectrum.size());
+    for (const Peak1D& p : spectrum)
+    {
+      const float offset = static_cast<float>(p.getMZ() - base_mz_);
+      max_mz_error_ = std::max(max_mz_error_, std::fabs(base_mz_ + offset - p.getMZ()));
+      mz_offset_.push_back(offset);
+      intensity_.push_back(p.getIntensity());
+    }
+  }
+
+  void CompactSpectrum::exportTo(MSSpectrum& spectrum) const
+  {
+    spectrum.clear(false);
+    spectrum.reserve(size());
+    for (Size i = 0; i < size(); ++i)
+    {
+      spectrum.emplace_back(getMZ(i), getIntensity(i));
+    }
+  }
+
+  void CompactSpectrum::clear()
+  {
+    base_mz_ = 0.0;
+    max_mz_error_ = 0.0;
+    mz_offset_.clear();
+    intensity_.clear();
+  }
+
+  Size CompactSpectrum::getMemoryUsage() const
+  {
+    return sizeof(*this) + (mz_offset_.capacity() + intensity_.capacity()) * sizeof(float);
+  }
+}
@@ -0,0 +1,107 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/FlatConsensusMap.h>
+
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+namespace OpenMS
+{
+  FlatConsensusMap::FlatConsensusMap(const ConsensusMap& map)
+  {
+    assign(map);
+  }
+
+  void FlatConsensusMap::assign(const ConsensusMap& map)
+  {
+    clear();
+    Size n_elements = 0;
+    for (const ConsensusFeature& cf : map)
+    {
+      n_elements += cf.size();
+    }
+    offsets_.reserve(map.size() + 1);
+    map_index_.reserve(n_elements);
+    unique_id_.reserve(n_elements);
+    intensity_.reserve(n_elements);
+    rt_.reserve(n_elements);
+    mz_.reserve(n_elements);
+
+    for (const ConsensusFeature& cf : map)
+    {
+      for (const FeatureHandle& fh : cf.getFeatures())
+      {
+        map_index_.push_back(fh.getMapIndex());
+        unique_id_.push_back(fh.getUniqueId());
+        intensity_.push_back(fh.getIntensity());
+        rt_.push_back(fh.getRT());
+        mz_.push_back(fh.getMZ());
+      }
+      offsets_.push_back(map_index_.size());
+    }
+  }
+
+  void FlatConsensusMap::applyIntensities(ConsensusMap& map) const
+  {
+    if (map.size() != size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Number of consensus features differs: " + String(map.size()) + " (map) vs. " + String(size()));
+    }
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      const ConsensusFeature::HandleSetType& handles = map[i].getFeatures();
+      if (handles.size() != elementsEnd(i) - elementsBegin(i))
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Number of feature handles of consensus feature " + String(i) + " differs");
+      }
+      Size e = elementsBegin(i);
+      for (const FeatureHandle& fh : handles)
+      {
+        fh.asMutable().setIntensity(intensity_[e++]);
+      }
+    }
+  }
+
+  void FlatConsensusMap::clear()
+  {
+    offsets_.assign(1, 0);
+    map_index_.clear();
+    unique_id_.clear();
+    intensity_.clear();
+    rt_.clear();
+    mz_.clear();
+  }
+
+} // namespace OpenMS
@@ -162,9 +162,9 @@ namespace OpenMS
   */
   MSExperiment::ConstIterator MSExperiment::RTBegin(CoordinateType rt) const
   {
-    SpectrumType s;
-    s.setRT(rt);
-    return lower_bound(spectra_.begin(), spectra_.end(), s, SpectrumType::RTLess());
+    // compare against the RT directly instead of constructing a temporary spectrum
+    return lower_bound(spectra_.begin(), spectra_.end(), rt,
+      [](const SpectrumType& spec, CoordinateType value) { return spec.getRT() < value; });
   }
 
   /**
@@ -176,9 +176,8 @@ namespace OpenMS
   */
   MSExperiment::ConstIterator MSExperiment::RTEnd(CoordinateType rt) const
   {
-    SpectrumType s;
-    s.setRT(rt);
-    return upper_bound(spectra_.begin(), spectra_.end(), s, SpectrumType::RTLess());
+    return upper_bound(spectra_.begin(), spectra_.end(), rt,
+      [](CoordinateType value, const SpectrumType& spec) { return value < spec.getRT(); });
   }
 
   /**
@@ -188,9 +187,9 @@ namespace OpenMS
   */
   MSExperiment::Iterator MSExperiment::RTBegin(CoordinateType rt)
   {
-    SpectrumType s;
-    s.setRT(rt);
-    return lower_bound(spectra_.begin(), spectra_.end(), s, SpectrumType::RTLess());
+    // compare against the RT directly instead of constructing a temporary spectrum
+    return lower_bound(spectra_.begin(), spectra_.end(), rt,
+      [](const SpectrumType& spec, CoordinateType value) { return spec.getRT() < value; });
   }
 
   /**
@@ -200,9 +199,106 @@ namespace OpenMS
   */
   MSExperiment::Iterator MSExperiment::RTEnd(CoordinateType rt)
   {
-    SpectrumType s;
-    s.setRT(rt);
-    return upper_bound(spectra_.begin(), spectra_.end(), s, SpectrumType::RTLess());
+    return upper_bound(spectra_.begin(), spectra_.end(), rt,
+      [](CoordinateType value, const SpectrumType& spec) { return value < spec.getRT(); });
+  }
+
+  std::vector<MSChromatogram> MSExperiment::extractXICs(const std::vector<std::pair<RangeMZ, RangeRT> >& ranges, UInt ms_level) const
+  {
+    OPENMS_PRECONDITION(this->isSorted(true), "Experiment is not sorted by RT and m/z! Using extractXICs will give invalid results!")
+
+    // spectra of the requested MS level (in RT order)
+    std::vector<Size> spec_idx;
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      if (spectra_[i].getMSLevel() == ms_level)
+      {
+        spec_idx.push_back(i);
+      }
+    }
+    auto rtLess = [this](Size i, CoordinateType rt) { return spectra_[i].getRT() < rt; };
+    auto rtGreater = [this](CoordinateType rt, Size i) { return rt < spectra_[i].getRT(); };
+
+    // each target covers the spectra [first[t], last[t]) of spec_idx; its chromatogram gets one point per spectrum
+    std::vector<MSChromatogram> xics(ranges.size());
+    std::vector<Size> first(ranges.size(), 0), last(ranges.size(), 0);
+    for (Size t = 0; t < ranges.size(); ++t)
+    {
+      const RangeMZ& mz = ranges[t].first;
+      const RangeRT& rt = ranges[t].second;
+      if (!mz.isEmpty())
+      {
+        xics[t].getProduct().setMZ(mz.center());
+      }
+      if (mz.isEmpty() || rt.isEmpty())
+      {
+        continue;
+      }
+      first[t] = std::lower_bound(spec_idx.begin(), spec_idx.end(), rt.getMin(), rtLess) - spec_idx.begin();
+      last[t] = std::max(first[t], Size(std::upper_bound(spec_idx.begin(), spec_idx.end(), rt.getMax(), rtGreater) - spec_idx.begin()));
+      xics[t].resize(last[t] - first[t]);
+      for (Size s = first[t]; s < last[t]; ++s)
+      {
+        xics[t][s - first[t]] = ChromatogramPeak(spectra_[spec_idx[s]].getRT(), 0.0);
+      }
+    }
+
+    // targets ordered by their first spectrum, for the sweep
+    std::vector<Size> by_first;
+    by_first.reserve(ranges.size());
+    for (Size t = 0; t < ranges.size(); ++t)
+    {
+      if (first[t] < last[t])
+      {
+        by_first.push_back(t);
+      }
+    }
+    std::sort(by_first.begin(), by_first.end(), [&first](Size a, Size b) { return first[a] < first[b]; });
+
+    // sweep over blocks of spectra; each block keeps a set of active targets (and has to find them first, so
+    // blocks should not be too small)
+    const SignedSize block_size = std::max<SignedSize>(64, spec_idx.size() / 256);
+    const SignedSize n_blocks = (SignedSize(spec_idx.size()) + block_size - 1) / block_size;
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize b = 0; b < n_blocks; ++b)
+    {
+      const Size block_begin = b * block_size;
+      const Size block_end = std::min(spec_idx.size(), Size(block_begin + block_size));
+
+      // targets starting before this block that are still active
+      std::vector<Size> active;
+      auto next = by_first.begin();
+      for (; next != by_first.end() && first[*next] < block_begin; ++next)
+      {
+        if (last[*next] > block_begin)
+        {
+          active.push_back(*next);
+        }
+      }
+
+      for (Size s = block_begin; s < block_end; ++s)
+      {
+        for (; next != by_first.end() && first[*next] == s; ++next)
+        {
+          active.push_back(*next);
+        }
+        // drop finished targets
+        active.erase(std::remove_if(active.begin(), active.end(), [&last, s](Size t) { return last[t] <= s; }), active.end());
+
+        const SpectrumType& spec = spectra_[spec_idx[s]];
+        for (Size t : active)
+        {
+          const RangeMZ& mz = ranges[t].first;
+          double intensity(0);
+          for (auto it = spec.MZBegin(mz.getMin()); it != spec.end() && it->getMZ() <= mz.getMax(); ++it)
+          {
+            intensity += it->getIntensity();
+          }
+          xics[t][s - first[t]].setIntensity(intensity);
+        }
+      }
+    }
+    return xics;
   }
 
   //@}
@@ -240,6 +336,25 @@ namespace OpenMS
       return;
     }
 
+    // the ranges of the individual spectra and chromatograms are independent: compute them in parallel
+#pragma omp parallel for schedule(dynamic, 64) if (spectra_.size() > 64)
+    for (SignedSize i = 0; i < (SignedSize)spectra_.size(); ++i)
+    {
+      if (ms_level < Int(0) || Int(spectra_[i].getMSLevel()) == ms_level)
+      {
+        spectra_[i].updateRanges();
+      }
+    }
+#pragma omp parallel for schedule(dynamic, 16) if (chromatograms_.size() > 16)
+    for (SignedSize i = 0; i < (SignedSize)chromatograms_.size(); ++i)
+    {
+      const auto type = chromatograms_[i].getChromatogramType();
+      if (type != ChromatogramSettings::TOTAL_ION_CURRENT_CHROMATOGRAM && type != ChromatogramSettings::EMISSION_CHROMATOGRAM)
+      {
+        chromatograms_[i].updateRanges();
+      }
+    }
+
     // update
     for (Base::iterator it = spectra_.begin(); it != spectra_.end(); ++it)
     {
@@ -256,7 +371,6 @@ namespace OpenMS
 
         // ranges
         this->extendRT(it->getRT()); // RT
-        it->updateRanges();
         this->extend(*it);           // m/z and intensity from spectrum's range
       }
       // for MS level = 1 we extend the range for all the MS2 precursors
@@ -292,7 +406,6 @@ namespace OpenMS
 
       // ranges
       this->extendMZ(cp.getMZ());// MZ
-      cp.updateRanges();
       this->extend(cp);// RT and intensity from chroms's range
     }
   }
@@ -39,6 +39,9 @@
 #include <OpenMS/FORMAT/PeakTypeEstimator.h>
 #include <OpenMS/IONMOBILITY/IMDataConverter.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace OpenMS
 {
   MSSpectrum &MSSpectrum::select(const std::vector<Size> &indices)
@@ -543,6 +546,18 @@ namespace OpenMS
     integer_data_arrays_(source.integer_data_arrays_)
   {}
 
+  MSSpectrum MSSpectrum::copyWithoutPeaks() const
+  {
+    MSSpectrum result;
+    result.SpectrumSettings::operator=(*this);
+    result.retention_time_ = retention_time_;
+    result.drift_time_ = drift_time_;
+    result.drift_time_unit_ = drift_time_unit_;
+    result.ms_level_ = ms_level_;
+    result.name_ = name_;
+    return result;
+  }
+
   MSSpectrum &MSSpectrum::operator=(const SpectrumSettings &source)
   {
     SpectrumSettings::operator=(source);
@@ -552,11 +567,25 @@ namespace OpenMS
   void MSSpectrum::updateRanges()
   {
     clearRanges();
+    if (ContainerType::empty())
+    {
+      return;
+    }
+    // reduce into local variables (the compiler can keep them in registers and vectorize the loop)
+    // instead of extending the member ranges for each peak
+    double min_mz = std::numeric_limits<double>::max(), max_mz = std::numeric_limits<double>::lowest();
+    float min_int = std::numeric_limits<float>::max(), max_int = std::numeric_limits<float>::lowest();
     for (const auto& peak : (ContainerType&)*this)
     {
-      extendMZ(peak.getMZ()); 
-      extendIntensity(peak.getIntensity());
+      min_mz = std::min(min_mz, peak.getMZ());
+      max_mz = std::max(max_mz, peak.getMZ());
+      min_int = std::min(min_int, peak.getIntensity());
+      max_int = std::max(max_int, peak.getIntensity());
     }
+    extendMZ(min_mz);
+    extendMZ(max_mz);
+    extendIntensity(min_int);
+    extendIntensity(max_int);
   }
 
   double MSSpectrum::getRT() const
@@ -54,6 +54,11 @@ namespace OpenMS
     indexed_mzml_file_.setSkipXMLChecks(skip);
   }
 
+  void OnDiscMSExperiment::setMemoryMapped(bool memory_mapped)
+  {
+    indexed_mzml_file_.setMemoryMapped(memory_mapped);
+  }
+
   OpenMS::Interfaces::ChromatogramPtr OnDiscMSExperiment::getChromatogramById(Size id)
   {
     return indexed_mzml_file_.getChromatogramById(id);
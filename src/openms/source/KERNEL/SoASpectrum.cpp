@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/SoASpectrum.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace OpenMS
+{
+  SoASpectrum::SoASpectrum(const MSSpectrum& spectrum)
+  {
+    assign(spectrum);
+  }
+
+  bool SoASpectrum::operator==(const SoASpectrum& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return mz_ == rhs.mz_ &&
+           intensity_ == rhs.intensity_ &&
+           float_data_arrays_ == rhs.float_data_arrays_;
+#pragma clang diagnostic pop
+  }
+
+  bool SoASpectrum::operator!=(const SoASpectrum& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void SoASpectrum::assign(const MSSpectrum& spectrum)
+  {
+    const Size n = spectrum.size();
+    mz_.resize(n);
+    intensity_.resize(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      mz_[i] = spectrum[i].getMZ();
+      intensity_[i] = spectrum[i].getIntensity();
+    }
+    float_data_arrays_ = spectrum.getFloatDataArrays();
+  }
+
+  void SoASpectrum::exportTo(MSSpectrum& spectrum) const
+  {
+    const Size n = size();
+    spectrum.resize(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      spectrum[i].setMZ(mz_[i]);
+      spectrum[i].setIntensity(intensity_[i]);
+    }
+    spectrum.setFloatDataArrays(float_data_arrays_);
+  }
+
+  void SoASpectrum::clear()
+  {
+    mz_.clear();
+    intensity_.clear();
+    float_data_arrays_.clear();
+  }
+
+  bool SoASpectrum::containsIMData() const
+  {
+    DriftTimeUnit unit;
+    for (const auto& fda : float_data_arrays_)
+    {
+      if (IMDataConverter::getIMUnit(fda, unit))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::pair<Size, DriftTimeUnit> SoASpectrum::getIMData() const
+  {
+    DriftTimeUnit unit;
+    for (Size index = 0; index < float_data_arrays_.size(); ++index)
+    {
+      if (IMDataConverter::getIMUnit(float_data_arrays_[index], unit))
+      {
+        return {index, unit};
+      }
+    }
+    throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                        "Cannot get ion mobility data. No float array with the correct name available."
+                                        " Number of float arrays: " + String(float_data_arrays_.size()));
+  }
+
+  bool SoASpectrum::isSorted() const
+  {
+    return std::is_sorted(mz_.begin(), mz_.end());
+  }
+
+  void SoASpectrum::sortByPosition()
+  {
+    if (isSorted())
+    {
+      return;
+    }
+
+    // sort an index list, then permute all arrays of matching length
+    std::vector<Size> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b) { return mz_[a] < mz_[b]; });
+
+    MZArray mz(size());
+    IntensityArray intensity(size());
+    for (Size i = 0; i < order.size(); ++i)
+    {
+      mz[i] = mz_[order[i]];
+      intensity[i] = intensity_[order[i]];
+    }
+    mz_.swap(mz);
+    intensity_.swap(intensity);
+
+    for (auto& fda : float_data_arrays_)
+    {
+      if (fda.size() != order.size())
+      {
+        continue;
+      }
+      std::vector<float> values(fda.size());
+      for (Size i = 0; i < order.size(); ++i)
+      {
+        values[i] = fda[order[i]];
+      }
+      static_cast<std::vector<float>&>(fda).swap(values);
+    }
+  }
+
+} // namespace OpenMS
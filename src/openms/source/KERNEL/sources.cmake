@@ -3,8 +3,10 @@ set(directory source/KERNEL)
 
 ### list all filenames of the directory here
 set(sources_list
+AreaIndex.cpp
 AreaIterator.cpp
 BaseFeature.cpp
+CompactSpectrum.cpp
 ConsensusFeature.cpp
 ConsensusMap.cpp
 ConversionHelper.cpp
@@ -12,6 +14,7 @@ DPeak.cpp
 Feature.cpp
 FeatureHandle.cpp
 FeatureMap.cpp
+FlatConsensusMap.cpp
 MassTrace.cpp
 MRMFeature.cpp
 MRMTransitionGroup.cpp
@@ -23,6 +26,7 @@ Peak2D.cpp
 PeakIndex.cpp
 RangeManager.cpp
 RichPeak2D.cpp
+SoASpectrum.cpp
 StandardTypes.cpp
 ChromatogramPeak.cpp
 MSChromatogram.cpp
@@ -35,6 +35,8 @@
 #include <OpenMS/MATH/MISC/NonNegativeLeastSquaresSolver.h>
 #include <OpenMS/MATH/MISC/NNLS/NNLS.h>
 
+#include <vector>
+
 namespace OpenMS
 {
   Int NonNegativeLeastSquaresSolver::solve(const Matrix<double> & A, const Matrix<double> & b, Matrix<double> & x)
@@ -46,7 +48,7 @@ namespace OpenMS
     }
 
     // translate A to array a (column major order)
-    double * a_vec = new double[A.rows() * A.cols()];
+    std::vector<double> a_vec(A.rows() * A.cols());
     size_t idx = 0;
     for (size_t col = 0; col < A.cols(); ++col)
     {
@@ -66,7 +68,7 @@ namespace OpenMS
     int a_cols = (int)A.cols();
 
     // translate b
-    double * b_vec = new double[a_rows];
+    std::vector<double> b_vec(a_rows);
     for (size_t row = 0; row < b.rows(); ++row)
     {
       b_vec[row] = b(row, 0);
@@ -77,18 +79,18 @@ namespace OpenMS
 #endif
 
     // prepare solution array (directly copied from example)
-    double * x_vec = new double[a_cols + 1];
+    std::vector<double> x_vec(a_cols + 1);
     double rnorm;
-    double * w = new double[a_cols + 1];
-    double * zz = new double[a_rows + 1];
-    int * indx = new int[a_cols + 1];
+    std::vector<double> w(a_cols + 1);
+    std::vector<double> zz(a_rows + 1);
+    std::vector<int> indx(a_cols + 1);
     int mode;
 
 #ifdef NNLS_DEBUG
     std::cout << "solving ..." << std::endl;
 #endif
 
-    NNLS::nnls_(a_vec, &a_rows, &a_rows, &a_cols, b_vec, x_vec, &rnorm, w, zz, indx, &mode);
+    NNLS::nnls_(a_vec.data(), &a_rows, &a_rows, &a_cols, b_vec.data(), x_vec.data(), &rnorm, w.data(), zz.data(), indx.data(), &mode);
 
 
     // translate solution back to Matrix:
@@ -103,14 +105,6 @@ namespace OpenMS
     std::cout << "solution x:\n" << x << std::endl;
 #endif
 
-    // clean up
-    delete[] a_vec;
-    delete[] b_vec;
-    delete[] x_vec;
-    delete[] w;
-    delete[] zz;
-    delete[] indx;
-
     if (mode == 1)
     {
       return SOLVED;
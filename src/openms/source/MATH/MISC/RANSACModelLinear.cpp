@@ -77,10 +77,12 @@ namespace OpenMS::Math
     double RansacModelLinear::rm_rss_impl(const DVecIt& begin, const DVecIt& end, const ModelParameters& coefficients)
     {
       double rss = 0;
+      const double intercept = coefficients[0], slope = coefficients[1];
 
       for (DVecIt it = begin; it != end; ++it)
       {
-        rss += pow(it->second - (coefficients[0] + ( coefficients[1] * it->first)), 2);
+        const double diff = it->second - (intercept + slope * it->first);
+        rss += diff * diff;
       }
 
       return rss;
@@ -89,17 +91,15 @@ namespace OpenMS::Math
     RansacModelLinear::DVec RansacModelLinear::rm_inliers_impl(const DVecIt& begin, const DVecIt& end, const ModelParameters& coefficients, double max_threshold)
     {
       DVec alsoinliers;
-      //std::cerr << "\n\nRANSAC dists: ";
+      const double intercept = coefficients[0], slope = coefficients[1];
       for (DVecIt it = begin; it != end; ++it)
       {
-        double dist = pow(it->second - (coefficients[0] + ( coefficients[1] * it->first)), 2);
-        //std::cerr << dist << ", ";
-        if (dist < max_threshold)
+        const double diff = it->second - (intercept + slope * it->first);
+        if (diff * diff < max_threshold)
         {
           alsoinliers.push_back(*it);
         }
       }
-      //std::cerr << "\n\n";
 
       return alsoinliers;
     }
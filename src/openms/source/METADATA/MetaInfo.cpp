@@ -57,6 +57,11 @@ namespace OpenMS
 
   const DataValue& MetaInfo::getValue(const String& name, const DataValue& default_value) const
   {
+    // avoid the (synchronized) registry lookup if there is nothing to find
+    if (index_to_value_.empty())
+    {
+      return default_value;
+    }
     MapType::const_iterator it = index_to_value_.find(registry_.getIndex(name));
     if (it != index_to_value_.end())
     {
@@ -84,8 +89,8 @@ namespace OpenMS
   void MetaInfo::setValue(UInt index, const DataValue& value)
   {
     // @TODO: check if that index is registered in MetaInfoRegistry?
-    auto it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
+    auto it = index_to_value_.lower_bound(index);
+    if (it != index_to_value_.end() && it->first == index)
     {
       it->second = value;
     }
@@ -95,7 +100,7 @@ namespace OpenMS
       // The underlying flat_map invalidates references to it if inserting
       // an element leads to relocation (e.g, in constructs like: m.insert(1, m[2]));)
       DataValue tmp = value;
-      index_to_value_.insert(std::make_pair(index, tmp));
+      index_to_value_.emplace_hint(it, index, std::move(tmp));
     }
   }
 
@@ -106,6 +111,10 @@ namespace OpenMS
 
   bool MetaInfo::exists(const String& name) const
   {
+    if (index_to_value_.empty())
+    {
+      return false;
+    }
     UInt index = registry_.getIndex(name);
     if (index != UInt(-1))
     {
@@ -121,6 +130,10 @@ namespace OpenMS
 
   void MetaInfo::removeValue(const String& name)
   {
+    if (index_to_value_.empty())
+    {
+      return;
+    }
     MapType::iterator it = index_to_value_.find(registry_.getIndex(name));
     if (it != index_to_value_.end())
     {
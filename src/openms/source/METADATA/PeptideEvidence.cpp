@@ -38,6 +38,15 @@
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// accessions of all peptide evidences (never destroyed, as it must outlive all evidences)
+    InternPool<String>& accessionPool()
+    {
+      static InternPool<String>* pool = new InternPool<String>();
+      return *pool;
+    }
+  }
 
   const int PeptideEvidence::UNKNOWN_POSITION = -1;
   const int PeptideEvidence::N_TERMINAL_POSITION = 0;
@@ -46,7 +55,7 @@ namespace OpenMS
   const char PeptideEvidence::C_TERMINAL_AA = ']';
 
   PeptideEvidence::PeptideEvidence()
-   : accession_(),
+   : accession_(accessionPool().defaultValue()),
      start_(UNKNOWN_POSITION),
      end_(UNKNOWN_POSITION),
      aa_before_(UNKNOWN_AA),
@@ -55,7 +64,7 @@ namespace OpenMS
   }
 
   PeptideEvidence::PeptideEvidence(const String& accession, Int start, Int end, char aa_before, char aa_after) :
-      accession_(accession),
+      accession_(accessionPool().intern(accession)),
       start_(start),
       end_(end),
       aa_before_(aa_before),
@@ -76,7 +85,7 @@ namespace OpenMS
   {
     if (accession_ != rhs.accession_)
     {
-      return accession_ < rhs.accession_;
+      return *accession_ < *rhs.accession_;
     }
     if (start_ != rhs.start_)
     {
@@ -113,12 +122,12 @@ namespace OpenMS
 
   void PeptideEvidence::setProteinAccession(const String& s)
   {
-    accession_ = s;
+    accession_ = accessionPool().intern(s);
   }
 
   const String& PeptideEvidence::getProteinAccession() const
   {
-    return accession_;
+    return *accession_;
   }
 
   void PeptideEvidence::setStart(const Int a)
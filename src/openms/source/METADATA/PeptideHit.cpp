@@ -39,10 +39,37 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// sequences of all peptide hits (never destroyed, as it must outlive all hits)
+    InternPool<AASequence, PeptideHit::SequenceHash>& sequencePool()
+    {
+      static InternPool<AASequence, PeptideHit::SequenceHash>* pool = new InternPool<AASequence, PeptideHit::SequenceHash>();
+      return *pool;
+    }
+  }
+
+  std::size_t PeptideHit::SequenceHash::operator()(const AASequence& seq) const
+  {
+    // residues (incl. their modification) and terminal modifications are unique objects, so their addresses suffice
+    auto combine = [](std::size_t& seed, const void* p)
+    {
+      seed ^= std::hash<const void*>()(p) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    std::size_t seed = seq.size();
+    for (const Residue& r : seq)
+    {
+      combine(seed, &r);
+    }
+    combine(seed, seq.getNTerminalModification());
+    combine(seed, seq.getCTerminalModification());
+    return seed;
+  }
+
   // default constructor
   PeptideHit::PeptideHit() :
     MetaInfoInterface(),
-    sequence_(),
+    sequence_(sequencePool().defaultValue()),
     score_(0),
     analysis_results_(nullptr),
     rank_(0),
@@ -55,7 +82,7 @@ namespace OpenMS
   // values constructor
   PeptideHit::PeptideHit(double score, UInt rank, Int charge, const AASequence& sequence) :
       MetaInfoInterface(),
-      sequence_(sequence),
+      sequence_(sequencePool().intern(sequence)),
       score_(score),
       analysis_results_(nullptr),
       rank_(rank),
@@ -68,7 +95,7 @@ namespace OpenMS
   // values constructor
   PeptideHit::PeptideHit(double score, UInt rank, Int charge, AASequence&& sequence) :
     MetaInfoInterface(),
-    sequence_(sequence),
+    sequence_(sequencePool().intern(std::move(sequence))),
     score_(score),
     analysis_results_(nullptr),
     rank_(rank),
@@ -98,7 +125,7 @@ namespace OpenMS
   /// Move constructor
   PeptideHit::PeptideHit(PeptideHit&& source) noexcept :
     MetaInfoInterface(std::move(source)), // NOTE: rhs itself is an lvalue
-    sequence_(std::move(source.sequence_)),
+    sequence_(source.sequence_),
     score_(source.score_),
     analysis_results_(std::move(source.analysis_results_)),
     rank_(source.rank_),
@@ -208,17 +235,17 @@ namespace OpenMS
   // returns the peptide sequence without trailing or following spaces
   const AASequence& PeptideHit::getSequence() const
   {
-    return sequence_;
+    return *sequence_;
   }
 
   void PeptideHit::setSequence(const AASequence& sequence)
   {
-    sequence_ = sequence;
+    sequence_ = sequencePool().intern(sequence);
   }
 
   void PeptideHit::setSequence(AASequence&& sequence)
   {
-    sequence_ = std::move(sequence);
+    sequence_ = sequencePool().intern(std::move(sequence));
   }
 
   Int PeptideHit::getCharge() const
@@ -40,6 +40,16 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// accessions of all protein hits (never destroyed, as it must outlive all hits)
+    InternPool<String>& accessionPool()
+    {
+      static InternPool<String>* pool = new InternPool<String>();
+      return *pool;
+    }
+  }
+
   const double ProteinHit::COVERAGE_UNKNOWN = -1;
 
   // default constructor
@@ -47,7 +57,7 @@ namespace OpenMS
     MetaInfoInterface(),
     score_(0),
     rank_(0),
-    accession_(""),
+    accession_(accessionPool().defaultValue()),
     sequence_(""),
     coverage_(COVERAGE_UNKNOWN)
   {
@@ -58,7 +68,7 @@ namespace OpenMS
     MetaInfoInterface(),
     score_(score),
     rank_(rank),
-    accession_(accession.trim()),
+    accession_(accessionPool().intern(std::move(accession.trim()))),
     sequence_(sequence.trim()),
     coverage_(COVERAGE_UNKNOWN)
   {
@@ -110,7 +120,7 @@ namespace OpenMS
   // returns the accession of the protein
   const String& ProteinHit::getAccession() const
   {
-    return accession_;
+    return *accession_;
   }
 
   // returns the description of the protein
@@ -161,8 +171,8 @@ namespace OpenMS
   // sets the accession of the protein
   void ProteinHit::setAccession(const String& accession)
   {
-    accession_ = accession;
-    accession_.trim();
+    String trimmed(accession);
+    accession_ = accessionPool().intern(std::move(trimmed.trim()));
   }
 
   // sets the coverage (in percent) of the protein hit based upon matched peptides
@@ -35,12 +35,26 @@
 #include <OpenMS/METADATA/SpectrumLookup.h>
 #include <boost/regex/v4/regex_match.hpp>
 
+#include <algorithm>
+#include <cctype>
+
 using namespace std;
 
 namespace OpenMS
 {
   const String& SpectrumLookup::default_scan_regexp = R"(=(?<SCAN>\d+)$)";
 
+  namespace
+  {
+    // is this the default scan regexp, which can be evaluated without the regex engine?
+    bool isDefaultScanRegExp(const boost::regex& scan_regexp)
+    {
+      const String& def = SpectrumLookup::default_scan_regexp;
+      return (scan_regexp.flags() == boost::regex::normal) && (scan_regexp.size() == def.size()) &&
+        std::equal(scan_regexp.begin(), scan_regexp.end(), def.begin());
+    }
+  }
+
   const String& SpectrumLookup::regexp_names_ = "INDEX0 INDEX1 SCAN ID RT";
 
   SpectrumLookup::SpectrumLookup(): 
@@ -90,7 +104,7 @@ namespace OpenMS
 
   Size SpectrumLookup::findByNativeID(const String& native_id) const
   {
-    map<String, Size>::const_iterator pos = ids_.find(native_id);
+    auto pos = ids_.find(native_id);
     if (pos == ids_.end())
     {
       String element = "spectrum with native ID '" + native_id + "'";
@@ -120,7 +134,7 @@ namespace OpenMS
 
   Size SpectrumLookup::findByScanNumber(Size scan_number) const
   {
-    map<Size, Size>::const_iterator pos = scans_.find(scan_number);
+    auto pos = scans_.find(scan_number);
     if (pos == scans_.end())
     {
       String element = "spectrum with scan number " + String(scan_number);
@@ -262,6 +276,29 @@ namespace OpenMS
                                         const boost::regex& scan_regexp, 
                                         bool no_error)
   {
+    if (isDefaultScanRegExp(scan_regexp))
+    {
+      // "=(?<SCAN>\d+)$": the digits at the end of the native ID, following a '='
+      Size pos = native_id.size();
+      while (pos > 0 && isdigit((unsigned char)native_id[pos - 1])) --pos;
+      if (pos > 0 && pos < native_id.size() && native_id[pos - 1] == '=')
+      {
+        try
+        {
+          return native_id.substr(pos).toInt();
+        }
+        catch (Exception::ConversionError&)
+        {
+        }
+      }
+      if (!no_error)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                    native_id, "Could not extract scan number");
+      }
+      return -1;
+    }
+
     vector<string> matches;
     boost::sregex_token_iterator current_begin(native_id.begin(), native_id.end(), scan_regexp, 1);
     boost::sregex_token_iterator current_end(native_id.end(), native_id.end(), scan_regexp, 1);
@@ -35,7 +35,9 @@
 #include <OpenMS/QC/FragmentMassError.h>
 
 #include <cassert>
+#include <exception>
 #include <string>
+#include <vector>
 
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 #include <OpenMS/CONCEPT/Exception.h>
@@ -131,7 +133,8 @@ namespace OpenMS
     //---------------------------------------------------------------------
     // CREATE THEORETICAL SPECTRUM
     //---------------------------------------------------------------------
-    PeakSpectrum theo_spectrum = TheoreticalSpectrumGenerator::generateSpectrum(act_method, seq, charge);
+    PeakSpectrum theo_spectrum;
+    TheoreticalSpectrumGenerator::generateSpectrum(theo_spectrum, act_method, seq, charge);
 
     //-----------------------------------------------------------------------
     // COMPARE THEORETICAL AND EXPERIMENTAL SPECTRUM
@@ -238,14 +241,40 @@ namespace OpenMS
       }
     }
 
-    bool print_warning {false};
+    // PSMs are independent: collect them first and compute the errors in parallel.
+    // Partial sums are kept per PSM and added up in input order afterwards.
+    std::vector<PeptideIdentification*> pep_ids;
+    fmap.applyFunctionOnPeptideIDs([&pep_ids](PeptideIdentification& pep_id) { pep_ids.push_back(&pep_id); });
 
-    // computes the FragmentMassError
-    std::function<void(PeptideIdentification&)> fCompPPM =
-        [&exp, &map_to_spectrum, &print_warning, tolerance, tolerance_unit, &accumulator_ppm, &counter_ppm, &window_mower_filter](PeptideIdentification& pep_id)
+    std::vector<double> accumulators(pep_ids.size(), 0.0);
+    std::vector<UInt32> counters(pep_ids.size(), 0);
+    std::vector<std::exception_ptr> errors(pep_ids.size());
+#pragma omp parallel
     {
-      calculateFME_(pep_id, exp, map_to_spectrum, print_warning, tolerance, tolerance_unit, accumulator_ppm, counter_ppm, window_mower_filter);
-    };
+      WindowMower thread_filter(window_mower_filter);
+      bool print_warning {false};
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)pep_ids.size(); ++i)
+      {
+        try
+        {
+          calculateFME_(*pep_ids[i], exp, map_to_spectrum, print_warning, tolerance, tolerance_unit, accumulators[i], counters[i], thread_filter);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      }
+    }
+    for (const std::exception_ptr& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
+    for (Size i = 0; i < pep_ids.size(); ++i)
+    {
+      accumulator_ppm += accumulators[i];
+      counter_ppm += counters[i];
+    }
 
     auto fVar =
         [&result, &counter_ppm](const PeptideIdentification& pep_id)
@@ -253,8 +282,6 @@ namespace OpenMS
       calculateVariance_(result, pep_id, counter_ppm);
     };
 
-    // computation of ppms
-    fmap.applyFunctionOnPeptideIDs(fCompPPM);
     // if there are no matching peaks, the counter is zero and it is not possible to find ppms
     if (counter_ppm == 0)
     {
@@ -35,6 +35,7 @@
 #include <OpenMS/QC/PSMExplainedIonCurrent.h>
 
 #include <cfloat>
+#include <exception>
 #include <numeric>
 
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
@@ -105,7 +106,8 @@ namespace OpenMS
     //---------------------------------------------------------------------
     // CREATE THEORETICAL SPECTRUM
     //---------------------------------------------------------------------
-    PeakSpectrum theo_spectrum = TheoreticalSpectrumGenerator::generateSpectrum(act_method, seq, charge);
+    PeakSpectrum theo_spectrum;
+    TheoreticalSpectrumGenerator::generateSpectrum(theo_spectrum, act_method, seq, charge);
 
     //-----------------------------------------------------------------------
     // COMPARE THEORETICAL AND EXPERIMENTAL SPECTRUM
@@ -192,19 +194,41 @@ namespace OpenMS
       }
     }
 
-    std::vector<double> correctnesses;
+    // PSMs are independent: collect them first and annotate them in parallel (keeping the input order of the results)
+    std::vector<PeptideIdentification*> pep_ids;
+    fmap.applyFunctionOnPeptideIDs([&pep_ids](PeptideIdentification& pep_id) { pep_ids.push_back(&pep_id); });
 
-    std::function<void(PeptideIdentification&)> fCorrectness =
-      [&exp, &map_to_spectrum, &correctnesses, &wm_filter, tolerance, tolerance_unit](PeptideIdentification& pep_id)
+    std::vector<double> all_correctnesses(pep_ids.size(), DBL_MAX);
+    std::vector<std::exception_ptr> errors(pep_ids.size());
+#pragma omp parallel
+    {
+      WindowMower thread_filter(wm_filter);
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)pep_ids.size(); ++i)
+      {
+        try
+        {
+          all_correctnesses[i] = annotatePSMExplainedIonCurrent_(*pep_ids[i], exp, map_to_spectrum, thread_filter, tolerance_unit, tolerance);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      }
+    }
+    for (const std::exception_ptr& e : errors)
+    {
+      if (e) std::rethrow_exception(e);
+    }
+
+    std::vector<double> correctnesses;
+    for (double correctness : all_correctnesses)
     {
-      double correctness = annotatePSMExplainedIonCurrent_(pep_id, exp, map_to_spectrum, wm_filter, tolerance_unit, tolerance);
       if (correctness != DBL_MAX)
       {
         correctnesses.push_back(correctness);
       }
-    };
-
-    fmap.applyFunctionOnPeptideIDs(fCorrectness);
+    }
 
     if (correctnesses.empty())
     {
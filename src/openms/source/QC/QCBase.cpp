@@ -51,6 +51,7 @@ namespace OpenMS
   void QCBase::SpectraMap::calculateMap(const MSExperiment& exp)
   {
     nativeid_to_index_.clear();
+    nativeid_to_index_.reserve(exp.size());
     for (Size i = 0; i < exp.size(); ++i)
     {
       nativeid_to_index_[exp[i].getNativeID()] = i;
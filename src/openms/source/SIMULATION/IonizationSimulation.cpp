@@ -295,19 +295,22 @@ public:
     typedef UInt AbundanceType;
     std::atomic<bool> omp_exception {false};
 
+    // RNGs are not thread-safe: every feature gets its own RNG, seeded from a single draw of
+    // the shared technical RNG and the feature index, so results do not depend on the thread count
+    const UInt64 rng_seed = rnd_gen_->getTechnicalRng()();
+
+    // results per input feature; merged in input order after the parallel loop
+    std::vector<std::vector<Feature> > charged_features(features.size());
+    std::vector<ConsensusFeature> charge_consensus_features(features.size());
+    std::vector<char> has_consensus(features.size(), 0);
+
     // iterate over all features
     #pragma omp parallel reduction(+: uncharged_feature_count, undetected_features_count)
     {
       std::vector<UInt> prec_rndbin;
-      // RNGs are not thread-safe... we need a copy for each thread
-      auto rng_tec = rnd_gen_->getTechnicalRng();
       boost::random::discrete_distribution<Size, double> ddist(weights.begin(), weights.end());
-        
-      // local vectors for threads with results. Will be merged at the end.
-      SimTypes::FeatureMapSim t_features;
-      ConsensusMap t_charge_consensus;
 
-      #pragma omp for
+      #pragma omp for schedule(dynamic)
       for (SignedSize index = 0; index < (SignedSize)features.size(); ++index)
       {
         // no barrier here .. only an atomic update of progress value
@@ -334,6 +337,8 @@ public:
           abundance = 1; // keep on going for now, but fail after parallel region;
           omp_exception = true;
         }
+        boost::random::mt19937_64 rng_tec = SimTypes::SimRandomNumberGenerator::createItemRng(rng_seed, index);
+
         UInt basic_residues_c = countIonizedResidues_(features[index].getPeptideIdentifications()[0].getHits()[0].getSequence());
 
         if (basic_residues_c == 0)
@@ -471,7 +476,7 @@ public:
               continue;
             }
 
-            t_features.push_back(charged_feature);
+            charged_features[index].push_back(charged_feature);
 
             // add to consensus
             cf.insert(0, charged_feature);
@@ -482,26 +487,25 @@ public:
         }
 
         // add consensus element containing all charge variants just created
-        t_charge_consensus.push_back(cf);
+        charge_consensus_features[index] = cf;
+        has_consensus[index] = 1;
 
       } // ! for feature  (parallel)
+    } // end omp parallel
+    this->endProgress();
 
-      // merge thread results
-#pragma omp critical (OPENMS_IONSIM_ESI_FINAL)
+    // merge results in input order
+    for (Size index = 0; index < features.size(); ++index)
+    {
+      for (Feature& f : charged_features[index])
       {
-        for (auto& e : t_features)
-        {
-          copy_map.push_back(e);
-        }
-        for (auto& e : t_charge_consensus)
-        {
-          charge_consensus.push_back(e);
-        }
+        copy_map.push_back(f);
       }
-          
-
-    } // end omp parallel
-    this->endProgress();
+      if (has_consensus[index])
+      {
+        charge_consensus.push_back(charge_consensus_features[index]);
+      }
+    }
 
     if (omp_exception)
     {
@@ -400,24 +400,13 @@ namespace OpenMS
 
 
 #ifdef _OPENMP
-      // prepare random numbers for the different threads
-      // each possible thread gets his own set of random
-      // numbers
       Size thread_count = omp_get_max_threads();
 
-      threaded_random_numbers_.resize(thread_count);
-      threaded_random_numbers_index_.resize(thread_count);
       experiments.reserve(thread_count); // !reserve!
       experiments_ct.reserve(thread_count); // !reserve!
       std::vector<SimTypes::MSSimExperiment> experiments_tmp(thread_count - 1); // holds MSExperiments for slave threads
       std::vector<SimTypes::MSSimExperiment> experiments_ct_tmp(thread_count - 1); // holds MSExperiments (centroided) for slave threads
 
-      for (Size i = 0; i < thread_count; ++i)
-      {
-        threaded_random_numbers_[i].resize(THREADED_RANDOM_NUMBER_POOL_SIZE_);
-        threaded_random_numbers_index_[i] = THREADED_RANDOM_NUMBER_POOL_SIZE_;
-      }
-
       if (thread_count > 1)
       {
         // prepare a temporary experiment to store the results
@@ -446,8 +435,12 @@ namespace OpenMS
       Size compress_size_intermediate = 20000 / thread_count; // compress map every X features, (10.000 feature are ~ 2 GB at 0.002 sampling rate)
       Size compress_count = 0; // feature count (for each thread)
 
+      // each feature draws its m/z errors from its own RNG (seeded from the shared technical RNG
+      // and the feature index), so the simulated signal does not depend on the number of threads
+      const UInt64 rng_seed = rnd_gen_->getTechnicalRng()();
+
 #ifdef _OPENMP
-#pragma omp parallel for firstprivate(compress_count)
+#pragma omp parallel for schedule(dynamic) firstprivate(compress_count)
 #endif
       for (SignedSize f = 0; f < (SignedSize)features.size(); ++f)
       {
@@ -456,7 +449,8 @@ namespace OpenMS
 #else
         const int current_thread(0);
 #endif
-        add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]));
+        boost::random::mt19937_64 rng = SimTypes::SimRandomNumberGenerator::createItemRng(rng_seed, f);
+        add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]), rng);
 
         // progresslogger, only master thread sets progress (no barrier here)
 #ifdef _OPENMP
@@ -583,7 +577,7 @@ namespace OpenMS
     samplePeptideModel1D_(isomodel, mz_start, mz_end, experiment, experiment_ct, active_feature);
   }
 
-  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, boost::random::mt19937_64& rng)
   {
     SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0);
 
@@ -648,7 +642,7 @@ namespace OpenMS
 
     // add peptide to GLOBAL MS map
     // add CH and new intensity to feature
-    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature);
+    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature, rng);
   }
 
   void RawMSSignalSimulation::samplePeptideModel1D_(const IsotopeModel& pm,
@@ -705,7 +699,8 @@ namespace OpenMS
                                                     SimTypes::SimCoordinateType rt_end,
                                                     SimTypes::MSSimExperiment& experiment,
                                                     SimTypes::MSSimExperiment& experiment_ct,
-                                                    Feature& active_feature)
+                                                    Feature& active_feature,
+                                                    boost::random::mt19937_64& rng)
   {
     if (rt_start <= 0)
     {
@@ -733,6 +728,7 @@ namespace OpenMS
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Sample the model ...
+    boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
     SimTypes::SimCoordinateType rt(0);
     SimTypes::MSSimExperiment::iterator exp_iter = exp_start;
     SimTypes::MSSimExperiment::iterator exp_ct_iter = exp_ct_start;
@@ -771,37 +767,7 @@ namespace OpenMS
         //OPENMS_LOG_ERROR << "Sampling " << rt << " , " << mz << " -> " << point.getIntensity() << std::endl;
 
         // add Gaussian distributed m/z error
-#ifdef _OPENMP
-        int CURRENT_THREAD = omp_get_thread_num();
-        // check if we need to refill the random number pool for this thread
-        if (threaded_random_numbers_index_[CURRENT_THREAD] == THREADED_RANDOM_NUMBER_POOL_SIZE_)
-        {
-          if (mz_error_stddev_ != 0.0)
-          {
-#pragma omp critical(generate_random_number_for_thread)
-            {
-              boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-              for (Size i = 0; i < THREADED_RANDOM_NUMBER_POOL_SIZE_; ++i)
-              {
-                threaded_random_numbers_[CURRENT_THREAD][i] = ndist(rnd_gen_->getTechnicalRng());
-              }
-            }
-          }
-          else
-          {
-            // we do not need to care about concurrency here
-            fill(threaded_random_numbers_[CURRENT_THREAD].begin(), threaded_random_numbers_[CURRENT_THREAD].end(), mz_error_mean_);
-          }
-          // reset index for this thread to first position
-          threaded_random_numbers_index_[CURRENT_THREAD] = 0;
-        }
-
-        const double mz_err = threaded_random_numbers_[CURRENT_THREAD][threaded_random_numbers_index_[CURRENT_THREAD]++];
-#else
-        // we can use the normal Gaussian ran-gen if we do not use OPENMP
-        boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-        const double mz_err = ndist(rnd_gen_->getTechnicalRng());
-#endif
+        const double mz_err = (mz_error_stddev_ != 0.0) ? ndist(rng) : mz_error_mean_;
         point.setMZ(std::fabs(point.getMZ() + mz_err));
         exp_iter->push_back(point);
 
@@ -999,7 +965,7 @@ namespace OpenMS
       feature.setMetaValue("sum_formula", contaminants_[i].sf.toString()); // formula without adducts or charges
       feature.setCharge(contaminants_[i].q);
       feature.setMetaValue("charge_adducts", "H" + String(contaminants_[i].q)); // adducts separately
-      add2DSignal_(feature, exp, exp_ct);
+      add2DSignal_(feature, exp, exp_ct, rnd_gen_->getTechnicalRng());
       c_map.push_back(feature);
     }
 
@@ -1240,8 +1206,7 @@ namespace OpenMS
       }
 
       // copy Spectrum and remove Peaks ..
-      SimTypes::MSSimExperiment::SpectrumType cont = experiment[i];
-      cont.clear(false);
+      SimTypes::MSSimExperiment::SpectrumType cont = experiment[i].copyWithoutPeaks();
 
       GridTypeIt grid_pos = grid.begin();
       GridTypeIt grid_pos_next(grid_pos + 1);
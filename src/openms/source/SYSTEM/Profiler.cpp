@@ -0,0 +1,236 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  namespace
+  {
+    using json = nlohmann::ordered_json;
+
+    /// a stage of the profile tree
+    struct ProfileNode
+    {
+      String name;
+      ProfileNode* parent = nullptr;
+      std::vector<std::unique_ptr<ProfileNode>> children; // in order of first appearance
+      Size calls = 0;
+      double wall_time = 0.0;
+      double cpu_time = 0.0;
+      Int64 memory_delta = 0; // KB
+      size_t peak_memory = 0; // KB
+      std::map<String, Int64> counters;
+
+      // state while the stage is open
+      StopWatch watch;
+      size_t memory_at_open = 0;
+
+      ProfileNode* child(const String& child_name)
+      {
+        for (auto& c : children)
+        {
+          if (c->name == child_name) return c.get();
+        }
+        children.emplace_back(new ProfileNode());
+        children.back()->name = child_name;
+        children.back()->parent = this;
+        return children.back().get();
+      }
+
+      void open()
+      {
+        ++calls;
+        SysInfo::getProcessMemoryConsumption(memory_at_open);
+        watch.start();
+      }
+
+      void close()
+      {
+        watch.stop();
+        wall_time += watch.getClockTime();
+        cpu_time += watch.getCPUTime();
+        size_t memory(0), peak(0);
+        SysInfo::getProcessMemoryConsumption(memory);
+        SysInfo::getProcessPeakMemoryConsumption(peak);
+        memory_delta += Int64(memory) - Int64(memory_at_open);
+        peak_memory = std::max(peak_memory, peak);
+      }
+
+      json toJSON() const
+      {
+        json j;
+        j["name"] = name;
+        j["calls"] = calls;
+        j["wall_time_s"] = wall_time;
+        j["cpu_time_s"] = cpu_time;
+        j["memory_delta_kb"] = memory_delta;
+        j["peak_memory_kb"] = peak_memory;
+        j["counters"] = json::object();
+        for (const auto& c : counters)
+        {
+          j["counters"][c.first] = c.second;
+        }
+        j["children"] = json::array();
+        for (const auto& c : children)
+        {
+          j["children"].push_back(c->toJSON());
+        }
+        return j;
+      }
+    };
+
+    struct ProfilerState
+    {
+      std::atomic<bool> enabled{false};
+      std::thread::id owner; // thread which enabled the profiler
+      Size session = 1; // incremented by clear(), invalidates open scopes (0 marks inactive scopes)
+      ProfileNode root;
+      ProfileNode* current = &root;
+    };
+
+    ProfilerState& profilerState()
+    {
+      static ProfilerState state;
+      return state;
+    }
+
+    /// may the calling thread record right now?
+    bool recording(const ProfilerState& state)
+    {
+      if (!state.enabled.load(std::memory_order_relaxed)) return false;
+#ifdef _OPENMP
+      if (omp_in_parallel()) return false;
+#endif
+      return std::this_thread::get_id() == state.owner;
+    }
+
+    json stagesToJSON(const ProfileNode& root)
+    {
+      json stages = json::array();
+      for (const auto& c : root.children)
+      {
+        stages.push_back(c->toJSON());
+      }
+      return stages;
+    }
+  }
+
+  Profiler::Scope::Scope(const String& name) :
+    session_(0)
+  {
+    ProfilerState& state = profilerState();
+    if (!recording(state)) return;
+    session_ = state.session;
+    state.current = state.current->child(name);
+    state.current->open();
+  }
+
+  Profiler::Scope::~Scope()
+  {
+    if (session_ == 0) return;
+    ProfilerState& state = profilerState();
+    if (session_ != state.session || state.current == &state.root) return; // cleared in the meantime
+    state.current->close();
+    state.current = state.current->parent;
+  }
+
+  void Profiler::setEnabled(bool enabled)
+  {
+    clear();
+    ProfilerState& state = profilerState();
+    state.owner = std::this_thread::get_id();
+    state.enabled = enabled;
+  }
+
+  bool Profiler::isEnabled()
+  {
+    return profilerState().enabled;
+  }
+
+  void Profiler::addCounter(const String& name, Int64 value)
+  {
+    ProfilerState& state = profilerState();
+    if (!recording(state) || state.current == &state.root) return;
+    state.current->counters[name] += value;
+  }
+
+  void Profiler::clear()
+  {
+    ProfilerState& state = profilerState();
+    state.root.children.clear();
+    state.current = &state.root;
+    // session 0 is reserved for inactive scopes
+    ++state.session;
+  }
+
+  String Profiler::toJSON()
+  {
+    return stagesToJSON(profilerState().root).dump(2);
+  }
+
+  void Profiler::storeJSON(const String& filename, const std::map<String, String>& info)
+  {
+    json j;
+    for (const auto& i : info)
+    {
+      j[i.first] = i.second;
+    }
+    j["stages"] = stagesToJSON(profilerState().root);
+
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    os << j.dump(2) << "\n";
+  }
+
+} // namespace OpenMS
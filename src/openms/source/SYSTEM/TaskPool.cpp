@@ -0,0 +1,191 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/TaskPool.h>
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// pool whose worker is the current thread (nullptr outside of workers)
+    thread_local const TaskPool* current_pool = nullptr;
+
+    /// thread budget set by setThreadBudget() (0: not set)
+    std::atomic<Size> thread_budget{0};
+  }
+
+  TaskPool::TaskPool(Size num_workers)
+  {
+    start_(num_workers);
+  }
+
+  TaskPool::~TaskPool()
+  {
+    stop_();
+  }
+
+  TaskPool& TaskPool::getInstance()
+  {
+    static TaskPool pool(getThreadBudget() - 1);
+    return pool;
+  }
+
+  void TaskPool::setThreadBudget(Size num_threads)
+  {
+    num_threads = std::max(Size(1), num_threads);
+    thread_budget = num_threads;
+#ifdef _OPENMP
+    omp_set_num_threads(static_cast<int>(num_threads));
+    // nested parallel regions would multiply the number of threads
+    omp_set_max_active_levels(1);
+#endif
+    TaskPool& pool = getInstance();
+    if (pool.getNumberOfWorkers() != num_threads - 1)
+    {
+      pool.stop_();
+      pool.start_(num_threads - 1);
+    }
+  }
+
+  Size TaskPool::getThreadBudget()
+  {
+    Size budget = thread_budget;
+    if (budget != 0) return budget;
+#ifdef _OPENMP
+    return std::max(1, omp_get_max_threads());
+#else
+    return std::max(1u, std::thread::hardware_concurrency());
+#endif
+  }
+
+  Size TaskPool::getNumberOfWorkers() const
+  {
+    return workers_.size();
+  }
+
+  bool TaskPool::isWorkerThread_() const
+  {
+    return current_pool == this;
+  }
+
+  void TaskPool::enqueue_(Task task)
+  {
+    Queue& queue = *queues_[next_queue_++ % queues_.size()];
+    {
+      // count the task before a worker can take (and uncount) it
+      std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+      std::lock_guard<std::mutex> queue_lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+      ++pending_;
+    }
+    wake_.notify_one();
+  }
+
+  bool TaskPool::popTask_(Size index, Task& task)
+  {
+    // own queue first, then steal from the others (oldest tasks first, to keep submission order roughly)
+    for (Size i = 0; i < queues_.size(); ++i)
+    {
+      Queue& queue = *queues_[(index + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty())
+      {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void TaskPool::run_(Size index)
+  {
+    current_pool = this;
+#ifdef _OPENMP
+    // OpenMP loops called from tasks run sequentially (the pool already uses the thread budget)
+    omp_set_num_threads(1);
+#endif
+    while (true)
+    {
+      Task task;
+      if (popTask_(index, task))
+      {
+        {
+          std::lock_guard<std::mutex> lock(wake_mutex_);
+          --pending_;
+        }
+        task(); // exceptions are stored in the future by packaged_task
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+      if (stopping_ && pending_ == 0) return;
+    }
+  }
+
+  void TaskPool::start_(Size num_workers)
+  {
+    stopping_ = false;
+    pending_ = 0;
+    for (Size i = 0; i < num_workers; ++i)
+    {
+      queues_.emplace_back(new Queue());
+    }
+    for (Size i = 0; i < num_workers; ++i)
+    {
+      workers_.emplace_back(&TaskPool::run_, this, i);
+    }
+  }
+
+  void TaskPool::stop_()
+  {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+      worker.join();
+    }
+    workers_.clear();
+    queues_.clear();
+  }
+
+} // namespace OpenMS
@@ -8,10 +8,12 @@ File.cpp
 FileWatcher.cpp
 JavaInfo.cpp
 NetworkGetRequest.cpp
+Profiler.cpp
 PythonInfo.cpp
 RWrapper.cpp
 StopWatch.cpp
 SysInfo.cpp
+TaskPool.cpp
 UpdateCheck.cpp
 )
 
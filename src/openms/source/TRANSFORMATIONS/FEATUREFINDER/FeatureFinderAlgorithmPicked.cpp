@@ -139,6 +139,8 @@ namespace OpenMS
     defaults_.setMaxFloat("feature:max_intersection", 1.0);
     defaults_.setValue("feature:reported_mz", "monoisotopic", "The mass type that is reported for features.\n'maximum' returns the m/z value of the highest mass trace.\n'average' returns the intensity-weighted average m/z value of all contained peaks.\n'monoisotopic' returns the monoisotopic m/z value derived from the fitted isotope model.");
     defaults_.setValidStrings("feature:reported_mz", {"maximum","average","monoisotopic"});
+    defaults_.setValue("feature:convex_hulls", "full", "The convex hulls that are reported for the mass traces of features.\n'full' reports the m/z range of each scan.\n'bounding_box' reports only the bounding box of each mass trace, which reduces memory usage and featureXML size considerably.", {"advanced"});
+    defaults_.setValidStrings("feature:convex_hulls", {"full","bounding_box"});
     defaults_.setSectionDescription("feature", "Settings for the features (intensity, quality assessment, ...)");
     //user-specified seed settings
     defaults_.setValue("user-seed:rt_tolerance", 5.0, "Allowed RT deviation of seeds from the user-specified seed position.");
@@ -615,13 +617,27 @@ namespace OpenMS
       // The features are stored in an temporary feature map until it is
       // decided whether they are contained within a seed of higher
       // intensity.
-      std::map<Size, std::vector<Size>> seeds_in_features;
+      //
+      // All seeds are extended and fitted concurrently (a seed does not
+      // know yet whether it will be covered by another feature); the
+      // conflicts are resolved afterwards in order of seed intensity.
+      std::vector<std::vector<Size>> seeds_in_features(seeds.size());
       typedef std::map<Size, Feature> FeatureMapType;
       FeatureMapType tmp_feature_map;
       int gl_progress = 0;
       ff_->startProgress(0, seeds.size(), String("Extending seeds for charge ") + String(c));
 
-#pragma omp parallel for
+      // seed positions sorted by m/z, to find the seeds inside a feature quickly
+      std::vector<std::pair<double, Size>> seed_mz_index;
+      seed_mz_index.reserve(seeds.size());
+      for (Size j = 0; j < seeds.size(); ++j)
+      {
+        seed_mz_index.emplace_back(map_[seeds[j].spectrum][seeds[j].peak].getMZ(), j);
+      }
+      std::sort(seed_mz_index.begin(), seed_mz_index.end());
+
+      // the cost of extension and fitting varies a lot between seeds
+#pragma omp parallel for schedule(dynamic)
       for (SignedSize i = 0; i < (SignedSize)seeds.size(); ++i)
       {
         //------------------------------------------------------------------
@@ -830,40 +846,33 @@ namespace OpenMS
         }
 
         //----------------------------------------------------------------
-        //Remember all seeds that lie inside the convex hull of the new feature
+        //Remember all (weaker) seeds that lie inside the convex hull of the new feature
         DBoundingBox<2> bb = f.getConvexHull().getBoundingBox();
-        for (Size j = i + 1; j < seeds.size(); ++j)
+        std::vector<Size>& contained = seeds_in_features[i]; // only written by this thread
+        for (auto it = std::lower_bound(seed_mz_index.begin(), seed_mz_index.end(), std::make_pair(bb.minPosition()[1], Size(0)));
+             it != seed_mz_index.end() && it->first <= bb.maxPosition()[1]; ++it)
         {
+          Size j = it->second;
+          if (j <= (Size)i) continue;
           double rt = map_[seeds[j].spectrum].getRT();
-          double mz = map_[seeds[j].spectrum][seeds[j].peak].getMZ();
+          double mz = it->first;
           if (bb.encloses(rt, mz) && f.encloses(rt, mz))
           {
-#pragma omp critical(FeatureFinderAlgorithmPicked_SEEDSINFEATURES)
-            {
-              seeds_in_features[i].push_back(j);
-            }
+            contained.push_back(j);
           }
         }
+        std::sort(contained.begin(), contained.end());
       } //end of OPENMP over seeds
 
       // Here we have to evaluate which seeds are already contained in
       // features of seeds with higher intensities. Only if the seed is not
       // used in any feature with higher intensity, we can add it to the
       // features_ list.
-      std::vector<Size> seeds_contained;
+      std::vector<bool> seeds_contained(seeds.size(), false);
       for (auto& f : tmp_feature_map)
       {
         Size seed_nr = f.first;
-        bool is_used = false;
-        for (Size i : seeds_contained)
-        {
-          if (seed_nr == i)
-          {
-            is_used = true;
-            break;
-          }
-        }
-        if (!is_used)
+        if (!seeds_contained[seed_nr])
         {
           ++feature_candidates;
 
@@ -872,10 +881,9 @@ namespace OpenMS
           ++feature_nr_global;
           features_->push_back(f.second);
 
-          std::vector<Size> curr_seed = seeds_in_features[seed_nr];
-          for (Size k : curr_seed)
+          for (Size k : seeds_in_features[seed_nr])
           {
-            seeds_contained.push_back(k);
+            seeds_contained[k] = true;
           }
         }
       }
@@ -1020,6 +1028,18 @@ namespace OpenMS
     features_->sortByIntensity(true);
     ff_->endProgress();
 
+    // the full hulls were needed for resolving overlaps, only report their extent if requested
+    if (bounding_box_hulls_)
+    {
+      for (Feature& f : *features_)
+      {
+        for (ConvexHull2D& hull : f.getConvexHulls())
+        {
+          hull.expandToBoundingBox();
+        }
+      }
+    }
+
     // Abort reasons
     OPENMS_LOG_INFO << '\n';
     OPENMS_LOG_INFO << "Info: reasons for not finalizing a feature during its construction:\n";
@@ -1087,19 +1107,24 @@ namespace OpenMS
     max_rt_span_ = param_.getValue("feature:max_rt_span");
     max_feature_intersection_ = param_.getValue("feature:max_intersection");
     reported_mz_ = param_.getValue("feature:reported_mz").toString();
+    bounding_box_hulls_ = param_.getValue("feature:convex_hulls") == "bounding_box";
   }
 
   /// Writes the abort reason to the log file and counts occurrences for each reason
   void FeatureFinderAlgorithmPicked::abort_(const Seed& seed, const String& reason)
   {
-    if (debug_)
-    {
-      log_ << "Abort: " << reason << std::endl;
-    }
-    aborts_[reason]++;
-    if (debug_)
+    // called from the parallel seed extension
+#pragma omp critical(FeatureFinderAlgorithmPicked_ABORT)
     {
-      abort_reasons_[seed] = reason;
+      if (debug_)
+      {
+        log_ << "Abort: " << reason << std::endl;
+      }
+      aborts_[reason]++;
+      if (debug_)
+      {
+        abort_reasons_[seed] = reason;
+      }
     }
   }
 
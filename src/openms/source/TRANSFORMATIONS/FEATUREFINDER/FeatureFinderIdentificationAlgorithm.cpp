@@ -41,6 +41,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractor.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/SVM/SimpleSVM.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
@@ -304,8 +305,12 @@ namespace OpenMS
     feat_finder_.setParameters(params);
     feat_finder_.setLogType(ProgressLogger::NONE);
     feat_finder_.setStrictFlag(false);
+    // read-only copy of the MS data, shared by the MS1 scores and the chromatogram extraction of all batches:
+    boost::shared_ptr<PeakMap> shared = boost::make_shared<PeakMap>(ms_data_);
+    OpenSwath::SpectrumAccessPtr spec_temp =
+        SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(shared);
     // to use MS1 Swath scores:
-    feat_finder_.setMS1Map(SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(boost::make_shared<MSExperiment>(ms_data_)));
+    feat_finder_.setMS1Map(spec_temp);
 
     double rt_uncertainty(0);
     bool with_external_ids = !peptides_ext.empty();
@@ -449,9 +454,6 @@ namespace OpenMS
     }
     n_external_peps_ = peptide_map_.size() - n_internal_peps_;
 
-    boost::shared_ptr<PeakMap> shared = boost::make_shared<PeakMap>(ms_data_);
-    OpenSwath::SpectrumAccessPtr spec_temp =
-        SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(shared);
     auto chunks = chunk_(peptide_map_.begin(), peptide_map_.end(), batch_size_);
 
     PeptideRefRTMap ref_rt_map;
@@ -472,53 +474,49 @@ namespace OpenMS
     //-------------------------------------------------------------
     //Note: progress only works in non-debug when no logs come in-between
     getProgressLogger().startProgress(0, chunks.size(), "Creating assay library and extracting chromatograms");
+    // Assay libraries are created sequentially, since this updates 'ref_rt_map' and the isotope probabilities.
+    // Chromatogram extraction and feature detection of the batches then run in parallel on the shared MS data.
+    // To limit memory usage, only as many batches as there are threads are kept at a time.
+    Size n_parallel = 1;
+#ifdef _OPENMP
+    n_parallel = omp_get_max_threads();
+#endif
     Size chunk_count = 0;
-    for (auto& chunk : chunks)
+    for (Size wave_start = 0; wave_start < chunks.size(); wave_start += n_parallel)
     {
-      //TODO since ref_rt_map is only used after chunking, we could create
-      // maps per chunk and merge them in the end. Would help in parallelizing as well.
-      createAssayLibrary_(chunk.first, chunk.second, ref_rt_map);
-      OPENMS_LOG_DEBUG << "#Transitions: " << library_.getTransitions().size() << endl;
-
-      ChromatogramExtractor extractor;
-      // extractor.setLogType(ProgressLogger::NONE);
+      Size wave_end = min(chunks.size(), wave_start + n_parallel);
+      vector<TargetedExperiment> libraries;
+      libraries.reserve(wave_end - wave_start);
+      for (Size i = wave_start; i < wave_end; ++i)
       {
-        vector<OpenSwath::ChromatogramPtr> chrom_temp;
-        vector<ChromatogramExtractor::ExtractionCoordinates> coords;
-        // take entries in library_ and put to chrom_temp and coords
-        extractor.prepare_coordinates(chrom_temp, coords, library_,
-                                      numeric_limits<double>::quiet_NaN(), false);
-
-
-        extractor.extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
-                                       mz_window_ppm_, "tophat");
-        extractor.return_chromatogram(chrom_temp, coords, library_, (*shared)[0],
-                                      chrom_data_.getChromatograms(), false);
+        createAssayLibrary_(chunks[i].first, chunks[i].second, ref_rt_map);
+        OPENMS_LOG_DEBUG << "#Transitions: " << library_.getTransitions().size() << endl;
+        libraries.push_back(std::move(library_));
+        library_.clear(true);
       }
 
-      OPENMS_LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
-                       << " chromatogram(s)." << endl;
-
-      OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
       // suppress status output from OpenSWATH, unless in debug mode:
       if (debug_level_ < 1)
       {
         OpenMS_Log_info.remove(cout);
       }
-      feat_finder_.pickExperiment(chrom_data_, features, library_,
-                                  TransformationDescription(), ms_data_);
+      vector<FeatureMap> batch_features(libraries.size());
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)libraries.size(); ++i)
+      {
+        extractAndScoreBatch_(libraries[i], spec_temp, batch_features[i]);
+      }
       if (debug_level_ < 1)
       {
         OpenMS_Log_info.insert(cout); // revert logging change
       }
-      chrom_data_.clear(true);
-      library_.clear(true);
-      // since chrom_data_ here is just a container for the chromatograms and identifications will be empty,
-      // pickExperiment above will only add empty ProteinIdentification runs with colliding identifiers.
-      // Usually we could sanitize the identifiers or merge the runs, but since they are empty and we add the
-      // "real" proteins later -> just clear them
-      features.getProteinIdentifications().clear();
-      getProgressLogger().setProgress(++chunk_count);
+
+      // merge in batch order, so the result does not depend on the number of threads
+      for (FeatureMap& batch : batch_features)
+      {
+        features.insert(features.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+        getProgressLogger().setProgress(++chunk_count);
+      }
     }
     getProgressLogger().endProgress();
 
@@ -915,6 +913,44 @@ namespace OpenMS
     }
   }
 
+  void FeatureFinderIdentificationAlgorithm::extractAndScoreBatch_(const TargetedExperiment& library, OpenSwath::SpectrumAccessPtr ms_data, FeatureMap& features) const
+  {
+    boost::shared_ptr<PeakMap> chrom_data = boost::make_shared<PeakMap>();
+    ChromatogramExtractor extractor;
+    // extractor.setLogType(ProgressLogger::NONE);
+    {
+      vector<OpenSwath::ChromatogramPtr> chrom_temp;
+      vector<ChromatogramExtractor::ExtractionCoordinates> coords;
+      // take entries in library and put to chrom_temp and coords
+      extractor.prepare_coordinates(chrom_temp, coords, library,
+                                    numeric_limits<double>::quiet_NaN(), false);
+
+      extractor.extractChromatograms(ms_data, chrom_temp, coords, mz_window_,
+                                     mz_window_ppm_, "tophat");
+      extractor.return_chromatogram(chrom_temp, coords, library, ms_data_[0],
+                                    chrom_data->getChromatograms(), false);
+    }
+
+    OPENMS_LOG_DEBUG << "Extracted " << chrom_data->getNrChromatograms()
+                     << " chromatogram(s)." << endl;
+
+    OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
+    // the feature finder keeps per-run state, so every batch works on its own copy
+    MRMFeatureFinderScoring feat_finder(feat_finder_);
+    OpenSwath::LightTargetedExperiment transition_exp;
+    OpenSwathDataAccessHelper::convertTargetedExp(library, transition_exp);
+    OpenSwath::SwathMap swath_map;
+    swath_map.sptr = ms_data;
+    MRMFeatureFinderScoring::TransitionGroupMapType transition_group_map;
+    feat_finder.pickExperiment(SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(chrom_data), features,
+                               transition_exp, TransformationDescription(), {swath_map}, transition_group_map);
+    // since the chromatograms here are just a container and identifications will be empty,
+    // pickExperiment above will only add empty ProteinIdentification runs with colliding identifiers.
+    // Usually we could sanitize the identifiers or merge the runs, but since they are empty and we add the
+    // "real" proteins later -> just clear them
+    features.getProteinIdentifications().clear();
+  }
+
   void FeatureFinderIdentificationAlgorithm::getRTRegions_(
     ChargeMap& peptide_data,
     std::vector<RTRegion>& rt_regions,
@@ -85,10 +85,8 @@ namespace OpenMS
     x_init(1) = x0_;
     x_init(2) = sigma_;
 
-    TraceFitter::ModelData data;
-    data.traces_ptr = &traces;
-    data.weighted = this->weighted_;
-    GaussTraceFunctor functor(NUM_PARAMS_, &data);
+    setUpModelData_(traces);
+    GaussTraceFunctor functor(NUM_PARAMS_, &model_data_);
 
     TraceFitter::optimize_(x_init, functor);
   }
@@ -162,7 +160,7 @@ namespace OpenMS
   GaussTraceFitter::GaussTraceFunctor::GaussTraceFunctor(int dimensions,
                                                          const TraceFitter::ModelData* data) :
     TraceFitter::GenericFunctor(dimensions,
-                                static_cast<int>(data->traces_ptr->getPeakCount())),
+                                static_cast<int>(data->rt.size())),
     m_data(data)
   {
   }
@@ -174,17 +172,16 @@ namespace OpenMS
     double sig = x(2);
     double c_fac = -0.5 / pow(sig, 2);
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double baseline = m_data->baseline;
+    const double* rt = m_data->rt.data();
+    const double* intensity = m_data->intensity.data();
+    const double* theo = m_data->theoretical_int.data();
+    const double* weight = m_data->weight.data();
+    double* out = fvec.data();
+    const Size n = m_data->rt.size();
+    for (Size k = 0; k < n; ++k)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        fvec(count) = (m_data->traces_ptr->baseline + trace.theoretical_int * height
-                       * exp(c_fac * pow(trace.peaks[i].first - x0, 2)) - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
-      }
+      out[k] = (baseline + theo[k] * height * exp(c_fac * pow(rt[k] - x0, 2)) - intensity[k]) * weight[k];
     }
 
     return 0;
@@ -200,20 +197,16 @@ namespace OpenMS
     double sig_3 = pow(sig, 3);
     double c_fac = -0.5 / sig_sq;
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const Size n = m_data->rt.size();
+    for (Size k = 0; k < n; ++k)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-        double e = exp(c_fac * pow(rt - x0, 2));
-        J(count, 0) = trace.theoretical_int * e * weight;
-        J(count, 1) = trace.theoretical_int * height * e * (rt - x0) / sig_sq * weight;
-        J(count, 2) = 0.125* trace.theoretical_int* height* e* pow(rt - x0, 2) / sig_3 * weight;
-        ++count;
-      }
+      double rt = m_data->rt[k];
+      double theo = m_data->theoretical_int[k];
+      double weight = m_data->weight[k];
+      double e = exp(c_fac * pow(rt - x0, 2));
+      J(k, 0) = theo * e * weight;
+      J(k, 1) = theo * height * e * (rt - x0) / sig_sq * weight;
+      J(k, 2) = 0.125* theo* height* e* pow(rt - x0, 2) / sig_3 * weight;
     }
     return 0;
   }
@@ -170,23 +170,23 @@ namespace OpenMS
 
   std::vector<std::map<int, GridBasedCluster> > MultiplexClustering::cluster(const std::vector<MultiplexFilteredMSExperiment>& filter_results)
   {
-    // progress logger
-    unsigned progress = 0;
     startProgress(0, filter_results.size(), "clustering filtered LC-MS data");
-      
-    std::vector<std::map<int, GridBasedCluster> > cluster_results;
-
+    
+    std::vector<std::map<int, GridBasedCluster> > cluster_results(filter_results.size());
+    
     // loop over patterns i.e. cluster each of the corresponding filter results
-    for (unsigned i = 0; i < filter_results.size(); ++i)
+    // The filter results of different patterns are clustered independently of each other.
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize) filter_results.size(); ++i)
     {
-      setProgress(++progress);
-        
       GridBasedClustering<MultiplexDistance> clustering(MultiplexDistance(rt_scaling_), filter_results[i].getMZ(), filter_results[i].getRT(), grid_spacing_mz_, grid_spacing_rt_);
       clustering.cluster();
       //clustering.extendClustersY();
-      cluster_results.push_back(clustering.getResults());
+      cluster_results[i] = clustering.getResults();
+      
+      nextProgress();
     }
-
+    
     endProgress();
 
     return cluster_results;
@@ -37,7 +37,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
-#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternCache.h>
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFiltering.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexIsotopicPeakPattern.h>
@@ -106,21 +106,20 @@ namespace OpenMS
       MSSpectrum spectrum_picked_white;
       spectrum_picked_white.setRT(it_rt.getRT());
       
-      std::map<int, int> mapping_spectrum;
-      int count = 0;
+      const std::vector<int>& blacklist_spectrum = blacklist_[&it_rt - &exp_centroided_[0]];
+      std::vector<int> mapping_spectrum;
+      mapping_spectrum.reserve(it_rt.size());
       // loop over m/z
       for (const auto &it_mz : it_rt)
       {
-        if (blacklist_[&it_rt - &exp_centroided_[0]][&it_mz - &it_rt[0]] == -1)
+        if (blacklist_spectrum[&it_mz - &it_rt[0]] == -1)
         {
           spectrum_picked_white.push_back(it_mz);
-          
-          mapping_spectrum[count] = &it_mz - &it_rt[0];
-          ++count;
+          mapping_spectrum.push_back(&it_mz - &it_rt[0]);
         }
       }
-      exp_centroided_white_.addSpectrum(spectrum_picked_white);
-      exp_centroided_mapping_.push_back(mapping_spectrum);
+      exp_centroided_white_.addSpectrum(std::move(spectrum_picked_white));
+      exp_centroided_mapping_.push_back(std::move(mapping_spectrum));
     }
     exp_centroided_white_.updateRanges();
   }
@@ -202,7 +201,7 @@ namespace OpenMS
             // Note that as primary peaks, satellite peaks are also restricted by the blacklist.
             // The peak can either be pure white i.e. untouched, or have been seen earlier as part of the same mass trace.
             size_t rt_idx = it_rt - it_rt_begin;
-            size_t mz_idx = exp_centroided_mapping_.at(it_rt - it_rt_begin).at(i);
+            size_t mz_idx = exp_centroided_mapping_[rt_idx][i];
             
             // Check that the peak has not been blacklisted and is not already in the satellite set.
             if (((blacklist_[rt_idx][mz_idx] == -1) || (blacklist_[rt_idx][mz_idx] == static_cast<int>(mz_shift_idx))) && (!(peak.checkSatellite(rt_idx, mz_idx))))
@@ -341,7 +340,7 @@ namespace OpenMS
     }
     
     // Determine the RT boundaries for each of the mass traces.
-    std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
+    const std::multimap<size_t, MultiplexSatelliteCentroided >& satellites = peak.getSatellites();
     // <rt_boundaries> is a map from the mass trace index to the spectrum indices for beginning and end of the mass trace.
     std::map<size_t, std::pair<size_t, size_t> > rt_boundaries;
     // loop over satellites
@@ -398,6 +397,24 @@ namespace OpenMS
     }
     
   }
+
+  void MultiplexFiltering::addFilteredPeaks_(const std::vector<std::vector<MultiplexFilteredPeak> >& peaks_per_spectrum, unsigned pattern_idx, MultiplexFilteredMSExperiment& result)
+  {
+    for (const auto &peaks : peaks_per_spectrum)
+    {
+      for (const auto &peak : peaks)
+      {
+        // An earlier peak of this pattern might have claimed this one as one of its satellites.
+        if (blacklist_[peak.getRTidx()][peak.getMZidx()] > 0)
+        {
+          continue;
+        }
+        
+        result.addPeak(peak);
+        blacklistPeak_(peak, pattern_idx);
+      }
+    }
+  }
   
   MSExperiment MultiplexFiltering::getBlacklist()
   {
@@ -429,19 +446,19 @@ namespace OpenMS
   {
     // construct averagine distribution
     double mass = peak.getMZ() * pattern.getCharge();
-    CoarseIsotopePatternGenerator solver(isotopes_per_peptide_max_);
+    IsotopePatternCache* cache = IsotopePatternCache::getInstance();
     IsotopeDistribution distribution;
     if (averagine_type_ == "peptide")
     {
-      distribution = solver.estimateFromPeptideWeight(mass);
+      distribution = cache->estimateFromPeptideWeight(mass, isotopes_per_peptide_max_);
     }
     else if (averagine_type_ == "RNA")
     {
-      distribution = solver.estimateFromRNAWeight(mass);
+      distribution = cache->estimateFromRNAWeight(mass, isotopes_per_peptide_max_);
     }
     else if (averagine_type_ == "DNA")
     {
-      distribution = solver.estimateFromDNAWeight(mass);
+      distribution = cache->estimateFromDNAWeight(mass, isotopes_per_peptide_max_);
     }
     else
     {
@@ -58,7 +58,6 @@ namespace OpenMS
   vector<MultiplexFilteredMSExperiment> MultiplexFilteringCentroided::filter()
   {
     // progress logger
-    unsigned progress = 0;
     startProgress(0, patterns_.size() * exp_centroided_.size(), "filtering LC-MS data");
     
     // list of filter results for each peak pattern
@@ -70,42 +69,44 @@ namespace OpenMS
 #endif
 
     // loop over all patterns
+    // Patterns are processed one after the other, since each of them blacklists peaks for all subsequent patterns.
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
-      MultiplexIsotopicPeakPattern pattern = patterns_[pattern_idx];
+      const MultiplexIsotopicPeakPattern& pattern = patterns_[pattern_idx];
       
       // data structure storing peaks which pass all filters for this pattern
       MultiplexFilteredMSExperiment result;
   
       // update white experiment
       updateWhiteMSExperiment_();
+      
+      // peaks which pass all filters, collected separately for each spectrum
+      std::vector<std::vector<MultiplexFilteredPeak> > peaks_per_spectrum(exp_centroided_white_.size());
   
       // filter (white) experiment
       // loop over spectra
-      for (const auto &it_rt : exp_centroided_white_)
+      #pragma omp parallel for schedule(dynamic)
+      for (SignedSize r = 0; r < (SignedSize) exp_centroided_white_.size(); ++r)
       {
+        const MSSpectrum& it_rt = exp_centroided_white_[r];
+        
         // skip empty spectra
         if (it_rt.empty())
         {
           continue;
         }
 
-        setProgress(++progress);
-
         double rt = it_rt.getRT();
-        size_t idx_rt = &it_rt - &exp_centroided_white_[0];
+        size_t idx_rt = r;
         
         MSExperiment::ConstIterator it_rt_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
         MSExperiment::ConstIterator it_rt_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
         
         // loop over m/z
-        //for (MSSpectrum::ConstIterator it_mz = it_rt.begin(); it_mz != it_rt.end(); ++it_mz)
-        #pragma omp parallel for
-        for (SignedSize s = 0; s < (SignedSize) it_rt.size(); s++)
+        for (Size s = 0; s < it_rt.size(); ++s)
         {
-          auto& it_mz = it_rt[s];
-          double mz = it_mz.getMZ();
+          double mz = it_rt[s].getMZ();
           MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][s], idx_rt);
           
           if (!(filterPeakPositions_(mz, exp_centroided_white_.begin(), it_rt_band_begin, it_rt_band_end, pattern, peak)))
@@ -126,15 +127,14 @@ namespace OpenMS
           /**
            * All filters passed.
            */
-
-          #pragma omp critical
-          {
-            result.addPeak(peak);
-            blacklistPeak_(peak, pattern_idx);
-          };
+          
+          peaks_per_spectrum[idx_rt].push_back(peak);
         }
       }
       
+      addFilteredPeaks_(peaks_per_spectrum, pattern_idx, result);
+      setProgress((pattern_idx + 1) * exp_centroided_.size());
+      
 #ifdef DEBUG
       // write filtered peaks to debug output
       std::stringstream debug_out;
@@ -35,7 +35,7 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/BaseFeature.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
-#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternCache.h>
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteringProfile.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
@@ -120,7 +120,6 @@ namespace OpenMS
   vector<MultiplexFilteredMSExperiment> MultiplexFilteringProfile::filter()
   {
     // progress logger
-    unsigned progress = 0;
     startProgress(0, patterns_.size() * exp_spline_profile_.size(), "filtering LC-MS data");
 
     // list of filter results for each peak pattern
@@ -133,6 +132,7 @@ namespace OpenMS
     
     // construct navigators for all spline spectra
     std::vector<SplineInterpolatedPeaks::Navigator> navigators;
+    navigators.reserve(exp_spline_profile_.size());
     for (SplineInterpolatedPeaks& spl : exp_spline_profile_)
     {
       SplineInterpolatedPeaks::Navigator nav = spl.getNavigator();
@@ -140,10 +140,11 @@ namespace OpenMS
     }
     
     // loop over all patterns
+    // Patterns are processed one after the other, since each of them blacklists peaks for all subsequent patterns.
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
-      MultiplexIsotopicPeakPattern pattern = patterns_[pattern_idx];
+      const MultiplexIsotopicPeakPattern& pattern = patterns_[pattern_idx];
       
       // data structure storing peaks which pass all filters
       MultiplexFilteredMSExperiment result;
@@ -151,114 +152,121 @@ namespace OpenMS
       // update white experiment
       updateWhiteMSExperiment_();
       
-      // loop over spectra
-      // loop simultaneously over RT in the spline interpolated profile and (white) centroided experiment (including peak boundaries)
-      for (const auto &it_rt : exp_centroided_white_)
+      // peaks which pass all filters, collected separately for each spectrum
+      std::vector<std::vector<MultiplexFilteredPeak> > peaks_per_spectrum(exp_centroided_white_.size());
+      
+      #pragma omp parallel
       {
-        // retention time
-        double rt = it_rt.getRT();
-        // spectral index in exp_centroided_white_, boundaries_ and exp_spline_profile_
-        size_t idx_rt = &it_rt - &exp_centroided_white_[0];
-        
-        // skip empty spectra
-        if (it_rt.empty() || boundaries_[idx_rt].empty() || exp_spline_profile_[idx_rt].size() == 0)
+        // Navigators remember the spline package of their last look-up. Each thread therefore works on its own copies.
+        std::vector<SplineInterpolatedPeaks::Navigator> thread_navigators(navigators);
+      
+        // loop over spectra
+        // loop simultaneously over RT in the spline interpolated profile and (white) centroided experiment (including peak boundaries)
+        #pragma omp for schedule(dynamic)
+        for (SignedSize r = 0; r < (SignedSize) exp_centroided_white_.size(); ++r)
         {
-          continue;
-        }
-        
-        setProgress(++progress);
-        
-        MSExperiment::ConstIterator it_rt_picked_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
-        MSExperiment::ConstIterator it_rt_picked_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
+          const MSSpectrum& it_rt = exp_centroided_white_[r];
+          // retention time
+          double rt = it_rt.getRT();
+          // spectral index in exp_centroided_white_, boundaries_ and exp_spline_profile_
+          size_t idx_rt = r;
         
-        // loop over mz
-        #pragma omp parallel for
-        for (SignedSize s = 0; s < (SignedSize) it_rt.size(); s++)
-        {
-          double mz = it_rt[s].getMZ();
-          MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][s], idx_rt);
-          
-          if (!(filterPeakPositions_(mz, exp_centroided_white_.begin(), it_rt_picked_band_begin, it_rt_picked_band_end, pattern, peak)))
+          // skip empty spectra
+          if (it_rt.empty() || boundaries_[idx_rt].empty() || exp_spline_profile_[idx_rt].size() == 0)
           {
             continue;
           }
+        
+          MSExperiment::ConstIterator it_rt_picked_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
+          MSExperiment::ConstIterator it_rt_picked_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
+        
+          // loop over mz
+          for (Size s = 0; s < it_rt.size(); ++s)
+          {
+            double mz = it_rt[s].getMZ();
+            MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][s], idx_rt);
           
-          size_t mz_idx = exp_centroided_mapping_[idx_rt][s];
-          double peak_min = boundaries_[idx_rt][mz_idx].mz_min;
-          double peak_max = boundaries_[idx_rt][mz_idx].mz_max;
+            if (!(filterPeakPositions_(mz, exp_centroided_white_.begin(), it_rt_picked_band_begin, it_rt_picked_band_end, pattern, peak)))
+            {
+              continue;
+            }
+          
+            size_t mz_idx = exp_centroided_mapping_[idx_rt][s];
+            double peak_min = boundaries_[idx_rt][mz_idx].mz_min;
+            double peak_max = boundaries_[idx_rt][mz_idx].mz_max;
           
-          //double rt_peak = peak.getRT();
-          double mz_peak = peak.getMZ();
+            //double rt_peak = peak.getRT();
+            double mz_peak = peak.getMZ();
 
-          std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
+            const std::multimap<size_t, MultiplexSatelliteCentroided >& satellites = peak.getSatellites();
           
-          // Arrangement of peaks looks promising. Now scan through the spline fitted profile data around the peak i.e. from peak boundary to peak boundary.
-          for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = navigators[idx_rt].getNextPos(mz_profile))
-          {
-            // determine m/z shift relative to the centroided peak at which the profile data will be sampled
-            double mz_shift = mz_profile - mz_peak;
+            // Arrangement of peaks looks promising. Now scan through the spline fitted profile data around the peak i.e. from peak boundary to peak boundary.
+            for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = thread_navigators[idx_rt].getNextPos(mz_profile))
+            {
+              // determine m/z shift relative to the centroided peak at which the profile data will be sampled
+              double mz_shift = mz_profile - mz_peak;
 
-            std::multimap<size_t, MultiplexSatelliteProfile > satellites_profile;
+              std::multimap<size_t, MultiplexSatelliteProfile > satellites_profile;
 
-            // construct the set of spline-interpolated satellites for this specific mz_profile
-            for (const auto &satellite_it : satellites)
-            {
-              // find indices of the peak
-              size_t rt_idx = (satellite_it.second).getRTidx();
-              size_t mz_idx = (satellite_it.second).getMZidx();
+              // construct the set of spline-interpolated satellites for this specific mz_profile
+              for (const auto &satellite_it : satellites)
+              {
+                // find indices of the peak
+                size_t rt_idx = (satellite_it.second).getRTidx();
+                size_t mz_idx = (satellite_it.second).getMZidx();
               
-              // find peak itself
-              MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
-              std::advance(it_rt, rt_idx);
-              MSSpectrum::ConstIterator it_mz = it_rt->begin();
-              std::advance(it_mz, mz_idx);
+                // find peak itself
+                MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
+                std::advance(it_rt, rt_idx);
+                MSSpectrum::ConstIterator it_mz = it_rt->begin();
+                std::advance(it_mz, mz_idx);
               
-              double rt_satellite = it_rt->getRT();
-              double mz_satellite = it_mz->getMZ();
+                double rt_satellite = it_rt->getRT();
+                double mz_satellite = it_mz->getMZ();
               
-              // determine m/z and corresponding intensity
-              double mz = mz_satellite + mz_shift;
-              double intensity = navigators[rt_idx].eval(mz);
+                // determine m/z and corresponding intensity
+                double mz = mz_satellite + mz_shift;
+                double intensity = thread_navigators[rt_idx].eval(mz);
               
-              satellites_profile.insert(std::make_pair(satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity)));
-            }
+                satellites_profile.insert(std::make_pair(satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity)));
+              }
             
-            if (!(filterAveragineModel_(pattern, peak, satellites_profile)))
-            {
-              continue;
-            }
+              if (!(filterAveragineModel_(pattern, peak, satellites_profile)))
+              {
+                continue;
+              }
             
-            if (!(filterPeptideCorrelation_(pattern, satellites_profile)))
-            {
-              continue;
-            }
+              if (!(filterPeptideCorrelation_(pattern, satellites_profile)))
+              {
+                continue;
+              }
             
-            /**
-             * All filters passed.
-             */
+              /**
+               * All filters passed.
+               */
             
-            // add the satellite data points to the peak
-            for (const auto &it : satellites_profile)
-            {
-              peak.addSatelliteProfile(it.second, it.first);
-            }
+              // add the satellite data points to the peak
+              for (const auto &it : satellites_profile)
+              {
+                peak.addSatelliteProfile(it.second, it.first);
+              }
             
-          }
+            }
           
-          // If some satellite data points passed all filters, we can add the peak to the filter result.
-          if (peak.sizeProfile() > 0)
-          {
-            #pragma omp critical
+            // If some satellite data points passed all filters, we can add the peak to the filter result.
+            if (peak.sizeProfile() > 0)
             {
-              result.addPeak(peak);
-              blacklistPeak_(peak, pattern_idx);
-            };
-          }
+              peaks_per_spectrum[idx_rt].push_back(peak);
+            }
           
-        }
+          }
         
+        }
       }
- 
+      
+      addFilteredPeaks_(peaks_per_spectrum, pattern_idx, result);
+      setProgress((pattern_idx + 1) * exp_spline_profile_.size());
+      
 #ifdef DEBUG
       // write filtered peaks to debug output
       std::stringstream debug_out;
@@ -290,19 +298,19 @@ namespace OpenMS
     // construct averagine distribution
     // Note that the peptide(s) are very close in mass. We therefore calculate the averagine distribution only once (for the lightest peptide).
     double mass = peak.getMZ() * pattern.getCharge();
-    CoarseIsotopePatternGenerator solver(isotopes_per_peptide_max_);
+    IsotopePatternCache* cache = IsotopePatternCache::getInstance();
     IsotopeDistribution distribution;
     if (averagine_type_ == "peptide")
     {
-      distribution = solver.estimateFromPeptideWeight(mass);
+      distribution = cache->estimateFromPeptideWeight(mass, isotopes_per_peptide_max_);
     }
     else if (averagine_type_ == "RNA")
     {
-      distribution = solver.estimateFromRNAWeight(mass);
+      distribution = cache->estimateFromRNAWeight(mass, isotopes_per_peptide_max_);
     }
     else if (averagine_type_ == "DNA")
     {
-      distribution = solver.estimateFromDNAWeight(mass);
+      distribution = cache->estimateFromDNAWeight(mass, isotopes_per_peptide_max_);
     }
     else
     {
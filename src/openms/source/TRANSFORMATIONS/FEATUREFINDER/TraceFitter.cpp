@@ -93,6 +93,34 @@ namespace OpenMS
     return trace.theoretical_int * getValue(rt);
   }
 
+  void TraceFitter::setUpModelData_(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces)
+  {
+    model_data_.traces_ptr = &traces;
+    model_data_.weighted = weighted_;
+    model_data_.baseline = traces.baseline;
+
+    const Size n = traces.getPeakCount();
+    model_data_.rt.resize(n);
+    model_data_.intensity.resize(n);
+    model_data_.theoretical_int.resize(n);
+    model_data_.weight.resize(n);
+
+    Size count = 0;
+    for (Size t = 0; t < traces.size(); ++t)
+    {
+      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = traces[t];
+      double weight = weighted_ ? trace.theoretical_int : 1.0;
+      for (Size i = 0; i < trace.peaks.size(); ++i)
+      {
+        model_data_.rt[count] = trace.peaks[i].first;
+        model_data_.intensity[count] = trace.peaks[i].second->getIntensity();
+        model_data_.theoretical_int[count] = trace.theoretical_int;
+        model_data_.weight[count] = weight;
+        ++count;
+      }
+    }
+  }
+
   void TraceFitter::updateMembers_()
   {
     max_iterations_ = this->param_.getValue("max_iteration");
@@ -35,41 +35,47 @@
 
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/ContinuousWaveletTransformNumIntegration.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
+  std::vector<double> ContinuousWaveletTransformNumIntegration::tabulateKernel_(double spacing_data) const
+  {
+    int half_width = (int)wavelet_.size();
+    int index_in_data = (int)floor((half_width * spacing_) / spacing_data);
+
+    std::vector<double> kernel(index_in_data + 1);
+    for (int k = 0; k <= index_in_data; ++k)
+    {
+      Size index_w = (Size)Math::round((k * spacing_data) / spacing_);
+      kernel[k] = wavelet_[std::min(index_w, wavelet_.size() - 1)];
+    }
+    return kernel;
+  }
+
   double ContinuousWaveletTransformNumIntegration::integrate_
     (const std::vector<double> & processed_input,
+    const std::vector<double> & kernel,
     double spacing_data,
-    int index)
+    int index) const
   {
     double v = 0.;
-    int half_width = (int)wavelet_.size();
-    int index_in_data = (int)floor((half_width * spacing_) / spacing_data);
+    int index_in_data = (int)kernel.size() - 1;
     int offset_data_left = ((index - index_in_data) < 0) ? 0 : (index - index_in_data);
     int offset_data_right = ((index + index_in_data) > (int)processed_input.size() - 1) ? (int)processed_input.size() - 2 : (index + index_in_data);
 
     // integrate from i until offset_data_left
+    for (int i = index; i > offset_data_left; --i)
     {
-      int index_w_r = 0;
-      for (int i = index; i > offset_data_left; --i)
-      {
-        int index_w_l = (int)Math::round(((index - (i - 1)) * spacing_data) / spacing_);
-        // we could also use:
-        // v += spacing_data / 2. * (...), but this can be factored out (see below) for faster computation
-        v += (processed_input[i] * wavelet_[index_w_r] + processed_input[i - 1] * wavelet_[index_w_l]);
-        index_w_r = index_w_l;
-      }
+      // we could also use:
+      // v += spacing_data / 2. * (...), but this can be factored out (see below) for faster computation
+      v += (processed_input[i] * kernel[index - i] + processed_input[i - 1] * kernel[index - i + 1]);
     }
 
     // integrate from i+1 until offset_data_right
+    for (int i = index; i < offset_data_right; ++i)
     {
-      int index_w_l = 0;
-      for (int i = index; i < offset_data_right; ++i)
-      {
-        int index_w_r = (int)Math::round((((i + 1) - index) * spacing_data) / spacing_);
-        v += (processed_input[i + 1] * wavelet_[index_w_r] + processed_input[i] * wavelet_[index_w_l]);
-        index_w_l = index_w_r;
-      }
+      v += (processed_input[i + 1] * kernel[i + 1 - index] + processed_input[i] * kernel[i - index]);
     }
 
     // multiply by (spacing_data / 2.), but change order for better numerical stability
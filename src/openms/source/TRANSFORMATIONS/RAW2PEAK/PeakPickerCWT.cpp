@@ -1067,7 +1067,6 @@ namespace OpenMS
     output.resize(input.size());
     // pick peaks on each scan
     startProgress(0, input.size(), "picking peaks");
-    Size progress = 0;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
@@ -1076,12 +1075,7 @@ namespace OpenMS
       // pick the peaks in scan i
       // this is needed to eliminate empty spectra in the end
       pick(input[i], output[i]);
-#ifdef _OPENMP
-#pragma omp critical (PeakPickerCWT_PickExperiment)
-#endif
-      {
-        setProgress(++progress);             //do not use 'i' here, as each thread will be assigned different blocks
-      }
+      nextProgress();
     }
     //optimize peak positions
     if (two_d_optimization_ || optimization_)
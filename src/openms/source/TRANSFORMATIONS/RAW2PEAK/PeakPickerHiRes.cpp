@@ -38,9 +38,13 @@
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <exception>
 
 
 using namespace std;
@@ -124,6 +128,25 @@ namespace OpenMS
     pick_(input, output, boundaries, check_spacings);
   }
 
+  void PeakPickerHiRes::pick(const SoASpectrum& input, SoASpectrum& output) const
+  {
+    std::vector<PeakBoundary> boundaries;
+    pick(input, output, boundaries);
+  }
+
+  void PeakPickerHiRes::pick(const SoASpectrum& input, SoASpectrum& output, std::vector<PeakBoundary>& boundaries, bool check_spacings) const
+  {
+    output.clear();
+
+    int im_data_index = -1;
+    if (input.containsIMData())
+    {
+      im_data_index = int(input.getIMData().first);
+    }
+
+    pick_(input, output, boundaries, check_spacings, im_data_index);
+  }
+
   template <typename ContainerType>
   void PeakPickerHiRes::pick_(const ContainerType& input,
                               ContainerType& output,
@@ -179,6 +202,13 @@ namespace OpenMS
       double left_neighbor_mz = input[i - 1].getMZ(), left_neighbor_int = input[i - 1].getIntensity();
       double right_neighbor_mz = input[i + 1].getMZ(), right_neighbor_int = input[i + 1].getIntensity();
 
+      // cheap pre-filter: only strict local maxima can become peak cores, so skip
+      // the spacing and S/N lookups for the (vast majority of) other data points
+      if (!(central_peak_int > left_neighbor_int && central_peak_int > right_neighbor_int))
+      {
+        continue;
+      }
+
       // do not interpolate when the left or right support is a zero-data-point
       if (std::fabs(left_neighbor_int) < std::numeric_limits<double>::epsilon())
       {
@@ -466,6 +496,8 @@ namespace OpenMS
                                        std::vector<std::vector<PeakBoundary> >& boundaries_chrom,
                                        const bool check_spectrum_type) const
   {
+    OPENMS_PROFILE_SCOPE("PeakPickerHiRes::pickExperiment");
+
     // make sure that output is clear
     output.clear(true);
 
@@ -475,7 +507,6 @@ namespace OpenMS
     // resize output with respect to input
     output.resize(input.size());
 
-    Size progress = 0;
     startProgress(0, input.size() + input.getChromatograms().size(), "picking peaks");
 
     // MSLevel -> stats
@@ -483,58 +514,106 @@ namespace OpenMS
 
     if (input.getNrSpectra() > 0)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      // spectra are picked independently (in parallel); boundaries and errors are
+      // collected per scan and merged afterwards in scan order, so the result is
+      // identical to a sequential run
+      const SignedSize n_spectra = static_cast<SignedSize>(input.size());
+      std::vector<std::vector<PeakBoundary> > boundaries_per_scan(input.size());
+      std::vector<char> was_picked(input.size(), 0);
+      std::vector<std::exception_ptr> errors(input.size());
+
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize scan_idx = 0; scan_idx < n_spectra; ++scan_idx)
       {
-        bool was_picked{false};
-        // auto mode
-        if (ms_levels_.empty()) 
+        try
         {
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
-          if (spectrum_type == SpectrumSettings::CENTROID)
+          // auto mode
+          if (ms_levels_.empty())
+          {
+            SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
+            if (spectrum_type == SpectrumSettings::CENTROID)
+            {
+              output[scan_idx] = input[scan_idx];
+            }
+            else
+            {
+              pick(input[scan_idx], output[scan_idx], boundaries_per_scan[scan_idx]);
+              was_picked[scan_idx] = 1;
+            }
+          }
+          // manual mode
+          else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel()))
           {
             output[scan_idx] = input[scan_idx];
           }
           else
           {
-            std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-            pick(input[scan_idx], output[scan_idx], boundaries_s);
-            was_picked = true;
-            boundaries_spec.push_back(std::move(boundaries_s));
+            SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
+            if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
+            {
+              throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+            }
+
+            pick(input[scan_idx], output[scan_idx], boundaries_per_scan[scan_idx]);
+            was_picked[scan_idx] = 1;
           }
         }
-        // manual mode
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) 
+        catch (...)
         {
-          output[scan_idx] = input[scan_idx];
+          errors[scan_idx] = std::current_exception();
         }
-        else
-        {
-          std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
+        nextProgress();
+      }
 
-          pick(input[scan_idx], output[scan_idx], boundaries_s);
-          was_picked = true;
-          boundaries_spec.push_back(std::move(boundaries_s));
+      // report the first error in scan order, as the sequential loop did
+      for (const std::exception_ptr& error : errors)
+      {
+        if (error)
+        {
+          endProgress();
+          std::rethrow_exception(error);
         }
-        pick_info[input[scan_idx].getMSLevel()].picked += was_picked;
+      }
+
+      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      {
+        pick_info[input[scan_idx].getMSLevel()].picked += was_picked[scan_idx];
         ++pick_info[input[scan_idx].getMSLevel()].total;
-        setProgress(++progress);
+        if (was_picked[scan_idx])
+        {
+          boundaries_spec.push_back(std::move(boundaries_per_scan[scan_idx]));
+        }
       }
     }
 
+    const SignedSize n_chromatograms = static_cast<SignedSize>(input.getChromatograms().size());
+    std::vector<MSChromatogram> chromatograms(input.getChromatograms().size());
+    std::vector<std::vector<PeakBoundary> > boundaries_per_chrom(input.getChromatograms().size());
+    std::vector<std::exception_ptr> chrom_errors(input.getChromatograms().size());
 
-    for (Size i = 0; i < input.getChromatograms().size(); ++i)
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < n_chromatograms; ++i)
     {
-      MSChromatogram chromatogram;
-      std::vector<PeakBoundary> boundaries_c; // peak boundaries of a single chromatogram
-      pick(input.getChromatograms()[i], chromatogram, boundaries_c);
-      output.addChromatogram(chromatogram);
-      boundaries_chrom.push_back(boundaries_c);
-      setProgress(++progress);
+      try
+      {
+        pick(input.getChromatograms()[i], chromatograms[i], boundaries_per_chrom[i]);
+      }
+      catch (...)
+      {
+        chrom_errors[i] = std::current_exception();
+      }
+      nextProgress();
+    }
+
+    for (Size i = 0; i < chromatograms.size(); ++i)
+    {
+      if (chrom_errors[i])
+      {
+        endProgress();
+        std::rethrow_exception(chrom_errors[i]);
+      }
+      output.addChromatogram(std::move(chromatograms[i]));
+      boundaries_chrom.push_back(std::move(boundaries_per_chrom[i]));
     }
     endProgress();
 
@@ -542,7 +621,9 @@ namespace OpenMS
     for (const auto& info : pick_info)
     {
       OPENMS_LOG_INFO << "  MS-level " << info.first << ": " << info.second.picked << " / " << info.second.total << "\n";
+      Profiler::addCounter("picked_spectra", info.second.picked);
     }
+    Profiler::addCounter("chromatograms", n_chromatograms);
 
     return;
   }
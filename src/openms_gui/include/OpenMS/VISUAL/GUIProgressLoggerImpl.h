@@ -85,7 +85,7 @@ private:
     mutable QProgressDialog* dlg_;
     mutable SignedSize begin_;
     mutable SignedSize end_;
-    mutable SignedSize current_;
+    mutable std::atomic<SignedSize> current_;
   };
 }
 
@@ -56,6 +56,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <bitset>
+#include <list>
 #include <vector>
 
 class QWidget;
@@ -250,6 +251,8 @@ namespace OpenMS
     void setOnDiscPeakData(ODExperimentSharedPtrType p)
     {
       on_disc_peaks = p;
+      on_disc_cache_.clear();
+      on_disc_cache_peaks_ = 0;
     }
 
     /// Returns a mutable reference to the on-disc data
@@ -524,6 +527,18 @@ namespace OpenMS
 
     /// Current cached spectrum
     ExperimentType::SpectrumType cached_spectrum_;
+
+    /// Returns spectrum @p spectrum_idx of the on-disc data; recently decoded spectra are served from on_disc_cache_
+    const ExperimentType::SpectrumType& getOnDiscSpectrum_(Size spectrum_idx) const;
+
+    /// maximum number of spectra in on_disc_cache_
+    static constexpr Size ON_DISC_CACHE_MAX_SPECTRA = 1000;
+    /// maximum number of peaks in on_disc_cache_ (bounds its memory)
+    static constexpr Size ON_DISC_CACHE_MAX_PEAKS = 10000000;
+    /// recently decoded on-disc spectra as (index, spectrum), most recently used first
+    mutable std::list<std::pair<Size, ExperimentType::SpectrumType> > on_disc_cache_;
+    /// number of peaks in on_disc_cache_
+    mutable Size on_disc_cache_peaks_ = 0;
   };
 
   /// A base class to annotate layers of specific types with (identification) data
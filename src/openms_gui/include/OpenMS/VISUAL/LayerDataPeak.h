@@ -35,6 +35,10 @@
 #pragma once
 
 #include <OpenMS/VISUAL/LayerDataBase.h>
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
+
+#include <future>
+#include <memory>
 
 namespace OpenMS
 {
@@ -75,6 +79,29 @@ namespace OpenMS
     }
 
     std::unique_ptr<LayerStatistics> getStats() const override;
+
+    /**
+      @brief Returns the max-intensity tile pyramid of the current peak data (for zoomed-out 2D painting)
+
+      The first call for the current peak data starts building the pyramid in a background thread
+      and returns nullptr, as do all calls until it is finished. If the peak data was replaced
+      (see setPeakData()), the pyramid is rebuilt.
+    */
+    const PeakMapTilePyramid* getTilePyramid() const;
+
+    /// Discards the tile pyramid (waits for a running build). Call before modifying the peak data in place.
+    void invalidateTilePyramid();
+
+  protected:
+    /// waits for a running build and drops the tile pyramid
+    void resetTilePyramid_() const;
+
+    /// peak data the tile pyramid is built (or being built) for
+    mutable ConstExperimentSharedPtrType tile_pyramid_data_;
+    /// running background build of the tile pyramid
+    mutable std::future<std::unique_ptr<PeakMapTilePyramid>> tile_pyramid_future_;
+    /// the finished tile pyramid
+    mutable std::unique_ptr<PeakMapTilePyramid> tile_pyramid_;
   };
 
 }// namespace OpenMS
@@ -0,0 +1,119 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Multi-resolution maximum intensity image of the MS1 peaks of a peak map
+
+    The finest level bins the RT x m/z range of all MS1 peaks into a regular grid and stores
+    the maximum peak intensity of every bin. Each further level halves the resolution in both
+    dimensions. Plot2DCanvas paints zoomed-out views from the coarsest level that is still
+    finer than a screen pixel, instead of visiting every raw peak. At high zoom no level is
+    fine enough and the raw peaks are painted.
+
+    Construction only reads the map, so it can run in a background thread (see LayerDataPeak::getTilePyramid()).
+
+    @ingroup PlotWidgets
+  */
+  class OPENMS_GUI_DLLAPI PeakMapTilePyramid
+  {
+  public:
+    /// One resolution level
+    struct Level
+    {
+      Size rt_bins = 0; ///< number of bins in RT
+      Size mz_bins = 0; ///< number of bins in m/z
+      double rt_bin_width = 0.0; ///< RT width of a bin
+      double mz_bin_width = 0.0; ///< m/z width of a bin
+      std::vector<float> max_intensity; ///< maximum intensity per bin (RT-major), negative for bins without peaks
+    };
+
+    /// Default constructor (empty pyramid)
+    PeakMapTilePyramid() = default;
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      @param map The peak map (spectra sorted by RT, peaks sorted by m/z)
+      @param rt_bins Number of RT bins of the finest level
+      @param mz_bins Number of m/z bins of the finest level
+    */
+    PeakMapTilePyramid(const PeakMap& map, Size rt_bins = 1024, Size mz_bins = 4096);
+
+    /// True if the map contained no MS1 peaks
+    bool empty() const;
+
+    /// All levels, from the finest to the coarsest
+    const std::vector<Level>& getLevels() const;
+
+    /**
+      @brief Returns the coarsest level whose bins are at most half a pixel wide in both dimensions
+
+      @param rt_per_pixel RT width of one screen pixel
+      @param mz_per_pixel m/z width of one screen pixel
+      @return The level or nullptr if no level is fine enough (i.e. raw peaks should be painted)
+    */
+    const Level* selectLevel(double rt_per_pixel, double mz_per_pixel) const;
+
+    /**
+      @brief Maximum intensity of all bins of @p level whose center lies in the given area
+
+      Every bin is assigned to exactly one of several adjacent areas.
+
+      @return The maximum intensity or a negative value if the area contains no peaks
+    */
+    float getMaxIntensity(const Level& level, double rt_start, double rt_end, double mz_start, double mz_end) const;
+
+  protected:
+    /// first bin whose center is >= @p pos (clamped to [0, bins])
+    static Size firstBin_(double pos, double min, double width, Size bins);
+
+    /// lower RT bound of all levels
+    double rt_min_ = 0.0;
+    /// lower m/z bound of all levels
+    double mz_min_ = 0.0;
+    /// levels from the finest to the coarsest
+    std::vector<Level> levels_;
+  };
+
+} // namespace OpenMS
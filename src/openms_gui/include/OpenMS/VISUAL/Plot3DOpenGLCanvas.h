@@ -42,6 +42,9 @@
 
 // OpenMS
 #include <OpenMS/DATASTRUCTURES/DRange.h>
+#include <OpenMS/KERNEL/Peak2D.h>
+
+#include <vector>
 
 namespace OpenMS
 {
@@ -127,6 +130,19 @@ protected:
     GLuint makeGround_();
     /// Builds up a display list for grid lines
     GLuint makeGridLines_();
+    /**
+      @brief Returns the MS1 peaks of layer @p layer_index in the visible area, decimated to about @p max_peaks
+
+      If the area contains more peaks, each spectrum is split into groups of consecutive peaks and only the
+      most intense peak of each group is kept, so prominent signals remain visible.
+    */
+    std::vector<Peak2D> getDisplayedPeaks_(Size layer_index, Size max_peaks) const;
+    /// color of a peak with the given @p intensity in the current intensity mode
+    QColor peakColor_(const LayerDataBase& layer, Size layer_index, double intensity) const;
+    /// appends a vertex and its (RGBA) color to the arrays for drawVertexArray_()
+    static void addVertex_(std::vector<GLfloat>& vertices, std::vector<GLubyte>& colors, GLfloat x, GLfloat y, GLfloat z, const QColor& color);
+    /// draws the vertices (x, y, z triples) with their colors in a single glDrawArrays() call
+    void drawVertexArray_(GLenum mode, const std::vector<GLfloat>& vertices, const std::vector<GLubyte>& colors);
     /// Draws the axis texts
     void drawAxesLegend_();
 
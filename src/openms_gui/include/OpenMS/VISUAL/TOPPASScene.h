@@ -42,6 +42,7 @@
 #include <OpenMS/VISUAL/TOPPASToolVertex.h>
 
 #include <QtWidgets/QGraphicsScene>
+#include <QtCore/QHash>
 #include <QtCore/QProcess>
 
 namespace OpenMS
@@ -93,11 +94,13 @@ public:
     struct TOPPProcess
     {
       /// Constructor
-      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool) :
+      TOPPProcess(QProcess * p, const QString & cmd, const QStringList & arg, TOPPASToolVertex * const tool, int num_threads = 1, int prio = 0) :
         proc(p),
         command(cmd),
         args(arg),
-        tv(tool)
+        tv(tool),
+        threads(num_threads),
+        priority(prio)
       {
       }
 
@@ -109,6 +112,10 @@ public:
       QStringList args;
       /// The tool which is started (used to call its slots)
       TOPPASToolVertex * tv;
+      /// Number of threads the process will use (its '-threads' value); counted against the allowed threads
+      int threads;
+      /// Scheduling priority (length of the remaining tool chain); higher values are started first
+      int priority;
     };
 
     /// The current action mode (creation of a new edge, or panning of the widget)
@@ -206,7 +213,13 @@ public:
     bool askForOutputDir(bool always_ask = true);
     /// Enqueues the process, it will be run when the currently pending processes have finished
     void enqueueProcess(const TOPPProcess & process);
-    /// Runs the next process in the queue, if any
+    /**
+      @brief Starts queued processes as long as their threads fit into the allowed threads
+
+      Processes with the highest priority (i.e. on the longest remaining path of the pipeline) are started first,
+      in order of enqueueing among equal priorities. A process requesting more threads than allowed in total
+      is started once nothing else is running.
+    */
     void runNextProcess();
     /// Resets the processes queue
     void resetProcessesQueue();
@@ -275,8 +288,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called by a finished QProcess to indicate that we are free to start a new one (releases the threads of @p p)
+    void processFinished(QProcess * p);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -355,8 +368,10 @@ protected:
     TOPPASScene * clipboard_;
     /// dry run mode (no tools are actually called)
     bool dry_run_;
-    /// currently running processes...
+    /// threads used by the currently running processes
     int threads_active_;
+    /// threads accounted for each running process
+    QHash<QProcess*, int> process_threads_;
     /// description text
     QString description_text_;
     /// maximum number of allowed threads
@@ -41,6 +41,7 @@
 #include <OpenMS/DATASTRUCTURES/Param.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
+#include <QtCore/QHash>
 #include <QtCore/QVector>
 
 namespace OpenMS
@@ -253,6 +254,8 @@ protected:
     void getParameters_(QVector<IOInfo>& io_infos, bool input_params) const;
     /// Writes @p param to the @p ini_file
     void writeParam_(const Param& param, const QString& ini_file);
+    /// Number of tool vertices on the longest path starting at @p v (including @p v itself); @p memo caches results of visited vertices
+    static int remainingChainLength_(const TOPPASVertex* v, QHash<const TOPPASVertex*, int>& memo);
     /// Helper method for finding good boundaries for wrapping the tool name. Returns a string with whitespaces at the preferred boundaries.
     QString toolnameWithWhitespacesForFancyWordWrapping_(QPainter* painter, const QString& str);
     /// smart naming of round-based filenames
@@ -32,6 +32,7 @@ MultiGradientSelector.h
 OutputDirectory.h
 Painter1DBase.h
 ParamEditor.h
+PeakMapTilePyramid.h
 Plot1DCanvas.h
 Plot1DWidget.h
 Plot2DCanvas.h
@@ -69,6 +69,7 @@
 #include <OpenMS/VISUAL/DIALOGS/TOPPViewOpenDialog.h>
 #include <OpenMS/VISUAL/DIALOGS/TOPPViewPrefDialog.h>
 #include <OpenMS/VISUAL/INTERFACES/IPeptideIds.h>
+#include <OpenMS/VISUAL/LayerDataPeak.h>
 #include <OpenMS/VISUAL/LayerListView.h>
 #include <OpenMS/VISUAL/LogWindow.h>
 #include <OpenMS/VISUAL/MetaDataBrowser.h>
@@ -85,6 +86,7 @@
 
 // Qt
 #include <QCloseEvent>
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QSettings>
 #include <QtCore/QUrl>
@@ -95,7 +97,9 @@
 #include <QtWidgets/QSplashScreen>
 #include <QtWidgets/QToolButton>
 
+#include <chrono>
 #include <cmath>
+#include <future>
 #include <utility>
 
 using namespace std;
@@ -684,8 +688,6 @@ namespace OpenMS
           indexed_mzml_file_.openFile(filename);
           if ( indexed_mzml_file_.getParsingSuccess() && cache_ms2_on_disc)
           {
-            // If it has an index, now load index and meta data
-            on_disc_peaks->openFile(filename, false);
             OPENMS_LOG_INFO << "INFO: will use cached MS2 spectra" << std::endl;
             if (cache_ms1_on_disc)
             {
@@ -701,24 +703,38 @@ namespace OpenMS
             // In a second step (see below), we populate some of these maps
             // with actual spectra including raw data (allowing us to only
             // populate MS1 spectra with actual data).
+            //
+            // Parsing the meta data and decoding the MS1 spectra takes long for large files:
+            // do it in a background thread (nothing else touches the new data yet) and keep the GUI responsive meanwhile.
+            auto loader = std::async(std::launch::async, [&]()
+            {
+              // If it has an index, now load index and meta data
+              on_disc_peaks->openFile(filename, false);
 
-            // peak_map_sptr = boost::static_pointer_cast<ExperimentSharedPtrType>(on_disc_peaks->getMetaData());
-            peak_map_sptr = on_disc_peaks->getMetaData();
+              // peak_map_sptr = boost::static_pointer_cast<ExperimentSharedPtrType>(on_disc_peaks->getMetaData());
+              peak_map_sptr = on_disc_peaks->getMetaData();
 
-            for (Size k = 0; k < indexed_mzml_file_.getNrSpectra() && !cache_ms1_on_disc; k++)
-            {
-              if ( peak_map_sptr->getSpectrum(k).getMSLevel() == 1)
+              for (Size k = 0; k < indexed_mzml_file_.getNrSpectra() && !cache_ms1_on_disc; k++)
               {
-                peak_map_sptr->getSpectrum(k) = on_disc_peaks->getSpectrum(k);
+                if ( peak_map_sptr->getSpectrum(k).getMSLevel() == 1)
+                {
+                  peak_map_sptr->getSpectrum(k) = on_disc_peaks->getSpectrum(k);
+                }
               }
-            }
-            for (Size k = 0; k < indexed_mzml_file_.getNrChromatograms() && !cache_ms2_on_disc; k++)
+              for (Size k = 0; k < indexed_mzml_file_.getNrChromatograms() && !cache_ms2_on_disc; k++)
+              {
+                peak_map_sptr->getChromatogram(k) = on_disc_peaks->getChromatogram(k);
+              }
+
+              // Load at least one spectrum into memory (TOPPView assumes that at least one spectrum is in memory)
+              if (cache_ms1_on_disc && peak_map_sptr->getNrSpectra() > 0) peak_map_sptr->getSpectrum(0) = on_disc_peaks->getSpectrum(0);
+            });
+            while (loader.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready)
             {
-              peak_map_sptr->getChromatogram(k) = on_disc_peaks->getChromatogram(k);
+              // Keep GUI responsive while waiting
+              QCoreApplication::processEvents();
             }
-
-            // Load at least one spectrum into memory (TOPPView assumes that at least one spectrum is in memory)
-            if (cache_ms1_on_disc && peak_map_sptr->getNrSpectra() > 0) peak_map_sptr->getSpectrum(0) = on_disc_peaks->getSpectrum(0);
+            loader.get(); // rethrows errors of the background thread
           }
         }
 
@@ -2655,6 +2671,11 @@ namespace OpenMS
     // reload data
     if (layer.type == LayerDataBase::DT_PEAK) // peak data
     {
+      // the data is replaced in place; drop the tiles built from the old data
+      if (LayerDataPeak* peak_layer = dynamic_cast<LayerDataPeak*>(&layer))
+      {
+        peak_layer->invalidateTilePyramid();
+      }
       try
       {
         FileHandler().loadExperiment(layer.filename, *layer.getPeakDataMuteable());
@@ -45,6 +45,7 @@
 #include <OpenMS/VISUAL/ANNOTATION/Annotation1DPeakItem.h>
 #include <OpenMS/VISUAL/MISC/GUIHelpers.h>
 
+#include <algorithm>
 //#include <iostream>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
@@ -93,10 +94,31 @@ namespace OpenMS
     }
     else if (on_disc_peaks->getNrSpectra() > current_spectrum_idx_)
     {
-      cached_spectrum_ = on_disc_peaks->getSpectrum(current_spectrum_idx_);
+      cached_spectrum_ = getOnDiscSpectrum_(current_spectrum_idx_);
     }
   }
 
+  const LayerDataBase::ExperimentType::SpectrumType& LayerDataBase::getOnDiscSpectrum_(Size spectrum_idx) const
+  {
+    auto it = std::find_if(on_disc_cache_.begin(), on_disc_cache_.end(), [spectrum_idx](const auto& entry) { return entry.first == spectrum_idx; });
+    if (it != on_disc_cache_.end())
+    {
+      // mark as most recently used
+      on_disc_cache_.splice(on_disc_cache_.begin(), on_disc_cache_, it);
+      return on_disc_cache_.front().second;
+    }
+
+    on_disc_cache_.emplace_front(spectrum_idx, on_disc_peaks->getSpectrum(spectrum_idx));
+    on_disc_cache_peaks_ += on_disc_cache_.front().second.size();
+    // evict least recently used spectra (but keep the one just decoded)
+    while (on_disc_cache_.size() > 1 && (on_disc_cache_.size() > ON_DISC_CACHE_MAX_SPECTRA || on_disc_cache_peaks_ > ON_DISC_CACHE_MAX_PEAKS))
+    {
+      on_disc_cache_peaks_ -= on_disc_cache_.back().second.size();
+      on_disc_cache_.pop_back();
+    }
+    return on_disc_cache_.front().second;
+  }
+
   LayerDataBase::OSWDataSharedPtrType& LayerDataBase::getChromatogramAnnotation()
   {
     return chrom_annotation_;
@@ -159,7 +181,7 @@ namespace OpenMS
     }
     else if (!on_disc_peaks->empty())
     {
-      return on_disc_peaks->getSpectrum(spectrum_idx);
+      return getOnDiscSpectrum_(spectrum_idx);
     }
     return (*peak_map_)[spectrum_idx];
   }
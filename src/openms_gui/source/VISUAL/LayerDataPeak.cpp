@@ -37,6 +37,8 @@
 
 #include <OpenMS/VISUAL/Painter1DBase.h>
 
+#include <chrono>
+
 using namespace std;
 
 namespace OpenMS
@@ -56,4 +58,42 @@ namespace OpenMS
     return make_unique<Painter1DPeak>(this);
   }
 
+  const PeakMapTilePyramid* LayerDataPeak::getTilePyramid() const
+  {
+    ConstExperimentSharedPtrType data = getPeakData();
+    if (data != tile_pyramid_data_)
+    {
+      resetTilePyramid_();
+      tile_pyramid_data_ = data;
+      if (data.get() == nullptr)
+      {
+        return nullptr;
+      }
+      // the task holds a reference to the data, so replacing the layer data does not invalidate it
+      tile_pyramid_future_ = std::async(std::launch::async, [data]() { return make_unique<PeakMapTilePyramid>(*data); });
+      return nullptr;
+    }
+    if (tile_pyramid_future_.valid() && tile_pyramid_future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+      tile_pyramid_ = tile_pyramid_future_.get();
+    }
+    return tile_pyramid_.get();
+  }
+
+  void LayerDataPeak::invalidateTilePyramid()
+  {
+    resetTilePyramid_();
+  }
+
+  void LayerDataPeak::resetTilePyramid_() const
+  {
+    if (tile_pyramid_future_.valid())
+    {
+      tile_pyramid_future_.wait();
+      tile_pyramid_future_ = std::future<std::unique_ptr<PeakMapTilePyramid>>();
+    }
+    tile_pyramid_.reset();
+    tile_pyramid_data_.reset();
+  }
+
 }// namespace OpenMS
@@ -0,0 +1,166 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace OpenMS
+{
+  PeakMapTilePyramid::PeakMapTilePyramid(const PeakMap& map, Size rt_bins, Size mz_bins)
+  {
+    // data range of all MS1 peaks (ranges of the map might not be up-to-date)
+    double rt_max = -std::numeric_limits<double>::max();
+    double mz_max = -std::numeric_limits<double>::max();
+    rt_min_ = std::numeric_limits<double>::max();
+    mz_min_ = std::numeric_limits<double>::max();
+    for (const MSSpectrum& spec : map)
+    {
+      if (spec.getMSLevel() != 1 || spec.empty())
+      {
+        continue;
+      }
+      rt_min_ = std::min(rt_min_, spec.getRT());
+      rt_max = std::max(rt_max, spec.getRT());
+      mz_min_ = std::min(mz_min_, spec.front().getMZ());
+      mz_max = std::max(mz_max, spec.back().getMZ());
+    }
+    if (rt_max < rt_min_ || rt_bins == 0 || mz_bins == 0)
+    {
+      rt_min_ = mz_min_ = 0.0;
+      return;
+    }
+
+    // finest level; the upper bound is included in the last bin
+    Level level;
+    level.rt_bins = rt_bins;
+    level.mz_bins = mz_bins;
+    level.rt_bin_width = std::max(rt_max - rt_min_, 1e-6) / rt_bins;
+    level.mz_bin_width = std::max(mz_max - mz_min_, 1e-6) / mz_bins;
+    level.max_intensity.assign(rt_bins * mz_bins, -1.0f);
+    for (const MSSpectrum& spec : map)
+    {
+      if (spec.getMSLevel() != 1 || spec.empty())
+      {
+        continue;
+      }
+      const Size rt_bin = std::min(rt_bins - 1, Size((spec.getRT() - rt_min_) / level.rt_bin_width));
+      float* row = &level.max_intensity[rt_bin * mz_bins];
+      for (const Peak1D& p : spec)
+      {
+        const Size mz_bin = std::min(mz_bins - 1, Size(std::max(0.0, p.getMZ() - mz_min_) / level.mz_bin_width));
+        row[mz_bin] = std::max(row[mz_bin], p.getIntensity());
+      }
+    }
+    levels_.push_back(std::move(level));
+
+    // coarser levels: maximum of 2x2 bins of the previous level
+    while (levels_.back().rt_bins > 16 || levels_.back().mz_bins > 16)
+    {
+      const Level& fine = levels_.back();
+      Level coarse;
+      coarse.rt_bins = (fine.rt_bins + 1) / 2;
+      coarse.mz_bins = (fine.mz_bins + 1) / 2;
+      coarse.rt_bin_width = fine.rt_bin_width * 2;
+      coarse.mz_bin_width = fine.mz_bin_width * 2;
+      coarse.max_intensity.assign(coarse.rt_bins * coarse.mz_bins, -1.0f);
+      for (Size rt = 0; rt < fine.rt_bins; ++rt)
+      {
+        const float* fine_row = &fine.max_intensity[rt * fine.mz_bins];
+        float* coarse_row = &coarse.max_intensity[(rt / 2) * coarse.mz_bins];
+        for (Size mz = 0; mz < fine.mz_bins; ++mz)
+        {
+          coarse_row[mz / 2] = std::max(coarse_row[mz / 2], fine_row[mz]);
+        }
+      }
+      levels_.push_back(std::move(coarse));
+    }
+  }
+
+  bool PeakMapTilePyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  const std::vector<PeakMapTilePyramid::Level>& PeakMapTilePyramid::getLevels() const
+  {
+    return levels_;
+  }
+
+  const PeakMapTilePyramid::Level* PeakMapTilePyramid::selectLevel(double rt_per_pixel, double mz_per_pixel) const
+  {
+    for (auto it = levels_.rbegin(); it != levels_.rend(); ++it)
+    {
+      if (it->rt_bin_width <= 0.5 * rt_per_pixel && it->mz_bin_width <= 0.5 * mz_per_pixel)
+      {
+        return &(*it);
+      }
+    }
+    return nullptr;
+  }
+
+  Size PeakMapTilePyramid::firstBin_(double pos, double min, double width, Size bins)
+  {
+    const double bin = std::ceil((pos - min) / width - 0.5);
+    if (bin <= 0.0)
+    {
+      return 0;
+    }
+    return std::min(bins, Size(bin));
+  }
+
+  float PeakMapTilePyramid::getMaxIntensity(const Level& level, double rt_start, double rt_end, double mz_start, double mz_end) const
+  {
+    const Size rt_first = firstBin_(rt_start, rt_min_, level.rt_bin_width, level.rt_bins);
+    const Size rt_last = firstBin_(rt_end, rt_min_, level.rt_bin_width, level.rt_bins);
+    const Size mz_first = firstBin_(mz_start, mz_min_, level.mz_bin_width, level.mz_bins);
+    const Size mz_last = firstBin_(mz_end, mz_min_, level.mz_bin_width, level.mz_bins);
+
+    float max = -1.0f;
+    for (Size rt = rt_first; rt < rt_last; ++rt)
+    {
+      const float* row = &level.max_intensity[rt * level.mz_bins];
+      for (Size mz = mz_first; mz < mz_last; ++mz)
+      {
+        max = std::max(max, row[mz]);
+      }
+    }
+    return max;
+  }
+
+} // namespace OpenMS
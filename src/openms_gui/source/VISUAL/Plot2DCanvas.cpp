@@ -45,6 +45,7 @@
 #include <OpenMS/VISUAL/DIALOGS/FeatureEditDialog.h>
 #include <OpenMS/VISUAL/DIALOGS/Plot2DPrefDialog.h>
 #include <OpenMS/VISUAL/INTERFACES/IPeptideIds.h>
+#include <OpenMS/VISUAL/LayerDataPeak.h>
 #include <OpenMS/VISUAL/MISC/GUIHelpers.h>
 #include <OpenMS/VISUAL/MultiGradientSelector.h>
 #include <OpenMS/VISUAL/Plot2DCanvas.h>
@@ -632,6 +633,36 @@ namespace OpenMS
     double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
     double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
 
+    // zoomed out: paint from the precomputed max-intensity tiles (if ready) instead of visiting all peaks
+    const LayerDataPeak* peak_layer = dynamic_cast<const LayerDataPeak*>(&layer);
+    if (peak_layer != nullptr && (!layer.filters.isActive() || layer.filters.size() == 0))
+    {
+      const PeakMapTilePyramid* tiles = peak_layer->getTilePyramid();
+      const PeakMapTilePyramid::Level* level = (tiles == nullptr || tiles->empty()) ? nullptr : tiles->selectLevel(rt_step_size, mz_step_size);
+      if (level != nullptr)
+      {
+        for (Size rt = 0; rt < rt_pixel_count; ++rt)
+        {
+          double rt_start = rt_min + rt_step_size * rt;
+          for (Size mz = 0; mz < mz_pixel_count; ++mz)
+          {
+            double mz_start = mz_min + mz_step_size * mz;
+            float max = tiles->getMaxIntensity(*level, rt_start, rt_start + rt_step_size, mz_start, mz_start + mz_step_size);
+            if (max >= 0.0)
+            {
+              QPoint pos;
+              dataToWidget_(mz_start + 0.5 * mz_step_size, rt_start + 0.5 * rt_step_size, pos);
+              if (pos.y() < image_height && pos.x() < image_width)
+              {
+                buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
+              }
+            }
+          }
+        }
+        return;
+      }
+    }
+
     // start at first visible RT scan
     Size scan_index = std::distance(map.begin(), map.RTBegin(rt_min));
     //iterate over all pixels (RT dimension)
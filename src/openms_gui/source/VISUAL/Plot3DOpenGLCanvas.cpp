@@ -534,6 +534,105 @@ namespace OpenMS
     return list;
   }
 
+  std::vector<Peak2D> Plot3DOpenGLCanvas::getDisplayedPeaks_(Size layer_index, Size max_peaks) const
+  {
+    const LayerDataBase& layer = canvas_3d_.getLayer(layer_index);
+    const LayerDataBase::ExperimentType& map = *layer.getPeakData();
+    const double min_mz = canvas_3d_.visible_area_.min_[0];
+    const double max_mz = canvas_3d_.visible_area_.max_[0];
+    auto rt_begin = map.RTBegin(canvas_3d_.visible_area_.min_[1]);
+    auto rt_end = map.RTEnd(canvas_3d_.visible_area_.max_[1]);
+
+    // count MS1 peaks in area (per spectrum, without visiting every peak)
+    Size count = 0;
+    for (auto it = rt_begin; it != rt_end; ++it)
+    {
+      if (it->getMSLevel() == 1)
+      {
+        count += std::distance(it->MZBegin(min_mz), it->MZEnd(max_mz));
+      }
+    }
+    const Size step = (count > max_peaks) ? 1 + count / max_peaks : 1;
+
+    std::vector<Peak2D> peaks;
+    peaks.reserve(count / step + std::distance(rt_begin, rt_end));
+    for (auto it = rt_begin; it != rt_end; ++it)
+    {
+      if (it->getMSLevel() != 1)
+      {
+        continue;
+      }
+      const Size first = it->MZBegin(min_mz) - it->begin();
+      const Size last = it->MZEnd(max_mz) - it->begin();
+      for (Size group = first; group < last; group += step)
+      {
+        // keep the most intense peak of the group (which passes the filters)
+        const Size group_end = std::min(group + step, last);
+        Size best = group_end;
+        for (Size p = group; p < group_end; ++p)
+        {
+          if ((best == group_end || (*it)[p].getIntensity() > (*it)[best].getIntensity()) && layer.filters.passes(*it, p))
+          {
+            best = p;
+          }
+        }
+        if (best != group_end)
+        {
+          Peak2D peak;
+          peak.setRT(it->getRT());
+          peak.setMZ((*it)[best].getMZ());
+          peak.setIntensity((*it)[best].getIntensity());
+          peaks.push_back(peak);
+        }
+      }
+    }
+    return peaks;
+  }
+
+  QColor Plot3DOpenGLCanvas::peakColor_(const LayerDataBase& layer, Size layer_index, double intensity) const
+  {
+    switch (canvas_3d_.intensity_mode_)
+    {
+    case PlotCanvas::IM_PERCENTAGE:
+      return layer.gradient.precalculatedColorAt(intensity * 100.0 / canvas_3d_.getMaxIntensity(layer_index));
+
+    case PlotCanvas::IM_LOG:
+      return layer.gradient.precalculatedColorAt(log10(1 + max(0.0, intensity)));
+
+    case PlotCanvas::IM_NONE:
+    case PlotCanvas::IM_SNAP:
+    default:
+      return layer.gradient.precalculatedColorAt(intensity);
+    }
+  }
+
+  void Plot3DOpenGLCanvas::addVertex_(std::vector<GLfloat>& vertices, std::vector<GLubyte>& colors, GLfloat x, GLfloat y, GLfloat z, const QColor& color)
+  {
+    vertices.push_back(x);
+    vertices.push_back(y);
+    vertices.push_back(z);
+    colors.push_back(GLubyte(color.red()));
+    colors.push_back(GLubyte(color.green()));
+    colors.push_back(GLubyte(color.blue()));
+    colors.push_back(GLubyte(color.alpha()));
+  }
+
+  void Plot3DOpenGLCanvas::drawVertexArray_(GLenum mode, const std::vector<GLfloat>& vertices, const std::vector<GLubyte>& colors)
+  {
+    if (vertices.empty())
+    {
+      return;
+    }
+    // the client state calls are executed immediately, glDrawArrays() copies the arrays into the display list being compiled
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, vertices.data());
+    glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    glDrawArrays(mode, 0, GLsizei(vertices.size() / 3));
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+
   GLuint Plot3DOpenGLCanvas::makeDataAsTopView_()
   {
     GLuint list = glGenLists(1);
@@ -554,65 +653,21 @@ namespace OpenMS
           glShadeModel(GL_FLAT);
         }
 
-        auto begin_it = layer.getPeakData()->areaBeginConst(canvas_3d_.visible_area_.min_[1], canvas_3d_.visible_area_.max_[1], canvas_3d_.visible_area_.min_[0], canvas_3d_.visible_area_.max_[0]);
-        auto end_it = layer.getPeakData()->areaEndConst();
-
-        // count peaks in area
-        int count = std::distance(begin_it, end_it);
-
-        int max_displayed_peaks = 10000;
-        int step = 1;
-        if (count > max_displayed_peaks)
+        // one vertex per peak, drawn with a single call instead of one glBegin()/glEnd() per peak
+        std::vector<Peak2D> peaks = getDisplayedPeaks_(i, 10000);
+        std::vector<GLfloat> vertices;
+        std::vector<GLubyte> colors;
+        vertices.reserve(3 * peaks.size());
+        colors.reserve(4 * peaks.size());
+        for (const Peak2D& peak : peaks)
         {
-          step = 1 + count / max_displayed_peaks;
-        }
-
-        for (auto it = begin_it; it != end_it; ++it)
-        {
-          if (step > 1)
-          {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
-          {
-            glEndList();
-            return list;
-          }
-
-          PeakIndex pi = it.getPeakIndex();
-          if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
-          {
-            glBegin(GL_POINTS);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-            case PlotCanvas::IM_NONE:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case PlotCanvas::IM_PERCENTAGE:
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              break;
-
-            case PlotCanvas::IM_SNAP:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case PlotCanvas::IM_LOG:
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              break;
-
-            }
-            glVertex3f(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                       -corner_,
-                       -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-            glEnd();
-          }
+          addVertex_(vertices, colors,
+                     -corner_ + (GLfloat)scaledMZ_(peak.getMZ()),
+                     -corner_,
+                     -near_ - 2 * corner_ - (GLfloat)scaledRT_(peak.getRT()),
+                     peakColor_(layer, i, peak.getIntensity()));
         }
+        drawVertexArray_(GL_POINTS, vertices, colors);
       }
     }
     glEndList();
@@ -642,95 +697,21 @@ namespace OpenMS
 
         glLineWidth(layer.param.getValue("dot:line_width"));
 
-        auto begin_it = layer.getPeakData()->areaBeginConst(canvas_3d_.visible_area_.min_[1], canvas_3d_.visible_area_.max_[1], canvas_3d_.visible_area_.min_[0], canvas_3d_.visible_area_.max_[0]);
-        auto end_it = layer.getPeakData()->areaEndConst();
-        // count peaks in area
-        int count = std::distance(begin_it, end_it);
-
-        int max_displayed_peaks = 100000;
-        int step = 1;
-        if (count > max_displayed_peaks)
-        {
-          step = 1 + count / max_displayed_peaks;
-        }
-
-        for (auto it = begin_it; it != end_it; ++it)
+        // two vertices (base and tip of the stick) per peak, drawn with a single call
+        std::vector<Peak2D> peaks = getDisplayedPeaks_(i, 100000);
+        std::vector<GLfloat> vertices;
+        std::vector<GLubyte> colors;
+        vertices.reserve(6 * peaks.size());
+        colors.reserve(8 * peaks.size());
+        const QColor base_color = layer.gradient.precalculatedColorAt(0.0);
+        for (const Peak2D& peak : peaks)
         {
-          if (step > 1)
-          {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
-          {
-            glEndList();
-            return list;
-          }
-
-          PeakIndex pi = it.getPeakIndex();
-          if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
-          {
-            glBegin(GL_LINES);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-
-            case PlotCanvas::IM_PERCENTAGE:
-
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case PlotCanvas::IM_NONE:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case PlotCanvas::IM_SNAP:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-
-            case PlotCanvas::IM_LOG:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-            }
-            glEnd();
-          }
+          const GLfloat x = -corner_ + (GLfloat)scaledMZ_(peak.getMZ());
+          const GLfloat z = -near_ - 2 * corner_ - (GLfloat)scaledRT_(peak.getRT());
+          addVertex_(vertices, colors, x, -corner_, z, base_color);
+          addVertex_(vertices, colors, x, -corner_ + (GLfloat)scaledIntensity_(peak.getIntensity(), i), z, peakColor_(layer, i, peak.getIntensity()));
         }
+        drawVertexArray_(GL_LINES, vertices, colors);
       }
     }
     glEndList();
@@ -58,6 +58,7 @@
 #include <QtCore/QTextStream>
 #include <QtWidgets/QMessageBox>
 
+#include <algorithm>
 #include <map>
 
 namespace OpenMS
@@ -1689,9 +1690,9 @@ namespace OpenMS
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* p)
   {
-    --threads_active_;
+    threads_active_ -= process_threads_.take(p);
     // try to run next in line
     runNextProcess();
   }
@@ -2032,9 +2033,19 @@ namespace OpenMS
 
     while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
     {
-      ++threads_active_; // will be decreased, once the tool finishes
-      TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
+      // most critical process first (the first one among equal priorities)
+      auto next = std::max_element(topp_processes_queue_.begin(), topp_processes_queue_.end(),
+                                   [](const TOPPProcess& a, const TOPPProcess& b) { return a.priority < b.priority; });
+      // a process which needs more than all threads gets them all (once the others are done)
+      int threads = std::max(1, std::min(next->threads, allowed_threads_));
+      if (threads_active_ + threads > allowed_threads_)
+      {
+        break; // wait for running processes to free their threads
+      }
+      threads_active_ += threads; // will be decreased, once the tool finishes
+      TOPPProcess tp = *next;
+      topp_processes_queue_.erase(next);
+      process_threads_[tp.proc] = threads;
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
       if (p)
       {
@@ -53,6 +53,7 @@
 #include <QtCore/QRegExp>
 
 #include <QSvgRenderer>
+#include <algorithm>
 #include <map>
 
 namespace OpenMS
@@ -534,6 +535,10 @@ namespace OpenMS
 
     bool ini_round_dependent = false; // indicates if we need a new INI file for each round (usually GenericWrapper issue)
 
+    // schedule tools on long remaining chains first, so the pipeline's critical path is not delayed
+    QHash<const TOPPASVertex*, int> path_lengths;
+    int priority = remainingChainLength_(this, path_lengths);
+
     // maximum number of filenames per TOPP parameter file-list to put on the commandline
     // If more filenames are needed, e.g. for MapAligner's -in/-out etc., they are put in the .INI file
     // to avoid exceeding the 8KB length limit of the Windows commandline
@@ -682,7 +687,8 @@ namespace OpenMS
         }
       }
       toolScheduledSlot();
-      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findSiblingTOPPExecutable(name_).toQString(), args, this));
+      int threads = param_tmp.exists("threads") ? std::max(1, (int)param_tmp.getValue("threads")) : 1;
+      ts->enqueueProcess(TOPPASScene::TOPPProcess(p, File::findSiblingTOPPExecutable(name_).toQString(), args, this, threads, priority));
     }
 
     // run pending processes
@@ -705,12 +711,11 @@ namespace OpenMS
 
     RAIICleanup clean([&]() {
       // clean up at end
+      ts->processFinished(p);
       if (p)
       {
         delete p;
       }
-
-      ts->processFinished();
     });
 
     //** ERROR handling
@@ -1292,6 +1297,23 @@ namespace OpenMS
     paramFile.store(ini_file, save_param);
   }
 
+  int TOPPASToolVertex::remainingChainLength_(const TOPPASVertex* v, QHash<const TOPPASVertex*, int>& memo)
+  {
+    auto it = memo.constFind(v);
+    if (it != memo.constEnd())
+    {
+      return it.value();
+    }
+    int longest = 0;
+    for (ConstEdgeIterator e = v->outEdgesBegin(); e != v->outEdgesEnd(); ++e)
+    {
+      longest = std::max(longest, remainingChainLength_((*e)->getTargetVertex(), memo));
+    }
+    int length = longest + (qobject_cast<const TOPPASToolVertex*>(v) ? 1 : 0);
+    memo.insert(v, length);
+    return length;
+  }
+
   void TOPPASToolVertex::toggleBreakpoint()
   {
     breakpoint_set_ = !breakpoint_set_;
@@ -37,6 +37,7 @@ OutputDirectory.ui
 Painter1DBase.cpp
 ParamEditor.cpp
 ParamEditor.ui
+PeakMapTilePyramid.cpp
 Plot1DCanvas.cpp
 Plot1DWidget.cpp
 Plot2DCanvas.cpp
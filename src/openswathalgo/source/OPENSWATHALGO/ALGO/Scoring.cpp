@@ -169,40 +169,113 @@ namespace OpenSwath::Scoring
     XCorrArrayType normalizedCrossCorrelationPost(std::vector<double>& normalized_data1,
                                                   std::vector<double>& normalized_data2, const int maxdelay, const int lag = 1)
     {
-      XCorrArrayType result = calculateCrossCorrelation(normalized_data1, normalized_data2, maxdelay, lag);
+      XCorrArrayType result;
+      normalizedCrossCorrelationPost(normalized_data1, normalized_data2, maxdelay, lag, result);
+      return result;
+    }
+
+    void normalizedCrossCorrelationPost(const std::vector<double>& normalized_data1,
+                                        const std::vector<double>& normalized_data2, const int maxdelay, const int lag,
+                                        XCorrArrayType& result)
+    {
+      calculateCrossCorrelation(normalized_data1, normalized_data2, maxdelay, lag, result);
 
       for (XCorrArrayType::iterator it = result.begin(); it != result.end(); ++it)
       {
         it->second /= normalized_data1.size();
       }
-      return result;
     }
 
     XCorrArrayType calculateCrossCorrelation(const std::vector<double>& data1,
                                              const std::vector<double>& data2, const int maxdelay, const int lag)
+    {
+      XCorrArrayType result;
+      calculateCrossCorrelation(data1, data2, maxdelay, lag, result);
+      return result;
+    }
+
+    namespace
+    {
+      // adds data1[i] * data2[i + delay] for i in [begin, end) to sxy, in order of increasing i
+      inline double addShiftedProducts_(const double* data1, const double* data2, int delay, int begin, int end, double sxy)
+      {
+        for (int i = begin; i < end; ++i)
+        {
+          sxy += data1[i] * data2[i + delay];
+        }
+        return sxy;
+      }
+    }
+
+    void calculateCrossCorrelation(const std::vector<double>& data1,
+                                   const std::vector<double>& data2, const int maxdelay, const int lag,
+                                   XCorrArrayType& result)
     {
       OPENSWATH_PRECONDITION(data1.size() == data2.size(), "Both data vectors need to have the same length");
 
-      XCorrArrayType result;
+      result.data.clear();
       result.data.reserve( (size_t)std::ceil((2*maxdelay + 1) / lag));
-      int datasize = static_cast<int>(data1.size());
-      int i, j, delay;
-
-      for (delay = -maxdelay; delay <= maxdelay; delay = delay + lag)
+      const int datasize = static_cast<int>(data1.size());
+      const double* x = data1.data();
+      const double* y = data2.data();
+
+      // For a given delay, data1[i] overlaps with data2 for i in
+      // [max(0, -delay), min(n, n - delay)). Blocks of delays are processed
+      // together over the range they have in common, which lets the compiler
+      // vectorize across the delays (for lag 1 the data2 values are
+      // contiguous). Each sum is still accumulated in order of increasing i,
+      // so the results are identical to processing one delay at a time.
+      const int block = 4;
+      int delay = -maxdelay;
+      for (; delay + (block - 1) * lag <= maxdelay; delay += block * lag)
       {
-        double sxy = 0;
-        for (i = 0; i < datasize; ++i)
+        int lo[block], hi[block];
+        double sxy[block];
+        for (int k = 0; k < block; ++k)
         {
-          j = i + delay;
-          if (j < 0 || j >= datasize)
+          const int d = delay + k * lag;
+          lo[k] = std::max(0, -d);
+          hi[k] = std::min(datasize, datasize - d);
+        }
+        // lo and hi are non-increasing in k
+        const int common_lo = lo[0];
+        const int common_hi = hi[block - 1];
+        if (common_lo < common_hi)
+        {
+          for (int k = 0; k < block; ++k)
           {
-            continue;
+            sxy[k] = addShiftedProducts_(x, y, delay + k * lag, lo[k], common_lo, 0.0);
+          }
+          for (int i = common_lo; i < common_hi; ++i)
+          {
+            const double xi = x[i];
+            const double* yi = y + i + delay;
+            for (int k = 0; k < block; ++k)
+            {
+              sxy[k] += xi * yi[k * lag];
+            }
+          }
+          for (int k = 0; k < block; ++k)
+          {
+            sxy[k] = addShiftedProducts_(x, y, delay + k * lag, common_hi, hi[k], sxy[k]);
           }
-          sxy += (data1[i]) * (data2[j]);
         }
-        result.data.push_back(std::make_pair(delay, sxy));
+        else
+        {
+          for (int k = 0; k < block; ++k)
+          {
+            sxy[k] = addShiftedProducts_(x, y, delay + k * lag, lo[k], hi[k], 0.0);
+          }
+        }
+        for (int k = 0; k < block; ++k)
+        {
+          result.data.emplace_back(delay + k * lag, sxy[k]);
+        }
+      }
+      for (; delay <= maxdelay; delay += lag)
+      {
+        result.data.emplace_back(delay, addShiftedProducts_(x, y, delay, std::max(0, -delay), std::min(datasize, datasize - delay), 0.0));
       }
-      return result;
     }
 
     XCorrArrayType calcxcorr_legacy_mquest_(std::vector<double>& data1,
@@ -0,0 +1,102 @@
+#ifndef __PYTHON_PEAK_VIEWS_HPP__
+#define __PYTHON_PEAK_VIEWS_HPP__
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/METADATA/DataArrays.h>
+
+#include <type_traits>
+
+// Memory layout of peak containers for zero-copy NumPy views (buffer protocol)
+// instead of copying m/z and intensity values on every get_peaks() call.
+//
+// A view points directly into the container, i.e. the Python object exposing
+// it must keep the owning wrapper alive (NumPy 'base') and the view becomes
+// invalid as soon as the container is resized or reallocated (e.g. by
+// set_peaks(), push_back() or sortByPosition()).
+namespace PythonPeakViews
+{
+  // position (double) is the first member, intensity (float) follows at an offset of sizeof(double)
+  static_assert(std::is_standard_layout<OpenMS::Peak1D>::value && sizeof(OpenMS::Peak1D) == 2 * sizeof(double),
+                "Peak1D layout does not allow strided views");
+  static_assert(std::is_standard_layout<OpenMS::ChromatogramPeak>::value && sizeof(OpenMS::ChromatogramPeak) == 2 * sizeof(double),
+                "ChromatogramPeak layout does not allow strided views");
+
+  /// Strided 1D view: @p size elements, the i-th one at @p data + i * @p stride (in bytes)
+  struct StridedView
+  {
+    char* data;
+    OpenMS::Size size;
+    OpenMS::Size stride;
+  };
+
+  template <typename PeakContainer>
+  inline StridedView positionView(PeakContainer& peaks)
+  {
+    return StridedView{peaks.empty() ? nullptr : reinterpret_cast<char*>(&peaks[0]),
+                       peaks.size(), sizeof(typename PeakContainer::PeakType)};
+  }
+
+  template <typename PeakContainer>
+  inline StridedView intensityView(PeakContainer& peaks)
+  {
+    return StridedView{peaks.empty() ? nullptr : reinterpret_cast<char*>(&peaks[0]) + sizeof(double),
+                       peaks.size(), sizeof(typename PeakContainer::PeakType)};
+  }
+
+  /// m/z values (double) of @p spec
+  inline StridedView mzView(OpenMS::MSSpectrum& spec) { return positionView(spec); }
+  /// intensities (float) of @p spec
+  inline StridedView intensityView(OpenMS::MSSpectrum& spec) { return intensityView<OpenMS::MSSpectrum>(spec); }
+  /// retention times (double) of @p chrom
+  inline StridedView rtView(OpenMS::MSChromatogram& chrom) { return positionView(chrom); }
+  /// intensities (float) of @p chrom
+  inline StridedView intensityView(OpenMS::MSChromatogram& chrom) { return intensityView<OpenMS::MSChromatogram>(chrom); }
+
+  /// values (float) of @p array, which are contiguous
+  inline StridedView floatDataView(OpenMS::DataArrays::FloatDataArray& array)
+  {
+    return StridedView{array.empty() ? nullptr : reinterpret_cast<char*>(array.data()), array.size(), sizeof(float)};
+  }
+
+  /// Number of peaks in all spectra of MS level @p ms_level (to allocate the arrays for getConcatenatedPeaks())
+  inline OpenMS::Size getPeakCount(const OpenMS::MSExperiment& exp, OpenMS::UInt ms_level)
+  {
+    OpenMS::Size count = 0;
+    for (const auto& spec : exp)
+    {
+      if (spec.getMSLevel() == ms_level) count += spec.size();
+    }
+    return count;
+  }
+
+  /**
+    @brief Copies the peaks of all spectra of MS level @p ms_level into pre-allocated (NumPy) arrays
+
+    @p rt, @p mz and @p intensity must hold getPeakCount() elements, @p spectrum_offsets one more than
+    the number of spectra of that MS level: the peaks of the i-th spectrum are at [offsets[i], offsets[i + 1]).
+    Any of the pointers may be null to skip that array.
+  */
+  inline void getConcatenatedPeaks(const OpenMS::MSExperiment& exp, OpenMS::UInt ms_level,
+                                   double* rt, double* mz, float* intensity, OpenMS::Size* spectrum_offsets)
+  {
+    OpenMS::Size pos = 0;
+    for (const auto& spec : exp)
+    {
+      if (spec.getMSLevel() != ms_level) continue;
+      if (spectrum_offsets != nullptr) *spectrum_offsets++ = pos;
+      for (const auto& p : spec)
+      {
+        if (rt != nullptr) rt[pos] = spec.getRT();
+        if (mz != nullptr) mz[pos] = p.getMZ();
+        if (intensity != nullptr) intensity[pos] = p.getIntensity();
+        ++pos;
+      }
+    }
+    if (spectrum_offsets != nullptr) *spectrum_offsets = pos;
+  }
+}
+
+#endif
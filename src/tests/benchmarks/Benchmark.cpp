@@ -0,0 +1,410 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "Benchmark.h"
+
+#include <OpenMS/CONCEPT/VersionInfo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    State::State(std::int64_t max_iterations) :
+      max_iterations_(max_iterations)
+    {
+    }
+
+    State::Iterator State::begin()
+    {
+      resumeTiming();
+      return Iterator{this, max_iterations_};
+    }
+
+    State::Iterator State::end()
+    {
+      return Iterator{this, 0};
+    }
+
+    void State::pauseTiming()
+    {
+      if (!running_) return;
+      elapsed_ += std::chrono::duration<double>(Clock_::now() - start_).count();
+      cpu_elapsed_ += double(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+      running_ = false;
+    }
+
+    void State::resumeTiming()
+    {
+      if (running_) return;
+      cpu_start_ = std::clock();
+      start_ = Clock_::now();
+      running_ = true;
+    }
+
+    void State::finish_()
+    {
+      pauseTiming();
+    }
+
+    void State::setItemsProcessed(std::int64_t items)
+    {
+      items_ = items;
+    }
+
+    void State::setBytesProcessed(std::int64_t bytes)
+    {
+      bytes_ = bytes;
+    }
+
+    void State::setLabel(const std::string& label)
+    {
+      label_ = label;
+    }
+
+    namespace
+    {
+      struct Registered
+      {
+        std::string name;
+        Function function;
+      };
+
+      std::vector<Registered>& registry()
+      {
+        static std::vector<Registered> benchmarks;
+        return benchmarks;
+      }
+
+      struct Options
+      {
+        std::string filter = ".";
+        double min_time = 0.5;
+        int repetitions = 1;
+        std::string format = "console";
+        std::string out;
+        std::string out_format = "json";
+      };
+
+      /// One measured run (or an aggregate over repetitions)
+      struct Run
+      {
+        std::string name;
+        std::string run_name;
+        std::string aggregate_name; // empty for plain iterations
+        int repetitions = 1;
+        int repetition_index = 0;
+        std::int64_t iterations = 0;
+        double real_ns = 0.0; // per iteration
+        double cpu_ns = 0.0; // per iteration
+        double items_per_second = 0.0;
+        double bytes_per_second = 0.0;
+        std::string label;
+      };
+
+      bool parseFlag_(const std::string& arg, const std::string& flag, std::string& value)
+      {
+        const std::string prefix = "--" + flag + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+        value = arg.substr(prefix.size());
+        return true;
+      }
+
+      void printUsage_(const char* exe)
+      {
+        std::cout << "Usage: " << exe << " [options]\n"
+                  << "  --benchmark_list_tests               list the registered benchmarks and exit\n"
+                  << "  --benchmark_filter=<regex>           run only benchmarks whose name matches\n"
+                  << "  --benchmark_min_time=<seconds>       minimal timed duration per run (default 0.5)\n"
+                  << "  --benchmark_repetitions=<n>          repeat each run n times and report mean/median/stddev\n"
+                  << "  --benchmark_format=<console|json>    output format on stdout\n"
+                  << "  --benchmark_out=<file>               additionally write results to <file>\n"
+                  << "  --benchmark_out_format=<json|console> format of <file> (default json)\n";
+      }
+
+      std::string escapeJSON_(const std::string& s)
+      {
+        std::string r;
+        for (char c : s)
+        {
+          switch (c)
+          {
+            case '"': r += "\\\""; break;
+            case '\\': r += "\\\\"; break;
+            case '\n': r += "\\n"; break;
+            case '\t': r += "\\t"; break;
+            default:
+              if (static_cast<unsigned char>(c) < 0x20)
+              {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                r += buf;
+              }
+              else
+              {
+                r += c;
+              }
+          }
+        }
+        return r;
+      }
+
+      Run measure_(const Registered& b, const Options& opts)
+      {
+        // grow the number of iterations until a run takes at least min_time (like Google Benchmark)
+        const std::int64_t max_iterations = 1000000000;
+        std::int64_t iterations = 1;
+        while (true)
+        {
+          State state(iterations);
+          b.function(state);
+          const double elapsed = state.elapsedSeconds();
+          if (elapsed >= opts.min_time || iterations >= max_iterations)
+          {
+            Run r;
+            r.name = b.name;
+            r.run_name = b.name;
+            r.iterations = iterations;
+            r.real_ns = elapsed * 1e9 / iterations;
+            r.cpu_ns = state.cpuSeconds() * 1e9 / iterations;
+            if (state.itemsProcessed() > 0 && elapsed > 0) r.items_per_second = state.itemsProcessed() / elapsed;
+            if (state.bytesProcessed() > 0 && elapsed > 0) r.bytes_per_second = state.bytesProcessed() / elapsed;
+            r.label = state.label();
+            return r;
+          }
+          double multiplier = opts.min_time * 1.4 / std::max(elapsed, 1e-9);
+          multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+          iterations = std::min(max_iterations, static_cast<std::int64_t>(std::ceil(iterations * multiplier)));
+        }
+      }
+
+      std::vector<Run> aggregate_(const std::vector<Run>& runs)
+      {
+        std::vector<Run> result;
+        if (runs.size() < 2) return result;
+
+        auto stat = [&runs](double Run::* field, const std::string& which)
+        {
+          std::vector<double> v;
+          for (const Run& r : runs) v.push_back(r.*field);
+          const double n = v.size();
+          double mean = 0.0;
+          for (double x : v) mean += x;
+          mean /= n;
+          if (which == "mean") return mean;
+          if (which == "median")
+          {
+            std::sort(v.begin(), v.end());
+            return v.size() % 2 ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+          }
+          double sq = 0.0;
+          for (double x : v) sq += (x - mean) * (x - mean);
+          return std::sqrt(sq / (n - 1)); // stddev
+        };
+
+        for (const std::string which : {"mean", "median", "stddev"})
+        {
+          Run a = runs.front();
+          a.name = a.run_name + "_" + which;
+          a.aggregate_name = which;
+          a.repetitions = static_cast<int>(runs.size());
+          a.repetition_index = 0;
+          a.real_ns = stat(&Run::real_ns, which);
+          a.cpu_ns = stat(&Run::cpu_ns, which);
+          a.items_per_second = stat(&Run::items_per_second, which);
+          a.bytes_per_second = stat(&Run::bytes_per_second, which);
+          result.push_back(a);
+        }
+        return result;
+      }
+
+      void writeConsole_(std::ostream& os, const std::vector<Run>& runs)
+      {
+        os << std::left << std::setw(50) << "Benchmark" << std::right
+           << std::setw(16) << "Time (ns)" << std::setw(16) << "CPU (ns)" << std::setw(14) << "Iterations"
+           << "  UserCounters\n";
+        os << std::string(110, '-') << "\n";
+        for (const Run& r : runs)
+        {
+          os << std::left << std::setw(50) << r.name << std::right << std::fixed << std::setprecision(0)
+             << std::setw(16) << r.real_ns << std::setw(16) << r.cpu_ns << std::setw(14) << r.iterations;
+          if (r.items_per_second > 0) os << "  items_per_second=" << std::setprecision(3) << std::scientific << r.items_per_second;
+          if (r.bytes_per_second > 0) os << "  bytes_per_second=" << std::setprecision(3) << std::scientific << r.bytes_per_second;
+          if (!r.label.empty()) os << "  " << r.label;
+          os << std::defaultfloat << "\n";
+        }
+      }
+
+      void writeJSON_(std::ostream& os, const std::vector<Run>& runs, const char* exe)
+      {
+        std::time_t now = std::time(nullptr);
+        char date[64];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+        os << "{\n  \"context\": {\n"
+           << "    \"date\": \"" << date << "\",\n"
+           << "    \"executable\": \"" << escapeJSON_(exe) << "\",\n"
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+           << "    \"openms_version\": \"" << escapeJSON_(VersionInfo::getVersion()) << "\",\n"
+           << "    \"openms_revision\": \"" << escapeJSON_(VersionInfo::getRevision()) << "\",\n"
+#ifdef NDEBUG
+           << "    \"library_build_type\": \"release\"\n"
+#else
+           << "    \"library_build_type\": \"debug\"\n"
+#endif
+           << "  },\n  \"benchmarks\": [";
+        os << std::setprecision(17);
+        for (std::size_t i = 0; i < runs.size(); ++i)
+        {
+          const Run& r = runs[i];
+          os << (i ? "," : "") << "\n    {\n"
+             << "      \"name\": \"" << escapeJSON_(r.name) << "\",\n"
+             << "      \"run_name\": \"" << escapeJSON_(r.run_name) << "\",\n"
+             << "      \"run_type\": \"" << (r.aggregate_name.empty() ? "iteration" : "aggregate") << "\",\n"
+             << "      \"repetitions\": " << r.repetitions << ",\n"
+             << "      \"repetition_index\": " << r.repetition_index << ",\n"
+             << "      \"threads\": 1,\n";
+          if (!r.aggregate_name.empty())
+          {
+            os << "      \"aggregate_name\": \"" << r.aggregate_name << "\",\n";
+          }
+          os << "      \"iterations\": " << r.iterations << ",\n"
+             << "      \"real_time\": " << r.real_ns << ",\n"
+             << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+             << "      \"time_unit\": \"ns\"";
+          if (r.items_per_second > 0) os << ",\n      \"items_per_second\": " << r.items_per_second;
+          if (r.bytes_per_second > 0) os << ",\n      \"bytes_per_second\": " << r.bytes_per_second;
+          if (!r.label.empty()) os << ",\n      \"label\": \"" << escapeJSON_(r.label) << "\"";
+          os << "\n    }";
+        }
+        os << "\n  ]\n}\n";
+      }
+    } // anonymous namespace
+
+    int registerBenchmark(const std::string& name, Function function)
+    {
+      registry().push_back(Registered{name, std::move(function)});
+      return static_cast<int>(registry().size());
+    }
+
+    int runBenchmarks(int argc, char** argv)
+    {
+      Options opts;
+      bool list_only = false;
+      for (int i = 1; i < argc; ++i)
+      {
+        const std::string arg = argv[i];
+        std::string value;
+        if (arg == "--help" || arg == "-h")
+        {
+          printUsage_(argv[0]);
+          return EXIT_SUCCESS;
+        }
+        else if (arg == "--benchmark_list_tests" || arg == "--benchmark_list_tests=true") list_only = true;
+        else if (parseFlag_(arg, "benchmark_filter", value)) opts.filter = value;
+        else if (parseFlag_(arg, "benchmark_min_time", value)) opts.min_time = std::atof(value.c_str());
+        else if (parseFlag_(arg, "benchmark_repetitions", value)) opts.repetitions = std::max(1, std::atoi(value.c_str()));
+        else if (parseFlag_(arg, "benchmark_format", value)) opts.format = value;
+        else if (parseFlag_(arg, "benchmark_out", value)) opts.out = value;
+        else if (parseFlag_(arg, "benchmark_out_format", value)) opts.out_format = value;
+        else
+        {
+          std::cerr << "Unknown argument '" << arg << "'.\n";
+          printUsage_(argv[0]);
+          return EXIT_FAILURE;
+        }
+      }
+
+      std::regex filter;
+      try
+      {
+        filter = std::regex(opts.filter);
+      }
+      catch (const std::regex_error&)
+      {
+        std::cerr << "Invalid --benchmark_filter regular expression '" << opts.filter << "'.\n";
+        return EXIT_FAILURE;
+      }
+
+      std::vector<Run> runs;
+      for (const Registered& b : registry())
+      {
+        if (!std::regex_search(b.name, filter)) continue;
+        if (list_only)
+        {
+          std::cout << b.name << "\n";
+          continue;
+        }
+        std::vector<Run> repetitions;
+        for (int rep = 0; rep < opts.repetitions; ++rep)
+        {
+          Run r = measure_(b, opts);
+          r.repetitions = opts.repetitions;
+          r.repetition_index = rep;
+          repetitions.push_back(r);
+        }
+        runs.insert(runs.end(), repetitions.begin(), repetitions.end());
+        std::vector<Run> aggregates = aggregate_(repetitions);
+        runs.insert(runs.end(), aggregates.begin(), aggregates.end());
+      }
+      if (list_only) return EXIT_SUCCESS;
+
+      if (opts.format == "json") writeJSON_(std::cout, runs, argv[0]);
+      else writeConsole_(std::cout, runs);
+
+      if (!opts.out.empty())
+      {
+        std::ofstream out(opts.out.c_str());
+        if (!out)
+        {
+          std::cerr << "Could not open '" << opts.out << "' for writing.\n";
+          return EXIT_FAILURE;
+        }
+        if (opts.out_format == "console") writeConsole_(out, runs);
+        else writeJSON_(out, runs, argv[0]);
+      }
+      return EXIT_SUCCESS;
+    }
+
+  } // namespace Benchmark
+} // namespace OpenMS
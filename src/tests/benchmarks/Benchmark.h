@@ -0,0 +1,187 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+  @brief Minimal micro benchmark harness for the OpenMS_benchmarks target.
+
+  Mimics the interface and the command line / JSON output of Google Benchmark
+  (https://github.com/google/benchmark) closely enough that its comparison
+  scripts (tools/compare.py) can be used on the results, without adding a
+  third-party dependency to the build.
+
+  Usage:
+  @code
+  static void BM_Something(OpenMS::Benchmark::State& state)
+  {
+    // setup (not timed)
+    for (auto _ : state)
+    {
+      OpenMS::Benchmark::doNotOptimize(compute());
+    }
+    state.setItemsProcessed(state.iterations() * n_items);
+  }
+  OPENMS_BENCHMARK(BM_Something);
+  @endcode
+*/
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    /// Prevents the compiler from optimizing away the computation of @p value
+    template <class T>
+    inline void doNotOptimize(T const& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = static_cast<const void*>(&value);
+#endif
+    }
+
+    /// Timing state handed to each benchmark function
+    class State
+    {
+    public:
+      explicit State(std::int64_t max_iterations);
+
+      /// Dummy loop variable of 'for (auto _ : state)' (marked unused to avoid compiler warnings)
+#if defined(__GNUC__) || defined(__clang__)
+      struct __attribute__((unused)) Value {};
+#else
+      struct Value {};
+#endif
+
+      /// Iterator type for range-based for loops over the state (one step per timed iteration)
+      struct Iterator
+      {
+        State* state;
+        std::int64_t remaining;
+
+        bool operator!=(const Iterator&) const
+        {
+          if (remaining > 0) return true;
+          state->finish_();
+          return false;
+        }
+        Iterator& operator++()
+        {
+          --remaining;
+          return *this;
+        }
+        Value operator*() const
+        {
+          return Value();
+        }
+      };
+
+      Iterator begin();
+      Iterator end();
+
+      /// Stops the timer (e.g. to exclude per-iteration setup)
+      void pauseTiming();
+      /// Restarts the timer after pauseTiming()
+      void resumeTiming();
+
+      /// Reports the number of processed items (enables the items_per_second counter)
+      void setItemsProcessed(std::int64_t items);
+      /// Reports the number of processed bytes (enables the bytes_per_second counter)
+      void setBytesProcessed(std::int64_t bytes);
+      /// Free text label reported with the result (e.g. dataset size)
+      void setLabel(const std::string& label);
+
+      /// Number of iterations of this run
+      std::int64_t iterations() const
+      {
+        return max_iterations_;
+      }
+
+      /// Elapsed (timed) wall clock seconds
+      double elapsedSeconds() const
+      {
+        return elapsed_;
+      }
+
+      /// Elapsed (timed) process CPU seconds (summed over all threads)
+      double cpuSeconds() const
+      {
+        return cpu_elapsed_;
+      }
+
+      std::int64_t itemsProcessed() const { return items_; }
+      std::int64_t bytesProcessed() const { return bytes_; }
+      const std::string& label() const { return label_; }
+
+    private:
+      void finish_();
+
+      typedef std::chrono::steady_clock Clock_;
+
+      std::int64_t max_iterations_;
+      Clock_::time_point start_;
+      std::clock_t cpu_start_ = 0;
+      double elapsed_ = 0.0;
+      double cpu_elapsed_ = 0.0;
+      bool running_ = false;
+      std::int64_t items_ = 0;
+      std::int64_t bytes_ = 0;
+      std::string label_;
+    };
+
+    typedef std::function<void(State&)> Function;
+
+    /// Registers a benchmark with the global registry; used by OPENMS_BENCHMARK
+    int registerBenchmark(const std::string& name, Function function);
+
+    /// Runs all registered benchmarks according to the command line arguments
+    int runBenchmarks(int argc, char** argv);
+
+  } // namespace Benchmark
+} // namespace OpenMS
+
+#define OPENMS_BENCHMARK_CONCAT2_(a, b) a##b
+#define OPENMS_BENCHMARK_CONCAT_(a, b) OPENMS_BENCHMARK_CONCAT2_(a, b)
+
+/// Registers the benchmark function @p func (signature: void(OpenMS::Benchmark::State&))
+#define OPENMS_BENCHMARK(func) \
+  static int OPENMS_BENCHMARK_CONCAT_(openms_benchmark_registered_, __LINE__) = \
+    OpenMS::Benchmark::registerBenchmark(#func, func)
@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace OpenMS;
+
+namespace
+{
+  typedef ChromatogramExtractorAlgorithm::ExtractionCoordinates Coordinates;
+
+  // one SWATH window: 3000 MS2 spectra (50 min at 1 Hz) with 1000 peaks each
+  boost::shared_ptr<PeakMap> swathMap()
+  {
+    static boost::shared_ptr<PeakMap> exp(new PeakMap(Benchmark::SyntheticData::centroidedMap(3000, 1000)));
+    return exp;
+  }
+
+  // 600 transitions (e.g. 100 peptides with 6 transitions each), sorted by m/z, extracted over the whole RT range
+  std::vector<Coordinates> coordinates()
+  {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> mz_dist(150.0, 1900.0);
+    std::vector<Coordinates> coords(600);
+    for (Size i = 0; i < coords.size(); ++i)
+    {
+      coords[i].mz = mz_dist(rng);
+      coords[i].rt_start = 0.0;
+      coords[i].rt_end = -1.0;
+      coords[i].id = "tr" + String(i);
+    }
+    std::sort(coords.begin(), coords.end(), Coordinates::SortExtractionCoordinatesByMZ);
+    return coords;
+  }
+
+  std::vector<OpenSwath::ChromatogramPtr> emptyOutput(Size n)
+  {
+    std::vector<OpenSwath::ChromatogramPtr> output;
+    output.reserve(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      output.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    return output;
+  }
+}
+
+static void BM_ChromatogramExtractor_SpectrumAccess(Benchmark::State& state)
+{
+  OpenSwath::SpectrumAccessPtr input = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swathMap());
+  const std::vector<Coordinates> coords = coordinates();
+  ChromatogramExtractorAlgorithm extractor;
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    std::vector<OpenSwath::ChromatogramPtr> output = emptyOutput(coords.size());
+    state.resumeTiming();
+    extractor.extractChromatograms(input, output, coords, 20.0, true, -1, "tophat");
+    Benchmark::doNotOptimize(output.back()->getIntensityArray()->data.size());
+  }
+  state.setItemsProcessed(state.iterations() * swathMap()->getSize());
+}
+OPENMS_BENCHMARK(BM_ChromatogramExtractor_SpectrumAccess);
+
+static void BM_ChromatogramExtractor_SoA(Benchmark::State& state)
+{
+  std::vector<SoASpectrum> input;
+  std::vector<double> rts;
+  for (const MSSpectrum& s : swathMap()->getSpectra())
+  {
+    input.emplace_back(s);
+    rts.push_back(s.getRT());
+  }
+  const std::vector<Coordinates> coords = coordinates();
+  ChromatogramExtractorAlgorithm extractor;
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    std::vector<OpenSwath::ChromatogramPtr> output = emptyOutput(coords.size());
+    state.resumeTiming();
+    extractor.extractChromatograms(input, rts, output, coords, 20.0, true, -1, "tophat");
+    Benchmark::doNotOptimize(output.back()->getIntensityArray()->data.size());
+  }
+  state.setItemsProcessed(state.iterations() * swathMap()->getSize());
+}
+OPENMS_BENCHMARK(BM_ChromatogramExtractor_SoA);
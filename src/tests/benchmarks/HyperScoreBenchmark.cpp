@@ -0,0 +1,104 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  // 500 candidate peptides scored against one experimental spectrum (a typical precursor window),
+  // the spectrum is generated from the first candidate
+  const Size n_candidates = 500;
+
+  const PeakSpectrum& experimental()
+  {
+    static const PeakSpectrum spec = Benchmark::SyntheticData::experimentalSpectrum(Benchmark::SyntheticData::peptides(n_candidates).front());
+    return spec;
+  }
+}
+
+static void BM_HyperScore_compute(Benchmark::State& state)
+{
+  // theoretical b/y spectra with ion annotations, as required by HyperScore::compute
+  TheoreticalSpectrumGenerator tsg;
+  Param p = tsg.getParameters();
+  p.setValue("add_metainfo", "true");
+  tsg.setParameters(p);
+  std::vector<PeakSpectrum> theo;
+  for (const AASequence& peptide : Benchmark::SyntheticData::peptides(n_candidates))
+  {
+    PeakSpectrum spec;
+    tsg.getSpectrum(spec, peptide, 1, 1);
+    theo.push_back(spec);
+  }
+
+  const PeakSpectrum& exp = experimental();
+  for (auto _ : state)
+  {
+    double sum = 0.0;
+    for (const PeakSpectrum& t : theo)
+    {
+      sum += HyperScore::compute(10.0, true, exp, t);
+    }
+    Benchmark::doNotOptimize(sum);
+  }
+  state.setItemsProcessed(state.iterations() * theo.size());
+}
+OPENMS_BENCHMARK(BM_HyperScore_compute);
+
+static void BM_HyperScore_computeBatch(Benchmark::State& state)
+{
+  std::vector<std::vector<TheoreticalSpectrumGenerator::FragmentIon> > ions;
+  for (const AASequence& peptide : Benchmark::SyntheticData::peptides(n_candidates))
+  {
+    std::vector<TheoreticalSpectrumGenerator::FragmentIon> i;
+    TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(i, peptide, 1);
+    ions.push_back(std::move(i));
+  }
+
+  const PeakSpectrum& exp = experimental();
+  std::vector<double> scores;
+  std::vector<HyperScore::PSMDetail> details;
+  for (auto _ : state)
+  {
+    HyperScore::computeBatch(10.0, true, exp, ions, scores, details);
+    Benchmark::doNotOptimize(scores.data());
+  }
+  state.setItemsProcessed(state.iterations() * ions.size());
+}
+OPENMS_BENCHMARK(BM_HyperScore_computeBatch);
@@ -0,0 +1,98 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+
+namespace
+{
+  // 300 profile MS1 spectra with 2000 peaks (~24k data points) each
+  const PeakMap& mzmlData()
+  {
+    static const PeakMap exp = Benchmark::SyntheticData::profileMap(300, 2000);
+    return exp;
+  }
+
+  const String& mzmlFile()
+  {
+    static const String filename = []()
+    {
+      String f = File::getTemporaryFile();
+      MzMLFile().store(f, mzmlData());
+      return f;
+    }();
+    return filename;
+  }
+
+  std::int64_t fileSize(const String& filename)
+  {
+    std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+    return static_cast<std::int64_t>(in.tellg());
+  }
+}
+
+static void BM_MzMLFile_load(Benchmark::State& state)
+{
+  const String& filename = mzmlFile();
+  MzMLFile f;
+  for (auto _ : state)
+  {
+    PeakMap exp;
+    f.load(filename, exp);
+    Benchmark::doNotOptimize(exp.size());
+  }
+  state.setBytesProcessed(state.iterations() * fileSize(filename));
+  state.setItemsProcessed(state.iterations() * mzmlData().size());
+}
+OPENMS_BENCHMARK(BM_MzMLFile_load);
+
+static void BM_MzMLFile_store(Benchmark::State& state)
+{
+  const PeakMap& exp = mzmlData();
+  const String filename = File::getTemporaryFile();
+  MzMLFile f;
+  for (auto _ : state)
+  {
+    f.store(filename, exp);
+  }
+  state.setBytesProcessed(state.iterations() * fileSize(filename));
+  state.setItemsProcessed(state.iterations() * exp.size());
+}
+OPENMS_BENCHMARK(BM_MzMLFile_store);
@@ -0,0 +1,103 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <OpenMS/KERNEL/SoASpectrum.h>
+#include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  // a single Orbitrap-like profile spectrum: 5000 peaks sampled with 12 points each
+  const MSSpectrum& profileSpectrum()
+  {
+    static const MSSpectrum spec = Benchmark::SyntheticData::profileSpectrum(5000);
+    return spec;
+  }
+
+  void configure(PeakPickerHiRes& pp)
+  {
+    Param param = pp.getParameters();
+    param.setValue("signal_to_noise", 1.0);
+    pp.setParameters(param);
+  }
+}
+
+static void BM_PeakPickerHiRes_pickSpectrum(Benchmark::State& state)
+{
+  const MSSpectrum& input = profileSpectrum();
+  PeakPickerHiRes pp;
+  configure(pp);
+  for (auto _ : state)
+  {
+    MSSpectrum output;
+    pp.pick(input, output);
+    Benchmark::doNotOptimize(output.size());
+  }
+  state.setItemsProcessed(state.iterations() * input.size());
+}
+OPENMS_BENCHMARK(BM_PeakPickerHiRes_pickSpectrum);
+
+static void BM_PeakPickerHiRes_pickSpectrumSoA(Benchmark::State& state)
+{
+  const SoASpectrum input(profileSpectrum());
+  PeakPickerHiRes pp;
+  configure(pp);
+  for (auto _ : state)
+  {
+    SoASpectrum output;
+    pp.pick(input, output);
+    Benchmark::doNotOptimize(output.size());
+  }
+  state.setItemsProcessed(state.iterations() * input.size());
+}
+OPENMS_BENCHMARK(BM_PeakPickerHiRes_pickSpectrumSoA);
+
+static void BM_PeakPickerHiRes_pickExperiment(Benchmark::State& state)
+{
+  // 100 spectra with 2000 peaks each (may run in parallel with OpenMP)
+  const PeakMap input = Benchmark::SyntheticData::profileMap(100, 2000);
+  PeakPickerHiRes pp;
+  configure(pp);
+  for (auto _ : state)
+  {
+    PeakMap output;
+    pp.pickExperiment(input, output);
+    Benchmark::doNotOptimize(output.size());
+  }
+  state.setItemsProcessed(state.iterations() * input.getSize());
+}
+OPENMS_BENCHMARK(BM_PeakPickerHiRes_pickExperiment);
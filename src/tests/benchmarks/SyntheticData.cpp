@@ -0,0 +1,227 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "SyntheticData.h"
+
+#include <OpenMS/CHEMISTRY/Residue.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    namespace SyntheticData
+    {
+      MSSpectrum profileSpectrum(Size n_peaks, Size points_per_peak, unsigned seed)
+      {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> mz_dist(300.0, 1800.0);
+        uniform_real_distribution<double> log_int_dist(3.0, 7.0);
+        uniform_real_distribution<double> noise_dist(0.0, 50.0);
+
+        vector<double> centers(n_peaks);
+        for (double& c : centers) c = mz_dist(rng);
+        sort(centers.begin(), centers.end());
+
+        MSSpectrum spec;
+        spec.setMSLevel(1);
+        spec.reserve(n_peaks * points_per_peak);
+        for (double center : centers)
+        {
+          const double height = pow(10.0, log_int_dist(rng));
+          const double fwhm = center * 4e-6;
+          const double sigma = fwhm / 2.355;
+          // sample the peak over +/- 1.5 FWHM
+          const double step = 3.0 * fwhm / (points_per_peak - 1);
+          for (Size i = 0; i < points_per_peak; ++i)
+          {
+            const double mz = center - 1.5 * fwhm + i * step;
+            const double d = (mz - center) / sigma;
+            if (!spec.empty() && mz <= spec.back().getMZ()) continue; // overlapping peaks
+            spec.push_back(Peak1D(mz, height * exp(-0.5 * d * d) + noise_dist(rng)));
+          }
+        }
+        spec.setSorted(true);
+        return spec;
+      }
+
+      PeakMap profileMap(Size n_spectra, Size n_peaks, unsigned seed)
+      {
+        PeakMap exp;
+        exp.reserveSpaceSpectra(n_spectra);
+        for (Size i = 0; i < n_spectra; ++i)
+        {
+          MSSpectrum spec = profileSpectrum(n_peaks, 12, seed + i);
+          spec.setRT(double(i));
+          spec.setNativeID("scan=" + String(i + 1));
+          spec.setType(SpectrumSettings::PROFILE);
+          exp.addSpectrum(std::move(spec));
+        }
+        exp.updateRanges();
+        return exp;
+      }
+
+      PeakMap centroidedMap(Size n_spectra, Size n_peaks, unsigned seed)
+      {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> mz_dist(100.0, 2000.0);
+        uniform_real_distribution<double> log_int_dist(1.0, 6.0);
+
+        PeakMap exp;
+        exp.reserveSpaceSpectra(n_spectra);
+        for (Size i = 0; i < n_spectra; ++i)
+        {
+          MSSpectrum spec;
+          spec.setMSLevel(2);
+          spec.setRT(double(i));
+          spec.setNativeID("scan=" + String(i + 1));
+          spec.setType(SpectrumSettings::CENTROID);
+          spec.reserve(n_peaks);
+          for (Size p = 0; p < n_peaks; ++p)
+          {
+            spec.push_back(Peak1D(mz_dist(rng), pow(10.0, log_int_dist(rng))));
+          }
+          spec.sortByPosition();
+          exp.addSpectrum(std::move(spec));
+        }
+        exp.updateRanges();
+        return exp;
+      }
+
+      vector<AASequence> peptides(Size n, unsigned seed)
+      {
+        // no C and M to avoid fixed/variable modification handling, no K/R except at the C-terminus
+        static const String inner = "ADEFGHILNPQSTVWY";
+        static const String cterm = "KR";
+
+        mt19937 rng(seed);
+        uniform_int_distribution<Size> length_dist(7, 25);
+        uniform_int_distribution<Size> inner_dist(0, inner.size() - 1);
+        uniform_int_distribution<Size> cterm_dist(0, cterm.size() - 1);
+
+        vector<AASequence> result;
+        result.reserve(n);
+        for (Size i = 0; i < n; ++i)
+        {
+          String s;
+          const Size length = length_dist(rng);
+          for (Size j = 0; j + 1 < length; ++j) s += inner[inner_dist(rng)];
+          s += cterm[cterm_dist(rng)];
+          result.push_back(AASequence::fromString(s));
+        }
+        return result;
+      }
+
+      PeakSpectrum experimentalSpectrum(const AASequence& peptide, Size n_noise, unsigned seed)
+      {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        normal_distribution<double> ppm_error(0.0, 3.0);
+        uniform_real_distribution<double> log_int_dist(2.0, 6.0);
+        uniform_real_distribution<double> noise_mz(100.0, 2000.0);
+
+        PeakSpectrum spec;
+        spec.setMSLevel(2);
+        auto add = [&](double mz)
+        {
+          if (unit(rng) < 0.3) return; // missing fragment
+          spec.push_back(Peak1D(mz * (1.0 + ppm_error(rng) * 1e-6), pow(10.0, log_int_dist(rng))));
+        };
+        for (Size i = 1; i < peptide.size(); ++i)
+        {
+          add(peptide.getPrefix(i).getMonoWeight(Residue::BIon, 1));
+          add(peptide.getSuffix(i).getMonoWeight(Residue::YIon, 1));
+        }
+        for (Size i = 0; i < n_noise; ++i)
+        {
+          spec.push_back(Peak1D(noise_mz(rng), pow(10.0, log_int_dist(rng) - 1.0)));
+        }
+        spec.sortByPosition();
+        return spec;
+      }
+
+      vector<FeatureMap> featureMaps(Size n_maps, Size n_features, unsigned seed)
+      {
+        mt19937 rng(seed);
+        uniform_real_distribution<double> rt_dist(0.0, 5400.0);
+        uniform_real_distribution<double> mz_dist(350.0, 1500.0);
+        uniform_real_distribution<double> log_int_dist(4.0, 9.0);
+        uniform_int_distribution<Int> charge_dist(1, 4);
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        normal_distribution<double> rt_shift(0.0, 5.0);
+        normal_distribution<double> ppm_error(0.0, 3.0);
+
+        struct Analyte
+        {
+          double rt, mz, intensity;
+          Int charge;
+        };
+        vector<Analyte> analytes(n_features);
+        for (Analyte& a : analytes)
+        {
+          a = Analyte{rt_dist(rng), mz_dist(rng), pow(10.0, log_int_dist(rng)), charge_dist(rng)};
+        }
+
+        vector<FeatureMap> maps(n_maps);
+        for (Size m = 0; m < n_maps; ++m)
+        {
+          FeatureMap& fm = maps[m];
+          fm.setPrimaryMSRunPath({"run" + String(m + 1) + ".mzML"});
+          fm.reserve(n_features);
+          const double map_rt_offset = rt_shift(rng);
+          for (Size i = 0; i < analytes.size(); ++i)
+          {
+            if (unit(rng) > 0.8) continue; // not detected in this run
+            const Analyte& a = analytes[i];
+            Feature f;
+            f.setRT(a.rt + map_rt_offset + 0.5 * rt_shift(rng));
+            f.setMZ(a.mz * (1.0 + ppm_error(rng) * 1e-6));
+            f.setIntensity(a.intensity * (0.5 + unit(rng)));
+            f.setCharge(a.charge);
+            f.setOverallQuality(unit(rng));
+            f.setUniqueId(m * 1000000000ULL + i + 1);
+            fm.push_back(f);
+          }
+          fm.setUniqueId(m + 1);
+          fm.updateRanges();
+        }
+        return maps;
+      }
+    }
+  }
+}
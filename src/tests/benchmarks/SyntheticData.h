@@ -0,0 +1,81 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    /**
+      @brief Deterministic synthetic datasets for the micro benchmarks.
+
+      All generators use a fixed-seed std::mt19937, so a dataset of a given size is
+      identical between runs, machines and releases and timings stay comparable.
+      Sizes are chosen by the benchmarks to resemble typical Orbitrap / SWATH data.
+    */
+    namespace SyntheticData
+    {
+      /// Profile spectrum (@p n_peaks Gaussian peaks of ~4 ppm FWHM, sampled with @p points_per_peak points each, plus baseline noise)
+      MSSpectrum profileSpectrum(Size n_peaks, Size points_per_peak = 12, unsigned seed = 42);
+
+      /// Profile MS1 map of @p n_spectra spectra, 1 s apart
+      PeakMap profileMap(Size n_spectra, Size n_peaks, unsigned seed = 42);
+
+      /// Centroided MS2 map of @p n_spectra spectra with @p n_peaks peaks each in [100, 2000) m/z, 1 s apart (e.g. one SWATH window)
+      PeakMap centroidedMap(Size n_spectra, Size n_peaks, unsigned seed = 42);
+
+      /// @p n random tryptic-like peptides of length 7-25 (ending in K or R)
+      std::vector<AASequence> peptides(Size n, unsigned seed = 42);
+
+      /// Centroided experimental spectrum of @p peptide: singly charged b/y ions (with a random 30 % missing) plus @p n_noise random noise peaks
+      PeakSpectrum experimentalSpectrum(const AASequence& peptide, Size n_noise = 200, unsigned seed = 42);
+
+      /**
+        @brief @p n_maps feature maps of @p n_features features each
+
+        The same set of analytes is present in every map (with 80 % probability),
+        with RT shifts of a few seconds and m/z errors of a few ppm between maps.
+        All features have unique ids.
+      */
+      std::vector<FeatureMap> featureMaps(Size n_maps, Size n_features, unsigned seed = 42);
+    }
+  }
+}
@@ -0,0 +1,154 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CHEMISTRY/AASequenceParseCache.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(AASequenceParseCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+AASequenceParseCache* ptr = nullptr;
+AASequenceParseCache* null_ptr = nullptr;
+START_SECTION(explicit AASequenceParseCache(Size capacity = 10000))
+{
+  ptr = new AASequenceParseCache();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->getCapacity(), 10000)
+}
+END_SECTION
+
+START_SECTION(~AASequenceParseCache())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(AASequence fromString(const String& s, bool permissive = true))
+{
+  AASequenceParseCache cache(2);
+  TEST_EQUAL(cache.fromString("PEPTIDE"), AASequence::fromString("PEPTIDE"))
+  TEST_EQUAL(cache.fromString("PEPTIDE"), AASequence::fromString("PEPTIDE"))
+  TEST_EQUAL(cache.getHits(), 1)
+  TEST_EQUAL(cache.getMisses(), 1)
+  TEST_EQUAL(cache.fromString(".(Acetyl)PEPM(Oxidation)TIDE."), AASequence::fromString(".(Acetyl)PEPM(Oxidation)TIDE."))
+  TEST_EQUAL(cache.size(), 2)
+
+  // least recently used entry is evicted
+  cache.fromString("PEPTIDE");
+  cache.fromString("ELVIS");
+  TEST_EQUAL(cache.size(), 2)
+  Size misses = cache.getMisses();
+  cache.fromString("PEPTIDE");
+  TEST_EQUAL(cache.getMisses(), misses)
+  cache.fromString(".(Acetyl)PEPM(Oxidation)TIDE.");
+  TEST_EQUAL(cache.getMisses(), misses + 1)
+
+  // parsing mode is part of the key
+  TEST_EQUAL(cache.fromString("PEP*TIDE").toString(), "PEPXTIDE")
+  TEST_EXCEPTION(Exception::ParseError, cache.fromString("PEP*TIDE", false))
+
+  // invalid strings are not cached
+  AASequenceParseCache cache2;
+  TEST_EXCEPTION(Exception::ParseError, cache2.fromString("PEP?TIDE"))
+  TEST_EQUAL(cache2.size(), 0)
+
+  // capacity 0 disables caching
+  AASequenceParseCache no_cache(0);
+  TEST_EQUAL(no_cache.fromString("PEPTIDE"), AASequence::fromString("PEPTIDE"))
+  TEST_EQUAL(no_cache.size(), 0)
+}
+END_SECTION
+
+START_SECTION(AASequenceParseCache(const AASequenceParseCache& rhs))
+{
+  AASequenceParseCache cache(5);
+  cache.fromString("PEPTIDE");
+  AASequenceParseCache copy(cache);
+  TEST_EQUAL(copy.size(), 0)
+  TEST_EQUAL(copy.getCapacity(), 5)
+}
+END_SECTION
+
+START_SECTION(AASequenceParseCache& operator=(const AASequenceParseCache& rhs))
+{
+  AASequenceParseCache cache(5), other(7);
+  other.fromString("PEPTIDE");
+  other = cache;
+  TEST_EQUAL(other.size(), 0)
+  TEST_EQUAL(other.getCapacity(), 5)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  AASequenceParseCache cache;
+  cache.fromString("PEPTIDE");
+  cache.fromString("PEPTIDE");
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+  TEST_EQUAL(cache.getHits(), 0)
+  TEST_EQUAL(cache.getMisses(), 0)
+}
+END_SECTION
+
+START_SECTION([EXTRA] multithreaded access)
+{
+  AASequenceParseCache cache(3);
+  const vector<String> peptides = {"PEPTIDE", "ELVIS", "M(Oxidation)ISSISSIPPI", "DFPIANGER", "LIVES"};
+  Size errors = 0;
+#pragma omp parallel for reduction(+: errors)
+  for (int i = 0; i < 1000; ++i)
+  {
+    const String& p = peptides[i % peptides.size()];
+    if (cache.fromString(p) != AASequence::fromString(p)) ++errors;
+  }
+  TEST_EQUAL(errors, 0)
+  TEST_EQUAL(cache.getHits() + cache.getMisses(), 1000)
+  TEST_EQUAL(cache.size() <= 3, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -423,6 +423,48 @@ START_SECTION((double getMonoWeight(Residue::ResidueType type = Residue::Full, I
 }
 END_SECTION
 
+START_SECTION((std::vector<double> getPrefixMonoWeights(Residue::ResidueType type = Residue::Full, Int charge = 0) const))
+{
+  AASequence seq = AASequence::fromString(".(Acetyl)PEPM(Oxidation)TIDEK.(Amidated)");
+  std::vector<Residue::ResidueType> types = {Residue::Full, Residue::AIon, Residue::BIon, Residue::YIon, Residue::Internal};
+  for (const auto& type : types)
+  {
+    for (Int charge = 0; charge < 3; ++charge)
+    {
+      std::vector<double> weights = seq.getPrefixMonoWeights(type, charge);
+      TEST_EQUAL(weights.size(), seq.size())
+      for (Size i = 0; i < weights.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(weights[i], seq.getPrefix(i + 1).getMonoWeight(type, charge))
+      }
+    }
+  }
+  TEST_EQUAL(AASequence().getPrefixMonoWeights().empty(), true)
+  TEST_EXCEPTION(Exception::InvalidValue, AASequence::fromString("PEPXTIDE").getPrefixMonoWeights())
+}
+END_SECTION
+
+START_SECTION((std::vector<double> getSuffixMonoWeights(Residue::ResidueType type = Residue::Full, Int charge = 0) const))
+{
+  AASequence seq = AASequence::fromString(".(Acetyl)PEPM(Oxidation)TIDEK.(Amidated)");
+  std::vector<Residue::ResidueType> types = {Residue::Full, Residue::CIon, Residue::XIon, Residue::YIon, Residue::ZIon};
+  for (const auto& type : types)
+  {
+    for (Int charge = 0; charge < 3; ++charge)
+    {
+      std::vector<double> weights = seq.getSuffixMonoWeights(type, charge);
+      TEST_EQUAL(weights.size(), seq.size())
+      for (Size i = 0; i < weights.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(weights[i], seq.getSuffix(i + 1).getMonoWeight(type, charge))
+      }
+    }
+  }
+  TEST_EQUAL(AASequence().getSuffixMonoWeights().empty(), true)
+  TEST_EXCEPTION(Exception::InvalidValue, AASequence::fromString("PEPXTIDE").getSuffixMonoWeights())
+}
+END_SECTION
+
 START_SECTION((double getMZ(Int charge, Residue::ResidueType type = Residue::Full) const))
 {
   TOLERANCE_ABSOLUTE(1e-6)
@@ -43,6 +43,7 @@
 
 #include <array>
 #include <cassert>
+#include <sstream>
 #include <string_view>
 
 using namespace OpenMS;
@@ -367,6 +368,45 @@ START_SECTION(void getAllHits(ACTrieState& state) const)
   NOT_TESTABLE // tested above
 END_SECTION
 
+START_SECTION(void store(std::ostream& os) const)
+{
+  ACTrie t(2, 1);
+  vector<string> needles = {"dady", "baxy", "iibac", "ancii", "yaknif"};
+  t.addNeedles(needles);
+  stringstream uncompressed;
+  TEST_EXCEPTION(Exception::IllegalArgument, t.store(uncompressed))
+  t.compressTrie();
+  stringstream ss;
+  t.store(ss);
+  TEST_EQUAL(ss.str().empty(), false)
+}
+END_SECTION
+
+START_SECTION(bool load(std::istream& is))
+{
+  ACTrie t(2, 2);
+  vector<string> needles = {"dady", "baxy", "iibac", "ancii", "yaknif"};
+  t.addNeedlesAndCompress(needles);
+  stringstream ss;
+  t.store(ss);
+
+  ACTrie t2;
+  TEST_EQUAL(t2.load(ss), true)
+  TEST_EQUAL(t2.getNeedleCount(), t.getNeedleCount())
+  TEST_EQUAL(t2.getMaxAAACount(), 2)
+  TEST_EQUAL(t2.getMaxMMCount(), 2)
+  testCase(t2, "baxyacbIIabcIIbac", "dady@0, baxy@0, dady@8, ancii@4, ancii@9, iibac@1, iibac@7, iibac@12, yaknif@3", needles, __LINE__);
+
+  // corrupt input leaves the trie untouched
+  stringstream garbage("OMSACTRI but not really a trie");
+  TEST_EQUAL(t2.load(garbage), false)
+  string truncated_data = ss.str().substr(0, ss.str().size() / 2);
+  stringstream truncated(truncated_data);
+  TEST_EQUAL(t2.load(truncated), false)
+  testCase(t2, "baxyacbIIabcIIbac", "dady@0, baxy@0, dady@8, ancii@4, ancii@9, iibac@1, iibac@7, iibac@12, yaknif@3", needles, __LINE__);
+}
+END_SECTION
+
 /////////////////////////////////////
 //// testing ACTrieState
 /////////////////////////////////////
@@ -0,0 +1,224 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/AreaIndex.h>
+///////////////////////////
+
+#include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+
+using namespace OpenMS;
+using namespace std;
+
+// reference implementation by looking at every peak
+struct AreaStats
+{
+  Size count = 0;
+  double sum = 0;
+  double max = 0;
+};
+
+AreaStats bruteForce(const MSExperiment& exp, double min_rt, double max_rt, double min_mz, double max_mz)
+{
+  AreaStats stats;
+  for (const MSSpectrum& spec : exp)
+  {
+    if (spec.getMSLevel() != 1 || spec.getRT() < min_rt || spec.getRT() > max_rt) continue;
+    for (const Peak1D& p : spec)
+    {
+      if (p.getMZ() < min_mz || p.getMZ() > max_mz) continue;
+      ++stats.count;
+      stats.sum += p.getIntensity();
+      stats.max = std::max(stats.max, double(p.getIntensity()));
+    }
+  }
+  return stats;
+}
+
+START_TEST(AreaIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSExperiment exp;
+for (Size i = 0; i < 20; ++i)
+{
+  MSSpectrum spec;
+  spec.setMSLevel(1);
+  spec.setRT(10.0 * i);
+  for (Size j = 0; j < 100; ++j)
+  {
+    spec.push_back(Peak1D(100.0 + j + 0.01 * i, float((i + 1) * (j % 7 + 1))));
+  }
+  exp.addSpectrum(spec);
+
+  // MS2 spectra are not indexed
+  MSSpectrum ms2;
+  ms2.setMSLevel(2);
+  ms2.setRT(10.0 * i + 5.0);
+  ms2.push_back(Peak1D(150.0, 1e6f));
+  exp.addSpectrum(ms2);
+}
+// many equal m/z values spanning several blocks
+MSSpectrum flat;
+flat.setMSLevel(1);
+flat.setRT(500.0);
+for (Size j = 0; j < 70; ++j)
+{
+  flat.push_back(Peak1D(j < 10 ? 499.0 : 500.0, float(j)));
+}
+exp.addSpectrum(flat);
+
+AreaIndex* ptr = nullptr;
+AreaIndex* null_ptr = nullptr;
+START_SECTION(AreaIndex())
+{
+  ptr = new AreaIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->countPeaks(0, 1000, 0, 1000), 0)
+}
+END_SECTION
+
+START_SECTION(~AreaIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit AreaIndex(const MSExperiment& exp, UInt ms_level = 1))
+{
+  AreaIndex index(exp);
+  TEST_EQUAL(index.size(), 21)
+  AreaIndex index2(exp, 2);
+  TEST_EQUAL(index2.size(), 20)
+  TEST_EQUAL(index2.countPeaks(0, 1000, 0, 1000), 20)
+
+  MSExperiment unsorted;
+  MSSpectrum spec;
+  spec.push_back(Peak1D(200.0, 1.0f));
+  spec.push_back(Peak1D(100.0, 1.0f));
+  unsorted.addSpectrum(spec);
+  TEST_EXCEPTION(Exception::IllegalArgument, AreaIndex(unsorted, 1))
+}
+END_SECTION
+
+START_SECTION(void build(const MSExperiment& exp, UInt ms_level = 1))
+{
+  AreaIndex index;
+  index.build(exp);
+  TEST_EQUAL(index.size(), 21)
+  index.build(exp, 2);
+  TEST_EQUAL(index.size(), 20)
+  index.build(MSExperiment());
+  TEST_EQUAL(index.empty(), true)
+}
+END_SECTION
+
+AreaIndex index(exp);
+std::vector<std::vector<double> > areas = {
+  {0, 1000, 0, 1000}, {0, 0, 0, 1000}, {15, 55, 120.5, 160.02}, {30, 30, 100.0, 100.3},
+  {0, 1000, 499.0, 499.0}, {0, 1000, 500.0, 500.0}, {0, 1000, 499.5, 600.0}, {500, 500, 0, 1000},
+  {100, 190, 131.0, 131.0}, {1000, 2000, 0, 1000}, {0, 1000, 50, 99}, {50, 40, 0, 1000}};
+
+START_SECTION(Size countPeaks(double min_rt, double max_rt, double min_mz, double max_mz) const)
+{
+  for (const auto& a : areas)
+  {
+    TEST_EQUAL(index.countPeaks(a[0], a[1], a[2], a[3]), bruteForce(exp, a[0], a[1], a[2], a[3]).count)
+  }
+  TEST_EQUAL(index.countPeaks(0, 1000, 500.0, 500.0), 60)
+}
+END_SECTION
+
+START_SECTION(double sumIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const)
+{
+  for (const auto& a : areas)
+  {
+    TEST_REAL_SIMILAR(index.sumIntensity(a[0], a[1], a[2], a[3]), bruteForce(exp, a[0], a[1], a[2], a[3]).sum)
+  }
+}
+END_SECTION
+
+START_SECTION(double maxIntensity(double min_rt, double max_rt, double min_mz, double max_mz) const)
+{
+  for (const auto& a : areas)
+  {
+    TEST_REAL_SIMILAR(index.maxIntensity(a[0], a[1], a[2], a[3]), bruteForce(exp, a[0], a[1], a[2], a[3]).max)
+  }
+  TEST_REAL_SIMILAR(index.maxIntensity(0, 1000, 499.0, 499.0), 9.0)
+}
+END_SECTION
+
+START_SECTION(void extractXIC(double min_rt, double max_rt, double min_mz, double max_mz, MSChromatogram& xic) const)
+{
+  MSChromatogram xic;
+  index.extractXIC(15, 55, 103.5, 104.5, xic);
+  TEST_EQUAL(xic.size(), 4)
+  ABORT_IF(xic.size() != 4)
+  TEST_REAL_SIMILAR(xic[0].getRT(), 20.0)
+  TEST_REAL_SIMILAR(xic[0].getIntensity(), 3 * 5)
+  TEST_REAL_SIMILAR(xic[3].getRT(), 50.0)
+  TEST_REAL_SIMILAR(xic[3].getIntensity(), 6 * 5)
+
+  // spectra without peaks in the window contribute zero intensity
+  index.extractXIC(0, 1000, 499.5, 500.5, xic);
+  TEST_EQUAL(xic.size(), 21)
+  TEST_REAL_SIMILAR(xic[0].getIntensity(), 0.0)
+}
+END_SECTION
+
+START_SECTION(void getPeaks(double min_rt, double max_rt, double min_mz, double max_mz, std::vector<PeakIndex>& result) const)
+{
+  std::vector<PeakIndex> result;
+  index.getPeaks(25, 35, 110.0, 111.5, result);
+  TEST_EQUAL(result.size(), 2)
+  ABORT_IF(result.size() != 2)
+  // spectrum index refers to the experiment (MS1 and MS2 spectra alternate)
+  TEST_EQUAL(result[0].spectrum, 6)
+  TEST_EQUAL(result[0].peak, 10)
+  TEST_EQUAL(result[1].peak, 11)
+  TEST_REAL_SIMILAR(result[1].getPeak(exp).getMZ(), 111.03)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -193,6 +193,50 @@ START_SECTION((template < typename ToType > void decode(const String &in, ByteOr
 }
 END_SECTION
 
+START_SECTION([EXTRA] encode and decode of long arrays (vectorized code paths))
+{
+  // long inputs are processed in blocks by the SIMD code paths, the tail by the scalar code
+  Base64 b64;
+  String dest;
+  for (Size n = 1; n < 100; n += 7)
+  {
+    std::vector<double> data_double;
+    std::vector<float> data_float;
+    for (Size i = 0; i < n; ++i)
+    {
+      data_double.push_back(300.15 + 1.7 * i);
+      data_float.push_back(90.5f * i);
+    }
+    std::vector<double> in_double = data_double;
+    std::vector<float> in_float = data_float;
+    std::vector<double> res_double;
+    std::vector<float> res_float;
+
+    b64.encode(in_double, Base64::BYTEORDER_BIGENDIAN, dest);
+    TEST_EQUAL(dest.size(), (n * 8 + 2) / 3 * 4)
+    b64.decode(dest, Base64::BYTEORDER_BIGENDIAN, res_double);
+    TEST_EQUAL(res_double == data_double, true)
+
+    b64.encode(in_float, Base64::BYTEORDER_LITTLEENDIAN, dest);
+    b64.decode(dest, Base64::BYTEORDER_LITTLEENDIAN, res_float);
+    TEST_EQUAL(res_float == data_float, true)
+  }
+
+  // invalid characters decode to zero bits ('A'), independent of their position
+  std::vector<double> data_double(24, 471.568);
+  b64.encode(data_double, Base64::BYTEORDER_LITTLEENDIAN, dest);
+  String src = dest;
+  src[37] = '*';
+  dest[37] = 'A';
+  std::vector<double> res_double;
+  std::vector<double> ref_double;
+  b64.decode(src, Base64::BYTEORDER_LITTLEENDIAN, res_double);
+  b64.decode(dest, Base64::BYTEORDER_LITTLEENDIAN, ref_double);
+  TEST_EQUAL(res_double.size(), 24)
+  TEST_EQUAL(res_double == ref_double, true)
+}
+END_SECTION
+
 START_SECTION([EXTRA] zlib functionality)
 {
   TOLERANCE_ABSOLUTE(0.001)
@@ -338,6 +382,31 @@ START_SECTION((void decodeSingleString(const String & in, QByteArray & base64_un
   NOT_TESTABLE
 END_SECTION
 
+START_SECTION((static void decodeBytes(const char* in, Size in_size, std::vector<Byte>& out, bool zlib_compression)))
+{
+  std::vector<Byte> out;
+  String src = "QvAAAELIAA==";
+  Base64::decodeBytes(src.c_str(), src.size(), out, false);
+  TEST_EQUAL(out.size(), 8)
+  TEST_EQUAL((int)out[0], 0x42)
+  TEST_EQUAL((int)out[1], 0xf0)
+  TEST_EQUAL((int)out[7], 0x00)
+
+  // zlib compressed data, same result as decode()
+  std::vector<double> data_double = {300.15, 15.124, 304.2};
+  std::vector<double> in_double = data_double;
+  String str;
+  Base64::encode(in_double, Base64::BYTEORDER_LITTLEENDIAN, str, true);
+  Base64::decodeBytes(str.c_str(), str.size(), out, true);
+  TEST_EQUAL(out.size(), 24)
+  TEST_EQUAL(std::memcmp(out.data(), data_double.data(), 24), 0)
+
+  // too short input
+  Base64::decodeBytes("Q==", 3, out, true);
+  TEST_EQUAL(out.size(), 0)
+}
+END_SECTION
+
 START_SECTION((template < typename ToType > void decodeIntegers(const String &in, ByteOrder from_byte_order, std::vector< ToType > &out, bool zlib_compression=false)))
 {
   Base64 b64;
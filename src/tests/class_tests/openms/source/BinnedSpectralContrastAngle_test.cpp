@@ -106,6 +106,45 @@ START_SECTION((double operator()(const BinnedSpectrum &spec) const ))
 }
 END_SECTION
 
+START_SECTION((void computeSimilarityMatrix(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& library, Matrix<double>& similarities) const))
+{
+  PeakSpectrum s1;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+  std::vector<BinnedSpectrum> queries, library;
+  for (Size k = 0; k < 6; ++k)
+  {
+    PeakSpectrum s = s1;
+    // remove a different number of peaks from the end and shift some of the rest
+    s.resize(s.size() - std::min(3 * k, s.size() / 2));
+    for (Size i = 0; i < s.size(); i += k + 2) s[i].setMZ(s[i].getMZ() + 2.0 * k);
+    s.sortByPosition();
+    queries.push_back(BinnedSpectrum(s, 1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES));
+    s.resize(s.size() / 2);
+    library.push_back(BinnedSpectrum(s, 1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES));
+  }
+  library.push_back(queries[0]);
+
+  Matrix<double> sim;
+  ptr->computeSimilarityMatrix(queries, library, sim);
+  TEST_EQUAL(sim.rows(), queries.size())
+  TEST_EQUAL(sim.cols(), library.size())
+  for (Size i = 0; i < queries.size(); ++i)
+  {
+    for (Size j = 0; j < library.size(); ++j)
+    {
+      TEST_REAL_SIMILAR(sim(i, j), (*ptr)(queries[i], library[j]))
+    }
+  }
+  TEST_REAL_SIMILAR(sim(0, library.size() - 1), 1.0)
+
+  // the generic implementation gives the same result
+  Matrix<double> sim_generic;
+  ptr->BinnedSpectrumCompareFunctor::computeSimilarityMatrix(queries, library, sim_generic);
+  TEST_EQUAL(sim_generic.rows(), sim.rows())
+  TEST_REAL_SIMILAR(sim_generic(2, 3), sim(2, 3))
+}
+END_SECTION
+
 START_SECTION((static BinnedSpectrumCompareFunctor* create()))
 {
   BinnedSpectrumCompareFunctor* bsf = BinnedSpectralContrastAngle::create();
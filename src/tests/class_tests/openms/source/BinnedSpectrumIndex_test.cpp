@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumIndex.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BinnedSpectrumIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+BinnedSpectrumIndex* ptr = nullptr;
+BinnedSpectrumIndex* nullPointer = nullptr;
+
+START_SECTION((BinnedSpectrumIndex(float bin_size, float offset, UInt bin_spread, Size peaks_per_entry)))
+{
+  ptr = new BinnedSpectrumIndex();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EXCEPTION(Exception::InvalidValue, BinnedSpectrumIndex(0.0f))
+}
+END_SECTION
+
+START_SECTION((~BinnedSpectrumIndex()))
+{
+  delete ptr;
+}
+END_SECTION
+
+// library: entries with precursor m/z 510 - i / 10 and three peaks; the peak at 100 + i is unique to entry i
+auto makeSpectrum = [](double precursor_mz, const vector<double>& mzs)
+{
+  PeakSpectrum s;
+  Precursor p;
+  p.setMZ(precursor_mz);
+  s.getPrecursors().push_back(p);
+  for (double mz : mzs) { s.push_back(Peak1D(mz, 100.0)); }
+  return s;
+};
+
+vector<PeakSpectrum> library;
+for (Size i = 0; i < 100; ++i)
+{
+  library.push_back(makeSpectrum(510.0 - i / 10.0, {100.0 + i, 300.0 + 10.0 * (i % 3), 700.5}));
+}
+
+START_SECTION((void build(const std::vector<PeakSpectrum>& library)))
+{
+  BinnedSpectrumIndex index(0.02f, 0.0f, 1, 50);
+  index.build(library);
+  TEST_EQUAL(index.size(), 100)
+  TEST_EQUAL(index.getNumberOfPostings(), 300)
+
+  vector<PeakSpectrum> no_precursor(1);
+  TEST_EXCEPTION(Exception::MissingInformation, index.build(no_precursor))
+}
+END_SECTION
+
+START_SECTION((void query(const PeakSpectrum& spectrum, double precursor_mz_low, double precursor_mz_high, Size k, std::vector<Size>& candidates) const))
+{
+  BinnedSpectrumIndex index(0.02f, 0.0f, 1, 50);
+  index.build(library);
+  vector<Size> candidates;
+
+  // window without entries
+  index.query(library[0], 100.0, 200.0, 5, candidates);
+  TEST_EQUAL(candidates.size(), 0)
+
+  // small window: all entries are returned in precursor m/z order
+  index.query(library[0], 509.75, 510.05, 5, candidates);
+  TEST_EQUAL(candidates.size(), 3)
+  ABORT_IF(candidates.size() != 3)
+  TEST_EQUAL(candidates[0], 2)
+  TEST_EQUAL(candidates[1], 1)
+  TEST_EQUAL(candidates[2], 0)
+
+  // large window: the entry sharing all peaks ranks first, followed by those sharing two
+  index.query(library[42], 0.0, 1000.0, 1, candidates);
+  TEST_EQUAL(candidates.size(), 1)
+  ABORT_IF(candidates.size() != 1)
+  TEST_EQUAL(candidates[0], 42)
+
+  index.query(library[42], 505.0, 507.0, 4, candidates);
+  TEST_EQUAL(candidates.size(), 4)
+  ABORT_IF(candidates.size() != 4)
+  // entry 42 shares all peaks, entries 30, 33, ..., 48 share two (ties go to lower precursor m/z); returned in precursor m/z order
+  TEST_EQUAL(candidates[0], 48)
+  TEST_EQUAL(candidates[1], 45)
+  TEST_EQUAL(candidates[2], 42)
+  TEST_EQUAL(candidates[3], 39)
+
+  // query peaks in a neighboring bin are found through the bin spread
+  PeakSpectrum shifted = makeSpectrum(505.8, {142.03});
+  index.query(shifted, 0.0, 1000.0, 1, candidates);
+  TEST_EQUAL(candidates.size(), 1)
+  ABORT_IF(candidates.size() != 1)
+  TEST_EQUAL(candidates[0], 42)
+
+  // no shared bins: nothing is returned
+  PeakSpectrum unrelated = makeSpectrum(505.8, {900.0});
+  index.query(unrelated, 0.0, 1000.0, 1, candidates);
+  TEST_EQUAL(candidates.size(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -412,6 +412,88 @@ START_SECTION( static inline void readChromatogramFast(OpenSwath::BinaryDataArra
 }
 END_SECTION
 
+START_SECTION(( void setFormatVersion(FormatVersion version) ))
+{
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  // lossless version 2: identical data, index from the footer
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  CachedMzMLHandler cache;
+  TEST_EQUAL(cache.getFormatVersion(), CachedMzMLHandler::FORMAT_V1)
+  cache.setFormatVersion(CachedMzMLHandler::FORMAT_V2);
+  TEST_EQUAL(cache.getFormatVersion(), CachedMzMLHandler::FORMAT_V2)
+  cache.writeMemdump(exp, tmp_filename);
+
+  CachedMzMLHandler index;
+  index.createMemdumpIndex(tmp_filename);
+  TEST_EQUAL(index.getFormatVersion(), CachedMzMLHandler::FORMAT_V2)
+  TEST_EQUAL(index.getSpectraIndex().size(), 4)
+  TEST_EQUAL(index.getChromatogramIndex().size(), 2)
+  TEST_EQUAL(index.getSpectraRTIndex().size(), 4)
+  TEST_EQUAL(index.getSpectraMSLevelIndex().size(), 4)
+  TEST_EQUAL(index.getSpectraPrecursorMZIndex().size(), 4)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(index.getSpectraRTIndex()[i], exp[i].getRT())
+    TEST_EQUAL(index.getSpectraMSLevelIndex()[i], exp[i].getMSLevel())
+  }
+
+  PeakMap exp_new;
+  index.readMemdump(exp_new, tmp_filename);
+  TEST_EQUAL(exp_new.size(), exp.size())
+  TEST_EQUAL(exp_new.getChromatograms().size(), exp.getChromatograms().size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp_new[i].size(), exp[i].size())
+    TEST_EQUAL(exp_new[i].getFloatDataArrays().size(), exp[i].getFloatDataArrays().size())
+    for (Size k = 0; k < exp[i].size(); ++k)
+    {
+      TEST_EQUAL(exp_new[i][k].getMZ(), exp[i][k].getMZ())
+      TEST_EQUAL(exp_new[i][k].getIntensity(), exp[i][k].getIntensity())
+    }
+  }
+  for (Size i = 0; i < exp.getChromatograms().size(); ++i)
+  {
+    TEST_EQUAL(exp_new.getChromatograms()[i].size(), exp.getChromatograms()[i].size())
+    for (Size k = 0; k < exp.getChromatograms()[i].size(); ++k)
+    {
+      TEST_EQUAL(exp_new.getChromatograms()[i][k].getRT(), exp.getChromatograms()[i][k].getRT())
+      TEST_EQUAL(exp_new.getChromatograms()[i][k].getIntensity(), exp.getChromatograms()[i][k].getIntensity())
+    }
+  }
+
+  // random access into version 2
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  ifs_.seekg(index.getSpectraIndex()[1]);
+  MSSpectrum s;
+  CachedMzMLHandler::readSpectrum(s, ifs_, CachedMzMLHandler::FORMAT_V2);
+  TEST_EQUAL(s.size(), exp[1].size())
+  TEST_REAL_SIMILAR(s.getRT(), exp[1].getRT())
+
+  // lossy version 2: numpress encoded m/z and RT values
+  std::string tmp_filename_lossy;
+  NEW_TMP_FILE(tmp_filename_lossy);
+  cache.setLossyCompression(true);
+  TEST_EQUAL(cache.getLossyCompression(), true)
+  cache.writeMemdump(exp, tmp_filename_lossy);
+  PeakMap exp_lossy;
+  cache.readMemdump(exp_lossy, tmp_filename_lossy);
+  TEST_EQUAL(exp_lossy.size(), exp.size())
+  TOLERANCE_RELATIVE(1.0 + 1e-6)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp_lossy[i].size(), exp[i].size())
+    for (Size k = 0; k < exp[i].size(); ++k)
+    {
+      TEST_REAL_SIMILAR(exp_lossy[i][k].getMZ(), exp[i][k].getMZ())
+      TEST_EQUAL(exp_lossy[i][k].getIntensity(), exp[i][k].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -180,6 +180,31 @@ START_SECTION(( [EXTRA] testCaching))
 }
 END_SECTION
 
+START_SECTION(( CachedmzML(const CachedmzML & rhs) ))
+{
+  // copies share the mapped file, the index and the meta data
+  CachedmzML copy(cache_example);
+  TEST_EQUAL(copy.getNrSpectra(), 4)
+  TEST_EQUAL(copy.getNrChromatograms(), 2)
+  TEST_EQUAL(&copy.getMetaData() == &cache_example.getMetaData(), true)
+  for (Size i = 0; i < 4; i++)
+  {
+    TEST_EQUAL(copy.getSpectrum(i) == cache_example.getSpectrum(i), true)
+  }
+
+  // concurrent access on the same object
+  Size nr_errors = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: nr_errors)
+#endif
+  for (SignedSize i = 0; i < 40; i++)
+  {
+    if (copy.getSpectrum(i % 4).size() != exp[i % 4].size()) ++nr_errors;
+  }
+  TEST_EQUAL(nr_errors, 0)
+}
+END_SECTION
+
 START_SECTION(( size_t getNrSpectra() const ))
     TEST_EQUAL(cache_example.getNrSpectra(), 4)
 END_SECTION
@@ -0,0 +1,174 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/CachedPeptideDatabase.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/SYSTEM/File.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(CachedPeptideDatabase, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+CachedPeptideDatabase* ptr = nullptr;
+CachedPeptideDatabase* null_ptr = nullptr;
+START_SECTION(CachedPeptideDatabase())
+{
+  ptr = new CachedPeptideDatabase();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~CachedPeptideDatabase())
+{
+  delete ptr;
+}
+END_SECTION
+
+vector<FASTAFile::FASTAEntry> proteins;
+proteins.push_back(FASTAFile::FASTAEntry("P1", "", "PEPTIDEKMAMAR"));
+proteins.push_back(FASTAFile::FASTAEntry("P2", "", "MAMARGGXGKLLLK"));
+
+CachedPeptideDatabase::Settings settings;
+settings.enzyme = "Trypsin";
+settings.missed_cleavages = 0;
+settings.min_length = 3;
+settings.max_length = 0;
+settings.variable_modifications = {"Oxidation (M)"};
+settings.max_variable_mods_per_peptide = 2;
+
+String filename;
+NEW_TMP_FILE(filename)
+
+START_SECTION(static void store(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings))
+{
+  CachedPeptideDatabase::store(filename, proteins, settings);
+  TEST_EQUAL(File::exists(filename), true)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, CachedPeptideDatabase::store("/does/not/exist/peptides.db", proteins, settings))
+}
+END_SECTION
+
+START_SECTION(bool load(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings))
+{
+  CachedPeptideDatabase db;
+  TEST_EQUAL(db.load(filename, proteins, settings), true)
+  TEST_EQUAL(db.size(), 3)
+
+  // different settings or proteins
+  CachedPeptideDatabase::Settings other_settings = settings;
+  other_settings.missed_cleavages = 1;
+  TEST_EQUAL(db.load(filename, proteins, other_settings), false)
+  TEST_EQUAL(db.size(), 0)
+  vector<FASTAFile::FASTAEntry> other_proteins = proteins;
+  other_proteins[1].sequence = "MAMARGGGKLLLK";
+  TEST_EQUAL(db.load(filename, other_proteins, settings), false)
+
+  // missing file
+  TEST_EQUAL(db.load(filename + ".missing", proteins, settings), false)
+}
+END_SECTION
+
+START_SECTION(void loadOrStore(const String& filename, const std::vector<FASTAFile::FASTAEntry>& proteins, const Settings& settings))
+{
+  String new_filename;
+  NEW_TMP_FILE(new_filename)
+  CachedPeptideDatabase db;
+  db.loadOrStore(new_filename, proteins, settings);
+  TEST_EQUAL(db.size(), 3)
+
+  // recreated for different settings
+  CachedPeptideDatabase::Settings other_settings = settings;
+  other_settings.min_length = 5;
+  db.loadOrStore(new_filename, proteins, other_settings);
+  TEST_EQUAL(db.size(), 2)
+}
+END_SECTION
+
+CachedPeptideDatabase db;
+db.load(filename, proteins, settings);
+
+START_SECTION(StringView getSequence(Size peptide_index) const)
+{
+  // in order of first occurrence, peptides with X are excluded
+  TEST_EQUAL(db.getSequence(0).getString(), "PEPTIDEK")
+  TEST_EQUAL(db.getSequence(1).getString(), "MAMAR")
+  TEST_EQUAL(db.getSequence(2).getString(), "LLLK")
+}
+END_SECTION
+
+START_SECTION(Size getNumberOfVariants(Size peptide_index) const)
+{
+  TEST_EQUAL(db.getNumberOfVariants(0), 1)
+  TEST_EQUAL(db.getNumberOfVariants(1), 4)
+  TEST_EQUAL(db.getNumberOfVariants(2), 1)
+}
+END_SECTION
+
+START_SECTION(double getVariantMass(Size peptide_index, Size variant_index) const)
+{
+  TEST_REAL_SIMILAR(db.getVariantMass(0, 0), AASequence::fromString("PEPTIDEK").getMonoWeight())
+  double min_mass = db.getVariantMass(1, 0);
+  for (Size i = 1; i != db.getNumberOfVariants(1); ++i)
+  {
+    min_mass = std::min(min_mass, db.getVariantMass(1, i));
+  }
+  TEST_REAL_SIMILAR(min_mass, AASequence::fromString("MAMAR").getMonoWeight())
+}
+END_SECTION
+
+START_SECTION(std::vector<Size> getProteinReferences(Size peptide_index) const)
+{
+  TEST_EQUAL(db.getProteinReferences(0).size(), 1)
+  TEST_EQUAL(db.getProteinReferences(0)[0], 0)
+  TEST_EQUAL(db.getProteinReferences(1).size(), 2)
+  TEST_EQUAL(db.getProteinReferences(1)[0], 0)
+  TEST_EQUAL(db.getProteinReferences(1)[1], 1)
+  TEST_EQUAL(db.getProteinReferences(2).size(), 1)
+  TEST_EQUAL(db.getProteinReferences(2)[0], 1)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
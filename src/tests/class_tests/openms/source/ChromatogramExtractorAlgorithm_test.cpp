@@ -38,6 +38,7 @@
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -136,6 +137,116 @@ START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr input
 }
 END_SECTION
 
+START_SECTION(void extractChromatograms(const std::vector<SoASpectrum>& input, const std::vector<double>& retention_times, std::vector< OpenSwath::ChromatogramPtr >& output, const std::vector<ExtractionCoordinates>& extraction_coordinates, double mz_extraction_window, bool ppm, double im_extraction_window, const String& filter))
+{
+  double extract_window = 0.05;
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::vector<SoASpectrum> soa_spectra;
+  std::vector<double> rts;
+  for (const auto& s : exp->getSpectra())
+  {
+    soa_spectra.emplace_back(s);
+    rts.push_back(s.getRT());
+  }
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 618.31; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr1";
+    coordinates.push_back(coord);
+    coord.mz = 628.45; coord.rt_start = 3050; coord.rt_end = 3110; coord.id = "tr2";
+    coordinates.push_back(coord);
+    coord.mz = 654.38; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr3";
+    coordinates.push_back(coord);
+  }
+  std::vector< OpenSwath::ChromatogramPtr > out_aos, out_soa;
+  for (int i = 0; i < 3; i++)
+  {
+    out_aos.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_soa.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+  extractor.extractChromatograms(expptr, out_aos, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(soa_spectra, rts, out_soa, coordinates, extract_window, false, -1, "tophat");
+
+  // same result as extraction from the spectrum access interface
+  for (Size k = 0; k < 3; ++k)
+  {
+    TEST_EQUAL(out_soa[k]->getTimeArray()->data.size(), out_aos[k]->getTimeArray()->data.size())
+    ABORT_IF(out_soa[k]->getTimeArray()->data.size() != out_aos[k]->getTimeArray()->data.size())
+    for (Size i = 0; i < out_soa[k]->getTimeArray()->data.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(out_soa[k]->getTimeArray()->data[i], out_aos[k]->getTimeArray()->data[i])
+      TEST_REAL_SIMILAR(out_soa[k]->getIntensityArray()->data[i], out_aos[k]->getIntensityArray()->data[i])
+    }
+  }
+  TEST_EQUAL(out_soa[0]->getTimeArray()->data.size(), 59)
+
+  // there is no ion mobility, so this should not work
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(soa_spectra, rts, out_soa, coordinates, extract_window, false, 1, "tophat"))
+  // sizes need to match
+  rts.pop_back();
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(soa_spectra, rts, out_soa, coordinates, extract_window, false, -1, "tophat"))
+}
+END_SECTION
+
+START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
+{
+  // large libraries are extracted in blocks of coordinates, which must give the same result as a single sweep
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  for (Size i = 0; i < 10000; ++i)
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 400.0 + i * 0.05;
+    coord.rt_start = (i % 3 == 0) ? 3050 : 0;
+    coord.rt_end = (i % 3 == 0) ? 3110 : -1;
+    coord.id = String(i);
+    coordinates.push_back(coord);
+  }
+  std::vector< OpenSwath::ChromatogramPtr > out;
+  for (Size i = 0; i < coordinates.size(); ++i)
+  {
+    out.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+  extractor.extractChromatograms(expptr, out, coordinates, 0.05, false, -1, "tophat");
+
+  std::vector<Size> pos(coordinates.size(), 0);
+  for (Size scan_idx = 0; scan_idx < expptr->getNrSpectra(); ++scan_idx)
+  {
+    OpenSwath::SpectrumPtr sptr = expptr->getSpectrumById(scan_idx);
+    double rt = expptr->getSpectrumMetaById(scan_idx).RT;
+    const std::vector<double>& mz_arr = sptr->getMZArray()->data;
+    const std::vector<double>& int_arr = sptr->getIntensityArray()->data;
+    if (mz_arr.empty()) continue;
+    for (Size k = 0; k < coordinates.size(); ++k)
+    {
+      if (coordinates[k].rt_end - coordinates[k].rt_start > 0 && (rt < coordinates[k].rt_start || rt > coordinates[k].rt_end)) continue;
+      std::vector<double>::const_iterator mz_it = mz_arr.begin(), int_it = int_arr.begin();
+      double intensity = 0;
+      extractor.extract_value_tophat(mz_arr.begin(), mz_it, mz_arr.end(), int_it, coordinates[k].mz, intensity, 0.05, false);
+      ABORT_IF(pos[k] >= out[k]->getIntensityArray()->data.size())
+      TEST_EQUAL(out[k]->getTimeArray()->data[pos[k]], rt)
+      TEST_EQUAL(out[k]->getIntensityArray()->data[pos[k]], intensity)
+      ++pos[k];
+    }
+  }
+  for (Size k = 0; k < coordinates.size(); ++k)
+  {
+    TEST_EQUAL(out[k]->getIntensityArray()->data.size(), pos[k])
+  }
+}
+END_SECTION
+
 START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
 {
   typedef OpenMS::DataArrays::FloatDataArray FloatDataArray;
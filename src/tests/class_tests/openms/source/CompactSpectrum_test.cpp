@@ -0,0 +1,155 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/CompactSpectrum.h>
+///////////////////////////
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(CompactSpectrum, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSSpectrum spec;
+spec.setRT(12.5);
+for (Size i = 0; i < 1000; ++i)
+{
+  spec.push_back(Peak1D(200.0 + i * 1.2345678901, float(i)));
+}
+
+CompactSpectrum* ptr = nullptr;
+CompactSpectrum* null_ptr = nullptr;
+START_SECTION(CompactSpectrum())
+{
+  ptr = new CompactSpectrum();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~CompactSpectrum())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit CompactSpectrum(const MSSpectrum& spectrum))
+{
+  CompactSpectrum c(spec);
+  TEST_EQUAL(c.size(), 1000)
+  TEST_REAL_SIMILAR(c.getBaseMZ(), 200.0)
+  double max_error(0);
+  for (Size i = 0; i < spec.size(); ++i)
+  {
+    max_error = std::max(max_error, std::fabs(c.getMZ(i) - spec[i].getMZ()));
+    TEST_EQUAL(c.getIntensity(i), spec[i].getIntensity())
+  }
+  // span of ~1234 Th: the relative encoding is accurate to about 1e-4 Th
+  TEST_EQUAL(max_error < 1e-4, true)
+  TEST_REAL_SIMILAR(max_error, c.getMaxMZError())
+  TEST_REAL_SIMILAR(c[999].getMZ(), spec[999].getMZ())
+}
+END_SECTION
+
+START_SECTION(void assign(const MSSpectrum& spectrum))
+{
+  CompactSpectrum c(spec);
+  MSSpectrum unsorted;
+  unsorted.push_back(Peak1D(500.0, 1.0f));
+  unsorted.push_back(Peak1D(100.0, 2.0f));
+  c.assign(unsorted);
+  TEST_EQUAL(c.size(), 2)
+  TEST_REAL_SIMILAR(c.getBaseMZ(), 100.0)
+  TEST_REAL_SIMILAR(c.getMZ(0), 500.0)
+  TEST_REAL_SIMILAR(c.getMZ(1), 100.0)
+  c.assign(MSSpectrum());
+  TEST_EQUAL(c.empty(), true)
+  TEST_EQUAL(c.getMaxMZError(), 0.0)
+}
+END_SECTION
+
+START_SECTION(void exportTo(MSSpectrum& spectrum) const)
+{
+  CompactSpectrum c(spec);
+  MSSpectrum out;
+  out.setRT(99.0);
+  out.push_back(Peak1D(1.0, 1.0f));
+  c.exportTo(out);
+  TEST_EQUAL(out.size(), spec.size())
+  TEST_REAL_SIMILAR(out.getRT(), 99.0)
+  TEST_REAL_SIMILAR(out[500].getMZ(), spec[500].getMZ())
+  TEST_EQUAL(out[500].getIntensity(), spec[500].getIntensity())
+}
+END_SECTION
+
+START_SECTION(bool operator==(const CompactSpectrum& rhs) const)
+{
+  CompactSpectrum a(spec), b(spec), c;
+  TEST_EQUAL(a == b, true)
+  TEST_EQUAL(a == c, false)
+  TEST_EQUAL(a != c, true)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  CompactSpectrum c(spec);
+  c.clear();
+  TEST_EQUAL(c.empty(), true)
+  TEST_EQUAL(c == CompactSpectrum(), true)
+}
+END_SECTION
+
+START_SECTION(Size getMemoryUsage() const)
+{
+  CompactSpectrum c(spec);
+  // half of the Peak1D storage
+  TEST_EQUAL(c.getMemoryUsage() < spec.size() * sizeof(Peak1D) / 2 + 100, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
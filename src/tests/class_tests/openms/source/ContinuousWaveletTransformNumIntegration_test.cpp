@@ -82,6 +82,35 @@ START_SECTION((template <typename InputPeakIterator> void transform(InputPeakIte
   TEST_REAL_SIMILAR(transformer.getWavelet()[0],1.)
   TEST_REAL_SIMILAR(transformer.getScale(),scale)
   TEST_REAL_SIMILAR(transformer.getSpacing(),spacing)
+
+  // symmetric peak on equidistant data: the transform is symmetric and maximal at the apex
+  std::vector<Peak1D> peak(41);
+  for (Size i = 0; i < peak.size(); ++i)
+  {
+    double x = (double(i) - 20.0) * 0.1;
+    peak[i].setMZ(500.0 + x);
+    peak[i].setIntensity(1000.0 * std::exp(-x * x / (2 * 0.3 * 0.3)));
+  }
+  for (float resolution : {1.0f, 2.0f})
+  {
+    ContinuousWaveletTransformNumIntegration wt;
+    wt.init(scale, spacing);
+    wt.transform(peak.begin(), peak.end(), resolution);
+    const int n = wt.getSize();
+    TEST_EQUAL(n, int(resolution * peak.size()))
+    int apex = 0;
+    for (int i = 0; i < n; ++i)
+    {
+      if (wt[i] > wt[apex]) apex = i;
+    }
+    TOLERANCE_RELATIVE(1.001)
+    for (int i = n / 2 - 5 * int(resolution); i <= n / 2 + 5 * int(resolution); ++i)
+    {
+      TEST_REAL_SIMILAR(wt[i], wt[n - 1 - i])
+    }
+    TEST_EQUAL(apex == (n - 1) / 2 || apex == n / 2, true)
+    TEST_EQUAL(wt[apex] > 0, true)
+  }
 END_SECTION
 
 /////////////////////////////////////////////////////////////
@@ -183,6 +183,22 @@ START_SECTION((void getAllChildTerms(std::set<String>& terms, const String& pare
 	TEST_EQUAL(terms.find("OpenMS:5") == terms.end(), false)
 END_SECTION
 
+START_SECTION((static const ControlledVocabulary& getCachedCV(const std::vector<std::pair<String, String>>& obo_files)))
+{
+  const ControlledVocabulary& cached = ControlledVocabulary::getCachedCV({{"bla", OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo")}});
+  TEST_EQUAL(cached.name(), "bla")
+  TEST_EQUAL(cached.getTerms().size(), cv.getTerms().size())
+  TEST_EQUAL(cached.exists("OpenMS:6"), true)
+  // same list -> same instance, no re-parsing
+  TEST_EQUAL(&ControlledVocabulary::getCachedCV({{"bla", OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo")}}), &cached)
+  // different name -> separate instance
+  const ControlledVocabulary& other = ControlledVocabulary::getCachedCV({{"blubb", OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo")}});
+  TEST_NOT_EQUAL(&other, &cached)
+  TEST_EQUAL(other.name(), "blubb")
+  TEST_EXCEPTION(Exception::FileNotFound, ControlledVocabulary::getCachedCV({{"bla", "/this/file/does/not/exist.obo"}}))
+}
+END_SECTION
+
 
 ControlledVocabulary::CVTerm * cvterm = nullptr;
 ControlledVocabulary::CVTerm * cvtermNullPointer = nullptr;
@@ -251,6 +251,16 @@ START_SECTION((bool addPoint(const PointType& point)))
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(3.0,2.5)),false)
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(3.0,2.0)),false)
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(0.5,0.5)),true)	
+	// scans inserted out of RT order are kept sorted
+	TEST_EQUAL(tmp.addPoint(DPosition<2>(2.0,2.0)),true)
+	ConvexHull2D::PointArrayType points = tmp.getHullPoints();
+	ABORT_IF(points.size() < 5)
+	TEST_REAL_SIMILAR(points[0][0], 0.5)
+	TEST_REAL_SIMILAR(points[1][0], 1.0)
+	TEST_REAL_SIMILAR(points[2][0], 1.5)
+	TEST_REAL_SIMILAR(points[3][0], 2.0)
+	TEST_REAL_SIMILAR(points[4][0], 3.0)
+	TEST_REAL_SIMILAR(points[4][1], 1.5)
 END_SECTION
 
 START_SECTION((Size compress()))
@@ -508,6 +508,22 @@ START_SECTION ( void dia_by_ion_score(SpectrumType spectrum, AASequence &sequenc
 
   TEST_REAL_SIMILAR (bseries_score, 1);
   TEST_REAL_SIMILAR (yseries_score, 3);
+
+  // the b/y series of the previous peptide must not be reused
+  AASequence unmodified = AASequence::fromString(sequence);
+  bseries_score = 0, yseries_score = 0;
+  diascoring.dia_by_ion_score(sptr, unmodified, 1, bseries_score, yseries_score);
+  TEST_REAL_SIMILAR (bseries_score, 2);
+  TEST_REAL_SIMILAR (yseries_score, 2);
+
+  double bseries_charge2 = 0, yseries_charge2 = 0;
+  DIAScoring diascoring_charge2;
+  diascoring_charge2.setParameters(p_dia);
+  diascoring_charge2.dia_by_ion_score(sptr, unmodified, 2, bseries_charge2, yseries_charge2);
+  bseries_score = 0, yseries_score = 0;
+  diascoring.dia_by_ion_score(sptr, unmodified, 2, bseries_score, yseries_score);
+  TEST_REAL_SIMILAR (bseries_score, bseries_charge2);
+  TEST_REAL_SIMILAR (yseries_score, yseries_charge2);
 }
 END_SECTION
 
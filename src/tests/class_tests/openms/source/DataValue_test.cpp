@@ -1058,6 +1058,48 @@ START_SECTION((DataValue& operator=(const unsigned long long)))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] short and long strings))
+  // strings of up to 7 characters are stored inline, longer ones on the heap
+  std::vector<String> values = {"", "a", "1234567", "12345678", "a much longer string value"};
+  for (const String& v : values)
+  {
+    DataValue a(v);
+    TEST_EQUAL(a.valueType(), DataValue::STRING_VALUE)
+    TEST_EQUAL(a.toString(), v)
+    TEST_STRING_EQUAL(a.toChar(), v.c_str())
+    TEST_EQUAL(std::string(a), v)
+
+    DataValue copy(a);
+    TEST_EQUAL(copy == a, true)
+    TEST_EQUAL(copy.toString(), v)
+
+    DataValue moved(std::move(copy));
+    TEST_EQUAL(moved.toString(), v)
+    TEST_EQUAL(copy.isEmpty(), true)
+
+    // switch between inline and heap storage via assignment
+    DataValue b("short");
+    b = a;
+    TEST_EQUAL(b.toString(), v)
+    b = "another long string";
+    TEST_EQUAL(b.toString(), "another long string")
+    b = std::move(moved);
+    TEST_EQUAL(b.toString(), v)
+    b = String("xy");
+    TEST_EQUAL(b.toString(), "xy")
+  }
+
+  // comparison across storage types
+  TEST_EQUAL(DataValue("abc") < DataValue("abcdefghij"), true)
+  TEST_EQUAL(DataValue("abcdefghij") > DataValue("abc"), true)
+  TEST_EQUAL(DataValue("abcdefg") == DataValue(String("abcdefg")), true)
+  TEST_EQUAL(DataValue("abcdefg") == DataValue("abcdefgh"), false)
+
+  std::ostringstream os;
+  os << DataValue("abc") << DataValue("abcdefghij");
+  TEST_EQUAL(os.str(), "abcabcdefghij")
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -315,6 +315,50 @@ START_SECTION(static void deisotopeWithAveragineModel(MSSpectrum& spectrum,
 }
 END_SECTION
 
+START_SECTION(static void deisotopeAndSingleCharge(PeakMap& exp,
+                                         double fragment_tolerance,
+                                         bool fragment_unit_ppm,
+                                         int min_charge = 1,
+                                         int max_charge = 3,
+                                         bool keep_only_deisotoped = false,
+                                         unsigned int min_isopeaks = 3,
+                                         unsigned int max_isopeaks = 10,
+                                         bool make_single_charged = true,
+                                         bool annotate_charge = false,
+                                         bool annotate_iso_peak_count = false,
+                                         bool use_decreasing_model = true,
+                                         unsigned int start_intensity_check = 2,
+                                         bool add_up_intensity = false))
+{
+  MzMLFile file;
+  PeakMap in;
+  file.load(OPENMS_GET_TEST_DATA_PATH("Deisotoper_test_in.mzML"), in);
+  ABORT_IF(in.empty())
+
+  // many copies of the same spectrum; one of them unsorted
+  PeakMap exp;
+  for (Size i = 0; i < 16; ++i)
+  {
+    exp.addSpectrum(in.getSpectrum(0));
+  }
+  exp[5].sortByIntensity();
+
+  MSSpectrum expected = in.getSpectrum(0);
+  expected.sortByPosition();
+  Deisotoper::deisotopeAndSingleCharge(expected, 10.0, true, 1, 3, false, 2, 10, true, true);
+
+  Deisotoper::deisotopeAndSingleCharge(exp, 10.0, true, 1, 3, false, 2, 10, true, true);
+  TEST_EQUAL(exp.size(), 16)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp[i] == expected, true)
+  }
+
+  // invalid arguments are propagated
+  TEST_EXCEPTION(Exception::IllegalArgument, Deisotoper::deisotopeAndSingleCharge(exp, 10.0, true, 1, 3, false, 1, 10))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
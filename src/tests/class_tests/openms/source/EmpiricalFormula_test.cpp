@@ -189,6 +189,14 @@ START_SECTION(EmpiricalFormula& operator+=(const EmpiricalFormula& rhs))
   TEST_EQUAL(ef, "C")
   ef += EmpiricalFormula("C-1H2");
   TEST_EQUAL(ef, "H2")
+
+  // more elements than stored inline
+  ef = EmpiricalFormula("C6H12N2O3S1P1");
+  ef += EmpiricalFormula("Na1K1Cl2Br1Fe1Se1");
+  TEST_EQUAL(ef, "BrC6Cl2FeH12KN2NaO3PSSe")
+  TEST_EQUAL(ef.getNumberOfAtoms(), 32)
+  ef += EmpiricalFormula("Na-1K-1Cl-2Br-1Fe-1Se-1");
+  TEST_EQUAL(ef, "C6H12N2O3S1P1")
 END_SECTION
 
 START_SECTION(EmpiricalFormula operator+(const EmpiricalFormula& rhs) const)
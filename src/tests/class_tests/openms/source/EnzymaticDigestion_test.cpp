@@ -308,6 +308,63 @@ START_SECTION((Size digestUnmodified(const StringView sequence, std::vector<Stri
 }
 END_SECTION
 
+START_SECTION((Size digestUnmodified(const StringView& sequence, const std::function<void(Size, Size)>& product, Size min_length = 1, Size max_length = 0) const))
+{
+  EnzymaticDigestion ed;
+  const std::string s = "ACKDEFRGHKPKLMNRSTK";
+  for (Size missed_cleavages : {0, 1, 2})
+  {
+    ed.setMissedCleavages(missed_cleavages);
+    for (std::pair<Size, Size> length : {std::make_pair(1, 0), std::make_pair(3, 8)})
+    {
+      vector<StringView> expected;
+      Size expected_discarded = ed.digestUnmodified(s, expected, length.first, length.second);
+
+      vector<std::pair<Size, Size> > products;
+      Size discarded = ed.digestUnmodified(StringView(s), [&products](Size start, Size l) { products.emplace_back(start, l); }, length.first, length.second);
+      TEST_EQUAL(discarded, expected_discarded)
+      TEST_EQUAL(products.size(), expected.size())
+      for (Size i = 0; i != std::min(products.size(), expected.size()); ++i)
+      {
+        TEST_EQUAL(s.substr(products[i].first, products[i].second), expected[i].getString())
+      }
+    }
+  }
+
+  // unspecific cleavage
+  ed.setEnzyme(ProteaseDB::getInstance()->getEnzyme("unspecific cleavage"));
+  Size count(0);
+  ed.digestUnmodified(StringView(s), [&count](Size, Size) { ++count; }, 5, 6);
+  TEST_EQUAL(count, (s.size() - 4) + (s.size() - 5))
+}
+END_SECTION
+
+START_SECTION((Size digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size,Size>>>& output, Size min_length = 1, Size max_length = 0) const))
+{
+  EnzymaticDigestion ed;
+  ed.setMissedCleavages(1);
+  const vector<std::string> proteins = {"ACKDEFRGHKPKLMNRSTK", "", "PEPTIDE", "KKKKRRRR", "MLKAAAAAAAAAAAAAAAAAAAAAAAAR"};
+  vector<StringView> sequences(proteins.begin(), proteins.end());
+
+  vector<vector<std::pair<Size, Size> > > output;
+  Size discarded = ed.digestUnmodified(sequences, output, 2, 20);
+  TEST_EQUAL(output.size(), proteins.size())
+
+  Size expected_discarded(0);
+  for (Size p = 0; p != proteins.size(); ++p)
+  {
+    vector<StringView> expected;
+    expected_discarded += ed.digestUnmodified(sequences[p], expected, 2, 20);
+    TEST_EQUAL(output[p].size(), expected.size())
+    for (Size i = 0; i != std::min(output[p].size(), expected.size()); ++i)
+    {
+      TEST_EQUAL(proteins[p].substr(output[p][i].first, output[p][i].second), expected[i].getString())
+    }
+  }
+  TEST_EQUAL(discarded, expected_discarded)
+}
+END_SECTION
+
 START_SECTION((bool isValidProduct(const String& sequence, int pos, int length, bool ignore_missed_cleavages)))
 {
     EnzymaticDigestion ed;
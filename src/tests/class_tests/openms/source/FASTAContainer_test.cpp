@@ -220,6 +220,35 @@ START_SECTION(size_t size() const)
 
 END_SECTION
 
+START_SECTION([FASTAContainer<TFI_Indexed>] FASTAContainer(const String& database_file))
+  String db_file;
+  NEW_TMP_FILE(db_file)
+  IndexedFASTAFile::store(db_file, fev);
+  FASTAContainer<TFI_Indexed> fi(db_file);
+  TEST_EQUAL(fi.empty(), false)
+  TEST_EQUAL(fi.size(), 4) // known upfront
+  TEST_EQUAL(fi.cacheChunk(3), true)
+  TEST_EQUAL(fi.activateCache(), true)
+  TEST_EQUAL(fi.chunkSize(), 3)
+  TEST_EQUAL(fi.getChunkOffset(), 0)
+  TEST_EQUAL(fi.chunkAt(2) == fev[2], true)
+  TEST_EQUAL(fi.cacheChunk(3), true) // only 1 left
+  TEST_EQUAL(fi.activateCache(), true)
+  TEST_EQUAL(fi.chunkSize(), 1)
+  TEST_EQUAL(fi.getChunkOffset(), 3)
+  TEST_EQUAL(fi.chunkAt(0) == fev[3], true)
+  TEST_EQUAL(fi.cacheChunk(3), false)
+  TEST_EQUAL(fi.activateCache(), false)
+  FASTAFile::FASTAEntry pe;
+  TEST_EQUAL(fi.readAt(pe, 1), true)
+  TEST_EQUAL(pe == fev[1], true)
+  TEST_EXCEPTION(Exception::IndexOverflow, fi.readAt(pe, 4))
+  fi.reset();
+  TEST_EQUAL(fi.cacheChunk(10), true)
+  TEST_EQUAL(fi.activateCache(), true)
+  TEST_EQUAL(fi.chunkSize(), 4)
+END_SECTION
+
 START_SECTION(Result findDecoyString(FASTAContainer<T>& proteins))
 // test without decoys in input
   FASTAContainer<TFI_File> f1{OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta")};
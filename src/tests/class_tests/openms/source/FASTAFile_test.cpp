@@ -44,6 +44,7 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
 
+#include <fstream>
 #include <vector>
 
 ///////////////////////////
@@ -263,6 +264,46 @@ START_SECTION(test_white_spaces)
   TEST_EQUAL(data2[0].sequence == string("GDREQLLQRARLAEQAERYDDMASAMKAVTEL"), true);
 END_SECTION
 
+START_SECTION([EXTRA] load() is consistent with readNext())
+  // the chunked parser of load() must yield exactly what readNext() yields
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  {
+    ofstream os(tmp_filename.c_str(), ios::binary);
+    os << "# PEFF header\n";
+    for (int i = 0; i < 200000; ++i)
+    {
+      os << ">prot_" << i << (i % 3 == 0 ? "\r\n" : " some\tdescription\r\n") << "MKT AYIA\tKQR\r\n" << "QISFVKSHFSRQ\n";
+      if (i % 1000 == 0) os << ">odd_" << i << "\n>first_line_of_sequence\nAAA\n\n";
+    }
+  }
+  vector<FASTAFile::FASTAEntry> data, data_stream;
+  FASTAFile file;
+  file.load(tmp_filename, data);
+  FASTAFile::FASTAEntry entry;
+  file.readStart(tmp_filename);
+  while (file.readNext(entry)) data_stream.push_back(entry);
+  TEST_EQUAL(data.size(), 200200)
+  TEST_EQUAL(data == data_stream, true)
+  ABORT_IF(data.size() != 200200)
+  TEST_EQUAL(data[1].identifier, "odd_0")
+  TEST_EQUAL(data[1].sequence, ">first_line_of_sequenceAAA") // the line after a header is never a header
+  TEST_EQUAL(data[2].identifier, "prot_1")
+  TEST_EQUAL(data[2].description, "somedescription")
+  TEST_EQUAL(data[2].sequence, "MKTAYIAKQRQISFVKSHFSRQ")
+  TEST_EQUAL(data[4].identifier, "prot_3")
+  TEST_EQUAL(data[4].description, "")
+
+  // a broken record reports the number of entries read before it
+  String broken_filename;
+  NEW_TMP_FILE(broken_filename);
+  {
+    ofstream os(broken_filename.c_str(), ios::binary);
+    os << ">a\nAAA\n>b\nBBB\n> \nCCC\n";
+  }
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::ParseError, file.load(broken_filename, data), "Error while parsing FASTA file! Only 2 proteins could be read. Parsing next record failed. Please check the file! in: ")
+END_SECTION
+
 START_SECTION([EXTRA] test_position)
   // test if setPosition() works correctly
   String tmp_filename;
@@ -103,6 +103,36 @@ START_SECTION((bool getLoadSubordinates() const ))
 }
 END_SECTION
 
+START_SECTION((void setStoreConvexHull(bool convex)))
+{
+  FeatureFileOptions tmp;
+  tmp.setStoreConvexHull(false);
+  TEST_EQUAL(tmp.getStoreConvexHull(), false)
+}
+END_SECTION
+
+START_SECTION((bool getStoreConvexHull() const ))
+{
+  FeatureFileOptions tmp;
+  TEST_EQUAL(tmp.getStoreConvexHull(), true)
+}
+END_SECTION
+
+START_SECTION((void setStoreSubordinates(bool sub)))
+{
+  FeatureFileOptions tmp;
+  tmp.setStoreSubordinates(false);
+  TEST_EQUAL(tmp.getStoreSubordinates(), false)
+}
+END_SECTION
+
+START_SECTION((bool getStoreSubordinates() const ))
+{
+  FeatureFileOptions tmp;
+  TEST_EQUAL(tmp.getStoreSubordinates(), true)
+}
+END_SECTION
+
 START_SECTION((void setMetadataOnly(bool only)))
 {
   // TODO
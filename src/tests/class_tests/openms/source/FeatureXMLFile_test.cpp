@@ -241,6 +241,58 @@ START_SECTION((void store(const String &filename, const FeatureMap&feature_map))
   f.store(tmp_filename, map);
   WHITELIST("?xml-stylesheet")
   TEST_FILE_SIMILAR(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), tmp_filename)
+
+  // many features (written in parallel blocks) keep their order
+  FeatureMap large;
+  for (Size i = 0; i < 5000; ++i)
+  {
+    Feature feat;
+    feat.setRT(double(i));
+    feat.setMZ(500.0 + i * 0.001);
+    feat.setIntensity(1000.0f);
+    feat.setUniqueId(i + 1);
+    feat.setMetaValue("index", int(i));
+    large.push_back(feat);
+  }
+  NEW_TMP_FILE(tmp_filename);
+  f.store(tmp_filename, large);
+  FeatureMap large_loaded;
+  f.load(tmp_filename, large_loaded);
+  ABORT_IF(large_loaded.size() != large.size())
+  bool same_order = true;
+  for (Size i = 0; i < large.size(); ++i)
+  {
+    same_order &= (large_loaded[i].getUniqueId() == large[i].getUniqueId()) && (int(large_loaded[i].getMetaValue("index")) == int(i));
+  }
+  TEST_EQUAL(same_order, true)
+
+  // skip convex hulls and subordinates when storing
+  {
+    FeatureXMLFile fo;
+    FeatureMap e_full, e;
+    fo.load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.featureXML"), e_full);
+    fo.getOptions().setStoreConvexHull(false);
+    fo.getOptions().setStoreSubordinates(false);
+    NEW_TMP_FILE(tmp_filename);
+    fo.store(tmp_filename, e_full);
+    fo.getOptions() = FeatureFileOptions();
+    fo.load(tmp_filename, e);
+    for (Size ic = 0; ic < e_full.size(); ++ic)
+    {
+      e_full[ic].setConvexHulls(std::vector<ConvexHull2D>());
+      e_full[ic].setSubordinates(std::vector<Feature>());
+    }
+    e_full.updateRanges();
+    e.updateRanges();
+    TEST_EQUAL(e.size(), e_full.size())
+    ABORT_IF(e.size() != e_full.size())
+    bool stripped = true;
+    for (Size ic = 0; ic < e.size(); ++ic)
+    {
+      stripped &= e[ic].getConvexHulls().empty() && e[ic].getSubordinates().empty();
+    }
+    TEST_EQUAL(stripped, true)
+  }
 }
 END_SECTION
 
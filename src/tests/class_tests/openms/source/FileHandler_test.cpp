@@ -44,6 +44,8 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <fstream>
+
 START_TEST(FileHandler, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -126,6 +128,17 @@ START_SECTION((static FileTypes::Type getTypeByContent(const String &filename)))
   TEST_EQUAL(tmp.getTypeByContent(OPENMS_GET_TEST_DATA_PATH("FileHandler_MGFbyContent1.mgf")), FileTypes::MGF) // detect via 'FORMAT=Mascot generic\n'
   TEST_EQUAL(tmp.getTypeByContent(OPENMS_GET_TEST_DATA_PATH("FileHandler_MGFbyContent2.mgf")), FileTypes::MGF) // detect via 'BEGIN IONS\n'
 
+  // a file without line breaks is detected from a prefix (the rest is not read)
+  String one_line;
+  NEW_TMP_FILE(one_line)
+  {
+    std::ofstream out(one_line.c_str());
+    out << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?><mzML xmlns=\"http://psi.hupo.org/ms/mzml\">";
+    for (Size i = 0; i < 100000; ++i) out << "<cvParam cvRef=\"MS\" accession=\"MS:1000579\" name=\"MS1 spectrum\"/>";
+    out << "</mzML>";
+  }
+  TEST_EQUAL(tmp.getTypeByContent(one_line), FileTypes::MZML)
+
   TEST_EXCEPTION(Exception::FileNotFound, tmp.getTypeByContent("/bli/bla/bluff"))
 END_SECTION
 
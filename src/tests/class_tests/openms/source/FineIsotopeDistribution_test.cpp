@@ -461,6 +461,29 @@ START_SECTION(( void setAbsolute(bool absolute) ))
 }
 END_SECTION
 
+START_SECTION(( std::vector<IsotopeDistribution> run(const std::vector<EmpiricalFormula>& formulas) const ))
+{
+  std::vector<EmpiricalFormula> formulas = {EmpiricalFormula("C6H12O6"), EmpiricalFormula("C520H817N139O147S8"), EmpiricalFormula("C100H202")};
+  FineIsotopePatternGenerator gen(0.01, false, false);
+  std::vector<IsotopeDistribution> ids = gen.run(formulas);
+  TEST_EQUAL(ids.size(), 3)
+  TEST_EQUAL(ids[0].size(), 3)
+  TEST_EQUAL(ids[1].size(), 267)
+  for (Size i = 0; i < formulas.size(); ++i)
+  {
+    TEST_EQUAL(ids[i] == gen.run(formulas[i]), true)
+  }
+
+  gen.setTotalProbability(true);
+  ids = gen.run(formulas);
+  for (Size i = 0; i < formulas.size(); ++i)
+  {
+    TEST_EQUAL(ids[i] == gen.run(formulas[i]), true)
+  }
+  TEST_EQUAL(gen.run(std::vector<EmpiricalFormula>()).empty(), true)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -0,0 +1,158 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/FlatConsensusMap.h>
+///////////////////////////
+
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FlatConsensusMap, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ConsensusMap map;
+{
+  ConsensusFeature cf1;
+  cf1.insert(0, Peak2D({10.0, 500.0}, 100.0f), 1);
+  cf1.insert(1, Peak2D({11.0, 500.1}, 200.0f), 2);
+  map.push_back(cf1);
+  ConsensusFeature cf2;
+  map.push_back(cf2); // no handles
+  ConsensusFeature cf3;
+  cf3.insert(1, Peak2D({20.0, 600.0}, 300.0f), 3);
+  map.push_back(cf3);
+}
+
+FlatConsensusMap* ptr = nullptr;
+FlatConsensusMap* null_ptr = nullptr;
+START_SECTION(FlatConsensusMap())
+{
+  ptr = new FlatConsensusMap();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->numberOfElements(), 0)
+}
+END_SECTION
+
+START_SECTION(~FlatConsensusMap())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit FlatConsensusMap(const ConsensusMap& map))
+{
+  FlatConsensusMap flat(map);
+  TEST_EQUAL(flat.size(), 3)
+  TEST_EQUAL(flat.numberOfElements(), 3)
+  TEST_EQUAL(flat.elementsBegin(0), 0)
+  TEST_EQUAL(flat.elementsEnd(0), 2)
+  TEST_EQUAL(flat.elementsBegin(1), 2)
+  TEST_EQUAL(flat.elementsEnd(1), 2)
+  TEST_EQUAL(flat.elementsBegin(2), 2)
+  TEST_EQUAL(flat.elementsEnd(2), 3)
+  TEST_EQUAL(flat.getMapIndex(0), 0)
+  TEST_EQUAL(flat.getMapIndex(1), 1)
+  TEST_EQUAL(flat.getUniqueId(2), 3)
+  TEST_REAL_SIMILAR(flat.getIntensity(1), 200.0)
+  TEST_REAL_SIMILAR(flat.getRT(2), 20.0)
+  TEST_REAL_SIMILAR(flat.getMZ(1), 500.1)
+  TEST_EQUAL(flat.getMapIndices().size(), 3)
+  TEST_EQUAL(flat.getRTs().size(), 3)
+  TEST_EQUAL(flat.getMZs().size(), 3)
+}
+END_SECTION
+
+START_SECTION(void assign(const ConsensusMap& map))
+{
+  FlatConsensusMap flat(map);
+  flat.assign(ConsensusMap());
+  TEST_EQUAL(flat.empty(), true)
+  flat.assign(map);
+  TEST_EQUAL(flat.size(), 3)
+}
+END_SECTION
+
+START_SECTION(void setIntensity(Size element, FeatureHandle::IntensityType intensity))
+{
+  FlatConsensusMap flat(map);
+  flat.setIntensity(2, 5.0f);
+  TEST_REAL_SIMILAR(flat.getIntensity(2), 5.0)
+  flat.getIntensities()[0] = 7.0f;
+  TEST_REAL_SIMILAR(flat.getIntensity(0), 7.0)
+}
+END_SECTION
+
+START_SECTION(void applyIntensities(ConsensusMap& map) const)
+{
+  ConsensusMap copy = map;
+  FlatConsensusMap flat(copy);
+  for (auto& intensity : flat.getIntensities())
+  {
+    intensity *= 2;
+  }
+  flat.applyIntensities(copy);
+  TEST_REAL_SIMILAR(copy[0].getFeatures().begin()->getIntensity(), 200.0)
+  TEST_REAL_SIMILAR(copy[0].getFeatures().rbegin()->getIntensity(), 400.0)
+  TEST_REAL_SIMILAR(copy[2].getFeatures().begin()->getIntensity(), 600.0)
+
+  copy.resize(2);
+  TEST_EXCEPTION(Exception::IllegalArgument, flat.applyIntensities(copy))
+  copy = map;
+  copy[1].insert(0, Peak2D({1.0, 1.0}, 1.0f), 4);
+  TEST_EXCEPTION(Exception::IllegalArgument, flat.applyIntensities(copy))
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  FlatConsensusMap flat(map);
+  flat.clear();
+  TEST_EQUAL(flat.empty(), true)
+  TEST_EQUAL(flat.numberOfElements(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
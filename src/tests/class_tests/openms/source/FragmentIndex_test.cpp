@@ -0,0 +1,139 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FragmentIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FragmentIndex* ptr = nullptr;
+FragmentIndex* null_ptr = nullptr;
+START_SECTION(FragmentIndex())
+{
+  ptr = new FragmentIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->isBuilt(), true)
+}
+END_SECTION
+
+START_SECTION(~FragmentIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+FragmentIndex index;
+
+START_SECTION(Size addPeptide(double mass, const std::vector<double>& fragment_mzs))
+{
+  TEST_EQUAL(index.addPeptide(1000.0, {100.0, 200.0, 300.0, 400.0}), 0)
+  TEST_EQUAL(index.addPeptide(1500.0, {100.0, 200.0, 300.0, 400.0}), 1)
+  TEST_EQUAL(index.addPeptide(1000.5, {500.0, 200.0, 100.0}), 2)
+  TEST_EQUAL(index.size(), 3)
+  TEST_EQUAL(index.getNumberOfFragments(), 11)
+  TEST_EQUAL(index.isBuilt(), false)
+  TEST_REAL_SIMILAR(index.getPeptideMass(2), 1000.5)
+}
+END_SECTION
+
+START_SECTION(void query(const std::vector<double>& peak_mzs, double min_mass, double max_mass, double fragment_tolerance, bool fragment_tolerance_ppm, Size min_shared_fragments, Size max_hits, std::vector<Hit>& hits) const)
+{
+  std::vector<FragmentIndex::Hit> hits;
+  std::vector<double> peaks = {100.001, 200.0, 300.0, 400.0, 600.0};
+
+  // not built yet
+  TEST_EXCEPTION(Exception::Precondition, index.query(peaks, 999.0, 1001.0, 0.01, false, 1, 0, hits))
+
+  index.build();
+  TEST_EQUAL(index.isBuilt(), true)
+
+  // only the peptides within the precursor mass window are counted
+  index.query(peaks, 999.0, 1001.0, 0.01, false, 1, 0, hits);
+  TEST_EQUAL(hits.size(), 2)
+  TEST_EQUAL(hits[0].peptide_index, 0)
+  TEST_EQUAL(hits[0].shared_fragments, 4)
+  TEST_EQUAL(hits[1].peptide_index, 2)
+  TEST_EQUAL(hits[1].shared_fragments, 2)
+
+  // minimum number of shared fragments
+  index.query(peaks, 999.0, 1001.0, 0.01, false, 3, 0, hits);
+  TEST_EQUAL(hits.size(), 1)
+  TEST_EQUAL(hits[0].peptide_index, 0)
+
+  // tolerance in ppm (100.001 is 10 ppm off)
+  index.query(peaks, 999.0, 1001.0, 5.0, true, 1, 0, hits);
+  TEST_EQUAL(hits.size(), 2)
+  TEST_EQUAL(hits[0].shared_fragments, 3)
+  TEST_EQUAL(hits[1].shared_fragments, 1)
+
+  // wide window, ties are sorted by peptide index
+  index.query(peaks, 500.0, 2000.0, 0.01, false, 1, 2, hits);
+  TEST_EQUAL(hits.size(), 2)
+  TEST_EQUAL(hits[0].peptide_index, 0)
+  TEST_EQUAL(hits[1].peptide_index, 1)
+
+  // a fragment matched by several peaks is counted once
+  index.query({99.995, 100.0, 100.005}, 999.0, 1001.0, 0.01, false, 1, 0, hits);
+  TEST_EQUAL(hits.size(), 2)
+  TEST_EQUAL(hits[0].shared_fragments, 1)
+  TEST_EQUAL(hits[1].shared_fragments, 1)
+
+  // empty window
+  index.query(peaks, 1100.0, 1200.0, 0.01, false, 1, 0, hits);
+  TEST_EQUAL(hits.size(), 0)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  index.clear();
+  TEST_EQUAL(index.size(), 0)
+  TEST_EQUAL(index.getNumberOfFragments(), 0)
+  TEST_EQUAL(index.isBuilt(), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -98,6 +98,53 @@ START_SECTION((template <typename ConstIterT, typename IterT> bool filter(ConstI
   TEST_REAL_SIMILAR(*it,1.0)
 END_SECTION 
 
+START_SECTION((template <typename ConstIterT> static bool isUniformlySpaced(ConstIterT first, ConstIterT last, double& data_spacing)))
+{
+  std::vector<double> mz;
+  for (Size i = 0; i < 100; ++i)
+  {
+    mz.push_back(500.0 + 0.05 * i);
+  }
+  double spacing = 0;
+  TEST_EQUAL(GaussFilterAlgorithm::isUniformlySpaced(mz.begin(), mz.end(), spacing), true)
+  TEST_REAL_SIMILAR(spacing, 0.05)
+  TEST_EQUAL(GaussFilterAlgorithm::isUniformlySpaced(mz.begin(), mz.begin() + 2, spacing), false)
+
+  // a single shifted data point makes the data non-uniform
+  mz[40] += 0.01;
+  TEST_EQUAL(GaussFilterAlgorithm::isUniformlySpaced(mz.begin(), mz.end(), spacing), false)
+}
+END_SECTION
+
+START_SECTION([EXTRA] filter on uniform data matches the general algorithm)
+{
+  // uniform data use the tabulated kernel; a tiny shift of the last data point forces the general algorithm
+  std::vector<double> mz, intensities;
+  for (Size i = 0; i < 200; ++i)
+  {
+    mz.push_back(500.0 + 0.05 * i);
+    intensities.push_back(1000.0 * std::exp(-std::pow((double(i) - 100.0) * 0.05, 2) / 0.5) + double(i % 7));
+  }
+  std::vector<double> mz_shifted = mz;
+  mz_shifted.back() += 1e-6;
+  double spacing;
+  TEST_EQUAL(GaussFilterAlgorithm::isUniformlySpaced(mz.begin(), mz.end(), spacing), true)
+  TEST_EQUAL(GaussFilterAlgorithm::isUniformlySpaced(mz_shifted.begin(), mz_shifted.end(), spacing), false)
+
+  GaussFilterAlgorithm gauss;
+  gauss.initialize(1.0 /* gaussian_width */, 0.01 /* spacing */, 10.0 /* ppm_tolerance */, false /* use_ppm_tolerance */);
+  std::vector<double> mz_out(200), int_out(200), mz_out_general(200), int_out_general(200);
+  gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), int_out.begin());
+  gauss.filter(mz_shifted.begin(), mz_shifted.end(), intensities.begin(), mz_out_general.begin(), int_out_general.begin());
+  TOLERANCE_RELATIVE(1.0001)
+  for (Size i = 0; i < 190; ++i)
+  {
+    TEST_REAL_SIMILAR(mz_out[i], mz[i])
+    TEST_REAL_SIMILAR(int_out[i], int_out_general[i])
+  }
+}
+END_SECTION
+
 START_SECTION((bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)))
 
   OpenMS::Interfaces::SpectrumPtr spectrum(new OpenMS::Interfaces::Spectrum);
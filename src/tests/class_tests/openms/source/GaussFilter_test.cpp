@@ -190,6 +190,33 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
   TEST_REAL_SIMILAR(exp[2][0].getIntensity(),0.0)
 
+  // many spectra with ppm tolerance (filtered in parallel): same result as filtering one by one
+  PeakMap exp_ppm;
+  exp_ppm.resize(50);
+  for (Size s = 0; s < exp_ppm.size(); ++s)
+  {
+    for (Size i = 0; i < 30; ++i)
+    {
+      exp_ppm[s].push_back(Peak1D(500.0 + 0.001 * i * i, (i + s) % 7 + 1.0));
+    }
+  }
+  param.setValue("use_ppm_tolerance", "true");
+  param.setValue("ppm_tolerance", 50.0);
+  gauss.setParameters(param);
+  MSSpectrum single = exp_ppm[17];
+  const GaussFilter& const_gauss = gauss;
+  const_gauss.filter(single);
+  gauss.filterExperiment(exp_ppm);
+  ABORT_IF(exp_ppm[17].size() != single.size())
+  for (Size i = 0; i < single.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(exp_ppm[17][i].getIntensity(), single[i].getIntensity())
+  }
+
+  // ppm tolerance cannot be used with chromatograms
+  exp_ppm.getChromatograms().resize(3);
+  TEST_EXCEPTION(Exception::IllegalArgument, gauss.filterExperiment(exp_ppm))
+
 
   // We don't throw exceptions anymore... just issue warnings 
   //test exception for too low gaussian width
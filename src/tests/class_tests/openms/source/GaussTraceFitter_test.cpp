@@ -315,6 +315,28 @@ START_SECTION((void fit(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& t
   weighted_fitter.fit(mts);
   TEST_REAL_SIMILAR(weighted_fitter.getCenter(), expected_x0)
     TEST_REAL_SIMILAR(weighted_fitter.getHeight(), 6.0847)
+
+  // fitting a batch gives the same models as fitting one by one
+  std::vector<FeatureFinderAlgorithmPickedHelperStructs::MassTraces> batch(5, mts);
+  batch[2][0].theoretical_int = 0.8;
+  batch[2][1].theoretical_int = 0.2;
+  std::vector<double> centers(batch.size()), heights(batch.size());
+  std::vector<int> fitted(batch.size(), 0);
+  TraceFitter::fitBatch(weighted_fitter, batch, [&](Size i, const GaussTraceFitter& fitter, bool success)
+  {
+    centers[i] = fitter.getCenter();
+    heights[i] = fitter.getHeight();
+    fitted[i] = success ? 1 : 0;
+  });
+  for (Size i = 0; i < batch.size(); ++i)
+  {
+    GaussTraceFitter single = weighted_fitter;
+    single.fit(batch[i]);
+    TEST_EQUAL(fitted[i], 1)
+    TEST_REAL_SIMILAR(centers[i], single.getCenter())
+    TEST_REAL_SIMILAR(heights[i], single.getHeight())
+  }
+  TEST_REAL_SIMILAR(heights[0], 6.0847)
 }
 END_SECTION
 
@@ -267,6 +267,37 @@ START_SECTION((BinSizeType rightBorderOfBin(Size bin_index) const))
 	TEST_EXCEPTION(Exception::IndexOverflow, dist.rightBorderOfBin(5))
 END_SECTION
 
+START_SECTION((template <typename DataIterator> static void getCumulativeHistogram(DataIterator begin, DataIterator end, bool complement, bool inclusive, Histogram<ValueType, BinSizeType>& histogram)))
+	std::vector<float> values = {0.5f, 1.5f, 1.7f, 3.2f, 5.0f};
+	for (bool complement : {true, false})
+	{
+		for (bool inclusive : {true, false})
+		{
+			// compare to incrementing every value separately
+			Histogram<float, float> expected(0, 5, 1);
+			for (float v : values)
+			{
+				if (complement) expected.incUntil(v, inclusive);
+				else expected.incFrom(v, inclusive);
+			}
+			Histogram<float, float> cumulative(0, 5, 1);
+			Histogram<float, float>::getCumulativeHistogram(values.begin(), values.end(), complement, inclusive, cumulative);
+			TEST_EQUAL(cumulative == expected, true)
+		}
+	}
+
+	Histogram<float, float> complement(0, 5, 1);
+	Histogram<float, float>::getCumulativeHistogram(values.begin(), values.end(), true, true, complement);
+	TEST_REAL_SIMILAR(complement[0], 5)
+	TEST_REAL_SIMILAR(complement[1], 4)
+	TEST_REAL_SIMILAR(complement[2], 2)
+	TEST_REAL_SIMILAR(complement[3], 2)
+	TEST_REAL_SIMILAR(complement[4], 1)
+
+	std::vector<float> out_of_range = {6.0f};
+	TEST_EXCEPTION(Exception::OutOfRange, Histogram<float, float>::getCumulativeHistogram(out_of_range.begin(), out_of_range.end(), true, true, complement))
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
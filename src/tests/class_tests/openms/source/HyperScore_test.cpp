@@ -117,6 +117,47 @@ START_SECTION((static double compute(double fragment_mass_tolerance, bool fragme
 }
 END_SECTION
 
+START_SECTION((static void computeBatch(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum &exp_spectrum, const std::vector< std::vector< TheoreticalSpectrumGenerator::FragmentIon > > &theo_ions, std::vector< double > &scores, std::vector< PSMDetail > &details)))
+{
+  PeakSpectrum exp_spectrum;
+  tsg.getSpectrum(exp_spectrum, AASequence::fromString("PEPTIDE"), 1, 1);
+
+  std::vector<std::vector<TheoreticalSpectrumGenerator::FragmentIon> > ions(3);
+  TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(ions[0], AASequence::fromString("PEPTIDE"));
+  TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(ions[1], AASequence::fromString("YYYYYY"));
+  TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(ions[2], AASequence::fromString("PEPTIDES"));
+
+  std::vector<double> scores;
+  std::vector<HyperScore::PSMDetail> details;
+  HyperScore::computeBatch(0.1, false, exp_spectrum, ions, scores, details);
+  TEST_EQUAL(scores.size(), 3)
+  TEST_EQUAL(details.size(), 3)
+  TEST_REAL_SIMILAR(scores[0], 13.8516496);
+  TEST_EQUAL(details[0].matched_b_ions, 5)
+  TEST_EQUAL(details[0].matched_y_ions, 6)
+  TEST_REAL_SIMILAR(scores[1], 0.0);
+  TEST_EQUAL(details[1].matched_b_ions + details[1].matched_y_ions, 0)
+
+  // identical to the single candidate score on an annotated theoretical spectrum
+  PeakSpectrum theo_spectrum;
+  tsg.getSpectrum(theo_spectrum, AASequence::fromString("PEPTIDES"), 1, 1);
+  HyperScore::PSMDetail d;
+  TEST_EQUAL(scores[2], HyperScore::computeWithDetail(0.1, false, exp_spectrum, theo_spectrum, d))
+  TEST_EQUAL(details[2].matched_b_ions, d.matched_b_ions)
+  TEST_EQUAL(details[2].matched_y_ions, d.matched_y_ions)
+  TEST_EQUAL(details[2].mean_error, d.mean_error)
+
+  HyperScore::computeBatch(10, true, exp_spectrum, ions, scores, details);
+  TEST_EQUAL(scores[2], HyperScore::computeWithDetail(10, true, exp_spectrum, theo_spectrum, d))
+  TEST_EQUAL(details[2].mean_error, d.mean_error)
+
+  // empty experimental spectrum
+  HyperScore::computeBatch(0.1, false, PeakSpectrum(), ions, scores, details);
+  TEST_EQUAL(scores.size(), 3)
+  TEST_REAL_SIMILAR(scores[0], 0.0);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -123,6 +123,29 @@ START_SECTION((template <class Container, class Predicate> static void keepMatch
 }
 END_SECTION
 
+START_SECTION((template <class IDContainer, class... Predicates> static void keepHitsMatchingAll(IDContainer& items, const Predicates&... preds)))
+{
+  vector<PeptideIdentification> peptides = global_peptides;
+  vector<PeptideHit>& peptide_hits = peptides[0].getHits();
+  TEST_EQUAL(peptide_hits.size(), 11);
+
+  // same result as applying the filters one after the other:
+  vector<PeptideIdentification> expected = global_peptides;
+  IDFilter::HasGoodScore<PeptideHit> score_filter(33, true);
+  IDFilter::HasMaxRank<PeptideHit> rank_filter(3);
+  IDFilter::keepMatchingItems(expected[0].getHits(), score_filter);
+  IDFilter::keepMatchingItems(expected[0].getHits(), rank_filter);
+
+  IDFilter::keepHitsMatchingAll(peptides, score_filter, rank_filter);
+  TEST_EQUAL(peptide_hits.size(), expected[0].getHits().size());
+  TEST_EQUAL(peptide_hits.size() < 5, true);
+  for (Size i = 0; i < peptide_hits.size(); ++i)
+  {
+    TEST_EQUAL(peptide_hits[i].getSequence(), expected[0].getHits()[i].getSequence());
+  }
+}
+END_SECTION
+
 START_SECTION((template <class IdentificationType> static Size countHits(const vector<IdentificationType>& ids)))
 {
   vector<PeptideIdentification> peptides(4);
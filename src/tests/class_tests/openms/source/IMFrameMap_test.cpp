@@ -0,0 +1,178 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/IONMOBILITY/IMFrameMap.h>
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(IMFrameMap, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+IMFrameMap* e_ptr = nullptr;
+IMFrameMap* e_nullPointer = nullptr;
+
+START_SECTION((IMFrameMap()))
+  e_ptr = new IMFrameMap;
+  TEST_NOT_EQUAL(e_ptr, e_nullPointer)
+  TEST_EQUAL(e_ptr->empty(), true)
+  TEST_EQUAL(e_ptr->getNrOfPeaks(), 0)
+  TEST_EQUAL(e_ptr->getNrOfScans(), 0)
+END_SECTION
+
+START_SECTION((~IMFrameMap()))
+  delete e_ptr;
+END_SECTION
+
+MSSpectrum frame;
+frame.push_back({1.0, 29.0f});
+frame.push_back({2.0, 60.0f});
+frame.push_back({3.0, 34.0f});
+frame.push_back({4.0, 29.0f});
+frame.push_back({5.0, 37.0f});
+frame.push_back({6.0, 31.0f});
+frame.setRT(1);
+MSSpectrum::FloatDataArray& afa = frame.getFloatDataArrays().emplace_back();
+afa.assign({1.1, 2.2, 3.3, 3.3, 5.5, 6.6});
+IMDataConverter::setIMUnit(afa, DriftTimeUnit::MILLISECOND);
+
+// same frame, but not sorted by IM
+MSSpectrum frame_unsorted = frame;
+frame_unsorted.setRT(3);
+frame_unsorted.getFloatDataArrays()[0].assign({6.6, 3.3, 1.1, 3.3, 2.2, 5.5});
+
+MSSpectrum spec;
+spec.push_back({111.0, -1.0f});
+spec.push_back({222.0, -2.0f});
+spec.setRT(2); // just a spectrum with RT = 2
+
+START_SECTION((void addFrame(const MSSpectrum& im_frame)))
+  IMFrameMap fm;
+  TEST_EXCEPTION(Exception::MissingInformation, fm.addFrame(spec))
+  fm.addFrame(frame);
+  TEST_EQUAL(fm.size(), 1)
+  TEST_EQUAL(fm.getNrOfPeaks(), 6)
+  TEST_EQUAL(fm.getNrOfScans(), 5)
+  TEST_EQUAL(fm.getNrOfScans(0), 5)
+  TEST_EQUAL(fm.getFrameMetaData(0).getRT(), 1)
+  TEST_EQUAL(fm.getFrameMetaData(0).empty(), true)
+  TEST_EQUAL(fm.getDriftTimeUnit(0) == DriftTimeUnit::MILLISECOND, true)
+
+  fm.addFrame(MSSpectrum()); // empty frame
+  TEST_EQUAL(fm.size(), 2)
+  TEST_EQUAL(fm.getNrOfScans(1), 0)
+END_SECTION
+
+START_SECTION((MobilityScanView getScan(Size frame_index, Size scan_index) const))
+  IMFrameMap fm;
+  fm.addFrame(frame);
+  fm.addFrame(frame_unsorted);
+
+  auto v = fm.getScan(0, 2);
+  TEST_EQUAL(v.size, 2)
+  TEST_REAL_SIMILAR(v.drift_time, 3.3)
+  TEST_EQUAL(v.mz[0], 3.0)
+  TEST_EQUAL(v.mz[1], 4.0)
+  TEST_EQUAL(v.intensity[1], 29.0f)
+
+  // second frame: sorted by IM, stable for identical IM values
+  TEST_EQUAL(fm.getNrOfScans(1), 5)
+  v = fm.getScan(1, 0);
+  TEST_EQUAL(v.size, 1)
+  TEST_EQUAL(v.mz[0], 3.0)
+  v = fm.getScan(1, 2);
+  TEST_EQUAL(v.size, 2)
+  TEST_EQUAL(v.mz[0], 2.0)
+  TEST_EQUAL(v.mz[1], 4.0)
+  v = fm.getScan(1, 4);
+  TEST_EQUAL(v.mz[0], 1.0)
+
+  TEST_EXCEPTION(Exception::IndexOverflow, fm.getScan(0, 5))
+END_SECTION
+
+START_SECTION((MSSpectrum toSpectrum(Size frame_index, Size scan_index) const))
+  IMFrameMap fm;
+  fm.addFrame(frame_unsorted);
+  MSExperiment split = IMDataConverter::splitByIonMobility(frame_unsorted);
+  TEST_EQUAL(fm.getNrOfScans(0), split.size())
+  for (Size i = 0; i < split.size(); ++i)
+  {
+    MSSpectrum s = fm.toSpectrum(0, i);
+    TEST_EQUAL(s.size(), split[i].size())
+    TEST_EQUAL(s.getRT(), split[i].getRT())
+    TEST_EQUAL(s.getDriftTime(), split[i].getDriftTime())
+    TEST_EQUAL(s.getDriftTimeUnit() == split[i].getDriftTimeUnit(), true)
+    for (Size p = 0; p < s.size(); ++p)
+    {
+      TEST_EQUAL(s[p], split[i][p])
+    }
+  }
+END_SECTION
+
+START_SECTION((MSSpectrum toFrameSpectrum(Size frame_index) const))
+  IMFrameMap fm;
+  fm.addFrame(frame);
+  TEST_EQUAL(fm.toFrameSpectrum(0) == frame, true)
+END_SECTION
+
+START_SECTION((explicit IMFrameMap(const MSExperiment& exp)))
+  MSExperiment exp;
+  exp.addSpectrum(frame);
+  exp.addSpectrum(spec); // ignored
+  exp.addSpectrum(frame_unsorted);
+  IMFrameMap fm(exp);
+  TEST_EQUAL(fm.size(), 2)
+  TEST_EQUAL(fm.getNrOfPeaks(), 12)
+  TEST_EQUAL(fm.getNrOfScans(), 10)
+  TEST_EQUAL(fm.getFrameMetaData(1).getRT(), 3)
+
+  fm.clear();
+  TEST_EQUAL(fm.empty(), true)
+  TEST_EQUAL(fm.getNrOfPeaks(), 0)
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -42,6 +42,26 @@
 
 ///////////////////////////
 
+/// consumer collecting everything it receives
+struct CollectingConsumer : public OpenMS::Interfaces::IIdentificationConsumer
+{
+  std::vector<OpenMS::ProteinIdentification> proteins;
+  std::vector<OpenMS::PeptideIdentification> peptides;
+  std::vector<int> order; // 0: protein, 1: peptide
+
+  void consumeProteinIdentification(OpenMS::ProteinIdentification& protein_id) override
+  {
+    proteins.push_back(std::move(protein_id)); // moving is allowed
+    order.push_back(0);
+  }
+
+  void consumePeptideIdentification(OpenMS::PeptideIdentification& peptide_id) override
+  {
+    peptides.push_back(std::move(peptide_id));
+    order.push_back(1);
+  }
+};
+
 START_TEST(IdXMLFile, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -204,6 +224,45 @@ START_SECTION(void load(const String& filename, std::vector<ProteinIdentificatio
   TEST_EQUAL(pes4[0].getAAAfter(), PeptideEvidence::UNKNOWN_AA)
 END_SECTION
 
+START_SECTION(void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, String& document_id))
+{
+  for (const String& file : {String(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML")), String(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_no_proteinhits.idXML"))})
+  {
+    std::vector<ProteinIdentification> protein_ids;
+    std::vector<PeptideIdentification> peptide_ids;
+    String document_id, streamed_document_id;
+    IdXMLFile().load(file, protein_ids, peptide_ids, document_id);
+
+    CollectingConsumer consumer;
+    IdXMLFile f;
+    f.transform(file, &consumer, streamed_document_id);
+    TEST_EQUAL(streamed_document_id, document_id)
+    TEST_EQUAL(consumer.proteins.size(), protein_ids.size())
+    TEST_EQUAL(consumer.peptides.size(), peptide_ids.size())
+    TEST_EQUAL(consumer.proteins == protein_ids, true)
+    TEST_EQUAL(consumer.peptides == peptide_ids, true)
+    // a run is handed out before its peptide identifications
+    ABORT_IF(consumer.order.empty())
+    TEST_EQUAL(consumer.order[0], 0)
+
+    // the same instance can be used for loading afterwards
+    std::vector<ProteinIdentification> protein_ids2;
+    std::vector<PeptideIdentification> peptide_ids2;
+    f.load(file, protein_ids2, peptide_ids2);
+    TEST_EQUAL(peptide_ids2 == peptide_ids, true)
+  }
+}
+END_SECTION
+
+START_SECTION(void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer))
+{
+  CollectingConsumer consumer;
+  TEST_EXCEPTION(Exception::FileNotFound, IdXMLFile().transform("IdXMLFile_test_this_file_does_not_exist", &consumer))
+  IdXMLFile().transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer);
+  TEST_EQUAL(consumer.peptides.empty(), false)
+}
+END_SECTION
+
 START_SECTION(void store(String filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id="") )
 
   // load, store, and reload data
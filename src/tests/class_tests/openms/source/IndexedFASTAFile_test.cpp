@@ -0,0 +1,200 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/IndexedFASTAFile.h>
+///////////////////////////
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IndexedFASTAFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+IndexedFASTAFile* ptr = nullptr;
+IndexedFASTAFile* null_ptr = nullptr;
+START_SECTION(IndexedFASTAFile())
+{
+  ptr = new IndexedFASTAFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->isOpen(), false)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~IndexedFASTAFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+std::vector<FASTAFile::FASTAEntry> entries = { {"P1", "first protein", "PEPTIDEK"}, {"DECOY_P1", "", "KEDITPEP"}, {"P2", "third", ""} };
+
+START_SECTION(static void store(const String& filename, const std::vector<FASTAFile::FASTAEntry>& entries, const String& decoy_string = "", bool decoy_is_prefix = true))
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries, "DECOY_", true);
+  IndexedFASTAFile db(tmp_file);
+  TEST_EQUAL(db.size(), 3)
+  TEST_EQUAL(db.isDecoy(0), false)
+  TEST_EQUAL(db.isDecoy(1), true)
+  TEST_EQUAL(db.isDecoy(2), false)
+
+  // suffix and no decoy string
+  IndexedFASTAFile::store(tmp_file, entries, "_P1", false);
+  db.load(tmp_file);
+  TEST_EQUAL(db.isDecoy(0), false)
+  TEST_EQUAL(db.isDecoy(1), true)
+  IndexedFASTAFile::store(tmp_file, entries);
+  db.load(tmp_file);
+  TEST_EQUAL(db.isDecoy(1), false)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, IndexedFASTAFile::store("/this/path/does/not/exist/db.bin", entries))
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename))
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries, "DECOY_");
+  IndexedFASTAFile db;
+  db.load(tmp_file);
+  TEST_EQUAL(db.isOpen(), true)
+  TEST_EQUAL(db.size(), 3)
+
+  // empty database
+  IndexedFASTAFile::store(tmp_file, std::vector<FASTAFile::FASTAEntry>());
+  db.load(tmp_file);
+  TEST_EQUAL(db.isOpen(), true)
+  TEST_EQUAL(db.size(), 0)
+
+  TEST_EXCEPTION(Exception::FileNotFound, db.load("IndexedFASTAFile_test_this_file_does_not_exist"))
+  TEST_EQUAL(db.isOpen(), false)
+
+  // a FASTA file is not a binary database
+  TEST_EXCEPTION(Exception::ParseError, db.load(OPENMS_GET_TEST_DATA_PATH("FASTAFile_test.fasta")))
+
+  // truncated database
+  IndexedFASTAFile::store(tmp_file, entries);
+  String truncated_file;
+  NEW_TMP_FILE(truncated_file)
+  {
+    ifstream is(tmp_file.c_str(), ios::binary);
+    string content((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+    ofstream os(truncated_file.c_str(), ios::binary);
+    os.write(content.data(), content.size() - 1);
+  }
+  TEST_EXCEPTION(Exception::ParseError, db.load(truncated_file))
+}
+END_SECTION
+
+START_SECTION(std::string_view getIdentifier(Size index) const)
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries);
+  IndexedFASTAFile db(tmp_file);
+  TEST_EQUAL(String(db.getIdentifier(0)), "P1")
+  TEST_EQUAL(String(db.getIdentifier(1)), "DECOY_P1")
+  TEST_EQUAL(String(db.getIdentifier(2)), "P2")
+}
+END_SECTION
+
+START_SECTION(std::string_view getDescription(Size index) const)
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries);
+  IndexedFASTAFile db(tmp_file);
+  TEST_EQUAL(String(db.getDescription(0)), "first protein")
+  TEST_EQUAL(db.getDescription(1).empty(), true)
+  TEST_EQUAL(String(db.getDescription(2)), "third")
+}
+END_SECTION
+
+START_SECTION(std::string_view getSequence(Size index) const)
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries);
+  IndexedFASTAFile db(tmp_file);
+  // copies share the mapping
+  IndexedFASTAFile copy(db);
+  db = IndexedFASTAFile();
+  TEST_EQUAL(String(copy.getSequence(0)), "PEPTIDEK")
+  TEST_EQUAL(String(copy.getSequence(1)), "KEDITPEP")
+  TEST_EQUAL(copy.getSequence(2).empty(), true)
+}
+END_SECTION
+
+START_SECTION(void getEntry(Size index, FASTAFile::FASTAEntry& entry) const)
+{
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  IndexedFASTAFile::store(tmp_file, entries);
+  IndexedFASTAFile db(tmp_file);
+  FASTAFile::FASTAEntry entry;
+  for (Size i = 0; i < entries.size(); ++i)
+  {
+    db.getEntry(i, entry);
+    TEST_EQUAL(entry == entries[i], true)
+  }
+  TEST_EXCEPTION(Exception::IndexOverflow, db.getEntry(3, entry))
+}
+END_SECTION
+
+START_SECTION(bool isOpen() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(Size size() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(bool isDecoy(Size index) const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -121,6 +121,45 @@ START_SECTION(bool load(const String& filename, OnDiscPeakMap& exp))
 }
 END_SECTION
 
+START_SECTION(bool load(const String& filename, PeakMap& exp))
+{
+  IndexedMzMLFileLoader file;
+  PeakMap exp, exp2;
+  TEST_EQUAL(file.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp), true)
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp2);
+
+  TEST_EQUAL(exp.getSpectra().size(), 2)
+  TEST_EQUAL(exp.getChromatograms().size(), 1)
+  for (Size i = 0; i < exp.getSpectra().size(); i++)
+  {
+    TEST_EQUAL(exp.getSpectra()[i] == exp2.getSpectra()[i], true)
+  }
+  for (Size i = 0; i < exp.getChromatograms().size(); i++)
+  {
+    TEST_EQUAL(exp.getChromatograms()[i] == exp2.getChromatograms()[i], true)
+  }
+  TEST_EQUAL((OpenMS::ExperimentalSettings)exp == (OpenMS::ExperimentalSettings)exp2, true)
+
+  // filtered meta data is matched to the index by native id
+  PeakMap exp_ms2, exp2_ms2;
+  file.getOptions().addMSLevel(2);
+  file.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp_ms2);
+  MzMLFile f;
+  f.getOptions().addMSLevel(2);
+  f.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), exp2_ms2);
+  TEST_EQUAL(exp_ms2.getSpectra().size(), exp2_ms2.getSpectra().size())
+  for (Size i = 0; i < exp_ms2.getSpectra().size(); i++)
+  {
+    TEST_EQUAL(exp_ms2.getSpectra()[i] == exp2_ms2.getSpectra()[i], true)
+  }
+
+  // not an indexed file
+  IndexedMzMLFileLoader file2;
+  PeakMap exp3;
+  TEST_EQUAL(file2.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp3), false)
+}
+END_SECTION
+
 START_SECTION([EXTRA]CheckParsing)
 {
   // Check return value of load
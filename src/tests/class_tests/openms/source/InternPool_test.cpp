@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/InternPool.h>
+///////////////////////////
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(InternPool, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+InternPool<String>* ptr = nullptr;
+InternPool<String>* null_ptr = nullptr;
+START_SECTION(InternPool())
+{
+  ptr = new InternPool<String>();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 1) // the default value
+}
+END_SECTION
+
+START_SECTION(~InternPool())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(Handle intern(T value))
+{
+  InternPool<String> pool;
+  InternPool<String>::Handle a = pool.intern("P12345");
+  InternPool<String>::Handle b = pool.intern(String("P12345"));
+  InternPool<String>::Handle c = pool.intern("Q99999");
+  TEST_EQUAL(*a, "P12345")
+  TEST_EQUAL(*c, "Q99999")
+  TEST_EQUAL(a.get() == b.get(), true)
+  TEST_EQUAL(a == b, true)
+  TEST_EQUAL(a != c, true)
+  TEST_EQUAL(pool.size(), 3)
+
+  // values are removed once the last handle is gone
+  {
+    InternPool<String>::Handle d = pool.intern("temporary");
+    TEST_EQUAL(pool.size(), 4)
+  }
+  TEST_EQUAL(pool.size(), 3)
+  InternPool<String>::Handle e = pool.intern("temporary");
+  TEST_EQUAL(*e, "temporary")
+  TEST_EQUAL(pool.size(), 4)
+}
+END_SECTION
+
+START_SECTION(const Handle& defaultValue() const)
+{
+  InternPool<String> pool;
+  TEST_EQUAL(*pool.defaultValue(), "")
+  TEST_EQUAL(pool.intern("") == pool.defaultValue(), true)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  InternPool<String> pool;
+  std::vector<InternPool<String>::Handle> handles;
+  for (Size i = 0; i < 100; ++i)
+  {
+    handles.push_back(pool.intern(String(i % 10)));
+  }
+  TEST_EQUAL(pool.size(), 11)
+  handles.clear();
+  TEST_EQUAL(pool.size(), 1)
+}
+END_SECTION
+
+START_SECTION([EXTRA] Handle move)
+{
+  InternPool<String> pool;
+  InternPool<String>::Handle a = pool.intern("P12345");
+  InternPool<String>::Handle b(std::move(a));
+  // moved-from handles stay valid
+  TEST_EQUAL(*a, "P12345")
+  TEST_EQUAL(*b, "P12345")
+  InternPool<String>::Handle c = pool.defaultValue();
+  c = std::move(b);
+  TEST_EQUAL(*c, "P12345")
+  TEST_EQUAL(*b, "P12345")
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
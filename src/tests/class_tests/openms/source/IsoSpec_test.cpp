@@ -37,6 +37,7 @@
 
 ///////////////////////////
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsoSpecWrapper.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/FineIsotopePatternGenerator.h>
 ///////////////////////////
 
 #include <OpenMS/CHEMISTRY/Element.h>
@@ -522,6 +523,38 @@ START_SECTION(( void IsoSpecTotalProbWrapper::run() ))
 END_SECTION
 
 
+START_SECTION(( IsotopeDistribution IsoSpecBatchGenerator::run(const EmpiricalFormula& formula) ))
+{
+  IsoSpecBatchGenerator total_prob(0.01, true);
+  IsoSpecBatchGenerator threshold(0.01, false, false);
+  for (const String& f : {"C6H12O6", "C100H202", "C520H817N139O147S8"})
+  {
+    EmpiricalFormula ef(f);
+    TEST_EQUAL(total_prob.run(ef) == FineIsotopePatternGenerator(0.01, true).run(ef), true)
+    TEST_EQUAL(threshold.run(ef) == FineIsotopePatternGenerator(0.01, false, false).run(ef), true)
+  }
+}
+END_SECTION
+
+START_SECTION(( std::vector<IsotopeDistribution> IsoSpecBatchGenerator::run(const std::vector<EmpiricalFormula>& formulas) ))
+{
+  std::vector<EmpiricalFormula> formulas;
+  for (Size i = 1; i < 50; ++i)
+  {
+    formulas.push_back(EmpiricalFormula("C" + String(i) + "H" + String(2 * i + 2) + "O" + String(i % 5) + "N" + String(i % 3)));
+  }
+  IsoSpecBatchGenerator gen(1e-3, false, true);
+  std::vector<IsotopeDistribution> result = gen.run(formulas);
+  TEST_EQUAL(result.size(), formulas.size())
+  Size errors = 0;
+  for (Size i = 0; i < formulas.size(); ++i)
+  {
+    if (!(result[i] == FineIsotopePatternGenerator(1e-3, false, true).run(formulas[i]))) ++errors;
+  }
+  TEST_EQUAL(errors, 0)
+}
+END_SECTION
+
 
 #if 0
 START_SECTION(( [STRESSTEST] void run(const std::string&) ))
@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternCache.h>
+///////////////////////////
+
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IsotopePatternCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+IsotopePatternCache* ptr = nullptr;
+IsotopePatternCache* null_ptr = nullptr;
+START_SECTION(explicit IsotopePatternCache(Size capacity = 10000))
+{
+  ptr = new IsotopePatternCache();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->getCapacity(), 10000)
+}
+END_SECTION
+
+START_SECTION(~IsotopePatternCache())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(static IsotopePatternCache* getInstance())
+{
+  TEST_NOT_EQUAL(IsotopePatternCache::getInstance(), null_ptr)
+  TEST_EQUAL(IsotopePatternCache::getInstance(), IsotopePatternCache::getInstance())
+}
+END_SECTION
+
+START_SECTION(IsotopeDistribution run(const EmpiricalFormula& formula, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache(2);
+  EmpiricalFormula ef("C100H202O2");
+  TEST_EQUAL(cache.run(ef, 5) == CoarseIsotopePatternGenerator(5).run(ef), true)
+  TEST_EQUAL(cache.run(ef, 5) == CoarseIsotopePatternGenerator(5).run(ef), true)
+  TEST_EQUAL(cache.getHits(), 1)
+  TEST_EQUAL(cache.getMisses(), 1)
+
+  // generator settings are part of the key
+  TEST_EQUAL(cache.run(ef, 5, true) == CoarseIsotopePatternGenerator(5, true).run(ef), true)
+  TEST_EQUAL(cache.getMisses(), 2)
+  TEST_EQUAL(cache.size(), 2)
+
+  // least recently used entry is evicted
+  cache.run(ef, 5);
+  cache.run(ef, 3);
+  TEST_EQUAL(cache.size(), 2)
+  Size misses = cache.getMisses();
+  cache.run(ef, 5);
+  TEST_EQUAL(cache.getMisses(), misses)
+  cache.run(ef, 5, true);
+  TEST_EQUAL(cache.getMisses(), misses + 1)
+
+  // capacity 0 disables caching
+  IsotopePatternCache no_cache(0);
+  TEST_EQUAL(no_cache.run(ef, 5) == CoarseIsotopePatternGenerator(5).run(ef), true)
+  TEST_EQUAL(no_cache.size(), 0)
+}
+END_SECTION
+
+START_SECTION(std::vector<IsotopeDistribution> run(const std::vector<EmpiricalFormula>& formulas, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache;
+  vector<EmpiricalFormula> formulas = {EmpiricalFormula("C6H12O6"), EmpiricalFormula("C10H16N5O13P3"), EmpiricalFormula("C6H12O6")};
+  vector<IsotopeDistribution> dists = cache.run(formulas, 4);
+  TEST_EQUAL(dists.size(), 3)
+  for (Size i = 0; i < formulas.size(); ++i)
+  {
+    TEST_EQUAL(dists[i] == CoarseIsotopePatternGenerator(4).run(formulas[i]), true)
+  }
+  TEST_EQUAL(cache.size(), 2)
+}
+END_SECTION
+
+START_SECTION(IsotopeDistribution estimateFromPeptideWeight(double average_weight, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache;
+  CoarseIsotopePatternGenerator solver(10);
+  TEST_EQUAL(cache.estimateFromPeptideWeight(1234.5, 10) == solver.estimateFromPeptideWeight(1234.5), true)
+  // nearby masses share the estimated formula
+  TEST_EQUAL(cache.estimateFromPeptideWeight(1234.6, 10) == solver.estimateFromPeptideWeight(1234.6), true)
+  TEST_EQUAL(cache.getHits(), 1)
+}
+END_SECTION
+
+START_SECTION(std::vector<IsotopeDistribution> estimateFromPeptideWeights(const std::vector<double>& average_weights, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache;
+  CoarseIsotopePatternGenerator solver(5);
+  vector<double> weights;
+  for (Size i = 0; i < 500; ++i) weights.push_back(500.0 + i * 7.3);
+  vector<IsotopeDistribution> dists = cache.estimateFromPeptideWeights(weights, 5);
+  TEST_EQUAL(dists.size(), weights.size())
+  Size errors = 0;
+  for (Size i = 0; i < weights.size(); ++i)
+  {
+    if (!(dists[i] == solver.estimateFromPeptideWeight(weights[i]))) ++errors;
+  }
+  TEST_EQUAL(errors, 0)
+}
+END_SECTION
+
+START_SECTION(IsotopeDistribution estimateFromRNAWeight(double average_weight, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache;
+  TEST_EQUAL(cache.estimateFromRNAWeight(3000.0, 6) == CoarseIsotopePatternGenerator(6).estimateFromRNAWeight(3000.0), true)
+}
+END_SECTION
+
+START_SECTION(IsotopeDistribution estimateFromDNAWeight(double average_weight, Size max_isotope = 0, bool round_masses = false))
+{
+  IsotopePatternCache cache;
+  TEST_EQUAL(cache.estimateFromDNAWeight(3000.0, 6) == CoarseIsotopePatternGenerator(6).estimateFromDNAWeight(3000.0), true)
+}
+END_SECTION
+
+START_SECTION(IsotopePatternCache(const IsotopePatternCache& rhs))
+{
+  IsotopePatternCache cache(5);
+  cache.run(EmpiricalFormula("C6H12O6"));
+  IsotopePatternCache copy(cache);
+  TEST_EQUAL(copy.size(), 0)
+  TEST_EQUAL(copy.getCapacity(), 5)
+}
+END_SECTION
+
+START_SECTION(IsotopePatternCache& operator=(const IsotopePatternCache& rhs))
+{
+  IsotopePatternCache cache(5), other(7);
+  other.run(EmpiricalFormula("C6H12O6"));
+  other = cache;
+  TEST_EQUAL(other.size(), 0)
+  TEST_EQUAL(other.getCapacity(), 5)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  IsotopePatternCache cache;
+  cache.run(EmpiricalFormula("C6H12O6"));
+  cache.run(EmpiricalFormula("C6H12O6"));
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+  TEST_EQUAL(cache.getHits(), 0)
+  TEST_EQUAL(cache.getMisses(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -175,8 +175,41 @@ START_SECTION((void getNeighborhood(Size index, std::vector<Size>& result_indice
   NOT_TESTABLE;
 END_SECTION
 
+START_SECTION((void getNeighborhoods(std::vector<std::vector<Size> >& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map = false, double max_pairwise_log_fc = -1.0) const))
+  vector<vector<Size> > neighbors;
+  kd_data_1.getNeighborhoods(neighbors, 1500, 150, false, true);
+  TEST_EQUAL(neighbors.size(), 2)
+  TEST_EQUAL(neighbors[0].size(), 2)
+  TEST_EQUAL(neighbors[1].size(), 2)
+  kd_data_1.getNeighborhoods(neighbors, 500, 150, false, true);
+  TEST_EQUAL(neighbors[0].size(), 1)
+  TEST_EQUAL(neighbors[0][0], 0)
+  kd_data_1.getNeighborhoods(neighbors, 1500, 150, false, false);
+  TEST_EQUAL(neighbors[0].empty(), true)
+END_SECTION
+
 START_SECTION((void queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, std::vector<Size>& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const))
-  NOT_TESTABLE;
+  vector<Size> result;
+  kd_data_1.queryRegion(500, 2500, 350, 550, result);
+  TEST_EQUAL(result.size(), 2)
+  kd_data_1.queryRegion(1500, 2500, 350, 550, result);
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 1)
+  kd_data_1.queryRegion(500, 2500, 350, 550, result, 0);
+  TEST_EQUAL(result.empty(), true)
+
+  // features added after building the tree are found as well
+  KDTreeFeatureMaps kd_data_4(fmaps, p);
+  Feature f4;
+  f4.setMZ(450);
+  f4.setRT(1500);
+  kd_data_4.addFeature(1, &f4);
+  kd_data_4.queryRegion(500, 2500, 350, 550, result);
+  TEST_EQUAL(result.size(), 3)
+  kd_data_4.optimizeTree();
+  kd_data_4.queryRegion(1400, 1600, 440, 460, result);
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 2)
 END_SECTION
 
 START_SECTION((void applyTransformations(const std::vector<TransformationModelLowess*>& trafos)))
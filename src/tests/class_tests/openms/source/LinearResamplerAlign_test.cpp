@@ -235,6 +235,68 @@ START_SECTION((template < template< typename > class SpecT, typename PeakType >
 }
 END_SECTION
 
+START_SECTION((template <class SpecT> void raster(SpecT& container, std::vector<typename SpecT::PeakType>& buffer)))
+{
+  LinearResamplerAlign lr;
+  Param param;
+  param.setValue("spacing", 0.5);
+  lr.setParameters(param);
+
+  // the buffer is reused (and holds stale peaks from the previous call)
+  std::vector<Peak1D> buffer;
+  for (Size k = 0; k < 3; ++k)
+  {
+    MSSpectrum spec = input_spectrum;
+    MSSpectrum expected = input_spectrum;
+    lr.raster(expected);
+    lr.raster(spec, buffer);
+    TEST_EQUAL(spec.size(), expected.size())
+    ABORT_IF(spec.size() != expected.size())
+    for (Size i = 0; i < spec.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(spec[i].getMZ(), expected[i].getMZ())
+      TEST_REAL_SIMILAR(spec[i].getIntensity(), expected[i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename SpecT> void raster_align_all(std::vector<SpecT>& containers, double start_pos, double end_pos)))
+{
+  LinearResamplerAlign lr;
+  Param param;
+  param.setValue("spacing", 0.75);
+  lr.setParameters(param);
+
+  std::vector<MSSpectrum> spectra(50, input_spectrum);
+  spectra[7].clear(true);
+  for (Size k = 0; k < spectra[3].size(); ++k) spectra[3][k].setIntensity(2 * spectra[3][k].getIntensity());
+  std::vector<MSSpectrum> expected = spectra;
+  for (MSSpectrum& s : expected) lr.raster_align(s, -0.25, 1.8);
+
+  lr.raster_align_all(spectra, -0.25, 1.8);
+  TEST_EQUAL(spectra.size(), 50)
+  TEST_EQUAL(spectra[7].empty(), true)
+  bool all_equal = true;
+  for (Size k = 0; k < spectra.size(); ++k)
+  {
+    if (spectra[k].size() != expected[k].size()) all_equal = false;
+    for (Size i = 0; i < spectra[k].size() && all_equal; ++i)
+    {
+      if (spectra[k][i].getMZ() != expected[k][i].getMZ() ||
+          spectra[k][i].getIntensity() != expected[k][i].getIntensity()) all_equal = false;
+    }
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(spectra[0].size(), 4)
+
+  // inverted range empties all containers
+  lr.raster_align_all(spectra, 1.8, -0.25);
+  TEST_EQUAL(spectra[0].empty(), true)
+  TEST_EQUAL(spectra[3].empty(), true)
+}
+END_SECTION
+
 // it should work with alignment to -0.25, 1.8
 START_SECTION([EXTRA] test_linear_res_align_3)
 {
@@ -47,6 +47,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
 #include <fstream>
+#include <thread>
 #include <boost/regex.hpp>
 
 // OpenMP support
@@ -524,6 +525,35 @@ START_SECTION(([EXTRA] Test caching of empty lines))
 }
 END_SECTION
 
+START_SECTION((LogStream& threadLocalStream(LogStream& global)))
+{
+  ostringstream stream_by_logger;
+  LogStream global(new LogStreamBuf());
+  global.insert(stream_by_logger);
+
+  // the main thread writes to the global stream directly
+  TEST_EQUAL(&threadLocalStream(global), &global)
+
+  LogStream* worker_stream = nullptr;
+  LogStream* worker_stream_again = nullptr;
+  std::string after_flush;
+  std::thread worker([&]()
+  {
+    worker_stream = &threadLocalStream(global);
+    *worker_stream << "1\n2";
+    worker_stream->flush(); // the unterminated '2' stays in the thread
+    after_flush = stream_by_logger.str();
+    *worker_stream << "3" << endl;
+    worker_stream_again = &threadLocalStream(global);
+  });
+  worker.join();
+  TEST_NOT_EQUAL(worker_stream, &global)
+  TEST_EQUAL(worker_stream_again, worker_stream)
+  TEST_EQUAL(after_flush, "1\n")
+  TEST_EQUAL(stream_by_logger.str(), "1\n23\n")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
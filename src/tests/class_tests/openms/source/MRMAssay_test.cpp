@@ -59,6 +59,11 @@ public:
     return getMatchingPeptidoforms_(fragment_ion, ions, mz_threshold);
   }
 
+  std::vector<std::string> getMatchingPeptidoformsSorted_test(const double fragment_ion, std::vector<std::pair<double, std::string> >& ions, const double mz_threshold)
+  {
+    return getMatchingPeptidoformsSorted_(fragment_ion, ions, mz_threshold);
+  }
+
   int getSwath_test(const std::vector<std::pair<double, double> >& swathes, const double precursor_mz)
   {
     return getSwath_(swathes, precursor_mz);
@@ -133,6 +138,33 @@ START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoforms_(const
 
 END_SECTION
 
+START_SECTION(std::vector<std::string> MRMAssay::getMatchingPeptidoformsSorted_(const double fragment_ion, const FragmentSeqMap& sorted_ions, const double mz_threshold))
+{
+  MRMAssay_test mrma;
+
+  std::vector<std::pair<double, std::string> > ions;
+  ions.push_back(std::make_pair(100.00, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.01, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.10, "PEPT(UniMod:21)IDEK"));
+  ions.push_back(std::make_pair(100.11, "PEPTIDEK"));
+  ions.push_back(std::make_pair(100.12, "PEPTIDEK"));
+
+  std::vector<std::string> isoforms1 = mrma.getMatchingPeptidoformsSorted_test(100.06, ions, 0.03);
+  std::vector<std::string> isoforms2 = mrma.getMatchingPeptidoformsSorted_test(100.06, ions, 0.06);
+  std::vector<std::string> isoforms3 = mrma.getMatchingPeptidoformsSorted_test(99.99, ions, 0.015);
+
+  TEST_EQUAL(isoforms1.size(), 0)
+
+  TEST_EQUAL(isoforms2.size(), 2)
+  TEST_EQUAL(isoforms2[0], "PEPT(UniMod:21)IDEK")
+  TEST_EQUAL(isoforms2[1], "PEPTIDEK")
+
+  TEST_EQUAL(isoforms3.size(), 1)
+  TEST_EQUAL(isoforms3[0], "PEPTIDEK")
+}
+
+END_SECTION
+
 START_SECTION(int MRMAssay::getSwath_(const std::vector<std::pair<double, double> > swathes, const double precursor_mz))
 {
   MRMAssay_test mrma;
@@ -0,0 +1,183 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest, Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+START_TEST(MSDataParallelTransformingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+MSDataParallelTransformingConsumer* ptr = nullptr;
+MSDataParallelTransformingConsumer* nullPointer = nullptr;
+MSDataStoringConsumer storage;
+
+PeakMap expc;
+MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), expc);
+
+START_SECTION((MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next, Size batch_size = 64)))
+{
+  ptr = new MSDataParallelTransformingConsumer(&storage, 3);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getBatchSize(), 3)
+  TEST_EXCEPTION(Exception::IllegalArgument, MSDataParallelTransformingConsumer(nullptr))
+  TEST_EXCEPTION(Exception::IllegalArgument, MSDataParallelTransformingConsumer(&storage, 0))
+}
+END_SECTION
+
+START_SECTION((~MSDataParallelTransformingConsumer()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  // many spectra with a small batch size: all are transformed and their order is kept
+  MSDataStoringConsumer out;
+  {
+    MSDataParallelTransformingConsumer consumer(&out, 4);
+    consumer.setSpectraProcessingFunc([](MSSpectrum& s) { s.setNativeID(s.getNativeID() + "_done"); });
+    for (Size i = 0; i < 50; ++i)
+    {
+      MSSpectrum s;
+      s.setNativeID(String(i));
+      consumer.consumeSpectrum(s);
+      TEST_EQUAL(s.getNativeID(), String(i)) // input is not modified
+    }
+    TEST_EQUAL(out.getData().size(), 48) // two spectra are still pending
+  } // destructor flushes
+  TEST_EQUAL(out.getData().size(), 50)
+  ABORT_IF(out.getData().size() != 50)
+  TEST_EQUAL(out.getData()[0].getNativeID(), "0_done")
+  TEST_EQUAL(out.getData()[37].getNativeID(), "37_done")
+  TEST_EQUAL(out.getData()[49].getNativeID(), "49_done")
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  PeakMap exp = expc;
+  TEST_EQUAL(exp.getNrChromatograms() > 0, true)
+  exp.getChromatogram(0).sortByPosition();
+
+  MSDataStoringConsumer out;
+  MSDataParallelTransformingConsumer consumer(&out, 2);
+  consumer.setChromatogramProcessingFunc([](MSChromatogram& c) { c.sortByIntensity(); });
+  consumer.consumeChromatogram(exp.getChromatogram(0));
+  TEST_EQUAL(out.getData().getNrChromatograms(), 0)
+  consumer.flush();
+  TEST_EQUAL(out.getData().getNrChromatograms(), 1)
+  TEST_EQUAL(exp.getChromatogram(0).isSorted(), true)
+  TEST_EQUAL(out.getData().getChromatograms()[0].isSorted(), false)
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  // a chromatogram forces pending spectra out first
+  MSDataStoringConsumer out;
+  MSDataParallelTransformingConsumer consumer(&out, 10);
+  MSSpectrum s;
+  consumer.consumeSpectrum(s);
+  consumer.consumeSpectrum(s);
+  TEST_EQUAL(out.getData().size(), 0)
+  MSChromatogram c;
+  consumer.consumeChromatogram(c);
+  TEST_EQUAL(out.getData().size(), 2)
+  TEST_EQUAL(out.getData().getNrChromatograms(), 0)
+  consumer.flush();
+  TEST_EQUAL(out.getData().getNrChromatograms(), 1)
+
+  // errors are reported in consumption order
+  MSDataStoringConsumer out2;
+  MSDataParallelTransformingConsumer failing(&out2, 10);
+  failing.setSpectraProcessingFunc([](MSSpectrum& sp)
+  {
+    if (sp.getNativeID() == "bad") throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "bad spectrum", sp.getNativeID());
+  });
+  MSSpectrum bad;
+  bad.setNativeID("bad");
+  failing.consumeSpectrum(s);
+  failing.consumeSpectrum(bad);
+  TEST_EXCEPTION(Exception::InvalidValue, failing.flush())
+  TEST_EQUAL(out2.getData().size(), 0)
+}
+END_SECTION
+
+START_SECTION((void setSpectraProcessingFunc(std::function<void (SpectrumType&)> f_spec)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setChromatogramProcessingFunc(std::function<void (ChromatogramType&)> f_chrom)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+{
+  NOT_TESTABLE // forwarded to the next consumer
+}
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)))
+{
+  NOT_TESTABLE // forwarded to the next consumer
+}
+END_SECTION
+
+START_SECTION((Size getBatchSize() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -38,6 +38,10 @@
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 ///////////////////////////
 
+#include <OpenMS/test_config.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -103,6 +107,36 @@ START_SECTION((virtual void addDataProcessing(DataProcessing d)))
 }
 END_SECTION
 
+START_SECTION((void setWriteBehind(Size max_pending)))
+{
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  String sync_file, async_file;
+  NEW_TMP_FILE(sync_file)
+  NEW_TMP_FILE(async_file)
+  for (const String& f : {sync_file, async_file})
+  {
+    PlainMSDataWritingConsumer consumer(f);
+    if (f == async_file) consumer.setWriteBehind(2);
+    consumer.setExpectedSize(exp.size(), exp.getNrChromatograms());
+    consumer.setExperimentalSettings(exp);
+    for (MSSpectrum s : exp.getSpectra()) consumer.consumeSpectrum(s);
+    for (MSChromatogram c : exp.getChromatograms()) consumer.consumeChromatogram(c);
+    TEST_EQUAL(consumer.getNrSpectraWritten(), exp.size())
+
+    // cannot be changed once writing started
+    TEST_EXCEPTION(Exception::IllegalArgument, consumer.setWriteBehind(4))
+  }
+  TEST_FILE_EQUAL(async_file.c_str(), sync_file.c_str())
+
+  PeakMap reloaded;
+  MzMLFile().load(async_file, reloaded);
+  TEST_EQUAL(reloaded.size(), exp.size())
+  TEST_EQUAL(reloaded.getNrChromatograms(), exp.getNrChromatograms())
+}
+END_SECTION
+
 START_SECTION((virtual Size getNrSpectraWritten()))
 {
   // TODO
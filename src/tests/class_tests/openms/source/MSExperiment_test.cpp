@@ -897,6 +897,62 @@ START_SECTION((ConstIterator RTEnd(CoordinateType rt) const))
 }
 END_SECTION
 
+START_SECTION((std::vector<MSChromatogram> extractXICs(const std::vector<std::pair<RangeMZ, RangeRT> >& ranges, UInt ms_level = 1) const))
+{
+  // several sweep blocks of spectra, MS1 and MS2 interleaved
+  PeakMap tmp;
+  for (Size i = 0; i < 300; ++i)
+  {
+    MSSpectrum s;
+    s.setRT(double(i));
+    s.setMSLevel(i % 3 == 2 ? 2 : 1);
+    for (Size j = 0; j < 50; ++j)
+    {
+      s.push_back(Peak1D(400.0 + j * 2.0, float(i + j)));
+    }
+    tmp.addSpectrum(s);
+  }
+
+  std::vector<std::pair<RangeMZ, RangeRT> > ranges = {
+    {RangeMZ(401.0, 405.0), RangeRT(250.0, 299.0)}, // unsorted targets
+    {RangeMZ(400.0, 400.0), RangeRT(0.0, 299.0)},
+    {RangeMZ(410.5, 411.5), RangeRT(60.0, 70.0)},   // no peaks in m/z window
+    {RangeMZ(400.0, 500.0), RangeRT(1000.0, 2000.0)}, // no spectra in RT window
+    {RangeMZ(), RangeRT(0.0, 10.0)}};                // empty range
+  std::vector<MSChromatogram> xics = tmp.extractXICs(ranges);
+  TEST_EQUAL(xics.size(), 5)
+  ABORT_IF(xics.size() != 5)
+  TEST_EQUAL(xics[1].size(), 200)
+  TEST_EQUAL(xics[2].size(), 8)
+  TEST_EQUAL(xics[3].size(), 0)
+  TEST_EQUAL(xics[4].size(), 0)
+  TEST_REAL_SIMILAR(xics[0].getMZ(), 403.0)
+
+  // compare to the area iterator
+  for (Size t = 0; t < 3; ++t)
+  {
+    Size n(0);
+    for (const ChromatogramPeak& p : xics[t])
+    {
+      double sum(0);
+      for (auto it = tmp.areaBeginConst(p.getRT(), p.getRT(), ranges[t].first.getMin(), ranges[t].first.getMax()); it != tmp.areaEndConst(); ++it)
+      {
+        sum += it->getIntensity();
+      }
+      if (std::fabs(sum - p.getIntensity()) < 1e-3) ++n;
+    }
+    TEST_EQUAL(n, xics[t].size())
+  }
+  TEST_REAL_SIMILAR(xics[0][0].getRT(), 250.0)
+  TEST_REAL_SIMILAR(xics[0][0].getIntensity(), (250 + 1) + (250 + 2))
+  TEST_REAL_SIMILAR(xics[2][0].getIntensity(), 0.0)
+
+  // MS2
+  std::vector<MSChromatogram> ms2 = tmp.extractXICs(ranges, 2);
+  TEST_EQUAL(ms2[1].size(), 100)
+}
+END_SECTION
+
 START_SECTION((void sortSpectra(bool sort_mz = true)))
 {
   std::vector< Peak2D> plist;
@@ -42,6 +42,8 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <fstream>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -143,6 +145,51 @@ START_SECTION(void load(const String &filename, std::vector< PeptideIdentificati
 
 END_SECTION
 
+START_SECTION(void load(const String &filename, const std::function<void(PeptideIdentification&, PeakSpectrum&)>& consume))
+{
+  MSPFile msp_file;
+  vector<PeptideIdentification> ids;
+  PeakMap exp;
+  msp_file.load(OPENMS_GET_TEST_DATA_PATH("MSPFile_test.msp"), ids, exp);
+
+  vector<PeptideIdentification> streamed_ids;
+  vector<PeakSpectrum> streamed_spectra;
+  msp_file.load(OPENMS_GET_TEST_DATA_PATH("MSPFile_test.msp"), [&](PeptideIdentification& id, PeakSpectrum& spec)
+  {
+    streamed_ids.push_back(id);
+    streamed_spectra.push_back(spec);
+  });
+  TEST_EQUAL(streamed_spectra.size(), exp.size())
+  TEST_EQUAL(streamed_ids.size(), ids.size())
+  ABORT_IF(streamed_spectra.size() != 7)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(streamed_spectra[i] == exp[i], true)
+    TEST_EQUAL(streamed_ids[i] == ids[i], true)
+  }
+
+  // more entries than fit into a single chunk
+  String large_msp;
+  NEW_TMP_FILE(large_msp)
+  {
+    ofstream out(large_msp.c_str());
+    for (Size i = 0; i < 1000; ++i)
+    {
+      out << "Name: PEPTIDEK/2\nMW: 927.45\nComment: Mods=0\nNum peaks: 2\n"
+          << 100 + i << "\t1000\t\"b2/0.01\"\n" << 200 + i << "\t500\t\"y2/0.01\"\n\n";
+    }
+  }
+  ids.clear();
+  msp_file.load(large_msp, ids, exp);
+  TEST_EQUAL(exp.size(), 1000)
+  TEST_EQUAL(ids.size(), 1000)
+  ABORT_IF(exp.size() != 1000)
+  TEST_STRING_EQUAL(exp[777].getNativeID(), "index=777")
+  TEST_REAL_SIMILAR(exp[777][0].getMZ(), 877.0)
+  TEST_EQUAL(ids[999].getHits()[0].getPeakAnnotations().size(), 2)
+}
+END_SECTION
+
 START_SECTION(void store(const String& filename, const PeakMap& exp) const)
 	MSPFile msp_file;
 	vector<PeptideIdentification> ids;
@@ -1416,6 +1416,35 @@ START_SECTION(void clear(bool clear_meta_data))
 }
 END_SECTION
 
+START_SECTION(MSSpectrum copyWithoutPeaks() const)
+{
+  MSSpectrum edit;
+  edit.getInstrumentSettings().getScanWindows().resize(1);
+  edit.resize(3);
+  edit.setMetaValue("label",String("bla"));
+  edit.setRT(5);
+  edit.setDriftTime(6);
+  edit.setDriftTimeUnit(DriftTimeUnit::MILLISECOND);
+  edit.setMSLevel(5);
+  edit.setName("name");
+  edit.getFloatDataArrays().resize(5);
+  edit.getIntegerDataArrays().resize(5);
+  edit.getStringDataArrays().resize(5);
+
+  MSSpectrum copy = edit.copyWithoutPeaks();
+  MSSpectrum reference = edit;
+  reference.clear(false);
+  TEST_EQUAL(copy == reference, true)
+  TEST_EQUAL(copy.empty(), true)
+  TEST_EQUAL(copy.getFloatDataArrays().empty(), true)
+  TEST_EQUAL(copy.getRT(), 5)
+  TEST_EQUAL(copy.getMSLevel(), 5)
+  TEST_EQUAL(copy.getName(), "name")
+  TEST_EQUAL(copy.getMetaValue("label"), "bla")
+  TEST_EQUAL(edit.size(), 3)
+}
+END_SECTION
+
 START_SECTION(([MSSpectrum::RTLess] bool operator()(const MSSpectrum &a, const MSSpectrum &b) const))
 {
   vector< MSSpectrum> v;
@@ -42,6 +42,9 @@
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+
+#include <fstream>
 
 using namespace OpenMS;
 using namespace std;
@@ -78,6 +81,52 @@ START_SECTION((template < typename MapType > void load(const String &filename, M
 }
 END_SECTION
 
+START_SECTION((void transform(const String& filename, Interfaces::IMSDataConsumer* consumer, bool skip_full_count = false)))
+{
+  // more spectra than parsed in a single batch
+  String large_mgf;
+  NEW_TMP_FILE(large_mgf)
+  {
+    ofstream out(large_mgf.c_str());
+    for (Size i = 0; i < 5000; ++i)
+    {
+      out << "BEGIN IONS\nTITLE=spectrum " << i << "\nPEPMASS=" << 400 + i << "\nCHARGE=2+\n";
+      if (i % 2 == 0) out << "RTINSECONDS=" << i << "\n";
+      out << "100.5 10\n200.5\t20\n300.5  30 1\nEND IONS\n\n";
+    }
+    // block without peaks is skipped
+    out << "BEGIN IONS\nTITLE=empty\nEND IONS\n";
+  }
+  PeakMap exp;
+  ptr->load(large_mgf, exp);
+  TEST_EQUAL(exp.size(), 5000)
+  ABORT_IF(exp.size() != 5000)
+  TEST_STRING_EQUAL(exp[4321].getNativeID(), "index=4321")
+  TEST_STRING_EQUAL(exp[4321].getMetaValue("TITLE"), "spectrum 4321_index=4321")
+  TEST_REAL_SIMILAR(exp[4321].getPrecursors()[0].getMZ(), 4721.0)
+  TEST_EQUAL(exp[4321].getPrecursors()[0].getCharge(), 2)
+  TEST_EQUAL(exp[4321].size(), 3)
+  TEST_REAL_SIMILAR(exp[4321][2].getIntensity(), 30.0)
+  TEST_REAL_SIMILAR(exp[4320].getRT(), 4320.0)
+  TEST_EQUAL(exp[4321].getRT() < 0, true) // not taken over from the previous spectrum
+
+  MSDataStoringConsumer consumer;
+  ptr->transform(large_mgf, &consumer);
+  TEST_EQUAL(consumer.getData().size(), 5000)
+  ABORT_IF(consumer.getData().size() != 5000)
+  TEST_EQUAL(consumer.getData()[4321] == exp[4321], true)
+
+  // errors report the line number in the file
+  String broken_mgf;
+  NEW_TMP_FILE(broken_mgf)
+  {
+    ofstream out(broken_mgf.c_str());
+    out << "BEGIN IONS\nPEPMASS=400\n100 10\nEND IONS\nBEGIN IONS\nPEPMASS=500\n100 abc\nEND IONS\n";
+  }
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::ParseError, ptr->load(broken_mgf, exp), " in: The content '100 abc' at line #7 could not be converted to a number! Expected two (m/z int) or three (m/z int charge) numbers separated by whitespace (space or tab).")
+}
+END_SECTION
+
 START_SECTION((void store(std::ostream &os, const String &filename, const PeakMap &experiment, bool compact = false)))
 {
   PeakMap exp;
@@ -85,6 +85,77 @@ START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, d
 }
 END_SECTION
 
+START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, double weight, double tolerance) const))
+{
+  double mass = AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal);
+  MassDecompositionAlgorithm mda;
+  vector<MassDecomposition> decomps;
+  mda.getDecompositions(decomps, mass, 0.0001);
+  TEST_EQUAL(decomps.size(), 842)
+  decomps.clear();
+  mda.getDecompositions(decomps, mass, 0.001);
+  TEST_EQUAL(decomps.size(), 911)
+
+  // same result as with the tolerance parameter
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.001);
+  mda.setParameters(p);
+  vector<MassDecomposition> decomps2;
+  mda.getDecompositions(decomps2, mass);
+  TEST_EQUAL(decomps2.size(), decomps.size())
+  ABORT_IF(decomps2.size() != decomps.size())
+  bool equal = true;
+  for (Size i = 0; i < decomps.size(); ++i)
+  {
+    equal &= decomps[i].toString() == decomps2[i].toString();
+  }
+  TEST_EQUAL(equal, true)
+}
+END_SECTION
+
+START_SECTION((void getDecompositions(std::vector<std::vector<MassDecomposition> >& decomps, const std::vector<double>& weights) const))
+{
+  MassDecompositionAlgorithm mda;
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.0001);
+  mda.setParameters(p);
+
+  vector<double> weights;
+  for (const String& s : {"DFPIANGER", "PEPTIDE", "ELVIS", "GG"})
+  {
+    weights.push_back(AASequence::fromString(s).getMonoWeight(Residue::Internal));
+  }
+  vector<vector<MassDecomposition> > decomps;
+  mda.getDecompositions(decomps, weights);
+  TEST_EQUAL(decomps.size(), 4)
+  TEST_EQUAL(decomps[0].size(), 842)
+  for (Size i = 0; i < weights.size(); ++i)
+  {
+    vector<MassDecomposition> single;
+    mda.getDecompositions(single, weights[i]);
+    TEST_EQUAL(decomps[i].size(), single.size())
+  }
+  // GG has the same composition as N
+  TEST_EQUAL(decomps[3].size(), 2)
+}
+END_SECTION
+
+START_SECTION((void forEachDecomposition(double weight, double tolerance, const std::function<void(const MassDecomposition&)>& callback) const))
+{
+  double mass = AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal);
+  MassDecompositionAlgorithm mda;
+  Size count = 0;
+  Size with_nine_aa = 0;
+  mda.forEachDecomposition(mass, 0.0001, [&](const MassDecomposition& d)
+  {
+    ++count;
+    if (d.toExpandedString().size() == 9) ++with_nine_aa;
+  });
+  TEST_EQUAL(count, 842)
+  TEST_NOT_EQUAL(with_nine_aa, 0)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -82,6 +82,17 @@ START_SECTION((MassDecomposition(const String &deco)))
 }
 END_SECTION
 
+START_SECTION((explicit MassDecomposition(const std::map<char, Size>& deco)))
+{
+  std::map<char, Size> deco = {{'C', 3}, {'M', 4}, {'S', 200}, {'W', 0}};
+  MassDecomposition md(deco);
+  TEST_EQUAL(md.getNumberOfMaxAA(), 200)
+  TEST_STRING_EQUAL(md.toString(), "C3 M4 S200")
+  TEST_EQUAL(md == "C3 M4 S200", true)
+  TEST_EQUAL(MassDecomposition(std::map<char, Size>()).toString(), "")
+}
+END_SECTION
+
 START_SECTION((MassDecomposition& operator=(const MassDecomposition &rhs)))
 {
   MassDecomposition md("C3 M4 S200");
@@ -172,6 +172,34 @@ START_SECTION((void run(const PeakMap &, std::vector< MassTrace > &)))
       }
 
     }
+
+    // splitting the m/z axis into bands must not change the result
+    {
+      std::vector<MassTrace> serial_mt, banded_mt;
+      Param p_serial(p_mtd);
+      p_serial.setValue("mz_bands", 1);
+      test_mtd.setParameters(p_serial);
+      test_mtd.run(input, serial_mt);
+
+      for (int bands : {2, 3, 8})
+      {
+        Param p_banded(p_mtd);
+        p_banded.setValue("mz_bands", bands);
+        test_mtd.setParameters(p_banded);
+        banded_mt.clear();
+        test_mtd.run(input, banded_mt);
+
+        TEST_EQUAL(banded_mt.size(), serial_mt.size());
+        for (Size i = 0; i < std::min(banded_mt.size(), serial_mt.size()); ++i)
+        {
+          TEST_EQUAL(banded_mt[i].getLabel(), serial_mt[i].getLabel());
+          TEST_EQUAL(banded_mt[i].getSize(), serial_mt[i].getSize());
+          TEST_REAL_SIMILAR(banded_mt[i].getCentroidMZ(), serial_mt[i].getCentroidMZ());
+          TEST_REAL_SIMILAR(banded_mt[i].computePeakArea(), serial_mt[i].computePeakArea());
+        }
+      }
+      test_mtd.setParameters(p_mtd);
+    }
 }
 END_SECTION
 
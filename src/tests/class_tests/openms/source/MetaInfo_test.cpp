@@ -39,6 +39,8 @@
 
 #include <OpenMS/METADATA/MetaInfo.h>
 
+#include <algorithm>
+
 ///////////////////////////
 
 START_TEST(Example, "$Id$")
@@ -251,6 +253,30 @@ START_SECTION((void removeValue(const String& name)))
 	i.removeValue("icon");
 END_SECTION
 
+START_SECTION(([EXTRA] more values than stored inline))
+  MetaInfo i;
+  for (UInt index = 20; index > 0; --index)
+  {
+    i.setValue(index, DataValue(String(index)));
+  }
+  std::vector<UInt> keys;
+  i.getKeys(keys);
+  TEST_EQUAL(keys.size(), 20)
+  TEST_EQUAL(std::is_sorted(keys.begin(), keys.end()), true)
+  TEST_EQUAL(i.getValue(7).toString(), "7")
+
+  MetaInfo copy(i);
+  TEST_EQUAL(copy == i, true)
+  MetaInfo moved(std::move(copy));
+  TEST_EQUAL(moved == i, true)
+
+  // overwriting keeps a single entry per index
+  i.setValue(7, DataValue("seven"));
+  i.getKeys(keys);
+  TEST_EQUAL(keys.size(), 20)
+  TEST_EQUAL(i.getValue(7).toString(), "seven")
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
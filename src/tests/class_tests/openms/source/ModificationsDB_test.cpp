@@ -293,6 +293,20 @@ START_SECTION((bool addModification(ResidueModification* modification)))
   modification->setFullId("Phospho (A)");
   ptr->addModification(std::move(modification));
   TEST_EQUAL(ptr->has("Phospho (A)"), true);
+
+  // new modifications are found by mass difference
+  std::unique_ptr<ResidueModification> heavy(new ResidueModification());
+  heavy->setFullId("Heavy test (X)");
+  heavy->setDiffMonoMass(12345.678);
+  const ResidueModification* heavy_ptr = ptr->addModification(std::move(heavy));
+  vector<const ResidueModification*> mods;
+  ptr->searchModificationsByDiffMonoMass(mods, 12345.6, 0.1);
+  TEST_EQUAL(mods.size(), 1)
+  ABORT_IF(mods.empty())
+  TEST_EQUAL(mods[0], heavy_ptr)
+  TEST_EQUAL(ptr->getBestModificationByDiffMonoMass(12345.7, 0.1), heavy_ptr)
+  ptr->searchModificationsByDiffMonoMass(mods, 12345.6, 0.05);
+  TEST_EQUAL(mods.empty(), true)
 }
 END_SECTION
 
@@ -279,6 +279,59 @@ START_SECTION((static void applyVariableModifications(const ModifiedPeptideGener
 }
 END_SECTION
 
+START_SECTION(([ModifiedPeptideGenerator::VariableModificationEnumerator] bool next()))
+{
+  vector<String> all_mods = {"Oxidation (M)", "Phospho (S)", "Phospho (T)", "Carbamyl (K)", "Carbamyl (N-term)", "Amidated (C-term)"};
+  ModifiedPeptideGenerator::MapToResidueType variable_mods = ModifiedPeptideGenerator::getModifications(all_mods);
+  const AASequence seq = AASequence::fromString("KSAMTPMSK");
+
+  // same variants in the same order as applyVariableModifications
+  for (Size max_mods = 0; max_mods <= 3; ++max_mods)
+  {
+    for (bool keep_unmodified : {true, false})
+    {
+      vector<AASequence> modified_peptides;
+      ModifiedPeptideGenerator::applyVariableModifications(variable_mods, seq, max_mods, modified_peptides, keep_unmodified);
+
+      ModifiedPeptideGenerator::VariableModificationEnumerator variants(variable_mods, seq, max_mods, keep_unmodified);
+      Size count(0);
+      while (variants.next())
+      {
+        TEST_EQUAL(variants.getIndex(), count)
+        const AASequence variant = variants.getPeptide();
+        TEST_EQUAL(variant, modified_peptides[count])
+        TEST_REAL_SIMILAR(variants.getMonoWeight(), variant.getMonoWeight())
+        TEST_EQUAL(variants.getPlacements().size() <= max_mods, true)
+        ++count;
+      }
+      TEST_EQUAL(count, modified_peptides.size())
+      TEST_EQUAL(variants.next(), false)
+    }
+  }
+
+  // only variants in the mass range are visited, indices still refer to the full list
+  vector<AASequence> modified_peptides;
+  ModifiedPeptideGenerator::applyVariableModifications(variable_mods, seq, 2, modified_peptides);
+  const double min_mass = seq.getMonoWeight() + 75.0; // e.g. phosphorylated or doubly carbamylated variants
+  ModifiedPeptideGenerator::VariableModificationEnumerator variants(variable_mods, seq, 2);
+  variants.setMassRange(min_mass, 1e10);
+  Size count(0);
+  while (variants.next())
+  {
+    TEST_EQUAL(variants.getMonoWeight() >= min_mass, true)
+    TEST_EQUAL(variants.getPeptide(), modified_peptides[variants.getIndex()])
+    ++count;
+  }
+  Size expected(0);
+  for (const AASequence& p : modified_peptides)
+  {
+    if (p.getMonoWeight() >= min_mass) { ++expected; }
+  }
+  TEST_EQUAL(count, expected)
+  TEST_NOT_EQUAL(count, 0)
+}
+END_SECTION
+
 START_SECTION([EXTRA] multithreaded example)
 {
 // only do this in release, since MP errors are unlikely to occur in Debug mode anyway and it takes 5min to run the test in Debug
@@ -126,6 +126,37 @@ START_SECTION((static MorpheusScore::Result compute(
 }
 END_SECTION
 
+START_SECTION((static void computeBatch(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum &exp_spectrum, const std::vector< const PeakSpectrum * > &theo_spectra, std::vector< Result > &results)))
+{
+  PeakSpectrum exp_spectrum, theo1, theo2, theo3;
+  tsg.getSpectrum(exp_spectrum, AASequence::fromString("PEPTIDE"), 1, 1);
+  tsg.getSpectrum(theo1, AASequence::fromString("PEPTIDE"), 1, 1);
+  tsg.getSpectrum(theo2, AASequence::fromString("EDITPEP"), 1, 1);
+  tsg.getSpectrum(theo3, AASequence::fromString("PEPTIDES"), 1, 2);
+  std::vector<const PeakSpectrum*> theo_spectra = { &theo1, &theo2, &theo3, &exp_spectrum };
+
+  std::vector<MorpheusScore::Result> results;
+  MorpheusScore::computeBatch(0.1, false, exp_spectrum, theo_spectra, results);
+  TEST_EQUAL(results.size(), 4)
+  for (Size i = 0; i != theo_spectra.size(); ++i)
+  {
+    MorpheusScore::Result single = MorpheusScore::compute(0.1, false, exp_spectrum, *theo_spectra[i]);
+    TEST_EQUAL(results[i].matches, single.matches)
+    TEST_EQUAL(results[i].n_peaks, single.n_peaks)
+    TEST_EQUAL(results[i].score, single.score)
+    TEST_EQUAL(results[i].MIC, single.MIC)
+    TEST_EQUAL(results[i].TIC, single.TIC)
+    TEST_EQUAL(results[i].err, single.err)
+  }
+  TEST_REAL_SIMILAR(results[0].score, 11.0 + 1.0);
+
+  // empty experimental spectrum
+  MorpheusScore::computeBatch(0.1, false, PeakSpectrum(), theo_spectra, results);
+  TEST_EQUAL(results.size(), 4)
+  TEST_EQUAL(results[0].matches, 0)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -697,6 +697,23 @@ START_SECTION((template <typename PeakType > void filterExperiment(MSExperiment<
     }
   }
 
+  // many spectra (filtered in parallel) give the same result as filtering them one by one
+  PeakMap many;
+  for (UInt scan = 0; scan < 64; ++scan)
+  {
+    MSSpectrum spec = raw;
+    for (Peak1D& p : spec) p.setIntensity(p.getIntensity() + float(scan % 5));
+    many.addSpectrum(spec);
+  }
+  Param tophat;
+  tophat.setValue("method", "tophat");
+  tophat.setValue("struc_elem_length", 1.3);
+  mf.setParameters(tophat);
+  PeakMap expected = many;
+  for (MSSpectrum& spec : expected) mf.filter(spec);
+  mf.filterExperiment(many);
+  TEST_EQUAL(many.size(), 64)
+  TEST_EQUAL(many == expected, true)
 }
 END_SECTION
 
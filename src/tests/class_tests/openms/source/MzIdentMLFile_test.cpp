@@ -38,6 +38,8 @@
 ///////////////////////////
 
 #include <OpenMS/FORMAT/MzIdentMLFile.h>
+#include <OpenMS/FORMAT/HANDLERS/MzIdentMLDOMHandler.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/CONCEPT/FuzzyStringComparator.h>
 #include <OpenMS/CHEMISTRY/CrossLinksDB.h>
 #include <OpenMS/CONCEPT/Constants.h>
@@ -367,6 +369,72 @@ START_SECTION(([EXTRA] regression test for file loading on example files))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] streaming and DOM parser yield the same identifications))
+{
+  for (const String& input_path : {String(OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_whole.mzid")),
+                                   String(OPENMS_GET_TEST_DATA_PATH("MzIdentMLFile_msgf_mini.mzid")),
+                                   String(OPENMS_GET_TEST_DATA_PATH("MzIdentML_3runs.mzid"))})
+  {
+    std::vector<ProteinIdentification> protein_ids, protein_ids_dom;
+    std::vector<PeptideIdentification> peptide_ids, peptide_ids_dom;
+    MzIdentMLFile().load(input_path, protein_ids, peptide_ids);
+    {
+      ProgressLogger logger;
+      Internal::MzIdentMLDOMHandler handler(protein_ids_dom, peptide_ids_dom, "1.1.0", logger);
+      handler.readMzIdentMLFile(input_path);
+    }
+
+    TEST_EQUAL(protein_ids.size(), protein_ids_dom.size())
+    ABORT_IF(protein_ids.size() != protein_ids_dom.size())
+    for (Size i = 0; i < protein_ids.size(); ++i)
+    {
+      TEST_EQUAL(protein_ids[i].getSearchEngine(), protein_ids_dom[i].getSearchEngine())
+      TEST_EQUAL(protein_ids[i].getSearchEngineVersion(), protein_ids_dom[i].getSearchEngineVersion())
+      TEST_REAL_SIMILAR(protein_ids[i].getSignificanceThreshold(), protein_ids_dom[i].getSignificanceThreshold())
+      TEST_EQUAL(protein_ids[i].getSearchParameters().db, protein_ids_dom[i].getSearchParameters().db)
+      TEST_EQUAL(protein_ids[i].getSearchParameters().charges, protein_ids_dom[i].getSearchParameters().charges)
+      TEST_EQUAL(protein_ids[i].getSearchParameters().missed_cleavages, protein_ids_dom[i].getSearchParameters().missed_cleavages)
+      TEST_EQUAL(protein_ids[i].getSearchParameters().digestion_enzyme.getName(), protein_ids_dom[i].getSearchParameters().digestion_enzyme.getName())
+      TEST_EQUAL(ListUtils::concatenate(protein_ids[i].getSearchParameters().fixed_modifications, ","),
+                 ListUtils::concatenate(protein_ids_dom[i].getSearchParameters().fixed_modifications, ","))
+      TEST_EQUAL(ListUtils::concatenate(protein_ids[i].getSearchParameters().variable_modifications, ","),
+                 ListUtils::concatenate(protein_ids_dom[i].getSearchParameters().variable_modifications, ","))
+      TEST_EQUAL(protein_ids[i].getHits().size(), protein_ids_dom[i].getHits().size())
+      ABORT_IF(protein_ids[i].getHits().size() != protein_ids_dom[i].getHits().size())
+      for (Size j = 0; j < protein_ids[i].getHits().size(); ++j)
+      {
+        TEST_EQUAL(protein_ids[i].getHits()[j].getAccession(), protein_ids_dom[i].getHits()[j].getAccession())
+        TEST_EQUAL(protein_ids[i].getHits()[j].getSequence(), protein_ids_dom[i].getHits()[j].getSequence())
+      }
+    }
+
+    TEST_EQUAL(peptide_ids.size(), peptide_ids_dom.size())
+    ABORT_IF(peptide_ids.size() != peptide_ids_dom.size())
+    for (Size i = 0; i < peptide_ids.size(); ++i)
+    {
+      TEST_EQUAL(peptide_ids[i].getScoreType(), peptide_ids_dom[i].getScoreType())
+      TEST_EQUAL(peptide_ids[i].isHigherScoreBetter(), peptide_ids_dom[i].isHigherScoreBetter())
+      TEST_EQUAL(peptide_ids[i].getMetaValue("spectrum_reference"), peptide_ids_dom[i].getMetaValue("spectrum_reference"))
+      TEST_REAL_SIMILAR(peptide_ids[i].getMZ(), peptide_ids_dom[i].getMZ())
+      TEST_EQUAL(peptide_ids[i].hasRT(), peptide_ids_dom[i].hasRT())
+      TEST_EQUAL(peptide_ids[i].getHits().size(), peptide_ids_dom[i].getHits().size())
+      ABORT_IF(peptide_ids[i].getHits().size() != peptide_ids_dom[i].getHits().size())
+      for (Size j = 0; j < peptide_ids[i].getHits().size(); ++j)
+      {
+        const PeptideHit& hit = peptide_ids[i].getHits()[j];
+        const PeptideHit& hit_dom = peptide_ids_dom[i].getHits()[j];
+        TEST_EQUAL(hit.getSequence(), hit_dom.getSequence())
+        TEST_REAL_SIMILAR(hit.getScore(), hit_dom.getScore())
+        TEST_EQUAL(hit.getRank(), hit_dom.getRank())
+        TEST_EQUAL(hit.getCharge(), hit_dom.getCharge())
+        TEST_EQUAL(hit.getMetaValue(Constants::UserParam::TARGET_DECOY), hit_dom.getMetaValue(Constants::UserParam::TARGET_DECOY))
+        TEST_EQUAL(hit.extractProteinAccessionsSet() == hit_dom.extractProteinAccessionsSet(), true)
+      }
+    }
+  }
+}
+END_SECTION
+
 
 START_SECTION(([EXTRA] compability issues))
 {
@@ -41,6 +41,7 @@
 
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -982,6 +983,44 @@ START_SECTION([EXTRA] load intensity range)
 }
 END_SECTION
 
+START_SECTION([EXTRA] load with pipelined decoding)
+{
+  MzMLFile file;
+  PeakMap exp, exp_pipelined;
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  // small data pools so that several of them are decoded in the background
+  file.getOptions().setPipelinedDecoding(true);
+  file.getOptions().setMaxDataPoolSize(1);
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp_pipelined);
+
+  TEST_EQUAL(exp_pipelined.size(), exp.size())
+  TEST_EQUAL(exp_pipelined.getChromatograms().size(), exp.getChromatograms().size())
+  TEST_EQUAL(exp_pipelined == exp, true)
+}
+END_SECTION
+
+START_SECTION([EXTRA] load reuses binary data buffers between spectra)
+{
+  // with a data pool of one spectrum, the buffers of each decoded spectrum
+  // are recycled for the next one: no data may carry over
+  MzMLFile file;
+  PeakMap exp, exp_recycled;
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  file.getOptions().setMaxDataPoolSize(1);
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp_recycled);
+  TEST_EQUAL(exp_recycled == exp, true)
+  ABORT_IF(exp_recycled.size() != exp.size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp_recycled[i].getFloatDataArrays().size(), exp[i].getFloatDataArrays().size())
+    TEST_EQUAL(exp_recycled[i].getIntegerDataArrays().size(), exp[i].getIntegerDataArrays().size())
+    TEST_EQUAL(exp_recycled[i].getStringDataArrays().size(), exp[i].getStringDataArrays().size())
+  }
+}
+END_SECTION
+
 
 START_SECTION((template <typename MapType> void store(const String& filename, const MapType& map) const))
 {
@@ -1075,6 +1114,60 @@ START_SECTION((template <typename MapType> void store(const String& filename, co
 }
 END_SECTION
 
+START_SECTION([EXTRA] store with parallel encoding writes a valid index)
+{
+  PeakMap exp_original;
+  for (Size i = 0; i < 300; ++i)
+  {
+    MSSpectrum spec;
+    spec.setNativeID(String("scan=") + (i + 1));
+    spec.setRT(i * 1.5);
+    spec.setMSLevel(i % 3 == 0 ? 1 : 2);
+    for (Size k = 0; k < i % 37; ++k)
+    {
+      spec.push_back(Peak1D(100.0 + k * 10.0, (float)(i + k)));
+    }
+    exp_original.addSpectrum(spec);
+  }
+  for (Size i = 0; i < 20; ++i)
+  {
+    MSChromatogram chrom;
+    chrom.setNativeID(String("chrom_") + i);
+    for (Size k = 0; k < i; ++k)
+    {
+      chrom.push_back(ChromatogramPeak(k * 2.0, (float)k));
+    }
+    exp_original.addChromatogram(chrom);
+  }
+
+  MzMLFile file;
+  file.getOptions().setCompression(true);
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  file.store(tmp_filename, exp_original);
+
+  PeakMap exp;
+  file.load(tmp_filename, exp);
+  TEST_EQUAL(exp.size(), 300)
+  TEST_EQUAL(exp.getChromatograms().size(), 20)
+  ABORT_IF(exp.size() != 300)
+  TEST_STRING_EQUAL(exp[123].getNativeID(), "scan=124")
+  TEST_EQUAL(exp[123].size(), 123 % 37)
+
+  // random access through the index requires correct offsets of every spectrum and chromatogram
+  OnDiscPeakMap on_disc;
+  TEST_EQUAL(on_disc.openFile(tmp_filename), true)
+  TEST_EQUAL(on_disc.getNrSpectra(), 300)
+  for (Size i = 0; i < 300; i += 7)
+  {
+    MSSpectrum spec = on_disc.getSpectrum(i);
+    TEST_EQUAL(spec.size(), exp_original[i].size())
+    if (!spec.empty()) TEST_REAL_SIMILAR(spec.back().getIntensity(), exp_original[i].back().getIntensity())
+  }
+  TEST_EQUAL(on_disc.getChromatogram(19).size(), 19)
+}
+END_SECTION
+
 START_SECTION((void storeBuffer(std::string & output, const PeakMap& map) const))
 {
   MzMLFile file;
@@ -67,7 +67,7 @@ START_SECTION((~MzMLSpectrumDecoder()))
 END_SECTION
 
 // Working example of parsing a spectrum
-START_SECTION(( void domParseSpectrum(const std::string& in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
+START_SECTION(( void domParseSpectrum(std::string_view in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
 {
   ptr = new MzMLSpectrumDecoder();
   std::string testString = MULTI_LINE_STRING(
@@ -222,7 +222,7 @@ START_SECTION(([EXTRA] void domParseSpectrum(std::string& in, OpenMS::Interfaces
 END_SECTION
 
 // Working example without intensity -> simply an empty spectrum
-START_SECTION(( void domParseSpectrum(const std::string& in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
+START_SECTION(( void domParseSpectrum(std::string_view in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
 {
   ptr = new MzMLSpectrumDecoder();
   std::string testString = MULTI_LINE_STRING(
@@ -530,7 +530,7 @@ START_SECTION(([EXTRA] void domParseSpectrum(std::string& in, OpenMS::Interfaces
 END_SECTION
 
 // Working example of parsing a chromatogram
-START_SECTION(( void domParseChromatogram(const std::string& in, OpenMS::Interfaces::ChromatogramPtr & cptr) ))
+START_SECTION(( void domParseChromatogram(std::string_view in, OpenMS::Interfaces::ChromatogramPtr & cptr) ))
 {
   ptr = new MzMLSpectrumDecoder();
   std::string testString = MULTI_LINE_STRING( 
@@ -564,7 +564,7 @@ START_SECTION(( void domParseChromatogram(const std::string& in, OpenMS::Interfa
 }
 END_SECTION
 
-START_SECTION(( void domParseSpectrum(const std::string& in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
+START_SECTION(( void domParseSpectrum(std::string_view in, OpenMS::Interfaces::SpectrumPtr & sptr) ))
 {
   ptr = new MzMLSpectrumDecoder();
   std::string testString = MULTI_LINE_STRING(
@@ -606,7 +606,7 @@ START_SECTION(( void domParseSpectrum(const std::string& in, OpenMS::Interfaces:
 }
 END_SECTION
 
-START_SECTION(( void domParseChromatogram(const std::string& in, OpenMS::Interfaces::ChromatogramPtr & cptr) ))
+START_SECTION(( void domParseChromatogram(std::string_view in, OpenMS::Interfaces::ChromatogramPtr & cptr) ))
 {
   ptr = new MzMLSpectrumDecoder();
   std::string testString = MULTI_LINE_STRING( 
@@ -39,6 +39,7 @@
 #include <OpenMS/FORMAT/HANDLERS/MzMLSqliteHandler.h>
 ///////////////////////////
 
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
@@ -456,6 +457,79 @@ START_SECTION(std::vector<size_t> getSpectraIndicesbyRT(double RT, double deltaR
 }
 END_SECTION
 
+START_SECTION(std::vector<int> getSpectraIndices(double rt_min, double rt_max, int ms_level = -1, double precursor_mz_min = 0.0, double precursor_mz_max = -1.0) const)
+{
+  // MS1 spectra at RT 0, 10, 20 ... and MS2 spectra of two windows in between
+  std::vector<MSSpectrum> spectra;
+  for (int k = 0; k < 10; k++)
+  {
+    MSSpectrum s;
+    s.setRT(k * 10.0);
+    s.setMSLevel(1);
+    s.setNativeID(String("ms1_") + k);
+    s.push_back(Peak1D(400.0 + k, 100.0));
+    spectra.push_back(s);
+    for (int w = 0; w < 2; w++)
+    {
+      MSSpectrum s2;
+      s2.setRT(k * 10.0 + 2.0 + w);
+      s2.setMSLevel(2);
+      s2.setNativeID(String("ms2_") + k + "_" + w);
+      Precursor prec;
+      prec.setMZ(412.5 + w * 25.0);
+      prec.setIsolationWindowLowerOffset(12.5);
+      prec.setIsolationWindowUpperOffset(12.5);
+      s2.setPrecursors({prec});
+      s2.push_back(Peak1D(300.0 + k, 10.0));
+      spectra.push_back(s2);
+    }
+  }
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  MzMLSqliteHandler handler(tmp_filename, 12345);
+  handler.setConfig(false, false, 0.0001);
+  handler.createTables();
+  handler.writeSpectra(spectra);
+
+  // RT window only
+  std::vector<int> res = handler.getSpectraIndices(15.0, 30.0);
+  TEST_EQUAL(res.size(), 4)
+  TEST_EQUAL(res[0], 6) // ms1_2 (RT 20)
+  TEST_EQUAL(res[1], 7)
+  TEST_EQUAL(res[2], 8)
+  TEST_EQUAL(res[3], 9) // ms1_3 (RT 30)
+
+  // RT window and MS level
+  res = handler.getSpectraIndices(15.0, 30.0, 1);
+  TEST_EQUAL(res.size(), 2)
+  TEST_EQUAL(res[0], 6)
+  TEST_EQUAL(res[1], 9)
+
+  // MS level and isolation window only
+  res = handler.getSpectraIndices(1.0, 0.0, 2, 430.0, 440.0);
+  TEST_EQUAL(res.size(), 10)
+  TEST_EQUAL(res[0], 2)
+  TEST_EQUAL(res[9], 29)
+
+  // all criteria
+  res = handler.getSpectraIndices(0.0, 15.0, 2, 400.0, 420.0);
+  TEST_EQUAL(res.size(), 2)
+  TEST_EQUAL(res[0], 1)
+  TEST_EQUAL(res[1], 4) // ms2_1_0 (RT 12)
+
+  // nothing selected
+  res = handler.getSpectraIndices(0.0, 100.0, 3);
+  TEST_EQUAL(res.size(), 0)
+  res = handler.getSpectraIndices(200.0, 300.0);
+  TEST_EQUAL(res.size(), 0)
+
+  // no restriction at all
+  res = handler.getSpectraIndices(1.0, 0.0);
+  TEST_EQUAL(res.size(), 30)
+}
+END_SECTION
+
 START_SECTION(void writeExperiment(const MSExperiment & exp))
 {
   const MSExperiment exp_orig = [](){
@@ -581,6 +655,44 @@ START_SECTION(void writeSpectra(const std::vector<MSSpectrum>& spectra))
 }
 END_SECTION
 
+START_SECTION(void setWriteTuning(bool use_wal, int page_size = 0, int cache_size_kb = 0))
+{
+  MSExperiment exp_orig;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLSqliteHandler_1.mzML"), exp_orig);
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+
+  {
+    MzMLSqliteHandler handler(tmp_filename, 12345);
+    // small batches: encoding and writing of several batches overlap
+    handler.setConfig(true, false, 0.0001, 2);
+    handler.setWriteTuning(true, 8192, 16384);
+    handler.createTables();
+    handler.writeExperiment(exp_orig);
+    handler.writeSpectra(exp_orig.getSpectra());
+    TEST_EQUAL(handler.getNrSpectra(), 4)
+    TEST_EQUAL(handler.getNrChromatograms(), 1)
+
+    MSExperiment tmp;
+    handler.readExperiment(tmp, false);
+    TEST_EQUAL(tmp.getNrSpectra(), 4)
+    TEST_EQUAL(tmp[0].size(), 19914)
+    TEST_EQUAL(tmp[1].size(), 19800)
+    TEST_EQUAL(tmp[2].size(), 19914)
+    TEST_EQUAL(tmp[3].size(), 19800)
+    TEST_EQUAL(tmp[0].getNativeID(), exp_orig[0].getNativeID())
+    TEST_EQUAL(tmp[2].getNativeID(), exp_orig[0].getNativeID())
+    TEST_REAL_SIMILAR(tmp.getSpectra()[0][100].getMZ(), 204.817)
+    TEST_REAL_SIMILAR(tmp.getSpectra()[0][100].getIntensity(), 3857.86)
+    TEST_EQUAL(tmp.getChromatograms()[0].size(), 48)
+  }
+
+  // the file is self-contained after writing (no write-ahead log left behind)
+  TEST_EQUAL(File::exists(tmp_filename + "-wal"), false)
+}
+END_SECTION
+
 START_SECTION(void writeChromatograms(const std::vector<MSChromatogram>& chroms))
 {
   MSExperiment exp_orig;
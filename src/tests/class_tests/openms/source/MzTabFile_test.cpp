@@ -122,6 +122,59 @@ START_SECTION(void store(const String& filename, MzTab& mzTab) )
 }
 END_SECTION
 
+START_SECTION(void store(const String& filename, const std::vector<ProteinIdentification>& protein_identifications, const std::vector<PeptideIdentification>& peptide_identifications, bool first_run_inference_only, bool export_empty_pep_ids = false, bool export_all_psms = false, const String& title = "ID export from OpenMS"))
+{
+  // more PSMs than fit into a single formatting batch
+  vector<ProteinIdentification> prot_ids(1);
+  prot_ids[0].setIdentifier("run1");
+  prot_ids[0].setSearchEngine("SearchEngine");
+  prot_ids[0].setPrimaryMSRunPath({"file://run1.mzML"});
+  ProteinHit protein;
+  protein.setAccession("P1");
+  prot_ids[0].insertHit(protein);
+
+  const Size n_psms = 2500;
+  vector<PeptideIdentification> pep_ids(n_psms);
+  for (Size i = 0; i < n_psms; ++i)
+  {
+    pep_ids[i].setIdentifier("run1");
+    pep_ids[i].setScoreType("score");
+    pep_ids[i].setRT(double(i));
+    pep_ids[i].setMZ(500.0);
+    PeptideHit hit;
+    hit.setSequence(AASequence::fromString("PEPTIDE"));
+    hit.setScore(double(i));
+    hit.setCharge(2);
+    pep_ids[i].insertHit(hit);
+  }
+
+  String stored_mzTab;
+  NEW_TMP_FILE(stored_mzTab)
+  MzTabFile().store(stored_mzTab, prot_ids, pep_ids, false);
+
+  TextFile file;
+  file.load(stored_mzTab);
+  Size n_prt = 0, n_psh = 0, n_psm = 0;
+  bool in_order = true;
+  for (const String& line : file)
+  {
+    if (line.hasPrefix("PRT")) ++n_prt;
+    if (line.hasPrefix("PSH")) ++n_psh;
+    if (line.hasPrefix("PSM"))
+    {
+      std::vector<String> cells;
+      line.split('\t', cells);
+      if (cells.size() < 3 || cells[2] != String(n_psm)) in_order = false;
+      ++n_psm;
+    }
+  }
+  TEST_EQUAL(n_prt, 1)
+  TEST_EQUAL(n_psh, 1)
+  TEST_EQUAL(n_psm, n_psms)
+  TEST_EQUAL(in_order, true)
+}
+END_SECTION
+
 START_SECTION(~MzTabFile())
 {
   delete ptr;
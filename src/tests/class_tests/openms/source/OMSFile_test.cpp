@@ -128,6 +128,112 @@ START_SECTION(void load(const String& filename, IdentificationData& id_data))
 }
 END_SECTION
 
+START_SECTION(void load(const String& filename, IdentificationData& id_data, const LoadSelection& selection))
+{
+  // observation matches only:
+  OMSFile::LoadSelection selection;
+  selection.parent_sequences = false;
+  selection.meta_info = false;
+  IdentificationData out;
+  OMSFile().load(oms_tmp, out, selection);
+  TEST_EQUAL(out.getParentSequences().size(), 0);
+  TEST_EQUAL(out.getParentGroupSets().size(), 0);
+  TEST_EQUAL(ids.getScoreTypes().size(), out.getScoreTypes().size());
+  TEST_EQUAL(ids.getObservations().size(), out.getObservations().size());
+  TEST_EQUAL(ids.getObservationMatches().size(),
+             out.getObservationMatches().size());
+  auto it1 = ids.getObservationMatches().begin();
+  auto it2 = out.getObservationMatches().begin();
+  for (; (it1 != ids.getObservationMatches().end()) &&
+         (it2 != out.getObservationMatches().end()); ++it1, ++it2)
+  {
+    TEST_EQUAL(it1->steps_and_scores.size(),
+               it2->steps_and_scores.size());
+    TEST_EQUAL(it2->isMetaEmpty(), true);
+  }
+
+  // parent sequences only:
+  selection = OMSFile::LoadSelection();
+  selection.observation_matches = false;
+  IdentificationData parents;
+  OMSFile().load(oms_tmp, parents, selection);
+  TEST_EQUAL(ids.getParentSequences().size(),
+             parents.getParentSequences().size());
+  TEST_EQUAL(ids.getParentGroupSets().size(),
+             parents.getParentGroupSets().size());
+  TEST_EQUAL(parents.getObservations().size(), 0);
+  TEST_EQUAL(parents.getIdentifiedPeptides().size(), 0);
+  TEST_EQUAL(parents.getObservationMatches().size(), 0);
+
+  // page through the observation matches:
+  selection = OMSFile::LoadSelection();
+  selection.parent_sequences = false;
+  selection.limit = 3;
+  Size n_matches = 0;
+  for (Size page = 0; page < ids.getObservationMatches().size(); ++page)
+  {
+    selection.offset = page * selection.limit;
+    IdentificationData paged;
+    OMSFile().load(oms_tmp, paged, selection);
+    Size n_page = paged.getObservationMatches().size();
+    TEST_EQUAL(n_page <= selection.limit, true);
+    TEST_EQUAL(paged.getObservations().size() <= n_page, true);
+    n_matches += n_page;
+    if (n_page < selection.limit) break;
+  }
+  TEST_EQUAL(n_matches, ids.getObservationMatches().size());
+}
+END_SECTION
+
+START_SECTION([EXTRA] store/load of data sets larger than one insert batch)
+{
+  IdentificationData large;
+  auto file_ref = large.registerInputFile(IdentificationData::InputFile("large.mzML"));
+  auto score_ref = large.registerScoreType(IdentificationData::ScoreType("score", true));
+  const String residues = "ACDEFGHIKL";
+  const Size n = 1500;
+  double score_sum = 0.0;
+  for (Size i = 0; i < n; ++i)
+  {
+    // unique sequence per index:
+    String seq = "PEP";
+    for (char digit : String(i)) seq += residues[digit - '0'];
+    IdentificationData::ParentSequence parent("ACC" + String(i), IdentificationData::MoleculeType::PROTEIN, seq);
+    auto parent_ref = large.registerParentSequence(parent);
+    IdentificationData::IdentifiedPeptide peptide(AASequence::fromString(seq));
+    peptide.parent_matches[parent_ref].insert(IdentificationData::ParentMatch(0, seq.size() - 1));
+    auto peptide_ref = large.registerIdentifiedPeptide(peptide);
+    auto obs_ref = large.registerObservation(IdentificationData::Observation("scan=" + String(i), file_ref, double(i), 500.0));
+    IdentificationData::ObservationMatch match(peptide_ref, obs_ref, 2);
+    match.addScore(score_ref, double(i));
+    score_sum += double(i);
+    large.registerObservationMatch(match);
+  }
+  String large_tmp;
+  NEW_TMP_FILE(large_tmp);
+  OMSFile().store(large_tmp, large);
+
+  IdentificationData out;
+  OMSFile().load(large_tmp, out);
+  TEST_EQUAL(out.getParentSequences().size(), n);
+  TEST_EQUAL(out.getIdentifiedPeptides().size(), n);
+  TEST_EQUAL(out.getObservations().size(), n);
+  TEST_EQUAL(out.getObservationMatches().size(), n);
+  double loaded_sum = 0.0;
+  Size n_parent_matches = 0;
+  for (const auto& match : out.getObservationMatches())
+  {
+    loaded_sum += match.getScore(out.getScoreTypes().begin()).first;
+  }
+  for (const auto& peptide : out.getIdentifiedPeptides())
+  {
+    n_parent_matches += peptide.parent_matches.size();
+  }
+  TEST_REAL_SIMILAR(loaded_sum, score_sum);
+  TEST_EQUAL(n_parent_matches, n);
+}
+END_SECTION
+
 START_SECTION(void store(const String& filename, const FeatureMap& features))
 {
   FeatureMap features;
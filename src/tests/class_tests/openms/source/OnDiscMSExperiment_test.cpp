@@ -334,6 +334,45 @@ START_SECTION(MSMSSpectrum getSpectrumByNativeId(const std::string& id))
 }
 END_SECTION
 
+START_SECTION(void setMemoryMapped(bool memory_mapped))
+{
+  OnDiscPeakMap streamed; streamed.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+  // before and after opening the file
+  OnDiscPeakMap mapped; mapped.setMemoryMapped(true);
+  mapped.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  OnDiscPeakMap mapped2; mapped2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  mapped2.setMemoryMapped(true);
+
+  TEST_EQUAL(mapped.getNrSpectra(), 2)
+  for (Size i = 0; i < streamed.getNrSpectra(); i++)
+  {
+    TEST_EQUAL(mapped.getSpectrum(i) == streamed.getSpectrum(i), true)
+    TEST_EQUAL(mapped2.getSpectrum(i) == streamed.getSpectrum(i), true)
+  }
+  for (Size i = 0; i < streamed.getNrChromatograms(); i++)
+  {
+    TEST_EQUAL(mapped.getChromatogram(i) == streamed.getChromatogram(i), true)
+  }
+  TEST_EQUAL(mapped.getSpectrumByNativeId("controllerType=0 controllerNumber=1 scan=2").size(), 19800)
+
+  // copies share the mapping
+  OnDiscPeakMap copy(mapped);
+  TEST_EQUAL(copy.getSpectrum(1) == streamed.getSpectrum(1), true)
+
+  // concurrent access on the same object
+  Size nr_errors = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: nr_errors)
+#endif
+  for (SignedSize i = 0; i < 20; i++)
+  {
+    if (mapped.getSpectrumById(i % 2)->getMZArray()->data.size() != (i % 2 == 0 ? 19914u : 19800u)) ++nr_errors;
+  }
+  TEST_EQUAL(nr_errors, 0)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -49,6 +49,7 @@ ThisShouldFailAtCompileTime = 0
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -269,6 +270,65 @@ START_SECTION((OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::
     TEST_REAL_SIMILAR(sp->getIntensityArray()->data[1], 200.0);
     TEST_REAL_SIMILAR(sp->getMZArray()->data[2], 250.0);
     TEST_REAL_SIMILAR(sp->getIntensityArray()->data[2], 300.0);
+
+    // spectra summed around the same scan are reused (also from another scorer)
+    OpenSwathScoring sc2;
+    sc2.initialize(1.0, 1, 0.005, 0.0, su, "simple");
+    OpenSwath::SpectrumPtr sp2 = sc2.fetchSpectrumSwath(swath_ptr, 21.0, 3, 0, 0);
+    TEST_EQUAL(sp2 == sp, true)
+
+    // ... but not if they were added up differently
+    sc2.initialize(1.0, 1, 0.005, 0.0, su, "resample");
+    sp2 = sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+    TEST_EQUAL(sp2 == sp, false)
+    TEST_EQUAL(sp2->getMZArray()->data.size(), 3);
+    TEST_REAL_SIMILAR(sp2->getIntensityArray()->data[0], 360.0);
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] OpenSwath::SpectrumPtr fetchSpectrumSwath(OpenSwath::SpectrumAccessPtr swath_map, double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper))
+{
+  // spectrum with ion mobility, filtered repeatedly (the ion mobility index is used from the second request on)
+  PeakMap* eptr = new PeakMap;
+  MSSpectrum s;
+  s.getFloatDataArrays().resize(1);
+  s.getFloatDataArrays()[0].setName("Ion Mobility");
+  for (Size i = 0; i < 2000; ++i)
+  {
+    s.push_back(Peak1D(400.0 + i * 0.01, 100.0 + i));
+    s.getFloatDataArrays()[0].push_back(0.6f + float((i * 37) % 100) / 100.0f);
+  }
+  s.setRT(20.0);
+  eptr->addSpectrum(s);
+  boost::shared_ptr<PeakMap > swath_map (eptr);
+  OpenSwath::SpectrumAccessPtr swath_ptr(new SpectrumAccessOpenMSInMemory(*SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map)));
+  OpenSwath::SpectrumPtr input = swath_ptr->getSpectrumById(0);
+  const std::vector<double>& im = input->getDriftTimeArray()->data;
+
+  OpenSwathScoring sc;
+  OpenSwath_Scores_Usage su;
+  sc.initialize(1.0, 1, 0.005, 0.0, su, "simple");
+  for (Size repeat = 0; repeat < 2; ++repeat)
+  {
+    for (double lower : {0.0, 0.6, 0.75, 1.2, 1.7})
+    {
+      const double upper = lower + 0.21;
+      OpenSwath::SpectrumPtr sp = sc.fetchSpectrumSwath(swath_ptr, 20.0, 1, lower, upper);
+
+      std::vector<double> expected_mz, expected_im;
+      for (Size i = 0; i < im.size(); ++i)
+      {
+        if (im[i] > lower && im[i] < upper)
+        {
+          expected_mz.push_back(input->getMZArray()->data[i]);
+          expected_im.push_back(im[i]);
+        }
+      }
+      TEST_EQUAL(sp->getMZArray()->data == expected_mz, true)
+      TEST_EQUAL(sp->getIntensityArray()->data.size(), expected_mz.size())
+      TEST_EQUAL(sp->getDriftTimeArray()->data == expected_im, true)
+    }
   }
 }
 END_SECTION
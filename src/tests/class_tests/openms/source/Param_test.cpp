@@ -675,6 +675,77 @@ START_SECTION((const DataValue& getValue(const std::string &key) const))
 	TEST_EXCEPTION(Exception::ElementNotFound, p.getValue("key:value"))
 END_SECTION
 
+START_SECTION((double getDouble(const std::string& key) const))
+	Param p;
+	p.setValue("a:d", 1.5);
+	p.setValue("a:i", 3);
+	p.setValue("a:s", "x");
+	TEST_REAL_SIMILAR(p.getDouble("a:d"), 1.5)
+	TEST_REAL_SIMILAR(p.getDouble("a:i"), 3.0)
+	TEST_EXCEPTION(Exception::ElementNotFound, p.getDouble("a:x"))
+	TEST_EXCEPTION(Exception::ConversionError, p.getDouble("a:s"))
+END_SECTION
+
+START_SECTION((int getInt(const std::string& key) const))
+	Param p;
+	p.setValue("a:i", 3);
+	p.setValue("a:d", 1.5);
+	TEST_EQUAL(p.getInt("a:i"), 3)
+	TEST_EXCEPTION(Exception::ElementNotFound, p.getInt("i"))
+	TEST_EXCEPTION(Exception::ConversionError, p.getInt("a:d"))
+END_SECTION
+
+START_SECTION((bool getBool(const std::string& key) const))
+	Param p;
+	p.setValue("t", "true");
+	p.setValue("f", "false");
+	p.setValue("s", "yes");
+	TEST_EQUAL(p.getBool("t"), true)
+	TEST_EQUAL(p.getBool("f"), false)
+	TEST_EXCEPTION(Exception::ConversionError, p.getBool("s"))
+END_SECTION
+
+START_SECTION((std::string getString(const std::string& key) const))
+	Param p;
+	p.setValue("a:b:s", "value");
+	p.setValue("a:b:i", 3);
+	TEST_EQUAL(p.getString("a:b:s"), "value")
+	TEST_EXCEPTION(Exception::ElementNotFound, p.getString("a:b"))
+	TEST_EXCEPTION(Exception::ConversionError, p.getString("a:b:i"))
+END_SECTION
+
+START_SECTION(([EXTRA] lookups stay correct while the tree changes))
+	// repeated lookups build the hashed index; any insertion or removal must be reflected
+	Param p;
+	p.setValue("a:b:c", 1);
+	p.setValue("a:x", 2);
+	for (Size i = 0; i < 20; ++i)
+	{
+		TEST_EQUAL(p.getInt("a:b:c"), 1)
+		TEST_EQUAL(p.exists("a:b"), false)
+	}
+	for (Int i = 0; i < 100; ++i) // enough to reallocate the entries of section 'a:b'
+	{
+		p.setValue("a:b:k" + String(i), i);
+		TEST_EQUAL(p.getInt("a:b:k" + String(i)), i)
+	}
+	TEST_EQUAL(p.getInt("a:b:c"), 1)
+	p.remove("a:b:c");
+	TEST_EQUAL(p.exists("a:b:c"), false)
+	TEST_EQUAL(p.getInt("a:b:k50"), 50)
+	p.removeAll("a:b:");
+	TEST_EQUAL(p.exists("a:b:k50"), false)
+	TEST_EQUAL(p.getInt("a:x"), 2)
+
+	Param copy(p);
+	copy.setValue("a:y", 3);
+	TEST_EQUAL(copy.exists("a:y"), true)
+	TEST_EQUAL(p.exists("a:y"), false)
+	p.clear();
+	TEST_EQUAL(p.exists("a:x"), false)
+	TEST_EQUAL(copy.getInt("a:x"), 2)
+END_SECTION
+
 START_SECTION((const std::string& getSectionDescription(const std::string& key) const))
 	Param p;
 	TEST_EQUAL(p.getSectionDescription(""),"")
@@ -246,6 +246,23 @@ START_SECTION(void setMaxDataPoolSize(Size size))
 }
 END_SECTION
 
+START_SECTION(bool getPipelinedDecoding() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getPipelinedDecoding(), false);
+}
+END_SECTION
+
+START_SECTION(void setPipelinedDecoding(bool pipelined))
+{
+	PeakFileOptions tmp;
+	tmp.setPipelinedDecoding(true);
+	TEST_EQUAL(tmp.getPipelinedDecoding(), true);
+	PeakFileOptions copy(tmp);
+	TEST_EQUAL(copy.getPipelinedDecoding(), true);
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
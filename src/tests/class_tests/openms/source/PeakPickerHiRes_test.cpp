@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
@@ -207,6 +208,33 @@ START_SECTION((template <typename PeakType> void pick(const MSSpectrum& input, M
 }
 END_SECTION
 
+START_SECTION((void pick(const SoASpectrum& input, SoASpectrum& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = true) const))
+{
+  MSSpectrum aos_spec;
+  std::vector<PeakPickerHiRes::PeakBoundary> aos_boundaries;
+  pp_hires.pick(input[0], aos_spec, aos_boundaries);
+
+  SoASpectrum soa_input(input[0]), soa_spec;
+  std::vector<PeakPickerHiRes::PeakBoundary> soa_boundaries;
+  pp_hires.pick(soa_input, soa_spec, soa_boundaries);
+
+  TEST_EQUAL(soa_spec.size(), aos_spec.size())
+  TEST_EQUAL(soa_boundaries.size(), aos_boundaries.size())
+  ABORT_IF(soa_spec.size() != aos_spec.size())
+  for (Size peak_idx = 0; peak_idx < soa_spec.size(); ++peak_idx)
+  {
+    TEST_REAL_SIMILAR(soa_spec[peak_idx].getMZ(), aos_spec[peak_idx].getMZ())
+    TEST_REAL_SIMILAR(soa_spec[peak_idx].getIntensity(), aos_spec[peak_idx].getIntensity())
+  }
+  TEST_REAL_SIMILAR(soa_boundaries[25].mz_min, 359.728698730469)
+  TEST_REAL_SIMILAR(soa_boundaries[25].mz_max, 359.736419677734)
+
+  // output is replaced on the next call
+  pp_hires.pick(soa_input, soa_spec);
+  TEST_EQUAL(soa_spec.size(), aos_spec.size())
+}
+END_SECTION
+
 START_SECTION([EXTRA](template <typename PeakType> void pickExperiment(const MSExperiment<PeakType>& input, MSExperiment<PeakType>& output)))
   // does the same as pick method for spectra
   NOT_TESTABLE
@@ -520,6 +548,31 @@ START_SECTION(void pick(const MSSpectrum& input, MSSpectrum& output, std::vector
 }
 END_SECTION
 
+START_SECTION([EXTRA] pickExperiment matches spectrum-wise picking)
+{
+  // pickExperiment runs in parallel; it has to reproduce the sequential result
+  PeakMap tmp_picked;
+  std::vector<std::vector<PeakPickerHiRes::PeakBoundary> > tmp_boundaries_s;
+  std::vector<std::vector<PeakPickerHiRes::PeakBoundary> > tmp_boundaries_c;
+  PeakMap many = input;
+  for (Size rep = 0; rep < 20; ++rep) many.addSpectrum(input[0]);
+  pp_hires.pickExperiment(many, tmp_picked, tmp_boundaries_s, tmp_boundaries_c);
+
+  TEST_EQUAL(tmp_picked.size(), many.size())
+  TEST_EQUAL(tmp_boundaries_s.size(), many.size())
+  ABORT_IF(tmp_boundaries_s.size() != many.size())
+  for (Size i = 0; i < many.size(); ++i)
+  {
+    MSSpectrum single;
+    std::vector<PeakPickerHiRes::PeakBoundary> single_boundaries;
+    pp_hires.pick(many[i], single, single_boundaries);
+    TEST_EQUAL(tmp_picked[i].size(), single.size())
+    TEST_EQUAL(tmp_boundaries_s[i].size(), single_boundaries.size())
+    TEST_EQUAL(tmp_picked[i] == single, true)
+  }
+}
+END_SECTION
+
 input.clear(true);
 output.clear(true);
 
@@ -291,6 +291,25 @@ START_SECTION((void setPeakAnnotations(const vector<PeptideHit::PeakAnnotation>
   TEST_EQUAL(hit.getPeakAnnotations()[1].annotation == "second test string", true)
   TEST_EQUAL(hit.getPeakAnnotations()[1].mz == 89.1, true)
 END_SECTION
+
+START_SECTION(([EXTRA] equal sequences and accessions are shared))
+  PeptideHit a(1.0, 1, 2, AASequence::fromString("PEPT(Phospho)IDEK"));
+  PeptideHit b;
+  b.setSequence(AASequence::fromString("PEPT(Phospho)IDEK"));
+  TEST_EQUAL(&a.getSequence() == &b.getSequence(), true)
+  b.setSequence(AASequence::fromString("PEPTIDEK"));
+  TEST_EQUAL(&a.getSequence() == &b.getSequence(), false)
+  TEST_EQUAL(b.getSequence().toString(), "PEPTIDEK")
+
+  // moved-from hits keep a valid sequence
+  PeptideHit c(std::move(a));
+  TEST_EQUAL(c.getSequence().toString(), "PEPT(Phospho)IDEK")
+
+  PeptideEvidence e1("P12345", 0, 7, '[', 'K'), e2;
+  e2.setProteinAccession("P12345");
+  TEST_EQUAL(&e1.getProteinAccession() == &e2.getProteinAccession(), true)
+  TEST_EQUAL(e1 == e2, false) // positions differ
+END_SECTION
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
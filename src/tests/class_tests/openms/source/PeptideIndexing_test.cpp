@@ -39,6 +39,7 @@
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/ID/PeptideIndexing.h>
+#include <OpenMS/SYSTEM/File.h>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -111,6 +112,32 @@ START_SECTION((ExitCodes run(std::vector<FASTAFile::FASTAEntry>& proteins, std::
     TEST_EQUAL(pep_ids[0].getHits()[0].extractProteinAccessionsSet().size(), 1); // one exact hit
   }
 
+  // trie cache: the second run loads the trie built in the first one; proteins without any peptide are skipped
+  {
+    PeptideIndexing indexer;
+    Param p = indexer.getParameters();
+    p.setValue("decoy_string", "DECOY_");
+    String trie_cache;
+    NEW_TMP_FILE(trie_cache)
+    p.setValue("trie_cache", trie_cache);
+    p.setValue("missing_decoy_action", "warn");
+    indexer.setParameters(p);
+    std::vector<FASTAFile::FASTAEntry> proteins = toFASTAVec(QStringList() << "WWWWWWWW" << "AAAKEEEEKTTTK" << "DDDKEEEEK");
+    std::vector<ProteinIdentification> prot_ids;
+    std::vector<PeptideIdentification> pep_ids = toPepVec(QStringList() << "EEEEK" << "TTTK");
+    TEST_EQUAL(indexer.run(proteins, prot_ids, pep_ids), PeptideIndexing::EXECUTION_OK)
+    TEST_EQUAL(File::empty(trie_cache), false)
+    TEST_EQUAL(pep_ids[0].getHits()[0].extractProteinAccessionsSet().size(), 2);
+    TEST_EQUAL(pep_ids[1].getHits()[0].extractProteinAccessionsSet().size(), 1);
+    TEST_EQUAL(indexer.run(proteins, prot_ids, pep_ids), PeptideIndexing::EXECUTION_OK)
+    TEST_EQUAL(pep_ids[0].getHits()[0].extractProteinAccessionsSet().size(), 2);
+    TEST_EQUAL(pep_ids[1].getHits()[0].extractProteinAccessionsSet().size(), 1);
+    // different peptides: cache is rebuilt
+    pep_ids = toPepVec(QStringList() << "DDDK");
+    TEST_EQUAL(indexer.run(proteins, prot_ids, pep_ids), PeptideIndexing::EXECUTION_OK)
+    TEST_EQUAL(pep_ids[0].getHits()[0].extractProteinAccessionsSet().size(), 1);
+  }
+
   PeptideIndexing pi;
   Param p = pi.getParameters();
   PeptideIndexing::ExitCodes r;
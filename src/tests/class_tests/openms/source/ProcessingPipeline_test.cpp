@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/APPLICATIONS/ProcessingPipeline.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+#include <algorithm>
+
+///////////////////////////
+
+using namespace OpenMS;
+
+START_TEST(ProcessingPipeline, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap input;
+for (Size i = 0; i < 50; ++i)
+{
+  MSSpectrum s;
+  s.setRT(double(i));
+  for (Size k = 0; k < 20; ++k)
+  {
+    s.push_back(Peak1D(100.0 + k, float(k + 1)));
+  }
+  input.addSpectrum(s);
+}
+
+START_SECTION(ProcessingPipeline& addStep(const String& name, DataStep step))
+{
+  ProcessingPipeline pipeline;
+  TEST_EQUAL(pipeline.size(), 0)
+  pipeline.addStep("a", [](ProcessingPipeline::Data&) {}).addStep("b", [](ProcessingPipeline::Data&) {});
+  TEST_EQUAL(pipeline.size(), 2)
+}
+END_SECTION
+
+START_SECTION(ProcessingPipeline& addSpectrumStep(const String& name, SpectrumStep step))
+{
+  ProcessingPipeline pipeline;
+  pipeline.addSpectrumStep("a", [](MSSpectrum&) {});
+  TEST_EQUAL(pipeline.size(), 1)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(std::vector<String> getStepNames() const)
+{
+  ProcessingPipeline pipeline;
+  pipeline.addSpectrumStep("pick", [](MSSpectrum&) {}).addStep("features", [](ProcessingPipeline::Data&) {});
+  TEST_EQUAL(pipeline.getStepNames().size(), 2)
+  TEST_EQUAL(pipeline.getStepNames()[0], "pick")
+  TEST_EQUAL(pipeline.getStepNames()[1], "features")
+}
+END_SECTION
+
+START_SECTION(void run(Data& data) const)
+{
+  // spectrum steps run in order, data steps see the result of all previous steps
+  ProcessingPipeline pipeline;
+  Size peaks_seen = 0;
+  pipeline.addSpectrumStep("double", [](MSSpectrum& s) { for (Peak1D& p : s) p.setIntensity(p.getIntensity() * 2); })
+          .addSpectrumStep("filter", [](MSSpectrum& s) { s.erase(std::remove_if(s.begin(), s.end(), [](const Peak1D& p) { return p.getIntensity() > 20.0; }), s.end()); })
+          .addStep("count", [&peaks_seen](ProcessingPipeline::Data& d) { peaks_seen = d.experiment.getSize(); })
+          .addSpectrumStep("single", [](MSSpectrum& s) { s.resize(1); })
+          .addStep("features", [](ProcessingPipeline::Data& d) { d.features.resize(d.experiment.size()); });
+
+  ProcessingPipeline::Data data;
+  data.experiment = input;
+  pipeline.run(data);
+  TEST_EQUAL(peaks_seen, 50 * 10) // intensities 2..40, 10 are <= 20
+  TEST_EQUAL(data.experiment.size(), 50)
+  TEST_EQUAL(data.experiment.getSize(), 50)
+  TEST_REAL_SIMILAR(data.experiment[7][0].getIntensity(), 2.0)
+  TEST_EQUAL(data.features.size(), 50)
+
+  // the exception of the first failing spectrum is passed on
+  ProcessingPipeline failing;
+  failing.addSpectrumStep("fail", [](MSSpectrum& s)
+  {
+    if (s.getRT() >= 10.0) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "RT too large", String(s.getRT()));
+  });
+  data.experiment = input;
+  TEST_EXCEPTION(Exception::InvalidValue, failing.run(data))
+}
+END_SECTION
+
+START_SECTION(void run(const String& mzml_file, Data& data) const)
+{
+  PeakMap expected;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), expected);
+  for (MSSpectrum& s : expected)
+  {
+    for (Peak1D& p : s) p.setIntensity(p.getIntensity() * 2);
+  }
+
+  ProcessingPipeline pipeline;
+  Size spectra_seen = 0;
+  pipeline.addSpectrumStep("double", [](MSSpectrum& s) { for (Peak1D& p : s) p.setIntensity(p.getIntensity() * 2); })
+          .addStep("count", [&spectra_seen](ProcessingPipeline::Data& d) { spectra_seen = d.experiment.size(); });
+  ProcessingPipeline::Data data;
+  pipeline.run(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), data);
+  TEST_EQUAL(spectra_seen, expected.size())
+  ABORT_IF(data.experiment.size() != expected.size())
+  TEST_EQUAL(data.experiment.getChromatograms().size(), expected.getChromatograms().size())
+  for (Size i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(data.experiment[i].size(), expected[i].size())
+    TEST_EQUAL(data.experiment[i].getNativeID(), expected[i].getNativeID())
+    if (!expected[i].empty())
+    {
+      TEST_REAL_SIMILAR(data.experiment[i].back().getIntensity(), expected[i].back().getIntensity())
+    }
+  }
+
+  // without leading spectrum steps the file is just loaded
+  ProcessingPipeline empty;
+  ProcessingPipeline::Data data2;
+  empty.run(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), data2);
+  TEST_EQUAL(data2.experiment.size(), expected.size())
+
+  TEST_EXCEPTION(Exception::FileNotFound, empty.run("/this/file/does/not/exist.mzML", data2))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,119 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/SYSTEM/Profiler.h>
+#include <OpenMS/FORMAT/TextFile.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+
+START_TEST(Profiler, "$Id$")
+
+START_SECTION(static bool isEnabled())
+{
+  TEST_EQUAL(Profiler::isEnabled(), false)
+  Profiler::setEnabled(true);
+  TEST_EQUAL(Profiler::isEnabled(), true)
+  Profiler::setEnabled(false);
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION(static String toJSON())
+{
+  // nothing is recorded while disabled
+  {
+    OPENMS_PROFILE_SCOPE("disabled");
+    Profiler::addCounter("ignored", 1);
+  }
+  TEST_EQUAL(Profiler::toJSON(), "[]")
+
+  Profiler::setEnabled(true);
+  {
+    OPENMS_PROFILE_SCOPE("tool");
+    for (int i = 0; i < 3; ++i)
+    {
+      OPENMS_PROFILE_SCOPE("load");
+      Profiler::addCounter("spectra", 10);
+    }
+    OPENMS_PROFILE_SCOPE("pick");
+  }
+  String json = Profiler::toJSON();
+  TEST_EQUAL(json.hasSubstring("\"name\": \"tool\""), true)
+  TEST_EQUAL(json.hasSubstring("\"name\": \"load\""), true)
+  TEST_EQUAL(json.hasSubstring("\"name\": \"pick\""), true)
+  // the three 'load' scopes are merged into one stage
+  TEST_EQUAL(json.hasSubstring("\"calls\": 3"), true)
+  TEST_EQUAL(json.hasSubstring("\"spectra\": 30"), true)
+  TEST_EQUAL(json.hasSubstring("wall_time_s"), true)
+  TEST_EQUAL(json.hasSubstring("peak_memory_kb"), true)
+  // 'load' and 'pick' are children of 'tool'
+  TEST_EQUAL(json.find("\"tool\"") < json.find("\"load\""), true)
+  TEST_EQUAL(json.find("\"load\"") < json.find("\"pick\""), true)
+
+  Profiler::clear();
+  TEST_EQUAL(Profiler::toJSON(), "[]")
+  Profiler::setEnabled(false);
+}
+END_SECTION
+
+START_SECTION(static void storeJSON(const String& filename, const std::map<String, String>& info = std::map<String, String>()))
+{
+  Profiler::setEnabled(true);
+  {
+    OPENMS_PROFILE_SCOPE("stage");
+  }
+  String filename;
+  NEW_TMP_FILE(filename)
+  Profiler::storeJSON(filename, {{"tool", "Profiler_test"}});
+  Profiler::setEnabled(false);
+
+  TextFile tf(filename);
+  String content;
+  for (const String& line : tf) content += line;
+  TEST_EQUAL(content.hasSubstring("\"tool\": \"Profiler_test\""), true)
+  TEST_EQUAL(content.hasSubstring("\"stages\""), true)
+  TEST_EQUAL(content.hasSubstring("\"name\": \"stage\""), true)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, Profiler::storeJSON("/does/not/exist/profile.json"))
+}
+END_SECTION
+
+END_TEST
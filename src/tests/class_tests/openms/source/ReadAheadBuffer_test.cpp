@@ -0,0 +1,162 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace OpenMS;
+using namespace std;
+
+/// Source producing @p total bytes (at most @p max_read per call, like a decompressor with short reads)
+struct TestSource
+{
+  size_t total;
+  size_t max_read;
+  size_t pos = 0;
+
+  size_t operator()(char* s, size_t n)
+  {
+    size_t k = std::min(std::min(n, total - pos), max_read);
+    for (size_t i = 0; i < k; ++i)
+    {
+      s[i] = char('a' + (pos + i) % 26);
+    }
+    pos += k;
+    return k;
+  }
+};
+
+START_TEST(ReadAheadBuffer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ReadAheadBuffer* ptr = nullptr;
+ReadAheadBuffer* nullPointer = nullptr;
+
+START_SECTION((explicit ReadAheadBuffer(ReadFunction read_function, size_t chunk_size = 1 << 20, size_t max_chunks_ahead = 2)))
+{
+  ptr = new ReadAheadBuffer(TestSource{100, 100});
+  TEST_NOT_EQUAL(ptr, nullPointer)
+}
+END_SECTION
+
+START_SECTION((~ReadAheadBuffer()))
+{
+  delete ptr;
+
+  // an endless source is stopped
+  ReadAheadBuffer* endless = new ReadAheadBuffer([](char* s, size_t n) { std::fill(s, s + n, 'x'); return n; }, 16);
+  char buffer[4];
+  TEST_EQUAL(endless->read(buffer, 4), 4)
+  delete endless;
+}
+END_SECTION
+
+START_SECTION((size_t read(char* s, size_t n)))
+{
+  // different chunk sizes and short reads of the source
+  for (size_t chunk_size : {1, 7, 64, 4096})
+  {
+    ReadAheadBuffer reader(TestSource{1000, 13}, chunk_size);
+    string result;
+    char buffer[100];
+    size_t n;
+    while ((n = reader.read(buffer, sizeof(buffer))) > 0)
+    {
+      result.append(buffer, n);
+    }
+    TEST_EQUAL(result.size(), 1000)
+    TEST_EQUAL(result.substr(0, 5), "abcde")
+    TEST_EQUAL(result[999], char('a' + 999 % 26))
+    TEST_EQUAL(reader.read(buffer, sizeof(buffer)), 0)
+  }
+
+  // only the last read is short
+  {
+    ReadAheadBuffer reader(TestSource{25, 25}, 8);
+    char buffer[10];
+    TEST_EQUAL(reader.read(buffer, 10), 10)
+    TEST_EQUAL(reader.read(buffer, 10), 10)
+    TEST_EQUAL(reader.read(buffer, 10), 5)
+  }
+
+  // empty input
+  {
+    ReadAheadBuffer reader(TestSource{0, 10});
+    char buffer[10];
+    TEST_EQUAL(reader.read(buffer, 10), 0)
+    TEST_EQUAL(reader.streamEnd(), true)
+  }
+
+  // errors of the source are passed on after the data read before
+  {
+    int calls = 0;
+    ReadAheadBuffer reader([&calls](char* s, size_t n) -> size_t
+    {
+      if (calls++ == 2) throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "corrupted");
+      std::fill(s, s + n, 'x');
+      return n;
+    }, 10);
+    char buffer[30];
+    TEST_EQUAL(reader.read(buffer, 20), 20)
+    TEST_EXCEPTION(Exception::ConversionError, reader.read(buffer, 30))
+  }
+}
+END_SECTION
+
+START_SECTION((bool streamEnd() const))
+{
+  ReadAheadBuffer reader(TestSource{10, 10});
+  TEST_EQUAL(reader.streamEnd(), false)
+  char buffer[20];
+  TEST_EQUAL(reader.read(buffer, 5), 5)
+  TEST_EQUAL(reader.streamEnd(), false)
+  TEST_EQUAL(reader.read(buffer, 20), 5)
+  TEST_EQUAL(reader.streamEnd(), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -157,6 +157,85 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
 END_SECTION
 
+START_SECTION((void filterChromatograms(std::vector<MSChromatogram> & chromatograms) const))
+{
+  Param p_sg;
+  p_sg.setValue("frame_length", 7);
+  p_sg.setValue("polynomial_order", 3);
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(p_sg);
+
+  // chromatograms of different lengths, including one shorter than the frame
+  std::vector<MSChromatogram> chromatograms(25);
+  for (Size c = 0; c < chromatograms.size(); ++c)
+  {
+    chromatograms[c].setNativeID(String(c));
+    for (Size i = 0; i < 3 + 2 * c; ++i)
+    {
+      chromatograms[c].push_back(ChromatogramPeak(10.0 + i, 100.0 * std::exp(-std::pow(double(i) - double(c), 2) / 8.0) + double((i * 7 + c) % 5)));
+    }
+  }
+  std::vector<MSChromatogram> expected = chromatograms;
+  for (MSChromatogram& chrom : expected)
+  {
+    MSChromatogram output = chrom;
+    sgolay.filter(chrom.begin(), chrom.end(), output.begin()); // reference implementation
+    chrom = output;
+  }
+
+  sgolay.filterChromatograms(chromatograms);
+  ABORT_IF(chromatograms.size() != expected.size())
+  for (Size c = 0; c < chromatograms.size(); ++c)
+  {
+    TEST_EQUAL(chromatograms[c].getNativeID(), String(c))
+    TEST_EQUAL(chromatograms[c].size(), expected[c].size())
+    for (Size i = 0; i < chromatograms[c].size(); ++i)
+    {
+      TEST_REAL_SIMILAR(chromatograms[c][i].getRT(), expected[c][i].getRT())
+      TEST_REAL_SIMILAR(chromatograms[c][i].getIntensity(), expected[c][i].getIntensity())
+    }
+  }
+
+  // filter(MSChromatogram&) uses the same in-place implementation
+  MSChromatogram single = expected.back();
+  chromatograms.back() = single;
+  sgolay.filter(single);
+  sgolay.filterChromatograms(chromatograms);
+  TEST_EQUAL(single == chromatograms.back(), true)
+}
+END_SECTION
+
+START_SECTION((void smoothIntensities(const std::vector<double> & intensities, std::vector<double> & smoothed) const))
+{
+  Param p_sg;
+  p_sg.setValue("frame_length", 5);
+  p_sg.setValue("polynomial_order", 2);
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(p_sg);
+
+  std::vector<double> smoothed;
+  for (Size n : {3, 5, 12})
+  {
+    MSSpectrum spectrum;
+    std::vector<double> intensities;
+    for (Size i = 0; i < n; ++i)
+    {
+      intensities.push_back(50.0 * std::exp(-std::pow(double(i) - 5.0, 2) / 6.0) + double((i * 3) % 4));
+      spectrum.push_back(Peak1D(100.0 + i, intensities.back()));
+    }
+    sgolay.filter(spectrum);
+    sgolay.smoothIntensities(intensities, smoothed);
+
+    // same values as filter(), short data is left unchanged
+    TEST_EQUAL(smoothed.size(), n)
+    for (Size i = 0; i < n; ++i)
+    {
+      TEST_EQUAL(smoothed[i], spectrum[i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
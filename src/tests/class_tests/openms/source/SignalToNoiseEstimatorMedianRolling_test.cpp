@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+#include <OpenMS/FORMAT/DTAFile.h>
+
+///////////////////////////
+#include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedianRolling.h>
+///////////////////////////
+
+#include <algorithm>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SignalToNoiseEstimatorMedianRolling, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SignalToNoiseEstimatorMedianRolling< >* ptr = nullptr;
+SignalToNoiseEstimatorMedianRolling< >* nullPointer = nullptr;
+START_SECTION((SignalToNoiseEstimatorMedianRolling()))
+	ptr = new SignalToNoiseEstimatorMedianRolling<>;
+	TEST_NOT_EQUAL(ptr, nullPointer)
+END_SECTION
+
+START_SECTION((SignalToNoiseEstimatorMedianRolling& operator=(const SignalToNoiseEstimatorMedianRolling &source)))
+  MSSpectrum raw_data;
+  SignalToNoiseEstimatorMedianRolling<> sne;
+	sne.init(raw_data);
+  SignalToNoiseEstimatorMedianRolling<> sne2;
+  sne2 = sne;
+	NOT_TESTABLE
+END_SECTION
+
+START_SECTION((SignalToNoiseEstimatorMedianRolling(const SignalToNoiseEstimatorMedianRolling &source)))
+  MSSpectrum raw_data;
+  SignalToNoiseEstimatorMedianRolling<> sne;
+	sne.init(raw_data);
+  SignalToNoiseEstimatorMedianRolling<> sne2(sne);
+	NOT_TESTABLE
+END_SECTION
+
+START_SECTION((virtual ~SignalToNoiseEstimatorMedianRolling()))
+	delete ptr;
+END_SECTION
+
+START_SECTION([EXTRA](virtual void init(const Container& c)))
+{
+  MSSpectrum raw_data;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimator_test.dta"), raw_data);
+
+  Param p;
+  p.setValue("win_len", 40.0);
+  p.setValue("noise_for_empty_window", 2.0);
+  p.setValue("min_required_elements", 10);
+  p.setValue("write_log_messages", "false");
+
+  SignalToNoiseEstimatorMedianRolling< MSSpectrum > sne;
+  sne.setParameters(p);
+  sne.init(raw_data);
+
+  // compare against a brute force median of each window
+  for (Size i = 0; i < raw_data.size(); ++i)
+  {
+    std::vector<double> window;
+    for (const Peak1D& peak : raw_data)
+    {
+      if (peak.getMZ() >= raw_data[i].getMZ() - 20.0 && peak.getMZ() <= raw_data[i].getMZ() + 20.0)
+      {
+        window.push_back(peak.getIntensity());
+      }
+    }
+    double noise = 2.0;
+    if (window.size() >= 10)
+    {
+      std::sort(window.begin(), window.end());
+      noise = std::max(1.0, window[(window.size() + 1) / 2 - 1]);
+    }
+    TEST_REAL_SIMILAR(sne.getSignalToNoise(i), raw_data[i].getIntensity() / noise)
+  }
+}
+END_SECTION
+
+START_SECTION((double getSparseWindowPercent() const))
+{
+  MSSpectrum spec;
+  for (Size i = 0; i < 10; ++i)
+  {
+    spec.push_back(Peak1D(100.0 + i, 10.0 * (i + 1)));
+  }
+  spec.push_back(Peak1D(1000.0, 50.0)); // isolated data point
+  spec.push_back(Peak1D(2000.0, 50.0)); // isolated data point
+
+  Param p;
+  p.setValue("win_len", 40.0);
+  p.setValue("noise_for_empty_window", 5.0);
+  p.setValue("min_required_elements", 5);
+  p.setValue("write_log_messages", "false");
+
+  SignalToNoiseEstimatorMedianRolling<> sne;
+  sne.setParameters(p);
+  sne.init(spec);
+  // the ten data points share one window with intensities 10..100 -> lower median 50
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(0), 10.0 / 50.0)
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(9), 100.0 / 50.0)
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(10), 50.0 / 5.0)
+  TEST_REAL_SIMILAR(sne.getSparseWindowPercent(), 2.0 * 100 / 12)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
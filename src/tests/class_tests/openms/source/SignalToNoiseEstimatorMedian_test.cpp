@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/DTAFile.h>
+#include <OpenMS/KERNEL/SoASpectrum.h>
 
 ///////////////////////////
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
@@ -114,6 +115,30 @@ START_SECTION([EXTRA](virtual void init(const Container& c)))
 
 END_SECTION
 
+START_SECTION([EXTRA](virtual void init(const Container& c) with Container = SoASpectrum))
+{
+  MSSpectrum raw_data;
+  DTAFile dta_file;
+  dta_file.load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimator_test.dta"), raw_data);
+
+  Param p;
+  p.setValue("win_len", 40.0);
+  p.setValue("noise_for_empty_window", 2.0);
+  p.setValue("min_required_elements", 10);
+
+  SignalToNoiseEstimatorMedian< SoASpectrum > sne;
+  sne.setParameters(p);
+  sne.init(SoASpectrum(raw_data));
+
+  MSSpectrum stn_data;
+  dta_file.load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimatorMedian_test.out"), stn_data);
+  for (Size i = 0; i < raw_data.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(stn_data[i].getIntensity(), sne.getSignalToNoise(i));
+  }
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
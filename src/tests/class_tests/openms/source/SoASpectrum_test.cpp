@@ -0,0 +1,217 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/SoASpectrum.h>
+///////////////////////////
+
+#include <OpenMS/IONMOBILITY/IMTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SoASpectrum, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSSpectrum spec;
+spec.setRT(12.5);
+spec.push_back(Peak1D(412.0, 10.0f));
+spec.push_back(Peak1D(400.0, 20.0f));
+spec.push_back(Peak1D(405.0, 30.0f));
+spec.getFloatDataArrays().resize(1);
+spec.getFloatDataArrays()[0].setName("width");
+spec.getFloatDataArrays()[0].assign({1.0f, 2.0f, 3.0f});
+
+SoASpectrum* ptr = nullptr;
+SoASpectrum* null_ptr = nullptr;
+START_SECTION(SoASpectrum())
+{
+  ptr = new SoASpectrum();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION(~SoASpectrum())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit SoASpectrum(const MSSpectrum& spectrum))
+{
+  SoASpectrum soa(spec);
+  TEST_EQUAL(soa.size(), 3)
+  TEST_REAL_SIMILAR(soa[0].getMZ(), 412.0)
+  TEST_REAL_SIMILAR(soa[1].getIntensity(), 20.0)
+  TEST_EQUAL(soa.getFloatDataArrays().size(), 1)
+  TEST_EQUAL(soa.getFloatDataArrays()[0].getName(), "width")
+
+  // arrays are aligned to cache lines
+  TEST_EQUAL(reinterpret_cast<std::uintptr_t>(soa.getMZArray().data()) % 64, 0)
+  TEST_EQUAL(reinterpret_cast<std::uintptr_t>(soa.getIntensityArray().data()) % 64, 0)
+}
+END_SECTION
+
+START_SECTION(void assign(const MSSpectrum& spectrum))
+{
+  SoASpectrum soa;
+  soa.push_back(1.0, 1.0f);
+  soa.assign(spec);
+  TEST_EQUAL(soa == SoASpectrum(spec), true)
+}
+END_SECTION
+
+START_SECTION(void exportTo(MSSpectrum& spectrum) const)
+{
+  SoASpectrum soa(spec);
+  soa[0].setIntensity(99.0f);
+  MSSpectrum out = spec;
+  soa.exportTo(out);
+  TEST_EQUAL(out.size(), 3)
+  TEST_REAL_SIMILAR(out[0].getIntensity(), 99.0)
+  TEST_REAL_SIMILAR(out[2].getMZ(), 405.0)
+  // meta data is kept
+  TEST_REAL_SIMILAR(out.getRT(), 12.5)
+
+  soa.clear();
+  soa.exportTo(out);
+  TEST_EQUAL(out.size(), 0)
+  TEST_EQUAL(out.getFloatDataArrays().size(), 0)
+}
+END_SECTION
+
+START_SECTION(bool operator==(const SoASpectrum& rhs) const)
+{
+  SoASpectrum a(spec), b(spec);
+  TEST_EQUAL(a == b, true)
+  b[1].setMZ(401.0);
+  TEST_EQUAL(a == b, false)
+  TEST_EQUAL(a != b, true)
+}
+END_SECTION
+
+START_SECTION(void push_back(const PeakType& peak))
+{
+  SoASpectrum soa;
+  soa.push_back(Peak1D(100.0, 5.0f));
+  soa.push_back(200.0, 6.0f);
+  TEST_EQUAL(soa.size(), 2)
+  TEST_REAL_SIMILAR(soa.getMZArray()[1], 200.0)
+  TEST_REAL_SIMILAR(soa.getIntensityArray()[0], 5.0)
+}
+END_SECTION
+
+START_SECTION(PeakRef operator[](Size index))
+{
+  SoASpectrum soa(spec);
+  soa[2] = Peak1D(500.0, 1.0f);
+  TEST_REAL_SIMILAR(soa.getMZArray()[2], 500.0)
+  TEST_REAL_SIMILAR(soa.getIntensityArray()[2], 1.0)
+  Peak1D p = soa[1];
+  TEST_REAL_SIMILAR(p.getMZ(), 400.0)
+  TEST_REAL_SIMILAR(p.getIntensity(), 20.0)
+}
+END_SECTION
+
+START_SECTION(ConstIterator begin() const)
+{
+  const SoASpectrum soa(spec);
+  TEST_EQUAL(soa.end() - soa.begin(), 3)
+  auto max_it = std::max_element(soa.begin(), soa.end(), [](const Peak1D& a, const Peak1D& b) { return a.getIntensity() < b.getIntensity(); });
+  TEST_EQUAL(max_it.getIndex(), 2)
+  TEST_REAL_SIMILAR(max_it->getMZ(), 405.0)
+
+  double sum = 0;
+  for (const auto& p : soa)
+  {
+    sum += p.getIntensity();
+  }
+  TEST_REAL_SIMILAR(sum, 60.0)
+  TEST_REAL_SIMILAR(soa.begin()[1].getMZ(), 400.0)
+}
+END_SECTION
+
+START_SECTION(void sortByPosition())
+{
+  SoASpectrum soa(spec);
+  TEST_EQUAL(soa.isSorted(), false)
+  soa.sortByPosition();
+  TEST_EQUAL(soa.isSorted(), true)
+  TEST_REAL_SIMILAR(soa[0].getMZ(), 400.0)
+  TEST_REAL_SIMILAR(soa[0].getIntensity(), 20.0)
+  TEST_REAL_SIMILAR(soa[2].getMZ(), 412.0)
+  TEST_REAL_SIMILAR(soa[2].getIntensity(), 10.0)
+  // float data arrays are permuted as well
+  TEST_REAL_SIMILAR(soa.getFloatDataArrays()[0][0], 2.0)
+  TEST_REAL_SIMILAR(soa.getFloatDataArrays()[0][2], 1.0)
+
+  // same order as MSSpectrum::sortByPosition
+  MSSpectrum sorted = spec;
+  sorted.sortByPosition();
+  TEST_EQUAL(soa == SoASpectrum(sorted), true)
+}
+END_SECTION
+
+START_SECTION(bool containsIMData() const)
+{
+  SoASpectrum soa(spec);
+  TEST_EQUAL(soa.containsIMData(), false)
+  TEST_EXCEPTION(Exception::MissingInformation, soa.getIMData())
+
+  MSSpectrum im_spec = spec;
+  im_spec.getFloatDataArrays().resize(2);
+  im_spec.getFloatDataArrays()[1].setName("Ion Mobility");
+  im_spec.getFloatDataArrays()[1].assign({0.9f, 1.0f, 1.1f});
+  TEST_EQUAL(im_spec.containsIMData(), true)
+  soa.assign(im_spec);
+  TEST_EQUAL(soa.containsIMData(), true)
+  TEST_EQUAL(soa.getIMData().first, 1)
+  TEST_EQUAL(soa.getIMData().second == im_spec.getIMData().second, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -144,6 +144,55 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
     TEST_EQUAL(exp[i].getMSLevel (), exp2[i].getMSLevel ())
   }
 
+  // clusters are transitive (single linkage): A-B and B-C are within tolerance, A-C is not
+  {
+    PeakMap chain;
+    const double rts[] = {10.0, 14.0, 18.0, 100.0, 12.0};
+    const double mzs[] = {500.0, 500.0, 500.0, 500.0, 600.0};
+    for (Size i = 0; i < 5; ++i)
+    {
+      MSSpectrum s;
+      s.setMSLevel(2);
+      s.setRT(rts[i]);
+      Precursor prec;
+      prec.setMZ(mzs[i]);
+      s.getPrecursors().push_back(prec);
+      Peak1D peak;
+      peak.setMZ(200.0 + i);
+      peak.setIntensity(1.0f);
+      s.push_back(peak);
+      chain.addSpectrum(s);
+    }
+    MSSpectrum ms1;
+    ms1.setMSLevel(1);
+    ms1.setRT(11.0);
+    chain.addSpectrum(ms1);
+
+    Param pc;
+    pc.setValue("mz_binning_width", 0.3);
+    pc.setValue("mz_binning_width_unit", "Da");
+    pc.setValue("precursor_method:mz_tolerance", 0.01);
+    pc.setValue("precursor_method:rt_tolerance", 5.0);
+    SpectraMerger chain_merger;
+    chain_merger.setParameters(pc);
+    chain_merger.mergeSpectraPrecursors(chain);
+
+    // MS1 + merged (10, 14, 18) + two singletons
+    TEST_EQUAL(chain.size(), 4)
+    ABORT_IF(chain.size() != 4)
+    Size merged_count(0);
+    for (const MSSpectrum& s : chain)
+    {
+      if (s.getMSLevel() == 2 && s.size() == 3)
+      {
+        ++merged_count;
+        TEST_REAL_SIMILAR(s.getRT(), 14.0)
+        TEST_REAL_SIMILAR(s.getPrecursors()[0].getMZ(), 500.0)
+      }
+    }
+    TEST_EQUAL(merged_count, 1)
+  }
+
 END_SECTION
 
 START_SECTION((template < typename MapType > void averageGaussian(MapType &exp)))
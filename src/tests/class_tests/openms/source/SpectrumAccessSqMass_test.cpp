@@ -147,6 +147,36 @@ START_SECTION(size_t getNrSpectra() const)
 }
 END_SECTION
 
+START_SECTION(std::vector<std::size_t> getSpectraByRange(double rt_min, double rt_max, int ms_level = -1, double precursor_mz_min = 0.0, double precursor_mz_max = -1.0) const)
+{
+  OpenMS::Internal::MzMLSqliteHandler handler(OPENMS_GET_TEST_DATA_PATH("SqliteMassFile_1.sqMass"), 0);
+
+  {
+    SpectrumAccessSqMass sa(handler);
+    std::vector<std::size_t> res = sa.getSpectraByRange(0.0, 1.0);
+    TEST_EQUAL(res.size(), 2)
+    TEST_EQUAL(res[0], 0)
+    TEST_EQUAL(res[1], 1)
+
+    res = sa.getSpectraByRange(0.4, 0.5);
+    TEST_EQUAL(res.size(), 1)
+    TEST_EQUAL(res[0], 1)
+
+    res = sa.getSpectraByRange(2.0, 3.0);
+    TEST_EQUAL(res.size(), 0)
+  }
+
+  // indices are relative to the subset
+  {
+    std::vector<int> indices = {1};
+    SpectrumAccessSqMass sa(handler, indices);
+    std::vector<std::size_t> res = sa.getSpectraByRange(0.0, 1.0);
+    TEST_EQUAL(res.size(), 1)
+    TEST_EQUAL(res[0], 0)
+  }
+}
+END_SECTION
+
 START_SECTION(boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const)
 {
   OpenMS::Internal::MzMLSqliteHandler handler(OPENMS_GET_TEST_DATA_PATH("SqliteMassFile_1.sqMass"), 0);
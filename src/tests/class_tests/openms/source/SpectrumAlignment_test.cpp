@@ -191,6 +191,72 @@ START_SECTION(template <typename SpectrumType> void getSpectrumAlignment(std::ve
 
 END_SECTION
 
+START_SECTION((template <typename SpectrumType1, typename SpectrumType2> void getSpectrumAlignment(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2, Workspace& ws) const))
+{
+  PeakSpectrum s1, s2, s3, s4;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s2);
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("SpectrumAlignment_in1.dta"), s3);
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("SpectrumAlignment_in2.dta"), s4);
+
+  SpectrumAlignment sas1;
+  Param p;
+  p.setValue("tolerance", 1.01);
+  sas1.setParameters(p);
+
+  // the same workspace is reused for differently sized inputs
+  SpectrumAlignment::Workspace ws;
+  vector<pair<Size, Size > > alignment, expected;
+  sas1.getSpectrumAlignment(alignment, s1, s2, ws);
+  sas1.getSpectrumAlignment(expected, s1, s2);
+  TEST_EQUAL(alignment == expected, true)
+
+  sas1.getSpectrumAlignment(alignment, s3, s4, ws);
+  TEST_EQUAL(alignment.size(), 5)
+  ABORT_IF(alignment.size() != 5)
+  TEST_EQUAL(alignment[2].first, 3)
+  TEST_EQUAL(alignment[3].first, 4)
+  TEST_EQUAL(alignment[3].second, 5)
+
+  sas1.getSpectrumAlignment(alignment, s1, s2, ws);
+  TEST_EQUAL(alignment == expected, true)
+
+  SpectrumAlignment::getBandedAlignment(alignment, s3, s4, 1.01, ws);
+  TEST_EQUAL(alignment.size(), 5)
+
+  // empty input
+  PeakSpectrum empty;
+  sas1.getSpectrumAlignment(alignment, empty, s4, ws);
+  TEST_EQUAL(alignment.size(), 0)
+}
+END_SECTION
+
+START_SECTION((template <typename SpectrumType1, typename SpectrumType2> static void getClosestPeakMatches(std::vector<std::pair<Size, Size> >& alignment, const SpectrumType1& s1, const SpectrumType2& s2, double tolerance, bool tolerance_ppm)))
+{
+  PeakSpectrum s1, s2;
+  for (double mz : {100.0, 200.0, 300.0, 400.0}) { s1.push_back(Peak1D(mz, 1.0)); }
+  for (double mz : {100.05, 199.7, 200.2, 300.5, 400.001}) { s2.push_back(Peak1D(mz, 1.0)); }
+
+  vector<pair<Size, Size > > alignment;
+  SpectrumAlignment::getClosestPeakMatches(alignment, s1, s2, 0.3, false);
+  TEST_EQUAL(alignment.size(), 3)
+  ABORT_IF(alignment.size() != 3)
+  TEST_EQUAL(alignment[0].first, 0)
+  TEST_EQUAL(alignment[0].second, 0)
+  TEST_EQUAL(alignment[1].first, 1)
+  TEST_EQUAL(alignment[1].second, 2)
+  TEST_EQUAL(alignment[2].first, 3)
+  TEST_EQUAL(alignment[2].second, 4)
+
+  // 10 ppm: only the peak at 400.001 is close enough
+  SpectrumAlignment::getClosestPeakMatches(alignment, s1, s2, 10.0, true);
+  TEST_EQUAL(alignment.size(), 1)
+  ABORT_IF(alignment.size() != 1)
+  TEST_EQUAL(alignment[0].first, 3)
+  TEST_EQUAL(alignment[0].second, 4)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -160,6 +160,15 @@ START_SECTION((static Int extractScanNumber(const String&,
   TEST_EQUAL(SpectrumLookup::extractScanNumber("scan=42", re, true), -1);
 
   TEST_EXCEPTION(Exception::ParseError, SpectrumLookup::extractScanNumber("scan=42", re));
+
+  // the default expression is evaluated without the regex engine - results must not differ
+  boost::regex def_re(SpectrumLookup::default_scan_regexp);
+  boost::regex same_re("=(?<SCAN>[0-9]+)$");
+  for (const String& native_id : {"scan=42", "controllerType=0 controllerNumber=1 scan=7", "index=0", "scan=42 ", "42", "=", "scan=", "a=1 b=x", "spectrum=12a", "=99999999999999999999"})
+  {
+    TEST_EQUAL(SpectrumLookup::extractScanNumber(native_id, def_re, true), SpectrumLookup::extractScanNumber(native_id, same_re, true));
+  }
+  TEST_EXCEPTION(Exception::ParseError, SpectrumLookup::extractScanNumber("scan=", def_re));
 }
 END_SECTION
 
@@ -0,0 +1,185 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FILTERING/TRANSFORMERS/SpectrumPreprocessingPipeline.h>
+#include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/Deisotoper.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/SqrtMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ThresholdMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(SpectrumPreprocessingPipeline, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+// test spectrum with distinct intensities (no ties) and a few isotopic patterns
+PeakSpectrum input;
+for (Size i = 0; i < 600; ++i)
+{
+  Peak1D p;
+  p.setMZ(100.0 + i * 3.17 + (i % 7) * 0.13);
+  p.setIntensity(float(((i * 7919) % 1009) + 1) / 100.0f);
+  input.push_back(p);
+}
+for (Size k = 0; k < 3; ++k)
+{
+  Peak1D p;
+  p.setMZ(500.5 + k * Constants::C13C12_MASSDIFF_U);
+  p.setIntensity(50.0f - k * 10.0f);
+  input.push_back(p);
+}
+input.sortByPosition();
+
+SpectrumPreprocessingPipeline* e_ptr = nullptr;
+SpectrumPreprocessingPipeline* e_nullPointer = nullptr;
+START_SECTION((SpectrumPreprocessingPipeline()))
+  e_ptr = new SpectrumPreprocessingPipeline;
+  TEST_NOT_EQUAL(e_ptr, e_nullPointer)
+END_SECTION
+
+START_SECTION((~SpectrumPreprocessingPipeline()))
+  delete e_ptr;
+END_SECTION
+
+e_ptr = new SpectrumPreprocessingPipeline();
+
+START_SECTION((SpectrumPreprocessingPipeline(const SpectrumPreprocessingPipeline& source)))
+  SpectrumPreprocessingPipeline copy(*e_ptr);
+  TEST_EQUAL(copy.getParameters(), e_ptr->getParameters())
+  TEST_EQUAL(copy.getName(), e_ptr->getName())
+END_SECTION
+
+START_SECTION((SpectrumPreprocessingPipeline& operator=(const SpectrumPreprocessingPipeline& source)))
+  SpectrumPreprocessingPipeline copy;
+  copy = *e_ptr;
+  TEST_EQUAL(copy.getParameters(), e_ptr->getParameters())
+  TEST_EQUAL(copy.getName(), e_ptr->getName())
+END_SECTION
+
+START_SECTION((void filterPeakSpectrum(PeakSpectrum& spectrum) const))
+{
+  // reference: the individual filters one after the other
+  PeakSpectrum expected = input;
+  ThresholdMower().filterPeakSpectrum(expected);
+  Normalizer().filterPeakSpectrum(expected);
+  Deisotoper::deisotopeAndSingleCharge(expected, 0.01, false, 1, 3, false, 3, 10, true);
+  WindowMower window_mower;
+  Param wp = window_mower.getParameters();
+  wp.setValue("windowsize", 100.0);
+  wp.setValue("peakcount", 20);
+  wp.setValue("movetype", "jump");
+  window_mower.setParameters(wp);
+  window_mower.filterPeakSpectrum(expected);
+  NLargest(150).filterPeakSpectrum(expected);
+  SqrtMower().filterPeakSpectrum(expected);
+  expected.sortByPosition();
+
+  SpectrumPreprocessingPipeline pipeline;
+  Param p = pipeline.getParameters();
+  p.setValue("steps", std::vector<std::string>{"threshold", "normalize", "deisotope", "window_mower", "nlargest", "sqrt"});
+  p.setValue("deisotope:fragment_tolerance", 0.01);
+  p.setValue("deisotope:fragment_unit", "Da");
+  p.setValue("nlargest:n", 150);
+  pipeline.setParameters(p);
+
+  PeakSpectrum spec = input;
+  pipeline.filterPeakSpectrum(spec);
+
+  TEST_EQUAL(spec.size(), expected.size())
+  ABORT_IF(spec.size() != expected.size())
+  TEST_EQUAL(spec.isSorted(), true)
+  for (Size i = 0; i < spec.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(spec[i].getMZ(), expected[i].getMZ())
+    TEST_REAL_SIMILAR(spec[i].getIntensity(), expected[i].getIntensity())
+  }
+
+  // order of steps matters: nlargest only
+  p.setValue("steps", std::vector<std::string>{"nlargest"});
+  p.setValue("nlargest:n", 10);
+  pipeline.setParameters(p);
+  spec = input;
+  pipeline.filterPeakSpectrum(spec);
+  TEST_EQUAL(spec.size(), 10)
+  TEST_EQUAL(spec.isSorted(), true)
+
+  // empty spectrum
+  PeakSpectrum empty;
+  pipeline.filterPeakSpectrum(empty);
+  TEST_EQUAL(empty.size(), 0)
+}
+END_SECTION
+
+START_SECTION((void filterPeakMap(PeakMap& exp) const))
+{
+  SpectrumPreprocessingPipeline pipeline;
+  PeakMap exp;
+  for (Size i = 0; i < 20; ++i)
+  {
+    PeakSpectrum s = input;
+    s.setRT(i);
+    exp.addSpectrum(s);
+  }
+  pipeline.filterPeakMap(exp);
+
+  PeakSpectrum expected = input;
+  pipeline.filterPeakSpectrum(expected);
+  TEST_EQUAL(exp.size(), 20)
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp[i].size(), expected.size())
+  }
+  TEST_EQUAL(exp[19].getRT(), 19)
+}
+END_SECTION
+
+delete e_ptr;
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
+///////////////////////////
+
+#include <vector>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(StaticKDTree, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+typedef StaticKDTree<2> Tree;
+
+// regular grid: point (x, y) has index 100 * x + y
+vector<Tree::PointType> points;
+for (Size x = 0; x < 100; ++x)
+{
+  for (Size y = 0; y < 100; ++y)
+  {
+    points.push_back({double(x), double(y)});
+  }
+}
+
+START_SECTION((void build(const std::vector<PointType>& points)))
+{
+  Tree tree;
+  TEST_EQUAL(tree.empty(), true)
+  tree.build(points);
+  TEST_EQUAL(tree.size(), 10000)
+  tree.build(vector<Tree::PointType>());
+  TEST_EQUAL(tree.size(), 0)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  Tree tree;
+  tree.build(points);
+  tree.clear();
+  TEST_EQUAL(tree.empty(), true)
+}
+END_SECTION
+
+START_SECTION((void queryRegion(const RegionType& region, std::vector<Size>& result) const))
+{
+  Tree tree;
+  tree.build(points);
+  vector<Size> result;
+  tree.queryRegion(Tree::RegionType({10.5, 20.0}, {12.0, 21.5}), result); // bounds are inclusive
+  sort(result.begin(), result.end());
+  TEST_EQUAL(result.size(), 4)
+  ABORT_IF(result.size() != 4)
+  TEST_EQUAL(result[0], 1120)
+  TEST_EQUAL(result[1], 1121)
+  TEST_EQUAL(result[2], 1220)
+  TEST_EQUAL(result[3], 1221)
+
+  result.clear();
+  tree.queryRegion(Tree::RegionType({-5.0, -5.0}, {-1.0, 200.0}), result);
+  TEST_EQUAL(result.empty(), true)
+
+  // duplicates (many points with the same coordinate)
+  vector<Tree::PointType> same(50, Tree::PointType{{1.0, 2.0}});
+  tree.build(same);
+  tree.queryRegion(Tree::RegionType({1.0, 2.0}, {1.0, 2.0}), result);
+  TEST_EQUAL(result.size(), 50)
+}
+END_SECTION
+
+START_SECTION((void queryRegions(const std::vector<RegionType>& regions, std::vector<std::vector<Size> >& results) const))
+{
+  Tree tree;
+  tree.build(points);
+  vector<Tree::RegionType> regions;
+  for (Size i = 0; i < 90; ++i)
+  {
+    regions.emplace_back(Tree::PointType{{double(i), 5.0}}, Tree::PointType{{double(i) + 2.0, 5.0}});
+  }
+  vector<vector<Size> > results;
+  tree.queryRegions(regions, results);
+  TEST_EQUAL(results.size(), 90)
+  bool all_correct = true;
+  for (Size i = 0; i < 90; ++i)
+  {
+    all_correct &= (results[i] == vector<Size>{100 * i + 5, 100 * (i + 1) + 5, 100 * (i + 2) + 5});
+  }
+  TEST_EQUAL(all_correct, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
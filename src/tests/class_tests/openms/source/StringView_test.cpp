@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/StringView.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(StringView, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+String s("  12.5\t-3 xyz");
+
+START_SECTION(StringView(const char* begin, Size size))
+{
+  StringView sv(s.c_str() + 2, 4);
+  TEST_EQUAL(sv.size(), 4)
+  TEST_EQUAL(sv.getString(), "12.5")
+  TEST_EQUAL(sv.data() == s.c_str() + 2, true)
+  TEST_EQUAL(StringView().empty(), true)
+}
+END_SECTION
+
+START_SECTION(StringView trim() const)
+{
+  TEST_EQUAL(StringView(s.c_str(), 7).trim().getString(), "12.5")
+  TEST_EQUAL(StringView(s.c_str(), 2).trim().empty(), true)
+}
+END_SECTION
+
+START_SECTION(Int toInt() const)
+{
+  TEST_EQUAL(StringView(s.c_str() + 6, 4).toInt(), -3)
+  TEST_EQUAL(StringView(String(" +17 ")).toInt(), 17)
+  TEST_EXCEPTION(Exception::ConversionError, StringView(s.c_str() + 2, 4).toInt())
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("")).toInt())
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("+-1")).toInt())
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("99999999999")).toInt())
+}
+END_SECTION
+
+START_SECTION(Int64 toInt64() const)
+{
+  TEST_EQUAL(StringView(String("99999999999")).toInt64(), 99999999999LL)
+}
+END_SECTION
+
+START_SECTION(float toFloat() const)
+{
+  TEST_REAL_SIMILAR(StringView(s.c_str(), 7).toFloat(), 12.5)
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("1e60")).toFloat())
+}
+END_SECTION
+
+START_SECTION(double toDouble() const)
+{
+  TEST_REAL_SIMILAR(StringView(s.c_str(), 7).toDouble(), 12.5)
+  TEST_REAL_SIMILAR(StringView(String("+.5")).toDouble(), 0.5)
+  TEST_REAL_SIMILAR(StringView(String("-1.25e3")).toDouble(), -1250.0)
+  TEST_EQUAL(std::isnan(StringView(String("nan")).toDouble()), true)
+  TEST_EQUAL(std::isinf(StringView(String("-inf")).toDouble()), true)
+  // underflow flushes to zero, overflow is an error
+  TEST_REAL_SIMILAR(StringView(String("1e-400")).toDouble(), 0.0)
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("1e400")).toDouble())
+  // the whole view must be a number
+  TEST_EXCEPTION(Exception::ConversionError, StringView(s).toDouble())
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("abc")).toDouble())
+  TEST_EXCEPTION(Exception::ConversionError, StringView(String("0x10")).toDouble())
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
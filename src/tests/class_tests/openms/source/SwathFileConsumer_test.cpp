@@ -555,6 +555,50 @@ START_SECTION(([EXTRA] consumeAndRetrieve_noMS2))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] consumeAndRetrieve_multiple_cycles))
+{
+  // maps are finalized as soon as they received their expected number of spectra
+  int nr_swath = 2;
+  std::vector<int> nr_ms2_spectra(nr_swath, 2);
+  cached_sfc_ptr = new CachedSwathFileConsumer("./", "tmp_osw_cached", 2, nr_ms2_spectra);
+  PeakMap exp;
+  getSwathFile(exp, nr_swath);
+  getSwathFile(exp, nr_swath);
+  for (Size i = 0; i < exp.getSpectra().size(); i++)
+  {
+    cached_sfc_ptr->consumeSpectrum(exp.getSpectra()[i]);
+  }
+
+  std::vector< OpenSwath::SwathMap > maps;
+  cached_sfc_ptr->retrieveSwathMaps(maps);
+
+  TEST_EQUAL(maps.size(), nr_swath+1) // Swath number + MS1
+  TEST_EQUAL(maps[0].ms1, true)
+  TEST_EQUAL(maps[0].sptr->getNrSpectra(), 2)
+  TEST_REAL_SIMILAR(maps[0].sptr->getSpectrumById(1)->getMZArray()->data[0], 100.0)
+  for (int i = 0; i< nr_swath; i++)
+  {
+    TEST_EQUAL(maps[i+1].ms1, false)
+    TEST_EQUAL(maps[i+1].sptr->getNrSpectra(), 2)
+    TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(0)->getMZArray()->data[0], 101.0+i)
+    TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(1)->getIntensityArray()->data[0], 201.0+i)
+    TEST_REAL_SIMILAR(maps[i+1].lower, 400+i*25.0)
+  }
+  delete cached_sfc_ptr;
+
+  // more spectra than expected
+  std::vector<int> too_few(nr_swath, 1);
+  cached_sfc_ptr = new CachedSwathFileConsumer("./", "tmp_osw_cached", 2, too_few);
+  for (Size i = 0; i < 1 + (Size)nr_swath; i++)
+  {
+    cached_sfc_ptr->consumeSpectrum(exp.getSpectra()[i]);
+  }
+  cached_sfc_ptr->consumeSpectrum(exp.getSpectra()[1 + nr_swath]); // second MS1 spectrum
+  TEST_EXCEPTION(Exception::InvalidParameter, cached_sfc_ptr->consumeSpectrum(exp.getSpectra()[2 + nr_swath]))
+  delete cached_sfc_ptr;
+}
+END_SECTION
+
 START_SECTION(([EXTRA] void retrieveSwathMaps(std::vector< OpenSwath::SwathMap > & maps))) 
 {
   NOT_TESTABLE // already tested consumeAndRetrieve
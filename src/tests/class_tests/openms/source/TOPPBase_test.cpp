@@ -46,6 +46,7 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
 #include <cstdlib>
+#include <fstream>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -398,6 +399,44 @@ public:
   }
 };
 
+// test class for batch mode: records the value of each job
+class TOPPBaseBatchTest
+: public TOPPBase
+{
+
+public:
+  TOPPBaseBatchTest()
+  : TOPPBase("TOPPBaseBatchTest", "A test class for the batch mode", false, {}, false)
+  {}
+
+  void registerOptionsAndFlags_() override
+  {
+    registerIntOption_("value", "<n>", 0, "the value 3 fails", false);
+    registerStringOption_("text", "<string>", "", "some text", false);
+  }
+
+  ExitCodes run(int argc , const char** argv)
+  {
+    static char* var = (char *)("OPENMS_DISABLE_UPDATE_CHECK=ON");
+#ifdef OPENMS_WINDOWSPLATFORM
+      _putenv(var);
+#else
+      putenv(var);
+#endif
+    return main(argc, argv);
+  }
+
+  ExitCodes main_(int /*argc*/ , const char** /*argv*/) override
+  {
+    values.push_back(getIntOption_("value"));
+    texts.push_back(getStringOption_("text"));
+    return values.back() == 3 ? ILLEGAL_PARAMETERS : EXECUTION_OK;
+  }
+
+  std::vector<Int> values;
+  std::vector<String> texts;
+};
+
 /////////////////////////////////////////////////////////////
 
   START_TEST(TOPPBase, "$Id$");
@@ -837,6 +876,47 @@ START_SECTION(([EXTRA] test subsection parameters))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] batch mode))
+{
+  String batch_file;
+  NEW_TMP_FILE(batch_file)
+  {
+    std::ofstream out(batch_file.c_str());
+    out << "# comment\n"
+        << "-value 1 -test\n"
+        << "\n"
+        << "  -value 2 -text \"with space\" -test\n"
+        << "-value 3 -test\n"
+        << "-test\n";
+  }
+  const char* string_cl[3] = {"TOPPBaseBatchTest", "-batch", batch_file.c_str()};
+  TOPPBaseBatchTest tool;
+  TOPPBase::ExitCodes ec = tool.run(3, string_cl);
+  TEST_EQUAL(ec, TOPPBase::ILLEGAL_PARAMETERS) // from the third job
+  // all jobs ran; parameters of a job do not leak into the next one
+  TEST_EQUAL(tool.values.size(), 4)
+  ABORT_IF(tool.values.size() != 4)
+  TEST_EQUAL(tool.values[0], 1)
+  TEST_EQUAL(tool.values[1], 2)
+  TEST_EQUAL(tool.values[2], 3)
+  TEST_EQUAL(tool.values[3], 0)
+  TEST_EQUAL(tool.texts[0], "")
+  TEST_EQUAL(tool.texts[1], "with space")
+  TEST_EQUAL(tool.texts[3], "")
+
+  // -batch must be the only option
+  const char* string_cl_2[4] = {"TOPPBaseBatchTest", "-batch", batch_file.c_str(), "-test"};
+  TOPPBaseBatchTest tool2;
+  TEST_EQUAL(tool2.run(4, string_cl_2), TOPPBase::ILLEGAL_PARAMETERS)
+  TEST_EQUAL(tool2.values.size(), 0)
+
+  // missing batch file
+  const char* string_cl_3[3] = {"TOPPBaseBatchTest", "-batch", "/this/file/does/not/exist.txt"};
+  TOPPBaseBatchTest tool3;
+  TEST_EQUAL(tool3.run(3, string_cl_3), TOPPBase::INPUT_FILE_NOT_FOUND)
+}
+END_SECTION
+
 delete [] a7;
 delete [] a8;
 
@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/SYSTEM/TaskPool.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+///////////////////////////
+
+using namespace OpenMS;
+
+START_TEST(TaskPool, "$Id$")
+
+TaskPool* ptr = nullptr;
+TaskPool* null_ptr = nullptr;
+START_SECTION(explicit TaskPool(Size num_workers))
+{
+  ptr = new TaskPool(3);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getNumberOfWorkers(), 3)
+}
+END_SECTION
+
+START_SECTION(~TaskPool())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(template <typename Function> std::future<std::invoke_result_t<Function>> submit(Function function))
+{
+  TaskPool pool(3);
+  std::vector<std::future<Size>> results;
+  for (Size i = 0; i < 1000; ++i)
+  {
+    results.push_back(pool.submit([i]() { return i * i; }));
+  }
+  Size sum = 0;
+  for (auto& r : results) sum += r.get();
+  TEST_EQUAL(sum, 332833500)
+
+  // exceptions are passed on by the future
+  std::future<int> error = pool.submit([]() -> int { throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "task failed", "1"); });
+  TEST_EXCEPTION(Exception::InvalidValue, error.get())
+
+  // tasks submitted from a task run synchronously in the worker (no deadlock)
+  std::future<std::pair<std::thread::id, std::thread::id>> outer = pool.submit([&pool]()
+  {
+    std::thread::id inner = pool.submit([]() { return std::this_thread::get_id(); }).get();
+    return std::make_pair(std::this_thread::get_id(), inner);
+  });
+  std::pair<std::thread::id, std::thread::id> ids = outer.get();
+  TEST_EQUAL(ids.first == ids.second, true)
+  TEST_EQUAL(ids.first == std::this_thread::get_id(), false)
+
+#ifdef _OPENMP
+  // OpenMP loops in tasks are sequential
+  TEST_EQUAL(pool.submit([]() { return omp_get_max_threads(); }).get(), 1)
+#endif
+
+  // without workers, tasks run in the calling thread
+  TaskPool sync_pool(0);
+  TEST_EQUAL(sync_pool.getNumberOfWorkers(), 0)
+  std::future<std::thread::id> id = sync_pool.submit([]() { return std::this_thread::get_id(); });
+  TEST_EQUAL(id.wait_for(std::chrono::seconds(0)) == std::future_status::ready, true)
+  TEST_EQUAL(id.get() == std::this_thread::get_id(), true)
+}
+END_SECTION
+
+START_SECTION(static TaskPool& getInstance())
+{
+  TEST_EQUAL(&TaskPool::getInstance(), &TaskPool::getInstance())
+}
+END_SECTION
+
+START_SECTION(static void setThreadBudget(Size num_threads))
+{
+  TaskPool::setThreadBudget(3);
+  TEST_EQUAL(TaskPool::getThreadBudget(), 3)
+  TEST_EQUAL(TaskPool::getInstance().getNumberOfWorkers(), 2)
+#ifdef _OPENMP
+  TEST_EQUAL(omp_get_max_threads(), 3)
+#endif
+  TEST_EQUAL(TaskPool::getInstance().submit([]() { return 42; }).get(), 42)
+
+  TaskPool::setThreadBudget(1);
+  TEST_EQUAL(TaskPool::getInstance().getNumberOfWorkers(), 0)
+  TEST_EQUAL(TaskPool::getInstance().submit([]() { return 42; }).get(), 42)
+}
+END_SECTION
+
+START_SECTION(static Size getThreadBudget())
+{
+  TaskPool::setThreadBudget(0); // at least one thread
+  TEST_EQUAL(TaskPool::getThreadBudget(), 1)
+}
+END_SECTION
+
+START_SECTION(Size getNumberOfWorkers() const)
+{
+  TaskPool pool(2);
+  TEST_EQUAL(pool.getNumberOfWorkers(), 2)
+}
+END_SECTION
+
+END_TEST
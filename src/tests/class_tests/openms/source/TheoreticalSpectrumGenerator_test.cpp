@@ -528,6 +528,33 @@ START_SECTION(static MSSpectrum generateSpectrum(const Precursor::ActivationMeth
 
 END_SECTION
 
+START_SECTION(static void generateSpectrum(PeakSpectrum& spec, const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge))
+{
+  // must give the same peaks as the returning variant (the buffer is reused between calls)
+  PeakSpectrum spec;
+  for (const auto& act : {Precursor::ActivationMethod::CID, Precursor::ActivationMethod::HCD, Precursor::ActivationMethod::ETD})
+  {
+    for (const String& seq : {"HFYLWCP", "PEP", ".(Acetyl)PEPTM(Oxidation)IDEK", "P"})
+    {
+      for (int charge : {0, 1, 2, 3})
+      {
+        PeakSpectrum expected = TheoreticalSpectrumGenerator::generateSpectrum(act, AASequence::fromString(seq), charge);
+        TheoreticalSpectrumGenerator::generateSpectrum(spec, act, AASequence::fromString(seq), charge);
+        TEST_EQUAL(spec.size(), expected.size())
+        ABORT_IF(spec.size() != expected.size())
+        for (Size i = 0; i < spec.size(); ++i)
+        {
+          TEST_EQUAL(spec[i].getMZ(), expected[i].getMZ())
+          TEST_EQUAL(spec[i].getIntensity(), expected[i].getIntensity())
+        }
+      }
+    }
+  }
+
+  TEST_EXCEPTION(Exception::InvalidParameter, TheoreticalSpectrumGenerator::generateSpectrum(spec, Precursor::ActivationMethod::SORI, AASequence::fromString("PEP"), 1));
+}
+END_SECTION
+
 START_SECTION(([EXTRA] bugfix test where losses lead to formulae with negative element frequencies))
 {
   // this tests for the loss of CONH2 on Arginine, however it is not clear how
@@ -910,6 +937,63 @@ START_SECTION(([EXTRA] test first prefix loss))
 }
 END_SECTION
 
+START_SECTION((template <bool add_a, bool add_b, bool add_c, bool add_x, bool add_y, bool add_z> static void getFragmentMZs(std::vector<double>& mzs, const AASequence& peptide, Int charge = 1, bool add_first_prefix_ion = false)))
+{
+  AASequence peptide = AASequence::fromString(".(Acetyl)PEPTM(Oxidation)IDEK");
+  TheoreticalSpectrumGenerator t_gen;
+  Param params;
+  params.setValue("add_a_ions", "true");
+  params.setValue("add_z_ions", "true");
+  params.setValue("add_first_prefix_ion", "true");
+  t_gen.setParameters(params);
+
+  // identical to the single peaks of getSpectrum()
+  for (Int charge = 1; charge <= 2; ++charge)
+  {
+    PeakSpectrum spec;
+    t_gen.getSpectrum(spec, peptide, charge, charge);
+    std::vector<double> mzs;
+    TheoreticalSpectrumGenerator::getFragmentMZs<true, true, false, false, true, true>(mzs, peptide, charge, true);
+    TEST_EQUAL(mzs.size(), spec.size())
+    ABORT_IF(mzs.size() != spec.size())
+    for (Size i = 0; i != mzs.size(); ++i)
+    {
+      TEST_EQUAL(mzs[i], spec[i].getMZ())
+    }
+  }
+
+  // the buffer is reused
+  std::vector<double> mzs(100, 0.0);
+  TheoreticalSpectrumGenerator::getFragmentMZs<false, true, false, false, false, false>(mzs, peptide);
+  TEST_EQUAL(mzs.size(), 7) // b2 - b8
+  TEST_EQUAL(mzs.capacity() >= 100, true)
+  TheoreticalSpectrumGenerator::getFragmentMZs<false, true, false, false, false, false>(mzs, AASequence::fromString("K"));
+  TEST_EQUAL(mzs.size(), 0)
+}
+END_SECTION
+
+START_SECTION((template <bool add_a, bool add_b, bool add_c, bool add_x, bool add_y, bool add_z> static void getFragmentIons(std::vector<FragmentIon>& ions, const AASequence& peptide, Int charge = 1, bool add_first_prefix_ion = false)))
+{
+  AASequence peptide = AASequence::fromString("PEPTIDEK");
+  TheoreticalSpectrumGenerator t_gen;
+  Param params;
+  params.setValue("add_metainfo", "true");
+  t_gen.setParameters(params);
+  PeakSpectrum spec;
+  t_gen.getSpectrum(spec, peptide, 1, 1);
+
+  std::vector<TheoreticalSpectrumGenerator::FragmentIon> ions;
+  TheoreticalSpectrumGenerator::getFragmentIons<false, true, false, false, true, false>(ions, peptide);
+  TEST_EQUAL(ions.size(), spec.size())
+  ABORT_IF(ions.size() != spec.size())
+  for (Size i = 0; i != ions.size(); ++i)
+  {
+    TEST_EQUAL(ions[i].mz, spec[i].getMZ())
+    TEST_EQUAL(String(ions[i].ion_type) + String(ions[i].ordinal) + "+", spec.getStringDataArrays()[0][i])
+  }
+}
+END_SECTION
+
 delete ptr;
 
 /////////////////////////////////////////////////////////////
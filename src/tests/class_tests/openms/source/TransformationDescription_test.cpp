@@ -251,6 +251,30 @@ START_SECTION(([EXTRA]void fitModel(const String& model_type, const Param& param
 }
 END_SECTION
 
+START_SECTION((void apply(std::vector<double>& values) const))
+{
+  TransformationDescription td;
+  std::vector<double> values = {-0.5, 1000.0};
+  td.apply(values);
+  TEST_EQUAL(values[0], -0.5);
+  TEST_EQUAL(values[1], 1000.0);
+
+  TransformationDescription td_nl(data_nonlinear);
+  Param params;
+  params.setValue("interpolation_type", "linear");
+  td_nl.fitModel("lowess", params);
+  values = {0.0, 0.5, 0.75, 1.0, 2.0};
+  std::vector<double> expected;
+  for (double v : values) expected.push_back(td_nl.apply(v));
+  td_nl.apply(values);
+  TEST_EQUAL(values.size(), expected.size());
+  for (Size i = 0; i < values.size(); ++i)
+  {
+    TEST_EQUAL(values[i], expected[i]);
+  }
+}
+END_SECTION
+
 START_SECTION((void getModelParameters(Param& params) const))
 {
 	TransformationDescription td;
@@ -38,6 +38,8 @@
 
 #include <boost/assign/std/vector.hpp>
 
+#include <fstream>
+
 ///////////////////////////
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 ///////////////////////////
@@ -80,6 +82,58 @@ START_SECTION( void convertTSVToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+START_SECTION( void convertTSVToTargetedExperiment(const char * filename, FileTypes::Type filetype, OpenSwath::LightTargetedExperiment & targeted_exp))
+{
+  // two precursors share a peptide group label but differ in sequence
+  String tsv_tmp;
+  NEW_TMP_FILE(tsv_tmp)
+  {
+    std::ofstream out(tsv_tmp.c_str());
+    out << "PrecursorMz\tProductMz\tLibraryIntensity\tNormalizedRetentionTime\ttransition_group_id\ttransition_name\t"
+        << "PeptideSequence\tFullUniModPeptideName\tProteinName\tPrecursorCharge\tPeptideGroupLabel\tFragmentCharge\tDecoy\n";
+    out << "400.2\t500.3\t100\t10.0\tPEPTIDEK_2\ttr1\tPEPTIDEK\tPEPTIDEK\tP1\t2\tg1\t1\t0\n";
+    out << "400.2\t600.3\t50\t10.0\tPEPTIDEK_2\ttr2\tPEPTIDEK\tPEPTIDEK\tP1\t2\tg1\t1\t0\n";
+    out << "414.2\t528.3\t80\t12.0\tPEPTIDER_2\ttr3\tPEPTIDER\tPEPTIDER\tP2\t2\tg1\t1\t0\n";
+    out << "414.2\t628.3\t40\t12.0\tPEPTIDER_2\ttr4\tPEPTIDER\tPEPTIDER\tP2\t2\tg1\t2\t0\n";
+  }
+
+  OpenSwath::LightTargetedExperiment exp;
+  TransitionTSVFile().convertTSVToTargetedExperiment(tsv_tmp.c_str(), FileTypes::TSV, exp);
+  TEST_EQUAL(exp.transitions.size(), 4)
+  TEST_EQUAL(exp.compounds.size(), 2)
+  TEST_EQUAL(exp.proteins.size(), 2)
+  ABORT_IF(exp.compounds.size() != 2)
+  TEST_EQUAL(exp.transitions[2].peptide_ref, "PEPTIDER_2")
+  TEST_EQUAL(exp.transitions[3].fragment_charge, 2)
+  TEST_EQUAL(exp.compounds[0].id, "PEPTIDEK_2")
+  TEST_EQUAL(exp.compounds[0].peptide_group_label, "g1")
+  // mixed sequence in label group is resolved to the precursor id:
+  TEST_EQUAL(exp.compounds[1].peptide_group_label, "PEPTIDER_2")
+  TEST_EQUAL(exp.compounds[1].protein_refs.size(), 1)
+
+  // large input spanning several parsing batches: order and line based default names are preserved
+  NEW_TMP_FILE(tsv_tmp)
+  {
+    std::ofstream out(tsv_tmp.c_str());
+    out << "PrecursorMz,ProductMz,LibraryIntensity,NormalizedRetentionTime,transition_group_id,"
+        << "PeptideSequence,FullUniModPeptideName,ProteinName,PrecursorCharge,FragmentCharge,Decoy\n";
+    for (Size i = 0; i < 20000; ++i)
+    {
+      out << 400.0 + i / 4 << "," << 500.0 + i << ",100,10.0,PEPTIDEK_" << i / 4 << ",PEPTIDEK,PEPTIDEK,P1,2,1,0\n";
+    }
+  }
+  OpenSwath::LightTargetedExperiment large_exp;
+  TransitionTSVFile().convertTSVToTargetedExperiment(tsv_tmp.c_str(), FileTypes::TSV, large_exp);
+  TEST_EQUAL(large_exp.transitions.size(), 20000)
+  TEST_EQUAL(large_exp.compounds.size(), 5000)
+  ABORT_IF(large_exp.transitions.size() != 20000)
+  TEST_EQUAL(large_exp.transitions[0].transition_name, "1")
+  TEST_EQUAL(large_exp.transitions[12345].transition_name, "12346")
+  TEST_REAL_SIMILAR(large_exp.transitions[12345].product_mz, 12845.0)
+  TEST_EQUAL(large_exp.transitions[19999].peptide_ref, "PEPTIDEK_4999")
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
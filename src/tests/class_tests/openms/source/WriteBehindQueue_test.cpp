@@ -0,0 +1,118 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/WriteBehindQueue.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <vector>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(WriteBehindQueue, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+WriteBehindQueue* ptr = nullptr;
+WriteBehindQueue* null_ptr = nullptr;
+START_SECTION(WriteBehindQueue(size_t max_pending = 16))
+{
+  ptr = new WriteBehindQueue();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(~WriteBehindQueue())
+{
+  delete ptr;
+
+  // pending tasks are executed before the queue is destroyed
+  vector<int> out;
+  {
+    WriteBehindQueue q(2);
+    for (int i = 0; i < 10; ++i)
+    {
+      q.push([&out, i]() { out.push_back(i); });
+    }
+  }
+  TEST_EQUAL(out.size(), 10)
+}
+END_SECTION
+
+START_SECTION(void push(Task task))
+{
+  // tasks are executed in submission order
+  vector<int> out;
+  WriteBehindQueue q(1);
+  for (int i = 0; i < 1000; ++i)
+  {
+    q.push([&out, i]() { out.push_back(i); });
+  }
+  q.flush();
+  TEST_EQUAL(out.size(), 1000)
+  bool ordered = true;
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (out[i] != i) ordered = false;
+  }
+  TEST_EQUAL(ordered, true)
+}
+END_SECTION
+
+START_SECTION(void flush())
+{
+  int executed = 0;
+  WriteBehindQueue q(4);
+  q.push([&executed]() { ++executed; });
+  q.push([]() { throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test.mzML"); });
+  TEST_EXCEPTION(Exception::UnableToCreateFile, q.flush())
+  TEST_EQUAL(executed, 1)
+
+  // the error is reported once, the queue stays usable
+  q.push([&executed]() { ++executed; });
+  q.flush();
+  TEST_EQUAL(executed, 2)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -207,6 +207,32 @@ START_SECTION((static void uncompressString(const QByteArray& compressed_data, Q
 }
 END_SECTION
 
+START_SECTION((static void uncompressData(const void* compressed_data, size_t nr_bytes, std::vector<Byte>& raw_data)))
+{
+  std::string compressed_data;
+  std::vector<Byte> uncompressed_data;
+
+  ZlibCompression::compressString(raw_data, compressed_data);
+  ZlibCompression::uncompressData(&compressed_data[0], compressed_data.size(), uncompressed_data);
+  TEST_EQUAL(uncompressed_data.size(), 58)
+  TEST_EQUAL(std::string(uncompressed_data.begin(), uncompressed_data.end()) == raw_data, true)
+
+  // the buffer is reused (and shrunk to the actual size)
+  ZlibCompression::compressString(raw_data4, compressed_data);
+  ZlibCompression::uncompressData(&compressed_data[0], compressed_data.size(), uncompressed_data);
+  TEST_EQUAL(uncompressed_data.size(), 1052)
+  TEST_EQUAL(std::string(uncompressed_data.begin(), uncompressed_data.end()) == raw_data4, true)
+
+  ZlibCompression::compressString(raw_data3, compressed_data);
+  ZlibCompression::uncompressData(&compressed_data[0], compressed_data.size(), uncompressed_data);
+  TEST_EQUAL(uncompressed_data.size(), 105)
+  TEST_EQUAL(std::string(uncompressed_data.begin(), uncompressed_data.end()) == raw_data3, true)
+
+  // invalid data
+  TEST_EXCEPTION(Exception::ConversionError, ZlibCompression::uncompressData(&raw_data3[0], raw_data3.size(), uncompressed_data))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
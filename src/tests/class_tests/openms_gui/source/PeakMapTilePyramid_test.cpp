@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2022.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: Timo Sachsenberg $
+// $Authors: The OpenMS Team $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/PeakMapTilePyramid.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+MSSpectrum makeSpectrum(double rt, UInt ms_level, const vector<pair<double, float>>& peaks)
+{
+  MSSpectrum s;
+  s.setRT(rt);
+  s.setMSLevel(ms_level);
+  for (const auto& p : peaks)
+  {
+    s.push_back(Peak1D(p.first, p.second));
+  }
+  return s;
+}
+
+START_TEST(PeakMapTilePyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap map;
+map.addSpectrum(makeSpectrum(10.0, 1, {{100.0, 5.0f}, {150.0, 7.0f}}));
+map.addSpectrum(makeSpectrum(15.0, 2, {{110.0, 100.0f}}));
+map.addSpectrum(makeSpectrum(20.0, 1, {{120.0, 3.0f}, {200.0, 9.0f}}));
+map.addSpectrum(makeSpectrum(30.0, 1, {{199.0, 1.0f}}));
+
+PeakMapTilePyramid* ptr = nullptr;
+PeakMapTilePyramid* null_ptr = nullptr;
+START_SECTION(PeakMapTilePyramid())
+{
+  ptr = new PeakMapTilePyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->selectLevel(1.0, 1.0) == nullptr, true)
+  delete ptr;
+}
+END_SECTION
+
+PeakMapTilePyramid pyramid(map, 32, 8);
+
+START_SECTION(PeakMapTilePyramid(const PeakMap& map, Size rt_bins = 1024, Size mz_bins = 4096))
+{
+  TEST_EQUAL(pyramid.empty(), false)
+  TEST_EQUAL(PeakMapTilePyramid(PeakMap()).empty(), true)
+}
+END_SECTION
+
+START_SECTION(const std::vector<Level>& getLevels() const)
+{
+  const vector<PeakMapTilePyramid::Level>& levels = pyramid.getLevels();
+  TEST_EQUAL(levels.size(), 2)
+  TEST_EQUAL(levels[0].rt_bins, 32)
+  TEST_EQUAL(levels[0].mz_bins, 8)
+  TEST_REAL_SIMILAR(levels[0].rt_bin_width, 0.625)
+  TEST_REAL_SIMILAR(levels[0].mz_bin_width, 12.5)
+  TEST_EQUAL(levels[1].rt_bins, 16)
+  TEST_EQUAL(levels[1].mz_bins, 4)
+  TEST_REAL_SIMILAR(levels[1].rt_bin_width, 1.25)
+  TEST_REAL_SIMILAR(levels[1].mz_bin_width, 25.0)
+}
+END_SECTION
+
+START_SECTION(const Level* selectLevel(double rt_per_pixel, double mz_per_pixel) const)
+{
+  const vector<PeakMapTilePyramid::Level>& levels = pyramid.getLevels();
+  TEST_EQUAL(pyramid.selectLevel(3.0, 60.0) == &levels[1], true)
+  TEST_EQUAL(pyramid.selectLevel(1.5, 30.0) == &levels[0], true)
+  TEST_EQUAL(pyramid.selectLevel(1.0, 20.0) == nullptr, true)
+}
+END_SECTION
+
+START_SECTION(float getMaxIntensity(const Level& level, double rt_start, double rt_end, double mz_start, double mz_end) const)
+{
+  for (const PeakMapTilePyramid::Level& level : pyramid.getLevels())
+  {
+    // MS2 peaks are ignored
+    TEST_REAL_SIMILAR(pyramid.getMaxIntensity(level, 0.0, 100.0, 0.0, 1000.0), 9.0)
+    TEST_REAL_SIMILAR(pyramid.getMaxIntensity(level, 5.0, 15.0, 0.0, 1000.0), 7.0)
+    TEST_EQUAL(pyramid.getMaxIntensity(level, 12.0, 18.0, 0.0, 1000.0) < 0.0, true)
+  }
+  const PeakMapTilePyramid::Level& finest = pyramid.getLevels()[0];
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(finest, 5.0, 15.0, 90.0, 130.0), 5.0)
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(finest, 25.0, 35.0, 150.0, 250.0), 1.0)
+  // adjacent areas do not share bins
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(finest, 15.0, 25.0, 0.0, 1000.0), 9.0)
+  TEST_EQUAL(pyramid.getMaxIntensity(finest, 25.0, 29.0, 0.0, 1000.0) < 0.0, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
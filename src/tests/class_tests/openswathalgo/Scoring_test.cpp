@@ -316,6 +316,41 @@ BOOST_AUTO_TEST_CASE(test_calculateCrossCorrelation)
   TEST_EQUAL (result.data[2].first, 0)
   TEST_EQUAL (result.data[1].first, -1)
   TEST_EQUAL (result.data[0].first, -2)
+
+  // filling preallocated storage gives the same result for all delays (also
+  // delays beyond the data length) and lags
+  static const double arr3[] = {0,1,3,5,2,0,4,7,1,1,0};
+  static const double arr4[] = {1,3,5,2,0,0,2,2,6,3,1};
+  std::vector<double> data3 (arr3, arr3 + sizeof(arr3) / sizeof(arr3[0]) );
+  std::vector<double> data4 (arr4, arr4 + sizeof(arr4) / sizeof(arr4[0]) );
+  OpenSwath::Scoring::XCorrArrayType inplace;
+  inplace.data.resize(100, std::make_pair(42, 42.0));
+  for (int lag = 1; lag <= 3; ++lag)
+  {
+    for (int maxdelay = 0; maxdelay <= 13; ++maxdelay)
+    {
+      Scoring::calculateCrossCorrelation(data3, data4, maxdelay, lag, inplace);
+      std::size_t k = 0;
+      for (int delay = -maxdelay; delay <= maxdelay; delay += lag, ++k)
+      {
+        double sxy = 0;
+        for (int i = 0; i < (int)data3.size(); ++i)
+        {
+          int j = i + delay;
+          if (j >= 0 && j < (int)data4.size()) sxy += data3[i] * data4[j];
+        }
+        ABORT_IF(k >= inplace.data.size())
+        TEST_EQUAL(inplace.data[k].first, delay)
+        TEST_EQUAL(inplace.data[k].second, sxy)
+      }
+      TEST_EQUAL(inplace.data.size(), k)
+    }
+  }
+
+  Scoring::normalizedCrossCorrelationPost(data1, data2, 2, 1, inplace);
+  TEST_EQUAL(inplace.data.size(), 5)
+  TEST_REAL_SIMILAR (inplace.data[4].second, -0.7374631);
+  TEST_REAL_SIMILAR (inplace.data[0].second,  0.15634218);
 }
 END_SECTION
 
@@ -49,6 +49,8 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <exception>
+#include <memory>
 #include <unordered_set>
 
 using namespace OpenMS;
@@ -142,6 +144,7 @@ public:
 protected:
 
   String algorithm_; // algorithm for consensus calculation (input parameter)
+  Param algo_params_; // parameters for the consensus algorithm
   bool keep_old_scores_;
 
   void registerOptionsAndFlags_() override
@@ -578,9 +581,77 @@ protected:
   }
 
 
+  /// creates a new instance of the selected consensus algorithm (using @p algo_params_)
+  ConsensusIDAlgorithm* createAlgorithm_() const
+  {
+    ConsensusIDAlgorithm* consensus;
+    if (algorithm_ == "PEPMatrix")
+    {
+      consensus = new ConsensusIDAlgorithmPEPMatrix();
+    }
+    else if (algorithm_ == "PEPIons")
+    {
+      consensus = new ConsensusIDAlgorithmPEPIons();
+    }
+    else if (algorithm_ == "best")
+    {
+      consensus = new ConsensusIDAlgorithmBest();
+    }
+    else if (algorithm_ == "worst")
+    {
+      consensus = new ConsensusIDAlgorithmWorst();
+    }
+    else if (algorithm_ == "average")
+    {
+      consensus = new ConsensusIDAlgorithmAverage();
+    }
+    else // algorithm_ == "ranks"
+    {
+      consensus = new ConsensusIDAlgorithmRanks();
+    }
+    consensus->setParameters(algo_params_);
+    return consensus;
+  }
+
+  /**
+    @brief Computes the consensus for each group of peptide IDs
+
+    Groups are independent of each other and are processed in parallel. Algorithms keep per-call state
+    (and similarity caches), so every thread uses its own algorithm instance.
+  */
+  void applyConsensus_(const vector<vector<PeptideIdentification>*>& groups,
+                       const map<String, String>& se_info,
+                       const vector<Size>& number_of_runs) const
+  {
+    vector<std::exception_ptr> errors(groups.size());
+    #pragma omp parallel
+    {
+      std::unique_ptr<ConsensusIDAlgorithm> consensus;
+      #pragma omp critical (ConsensusID_createAlgorithm)
+      consensus.reset(createAlgorithm_());
+
+      #pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)groups.size(); ++i)
+      {
+        try
+        {
+          consensus->apply(*groups[i], se_info, number_of_runs[i]);
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+        }
+      }
+    }
+    // report the first error in input order, as the sequential loop did
+    for (const std::exception_ptr& error : errors)
+    {
+      if (error) { std::rethrow_exception(error); }
+    }
+  }
+
   template <typename MapType>
-  void processFeatureOrConsensusMap_(MapType& input_map,
-                                     ConsensusIDAlgorithm* consensus)
+  void processFeatureOrConsensusMap_(MapType& input_map)
   {
     // Problem with feature data: IDs from multiple spectra may be attached to
     // a (consensus) feature, so we may have multiple IDs from the same search
@@ -604,6 +675,10 @@ protected:
     }
 
     // compute consensus:
+    vector<vector<PeptideIdentification>*> groups;
+    vector<Size> group_runs;
+    groups.reserve(input_map.size());
+    group_runs.reserve(input_map.size());
     for (typename MapType::Iterator map_it = input_map.begin();
          map_it != input_map.end(); ++map_it)
     {
@@ -615,8 +690,10 @@ protected:
       }
       Size n_repeats = *max_element(times_seen.begin(), times_seen.end());
 
-      consensus->apply(ids, runid_to_se, number_of_runs * n_repeats);
+      groups.push_back(&ids);
+      group_runs.push_back(number_of_runs * n_repeats);
     }
+    applyConsensus_(groups, runid_to_se, group_runs);
 
     // create new identification run:
     setProteinIdentifications_(input_map.getProteinIdentifications());
@@ -637,40 +714,20 @@ protected:
     //----------------------------------------------------------------
     // set up ConsensusID
     //----------------------------------------------------------------
-    ConsensusIDAlgorithm* consensus;
     // general algorithm parameters:
-    Param algo_params = ConsensusIDAlgorithmBest().getDefaults();
+    algo_params_ = ConsensusIDAlgorithmBest().getDefaults();
     algorithm_ = getStringOption_("algorithm");
     if (algorithm_ == "PEPMatrix")
     {
-      consensus = new ConsensusIDAlgorithmPEPMatrix();
       // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPMatrix:", true));
+      algo_params_.merge(getParam_().copy("PEPMatrix:", true));
     }
     else if (algorithm_ == "PEPIons")
     {
-      consensus = new ConsensusIDAlgorithmPEPIons();
       // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPIons:", true));
-    }
-    else if (algorithm_ == "best")
-    {
-      consensus = new ConsensusIDAlgorithmBest();
-    }
-    else if (algorithm_ == "worst")
-    {
-      consensus = new ConsensusIDAlgorithmWorst();
+      algo_params_.merge(getParam_().copy("PEPIons:", true));
     }
-    else if (algorithm_ == "average")
-    {
-      consensus = new ConsensusIDAlgorithmAverage();
-    }
-    else // algorithm_ == "ranks"
-    {
-      consensus = new ConsensusIDAlgorithmRanks();
-    }
-    algo_params.update(getParam_(), false, OpenMS_Log_debug); // update general params.
-    consensus->setParameters(algo_params);
+    algo_params_.update(getParam_(), false, OpenMS_Log_debug); // update general params.
 
     //----------------------------------------------------------------
     // idXML
@@ -796,24 +853,29 @@ protected:
           // we could keep track of it but IMHO we should not allow raw there at all (just complicates things)
           to_put.setPrimaryMSRunPath({file_ref_peps.first + ".mzML"});
           setProteinIdentificationSettings_(to_put, mzml_to_sesettings[new_run_id], mzml_to_rescoresettings[new_run_id]);
-          for (const auto& ref_peps : file_ref_peps.second)
+          // compute the consensus of all spectra of this file (the groups are consumed)
+          vector<vector<PeptideIdentification>*> groups;
+          vector<tuple<double, double, String>> group_positions; // m/z, RT, spectrum reference
+          for (auto& ref_peps : file_ref_peps.second)
           {
-            vector<PeptideIdentification> peps = ref_peps.second;
+            vector<PeptideIdentification>& peps = ref_peps.second;
             if (peps.empty())
             {
               continue; //sth went wrong. skip
             }
-            double mz = peps[0].getMZ();
-            double rt = peps[0].getRT();
             // has to have a ref, save it, since apply might modify everything
-            String ref = peps[0].getMetaValue("spectrum_reference");
-            consensus->apply(peps, runid_to_old_se, mzml_to_sesettings[new_run_id].size());
-            for (auto& p : peps)
+            group_positions.emplace_back(peps[0].getMZ(), peps[0].getRT(), peps[0].getMetaValue("spectrum_reference"));
+            groups.push_back(&peps);
+          }
+          applyConsensus_(groups, runid_to_old_se, vector<Size>(groups.size(), mzml_to_sesettings[new_run_id].size()));
+          for (Size g = 0; g < groups.size(); ++g)
+          {
+            for (auto& p : *groups[g])
             {
               p.setIdentifier(to_put.getIdentifier());
-              p.setMZ(mz);
-              p.setRT(rt);
-              p.setMetaValue("spectrum_reference", ref);
+              p.setMZ(get<0>(group_positions[g]));
+              p.setRT(get<1>(group_positions[g]));
+              p.setMetaValue("spectrum_reference", get<2>(group_positions[g]));
               //TODO copy other meta values from the originals? They need to be collected
               // in the algorithm subclasses though first
               pep_ids.emplace_back(std::move(p));
@@ -892,10 +954,16 @@ protected:
 
         // compute consensus
         pep_ids.clear();
+        vector<vector<PeptideIdentification>*> groups;
+        groups.reserve(grouping.size());
+        for (auto& cfeature : grouping)
+        {
+          groups.push_back(&cfeature.getPeptideIdentifications());
+        }
+        applyConsensus_(groups, runid_to_se, vector<Size>(groups.size(), old_size));
         for (auto& cfeature : grouping)
         {
           auto& ids = cfeature.getPeptideIdentifications();
-          consensus->apply(ids, runid_to_se, old_size);
 
           if (!ids.empty())
           {
@@ -924,7 +992,7 @@ protected:
       FeatureMap map;
       FeatureXMLFile().load(in[0], map);
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       FeatureXMLFile().store(out, map);
     }
@@ -937,13 +1005,11 @@ protected:
       ConsensusMap map;
       ConsensusXMLFile().load(in[0], map);
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       ConsensusXMLFile().store(out, map);
     }
 
-    delete consensus;
-
     return EXECUTION_OK;
   }
 };
@@ -432,6 +432,7 @@ protected:
           consumer.getOptions().setCompression(true);
         }
         consumer.addDataProcessing(getProcessingInfo_(DataProcessing::CONVERSION_MZML));
+        consumer.setWriteBehind(4);
 
         // for different input file type
         if (in_type == FileTypes::MZML)
@@ -462,6 +463,7 @@ protected:
         PeakMap exp_meta;
 
         MSDataCachedConsumer consumer(out);
+        consumer.setWriteBehind(16);
         MzMLFile().transform(in, &consumer, exp_meta);
         cacher.writeMetadata(exp_meta, out_meta);
 
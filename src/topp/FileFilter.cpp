@@ -46,6 +46,8 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/MSNumpressCoder.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
 #include <OpenMS/COMPARISON/SPECTRA/ZhangSimilarityScore.h>
@@ -53,6 +55,7 @@
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
+#include <functional>
 #include <memory>
 
 using namespace OpenMS;
@@ -113,6 +116,10 @@ The priority of the id-flags is (decreasing order): remove_annotated_features /
 MS2 and higher spectra can be filtered according to precursor m/z (see 'peak_options:pc_mz_range'). This flag can be combined with 'rt' range to filter precursors by RT and m/z.
 If you want to extract an MS1 region with untouched MS2 spectra included, you will need to split the dataset by MS level, then use the 'mz' option for MS1 data and 'peak_options:pc_mz_range' for MS2 data. Afterwards merge the two files again. RT can be filtered at any step.
 
+For very large mzML files, 'peak_options:lowmemory' filters mzML to mzML on the fly instead of loading the whole experiment.
+The input is read twice (once to count the surviving spectra and chromatograms, once to write them), so memory use does not depend on the file size.
+Options which need the complete experiment ('sort', 'id:blacklist', 'consensus:blackorwhitelist:file', 'spectra:blackorwhitelist:file') are not available in this mode, and spectra are never converted to chromatograms.
+
 @note For filtering peptide/protein identification data, see the @ref TOPP_IDFilter tool.
 
 @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
@@ -130,6 +137,50 @@ For the parameters of the S/N algorithm section see the class documentation ther
 // We do not want this class to show up in the docu:
 /// @cond TOPPCLASSES
 
+/// Writes only those spectra/chromatograms which pass the given filters.
+/// The number of surviving items must be known beforehand (see setFilteredSize), since it is written into the mzML header.
+class FilteringMSDataWritingConsumer :
+  public PlainMSDataWritingConsumer
+{
+public:
+  FilteringMSDataWritingConsumer(const String& filename,
+                                 std::function<bool(SpectrumType&)> keep_spectrum,
+                                 std::function<bool(ChromatogramType&)> keep_chromatogram) :
+    PlainMSDataWritingConsumer(filename),
+    keep_spectrum_(std::move(keep_spectrum)),
+    keep_chromatogram_(std::move(keep_chromatogram))
+  {
+  }
+
+  void setFilteredSize(Size spectra, Size chromatograms)
+  {
+    filtered_spectra_ = spectra;
+    filtered_chromatograms_ = chromatograms;
+  }
+
+  /// ignores the counts of the input file and uses the ones given to setFilteredSize()
+  void setExpectedSize(Size /* expectedSpectra */, Size /* expectedChromatograms */) override
+  {
+    PlainMSDataWritingConsumer::setExpectedSize(filtered_spectra_, filtered_chromatograms_);
+  }
+
+  void consumeSpectrum(SpectrumType& s) override
+  {
+    if (keep_spectrum_(s)) PlainMSDataWritingConsumer::consumeSpectrum(s);
+  }
+
+  void consumeChromatogram(ChromatogramType& c) override
+  {
+    if (keep_chromatogram_(c)) PlainMSDataWritingConsumer::consumeChromatogram(c);
+  }
+
+private:
+  std::function<bool(SpectrumType&)> keep_spectrum_;
+  std::function<bool(ChromatogramType&)> keep_chromatogram_;
+  Size filtered_spectra_ = 0;
+  Size filtered_chromatograms_ = 0;
+};
+
 class TOPPFileFilter :
   public TOPPBase
 {
@@ -175,17 +226,6 @@ private:
     return false;
   }
 
-  static void replacePrecursorCharge(MSExperiment& e, int charge_in, int charge_out)
-  {
-    for (auto& s : e.getSpectra())
-    {
-      for (auto& p : s.getPrecursors())
-      {
-        if (p.getCharge() == charge_in) { p.setCharge(charge_out); }
-      }
-    }
-  }
-
   static bool checkPeptideIdentification_(BaseFeature& feature,
                                           const bool remove_annotated_features,
                                           const bool remove_unannotated_features,
@@ -329,6 +369,7 @@ protected:
     registerFlag_("peak_options:no_chromatograms", "No conversion to space-saving real chromatograms, e.g. from SRM scans");
     registerFlag_("peak_options:remove_chromatograms", "Removes chromatograms stored in a file");
     registerFlag_("peak_options:remove_empty", "Removes spectra and chromatograms without peaks.");
+    registerFlag_("peak_options:lowmemory", "Filter mzML to mzML on the fly without loading the whole file into memory (the input is read twice). Implies 'peak_options:no_chromatograms' and cannot be combined with 'sort' or the black-/whitelist options.", true);
     registerStringOption_("peak_options:mz_precision", "32 or 64", 64, "Store base64 encoded m/z data using 32 or 64 bit precision", false);
     setValidStrings_("peak_options:mz_precision", ListUtils::create<String>("32,64"));
     registerStringOption_("peak_options:int_precision", "32 or 64", 32, "Store base64 encoded intensity data using 32 or 64 bit precision", false);
@@ -704,73 +745,46 @@ protected:
       f.getOptions().setNumpressConfigurationIntensity(npconfig_int);
       f.getOptions().setNumpressConfigurationFloatDataArray(npconfig_fda);
 
-      MapType exp;
-      f.load(in, exp);
-
-      // remove spectra with meta values:
-      if (remove_meta_enabled)
-      {
-        MapType exp_tmp;
-        for (MapType::ConstIterator it = exp.begin(); it != exp.end(); ++it)
-        {
-          if (checkMetaOk(*it, meta_info)) exp_tmp.addSpectrum(*it);
-        }
-        exp.clear(false);
-        exp.getSpectra().insert(exp.begin(), exp_tmp.begin(), exp_tmp.end());
-      }
-
+      //-------------------------------------------------------------
+      // per-spectrum filters
+      //-------------------------------------------------------------
 
-      if (!no_chromatograms)
+      // all filters which only need to look at a single spectrum are collected
+      // here, so they can be applied in memory as well as on the fly
+      bool remove_empty = getFlag_("peak_options:remove_empty");
+      bool sort_peaks = sort || getFlag_("peak_options:sort_peaks");
+      if (sort && getFlag_("peak_options:sort_peaks"))
       {
-        // convert the spectra chromatograms to real chromatograms
-        ChromatogramTools chrom_tools;
-        chrom_tools.convertSpectraToChromatograms(exp, true);
+        OPENMS_LOG_INFO << "Info: Using 'peak_options:sort_peaks' in combination with 'sort' is redundant, since 'sort' implies 'peak_options:sort_peaks'." << std::endl;
       }
 
-      bool remove_chromatograms(getFlag_("peak_options:remove_chromatograms"));
-      if (remove_chromatograms)
-      {
-        exp.setChromatograms(vector<MSChromatogram >());
-      }
+      std::vector<std::function<bool(const MapType::SpectrumType&)>> remove_spectrum;
 
-      bool remove_empty = getFlag_("peak_options:remove_empty");
       if (remove_empty)
       {
-        auto& spectra = exp.getSpectra();
-        spectra.erase(
-          remove_if(spectra.begin(), spectra.end(), [](const MSSpectrum & s){ return s.empty();} )
-          ,spectra.end());
-        auto& chroms = exp.getChromatograms();
-        chroms.erase(
-          remove_if(chroms.begin(), chroms.end(), [](const MSChromatogram & c){ return c.empty();} )
-          ,chroms.end());
+        remove_spectrum.emplace_back([](const MapType::SpectrumType& s) { return s.empty(); });
       }
 
-      //-------------------------------------------------------------
-      // calculations
-      //-------------------------------------------------------------
-
       // remove forbidden precursor charges
       IntList rm_pc_charge = getIntList_("peak_options:rm_pc_charge");
       if (!rm_pc_charge.empty())
       {
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasPrecursorCharge<MapType::SpectrumType>(rm_pc_charge, false)), exp.end());
+        remove_spectrum.emplace_back(HasPrecursorCharge<MapType::SpectrumType>(rm_pc_charge, false));
       }
 
       // remove precursors out of certain m/z range for all spectra with a precursor (MS2 and above)
       if (!pc_mz_range.empty())
       {
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), InPrecursorMZRange<MapType::SpectrumType>(pc_left, pc_right, true)), exp.end());
+        remove_spectrum.emplace_back(InPrecursorMZRange<MapType::SpectrumType>(pc_left, pc_right, true));
       }
 
       // keep MS/MS spectra whose precursors cover at least of the given m/z values
       std::vector<double> vec_mz = getDoubleList_("peak_options:pc_mz_list");
       if (!vec_mz.empty())
       {
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsInIsolationWindow<MapType::SpectrumType>(vec_mz, true)), exp.end());
+        remove_spectrum.emplace_back(IsInIsolationWindow<MapType::SpectrumType>(vec_mz, true));
       }
 
-
       // remove by scan mode (might be a lot of spectra)
       String remove_mode = getStringOption_("spectra:remove_mode");
       if (!remove_mode.empty())
@@ -780,7 +794,7 @@ protected:
         {
           if (InstrumentSettings::NamesOfScanMode[i] == remove_mode)
           {
-            exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasScanMode<MapType::SpectrumType>((InstrumentSettings::ScanMode)i)), exp.end());
+            remove_spectrum.emplace_back(HasScanMode<MapType::SpectrumType>((InstrumentSettings::ScanMode)i));
           }
         }
       }
@@ -794,7 +808,7 @@ protected:
         {
           if (InstrumentSettings::NamesOfScanMode[i] == select_mode)
           {
-            exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasScanMode<MapType::SpectrumType>((InstrumentSettings::ScanMode)i, true)), exp.end());
+            remove_spectrum.emplace_back(HasScanMode<MapType::SpectrumType>((InstrumentSettings::ScanMode)i, true));
           }
         }
       }
@@ -808,7 +822,7 @@ protected:
         {
           if (Precursor::NamesOfActivationMethod[i] == remove_activation)
           {
-            exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasActivationMethod<MapType::SpectrumType>(ListUtils::create<String>(remove_activation))), exp.end());
+            remove_spectrum.emplace_back(HasActivationMethod<MapType::SpectrumType>(ListUtils::create<String>(remove_activation)));
           }
         }
       }
@@ -822,7 +836,7 @@ protected:
         {
           if (Precursor::NamesOfActivationMethod[i] == select_activation)
           {
-            exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasActivationMethod<MapType::SpectrumType>(ListUtils::create<String>(select_activation), true)), exp.end());
+            remove_spectrum.emplace_back(HasActivationMethod<MapType::SpectrumType>(ListUtils::create<String>(select_activation), true));
           }
         }
       }
@@ -836,7 +850,7 @@ protected:
         {
           if (IonSource::NamesOfPolarity[i] == select_polarity)
           {
-            exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), HasScanPolarity<MapType::SpectrumType>((IonSource::Polarity)i, true)), exp.end());
+            remove_spectrum.emplace_back(HasScanPolarity<MapType::SpectrumType>((IonSource::Polarity)i, true));
           }
         }
       }
@@ -845,72 +859,72 @@ protected:
       if (getFlag_("spectra:remove_zoom"))
       {
         writeDebug_("Removing zoom scans", 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsZoomSpectrum<MapType::SpectrumType>()), exp.end());
+        remove_spectrum.emplace_back(IsZoomSpectrum<MapType::SpectrumType>());
       }
 
       if (getFlag_("spectra:select_zoom"))
       {
         writeDebug_("Selecting zoom scans", 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsZoomSpectrum<MapType::SpectrumType>(true)), exp.end());
+        remove_spectrum.emplace_back(IsZoomSpectrum<MapType::SpectrumType>(true));
       }
 
       //remove based on collision energy
       if (remove_collision_l != -1 * numeric_limits<double>::max() || remove_collision_u != numeric_limits<double>::max())
       {
         writeDebug_(String("Removing collision energy scans in the range: ") + remove_collision_l + ":" + remove_collision_u, 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsInCollisionEnergyRange<PeakMap::SpectrumType>(remove_collision_l, remove_collision_u)), exp.end());
+        remove_spectrum.emplace_back(IsInCollisionEnergyRange<PeakMap::SpectrumType>(remove_collision_l, remove_collision_u));
       }
       if (select_collision_l != -1 * numeric_limits<double>::max() || select_collision_u != numeric_limits<double>::max())
       {
         writeDebug_(String("Selecting collision energy scans in the range: ") + select_collision_l + ":" + select_collision_u, 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsInCollisionEnergyRange<PeakMap::SpectrumType>(select_collision_l, select_collision_u, true)), exp.end());
+        remove_spectrum.emplace_back(IsInCollisionEnergyRange<PeakMap::SpectrumType>(select_collision_l, select_collision_u, true));
       }
 
       //remove based on isolation window size
       if (remove_isolation_width_l != -1 * numeric_limits<double>::max() || remove_isolation_width_u != numeric_limits<double>::max())
       {
         writeDebug_(String("Removing isolation windows with width in the range: ") + remove_isolation_width_l + ":" + remove_isolation_width_u, 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsInIsolationWindowSizeRange<PeakMap::SpectrumType>(remove_isolation_width_l, remove_isolation_width_u)), exp.end());
+        remove_spectrum.emplace_back(IsInIsolationWindowSizeRange<PeakMap::SpectrumType>(remove_isolation_width_l, remove_isolation_width_u));
       }
       if (select_isolation_width_l != -1 * numeric_limits<double>::max() || select_isolation_width_u != numeric_limits<double>::max())
       {
         writeDebug_(String("Selecting isolation windows with width in the range: ") + select_isolation_width_l + ":" + select_isolation_width_u, 3);
-        exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsInIsolationWindowSizeRange<PeakMap::SpectrumType>(select_isolation_width_l, select_isolation_width_u, true)), exp.end());
+        remove_spectrum.emplace_back(IsInIsolationWindowSizeRange<PeakMap::SpectrumType>(select_isolation_width_l, select_isolation_width_u, true));
       }
 
       // reannoate precursor charge if both range values are set
-      if (replace_pc_charge_in != -1 * numeric_limits<double>::max() && replace_pc_charge_out != numeric_limits<double>::max())
-      {
-        replacePrecursorCharge(exp, (int)replace_pc_charge_in, (int)replace_pc_charge_out);
-      }        
+      bool replace_pc_charge = (replace_pc_charge_in != -1 * numeric_limits<double>::max() && replace_pc_charge_out != numeric_limits<double>::max());
 
-      //remove empty scans
-      exp.getSpectra().erase(remove_if(exp.begin(), exp.end(), IsEmptySpectrum<MapType::SpectrumType>()), exp.end());
+      // calculate S/N values and delete data points below S/N threshold
+      SignalToNoiseEstimatorMedian<MapType::SpectrumType> snm;
+      if (sn > 0)
+      {
+        Param const& dc_param = getParam_().copy("algorithm:SignalToNoise:", true);
+        snm.setParameters(dc_param);
+      }
 
-      //sort
-      if (sort)
+      // returns false if the spectrum should be dropped
+      auto process_spectrum = [&](MapType::SpectrumType& spec)
       {
-        exp.sortSpectra(true);
-        if (getFlag_("peak_options:sort_peaks"))
+        for (const auto& remove : remove_spectrum)
         {
-          OPENMS_LOG_INFO << "Info: Using 'peak_options:sort_peaks' in combination with 'sort' is redundant, since 'sort' implies 'peak_options:sort_peaks'." << std::endl;
+          if (remove(spec)) return false;
         }
-      }
-      else if (getFlag_("peak_options:sort_peaks"))
-      {
-        for (Size i = 0; i < exp.size(); ++i)
+        if (replace_pc_charge)
         {
-          exp[i].sortByPosition();
+          for (auto& p : spec.getPrecursors())
+          {
+            if (p.getCharge() == (int)replace_pc_charge_in) { p.setCharge((int)replace_pc_charge_out); }
+          }
         }
-      }
+        //remove empty scans
+        if (IsEmptySpectrum<MapType::SpectrumType>()(spec)) return false;
 
-      // calculate S/N values and delete data points below S/N threshold
-      if (sn > 0)
-      {
-        SignalToNoiseEstimatorMedian<MapType::SpectrumType> snm;
-        Param const& dc_param = getParam_().copy("algorithm:SignalToNoise:", true);
-        snm.setParameters(dc_param);
-        for (auto& spec : exp)
+        if (sort_peaks)
+        {
+          spec.sortByPosition();
+        }
+        if (sn > 0)
         {
           snm.init(spec);
           for (Size i = 0; i != spec.size(); ++i)
@@ -919,6 +933,104 @@ protected:
           }
           spec.erase(remove_if(spec.begin(), spec.end(), InIntensityRange<MapType::PeakType>(1, numeric_limits<MapType::PeakType::IntensityType>::max(), true)), spec.end());
         }
+        return true;
+      };
+
+      bool remove_chromatograms(getFlag_("peak_options:remove_chromatograms"));
+      auto keep_chromatogram = [&](const MapType::ChromatogramType& c)
+      {
+        return !remove_chromatograms && !(remove_empty && c.empty());
+      };
+
+      //-------------------------------------------------------------
+      // low memory: filter on the fly
+      //-------------------------------------------------------------
+
+      if (getFlag_("peak_options:lowmemory"))
+      {
+        if (out_type != FileTypes::MZML)
+        {
+          writeLog_("Error: 'peak_options:lowmemory' requires mzML output. Aborting!");
+          return ILLEGAL_PARAMETERS;
+        }
+        if (sort || !getStringOption_("id:blacklist").empty() || !getStringOption_("consensus:blackorwhitelist:file").empty() || !getStringOption_("spectra:blackorwhitelist:file").empty())
+        {
+          writeLog_("Error: 'peak_options:lowmemory' cannot be combined with 'sort' or the black-/whitelist options, since these need the complete experiment. Aborting!");
+          return ILLEGAL_PARAMETERS;
+        }
+
+        auto keep_spectrum = [&](MapType::SpectrumType& s)
+        {
+          return (!remove_meta_enabled || checkMetaOk(s, meta_info)) && process_spectrum(s);
+        };
+
+        // first pass: determine how many spectra/chromatograms survive, since
+        // the counts are written into the header before the first spectrum
+        Size spectra_kept(0), chromatograms_kept(0);
+        {
+          MSDataTransformingConsumer counter;
+          counter.setSpectraProcessingFunc([&](MapType::SpectrumType& s) { if (keep_spectrum(s)) ++spectra_kept; });
+          counter.setChromatogramProcessingFunc([&](MapType::ChromatogramType& c) { if (keep_chromatogram(c)) ++chromatograms_kept; });
+          f.transform(in, &counter, true);
+        }
+
+        // second pass: write the surviving data
+        FilteringMSDataWritingConsumer consumer(out, keep_spectrum, keep_chromatogram);
+        consumer.getOptions() = f.getOptions();
+        consumer.setFilteredSize(spectra_kept, chromatograms_kept);
+        consumer.addDataProcessing(getProcessingInfo_(DataProcessing::FILTERING));
+        consumer.setWriteBehind(4);
+        f.transform(in, &consumer, true);
+
+        return EXECUTION_OK;
+      }
+
+      MapType exp;
+      f.load(in, exp);
+
+      // remove spectra with meta values:
+      if (remove_meta_enabled)
+      {
+        MapType exp_tmp;
+        for (MapType::ConstIterator it = exp.begin(); it != exp.end(); ++it)
+        {
+          if (checkMetaOk(*it, meta_info)) exp_tmp.addSpectrum(*it);
+        }
+        exp.clear(false);
+        exp.getSpectra().insert(exp.begin(), exp_tmp.begin(), exp_tmp.end());
+      }
+
+
+      if (!no_chromatograms)
+      {
+        // convert the spectra chromatograms to real chromatograms
+        ChromatogramTools chrom_tools;
+        chrom_tools.convertSpectraToChromatograms(exp, true);
+      }
+
+      auto& chroms = exp.getChromatograms();
+      chroms.erase(
+        remove_if(chroms.begin(), chroms.end(), [&](const MSChromatogram & c){ return !keep_chromatogram(c);} )
+        ,chroms.end());
+
+      //-------------------------------------------------------------
+      // calculations
+      //-------------------------------------------------------------
+
+      auto& spectra = exp.getSpectra();
+      Size kept = 0;
+      for (Size i = 0; i < spectra.size(); ++i)
+      {
+        if (!process_spectrum(spectra[i])) continue;
+        if (kept != i) spectra[kept] = std::move(spectra[i]);
+        ++kept;
+      }
+      spectra.resize(kept);
+
+      //sort (peaks were already sorted above)
+      if (sort)
+      {
+        exp.sortSpectra(false);
       }
 
       //
@@ -40,6 +40,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 using namespace OpenMS;
@@ -99,35 +100,6 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFGaussMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFGaussMzMLConsumer(const String& filename, const GaussFilter& gf) :
-      MSDataWritingConsumer(filename) 
-    {
-      gf_ = gf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      gf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      gf_.filter(c);
-    }
-
-  private:
-    GaussFilter gf_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -149,17 +121,33 @@ public:
   ExitCodes doLowMemAlgorithm(const GaussFilter& gauss)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    NFGaussMzMLConsumer gaussConsumer(out, gauss);
-    gaussConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    // write smoothed spectra in the background while the next ones are filtered
+    writer.setWriteBehind(4);
+
+    // smooth batches of spectra and chromatograms in parallel, in order (GaussFilter::filter is const and thread-safe)
+    MSDataParallelTransformingConsumer gaussConsumer(&writer);
+    gaussConsumer.setSpectraProcessingFunc([&gauss](MSSpectrum& s) { gauss.filter(s); });
+    gaussConsumer.setChromatogramProcessingFunc([&gauss](MSChromatogram& c) { gauss.filter(c); });
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
     ///////////////////////////////////
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
-    mz_data_file.transform(in, &gaussConsumer);
+    try
+    {
+      mz_data_file.transform(in, &gaussConsumer);
+      gaussConsumer.flush();
+    }
+    catch (Exception::IllegalArgument & e)
+    {
+      writeLog_(String("Error: ") + e.what());
+      return INCOMPATIBLE_INPUT_DATA;
+    }
 
     return EXECUTION_OK;
   }
@@ -38,6 +38,7 @@
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
@@ -101,35 +102,6 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFSGolayMzMLConsumer :
-    public MSDataWritingConsumer 
-  {
-
-  public:
-
-    NFSGolayMzMLConsumer(const String& filename, const SavitzkyGolayFilter& sgf) :
-      MSDataWritingConsumer(filename) 
-    {
-      sgf_ = sgf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      sgf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      sgf_.filter(c);
-    }
-
-  private:
-    SavitzkyGolayFilter sgf_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input raw data file ");
@@ -151,10 +123,17 @@ public:
   ExitCodes doLowMemAlgorithm(const SavitzkyGolayFilter& sgolay)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    NFSGolayMzMLConsumer sgolayConsumer(out, sgolay);
-    sgolayConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    // write smoothed spectra in the background while the next ones are filtered
+    writer.setWriteBehind(4);
+
+    // smooth batches of spectra and chromatograms in parallel, in order (SavitzkyGolayFilter::filter is const and thread-safe)
+    MSDataParallelTransformingConsumer sgolayConsumer(&writer);
+    sgolayConsumer.setSpectraProcessingFunc([&sgolay](MSSpectrum& s) { sgolay.filter(s); });
+    sgolayConsumer.setChromatogramProcessingFunc([&sgolay](MSChromatogram& c) { sgolay.filter(c); });
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
@@ -162,6 +141,7 @@ public:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &sgolayConsumer);
+    sgolayConsumer.flush();
 
     return EXECUTION_OK;
   }
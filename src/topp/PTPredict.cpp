@@ -208,6 +208,24 @@ protected:
     vector<double> labels;
     labels.resize(peptides.size(), 0);
 
+    // the training set for the OLIGO kernel is the same for every block, load it once
+    if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO && !peptides.empty())
+    {
+      String in_trainset_name = getStringOption_("in_oligo_trainset");
+      if (in_trainset_name.empty())
+      {
+        in_trainset_name = svmfile_name + "_samples";
+        writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
+      }
+      inputFileReadable_(in_trainset_name, "in_oligo_trainset");
+
+      training_samples = encoder.loadLibSVMProblem(in_trainset_name);
+      svm.setTrainingSample(training_samples);
+
+      svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
+      svm.setParameter(SVMWrapper::SIGMA, sigma);
+    }
+
     vector<String>::iterator it_from = peptides.begin();
     vector<String>::iterator it_to = peptides.begin();
     while (it_from != peptides.end())
@@ -243,22 +261,6 @@ protected:
                                                                             border_length);
       }
 
-      if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO)
-      {
-        String in_trainset_name = getStringOption_("in_oligo_trainset");
-        if (in_trainset_name.empty())
-        {
-          in_trainset_name = svmfile_name + "_samples";
-          writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
-        }
-        inputFileReadable_(in_trainset_name, "in_oligo_trainset");
-
-        training_samples = encoder.loadLibSVMProblem(in_trainset_name);
-        svm.setTrainingSample(training_samples);
-
-        svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
-        svm.setParameter(SVMWrapper::SIGMA, sigma);
-      }
       svm.getSVCProbabilities(prediction_data, predicted_likelihoods, predicted_labels);
 
       for (Size p = 0; p < temp_peptides.size(); p++)
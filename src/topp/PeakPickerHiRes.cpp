@@ -38,6 +38,7 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 using namespace OpenMS;
@@ -125,54 +126,6 @@ public:
 
 protected:
 
-  /**
-    @brief Helper class for the Low Memory peak-picking
-  */
-  class PPHiResMzMLConsumer :
-    public MSDataWritingConsumer
-  {
-
-  public:
-
-    PPHiResMzMLConsumer(String filename, const PeakPickerHiRes& pp) :
-      MSDataWritingConsumer(std::move(filename)),
-      ms_levels_(pp.getParameters().getValue("ms_levels").toIntVector())
-    {
-      pp_ = pp;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      if (ms_levels_.empty()) //auto mode
-      {
-        if (s.getType() == SpectrumSettings::CENTROID)
-        {
-          return;
-        }
-      }
-      else if (!ListUtils::contains(ms_levels_, s.getMSLevel()))
-      {
-        return;
-      }
-
-      MapType::SpectrumType sout;
-      pp_.pick(s, sout);
-      s = std::move(sout);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType & c) override
-    {
-      MapType::ChromatogramType c_out;
-      pp_.pick(c, c_out);
-      c = std::move(c_out);
-    }
-
-  private:
-
-    PeakPickerHiRes pp_;
-    std::vector<Int> ms_levels_;
-  };
-
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input profile data file ");
@@ -194,10 +147,40 @@ protected:
   ExitCodes doLowMemAlgorithm(const PeakPickerHiRes& pp)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing
     ///////////////////////////////////
-    PPHiResMzMLConsumer pp_consumer(out, pp);
-    pp_consumer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
+    // write picked spectra in the background while the next ones are picked
+    writer.setWriteBehind(4);
+
+    // pick batches of spectra in parallel, in order (PeakPickerHiRes::pick is const and thread-safe)
+    MSDataParallelTransformingConsumer pp_consumer(&writer);
+    const std::vector<Int> ms_levels = pp.getParameters().getValue("ms_levels").toIntVector();
+    pp_consumer.setSpectraProcessingFunc([&pp, &ms_levels](MSSpectrum& s)
+    {
+      if (ms_levels.empty()) //auto mode
+      {
+        if (s.getType() == SpectrumSettings::CENTROID)
+        {
+          return;
+        }
+      }
+      else if (!ListUtils::contains(ms_levels, s.getMSLevel()))
+      {
+        return;
+      }
+
+      MSSpectrum sout;
+      pp.pick(s, sout);
+      s = std::move(sout);
+    });
+    pp_consumer.setChromatogramProcessingFunc([&pp](MSChromatogram& c)
+    {
+      MSChromatogram c_out;
+      pp.pick(c, c_out);
+      c = std::move(c_out);
+    });
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
@@ -205,6 +188,7 @@ protected:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &pp_consumer);
+    pp_consumer.flush();
 
     return EXECUTION_OK;
   }
@@ -54,6 +54,7 @@
 #include <cmath>
 #include <string>
 #include <set>
+#include <unordered_map>
 //#include <typeinfo>
 
 #include <boost/algorithm/clamp.hpp>
@@ -384,7 +385,7 @@ protected:
   }
 
     
-  void readPoutAsMap_(const String& pout_file, std::map<String, PercolatorResult>& pep_map)
+  void readPoutAsMap_(const String& pout_file, std::unordered_map<String, PercolatorResult>& pep_map)
   {
     CsvFile csv_file(pout_file, '\t');
     StringList row;
@@ -397,10 +398,7 @@ protected:
       writeDebug_("PSM identifier in pout file: " + spec_ref, 10);
 
       // retain only the best result in the unlikely case that a PSMId+peptide combination occurs multiple times
-      if (pep_map.find(spec_ref) == pep_map.end())
-      {
-        pep_map.insert( map<String, PercolatorResult>::value_type ( spec_ref, res ) );
-      }
+      pep_map.emplace(spec_ref, res);
     }
   }
 
@@ -968,7 +966,9 @@ protected:
     //-------------------------------------------------------------
     // when percolator finished calculation, it stores the results -r option (with or without -U) or -m (which seems to be not working)
     //  WARNING: The -r option cannot be used in conjunction with -U: no peptide level statistics are calculated, redirecting PSM level statistics to provided file instead.
-    map<String, PercolatorResult> pep_map;
+    // PSM identifier (scan identifier + peptide) -> result; hashed, as every input PSM is looked up
+    unordered_map<String, PercolatorResult> pep_map;
+    pep_map.reserve(all_peptide_ids.size());
     String pout_target = getStringOption_("out_pout_target");
     String pout_decoy = getStringOption_("out_pout_decoy");
     String pout_target_proteins = getStringOption_("out_pout_target_proteins");
@@ -1059,7 +1059,7 @@ protected:
           //Only for super debug
           writeDebug_("PSM identifier in PeptideHit: " + psm_identifier, 10);
  
-          map<String, PercolatorResult>::iterator pr = pep_map.find(psm_identifier);
+          auto pr = pep_map.find(psm_identifier);
           if (pr != pep_map.end())
           {
             hit.setMetaValue("MS:1001492", pr->second.score);  // svm score
@@ -1213,12 +1213,18 @@ protected:
     }
     else
     {
-      std::map< std::string, OSWFile::PercolatorFeature > features;
+      // visit the results ordered by PSM identifier, so the same result is kept for duplicate PSMIds regardless of hashing
+      std::map<String, const PercolatorResult*> sorted_results;
       for (auto const &feat : pep_map)
+      {
+        sorted_results.emplace(feat.first, &feat.second);
+      }
+      std::map< std::string, OSWFile::PercolatorFeature > features;
+      for (auto const &feat : sorted_results)
       {
         features.emplace(std::piecewise_construct,
-                         std::forward_as_tuple(feat.second.PSMId),
-                         std::forward_as_tuple(feat.second.score, feat.second.qvalue, feat.second.posterior_error_prob));
+                         std::forward_as_tuple(feat.second->PSMId),
+                         std::forward_as_tuple(feat.second->score, feat.second->qvalue, feat.second->posterior_error_prob));
       }
       OSWFile::writeFromPercolator(out, osw_level, features);
     }
@@ -40,6 +40,8 @@
 #include <OpenMS/ANALYSIS/ID/AScore.h>
 #include <OpenMS/METADATA/SpectrumMetaDataLookup.h>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -260,7 +262,7 @@ protected:
   // E.g. Percolator_qvalue <-> q-value.
   // Improvement for the future would be to have unique names for the score_types
   // LuciphorAdapter uses the same strategy to backup previous scores.
-  void addScoreToMetaValues_(PeptideHit& hit, const String score_type)
+  void addScoreToMetaValues_(PeptideHit& hit, const String score_type) const
   {
     if (!hit.metaValueExists(score_type) && !hit.metaValueExists(score_type + "_score"))
     {
@@ -313,28 +315,57 @@ protected:
     SpectrumLookup lookup;
     lookup.readSpectra(exp.getSpectra());
 
+    // map IDs to spectra up front (serially, so lookup errors surface as before)
+    vector<Size> scan_ids;
+    scan_ids.reserve(pep_ids.size());
     for (const PeptideIdentification& pep : pep_ids)
     {
-      Size scan_id = lookup.findByRT(pep.getRT());
-      PeakSpectrum& temp = exp.getSpectrum(scan_id);
-      
-      vector<PeptideHit> scored_peptides;
-      for (const PeptideHit& hit : pep.getHits())
+      scan_ids.push_back(lookup.findByRT(pep.getRT()));
+    }
+
+    // PSMs are scored independently: AScore::compute keeps per-spectrum state, so every thread
+    // gets its own (identically configured) instance. Peaks were sorted on loading, so the
+    // spectra are only read. Results are stored per ID to keep the input order.
+    pep_out.resize(pep_ids.size());
+    vector<exception_ptr> errors(pep_ids.size());
+#pragma omp parallel
+    {
+      AScore thread_ascore(ascore);
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)pep_ids.size(); ++i)
       {
-        PeptideHit scored_hit = hit;
-        addScoreToMetaValues_(scored_hit, pep.getScoreType()); // backup score value
-        
-        OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep.getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
-        
-        PeptideHit phospho_sites = ascore.compute(scored_hit, temp);
-        scored_peptides.push_back(phospho_sites);
-      }
+        try
+        {
+          const PeptideIdentification& pep = pep_ids[i];
+          PeakSpectrum& temp = exp.getSpectrum(scan_ids[i]);
+
+          vector<PeptideHit> scored_peptides;
+          for (const PeptideHit& hit : pep.getHits())
+          {
+            PeptideHit scored_hit = hit;
+            addScoreToMetaValues_(scored_hit, pep.getScoreType()); // backup score value
+
+            OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep.getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
 
-      PeptideIdentification new_pep_id(pep);
-      new_pep_id.setScoreType("PhosphoScore");
-      new_pep_id.setHigherScoreBetter(true);
-      new_pep_id.setHits(scored_peptides);
-      pep_out.push_back(new_pep_id);
+            PeptideHit phospho_sites = thread_ascore.compute(scored_hit, temp);
+            scored_peptides.push_back(phospho_sites);
+          }
+
+          PeptideIdentification new_pep_id(pep);
+          new_pep_id.setScoreType("PhosphoScore");
+          new_pep_id.setHigherScoreBetter(true);
+          new_pep_id.setHits(scored_peptides);
+          pep_out[i] = new_pep_id;
+        }
+        catch (...)
+        {
+          errors[i] = current_exception();
+        }
+      }
+    }
+    for (const exception_ptr& e : errors)
+    {
+      if (e) rethrow_exception(e);
     }
     
     //-------------------------------------------------------------
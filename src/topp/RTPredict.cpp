@@ -408,6 +408,24 @@ protected:
     vector<double> rts;
     rts.resize(number_of_peptides, 0);
 
+    // the training set for the OLIGO kernel is the same for every block, load it once
+    if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO && number_of_peptides > 0)
+    {
+      String in_trainset_name = getStringOption_("in_oligo_trainset");
+      if (in_trainset_name.empty())
+      {
+        in_trainset_name = svmfile_name + "_samples";
+        writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
+      }
+      inputFileReadable_(in_trainset_name, "in_oligo_trainset");
+
+      training_samples.load(in_trainset_name);
+      svm.setTrainingSample(training_samples);
+
+      svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
+      svm.setParameter(SVMWrapper::SIGMA, sigma);
+    }
+
     vector<String>::iterator it_from = peptides.begin();
     vector<String>::iterator it_to = peptides.begin();
     vector<AASequence>::iterator it_from_mod = modified_peptides.begin();
@@ -461,19 +479,6 @@ protected:
 
       if (svm.getIntParameter(SVMWrapper::KERNEL_TYPE) == SVMWrapper::OLIGO)
       {
-        String in_trainset_name = getStringOption_("in_oligo_trainset");
-        if (in_trainset_name.empty())
-        {
-          in_trainset_name = svmfile_name + "_samples";
-          writeLog_("Warning: Using OLIGO kernel but in_oligo_trainset parameter is missing. Trying default filename: " + in_trainset_name);
-        }
-        inputFileReadable_(in_trainset_name, "in_oligo_trainset");
-
-        training_samples.load(in_trainset_name);
-        svm.setTrainingSample(training_samples);
-
-        svm.setParameter(SVMWrapper::BORDER_LENGTH, (Int) border_length);
-        svm.setParameter(SVMWrapper::SIGMA, sigma);
         svm.predict(prediction_samples, predicted_retention_times);
         prediction_samples.labels.clear();
         prediction_samples.sequences.clear();
@@ -185,8 +185,7 @@ protected:
     {
       for (Size i = 0; i < exp.size(); ++i)
       {
-        MSSpectrum tmp = exp[i];
-        tmp.clear(false);
+        MSSpectrum tmp = exp[i].copyWithoutPeaks();
         for (Size j = 0; j < exp[i].size(); j++)
         {
           if (exp[i][j].getIntensity() > min_int_cutoff)
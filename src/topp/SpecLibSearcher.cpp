@@ -38,6 +38,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Factory.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumIndex.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectraSTSimilarityScore.h>
 #include <OpenMS/COMPARISON/SPECTRA/ZhangSimilarityScore.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
@@ -47,10 +48,11 @@
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <algorithm>
 #include <ctime>
 #include <vector>
-#include <map>
 #include <cmath>
+#include <numeric>
 using namespace OpenMS;
 using namespace std;
 
@@ -140,6 +142,17 @@ protected:
     PeakSpectrumCompareFunctor::registerChildren();
     setValidStrings_("compare_function", Factory<PeakSpectrumCompareFunctor>::registeredProducts());
 
+    registerTOPPSubsection_("index", "Candidate index options. For large libraries, an approximate index preselects the most similar library spectra in the precursor window, which are then scored exactly with the compare function.");
+    registerStringOption_("index:method", "<method>", "none", "Candidate preselection. 'none' scores all library spectra in the precursor window, 'inverted_file' uses an inverted file index over binned spectra.", false, true);
+    setValidStrings_("index:method", ListUtils::create<String>("none,inverted_file"));
+    registerIntOption_("index:candidates", "<num>", 100, "Number of preselected library spectra per query and isotope that are scored exactly.", false, true);
+    setMinInt_("index:candidates", 1);
+    registerDoubleOption_("index:bin_size", "<Th>", BinnedSpectrum::DEFAULT_BIN_WIDTH_HIRES, "Bin width used for the index.", false, true);
+    setMinFloat_("index:bin_size", 1e-4);
+    registerDoubleOption_("index:bin_offset", "<offset>", BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES, "Bin offset used for the index.", false, true);
+    registerIntOption_("index:peaks", "<num>", 50, "Number of most intense peaks per spectrum used for the index.", false, true);
+    setMinInt_("index:peaks", 1);
+
     registerTOPPSubsection_("report", "Reporting Options");
     registerIntOption_("report:top_hits", "<num>", 10, "Maximum number of top scoring hits per spectrum that are reported.", false, true);
 
@@ -163,15 +176,22 @@ protected:
     addEmptyLine_();
   }
 
-  using MapLibraryPrecursorToLibrarySpectrum = multimap<double, PeakSpectrum>;
+  /// returns the precursor m/z of a library entry
+  static double precursorMZ_(const PeakSpectrum& s)
+  {
+    return s.getPrecursors()[0].getMZ();
+  }
+
+  /// annotated library spectra sorted by precursor m/z
+  using LibrarySpectra = vector<PeakSpectrum>;
     
-  MapLibraryPrecursorToLibrarySpectrum annotateIdentificationsToSpectra_(const vector<PeptideIdentification>& ids, 
+  LibrarySpectra annotateIdentificationsToSpectra_(const vector<PeptideIdentification>& ids, 
     const PeakMap& library, 
     StringList variable_modifications, 
     StringList fixed_modifications,
     double remove_peaks_below_threshold)
   {
-    MapLibraryPrecursorToLibrarySpectrum annotated_lib;
+    LibrarySpectra annotated_lib;
 
     ModificationsDB* mdb = ModificationsDB::getInstance();
 
@@ -182,7 +202,6 @@ protected:
     for (; library_it < library.end(); ++library_it, ++id_it)
     {
       const MSSpectrum& lib_spec = *library_it;
-      const double& precursor_MZ = lib_spec.getPrecursors()[0].getMZ();
 
       const PeptideIdentification& id = *id_it;
       const AASequence& aaseq = id.getHits()[0].getSequence();
@@ -264,8 +283,12 @@ protected:
            lib_entry.push_back(peak);
          }
        }
-       annotated_lib.insert(make_pair(precursor_MZ, lib_entry));
+       annotated_lib.push_back(std::move(lib_entry));
      }
+
+    // stable: entries with equal precursor m/z keep their order in the library file
+    std::stable_sort(annotated_lib.begin(), annotated_lib.end(), 
+      [](const PeakSpectrum& a, const PeakSpectrum& b) { return precursorMZ_(a) < precursorMZ_(b); });
     return annotated_lib;
   }
 
@@ -298,6 +321,9 @@ protected:
     UInt max_peaks = getIntOption_("filter:max_peaks");
     Int cut_peaks_below = getIntOption_("filter:cut_peaks_below");
 
+    bool use_index = getStringOption_("index:method") == "inverted_file";
+    Size index_candidates = getIntOption_("index:candidates");
+
     StringList fixed_modifications = getStringList_("modifications:fixed");
     StringList variable_modifications = getStringList_("modifications:variable");
 
@@ -353,7 +379,17 @@ protected:
     cout << endl;
     */
 
-    MapLibraryPrecursorToLibrarySpectrum mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+    LibrarySpectra mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+    vector<double> mslib_mz;
+    mslib_mz.reserve(mslib.size());
+    for (const PeakSpectrum& s : mslib) { mslib_mz.push_back(precursorMZ_(s)); }
+
+    BinnedSpectrumIndex index(getDoubleOption_("index:bin_size"), getDoubleOption_("index:bin_offset"), 1, getIntOption_("index:peaks"));
+    if (use_index)
+    {
+      index.build(mslib);
+      OPENMS_LOG_INFO << "Indexed " << index.size() << " library spectra (" << index.getNumberOfPostings() << " postings)." << endl;
+    }
 
     time_t end_build_time = time(nullptr);
     OPENMS_LOG_INFO << "Time needed for preprocessing data: " << (end_build_time - start_build_time) << "\n";
@@ -365,6 +401,7 @@ protected:
     // calculations
     //-------------------------------------------------------------
     double score;
+    vector<Size> candidates;
     StringList::iterator in, out_file;
     for (in  = in_spec.begin(), out_file  = out.begin(); in < in_spec.end(); ++in, ++out_file)
     {
@@ -508,20 +545,30 @@ protected:
 
 
           // determine MS2 precursors that match to the current peptide mass
-          MapLibraryPrecursorToLibrarySpectrum::const_iterator low_it, up_it;
-        
-          low_it = mslib.lower_bound(ic_query_mz - 0.5 * precursor_mass_tolerance_mz);
-          up_it = mslib.upper_bound(ic_query_mz + 0.5 * precursor_mass_tolerance_mz);
+          const double window_low = ic_query_mz - 0.5 * precursor_mass_tolerance_mz;
+          const double window_high = ic_query_mz + 0.5 * precursor_mass_tolerance_mz;
+          if (use_index)
+          {
+            // preselect the most similar library spectra, these are scored exactly below
+            index.query(filtered_query, window_low, window_high, index_candidates, candidates);
+          }
+          else
+          {
+            Size low = std::lower_bound(mslib_mz.begin(), mslib_mz.end(), window_low) - mslib_mz.begin();
+            Size up = std::upper_bound(mslib_mz.begin(), mslib_mz.end(), window_high) - mslib_mz.begin();
+            candidates.resize(up > low ? up - low : 0);
+            std::iota(candidates.begin(), candidates.end(), low);
+          }
         
           // no matching precursor in data
-          if (low_it == up_it)
+          if (candidates.empty())
           { 
             continue;
           }
        
-          for (; low_it != up_it; ++low_it)
+          for (Size c : candidates)
           {
-            const PeakSpectrum& lib_spec = low_it->second;;
+            const PeakSpectrum& lib_spec = mslib[c];
             PeptideHit hit = lib_spec.getPeptideIdentifications()[0].getHits()[0];
             const int& lib_charge = hit.getCharge();  
 
@@ -50,6 +50,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <exception>
+#include <sstream>
 
 using namespace OpenMS;
 using namespace std;
@@ -566,6 +568,49 @@ namespace OpenMS
     }
   }
 
+  // write the rows of all elements of 'items' (e.g. a feature and its peptide IDs) to 'out', in order:
+  // the rows are formatted in parallel in batches (each element with its own SVOutStream into a string
+  // buffer), which is where most of the export time goes for large maps
+  template <typename ContainerType, typename RowWriter>
+  void writeRowsBatched(ostream& out, const ContainerType& items, const String& sep, const String& replacement,
+                        String::QuotingMethod quoting_method, const RowWriter& write_rows)
+  {
+    const Size batch_size = 10000;
+    vector<string> rows(std::min(batch_size, (Size)items.size()));
+    for (Size batch_begin = 0; batch_begin < items.size(); batch_begin += batch_size)
+    {
+      const Size batch_end = std::min(batch_begin + batch_size, (Size)items.size());
+      vector<exception_ptr> errors(batch_end - batch_begin);
+#pragma omp parallel
+      {
+        stringstream buffer; // reused for all elements of a thread
+#pragma omp for schedule(dynamic, 64)
+        for (SignedSize i = batch_begin; i < (SignedSize)batch_end; ++i)
+        {
+          buffer.str("");
+          try
+          {
+            SVOutStream row_output(buffer, sep, replacement, quoting_method);
+            write_rows(row_output, items[i]);
+          }
+          catch (...)
+          {
+            errors[i - batch_begin] = current_exception();
+          }
+          rows[i - batch_begin] = buffer.str();
+        }
+      }
+      for (const exception_ptr& e : errors)
+      {
+        if (e) rethrow_exception(e);
+      }
+      for (Size i = 0; i < batch_end - batch_begin; ++i)
+      {
+        out << rows[i];
+      }
+    }
+  }
+
   class TOPPTextExporter :
     public TOPPBase
   {
@@ -807,7 +852,7 @@ protected:
           }
         }
 
-        for (const Feature& feat : feature_map)
+        writeRowsBatched(outstr, feature_map, sep, replacement, quoting_method, [&](SVOutStream& output, const Feature& feat)
         {
           if (!no_ids)
           {
@@ -842,7 +887,7 @@ protected:
               writePeptideId(output, pep, "PEPTIDE", false, false, false, peptide_id_meta_keys, peptide_hit_meta_keys);
             }
           }
-        }
+        });
         outstr.close();
       }
       else if (in_type == FileTypes::CONSENSUSXML)
@@ -1321,16 +1366,17 @@ protected:
           }
 
           // consensus features (incl. peptide annotations):
-          for (ConsensusMap::const_iterator cmit = consensus_map.begin();
-               cmit != consensus_map.end(); ++cmit)
+          writeRowsBatched(outstr, consensus_map, sep, replacement, quoting_method, [&](SVOutStream& output, const ConsensusFeature& cf)
           {
             std::vector<FeatureHandle> feature_handles(map_num_to_map_id.size(),
                                                        feature_handle_NaN);
-            output << "CONSENSUS" << *cmit;
-            for (ConsensusFeature::const_iterator cfit = cmit->begin();
-                 cfit != cmit->end(); ++cfit)
+            output << "CONSENSUS" << cf;
+            for (ConsensusFeature::const_iterator cfit = cf.begin();
+                 cfit != cf.end(); ++cfit)
             {
-              feature_handles[map_id_to_map_num[cfit->getMapIndex()]] = *cfit;
+              // (elements from maps without column header go to the first column)
+              std::map<Size, Size>::const_iterator num_it = map_id_to_map_num.find(cfit->getMapIndex());
+              feature_handles[num_it != map_id_to_map_num.end() ? num_it->second : 0] = *cfit;
             }
             for (Size fhindex = 0; fhindex < feature_handles.size(); ++fhindex)
             {
@@ -1341,7 +1387,7 @@ protected:
             {
               for (const auto& key: meta_value_keys)
               {
-                output << cmit->getMetaValue(key, "");
+                output << cf.getMetaValue(key, "");
               }
             }
             output << nl;
@@ -1350,13 +1396,13 @@ protected:
             if (!no_ids)
             {
               for (vector<PeptideIdentification>::const_iterator pit =
-                     cmit->getPeptideIdentifications().begin(); pit !=
-                   cmit->getPeptideIdentifications().end(); ++pit)
+                     cf.getPeptideIdentifications().begin(); pit !=
+                   cf.getPeptideIdentifications().end(); ++pit)
               {
                 writePeptideId(output, *pit, "PEPTIDE", false, false, false, peptide_id_meta_keys, peptide_hit_meta_keys);
               }
             }
-          }
+          });
         }
         return EXECUTION_OK;
       }
@@ -39,6 +39,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
 
 #include <map>
 
@@ -196,49 +197,71 @@ protected:
     Size dropped_by_length(0); // stats for removing candidates
     Size fasta_out_count(0);
 
-    FASTAFile::FASTAEntry fe;
-    while (ff.readNext(fe))
+    // proteins are read in batches which are digested in parallel; products are (start, length) spans of the protein sequence
+    const Size batch_size = 10000;
+    vector<FASTAFile::FASTAEntry> batch;
+    vector<vector<pair<Size, Size> > > batch_digests;
+    bool more_proteins = true;
+    while (more_proteins)
     {
-      if (!has_FASTA_output)
+      batch.clear();
+      FASTAFile::FASTAEntry fe;
+      while (batch.size() < batch_size && (more_proteins = ff.readNext(fe)))
       {
-        ProteinHit temp_protein_hit;
-        temp_protein_hit.setSequence(fe.sequence);
-        temp_protein_hit.setAccession(fe.identifier);
-        protein_identifications[0].insertHit(temp_protein_hit);
-        temp_pe.setProteinAccession(fe.identifier);
-        temp_peptide_hit.setPeptideEvidences(vector<PeptideEvidence>(1, temp_pe));
+        batch.push_back(std::move(fe));
       }
 
-      vector<AASequence> current_digest;
       if (enzyme == "none")
       {
-        current_digest.push_back(AASequence::fromString(fe.sequence));
+        batch_digests.assign(batch.size(), vector<pair<Size, Size> >());
+        for (Size i = 0; i != batch.size(); ++i)
+        {
+          batch_digests[i].emplace_back(0, batch[i].sequence.size());
+        }
       }
       else
       {
-        dropped_by_length += digestor.digest(AASequence::fromString(fe.sequence), current_digest, min_size, max_size);
+        vector<StringView> sequences;
+        sequences.reserve(batch.size());
+        for (const auto& protein : batch) { sequences.emplace_back(protein.sequence); }
+        dropped_by_length += digestor.digestUnmodified(sequences, batch_digests, min_size, max_size);
       }
 
-      String id = fe.identifier;
-      for (auto const& s : current_digest)
+      for (Size i = 0; i != batch.size(); ++i)
       {
+        const FASTAFile::FASTAEntry& protein = batch[i];
         if (!has_FASTA_output)
         {
-          temp_peptide_hit.setSequence(s);
-          peptide_identification.insertHit(temp_peptide_hit);
-          identifications.push_back(peptide_identification);
-          peptide_identification.setHits(std::vector<PeptideHit>()); // clear
+          ProteinHit temp_protein_hit;
+          temp_protein_hit.setSequence(protein.sequence);
+          temp_protein_hit.setAccession(protein.identifier);
+          protein_identifications[0].insertHit(temp_protein_hit);
+          temp_pe.setProteinAccession(protein.identifier);
+          temp_peptide_hit.setPeptideEvidences(vector<PeptideEvidence>(1, temp_pe));
         }
-        else // for FASTA file output
+
+        String id = protein.identifier;
+        for (auto const& span : batch_digests[i])
         {
-          ++fasta_out_count;
-          switch (FASTA_ID)
+          const String peptide = protein.sequence.substr(span.first, span.second);
+          if (!has_FASTA_output)
+          {
+            temp_peptide_hit.setSequence(AASequence::fromString(peptide));
+            peptide_identification.insertHit(temp_peptide_hit);
+            identifications.push_back(peptide_identification);
+            peptide_identification.setHits(std::vector<PeptideHit>()); // clear
+          }
+          else // for FASTA file output
           {
-            case PARENT: break;
-            case NUMBER: id = String(fasta_out_count); break;
-            case BOTH: id = fe.identifier + "_" + String(fasta_out_count); break;
+            ++fasta_out_count;
+            switch (FASTA_ID)
+            {
+              case PARENT: break;
+              case NUMBER: id = String(fasta_out_count); break;
+              case BOTH: id = protein.identifier + "_" + String(fasta_out_count); break;
+            }
+            ff.writeNext(FASTAFile::FASTAEntry(id, keep_FASTA_desc ? protein.description : "", peptide));
           }
-          ff.writeNext(FASTAFile::FASTAEntry(id, keep_FASTA_desc ? fe.description : "", s.toString()));
         }
       }
     }
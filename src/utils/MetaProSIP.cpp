@@ -2199,7 +2199,7 @@ protected:
   }
 
   ///< Calculates the correlation between measured isotopic_intensities and the theoretical isotopic patterns for all incorporation rates
-  void calculateCorrelation(Size n_element, const vector<double>& isotopic_intensities, IsotopePatterns patterns,
+  void calculateCorrelation(Size n_element, const vector<double>& isotopic_intensities, const IsotopePatterns& patterns,
                             MapRateToScoreType& map_rate_to_correlation_score, String labeling_element, double mass, double min_correlation_distance_to_averagine)
   {
     double min_observed_peak_fraction = getDoubleOption_("observed_peak_fraction");
@@ -3174,6 +3174,9 @@ protected:
     Size spectrum_with_no_isotopic_peaks(0);
     Size spectrum_with_isotopic_peaks(0);
 
+    // theoretical patterns only depend on the sequence (and labeling element) so compute them once per peptide
+    map<String, IsotopePatterns> sequence_to_patterns;
+
     for (FeatureMap::iterator feature_it = feature_map.begin(); feature_it != feature_map.end(); ++feature_it) // for each peptide feature
     {
       const double feature_hit_center_rt = feature_it->getRT();
@@ -3408,21 +3411,30 @@ protected:
       // calculate isotopic patterns for the given sequence, incoroporation interval/steps
       if (sip_peptide.feature_type == FEATURE_STRING || sip_peptide.feature_type == UNASSIGNED_ID_STRING)
       {
-       if (labeling_element == "N")
-       {
-         patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor15NRange(AASequence::fromString(feature_hit_seq));
-       }
-       else if (labeling_element == "C")
+       map<String, IsotopePatterns>::const_iterator cached_it = sequence_to_patterns.find(feature_hit_seq);
+       if (cached_it != sequence_to_patterns.end())
        {
-         patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor13CRange(AASequence::fromString(feature_hit_seq));
+         patterns = cached_it->second;
        }
-       else if (labeling_element == "H")
-       {
-         patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor2HRange(AASequence::fromString(feature_hit_seq));
-       }
-       else if (labeling_element == "O")
+       else
        {
-         patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor18ORange(AASequence::fromString(feature_hit_seq));
+         if (labeling_element == "N")
+         {
+           patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor15NRange(AASequence::fromString(feature_hit_seq));
+         }
+         else if (labeling_element == "C")
+         {
+           patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor13CRange(AASequence::fromString(feature_hit_seq));
+         }
+         else if (labeling_element == "H")
+         {
+           patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor2HRange(AASequence::fromString(feature_hit_seq));
+         }
+         else if (labeling_element == "O")
+         {
+           patterns = MetaProSIPDecomposition::calculateIsotopePatternsFor18ORange(AASequence::fromString(feature_hit_seq));
+         }
+         sequence_to_patterns[feature_hit_seq] = patterns;
        }
       }
       else if (sip_peptide.feature_type == UNIDENTIFIED_STRING)
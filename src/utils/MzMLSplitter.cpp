@@ -38,6 +38,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <QFile>
+#include <exception>
 #include <iomanip>
 #include <sstream>
 
@@ -165,13 +166,18 @@ protected:
     writeLog_("Total spectra: " + String(spectra.size()));
     writeLog_("Total chromatograms: " + String(chromatograms.size()));
 
+    // distribute the data first, then write the (independent) parts in parallel
+    vector<PeakMap> part_maps(parts);
+    vector<String> part_names(parts);
     Size spec_start = 0, chrom_start = 0;
     Size width = String(parts).size();
     for (Size counter = 1; counter <= parts; ++counter)
     {
       ostringstream out_name;
       out_name << out << "_part" << setw(width) << setfill('0') << counter << "of" << parts << ".mzML";
-      PeakMap part = experiment;
+      part_names[counter - 1] = out_name.str();
+      PeakMap& part = part_maps[counter - 1];
+      part = experiment;
       addDataProcessing_(part, getProcessingInfo_(DataProcessing::FILTERING));
 
       Size remaining = parts - counter + 1;
@@ -198,7 +204,25 @@ protected:
       chrom_start += n_chrom;
 
       writeLog_("Part " + String(counter) + ": " + String(n_spec) + " spectra, " + String(n_chrom) + " chromatograms");
-      MzMLFile().store(out_name.str(), part);
+    }
+
+    vector<exception_ptr> errors(parts);
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)parts; ++i)
+    {
+      try
+      {
+        MzMLFile().store(part_names[i], part_maps[i]);
+        part_maps[i] = PeakMap(); // free memory as soon as possible
+      }
+      catch (...)
+      {
+        errors[i] = current_exception();
+      }
+    }
+    for (const exception_ptr& e : errors)
+    {
+      if (e) rethrow_exception(e);
     }
 
     return EXECUTION_OK;
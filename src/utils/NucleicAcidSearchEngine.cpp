@@ -1359,7 +1359,7 @@ protected:
                 // @TODO: is "observed - calculated" the right way around?
                 ah.precursor_error_ppm =
                   (prec_it->first - candidate_mass) / candidate_mass * 1.0e6;
-                ah.annotations = annotations;
+                ah.annotations = std::move(annotations);
                 ah.precursor_ref = &(prec_it->second);
               }
             }
@@ -227,6 +227,7 @@ class TOPPOpenSwathMzMLFileCacher
         f.setLogType(log_type_);
 
         MSDataCachedConsumer consumer(out_cached, true);
+        consumer.setWriteBehind(16);
         PeakFileOptions opt = f.getOptions();
         opt.setMaxDataPoolSize(batchSize);
         f.setOptions(opt);
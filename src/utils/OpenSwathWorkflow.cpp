@@ -530,7 +530,7 @@ protected:
 
     registerIntOption_("batchSize", "<number>", 1000, "The batch size of chromatograms to process (0 means to only have one batch, sensible values are around 250-1000)", false, true);
     setMinInt_("batchSize", 0);
-    registerIntOption_("outer_loop_threads", "<number>", -1, "How many threads should be used for the outer loop (-1 use all threads, use 4 to analyze 4 SWATH windows in memory at once).", false, true);
+    registerIntOption_("outer_loop_threads", "<number>", -1, "How many SWATH windows should be analyzed at once (-1 no limit, use 4 to hold at most 4 SWATH windows in memory at once). All threads work on the batches of these windows.", false, true);
 
     registerIntOption_("ms1_isotopes", "<number>", 3, "The number of MS1 isotopes used for extraction", false, true);
     setMinInt_("ms1_isotopes", 0);
@@ -938,6 +938,10 @@ protected:
     FeatureMap out_featureFile;
     OpenSwathTSVWriter tsvwriter(out_tsv, file_list[0], use_ms1_traces, sonar); // only active if filename not empty
     OpenSwathOSWWriter oswwriter(out_osw, run_id, file_list[0], use_ms1_traces, sonar, enable_uis_scoring); // only active if filename not empty
+    if (oswwriter.isActive())
+    {
+      oswwriter.setWriteBehind(16);
+    }
 
     ///////////////////////////////////
     // Extract and score
@@ -956,6 +960,7 @@ protected:
       wf.performExtraction(swath_maps, trafo_rtnorm, cp, cp_ms1, feature_finder_param, transition_exp,
           out_featureFile, !out.empty(), tsvwriter, oswwriter, chromatogramConsumer, batchSize, ms1_isotopes, load_into_memory);
     }
+    oswwriter.flush();
 
     if (!out.empty())
     {
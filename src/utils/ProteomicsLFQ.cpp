@@ -82,6 +82,8 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderMultiplexAlgorithm.h>
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 using Internal::IDBoostGraph;
@@ -246,6 +248,11 @@ protected:
                                                                      " sequence as a candidate per feature in the same file.", false, true);
     setValidStrings_("keep_feature_top_psm_only", ListUtils::create<String>("true,false"));
 
+    registerIntOption_("parallel_runs", "<number>", 1, "Number of MS runs of a fraction that are processed (centroiding, calibration, feature detection) concurrently. "
+                                                        "Each concurrently processed run keeps its spectra in memory, so this also bounds the peak memory usage. "
+                                                        "Algorithms called for a run use the remaining threads only if nested parallelism is enabled (OMP_MAX_ACTIVE_LEVELS).", false, true);
+    setMinInt_("parallel_runs", 1);
+
     registerTOPPSubsection_("Seeding", "Parameters for seeding of untargeted features");
     registerDoubleOption_("Seeding:intThreshold", "<threshold>", 1e4, "Peak intensity threshold applied in seed detection.", false, true);
     registerStringOption_("Seeding:charge", "<minChg:maxChg>", "2:5", "Charge range considered for untargeted feature seeds.", false, true); //TODO infer from IDs?
@@ -999,170 +1006,214 @@ protected:
     return EXECUTION_OK;
   }
  
-  ExitCodes quantifyFraction_(
-    const pair<unsigned int, std::vector<String> > & ms_files, 
-    const map<String, String>& mzfile2idfile, 
-    double median_fwhm,
+  /// Processes a single MS run of a fraction: centroiding, ID loading, (optional) recalibration and ID transfer, and feature detection.
+  /// Only reads members and its arguments, so different runs may be processed concurrently.
+  ExitCodes quantifyRun_(
+    const String& mz_file,
+    const Size fraction,
+    const Size fraction_group,
+    const map<String, String>& mzfile2idfile,
     const multimap<Size, PeptideIdentification> & transfered_ids,
-    ConsensusMap & consensus_fraction,
-    vector<TransformationDescription> & transformations,
-    double& max_alignment_diff,
+    const vector<TransformationDescription> & transformations,
+    FeatureMap& feature_map,
+    String& id_MS_run_ref,
+    double& median_fwhm,
     set<String>& fixed_modifications,
     set<String>& variable_modifications)
   {
-    vector<FeatureMap> feature_maps;
-    const Size fraction = ms_files.first;
-
     const bool is_already_aligned = !transformations.empty();
 
-    // debug output
-    writeDebug_("Processing fraction number: " + String(fraction) + "\nFiles: ",  1);
-    for (String const & mz_file : ms_files.second) { writeDebug_(mz_file,  1); }
+    writeDebug_("Processing file: " + mz_file,  1);
+    // centroid spectra (if in profile mode) and correct precursor masses
+    MSExperiment ms_centroided;    
 
-    // for sanity checks we collect the primary MS run basenames as well as the ones stored in the ID files (below)
-    StringList id_MS_run_ref;
-    StringList in_MS_run = ms_files.second;
+    {
+      ExitCodes e = centroidAndCorrectPrecursors_(mz_file, ms_centroided);
+      if (e != EXECUTION_OK) { return e; }
+    }
+
+    // load and clean identification data associated with MS run
+    vector<ProteinIdentification> protein_ids;
+    vector<PeptideIdentification> peptide_ids;
+    const String& mz_file_abs_path = File::absolutePath(mz_file);
+    const String& id_file_abs_path = File::absolutePath(mzfile2idfile.at(mz_file_abs_path));
 
-    // for each MS file of current fraction (e.g., all MS files that measured the n-th fraction) 
-    Size fraction_group{1};
-    for (String const & mz_file : ms_files.second)
     {
-      writeDebug_("Processing file: " + mz_file,  1);
-      // centroid spectra (if in profile mode) and correct precursor masses
-      MSExperiment ms_centroided;    
+      ExitCodes e = loadAndCleanupIDFile_(id_file_abs_path, mz_file, fraction_group, fraction, protein_ids, peptide_ids, fixed_modifications, variable_modifications);
+      if (e != EXECUTION_OK) return e;
+    }
 
-      {
-        ExitCodes e = centroidAndCorrectPrecursors_(mz_file, ms_centroided);
-        if (e != EXECUTION_OK) { return e; }
-      }
+    StringList id_msfile_ref;
+    protein_ids[0].getPrimaryMSRunPath(id_msfile_ref);
+    id_MS_run_ref = id_msfile_ref[0];
+   
+    //-------------------------------------------------------------
+    // Internal Calibration of spectra peaks and precursor peaks with high-confidence IDs
+    //-------------------------------------------------------------
+    if (getStringOption_("mass_recalibration") == "true")
+    {
+      recalibrateMasses_(ms_centroided, peptide_ids, id_file_abs_path);
+    }
 
-      // load and clean identification data associated with MS run
-      vector<ProteinIdentification> protein_ids;
-      vector<PeptideIdentification> peptide_ids;
-      const String& mz_file_abs_path = File::absolutePath(mz_file);
-      const String& id_file_abs_path = File::absolutePath(mzfile2idfile.at(mz_file_abs_path));
+    vector<ProteinIdentification> ext_protein_ids;
+    vector<PeptideIdentification> ext_peptide_ids;
 
-      {
-        ExitCodes e = loadAndCleanupIDFile_(id_file_abs_path, mz_file, fraction_group, fraction, protein_ids, peptide_ids, fixed_modifications, variable_modifications);
-        if (e != EXECUTION_OK) return e;
-      }
+    //////////////////////////////////////////////////////
+    // Transfer aligned IDs
+    //////////////////////////////////////////////////////
+    if (!transfered_ids.empty())
+    {
+      OPENMS_PRECONDITION(is_already_aligned, "Data has not been aligned.")
 
-      StringList id_msfile_ref;
-      protein_ids[0].getPrimaryMSRunPath(id_msfile_ref);
-      id_MS_run_ref.push_back(id_msfile_ref[0]);
-     
-      //-------------------------------------------------------------
-      // Internal Calibration of spectra peaks and precursor peaks with high-confidence IDs
-      //-------------------------------------------------------------
-      if (getStringOption_("mass_recalibration") == "true")
+      // transform observed IDs and spectra
+      MapAlignmentTransformer::transformRetentionTimes(peptide_ids, transformations[fraction_group - 1]);
+      MapAlignmentTransformer::transformRetentionTimes(ms_centroided, transformations[fraction_group - 1]);
+
+      // copy the (already) aligned, consensus feature derived ids that are to be transferred to this map to peptide_ids
+      auto range = transfered_ids.equal_range(fraction_group - 1);
+      for (auto& it = range.first; it != range.second; ++it)
       {
-        recalibrateMasses_(ms_centroided, peptide_ids, id_file_abs_path);
+         PeptideIdentification trans = it->second;
+         trans.setIdentifier(protein_ids[0].getIdentifier());
+         peptide_ids.push_back(trans);
       }
+    }
 
-      vector<ProteinIdentification> ext_protein_ids;
-      vector<PeptideIdentification> ext_peptide_ids;
+    //////////////////////////////////////////
+    // Chromatographic parameter estimation
+    //////////////////////////////////////////
+    median_fwhm = estimateMedianChromatographicFWHM_(ms_centroided);
 
-      //////////////////////////////////////////////////////
-      // Transfer aligned IDs
-      //////////////////////////////////////////////////////
-      if (!transfered_ids.empty())
-      {
-        OPENMS_PRECONDITION(is_already_aligned, "Data has not been aligned.")
+    //-------------------------------------------------------------
+    // Feature detection
+    //-------------------------------------------------------------   
+    ///////////////////////////////////////////////
 
-        // transform observed IDs and spectra
-        MapAlignmentTransformer::transformRetentionTimes(peptide_ids, transformations[fraction_group - 1]);
-        MapAlignmentTransformer::transformRetentionTimes(ms_centroided, transformations[fraction_group - 1]);
+    // Run MTD before FFM
 
-        // copy the (already) aligned, consensus feature derived ids that are to be transferred to this map to peptide_ids
-        auto range = transfered_ids.equal_range(fraction_group - 1);
-        for (auto& it = range.first; it != range.second; ++it)
-        {
-           PeptideIdentification trans = it->second;
-           trans.setIdentifier(protein_ids[0].getIdentifier());
-           peptide_ids.push_back(trans);
-        }
+    // create empty feature map and annotate MS file
+    FeatureMap seeds;
+    seeds.setPrimaryMSRunPath({mz_file});
+
+    if (getStringOption_("targeted_only") == "false")
+    {
+      calculateSeeds_(ms_centroided, seeds, median_fwhm);
+      if (debug_level_ > 666)
+      {
+        FeatureXMLFile().store("debug_seeds_fraction_" + String(fraction) + "_" + String(fraction_group) + ".featureXML", seeds);
       }
+    }
 
-      //////////////////////////////////////////
-      // Chromatographic parameter estimation
-      //////////////////////////////////////////
-      median_fwhm = estimateMedianChromatographicFWHM_(ms_centroided);
+    /////////////////////////////////////////////////
+    // Run FeatureFinderIdentification
 
-      //-------------------------------------------------------------
-      // Feature detection
-      //-------------------------------------------------------------   
-      ///////////////////////////////////////////////
+    FeatureMap fm;
 
-      // Run MTD before FFM
+    FeatureFinderIdentificationAlgorithm ffi;
+    ffi.getMSData().swap(ms_centroided);
+    ffi.getProgressLogger().setLogType(log_type_);
 
-      // create empty feature map and annotate MS file
-      FeatureMap seeds;
-      seeds.setPrimaryMSRunPath({mz_file});
+    Param ffi_param = getParam_().copy("PeptideQuantification:", true);
+    ffi_param.setValue("detect:peak_width", 5.0 * median_fwhm);
+    ffi_param.setValue("EMGScoring:init_mom", "true");
+    ffi_param.setValue("EMGScoring:max_iteration", 100);
+    ffi_param.setValue("debug", debug_level_); // pass down debug level
 
-      if (getStringOption_("targeted_only") == "false")
-      {
-        calculateSeeds_(ms_centroided, seeds, median_fwhm);
-        if (debug_level_ > 666)
-        {
-          FeatureXMLFile().store("debug_seeds_fraction_" + String(ms_files.first) + "_" + String(fraction_group) + ".featureXML", seeds);
-        }
-      }
+    ffi.setParameters(ffi_param);
+    writeDebug_("Parameters passed to FeatureFinderIdentification algorithm", ffi_param, 3);
 
-      /////////////////////////////////////////////////
-      // Run FeatureFinderIdentification
+    FeatureMap tmp = fm;
 
-      FeatureMap fm;
+    ffi.run(peptide_ids, 
+      protein_ids, 
+      ext_peptide_ids, 
+      ext_protein_ids, 
+      tmp,
+      seeds,
+      mz_file);
 
-      FeatureFinderIdentificationAlgorithm ffi;
-      ffi.getMSData().swap(ms_centroided);
-      ffi.getProgressLogger().setLogType(log_type_);
+    // TODO: consider moving this to FFid
+    // free parts of feature map not needed for further processing (e.g., subfeatures...)
+    for (auto & f : tmp)
+    {
+      //TODO keep FWHM meta value for QC
+      f.clearMetaInfo();
+      f.setSubordinates({});
+      f.setConvexHulls({});
+    }
 
-      Param ffi_param = getParam_().copy("PeptideQuantification:", true);
-      ffi_param.setValue("detect:peak_width", 5.0 * median_fwhm);
-      ffi_param.setValue("EMGScoring:init_mom", "true");
-      ffi_param.setValue("EMGScoring:max_iteration", 100);
-      ffi_param.setValue("debug", debug_level_); // pass down debug level
+    IDConflictResolverAlgorithm::resolve(tmp,
+        getStringOption_("keep_feature_top_psm_only") == "false"); // keep only best peptide per feature per file
 
-      ffi.setParameters(ffi_param);
-      writeDebug_("Parameters passed to FeatureFinderIdentification algorithm", ffi_param, 3);
+    feature_map = std::move(tmp);
+    
+    if (debug_level_ > 666)
+    {
+      FeatureXMLFile().store("debug_fraction_" + String(fraction) + "_" + String(fraction_group) + ".featureXML", feature_map);
+    }
 
-      FeatureMap tmp = fm;
+    if (debug_level_ > 670)
+    {
+      MzMLFile().store("debug_fraction_" + String(fraction) + "_" + String(fraction_group) + "_chroms.mzML", ffi.getChromatograms());
+    }
+    return EXECUTION_OK;
+  }
 
-      ffi.run(peptide_ids, 
-        protein_ids, 
-        ext_peptide_ids, 
-        ext_protein_ids, 
-        tmp,
-        seeds,
-        mz_file);
+  ExitCodes quantifyFraction_(
+    const pair<unsigned int, std::vector<String> > & ms_files, 
+    const map<String, String>& mzfile2idfile, 
+    double median_fwhm,
+    const multimap<Size, PeptideIdentification> & transfered_ids,
+    ConsensusMap & consensus_fraction,
+    vector<TransformationDescription> & transformations,
+    double& max_alignment_diff,
+    set<String>& fixed_modifications,
+    set<String>& variable_modifications)
+  {
+    vector<FeatureMap> feature_maps;
+    const Size fraction = ms_files.first;
 
-      // TODO: consider moving this to FFid
-      // free parts of feature map not needed for further processing (e.g., subfeatures...)
-      for (auto & f : tmp)
-      {
-        //TODO keep FWHM meta value for QC
-        f.clearMetaInfo();
-        f.setSubordinates({});
-        f.setConvexHulls({});
-      }
+    const bool is_already_aligned = !transformations.empty();
 
-      IDConflictResolverAlgorithm::resolve(tmp,
-          getStringOption_("keep_feature_top_psm_only") == "false"); // keep only best peptide per feature per file
+    // debug output
+    writeDebug_("Processing fraction number: " + String(fraction) + "\nFiles: ",  1);
+    for (String const & mz_file : ms_files.second) { writeDebug_(mz_file,  1); }
 
-      feature_maps.push_back(tmp);
-      
-      if (debug_level_ > 666)
+    // for sanity checks we collect the primary MS run basenames as well as the ones stored in the ID files (below)
+    StringList in_MS_run = ms_files.second;
+
+    // for each MS file of current fraction (e.g., all MS files that measured the n-th fraction):
+    // runs are independent until alignment, so up to "parallel_runs" of them are processed concurrently
+    const SignedSize n_runs = SignedSize(ms_files.second.size());
+    feature_maps.resize(n_runs);
+    StringList id_MS_run_ref(n_runs);
+    vector<double> run_fwhm(n_runs, median_fwhm);
+    vector<set<String>> run_fixed_modifications(n_runs), run_variable_modifications(n_runs);
+    vector<ExitCodes> run_exit_codes(n_runs, EXECUTION_OK);
+    vector<std::exception_ptr> run_errors(n_runs);
+    const int parallel_runs = std::max(1, std::min(getIntOption_("parallel_runs"), int(n_runs)));
+#pragma omp parallel for num_threads(parallel_runs) schedule(dynamic, 1)
+    for (SignedSize i = 0; i < n_runs; ++i)
+    {
+      try
       {
-        FeatureXMLFile().store("debug_fraction_" + String(ms_files.first) + "_" + String(fraction_group) + ".featureXML", feature_maps.back());
+        run_exit_codes[i] = quantifyRun_(ms_files.second[i], fraction, i + 1, mzfile2idfile, transfered_ids, transformations,
+          feature_maps[i], id_MS_run_ref[i], run_fwhm[i], run_fixed_modifications[i], run_variable_modifications[i]);
       }
-
-      if (debug_level_ > 670)
+      catch (...)
       {
-        MzMLFile().store("debug_fraction_" + String(ms_files.first) + "_" + String(fraction_group) + "_chroms.mzML", ffi.getChromatograms());
+        run_errors[i] = std::current_exception();
       }
-
-      ++fraction_group;
     }
+    for (SignedSize i = 0; i < n_runs; ++i)
+    {
+      if (run_errors[i]) { std::rethrow_exception(run_errors[i]); }
+      if (run_exit_codes[i] != EXECUTION_OK) { return run_exit_codes[i]; }
+      fixed_modifications.insert(run_fixed_modifications[i].begin(), run_fixed_modifications[i].end());
+      variable_modifications.insert(run_variable_modifications[i].begin(), run_variable_modifications[i].end());
+    }
+    // the chromatographic peak width of the last run is used for linking
+    if (n_runs > 0) { median_fwhm = run_fwhm.back(); }
 
     // Check for common mistake that order of input files have been switched.
     // This is the case if basenames are identical but the order does not match.
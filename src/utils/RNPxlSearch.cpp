@@ -57,11 +57,7 @@
 #include <OpenMS/DATASTRUCTURES/StringView.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/ThresholdMower.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
-#include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
-#include <OpenMS/FILTERING/DATAREDUCTION/Deisotoper.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/SpectrumPreprocessingPipeline.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
@@ -408,91 +404,41 @@ protected:
    */
   void preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, bool single_charge_spectra, bool annotate_charge = false)
   {
-    // filter MS2 map
-    // remove 0 intensities
-    ThresholdMower threshold_mower_filter;
-    threshold_mower_filter.filterPeakMap(exp);
-
-    Normalizer normalizer;
-    normalizer.filterPeakMap(exp);
+    // filter MS2 map: remove low intensities, normalize, deisotope and remove noise in one pass per spectrum
+    SpectrumPreprocessingPipeline pipeline;
+    Param pipeline_param = pipeline.getParameters();
+    pipeline_param.setValue("steps", std::vector<std::string>{"threshold", "normalize", "deisotope", "window_mower", "nlargest"});
+    pipeline_param.setValue("deisotope:fragment_tolerance", fragment_mass_tolerance);
+    pipeline_param.setValue("deisotope:fragment_unit", fragment_mass_tolerance_unit_ppm ? "ppm" : "Da");
+    pipeline_param.setValue("deisotope:min_charge", 1);
+    pipeline_param.setValue("deisotope:max_charge", 3);
+    pipeline_param.setValue("deisotope:keep_only_deisotoped", "false");
+    pipeline_param.setValue("deisotope:min_isopeaks", 2);
+    pipeline_param.setValue("deisotope:max_isopeaks", 10);
+    pipeline_param.setValue("deisotope:make_single_charged", single_charge_spectra ? "true" : "false");
+    pipeline_param.setValue("deisotope:annotate_charge", annotate_charge ? "true" : "false");
+    pipeline_param.setValue("window_mower:windowsize", 100.0);
+    pipeline_param.setValue("window_mower:peakcount", 20);
+    pipeline_param.setValue("nlargest:n", 400);
+    pipeline.setParameters(pipeline_param);
 
     // sort by rt
     exp.sortSpectra(false);
 
-    // filter settings
-    WindowMower window_mower_filter;
-    Param filter_param = window_mower_filter.getParameters();
-    filter_param.setValue("windowsize", 100.0, "The size of the sliding window along the m/z axis.");
-    filter_param.setValue("peakcount", 20, "The number of peaks that should be kept.");
-    filter_param.setValue("movetype", "jump", "Whether sliding window (one peak steps) or jumping window (window size steps) should be used.");
-    window_mower_filter.setParameters(filter_param);
-
-    NLargest nlargest_filter = NLargest(400);
+    // spectra are sorted by m/z afterwards
+    pipeline.filterPeakMap(exp);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (SignedSize exp_index = 0; exp_index < (SignedSize)exp.size(); ++exp_index)
+  #ifdef DEBUG_RNPXLSEARCH
+    for (Size exp_index = 0; exp_index != exp.size(); ++exp_index)
     {
-      // sort by mz
-      exp[exp_index].sortByPosition();
-
-      // deisotope
-      Deisotoper::deisotopeAndSingleCharge(exp[exp_index],
-                                         fragment_mass_tolerance, fragment_mass_tolerance_unit_ppm,
-                                         1, 3,
-                                         false,
-                                         2, 10,
-                                         single_charge_spectra,
-                                         annotate_charge);
-    #ifdef DEBUG_RNPXLSEARCH
-      cout << "after deisotoping..." << endl;
-      cout << "Fragment m/z and intensities for spectrum: " << exp_index << endl;
-//      for (Size i = 0; i != exp[exp_index].size(); ++i) cout << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << endl;
-      cout << "Fragment charges in spectrum: " << exp_index  << endl;
-      if (exp[exp_index].getIntegerDataArrays().size())
-        for (Size i = 0; i != exp[exp_index].size(); ++i)
-          cout  << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << "\t"  << exp[exp_index].getIntegerDataArrays()[0][i] << endl;
-      cout << endl;
-    #endif
-
-      // remove noise
-      window_mower_filter.filterPeakSpectrum(exp[exp_index]);
-
-    #ifdef DEBUG_RNPXLSEARCH
-      cout << "after mower..." << endl;
-      cout << "Fragment m/z and intensities for spectrum: " << exp_index << endl;
-      for (Size i = 0; i != exp[exp_index].size(); ++i) cout << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << endl;
-      cout << "Fragment charges in spectrum: " << exp_index  << endl;
-      if (exp[exp_index].getIntegerDataArrays().size())
-        for (Size i = 0; i != exp[exp_index].size(); ++i)
-          cout  << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << "\t"  << exp[exp_index].getIntegerDataArrays()[0][i] << endl;
-    #endif
-
-      nlargest_filter.filterPeakSpectrum(exp[exp_index]);
-
-    #ifdef DEBUG_RNPXLSEARCH
-      cout << "after nlargest..." << endl;
-      cout << "Fragment m/z and intensities for spectrum: " << exp_index << endl;
-      for (Size i = 0; i != exp[exp_index].size(); ++i) cout << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << endl;
-      cout << "Fragment charges in spectrum: " << exp_index  << endl;
-      if (exp[exp_index].getIntegerDataArrays().size())
-        for (Size i = 0; i != exp[exp_index].size(); ++i)
-          cout  << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << "\t"  << exp[exp_index].getIntegerDataArrays()[0][i] << endl;
-    #endif
-
-      // sort (nlargest changes order)
-      exp[exp_index].sortByPosition();
-
-    #ifdef DEBUG_RNPXLSEARCH
-      cout << "after sort..." << endl;
+      cout << "after preprocessing..." << endl;
       cout << "Fragment m/z and intensities for spectrum: " << exp_index << endl;
       for (Size i = 0; i != exp[exp_index].size(); ++i) cout << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << endl;
       if (exp[exp_index].getIntegerDataArrays().size())
         for (Size i = 0; i != exp[exp_index].size(); ++i)
           cout  << exp[exp_index][i].getMZ() << "\t" << exp[exp_index][i].getIntensity() << "\t"  << exp[exp_index].getIntegerDataArrays()[0][i] << endl;
-    #endif
     }
+  #endif
 
 //    MzMLFile().store(String("RNPxlSearch_a_") + String((int)annotate_charge) + ".mzML", exp);
   }
@@ -577,6 +523,8 @@ protected:
     pa.setValue("is_relative_tolerance", fragment_mass_tolerance_unit_ppm ? "true" : "false");
     spectrum_aligner.setParameters(pa);
 
+    const auto mod_combination_its = indexModCombinations_(mm);
+
     // remove all but top n scoring for localization (usually all but the first one)
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -606,8 +554,7 @@ protected:
         for (Size i = 0; i != annotated_hits[scan_index].size(); ++i)
         {
           // determine RNA on precursor from index in map
-          auto mod_combinations_it = mm.mod_combinations.begin();
-          std::advance(mod_combinations_it, annotated_hits[scan_index][i].rna_mod_index);
+          auto mod_combinations_it = mod_combination_its[annotated_hits[scan_index][i].rna_mod_index];
           const String precursor_rna_adduct = *mod_combinations_it->second.begin();
           const vector<NucleotideToFeasibleFragmentAdducts>& feasible_MS2_adducts = all_feasible_adducts.at(precursor_rna_adduct).feasible_adducts;
 
@@ -661,8 +608,7 @@ protected:
         const double fixed_and_variable_modified_peptide_weight = fixed_and_variable_modified_peptide.getMonoWeight();
 
         // determine RNA on precursor from index in map
-        std::map<String, std::set<String> >::const_iterator mod_combinations_it = mm.mod_combinations.begin();
-        std::advance(mod_combinations_it, a.rna_mod_index);
+        std::map<String, std::set<String> >::const_iterator mod_combinations_it = mod_combination_its[a.rna_mod_index];
         const String precursor_rna_adduct = *mod_combinations_it->second.begin();
         const double precursor_rna_weight = EmpiricalFormula(mod_combinations_it->first).getMonoWeight();
 
@@ -1297,6 +1243,18 @@ protected:
     }
   }
 
+  /// Iterators into the RNA mod combinations indexed by rna_mod_index (so hits don't need to walk the map)
+  static vector<std::map<String, std::set<String> >::const_iterator> indexModCombinations_(const RNPxlModificationMassesResult& mm)
+  {
+    vector<std::map<String, std::set<String> >::const_iterator> mod_combination_its;
+    mod_combination_its.reserve(mm.mod_combinations.size());
+    for (auto it = mm.mod_combinations.cbegin(); it != mm.mod_combinations.cend(); ++it)
+    {
+      mod_combination_its.push_back(it);
+    }
+    return mod_combination_its;
+  }
+
   /// Filter by top scoring hits, reconstruct original peptide from memory efficient structure, and add additional meta information.
   void postProcessHits_(const PeakMap& exp,
     vector<vector<AnnotatedHit> >& annotated_hits,
@@ -1309,6 +1267,8 @@ protected:
     Size max_variable_mods_per_peptide,
     const map<String, PrecursorPurity::PurityScores>& purities)
   {
+      const auto mod_combination_its = indexModCombinations_(mm);
+
       // remove all but top n scoring (Note: this is currently necessary as postScoreHits_ might reintroduce nucleotide specific hits for fast scoring)
 #ifdef _OPENMP
 #pragma omp parallel for
@@ -1364,8 +1324,7 @@ protected:
           ph.setMetaValue(String("RNPxl:score"), ah.score); // important for Percolator feature set because the PeptideHit score might be overwritten by a q-value
 
           // determine RNA modification from index in map
-          std::map<String, std::set<String> >::const_iterator mod_combinations_it = mm.mod_combinations.begin();
-          std::advance(mod_combinations_it, ah.rna_mod_index);
+          std::map<String, std::set<String> >::const_iterator mod_combinations_it = mod_combination_its[ah.rna_mod_index];
           ph.setMetaValue(String("RNPxl:total_loss_score"), ah.total_loss_score);
           ph.setMetaValue(String("RNPxl:immonium_score"), ah.immonium_score);
           ph.setMetaValue(String("RNPxl:precursor_score"), ah.precursor_score);
@@ -1701,6 +1660,17 @@ protected:
     // calculate all feasible fragment adducts from all possible precursor adducts
     RNPxlParameterParsing::PrecursorsToMS2Adducts all_feasible_fragment_adducts = RNPxlParameterParsing::getAllFeasibleFragmentAdducts(mm, nucleotide_to_fragment_adducts, can_xl_);
 
+    // precursor adduct name and its feasible MS2 adducts / marker ions for every rna_mod_index, shared by all threads
+    vector<String> precursor_rna_adducts;
+    vector<const MS2AdductsOfSinglePrecursorAdduct*> precursor_ms2_adducts;
+    for (const auto& mod_combination : mm.mod_combinations)
+    {
+      const String& precursor_rna_adduct = *mod_combination.second.begin();
+      precursor_rna_adducts.push_back(precursor_rna_adduct);
+      auto ms2_adducts_it = all_feasible_fragment_adducts.find(precursor_rna_adduct);
+      precursor_ms2_adducts.push_back(ms2_adducts_it != all_feasible_fragment_adducts.end() ? &ms2_adducts_it->second : nullptr);
+    }
+
     // calculate FDR
     FalseDiscoveryRate fdr;
     Param p = fdr.getParameters();
@@ -1894,6 +1864,10 @@ protected:
                        precursor_sub_score_spectrum,
                        marker_ions_sub_score_spectrum;
 
+          // unshifted partial loss ion templates only depend on the peptide, so they are shared by all RNA adducts
+          PeakSpectrum partial_loss_template_z1, partial_loss_template_z2, partial_loss_template_z3;
+          bool partial_loss_templates_generated(false);
+
           // iterate over all RNA sequences, calculate peptide mass and generate complete loss spectrum only once as this can potentially be reused
           Size rna_mod_index = 0;
 
@@ -1945,9 +1919,7 @@ protected:
               PeakSpectrum partial_loss_spectrum_z1, partial_loss_spectrum_z2;
 
               // retrieve RNA adduct name
-              auto mod_combinations_it = mm.mod_combinations.begin();
-              std::advance(mod_combinations_it, rna_mod_index);
-              const String& precursor_rna_adduct = *mod_combinations_it->second.begin();
+              const String& precursor_rna_adduct = precursor_rna_adducts[rna_mod_index];
 
               if (precursor_rna_adduct == "none")
               {
@@ -2031,14 +2003,21 @@ protected:
               }
               else  // score peptide with RNA adduct
               {
-                PeakSpectrum partial_loss_template_z1, partial_loss_template_z2, partial_loss_template_z3;
-                partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z1, fixed_and_variable_modified_peptide, 1, 1);
-                partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z2, fixed_and_variable_modified_peptide, 2, 2);
-                partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z3, fixed_and_variable_modified_peptide, 3, 3);
+                if (!partial_loss_templates_generated) // only create once per peptide
+                {
+                  partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z1, fixed_and_variable_modified_peptide, 1, 1);
+                  partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z2, fixed_and_variable_modified_peptide, 2, 2);
+                  partial_loss_spectrum_generator.getSpectrum(partial_loss_template_z3, fixed_and_variable_modified_peptide, 3, 3);
+                  partial_loss_templates_generated = true;
+                }
 
                 // generate all partial loss spectra (excluding the complete loss spectrum) merged into one spectrum
                 // get RNA fragment shifts in the MS2 (based on the precursor RNA/DNA)
-                auto const & all_NA_adducts = all_feasible_fragment_adducts.at(precursor_rna_adduct);
+                if (precursor_ms2_adducts[rna_mod_index] == nullptr)
+                {
+                  throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, precursor_rna_adduct);
+                }
+                auto const & all_NA_adducts = *precursor_ms2_adducts[rna_mod_index];
                 const vector<NucleotideToFeasibleFragmentAdducts>& feasible_MS2_adducts = all_NA_adducts.feasible_adducts;
                 // get marker ions
                 const vector<FragmentAdductDefinition_>& marker_ions = all_NA_adducts.marker_ions;
@@ -2405,42 +2384,26 @@ protected:
     // bad score, likely wihout any single matching peak
     if (total_loss_score < 0.01) { return; }
 
-    immonium_sub_score = 0;
-    precursor_sub_score = 0;
-    a_ion_sub_score = 0;
-    auto const & tl_sub_scores = MorpheusScore::compute(fragment_mass_tolerance,
-                                                       fragment_mass_tolerance_unit_ppm,
-                                                       exp_spectrum,
-                                                       total_loss_spectrum);
-
+    // score all sub spectra in one pass over the experimental spectrum (empty spectra yield zero scores)
+    const std::vector<const PeakSpectrum*> sub_score_spectra = { &total_loss_spectrum,
+                                                                 &immonium_sub_score_spectrum,
+                                                                 &precursor_sub_score_spectrum,
+                                                                 &a_ion_sub_score_spectrum };
+    std::vector<MorpheusScore::Result> sub_scores;
+    MorpheusScore::computeBatch(fragment_mass_tolerance,
+                                fragment_mass_tolerance_unit_ppm,
+                                exp_spectrum,
+                                sub_score_spectra,
+                                sub_scores);
+
+    auto const & tl_sub_scores = sub_scores[0];
     tlss_MIC = tl_sub_scores.TIC != 0 ? tl_sub_scores.MIC / tl_sub_scores.TIC : 0;
     tlss_err = tl_sub_scores.err;
     tlss_Morph = tl_sub_scores.score;
 
-    if (!immonium_sub_score_spectrum.empty())
-    {
-      auto const & r = MorpheusScore::compute(fragment_mass_tolerance,
-                                             fragment_mass_tolerance_unit_ppm,
-                                             exp_spectrum,
-                                             immonium_sub_score_spectrum);
-      immonium_sub_score = r.TIC != 0 ? r.MIC / r.TIC : 0;
-    }
-    if (!precursor_sub_score_spectrum.empty())
-    {
-      auto const & r = MorpheusScore::compute(fragment_mass_tolerance,
-                                             fragment_mass_tolerance_unit_ppm,
-                                             exp_spectrum,
-                                             precursor_sub_score_spectrum);
-      precursor_sub_score = r.TIC != 0 ? r.MIC / r.TIC : 0;
-    }
-    if (!a_ion_sub_score_spectrum.empty())
-    {
-      auto const & r = MorpheusScore::compute(fragment_mass_tolerance,
-                                             fragment_mass_tolerance_unit_ppm,
-                                             exp_spectrum,
-                                             a_ion_sub_score_spectrum);
-      a_ion_sub_score = r.TIC != 0 ? r.MIC / r.TIC : 0;
-    }
+    immonium_sub_score = sub_scores[1].TIC != 0 ? sub_scores[1].MIC / sub_scores[1].TIC : 0;
+    precursor_sub_score = sub_scores[2].TIC != 0 ? sub_scores[2].MIC / sub_scores[2].TIC : 0;
+    a_ion_sub_score = sub_scores[3].TIC != 0 ? sub_scores[3].MIC / sub_scores[3].TIC : 0;
   }
 
   void scorePartialLossFragments_(const PeakSpectrum &exp_spectrum,